@@ -137,6 +137,13 @@ class GHOST_ISystem {
    */
   static GHOST_TSuccess createSystem();
 
+  /**
+   * Creates the one and only system without any display, the windows created by it have no
+   * drawing context. Used by the applications running in background.
+   * \return An indication of success.
+   */
+  static GHOST_TSuccess createSystemHeadless();
+
   /**
    * Disposes the one and only system.
    * \return An indication of success.
@@ -336,6 +336,10 @@ GHOST_TSuccess GHOST_ContextGLX::releaseNativeHandles()
 GHOST_TSuccess GHOST_ContextGLX::setSwapInterval(int interval)
 {
   if (GLXEW_EXT_swap_control) {
+    /* A negative interval is the adaptive vsync, fall back to the vsync without tearing. */
+    if (interval < 0 && !GLXEW_EXT_swap_control_tear) {
+      interval = -interval;
+    }
     ::glXSwapIntervalEXT(m_display, m_window, interval);
 
     return GHOST_kSuccess;
@@ -103,6 +103,10 @@ GHOST_TSuccess GHOST_ContextWGL::swapBuffers()
 
 GHOST_TSuccess GHOST_ContextWGL::setSwapInterval(int interval)
 {
+  /* A negative interval is the adaptive vsync, fall back to the vsync without tearing. */
+  if (interval < 0 && !WGLEW_EXT_swap_control_tear)
+    interval = -interval;
+
   if (WGLEW_EXT_swap_control)
     return WIN32_CHK(::wglSwapIntervalEXT(interval)) == TRUE ? GHOST_kSuccess : GHOST_kFailure;
   else
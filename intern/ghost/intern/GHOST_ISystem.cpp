@@ -26,9 +26,10 @@
  */
 
 #include "GHOST_ISystem.h"
+#include "GHOST_SystemNULL.h"
 
 #if defined(WITH_HEADLESS)
-#  include "GHOST_SystemNULL.h"
+/* Pass. */
 #elif defined(WITH_GHOST_X11) && defined(WITH_GHOST_WAYLAND)
 #  include "GHOST_SystemWayland.h"
 #  include "GHOST_SystemX11.h"
@@ -88,6 +89,15 @@ GHOST_TSuccess GHOST_ISystem::createSystem()
   return success;
 }
 
+GHOST_TSuccess GHOST_ISystem::createSystemHeadless()
+{
+  if (m_system) {
+    return GHOST_kFailure;
+  }
+  m_system = new GHOST_SystemNULL();
+  return m_system->init();
+}
+
 GHOST_TSuccess GHOST_ISystem::disposeSystem()
 {
   GHOST_TSuccess success = GHOST_kSuccess;
@@ -187,6 +187,15 @@ extern void (*MEM_reset_peak_memory)(void);
 /** Get the peak memory usage in bytes, including mmap allocations. */
 extern size_t (*MEM_get_peak_memory)(void) ATTR_WARN_UNUSED_RESULT;
 
+/** Enable the counting of the allocations, disabled by default to keep the allocations cheap. */
+extern void (*MEM_set_allocation_counting)(bool enable);
+
+/**
+ * Get the number of blocks and of bytes allocated while the counting was enabled.
+ * The frees can be deduced from the changes of the blocks and of the memory in use.
+ */
+extern void (*MEM_get_allocation_counters)(size_t *r_count, size_t *r_len);
+
 #ifdef __GNUC__
 #  define MEM_SAFE_FREE(v) \
     do { \
@@ -60,6 +60,9 @@ size_t (*MEM_get_memory_in_use)(void) = MEM_lockfree_get_memory_in_use;
 unsigned int (*MEM_get_memory_blocks_in_use)(void) = MEM_lockfree_get_memory_blocks_in_use;
 void (*MEM_reset_peak_memory)(void) = MEM_lockfree_reset_peak_memory;
 size_t (*MEM_get_peak_memory)(void) = MEM_lockfree_get_peak_memory;
+void (*MEM_set_allocation_counting)(bool enable) = MEM_lockfree_set_allocation_counting;
+void (*MEM_get_allocation_counters)(size_t *r_count,
+                                    size_t *r_len) = MEM_lockfree_get_allocation_counters;
 
 #ifndef NDEBUG
 const char *(*MEM_name_ptr)(void *vmemh) = MEM_lockfree_name_ptr;
@@ -139,6 +142,8 @@ void MEM_use_lockfree_allocator(void)
   MEM_get_memory_blocks_in_use = MEM_lockfree_get_memory_blocks_in_use;
   MEM_reset_peak_memory = MEM_lockfree_reset_peak_memory;
   MEM_get_peak_memory = MEM_lockfree_get_peak_memory;
+  MEM_set_allocation_counting = MEM_lockfree_set_allocation_counting;
+  MEM_get_allocation_counters = MEM_lockfree_get_allocation_counters;
 
 #ifndef NDEBUG
   MEM_name_ptr = MEM_lockfree_name_ptr;
@@ -170,6 +175,8 @@ void MEM_use_guarded_allocator(void)
   MEM_get_memory_blocks_in_use = MEM_guarded_get_memory_blocks_in_use;
   MEM_reset_peak_memory = MEM_guarded_reset_peak_memory;
   MEM_get_peak_memory = MEM_guarded_get_peak_memory;
+  MEM_set_allocation_counting = MEM_guarded_set_allocation_counting;
+  MEM_get_allocation_counters = MEM_guarded_get_allocation_counters;
 
 #ifndef NDEBUG
   MEM_name_ptr = MEM_guarded_name_ptr;
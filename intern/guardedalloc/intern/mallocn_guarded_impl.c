@@ -168,6 +168,9 @@ static volatile struct localListBase *membase = &_membase;
 static void (*error_callback)(const char *) = NULL;
 
 static bool malloc_debug_memset = false;
+/* Allocations counted while #count_allocations is enabled. */
+static bool count_allocations = false;
+static size_t totalloc = 0, totalloc_len = 0;
 
 #ifdef malloc
 #  undef malloc
@@ -435,6 +438,10 @@ static void make_memhead_header(MemHead *memh, size_t len, const char *str)
 
   atomic_add_and_fetch_u(&totblock, 1);
   atomic_add_and_fetch_z(&mem_in_use, len);
+  if (UNLIKELY(count_allocations)) {
+    atomic_add_and_fetch_z(&totalloc, 1);
+    atomic_add_and_fetch_z(&totalloc_len, len);
+  }
 
   mem_lock_thread();
   addtail(membase, &memh->next);
@@ -1204,6 +1211,17 @@ unsigned int MEM_guarded_get_memory_blocks_in_use(void)
   return _totblock;
 }
 
+void MEM_guarded_set_allocation_counting(bool enable)
+{
+  count_allocations = enable;
+}
+
+void MEM_guarded_get_allocation_counters(size_t *r_count, size_t *r_len)
+{
+  *r_count = totalloc;
+  *r_len = totalloc_len;
+}
+
 #ifndef NDEBUG
 const char *MEM_guarded_name_ptr(void *vmemh)
 {
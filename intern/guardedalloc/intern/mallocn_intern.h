@@ -145,6 +145,8 @@ size_t MEM_lockfree_get_memory_in_use(void);
 unsigned int MEM_lockfree_get_memory_blocks_in_use(void);
 void MEM_lockfree_reset_peak_memory(void);
 size_t MEM_lockfree_get_peak_memory(void) ATTR_WARN_UNUSED_RESULT;
+void MEM_lockfree_set_allocation_counting(bool enable);
+void MEM_lockfree_get_allocation_counters(size_t *r_count, size_t *r_len);
 #ifndef NDEBUG
 const char *MEM_lockfree_name_ptr(void *vmemh);
 #endif
@@ -188,6 +190,8 @@ size_t MEM_guarded_get_memory_in_use(void);
 unsigned int MEM_guarded_get_memory_blocks_in_use(void);
 void MEM_guarded_reset_peak_memory(void);
 size_t MEM_guarded_get_peak_memory(void) ATTR_WARN_UNUSED_RESULT;
+void MEM_guarded_set_allocation_counting(bool enable);
+void MEM_guarded_get_allocation_counters(size_t *r_count, size_t *r_len);
 #ifndef NDEBUG
 const char *MEM_guarded_name_ptr(void *vmemh);
 #endif
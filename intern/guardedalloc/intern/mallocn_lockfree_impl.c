@@ -47,6 +47,9 @@ typedef struct MemHeadAligned {
 static unsigned int totblock = 0;
 static size_t mem_in_use = 0, peak_mem = 0;
 static bool malloc_debug_memset = false;
+/* Allocations counted while #count_allocations is enabled. */
+static bool count_allocations = false;
+static size_t totalloc = 0, totalloc_len = 0;
 
 static void (*error_callback)(const char *) = NULL;
 
@@ -240,6 +243,10 @@ void *MEM_lockfree_callocN(size_t len, const char *str)
     atomic_add_and_fetch_u(&totblock, 1);
     atomic_add_and_fetch_z(&mem_in_use, len);
     update_maximum(&peak_mem, mem_in_use);
+    if (UNLIKELY(count_allocations)) {
+      atomic_add_and_fetch_z(&totalloc, 1);
+      atomic_add_and_fetch_z(&totalloc_len, len);
+    }
 
     return PTR_FROM_MEMHEAD(memh);
   }
@@ -285,6 +292,10 @@ void *MEM_lockfree_mallocN(size_t len, const char *str)
     atomic_add_and_fetch_u(&totblock, 1);
     atomic_add_and_fetch_z(&mem_in_use, len);
     update_maximum(&peak_mem, mem_in_use);
+    if (UNLIKELY(count_allocations)) {
+      atomic_add_and_fetch_z(&totalloc, 1);
+      atomic_add_and_fetch_z(&totalloc_len, len);
+    }
 
     return PTR_FROM_MEMHEAD(memh);
   }
@@ -356,6 +367,10 @@ void *MEM_lockfree_mallocN_aligned(size_t len, size_t alignment, const char *str
     atomic_add_and_fetch_u(&totblock, 1);
     atomic_add_and_fetch_z(&mem_in_use, len);
     update_maximum(&peak_mem, mem_in_use);
+    if (UNLIKELY(count_allocations)) {
+      atomic_add_and_fetch_z(&totalloc, 1);
+      atomic_add_and_fetch_z(&totalloc_len, len);
+    }
 
     return PTR_FROM_MEMHEAD(memh);
   }
@@ -430,6 +445,17 @@ size_t MEM_lockfree_get_peak_memory(void)
   return peak_mem;
 }
 
+void MEM_lockfree_set_allocation_counting(bool enable)
+{
+  count_allocations = enable;
+}
+
+void MEM_lockfree_get_allocation_counters(size_t *r_count, size_t *r_len)
+{
+  *r_count = totalloc;
+  *r_len = totalloc_len;
+}
+
 #ifndef NDEBUG
 const char *MEM_lockfree_name_ptr(void *vmemh)
 {
@@ -42,9 +42,19 @@ GEN_INLINE MT_Quaternion MT_Matrix3x3::getRotation() const {
 }
 
 GEN_INLINE MT_Matrix3x3& MT_Matrix3x3::operator*=(const MT_Matrix3x3& m) {
+#ifdef MT_SIMD
+    // The rows are computed before the assignment, m could be this matrix.
+    const MT_Vector3 x = m_el[0] * m;
+    const MT_Vector3 y = m_el[1] * m;
+    const MT_Vector3 z = m_el[2] * m;
+    m_el[0] = x;
+    m_el[1] = y;
+    m_el[2] = z;
+#else
     setValue(m.tdot(0, m_el[0]), m.tdot(1, m_el[0]), m.tdot(2, m_el[0]),
              m.tdot(0, m_el[1]), m.tdot(1, m_el[1]), m.tdot(2, m_el[1]),
              m.tdot(0, m_el[2]), m.tdot(1, m_el[2]), m.tdot(2, m_el[2]));
+#endif
     return *this;
 }
 
@@ -96,14 +106,29 @@ GEN_INLINE MT_Vector3 operator*(const MT_Matrix3x3& m, const MT_Vector3& v) {
 }
 
 GEN_INLINE MT_Vector3 operator*(const MT_Vector3& v, const MT_Matrix3x3& m) {
+#ifdef MT_SIMD
+    // Sum of the rows scaled by the vector components.
+    const MT_Simd r = MT_simdMul(m[0].simd(), MT_simdSplat(v[0]));
+    return MT_Vector3(MT_simdMulAdd(MT_simdMulAdd(r, m[1].simd(), MT_simdSplat(v[1])),
+                                    m[2].simd(), MT_simdSplat(v[2])));
+#else
     return MT_Vector3(m.tdot(0, v), m.tdot(1, v), m.tdot(2, v));
+#endif
 }
 
 GEN_INLINE MT_Matrix3x3 operator*(const MT_Matrix3x3& m1, const MT_Matrix3x3& m2) {
+#ifdef MT_SIMD
+    MT_Matrix3x3 m;
+    m[0] = m1[0] * m2;
+    m[1] = m1[1] * m2;
+    m[2] = m1[2] * m2;
+    return m;
+#else
     return 
         MT_Matrix3x3(m2.tdot(0, m1[0]), m2.tdot(1, m1[0]), m2.tdot(2, m1[0]),
                      m2.tdot(0, m1[1]), m2.tdot(1, m1[1]), m2.tdot(2, m1[1]),
                      m2.tdot(0, m1[2]), m2.tdot(1, m1[2]), m2.tdot(2, m1[2]));
+#endif
 }
 
 GEN_INLINE MT_Matrix3x3 MT_multTransposeLeft(const MT_Matrix3x3& m1, const MT_Matrix3x3& m2) {
@@ -0,0 +1,162 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file moto/include/MT_Simd.h
+ *  \ingroup moto
+ */
+
+/* Vector instructions of the 3D vectors and matrices, enabled at build time by WITH_MOTO_SIMD
+ * on the processors with SSE2 or NEON. The 3D vectors are then padded to four aligned scalars,
+ * the memory layout of the single precision Bullet vectors. The padding scalar is undefined
+ * in the results of the operations and ignored by the dot products and comparisons.
+ */
+
+#ifndef MT_SIMD_H
+#define MT_SIMD_H
+
+#include "MT_Scalar.h"
+
+#if defined(WITH_MOTO_SIMD)
+#  if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define MT_SIMD_SSE
+#    include <emmintrin.h>
+#  elif defined(__ARM_NEON)
+#    define MT_SIMD_NEON
+#    include <arm_neon.h>
+#  endif
+#endif
+
+#if defined(MT_SIMD_SSE) || defined(MT_SIMD_NEON)
+
+#define MT_SIMD
+
+#ifdef MT_SIMD_SSE
+typedef __m128 MT_Simd;
+#else
+typedef float32x4_t MT_Simd;
+#endif
+
+/// Load four aligned scalars.
+inline MT_Simd MT_simdLoad(const MT_Scalar *v)
+{
+#ifdef MT_SIMD_SSE
+    return _mm_load_ps(v);
+#else
+    return vld1q_f32(v);
+#endif
+}
+
+/// Store four aligned scalars.
+inline void MT_simdStore(MT_Scalar *v, MT_Simd a)
+{
+#ifdef MT_SIMD_SSE
+    _mm_store_ps(v, a);
+#else
+    vst1q_f32(v, a);
+#endif
+}
+
+inline MT_Simd MT_simdSplat(MT_Scalar s)
+{
+#ifdef MT_SIMD_SSE
+    return _mm_set1_ps(s);
+#else
+    return vdupq_n_f32(s);
+#endif
+}
+
+inline MT_Simd MT_simdAdd(MT_Simd a, MT_Simd b)
+{
+#ifdef MT_SIMD_SSE
+    return _mm_add_ps(a, b);
+#else
+    return vaddq_f32(a, b);
+#endif
+}
+
+inline MT_Simd MT_simdSub(MT_Simd a, MT_Simd b)
+{
+#ifdef MT_SIMD_SSE
+    return _mm_sub_ps(a, b);
+#else
+    return vsubq_f32(a, b);
+#endif
+}
+
+inline MT_Simd MT_simdMul(MT_Simd a, MT_Simd b)
+{
+#ifdef MT_SIMD_SSE
+    return _mm_mul_ps(a, b);
+#else
+    return vmulq_f32(a, b);
+#endif
+}
+
+/// Return a + b * c.
+inline MT_Simd MT_simdMulAdd(MT_Simd a, MT_Simd b, MT_Simd c)
+{
+#ifdef MT_SIMD_SSE
+    return _mm_add_ps(a, _mm_mul_ps(b, c));
+#else
+    return vmlaq_f32(a, b, c);
+#endif
+}
+
+inline MT_Simd MT_simdNeg(MT_Simd a)
+{
+#ifdef MT_SIMD_SSE
+    return _mm_sub_ps(_mm_setzero_ps(), a);
+#else
+    return vnegq_f32(a);
+#endif
+}
+
+/// Rotate the first three lanes, (x, y, z) becomes (y, z, x).
+inline MT_Simd MT_simdYZX(MT_Simd a)
+{
+#ifdef MT_SIMD_SSE
+    return _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+#else
+    const float32x2_t low = vget_low_f32(a);
+    return vcombine_f32(vext_f32(low, vget_high_f32(a), 1), low);
+#endif
+}
+
+/// Sum of the first three lanes.
+inline MT_Scalar MT_simdSum3(MT_Simd a)
+{
+#ifdef MT_SIMD_SSE
+    const __m128 y = _mm_shuffle_ps(a, a, _MM_SHUFFLE(1, 1, 1, 1));
+    const __m128 z = _mm_movehl_ps(a, a);
+    return _mm_cvtss_f32(_mm_add_ss(_mm_add_ss(a, y), z));
+#else
+    return vgetq_lane_f32(a, 0) + vgetq_lane_f32(a, 1) + vgetq_lane_f32(a, 2);
+#endif
+}
+
+inline MT_Simd MT_simdCross(MT_Simd a, MT_Simd b)
+{
+    const MT_Simd c = MT_simdSub(MT_simdMul(a, MT_simdYZX(b)), MT_simdMul(MT_simdYZX(a), b));
+    return MT_simdYZX(c);
+}
+
+#endif  // MT_SIMD_SSE || MT_SIMD_NEON
+
+#endif  // MT_SIMD_H
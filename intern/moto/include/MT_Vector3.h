@@ -51,6 +51,7 @@
 
 #include <BLI_utildefines.h>
 #include "MT_Scalar.h"
+#include "MT_Simd.h"
 #include "MT_Stream.h"
 #include "MT_Vector2.h"
 
@@ -61,6 +62,11 @@ public:
     template <typename T>
     explicit MT_Vector3(const T *v) { setValue(v); }
     explicit MT_Vector3(MT_Scalar xx, MT_Scalar yy, MT_Scalar zz) { setValue(xx, yy, zz); }
+#ifdef MT_SIMD
+    explicit MT_Vector3(MT_Simd v) { MT_simdStore(m_co, v); }
+
+    MT_Simd simd() const { return MT_simdLoad(m_co); }
+#endif
     
     MT_Scalar&       operator[](int i)       { return m_co[i]; }
     const MT_Scalar& operator[](int i) const { return m_co[i]; }
@@ -89,10 +95,16 @@ public:
         m_co[0] = (MT_Scalar)v[0]; 
         m_co[1] = (MT_Scalar)v[1]; 
         m_co[2] = (MT_Scalar)v[2];
+#ifdef MT_SIMD
+        m_co[3] = MT_Scalar(0.0f);
+#endif
     }
     
     void setValue(MT_Scalar xx, MT_Scalar yy, MT_Scalar zz) {
         m_co[0] = xx; m_co[1] = yy; m_co[2] = zz;
+#ifdef MT_SIMD
+        m_co[3] = MT_Scalar(0.0f);
+#endif
     }
 
 
@@ -137,7 +149,12 @@ public:
     static MT_Vector3 random();
 
 protected:
+#ifdef MT_SIMD
+    /// Padded to the layout of btVector3, the last scalar is unused.
+    alignas(16) MT_Scalar m_co[4];
+#else
     MT_Scalar m_co[3];                            
+#endif
 };
 
 inline bool operator==(const MT_Vector3& t1, const MT_Vector3& t2) {
@@ -1,8 +1,13 @@
 #include "MT_Optimize.h"
 
 GEN_INLINE MT_Vector3& MT_Vector3::operator=(const MT_Vector3& v) {
+#ifdef MT_SIMD
+    MT_simdStore(m_co, v.simd());
+    return *this;
+#else
     m_co[0] = v[0]; m_co[1] = v[1]; m_co[2] = v[2];
     return *this;
+#endif
 }
 
 GEN_INLINE MT_Scalar MT_Vector3::distance(const MT_Vector3& p) const {
@@ -14,9 +19,14 @@ GEN_INLINE MT_Scalar MT_Vector3::distance2(const MT_Vector3& p) const {
 }
 
 GEN_INLINE MT_Vector3 MT_Vector3::lerp(const MT_Vector3& p, MT_Scalar t) const {
+#ifdef MT_SIMD
+    const MT_Simd a = simd();
+    return MT_Vector3(MT_simdMulAdd(a, MT_simdSub(p.simd(), a), MT_simdSplat(t)));
+#else
     return MT_Vector3(m_co[0] + (p[0] - m_co[0]) * t,
                      m_co[1] + (p[1] - m_co[1]) * t,
                      m_co[2] + (p[2] - m_co[2]) * t);
+#endif
 }
 
 GEN_INLINE MT_Scalar MT_distance(const MT_Vector3& p1, const MT_Vector3& p2) { 
@@ -32,18 +42,33 @@ GEN_INLINE MT_Vector3 MT_lerp(const MT_Vector3& p1, const MT_Vector3& p2, MT_Sca
 }
 
 GEN_INLINE MT_Vector3& MT_Vector3::operator+=(const MT_Vector3& v) {
+#ifdef MT_SIMD
+    MT_simdStore(m_co, MT_simdAdd(simd(), v.simd()));
+    return *this;
+#else
     m_co[0] += v[0]; m_co[1] += v[1]; m_co[2] += v[2];
     return *this;
+#endif
 }
 
 GEN_INLINE MT_Vector3& MT_Vector3::operator-=(const MT_Vector3& v) {
+#ifdef MT_SIMD
+    MT_simdStore(m_co, MT_simdSub(simd(), v.simd()));
+    return *this;
+#else
     m_co[0] -= v[0]; m_co[1] -= v[1]; m_co[2] -= v[2];
     return *this;
+#endif
 }
  
 GEN_INLINE MT_Vector3& MT_Vector3::operator*=(MT_Scalar s) {
+#ifdef MT_SIMD
+    MT_simdStore(m_co, MT_simdMul(simd(), MT_simdSplat(s)));
+    return *this;
+#else
     m_co[0] *= s; m_co[1] *= s; m_co[2] *= s;
     return *this;
+#endif
 }
 
 GEN_INLINE MT_Vector3& MT_Vector3::operator/=(MT_Scalar s) {
@@ -52,19 +77,35 @@ GEN_INLINE MT_Vector3& MT_Vector3::operator/=(MT_Scalar s) {
 }
 
 GEN_INLINE MT_Vector3 operator+(const MT_Vector3& v1, const MT_Vector3& v2) {
+#ifdef MT_SIMD
+    return MT_Vector3(MT_simdAdd(v1.simd(), v2.simd()));
+#else
     return MT_Vector3(v1[0] + v2[0], v1[1] + v2[1], v1[2] + v2[2]);
+#endif
 }
 
 GEN_INLINE MT_Vector3 operator-(const MT_Vector3& v1, const MT_Vector3& v2) {
+#ifdef MT_SIMD
+    return MT_Vector3(MT_simdSub(v1.simd(), v2.simd()));
+#else
     return MT_Vector3(v1[0] - v2[0], v1[1] - v2[1], v1[2] - v2[2]);
+#endif
 }
 
 GEN_INLINE MT_Vector3 operator-(const MT_Vector3& v) {
+#ifdef MT_SIMD
+    return MT_Vector3(MT_simdNeg(v.simd()));
+#else
     return MT_Vector3(-v[0], -v[1], -v[2]);
+#endif
 }
 
 GEN_INLINE MT_Vector3 operator*(const MT_Vector3& v, MT_Scalar s) {
+#ifdef MT_SIMD
+    return MT_Vector3(MT_simdMul(v.simd(), MT_simdSplat(s)));
+#else
     return MT_Vector3(v[0] * s, v[1] * s, v[2] * s);
+#endif
 }
 
 GEN_INLINE MT_Vector3 operator*(MT_Scalar s, const MT_Vector3& v) { return v * s; }
@@ -75,11 +116,19 @@ GEN_INLINE MT_Vector3 operator/(const MT_Vector3& v, MT_Scalar s) {
 }
 
 GEN_INLINE MT_Vector3 operator*(const MT_Vector3& v1, const MT_Vector3& v2) {
+#ifdef MT_SIMD
+    return MT_Vector3(MT_simdMul(v1.simd(), v2.simd()));
+#else
     return MT_Vector3(v1[0] * v2[0], v1[1] * v2[1], v1[2] * v2[2]);
+#endif
 }
 
 GEN_INLINE MT_Scalar MT_Vector3::dot(const MT_Vector3& v) const {
+#ifdef MT_SIMD
+    return MT_simdSum3(MT_simdMul(simd(), v.simd()));
+#else
     return m_co[0] * v[0] + m_co[1] * v[1] + m_co[2] * v[2];
+#endif
 }
 
 GEN_INLINE MT_Scalar MT_Vector3::length2() const { return dot(*this); }
@@ -130,9 +179,13 @@ GEN_INLINE MT_Scalar MT_Vector3::angle(const MT_Vector3& v) const {
 }
 
 GEN_INLINE MT_Vector3 MT_Vector3::cross(const MT_Vector3& v) const {
+#ifdef MT_SIMD
+    return MT_Vector3(MT_simdCross(simd(), v.simd()));
+#else
     return MT_Vector3(m_co[1] * v[2] - m_co[2] * v[1],
                       m_co[2] * v[0] - m_co[0] * v[2],
                       m_co[0] * v[1] - m_co[1] * v[0]);
+#endif
 }
 
 GEN_INLINE MT_Scalar MT_Vector3::triple(const MT_Vector3& v1, const MT_Vector3& v2) const {
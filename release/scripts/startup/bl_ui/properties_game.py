@@ -305,8 +305,11 @@ class PHYSICS_PT_game_physics(PhysicsButtonsPanel, Panel):
             col.prop(game, "use_ccd_rigid_body")
             sub = col.column()
             sub.active = game.use_ccd_rigid_body
-            sub.prop(game, "ccd_motion_threshold")
-            sub.prop(game, "ccd_swept_sphere_radius")
+            sub.prop(game, "use_ccd_auto_threshold")
+            subsub = sub.column()
+            subsub.active = not game.use_ccd_auto_threshold
+            subsub.prop(game, "ccd_motion_threshold")
+            subsub.prop(game, "ccd_swept_sphere_radius")
 
             layout.separator()
             col = layout.column()
@@ -551,6 +554,8 @@ class SCENE_PT_game_physics(SceneButtonsPanel, Panel):
         layout.prop(gs, "physics_engine", text="Engine")
         if gs.physics_engine != 'NONE':
             layout.prop(gs, "physics_solver")
+            layout.prop(gs, "use_multithreaded_physics")
+            layout.prop(gs, "use_physics_bvh_cache")
             layout.prop(gs, "physics_gravity", text="Gravity")
 
             split = layout.split()
@@ -588,6 +593,20 @@ class SCENE_PT_game_physics(SceneButtonsPanel, Panel):
             row.label(text="Object Activity:")
             row.prop(gs, "use_activity_culling")
 
+            col = layout.column()
+            col.label(text="Render Culling:")
+            row = col.row()
+            row.prop(gs, "use_dbvt_culling")
+            sub = row.row()
+            sub.active = gs.use_dbvt_culling
+            sub.prop(gs, "use_occlusion_culling")
+            sub = col.row()
+            sub.active = gs.use_dbvt_culling and gs.use_occlusion_culling
+            sub.prop(gs, "occlusion_culling_resolution", text="Resolution")
+            sub = col.row()
+            sub.active = gs.use_dbvt_culling
+            sub.prop(gs, "use_gpu_occlusion_culling")
+
         else:
             split = layout.split()
 
@@ -702,6 +721,22 @@ class SCENE_PT_game_hysteresis(SceneButtonsPanel, Panel):
         row.active = gs.use_scene_hysteresis
         row.prop(gs, "scene_hysteresis_percentage", text="")
 
+class SCENE_PT_game_animation(SceneButtonsPanel, Panel):
+    bl_label = "Game Animation"
+    COMPAT_ENGINES = {'BLENDER_EEVEE', 'BLENDER_WORKBENCH'}
+
+    @classmethod
+    def poll(cls, context):
+        scene = context.scene
+        return (scene and scene.render.engine in cls.COMPAT_ENGINES)
+
+    def draw(self, context):
+        layout = self.layout
+        gs = context.scene.game_settings
+
+        layout.prop(gs, "use_animation_culling")
+
+
 class SCENE_PT_game_console(SceneButtonsPanel, Panel):
     bl_label = "Game Python Console"
     bl_options = {'DEFAULT_CLOSED'}
@@ -760,12 +795,21 @@ class OBJECT_PT_activity_culling(ObjectButtonsPanel, Panel):
         sub = col.column()
         sub.active = activity.use_physics
         sub.prop(activity, "physics_radius")
+        col.prop(activity, "use_physics_lod", text="Physics LOD")
+        sub = col.column()
+        sub.active = activity.use_physics_lod
+        sub.prop(activity, "physics_lod_radius", text="LOD Radius")
 
         col = split.column()
         col.prop(activity, "use_logic", text="Logic")
         sub = col.column()
         sub.active = activity.use_logic
         sub.prop(activity, "logic_radius")
+        col.prop(activity, "use_logic_lod", text="Logic LOD")
+        sub = col.column()
+        sub.active = activity.use_logic_lod
+        sub.prop(activity, "logic_lod_radius", text="LOD Radius")
+        sub.prop(activity, "logic_lod_interval", text="LOD Interval")
 
 class OBJECT_MT_lod_tools(Menu):
     bl_label = "Level Of Detail Tools"
@@ -837,6 +881,7 @@ classes = (
     SCENE_PT_game_physics_obstacles,
     SCENE_PT_game_navmesh,
     SCENE_PT_game_hysteresis,
+    SCENE_PT_game_animation,
     SCENE_PT_game_console,
     OBJECT_MT_lod_tools,
     OBJECT_PT_activity_culling,
@@ -172,6 +172,8 @@ bool BKE_pose_channels_is_valid(const struct bPose *pose);
 
 /* Copy the data from the action-pose (src) into the pose */
 void extract_pose_from_pose(struct bPose *pose, const struct bPose *src);
+/* Copy the data from a single action-pose channel (src) into the channel */
+void extract_pose_channel(struct bPoseChannel *pchan, const struct bPoseChannel *src);
 
 /* sets constraint flags */
 void BKE_pose_update_constraint_flags(struct bPose *pose);
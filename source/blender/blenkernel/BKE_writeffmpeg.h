@@ -93,6 +93,10 @@ void BKE_ffmpeg_property_del(struct RenderData *rd, void *type, void *prop_);
 
 void *BKE_ffmpeg_context_create(void);
 void BKE_ffmpeg_context_free(void *context_v);
+/* Prefer a hardware encoder of the H.264 and HEVC codecs, must be set before the start. */
+void BKE_ffmpeg_context_hardware_encoder_set(void *context_v, bool use_hardware_encoder);
+/* Name of the encoder of the started video stream, NULL if none. */
+const char *BKE_ffmpeg_video_encoder_name(void *context_v);
 
 #  ifdef __cplusplus
 }
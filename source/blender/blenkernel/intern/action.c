@@ -1692,6 +1692,12 @@ void extract_pose_from_pose(bPose *pose, const bPose *src)
   }
 }
 
+/* exported to game engine */
+void extract_pose_channel(bPoseChannel *pchan, const bPoseChannel *src)
+{
+  copy_pose_channel_data(pchan, src);
+}
+
 /**
  * Zero the pose transforms for the entire pose or only for selected bones.
  */
@@ -1617,6 +1617,33 @@ static const DupliGenerator gen_dupli_particles = {
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Dupli-Game Implementation (#OB_DUPLIGAME)
+ * \{ */
+
+static void make_duplis_game(const DupliContext *ctx)
+{
+  /* The instance buffer is only written on the original object by the game engine. */
+  const Object *ob_orig = DEG_get_original_object(ctx->object);
+  Object *instance_ob = ob_orig->runtime.game_instance_object;
+  if (instance_ob == nullptr || ob_orig->runtime.game_instance_matrices == nullptr) {
+    return;
+  }
+
+  Object *instance_ob_eval = DEG_get_evaluated_object(ctx->depsgraph, instance_ob);
+  const float(*matrices)[4][4] = (const float(*)[4][4])ob_orig->runtime.game_instance_matrices;
+  for (int i = 0; i < ob_orig->runtime.game_instance_count; i++) {
+    make_dupli(ctx, instance_ob_eval, matrices[i], i);
+  }
+}
+
+static const DupliGenerator gen_dupli_game = {
+    OB_DUPLIGAME,    /* type */
+    make_duplis_game /* make_duplis */
+};
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Dupli-Generator Selector For The Given Context
  * \{ */
@@ -1664,6 +1691,9 @@ static const DupliGenerator *get_dupli_generator(const DupliContext *ctx)
   else if (transflag & OB_DUPLICOLLECTION) {
     return &gen_dupli_collection;
   }
+  else if (transflag & OB_DUPLIGAME) {
+    return &gen_dupli_game;
+  }
 
   return nullptr;
 }
@@ -58,6 +58,7 @@
 #  include <libavformat/avformat.h>
 #  include <libavutil/imgutils.h>
 #  include <libavutil/opt.h>
+#  include <libavutil/pixdesc.h>
 #  include <libavutil/rational.h>
 #  include <libavutil/samplefmt.h>
 #  include <libswscale/swscale.h>
@@ -80,6 +81,8 @@ typedef struct FFMpegContext {
 
   int ffmpeg_crf;    /* set to 0 to not use CRF mode; we have another flag for lossless anyway. */
   int ffmpeg_preset; /* see eFFMpegPreset */
+  /* Prefer a hardware encoder for the video codec when one is available. */
+  bool ffmpeg_hardware_encoder;
 
   AVFormatContext *outfile;
   AVCodecContext *video_codec;
@@ -560,6 +563,64 @@ static AVRational calc_time_base(uint den, double num, int codec_id)
   return time_base;
 }
 
+/* First pixel format of an encoder taking frames in system memory. */
+static enum AVPixelFormat hardware_encoder_pix_fmt(const AVCodec *codec)
+{
+  if (codec->pix_fmts) {
+    for (const enum AVPixelFormat *fmt = codec->pix_fmts; *fmt != AV_PIX_FMT_NONE; fmt++) {
+      const AVPixFmtDescriptor *desc = av_pix_fmt_desc_get(*fmt);
+      if (desc && !(desc->flags & AV_PIX_FMT_FLAG_HWACCEL)) {
+        return *fmt;
+      }
+    }
+  }
+  return AV_PIX_FMT_NONE;
+}
+
+/* Find a hardware encoder of the codec usable on this system. Only the encoders accepting frames
+ * in system memory are tried, VAAPI needs the frames uploaded to the device and isn't supported.
+ * An encoder can be built in FFmpeg without a device supporting it, it is tried to be opened. */
+static AVCodec *find_hardware_video_encoder(int codec_id, int rectx, int recty)
+{
+  static const char *h264_encoders[] = {
+      "h264_nvenc", "h264_qsv", "h264_amf", "h264_videotoolbox", NULL};
+  static const char *hevc_encoders[] = {
+      "hevc_nvenc", "hevc_qsv", "hevc_amf", "hevc_videotoolbox", NULL};
+
+  const char **names = NULL;
+  if (codec_id == AV_CODEC_ID_H264) {
+    names = h264_encoders;
+  }
+  else if (codec_id == AV_CODEC_ID_HEVC) {
+    names = hevc_encoders;
+  }
+  else {
+    return NULL;
+  }
+
+  for (; *names; names++) {
+    AVCodec *codec = avcodec_find_encoder_by_name(*names);
+    if (!codec) {
+      continue;
+    }
+
+    AVCodecContext *c = avcodec_alloc_context3(codec);
+    c->width = rectx;
+    c->height = recty;
+    c->time_base = (AVRational){1, 25};
+    c->pix_fmt = hardware_encoder_pix_fmt(codec);
+    const int ret = (c->pix_fmt != AV_PIX_FMT_NONE) ? avcodec_open2(c, codec, NULL) : -1;
+    avcodec_free_context(&c);
+
+    if (ret >= 0) {
+      PRINT("Using hardware video encoder %s\n", *names);
+      return codec;
+    }
+  }
+
+  return NULL;
+}
+
 /* prepare a video stream for the output file */
 
 static AVStream *alloc_video_stream(FFMpegContext *context,
@@ -590,7 +651,13 @@ static AVStream *alloc_video_stream(FFMpegContext *context,
   c->codec_id = codec_id;
   c->codec_type = AVMEDIA_TYPE_VIDEO;
 
-  codec = avcodec_find_encoder(c->codec_id);
+  codec = context->ffmpeg_hardware_encoder ?
+              find_hardware_video_encoder(codec_id, rectx, recty) :
+              NULL;
+  const bool use_hardware_encoder = (codec != NULL);
+  if (!codec) {
+    codec = avcodec_find_encoder(c->codec_id);
+  }
   if (!codec) {
     fprintf(stderr, "Couldn't find valid video codec\n");
     avcodec_free_context(&c);
@@ -639,7 +706,12 @@ static AVStream *alloc_video_stream(FFMpegContext *context,
   c->gop_size = context->ffmpeg_gop_size;
   c->max_b_frames = context->ffmpeg_max_b_frames;
 
-  if (context->ffmpeg_type == FFMPEG_WEBM && context->ffmpeg_crf == 0) {
+  if (use_hardware_encoder) {
+    /* The hardware encoders don't support the CRF mode and have their own presets. */
+    c->bit_rate = context->ffmpeg_video_bitrate * 1000;
+    c->rc_max_rate = rd->ffcodecdata.rc_max_rate * 1000;
+  }
+  else if (context->ffmpeg_type == FFMPEG_WEBM && context->ffmpeg_crf == 0) {
     ffmpeg_dict_set_int(&opts, "lossless", 1);
   }
   else if (context->ffmpeg_crf >= 0) {
@@ -657,7 +729,7 @@ static AVStream *alloc_video_stream(FFMpegContext *context,
     c->rc_buffer_size = rd->ffcodecdata.rc_buffer_size * 1024;
   }
 
-  if (context->ffmpeg_preset) {
+  if (context->ffmpeg_preset && !use_hardware_encoder) {
     /* 'preset' is used by h.264, 'deadline' is used by webm/vp9. I'm not
      * setting those properties conditionally based on the video codec,
      * as the FFmpeg encoder simply ignores unknown settings anyway. */
@@ -689,7 +761,10 @@ static AVStream *alloc_video_stream(FFMpegContext *context,
 
   /* Be sure to use the correct pixel format(e.g. RGB, YUV) */
 
-  if (codec->pix_fmts) {
+  if (use_hardware_encoder) {
+    c->pix_fmt = hardware_encoder_pix_fmt(codec);
+  }
+  else if (codec->pix_fmts) {
     c->pix_fmt = codec->pix_fmts[0];
   }
   else {
@@ -730,7 +805,8 @@ static AVStream *alloc_video_stream(FFMpegContext *context,
   }
 
   /* Use 4:4:4 instead of 4:2:0 pixel format for lossless rendering. */
-  if ((codec_id == AV_CODEC_ID_H264 || codec_id == AV_CODEC_ID_VP9) && context->ffmpeg_crf == 0) {
+  if ((codec_id == AV_CODEC_ID_H264 || codec_id == AV_CODEC_ID_VP9) && context->ffmpeg_crf == 0 &&
+      !use_hardware_encoder) {
     c->pix_fmt = AV_PIX_FMT_YUV444P;
   }
 
@@ -1885,6 +1961,21 @@ void *BKE_ffmpeg_context_create(void)
   return context;
 }
 
+void BKE_ffmpeg_context_hardware_encoder_set(void *context_v, bool use_hardware_encoder)
+{
+  FFMpegContext *context = context_v;
+  context->ffmpeg_hardware_encoder = use_hardware_encoder;
+}
+
+const char *BKE_ffmpeg_video_encoder_name(void *context_v)
+{
+  FFMpegContext *context = context_v;
+  if (context->video_codec == NULL || context->video_codec->codec == NULL) {
+    return NULL;
+  }
+  return context->video_codec->codec->name;
+}
+
 void BKE_ffmpeg_context_free(void *context_v)
 {
   FFMpegContext *context = context_v;
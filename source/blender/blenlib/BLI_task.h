@@ -47,6 +47,11 @@ struct BLI_mempool;
 void BLI_task_scheduler_init(void);
 void BLI_task_scheduler_exit(void);
 int BLI_task_scheduler_num_threads(void);
+/* Change the number of threads after the initialization, 0 restores the initial number. */
+void BLI_task_scheduler_num_threads_set(int num_threads);
+/* Call a function in each worker thread when it enters the scheduler, to set its affinity for
+ * example. The threads already running call it before their next task, NULL stops the calls. */
+void BLI_task_scheduler_worker_init_set(void (*func)(void *userdata), void *userdata);
 
 /* Task Pool
  *
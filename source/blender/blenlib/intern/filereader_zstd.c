@@ -28,6 +28,8 @@
 #include "BLI_endian_switch.h"
 #include "BLI_filereader.h"
 #include "BLI_math_base.h"
+#include "BLI_task.h"
+#include "BLI_threads.h"
 
 #include "MEM_guardedalloc.h"
 
@@ -45,11 +47,19 @@ typedef struct {
     size_t *compressed_ofs;
     size_t *uncompressed_ofs;
 
+    /* Consecutive frames decompressed together, from `cached_frame` to
+     * `cached_frame + cached_num - 1`. */
     char *cached_content;
     int cached_frame;
+    int cached_num;
+    /* Number of frames decompressed in parallel when a frame isn't cached. */
+    int read_ahead;
   } seek;
 } ZstdReader;
 
+/* Limit the memory used by the read-ahead, each frame is 1mb when written by Blender. */
+#define ZSTD_MAX_READ_AHEAD 8
+
 static bool zstd_read_u32(FileReader *base, uint32_t *val)
 {
   if (base->read(base, val, sizeof(uint32_t)) != sizeof(uint32_t)) {
@@ -143,6 +153,8 @@ static bool zstd_read_seek_table(ZstdReader *zstd)
   }
 
   zstd->seek.cached_frame = -1;
+  zstd->seek.cached_num = 0;
+  zstd->seek.read_ahead = clamp_i(BLI_system_thread_count(), 1, ZSTD_MAX_READ_AHEAD);
 
   return true;
 }
@@ -170,39 +182,89 @@ static int zstd_frame_from_pos(ZstdReader *zstd, size_t pos)
   return low;
 }
 
-/* Ensure that the currently loaded frame is the correct one. */
+typedef struct ZstdDecompressData {
+  ZstdReader *zstd;
+  int first_frame;
+  const char *compressed_data;
+  char *uncompressed_data;
+  bool error;
+} ZstdDecompressData;
+
+static void zstd_decompress_frame_cb(void *__restrict userdata,
+                                     const int iter,
+                                     const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  ZstdDecompressData *data = userdata;
+  const size_t *compressed_ofs = data->zstd->seek.compressed_ofs;
+  const size_t *uncompressed_ofs = data->zstd->seek.uncompressed_ofs;
+  const int frame = data->first_frame + iter;
+
+  size_t compressed_size = compressed_ofs[frame + 1] - compressed_ofs[frame];
+  size_t uncompressed_size = uncompressed_ofs[frame + 1] - uncompressed_ofs[frame];
+  const char *src = data->compressed_data + compressed_ofs[frame] -
+                    compressed_ofs[data->first_frame];
+  char *dst = data->uncompressed_data + uncompressed_ofs[frame] -
+              uncompressed_ofs[data->first_frame];
+
+  /* Each frame is independent, the frames are decompressed in parallel. */
+  size_t res = ZSTD_decompress(dst, uncompressed_size, src, compressed_size);
+  if (ZSTD_isError(res) || res < uncompressed_size) {
+    data->error = true;
+  }
+}
+
+/* Ensure that the wanted frame is in the loaded frames, else load it with the following ones. */
 static const char *zstd_ensure_cache(ZstdReader *zstd, int frame)
 {
-  if (zstd->seek.cached_frame == frame) {
-    /* Cached frame matches, so just return it. */
-    return zstd->seek.cached_content;
+  const size_t *compressed_ofs = zstd->seek.compressed_ofs;
+  const size_t *uncompressed_ofs = zstd->seek.uncompressed_ofs;
+
+  if (frame >= zstd->seek.cached_frame &&
+      frame < zstd->seek.cached_frame + zstd->seek.cached_num) {
+    /* The frame is cached, so just return it. */
+    return zstd->seek.cached_content + uncompressed_ofs[frame] -
+           uncompressed_ofs[zstd->seek.cached_frame];
   }
 
-  /* Cached frame doesn't match, so discard it and cache the wanted one instead. */
+  /* The frame isn't cached, so discard the cached frames and read ahead the wanted one and the
+   * following ones, as the file is mostly read sequentially. */
   MEM_SAFE_FREE(zstd->seek.cached_content);
+  zstd->seek.cached_num = 0;
 
-  size_t compressed_size = zstd->seek.compressed_ofs[frame + 1] - zstd->seek.compressed_ofs[frame];
-  size_t uncompressed_size = zstd->seek.uncompressed_ofs[frame + 1] -
-                             zstd->seek.uncompressed_ofs[frame];
+  const int num = min_ii(zstd->seek.read_ahead, zstd->seek.num_frames - frame);
+  size_t compressed_size = compressed_ofs[frame + num] - compressed_ofs[frame];
+  size_t uncompressed_size = uncompressed_ofs[frame + num] - uncompressed_ofs[frame];
 
   char *uncompressed_data = MEM_mallocN(uncompressed_size, __func__);
   char *compressed_data = MEM_mallocN(compressed_size, __func__);
-  if (zstd->base->seek(zstd->base, zstd->seek.compressed_ofs[frame], SEEK_SET) < 0 ||
+  if (zstd->base->seek(zstd->base, compressed_ofs[frame], SEEK_SET) < 0 ||
       zstd->base->read(zstd->base, compressed_data, compressed_size) < compressed_size) {
     MEM_freeN(compressed_data);
     MEM_freeN(uncompressed_data);
     return NULL;
   }
 
-  size_t res = ZSTD_decompressDCtx(
-      zstd->ctx, uncompressed_data, uncompressed_size, compressed_data, compressed_size);
+  ZstdDecompressData data = {zstd, frame, compressed_data, uncompressed_data, false};
+  if (num == 1) {
+    size_t res = ZSTD_decompressDCtx(
+        zstd->ctx, uncompressed_data, uncompressed_size, compressed_data, compressed_size);
+    data.error = (ZSTD_isError(res) || res < uncompressed_size);
+  }
+  else {
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.min_iter_per_thread = 1;
+    BLI_task_parallel_range(0, num, &data, zstd_decompress_frame_cb, &settings);
+  }
+
   MEM_freeN(compressed_data);
-  if (ZSTD_isError(res) || res < uncompressed_size) {
+  if (data.error) {
     MEM_freeN(uncompressed_data);
     return NULL;
   }
 
   zstd->seek.cached_frame = frame;
+  zstd->seek.cached_num = num;
   zstd->seek.cached_content = uncompressed_data;
   return uncompressed_data;
 }
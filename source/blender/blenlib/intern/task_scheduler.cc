@@ -29,6 +29,7 @@
 /* Need to include at least one header to get the version define. */
 #  include <tbb/blocked_range.h>
 #  include <tbb/task_arena.h>
+#  include <tbb/task_scheduler_observer.h>
 #  if TBB_INTERFACE_VERSION_MAJOR >= 10
 #    include <tbb/global_control.h>
 #    define WITH_TBB_GLOBAL_CONTROL
@@ -38,10 +39,29 @@
 /* Task Scheduler */
 
 static int task_scheduler_num_threads = 1;
+static int task_scheduler_init_num_threads = 1;
 #ifdef WITH_TBB_GLOBAL_CONTROL
 static tbb::global_control *task_scheduler_global_control = nullptr;
 #endif
 
+#ifdef WITH_TBB
+/* Calls the worker init function when a worker thread enters the scheduler. */
+class TaskSchedulerWorkerObserver : public tbb::task_scheduler_observer {
+ public:
+  void (*func)(void *userdata) = nullptr;
+  void *userdata = nullptr;
+
+  void on_scheduler_entry(bool is_worker) override
+  {
+    if (is_worker && func) {
+      func(userdata);
+    }
+  }
+};
+
+static TaskSchedulerWorkerObserver *task_scheduler_worker_observer = nullptr;
+#endif
+
 void BLI_task_scheduler_init()
 {
 #ifdef WITH_TBB_GLOBAL_CONTROL
@@ -64,15 +84,65 @@ void BLI_task_scheduler_init()
 #else
   task_scheduler_num_threads = BLI_system_thread_count();
 #endif
+  task_scheduler_init_num_threads = task_scheduler_num_threads;
 }
 
 void BLI_task_scheduler_exit()
 {
+#ifdef WITH_TBB
+  if (task_scheduler_worker_observer) {
+    task_scheduler_worker_observer->observe(false);
+    OBJECT_GUARDED_DELETE(task_scheduler_worker_observer, TaskSchedulerWorkerObserver);
+  }
+#endif
 #ifdef WITH_TBB_GLOBAL_CONTROL
   OBJECT_GUARDED_DELETE(task_scheduler_global_control, tbb::global_control);
 #endif
 }
 
+void BLI_task_scheduler_num_threads_set(int num_threads)
+{
+#ifdef WITH_TBB_GLOBAL_CONTROL
+  OBJECT_GUARDED_SAFE_DELETE(task_scheduler_global_control, tbb::global_control);
+
+  if (num_threads <= 0) {
+    /* Restore the number of threads of the initialization. */
+    num_threads = BLI_system_num_threads_override_get();
+  }
+  if (num_threads > 0) {
+    task_scheduler_global_control = OBJECT_GUARDED_NEW(
+        tbb::global_control, tbb::global_control::max_allowed_parallelism, num_threads);
+    task_scheduler_num_threads = num_threads;
+  }
+  else {
+    task_scheduler_num_threads = task_scheduler_init_num_threads;
+  }
+#else
+  UNUSED_VARS(num_threads);
+#endif
+}
+
+void BLI_task_scheduler_worker_init_set(void (*func)(void *userdata), void *userdata)
+{
+#ifdef WITH_TBB
+  if (task_scheduler_worker_observer) {
+    /* Wait the end of the calls of the previous function. */
+    task_scheduler_worker_observer->observe(false);
+  }
+  else if (func) {
+    task_scheduler_worker_observer = OBJECT_GUARDED_NEW(TaskSchedulerWorkerObserver);
+  }
+
+  if (func) {
+    task_scheduler_worker_observer->func = func;
+    task_scheduler_worker_observer->userdata = userdata;
+    task_scheduler_worker_observer->observe(true);
+  }
+#else
+  UNUSED_VARS(func, userdata);
+#endif
+}
+
 int BLI_task_scheduler_num_threads()
 {
   return task_scheduler_num_threads;
@@ -5710,7 +5710,16 @@ BlendFileData *blo_read_blendafterruntime(int file,
 {
   BlendFileData *bfd = NULL;
   FileData *fd = filedata_new(reports);
-  fd->file = BLI_filereader_new_file(file);
+  /* Map the runtime as the regular blend files, the blocks read on demand by the linking are
+   * then copied from the mapping instead of being read by a system call each. */
+  fd->file = BLI_filereader_new_mmap(file);
+  if (fd->file != NULL) {
+    /* The mapping stays valid after the file is closed. */
+    close(file);
+  }
+  else {
+    fd->file = BLI_filereader_new_file(file);
+  }
   fd->file->seek(fd->file, datastart, SEEK_SET);
   /*fd->filedes = file;
   fd->buffersize = actualsize;
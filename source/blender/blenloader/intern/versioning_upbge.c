@@ -398,4 +398,9 @@ void blo_do_versions_upbge(FileData *fd, Library *lib, Main *bmain)
       }
     }
   }
+  if (!DNA_struct_elem_find(fd->filesdna, "ObjectActivityCulling", "short", "logicLodInterval")) {
+    LISTBASE_FOREACH (Object *, ob, &bmain->objects) {
+      ob->activityCulling.logicLodInterval = 4;
+    }
+  }
 }
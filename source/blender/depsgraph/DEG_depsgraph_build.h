@@ -75,6 +75,9 @@ void DEG_graph_tag_relations_update(struct Depsgraph *graph);
 /* Create or update relations in the specified graph. */
 void DEG_graph_relations_update(struct Depsgraph *graph);
 
+/* Check whether relations of the graph are tagged for update. */
+bool DEG_graph_relations_need_update(const struct Depsgraph *graph);
+
 /* Tag all relations in the database for update. */
 void DEG_relations_tag_update(struct Main *bmain);
 
@@ -807,6 +807,10 @@ void DepsgraphNodeBuilder::build_object(int base_index,
   /* Proxy object to copy from. */
   build_object_proxy_from(object, is_visible);
   build_object_proxy_group(object, is_visible);
+  /* Object instanced by the game engine. */
+  if (object->runtime.game_instance_object != nullptr) {
+    build_object(-1, object->runtime.game_instance_object, DEG_ID_LINKED_INDIRECTLY, is_visible);
+  }
   /* Object dupligroup. */
   if (object->instance_collection != nullptr) {
     build_object_instance_collection(object, is_visible);
@@ -783,6 +783,10 @@ void DepsgraphRelationBuilder::build_object(Object *object)
   /* Proxy object to copy from. */
   build_object_proxy_from(object);
   build_object_proxy_group(object);
+  /* Object instanced by the game engine. */
+  if (object->runtime.game_instance_object != nullptr) {
+    build_object(object->runtime.game_instance_object);
+  }
   /* Object dupligroup. */
   if (object->instance_collection != nullptr) {
     build_collection(nullptr, object, object->instance_collection);
@@ -312,6 +312,12 @@ void DEG_graph_relations_update(Depsgraph *graph)
   DEG_graph_build_from_view_layer(graph);
 }
 
+bool DEG_graph_relations_need_update(const Depsgraph *graph)
+{
+  const deg::Depsgraph *deg_graph = (const deg::Depsgraph *)graph;
+  return deg_graph->need_update;
+}
+
 /* Tag all relations for update. */
 void DEG_relations_tag_update(Main *bmain)
 {
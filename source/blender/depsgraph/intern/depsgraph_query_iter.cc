@@ -174,6 +174,10 @@ bool deg_iterator_duplis_step(DEGObjectIterData *data)
 
     /* Duplicated elements shouldn't care whether their original collection is visible or not. */
     temp_dupli_object->base_flag |= BASE_VISIBLE_DEPSGRAPH;
+    /* The game engine instances objects of inactive layers, as it does for its replicas. */
+    if (dob->type == OB_DUPLIGAME) {
+      temp_dupli_object->visibility_flag &= ~OB_HIDE_VIEWPORT;
+    }
 
     int ob_visibility = BKE_object_visibility(temp_dupli_object, data->eval_mode);
     if ((ob_visibility & (OB_VISIBLE_SELF | OB_VISIBLE_PARTICLES)) == 0) {
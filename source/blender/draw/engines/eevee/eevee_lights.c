@@ -139,9 +139,33 @@ static float light_shape_power_volume_get(const Light *la,
 }
 
 /* Update buffer with light data */
-static void eevee_light_setup(Object *ob, EEVEE_Light *evli)
+/* Light data of an object with the parameters changed by the game, r_la stores the changed
+ * copy. */
+static const Light *light_game_data_get(Object *ob, Light *r_la)
 {
   const Light *la = (Light *)ob->data;
+  const DRWGameLight *game_light = DRW_game_light_get(ob);
+  if (game_light == NULL) {
+    return la;
+  }
+
+  *r_la = *la;
+  copy_v3_v3(&r_la->r, game_light->color);
+  r_la->energy = game_light->energy;
+  if (game_light->distance > 0.0f) {
+    r_la->mode |= LA_CUSTOM_ATTENUATION;
+    r_la->att_dist = game_light->distance;
+  }
+  else {
+    r_la->mode &= ~LA_CUSTOM_ATTENUATION;
+  }
+  r_la->spotsize = game_light->spot_size;
+  r_la->spotblend = game_light->spot_blend;
+  return r_la;
+}
+
+static void eevee_light_setup(Object *ob, const Light *la, EEVEE_Light *evli)
+{
   float mat[4][4], scale[3];
 
   const DRWContextState *draw_ctx = DRW_context_state_get();
@@ -219,7 +243,8 @@ void EEVEE_lights_cache_init(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
 void EEVEE_lights_cache_add(EEVEE_ViewLayerData *sldata, Object *ob)
 {
   EEVEE_LightsInfo *linfo = sldata->lights;
-  const Light *la = (Light *)ob->data;
+  Light game_la;
+  const Light *la = light_game_data_get(ob, &game_la);
 
   if (linfo->num_light >= MAX_LIGHT) {
     printf("Too many lights in the scene !!!\n");
@@ -232,7 +257,7 @@ void EEVEE_lights_cache_add(EEVEE_ViewLayerData *sldata, Object *ob)
   }
 
   EEVEE_Light *evli = linfo->light_data + linfo->num_light;
-  eevee_light_setup(ob, evli);
+  eevee_light_setup(ob, la, evli);
 
   if (la->mode & LA_SHADOW) {
     if (la->type == LA_SUN) {
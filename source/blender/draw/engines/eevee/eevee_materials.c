@@ -60,12 +60,15 @@ typedef struct EeveeMaterialCache {
   struct DRWShadingGroup *depth_grp;
   struct DRWShadingGroup *shading_grp;
   struct DRWShadingGroup *shadow_grp;
+  /* Shadow group of the casters moved by the game when the static shadows are cached. */
+  struct DRWShadingGroup *shadow_dynamic_grp;
   struct GPUMaterial *shading_gpumat;
   /* Meh, Used by hair to ensure draw order when calling DRW_shgroup_create_sub.
    * Pointers to ghash values. */
   struct DRWShadingGroup **depth_grp_p;
   struct DRWShadingGroup **shading_grp_p;
   struct DRWShadingGroup **shadow_grp_p;
+  struct DRWShadingGroup **shadow_dynamic_grp_p;
 } EeveeMaterialCache;
 
 /* *********** FUNCTIONS *********** */
@@ -466,13 +469,42 @@ void EEVEE_materials_cache_init(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
   }
 }
 
+BLI_INLINE DRWShadingGroup *material_shadow_grp(EEVEE_Data *vedata,
+                                                EEVEE_ViewLayerData *sldata,
+                                                GPUMaterial *gpumat,
+                                                DRWPass *pass,
+                                                int option,
+                                                DRWShadingGroup ***r_grp_p)
+{
+  EEVEE_PrivateData *pd = vedata->stl->g_data;
+
+  /* Search for the same shaders usage in the pass. */
+  struct GPUShader *sh = GPU_material_get_shader(gpumat);
+  void *cache_key = (char *)sh + option;
+  DRWShadingGroup *grp, **grp_p;
+
+  if (BLI_ghash_ensure_p(pd->material_hash, cache_key, (void ***)&grp_p)) {
+    /* This GPUShader has already been used by another material.
+     * Add new shading group just after to avoid shader switching cost. */
+    grp = DRW_shgroup_create_sub(*grp_p);
+  }
+  else {
+    *grp_p = grp = DRW_shgroup_create(sh, pass);
+    EEVEE_material_bind_resources(grp, gpumat, sldata, vedata, NULL, NULL, false, false);
+  }
+
+  DRW_shgroup_add_material_resources(grp, gpumat);
+
+  *r_grp_p = grp_p;
+  return grp;
+}
+
 BLI_INLINE void material_shadow(EEVEE_Data *vedata,
                                 EEVEE_ViewLayerData *sldata,
                                 Material *ma,
                                 bool is_hair,
                                 EeveeMaterialCache *emc)
 {
-  EEVEE_PrivateData *pd = vedata->stl->g_data;
   EEVEE_PassList *psl = vedata->psl;
   const DRWContextState *draw_ctx = DRW_context_state_get();
   Scene *scene = draw_ctx->scene;
@@ -492,29 +524,27 @@ BLI_INLINE void material_shadow(EEVEE_Data *vedata,
     int option = KEY_SHADOW;
     SET_FLAG_FROM_TEST(option, is_hair, KEY_HAIR);
 
-    /* Search for the same shaders usage in the pass. */
-    struct GPUShader *sh = GPU_material_get_shader(gpumat);
-    void *cache_key = (char *)sh + option;
-    DRWShadingGroup *grp, **grp_p;
+    emc->shadow_grp = material_shadow_grp(
+        vedata, sldata, gpumat, psl->shadow_pass, option, &emc->shadow_grp_p);
 
-    if (BLI_ghash_ensure_p(pd->material_hash, cache_key, (void ***)&grp_p)) {
-      /* This GPUShader has already been used by another material.
-       * Add new shading group just after to avoid shader switching cost. */
-      grp = DRW_shgroup_create_sub(*grp_p);
+    if (sldata->lights->static_shadows) {
+      emc->shadow_dynamic_grp = material_shadow_grp(vedata,
+                                                    sldata,
+                                                    gpumat,
+                                                    psl->shadow_dynamic_pass,
+                                                    option | KEY_SHADOW_DYNAMIC,
+                                                    &emc->shadow_dynamic_grp_p);
     }
     else {
-      *grp_p = grp = DRW_shgroup_create(sh, psl->shadow_pass);
-      EEVEE_material_bind_resources(grp, gpumat, sldata, vedata, NULL, NULL, false, false);
+      emc->shadow_dynamic_grp = NULL;
+      emc->shadow_dynamic_grp_p = NULL;
     }
-
-    DRW_shgroup_add_material_resources(grp, gpumat);
-
-    emc->shadow_grp = grp;
-    emc->shadow_grp_p = grp_p;
   }
   else {
     emc->shadow_grp = NULL;
     emc->shadow_grp_p = NULL;
+    emc->shadow_dynamic_grp = NULL;
+    emc->shadow_dynamic_grp_p = NULL;
   }
 }
 
@@ -755,6 +785,11 @@ BLI_INLINE EeveeMaterialCache eevee_material_cache_get(
       matcache = material_opaque(vedata, sldata, ma, is_hair);
       break;
   }
+  /* The casters moved by the game are drawn over the cached shadows of the static casters. */
+  if (matcache.shadow_dynamic_grp && DRW_game_object_is_dynamic(ob)) {
+    matcache.shadow_grp = matcache.shadow_dynamic_grp;
+    matcache.shadow_grp_p = matcache.shadow_dynamic_grp_p;
+  }
   return matcache;
 }
 
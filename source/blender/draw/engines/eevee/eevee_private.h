@@ -201,6 +201,7 @@ enum {
   KEY_REFRACT = (1 << 1),
   KEY_HAIR = (1 << 2),
   KEY_SHADOW = (1 << 3),
+  KEY_SHADOW_DYNAMIC = (1 << 4),
 };
 
 /* DOF Gather pass shader variations */
@@ -253,6 +254,8 @@ typedef struct EEVEE_BoundBox {
 typedef struct EEVEE_PassList {
   /* Shadows */
   struct DRWPass *shadow_pass;
+  /* Casters moved by the game when the static shadows are cached. */
+  struct DRWPass *shadow_dynamic_pass;
   struct DRWPass *shadow_accum_pass;
 
   /* Probes */
@@ -563,6 +566,8 @@ BLI_STATIC_ASSERT(sizeof(EEVEE_Shadow) * MAX_SHADOW +
 typedef struct EEVEE_ShadowCasterBuffer {
   struct EEVEE_BoundBox *bbox;
   BLI_bitmap *update;
+  /* Casters moved by the game, drawn over the cached static shadows. */
+  BLI_bitmap *dynamic;
   uint alloc_count;
   uint count;
 } EEVEE_ShadowCasterBuffer;
@@ -575,6 +580,8 @@ typedef struct EEVEE_LightsInfo {
   int cube_len, cascade_len, shadow_len;
   int shadow_cube_size, shadow_cascade_size;
   bool shadow_high_bitdepth, soft_shadows;
+  /* Game only: the shadows of the static casters are cached, see DRW_game_dynamic_objects_set. */
+  bool static_shadows;
   /* UBO Storage : data used by UBO */
   struct EEVEE_Light light_data[MAX_LIGHT];
   struct EEVEE_Shadow shadow_data[MAX_SHADOW];
@@ -585,8 +592,13 @@ typedef struct EEVEE_LightsInfo {
   /* Back index in light_data. */
   uchar shadow_cube_light_indices[MAX_SHADOW_CUBE];
   uchar shadow_cascade_light_indices[MAX_SHADOW_CASCADE];
+  /* Light of each cube at its last update, the lights culled by the game change the cubes of
+   * the next lights. */
+  const struct EEVEE_LightEngineData *shadow_cube_owners[MAX_SHADOW_CUBE];
   /* Update bitmap. */
   BLI_bitmap sh_cube_update[BLI_BITMAP_SIZE(MAX_SHADOW_CUBE)];
+  /* Cubes of which the cached static shadows must be redrawn too. */
+  BLI_bitmap sh_cube_static_update[BLI_BITMAP_SIZE(MAX_SHADOW_CUBE)];
   /* Lights tracking */
   struct BoundSphere shadow_bounds[MAX_LIGHT]; /* Tightly packed light bounds. */
   /* List of bbox and update bitmap. Double buffered. */
@@ -936,8 +948,11 @@ typedef struct EEVEE_ViewLayerData {
   struct GPUUniformBuf *shadow_samples_ubo;
 
   struct GPUFrameBuffer *shadow_fb;
+  struct GPUFrameBuffer *shadow_static_fb;
 
   struct GPUTexture *shadow_cube_pool;
+  /* Shadows of the static casters only, copied before drawing the dynamic casters. */
+  struct GPUTexture *shadow_cube_static_pool;
   struct GPUTexture *shadow_cascade_pool;
 
   struct EEVEE_ShadowCasterBuffer shcasters_buffers[2];
@@ -979,6 +994,8 @@ typedef struct EEVEE_LightEngineData {
   DrawData dd;
 
   bool need_update;
+  /* Game only: changes of the light parameters at the last shadow update, see DRWGameLight. */
+  unsigned int game_changes;
 } EEVEE_LightEngineData;
 
 typedef struct EEVEE_LightProbeEngineData {
@@ -996,6 +1013,8 @@ typedef struct EEVEE_ObjectEngineData {
 
   bool need_update;
   bool geom_update;
+  /* The caster was drawn in the dynamic shadow pass at the last registration. */
+  bool dynamic_caster;
   uint shadow_caster_id;
 } EEVEE_ObjectEngineData;
 
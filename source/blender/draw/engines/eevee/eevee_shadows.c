@@ -56,6 +56,7 @@ void EEVEE_shadows_init(EEVEE_ViewLayerData *sldata)
       sldata->shcasters_buffers[i].bbox = MEM_mallocN(
           sizeof(EEVEE_BoundBox) * SH_CASTER_ALLOC_CHUNK, __func__);
       sldata->shcasters_buffers[i].update = BLI_BITMAP_NEW(SH_CASTER_ALLOC_CHUNK, __func__);
+      sldata->shcasters_buffers[i].dynamic = BLI_BITMAP_NEW(SH_CASTER_ALLOC_CHUNK, __func__);
       sldata->shcasters_buffers[i].alloc_count = SH_CASTER_ALLOC_CHUNK;
       sldata->shcasters_buffers[i].count = 0;
     }
@@ -88,9 +89,17 @@ void EEVEE_shadows_init(EEVEE_ViewLayerData *sldata)
     CLAMP(sh_cascade_size, 1, 4096);
   }
 
+  const bool static_shadows = DRW_game_static_shadows_get();
+  if ((linfo->static_shadows != static_shadows) || (linfo->shadow_cube_size != sh_cube_size) ||
+      (linfo->shadow_high_bitdepth != sh_high_bitdepth)) {
+    /* The casters changed of shadow pass, or the cached shadows are of the wrong size. */
+    DRW_TEXTURE_FREE_SAFE(sldata->shadow_cube_static_pool);
+  }
+
   linfo->shadow_high_bitdepth = sh_high_bitdepth;
   linfo->shadow_cube_size = sh_cube_size;
   linfo->shadow_cascade_size = sh_cascade_size;
+  linfo->static_shadows = static_shadows;
 }
 
 void EEVEE_shadows_cache_init(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
@@ -120,6 +129,8 @@ void EEVEE_shadows_cache_init(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
 
     stl->g_data->shadow_shgrp = DRW_shgroup_create(EEVEE_shaders_shadow_sh_get(),
                                                    psl->shadow_pass);
+
+    DRW_PASS_CREATE(psl->shadow_dynamic_pass, state);
   }
 }
 
@@ -130,6 +141,9 @@ void EEVEE_shadows_caster_register(EEVEE_ViewLayerData *sldata, Object *ob)
   EEVEE_ShadowCasterBuffer *backbuffer = linfo->shcaster_backbuffer;
   EEVEE_ShadowCasterBuffer *frontbuffer = linfo->shcaster_frontbuffer;
   bool update = true;
+  const bool dynamic = DRW_game_object_is_dynamic(ob);
+  /* The caster changed of shadow pass, the cached static shadows must be redrawn. */
+  bool static_change = false;
   int id = frontbuffer->count;
 
   /* Make sure shadow_casters is big enough. */
@@ -139,6 +153,7 @@ void EEVEE_shadows_caster_register(EEVEE_ViewLayerData *sldata, Object *ob)
     frontbuffer->bbox = MEM_reallocN(frontbuffer->bbox,
                                      sizeof(EEVEE_BoundBox) * frontbuffer->alloc_count);
     BLI_BITMAP_RESIZE(frontbuffer->update, frontbuffer->alloc_count);
+    BLI_BITMAP_RESIZE(frontbuffer->dynamic, frontbuffer->alloc_count);
   }
 
   if (ob->base_flag & BASE_FROM_DUPLI) {
@@ -150,17 +165,20 @@ void EEVEE_shadows_caster_register(EEVEE_ViewLayerData *sldata, Object *ob)
     EEVEE_ObjectEngineData *oedata = EEVEE_object_data_ensure(ob);
     int past_id = oedata->shadow_caster_id;
     oedata->shadow_caster_id = id;
+    static_change = (oedata->dynamic_caster != dynamic);
+    oedata->dynamic_caster = dynamic;
     /* Update flags in backbuffer. */
     if (past_id > -1 && past_id < backbuffer->count) {
-      BLI_BITMAP_SET(backbuffer->update, past_id, oedata->need_update);
+      BLI_BITMAP_SET(backbuffer->update, past_id, oedata->need_update || static_change);
     }
-    update = oedata->need_update;
+    update = oedata->need_update || static_change;
     oedata->need_update = false;
   }
 
   if (update) {
     BLI_BITMAP_ENABLE(frontbuffer->update, id);
   }
+  BLI_BITMAP_SET(frontbuffer->dynamic, id, dynamic && !static_change);
 
   /* Update World AABB in frontbuffer. */
   BoundBox *bb = BKE_object_boundbox_get(ob);
@@ -215,9 +233,11 @@ void EEVEE_shadows_update(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
   /* Free textures if number mismatch. */
   if (linfo->num_cube_layer != linfo->cache_num_cube_layer) {
     DRW_TEXTURE_FREE_SAFE(sldata->shadow_cube_pool);
+    DRW_TEXTURE_FREE_SAFE(sldata->shadow_cube_static_pool);
     linfo->cache_num_cube_layer = linfo->num_cube_layer;
     /* Update all lights. */
     BLI_bitmap_set_all(&linfo->sh_cube_update[0], true, MAX_LIGHT);
+    BLI_bitmap_set_all(&linfo->sh_cube_static_update[0], true, MAX_SHADOW_CUBE);
   }
 
   if (linfo->num_cascade_layer != linfo->cache_num_cascade_layer) {
@@ -234,6 +254,19 @@ void EEVEE_shadows_update(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
                                                            NULL);
   }
 
+  if (linfo->static_shadows && !sldata->shadow_cube_static_pool) {
+    sldata->shadow_cube_static_pool = DRW_texture_create_2d_array(
+        linfo->shadow_cube_size,
+        linfo->shadow_cube_size,
+        max_ii(1, linfo->num_cube_layer * 6),
+        shadow_pool_format,
+        0,
+        NULL);
+    /* Draw again the static casters of all lights. */
+    BLI_bitmap_set_all(&linfo->sh_cube_update[0], true, MAX_SHADOW_CUBE);
+    BLI_bitmap_set_all(&linfo->sh_cube_static_update[0], true, MAX_SHADOW_CUBE);
+  }
+
   if (!sldata->shadow_cascade_pool) {
     sldata->shadow_cascade_pool = DRW_texture_create_2d_array(linfo->shadow_cascade_size,
                                                               linfo->shadow_cascade_size,
@@ -247,12 +280,17 @@ void EEVEE_shadows_update(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
     sldata->shadow_fb = GPU_framebuffer_create("shadow_fb");
   }
 
+  if (linfo->static_shadows && sldata->shadow_static_fb == NULL) {
+    sldata->shadow_static_fb = GPU_framebuffer_create("shadow_static_fb");
+  }
+
   /* Gather all light own update bits. to avoid costly intersection check. */
   for (int j = 0; j < linfo->cube_len; j++) {
     const EEVEE_Light *evli = linfo->light_data + linfo->shadow_cube_light_indices[j];
     /* Setup shadow cube in UBO and tag for update if necessary. */
     if (EEVEE_shadows_cube_setup(linfo, evli, effects->taa_current_sample - 1)) {
       BLI_BITMAP_ENABLE(&linfo->sh_cube_update[0], j);
+      BLI_BITMAP_ENABLE(&linfo->sh_cube_static_update[0], j);
     }
   }
 
@@ -263,10 +301,13 @@ void EEVEE_shadows_update(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
   for (int i = 0; i < backbuffer->count; i++) {
     /* If the shadow-caster has been deleted or updated. */
     if (BLI_BITMAP_TEST(backbuffer->update, i)) {
+      BLI_bitmap *cube_update = BLI_BITMAP_TEST(backbuffer->dynamic, i) ?
+                                    linfo->sh_cube_update :
+                                    linfo->sh_cube_static_update;
       for (int j = 0; j < linfo->cube_len; j++) {
-        if (!BLI_BITMAP_TEST(&linfo->sh_cube_update[0], j)) {
+        if (!BLI_BITMAP_TEST(cube_update, j)) {
           if (sphere_bbox_intersect(&bsphere[j], &bbox[i])) {
-            BLI_BITMAP_ENABLE(&linfo->sh_cube_update[0], j);
+            BLI_BITMAP_ENABLE(cube_update, j);
           }
         }
       }
@@ -277,15 +318,21 @@ void EEVEE_shadows_update(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
   for (int i = 0; i < frontbuffer->count; i++) {
     /* If the shadow-caster has been updated. */
     if (BLI_BITMAP_TEST(frontbuffer->update, i)) {
+      BLI_bitmap *cube_update = BLI_BITMAP_TEST(frontbuffer->dynamic, i) ?
+                                    linfo->sh_cube_update :
+                                    linfo->sh_cube_static_update;
       for (int j = 0; j < linfo->cube_len; j++) {
-        if (!BLI_BITMAP_TEST(&linfo->sh_cube_update[0], j)) {
+        if (!BLI_BITMAP_TEST(cube_update, j)) {
           if (sphere_bbox_intersect(&bsphere[j], &bbox[i])) {
-            BLI_BITMAP_ENABLE(&linfo->sh_cube_update[0], j);
+            BLI_BITMAP_ENABLE(cube_update, j);
           }
         }
       }
     }
   }
+  /* Without cached static shadows all the casters are static. Drawing the static casters of a
+   * cube updates it entirely. */
+  BLI_bitmap_or_all(linfo->sh_cube_update, linfo->sh_cube_static_update, MAX_SHADOW_CUBE);
 
   /* Resize shcasters buffers if too big. */
   if (frontbuffer->alloc_count - frontbuffer->count > SH_CASTER_ALLOC_CHUNK) {
@@ -297,6 +344,7 @@ void EEVEE_shadows_update(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
     frontbuffer->bbox = MEM_reallocN(frontbuffer->bbox,
                                      sizeof(EEVEE_BoundBox) * frontbuffer->alloc_count);
     BLI_BITMAP_RESIZE(frontbuffer->update, frontbuffer->alloc_count);
+    BLI_BITMAP_RESIZE(frontbuffer->dynamic, frontbuffer->alloc_count);
   }
 }
 
@@ -40,10 +40,23 @@ void EEVEE_shadows_cube_add(EEVEE_LightsInfo *linfo, EEVEE_Light *evli, Object *
       update = true;
       led->need_update = false;
     }
+    const DRWGameLight *game_light = DRW_game_light_get(ob);
+    if (game_light && game_light->changes != led->game_changes) {
+      update = true;
+      led->game_changes = game_light->changes;
+    }
+    if (linfo->shadow_cube_owners[linfo->cube_len] != led) {
+      update = true;
+      linfo->shadow_cube_owners[linfo->cube_len] = led;
+    }
+  }
+  else {
+    linfo->shadow_cube_owners[linfo->cube_len] = NULL;
   }
 
   if (update) {
     BLI_BITMAP_ENABLE(&linfo->sh_cube_update[0], linfo->cube_len);
+    BLI_BITMAP_ENABLE(&linfo->sh_cube_static_update[0], linfo->cube_len);
   }
 
   sh_data->near = max_ff(la->clipsta, 1e-8f);
@@ -188,6 +201,7 @@ void EEVEE_shadows_draw_cubemap(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata,
   EEVEE_Light *evli = linfo->light_data + linfo->shadow_cube_light_indices[cube_index];
   EEVEE_Shadow *shdw_data = linfo->shadow_data + (int)evli->shadow_id;
   EEVEE_ShadowCube *cube_data = linfo->shadow_cube_data + (int)shdw_data->type_data_id;
+  const bool static_update = BLI_BITMAP_TEST(linfo->sh_cube_static_update, cube_index);
 
   eevee_ensure_cube_views(shdw_data->near,
                           shdw_data->far,
@@ -215,6 +229,23 @@ void EEVEE_shadows_draw_cubemap(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata,
 
     DRW_view_set_active(g_data->cube_views[j]);
     int layer = cube_index * 6 + j;
+    if (linfo->static_shadows) {
+      /* Copy the cached shadows of the static casters, drawn again only if they changed, and draw
+       * the dynamic casters over them. */
+      GPU_framebuffer_texture_layer_attach(
+          sldata->shadow_static_fb, sldata->shadow_cube_static_pool, 0, layer, 0);
+      if (static_update) {
+        GPU_framebuffer_bind(sldata->shadow_static_fb);
+        GPU_framebuffer_clear_depth(sldata->shadow_static_fb, 1.0f);
+        DRW_draw_pass(psl->shadow_pass);
+      }
+      GPU_framebuffer_texture_layer_attach(
+          sldata->shadow_fb, sldata->shadow_cube_pool, 0, layer, 0);
+      GPU_framebuffer_blit(sldata->shadow_static_fb, 0, sldata->shadow_fb, 0, GPU_DEPTH_BIT);
+      GPU_framebuffer_bind(sldata->shadow_fb);
+      DRW_draw_pass(psl->shadow_dynamic_pass);
+      continue;
+    }
     GPU_framebuffer_texture_layer_attach(sldata->shadow_fb, sldata->shadow_cube_pool, 0, layer, 0);
     GPU_framebuffer_bind(sldata->shadow_fb);
     GPU_framebuffer_clear_depth(sldata->shadow_fb, 1.0f);
@@ -222,4 +253,5 @@ void EEVEE_shadows_draw_cubemap(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata,
   }
 
   BLI_BITMAP_SET(&linfo->sh_cube_update[0], cube_index, false);
+  BLI_BITMAP_SET(&linfo->sh_cube_static_update[0], cube_index, false);
 }
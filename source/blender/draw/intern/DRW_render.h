@@ -71,6 +71,8 @@ struct GPUMaterial;
 struct GPUShader;
 struct GPUTexture;
 struct GPUUniformBuf;
+struct GHash;
+struct GSet;
 struct Object;
 struct ParticleSystem;
 struct RenderEngineType;
@@ -788,7 +790,8 @@ void DRW_game_render_loop(struct bContext *C,
                           struct Depsgraph *depsgraph,
                           const struct rcti *window,
                           bool is_overlay_pass,
-                          bool called_from_constructor);
+                          bool called_from_constructor,
+                          int samples);
 
 void DRW_game_render_loop_end(void);
 void DRW_game_python_loop_end(struct ViewLayer *view_layer);
@@ -800,6 +803,61 @@ void DRW_transform_to_display(struct GPUTexture *tex,
 void DRW_transform_to_display_image_render(struct GPUTexture *tex);
 void DRW_game_gpu_viewport_set(struct GPUViewport *viewport);
 struct GPUViewport *DRW_game_gpu_viewport_get(void);
+void DRW_game_culled_objects_set(struct GSet *culled_objects);
+/* Original objects of the overlay collections drawn by the next overlay pass instead of
+ * iterating all the depsgraph objects, NULL iterates the depsgraph. With use_workbench the
+ * overlay pass is drawn unlit by the workbench engine instead of EEVEE. */
+void DRW_game_overlay_pass_set(struct Object **objects, int objects_len, bool use_workbench);
+/* Update the world in the next render loop, to call when the world or its node tree was
+ * tagged since the last evaluation. The render loops skip the world update otherwise. */
+void DRW_game_world_update_tag(void);
+/* Other views drawn by the next render loop from the same populated caches, e.g. the second
+ * eye of a stereo camera. Each view is drawn with its matrices then its color and depth are
+ * copied into its target, of the size of the viewport. The view of the context is drawn last
+ * and stays in the viewport. The temporal anti-aliasing restarts at each frame as the history
+ * is shared by the views. */
+void DRW_game_extra_views_set(const float (*viewmats)[4][4],
+                              const float (*winmats)[4][4],
+                              struct GPUFrameBuffer **targets,
+                              int views_len);
+/* Original objects moved by the game for the next render loop, the shadows of the other
+ * objects are cached and only the moved objects are drawn when a shadow map is updated.
+ * NULL disables the cached static shadows. */
+void DRW_game_dynamic_objects_set(struct GSet *dynamic_objects);
+bool DRW_game_static_shadows_get(void);
+bool DRW_game_object_is_dynamic(struct Object *ob);
+/* Parameters of a light changed by the game, used by EEVEE instead of the evaluated light data
+ * without depsgraph update. */
+typedef struct DRWGameLight {
+  float color[3];
+  float energy;
+  /* Influence distance, 0 for the distance of the scene light threshold. */
+  float distance;
+  float spot_size;
+  float spot_blend;
+  /* Incremented at each change, the shadows of the light are then redrawn. */
+  unsigned int changes;
+} DRWGameLight;
+/* Original light objects changed by the game for the next render loop, mapped to their
+ * DRWGameLight. NULL uses the evaluated data of all the lights. */
+void DRW_game_lights_set(struct GHash *lights);
+const DRWGameLight *DRW_game_light_get(struct Object *ob);
+/* Share the temporary textures of the engines between the viewports created after, the
+ * viewports drawn one after the other reuse the same textures. Only the textures persistent
+ * between frames like the temporal anti-aliasing history stay per viewport. Disabling it
+ * must be done after freeing the viewports using the pool. */
+void DRW_game_shared_texture_pool_set(bool enable);
+/* Delete the shared textures not used during the last frames, called once per frame. */
+void DRW_game_shared_texture_pool_free_unused(int max_unused_frames);
+
+/* Queue the materials compiled while the game is running instead of compiling them when
+ * first drawn. Disabling it compiles the queued materials. */
+void DRW_game_deferred_compilation_set(bool enable);
+bool DRW_game_deferred_compilation_get(void);
+/* Compile the queued materials until the time budget in seconds is spent, a negative budget
+ * compiles all the materials. Return the number of materials still queued. */
+int DRW_game_deferred_shaders_compile(double time_budget);
+int DRW_game_deferred_shaders_count(void);
 /**************************END OF GAME ENGINE*******************************/
 
 #ifdef __cplusplus
@@ -243,6 +243,20 @@ void DRW_debug_line_bge(const float v1[3], const float v2[3], const float color[
   BLI_LINKS_PREPEND(DST.debug_bge.lines, line);
 }
 
+void DRW_debug_lines_bge(const float (*pos)[3], const float (*color)[4], const int vert_len)
+{
+  DRWDebugLines3D *lines = MEM_mallocN(
+      sizeof(DRWDebugLines3D) + sizeof(float[7]) * vert_len, "DRWDebugLines3D");
+  lines->vert_len = vert_len;
+  lines->pos = (float(*)[3])(lines + 1);
+  lines->color = (float(*)[4])(lines->pos + vert_len);
+  for (int i = 0; i < vert_len; i++) {
+    mul_v3_m4v3(lines->pos[i], g_modelmat, pos[i]);
+  }
+  memcpy(lines->color, color, sizeof(float[4]) * vert_len);
+  BLI_LINKS_PREPEND(DST.debug_bge.lines3D, lines);
+}
+
 void DRW_debug_box_2D_bge(const float xco, const float yco, const float xsize, const float ysize)
 {
   DRWDebugBox2D *box = MEM_mallocN(sizeof(DRWDebugBox2D), "DRWDebugBox");
@@ -253,6 +267,18 @@ void DRW_debug_box_2D_bge(const float xco, const float yco, const float xsize, c
   BLI_LINKS_PREPEND(DST.debug_bge.boxes, box);
 }
 
+void DRW_debug_lines_2D_bge(const float (*pos)[2], const float (*color)[4], const int vert_len)
+{
+  DRWDebugLines2D *lines = MEM_mallocN(
+      sizeof(DRWDebugLines2D) + sizeof(float[6]) * vert_len, "DRWDebugLines2D");
+  lines->vert_len = vert_len;
+  lines->pos = (float(*)[2])(lines + 1);
+  lines->color = (float(*)[4])(lines->pos + vert_len);
+  memcpy(lines->pos, pos, sizeof(float[2]) * vert_len);
+  memcpy(lines->color, color, sizeof(float[4]) * vert_len);
+  BLI_LINKS_PREPEND(DST.debug_bge.lines2D, lines);
+}
+
 void DRW_debug_text_2D_bge(const float xco, const float yco, const char *str)
 {
   DRWDebugText2D *text = MEM_mallocN(sizeof(DRWDebugText2D), "DRWDebugText2D");
@@ -264,7 +290,10 @@ void DRW_debug_text_2D_bge(const float xco, const float yco, const char *str)
 
 static void drw_debug_draw_lines_bge(void)
 {
-  int count = BLI_linklist_count((LinkNode *)DST.debug_bge.lines);
+  int count = BLI_linklist_count((LinkNode *)DST.debug_bge.lines) * 2;
+  for (DRWDebugLines3D *lines = DST.debug_bge.lines3D; lines; lines = lines->next) {
+    count += lines->vert_len;
+  }
 
   if (count == 0) {
     return;
@@ -279,7 +308,18 @@ static void drw_debug_draw_lines_bge(void)
   GPU_line_smooth(true);
   GPU_line_width(1.0f);
 
-  immBegin(GPU_PRIM_LINES, count * 2);
+  immBegin(GPU_PRIM_LINES, count);
+
+  while (DST.debug_bge.lines3D) {
+    void *next = DST.debug_bge.lines3D->next;
+    DRWDebugLines3D *lines = DST.debug_bge.lines3D;
+    for (int i = 0; i < lines->vert_len; i++) {
+      immAttr4fv(col, lines->color[i]);
+      immVertex3fv(pos, lines->pos[i]);
+    }
+    MEM_freeN(DST.debug_bge.lines3D);
+    DST.debug_bge.lines3D = next;
+  }
 
   while (DST.debug_bge.lines) {
     void *next = DST.debug_bge.lines->next;
@@ -331,6 +371,46 @@ static void drw_debug_draw_boxes_bge(void)
   immUnbindProgram();
 }
 
+static void drw_debug_draw_lines_2D_bge(void)
+{
+  int count = 0;
+  for (DRWDebugLines2D *lines = DST.debug_bge.lines2D; lines; lines = lines->next) {
+    count += lines->vert_len;
+  }
+
+  if (count == 0) {
+    return;
+  }
+
+  GPUVertFormat *format = immVertexFormat();
+  uint pos = GPU_vertformat_attr_add(format, "pos", GPU_COMP_F32, 2, GPU_FETCH_FLOAT);
+  uint col = GPU_vertformat_attr_add(format, "color", GPU_COMP_F32, 4, GPU_FETCH_FLOAT);
+
+  const float *size = DRW_viewport_size_get();
+  const unsigned int width = size[0];
+  const unsigned int height = size[1];
+  GPU_matrix_reset();
+  GPU_matrix_ortho_set(0, width, 0, height, -100, 100);
+
+  immBindBuiltinProgram(GPU_SHADER_2D_FLAT_COLOR);
+
+  immBegin(GPU_PRIM_LINES, count);
+
+  while (DST.debug_bge.lines2D) {
+    void *next = DST.debug_bge.lines2D->next;
+    DRWDebugLines2D *lines = DST.debug_bge.lines2D;
+    for (int i = 0; i < lines->vert_len; i++) {
+      immAttr4fv(col, lines->color[i]);
+      immVertex2fv(pos, lines->pos[i]);
+    }
+    MEM_freeN(DST.debug_bge.lines2D);
+    DST.debug_bge.lines2D = next;
+  }
+  immEnd();
+
+  immUnbindProgram();
+}
+
 static void drw_debug_draw_text_bge(void)
 {
   int count = BLI_linklist_count((LinkNode *)DST.debug_bge.texts);
@@ -371,6 +451,7 @@ void drw_debug_draw_bge(void)
 {
   drw_debug_draw_lines_bge();
   drw_debug_draw_boxes_bge();
+  drw_debug_draw_lines_2D_bge();
   drw_debug_draw_text_bge();
 }
 
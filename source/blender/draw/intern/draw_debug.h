@@ -40,7 +40,11 @@ void DRW_debug_sphere(const float center[3], const float radius, const float col
 
 /* UPBGE */
 void DRW_debug_line_bge(const float v1[3], const float v2[3], const float color[4]);
+/* Lines given by pairs of vertices, drawn in the same batch as the single lines. */
+void DRW_debug_lines_bge(const float (*pos)[3], const float (*color)[4], const int vert_len);
 void DRW_debug_box_2D_bge(const float xco, const float yco, const float xsize, const float ysize);
+/* Lines given by pairs of vertices, all the lines are drawn in a single batch. */
+void DRW_debug_lines_2D_bge(const float (*pos)[2], const float (*color)[4], const int vert_len);
 void DRW_debug_text_2D_bge(const float xco, const float yco, const char *str);
 
 #ifdef __cplusplus
@@ -23,6 +23,7 @@
 #include <stdio.h>
 
 #include "BLI_alloca.h"
+#include "BLI_ghash.h"
 #include "BLI_listbase.h"
 #include "BLI_memblock.h"
 #include "BLI_rect.h"
@@ -409,11 +410,20 @@ static void draw_unit_state_create(void)
   DRW_handle_increment(&DST.resource_handle);
 }
 
+/* Texture pool shared by the viewports of the game engine cameras (UPBGE). */
+static DRWTexturePool *game_texture_pool = NULL;
+
 DRWData *DRW_viewport_data_create(void)
 {
   DRWData *drw_data = MEM_callocN(sizeof(DRWData), "DRWData");
 
-  drw_data->texture_pool = DRW_texture_pool_create();
+  if (game_texture_pool) {
+    drw_data->texture_pool = game_texture_pool;
+    drw_data->shared_texture_pool = true;
+  }
+  else {
+    drw_data->texture_pool = DRW_texture_pool_create();
+  }
 
   drw_data->idatalist = DRW_instance_data_list_create();
 
@@ -479,7 +489,13 @@ static void drw_viewport_data_reset(DRWData *drw_data)
   DRW_instance_data_list_free_unused(drw_data->idatalist);
   DRW_instance_data_list_resize(drw_data->idatalist);
   DRW_instance_data_list_reset(drw_data->idatalist);
-  DRW_texture_pool_reset(drw_data->texture_pool);
+  if (drw_data->shared_texture_pool) {
+    /* The unused textures are deleted once all the viewports are drawn. */
+    DRW_texture_pool_release(drw_data->texture_pool);
+  }
+  else {
+    DRW_texture_pool_reset(drw_data->texture_pool);
+  }
 }
 
 void DRW_viewport_data_free(DRWData *drw_data)
@@ -499,7 +515,9 @@ void DRW_viewport_data_free(DRWData *drw_data)
   BLI_memblock_destroy(drw_data->images, NULL);
   DRW_uniform_attrs_pool_free(drw_data->obattrs_ubo_pool);
   DRW_instance_data_list_free(drw_data->idatalist);
-  DRW_texture_pool_free(drw_data->texture_pool);
+  if (!drw_data->shared_texture_pool) {
+    DRW_texture_pool_free(drw_data->texture_pool);
+  }
   for (int i = 0; i < 2; i++) {
     DRW_view_data_free(drw_data->view_data[i]);
   }
@@ -3367,12 +3385,266 @@ EEVEE_Data *EEVEE_engine_data_get(void)
   return data;
 }
 
+/* Original objects culled by the game engine for the next render loop. */
+static GSet *game_culled_objects = NULL;
+
+void DRW_game_culled_objects_set(GSet *culled_objects)
+{
+  game_culled_objects = culled_objects;
+}
+
+/* Objects drawn by the next overlay pass, NULL to iterate the depsgraph. */
+static struct {
+  Object **objects;
+  int len;
+  bool use_workbench;
+} game_overlay_pass = {NULL};
+
+void DRW_game_overlay_pass_set(Object **objects, int objects_len, bool use_workbench)
+{
+  game_overlay_pass.objects = objects;
+  game_overlay_pass.len = objects_len;
+  game_overlay_pass.use_workbench = use_workbench;
+}
+
+/* The world is only updated by the render loops once tagged, the depsgraph keeps adding its
+ * recalc flags to the draw data of the engines until then. */
+static struct {
+  bool tagged;
+  World *world;
+} game_world_update = {true, NULL};
+
+void DRW_game_world_update_tag(void)
+{
+  game_world_update.tagged = true;
+}
+
+/* Views drawn before the view of the context by the next render loop. */
+static struct {
+  const float (*viewmats)[4][4];
+  const float (*winmats)[4][4];
+  GPUFrameBuffer **targets;
+  int len;
+} game_extra_views = {NULL};
+
+void DRW_game_extra_views_set(const float (*viewmats)[4][4],
+                              const float (*winmats)[4][4],
+                              GPUFrameBuffer **targets,
+                              int views_len)
+{
+  game_extra_views.viewmats = viewmats;
+  game_extra_views.winmats = winmats;
+  game_extra_views.targets = targets;
+  game_extra_views.len = views_len;
+}
+
+void DRW_game_shared_texture_pool_set(bool enable)
+{
+  if (enable && !game_texture_pool) {
+    game_texture_pool = DRW_texture_pool_create();
+  }
+  else if (!enable && game_texture_pool) {
+    /* The viewports using the pool must be freed first. */
+    DRW_texture_pool_free(game_texture_pool);
+    game_texture_pool = NULL;
+  }
+}
+
+void DRW_game_shared_texture_pool_free_unused(int max_unused_frames)
+{
+  if (game_texture_pool) {
+    DRW_texture_pool_free_unused(game_texture_pool, max_unused_frames);
+  }
+}
+
+/* Original objects moved by the game, drawn apart from the cached static shadows. */
+static GSet *game_dynamic_objects = NULL;
+
+void DRW_game_dynamic_objects_set(GSet *dynamic_objects)
+{
+  game_dynamic_objects = dynamic_objects;
+}
+
+bool DRW_game_static_shadows_get(void)
+{
+  return game_dynamic_objects != NULL;
+}
+
+bool DRW_game_object_is_dynamic(Object *ob)
+{
+  if (game_dynamic_objects == NULL) {
+    return false;
+  }
+  /* The instances are always considered dynamic as their draw data is not kept. */
+  if (ob->base_flag & BASE_FROM_DUPLI) {
+    return true;
+  }
+  return BLI_gset_haskey(game_dynamic_objects, DEG_get_original_object(ob));
+}
+
+/* Original light objects changed by the game, mapped to their DRWGameLight. */
+static GHash *game_lights = NULL;
+
+void DRW_game_lights_set(GHash *lights)
+{
+  game_lights = lights;
+}
+
+const DRWGameLight *DRW_game_light_get(Object *ob)
+{
+  if (game_lights == NULL || (ob->base_flag & BASE_FROM_DUPLI)) {
+    return NULL;
+  }
+  return BLI_ghash_lookup(game_lights, DEG_get_original_object(ob));
+}
+
+static bool drw_game_object_is_culled(GSet *culled_objects,
+                                      const DEGObjectIterData *data,
+                                      Object *orig_ob)
+{
+  /* The instances are drawn from their dupli parent, only their parent is culled. */
+  return culled_objects && data->dupli_object_current == NULL &&
+         BLI_gset_haskey(culled_objects, orig_ob);
+}
+
+/* Return false if an overlay object draws instances, they are only generated by the depsgraph
+ * iteration. */
+static bool drw_game_overlay_objects_supported(Depsgraph *depsgraph)
+{
+  for (int i = 0; i < game_overlay_pass.len; i++) {
+    Object *ob = DEG_get_evaluated_object(depsgraph, game_overlay_pass.objects[i]);
+    if (DRW_object_visibility_in_active_context(ob) & OB_VISIBLE_INSTANCES) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/* Populate the caches with the overlay objects only, instead of iterating all the objects of
+ * the depsgraph to find them. */
+static void drw_game_overlay_objects_populate(Depsgraph *depsgraph,
+                                              View3D *v3d,
+                                              GSet *culled_objects)
+{
+  const int object_type_exclude_viewport = v3d->object_type_exclude_viewport;
+
+  DST.dupli_parent = NULL;
+  DST.dupli_source = NULL;
+  for (int i = 0; i < game_overlay_pass.len; i++) {
+    Object *orig_ob = game_overlay_pass.objects[i];
+    Object *ob = DEG_get_evaluated_object(depsgraph, orig_ob);
+    /* Not in the depsgraph. */
+    if (ob == orig_ob) {
+      continue;
+    }
+    if ((object_type_exclude_viewport & (1 << ob->type)) != 0) {
+      continue;
+    }
+    if ((DRW_object_visibility_in_active_context(ob) & OB_VISIBLE_SELF) == 0) {
+      continue;
+    }
+    if (!BKE_object_is_visible_in_viewport(v3d, ob)) {
+      continue;
+    }
+    if (culled_objects && BLI_gset_haskey(culled_objects, orig_ob)) {
+      continue;
+    }
+    drw_engines_cache_populate(ob);
+  }
+}
+
+/* Draw the overlay geometry unlit with the workbench engine, the shading of the 3D view is
+ * replaced during the render loop. */
+static void drw_game_overlay_workbench_shading(View3D *v3d, View3DShading *r_backup)
+{
+  *r_backup = v3d->shading;
+  v3d->shading.type = OB_SOLID;
+  v3d->shading.light = V3D_LIGHTING_FLAT;
+  v3d->shading.color_type = V3D_SHADING_TEXTURE_COLOR;
+  v3d->shading.flag &= ~(V3D_SHADING_XRAY | V3D_SHADING_SHADOW | V3D_SHADING_CAVITY |
+                         V3D_SHADING_OBJECT_OUTLINE | V3D_SHADING_DEPTH_OF_FIELD);
+}
+
+/* Accumulate the remaining TAA samples of the frame. The caches are already populated,
+ * only the scene is drawn again with the next jittered projection. */
+static void drw_game_draw_samples(EEVEE_Data *vedata, int samples)
+{
+  EEVEE_EffectsInfo *effects = vedata->stl->effects;
+  for (int i = 1; i < samples; i++) {
+    if ((effects->enabled_effects & EFFECT_TAA) == 0 ||
+        (effects->enabled_effects & EFFECT_TAA_REPROJECT) != 0 || effects->bypass_drawing ||
+        (effects->taa_total_sample != 0 &&
+         effects->taa_current_sample >= effects->taa_total_sample)) {
+      break;
+    }
+    effects->taa_current_sample += 1;
+    EEVEE_temporal_sampling_update_matrices(vedata);
+
+    GPU_framebuffer_bind(DST.default_framebuffer);
+    GPU_framebuffer_clear_depth_stencil(DST.default_framebuffer, 1.0f, 0xFF);
+
+    DRW_state_reset();
+
+    drw_engines_draw_scene();
+  }
+}
+
+/* Make a view the default view of the draw and restart its temporal anti-aliasing. */
+static void drw_game_view_activate(EEVEE_Data *vedata, DRWView *view)
+{
+  EEVEE_EffectsInfo *effects = vedata->stl->effects;
+
+  DRW_view_reset();
+  DRW_view_default_set(view);
+  DRW_view_set_active(NULL);
+
+  /* The previous view is only valid in the first sample and the history is the one of the
+   * previous view. The next frame must not accumulate into it either. */
+  EEVEE_temporal_sampling_create_view(vedata);
+  effects->taa_current_sample = 1;
+  effects->bypass_drawing = false;
+  zero_m4(effects->prev_drw_persmat);
+  EEVEE_temporal_sampling_update_matrices(vedata);
+  DRW_view_set_active(NULL);
+
+  GPU_framebuffer_bind(DST.default_framebuffer);
+  GPU_framebuffer_clear_depth_stencil(DST.default_framebuffer, 1.0f, 0xFF);
+
+  DRW_state_reset();
+}
+
+/* Draw the extra views into their targets, then restore the view of the context. */
+static void drw_game_draw_extra_views(EEVEE_Data *vedata, int samples)
+{
+  DRWView *main_view = DST.view_default;
+  RegionView3D *rv3d = DST.draw_ctx.rv3d;
+
+  for (int i = 0; i < game_extra_views.len; i++) {
+    DRWView *view = DRW_view_create(
+        game_extra_views.viewmats[i], game_extra_views.winmats[i], NULL, NULL, NULL);
+    DRW_view_camtexco_set(view, rv3d->viewcamtexcofac);
+    drw_game_view_activate(vedata, view);
+
+    drw_engines_draw_scene();
+    drw_game_draw_samples(vedata, samples);
+
+    GPU_framebuffer_blit(DST.default_framebuffer,
+                         0,
+                         game_extra_views.targets[i],
+                         0,
+                         GPU_COLOR_BIT | GPU_DEPTH_BIT);
+  }
+
+  drw_game_view_activate(vedata, main_view);
+}
+
 void DRW_game_render_loop(bContext *C,
                           GPUViewport *viewport,
                           Depsgraph *depsgraph,
                           const rcti *window,
                           bool is_overlay_pass,
-                          bool called_from_constructor)
+                          bool called_from_constructor,
+                          int samples)
 {
   /* Reset before using it. */
   drw_state_prepare_clean_for_draw(&DST);
@@ -3415,7 +3687,16 @@ void DRW_game_render_loop(bContext *C,
 
   bool gpencil_engine_needed = drw_gpencil_engine_needed(depsgraph, v3d);
 
-  use_drw_engine(&draw_engine_eevee_type);
+  /* The HUD geometry of the overlay pass doesn't need the EEVEE lighting and effects. */
+  const bool use_workbench = is_overlay_pass && game_overlay_pass.use_workbench;
+  View3DShading shading_backup;
+  if (use_workbench) {
+    drw_game_overlay_workbench_shading(v3d, &shading_backup);
+    use_drw_engine(DRW_engine_viewport_workbench_type.draw_engine);
+  }
+  else {
+    use_drw_engine(&draw_engine_eevee_type);
+  }
   if (gpencil_engine_needed) {
     use_drw_engine(&draw_engine_gpencil_type);
   }
@@ -3428,12 +3709,26 @@ void DRW_game_render_loop(bContext *C,
   drw_engines_init();
 
   drw_engines_cache_init();
-  drw_engines_world_update(DST.draw_ctx.scene);
+  /* The workbench overlay pass leaves the tag to the next EEVEE pass. */
+  if (!use_workbench &&
+      (game_world_update.tagged || game_world_update.world != DST.draw_ctx.scene->world)) {
+    drw_engines_world_update(DST.draw_ctx.scene);
+    game_world_update.tagged = false;
+    game_world_update.world = DST.draw_ctx.scene->world;
+  }
 
   DST.dupli_origin = NULL;
   DST.dupli_origin_data = NULL;
 
-  if (is_overlay_pass) {
+  GSet *culled_objects = (game_culled_objects && BLI_gset_len(game_culled_objects) != 0) ?
+                             game_culled_objects :
+                             NULL;
+
+  if (is_overlay_pass && game_overlay_pass.objects &&
+      drw_game_overlay_objects_supported(depsgraph)) {
+    drw_game_overlay_objects_populate(depsgraph, v3d, culled_objects);
+  }
+  else if (is_overlay_pass) {
     DEG_OBJECT_ITER_FOR_RENDER_ENGINE_BEGIN (depsgraph, ob) {
       if ((object_type_exclude_viewport & (1 << ob->type)) != 0) {
         continue;
@@ -3444,6 +3739,10 @@ void DRW_game_render_loop(bContext *C,
 
       Object *orig_ob = DEG_get_original_object(ob);
 
+      if (drw_game_object_is_culled(culled_objects, &data_, orig_ob)) {
+        continue;
+      }
+
       if (orig_ob->gameflag & OB_OVERLAY_COLLECTION) {
         DST.dupli_parent = data_.dupli_parent;
         DST.dupli_source = data_.dupli_object_current;
@@ -3467,6 +3766,9 @@ void DRW_game_render_loop(bContext *C,
       if (orig_ob->gameflag & OB_OVERLAY_COLLECTION) {
         continue;
       }
+      if (drw_game_object_is_culled(culled_objects, &data_, orig_ob)) {
+        continue;
+      }
       DST.dupli_parent = data_.dupli_parent;
       DST.dupli_source = data_.dupli_object_current;
       drw_duplidata_load(ob);
@@ -3489,7 +3791,21 @@ void DRW_game_render_loop(bContext *C,
 
   DRW_hair_update();
 
-  drw_engines_draw_scene();
+  if (use_workbench) {
+    drw_engines_draw_scene();
+  }
+  else {
+    EEVEE_Data *vedata = (EEVEE_Data *)drw_viewport_engine_data_ensure(&draw_engine_eevee_type);
+
+    /* The other views share the populated caches, only the draw is done per view. */
+    if (game_extra_views.len > 0 && !is_overlay_pass) {
+      drw_game_draw_extra_views(vedata, samples);
+    }
+
+    drw_engines_draw_scene();
+
+    drw_game_draw_samples(vedata, samples);
+  }
 
   GPU_framebuffer_bind(DST.default_framebuffer);
   GPU_framebuffer_clear_stencil(DST.default_framebuffer, 0xFF);
@@ -3501,6 +3817,10 @@ void DRW_game_render_loop(bContext *C,
 
   drw_engines_disable();
 
+  if (use_workbench) {
+    v3d->shading = shading_backup;
+  }
+
   if (!called_from_constructor) {
     drw_manager_exit(&DST);
   }
@@ -521,6 +521,22 @@ typedef struct DRWDebugBox2D {
   float xsize;
   float ysize;
 } DRWDebugBox2D;
+
+typedef struct DRWDebugLines2D {
+  struct DRWDebugLines2D *next; /* linked list */
+  int vert_len;
+  /* Allocated after the struct. */
+  float (*pos)[2];
+  float (*color)[4];
+} DRWDebugLines2D;
+
+typedef struct DRWDebugLines3D {
+  struct DRWDebugLines3D *next; /* linked list */
+  int vert_len;
+  /* Allocated after the struct. */
+  float (*pos)[3];
+  float (*color)[4];
+} DRWDebugLines3D;
 /* End of UPBGE */
 
 /* ------------- Memory Pools ------------ */
@@ -548,6 +564,8 @@ typedef struct DRWData {
   /** Texture pool to reuse temp texture across engines. */
   /* TODO(fclem) the pool could be shared even between viewports. */
   struct DRWTexturePool *texture_pool;
+  /** The texture pool is the game engine pool shared by all the viewports (UPBGE). */
+  bool shared_texture_pool;
   /** Per stereo view data. Contains engine data and default framebuffers. */
   struct DRWViewData *view_data[2];
 } DRWData;
@@ -666,7 +684,9 @@ typedef struct DRWManager {
   struct {
     /* TODO(fclem) optimize: use chunks. */
     DRWDebugLine *lines;
+    DRWDebugLines3D *lines3D;
     DRWDebugBox2D *boxes;
+    DRWDebugLines2D *lines2D;
     DRWDebugText2D *texts;
   } debug_bge;
   /* UPBGE */
@@ -39,6 +39,8 @@
 #include "GPU_material.h"
 #include "GPU_shader.h"
 
+#include "PIL_time.h"
+
 #include "WM_api.h"
 #include "WM_types.h"
 
@@ -205,11 +207,28 @@ static void drw_deferred_shader_compilation_free(void *custom_data)
   MEM_freeN(comp);
 }
 
+/* Materials queued while the game is running, compiled by the game engine in the main thread
+ * between the frames as the window manager jobs don't run during the game. Only accessed from
+ * the main thread. */
+static ListBase g_game_deferred_queue = {NULL, NULL}; /* DRWDeferredShader */
+static bool g_game_deferred_compilation = false;
+
 static void drw_deferred_shader_add(GPUMaterial *mat, bool deferred)
 {
   /* Use original scene ID since this is what the jobs template tests for. */
   Scene *scene = (Scene *)DEG_get_original_id(&DST.draw_ctx.scene->id);
 
+  if (g_game_deferred_compilation && deferred && (scene->flag & SCE_INTERACTIVE) &&
+      !DRW_state_is_image_render()) {
+    if (BLI_findptr(&g_game_deferred_queue, mat, offsetof(DRWDeferredShader, mat)) == NULL) {
+      DRWDeferredShader *dsh = MEM_callocN(sizeof(DRWDeferredShader), "Deferred Shader");
+      dsh->mat = mat;
+      BLI_addtail(&g_game_deferred_queue, dsh);
+    }
+    /* The engines draw with a default material until the material is compiled. */
+    return;
+  }
+
   /* Do not defer the compilation if we are rendering for image.
    * deferred rendering is only possible when `evil_C` is available */
   if (DST.draw_ctx.evil_C == NULL || DRW_state_is_image_render() || !USE_DEFERRED_COMPILATION ||
@@ -288,6 +307,13 @@ void DRW_deferred_shader_remove(GPUMaterial *mat)
 {
   Scene *scene = GPU_material_scene(mat);
 
+  DRWDeferredShader *game_dsh = (DRWDeferredShader *)BLI_findptr(
+      &g_game_deferred_queue, mat, offsetof(DRWDeferredShader, mat));
+  if (game_dsh) {
+    BLI_remlink(&g_game_deferred_queue, game_dsh);
+    drw_deferred_shader_free(game_dsh);
+  }
+
   for (wmWindowManager *wm = G_MAIN->wm.first; wm; wm = wm->id.next) {
     if (WM_jobs_test(wm, scene, WM_JOB_TYPE_SHADER_COMPILATION) == false) {
       /* No job running, do not create a new one by calling WM_jobs_get. */
@@ -323,6 +349,44 @@ void DRW_deferred_shader_remove(GPUMaterial *mat)
   }
 }
 
+void DRW_game_deferred_compilation_set(bool enable)
+{
+  if (!enable) {
+    /* Queued materials are not added again by the engines, compile them now. */
+    DRW_game_deferred_shaders_compile(-1.0);
+  }
+  g_game_deferred_compilation = enable;
+}
+
+bool DRW_game_deferred_compilation_get(void)
+{
+  return g_game_deferred_compilation;
+}
+
+int DRW_game_deferred_shaders_compile(double time_budget)
+{
+  const double start_time = PIL_check_seconds_timer();
+
+  /* Compile at least one material per call, a budget shorter than a compilation would
+   * never finish the queue. */
+  DRWDeferredShader *dsh;
+  while ((dsh = BLI_pophead(&g_game_deferred_queue))) {
+    GPU_material_compile(dsh->mat);
+    drw_deferred_shader_free(dsh);
+
+    if (time_budget >= 0.0 && PIL_check_seconds_timer() - start_time >= time_budget) {
+      break;
+    }
+  }
+
+  return BLI_listbase_count(&g_game_deferred_queue);
+}
+
+int DRW_game_deferred_shaders_count(void)
+{
+  return BLI_listbase_count(&g_game_deferred_queue);
+}
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
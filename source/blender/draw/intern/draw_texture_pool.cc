@@ -31,6 +31,10 @@ using namespace blender;
 struct DRWTexturePoolHandle {
   uint64_t users_bits;
   GPUTexture *texture;
+  /* Used since the last DRW_texture_pool_free_unused, see DRW_texture_pool_release. */
+  bool used;
+  /* Number of DRW_texture_pool_free_unused calls since the last use. */
+  int unused_count;
 };
 
 struct DRWTexturePool {
@@ -103,6 +107,8 @@ GPUTexture *DRW_texture_pool_query(
 
   DRWTexturePoolHandle handle;
   handle.users_bits = user_bit;
+  handle.used = false;
+  handle.unused_count = 0;
   handle.texture = GPU_texture_create_2d(name, width, height, 1, format, nullptr);
   pool->handles.append(handle);
   /* Doing filtering for depth does not make sense when not doing shadow mapping,
@@ -138,3 +144,34 @@ void DRW_texture_pool_reset(DRWTexturePool *pool)
     }
   }
 }
+
+/* Resets the user bits for each texture in the pool without deleting the unused ones.
+ * Used when the pool is shared by several viewports drawn one after the other, the textures
+ * of a viewport are then reused by the next viewports until DRW_texture_pool_free_unused. */
+void DRW_texture_pool_release(DRWTexturePool *pool)
+{
+  pool->last_user_id = -1;
+
+  for (DRWTexturePoolHandle &handle : pool->handles) {
+    if (handle.users_bits != 0) {
+      handle.used = true;
+      handle.users_bits = 0;
+    }
+  }
+}
+
+/* Delete the textures not used during the last max_unused_count calls. */
+void DRW_texture_pool_free_unused(DRWTexturePool *pool, int max_unused_count)
+{
+  for (int i = pool->handles.size() - 1; i >= 0; i--) {
+    DRWTexturePoolHandle &handle = pool->handles[i];
+    if (handle.used || handle.users_bits != 0) {
+      handle.used = false;
+      handle.unused_count = 0;
+    }
+    else if (++handle.unused_count > max_unused_count) {
+      GPU_texture_free(handle.texture);
+      pool->handles.remove_and_reorder(i);
+    }
+  }
+}
@@ -41,6 +41,8 @@ void DRW_texture_pool_free(DRWTexturePool *pool);
 GPUTexture *DRW_texture_pool_query(
     DRWTexturePool *pool, int width, int height, eGPUTextureFormat format, void *user);
 void DRW_texture_pool_reset(DRWTexturePool *pool);
+void DRW_texture_pool_release(DRWTexturePool *pool);
+void DRW_texture_pool_free_unused(DRWTexturePool *pool, int max_unused_count);
 
 #ifdef __cplusplus
 }
@@ -156,6 +156,10 @@ void GPU_batch_draw_instanced(GPUBatch *batch, int i_count);
 /* This does not bind/unbind shader and does not call GPU_matrix_bind() */
 void GPU_batch_draw_advanced(GPUBatch *, int v_first, int v_count, int i_first, int i_count);
 
+/* Number of batch draw calls since the last reset, immediate mode draws are not counted. */
+uint GPU_batch_draw_count_get(void);
+void GPU_batch_draw_count_reset(void);
+
 #if 0 /* future plans */
 
 /* Can multiple batches share a GPUVertBuf? Use ref count? */
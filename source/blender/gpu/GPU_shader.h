@@ -451,6 +451,10 @@ void GPU_shader_bind_attributes(GPUShader *shader, int *locations, const char **
 // GPU_shader_get_uniform doesn't handle array uniforms e.g: uniform vec2
 // bgl_TextureCoordinateOffset[9];
 int GPU_shader_get_uniform_location_old(GPUShader *shader, const char *name);
+/* Directory of the on disk cache of the linked shader programs, the binaries are keyed by the
+ * driver and the shader sources. NULL or an empty path disables the cache. */
+void GPU_shader_cache_dir_set(const char *dir);
+const char *GPU_shader_cache_dir_get(void);
 /****************************************End of UPBGE************************************/
 
 #ifdef __cplusplus
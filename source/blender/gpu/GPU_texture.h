@@ -162,12 +162,14 @@ typedef enum eGPUTextureFormat {
   GPU_RGBA8_DXT1,
   GPU_RGBA8_DXT3,
   GPU_RGBA8_DXT5,
+  GPU_COMPRESSED_RG_RGTC2,
+  GPU_COMPRESSED_RED_RGTC1,
+  GPU_SRGB8_A8_BPTC,
+  GPU_RGBA8_BPTC,
 #if 0
   GPU_SRGB8,
   GPU_RGB9_E5,
-  GPU_COMPRESSED_RG_RGTC2,
   GPU_COMPRESSED_SIGNED_RG_RGTC2,
-  GPU_COMPRESSED_RED_RGTC1,
   GPU_COMPRESSED_SIGNED_RED_RGTC1,
 #endif
 
@@ -299,6 +301,8 @@ size_t GPU_texture_dataformat_size(eGPUDataFormat data_format);
 
 /******************UPBGE************************/
 void GPU_texture_set_opengl_bindcode(GPUTexture *tex, int bindcode);
+/** Size in bytes of the base level of the texture, the mipmaps are not included. */
+size_t GPU_texture_memory_size(const GPUTexture *tex);
 /**************End of UPBGE*********************/
 
 #ifdef __cplusplus
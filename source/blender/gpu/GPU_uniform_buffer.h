@@ -47,6 +47,11 @@ GPUUniformBuf *GPU_uniformbuf_create_from_list(struct ListBase *inputs, const ch
 void GPU_uniformbuf_free(GPUUniformBuf *ubo);
 
 void GPU_uniformbuf_update(GPUUniformBuf *ubo, const void *data);
+/** Upload only a range of the buffer, \a data points to the bytes of the range. */
+void GPU_uniformbuf_update_range(GPUUniformBuf *ubo,
+                                 const void *data,
+                                 size_t offset,
+                                 size_t size);
 
 void GPU_uniformbuf_bind(GPUUniformBuf *ubo, int slot);
 void GPU_uniformbuf_unbind(GPUUniformBuf *ubo);
@@ -84,6 +84,12 @@ GPUTexture *GPU_viewport_depth_texture(GPUViewport *viewport);
 
 GPUFrameBuffer *GPU_viewport_framebuffer_overlay_get(GPUViewport *viewport);
 
+/******************UPBGE************************/
+/** Size in bytes of the color and depth textures of the viewport, the textures of the draw
+ * engines are not included. */
+size_t GPU_viewport_memory_size(const GPUViewport *viewport);
+/**************End of UPBGE*********************/
+
 #ifdef __cplusplus
 }
 #endif
@@ -231,6 +231,9 @@ void GPU_batch_set_shader(GPUBatch *batch, GPUShader *shader)
 /** \name Drawing / Drawcall functions
  * \{ */
 
+/* Only drawn from the thread owning the GPU context. */
+static uint batch_draw_count = 0;
+
 void GPU_batch_draw(GPUBatch *batch)
 {
   GPU_shader_bind(batch->shader);
@@ -279,9 +282,20 @@ void GPU_batch_draw_advanced(
     return;
   }
 
+  batch_draw_count++;
   batch->draw(v_first, v_count, i_first, i_count);
 }
 
+uint GPU_batch_draw_count_get(void)
+{
+  return batch_draw_count;
+}
+
+void GPU_batch_draw_count_reset(void)
+{
+  batch_draw_count = 0;
+}
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
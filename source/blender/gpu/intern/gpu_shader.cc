@@ -23,6 +23,9 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_fileops.h"
+#include "BLI_path_util.h"
+#include "BLI_string.h"
 #include "BLI_string_utils.h"
 
 #include "GPU_capabilities.h"
@@ -636,6 +639,27 @@ int GPU_shader_get_uniform_location_old(GPUShader *shader, const char *name)
   Shader *shad = reinterpret_cast<Shader *>(shader);
   return shad->shader_get_uniform_location_old(name);
 }
+
+static char g_shader_cache_dir[FILE_MAX] = "";
+
+void GPU_shader_cache_dir_set(const char *dir)
+{
+  if (dir == nullptr || dir[0] == '\0') {
+    g_shader_cache_dir[0] = '\0';
+    return;
+  }
+
+  BLI_strncpy(g_shader_cache_dir, dir, sizeof(g_shader_cache_dir));
+  if (!BLI_dir_create_recursive(g_shader_cache_dir)) {
+    fprintf(stderr, "GPUShader: Could not create the cache directory %s\n", g_shader_cache_dir);
+    g_shader_cache_dir[0] = '\0';
+  }
+}
+
+const char *GPU_shader_cache_dir_get(void)
+{
+  return (g_shader_cache_dir[0] != '\0') ? g_shader_cache_dir : nullptr;
+}
 /**********************End of UPBGE*******************************/
 
 /** \} */
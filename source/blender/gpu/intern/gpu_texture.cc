@@ -638,6 +638,13 @@ void GPU_texture_set_opengl_bindcode(GPUTexture *tex, int bindcode)
   Texture *t = reinterpret_cast<Texture *>(tex);
   t->gl_bindcode_set(bindcode);
 }
+
+size_t GPU_texture_memory_size(const GPUTexture *tex)
+{
+  const Texture *t = reinterpret_cast<const Texture *>(tex);
+  return to_bytesize(t->format_get()) * max_ii(1, t->width_get()) * max_ii(1, t->height_get()) *
+         max_ii(1, t->depth_get());
+}
 /********************End of UPBGE**********************/
 
 /** \} */
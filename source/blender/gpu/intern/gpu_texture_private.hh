@@ -317,6 +317,10 @@ inline size_t to_bytesize(eGPUTextureFormat format)
     case GPU_RGBA8_DXT1:
     case GPU_RGBA8_DXT3:
     case GPU_RGBA8_DXT5:
+    case GPU_COMPRESSED_RG_RGTC2:
+    case GPU_COMPRESSED_RED_RGTC1:
+    case GPU_SRGB8_A8_BPTC:
+    case GPU_RGBA8_BPTC:
       return 1; /* Incorrect but actual size is fractional. */
     default:
       BLI_assert_msg(0, "Texture format incorrect or unsupported");
@@ -329,11 +333,15 @@ inline size_t to_block_size(eGPUTextureFormat data_type)
   switch (data_type) {
     case GPU_SRGB8_A8_DXT1:
     case GPU_RGBA8_DXT1:
+    case GPU_COMPRESSED_RED_RGTC1:
       return 8;
     case GPU_SRGB8_A8_DXT3:
     case GPU_SRGB8_A8_DXT5:
     case GPU_RGBA8_DXT3:
     case GPU_RGBA8_DXT5:
+    case GPU_COMPRESSED_RG_RGTC2:
+    case GPU_SRGB8_A8_BPTC:
+    case GPU_RGBA8_BPTC:
       return 16;
     default:
       BLI_assert_msg(0, "Texture format is not a compressed format");
@@ -364,6 +372,10 @@ inline eGPUTextureFormatFlag to_format_flag(eGPUTextureFormat format)
     case GPU_RGBA8_DXT1:
     case GPU_RGBA8_DXT3:
     case GPU_RGBA8_DXT5:
+    case GPU_COMPRESSED_RG_RGTC2:
+    case GPU_COMPRESSED_RED_RGTC1:
+    case GPU_SRGB8_A8_BPTC:
+    case GPU_RGBA8_BPTC:
       return GPU_FORMAT_COMPRESSED;
     default:
       return GPU_FORMAT_FLOAT;
@@ -380,6 +392,8 @@ inline int to_component_len(eGPUTextureFormat format)
     case GPU_RGBA32F:
     case GPU_SRGB8_A8:
     case GPU_RGB10_A2:
+    case GPU_SRGB8_A8_BPTC:
+    case GPU_RGBA8_BPTC:
       return 4;
     case GPU_RGB16F:
     case GPU_R11F_G11F_B10F:
@@ -390,6 +404,7 @@ inline int to_component_len(eGPUTextureFormat format)
     case GPU_RG16I:
     case GPU_RG16UI:
     case GPU_RG32F:
+    case GPU_COMPRESSED_RG_RGTC2:
       return 2;
     default:
       return 1;
@@ -235,6 +235,14 @@ void GPU_uniformbuf_update(GPUUniformBuf *ubo, const void *data)
   unwrap(ubo)->update(data);
 }
 
+void GPU_uniformbuf_update_range(GPUUniformBuf *ubo,
+                                 const void *data,
+                                 size_t offset,
+                                 size_t size)
+{
+  unwrap(ubo)->update_range(data, offset, size);
+}
+
 void GPU_uniformbuf_bind(GPUUniformBuf *ubo, int slot)
 {
   unwrap(ubo)->bind(slot);
@@ -53,6 +53,7 @@ class UniformBuf {
   virtual ~UniformBuf();
 
   virtual void update(const void *data) = 0;
+  virtual void update_range(const void *data, size_t offset, size_t size) = 0;
   virtual void bind(int slot) = 0;
   virtual void unbind(void) = 0;
 
@@ -598,6 +598,24 @@ GPUFrameBuffer *GPU_viewport_framebuffer_overlay_get(GPUViewport *viewport)
   return viewport->overlay_fb;
 }
 
+/***********************UPBGE**************************/
+size_t GPU_viewport_memory_size(const GPUViewport *viewport)
+{
+  const GPUTexture *textures[] = {viewport->color_render_tx[0],
+                                  viewport->color_render_tx[1],
+                                  viewport->color_overlay_tx[0],
+                                  viewport->color_overlay_tx[1],
+                                  viewport->depth_tx};
+  size_t size = 0;
+  for (int i = 0; i < ARRAY_SIZE(textures); i++) {
+    if (textures[i]) {
+      size += GPU_texture_memory_size(textures[i]);
+    }
+  }
+  return size;
+}
+/********************End of UPBGE**********************/
+
 /* Must be executed inside Draw-manager OpenGL Context. */
 void GPU_viewport_free(GPUViewport *viewport)
 {
@@ -69,6 +69,7 @@ class GLContext : public Context {
   static bool fixed_restart_index_support;
   static bool multi_bind_support;
   static bool multi_draw_indirect_support;
+  static bool program_binary_support;
   static bool shader_draw_parameters_support;
   static bool texture_cube_map_array_support;
   static bool texture_filter_anisotropic_support;
@@ -23,6 +23,9 @@
 
 #include "BKE_global.h"
 
+#include "BLI_fileops.h"
+#include "BLI_hash_md5.h"
+#include "BLI_path_util.h"
 #include "BLI_string.h"
 #include "BLI_vector.hh"
 
@@ -137,8 +140,28 @@ char *GLShader::glsl_patch_get(GLenum gl_stage)
   return glsl_patch_default_get();
 }
 
-/* Create, compile and attach the shader stage to the shader program. */
+/* Create, compile and attach the shader stage to the shader program. The compilation is
+ * deferred to the program finalize when the shader cache is used. */
 GLuint GLShader::create_shader_stage(GLenum gl_stage, MutableSpan<const char *> sources)
+{
+  /* Patch the shader code using the first source slot. */
+  sources[0] = glsl_patch_get(gl_stage);
+
+  if (GLContext::program_binary_support && GPU_shader_cache_dir_get()) {
+    DeferredStage stage = {gl_stage};
+    for (const char *source : sources) {
+      stage.sources.append(source);
+      cache_key_ += source;
+    }
+    cache_key_ += '\0';
+    deferred_stages_.append(std::move(stage));
+    return 0;
+  }
+
+  return this->compile_shader_stage(gl_stage, sources);
+}
+
+GLuint GLShader::compile_shader_stage(GLenum gl_stage, MutableSpan<const char *> sources)
 {
   GLuint shader = glCreateShader(gl_stage);
   if (shader == 0) {
@@ -146,9 +169,6 @@ GLuint GLShader::create_shader_stage(GLenum gl_stage, MutableSpan<const char *>
     return 0;
   }
 
-  /* Patch the shader code using the first source slot. */
-  sources[0] = glsl_patch_get(gl_stage);
-
   glShaderSource(shader, sources.size(), sources.data(), nullptr);
   glCompileShader(shader);
 
@@ -209,10 +229,54 @@ void GLShader::compute_shader_from_glsl(MutableSpan<const char *> sources)
 
 bool GLShader::finalize()
 {
+  const bool use_cache = !deferred_stages_.is_empty();
+  char cache_filepath[FILE_MAX];
+
+  if (use_cache) {
+    this->cache_filepath_get(GPU_shader_cache_dir_get(), cache_filepath);
+
+    if (!this->program_binary_load(cache_filepath)) {
+      /* Cache miss, compile the stages as without cache. */
+      for (DeferredStage &stage : deferred_stages_) {
+        Vector<const char *> sources;
+        for (const std::string &source : stage.sources) {
+          sources.append(source.c_str());
+        }
+        const GLuint shader = this->compile_shader_stage(stage.gl_stage, sources);
+        switch (stage.gl_stage) {
+          case GL_VERTEX_SHADER:
+            vert_shader_ = shader;
+            break;
+          case GL_GEOMETRY_SHADER:
+            geom_shader_ = shader;
+            break;
+          case GL_FRAGMENT_SHADER:
+            frag_shader_ = shader;
+            break;
+          case GL_COMPUTE_SHADER:
+            compute_shader_ = shader;
+            break;
+        }
+      }
+    }
+    else {
+      /* The program is already linked. */
+      deferred_stages_.clear();
+      interface = new GLShaderInterface(shader_program_);
+      return true;
+    }
+
+    deferred_stages_.clear();
+  }
+
   if (compilation_failed_) {
     return false;
   }
 
+  if (use_cache) {
+    glProgramParameteri(shader_program_, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+  }
+
   glLinkProgram(shader_program_);
 
   GLint status;
@@ -226,6 +290,10 @@ bool GLShader::finalize()
     return false;
   }
 
+  if (use_cache) {
+    this->program_binary_save(cache_filepath);
+  }
+
   interface = new GLShaderInterface(shader_program_);
 
   return true;
@@ -233,6 +301,94 @@ bool GLShader::finalize()
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Program binary cache
+ *
+ * Linked programs are stored in the directory given by #GPU_shader_cache_dir_set, the file name
+ * is the hash of the driver identification, the stage sources and the link settings. A file
+ * starts with the binary format followed by the program binary.
+ * \{ */
+
+void GLShader::cache_filepath_get(const char *dir, char *r_filepath)
+{
+  /* A driver update can change the binary format or invalidate it. */
+  std::string key;
+  for (GLenum name : {GL_VENDOR, GL_RENDERER, GL_VERSION}) {
+    key += (const char *)glGetString(name);
+    key += '\0';
+  }
+  key += cache_key_;
+
+  char digest[16];
+  char hex_digest[33];
+  BLI_hash_md5_buffer(key.data(), key.size(), digest);
+  BLI_hash_md5_to_hexdigest(digest, hex_digest);
+
+  char filename[FILE_MAXFILE];
+  BLI_snprintf(filename, sizeof(filename), "%s.bin", hex_digest);
+  BLI_join_dirfile(r_filepath, FILE_MAX, dir, filename);
+}
+
+bool GLShader::program_binary_load(const char *filepath)
+{
+  size_t size;
+  char *data = (char *)BLI_file_read_binary_as_mem(filepath, 0, &size);
+  if (data == nullptr) {
+    return false;
+  }
+
+  GLint status = GL_FALSE;
+  if (size > sizeof(GLenum)) {
+    GLenum format;
+    memcpy(&format, data, sizeof(GLenum));
+    glProgramBinary(shader_program_, format, data + sizeof(GLenum), size - sizeof(GLenum));
+    glGetProgramiv(shader_program_, GL_LINK_STATUS, &status);
+  }
+  MEM_freeN(data);
+
+  if (!status) {
+    /* The binary was rejected by the driver, it is replaced after the program is compiled. */
+    if (G.debug & G_DEBUG_GPU) {
+      printf("GLShader: Invalid cached binary %s of shader %s\n", filepath, name);
+    }
+    return false;
+  }
+
+  return true;
+}
+
+void GLShader::program_binary_save(const char *filepath)
+{
+  GLint size = 0;
+  glGetProgramiv(shader_program_, GL_PROGRAM_BINARY_LENGTH, &size);
+  if (size <= 0) {
+    return;
+  }
+
+  Vector<char> data(sizeof(GLenum) + size);
+  GLenum format;
+  glGetProgramBinary(shader_program_, size, nullptr, &format, data.data() + sizeof(GLenum));
+  memcpy(data.data(), &format, sizeof(GLenum));
+
+  /* Write in a temporary file first to never read a partial binary from an other thread or
+   * process compiling the same shader. */
+  char tmp_filepath[FILE_MAX];
+  BLI_snprintf(tmp_filepath, sizeof(tmp_filepath), "%s.%p.tmp", filepath, this);
+
+  FILE *file = BLI_fopen(tmp_filepath, "wb");
+  if (file == nullptr) {
+    return;
+  }
+  const bool written = (fwrite(data.data(), 1, data.size(), file) == data.size());
+  fclose(file);
+
+  if (!written || BLI_rename(tmp_filepath, filepath) != 0) {
+    BLI_delete(tmp_filepath, false, false);
+  }
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Binding
  * \{ */
@@ -265,6 +421,12 @@ void GLShader::transform_feedback_names_set(Span<const char *> name_list,
   glTransformFeedbackVaryings(
       shader_program_, name_list.size(), name_list.data(), GL_INTERLEAVED_ATTRIBS);
   transform_feedback_type_ = geom_type;
+
+  /* The varyings are part of the program binary. */
+  for (const char *tf_name : name_list) {
+    cache_key_ += tf_name;
+    cache_key_ += '\0';
+  }
 }
 
 bool GLShader::transform_feedback_enable(GPUVertBuf *buf_)
@@ -25,6 +25,8 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_vector.hh"
+
 #include "glew-mx.h"
 
 #include "gpu_shader_private.hh"
@@ -47,6 +49,15 @@ class GLShader : public Shader {
   /** True if any shader failed to compile. */
   bool compilation_failed_ = false;
 
+  /** Stage compiled only if the program binary is not found in the shader cache. */
+  struct DeferredStage {
+    GLenum gl_stage;
+    Vector<std::string> sources;
+  };
+  Vector<DeferredStage> deferred_stages_;
+  /** Sources and link settings identifying the program in the shader cache. */
+  std::string cache_key_;
+
   eGPUShaderTFBType transform_feedback_type_ = GPU_SHADER_TFB_NONE;
 
  public:
@@ -88,6 +99,12 @@ class GLShader : public Shader {
   char *glsl_patch_get(GLenum gl_stage);
 
   GLuint create_shader_stage(GLenum gl_stage, MutableSpan<const char *> sources);
+  GLuint compile_shader_stage(GLenum gl_stage, MutableSpan<const char *> sources);
+
+  /** Return true if the program binary was loaded from the shader cache. */
+  bool program_binary_load(const char *filepath);
+  void program_binary_save(const char *filepath);
+  void cache_filepath_get(const char *dir, char *r_filepath);
 
   MEM_CXX_CLASS_ALLOC_FUNCS("GLShader");
 };
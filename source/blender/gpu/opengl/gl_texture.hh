@@ -187,6 +187,14 @@ inline GLenum to_gl_internal_format(eGPUTextureFormat format)
       return GL_COMPRESSED_RGBA_S3TC_DXT3_EXT;
     case GPU_RGBA8_DXT5:
       return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+    case GPU_COMPRESSED_RG_RGTC2:
+      return GL_COMPRESSED_RG_RGTC2;
+    case GPU_COMPRESSED_RED_RGTC1:
+      return GL_COMPRESSED_RED_RGTC1;
+    case GPU_SRGB8_A8_BPTC:
+      return GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM;
+    case GPU_RGBA8_BPTC:
+      return GL_COMPRESSED_RGBA_BPTC_UNORM;
     /* Depth Formats */
     case GPU_DEPTH_COMPONENT32F:
       return GL_DEPTH_COMPONENT32F;
@@ -361,6 +369,14 @@ inline GLenum to_gl_data_format(eGPUTextureFormat format)
       return GL_COMPRESSED_RGBA_S3TC_DXT3_EXT;
     case GPU_RGBA8_DXT5:
       return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+    case GPU_COMPRESSED_RG_RGTC2:
+      return GL_COMPRESSED_RG_RGTC2;
+    case GPU_COMPRESSED_RED_RGTC1:
+      return GL_COMPRESSED_RED_RGTC1;
+    case GPU_SRGB8_A8_BPTC:
+      return GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM;
+    case GPU_RGBA8_BPTC:
+      return GL_COMPRESSED_RGBA_BPTC_UNORM;
     default:
       BLI_assert_msg(0, "Texture format incorrect or unsupported\n");
       return 0;
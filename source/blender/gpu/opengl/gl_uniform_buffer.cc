@@ -76,6 +76,17 @@ void GLUniformBuf::update(const void *data)
   glBindBuffer(GL_UNIFORM_BUFFER, 0);
 }
 
+void GLUniformBuf::update_range(const void *data, size_t offset, size_t size)
+{
+  BLI_assert(offset + size <= size_in_bytes_);
+  if (ubo_id_ == 0) {
+    this->init();
+  }
+  glBindBuffer(GL_UNIFORM_BUFFER, ubo_id_);
+  glBufferSubData(GL_UNIFORM_BUFFER, offset, size, data);
+  glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
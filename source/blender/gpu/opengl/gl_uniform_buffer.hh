@@ -47,6 +47,7 @@ class GLUniformBuf : public UniformBuf {
   ~GLUniformBuf();
 
   void update(const void *data) override;
+  void update_range(const void *data, size_t offset, size_t size) override;
   void bind(int slot) override;
   void unbind(void) override;
 
@@ -775,6 +775,16 @@ struct GPUTexture *IMB_create_gpu_texture(const char *name,
                                           bool use_high_bitdepth,
                                           bool use_premult,
                                           bool limit_gl_texture_size);
+/**
+ * Create a texture of a given size, not greater than the image buffer one.
+ * \attention defined in util_gpu.c
+ */
+struct GPUTexture *IMB_create_gpu_texture_scaled(const char *name,
+                                                 struct ImBuf *ibuf,
+                                                 int w,
+                                                 int h,
+                                                 bool use_high_bitdepth,
+                                                 bool use_premult);
 struct GPUTexture *IMB_touch_gpu_texture(
     const char *name, struct ImBuf *ibuf, int w, int h, int layers, bool use_high_bitdepth);
 void IMB_update_gpu_texture_sub(struct GPUTexture *tex,
@@ -216,13 +216,47 @@ void IMB_update_gpu_texture_sub(GPUTexture *tex,
   }
 }
 
+static GPUTexture *imb_create_gpu_texture_uncompressed(const char *name,
+                                                       ImBuf *ibuf,
+                                                       int size[2],
+                                                       bool do_rescale,
+                                                       bool use_high_bitdepth,
+                                                       bool use_premult)
+{
+  eGPUDataFormat data_format;
+  eGPUTextureFormat tex_format;
+  imb_gpu_get_format(ibuf, use_high_bitdepth, &data_format, &tex_format);
+
+  const bool compress_as_srgb = (tex_format == GPU_SRGB8_A8);
+  bool freebuf = false;
+
+  /* Create Texture. */
+  GPUTexture *tex = GPU_texture_create_2d(name, UNPACK2(size), 9999, tex_format, NULL);
+  if (tex == NULL) {
+    size[0] = max_ii(1, size[0] / 2);
+    size[1] = max_ii(1, size[1] / 2);
+    tex = GPU_texture_create_2d(name, UNPACK2(size), 9999, tex_format, NULL);
+    do_rescale = true;
+  }
+  BLI_assert(tex != NULL);
+  void *data = imb_gpu_get_data(ibuf, do_rescale, size, compress_as_srgb, use_premult, &freebuf);
+  GPU_texture_update(tex, data_format, data);
+
+  GPU_texture_anisotropic_filter(tex, true);
+
+  if (freebuf) {
+    MEM_freeN(data);
+  }
+
+  return tex;
+}
+
 GPUTexture *IMB_create_gpu_texture(const char *name,
                                    ImBuf *ibuf,
                                    bool use_high_bitdepth,
                                    bool use_premult,
                                    bool limit_gl_texture_size)
 {
-  GPUTexture *tex = NULL;
   int size[2] = {GPU_texture_size_with_limit(ibuf->x, limit_gl_texture_size),
                  GPU_texture_size_with_limit(ibuf->y, limit_gl_texture_size)};
   bool do_rescale = (ibuf->x != size[0]) || (ibuf->y != size[1]);
@@ -240,12 +274,12 @@ GPUTexture *IMB_create_gpu_texture(const char *name,
       fprintf(stderr, "Unable to load non-power-of-two DXT image resolution,");
     }
     else {
-      tex = GPU_texture_create_compressed_2d(name,
-                                             ibuf->x,
-                                             ibuf->y,
-                                             ibuf->dds_data.nummipmaps,
-                                             compressed_format,
-                                             ibuf->dds_data.data);
+      GPUTexture *tex = GPU_texture_create_compressed_2d(name,
+                                                         ibuf->x,
+                                                         ibuf->y,
+                                                         ibuf->dds_data.nummipmaps,
+                                                         compressed_format,
+                                                         ibuf->dds_data.data);
 
       if (tex != NULL) {
         return tex;
@@ -258,30 +292,20 @@ GPUTexture *IMB_create_gpu_texture(const char *name,
   }
 #endif
 
-  eGPUDataFormat data_format;
-  eGPUTextureFormat tex_format;
-  imb_gpu_get_format(ibuf, use_high_bitdepth, &data_format, &tex_format);
-
-  const bool compress_as_srgb = (tex_format == GPU_SRGB8_A8);
-  bool freebuf = false;
-
-  /* Create Texture. */
-  tex = GPU_texture_create_2d(name, UNPACK2(size), 9999, tex_format, NULL);
-  if (tex == NULL) {
-    size[0] = max_ii(1, size[0] / 2);
-    size[1] = max_ii(1, size[1] / 2);
-    tex = GPU_texture_create_2d(name, UNPACK2(size), 9999, tex_format, NULL);
-    do_rescale = true;
-  }
-  BLI_assert(tex != NULL);
-  void *data = imb_gpu_get_data(ibuf, do_rescale, size, compress_as_srgb, use_premult, &freebuf);
-  GPU_texture_update(tex, data_format, data);
-
-  GPU_texture_anisotropic_filter(tex, true);
+  return imb_create_gpu_texture_uncompressed(
+      name, ibuf, size, do_rescale, use_high_bitdepth, use_premult);
+}
 
-  if (freebuf) {
-    MEM_freeN(data);
-  }
+GPUTexture *IMB_create_gpu_texture_scaled(const char *name,
+                                          ImBuf *ibuf,
+                                          int w,
+                                          int h,
+                                          bool use_high_bitdepth,
+                                          bool use_premult)
+{
+  int size[2] = {min_ii(w, ibuf->x), min_ii(h, ibuf->y)};
+  const bool do_rescale = (ibuf->x != size[0]) || (ibuf->y != size[1]);
 
-  return tex;
+  return imb_create_gpu_texture_uncompressed(
+      name, ibuf, size, do_rescale, use_high_bitdepth, use_premult);
 }
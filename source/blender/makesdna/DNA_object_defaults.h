@@ -81,6 +81,7 @@
     .friction = 0.5f, \
     .init_state = 1, \
     .state = 1, \
+    .activityCulling = {.logicLodInterval = 4}, \
     .obstacleRad = 1.0f, \
     .step_height = 0.15f, \
     .jump_speed = 10.0f, \
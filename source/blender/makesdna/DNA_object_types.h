@@ -125,15 +125,23 @@ typedef struct ObjectActivityCulling {
   /* For game engine, values around active camera where physics or logic are suspended */
   float physicsRadius;
   float logicRadius;
+  /* Distance where the physics shape is simplified. */
+  float physicsLodRadius;
 
   int flags;
-  int _pad;
+
+  /* Distance where the logic runs every logicLodInterval frames. */
+  float logicLodRadius;
+  short logicLodInterval;
+  char _pad[2];
 } ObjectActivityCulling;
 
 /* object activity flags */
 enum {
   OB_ACTIVITY_PHYSICS = (1 << 0),
   OB_ACTIVITY_LOGIC = (1 << 1),
+  OB_ACTIVITY_PHYSICS_LOD = (1 << 2),
+  OB_ACTIVITY_LOGIC_LOD = (1 << 3),
 };
 
 struct CustomData_MeshMasks;
@@ -226,6 +234,13 @@ typedef struct Object_Runtime {
   /** Runtime evaluated curve-specific data, not stored in the file. */
   struct CurveCache *curve_cache;
 
+  /** Object instanced by #OB_DUPLIGAME, set by the game engine on the original object. */
+  struct Object *game_instance_object;
+  /** World matrices of the game engine instances, 16 floats per instance. */
+  float *game_instance_matrices;
+  int game_instance_count;
+  char _pad3[4];
+
   unsigned short local_collections_bits;
   short _pad2[3];
 } Object_Runtime;
@@ -682,12 +697,14 @@ enum {
   OB_DUPLIFACES = 1 << 9,
   OB_DUPLIFACES_SCALE = 1 << 10,
   OB_DUPLIPARTS = 1 << 11,
-  OB_TRANSFLAG_UNUSED_12 = 1 << 12, /* cleared */
+  /* runtime, instances of Object_Runtime.game_instance_object generated by the game engine,
+   * reuses a cleared flag as the dupli types are stored in a short */
+  OB_DUPLIGAME = 1 << 12,  // UPBGE
   /* runtime constraints disable */
   OB_NO_CONSTRAINTS = 1 << 13,
   OB_TRANSFLAG_OVERRIDE_GAME_PRIORITY = 1 << 14,  // UPBGE
 
-  OB_DUPLI = OB_DUPLIVERTS | OB_DUPLICOLLECTION | OB_DUPLIFACES | OB_DUPLIPARTS,
+  OB_DUPLI = OB_DUPLIVERTS | OB_DUPLICOLLECTION | OB_DUPLIFACES | OB_DUPLIPARTS | OB_DUPLIGAME,
 };
 
 /* (short) trackflag / upflag */
@@ -752,6 +769,7 @@ enum {
   /*  OB_BOUND_DYN_MESH      = 6, */ /*UNUSED*/
   OB_BOUND_CAPSULE = 7,
   OB_BOUND_EMPTY = 8,
+  OB_BOUND_CONVEX_DECOMPOSITION = 9,
 };
 
 /* lod flags */
@@ -843,6 +861,7 @@ enum {
   OB_LOCK_RIGID_BODY_Y_ROT_AXIS = 1 << 6,
   OB_LOCK_RIGID_BODY_Z_ROT_AXIS = 1 << 7,
   OB_CCD_RIGID_BODY = 1 << 8,
+  OB_CCD_AUTO_THRESHOLD = 1 << 9,
 
   /*	OB_LIFE     = OB_PROP | OB_DYNAMIC | OB_ACTOR | OB_MAINACTOR | OB_CHILD, */
 };
@@ -246,6 +246,12 @@ static const EnumPropertyItem collision_bounds_items[] = {
     {OB_BOUND_CONE, "CONE", ICON_MESH_CONE, "Cone", ""},
     {OB_BOUND_CONVEX_HULL, "CONVEX_HULL", ICON_MESH_ICOSPHERE, "Convex Hull", ""},
     {OB_BOUND_TRIANGLE_MESH, "TRIANGLE_MESH", ICON_MESH_MONKEY, "Triangle Mesh", ""},
+    {OB_BOUND_CONVEX_DECOMPOSITION,
+     "CONVEX_DECOMPOSITION",
+     ICON_MESH_ICOSPHERE,
+     "Convex Decomposition",
+     "Compound of convex hulls approximating the mesh, faster than a triangle mesh for the "
+     "dynamic objects"},
     {OB_BOUND_CAPSULE, "CAPSULE", ICON_MESH_CAPSULE, "Capsule", ""},
     {OB_BOUND_EMPTY, "Empty", ICON_EMPTY_DATA, "Empty", ""},
     /*{OB_DYN_MESH, "DYNAMIC_MESH", 0, "Dynamic Mesh", ""}, */
@@ -777,6 +783,12 @@ static const EnumPropertyItem *rna_Object_collision_bounds_itemf(bContext *UNUSE
     RNA_enum_items_add_value(&item, &totitem, collision_bounds_items, OB_BOUND_TRIANGLE_MESH);
   }
 
+  /* The character controller needs a convex shape. */
+  if (!ELEM(ob->body_type, OB_BODY_TYPE_CHARACTER, OB_BODY_TYPE_SOFT)) {
+    RNA_enum_items_add_value(
+        &item, &totitem, collision_bounds_items, OB_BOUND_CONVEX_DECOMPOSITION);
+  }
+
   if (ob->body_type != OB_BODY_TYPE_SOFT) {
     RNA_enum_items_add_value(&item, &totitem, collision_bounds_items, OB_BOUND_CONVEX_HULL);
     RNA_enum_items_add_value(&item, &totitem, collision_bounds_items, OB_BOUND_CONE);
@@ -2891,6 +2903,39 @@ static void rna_def_game_object_activity_culling(BlenderRNA *brna)
       prop,
       "Cull Logic",
       "Suspend logic and animation of this object by its distance to nearest camera");
+
+  prop = RNA_def_property(srna, "physics_lod_radius", PROP_FLOAT, PROP_DISTANCE);
+  RNA_def_property_float_sdna(prop, NULL, "physicsLodRadius");
+  RNA_def_property_range(prop, 0.0, FLT_MAX);
+  RNA_def_property_ui_text(
+      prop, "Physics LOD Radius", "Distance to begin simplify the physics shape of this object");
+
+  prop = RNA_def_property(srna, "use_physics_lod", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "flags", OB_ACTIVITY_PHYSICS_LOD);
+  RNA_def_property_ui_text(prop,
+                           "Physics LOD",
+                           "Replace the mesh or convex hull physics shape of this dynamic object "
+                           "by its bounding box and disable its continuous collision detection "
+                           "by its distance to nearest camera");
+
+  prop = RNA_def_property(srna, "logic_lod_radius", PROP_FLOAT, PROP_DISTANCE);
+  RNA_def_property_float_sdna(prop, NULL, "logicLodRadius");
+  RNA_def_property_range(prop, 0.0, FLT_MAX);
+  RNA_def_property_ui_text(
+      prop, "Logic LOD Radius", "Distance to begin run the logic of this object less often");
+
+  prop = RNA_def_property(srna, "logic_lod_interval", PROP_INT, PROP_NONE);
+  RNA_def_property_int_sdna(prop, NULL, "logicLodInterval");
+  RNA_def_property_range(prop, 1, 1000);
+  RNA_def_property_ui_text(
+      prop, "Logic LOD Interval", "Number of logic frames between two runs of the logic");
+
+  prop = RNA_def_property(srna, "use_logic_lod", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "flags", OB_ACTIVITY_LOGIC_LOD);
+  RNA_def_property_ui_text(prop,
+                           "Logic LOD",
+                           "Run the sensors and components of this object only every few logic "
+                           "frames by its distance to nearest camera");
 }
 
 static void rna_def_object_game_settings(BlenderRNA *brna)
@@ -3323,6 +3368,13 @@ static void rna_def_object_game_settings(BlenderRNA *brna)
                            "Continuous Collision Detection",
                            "Enable Continuous Collision Detection for the rigid body");
 
+  prop = RNA_def_property(srna, "use_ccd_auto_threshold", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "gameflag2", OB_CCD_AUTO_THRESHOLD);
+  RNA_def_property_ui_text(prop,
+                           "Automatic Thresholds",
+                           "Derive the motion threshold and the swept sphere radius from the "
+                           "bounds of the collision shape");
+
   prop = RNA_def_property(srna, "ccd_motion_threshold", PROP_FLOAT, PROP_NONE);
   RNA_def_property_float_sdna(prop, NULL, "ccd_motion_threshold");
   RNA_def_property_range(prop, 0, 100);
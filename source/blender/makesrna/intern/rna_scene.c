@@ -5580,6 +5580,49 @@ static void rna_def_scene_game_data(BlenderRNA *brna)
   RNA_def_property_ui_text(prop, "Physics Solver", "Physics constraint solver");
   RNA_def_property_update(prop, NC_SCENE, NULL);
 
+  prop = RNA_def_property(srna, "use_multithreaded_physics", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "flag", GAME_USE_MULTITHREADED_PHYSICS);
+  RNA_def_property_ui_text(prop,
+                           "Multithreaded Physics",
+                           "Process the collisions and the constraints of the physics on all "
+                           "threads, the collisions are processed on one thread once soft bodies "
+                           "are added");
+  RNA_def_property_update(prop, NC_SCENE, NULL);
+
+  prop = RNA_def_property(srna, "use_physics_bvh_cache", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "flag", GAME_USE_PHYSICS_BVH_CACHE);
+  RNA_def_property_ui_text(prop,
+                           "BVH Cache",
+                           "Load the bounding volume hierarchy of the large triangle mesh "
+                           "collision shapes from the user cache directory instead of building "
+                           "it at each game start");
+  RNA_def_property_update(prop, NC_SCENE, NULL);
+
+  prop = RNA_def_property(srna, "use_dbvt_culling", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "flag", GAME_USE_DBVT_CULLING);
+  RNA_def_property_ui_text(prop,
+                           "Frustum Culling",
+                           "Skip the drawing of the mesh objects outside of the camera view using "
+                           "the bounding volume tree of the physics engine, culled objects don't "
+                           "cast shadows in the render pass");
+  RNA_def_property_update(prop, NC_SCENE, NULL);
+
+  prop = RNA_def_property(srna, "use_occlusion_culling", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "flag", GAME_USE_OCCLUSION_CULLING);
+  RNA_def_property_ui_text(prop,
+                           "Occlusion Culling",
+                           "Also skip the drawing of the mesh objects hidden behind the objects "
+                           "marked as occluders");
+  RNA_def_property_update(prop, NC_SCENE, NULL);
+
+  prop = RNA_def_property(srna, "use_gpu_occlusion_culling", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "flag", GAME_USE_GPU_OCCLUSION_CULLING);
+  RNA_def_property_ui_text(prop,
+                           "GPU Occlusion",
+                           "Also skip the drawing of the mesh objects hidden in the depth of the "
+                           "previous frame, tested on the GPU (requires compute shaders)");
+  RNA_def_property_update(prop, NC_SCENE, NULL);
+
   prop = RNA_def_property(srna, "occlusion_culling_resolution", PROP_INT, PROP_PIXEL);
   RNA_def_property_int_sdna(prop, NULL, "occlusionRes");
   RNA_def_property_range(prop, 128.0, 1024.0);
@@ -5783,6 +5826,13 @@ static void rna_def_scene_game_data(BlenderRNA *brna)
       "Restrict the number of animation updates to the animation FPS (this is "
       "better for performance, but can cause issues with smooth playback)");
 
+  prop = RNA_def_property(srna, "use_animation_culling", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "flag", GAME_USE_ANIMATION_CULLING);
+  RNA_def_property_ui_text(prop,
+                           "Animation Culling",
+                           "Don't evaluate the pose of the armatures whose meshes are outside of "
+                           "the camera views, only their actions time is updated");
+
   prop = RNA_def_property(srna, "use_python_console", PROP_BOOLEAN, PROP_NONE);
   RNA_def_property_boolean_sdna(prop, NULL, "flag", GAME_PYTHON_CONSOLE);
   RNA_def_property_ui_text(prop, "Python Console", "Create a python interpreter console in game");
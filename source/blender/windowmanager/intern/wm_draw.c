@@ -1090,6 +1090,91 @@ void wm_draw_update(bContext *C)
   GPU_context_main_unlock();
 }
 
+/* The other regions of the window need a redraw before they can be blitted. */
+static bool wm_draw_game_window_needs_update(wmWindow *win, ARegion *game_region)
+{
+  bScreen *screen = WM_window_get_active_screen(win);
+
+  if (screen->do_refresh || screen->do_draw || WM_stereo3d_enabled(win, false)) {
+    return true;
+  }
+
+  ED_screen_areas_iter (win, screen, area) {
+    LISTBASE_FOREACH (ARegion *, region, &area->regionbase) {
+      if (region != game_region && region->visible && region->draw_buffer == NULL) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+/**
+ * Game engine variant of #wm_draw_update, only the game region of the context window is
+ * redrawn. The other regions are blitted from their last draw, without their layout, the
+ * region overlays or the paint cursors. Falls back to #wm_draw_update when the window needs
+ * a full redraw.
+ */
+void wm_draw_game_update(bContext *C)
+{
+  wmWindowManager *wm = CTX_wm_manager(C);
+  wmWindow *win = CTX_wm_window(C);
+  ScrArea *game_area = CTX_wm_area(C);
+  ARegion *game_region = CTX_wm_region(C);
+
+  if (!win || !game_area || !game_region || wm_draw_game_window_needs_update(win, game_region)) {
+    wm_draw_update(C);
+    return;
+  }
+
+  bScreen *screen = WM_window_get_active_screen(win);
+
+  GPU_context_main_lock();
+  BKE_image_free_unused_gpu_textures();
+
+  wm_window_make_drawable(wm, win);
+
+  /* Avoid any BGL call issued before this to alter the window drawing. */
+  GPU_bgl_end();
+
+  const bool use_viewport = WM_region_use_viewport(game_area, game_region);
+  wm_draw_region_buffer_create(game_region, false, use_viewport);
+  wm_draw_region_bind(game_region, 0);
+  ED_region_do_draw(C, game_region);
+  wm_draw_region_unbind(game_region);
+  game_region->do_draw = false;
+
+  wmWindowViewport(win);
+
+  ED_screen_areas_iter (win, screen, area) {
+    LISTBASE_FOREACH (ARegion *, region, &area->regionbase) {
+      if (region->visible && !region->overlap) {
+        wm_draw_region_blit(region, -1);
+      }
+    }
+  }
+  ED_screen_areas_iter (win, screen, area) {
+    LISTBASE_FOREACH (ARegion *, region, &area->regionbase) {
+      if (region->visible && region->overlap) {
+        wm_draw_region_blend(region, 0, true);
+      }
+    }
+  }
+
+  ED_screen_draw_edges(win);
+  wmWindowViewport(win);
+
+  LISTBASE_FOREACH (ARegion *, region, &screen->regionbase) {
+    if (region->visible) {
+      wm_draw_region_blend(region, 0, true);
+    }
+  }
+
+  wm_window_swap_buffers(win);
+
+  GPU_context_main_unlock();
+}
+
 void wm_draw_region_clear(wmWindow *win, ARegion *UNUSED(region))
 {
   bScreen *screen = WM_window_get_active_screen(win);
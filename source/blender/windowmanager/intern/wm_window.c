@@ -2559,6 +2559,28 @@ void wm_window_ghostwindow_blenderplayer_ensure(wmWindowManager *wm,
   }
 }
 
+void wm_window_blenderplayer_headless_ensure(wmWindowManager *wm,
+                                             wmWindow *win,
+                                             int width,
+                                             int height,
+                                             bool first_time_window)
+{
+  /* No ghost window nor GPU context, only the message bus is needed by the runtime. */
+  win->ghostwin = NULL;
+  win->gpuctx = NULL;
+
+  if (first_time_window) {
+    wm->message_bus = WM_msgbus_create();
+    runtime_msgbus = wm->message_bus;
+  }
+  else {
+    wm->message_bus = runtime_msgbus;
+  }
+
+  win->sizex = width;
+  win->sizey = height;
+}
+
 void wm_window_ghostwindow_embedded_ensure(wmWindowManager *wm, wmWindow *win)
 {
   wm_window_clear_drawable(wm);
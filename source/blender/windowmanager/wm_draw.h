@@ -45,6 +45,7 @@ struct wmWindow;
 
 /* wm_draw.c */
 void wm_draw_update(struct bContext *C);
+void wm_draw_game_update(struct bContext *C);
 void wm_draw_region_clear(struct wmWindow *win, struct ARegion *region);
 void wm_draw_region_blend(struct ARegion *region, int view, bool blend);
 void wm_draw_region_test(struct bContext *C, struct ScrArea *area, struct ARegion *region);
@@ -94,6 +94,12 @@ void wm_window_ghostwindow_blenderplayer_ensure(struct wmWindowManager *wm,
                                                 struct wmWindow *win,
                                                 void *ghostwin,
                                                 bool first_time_window);
+/* Setup a window without ghost window nor GPU context for the headless blenderplayer. */
+void wm_window_blenderplayer_headless_ensure(struct wmWindowManager *wm,
+                                             struct wmWindow *win,
+                                             int width,
+                                             int height,
+                                             bool first_time_window);
 
 void wm_window_ghostwindow_embedded_ensure(struct wmWindowManager *wm, struct wmWindow *win);
 /* End of UPBGE */
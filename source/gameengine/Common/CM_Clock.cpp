@@ -1,5 +1,7 @@
 #include "CM_Clock.h"
 
+#include <thread>
+
 CM_Clock::CM_Clock()
 {
   Reset();
@@ -17,6 +19,18 @@ double CM_Clock::GetTimeSecond() const
 
 CM_Clock::Rep CM_Clock::GetTimeNano() const
 {
-  const std::chrono::high_resolution_clock::time_point now = m_clock.now();
+  const std::chrono::steady_clock::time_point now = m_clock.now();
   return std::chrono::duration_cast<std::chrono::nanoseconds>(now - m_start).count();
 }
+
+void CM_Clock::WaitUntil(double time, double busyWaitTime) const
+{
+  const double sleeptime = time - busyWaitTime - GetTimeSecond();
+  if (sleeptime > 0.0) {
+    std::this_thread::sleep_for(std::chrono::nanoseconds((Rep)(sleeptime * 1.0e9)));
+  }
+
+  while (GetTimeSecond() < time) {
+    std::this_thread::yield();
+  }
+}
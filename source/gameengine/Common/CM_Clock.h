@@ -7,8 +7,8 @@ class CM_Clock {
   using Rep = std::chrono::nanoseconds::rep;
 
  private:
-  std::chrono::high_resolution_clock::time_point m_start;
-  std::chrono::high_resolution_clock m_clock;
+  std::chrono::steady_clock::time_point m_start;
+  std::chrono::steady_clock m_clock;
 
  public:
   CM_Clock();
@@ -17,4 +17,10 @@ class CM_Clock {
 
   double GetTimeSecond() const;
   Rep GetTimeNano() const;
+
+  /** Wait until the clock reaches a time in seconds. The thread sleeps until
+   * busyWaitTime seconds before the time and busy waits the remaining time
+   * to not depend on the sleep resolution of the system.
+   */
+  void WaitUntil(double time, double busyWaitTime) const;
 };
@@ -0,0 +1,157 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Common/CM_JobGraph.cpp
+ *  \ingroup common
+ */
+
+#include "CM_JobGraph.h"
+
+#include "BLI_assert.h"
+#include "BLI_utildefines.h"
+
+CM_JobGraph::CM_JobGraph(eTaskPriority priority)
+{
+  m_pool = BLI_task_pool_create(this, priority);
+}
+
+CM_JobGraph::~CM_JobGraph()
+{
+  BLI_task_pool_free(m_pool);
+}
+
+unsigned int CM_JobGraph::AddJob(const Function &function)
+{
+  Job *job = new Job();
+  job->m_function = function;
+  job->m_numDependencies = 0;
+  m_jobs.emplace_back(job);
+
+  return m_jobs.size() - 1;
+}
+
+void CM_JobGraph::AddDependency(unsigned int job, unsigned int dependency)
+{
+  BLI_assert(job != dependency && job < m_jobs.size() && dependency < m_jobs.size());
+
+  m_jobs[dependency]->m_successors.push_back(job);
+  ++m_jobs[job]->m_numDependencies;
+}
+
+unsigned int CM_JobGraph::GetNumJobs() const
+{
+  return m_jobs.size();
+}
+
+void CM_JobGraph::Clear()
+{
+  m_jobs.clear();
+}
+
+void CM_JobGraph::Push(Job *job)
+{
+  BLI_task_pool_push(m_pool, RunJob, job, false, nullptr);
+}
+
+void CM_JobGraph::RunJob(TaskPool *__restrict pool, void *taskdata)
+{
+  CM_JobGraph *graph = (CM_JobGraph *)BLI_task_pool_user_data(pool);
+  Job *job = (Job *)taskdata;
+
+  job->m_function();
+
+  // The last finished dependency pushes the successor.
+  for (unsigned int index : job->m_successors) {
+    Job *successor = graph->m_jobs[index].get();
+    if (successor->m_pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      graph->Push(successor);
+    }
+  }
+
+#ifndef NDEBUG
+  graph->m_numDone.fetch_add(1, std::memory_order_relaxed);
+#endif
+}
+
+void CM_JobGraph::Run()
+{
+  if (m_jobs.empty()) {
+    return;
+  }
+
+#ifndef NDEBUG
+  m_numDone.store(0, std::memory_order_relaxed);
+#endif
+
+  // Reset all the counters before pushing any job, a job can finish before the next push.
+  for (std::unique_ptr<Job> &job : m_jobs) {
+    job->m_pending.store(job->m_numDependencies, std::memory_order_relaxed);
+  }
+
+  for (std::unique_ptr<Job> &job : m_jobs) {
+    if (job->m_numDependencies == 0) {
+      Push(job.get());
+    }
+  }
+
+  BLI_task_pool_work_and_wait(m_pool);
+
+  // A job not run belongs to a dependency cycle.
+  BLI_assert(m_numDone.load(std::memory_order_relaxed) == m_jobs.size());
+}
+
+static void parallel_for_task(void *__restrict userdata,
+                              const int index,
+                              const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const std::function<void(unsigned int)> &function =
+      *(const std::function<void(unsigned int)> *)userdata;
+  function(index);
+}
+
+void CM_ParallelFor(unsigned int size,
+                    const std::function<void(unsigned int)> &function,
+                    unsigned int grainSize)
+{
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = grainSize;
+  BLI_task_parallel_range(0, size, (void *)&function, parallel_for_task, &settings);
+}
+
+static void parallel_invoke_task(TaskPool *__restrict UNUSED(pool), void *taskdata)
+{
+  (*(const CM_JobGraph::Function *)taskdata)();
+}
+
+void CM_ParallelInvoke(const std::vector<CM_JobGraph::Function> &functions)
+{
+  if (functions.size() == 1) {
+    functions[0]();
+    return;
+  }
+
+  TaskPool *pool = BLI_task_pool_create(nullptr, TASK_PRIORITY_HIGH);
+  for (const CM_JobGraph::Function &function : functions) {
+    BLI_task_pool_push(pool, parallel_invoke_task, (void *)&function, false, nullptr);
+  }
+  BLI_task_pool_work_and_wait(pool);
+  BLI_task_pool_free(pool);
+}
@@ -0,0 +1,91 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file CM_JobGraph.h
+ *  \ingroup common
+ */
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "BLI_task.h"
+
+/** Graph of jobs run on the task scheduler shared by all the engine stages. A job is pushed
+ * as soon as all its dependencies are done, the independent jobs run in parallel without
+ * a join between them. The graph is kept between runs to avoid the allocations each frame.
+ */
+class CM_JobGraph {
+ public:
+  using Function = std::function<void()>;
+
+ private:
+  struct Job {
+    Function m_function;
+    /// Jobs depending on this job.
+    std::vector<unsigned int> m_successors;
+    unsigned int m_numDependencies;
+    /// Dependencies not yet done during a run.
+    std::atomic<unsigned int> m_pending;
+  };
+
+  /// Jobs are not movable because of their atomic counter.
+  std::vector<std::unique_ptr<Job>> m_jobs;
+  TaskPool *m_pool;
+#ifndef NDEBUG
+  std::atomic<unsigned int> m_numDone;
+#endif
+
+  static void RunJob(TaskPool *__restrict pool, void *taskdata);
+  void Push(Job *job);
+
+ public:
+  explicit CM_JobGraph(eTaskPriority priority = TASK_PRIORITY_HIGH);
+  ~CM_JobGraph();
+
+  CM_JobGraph(const CM_JobGraph &other) = delete;
+  CM_JobGraph &operator=(const CM_JobGraph &other) = delete;
+
+  /// Add a job and return its index.
+  unsigned int AddJob(const Function &function);
+  /// Run the job after its dependency.
+  void AddDependency(unsigned int job, unsigned int dependency);
+  unsigned int GetNumJobs() const;
+  /// Remove all the jobs.
+  void Clear();
+
+  /// Run all the jobs and wait until they are done.
+  void Run();
+};
+
+/** Fork-join helpers on the scheduler of the job graphs, the calling thread takes part in the
+ * work and returns once all of it is done.
+ */
+/** Call the function for each index of [0, size[ in parallel.
+ * \param grainSize The minimum number of indices run by a thread.
+ */
+void CM_ParallelFor(unsigned int size,
+                    const std::function<void(unsigned int)> &function,
+                    unsigned int grainSize = 1);
+/// Call the functions in parallel.
+void CM_ParallelInvoke(const std::vector<CM_JobGraph::Function> &functions);
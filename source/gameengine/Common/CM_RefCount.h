@@ -26,14 +26,20 @@
 
 #pragma once
 
+#include <atomic>
+#include <type_traits>
+
 #include "BLI_utildefines.h"
 
 /** \brief Reference counter base class. This class manages the destruction of an object
  * based on a reference counter, when the counter is to zero the object is destructed.
+ * The counter is atomic so that the objects can be shared by the threads, the classes of
+ * objects only referenced by one thread at a time can use a plain counter with ThreadSafe
+ * set to false.
  */
-template<class T> class CM_RefCount {
+template<class T, bool ThreadSafe = true> class CM_RefCount {
  private:
-  int m_refCount;
+  std::conditional_t<ThreadSafe, std::atomic<int>, int> m_refCount;
 
  public:
   CM_RefCount() : m_refCount(1)
@@ -44,16 +50,44 @@ template<class T> class CM_RefCount {
   {
   }
 
-  CM_RefCount(const CM_RefCount &UNUSED(other))
+  CM_RefCount(const CM_RefCount &UNUSED(other)) : m_refCount(1)
+  {
+  }
+
+  /// The references are to this object, the counter is kept when an other object is assigned.
+  CM_RefCount &operator=(const CM_RefCount &UNUSED(other))
   {
-    m_refCount = 1;
+    return *this;
   }
 
   /// Increase the reference count of the object.
   T *AddRef()
   {
-    BLI_assert(m_refCount > 0);
-    ++m_refCount;
+    BLI_assert(GetRefCount() > 0);
+    if constexpr (ThreadSafe) {
+      // The caller already holds a reference, no ordering is needed.
+      m_refCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    else {
+      ++m_refCount;
+    }
+
+    return static_cast<T *>(this);
+  }
+
+  /** Increase the reference count of an object found in a shared registry, unless its last
+   * reference was released and it is waiting to be removed from the registry by its destructor.
+   * \return nullptr if the object is being destructed.
+   */
+  T *TryAddRef()
+  {
+    static_assert(ThreadSafe, "TryAddRef is only meant for the objects shared by the threads");
+    int count = m_refCount.load(std::memory_order_relaxed);
+    do {
+      if (count == 0) {
+        return nullptr;
+      }
+    } while (!m_refCount.compare_exchange_weak(count, count + 1, std::memory_order_relaxed));
 
     return static_cast<T *>(this);
   }
@@ -61,9 +95,17 @@ template<class T> class CM_RefCount {
   /// Decrease the reference count of the object and destruct at zero.
   T *Release()
   {
-    BLI_assert(m_refCount > 0);
-    --m_refCount;
-    if (m_refCount == 0) {
+    BLI_assert(GetRefCount() > 0);
+    int count;
+    if constexpr (ThreadSafe) {
+      // The writes of the other owners must be visible to the thread destructing the object.
+      count = m_refCount.fetch_sub(1, std::memory_order_acq_rel) - 1;
+    }
+    else {
+      count = --m_refCount;
+    }
+
+    if (count == 0) {
       delete this;
       return nullptr;
     }
@@ -73,7 +115,12 @@ template<class T> class CM_RefCount {
 
   int GetRefCount() const
   {
-    return m_refCount;
+    if constexpr (ThreadSafe) {
+      return m_refCount.load(std::memory_order_relaxed);
+    }
+    else {
+      return m_refCount;
+    }
   }
 };
 
@@ -0,0 +1,76 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file CM_RingBuffer.h
+ *  \ingroup common
+ */
+
+#pragma once
+
+#include <atomic>
+
+/** Fixed size lock-free queue between one producer thread and one consumer thread, the
+ * producer and the consumer can be the same thread.
+ */
+template<class Item, unsigned int Size> class CM_RingBuffer {
+  static_assert((Size & (Size - 1)) == 0, "The size must be a power of two");
+
+ private:
+  Item m_items[Size];
+  /// Index of the next pushed item, only written by the producer.
+  std::atomic<unsigned int> m_head;
+  /// Index of the next popped item, only written by the consumer.
+  std::atomic<unsigned int> m_tail;
+
+ public:
+  CM_RingBuffer() : m_head(0), m_tail(0)
+  {
+  }
+
+  /** Add an item, called by the producer.
+   * \return False if the queue is full, the item is not added.
+   */
+  bool Push(const Item &item)
+  {
+    const unsigned int head = m_head.load(std::memory_order_relaxed);
+    if (head - m_tail.load(std::memory_order_acquire) == Size) {
+      return false;
+    }
+
+    m_items[head & (Size - 1)] = item;
+    m_head.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  /** Remove the oldest item, called by the consumer.
+   * \return False if the queue is empty.
+   */
+  bool Pop(Item &item)
+  {
+    const unsigned int tail = m_tail.load(std::memory_order_relaxed);
+    if (tail == m_head.load(std::memory_order_acquire)) {
+      return false;
+    }
+
+    item = m_items[tail & (Size - 1)];
+    m_tail.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+};
@@ -0,0 +1,246 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Common/CM_StartupProfiler.cpp
+ *  \ingroup common
+ */
+
+#include "CM_StartupProfiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+#include "CM_Message.h"
+#include "CM_Trace.h"
+
+/// Number of the slowest items printed.
+static const unsigned int STARTUP_PRINTED_ITEMS = 20;
+
+namespace {
+
+struct StartupEvent {
+  const char *m_name;
+  std::string m_label;
+  std::chrono::steady_clock::duration m_start;
+  std::chrono::steady_clock::duration m_end;
+  unsigned int m_thread;
+  unsigned int m_depth;
+  bool m_item;
+};
+
+/// Total time and time per scope name of an item.
+typedef std::pair<double, std::map<std::string, double>> ItemTimes;
+
+/// Open scope of a thread.
+struct StartupScope {
+  unsigned int m_event;
+  /// The scope is also open in the trace.
+  bool m_traced;
+};
+
+std::mutex eventsMutex;
+std::vector<StartupEvent> events;
+std::chrono::steady_clock::time_point startTime;
+std::string tracePath;
+/// Number of the threads which recorded a scope, the main thread is the first one.
+std::atomic<unsigned int> numThreads(0);
+/// Incremented at each start to forget the scopes left open by the previous recording.
+unsigned int generation = 0;
+
+thread_local unsigned int threadIndex = (unsigned int)-1;
+thread_local unsigned int threadGeneration = 0;
+thread_local std::vector<StartupScope> threadScopes;
+
+}  // namespace
+
+std::atomic<bool> CM_StartupProfiler::m_enabled(false);
+
+static double to_ms(std::chrono::steady_clock::duration duration)
+{
+  return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+void CM_StartupProfiler::Start(const std::string &filepath)
+{
+  if (m_enabled) {
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(eventsMutex);
+    events.clear();
+    ++generation;
+    tracePath = filepath;
+    startTime = std::chrono::steady_clock::now();
+  }
+
+  if (!tracePath.empty()) {
+    CM_Trace::Start();
+  }
+
+  m_enabled = true;
+}
+
+void CM_StartupProfiler::Stop()
+{
+  if (!m_enabled) {
+    return;
+  }
+  m_enabled = false;
+
+  std::lock_guard<std::mutex> lock(eventsMutex);
+  const std::chrono::steady_clock::duration total = std::chrono::steady_clock::now() -
+                                                    startTime;
+
+  std::ostringstream stream;
+  stream << std::fixed << std::setprecision(1);
+  stream << "Startup timeline: " << to_ms(total) << " ms" << std::endl;
+
+  /* The phases per thread in the order of their start, the items are only summed. The events
+   * are sorted by their start per thread as the scopes opened first are recorded first. */
+  std::vector<const StartupEvent *> phases;
+  std::map<std::string, ItemTimes> items;
+  for (const StartupEvent &event : events) {
+    const double duration = to_ms(event.m_end - event.m_start);
+    if (event.m_item) {
+      ItemTimes &item = items[event.m_label];
+      item.first += duration;
+      item.second[event.m_name] += duration;
+    }
+    else {
+      phases.push_back(&event);
+    }
+  }
+  std::stable_sort(phases.begin(),
+                   phases.end(),
+                   [](const StartupEvent *event1, const StartupEvent *event2) {
+                     return (event1->m_thread < event2->m_thread);
+                   });
+
+  unsigned int thread = 0;
+  for (const StartupEvent *event : phases) {
+    if (event->m_thread != thread) {
+      thread = event->m_thread;
+      stream << "  Thread " << thread << ":" << std::endl;
+    }
+    std::ostringstream name;
+    name << std::string(2 + event->m_depth * 2, ' ') << event->m_name;
+    stream << std::left << std::setw(40) << name.str() << std::right << std::setw(10)
+           << to_ms(event->m_end - event->m_start) << " ms at " << std::setw(8)
+           << to_ms(event->m_start) << " ms";
+    if (!event->m_label.empty()) {
+      stream << "  " << event->m_label;
+    }
+    stream << std::endl;
+  }
+
+  if (!items.empty()) {
+    std::vector<const std::pair<const std::string, ItemTimes> *> sortedItems;
+    for (const std::pair<const std::string, ItemTimes> &item : items) {
+      sortedItems.push_back(&item);
+    }
+    const unsigned int numPrinted = std::min<unsigned int>(sortedItems.size(),
+                                                           STARTUP_PRINTED_ITEMS);
+    std::partial_sort(sortedItems.begin(),
+                      sortedItems.begin() + numPrinted,
+                      sortedItems.end(),
+                      [](const std::pair<const std::string, ItemTimes> *item1,
+                         const std::pair<const std::string, ItemTimes> *item2) {
+                        return (item1->second.first > item2->second.first);
+                      });
+
+    stream << "Slowest of " << items.size() << " items:" << std::endl;
+    for (unsigned int i = 0; i < numPrinted; ++i) {
+      const std::pair<const std::string, ItemTimes> &item = *sortedItems[i];
+      stream << "  " << std::left << std::setw(38) << item.first << std::right << std::setw(10)
+             << item.second.first << " ms ";
+      const char *separator = "(";
+      for (const std::pair<const std::string, double> &scope : item.second.second) {
+        stream << separator << scope.first << " " << scope.second << " ms";
+        separator = ", ";
+      }
+      stream << ")" << std::endl;
+    }
+  }
+
+  CM_Message(stream.str());
+
+  if (!tracePath.empty() && CM_Trace::IsEnabled()) {
+    if (CM_Trace::Stop(tracePath)) {
+      CM_Message("Startup trace written to " << tracePath);
+    }
+    else {
+      CM_Error("cannot write startup trace file: " << tracePath);
+    }
+  }
+
+  events.clear();
+  // The scopes closed after the stop are ignored.
+  ++generation;
+}
+
+void CM_StartupProfiler::Begin(const char *name, const char *label, bool item)
+{
+  if (threadIndex == (unsigned int)-1) {
+    threadIndex = numThreads++;
+  }
+
+  const bool traced = CM_Trace::IsEnabled();
+  if (traced) {
+    CM_Trace::Begin(name, label ? label : "");
+  }
+
+  std::lock_guard<std::mutex> lock(eventsMutex);
+  if (threadGeneration != generation) {
+    threadScopes.clear();
+    threadGeneration = generation;
+  }
+
+  const std::chrono::steady_clock::duration time = std::chrono::steady_clock::now() - startTime;
+  threadScopes.push_back({(unsigned int)events.size(), traced});
+  events.push_back({name,
+                    label ? label : "",
+                    time,
+                    time,
+                    threadIndex,
+                    (unsigned int)threadScopes.size() - 1,
+                    item});
+}
+
+void CM_StartupProfiler::End()
+{
+  std::lock_guard<std::mutex> lock(eventsMutex);
+  if (threadGeneration != generation || threadScopes.empty()) {
+    return;
+  }
+
+  const StartupScope scope = threadScopes.back();
+  threadScopes.pop_back();
+  events[scope.m_event].m_end = std::chrono::steady_clock::now() - startTime;
+
+  if (scope.m_traced) {
+    CM_Trace::End();
+  }
+}
@@ -0,0 +1,85 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file CM_StartupProfiler.h
+ *  \ingroup common
+ */
+
+#pragma once
+
+#include <atomic>
+#include <string>
+
+/** Timeline of the startup from the file read to the end of the first frame. The phases and
+ * the items converted or started, e.g. the objects, are recorded from any thread and printed
+ * at the end of the startup with the slowest items.
+ * The scopes are also recorded in the Chrome trace of CM_Trace, the startup can be exported
+ * by recording a trace during the startup.
+ */
+class CM_StartupProfiler {
+ private:
+  static std::atomic<bool> m_enabled;
+
+ public:
+  static inline bool IsEnabled()
+  {
+    return m_enabled.load(std::memory_order_relaxed);
+  }
+
+  /** Clear the timeline and start recording, does nothing if already recording.
+   * \param tracePath Record a Chrome trace written to this file at the stop if not empty.
+   */
+  static void Start(const std::string &tracePath);
+  /** Stop recording, print the timeline and write the trace.
+   * Must be called when no other thread is recording.
+   */
+  static void Stop();
+
+  /** Open a scope on the current thread.
+   * \param name The scope name, it must stay valid until the stop.
+   * \param label Optional label of the scope, e.g the object name.
+   * \param item The scope measures an item, the items are summed per label.
+   */
+  static void Begin(const char *name, const char *label = nullptr, bool item = false);
+  /// Close the last scope on the current thread.
+  static void End();
+};
+
+/// Record a startup scope on the current thread for the lifetime of this object.
+class CM_StartupScope {
+ private:
+  bool m_active;
+
+ public:
+  inline CM_StartupScope(const char *name, const char *label = nullptr, bool item = false)
+      : m_active(CM_StartupProfiler::IsEnabled())
+  {
+    if (m_active) {
+      CM_StartupProfiler::Begin(name, label, item);
+    }
+  }
+
+  inline ~CM_StartupScope()
+  {
+    if (m_active) {
+      CM_StartupProfiler::End();
+    }
+  }
+};
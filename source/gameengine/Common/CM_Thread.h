@@ -28,35 +28,100 @@
 
 #include "BLI_threads.h"
 
-class CM_ThreadLock {
+/** Lock types without virtual functions, they can be used in the hot paths and their calls are
+ * inlined. A copy creates a new unlocked lock, the lock state is never shared.
+ */
+
+/// Lock for the short critical sections, the waiting threads spin.
+class CM_ThreadSpinLock {
  public:
-  CM_ThreadLock();
-  virtual ~CM_ThreadLock();
+  CM_ThreadSpinLock()
+  {
+    BLI_spin_init(&m_spinlock);
+  }
 
-  virtual void Lock() = 0;
-  virtual void Unlock() = 0;
-};
+  ~CM_ThreadSpinLock()
+  {
+    BLI_spin_end(&m_spinlock);
+  }
 
-class CM_ThreadSpinLock : public CM_ThreadLock {
- public:
-  CM_ThreadSpinLock();
-  virtual ~CM_ThreadSpinLock();
+  CM_ThreadSpinLock(const CM_ThreadSpinLock &)
+  {
+    BLI_spin_init(&m_spinlock);
+  }
+
+  CM_ThreadSpinLock &operator=(const CM_ThreadSpinLock &)
+  {
+    return *this;
+  }
 
-  virtual void Lock();
-  virtual void Unlock();
+  void Lock()
+  {
+    BLI_spin_lock(&m_spinlock);
+  }
+
+  void Unlock()
+  {
+    BLI_spin_unlock(&m_spinlock);
+  }
 
  private:
   SpinLock m_spinlock;
 };
 
-class CM_ThreadMutex : public CM_ThreadLock {
+/// Lock for the long critical sections, the waiting threads sleep.
+class CM_ThreadMutex {
  public:
-  CM_ThreadMutex();
-  virtual ~CM_ThreadMutex();
+  CM_ThreadMutex()
+  {
+    BLI_mutex_init(&m_mutex);
+  }
+
+  ~CM_ThreadMutex()
+  {
+    BLI_mutex_end(&m_mutex);
+  }
+
+  CM_ThreadMutex(const CM_ThreadMutex &)
+  {
+    BLI_mutex_init(&m_mutex);
+  }
+
+  CM_ThreadMutex &operator=(const CM_ThreadMutex &)
+  {
+    return *this;
+  }
 
-  virtual void Lock();
-  virtual void Unlock();
+  void Lock()
+  {
+    BLI_mutex_lock(&m_mutex);
+  }
+
+  void Unlock()
+  {
+    BLI_mutex_unlock(&m_mutex);
+  }
 
  private:
   ThreadMutex m_mutex;
 };
+
+/// Hold a lock for the lifetime of the guard.
+template<class Lock> class CM_ThreadLockGuard {
+ public:
+  explicit CM_ThreadLockGuard(Lock &lock) : m_lock(lock)
+  {
+    m_lock.Lock();
+  }
+
+  ~CM_ThreadLockGuard()
+  {
+    m_lock.Unlock();
+  }
+
+  CM_ThreadLockGuard(const CM_ThreadLockGuard &other) = delete;
+  CM_ThreadLockGuard &operator=(const CM_ThreadLockGuard &other) = delete;
+
+ private:
+  Lock &m_lock;
+};
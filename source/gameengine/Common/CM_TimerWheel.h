@@ -0,0 +1,244 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file CM_TimerWheel.h
+ *  \ingroup common
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+/** Hierarchical timer wheel, the timers are hashed in slots per expiry tick on levels of
+ * growing granularity. A timer is only touched when its slot of a coarse level is cascaded to
+ * the finer level, and when it expires. The timers too far in time for the top level are kept
+ * aside and inserted again at each turn of it.
+ */
+template<class Item> class CM_TimerWheel {
+ public:
+  enum { INVALID_TIMER = (unsigned int)-1 };
+
+ private:
+  enum {
+    LEVEL_BITS = 6,
+    LEVEL_SLOTS = (1 << LEVEL_BITS),
+    LEVEL_MASK = LEVEL_SLOTS - 1,
+    NUM_LEVELS = 4,
+    /// Slot of the timers past the top level.
+    OVERFLOW_SLOT = NUM_LEVELS * LEVEL_SLOTS
+  };
+
+  struct Timer {
+    Item m_item;
+    double m_expiry;
+    uint64_t m_tick;
+    /// Slot of the timer, INVALID_TIMER for a free timer.
+    unsigned int m_slot;
+    /// Index in the slot, for constant time removal.
+    unsigned int m_index;
+  };
+
+  std::vector<Timer> m_timers;
+  std::vector<unsigned int> m_freeTimers;
+  /// Indices of the timers per slot of each level, then the overflow slot.
+  std::vector<unsigned int> m_slots[OVERFLOW_SLOT + 1];
+  /// Duration of a tick of the finest level.
+  double m_resolution;
+  double m_time;
+  /// Tick of the current time, all the lower ticks are expired.
+  uint64_t m_tick;
+  unsigned int m_numTimers;
+
+  /// Mask of the ticks in a slot of a level.
+  static uint64_t GetLevelMask(unsigned int level)
+  {
+    return (uint64_t(1) << (level * LEVEL_BITS)) - 1;
+  }
+
+  uint64_t GetTick(double time) const
+  {
+    return (time > 0.0) ? (uint64_t)std::floor(time / m_resolution) : 0;
+  }
+
+  void Link(unsigned int index)
+  {
+    Timer &timer = m_timers[index];
+    unsigned int slot = OVERFLOW_SLOT;
+    // The finest level where the timer tick shares the window of the current tick.
+    for (unsigned int level = 0; level < NUM_LEVELS; ++level) {
+      const unsigned int shift = (level + 1) * LEVEL_BITS;
+      if ((timer.m_tick >> shift) == (m_tick >> shift)) {
+        slot = level * LEVEL_SLOTS + ((timer.m_tick >> (level * LEVEL_BITS)) & LEVEL_MASK);
+        break;
+      }
+    }
+
+    std::vector<unsigned int> &timers = m_slots[slot];
+    timer.m_slot = slot;
+    timer.m_index = timers.size();
+    timers.push_back(index);
+  }
+
+  void Unlink(unsigned int index)
+  {
+    Timer &timer = m_timers[index];
+    std::vector<unsigned int> &timers = m_slots[timer.m_slot];
+    const unsigned int last = timers.back();
+    timers[timer.m_index] = last;
+    m_timers[last].m_index = timer.m_index;
+    timers.pop_back();
+  }
+
+  void Free(unsigned int index)
+  {
+    m_timers[index].m_slot = INVALID_TIMER;
+    m_freeTimers.push_back(index);
+    --m_numTimers;
+  }
+
+  /// Insert again the timers of a slot, they fall to the finer levels.
+  void Cascade(unsigned int slot)
+  {
+    std::vector<unsigned int> timers;
+    timers.swap(m_slots[slot]);
+    for (unsigned int index : timers) {
+      Link(index);
+    }
+    // Keep the allocation of the slot.
+    timers.clear();
+    if (m_slots[slot].empty()) {
+      m_slots[slot].swap(timers);
+    }
+  }
+
+  void Expire(unsigned int index, std::vector<Item> &expired)
+  {
+    expired.push_back(m_timers[index].m_item);
+    Free(index);
+  }
+
+ public:
+  /// \param resolution The duration of a tick of the finest level.
+  CM_TimerWheel(double resolution)
+      : m_resolution(resolution), m_time(0.0), m_tick(0), m_numTimers(0)
+  {
+  }
+
+  double GetTime() const
+  {
+    return m_time;
+  }
+
+  unsigned int GetNumTimers() const
+  {
+    return m_numTimers;
+  }
+
+  /** Add a timer expiring after a delay.
+   * \return The identifier of the timer, valid until it expires or is removed.
+   */
+  unsigned int Add(const Item &item, double delay)
+  {
+    unsigned int index;
+    if (m_freeTimers.empty()) {
+      index = m_timers.size();
+      m_timers.emplace_back();
+    }
+    else {
+      index = m_freeTimers.back();
+      m_freeTimers.pop_back();
+    }
+
+    Timer &timer = m_timers[index];
+    timer.m_item = item;
+    timer.m_expiry = m_time + delay;
+    // An already expired timer is checked at the next advance in the current slot.
+    timer.m_tick = std::max(GetTick(timer.m_expiry), m_tick);
+    Link(index);
+    ++m_numTimers;
+
+    return index;
+  }
+
+  void Remove(unsigned int timer)
+  {
+    Unlink(timer);
+    Free(timer);
+  }
+
+  /// Return the time left before the expiry of a timer, negative when overdue.
+  double GetRemaining(unsigned int timer) const
+  {
+    return m_timers[timer].m_expiry - m_time;
+  }
+
+  /** Advance the time and remove the expired timers.
+   * \param expired Receive the items of the expired timers.
+   */
+  void Advance(double step, std::vector<Item> &expired)
+  {
+    m_time += step;
+    const uint64_t tick = GetTick(m_time);
+
+    while (m_tick < tick) {
+      // All the timers of the current tick expired before the new tick.
+      std::vector<unsigned int> &timers = m_slots[m_tick & LEVEL_MASK];
+      for (unsigned int index : timers) {
+        Expire(index, expired);
+      }
+      timers.clear();
+
+      ++m_tick;
+      if (m_numTimers == 0) {
+        m_tick = tick;
+        break;
+      }
+
+      // Cascade the slots of the levels entering a new slot, from the coarsest level.
+      unsigned int level = 0;
+      while (level < NUM_LEVELS && (m_tick & GetLevelMask(level + 1)) == 0) {
+        ++level;
+      }
+      if (level == NUM_LEVELS) {
+        Cascade(OVERFLOW_SLOT);
+        level = NUM_LEVELS - 1;
+      }
+      for (; level > 0; --level) {
+        Cascade(level * LEVEL_SLOTS + ((m_tick >> (level * LEVEL_BITS)) & LEVEL_MASK));
+      }
+    }
+
+    // The timers of the current tick expired before the current time.
+    std::vector<unsigned int> &timers = m_slots[m_tick & LEVEL_MASK];
+    for (unsigned int i = 0; i < timers.size();) {
+      const unsigned int index = timers[i];
+      if (m_timers[index].m_expiry <= m_time) {
+        Unlink(index);
+        Expire(index, expired);
+      }
+      else {
+        ++i;
+      }
+    }
+  }
+};
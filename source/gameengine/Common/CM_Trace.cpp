@@ -0,0 +1,181 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Common/CM_Trace.cpp
+ *  \ingroup common
+ */
+
+#include "CM_Trace.h"
+
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+struct TraceEvent {
+  const char *m_name;
+  std::string m_label;
+  std::chrono::nanoseconds::rep m_time;
+  int m_track;
+  char m_phase;
+};
+
+/// Events of a single thread, only this thread writes into it while recording.
+struct TraceBuffer {
+  std::vector<TraceEvent> m_events;
+  unsigned int m_id;
+};
+
+std::mutex buffersMutex;
+std::vector<std::unique_ptr<TraceBuffer>> buffers;
+std::chrono::steady_clock::time_point startTime;
+thread_local TraceBuffer *threadBuffer = nullptr;
+
+}  // namespace
+
+std::atomic<bool> CM_Trace::m_enabled(false);
+
+static TraceBuffer *get_thread_buffer()
+{
+  if (!threadBuffer) {
+    std::lock_guard<std::mutex> lock(buffersMutex);
+    buffers.emplace_back(new TraceBuffer());
+    threadBuffer = buffers.back().get();
+    // Track 0 is reserved for the time categories.
+    threadBuffer->m_id = buffers.size();
+  }
+  return threadBuffer;
+}
+
+static void add_event(const char *name, const std::string &label, int track, char phase)
+{
+  const std::chrono::nanoseconds::rep time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                                 std::chrono::steady_clock::now() - startTime)
+                                                 .count();
+  get_thread_buffer()->m_events.push_back({name, label, time, track, phase});
+}
+
+static void write_json_string(std::ofstream &file, const char *str)
+{
+  file << '"';
+  for (const char *c = str; *c; ++c) {
+    switch (*c) {
+      case '"':
+        file << "\\\"";
+        break;
+      case '\\':
+        file << "\\\\";
+        break;
+      case '\n':
+        file << "\\n";
+        break;
+      default:
+        // Other control characters are not expected in names.
+        if ((unsigned char)*c >= 0x20) {
+          file << *c;
+        }
+    }
+  }
+  file << '"';
+}
+
+static void write_thread_name(std::ofstream &file, int tid, const std::string &name)
+{
+  file << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << tid
+       << ",\"args\":{\"name\":";
+  write_json_string(file, name.c_str());
+  file << "}}";
+}
+
+void CM_Trace::Start()
+{
+  std::lock_guard<std::mutex> lock(buffersMutex);
+  for (std::unique_ptr<TraceBuffer> &buffer : buffers) {
+    buffer->m_events.clear();
+  }
+  startTime = std::chrono::steady_clock::now();
+  m_enabled = true;
+}
+
+bool CM_Trace::Stop(const std::string &filepath)
+{
+  m_enabled = false;
+
+  std::ofstream file(filepath);
+  if (!file.is_open()) {
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(buffersMutex);
+
+  // Every following object starts with a separator.
+  file << "[\n{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"BGE\"}}";
+  write_thread_name(file, TRACK_TIME_CATEGORIES, "Time Categories");
+
+  for (const std::unique_ptr<TraceBuffer> &buffer : buffers) {
+    write_thread_name(file, buffer->m_id, "Thread " + std::to_string(buffer->m_id));
+
+    for (const TraceEvent &event : buffer->m_events) {
+      const int tid = (event.m_track == TRACK_THREAD) ? buffer->m_id : event.m_track;
+      // Timestamps are in microseconds.
+      file << ",\n{\"ph\":\"" << event.m_phase << "\",\"pid\":1,\"tid\":" << tid
+           << ",\"ts\":" << (event.m_time / 1000) << "." << (event.m_time % 1000) / 100;
+      if (event.m_phase != 'E') {
+        file << ",\"name\":";
+        write_json_string(file, event.m_name);
+      }
+      if (event.m_phase == 'i') {
+        file << ",\"s\":\"t\"";
+      }
+      if (!event.m_label.empty()) {
+        file << ",\"args\":{\"label\":";
+        write_json_string(file, event.m_label.c_str());
+        file << "}";
+      }
+      file << "}";
+    }
+
+    buffer->m_events.clear();
+  }
+
+  file << "\n]\n";
+
+  return file.good();
+}
+
+void CM_Trace::Begin(const char *name, const std::string &label, int track)
+{
+  add_event(name, label, track, 'B');
+}
+
+void CM_Trace::End(int track)
+{
+  add_event(nullptr, "", track, 'E');
+}
+
+void CM_Trace::Instant(const char *name, int track)
+{
+  add_event(name, "", track, 'i');
+}
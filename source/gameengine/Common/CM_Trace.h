@@ -0,0 +1,101 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file CM_Trace.h
+ *  \ingroup common
+ */
+
+#pragma once
+
+#include <atomic>
+#include <string>
+
+/** Timestamped event recorder exported as a Chrome trace (JSON array format),
+ * which can be opened in chrome://tracing, Perfetto or converted for Tracy with
+ * its import-chrome tool.
+ * Events are recorded per thread in buffers without locking, recording while the
+ * recorder is disabled costs only the check of an atomic flag.
+ */
+class CM_Trace {
+ public:
+  /// Track identifier of the events not owned by a thread.
+  enum Track { TRACK_THREAD = -1, TRACK_TIME_CATEGORIES = 0 };
+
+ private:
+  static std::atomic<bool> m_enabled;
+
+ public:
+  static inline bool IsEnabled()
+  {
+    return m_enabled.load(std::memory_order_relaxed);
+  }
+
+  /** Clear the recorded events and start recording.
+   * Must be called when no other thread is recording events.
+   */
+  static void Start();
+  /** Stop recording and write the recorded events to a file.
+   * Must be called when no other thread is recording events.
+   * \return False if the file can't be written.
+   */
+  static bool Stop(const std::string &filepath);
+
+  /** Open a scope on the current thread or the given track.
+   * \param name The scope name, it must stay valid until the end of the recording.
+   * \param label Optional label exported in the arguments of the event, e.g a scene name.
+   */
+  static void Begin(const char *name, const std::string &label = "", int track = TRACK_THREAD);
+  /// Close the last scope on the current thread or the given track.
+  static void End(int track = TRACK_THREAD);
+  /// Record an instant event, e.g the start of a frame.
+  static void Instant(const char *name, int track = TRACK_THREAD);
+};
+
+/// Record a scope on the current thread for the lifetime of this object.
+class CM_TraceScope {
+ private:
+  bool m_active;
+
+ public:
+  inline CM_TraceScope(const char *name) : m_active(CM_Trace::IsEnabled())
+  {
+    if (m_active) {
+      CM_Trace::Begin(name);
+    }
+  }
+
+  inline CM_TraceScope(const char *name, const std::string &label)
+      : m_active(CM_Trace::IsEnabled())
+  {
+    if (m_active) {
+      CM_Trace::Begin(name, label);
+    }
+  }
+
+  inline ~CM_TraceScope()
+  {
+    // Keep the scopes balanced if the recording stopped in the meantime.
+    if (m_active) {
+      CM_Trace::End();
+    }
+  }
+};
@@ -35,28 +35,47 @@
 
 #include "BL_BlenderConverter.h"
 
+#include <algorithm>
+#include <fcntl.h>
+#include <limits>
+#include <unordered_set>
+
+#include "BKE_collection.h"
 #include "BKE_context.h"
 #include "BKE_idtype.h"
+#include "BKE_layer.h"
 #include "BKE_lib_id.h"
 #include "BKE_main.h"
 #include "BKE_report.h"
+#include "BKE_scene.h"
 #include "BLI_blenlib.h"
+#include "BLI_filereader.h"
 #include "BLI_linklist.h"
 #include "BLI_task.h"
 #include "BLO_readfile.h"
+#include "DNA_collection_types.h"
+#include "DNA_layer_types.h"
 #include "DNA_material_types.h"
 #include "DNA_mesh_types.h"
 #include "DNA_scene_types.h"
+#include "GPU_texture.h"
 
 #include "BL_BlenderDataConversion.h"
 #include "BL_BlenderSceneConverter.h"
+#include "CM_StartupProfiler.h"
 #include "DummyPhysicsEnvironment.h"
 #include "EXP_StringValue.h"
+#include "KX_BlenderMaterial.h"
 #include "KX_GameObject.h"
 #include "KX_LibLoadStatus.h"
+#include "KX_MemoryReport.h"
 #include "KX_PythonInit.h"  // So we can handle adding new text datablocks for Python to import
 #include "LA_SystemCommandLine.h"
+#include "PIL_time.h"
 #include "RAS_BucketManager.h"
+#include "RAS_IDisplayArray.h"
+#include "RAS_MeshObject.h"
+#include "RAS_Polygon.h"
 #include "SCA_ActionActuator.h"
 
 #ifdef WITH_BULLET
@@ -67,6 +86,9 @@
 #  include "Texture.h"  // For FreeAllTextures.
 #endif                  // WITH_PYTHON
 
+/// Time in seconds spent at most per frame to convert objects asynchronously.
+static const double ASYNC_CONVERSION_TIME_BUDGET = 0.004;
+
 BL_BlenderConverter::SceneSlot::SceneSlot() = default;
 
 BL_BlenderConverter::SceneSlot::SceneSlot(const BL_BlenderSceneConverter *converter)
@@ -101,7 +123,10 @@ void BL_BlenderConverter::SceneSlot::Merge(const BL_BlenderSceneConverter *conve
 }
 
 BL_BlenderConverter::BL_BlenderConverter(Main *maggie, KX_KetsjiEngine *engine)
-    : m_maggie(maggie), m_ketsjiEngine(engine), m_alwaysUseExpandFraming(false)
+    : m_maggie(maggie),
+      m_ketsjiEngine(engine),
+      m_alwaysUseExpandFraming(false),
+      m_lazyMeshConversion(false)
 {
   BKE_main_id_tag_all(maggie, LIB_TAG_DOIT, false);  // avoid re-tagging later on
   m_threadinfo.m_pool = BLI_task_pool_create(nullptr, TASK_PRIORITY_LOW);
@@ -116,6 +141,13 @@ BL_BlenderConverter::~BL_BlenderConverter()
 
   m_DynamicMaggie.clear();
 
+  for (KX_LibLoadStatus *status : m_convertqueue) {
+    delete (std::vector<Object *> *)status->GetData();
+  }
+  for (KX_LibLoadStatus *status : m_convertstatuslist) {
+    delete status;
+  }
+
   /* Thread infos like mutex must be freed after FreeBlendFile function.
      Because it needs to lock the mutex, even if there's no active task when it's
      in the scene converter destructor. */
@@ -169,6 +201,7 @@ void BL_BlenderConverter::ConvertScene(KX_Scene *destinationscene,
 
   // Find out which physics engine
   Scene *blenderscene = destinationscene->GetBlenderScene();
+  CM_StartupScope convertScope("Scene Conversion", blenderscene->id.name + 2);
 
   PHY_IPhysicsEnvironment *phy_env = nullptr;
 
@@ -242,6 +275,11 @@ void BL_BlenderConverter::RemoveScene(KX_Scene *scene)
   SceneSlot &sceneSlot = m_sceneSlots[scene];
   sceneSlot.m_meshobjects.clear();
 
+  // Abort the pending objects conversions into this scene.
+  DiscardAsyncConversions([scene](KX_LibLoadStatus *status, Object *UNUSED(blenderobj)) {
+    return status->GetMergeScene() == scene;
+  });
+
   // Delete the scene.
   scene->Release();
 
@@ -253,6 +291,26 @@ void BL_BlenderConverter::SetAlwaysUseExpandFraming(bool to_what)
   m_alwaysUseExpandFraming = to_what;
 }
 
+void BL_BlenderConverter::SetMeshCacheDirectory(const std::string &directory)
+{
+  m_meshCacheDirectory = directory;
+}
+
+const std::string &BL_BlenderConverter::GetMeshCacheDirectory() const
+{
+  return m_meshCacheDirectory;
+}
+
+void BL_BlenderConverter::SetLazyMeshConversion(bool lazy)
+{
+  m_lazyMeshConversion = lazy;
+}
+
+bool BL_BlenderConverter::GetLazyMeshConversion() const
+{
+  return m_lazyMeshConversion;
+}
+
 void BL_BlenderConverter::RegisterInterpolatorList(KX_Scene *scene,
                                                    BL_InterpolatorList *interpolator,
                                                    bAction *for_act)
@@ -292,40 +350,95 @@ Main *BL_BlenderConverter::GetMainDynamicPath(const std::string &path) const
   return nullptr;
 }
 
-void BL_BlenderConverter::MergeAsyncLoads()
+/// Data of an asynchronous load of scenes, owned by the status until the merge is finished.
+struct BL_AsyncLibLoad {
+  std::string m_path;
+  /// The opened library, given by the caller or read by the task, closed once linked.
+  BlendHandle *m_openlib;
+  /// Copy of the library data for a load from memory, or the decompressed library file.
+  std::vector<char> m_buffer;
+  short m_options;
+  BL_BlenderConverter::LibLoadFilter m_filter;
+  bool m_useFilter;
+
+  /// The main linked by the main thread, nullptr if the library couldn't be read.
+  Main *m_main;
+  /// The converted scenes, merged and replaced by nullptr in MergeAsyncLoads.
+  std::vector<KX_Scene *> m_scenes;
+  /// True when the main was registered in the converter.
+  bool m_registered;
+};
+
+void BL_BlenderConverter::MergeAsyncLoads(bool useBudget)
 {
-  std::vector<KX_Scene *> *merge_scenes;
-
-  std::vector<KX_LibLoadStatus *>::iterator mit;
-  std::vector<KX_Scene *>::iterator sit;
+  // The libraries read since the last call are linked here, their conversion is then queued.
+  LinkAsyncLoads();
 
   m_threadinfo.m_mutex.Lock();
 
-  for (mit = m_mergequeue.begin(); mit != m_mergequeue.end(); ++mit) {
-    merge_scenes = (std::vector<KX_Scene *> *)(*mit)->GetData();
+  while (!m_mergequeue.empty()) {
+    KX_LibLoadStatus *status = m_mergequeue.front();
+    BL_AsyncLibLoad *load = (BL_AsyncLibLoad *)status->GetData();
+    if (!load->m_registered) {
+      RegisterAsyncLoad(status);
+    }
+    std::vector<KX_Scene *> *merge_scenes = &load->m_scenes;
+
+    const float budget = status->GetMergeBudget();
+    const double endtime = (useBudget && budget > 0.0f) ?
+                               PIL_check_seconds_timer() + budget * 0.001 :
+                               std::numeric_limits<double>::max();
+
+    // Merged scenes are deleted and replaced by nullptr to keep track of the progress.
+    bool finished = true;
+    for (unsigned int i = 0, size = merge_scenes->size(); i < size; ++i) {
+      KX_Scene *scene = (*merge_scenes)[i];
+      if (!scene) {
+        continue;
+      }
+
+      status->GetMergeScene()->MergeScenePart(scene, endtime, finished);
+      if (!finished) {
+        // Conversion is 90% and merging 10% of the progress.
+        status->SetProgress(0.9f + 0.1f * ((float)i + scene->GetMergeProgress()) / (float)size);
+        status->RunProgressCallback();
+        break;
+      }
+
+      delete scene;
+      (*merge_scenes)[i] = nullptr;
+    }
 
-    for (sit = merge_scenes->begin(); sit != merge_scenes->end(); ++sit) {
-      (*mit)->GetMergeScene()->MergeScene(*sit);
-      delete (*sit);
+    // Continue the merge at the next frame.
+    if (!finished) {
+      break;
     }
 
-    delete merge_scenes;
-    (*mit)->SetData(nullptr);
+    delete load;
+    status->SetData(nullptr);
+    m_mergequeue.erase(m_mergequeue.begin());
 
-    (*mit)->Finish();
+    status->Finish();
   }
 
-  m_mergequeue.clear();
-
   m_threadinfo.m_mutex.Unlock();
 }
 
 void BL_BlenderConverter::FinalizeAsyncLoads()
 {
-  // Finish all loading libraries.
+  // Finish all loading libraries, the reads then the conversions of the linked libraries.
+  BLI_task_pool_work_and_wait(m_threadinfo.m_pool);
+  LinkAsyncLoads();
   BLI_task_pool_work_and_wait(m_threadinfo.m_pool);
   // Merge all libraries data in the current scene, to avoid memory leak of unmerged scenes.
-  MergeAsyncLoads();
+  MergeAsyncLoads(false);
+}
+
+void BL_BlenderConverter::AddLibraryToLinkQueue(KX_LibLoadStatus *status)
+{
+  m_threadinfo.m_mutex.Lock();
+  m_linkqueue.push_back(status);
+  m_threadinfo.m_mutex.Unlock();
 }
 
 void BL_BlenderConverter::AddScenesToMergeQueue(KX_LibLoadStatus *status)
@@ -335,138 +448,587 @@ void BL_BlenderConverter::AddScenesToMergeQueue(KX_LibLoadStatus *status)
   m_threadinfo.m_mutex.Unlock();
 }
 
-static void async_convert(TaskPool *pool, void *ptr, int UNUSED(threadid))
+KX_LibLoadStatus *BL_BlenderConverter::ConvertBlenderObjectsAsync(
+    KX_Scene *scene, const std::vector<Object *> &objects, const std::string &name)
+{
+  KX_LibLoadStatus *status = new KX_LibLoadStatus(this, m_ketsjiEngine, scene, name);
+  m_convertstatuslist.push_back(status);
+
+  if (objects.empty()) {
+    status->Finish();
+    return status;
+  }
+
+  // Objects are converted from the back of the list, deleted in ProcessAsyncConversions.
+  status->SetData(new std::vector<Object *>(objects.rbegin(), objects.rend()));
+  m_convertqueue.push_back(status);
+
+  return status;
+}
+
+void BL_BlenderConverter::ProcessAsyncConversions()
+{
+  const double starttime = PIL_check_seconds_timer();
+
+  while (!m_convertqueue.empty()) {
+    KX_LibLoadStatus *status = m_convertqueue.front();
+    std::vector<Object *> *objects = (std::vector<Object *> *)status->GetData();
+
+    // At least one object is converted per frame.
+    bool outoftime = false;
+    while (!objects->empty() && !outoftime) {
+      Object *blenderobj = objects->back();
+      objects->pop_back();
+
+      status->GetMergeScene()->ConvertBlenderObject(blenderobj);
+      status->AddProgress((1.0f - status->GetProgress()) / (objects->size() + 1));
+
+      outoftime = (PIL_check_seconds_timer() - starttime) > ASYNC_CONVERSION_TIME_BUDGET;
+    }
+
+    if (!objects->empty()) {
+      // Report the progress of this frame and continue at the next frame.
+      status->RunProgressCallback();
+      break;
+    }
+
+    delete objects;
+    status->SetData(nullptr);
+    m_convertqueue.erase(m_convertqueue.begin());
+
+    status->Finish();
+
+    if (outoftime) {
+      break;
+    }
+  }
+
+  PruneConvertStatuses();
+}
+
+void BL_BlenderConverter::DiscardAsyncConversions(
+    const std::function<bool(KX_LibLoadStatus *status, Object *blenderobj)> &discard)
+{
+  std::vector<KX_LibLoadStatus *> aborted;
+  for (std::vector<KX_LibLoadStatus *>::iterator it = m_convertqueue.begin();
+       it != m_convertqueue.end();) {
+    KX_LibLoadStatus *status = *it;
+    std::vector<Object *> *objects = (std::vector<Object *> *)status->GetData();
+    objects->erase(std::remove_if(objects->begin(),
+                                  objects->end(),
+                                  [status, &discard](Object *blenderobj) {
+                                    return discard(status, blenderobj);
+                                  }),
+                   objects->end());
+
+    if (objects->empty()) {
+      delete objects;
+      status->SetData(nullptr);
+      aborted.push_back(status);
+      it = m_convertqueue.erase(it);
+    }
+    else {
+      ++it;
+    }
+  }
+
+  // Finished once out of the queue as the callbacks can queue new conversions.
+  for (KX_LibLoadStatus *status : aborted) {
+    status->Finish();
+  }
+}
+
+void BL_BlenderConverter::PruneConvertStatuses()
+{
+  for (std::vector<KX_LibLoadStatus *>::iterator it = m_convertstatuslist.begin();
+       it != m_convertstatuslist.end();) {
+    KX_LibLoadStatus *status = *it;
+    bool referenced = false;
+#ifdef WITH_PYTHON
+    // The status owns one reference of its proxy, the others are owned by scripts.
+    referenced = status->m_proxy && Py_REFCNT(status->m_proxy) > 1;
+#endif
+    if (status->IsFinished() && !status->IsOwned() && !referenced) {
+      delete status;
+      it = m_convertstatuslist.erase(it);
+    }
+    else {
+      ++it;
+    }
+  }
+}
+
+static void load_datablocks(Main *main_tmp,
+                            BlendHandle *bpy_openlib,
+                            const char *path,
+                            int idcode,
+                            const LibraryLink_Params *liblink_params)
+{
+  LinkNode *names = nullptr;
+
+  int totnames_dummy;
+  names = BLO_blendhandle_get_datablock_names(bpy_openlib, idcode, false, &totnames_dummy);
+
+  int i = 0;
+  LinkNode *n = names;
+  while (n) {
+    BLO_library_link_named_part(main_tmp, &bpy_openlib, idcode, (char *)n->link, liblink_params);
+    n = (LinkNode *)n->next;
+    i++;
+  }
+  BLI_linklist_free(names, free);  // free linklist *and* each node's data
+}
+
+/** Link only the named datablocks of a type, their dependencies are linked with them.
+ * \param r_ids The linked datablocks.
+ */
+static void load_named_datablocks(Main *main_tmp,
+                                  BlendHandle *bpy_openlib,
+                                  const char *path,
+                                  int idcode,
+                                  const std::vector<std::string> &names,
+                                  const LibraryLink_Params *liblink_params,
+                                  std::vector<ID *> &r_ids)
+{
+  for (const std::string &name : names) {
+    ID *id = BLO_library_link_named_part(
+        main_tmp, &bpy_openlib, idcode, name.c_str(), liblink_params);
+    if (!id) {
+      CM_Warning("datablock \"" << name << "\" not found in library \"" << path << "\"");
+      continue;
+    }
+    r_ids.push_back(id);
+  }
+}
+
+/** Create a scene in the library instancing the linked objects and collections,
+ * the scene is merged like a linked scene and freed with the library.
+ */
+static void instance_datablocks(Main *maggie, const char *path, const std::vector<ID *> &ids)
+{
+  Scene *scene = BKE_scene_add(maggie, BLI_path_basename(path));
+  for (ID *id : ids) {
+    if (GS(id->name) == ID_GR) {
+      BKE_collection_child_add(maggie, scene->master_collection, (Collection *)id);
+    }
+    else {
+      BKE_collection_object_add(maggie, scene->master_collection, (Object *)id);
+    }
+  }
+
+  // The conversion reads the visibility of the objects from their base flag.
+  LISTBASE_FOREACH (Base *, base, &BKE_view_layer_default_view(scene)->object_bases) {
+    BKE_scene_object_base_flag_sync_from_base(base);
+  }
+}
+
+/** Link the datablocks of a library in a new main, the main is registered in the converter by
+ * the caller. Must be called from the main thread, the end of the linking swaps the global main
+ * to update the library overrides.
+ * \param bpy_openlib The opened library, closed after linking.
+ */
+static Main *link_blend_file(BlendHandle *bpy_openlib,
+                             const char *path,
+                             int idcode,
+                             short options,
+                             const BL_BlenderConverter::LibLoadFilter *filter)
+{
+  const bool filterScene = filter && (!filter->m_objects.empty() ||
+                                      !filter->m_collections.empty());
+  const bool filterMesh = filter && !filter->m_meshes.empty();
+
+  Main *main_newlib = BKE_main_new();
+  ReportList reports;
+  BKE_reports_init(&reports, RPT_STORE);
+
+  short flag = 0;  // don't need any special options
+  // created only for linking, then freed
+  struct LibraryLink_Params liblink_params;
+  BLO_library_link_params_init(&liblink_params, main_newlib, flag, 0);
+  Main *main_tmp = BLO_library_link_begin(&bpy_openlib, (char *)path, &liblink_params);
+
+  std::vector<ID *> instancedIds;
+  if (filterScene) {
+    load_named_datablocks(
+        main_tmp, bpy_openlib, path, ID_OB, filter->m_objects, &liblink_params, instancedIds);
+    load_named_datablocks(
+        main_tmp, bpy_openlib, path, ID_GR, filter->m_collections, &liblink_params, instancedIds);
+  }
+  else if (filterMesh) {
+    std::vector<ID *> meshes;
+    load_named_datablocks(
+        main_tmp, bpy_openlib, path, ID_ME, filter->m_meshes, &liblink_params, meshes);
+  }
+  else {
+    load_datablocks(main_tmp, bpy_openlib, path, idcode, &liblink_params);
+  }
+
+  // The scripts and actions used by the linked datablocks are always linked with them.
+  if (!(options & BL_BlenderConverter::LIB_LOAD_DEPENDENCIES_ONLY)) {
+    if (idcode == ID_SCE && options & BL_BlenderConverter::LIB_LOAD_LOAD_SCRIPTS) {
+      load_datablocks(main_tmp, bpy_openlib, path, ID_TXT, &liblink_params);
+    }
+
+    // now do another round of linking for Scenes so all actions are properly loaded
+    if (idcode == ID_SCE && options & BL_BlenderConverter::LIB_LOAD_LOAD_ACTIONS) {
+      load_datablocks(main_tmp, bpy_openlib, path, ID_AC, &liblink_params);
+    }
+  }
+
+  BLO_library_link_end(main_tmp, &bpy_openlib, &liblink_params);
+
+  BLO_blendhandle_close(bpy_openlib);
+
+  BKE_reports_clear(&reports);
+  // done linking
+
+  if (filterScene) {
+    instance_datablocks(main_newlib, path, instancedIds);
+  }
+
+  // needed for lookups
+  BLI_strncpy(main_newlib->name, path, sizeof(main_newlib->name));
+
+  return main_newlib;
+}
+
+/** Decompress a library file, or the copied data of a load from memory, into a buffer.
+ * The buffer of an uncompressed file is left empty, the file is mapped by
+ * BLO_blendhandle_from_file and its blocks are read on demand by the linking.
+ */
+static bool read_library_data(const std::string &path, std::vector<char> &buffer)
+{
+  FileReader *reader;
+  if (buffer.empty()) {
+    const int file = BLI_open(path.c_str(), O_BINARY | O_RDONLY, 0);
+    if (file == -1) {
+      return false;
+    }
+    reader = BLI_filereader_new_file(file);
+  }
+  else {
+    reader = BLI_filereader_new_memory(buffer.data(), buffer.size());
+  }
+
+  char header[4];
+  const bool compressed = (reader->read(reader, header, sizeof(header)) == sizeof(header) &&
+                           (BLI_file_magic_is_zstd(header) || BLI_file_magic_is_gzip(header)));
+  reader->seek(reader, 0, SEEK_SET);
+
+  if (compressed) {
+    FileReader *base = reader;
+    reader = BLI_file_magic_is_zstd(header) ? BLI_filereader_new_zstd(base) :
+                                              BLI_filereader_new_gzip(base);
+    if (!reader) {
+      base->close(base);
+      return false;
+    }
+  }
+  else {
+    // The copied data or the file are already uncompressed.
+    reader->close(reader);
+    return true;
+  }
+
+  static const size_t chunkSize = 1 << 20;
+  std::vector<char> data;
+  ssize_t readSize;
+  do {
+    const size_t size = data.size();
+    data.resize(size + chunkSize);
+    readSize = reader->read(reader, data.data() + size, chunkSize);
+    data.resize(size + std::max<ssize_t>(readSize, 0));
+  } while (readSize > 0);
+  reader->close(reader);
+
+  if (readSize < 0) {
+    return false;
+  }
+
+  buffer.swap(data);
+  return true;
+}
+
+/// Read the file of a library off the main thread, the library is then linked by the main thread.
+static void async_read_library(TaskPool *pool, void *ptr, int UNUSED(threadid))
 {
-  KX_Scene *new_scene = nullptr;
   KX_LibLoadStatus *status = (KX_LibLoadStatus *)ptr;
-  std::vector<Scene *> *scenes = (std::vector<Scene *> *)status->GetData();
-  std::vector<KX_Scene *> *merge_scenes =
-      new std::vector<KX_Scene *>();  // Deleted in MergeAsyncLoads
+  BL_AsyncLibLoad *load = (BL_AsyncLibLoad *)status->GetData();
+
+  // The decompression happens here, only the parsing is left to the linking.
+  if (!load->m_openlib && read_library_data(load->m_path, load->m_buffer)) {
+    load->m_openlib = load->m_buffer.empty() ?
+                          BLO_blendhandle_from_file(load->m_path.c_str(), nullptr) :
+                          BLO_blendhandle_from_memory(
+                              load->m_buffer.data(), load->m_buffer.size(), nullptr);
+  }
+
+  if (!load->m_openlib) {
+    CM_Error("could not open blendfile \"" << load->m_path << "\"");
+  }
 
-  for (unsigned int i = 0; i < scenes->size(); ++i) {
-    new_scene = status->GetEngine()->CreateScene((*scenes)[i], true);
+  status->GetConverter()->AddLibraryToLinkQueue(status);
+}
 
+/// Convert the scenes of a linked library off the main thread.
+static void async_convert_scenes(TaskPool *pool, void *ptr, int UNUSED(threadid))
+{
+  KX_LibLoadStatus *status = (KX_LibLoadStatus *)ptr;
+  BL_AsyncLibLoad *load = (BL_AsyncLibLoad *)status->GetData();
+
+  const int numScenes = BLI_listbase_count(&load->m_main->scenes);
+  LISTBASE_FOREACH (Scene *, scene, &load->m_main->scenes) {
+    if (load->m_options & BL_BlenderConverter::LIB_LOAD_VERBOSE) {
+      CM_Debug("scene name: " << scene->id.name + 2);
+    }
+
+    KX_Scene *new_scene = status->GetEngine()->CreateScene(scene, true);
     if (new_scene) {
-      merge_scenes->push_back(new_scene);
+      load->m_scenes.push_back(new_scene);
     }
 
-    status->AddProgress((1.0f / scenes->size()) *
-                        0.9f);  // We'll call conversion 90% and merging 10% for now
+    status->AddProgress(0.6f / numScenes);
   }
 
-  delete scenes;
-  status->SetData(merge_scenes);
-
   status->GetConverter()->AddScenesToMergeQueue(status);
 }
 
+void BL_BlenderConverter::LinkAsyncLoads()
+{
+  std::vector<KX_LibLoadStatus *> linkqueue;
+  m_threadinfo.m_mutex.Lock();
+  linkqueue.swap(m_linkqueue);
+  m_threadinfo.m_mutex.Unlock();
+
+  for (KX_LibLoadStatus *status : linkqueue) {
+    BL_AsyncLibLoad *load = (BL_AsyncLibLoad *)status->GetData();
+    if (!load->m_openlib) {
+      // Nothing to convert, the merge reports the failure.
+      AddScenesToMergeQueue(status);
+      continue;
+    }
+
+    load->m_main = link_blend_file(load->m_openlib,
+                                   load->m_path.c_str(),
+                                   ID_SCE,
+                                   load->m_options,
+                                   load->m_useFilter ? &load->m_filter : nullptr);
+    load->m_openlib = nullptr;
+    // The linked data doesn't reference the file data.
+    std::vector<char>().swap(load->m_buffer);
+
+    // Reading and linking is 30%, conversion 60% and merging 10% of the progress.
+    status->SetProgress(0.3f);
+
+    BLI_task_pool_push(
+        m_threadinfo.m_pool, (TaskRunFunction)async_convert_scenes, (void *)status, false, NULL);
+  }
+}
+
 KX_LibLoadStatus *BL_BlenderConverter::LinkBlendFileMemory(void *data,
                                                            int length,
                                                            const char *path,
                                                            char *group,
                                                            KX_Scene *scene_merge,
                                                            char **err_str,
-                                                           short options)
+                                                           short options,
+                                                           const LibLoadFilter *filter)
 {
+  if (IsAsyncSceneLoad(group, options)) {
+    // The data is copied, the library is opened in the loading task.
+    return LinkBlendFileAsync(
+        nullptr, (const char *)data, length, path, group, scene_merge, err_str, options, filter);
+  }
+
   BlendHandle *bpy_openlib = BLO_blendhandle_from_memory(data, length, nullptr);
 
   // Error checking is done in LinkBlendFile
-  return LinkBlendFile(bpy_openlib, path, group, scene_merge, err_str, options);
+  return LinkBlendFile(bpy_openlib, path, group, scene_merge, err_str, options, filter);
 }
 
-KX_LibLoadStatus *BL_BlenderConverter::LinkBlendFilePath(
-    const char *filepath, char *group, KX_Scene *scene_merge, char **err_str, short options)
+KX_LibLoadStatus *BL_BlenderConverter::LinkBlendFilePath(const char *filepath,
+                                                         char *group,
+                                                         KX_Scene *scene_merge,
+                                                         char **err_str,
+                                                         short options,
+                                                         const LibLoadFilter *filter)
 {
+  if (IsAsyncSceneLoad(group, options)) {
+    // The library is opened in the loading task.
+    return LinkBlendFileAsync(
+        nullptr, nullptr, 0, filepath, group, scene_merge, err_str, options, filter);
+  }
+
   BlendHandle *bpy_openlib = BLO_blendhandle_from_file(filepath, nullptr);
 
   // Error checking is done in LinkBlendFile
-  return LinkBlendFile(bpy_openlib, filepath, group, scene_merge, err_str, options);
+  return LinkBlendFile(bpy_openlib, filepath, group, scene_merge, err_str, options, filter);
 }
 
-static void load_datablocks(Main *main_tmp, BlendHandle *bpy_openlib, const char *path, int idcode)
+bool BL_BlenderConverter::IsAsyncSceneLoad(const char *group, short options) const
 {
-  LinkNode *names = nullptr;
-
-  int totnames_dummy;
-  names = BLO_blendhandle_get_datablock_names(bpy_openlib, idcode, false, &totnames_dummy);
-
-  int i = 0;
-  LinkNode *n = names;
-  while (n) {
-    struct LibraryLink_Params liblink_params;
-    BLO_library_link_named_part(main_tmp, &bpy_openlib, idcode, (char *)n->link, &liblink_params);
-    n = (LinkNode *)n->next;
-    i++;
-  }
-  BLI_linklist_free(names, free);  // free linklist *and* each node's data
+  return (options & LIB_LOAD_ASYNC) && BKE_idtype_idcode_from_name(group) == ID_SCE;
 }
 
-KX_LibLoadStatus *BL_BlenderConverter::LinkBlendFile(BlendHandle *bpy_openlib,
-                                                     const char *path,
-                                                     char *group,
-                                                     KX_Scene *scene_merge,
-                                                     char **err_str,
-                                                     short options)
+bool BL_BlenderConverter::CheckLinkBlendFile(const char *path,
+                                             const char *group,
+                                             const LibLoadFilter *filter,
+                                             char **err_str) const
 {
-  Main *main_newlib;  // stored as a dynamic 'main' until we free it
   const int idcode = BKE_idtype_idcode_from_name(group);
-  ReportList reports;
   static char err_local[255];
 
-  KX_LibLoadStatus *status;
-
   // only scene and mesh supported right now
   if (idcode != ID_SCE && idcode != ID_ME && idcode != ID_AC) {
     snprintf(err_local, sizeof(err_local), "invalid ID type given \"%s\"\n", group);
     *err_str = err_local;
-    BLO_blendhandle_close(bpy_openlib);
-    return nullptr;
+    return false;
+  }
+
+  const bool filterScene = filter && (!filter->m_objects.empty() ||
+                                      !filter->m_collections.empty());
+  const bool filterMesh = filter && !filter->m_meshes.empty();
+  if ((filterScene && idcode != ID_SCE) || (filterMesh && idcode != ID_ME)) {
+    snprintf(err_local,
+             sizeof(err_local),
+             "datablock names not supported for the ID type \"%s\"\n",
+             group);
+    *err_str = err_local;
+    return false;
   }
 
-  if (GetMainDynamicPath(path)) {
+  // The main of an asynchronous load is registered once linked.
+  if (GetMainDynamicPath(path) || m_status_map.count(path)) {
     snprintf(err_local, sizeof(err_local), "blend file already open \"%s\"\n", path);
     *err_str = err_local;
-    BLO_blendhandle_close(bpy_openlib);
+    return false;
+  }
+
+  return true;
+}
+
+KX_LibLoadStatus *BL_BlenderConverter::LinkBlendFileAsync(BlendHandle *bpy_openlib,
+                                                          const char *data,
+                                                          int length,
+                                                          const char *path,
+                                                          char *group,
+                                                          KX_Scene *scene_merge,
+                                                          char **err_str,
+                                                          short options,
+                                                          const LibLoadFilter *filter)
+{
+  static char err_local[255];
+
+  if (!CheckLinkBlendFile(path, group, filter, err_str)) {
+    if (bpy_openlib) {
+      BLO_blendhandle_close(bpy_openlib);
+    }
     return nullptr;
   }
 
-  if (bpy_openlib == nullptr) {
+  // Keep reporting the missing files immediately, the file is read in the task.
+  if (!bpy_openlib && !data && !BLI_is_file(path)) {
     snprintf(err_local, sizeof(err_local), "could not open blendfile \"%s\"\n", path);
     *err_str = err_local;
     return nullptr;
   }
 
-  main_newlib = BKE_main_new();
-  BKE_reports_init(&reports, RPT_STORE);
+  BL_AsyncLibLoad *load = new BL_AsyncLibLoad();
+  load->m_path = path;
+  load->m_openlib = bpy_openlib;
+  if (data) {
+    load->m_buffer.assign(data, data + length);
+  }
+  load->m_options = options;
+  load->m_useFilter = (filter != nullptr);
+  if (filter) {
+    load->m_filter = *filter;
+  }
+  load->m_main = nullptr;
+  load->m_registered = false;
 
-  // short flag = 0;  // don't need any special options
-  // created only for linking, then freed
-  struct LibraryLink_Params liblink_params;
-  Main *main_tmp = BLO_library_link_begin(&bpy_openlib, (char *)path, &liblink_params);
+  KX_LibLoadStatus *status = new KX_LibLoadStatus(this, m_ketsjiEngine, scene_merge, path);
+  status->SetData(load);
+  m_status_map[path] = status;
+
+  BLI_task_pool_push(
+      m_threadinfo.m_pool, (TaskRunFunction)async_read_library, (void *)status, false, NULL);
 
-  load_datablocks(main_tmp, bpy_openlib, path, idcode);
+  return status;
+}
 
-  if (idcode == ID_SCE && options & LIB_LOAD_LOAD_SCRIPTS) {
-    load_datablocks(main_tmp, bpy_openlib, path, ID_TXT);
+void BL_BlenderConverter::RegisterAsyncLoad(KX_LibLoadStatus *status)
+{
+  BL_AsyncLibLoad *load = (BL_AsyncLibLoad *)status->GetData();
+  load->m_registered = true;
+
+  Main *main_newlib = load->m_main;
+  if (!main_newlib) {
+    // Nothing can be freed, allow to load the library again.
+    m_status_map.erase(load->m_path);
+    m_convertstatuslist.push_back(status);
+    return;
   }
 
-  // now do another round of linking for Scenes so all actions are properly loaded
-  if (idcode == ID_SCE && options & LIB_LOAD_LOAD_ACTIONS) {
-    load_datablocks(main_tmp, bpy_openlib, path, ID_AC);
+  m_DynamicMaggie.push_back(main_newlib);
+  if (load->m_path != main_newlib->name) {
+    // The path was truncated by the main name, FreeBlendFile looks up with the main name.
+    m_status_map.erase(load->m_path);
+    m_status_map[main_newlib->name] = status;
   }
 
-  BLO_library_link_end(main_tmp, &bpy_openlib, &liblink_params);
+#ifdef WITH_PYTHON
+  // Handle any text datablocks
+  if (load->m_options & LIB_LOAD_LOAD_SCRIPTS) {
+    addImportMain(main_newlib);
+  }
+#endif
 
-  BLO_blendhandle_close(bpy_openlib);
+  // Now handle all the actions
+  if (load->m_options & LIB_LOAD_LOAD_ACTIONS) {
+    KX_Scene *scene_merge = status->GetMergeScene();
+    LISTBASE_FOREACH (ID *, action, &main_newlib->actions) {
+      if (load->m_options & LIB_LOAD_VERBOSE) {
+        CM_Debug("action name: " << action->name + 2);
+      }
+      scene_merge->GetLogicManager()->RegisterActionName(action->name + 2, action);
+    }
+  }
+}
 
-  BKE_reports_clear(&reports);
-  // done linking
+KX_LibLoadStatus *BL_BlenderConverter::LinkBlendFile(BlendHandle *bpy_openlib,
+                                                     const char *path,
+                                                     char *group,
+                                                     KX_Scene *scene_merge,
+                                                     char **err_str,
+                                                     short options,
+                                                     const LibLoadFilter *filter)
+{
+  const int idcode = BKE_idtype_idcode_from_name(group);
+  static char err_local[255];
 
-  // needed for lookups
+  if (IsAsyncSceneLoad(group, options)) {
+    // The library is linked by the main thread, its scenes converted in the loading task.
+    return LinkBlendFileAsync(
+        bpy_openlib, nullptr, 0, path, group, scene_merge, err_str, options, filter);
+  }
+
+  if (!CheckLinkBlendFile(path, group, filter, err_str)) {
+    BLO_blendhandle_close(bpy_openlib);
+    return nullptr;
+  }
+
+  if (bpy_openlib == nullptr) {
+    snprintf(err_local, sizeof(err_local), "could not open blendfile \"%s\"\n", path);
+    *err_str = err_local;
+    return nullptr;
+  }
+
+  // stored as a dynamic 'main' until we free it
+  Main *main_newlib = link_blend_file(bpy_openlib, path, idcode, options, filter);
   m_DynamicMaggie.push_back(main_newlib);
-  BLI_strncpy(main_newlib->name, path, sizeof(main_newlib->name));
 
-  status = new KX_LibLoadStatus(this, m_ketsjiEngine, scene_merge, path);
+  KX_LibLoadStatus *status = new KX_LibLoadStatus(this, m_ketsjiEngine, scene_merge, path);
 
   if (idcode == ID_ME) {
     // Convert all new meshes into BGE meshes
@@ -505,33 +1067,19 @@ KX_LibLoadStatus *BL_BlenderConverter::LinkBlendFile(BlendHandle *bpy_openlib,
   else if (idcode == ID_SCE) {
     // Merge all new linked in scene into the existing one
     ID *scene;
-    // scenes gets deleted by the thread when it's done using it (look in async_convert())
-    std::vector<Scene *> *scenes = (options & LIB_LOAD_ASYNC) ? new std::vector<Scene *>() :
-                                                                nullptr;
 
     for (scene = (ID *)main_newlib->scenes.first; scene; scene = (ID *)scene->next) {
       if (options & LIB_LOAD_VERBOSE) {
         CM_Debug("scene name: " << scene->name + 2);
       }
 
-      if (options & LIB_LOAD_ASYNC) {
-        scenes->push_back((Scene *)scene);
-      }
-      else {
-        // merge into the base  scene
-        KX_Scene *other = m_ketsjiEngine->CreateScene((Scene *)scene, true);
-        scene_merge->MergeScene(other);
-
-        // RemoveScene(other); // Don't run this, it frees the entire scene converter data, just
-        // delete the scene
-        delete other;
-      }
-    }
+      // merge into the base  scene
+      KX_Scene *other = m_ketsjiEngine->CreateScene((Scene *)scene, true);
+      scene_merge->MergeScene(other);
 
-    if (options & LIB_LOAD_ASYNC) {
-      status->SetData(scenes);
-      BLI_task_pool_push(
-          m_threadinfo.m_pool, (TaskRunFunction)async_convert, (void *)status, false, NULL);
+      // RemoveScene(other); // Don't run this, it frees the entire scene converter data, just
+      // delete the scene
+      delete other;
     }
 
 #ifdef WITH_PYTHON
@@ -554,9 +1102,7 @@ KX_LibLoadStatus *BL_BlenderConverter::LinkBlendFile(BlendHandle *bpy_openlib,
     }
   }
 
-  if (!(options & LIB_LOAD_ASYNC)) {
-    status->Finish();
-  }
+  status->Finish();
 
   m_status_map[main_newlib->name] = status;
   return status;
@@ -597,6 +1143,18 @@ bool BL_BlenderConverter::FreeBlendFile(Main *maggie)
     }
   }
 
+  // The queued objects conversions must not use the objects being freed.
+  DiscardAsyncConversions([](KX_LibLoadStatus *UNUSED(status), Object *blenderobj) {
+    return IS_TAGGED(blenderobj);
+  });
+
+  /* The preloaded scenes may use the freed datablocks, they are converted again at their
+   * replace. */
+  EXP_ListValue<KX_Scene> *preloadedScenes = m_ketsjiEngine->PreloadedScenes();
+  while (preloadedScenes->GetCount() > 0) {
+    m_ketsjiEngine->RemovePreloadedScene(preloadedScenes->GetFront());
+  }
+
   // free all tagged objects
   EXP_ListValue<KX_Scene> *scenes = m_ketsjiEngine->CurrentScenes();
   int numScenes = scenes->GetCount();
@@ -610,11 +1168,14 @@ bool BL_BlenderConverter::FreeBlendFile(Main *maggie)
       numScenes--;
     }
     else {
+      // The pooled replicas may be copies of objects being freed.
+      scene->FreeReplicaPool();
+
       // in case the mesh might be refered to later
-      std::map<std::string, void *> &mapStringToMeshes = scene->GetLogicManager()->GetMeshMap();
-      for (std::map<std::string, void *>::iterator it = mapStringToMeshes.begin(),
-                                                   end = mapStringToMeshes.end();
-           it != end;) {
+      std::unordered_map<std::string, void *> &mapStringToMeshes =
+          scene->GetLogicManager()->GetMeshMap();
+      for (std::unordered_map<std::string, void *>::iterator it = mapStringToMeshes.begin();
+           it != mapStringToMeshes.end();) {
         RAS_MeshObject *meshobj = (RAS_MeshObject *)it->second;
         if (meshobj && IS_TAGGED(meshobj->GetOrigMesh())) {
           it = mapStringToMeshes.erase(it);
@@ -625,10 +1186,10 @@ bool BL_BlenderConverter::FreeBlendFile(Main *maggie)
       }
 
       // Now unregister actions.
-      std::map<std::string, void *> &mapStringToActions = scene->GetLogicManager()->GetActionMap();
-      for (std::map<std::string, void *>::iterator it = mapStringToActions.begin(),
-                                                   end = mapStringToActions.end();
-           it != end;) {
+      std::unordered_map<std::string, void *> &mapStringToActions =
+          scene->GetLogicManager()->GetActionMap();
+      for (std::unordered_map<std::string, void *>::iterator it = mapStringToActions.begin();
+           it != mapStringToActions.end();) {
         ID *action = (ID *)it->second;
         if (IS_TAGGED(action)) {
           it = mapStringToActions.erase(it);
@@ -699,6 +1260,9 @@ bool BL_BlenderConverter::FreeBlendFile(Main *maggie)
           }
         }
       }
+
+      // The instances of the objects being freed were removed, their instancers must follow.
+      scene->FreeEmptyInstanceGroups();
     }
   }
 
@@ -753,8 +1317,19 @@ bool BL_BlenderConverter::FreeBlendFile(Main *maggie)
   removeImportMain(maggie);
 #endif
 
-  delete m_status_map[maggie->name];
-  m_status_map.erase(maggie->name);
+  std::map<std::string, KX_LibLoadStatus *>::iterator statusIt = m_status_map.find(
+      maggie->name);
+  if (statusIt != m_status_map.end()) {
+    KX_LibLoadStatus *status = statusIt->second;
+    // An owned status is deleted by PruneConvertStatuses once released.
+    if (status->IsOwned()) {
+      m_convertstatuslist.push_back(status);
+    }
+    else {
+      delete status;
+    }
+    m_status_map.erase(statusIt);
+  }
 
   BKE_main_free(maggie);
 
@@ -898,3 +1473,38 @@ void BL_BlenderConverter::PrintStats()
   CM_Message("\t meshes: " << nummesh);
   CM_Message("\t interpolators: " << numinter);
 }
+
+void BL_BlenderConverter::FillMemoryReport(KX_MemoryReport &report)
+{
+  // The textures of the images are shared by the materials using them.
+  std::unordered_set<GPUTexture *> textures;
+
+  for (const auto &pair : m_sceneSlots) {
+    const SceneSlot &sceneSlot = pair.second;
+
+    for (const std::unique_ptr<RAS_MeshObject> &meshobj : sceneSlot.m_meshobjects) {
+      size_t bytes = sizeof(RAS_MeshObject) + meshobj->NumPolygons() * sizeof(RAS_Polygon);
+      for (unsigned int i = 0, size = meshobj->NumMaterials(); i < size; ++i) {
+        RAS_IDisplayArray *array = meshobj->GetDisplayArray(i);
+        if (array) {
+          bytes += array->GetVertexCount() * array->GetVertexMemorySize() +
+                   array->GetIndexCount() * sizeof(unsigned int);
+        }
+      }
+      report.Add(KX_MemoryReport::MEM_MESHES, 1, bytes);
+    }
+
+    for (const std::unique_ptr<KX_BlenderMaterial> &mat : sceneSlot.m_materials) {
+      for (unsigned short i = 0; i < RAS_Texture::MaxUnits; ++i) {
+        RAS_Texture *tex = mat->GetTexture(i);
+        if (tex && tex->Ok() && tex->GetGPUTexture()) {
+          textures.insert(tex->GetGPUTexture());
+        }
+      }
+    }
+  }
+
+  for (GPUTexture *tex : textures) {
+    report.Add(KX_MemoryReport::MEM_TEXTURES, 1, GPU_texture_memory_size(tex));
+  }
+}
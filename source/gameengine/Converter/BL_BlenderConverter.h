@@ -31,7 +31,9 @@
 
 #pragma once
 
+#include <functional>
 #include <map>
+#include <string>
 #include <vector>
 
 #include "BL_BlenderScalarInterpolator.h"
@@ -44,12 +46,14 @@ class EXP_StringValue;
 class BL_BlenderSceneConverter;
 class KX_KetsjiEngine;
 class KX_LibLoadStatus;
+class KX_MemoryReport;
 class KX_BlenderMaterial;
 class BL_InterpolatorList;
 class RAS_MeshObject;
 class RAS_Rasterizer;
 struct Main;
 struct BlendHandle;
+struct Object;
 struct Scene;
 struct bAction;
 struct TaskPool;
@@ -83,13 +87,22 @@ class BL_BlenderConverter {
 
   // Saved KX_LibLoadStatus objects
   std::map<std::string, KX_LibLoadStatus *> m_status_map;
+  /// Libraries read by the loading tasks, waiting to be linked by the main thread.
+  std::vector<KX_LibLoadStatus *> m_linkqueue;
   std::vector<KX_LibLoadStatus *> m_mergequeue;
+  // Saved KX_LibLoadStatus objects of asynchronous objects conversions
+  std::vector<KX_LibLoadStatus *> m_convertstatuslist;
+  std::vector<KX_LibLoadStatus *> m_convertqueue;
 
   Main *m_maggie;
   std::vector<Main *> m_DynamicMaggie;
 
   KX_KetsjiEngine *m_ketsjiEngine;
   bool m_alwaysUseExpandFraming;
+  /// Directory of the cooked meshes, empty to always convert the meshes.
+  std::string m_meshCacheDirectory;
+  /// Defer the geometry conversion of the meshes used only by inactive objects.
+  bool m_lazyMeshConversion;
 
  public:
   BL_BlenderConverter(Main *maggie, KX_KetsjiEngine *engine);
@@ -107,6 +120,19 @@ class BL_BlenderConverter {
 
   void SetAlwaysUseExpandFraming(bool to_what);
 
+  /** Reuse the meshes converted by the previous launches, the cache is invalidated by the
+   * modification date of the files.
+   * \param directory The directory of the cache files, empty to disable the cache.
+   */
+  void SetMeshCacheDirectory(const std::string &directory);
+  const std::string &GetMeshCacheDirectory() const;
+
+  /** Convert the vertices and the polygons of the meshes used only by the inactive objects
+   * when they are first added or replaced, see BL_ConvertMeshGeometry.
+   */
+  void SetLazyMeshConversion(bool lazy);
+  bool GetLazyMeshConversion() const;
+
   void RegisterInterpolatorList(KX_Scene *scene,
                                 BL_InterpolatorList *interpolator,
                                 bAction *for_act);
@@ -120,21 +146,41 @@ class BL_BlenderConverter {
   Main *GetMainDynamicPath(const std::string &path) const;
   const std::vector<Main *> &GetMainDynamic() const;
 
+  /** Names of the datablocks linked by a LibLoad instead of all the datablocks of its group.
+   * The objects and collections are instanced in a scene merged as a linked scene.
+   */
+  struct LibLoadFilter {
+    /// Objects and collections linked for the Scene group.
+    std::vector<std::string> m_objects;
+    std::vector<std::string> m_collections;
+    /// Meshes linked for the Mesh group.
+    std::vector<std::string> m_meshes;
+  };
+
   KX_LibLoadStatus *LinkBlendFileMemory(void *data,
                                         int length,
                                         const char *path,
                                         char *group,
                                         KX_Scene *scene_merge,
                                         char **err_str,
-                                        short options);
-  KX_LibLoadStatus *LinkBlendFilePath(
-      const char *path, char *group, KX_Scene *scene_merge, char **err_str, short options);
+                                        short options,
+                                        const LibLoadFilter *filter = nullptr);
+  KX_LibLoadStatus *LinkBlendFilePath(const char *path,
+                                      char *group,
+                                      KX_Scene *scene_merge,
+                                      char **err_str,
+                                      short options,
+                                      const LibLoadFilter *filter = nullptr);
+  /** Link the datablocks of a group from a library and merge them in a scene.
+   * \param filter The names of the datablocks to link, all the datablocks if nullptr.
+   */
   KX_LibLoadStatus *LinkBlendFile(BlendHandle *bpy_openlib,
                                   const char *path,
                                   char *group,
                                   KX_Scene *scene_merge,
                                   char **err_str,
-                                  short options);
+                                  short options,
+                                  const LibLoadFilter *filter = nullptr);
 
   bool FreeBlendFile(Main *maggie);
   bool FreeBlendFile(const std::string &path);
@@ -143,11 +189,37 @@ class BL_BlenderConverter {
 
   void MergeScene(KX_Scene *to, KX_Scene *from);
 
-  void MergeAsyncLoads();
+  /** Merge the loaded scenes in their merge scene.
+   * \param useBudget Spread the merges over several calls according to
+   * the merge budget of the libload status, else merge everything.
+   */
+  void MergeAsyncLoads(bool useBudget);
   void FinalizeAsyncLoads();
+  /// Link the libraries read by the loading tasks and queue the conversion of their scenes.
+  void LinkAsyncLoads();
+  void AddLibraryToLinkQueue(KX_LibLoadStatus *status);
   void AddScenesToMergeQueue(KX_LibLoadStatus *status);
 
+  /** Queue the conversion of blender objects into a scene, the objects are converted
+   * over the next frames in ProcessAsyncConversions.
+   * \param name The name reported as library name by the status.
+   */
+  KX_LibLoadStatus *ConvertBlenderObjectsAsync(KX_Scene *scene,
+                                               const std::vector<Object *> &objects,
+                                               const std::string &name);
+  /// Convert queued objects until the conversion time budget of the frame is spent.
+  void ProcessAsyncConversions();
+  /** Remove the queued objects for which discard returns true, the conversions left
+   * without objects are finished.
+   */
+  void DiscardAsyncConversions(
+      const std::function<bool(KX_LibLoadStatus *status, Object *blenderobj)> &discard);
+  /// Delete the finished conversion statuses not owned nor referenced by a script anymore.
+  void PruneConvertStatuses();
+
   void PrintStats();
+  /// Add the memory used by the converted meshes and by the textures of the materials.
+  void FillMemoryReport(KX_MemoryReport &report);
 
   // LibLoad Options.
   enum {
@@ -155,5 +227,31 @@ class BL_BlenderConverter {
     LIB_LOAD_VERBOSE = 2,
     LIB_LOAD_LOAD_SCRIPTS = 4,
     LIB_LOAD_ASYNC = 8,
+    /// Link the scripts and actions used by the linked datablocks only, not all of them.
+    LIB_LOAD_DEPENDENCIES_ONLY = 16,
   };
+
+ private:
+  /// Return true if the library is read, linked and converted in a task.
+  bool IsAsyncSceneLoad(const char *group, short options) const;
+  /// Return false and set the error if the library can't be loaded.
+  bool CheckLinkBlendFile(const char *path,
+                          const char *group,
+                          const LibLoadFilter *filter,
+                          char **err_str) const;
+  /** Queue the reading, the linking and the conversion of the scenes of a library in a task.
+   * \param bpy_openlib The opened library, or nullptr to open the file or the data in the task.
+   * \param data The library data copied for the task, or nullptr to read the file.
+   */
+  KX_LibLoadStatus *LinkBlendFileAsync(BlendHandle *bpy_openlib,
+                                       const char *data,
+                                       int length,
+                                       const char *path,
+                                       char *group,
+                                       KX_Scene *scene_merge,
+                                       char **err_str,
+                                       short options,
+                                       const LibLoadFilter *filter);
+  /// Register the main linked by a task, its scripts and actions, before the merge.
+  void RegisterAsyncLoad(KX_LibLoadStatus *status);
 };
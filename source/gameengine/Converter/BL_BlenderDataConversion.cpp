@@ -63,8 +63,11 @@
 #include "BKE_layer.h"
 #include "BKE_main.h"
 #include "BKE_material.h" /* give_current_material */
+#include "BKE_modifier.h"
 #include "BKE_object.h"
 #include "BKE_scene.h"
+#include "BLI_fileops.h"
+#include "BLI_task.h"
 #include "DEG_depsgraph_query.h"
 #include "DNA_actuator_types.h"
 #include "DNA_python_proxy_types.h"
@@ -73,11 +76,14 @@
 /* end of blender include block */
 
 #include "BL_ArmatureObject.h"
+#include "BL_BlenderConverter.h"
 #include "BL_BlenderSceneConverter.h"
 #include "BL_ConvertActuators.h"
 #include "BL_ConvertControllers.h"
 #include "BL_ConvertProperties.h"
 #include "BL_ConvertSensors.h"
+#include "BL_MeshCache.h"
+#include "CM_StartupProfiler.h"
 #include "KX_BlenderMaterial.h"
 #include "KX_BoneParentNodeRelationship.h"
 #include "KX_Camera.h"
@@ -92,9 +98,11 @@
 #include "KX_ObstacleSimulation.h"
 #include "KX_PyConstraintBinding.h"
 #include "KX_PythonComponent.h"
+#include "KX_StaticBatchManager.h"
 #include "RAS_ICanvas.h"
 #include "RAS_Vertex.h"
 #ifdef WITH_BULLET
+#  include "CcdGraphicController.h"
 #  include "CcdPhysicsEnvironment.h"
 #endif
 
@@ -329,20 +337,70 @@ static RAS_MaterialBucket *BL_material_from_mesh(Material *ma,
   return bucket;
 }
 
-/* blenderobj can be nullptr, make sure its checked for */
-RAS_MeshObject *BL_ConvertMesh(Mesh *mesh,
-                               Object *blenderobj,
-                               KX_Scene *scene,
-                               RAS_Rasterizer *rasty,
-                               BL_BlenderSceneConverter *converter,
-                               bool libloading,
-                               bool converting_during_runtime)
-{
+struct BL_ConvertedMaterial {
+  Material *ma;
+  RAS_MeshMaterial *meshmat;
+  bool visible;
+  bool twoside;
+  bool collider;
+  bool wire;
+};
+
+/// A mesh being converted, the geometry is filled apart from the creation of the materials.
+struct BL_MeshConversion {
+  Mesh *mesh;
   RAS_MeshObject *meshobj;
-  int lightlayer = blenderobj ? blenderobj->lay : (1 << 20) - 1;  // all layers if no object.
+  DerivedMesh *dm;
+  unsigned short uvLayers;
+  unsigned short colorLayers;
+  const float (*normals)[3];
+  const float (*tangent)[4];
+  std::vector<BL_ConvertedMaterial> convertedMats;
+  /// The uv and color layers of the derived mesh.
+  RAS_MeshObject::LayerList layers;
+  /// The geometry was read from the mesh cache.
+  bool cached;
+  /// The cache file to write after the conversion, empty if the cache is unused.
+  std::string cacheFilePath;
+};
+
+/** Identification of the data converted from a mesh in the mesh cache: the files and their
+ * dates, the object giving the materials and the layout of the evaluated mesh.
+ */
+static std::string bl_mesh_cache_key(const BL_MeshConversion &conv,
+                                     Object *blenderobj,
+                                     Mesh *final_me)
+{
+  std::string key;
+  for (ID *id : {&conv.mesh->id, &blenderobj->id}) {
+    const char *filepath = ID_BLEND_PATH_FROM_GLOBAL(id);
+    BLI_stat_t st;
+    if (filepath[0] == '\0' || BLI_stat(filepath, &st) != 0) {
+      // Unsaved data can't be identified.
+      return "";
+    }
+    key += (boost::format("%s:%lld:%lld:%s;") % filepath % (long long)st.st_size %
+            (long long)st.st_mtime % id->name)
+               .str();
+  }
+
+  key += (boost::format("%d:%d:%d:%d:%d:%d;") % final_me->totvert % final_me->totedge %
+          final_me->totloop % final_me->totpoly % conv.uvLayers % conv.colorLayers)
+             .str();
+  for (const BL_ConvertedMaterial &mat : conv.convertedMats) {
+    key += (boost::format("%s:%d:%d;") % mat.ma->id.name % mat.ma->game.flag % mat.wire).str();
+  }
+
+  return key;
+}
 
+static RAS_MeshObject *bl_find_converted_mesh(Mesh *mesh,
+                                              Object *blenderobj,
+                                              BL_BlenderSceneConverter *converter)
+{
   // Without checking names, we get some reuse we don't want that can cause
   // problems with material LoDs.
+  RAS_MeshObject *meshobj;
   if (blenderobj && ((meshobj = converter->FindGameMesh(mesh /*, ob->lay*/)) != nullptr)) {
     const std::string bge_name = meshobj->GetName();
     const std::string blender_name = ((ID *)blenderobj->data)->name + 2;
@@ -351,82 +409,138 @@ RAS_MeshObject *BL_ConvertMesh(Mesh *mesh,
     }
   }
 
-  // Get DerivedMesh data
+  return nullptr;
+}
+
+/// Return the evaluated mesh of the object as a derived mesh.
+static DerivedMesh *bl_mesh_conversion_derived_mesh(Object *blenderobj, Mesh **r_final_me)
+{
   bContext *C = KX_GetActiveEngine()->GetContext();
   Depsgraph *depsgraph = CTX_data_depsgraph_on_load(C);
   Object *ob_eval = DEG_get_evaluated_object(depsgraph, blenderobj);
-  Mesh *final_me = (Mesh *)ob_eval->data;
-  DerivedMesh *dm = CDDM_from_mesh(final_me);
-  DM_ensure_tessface(dm);
-
-  const MVert *mverts = dm->getVertArray(dm);
-  const int totverts = dm->getNumVerts(dm);
-
-  const MFace *mfaces = dm->getTessFaceArray(dm);
-  const MPoly *mpolys = (MPoly *)dm->getPolyArray(dm);
-  const MLoop *mloops = (MLoop *)dm->getLoopArray(dm);
-  const MEdge *medges = (MEdge *)dm->getEdgeArray(dm);
-  const unsigned int numpolys = dm->getNumPolys(dm);
-  const int totfaces = dm->getNumTessFaces(dm);
-  const int *mfaceToMpoly = (int *)dm->getTessFaceDataArray(dm, CD_ORIGINDEX);
+  *r_final_me = (Mesh *)ob_eval->data;
+  return CDDM_from_mesh(*r_final_me);
+}
 
-  if (CustomData_get_layer_index(&dm->loopData, CD_NORMAL) == -1) {
-    dm->calcLoopNormals(dm, (final_me->flag & ME_AUTOSMOOTH), final_me->smoothresh);
-  }
-  const float(*normals)[3] = (float(*)[3])dm->getLoopDataArray(dm, CD_NORMAL);
+/// Extract the uv and color layers of the derived mesh.
+static void bl_mesh_conversion_layers(BL_MeshConversion &conv,
+                                      RAS_MeshObject::LayersInfo &layersInfo)
+{
+  DerivedMesh *dm = conv.dm;
 
   /* Extract available layers.
    * Get the active color and uv layer. */
   const short activeUv = CustomData_get_active_layer(&dm->loopData, CD_MLOOPUV);
   const short activeColor = CustomData_get_active_layer(&dm->loopData, CD_MLOOPCOL);
 
-  RAS_MeshObject::LayersInfo layersInfo;
   layersInfo.activeUv = (activeUv == -1) ? 0 : activeUv;
   layersInfo.activeColor = (activeColor == -1) ? 0 : activeColor;
 
-  const unsigned short uvLayers = CustomData_number_of_layers(&dm->loopData, CD_MLOOPUV);
-  const unsigned short colorLayers = CustomData_number_of_layers(&dm->loopData, CD_MLOOPCOL);
+  conv.uvLayers = CustomData_number_of_layers(&dm->loopData, CD_MLOOPUV);
+  conv.colorLayers = CustomData_number_of_layers(&dm->loopData, CD_MLOOPCOL);
 
   // Extract UV loops.
-  for (unsigned short i = 0; i < uvLayers; ++i) {
+  for (unsigned short i = 0; i < conv.uvLayers; ++i) {
     const std::string name = CustomData_get_layer_name(&dm->loopData, CD_MLOOPUV, i);
     MLoopUV *uv = (MLoopUV *)CustomData_get_layer_n(&dm->loopData, CD_MLOOPUV, i);
     layersInfo.layers.push_back({uv, nullptr, i, name});
   }
   // Extract color loops.
-  for (unsigned short i = 0; i < colorLayers; ++i) {
+  for (unsigned short i = 0; i < conv.colorLayers; ++i) {
     const std::string name = CustomData_get_layer_name(&dm->loopData, CD_MLOOPCOL, i);
     MLoopCol *col = (MLoopCol *)CustomData_get_layer_n(&dm->loopData, CD_MLOOPCOL, i);
     layersInfo.layers.push_back({nullptr, col, i, name});
   }
 
-  float(*tangent)[4] = nullptr;
-  if (uvLayers > 0) {
+  conv.layers = layersInfo.layers;
+}
+
+static BL_ConvertedMaterial bl_converted_material(Material *ma,
+                                                  RAS_MeshMaterial *meshmat,
+                                                  RAS_MaterialBucket *bucket)
+{
+  return {ma,
+          meshmat,
+          ((ma->game.flag & GEMAT_INVISIBLE) == 0),
+          ((ma->game.flag & GEMAT_BACKCULL) == 0),
+          ((ma->game.flag & GEMAT_NOPHYSICS) == 0),
+          bucket->IsWire()};
+}
+
+/** Prepare the derived mesh data read by the fill of the geometry, or read the geometry from
+ * the mesh cache when it is valid.
+ */
+static void bl_mesh_conversion_geometry(BL_MeshConversion &conv,
+                                        Object *blenderobj,
+                                        Mesh *final_me,
+                                        bool libloading)
+{
+  DerivedMesh *dm = conv.dm;
+  RAS_MeshObject *meshobj = conv.meshobj;
+
+  meshobj->m_sharedvertex_map.resize(dm->getNumVerts(dm));
+
+  // The libraries loaded from memory have no file to identify them.
+  const std::string &cacheDir = KX_GetActiveEngine()->GetConverter()->GetMeshCacheDirectory();
+  if (!cacheDir.empty() && blenderobj && !libloading) {
+    const std::string key = bl_mesh_cache_key(conv, blenderobj, final_me);
+    if (!key.empty()) {
+      conv.cacheFilePath = BL_GetMeshCacheFilePath(cacheDir, key);
+      conv.cached = BL_ReadMeshCache(conv.cacheFilePath, meshobj);
+      if (conv.cached) {
+        return;
+      }
+    }
+  }
+
+  DM_ensure_tessface(dm);
+
+  if (CustomData_get_layer_index(&dm->loopData, CD_NORMAL) == -1) {
+    dm->calcLoopNormals(dm, (final_me->flag & ME_AUTOSMOOTH), final_me->smoothresh);
+  }
+  conv.normals = (float(*)[3])dm->getLoopDataArray(dm, CD_NORMAL);
+
+  if (conv.uvLayers > 0) {
     if (CustomData_get_layer_index(&dm->loopData, CD_TANGENT) == -1) {
       DM_calc_loop_tangents(dm, true, nullptr, 0);
     }
-    tangent = (float(*)[4])dm->getLoopDataArray(dm, CD_TANGENT);
+    conv.tangent = (float(*)[4])dm->getLoopDataArray(dm, CD_TANGENT);
   }
+}
+
+/** Create the mesh object and its materials from the evaluated mesh.
+ * It uses the scene and the converter and must be called from the main thread.
+ * \param deferGeometry Only create the materials, the geometry is converted by
+ * BL_ConvertMeshGeometry when the mesh is first needed.
+ */
+static void bl_mesh_conversion_begin(BL_MeshConversion &conv,
+                                     Mesh *mesh,
+                                     Object *blenderobj,
+                                     KX_Scene *scene,
+                                     RAS_Rasterizer *rasty,
+                                     BL_BlenderSceneConverter *converter,
+                                     bool libloading,
+                                     bool converting_during_runtime,
+                                     bool deferGeometry)
+{
+  int lightlayer = blenderobj ? blenderobj->lay : (1 << 20) - 1;  // all layers if no object.
+
+  // Get DerivedMesh data
+  Mesh *final_me;
+  conv.dm = bl_mesh_conversion_derived_mesh(blenderobj, &final_me);
+
+  RAS_MeshObject::LayersInfo layersInfo;
+  bl_mesh_conversion_layers(conv, layersInfo);
 
-  meshobj = new RAS_MeshObject(mesh, final_me->totvert, blenderobj, layersInfo);
-  meshobj->m_sharedvertex_map.resize(totverts);
+  RAS_MeshObject *meshobj = new RAS_MeshObject(mesh, final_me->totvert, blenderobj, layersInfo);
 
   // Initialize vertex format with used uv and color layers.
   RAS_VertexFormat vertformat;
-  vertformat.uvSize = max_ii(1, uvLayers);
-  vertformat.colorSize = max_ii(1, colorLayers);
-
-  struct ConvertedMaterial {
-    Material *ma;
-    RAS_MeshMaterial *meshmat;
-    bool visible;
-    bool twoside;
-    bool collider;
-    bool wire;
-  };
+  vertformat.uvSize = max_ii(1, conv.uvLayers);
+  vertformat.colorSize = max_ii(1, conv.colorLayers);
 
   const unsigned short totmat = max_ii(final_me->totcol, 1);
-  std::vector<ConvertedMaterial> convertedMats(totmat);
+  conv.convertedMats.resize(totmat);
 
   // Convert all the materials contained in the mesh.
   for (unsigned short i = 0; i < totmat; ++i) {
@@ -446,14 +560,52 @@ RAS_MeshObject *BL_ConvertMesh(Mesh *mesh,
         ma, lightlayer, scene, rasty, converter, converting_during_runtime);
     RAS_MeshMaterial *meshmat = meshobj->AddMaterial(bucket, i, vertformat);
 
-    convertedMats[i] = {ma,
-                        meshmat,
-                        ((ma->game.flag & GEMAT_INVISIBLE) == 0),
-                        ((ma->game.flag & GEMAT_BACKCULL) == 0),
-                        ((ma->game.flag & GEMAT_NOPHYSICS) == 0),
-                        bucket->IsWire()};
+    conv.convertedMats[i] = bl_converted_material(ma, meshmat, bucket);
+  }
+
+  conv.mesh = mesh;
+  conv.meshobj = meshobj;
+  conv.normals = nullptr;
+  conv.tangent = nullptr;
+  conv.cached = false;
+
+  if (deferGeometry) {
+    meshobj->SetGeometryPending(true);
+    return;
+  }
+
+  bl_mesh_conversion_geometry(conv, blenderobj, final_me, libloading);
+}
+
+/** Fill the vertices and the polygons of the mesh object.
+ * It only modifies the mesh object and can be run in a thread for each mesh.
+ */
+static void bl_mesh_conversion_fill(BL_MeshConversion &conv)
+{
+  DerivedMesh *dm = conv.dm;
+  RAS_MeshObject *meshobj = conv.meshobj;
+
+  // The geometry is converted when the mesh is first needed.
+  if (meshobj->IsGeometryPending()) {
+    return;
   }
 
+  if (conv.cached) {
+    meshobj->EndConversion();
+    return;
+  }
+
+  const MVert *mverts = dm->getVertArray(dm);
+  const int totverts = dm->getNumVerts(dm);
+
+  const MFace *mfaces = dm->getTessFaceArray(dm);
+  const MPoly *mpolys = (MPoly *)dm->getPolyArray(dm);
+  const MLoop *mloops = (MLoop *)dm->getLoopArray(dm);
+  const MEdge *medges = (MEdge *)dm->getEdgeArray(dm);
+  const unsigned int numpolys = dm->getNumPolys(dm);
+  const int totfaces = dm->getNumTessFaces(dm);
+  const int *mfaceToMpoly = (int *)dm->getTessFaceDataArray(dm, CD_ORIGINDEX);
+
   std::vector<std::vector<unsigned int>> mpolyToMface(numpolys);
   // Generate a list of all mfaces wrapped by a mpoly.
   for (unsigned int i = 0; i < totfaces; ++i) {
@@ -466,7 +618,7 @@ RAS_MeshObject *BL_ConvertMesh(Mesh *mesh,
   for (unsigned int i = 0; i < numpolys; ++i) {
     const MPoly &mpoly = mpolys[i];
 
-    const ConvertedMaterial &mat = convertedMats[mpoly.mat_nr];
+    const BL_ConvertedMaterial &mat = conv.convertedMats[mpoly.mat_nr];
     RAS_MeshMaterial *meshmat = mat.meshmat;
 
     // Mark face as flat, so vertices are split.
@@ -480,12 +632,13 @@ RAS_MeshObject *BL_ConvertMesh(Mesh *mesh,
       const MVert &mvert = mverts[vertid];
 
       const MT_Vector3 pt(mvert.co);
-      const MT_Vector3 no(normals[j]);
-      const MT_Vector4 tan = tangent ? MT_Vector4(tangent[j]) : MT_Vector4(0.0f, 0.0f, 0.0f, 0.0f);
+      const MT_Vector3 no(conv.normals[j]);
+      const MT_Vector4 tan = conv.tangent ? MT_Vector4(conv.tangent[j]) :
+                                            MT_Vector4(0.0f, 0.0f, 0.0f, 0.0f);
       MT_Vector2 uvs[RAS_Texture::MaxUnits];
       unsigned int rgba[RAS_Texture::MaxUnits];
 
-      BL_GetUvRgba(layersInfo.layers, j, uvs, rgba, uvLayers, colorLayers);
+      BL_GetUvRgba(conv.layers, j, uvs, rgba, conv.uvLayers, conv.colorLayers);
 
       // Add tracked vertices by the mpoly.
       vertices[vertid] = meshobj->AddVertex(meshmat, pt, uvs, tan, rgba, no, flat, vertid);
@@ -521,6 +674,18 @@ RAS_MeshObject *BL_ConvertMesh(Mesh *mesh,
   // but this didnt save much ram. - Campbell
   meshobj->EndConversion();
 
+  if (!conv.cacheFilePath.empty()) {
+    BL_WriteMeshCache(conv.cacheFilePath, meshobj);
+  }
+}
+
+/// Finalize the materials and register the mesh object, must be called from the main thread.
+static void bl_mesh_conversion_end(BL_MeshConversion &conv,
+                                   BL_BlenderSceneConverter *converter,
+                                   bool libloading)
+{
+  RAS_MeshObject *meshobj = conv.meshobj;
+
   // Finalize materials.
   // However, we want to delay this if we're libloading so we can make sure we have the right
   // scene.
@@ -531,10 +696,177 @@ RAS_MeshObject *BL_ConvertMesh(Mesh *mesh,
     }
   }
 
-  dm->release(dm);
+  conv.dm->release(conv.dm);
+
+  converter->RegisterGameMesh(meshobj, conv.mesh);
+}
+
+/* blenderobj can be nullptr, make sure its checked for */
+RAS_MeshObject *BL_ConvertMesh(Mesh *mesh,
+                               Object *blenderobj,
+                               KX_Scene *scene,
+                               RAS_Rasterizer *rasty,
+                               BL_BlenderSceneConverter *converter,
+                               bool libloading,
+                               bool converting_during_runtime)
+{
+  RAS_MeshObject *meshobj = bl_find_converted_mesh(mesh, blenderobj, converter);
+  if (meshobj) {
+    return meshobj;
+  }
+
+  BL_MeshConversion conv;
+  bl_mesh_conversion_begin(conv,
+                           mesh,
+                           blenderobj,
+                           scene,
+                           rasty,
+                           converter,
+                           libloading,
+                           converting_during_runtime,
+                           false);
+  bl_mesh_conversion_fill(conv);
+  bl_mesh_conversion_end(conv, converter, libloading);
+
+  return conv.meshobj;
+}
+
+void BL_ConvertMeshGeometry(RAS_MeshObject *meshobj)
+{
+  if (!meshobj->IsGeometryPending()) {
+    return;
+  }
+  meshobj->SetGeometryPending(false);
+
+  Object *blenderobj = meshobj->GetOriginalObject();
+
+  BL_MeshConversion conv;
+  conv.mesh = meshobj->GetOrigMesh();
+  conv.meshobj = meshobj;
+  conv.normals = nullptr;
+  conv.tangent = nullptr;
+  conv.cached = false;
+
+  Mesh *final_me;
+  conv.dm = bl_mesh_conversion_derived_mesh(blenderobj, &final_me);
+
+  // The layers of the mesh object point to the released derived mesh of the first conversion.
+  RAS_MeshObject::LayersInfo layersInfo;
+  bl_mesh_conversion_layers(conv, layersInfo);
+
+  // Find back the materials created with the mesh object.
+  conv.convertedMats.resize(meshobj->NumMaterials());
+  for (unsigned short i = 0, num = meshobj->NumMaterials(); i < num; ++i) {
+    RAS_MeshMaterial *meshmat = meshobj->GetMeshMaterial(i);
+    Material *ma = BKE_object_material_get(blenderobj, i + 1);
+    if (!ma) {
+      ma = BKE_material_default_empty();
+    }
+    conv.convertedMats[i] = bl_converted_material(ma, meshmat, meshmat->GetBucket());
+  }
+
+  bl_mesh_conversion_geometry(conv, blenderobj, final_me, false);
+  bl_mesh_conversion_fill(conv);
+
+  conv.dm->release(conv.dm);
+}
+
+/** Return true if the geometry of the mesh is read when the object is converted: by its
+ * physics shape made of the polygons, its navigation mesh or its levels of detail.
+ */
+static bool bl_object_needs_mesh_geometry(Object *blenderobj)
+{
+  if ((blenderobj->gameflag & OB_NAVMESH) || !BLI_listbase_is_empty(&blenderobj->lodlevels)) {
+    return true;
+  }
+
+  if (!(blenderobj->gameflag & OB_COLLISION)) {
+    return false;
+  }
+
+  if (blenderobj->gameflag & OB_SOFT_BODY) {
+    return true;
+  }
+
+  // Same bounds as CcdPhysicsEnvironment::ConvertObject.
+  if (!(blenderobj->gameflag & OB_BOUNDS)) {
+    return !(blenderobj->gameflag & (OB_DYNAMIC | OB_CHARACTER));
+  }
+
+  return ELEM(blenderobj->collision_boundtype,
+              OB_BOUND_TRIANGLE_MESH,
+              OB_BOUND_CONVEX_HULL,
+              OB_BOUND_CONVEX_DECOMPOSITION);
+}
+
+static void bl_mesh_conversion_fill_task(void *__restrict userdata,
+                                         const int i,
+                                         const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  BL_MeshConversion *convs = (BL_MeshConversion *)userdata;
+  CM_StartupScope meshScope("Convert Mesh", convs[i].mesh->id.name, true);
+  bl_mesh_conversion_fill(convs[i]);
+}
+
+/** Convert the meshes of the objects before the objects themselves, the geometry of each
+ * mesh is filled in parallel. The objects then find their mesh already converted.
+ */
+static void bl_ConvertMeshes(const std::vector<Object *> &blenderobjects,
+                             const std::vector<bool> &lazyobjects,
+                             KX_Scene *scene,
+                             RAS_Rasterizer *rasty,
+                             BL_BlenderSceneConverter *converter,
+                             bool libloading)
+{
+  /* The geometry of a mesh is deferred only if all its objects are lazy, an object using
+   * the mesh and not converted here realizes it when it needs the geometry. */
+  std::map<Mesh *, bool> lazymeshes;
+  for (unsigned int i = 0, size = blenderobjects.size(); i < size; ++i) {
+    Object *blenderobj = blenderobjects[i];
+    if (blenderobj->type == OB_MESH) {
+      Mesh *mesh = static_cast<Mesh *>(blenderobj->data);
+      // Insert the mesh as lazy or unset the flag of an already inserted mesh.
+      lazymeshes.emplace(mesh, true).first->second &= lazyobjects[i];
+    }
+  }
+
+  std::vector<BL_MeshConversion> convs;
+  std::set<Mesh *> meshes;
+  for (Object *blenderobj : blenderobjects) {
+    if (blenderobj->type != OB_MESH) {
+      continue;
+    }
+
+    Mesh *mesh = static_cast<Mesh *>(blenderobj->data);
+    // The first object using a mesh gives its materials, as in BL_ConvertMesh.
+    if (!meshes.insert(mesh).second || bl_find_converted_mesh(mesh, blenderobj, converter)) {
+      continue;
+    }
+
+    convs.emplace_back();
+    bl_mesh_conversion_begin(convs.back(),
+                             mesh,
+                             blenderobj,
+                             scene,
+                             rasty,
+                             converter,
+                             libloading,
+                             false,
+                             lazymeshes[mesh]);
+  }
+
+  if (convs.empty()) {
+    return;
+  }
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(0, convs.size(), convs.data(), bl_mesh_conversion_fill_task, &settings);
 
-  converter->RegisterGameMesh(meshobj, mesh);
-  return meshobj;
+  for (BL_MeshConversion &conv : convs) {
+    bl_mesh_conversion_end(conv, converter, libloading);
+  }
 }
 
 //////////////////////////////////////////////////////
@@ -611,6 +943,53 @@ static void BL_CreatePhysicsObjectNew(KX_GameObject *gameobj,
                                                   KX_ClientObjectInfo::STATIC;
 }
 
+/** Create the bounds of a mesh object in the culling tree of the physics environment.
+ * The bounds of the meshes deformed by an armature are not tracked, these objects are
+ * never culled.
+ */
+static void BL_CreateGraphicObjectNew(KX_GameObject *gameobj,
+                                      Object *blenderobject,
+                                      KX_Scene *kxscene,
+                                      Depsgraph *depsgraph,
+                                      bool isActive,
+                                      e_PhysicsEngine physics_engine)
+{
+  if (gameobj->GetMeshCount() == 0 || gameobj->IsInstance() ||
+      BKE_modifiers_is_deformed_by_armature(blenderobject)) {
+    return;
+  }
+
+  Object *ob_eval = DEG_get_evaluated_object(depsgraph, blenderobject);
+  BoundBox *bb = BKE_object_boundbox_get(ob_eval);
+  if (!bb) {
+    return;
+  }
+
+  // Also kept for the GPU occlusion test.
+  gameobj->GetCullingNode().GetAabb().Set(MT_Vector3(bb->vec[0]), MT_Vector3(bb->vec[6]));
+
+  switch (physics_engine) {
+#ifdef WITH_BULLET
+    case UseBullet: {
+      CcdPhysicsEnvironment *env = static_cast<CcdPhysicsEnvironment *>(
+          kxscene->GetPhysicsEnvironment());
+      PHY_IMotionState *motionstate = new KX_MotionState(gameobj->GetSGNode());
+      CcdGraphicController *ctrl = new CcdGraphicController(env, motionstate);
+      gameobj->SetGraphicController(ctrl);
+      ctrl->SetNewClientInfo(gameobj->getClientInfo());
+      ctrl->SetLocalAabb(MT_Vector3(bb->vec[0]), MT_Vector3(bb->vec[6]));
+      if (isActive) {
+        env->AddCcdGraphicController(ctrl);
+      }
+      break;
+    }
+#endif
+    default: {
+      break;
+    }
+  }
+}
+
 static KX_LodManager *BL_lodmanager_from_blenderobject(Object *ob,
                                                        KX_Scene *scene,
                                                        RAS_Rasterizer *rasty,
@@ -654,10 +1033,27 @@ static KX_GameObject::ActivityCullingInfo activityCullingInfoFromBlenderObject(O
                                Flag)(cullingInfo.m_flags |
                                      KX_GameObject::ActivityCullingInfo::ACTIVITY_LOGIC);
   }
+  if (blenderInfo.flags & OB_ACTIVITY_PHYSICS_LOD) {
+    // Enable physics level of detail.
+    cullingInfo.m_flags = (KX_GameObject::ActivityCullingInfo::
+                               Flag)(cullingInfo.m_flags |
+                                     KX_GameObject::ActivityCullingInfo::ACTIVITY_PHYSICS_LOD);
+  }
+  if (blenderInfo.flags & OB_ACTIVITY_LOGIC_LOD) {
+    // Enable logic level of detail.
+    cullingInfo.m_flags = (KX_GameObject::ActivityCullingInfo::
+                               Flag)(cullingInfo.m_flags |
+                                     KX_GameObject::ActivityCullingInfo::ACTIVITY_LOGIC_LOD);
+  }
 
   // Set culling radius.
   cullingInfo.m_physicsRadius = blenderInfo.physicsRadius * blenderInfo.physicsRadius;
   cullingInfo.m_logicRadius = blenderInfo.logicRadius * blenderInfo.logicRadius;
+  cullingInfo.m_physicsLodRadius = blenderInfo.physicsLodRadius * blenderInfo.physicsLodRadius;
+  cullingInfo.m_logicLodRadius = blenderInfo.logicLodRadius * blenderInfo.logicLodRadius;
+  cullingInfo.m_logicLodInterval = (blenderInfo.logicLodInterval > 1) ?
+                                       blenderInfo.logicLodInterval :
+                                       1;
 
   return cullingInfo;
 }
@@ -1094,7 +1490,8 @@ static void bl_ConvertBlenderObject_Single(BL_BlenderSceneConverter *converter,
                           nullptr,
                           nullptr,
                           KX_Scene::KX_ScenegraphUpdateFunc,
-                          KX_Scene::KX_ScenegraphRescheduleFunc);
+                          KX_Scene::KX_ScenegraphRescheduleFunc,
+                          nullptr);
     SG_Node *parentinversenode = new SG_Node(nullptr, kxscene, callback);
 
     // Define a normal parent relationship for this node.
@@ -1242,10 +1639,14 @@ void BL_ConvertBlenderObjects(struct Main *maggie,
 
     /* set activity culling parameters */
     kxscene->SetActivityCulling((blenderscene->gm.mode & WO_ACTIVITY_CULLING) != 0);
-    kxscene->SetDbvtCulling(false);
+    kxscene->SetDbvtCulling((blenderscene->gm.flag & GAME_USE_DBVT_CULLING) != 0);
 
-    // no occlusion culling by default
-    kxscene->SetDbvtOcclusionRes(0);
+    // An occlusion resolution of zero disables the occlusion culling.
+    kxscene->SetDbvtOcclusionRes((blenderscene->gm.flag & GAME_USE_OCCLUSION_CULLING) ?
+                                     blenderscene->gm.occlusionRes :
+                                     0);
+    kxscene->SetGpuOcclusionCulling((blenderscene->gm.flag & GAME_USE_GPU_OCCLUSION_CULLING) !=
+                                    0);
 
     if (blenderscene->gm.lodflag & SCE_LOD_USE_HYST) {
       kxscene->SetLodHysteresis(true);
@@ -1299,10 +1700,21 @@ void BL_ConvertBlenderObjects(struct Main *maggie,
   // Beware of name conflict in linked data, it will not crash but will create confusion
   // in Python scripting and in certain actuators (replace mesh). Linked scene *should* have
   // no conflicting name for Object, Object data and Action.
+  bool converting_during_runtime = single_object != nullptr;
+
+  // Objects to convert, in the order of the scene bases.
+  std::vector<Object *> blenderobjects;
+  std::vector<bool> activeobjects;
+  // Objects of which the mesh geometry can be converted when they are first added.
+  std::vector<bool> lazyobjects;
+  std::set<Object *> addedobjects;
+  const bool lazyMeshes = KX_GetActiveEngine()->GetConverter()->GetLazyMeshConversion() &&
+                          !libloading;
   for (SETLOOPER(blenderscene, sce_iter, base)) {
     Object *blenderobject = base->object;
 
-    if (converter->FindGameObject(blenderobject) != nullptr) {
+    if (converter->FindGameObject(blenderobject) != nullptr ||
+        !addedobjects.insert(blenderobject).second) {
       continue;
     }
 
@@ -1331,7 +1743,25 @@ void BL_ConvertBlenderObjects(struct Main *maggie,
       DEG_relations_tag_update(maggie);
     }
 
-    bool converting_during_runtime = single_object != nullptr;
+    blenderobjects.push_back(blenderobject);
+    activeobjects.push_back(isInActiveLayer);
+    lazyobjects.push_back(lazyMeshes && !isInActiveLayer &&
+                          !is_lod_level(lod_objects, blenderobject) &&
+                          !bl_object_needs_mesh_geometry(blenderobject));
+  }
+
+  /* Build phase: the meshes are the longest to convert and don't depend on each other.
+   * The game objects, their logic bricks and properties are then created serially as they
+   * register into the logic manager, the converter and the scene lists. */
+  if (!converting_during_runtime) {
+    CM_StartupScope meshesScope("Convert Meshes");
+    bl_ConvertMeshes(blenderobjects, lazyobjects, kxscene, rendertools, converter, libloading);
+  }
+
+  for (unsigned int i = 0, size = blenderobjects.size(); i < size; ++i) {
+    Object *blenderobject = blenderobjects[i];
+    bool isInActiveLayer = activeobjects[i];
+    CM_StartupScope objectScope("Convert Object", blenderobject->id.name, true);
 
     KX_GameObject *gameobj = BL_gameobject_from_blenderobject(
         blenderobject, kxscene, rendertools, converter, libloading, converting_during_runtime);
@@ -1520,6 +1950,27 @@ void BL_ConvertBlenderObjects(struct Main *maggie,
       kxscene->GetPhysicsEnvironment()->SetNumTimeSubSteps(blenderscene->gm.physubstep);
   }
 
+  PHY_IPhysicsEnvironment *phyenv = kxscene->GetPhysicsEnvironment();
+
+  // Build the shapes of the meshes in parallel before the serial creation of the controllers.
+  {
+    std::vector<KX_GameObject *> physicsObjects;
+    for (KX_GameObject *gameobj : sumolist) {
+      if (!single_object || gameobj->GetBlenderObject() == single_object) {
+        physicsObjects.push_back(gameobj);
+
+        // A deferred mesh can be shared with an object reading its geometry.
+        if (bl_object_needs_mesh_geometry(gameobj->GetBlenderObject())) {
+          for (unsigned int i = 0; i < gameobj->GetMeshCount(); ++i) {
+            BL_ConvertMeshGeometry(gameobj->GetMesh(i));
+          }
+        }
+      }
+    }
+    CM_StartupScope shapesScope("Physics Shapes");
+    phyenv->PrepareObjectShapes(physicsObjects, kxscene);
+  }
+
   // Create physics information.
   for (unsigned short i = 0; i < 2; ++i) {
     const bool processCompoundChildren = (i == 1);
@@ -1539,11 +1990,32 @@ void BL_ConvertBlenderObjects(struct Main *maggie,
       }
 
       int layerMask = (groupobj.find(blenderobject) == groupobj.end()) ? activeLayerBitInfo : 0;
+      CM_StartupScope physicsScope("Physics Object", blenderobject->id.name, true);
       BL_CreatePhysicsObjectNew(
           gameobj, blenderobject, meshobj, kxscene, layerMask, converter, processCompoundChildren);
     }
   }
 
+  phyenv->ReleasePreparedShapes();
+
+  // Create the bounds of the render culling.
+  if (kxscene->GetDbvtCulling()) {
+    for (KX_GameObject *gameobj : sumolist) {
+      Object *blenderobject = gameobj->GetBlenderObject();
+      if (single_object && blenderobject != single_object) {
+        continue;
+      }
+
+      int layerMask = (groupobj.find(blenderobject) == groupobj.end()) ? activeLayerBitInfo : 0;
+      BL_CreateGraphicObjectNew(gameobj,
+                                blenderobject,
+                                kxscene,
+                                depsgraph,
+                                (blenderobject->lay & layerMask) != 0,
+                                physics_engine);
+    }
+  }
+
   // create physics joints
   for (KX_GameObject *gameobj : sumolist) {
     PHY_IPhysicsEnvironment *physEnv = kxscene->GetPhysicsEnvironment();
@@ -1654,6 +2126,7 @@ void BL_ConvertBlenderObjects(struct Main *maggie,
     }
     int layerMask = (groupobj.find(blenderobj) == groupobj.end()) ? activeLayerBitInfo : 0;
     bool isInActiveLayer = (blenderobj->lay & layerMask) != 0;
+    CM_StartupScope actuatorsScope("Convert Actuators", blenderobj->id.name, true);
     BL_ConvertActuators(maggie->name,
                         blenderobj,
                         gameobj,
@@ -1673,6 +2146,7 @@ void BL_ConvertBlenderObjects(struct Main *maggie,
     }
     int layerMask = (groupobj.find(blenderobj) == groupobj.end()) ? activeLayerBitInfo : 0;
     bool isInActiveLayer = (blenderobj->lay & layerMask) != 0;
+    CM_StartupScope controllersScope("Convert Controllers", blenderobj->id.name, true);
     BL_ConvertControllers(
         blenderobj, gameobj, logicmgr, layerMask, isInActiveLayer, converter, libloading);
   }
@@ -1685,6 +2159,7 @@ void BL_ConvertBlenderObjects(struct Main *maggie,
     }
     int layerMask = (groupobj.find(blenderobj) == groupobj.end()) ? activeLayerBitInfo : 0;
     bool isInActiveLayer = (blenderobj->lay & layerMask) != 0;
+    CM_StartupScope sensorsScope("Convert Sensors", blenderobj->id.name, true);
     BL_ConvertSensors(blenderobj,
                       gameobj,
                       logicmgr,
@@ -1766,4 +2241,15 @@ void BL_ConvertBlenderObjects(struct Main *maggie,
       }
     }
   }
+
+  /* The libraries are converted in a separate scene before being merged,
+   * only the objects of the scenes started by the engine are batched. */
+  if (!single_object && !libloading &&
+      ketsjiEngine->GetFlag(KX_KetsjiEngine::STATIC_BATCHING)) {
+    std::vector<KX_GameObject *> objects;
+    for (KX_GameObject *gameobj : objectlist) {
+      objects.push_back(gameobj);
+    }
+    kxscene->GetStaticBatchManager()->AddObjects(objects);
+  }
 }
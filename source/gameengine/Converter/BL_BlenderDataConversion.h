@@ -45,6 +45,11 @@ class RAS_MeshObject *BL_ConvertMesh(struct Mesh *mesh,
                                      bool libloading,
                                      bool converting_during_runtime);
 
+/** Convert the vertices and the polygons of a mesh of which the conversion was deferred
+ * because its objects were all inactive, does nothing if the geometry is already converted.
+ */
+void BL_ConvertMeshGeometry(class RAS_MeshObject *meshobj);
+
 void BL_ConvertBlenderObjects(struct Main *maggie,
                               struct Depsgraph *depsgraph,
                               class KX_Scene *kxscene,
@@ -55,6 +55,8 @@
 #include "CM_Utils.h"
 #include "EXP_IntValue.h"
 #include "KX_Globals.h"
+#include "KX_KetsjiEngine.h"
+#include "KX_SoundStreamer.h"
 #include "RAS_2DFilterManager.h"  // for filter type.
 #include "SCA_2DFilterActuator.h"
 #include "SCA_ActionActuator.h"
@@ -315,7 +317,8 @@ void BL_ConvertActuators(const char *maggiename,
 #ifdef WITH_AUDASPACE
             bContext *C = KX_GetActiveEngine()->GetContext();
             BKE_sound_load_no_assert(CTX_data_main(C), sound);
-            snd_sound = sound->playback_handle;
+            // The long sounds are streamed from their file instead of the playback handle.
+            snd_sound = KX_GetActiveEngine()->GetSoundStreamer()->GetSound(sound);
 
             // if sound shall be 3D but isn't mono, we have to make it mono!
             if (is3d) {
@@ -336,7 +339,7 @@ void BL_ConvertActuators(const char *maggiename,
 
 #ifdef WITH_AUDASPACE
           // if we made it mono, we have to free it
-          if (sound && snd_sound && snd_sound != sound->playback_handle) {
+          if (sound && snd_sound && is3d) {
             AUD_Sound_free(snd_sound);
           }
 #endif  // WITH_AUDASPACE
@@ -0,0 +1,390 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Converter/BL_MeshCache.cpp
+ *  \ingroup bgeconv
+ */
+
+#include "BL_MeshCache.h"
+
+#include <cstring>
+#include <fcntl.h>
+#include <map>
+#include <vector>
+
+#ifdef WIN32
+#  include <io.h>
+#else
+#  include <unistd.h>
+#endif
+
+#include "BLI_fileops.h"
+#include "BLI_hash_md5.h"
+#include "BLI_mmap.h"
+#include "BLI_path_util.h"
+#include "BLI_string.h"
+
+#include "RAS_IDisplayArray.h"
+#include "RAS_MeshObject.h"
+#include "RAS_Polygon.h"
+
+/* All the fields are 32 bits, the arrays following the headers stay aligned in the mapping. */
+
+/// Increase when the layout changes, the files of the previous layout are then replaced.
+static const unsigned int meshCacheVersion = 1;
+static const char meshCacheMagic[8] = "BGEMESH";
+
+struct MeshCacheHeader {
+  char magic[8];
+  unsigned int version;
+  unsigned int numMaterials;
+  unsigned int numSharedVertices;
+  unsigned int numPolygons;
+};
+
+/// Followed by the vertices, their infos and the indices of the display array.
+struct MeshCacheMaterial {
+  unsigned int uvSize;
+  unsigned int colorSize;
+  unsigned int numVertices;
+  unsigned int numIndices;
+};
+
+struct MeshCacheVertexInfo {
+  unsigned int origIndex;
+  unsigned int flag;
+};
+
+struct MeshCachePolygon {
+  unsigned int material;
+  unsigned int numVertices;
+  unsigned int offsets[4];
+  unsigned int flags;
+};
+
+/// Followed by the shared vertices of an original vertex.
+struct MeshCacheSharedVertices {
+  unsigned int numShared;
+};
+
+struct MeshCacheSharedVertex {
+  unsigned int material;
+  unsigned int offset;
+};
+
+enum { MESH_CACHE_VISIBLE = 1, MESH_CACHE_COLLIDER = 2, MESH_CACHE_TWOSIDE = 4 };
+
+/// Number of floats of a vertex: position, normal, tangent, uvs and colors.
+static unsigned int mesh_cache_vertex_size(unsigned int uvSize, unsigned int colorSize)
+{
+  return 3 + 3 + 4 + uvSize * 2 + colorSize;
+}
+
+/// Bounds checked access to the mapped file.
+class MeshCacheReader {
+ private:
+  const char *m_data;
+  size_t m_size;
+  size_t m_offset;
+
+ public:
+  MeshCacheReader(const void *data, size_t size)
+      : m_data((const char *)data), m_size(size), m_offset(0)
+  {
+  }
+
+  template<class Item> const Item *Get(size_t count = 1)
+  {
+    const size_t length = sizeof(Item) * count;
+    if (m_size - m_offset < length) {
+      return nullptr;
+    }
+
+    const Item *item = (const Item *)(m_data + m_offset);
+    m_offset += length;
+    return item;
+  }
+
+  bool End() const
+  {
+    return m_offset == m_size;
+  }
+};
+
+/** Walk the file data, validate it against the mesh object if fill is false, else fill the mesh
+ * object. The data is always validated before any modification of the mesh object.
+ */
+static bool mesh_cache_read_data(MeshCacheReader reader, RAS_MeshObject *meshobj, bool fill)
+{
+  const MeshCacheHeader *header = reader.Get<MeshCacheHeader>();
+  const unsigned int numMaterials = meshobj->NumMaterials();
+  if (!header || memcmp(header->magic, meshCacheMagic, sizeof(meshCacheMagic)) != 0 ||
+      header->version != meshCacheVersion || header->numMaterials != numMaterials ||
+      header->numSharedVertices != meshobj->m_sharedvertex_map.size()) {
+    return false;
+  }
+
+  std::vector<unsigned int> numVertices(numMaterials);
+  for (unsigned int i = 0; i < numMaterials; ++i) {
+    RAS_IDisplayArray *array = meshobj->GetDisplayArray(i);
+    const MeshCacheMaterial *mat = reader.Get<MeshCacheMaterial>();
+    if (!mat || mat->uvSize != array->GetVertexUvSize() ||
+        mat->colorSize != array->GetVertexColorSize()) {
+      return false;
+    }
+
+    const unsigned int vertexSize = mesh_cache_vertex_size(mat->uvSize, mat->colorSize);
+    const float *vertices = reader.Get<float>(size_t(vertexSize) * mat->numVertices);
+    const MeshCacheVertexInfo *infos = reader.Get<MeshCacheVertexInfo>(mat->numVertices);
+    const unsigned int *indices = reader.Get<unsigned int>(mat->numIndices);
+    if (!vertices || !infos || !indices) {
+      return false;
+    }
+
+    numVertices[i] = mat->numVertices;
+
+    if (!fill) {
+      for (unsigned int j = 0; j < mat->numIndices; ++j) {
+        if (indices[j] >= mat->numVertices) {
+          return false;
+        }
+      }
+      continue;
+    }
+
+    for (unsigned int j = 0; j < mat->numVertices; ++j) {
+      const float *data = vertices + size_t(j) * vertexSize;
+      const float *uvData = data + 10;
+      const float *colorData = uvData + mat->uvSize * 2;
+
+      MT_Vector2 uvs[RAS_Texture::MaxUnits];
+      unsigned int rgba[RAS_Texture::MaxUnits];
+      for (unsigned int k = 0; k < mat->uvSize; ++k) {
+        uvs[k] = MT_Vector2(uvData + k * 2);
+      }
+      memcpy(rgba, colorData, sizeof(unsigned int) * mat->colorSize);
+
+      RAS_IVertex *vertex = array->CreateVertex(
+          MT_Vector3(data), uvs, MT_Vector4(data + 6), rgba, MT_Vector3(data + 3));
+      array->AddVertex(vertex);
+      delete vertex;
+
+      const bool flat = (infos[j].flag & RAS_VertexInfo::FLAT);
+      array->AddVertexInfo(RAS_VertexInfo(infos[j].origIndex, flat));
+    }
+
+    for (unsigned int j = 0; j < mat->numIndices; ++j) {
+      array->AddIndex(indices[j]);
+    }
+  }
+
+  const MeshCachePolygon *polygons = reader.Get<MeshCachePolygon>(header->numPolygons);
+  if (!polygons) {
+    return false;
+  }
+
+  for (unsigned int i = 0; i < header->numPolygons; ++i) {
+    const MeshCachePolygon &poly = polygons[i];
+    if (!fill) {
+      if (poly.material >= numMaterials || poly.numVertices < 3 || poly.numVertices > 4) {
+        return false;
+      }
+      for (unsigned int j = 0; j < poly.numVertices; ++j) {
+        if (poly.offsets[j] >= numVertices[poly.material]) {
+          return false;
+        }
+      }
+      continue;
+    }
+
+    meshobj->AddConvertedPolygon(meshobj->GetMeshMaterial(poly.material),
+                                 poly.numVertices,
+                                 poly.offsets,
+                                 poly.flags & MESH_CACHE_VISIBLE,
+                                 poly.flags & MESH_CACHE_COLLIDER,
+                                 poly.flags & MESH_CACHE_TWOSIDE);
+  }
+
+  for (unsigned int i = 0; i < header->numSharedVertices; ++i) {
+    const MeshCacheSharedVertices *shared = reader.Get<MeshCacheSharedVertices>();
+    const MeshCacheSharedVertex *vertices =
+        shared ? reader.Get<MeshCacheSharedVertex>(shared->numShared) : nullptr;
+    if (!vertices) {
+      return false;
+    }
+
+    for (unsigned int j = 0; j < shared->numShared; ++j) {
+      const MeshCacheSharedVertex &vertex = vertices[j];
+      if (!fill) {
+        if (vertex.material >= numMaterials || vertex.offset >= numVertices[vertex.material]) {
+          return false;
+        }
+        continue;
+      }
+
+      RAS_MeshObject::SharedVertex sharedVertex;
+      sharedVertex.m_darray = meshobj->GetDisplayArray(vertex.material);
+      sharedVertex.m_offset = vertex.offset;
+      meshobj->m_sharedvertex_map[i].push_back(sharedVertex);
+    }
+  }
+
+  return reader.End();
+}
+
+std::string BL_GetMeshCacheFilePath(const std::string &directory, const std::string &key)
+{
+  char digest[16];
+  char hex_digest[33];
+  BLI_hash_md5_buffer(key.data(), key.size(), digest);
+  BLI_hash_md5_to_hexdigest(digest, hex_digest);
+
+  char filename[FILE_MAXFILE];
+  BLI_snprintf(filename, sizeof(filename), "%s.mesh", hex_digest);
+  char filepath[FILE_MAX];
+  BLI_join_dirfile(filepath, sizeof(filepath), directory.c_str(), filename);
+
+  return filepath;
+}
+
+bool BL_ReadMeshCache(const std::string &filepath, RAS_MeshObject *meshobj)
+{
+  const int file = BLI_open(filepath.c_str(), O_BINARY | O_RDONLY, 0);
+  if (file == -1) {
+    return false;
+  }
+
+  const size_t size = BLI_file_descriptor_size(file);
+  BLI_mmap_file *mmap_file = BLI_mmap_open(file);
+  if (!mmap_file) {
+    close(file);
+    return false;
+  }
+
+  const MeshCacheReader reader(BLI_mmap_get_pointer(mmap_file), size);
+  const bool valid = mesh_cache_read_data(reader, meshobj, false) &&
+                     mesh_cache_read_data(reader, meshobj, true);
+
+  BLI_mmap_free(mmap_file);
+  close(file);
+
+  return valid;
+}
+
+template<class Item>
+static void mesh_cache_append(std::vector<char> &data, const Item *items, size_t count = 1)
+{
+  const char *begin = (const char *)items;
+  data.insert(data.end(), begin, begin + sizeof(Item) * count);
+}
+
+void BL_WriteMeshCache(const std::string &filepath, RAS_MeshObject *meshobj)
+{
+  std::vector<char> data;
+
+  const unsigned int numMaterials = meshobj->NumMaterials();
+  const int numPolygons = meshobj->NumPolygons();
+
+  MeshCacheHeader header;
+  memcpy(header.magic, meshCacheMagic, sizeof(meshCacheMagic));
+  header.version = meshCacheVersion;
+  header.numMaterials = numMaterials;
+  header.numSharedVertices = meshobj->m_sharedvertex_map.size();
+  header.numPolygons = numPolygons;
+  mesh_cache_append(data, &header);
+
+  std::map<RAS_IDisplayArray *, unsigned int> arrayToMaterial;
+  for (unsigned int i = 0; i < numMaterials; ++i) {
+    RAS_IDisplayArray *array = meshobj->GetDisplayArray(i);
+    arrayToMaterial[array] = i;
+
+    const MeshCacheMaterial mat = {array->GetVertexUvSize(),
+                                   array->GetVertexColorSize(),
+                                   array->GetVertexCount(),
+                                   array->GetIndexCount()};
+    mesh_cache_append(data, &mat);
+
+    std::vector<float> vertex(mesh_cache_vertex_size(mat.uvSize, mat.colorSize));
+    for (unsigned int j = 0; j < mat.numVertices; ++j) {
+      const RAS_IVertex *vert = array->GetVertexNoCache(j);
+      memcpy(&vertex[0], vert->getXYZ(), sizeof(float[3]));
+      memcpy(&vertex[3], vert->getNormal(), sizeof(float[3]));
+      memcpy(&vertex[6], vert->getTangent(), sizeof(float[4]));
+      for (unsigned int k = 0; k < mat.uvSize; ++k) {
+        memcpy(&vertex[10 + k * 2], vert->getUV(k), sizeof(float[2]));
+      }
+      for (unsigned int k = 0; k < mat.colorSize; ++k) {
+        const unsigned int rgba = vert->getRawRGBA(k);
+        memcpy(&vertex[10 + mat.uvSize * 2 + k], &rgba, sizeof(unsigned int));
+      }
+      mesh_cache_append(data, vertex.data(), vertex.size());
+    }
+
+    for (unsigned int j = 0; j < mat.numVertices; ++j) {
+      const RAS_VertexInfo &info = array->GetVertexInfo(j);
+      const MeshCacheVertexInfo cacheInfo = {info.getOrigIndex(), (unsigned int)info.getFlag()};
+      mesh_cache_append(data, &cacheInfo);
+    }
+
+    mesh_cache_append(data, array->GetIndexPointer(), mat.numIndices);
+  }
+
+  for (int i = 0; i < numPolygons; ++i) {
+    const RAS_Polygon *poly = meshobj->GetPolygon(i);
+    MeshCachePolygon cachePoly = {arrayToMaterial[poly->GetDisplayArray()],
+                                  (unsigned int)poly->VertexCount(),
+                                  {0, 0, 0, 0},
+                                  (poly->IsVisible() ? MESH_CACHE_VISIBLE : 0u) |
+                                      (poly->IsCollider() ? MESH_CACHE_COLLIDER : 0u) |
+                                      (poly->IsTwoside() ? MESH_CACHE_TWOSIDE : 0u)};
+    for (unsigned int j = 0; j < cachePoly.numVertices; ++j) {
+      cachePoly.offsets[j] = poly->GetVertexOffset(j);
+    }
+    mesh_cache_append(data, &cachePoly);
+  }
+
+  for (const std::vector<RAS_MeshObject::SharedVertex> &sharedmap : meshobj->m_sharedvertex_map) {
+    const MeshCacheSharedVertices shared = {(unsigned int)sharedmap.size()};
+    mesh_cache_append(data, &shared);
+    for (const RAS_MeshObject::SharedVertex &sharedVertex : sharedmap) {
+      const MeshCacheSharedVertex vertex = {arrayToMaterial[sharedVertex.m_darray],
+                                            (unsigned int)sharedVertex.m_offset};
+      mesh_cache_append(data, &vertex);
+    }
+  }
+
+  /* Write in a temporary file first to never read a partial file from an other thread or
+   * process converting the same mesh. */
+  char tmp_filepath[FILE_MAX];
+  BLI_snprintf(tmp_filepath, sizeof(tmp_filepath), "%s.%p.tmp", filepath.c_str(), meshobj);
+
+  FILE *file = BLI_fopen(tmp_filepath, "wb");
+  if (!file) {
+    return;
+  }
+  const bool written = (fwrite(data.data(), 1, data.size(), file) == data.size());
+  fclose(file);
+
+  if (!written || BLI_rename(tmp_filepath, filepath.c_str()) != 0) {
+    BLI_delete(tmp_filepath, false, false);
+  }
+}
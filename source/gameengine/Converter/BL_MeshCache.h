@@ -0,0 +1,52 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file BL_MeshCache.h
+ *  \ingroup bgeconv
+ */
+
+#pragma once
+
+#include <string>
+
+class RAS_MeshObject;
+
+/** Cooked geometry of the converted meshes, reused by the next launches of an unchanged file.
+ * A cache file stores the display arrays, the polygons and the shared vertices of a mesh object
+ * in a flat layout read in place from a memory mapping.
+ */
+
+/** Return the path of the cache file of a mesh.
+ * \param key Identification of the converted data, any change of the key invalidates the file.
+ */
+std::string BL_GetMeshCacheFilePath(const std::string &directory, const std::string &key);
+
+/** Fill the mesh object from a cache file, the mesh object must have its materials and no
+ * geometry.
+ * The file is mapped, it must be called from the main thread.
+ * \return False if the file is missing or doesn't match the materials, the mesh object is then
+ * unmodified.
+ */
+bool BL_ReadMeshCache(const std::string &filepath, RAS_MeshObject *meshobj);
+
+/// Write the geometry of a converted mesh object, it can be called from any thread.
+void BL_WriteMeshCache(const std::string &filepath, RAS_MeshObject *meshobj);
@@ -35,7 +35,7 @@
 DEV_EventConsumer::DEV_EventConsumer(GHOST_ISystem *system,
                                      DEV_InputDevice *device,
                                      RAS_ICanvas *canvas)
-    : m_device(device), m_canvas(canvas)
+    : m_system(system), m_device(device), m_canvas(canvas)
 {
   // Setup the default mouse position.
   int cursorx, cursory;
@@ -49,78 +49,83 @@ DEV_EventConsumer::~DEV_EventConsumer()
 {
 }
 
-void DEV_EventConsumer::HandleWindowEvent(GHOST_TEventType type)
+void DEV_EventConsumer::HandleWindowEvent(GHOST_TEventType type, double age)
 {
-  m_device->ConvertWindowEvent(type);
+  m_device->QueueEvent(DEV_InputDevice::QUEUED_WINDOW, type, 1, 0, age);
 }
 
-void DEV_EventConsumer::HandleKeyEvent(GHOST_TEventDataPtr data, bool down)
+void DEV_EventConsumer::HandleKeyEvent(GHOST_TEventDataPtr data, bool down, double age)
 {
   GHOST_TEventKeyData *keyData = (GHOST_TEventKeyData *)data;
   unsigned int unicode = keyData->utf8_buf[0] ? BLI_str_utf8_as_unicode(keyData->utf8_buf) :
                                                 keyData->ascii;
-  m_device->ConvertKeyEvent(keyData->key, down, unicode);
+  m_device->QueueEvent(DEV_InputDevice::QUEUED_KEY, keyData->key, down, unicode, age);
 }
 
-void DEV_EventConsumer::HandleCursorEvent(GHOST_TEventDataPtr data, GHOST_IWindow *window)
+void DEV_EventConsumer::HandleCursorEvent(GHOST_TEventDataPtr data,
+                                          GHOST_IWindow *window,
+                                          double age)
 {
   GHOST_TEventCursorData *cursorData = (GHOST_TEventCursorData *)data;
   int x, y;
   m_canvas->ConvertMousePosition(cursorData->x, cursorData->y, x, y, false);
 
-  m_device->ConvertMoveEvent(x, y);
+  m_device->QueueEvent(DEV_InputDevice::QUEUED_MOVE, x, y, 0, age);
 }
 
-void DEV_EventConsumer::HandleWheelEvent(GHOST_TEventDataPtr data)
+void DEV_EventConsumer::HandleWheelEvent(GHOST_TEventDataPtr data, double age)
 {
   GHOST_TEventWheelData *wheelData = (GHOST_TEventWheelData *)data;
 
-  m_device->ConvertWheelEvent(wheelData->z);
+  m_device->QueueEvent(DEV_InputDevice::QUEUED_WHEEL, wheelData->z, 0, 0, age);
 }
 
-void DEV_EventConsumer::HandleButtonEvent(GHOST_TEventDataPtr data, bool down)
+void DEV_EventConsumer::HandleButtonEvent(GHOST_TEventDataPtr data, bool down, double age)
 {
   GHOST_TEventButtonData *buttonData = (GHOST_TEventButtonData *)data;
 
-  m_device->ConvertButtonEvent(buttonData->button, down);
+  m_device->QueueEvent(DEV_InputDevice::QUEUED_BUTTON, buttonData->button, down, 0, age);
 }
 
 bool DEV_EventConsumer::processEvent(GHOST_IEvent *event)
 {
   GHOST_TEventDataPtr eventData = ((GHOST_IEvent *)event)->getData();
+  // Time since the system received the event, to order the events inside a frame.
+  const double age = (double)(int64_t)(m_system->getMilliSeconds() - event->getTime()) * 1.0e-3;
+
   switch (event->getType()) {
     case GHOST_kEventButtonDown: {
-      HandleButtonEvent(eventData, true);
+      HandleButtonEvent(eventData, true, age);
       break;
     }
 
     case GHOST_kEventButtonUp: {
-      HandleButtonEvent(eventData, false);
+      HandleButtonEvent(eventData, false, age);
       break;
     }
 
     case GHOST_kEventWheel: {
-      HandleWheelEvent(eventData);
+      HandleWheelEvent(eventData, age);
       break;
     }
 
     case GHOST_kEventCursorMove: {
-      HandleCursorEvent(eventData, event->getWindow());
+      HandleCursorEvent(eventData, event->getWindow(), age);
       break;
     }
 
     case GHOST_kEventKeyDown: {
-      HandleKeyEvent(eventData, true);
+      HandleKeyEvent(eventData, true, age);
       break;
     }
     case GHOST_kEventKeyUp: {
-      HandleKeyEvent(eventData, false);
+      HandleKeyEvent(eventData, false, age);
       break;
     }
     case GHOST_kEventWindowSize:
     case GHOST_kEventWindowClose:
     case GHOST_kEventQuitRequest: {
-      HandleWindowEvent(event->getType());
+      HandleWindowEvent(event->getType(), age);
       break;
     }
     default:
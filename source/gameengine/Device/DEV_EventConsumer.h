@@ -33,16 +33,20 @@ class GHOST_ISystem;
 
 class RAS_ICanvas;
 
+/** Queue the GHOST events in the input device, they are converted at the next flush of the
+ * device with the time they were received by the system.
+ */
 class DEV_EventConsumer : public GHOST_IEventConsumer {
  private:
+  GHOST_ISystem *m_system;
   DEV_InputDevice *m_device;
   RAS_ICanvas *m_canvas;
 
-  void HandleWindowEvent(GHOST_TEventType type);
-  void HandleKeyEvent(GHOST_TEventDataPtr data, bool down);
-  void HandleCursorEvent(GHOST_TEventDataPtr data, GHOST_IWindow *window);
-  void HandleWheelEvent(GHOST_TEventDataPtr data);
-  void HandleButtonEvent(GHOST_TEventDataPtr data, bool down);
+  void HandleWindowEvent(GHOST_TEventType type, double age);
+  void HandleKeyEvent(GHOST_TEventDataPtr data, bool down, double age);
+  void HandleCursorEvent(GHOST_TEventDataPtr data, GHOST_IWindow *window, double age);
+  void HandleWheelEvent(GHOST_TEventDataPtr data, double age);
+  void HandleButtonEvent(GHOST_TEventDataPtr data, bool down, double age);
 
  public:
   DEV_EventConsumer(GHOST_ISystem *system, DEV_InputDevice *device, RAS_ICanvas *canvas);
@@ -25,10 +25,15 @@
  */
 
 #include "DEV_InputDevice.h"
+#include "DEV_InputRecord.h"
 
+#include <algorithm>
+
+#include "CM_Clock.h"
+#include "CM_Message.h"
 #include "GHOST_Types.h"
 
-DEV_InputDevice::DEV_InputDevice()
+DEV_InputDevice::DEV_InputDevice() : m_record(nullptr), m_replay(nullptr), m_clock(nullptr)
 {
   m_reverseKeyTranslateTable[GHOST_kKeyA] = AKEY;
   m_reverseKeyTranslateTable[GHOST_kKeyB] = BKEY;
@@ -189,6 +194,10 @@ void DEV_InputDevice::ConvertEvent(SCA_IInputDevice::SCA_EnumInputs type,
                                    int val,
                                    unsigned int unicode)
 {
+  if (m_record) {
+    m_record->AddEvent(DEV_InputRecord::EVENT_INPUT, type, val, unicode);
+  }
+
   SCA_InputEvent &event = m_inputsTable[type];
 
   if (event.m_values[event.m_values.size() - 1] != val) {
@@ -196,6 +205,7 @@ void DEV_InputDevice::ConvertEvent(SCA_IInputDevice::SCA_EnumInputs type,
     event.m_status.push_back((val > 0) ? SCA_InputEvent::ACTIVE : SCA_InputEvent::NONE);
     event.m_queue.push_back((val > 0) ? SCA_InputEvent::JUSTACTIVATED :
                                         SCA_InputEvent::JUSTRELEASED);
+    event.m_times.push_back(m_eventTime);
     event.m_values.push_back(val);
     event.m_unicode = unicode;
 
@@ -208,11 +218,16 @@ void DEV_InputDevice::ConvertEvent(SCA_IInputDevice::SCA_EnumInputs type,
 
 void DEV_InputDevice::ConvertMoveEvent(int x, int y)
 {
+  if (m_record) {
+    m_record->AddEvent(DEV_InputRecord::EVENT_MOVE, x, y, 0);
+  }
+
   SCA_InputEvent &xevent = m_inputsTable[MOUSEX];
   xevent.m_values.push_back(x);
   if (xevent.m_status[xevent.m_status.size() - 1] != SCA_InputEvent::ACTIVE) {
     xevent.m_status.push_back(SCA_InputEvent::ACTIVE);
     xevent.m_queue.push_back(SCA_InputEvent::JUSTACTIVATED);
+    xevent.m_times.push_back(m_eventTime);
   }
 
   SCA_InputEvent &yevent = m_inputsTable[MOUSEY];
@@ -220,15 +235,106 @@ void DEV_InputDevice::ConvertMoveEvent(int x, int y)
   if (yevent.m_status[yevent.m_status.size() - 1] != SCA_InputEvent::ACTIVE) {
     yevent.m_status.push_back(SCA_InputEvent::ACTIVE);
     yevent.m_queue.push_back(SCA_InputEvent::JUSTACTIVATED);
+    yevent.m_times.push_back(m_eventTime);
   }
 }
 
 void DEV_InputDevice::ConvertWheelEvent(int z)
 {
+  if (m_record) {
+    m_record->AddEvent(DEV_InputRecord::EVENT_WHEEL, z, 0, 0);
+  }
+
   SCA_InputEvent &event = m_inputsTable[(z > 0) ? WHEELUPMOUSE : WHEELDOWNMOUSE];
   event.m_values.push_back(z);
   if (event.m_status[event.m_status.size() - 1] != SCA_InputEvent::ACTIVE) {
     event.m_status.push_back(SCA_InputEvent::ACTIVE);
     event.m_queue.push_back(SCA_InputEvent::JUSTACTIVATED);
+    event.m_times.push_back(m_eventTime);
+  }
+}
+
+void DEV_InputDevice::QueueEvent(
+    QueuedEventType type, int code, int value, unsigned int unicode, double age)
+{
+  // A late or inconsistent system time is clamped to the reception.
+  const double now = m_clock ? m_clock->GetTimeSecond() : 0.0;
+  const QueuedEvent event = {type, code, value, unicode, now - std::min(std::max(age, 0.0), 1.0)};
+
+  if (!m_queuedEvents.Push(event)) {
+    CM_Warning("input event queue full, event dropped");
+  }
+}
+
+void DEV_InputDevice::FlushEvents()
+{
+  const double time = m_eventTime;
+
+  QueuedEvent event;
+  while (m_queuedEvents.Pop(event)) {
+    m_eventTime = event.time;
+    switch (event.type) {
+      case QUEUED_KEY: {
+        ConvertKeyEvent(event.code, event.value, event.unicode);
+        break;
+      }
+      case QUEUED_BUTTON: {
+        ConvertButtonEvent(event.code, event.value);
+        break;
+      }
+      case QUEUED_WINDOW: {
+        ConvertWindowEvent(event.code);
+        break;
+      }
+      case QUEUED_MOVE: {
+        ConvertMoveEvent(event.code, event.value);
+        break;
+      }
+      case QUEUED_WHEEL: {
+        ConvertWheelEvent(event.code);
+        break;
+      }
+    }
   }
+
+  m_eventTime = time;
+
+  // The recorded events are converted at the same flush than when they were recorded.
+  if (m_replay) {
+    m_replay->Replay(this);
+    m_replay->NextFlush();
+  }
+  if (m_record) {
+    m_record->NextFlush();
+  }
+}
+
+void DEV_InputDevice::ProcessEvents(double time)
+{
+  if (m_eventPump) {
+    m_eventPump();
+  }
+  FlushEvents();
+
+  SCA_IInputDevice::ProcessEvents(time);
+}
+
+void DEV_InputDevice::SetClock(const CM_Clock *clock)
+{
+  m_clock = clock;
+}
+
+void DEV_InputDevice::SetEventPump(const std::function<void()> &pump)
+{
+  m_eventPump = pump;
+}
+
+void DEV_InputDevice::SetRecord(DEV_InputRecord *record)
+{
+  m_record = record;
+}
+
+void DEV_InputDevice::SetReplay(DEV_InputRecord *record)
+{
+  m_replay = record;
 }
@@ -26,12 +26,45 @@
 
 #pragma once
 
+#include <functional>
 #include <map>
 
+#include "CM_RingBuffer.h"
 #include "SCA_IInputDevice.h"
 
+class CM_Clock;
+class DEV_InputRecord;
+
 class DEV_InputDevice : public SCA_IInputDevice {
+ public:
+  /// Kind of a queued event, matching the conversion functions.
+  enum QueuedEventType { QUEUED_KEY, QUEUED_BUTTON, QUEUED_WINDOW, QUEUED_MOVE, QUEUED_WHEEL };
+
+  /// Event received from the system and not yet converted.
+  struct QueuedEvent {
+    QueuedEventType type;
+    /// The system code of the input, or the x position of a move.
+    int code;
+    /// The value of the input, or the y position of a move.
+    int value;
+    unsigned int unicode;
+    /// Time in seconds of the engine clock.
+    double time;
+  };
+
  protected:
+  /// Record of the converted events, nullptr when not recording.
+  DEV_InputRecord *m_record;
+  /// Record of the events converted at each flush, nullptr when not replaying.
+  DEV_InputRecord *m_replay;
+
+  /// Events received since the last conversion, in reception order.
+  CM_RingBuffer<QueuedEvent, 4096> m_queuedEvents;
+  /// Clock giving the time of the queued events, nullptr for zero.
+  const CM_Clock *m_clock;
+  /// Function reading the pending system events just before the conversion.
+  std::function<void()> m_eventPump;
+
   /// These maps converts GHOST input number to SCA input enum.
   std::map<int, SCA_EnumInputs> m_reverseKeyTranslateTable;
   std::map<int, SCA_EnumInputs> m_reverseButtonTranslateTable;
@@ -47,4 +80,22 @@ class DEV_InputDevice : public SCA_IInputDevice {
   void ConvertMoveEvent(int x, int y);
   void ConvertWheelEvent(int z);
   void ConvertEvent(SCA_IInputDevice::SCA_EnumInputs type, int val, unsigned int unicode);
+
+  /** Queue a system event to convert at the next flush, can be called from another thread
+   * than the conversion.
+   * \param age The time in seconds since the system received the event.
+   */
+  void QueueEvent(QueuedEventType type, int code, int value, unsigned int unicode, double age);
+  /// Convert all the queued events in their reception order.
+  void FlushEvents();
+  /// Read the system events with the event pump and convert them.
+  virtual void ProcessEvents(double time);
+
+  void SetClock(const CM_Clock *clock);
+  void SetEventPump(const std::function<void()> &pump);
+
+  /// Set the record receiving all the converted events.
+  void SetRecord(DEV_InputRecord *record);
+  /// Set the record whose events are converted at each flush.
+  void SetReplay(DEV_InputRecord *record);
 };
@@ -0,0 +1,116 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Device/DEV_InputRecord.cpp
+ *  \ingroup device
+ */
+
+#include "DEV_InputRecord.h"
+
+#include <fstream>
+
+#include "DEV_InputDevice.h"
+
+/// Identifier and version of the file format, the next lines contain one event each.
+static const char *fileHeader = "BGE_INPUT_RECORD 2";
+
+DEV_InputRecord::DEV_InputRecord() : m_flush(0), m_replayIndex(0)
+{
+}
+
+DEV_InputRecord::~DEV_InputRecord()
+{
+}
+
+void DEV_InputRecord::NextFlush()
+{
+  ++m_flush;
+}
+
+void DEV_InputRecord::AddEvent(EventType type, int code, int value, unsigned int unicode)
+{
+  m_events.push_back({m_flush, type, code, value, unicode});
+}
+
+void DEV_InputRecord::Replay(DEV_InputDevice *device)
+{
+  for (const unsigned int size = m_events.size();
+       m_replayIndex < size && m_events[m_replayIndex].m_flush <= m_flush;
+       ++m_replayIndex) {
+    const Event &event = m_events[m_replayIndex];
+    switch (event.m_type) {
+      case EVENT_INPUT: {
+        device->ConvertEvent(
+            (SCA_IInputDevice::SCA_EnumInputs)event.m_code, event.m_value, event.m_unicode);
+        break;
+      }
+      case EVENT_MOVE: {
+        device->ConvertMoveEvent(event.m_code, event.m_value);
+        break;
+      }
+      case EVENT_WHEEL: {
+        device->ConvertWheelEvent(event.m_code);
+        break;
+      }
+    }
+  }
+}
+
+bool DEV_InputRecord::Load(const std::string &filepath)
+{
+  std::ifstream file(filepath);
+  std::string header;
+  if (!std::getline(file, header) || header != fileHeader) {
+    return false;
+  }
+
+  m_events.clear();
+  m_replayIndex = 0;
+
+  Event event;
+  int type;
+  while (file >> event.m_flush >> type >> event.m_code >> event.m_value >> event.m_unicode) {
+    if (type < EVENT_INPUT || type > EVENT_WHEEL) {
+      return false;
+    }
+    event.m_type = (EventType)type;
+    m_events.push_back(event);
+  }
+
+  return file.eof();
+}
+
+bool DEV_InputRecord::Save(const std::string &filepath) const
+{
+  std::ofstream file(filepath);
+  if (!file) {
+    return false;
+  }
+
+  file << fileHeader << "\n";
+  for (const Event &event : m_events) {
+    file << event.m_flush << " " << (int)event.m_type << " " << event.m_code << " "
+         << event.m_value << " " << event.m_unicode << "\n";
+  }
+
+  return file.good();
+}
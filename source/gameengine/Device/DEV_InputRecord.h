@@ -0,0 +1,74 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file DEV_InputRecord.h
+ *  \ingroup device
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+class DEV_InputDevice;
+
+/** Record of the events converted by an input device at each flush of its events, used to
+ * replay the same inputs at the same points of the frames in benchmarks.
+ */
+class DEV_InputRecord {
+ public:
+  enum EventType { EVENT_INPUT = 0, EVENT_MOVE, EVENT_WHEEL };
+
+  struct Event {
+    /// Index of the flush converting the event.
+    unsigned int m_flush;
+    EventType m_type;
+    /// The input for EVENT_INPUT, the x position for EVENT_MOVE or the wheel value.
+    int m_code;
+    /// The input value for EVENT_INPUT or the y position for EVENT_MOVE.
+    int m_value;
+    unsigned int m_unicode;
+  };
+
+ private:
+  std::vector<Event> m_events;
+  /// Index of the flush of the events added or replayed.
+  unsigned int m_flush;
+  /// Index of the next event to replay.
+  unsigned int m_replayIndex;
+
+ public:
+  DEV_InputRecord();
+  ~DEV_InputRecord();
+
+  /// Move to the next flush of the device events, called at the end of every flush.
+  void NextFlush();
+
+  void AddEvent(EventType type, int code, int value, unsigned int unicode);
+  /// Convert in the device the recorded events of the current flush.
+  void Replay(DEV_InputDevice *device);
+
+  /// Load a record from a file, return false if the file can't be read.
+  bool Load(const std::string &filepath);
+  /// Save the record to a file, return false if the file can't be written.
+  bool Save(const std::string &filepath) const;
+};
@@ -48,14 +48,15 @@ DEV_Joystick::DEV_Joystick(short index)
       m_buttonmax(-1),
       m_isinit(0),
       m_istrig_axis(0),
-      m_istrig_button(0)
+      m_istrig_button(0),
+      m_rumbleSupport(false),
+      m_rumbleStatus(false),
+      m_rumbleCommands(0)
 {
   for (int i = 0; i < JOYAXIS_MAX; i++)
     m_axis_array[i] = 0;
-
-#ifdef WITH_SDL
-  m_private = new PrivateData();
-#endif
+  for (int i = 0; i < JOYBUT_MAX; i++)
+    m_button_array[i] = false;
 }
 
 DEV_Joystick::~DEV_Joystick()
@@ -63,6 +64,9 @@ DEV_Joystick::~DEV_Joystick()
 }
 
 DEV_Joystick *DEV_Joystick::m_instance[JOYINDEX_MAX];
+#ifdef WITH_SDL
+DEV_Joystick::Poller *DEV_Joystick::m_poller = nullptr;
+#endif
 
 void DEV_Joystick::Init()
 {
@@ -85,6 +89,10 @@ void DEV_Joystick::Init()
             "database (more restricted)");
       }
     }
+
+    /* The mappings must be loaded before the polling thread opens the devices
+     * of the SDL_JOYDEVICEADDED events queued by the initialization. */
+    m_poller = new Poller();
   }
   else {
     CM_Error("initializing SDL Game Controller: " << SDL_GetError());
@@ -95,9 +103,16 @@ void DEV_Joystick::Init()
 void DEV_Joystick::Close()
 {
 #ifdef WITH_SDL
-  /* Closing possible connected Joysticks */
+  /* Stopping the polling thread, closing possible connected Joysticks */
+  if (m_poller) {
+    delete m_poller;
+    m_poller = nullptr;
+  }
+
   for (int i = 0; i < JOYINDEX_MAX; i++) {
-    m_instance[i]->ReleaseInstance(i);
+    if (m_instance[i]) {
+      m_instance[i]->ReleaseInstance(i);
+    }
   }
 
   /* Closing SDL Game controller system */
@@ -124,14 +139,56 @@ void DEV_Joystick::ReleaseInstance(short joyindex)
 {
 #ifdef WITH_SDL
   if (m_instance[joyindex]) {
-    m_instance[joyindex]->DestroyJoystickDevice();
-    delete m_private;
     delete m_instance[joyindex];
   }
   m_instance[joyindex] = nullptr;
 #endif /* WITH_SDL */
 }
 
+void DEV_Joystick::SetState(const State &state)
+{
+#ifdef WITH_SDL
+  for (int i = 0; i < JOYAXIS_MAX; i++) {
+    m_axis_array[i] = state.m_axes[i];
+  }
+  for (int i = 0; i < JOYBUT_MAX; i++) {
+    m_button_array[i] = state.m_buttons[i];
+  }
+
+  m_istrig_axis = state.m_trigAxis;
+  m_istrig_button = state.m_trigButton;
+
+  if (state.m_connected != m_isinit) {
+    m_isinit = state.m_connected;
+    /* A Game Controller has:
+     *
+     * 6 axis availables:	   AXIS_LEFTSTICK_X, AXIS_LEFTSTICK_Y,
+     * (in order from 0 to 5)  AXIS_RIGHTSTICK_X, AXIS_RIGHTSTICK_Y,
+     *						   AXIS_TRIGGERLEFT and AXIS_TRIGGERRIGHT.
+     *
+     * 15 buttons availables:  BUTTON_A, BUTTON_B, BUTTON_X, BUTTON_Y,
+     * (in order from 0 to 14) BUTTON_BACK, BUTTON_GUIDE, BUTTON_START,
+     *						   BUTTON_LEFTSTICK, BUTTON_RIGHTSTICK,
+     *						   BUTTON_LEFTSHOULDER, BUTTON_RIGHTSHOULDER,
+     *						   BUTTON_DPAD_UP, BUTTON_DPAD_DOWN,
+     *						   BUTTON_DPAD_LEFT and BUTTON_DPAD_RIGHT.
+     */
+    m_axismax = m_isinit ? SDL_CONTROLLER_AXIS_MAX : 0;
+    m_buttonmax = m_isinit ? SDL_CONTROLLER_BUTTON_MAX : 0;
+  }
+
+  if (m_name != state.m_name) {
+    m_name = state.m_name;
+  }
+
+  m_rumbleSupport = state.m_rumbleSupport;
+  // Keep the predicted status while commands are pending.
+  if (state.m_rumbleCommands == m_rumbleCommands) {
+    m_rumbleStatus = state.m_rumbleStatus;
+  }
+#endif /* WITH_SDL */
+}
+
 void DEV_Joystick::cSetPrecision(int val)
 {
   m_prec = val;
@@ -165,48 +222,38 @@ bool DEV_Joystick::aAxisIsPositive(int axis_single)
 
 bool DEV_Joystick::aAnyButtonPressIsPositive(void)
 {
-#ifdef WITH_SDL
   /* this is needed for the "all events" option
    * so we know if there are no buttons pressed */
   for (int i = 0; i < m_buttonmax; i++) {
-    if (SDL_GameControllerGetButton(m_private->m_gamecontroller, (SDL_GameControllerButton)i)) {
+    if (m_button_array[i]) {
       return true;
     }
   }
-#endif
   return false;
 }
 
 bool DEV_Joystick::aButtonPressIsPositive(int button)
 {
-#ifdef WITH_SDL
-  if (SDL_GameControllerGetButton(m_private->m_gamecontroller, (SDL_GameControllerButton)button)) {
+  if (button >= 0 && button < m_buttonmax && m_button_array[button]) {
     return true;
   }
-#endif
   return false;
 }
 
 bool DEV_Joystick::aButtonReleaseIsPositive(int button)
 {
-#ifdef WITH_SDL
-  if (!(SDL_GameControllerGetButton(m_private->m_gamecontroller,
-                                    (SDL_GameControllerButton)button))) {
+  if (button >= 0 && button < m_buttonmax && !m_button_array[button]) {
     return true;
   }
-#endif
   return false;
 }
 
-bool DEV_Joystick::CreateJoystickDevice(void)
+#ifdef WITH_SDL
+bool DEV_Joystick::PrivateData::CreateJoystickDevice()
 {
   bool joy_error = false;
 
-#ifndef WITH_SDL
-  m_isinit = true;
-  joy_error = true;
-#else  /* WITH_SDL */
-  if (!m_isinit) {
+  if (!m_gamecontroller) {
     if (!joy_error && !SDL_IsGameController(m_joyindex)) {
       /* mapping instruccions if joystick is not a game controller */
       CM_Error(
@@ -223,23 +270,23 @@ bool DEV_Joystick::CreateJoystickDevice(void)
     }
 
     if (!joy_error) {
-      m_private->m_gamecontroller = SDL_GameControllerOpen(m_joyindex);
-      if (!m_private->m_gamecontroller) {
+      m_gamecontroller = SDL_GameControllerOpen(m_joyindex);
+      if (!m_gamecontroller) {
         joy_error = true;
       }
     }
 
     SDL_Joystick *joy;
     if (!joy_error) {
-      joy = SDL_GameControllerGetJoystick(m_private->m_gamecontroller);
+      joy = SDL_GameControllerGetJoystick(m_gamecontroller);
       if (!joy) {
         joy_error = true;
       }
     }
 
     if (!joy_error) {
-      m_private->m_instance_id = SDL_JoystickInstanceID(joy);
-      if (m_private->m_instance_id < 0) {
+      m_instance_id = SDL_JoystickInstanceID(joy);
+      if (m_instance_id < 0) {
         joy_error = true;
         CM_Error("joystick instanced failed: " << SDL_GetError());
       }
@@ -248,74 +295,57 @@ bool DEV_Joystick::CreateJoystickDevice(void)
     if (!joy_error) {
       CM_Debug("Game Controller (" << GetName() << ") with index " << m_joyindex
                                    << " initialized");
-
-      /* A Game Controller has:
-       *
-       * 6 axis availables:	   AXIS_LEFTSTICK_X, AXIS_LEFTSTICK_Y,
-       * (in order from 0 to 5)  AXIS_RIGHTSTICK_X, AXIS_RIGHTSTICK_Y,
-       *						   AXIS_TRIGGERLEFT and AXIS_TRIGGERRIGHT.
-       *
-       * 15 buttons availables:  BUTTON_A, BUTTON_B, BUTTON_X, BUTTON_Y,
-       * (in order from 0 to 14) BUTTON_BACK, BUTTON_GUIDE, BUTTON_START,
-       *						   BUTTON_LEFTSTICK, BUTTON_RIGHTSTICK,
-       *						   BUTTON_LEFTSHOULDER, BUTTON_RIGHTSHOULDER,
-       *						   BUTTON_DPAD_UP, BUTTON_DPAD_DOWN,
-       *						   BUTTON_DPAD_LEFT and BUTTON_DPAD_RIGHT.
-       */
-      m_axismax = SDL_CONTROLLER_AXIS_MAX;
-      m_buttonmax = SDL_CONTROLLER_BUTTON_MAX;
     }
 
     /* Haptic configuration */
     if (!joy_error) {
-      m_private->m_haptic = SDL_HapticOpen(m_joyindex);
-      if (!m_private->m_haptic) {
+      m_haptic = SDL_HapticOpen(m_joyindex);
+      if (!m_haptic) {
         CM_Warning("Game Controller (" << GetName() << ") with index " << m_joyindex
                                        << " has not force feedback (vibration) available");
       }
     }
   }
-#endif /* WITH_SDL */
 
   if (joy_error) {
-    m_axismax = m_buttonmax = 0;
+    if (m_gamecontroller) {
+      SDL_GameControllerClose(m_gamecontroller);
+      m_gamecontroller = nullptr;
+    }
     return false;
   }
-  else {
-    m_isinit = true;
-    return true;
-  }
+  return true;
 }
 
-void DEV_Joystick::DestroyJoystickDevice(void)
+void DEV_Joystick::PrivateData::DestroyJoystickDevice()
 {
-#ifdef WITH_SDL
-  if (m_isinit) {
+  if (m_haptic) {
+    SDL_HapticClose(m_haptic);
+    m_haptic = nullptr;
+  }
 
-    if (m_private->m_haptic) {
-      SDL_HapticClose(m_private->m_haptic);
-      m_private->m_haptic = nullptr;
-    }
+  if (m_gamecontroller) {
+    CM_Debug("Game Controller (" << GetName() << ") with index " << m_joyindex << " closed");
+    SDL_GameControllerClose(m_gamecontroller);
+    m_gamecontroller = nullptr;
+  }
 
-    if (m_private->m_gamecontroller) {
-      CM_Debug("Game Controller (" << GetName() << ") with index " << m_joyindex << " closed");
-      SDL_GameControllerClose(m_private->m_gamecontroller);
-      m_private->m_gamecontroller = nullptr;
-    }
+  m_instance_id = -1;
+  m_hapticEffectId = -1;
+  m_hapticEffectStatus = JOYHAPTIC_STOPPED;
+  m_hapticEndTime = 0.0;
+}
 
-    m_isinit = false;
-  }
-#endif /* WITH_SDL */
+const std::string DEV_Joystick::PrivateData::GetName()
+{
+  const char *name = SDL_GameControllerName(m_gamecontroller);
+  return name ? name : "";
 }
+#endif /* WITH_SDL */
 
 int DEV_Joystick::Connected(void)
 {
-#ifdef WITH_SDL
-  if (m_isinit && SDL_GameControllerGetAttached(m_private->m_gamecontroller)) {
-    return 1;
-  }
-#endif
-  return 0;
+  return m_isinit ? 1 : 0;
 }
 
 int DEV_Joystick::pGetAxis(int axisnum, int udlr)
@@ -353,9 +383,5 @@ int DEV_Joystick::pAxisTest(int axisnum)
 
 const std::string DEV_Joystick::GetName()
 {
-#ifdef WITH_SDL
-  return SDL_GameControllerName(m_private->m_gamecontroller);
-#else  /* WITH_SDL */
-  return "";
-#endif /* WITH_SDL */
+  return m_name;
 }
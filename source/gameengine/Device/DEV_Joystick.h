@@ -55,6 +55,10 @@
  * I will make this class a singleton because there should be only one joystick
  * even if there are more than one scene using it and count how many scene are using it.
  * The underlying joystick should only be removed when the last scene is removed
+ *
+ * The SDL devices are polled by a dedicated thread, see DEV_Joystick::Poller. The instances
+ * only hold the snapshot of the device state taken at the last call to HandleEvents and
+ * queue the vibration commands to the polling thread.
  */
 
 class DEV_Joystick
@@ -63,8 +67,10 @@ class DEV_Joystick
   static DEV_Joystick *m_instance[JOYINDEX_MAX];
 
   class PrivateData;
+  class Poller;
+  struct State;
 #ifdef WITH_SDL
-  PrivateData *m_private;
+  static Poller *m_poller;
 #endif
   int m_joyindex;
 
@@ -73,6 +79,11 @@ class DEV_Joystick
    */
   int m_axis_array[JOYAXIS_MAX];
 
+  /**
+   * pressed state of the JOYBUT_MAX buttons
+   */
+  bool m_button_array[JOYBUT_MAX];
+
   /**
    * Precision or range of the axes
    */
@@ -92,24 +103,23 @@ class DEV_Joystick
   bool m_istrig_axis;
   bool m_istrig_button;
 
-#ifdef WITH_SDL
-  /**
-   * event callbacks
-   */
-  void OnAxisEvent(SDL_Event *sdl_event);
-  void OnButtonEvent(SDL_Event *sdl_event);
-  void OnNothing(SDL_Event *sdl_event);
+  std::string m_name;
+
+  /** Vibration state, the status is predicted until the polling thread processed all the
+   * commands queued by this instance. */
+  bool m_rumbleSupport;
+  bool m_rumbleStatus;
+  unsigned int m_rumbleCommands;
 
-#endif /* WITH_SDL */
   /**
-   * Open the joystick
+   * Copy the snapshot of the device state
    */
-  bool CreateJoystickDevice(void);
+  void SetState(const State &state);
 
   /**
-   * Close the joystick
+   * Queue a vibration command to the polling thread
    */
-  void DestroyJoystickDevice(void);
+  bool QueueRumble(bool play, float strengthLeft, float strengthRight, unsigned int duration);
 
   /**
    * returns m_axis_array
@@ -127,6 +137,11 @@ class DEV_Joystick
 
  public:
   static DEV_Joystick *GetInstance(short joyindex);
+  /** Take the last snapshot published by the polling thread, create and release the
+   * instances of the connected and disconnected devices.
+   * \param addrem Set to 1 for an added device and 2 for a removed device.
+   * \return True if a device was added or removed.
+   */
   static bool HandleEvents(short (&addrem)[JOYINDEX_MAX]);
   void ReleaseInstance(short joyindex);
   static void Init();
@@ -171,12 +186,13 @@ class DEV_Joystick
    * and duration. As the vibration strength and duration can be updated on-fly it is possible to
    * generate several types of vibration (sinus, periodic, custom, etc) using BGE python scripts
    * for more advanced uses.
+   * The commands are queued and played by the polling thread, which also stops the vibration
+   * at the end of its duration.
    */
   bool RumblePlay(float strengthLeft, float strengthRight, unsigned int duration);
   bool RumbleStop();
   bool GetRumbleStatus();
   bool GetRumbleSupport();
-  void ProcessRumbleStatus();
 
   /**
    * Test if the joystick is connected
@@ -29,68 +29,90 @@
  *  \ingroup device
  */
 
+#include <cstring>
+
+#include "BLI_string.h"
+
 #include "CM_Message.h"
 #include "DEV_Joystick.h"
 #include "DEV_JoystickPrivate.h"
 
 #ifdef WITH_SDL
-void DEV_Joystick::OnAxisEvent(SDL_Event *sdl_event)
+/// Interval between two polls of the devices in milliseconds.
+static const unsigned int pollInterval = 1;
+
+DEV_Joystick::Poller::Poller() : m_running(true)
 {
-  if (sdl_event->caxis.axis >= JOYAXIS_MAX)
-    return;
+  for (int i = 0; i < JOYINDEX_MAX; i++) {
+    m_devices[i].m_joyindex = i;
+    memset(&m_states[i], 0, sizeof(State));
+    m_published[i] = m_states[i];
+  }
 
-  m_axis_array[sdl_event->caxis.axis] = sdl_event->caxis.value;
-  m_istrig_axis = 1;
-}
+  /* When the window system uses SDL it pumps the events from its own thread,
+   * pumping them here would be unsafe and remove the window events. */
+  m_sharedEvents = (SDL_WasInit(SDL_INIT_VIDEO) != 0);
 
-/* See notes below in the event loop */
-void DEV_Joystick::OnButtonEvent(SDL_Event *sdl_event)
-{
-  m_istrig_button = 1;
+  m_thread = std::thread(&Poller::Run, this);
 }
 
-void DEV_Joystick::OnNothing(SDL_Event *sdl_event)
+DEV_Joystick::Poller::~Poller()
 {
-  m_istrig_axis = m_istrig_button = 0;
+  m_running.store(false, std::memory_order_release);
+  m_thread.join();
+
+  for (int i = 0; i < JOYINDEX_MAX; i++) {
+    m_devices[i].DestroyJoystickDevice();
+  }
 }
 
-bool DEV_Joystick::HandleEvents(short (&addrem)[JOYINDEX_MAX])
+void DEV_Joystick::Poller::Run()
 {
-  SDL_Event sdl_event;
-  bool remap = false;
+  while (m_running.load(std::memory_order_acquire)) {
+    if (!m_sharedEvents) {
+      /* Update the devices and detect the hotplugs, the
+       * events are queued and read in HandleEvents. */
+      SDL_GameControllerUpdate();
+    }
 
-  for (int i = 0; i < JOYINDEX_MAX; i++) {
-    if (DEV_Joystick::m_instance[i])
-      DEV_Joystick::m_instance[i]->OnNothing(&sdl_event);
-  }
+    HandleEvents();
+    ProcessRumble();
+    Publish();
 
-  while (SDL_PollEvent(&sdl_event)) {
-    /* Note! m_instance[instance]
-     * will segfault if over JOYINDEX_MAX, not too nice but what are the chances? */
+    SDL_Delay(pollInterval);
+  }
+}
 
-    /* Note!, with buttons, this wont care which button is pressed,
-     * only to set 'm_istrig_button', actual pressed buttons are detected by
-     * SDL_ControllerGetButton */
+void DEV_Joystick::Poller::HandleEvents()
+{
+  SDL_Event sdl_event;
 
-    /* Note!, if you manage to press and release a button within 1 logic tick
-     * it wont work as it should */
+  /* Note!, with buttons, this wont care which button is pressed,
+   * only to set 'm_trigButton', actual pressed buttons are read
+   * by SDL_GameControllerGetButton at each poll */
 
-    /* Note!, we need to use SDL_JOYDEVICE ADDED to find new controllers as
-     * SDL_CONTROLLERDEVICEADDED doesn't report about all devices connected at beginning.
-     * Additionally we capture all devices this
-     * way and we can inform properly (with ways to solve it) if the joystick it is not a game
-     * controller */
+  /* Note!, we need to use SDL_JOYDEVICE ADDED to find new controllers as
+   * SDL_CONTROLLERDEVICEADDED doesn't report about all devices connected at beginning.
+   * Additionally we capture all devices this
+   * way and we can inform properly (with ways to solve it) if the joystick it is not a game
+   * controller */
 
+  while (SDL_PeepEvents(
+             &sdl_event, 1, SDL_GETEVENT, SDL_JOYAXISMOTION, SDL_CONTROLLERDEVICEREMAPPED) > 0) {
     switch (sdl_event.type) {
-      case SDL_JOYDEVICEADDED:
-        if (sdl_event.jdevice.which < JOYINDEX_MAX) {
-          if (!DEV_Joystick::m_instance[sdl_event.jdevice.which]) {
-            DEV_Joystick::m_instance[sdl_event.jdevice.which] = new DEV_Joystick(
-                sdl_event.jdevice.which);
-            DEV_Joystick::m_instance[sdl_event.jdevice.which]->CreateJoystickDevice();
-            addrem[sdl_event.jdevice.which] = 1;
-            remap = true;
-            break;
+      case SDL_JOYDEVICEADDED: {
+        const int index = sdl_event.jdevice.which;
+        if (index < JOYINDEX_MAX) {
+          State &state = m_states[index];
+          if (!state.m_present) {
+            PrivateData &device = m_devices[index];
+            state.m_present = true;
+            state.m_connected = device.CreateJoystickDevice();
+            state.m_rumbleSupport = (device.m_haptic != nullptr);
+            state.m_rumbleStatus = false;
+            BLI_strncpy(state.m_name,
+                        state.m_connected ? device.GetName().c_str() : "",
+                        sizeof(state.m_name));
           }
           else {
             CM_Warning("conflicts with Joysticks trying to use the same index."
@@ -103,36 +125,35 @@ bool DEV_Joystick::HandleEvents(short (&addrem)[JOYINDEX_MAX])
               "additional ones.");
         }
         break;
+      }
       case SDL_CONTROLLERDEVICEREMOVED:
         for (int i = 0; i < JOYINDEX_MAX; i++) {
-          if (DEV_Joystick::m_instance[i]) {
-            if (sdl_event.cdevice.which == DEV_Joystick::m_instance[i]->m_private->m_instance_id) {
-              DEV_Joystick::m_instance[i]->ReleaseInstance(i);
-              addrem[i] = 2;
-              remap = true;
-              break;
-            }
+          if (m_states[i].m_connected && sdl_event.cdevice.which == m_devices[i].m_instance_id) {
+            m_devices[i].DestroyJoystickDevice();
+            const unsigned int rumbleCommands = m_states[i].m_rumbleCommands;
+            memset(&m_states[i], 0, sizeof(State));
+            m_states[i].m_rumbleCommands = rumbleCommands;
+            break;
           }
         }
         break;
       case SDL_CONTROLLERBUTTONDOWN:
       case SDL_CONTROLLERBUTTONUP:
         for (int i = 0; i < JOYINDEX_MAX; i++) {
-          if (DEV_Joystick::m_instance[i]) {
-            if (sdl_event.cdevice.which == DEV_Joystick::m_instance[i]->m_private->m_instance_id) {
-              DEV_Joystick::m_instance[i]->OnButtonEvent(&sdl_event);
-              break;
-            }
+          if (m_states[i].m_connected && sdl_event.cbutton.which == m_devices[i].m_instance_id) {
+            m_states[i].m_trigButton = true;
+            break;
           }
         }
         break;
       case SDL_CONTROLLERAXISMOTION:
         for (int i = 0; i < JOYINDEX_MAX; i++) {
-          if (DEV_Joystick::m_instance[i]) {
-            if (sdl_event.cdevice.which == DEV_Joystick::m_instance[i]->m_private->m_instance_id) {
-              DEV_Joystick::m_instance[i]->OnAxisEvent(&sdl_event);
-              break;
+          if (m_states[i].m_connected && sdl_event.caxis.which == m_devices[i].m_instance_id) {
+            if (sdl_event.caxis.axis < JOYAXIS_MAX) {
+              m_states[i].m_axes[sdl_event.caxis.axis] = sdl_event.caxis.value;
+              m_states[i].m_trigAxis = true;
             }
+            break;
           }
         }
         break;
@@ -141,6 +162,84 @@ bool DEV_Joystick::HandleEvents(short (&addrem)[JOYINDEX_MAX])
         break;
     }
   }
-  return remap;
+
+  if (!m_sharedEvents) {
+    // Nobody else reads the SDL events, drop them to not fill the queue.
+    SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+  }
+
+  for (int i = 0; i < JOYINDEX_MAX; i++) {
+    if (m_states[i].m_connected) {
+      for (int j = 0; j < JOYBUT_MAX; j++) {
+        m_states[i].m_buttons[j] = SDL_GameControllerGetButton(m_devices[i].m_gamecontroller,
+                                                               (SDL_GameControllerButton)j);
+      }
+    }
+  }
+}
+
+void DEV_Joystick::Poller::Publish()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  for (int i = 0; i < JOYINDEX_MAX; i++) {
+    // Keep the triggers not yet seen by the logic.
+    const bool trigAxis = m_published[i].m_trigAxis;
+    const bool trigButton = m_published[i].m_trigButton;
+    m_published[i] = m_states[i];
+    m_published[i].m_trigAxis |= trigAxis;
+    m_published[i].m_trigButton |= trigButton;
+
+    m_states[i].m_trigAxis = false;
+    m_states[i].m_trigButton = false;
+  }
 }
+
+void DEV_Joystick::Poller::GetStates(State (&states)[JOYINDEX_MAX])
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  for (int i = 0; i < JOYINDEX_MAX; i++) {
+    states[i] = m_published[i];
+    m_published[i].m_trigAxis = false;
+    m_published[i].m_trigButton = false;
+  }
+}
+#endif /* WITH_SDL */
+
+bool DEV_Joystick::HandleEvents(short (&addrem)[JOYINDEX_MAX])
+{
+#ifdef WITH_SDL
+  if (!m_poller) {
+    return false;
+  }
+
+  State states[JOYINDEX_MAX];
+  m_poller->GetStates(states);
+
+  bool remap = false;
+  for (int i = 0; i < JOYINDEX_MAX; i++) {
+    const State &state = states[i];
+    if (state.m_present && !m_instance[i]) {
+      m_instance[i] = new DEV_Joystick(i);
+      // Commands queued by a previous instance of this index are already counted.
+      m_instance[i]->m_rumbleCommands = state.m_rumbleCommands;
+      addrem[i] = 1;
+      remap = true;
+    }
+    else if (!state.m_present && m_instance[i]) {
+      m_instance[i]->ReleaseInstance(i);
+      addrem[i] = 2;
+      remap = true;
+    }
+
+    if (m_instance[i]) {
+      m_instance[i]->SetState(state);
+    }
+  }
+
+  return remap;
+#else  /* WITH_SDL */
+  return false;
 #endif /* WITH_SDL */
+}
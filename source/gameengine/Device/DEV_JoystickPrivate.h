@@ -28,14 +28,39 @@
 /** \file DEV_JoystickPrivate.h
  *  \ingroup device
  */
-
 #pragma once
 
 #include "DEV_JoystickDefines.h"
 
 #ifdef WITH_SDL
+#  include <atomic>
+#  include <mutex>
+#  include <thread>
+
+#  include "CM_RingBuffer.h"
+
+/// Snapshot of a device published by the polling thread.
+struct DEV_Joystick::State {
+  /// The device is plugged, an instance exists.
+  bool m_present;
+  /// The device is opened as a game controller.
+  bool m_connected;
+  int m_axes[JOYAXIS_MAX];
+  bool m_buttons[JOYBUT_MAX];
+  /// An event was received since the last snapshot taken by the logic.
+  bool m_trigAxis;
+  bool m_trigButton;
+  char m_name[128];
+  bool m_rumbleSupport;
+  bool m_rumbleStatus;
+  /// Number of vibration commands processed for this index.
+  unsigned int m_rumbleCommands;
+};
+
+/// Device opened by the polling thread, only used from this thread.
 class DEV_Joystick::PrivateData {
  public:
+  int m_joyindex;
   /*
    * The Game controller
    */
@@ -48,11 +73,67 @@ class DEV_Joystick::PrivateData {
   double m_hapticEndTime;
 
   PrivateData()
-      : m_gamecontroller(nullptr),
+      : m_joyindex(-1),
+        m_gamecontroller(nullptr),
+        m_instance_id(-1),
         m_haptic(nullptr),
+        m_hapticEffectId(-1),
         m_hapticEffectStatus(JOYHAPTIC_STOPPED),
         m_hapticEndTime(0.0)
   {
   }
+
+  bool CreateJoystickDevice();
+  void DestroyJoystickDevice();
+  const std::string GetName();
+
+  bool RumblePlay(float strengthLeft, float strengthRight, unsigned int duration);
+  bool RumbleStop();
+  void ProcessRumbleStatus();
+};
+
+/** Thread pumping the SDL joystick events and playing the vibrations, the device states are
+ * published to the logic through a double buffer: the thread updates its own copy and copies it
+ * to the published one under a lock, the logic swaps the published copy at each frame.
+ */
+class DEV_Joystick::Poller {
+ public:
+  /// Vibration command queued by the logic.
+  struct RumbleCommand {
+    short m_joyindex;
+    bool m_play;
+    float m_strengthLeft;
+    float m_strengthRight;
+    unsigned int m_duration;
+  };
+
+ private:
+  PrivateData m_devices[JOYINDEX_MAX];
+  /// States updated by the thread.
+  State m_states[JOYINDEX_MAX];
+  /// States published to the logic, protected by m_mutex.
+  State m_published[JOYINDEX_MAX];
+  std::mutex m_mutex;
+
+  CM_RingBuffer<RumbleCommand, 256> m_rumbleCommands;
+
+  /// The window system pumps the SDL events, only the joystick events are removed here.
+  bool m_sharedEvents;
+  std::atomic<bool> m_running;
+  std::thread m_thread;
+
+  void Run();
+  void HandleEvents();
+  void ProcessRumble();
+  void Publish();
+
+ public:
+  Poller();
+  ~Poller();
+
+  /// Copy the published states, reset the event triggers.
+  void GetStates(State (&states)[JOYINDEX_MAX]);
+  /// Queue a vibration command, called from the logic thread only.
+  bool QueueRumble(const RumbleCommand &command);
 };
 #endif  // WITH_SDL
@@ -31,59 +31,61 @@
 #include "DEV_JoystickPrivate.h"
 #include "PIL_time.h"  // Module to get real time in Game Engine
 
-bool DEV_Joystick::RumblePlay(float strengthLeft, float strengthRight, unsigned int duration)
-{
 #ifdef WITH_SDL
+bool DEV_Joystick::PrivateData::RumblePlay(float strengthLeft,
+                                           float strengthRight,
+                                           unsigned int duration)
+{
   unsigned int effects;
   bool run_by_effect = false;
   bool effects_issue = false;
 
-  if (m_private->m_haptic == nullptr) {
+  if (m_haptic == nullptr) {
     return false;
   }
 
   // Managing vibration logic
-  if (m_private->m_hapticEffectStatus == JOYHAPTIC_STOPPED) {
-    memset(&m_private->m_hapticeffect, 0, sizeof(SDL_HapticEffect));  // 0 is safe default
+  if (m_hapticEffectStatus == JOYHAPTIC_STOPPED) {
+    memset(&m_hapticeffect, 0, sizeof(SDL_HapticEffect));  // 0 is safe default
   }
-  else if (m_private->m_hapticEffectStatus == JOYHAPTIC_PLAYING_EFFECT) {
-    m_private->m_hapticEffectStatus = JOYHAPTIC_UPDATING_EFFECT;
+  else if (m_hapticEffectStatus == JOYHAPTIC_PLAYING_EFFECT) {
+    m_hapticEffectStatus = JOYHAPTIC_UPDATING_EFFECT;
   }
-  else if (m_private->m_hapticEffectStatus == JOYHAPTIC_PLAYING_RUMBLE_EFFECT) {
-    m_private->m_hapticEffectStatus = JOYHAPTIC_UPDATING_RUMBLE_EFFECT;
+  else if (m_hapticEffectStatus == JOYHAPTIC_PLAYING_RUMBLE_EFFECT) {
+    m_hapticEffectStatus = JOYHAPTIC_UPDATING_RUMBLE_EFFECT;
   }
 
   // Checking supported effects
-  effects = SDL_HapticQuery(m_private->m_haptic);
+  effects = SDL_HapticQuery(m_haptic);
 
   // LeftRight is the most supported effect by XInput game controllers
   if ((effects & SDL_HAPTIC_LEFTRIGHT) &&
-      m_private->m_hapticEffectStatus != JOYHAPTIC_UPDATING_RUMBLE_EFFECT) {
-    if (m_private->m_hapticEffectStatus != JOYHAPTIC_UPDATING_EFFECT) {
-      m_private->m_hapticeffect.type = SDL_HAPTIC_LEFTRIGHT;
+      m_hapticEffectStatus != JOYHAPTIC_UPDATING_RUMBLE_EFFECT) {
+    if (m_hapticEffectStatus != JOYHAPTIC_UPDATING_EFFECT) {
+      m_hapticeffect.type = SDL_HAPTIC_LEFTRIGHT;
     }
 
-    m_private->m_hapticeffect.leftright.length = duration;
-    m_private->m_hapticeffect.leftright.large_magnitude = (unsigned int)(strengthLeft * 0x7FFF);
-    m_private->m_hapticeffect.leftright.small_magnitude = (unsigned int)(strengthRight * 0x7FFF);
+    m_hapticeffect.leftright.length = duration;
+    m_hapticeffect.leftright.large_magnitude = (unsigned int)(strengthLeft * 0x7FFF);
+    m_hapticeffect.leftright.small_magnitude = (unsigned int)(strengthRight * 0x7FFF);
     run_by_effect = true;
   }
   // Some Game Controllers only supports large/small magnitude motors using a custom effect
   else if ((effects & SDL_HAPTIC_CUSTOM) &&
-           m_private->m_hapticEffectStatus != JOYHAPTIC_UPDATING_RUMBLE_EFFECT) {
+           m_hapticEffectStatus != JOYHAPTIC_UPDATING_RUMBLE_EFFECT) {
 
     Uint16 data[2];  // data = channels * samples
     data[0] = (Uint16)(strengthLeft * 0x7FFF);
     data[1] = (Uint16)(strengthRight * 0x7FFF);
 
-    if (m_private->m_hapticEffectStatus != JOYHAPTIC_UPDATING_EFFECT) {
-      m_private->m_hapticeffect.type = SDL_HAPTIC_CUSTOM;
+    if (m_hapticEffectStatus != JOYHAPTIC_UPDATING_EFFECT) {
+      m_hapticeffect.type = SDL_HAPTIC_CUSTOM;
     }
-    m_private->m_hapticeffect.custom.length = duration;
-    m_private->m_hapticeffect.custom.channels = 2;
-    m_private->m_hapticeffect.custom.period = 1;
-    m_private->m_hapticeffect.custom.samples = 1;
-    m_private->m_hapticeffect.custom.data = data;
+    m_hapticeffect.custom.length = duration;
+    m_hapticeffect.custom.channels = 2;
+    m_hapticeffect.custom.period = 1;
+    m_hapticeffect.custom.samples = 1;
+    m_hapticeffect.custom.data = data;
 
     run_by_effect = true;
   }
@@ -91,28 +93,28 @@ bool DEV_Joystick::RumblePlay(float strengthLeft, float strengthRight, unsigned
   if (run_by_effect) {
     bool new_effect = true;
 
-    if (m_private->m_hapticEffectStatus == JOYHAPTIC_UPDATING_EFFECT) {
+    if (m_hapticEffectStatus == JOYHAPTIC_UPDATING_EFFECT) {
       if (SDL_HapticUpdateEffect(
-              m_private->m_haptic, m_private->m_hapticEffectId, &m_private->m_hapticeffect) == 0) {
-        m_private->m_hapticEffectStatus = JOYHAPTIC_PLAYING_EFFECT;
+              m_haptic, m_hapticEffectId, &m_hapticeffect) == 0) {
+        m_hapticEffectStatus = JOYHAPTIC_PLAYING_EFFECT;
         new_effect = false;
       }
       else {
-        SDL_HapticDestroyEffect(m_private->m_haptic, m_private->m_hapticEffectId);
-        m_private->m_hapticEffectId = -1;
+        SDL_HapticDestroyEffect(m_haptic, m_hapticEffectId);
+        m_hapticEffectId = -1;
       }
     }
 
     if (new_effect) {
       // Upload the effect
-      m_private->m_hapticEffectId = SDL_HapticNewEffect(m_private->m_haptic,
-                                                        &m_private->m_hapticeffect);
+      m_hapticEffectId = SDL_HapticNewEffect(m_haptic,
+                                                        &m_hapticeffect);
     }
 
     // Run the effect
-    if (m_private->m_hapticEffectId >= 0 &&
-        SDL_HapticRunEffect(m_private->m_haptic, m_private->m_hapticEffectId, 1) != -1) {
-      m_private->m_hapticEffectStatus = JOYHAPTIC_PLAYING_EFFECT;
+    if (m_hapticEffectId >= 0 &&
+        SDL_HapticRunEffect(m_haptic, m_hapticEffectId, 1) != -1) {
+      m_hapticEffectStatus = JOYHAPTIC_PLAYING_EFFECT;
     }
     else {
       effects_issue = true;
@@ -121,103 +123,157 @@ bool DEV_Joystick::RumblePlay(float strengthLeft, float strengthRight, unsigned
 
   // Initialize simplest rumble effect for both motors if more complex effects are not supported
   // Most controllers can use SINE effect, but XInput only has LEFTRIGHT.
-  if (effects_issue || m_private->m_hapticEffectStatus == JOYHAPTIC_UPDATING_RUMBLE_EFFECT) {
+  if (effects_issue || m_hapticEffectStatus == JOYHAPTIC_UPDATING_RUMBLE_EFFECT) {
     bool new_effect = true;
 
-    if (m_private->m_hapticEffectStatus != JOYHAPTIC_UPDATING_RUMBLE_EFFECT) {
-      m_private->m_hapticeffect.type = SDL_HAPTIC_SINE;
+    if (m_hapticEffectStatus != JOYHAPTIC_UPDATING_RUMBLE_EFFECT) {
+      m_hapticeffect.type = SDL_HAPTIC_SINE;
     }
 
-    m_private->m_hapticeffect.periodic.period = 1000;
-    m_private->m_hapticeffect.periodic.magnitude = (unsigned int)(strengthLeft * 0x7FFF);
-    m_private->m_hapticeffect.periodic.length = duration;
-    m_private->m_hapticeffect.periodic.attack_length = 0;
-    m_private->m_hapticeffect.periodic.fade_length = 0;
+    m_hapticeffect.periodic.period = 1000;
+    m_hapticeffect.periodic.magnitude = (unsigned int)(strengthLeft * 0x7FFF);
+    m_hapticeffect.periodic.length = duration;
+    m_hapticeffect.periodic.attack_length = 0;
+    m_hapticeffect.periodic.fade_length = 0;
 
-    if (m_private->m_hapticEffectStatus == JOYHAPTIC_UPDATING_RUMBLE_EFFECT) {
+    if (m_hapticEffectStatus == JOYHAPTIC_UPDATING_RUMBLE_EFFECT) {
       if (SDL_HapticUpdateEffect(
-              m_private->m_haptic, m_private->m_hapticEffectId, &m_private->m_hapticeffect) == 0) {
-        m_private->m_hapticEffectStatus = JOYHAPTIC_PLAYING_RUMBLE_EFFECT;
+              m_haptic, m_hapticEffectId, &m_hapticeffect) == 0) {
+        m_hapticEffectStatus = JOYHAPTIC_PLAYING_RUMBLE_EFFECT;
         new_effect = false;
       }
       else {
-        SDL_HapticDestroyEffect(m_private->m_haptic, m_private->m_hapticEffectId);
-        m_private->m_hapticEffectId = -1;
+        SDL_HapticDestroyEffect(m_haptic, m_hapticEffectId);
+        m_hapticEffectId = -1;
         CM_Error("Vibration can not be updated. Trying other approach.");
       }
     }
 
     if (new_effect) {
       // Upload the effect
-      m_private->m_hapticEffectId = SDL_HapticNewEffect(m_private->m_haptic,
-                                                        &m_private->m_hapticeffect);
+      m_hapticEffectId = SDL_HapticNewEffect(m_haptic,
+                                                        &m_hapticeffect);
     }
 
     // Run the effect
-    if (m_private->m_hapticEffectId >= 0 &&
-        SDL_HapticRunEffect(m_private->m_haptic, m_private->m_hapticEffectId, 1) != -1) {
-      m_private->m_hapticEffectStatus = JOYHAPTIC_PLAYING_RUMBLE_EFFECT;
+    if (m_hapticEffectId >= 0 &&
+        SDL_HapticRunEffect(m_haptic, m_hapticEffectId, 1) != -1) {
+      m_hapticEffectStatus = JOYHAPTIC_PLAYING_RUMBLE_EFFECT;
     }
     else {
-      SDL_HapticDestroyEffect(m_private->m_haptic, m_private->m_hapticEffectId);
-      m_private->m_hapticEffectId = -1;
-      m_private->m_hapticEffectStatus = JOYHAPTIC_STOPPED;
+      SDL_HapticDestroyEffect(m_haptic, m_hapticEffectId);
+      m_hapticEffectId = -1;
+      m_hapticEffectStatus = JOYHAPTIC_STOPPED;
       CM_Error("Vibration not reproduced. Rumble can not initialized/played");
-      m_private->m_hapticEndTime = 0.0;
+      m_hapticEndTime = 0.0;
       return false;
     }
   }
-  m_private->m_hapticEndTime = PIL_check_seconds_timer() * 1000.0 + (double)duration;
+  m_hapticEndTime = PIL_check_seconds_timer() * 1000.0 + (double)duration;
   return true;
-#endif  // WITH_SDL
-  return false;
 }
 
-bool DEV_Joystick::RumbleStop()
+bool DEV_Joystick::PrivateData::RumbleStop()
 {
-#ifdef WITH_SDL
-  if (m_private->m_haptic == nullptr) {
+  if (m_haptic == nullptr) {
     return false;
   }
 
-  if (m_private->m_hapticEffectStatus != JOYHAPTIC_STOPPED) {
-    m_private->m_hapticEffectStatus = JOYHAPTIC_STOPPED;
+  if (m_hapticEffectStatus != JOYHAPTIC_STOPPED) {
+    m_hapticEffectStatus = JOYHAPTIC_STOPPED;
   }
-  SDL_HapticDestroyEffect(m_private->m_haptic, m_private->m_hapticEffectId);
-  m_private->m_hapticEndTime = 0.0;
+  SDL_HapticDestroyEffect(m_haptic, m_hapticEffectId);
+  m_hapticEffectId = -1;
+  m_hapticEndTime = 0.0;
   return true;
-#endif
-  return false;
 }
 
-bool DEV_Joystick::GetRumbleStatus()
+// We can not trust in SDL_HapticGetEffectStatus function as it is not supported
+// in the most used game controllers. Then we work around it using own time management.
+void DEV_Joystick::PrivateData::ProcessRumbleStatus()
 {
-#ifdef WITH_SDL
-  return (m_private->m_hapticEffectStatus != JOYHAPTIC_STOPPED);
-#endif
-  return false;
+  if (m_haptic == nullptr || m_hapticEffectStatus == JOYHAPTIC_STOPPED) {
+    return;
+  }
+
+  if ((PIL_check_seconds_timer() * 1000.0) >= m_hapticEndTime) {
+    RumbleStop();
+  }
 }
 
-bool DEV_Joystick::GetRumbleSupport()
+void DEV_Joystick::Poller::ProcessRumble()
 {
-#ifdef WITH_SDL
-  return (m_private->m_haptic);
-#endif
-  return false;
+  RumbleCommand command;
+  while (m_rumbleCommands.Pop(command)) {
+    PrivateData &device = m_devices[command.m_joyindex];
+    State &state = m_states[command.m_joyindex];
+    // The device could be removed since the command was queued.
+    if (state.m_connected) {
+      if (command.m_play) {
+        device.RumblePlay(command.m_strengthLeft, command.m_strengthRight, command.m_duration);
+      }
+      else {
+        device.RumbleStop();
+      }
+    }
+    ++state.m_rumbleCommands;
+  }
+
+  for (int i = 0; i < JOYINDEX_MAX; i++) {
+    if (m_states[i].m_connected) {
+      m_devices[i].ProcessRumbleStatus();
+      m_states[i].m_rumbleStatus = (m_devices[i].m_hapticEffectStatus != JOYHAPTIC_STOPPED);
+    }
+  }
 }
 
-// We can not trust in SDL_HapticGetEffectStatus function as it is not supported
-// in the most used game controllers. Then we work around it using own time management.
-void DEV_Joystick::ProcessRumbleStatus()
+bool DEV_Joystick::Poller::QueueRumble(const RumbleCommand &command)
+{
+  return m_rumbleCommands.Push(command);
+}
+#endif  // WITH_SDL
+
+bool DEV_Joystick::QueueRumble(bool play,
+                               float strengthLeft,
+                               float strengthRight,
+                               unsigned int duration)
 {
 #ifdef WITH_SDL
-  if (m_private->m_haptic == nullptr) {
-    return;
+  if (!m_rumbleSupport || !m_poller) {
+    return false;
   }
 
-  if ((PIL_check_seconds_timer() * 1000.0) >= m_private->m_hapticEndTime) {
-    RumbleStop();
+  const Poller::RumbleCommand command = {
+      (short)m_joyindex, play, strengthLeft, strengthRight, duration};
+  if (!m_poller->QueueRumble(command)) {
+    CM_Warning("too many vibration commands queued for the Game Controller with index "
+               << m_joyindex);
+    return false;
   }
-#endif
-  return;
+
+  ++m_rumbleCommands;
+  m_rumbleStatus = play;
+  return true;
+#endif  // WITH_SDL
+  return false;
+}
+
+bool DEV_Joystick::RumblePlay(float strengthLeft, float strengthRight, unsigned int duration)
+{
+  return QueueRumble(true, strengthLeft, strengthRight, duration);
+}
+
+bool DEV_Joystick::RumbleStop()
+{
+  return QueueRumble(false, 0.0f, 0.0f, 0);
+}
+
+bool DEV_Joystick::GetRumbleStatus()
+{
+  return m_rumbleStatus;
+}
+
+bool DEV_Joystick::GetRumbleSupport()
+{
+  return m_rumbleSupport;
 }
@@ -18,6 +18,8 @@
 
 #pragma once
 
+#include <unordered_map>
+
 #include "EXP_Value.h"
 
 class EXP_BaseListValue : public EXP_PropValue {
@@ -32,6 +34,31 @@ class EXP_BaseListValue : public EXP_PropValue {
   VectorType m_pValueArray;
   bool m_bReleaseContents;
 
+  /// Use m_nameIndex in FindValue and SearchValue.
+  bool m_useNameIndex;
+  /// m_nameIndex matches the items, it is rebuilt by FindValue otherwise.
+  mutable bool m_nameIndexValid;
+  /// Items of each name in list order.
+  mutable std::unordered_map<std::string, std::vector<EXP_Value *>> m_nameIndex;
+
+  /// Use m_itemIndex in SearchValue and RemoveValue.
+  bool m_useItemIndex;
+  /// RemoveValue keeps the order of the items, else the last item takes the removed slot.
+  bool m_stableOrder;
+  /// m_itemIndex matches the items, it is rebuilt by the next lookup otherwise.
+  mutable bool m_itemIndexValid;
+  /// Removals in stable order since the last rebuild of m_itemIndex.
+  mutable unsigned int m_itemIndexShifts;
+  /** Slot of each item. In stable order the items after a removed one keep their slot, their
+   * actual slot is at most m_itemIndexShifts before.
+   */
+  mutable std::unordered_map<EXP_Value *, unsigned int> m_itemIndex;
+
+  void RebuildNameIndex() const;
+  void RebuildItemIndex() const;
+  /// Return the slot of an item with m_itemIndex, -1 if the item is not in the list.
+  int FindItemSlot(EXP_Value *val) const;
+
   void SetValue(int i, EXP_Value *val);
   EXP_Value *GetValue(int i);
   EXP_Value *FindValue(const std::string &name) const;
@@ -50,6 +77,20 @@ class EXP_BaseListValue : public EXP_PropValue {
   virtual std::string GetText();
 
   void SetReleaseOnDestruct(bool bReleaseContents);
+  /** Index the items by name to make FindValue constant time, the index is updated by Add and
+   * RemoveValue and rebuilt after any other modification. Only for lists holding a reference
+   * on their items.
+   */
+  void SetUseNameIndex(bool use);
+  /// Notify that the name of an item changed.
+  void InvalidateNameIndex();
+  /** Index the slot of the items to make SearchValue and RemoveValue constant time instead of
+   * searching the list. Only for lists holding each item once.
+   * \param stableOrder RemoveValue shifts the next items to keep their order, e.g for the
+   * lists visible to python, the removal then costs the shift of the items. Otherwise the last
+   * item is moved to the slot of the removed item.
+   */
+  void SetUseItemIndex(bool use, bool stableOrder);
 
   void Remove(int i);
   void Resize(int num);
@@ -20,7 +20,10 @@
 
 #include "EXP_Value.h"
 
-class EXP_Expression : public CM_RefCount<EXP_Expression> {
+class EXP_ExpressionProgram;
+
+/// The expression trees are owned by a logic brick, their counter doesn't need to be atomic.
+class EXP_Expression : public CM_RefCount<EXP_Expression, false> {
  public:
   enum {
     COPERATOR1EXPRESSIONID = 1,
@@ -39,4 +42,6 @@ class EXP_Expression : public CM_RefCount<EXP_Expression> {
 
   virtual EXP_Value *Calculate() = 0;
   virtual unsigned char GetExpressionID() = 0;
+  /// Append the instructions of the expression to a program, return false if not supported.
+  virtual bool Compile(EXP_ExpressionProgram &program);
 };
@@ -0,0 +1,136 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file EXP_ExpressionProgram.h
+ *  \ingroup expressions
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "EXP_IntValue.h"
+
+class EXP_Expression;
+
+/** Flat form of a parsed expression evaluated without allocations.
+ * The instructions are in postfix order and run on a value stack sized at the compilation,
+ * the identifiers are resolved once to the sources of a context. Only the booleans, integers
+ * and floats are supported, the operations the tree evaluates to an error value are reported
+ * as unsupported so the caller can evaluate the tree instead and get its exact value.
+ */
+class EXP_ExpressionProgram {
+ public:
+  enum ValueType { TYPE_EMPTY, TYPE_BOOL, TYPE_INT, TYPE_FLOAT };
+
+  struct Value {
+    ValueType m_type;
+    union {
+      bool m_bool;
+      cInt m_int;
+      float m_float;
+    };
+
+    /// Return the value as EXP_Value::GetNumber.
+    double GetNumber() const;
+  };
+
+  enum Status {
+    STATUS_SUCCESS,
+    /// The evaluation failed, see GetError.
+    STATUS_ERROR,
+    /// A source or an operation isn't supported, the tree must be evaluated.
+    STATUS_UNSUPPORTED
+  };
+
+  /// Resolve and read the identifiers of a program.
+  class Context {
+   public:
+    virtual ~Context() = default;
+
+    /// Return the index of the source of an identifier, -1 if it can't be compiled.
+    virtual int ResolveIdentifier(const std::string &name) = 0;
+    /// Read the value of a source, return false if its value isn't supported.
+    virtual bool GetSource(unsigned int index, Value &value) = 0;
+  };
+
+ private:
+  enum Opcode {
+    OPCODE_CONSTANT,
+    OPCODE_SOURCE,
+    OPCODE_UNARY,
+    OPCODE_BINARY,
+    /// Pop a boolean and jump if false.
+    OPCODE_BRANCH_FALSE,
+    OPCODE_JUMP
+  };
+
+  struct Instruction {
+    Opcode m_opcode;
+    VALUE_OPERATOR m_operator;
+    /// Source index or jump target.
+    unsigned int m_operand;
+    Value m_value;
+  };
+
+  Context *m_context;
+  std::vector<Instruction> m_instructions;
+  std::vector<Value> m_stack;
+  /// Stack depth at the end of the instructions compiled so far.
+  unsigned int m_depth;
+  const char *m_error;
+
+  void AddInstruction(Opcode opcode, VALUE_OPERATOR op, unsigned int operand, int depth);
+  Status Unary(VALUE_OPERATOR op, Value &value);
+  Status Binary(VALUE_OPERATOR op, const Value &lhs, const Value &rhs, Value &result);
+
+ public:
+  EXP_ExpressionProgram();
+
+  /** Compile an expression.
+   * \return False if the expression uses an unsupported value or identifier, the program
+   * is then empty.
+   */
+  bool Compile(EXP_Expression *expr, Context *context);
+  void Clear();
+  bool IsValid() const;
+
+  /// Evaluate the program, the result is undefined if the status isn't a success.
+  Status Evaluate(Value &result);
+  const char *GetError() const;
+
+  /// Functions used by the expressions to compile themselves.
+  bool AddConstant(EXP_Value *value);
+  bool AddIdentifier(const std::string &name);
+  void AddUnary(VALUE_OPERATOR op);
+  void AddBinary(VALUE_OPERATOR op);
+  /** Add a jump to set later with SetBranchTarget.
+   * An unconditional jump leaves its value to the target, it is not counted in the depth
+   * of the following instructions.
+   * \param conditional Jump if the top of the stack is false.
+   * \return The index of the jump.
+   */
+  unsigned int AddBranch(bool conditional);
+  /// Make a jump go to the next compiled instruction.
+  void SetBranchTarget(unsigned int branch);
+};
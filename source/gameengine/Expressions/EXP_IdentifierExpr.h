@@ -43,5 +43,6 @@ class EXP_IdentifierExpr : public EXP_Expression {
   virtual ~EXP_IdentifierExpr();
 
   virtual EXP_Value *Calculate();
+  virtual bool Compile(EXP_ExpressionProgram &program);
   virtual unsigned char GetExpressionID();
 };
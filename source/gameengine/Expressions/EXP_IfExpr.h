@@ -33,4 +33,5 @@ class EXP_IfExpr : public EXP_Expression {
 
   virtual unsigned char GetExpressionID();
   virtual EXP_Value *Calculate();
+  virtual bool Compile(EXP_ExpressionProgram &program);
 };
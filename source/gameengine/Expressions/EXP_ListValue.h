@@ -70,6 +70,8 @@ template<class ItemType> class EXP_ListValue : public EXP_BaseListValue {
     replica->ProcessReplica();
 
     replica->m_bReleaseContents = true;  // For copy, complete array is copied for now...
+    replica->m_nameIndexValid = false;
+    replica->m_itemIndexValid = false;
     // Copy all values.
     const int numelements = m_pValueArray.size();
     replica->m_pValueArray.resize(numelements);
@@ -101,6 +103,28 @@ template<class ItemType> class EXP_ListValue : public EXP_BaseListValue {
     return nullptr;
   }
 
+  /** Remove in a single pass all the items for which function returns true.
+   * The removed items are not released, their reference is transfered to removed.
+   */
+  void RemoveIf(std::function<bool(EXP_Value *)> function, std::vector<EXP_Value *> &removed)
+  {
+    VectorTypeIterator dest = m_pValueArray.begin();
+    for (EXP_Value *val : m_pValueArray) {
+      if (function(val)) {
+        removed.push_back(val);
+      }
+      else {
+        *dest++ = val;
+      }
+    }
+
+    if (dest != m_pValueArray.end()) {
+      m_pValueArray.erase(dest, m_pValueArray.end());
+      m_nameIndexValid = false;
+      m_itemIndexValid = false;
+    }
+  }
+
   void MergeList(EXP_ListValue<ItemType> *otherlist)
   {
     const unsigned int numelements = GetCount();
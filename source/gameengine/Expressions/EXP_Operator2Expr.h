@@ -29,6 +29,7 @@ class EXP_Operator2Expr : public EXP_Expression {
 
   virtual unsigned char GetExpressionID();
   virtual EXP_Value *Calculate();
+  virtual bool Compile(EXP_ExpressionProgram &program);
 
  protected:
   EXP_Expression *m_rhs;
@@ -0,0 +1,57 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file EXP_PropertyHandle.h
+ *  \ingroup expressions
+ */
+
+#pragma once
+
+#include <string>
+
+class EXP_Value;
+
+/** Property name resolved once for an owner.
+ * The property is looked up again only when the owner changes or when a property of
+ * the owner was added, replaced or removed, see EXP_Value::GetPropertiesVersion.
+ */
+class EXP_PropertyHandle {
+ private:
+  std::string m_name;
+  EXP_Value *m_owner;
+  EXP_Value *m_property;
+  unsigned int m_propertiesVersion;
+
+ public:
+  EXP_PropertyHandle(const std::string &name);
+  /// A copy is resolved again at its first use, the copied owner could be freed.
+  EXP_PropertyHandle(const EXP_PropertyHandle &other);
+  EXP_PropertyHandle &operator=(const EXP_PropertyHandle &other);
+
+  const std::string &GetName() const;
+  void SetName(const std::string &name);
+
+  /// Return the property of the owner, nullptr if the owner doesn't have this property.
+  EXP_Value *Get(EXP_Value *owner);
+  /// Forget the resolved property, e.g. when the name was modified in place.
+  void Invalidate();
+};
@@ -22,8 +22,9 @@
 #  pragma warning(disable : 4786)
 #endif
 
-#include <map>     // Array functionality for the property list.
-#include <string>  // std::string class.
+#include <map>
+#include <string>         // std::string class.
+#include <unordered_map>  // Hash map for the property list.
 #include <vector>
 
 #include "CM_RefCount.h"
@@ -163,12 +164,22 @@ class EXP_Value : public EXP_PyObjectPlus, public CM_RefCount<EXP_Value> {
 
   virtual bool IsError() const;
 
+  /// Counter incremented at each change of the value, see SetValue.
+  unsigned int GetValueVersion() const;
+  /// Counter incremented at each property added, replaced or removed.
+  unsigned int GetPropertiesVersion() const;
+
  protected:
   virtual void DestructFromPython();
 
+  /// Notify the readers comparing versions that the value was modified in place.
+  void TagValueChanged();
+
  private:
-  /// Properties for user/game etc.
-  std::map<std::string, EXP_Value *> m_properties;
+  /// Properties for user/game etc, the names are sorted when listed.
+  std::unordered_map<std::string, EXP_Value *> m_properties;
+  unsigned int m_valueVersion;
+  unsigned int m_propertiesVersion;
 };
 
 /** EXP_PropValue is a EXP_Value derived class, that implements the identification (String name)
@@ -17,11 +17,19 @@
  *
  */
 
+#include <cmath>
 #include <regex>
 
 #include "EXP_ListValue.h"
 
-EXP_BaseListValue::EXP_BaseListValue() : m_bReleaseContents(true)
+EXP_BaseListValue::EXP_BaseListValue()
+    : m_bReleaseContents(true),
+      m_useNameIndex(false),
+      m_nameIndexValid(false),
+      m_useItemIndex(false),
+      m_stableOrder(true),
+      m_itemIndexValid(false),
+      m_itemIndexShifts(0)
 {
 }
 
@@ -37,6 +45,8 @@ EXP_BaseListValue::~EXP_BaseListValue()
 void EXP_BaseListValue::SetValue(int i, EXP_Value *val)
 {
   m_pValueArray[i] = val;
+  m_nameIndexValid = false;
+  m_itemIndexValid = false;
 }
 
 EXP_Value *EXP_BaseListValue::GetValue(int i)
@@ -44,8 +54,65 @@ EXP_Value *EXP_BaseListValue::GetValue(int i)
   return m_pValueArray[i];
 }
 
+void EXP_BaseListValue::RebuildNameIndex() const
+{
+  m_nameIndex.clear();
+  for (EXP_Value *item : m_pValueArray) {
+    m_nameIndex[item->GetName()].push_back(item);
+  }
+  m_nameIndexValid = true;
+}
+
+void EXP_BaseListValue::RebuildItemIndex() const
+{
+  m_itemIndex.clear();
+  m_itemIndex.reserve(m_pValueArray.size());
+  for (unsigned int i = 0, size = m_pValueArray.size(); i < size; ++i) {
+    m_itemIndex[m_pValueArray[i]] = i;
+  }
+  m_itemIndexShifts = 0;
+  m_itemIndexValid = true;
+}
+
+int EXP_BaseListValue::FindItemSlot(EXP_Value *val) const
+{
+  if (!m_itemIndexValid) {
+    RebuildItemIndex();
+  }
+
+  const std::unordered_map<EXP_Value *, unsigned int>::iterator it = m_itemIndex.find(val);
+  if (it == m_itemIndex.end()) {
+    return -1;
+  }
+
+  // The item was shifted back by the stable removals of the items before it.
+  int slot = std::min<int>(it->second, m_pValueArray.size() - 1);
+  const int lastSlot = std::max<int>(slot - m_itemIndexShifts, 0);
+  while (slot >= lastSlot && m_pValueArray[slot] != val) {
+    --slot;
+  }
+  if (slot < lastSlot) {
+    // The list was modified without invalidating the index.
+    RebuildItemIndex();
+    return FindItemSlot(val);
+  }
+
+  it->second = slot;
+  return slot;
+}
+
 EXP_Value *EXP_BaseListValue::FindValue(const std::string &name) const
 {
+  if (m_useNameIndex) {
+    if (!m_nameIndexValid) {
+      RebuildNameIndex();
+    }
+
+    const std::unordered_map<std::string, std::vector<EXP_Value *>>::const_iterator it =
+        m_nameIndex.find(name);
+    return (it != m_nameIndex.end()) ? it->second.front() : NULL;
+  }
+
   const VectorTypeConstIterator it = std::find_if(
       m_pValueArray.begin(), m_pValueArray.end(), [&name](EXP_Value *item) {
         return item->GetName() == name;
@@ -59,31 +126,104 @@ EXP_Value *EXP_BaseListValue::FindValue(const std::string &name) const
 
 bool EXP_BaseListValue::SearchValue(EXP_Value *val) const
 {
+  if (m_useItemIndex) {
+    return (FindItemSlot(val) != -1);
+  }
+
+  // Only the items with the same name can match.
+  if (m_useNameIndex) {
+    if (!m_nameIndexValid) {
+      RebuildNameIndex();
+    }
+
+    const std::unordered_map<std::string, std::vector<EXP_Value *>>::const_iterator it =
+        m_nameIndex.find(val->GetName());
+    return (it != m_nameIndex.end() &&
+            std::find(it->second.begin(), it->second.end(), val) != it->second.end());
+  }
+
   return (std::find(m_pValueArray.begin(), m_pValueArray.end(), val) != m_pValueArray.end());
 }
 
 void EXP_BaseListValue::Add(EXP_Value *value)
 {
   m_pValueArray.push_back(value);
+
+  if (m_nameIndexValid) {
+    m_nameIndex[value->GetName()].push_back(value);
+  }
+  if (m_itemIndexValid) {
+    m_itemIndex[value] = m_pValueArray.size() - 1;
+  }
 }
 
 void EXP_BaseListValue::Insert(unsigned int i, EXP_Value *value)
 {
   m_pValueArray.insert(m_pValueArray.begin() + i, value);
+  m_nameIndexValid = false;
+  m_itemIndexValid = false;
 }
 
 bool EXP_BaseListValue::RemoveValue(EXP_Value *val)
 {
   bool result = false;
-  for (VectorTypeIterator it = m_pValueArray.begin(); it != m_pValueArray.end();) {
-    if (*it == val) {
-      it = m_pValueArray.erase(it);
+  if (m_useItemIndex) {
+    const int slot = FindItemSlot(val);
+    if (slot != -1) {
+      m_itemIndex.erase(val);
+      if (m_stableOrder) {
+        m_pValueArray.erase(m_pValueArray.begin() + slot);
+        /* Bound the search of the shifted items, the index is rebuilt at the next lookup. The
+         * bound balances the search of the shifts with the rebuild of all the items. */
+        const unsigned int maxShifts = std::max(
+            64u, (unsigned int)(4.0f * sqrtf((float)m_pValueArray.size())));
+        if (++m_itemIndexShifts > maxShifts) {
+          m_itemIndexValid = false;
+        }
+      }
+      else {
+        EXP_Value *last = m_pValueArray.back();
+        m_pValueArray[slot] = last;
+        m_pValueArray.pop_back();
+        if (last != val) {
+          m_itemIndex[last] = slot;
+        }
+      }
       result = true;
     }
-    else {
-      ++it;
+  }
+  else {
+    for (VectorTypeIterator it = m_pValueArray.begin(); it != m_pValueArray.end();) {
+      if (*it == val) {
+        it = m_pValueArray.erase(it);
+        result = true;
+      }
+      else {
+        ++it;
+      }
+    }
+  }
+
+  if (result && m_nameIndexValid) {
+    bool indexed = false;
+    std::unordered_map<std::string, std::vector<EXP_Value *>>::iterator it = m_nameIndex.find(
+        val->GetName());
+    if (it != m_nameIndex.end()) {
+      std::vector<EXP_Value *> &items = it->second;
+      const VectorTypeIterator end = std::remove(items.begin(), items.end(), val);
+      indexed = (end != items.end());
+      items.erase(end, items.end());
+      if (items.empty()) {
+        m_nameIndex.erase(it);
+      }
+    }
+
+    // The item was renamed without invalidating the index.
+    if (!indexed) {
+      m_nameIndexValid = false;
     }
   }
+
   return result;
 }
 
@@ -127,14 +267,38 @@ void EXP_BaseListValue::SetReleaseOnDestruct(bool bReleaseContents)
   m_bReleaseContents = bReleaseContents;
 }
 
+void EXP_BaseListValue::SetUseNameIndex(bool use)
+{
+  m_useNameIndex = use;
+  m_nameIndexValid = false;
+  m_nameIndex.clear();
+}
+
+void EXP_BaseListValue::InvalidateNameIndex()
+{
+  m_nameIndexValid = false;
+}
+
+void EXP_BaseListValue::SetUseItemIndex(bool use, bool stableOrder)
+{
+  m_useItemIndex = use;
+  m_stableOrder = stableOrder;
+  m_itemIndexValid = false;
+  m_itemIndex.clear();
+}
+
 void EXP_BaseListValue::Remove(int i)
 {
   m_pValueArray.erase(m_pValueArray.begin() + i);
+  m_nameIndexValid = false;
+  m_itemIndexValid = false;
 }
 
 void EXP_BaseListValue::Resize(int num)
 {
   m_pValueArray.resize(num);
+  m_nameIndexValid = false;
+  m_itemIndexValid = false;
 }
 
 void EXP_BaseListValue::ReleaseAndRemoveAll()
@@ -143,6 +307,8 @@ void EXP_BaseListValue::ReleaseAndRemoveAll()
     item->Release();
   }
   m_pValueArray.clear();
+  m_nameIndexValid = false;
+  m_itemIndexValid = false;
 }
 
 int EXP_BaseListValue::GetCount() const
@@ -470,6 +636,8 @@ PyObject *EXP_BaseListValue::Pyreverse()
   }
 
   std::reverse(m_pValueArray.begin(), m_pValueArray.end());
+  m_nameIndexValid = false;
+  m_itemIndexValid = false;
   Py_RETURN_NONE;
 }
 
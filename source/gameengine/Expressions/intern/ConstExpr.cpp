@@ -18,6 +18,8 @@
 
 #include "EXP_ConstExpr.h"
 
+#include "EXP_ExpressionProgram.h"
+
 EXP_ConstExpr::EXP_ConstExpr()
 {
 }
@@ -48,3 +50,8 @@ double EXP_ConstExpr::GetNumber()
 {
   return -1.0;
 }
+
+bool EXP_ConstExpr::Compile(EXP_ExpressionProgram &program)
+{
+  return program.AddConstant(m_value);
+}
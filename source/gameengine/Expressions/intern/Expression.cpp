@@ -16,6 +16,8 @@
  */
 #include "EXP_Expression.h"
 
+#include "EXP_ExpressionProgram.h"
+
 EXP_Expression::EXP_Expression()
 {
 }
@@ -23,3 +25,8 @@ EXP_Expression::EXP_Expression()
 EXP_Expression::~EXP_Expression()
 {
 }
+
+bool EXP_Expression::Compile(EXP_ExpressionProgram &program)
+{
+  return false;
+}
@@ -0,0 +1,466 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file ExpressionProgram.cpp
+ *  \ingroup expressions
+ */
+
+#include "EXP_ExpressionProgram.h"
+
+#include <cmath>
+
+#include "EXP_BoolValue.h"
+#include "EXP_Expression.h"
+#include "EXP_FloatValue.h"
+
+double EXP_ExpressionProgram::Value::GetNumber() const
+{
+  switch (m_type) {
+    case TYPE_BOOL: {
+      return m_bool ? 1.0 : 0.0;
+    }
+    case TYPE_INT: {
+      return (double)m_int;
+    }
+    case TYPE_FLOAT: {
+      return (double)m_float;
+    }
+    default: {
+      return 0.0;
+    }
+  }
+}
+
+EXP_ExpressionProgram::EXP_ExpressionProgram()
+    : m_context(nullptr), m_depth(0), m_error(nullptr)
+{
+}
+
+bool EXP_ExpressionProgram::Compile(EXP_Expression *expr, Context *context)
+{
+  Clear();
+  m_context = context;
+
+  if (!expr->Compile(*this) || m_depth != 1) {
+    Clear();
+    return false;
+  }
+
+  return true;
+}
+
+void EXP_ExpressionProgram::Clear()
+{
+  m_context = nullptr;
+  m_instructions.clear();
+  m_stack.clear();
+  m_depth = 0;
+}
+
+bool EXP_ExpressionProgram::IsValid() const
+{
+  return !m_instructions.empty();
+}
+
+const char *EXP_ExpressionProgram::GetError() const
+{
+  return m_error;
+}
+
+void EXP_ExpressionProgram::AddInstruction(Opcode opcode,
+                                           VALUE_OPERATOR op,
+                                           unsigned int operand,
+                                           int depth)
+{
+  Instruction instruction;
+  instruction.m_opcode = opcode;
+  instruction.m_operator = op;
+  instruction.m_operand = operand;
+  instruction.m_value.m_type = TYPE_EMPTY;
+  instruction.m_value.m_int = 0;
+  m_instructions.push_back(instruction);
+
+  m_depth += depth;
+  if (m_depth > m_stack.size()) {
+    m_stack.resize(m_depth);
+  }
+}
+
+bool EXP_ExpressionProgram::AddConstant(EXP_Value *value)
+{
+  Value constant;
+  switch (value->GetValueType()) {
+    case VALUE_BOOL_TYPE: {
+      constant.m_type = TYPE_BOOL;
+      constant.m_bool = static_cast<EXP_BoolValue *>(value)->GetBool();
+      break;
+    }
+    case VALUE_INT_TYPE: {
+      constant.m_type = TYPE_INT;
+      constant.m_int = static_cast<EXP_IntValue *>(value)->GetInt();
+      break;
+    }
+    case VALUE_FLOAT_TYPE: {
+      constant.m_type = TYPE_FLOAT;
+      constant.m_float = static_cast<EXP_FloatValue *>(value)->GetFloat();
+      break;
+    }
+    case VALUE_EMPTY_TYPE: {
+      constant.m_type = TYPE_EMPTY;
+      constant.m_int = 0;
+      break;
+    }
+    default: {
+      // Strings and parse errors are left to the tree.
+      return false;
+    }
+  }
+
+  AddInstruction(OPCODE_CONSTANT, VALUE_NO_OPERATOR, 0, 1);
+  m_instructions.back().m_value = constant;
+  return true;
+}
+
+bool EXP_ExpressionProgram::AddIdentifier(const std::string &name)
+{
+  const int index = m_context ? m_context->ResolveIdentifier(name) : -1;
+  if (index == -1) {
+    return false;
+  }
+
+  AddInstruction(OPCODE_SOURCE, VALUE_NO_OPERATOR, index, 1);
+  return true;
+}
+
+void EXP_ExpressionProgram::AddUnary(VALUE_OPERATOR op)
+{
+  AddInstruction(OPCODE_UNARY, op, 0, 0);
+}
+
+void EXP_ExpressionProgram::AddBinary(VALUE_OPERATOR op)
+{
+  AddInstruction(OPCODE_BINARY, op, 0, -1);
+}
+
+unsigned int EXP_ExpressionProgram::AddBranch(bool conditional)
+{
+  AddInstruction(conditional ? OPCODE_BRANCH_FALSE : OPCODE_JUMP, VALUE_NO_OPERATOR, 0, -1);
+  return m_instructions.size() - 1;
+}
+
+void EXP_ExpressionProgram::SetBranchTarget(unsigned int branch)
+{
+  m_instructions[branch].m_operand = m_instructions.size();
+}
+
+EXP_ExpressionProgram::Status EXP_ExpressionProgram::Unary(VALUE_OPERATOR op, Value &value)
+{
+  switch (value.m_type) {
+    case TYPE_BOOL: {
+      if (op != VALUE_NOT_OPERATOR) {
+        return STATUS_UNSUPPORTED;
+      }
+      value.m_bool = !value.m_bool;
+      return STATUS_SUCCESS;
+    }
+    case TYPE_INT: {
+      switch (op) {
+        case VALUE_NEG_OPERATOR: {
+          value.m_int = -value.m_int;
+          return STATUS_SUCCESS;
+        }
+        case VALUE_POS_OPERATOR: {
+          return STATUS_SUCCESS;
+        }
+        case VALUE_NOT_OPERATOR: {
+          value.m_bool = (value.m_int == 0);
+          value.m_type = TYPE_BOOL;
+          return STATUS_SUCCESS;
+        }
+        default: {
+          return STATUS_UNSUPPORTED;
+        }
+      }
+    }
+    case TYPE_FLOAT: {
+      switch (op) {
+        case VALUE_NEG_OPERATOR: {
+          value.m_float = -value.m_float;
+          return STATUS_SUCCESS;
+        }
+        case VALUE_POS_OPERATOR: {
+          return STATUS_SUCCESS;
+        }
+        case VALUE_NOT_OPERATOR: {
+          value.m_bool = (value.m_float == 0.0f);
+          value.m_type = TYPE_BOOL;
+          return STATUS_SUCCESS;
+        }
+        default: {
+          return STATUS_UNSUPPORTED;
+        }
+      }
+    }
+    default: {
+      return STATUS_UNSUPPORTED;
+    }
+  }
+}
+
+EXP_ExpressionProgram::Status EXP_ExpressionProgram::Binary(VALUE_OPERATOR op,
+                                                            const Value &lhs,
+                                                            const Value &rhs,
+                                                            Value &result)
+{
+  if (lhs.m_type == TYPE_EMPTY || rhs.m_type == TYPE_EMPTY) {
+    return STATUS_UNSUPPORTED;
+  }
+
+  // Booleans only combine with booleans.
+  if (lhs.m_type == TYPE_BOOL || rhs.m_type == TYPE_BOOL) {
+    if (lhs.m_type != rhs.m_type) {
+      return STATUS_UNSUPPORTED;
+    }
+
+    bool value;
+    switch (op) {
+      case VALUE_AND_OPERATOR: {
+        value = lhs.m_bool && rhs.m_bool;
+        break;
+      }
+      case VALUE_OR_OPERATOR: {
+        value = lhs.m_bool || rhs.m_bool;
+        break;
+      }
+      case VALUE_EQL_OPERATOR: {
+        value = (lhs.m_bool == rhs.m_bool);
+        break;
+      }
+      case VALUE_NEQ_OPERATOR: {
+        value = (lhs.m_bool != rhs.m_bool);
+        break;
+      }
+      default: {
+        return STATUS_UNSUPPORTED;
+      }
+    }
+
+    result.m_type = TYPE_BOOL;
+    result.m_bool = value;
+    return STATUS_SUCCESS;
+  }
+
+  if (lhs.m_type == TYPE_INT && rhs.m_type == TYPE_INT) {
+    const cInt a = lhs.m_int;
+    const cInt b = rhs.m_int;
+    switch (op) {
+      case VALUE_MOD_OPERATOR: {
+        if (b == 0) {
+          m_error = "Division by zero";
+          return STATUS_ERROR;
+        }
+        result.m_int = a % b;
+        break;
+      }
+      case VALUE_ADD_OPERATOR: {
+        result.m_int = a + b;
+        break;
+      }
+      case VALUE_SUB_OPERATOR: {
+        result.m_int = a - b;
+        break;
+      }
+      case VALUE_MUL_OPERATOR: {
+        result.m_int = a * b;
+        break;
+      }
+      case VALUE_DIV_OPERATOR: {
+        if (b == 0) {
+          return STATUS_UNSUPPORTED;
+        }
+        result.m_int = a / b;
+        break;
+      }
+      case VALUE_EQL_OPERATOR: {
+        result.m_bool = (a == b);
+        result.m_type = TYPE_BOOL;
+        return STATUS_SUCCESS;
+      }
+      case VALUE_NEQ_OPERATOR: {
+        result.m_bool = (a != b);
+        result.m_type = TYPE_BOOL;
+        return STATUS_SUCCESS;
+      }
+      case VALUE_GRE_OPERATOR: {
+        result.m_bool = (a > b);
+        result.m_type = TYPE_BOOL;
+        return STATUS_SUCCESS;
+      }
+      case VALUE_LES_OPERATOR: {
+        result.m_bool = (a < b);
+        result.m_type = TYPE_BOOL;
+        return STATUS_SUCCESS;
+      }
+      case VALUE_GEQ_OPERATOR: {
+        result.m_bool = (a >= b);
+        result.m_type = TYPE_BOOL;
+        return STATUS_SUCCESS;
+      }
+      case VALUE_LEQ_OPERATOR: {
+        result.m_bool = (a <= b);
+        result.m_type = TYPE_BOOL;
+        return STATUS_SUCCESS;
+      }
+      default: {
+        return STATUS_UNSUPPORTED;
+      }
+    }
+
+    result.m_type = TYPE_INT;
+    return STATUS_SUCCESS;
+  }
+
+  /* A float with an integer or a float, computed in float precision as EXP_FloatValue and
+   * EXP_IntValue do, except the modulo computed in double precision by fmod. */
+  const float a = (lhs.m_type == TYPE_INT) ? (float)lhs.m_int : lhs.m_float;
+  const float b = (rhs.m_type == TYPE_INT) ? (float)rhs.m_int : rhs.m_float;
+  switch (op) {
+    case VALUE_MOD_OPERATOR: {
+      const double da = (lhs.m_type == TYPE_INT) ? (double)lhs.m_int : (double)lhs.m_float;
+      const double db = (rhs.m_type == TYPE_INT) ? (double)rhs.m_int : (double)rhs.m_float;
+      result.m_float = fmod(da, db);
+      break;
+    }
+    case VALUE_ADD_OPERATOR: {
+      result.m_float = a + b;
+      break;
+    }
+    case VALUE_SUB_OPERATOR: {
+      result.m_float = a - b;
+      break;
+    }
+    case VALUE_MUL_OPERATOR: {
+      result.m_float = a * b;
+      break;
+    }
+    case VALUE_DIV_OPERATOR: {
+      if (b == 0.0f) {
+        return STATUS_UNSUPPORTED;
+      }
+      result.m_float = a / b;
+      break;
+    }
+    case VALUE_EQL_OPERATOR: {
+      result.m_bool = (a == b);
+      result.m_type = TYPE_BOOL;
+      return STATUS_SUCCESS;
+    }
+    case VALUE_NEQ_OPERATOR: {
+      result.m_bool = (a != b);
+      result.m_type = TYPE_BOOL;
+      return STATUS_SUCCESS;
+    }
+    case VALUE_GRE_OPERATOR: {
+      result.m_bool = (a > b);
+      result.m_type = TYPE_BOOL;
+      return STATUS_SUCCESS;
+    }
+    case VALUE_LES_OPERATOR: {
+      result.m_bool = (a < b);
+      result.m_type = TYPE_BOOL;
+      return STATUS_SUCCESS;
+    }
+    case VALUE_GEQ_OPERATOR: {
+      result.m_bool = (a >= b);
+      result.m_type = TYPE_BOOL;
+      return STATUS_SUCCESS;
+    }
+    case VALUE_LEQ_OPERATOR: {
+      result.m_bool = (a <= b);
+      result.m_type = TYPE_BOOL;
+      return STATUS_SUCCESS;
+    }
+    default: {
+      return STATUS_UNSUPPORTED;
+    }
+  }
+
+  result.m_type = TYPE_FLOAT;
+  return STATUS_SUCCESS;
+}
+
+EXP_ExpressionProgram::Status EXP_ExpressionProgram::Evaluate(Value &result)
+{
+  Value *stack = m_stack.data();
+  unsigned int top = 0;
+  const unsigned int size = m_instructions.size();
+
+  for (unsigned int pc = 0; pc < size;) {
+    const Instruction &instruction = m_instructions[pc++];
+    switch (instruction.m_opcode) {
+      case OPCODE_CONSTANT: {
+        stack[top++] = instruction.m_value;
+        break;
+      }
+      case OPCODE_SOURCE: {
+        if (!m_context->GetSource(instruction.m_operand, stack[top++])) {
+          return STATUS_UNSUPPORTED;
+        }
+        break;
+      }
+      case OPCODE_UNARY: {
+        const Status status = Unary(instruction.m_operator, stack[top - 1]);
+        if (status != STATUS_SUCCESS) {
+          return status;
+        }
+        break;
+      }
+      case OPCODE_BINARY: {
+        --top;
+        const Status status = Binary(
+            instruction.m_operator, stack[top - 1], stack[top], stack[top - 1]);
+        if (status != STATUS_SUCCESS) {
+          return status;
+        }
+        break;
+      }
+      case OPCODE_BRANCH_FALSE: {
+        const Value &guard = stack[--top];
+        // The tree reports an error for a guard which isn't a boolean.
+        if (guard.m_type != TYPE_BOOL) {
+          return STATUS_UNSUPPORTED;
+        }
+        if (!guard.m_bool) {
+          pc = instruction.m_operand;
+        }
+        break;
+      }
+      case OPCODE_JUMP: {
+        pc = instruction.m_operand;
+        break;
+      }
+    }
+  }
+
+  result = stack[0];
+  return STATUS_SUCCESS;
+}
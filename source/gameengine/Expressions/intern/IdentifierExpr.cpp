@@ -31,6 +31,8 @@
 
 #include "EXP_IdentifierExpr.h"
 
+#include "EXP_ExpressionProgram.h"
+
 EXP_IdentifierExpr::EXP_IdentifierExpr(const std::string &identifier, EXP_Value *id_context)
     : m_identifier(identifier)
 {
@@ -63,3 +65,8 @@ unsigned char EXP_IdentifierExpr::GetExpressionID()
 {
   return CIDENTIFIEREXPRESSIONID;
 }
+
+bool EXP_IdentifierExpr::Compile(EXP_ExpressionProgram &program)
+{
+  return program.AddIdentifier(m_identifier);
+}
@@ -19,6 +19,7 @@
 
 #include "EXP_BoolValue.h"
 #include "EXP_ErrorValue.h"
+#include "EXP_ExpressionProgram.h"
 
 EXP_IfExpr::EXP_IfExpr()
 {
@@ -65,3 +66,24 @@ unsigned char EXP_IfExpr::GetExpressionID()
 {
   return CIFEXPRESSIONID;
 }
+
+bool EXP_IfExpr::Compile(EXP_ExpressionProgram &program)
+{
+  if (!m_guard->Compile(program)) {
+    return false;
+  }
+
+  const unsigned int elseBranch = program.AddBranch(true);
+  if (!m_e1->Compile(program)) {
+    return false;
+  }
+
+  const unsigned int endBranch = program.AddBranch(false);
+  program.SetBranchTarget(elseBranch);
+  if (!m_e2->Compile(program)) {
+    return false;
+  }
+
+  program.SetBranchTarget(endBranch);
+  return true;
+}
@@ -18,6 +18,7 @@
 #include "EXP_Operator1Expr.h"
 
 #include "EXP_EmptyValue.h"
+#include "EXP_ExpressionProgram.h"
 
 EXP_Operator1Expr::EXP_Operator1Expr() : m_lhs(nullptr)
 {
@@ -50,3 +51,13 @@ EXP_Value *EXP_Operator1Expr::Calculate()
 
   return ret;
 }
+
+bool EXP_Operator1Expr::Compile(EXP_ExpressionProgram &program)
+{
+  if (!m_lhs->Compile(program)) {
+    return false;
+  }
+
+  program.AddUnary(m_op);
+  return true;
+}
@@ -17,6 +17,8 @@
 
 #include "EXP_Operator2Expr.h"
 
+#include "EXP_ExpressionProgram.h"
+
 EXP_Operator2Expr::EXP_Operator2Expr(VALUE_OPERATOR op, EXP_Expression *lhs, EXP_Expression *rhs)
     : m_rhs(rhs), m_lhs(lhs), m_op(op)
 {
@@ -54,3 +56,14 @@ EXP_Value *EXP_Operator2Expr::Calculate()
 
   return calculate;
 }
+
+bool EXP_Operator2Expr::Compile(EXP_ExpressionProgram &program)
+{
+  // Both operands are always evaluated, as in Calculate.
+  if (!m_lhs->Compile(program) || !m_rhs->Compile(program)) {
+    return false;
+  }
+
+  program.AddBinary(m_op);
+  return true;
+}
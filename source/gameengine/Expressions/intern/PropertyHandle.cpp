@@ -0,0 +1,75 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file PropertyHandle.cpp
+ *  \ingroup expressions
+ */
+
+#include "EXP_PropertyHandle.h"
+
+#include "EXP_Value.h"
+
+EXP_PropertyHandle::EXP_PropertyHandle(const std::string &name)
+    : m_name(name), m_owner(nullptr), m_property(nullptr), m_propertiesVersion(0)
+{
+}
+
+EXP_PropertyHandle::EXP_PropertyHandle(const EXP_PropertyHandle &other)
+    : m_name(other.m_name), m_owner(nullptr), m_property(nullptr), m_propertiesVersion(0)
+{
+}
+
+EXP_PropertyHandle &EXP_PropertyHandle::operator=(const EXP_PropertyHandle &other)
+{
+  m_name = other.m_name;
+  Invalidate();
+  return *this;
+}
+
+const std::string &EXP_PropertyHandle::GetName() const
+{
+  return m_name;
+}
+
+void EXP_PropertyHandle::SetName(const std::string &name)
+{
+  m_name = name;
+  Invalidate();
+}
+
+EXP_Value *EXP_PropertyHandle::Get(EXP_Value *owner)
+{
+  // The owner holds a reference on the property while its properties don't change.
+  if (owner != m_owner || owner->GetPropertiesVersion() != m_propertiesVersion) {
+    m_owner = owner;
+    m_propertiesVersion = owner->GetPropertiesVersion();
+    m_property = owner->GetProperty(m_name);
+  }
+
+  return m_property;
+}
+
+void EXP_PropertyHandle::Invalidate()
+{
+  m_owner = nullptr;
+  m_property = nullptr;
+}
@@ -20,6 +20,8 @@
 
 #include "EXP_Value.h"
 
+#include <algorithm>
+
 #include "EXP_BoolValue.h"
 #include "EXP_ErrorValue.h"
 #include "EXP_FloatValue.h"
@@ -71,7 +73,7 @@ PyMethodDef EXP_Value::Methods[] = {
 };
 #endif  // WITH_PYTHON
 
-EXP_Value::EXP_Value()
+EXP_Value::EXP_Value() : m_valueVersion(0), m_propertiesVersion(0)
 {
 }
 
@@ -154,21 +156,22 @@ void EXP_Value::SetProperty(const std::string &name, EXP_Value *ioProperty)
     return;
   }
 
-  // Try to replace property (if so -> exit as soon as we replaced it).
-  EXP_Value *oldval = m_properties[name];
-  if (oldval) {
-    oldval->Release();
+  // Try to replace property, the name is hashed once for both cases.
+  std::pair<std::unordered_map<std::string, EXP_Value *>::iterator, bool> result =
+      m_properties.emplace(name, nullptr);
+  if (!result.second) {
+    result.first->second->Release();
   }
 
-  // Add property at end of array.
-  m_properties[name] = ioProperty->AddRef();
+  result.first->second = ioProperty->AddRef();
+  ++m_propertiesVersion;
 }
 
 /// Get pointer to a property with name <inName>, returns nullptr if there is no property named
 /// <inName>.
 EXP_Value *EXP_Value::GetProperty(const std::string &inName)
 {
-  std::map<std::string, EXP_Value *>::iterator it = m_properties.find(inName);
+  std::unordered_map<std::string, EXP_Value *>::iterator it = m_properties.find(inName);
   if (it != m_properties.end()) {
     return it->second;
   }
@@ -203,26 +206,27 @@ float EXP_Value::GetPropertyNumber(const std::string &inName, float defnumber)
 /// if property was not found or could not be removed.
 bool EXP_Value::RemoveProperty(const std::string &inName)
 {
-  std::map<std::string, EXP_Value *>::iterator it = m_properties.find(inName);
+  std::unordered_map<std::string, EXP_Value *>::iterator it = m_properties.find(inName);
   if (it != m_properties.end()) {
     (*it).second->Release();
     m_properties.erase(it);
+    ++m_propertiesVersion;
     return true;
   }
 
   return false;
 }
 
-/// Get Property Names.
+/// Get Property Names, sorted to not depend on the hash map order.
 std::vector<std::string> EXP_Value::GetPropertyNames()
 {
-  const unsigned short size = m_properties.size();
-  std::vector<std::string> result(size);
+  std::vector<std::string> result;
+  result.reserve(m_properties.size());
 
-  unsigned short i = 0;
   for (const auto &pair : m_properties) {
-    result[i++] = pair.first;
+    result.push_back(pair.first);
   }
+  std::sort(result.begin(), result.end());
   return result;
 }
 
@@ -236,6 +240,22 @@ void EXP_Value::ClearProperties()
 
   // Delete property array.
   m_properties.clear();
+  ++m_propertiesVersion;
+}
+
+unsigned int EXP_Value::GetValueVersion() const
+{
+  return m_valueVersion;
+}
+
+unsigned int EXP_Value::GetPropertiesVersion() const
+{
+  return m_propertiesVersion;
+}
+
+void EXP_Value::TagValueChanged()
+{
+  ++m_valueVersion;
 }
 
 /// Get property number <inIndex>.
@@ -372,11 +392,12 @@ EXP_Value *EXP_Value::ConvertPythonToValue(PyObject *pyobj,
 
 PyObject *EXP_Value::ConvertKeysToPython(void)
 {
-  PyObject *pylist = PyList_New(m_properties.size());
+  const std::vector<std::string> names = GetPropertyNames();
+  PyObject *pylist = PyList_New(names.size());
 
   Py_ssize_t i = 0;
-  for (const auto &pair : m_properties) {
-    PyList_SET_ITEM(pylist, i++, PyUnicode_FromStdString(pair.first));
+  for (const std::string &name : names) {
+    PyList_SET_ITEM(pylist, i++, PyUnicode_FromStdString(name));
   }
 
   return pylist;
@@ -49,9 +49,13 @@ SCA_ANDController::~SCA_ANDController()
 {
 }
 
-void SCA_ANDController::Trigger(SCA_LogicManager *logicmgr)
+bool SCA_ANDController::IsThreadSafe() const
 {
+  return true;
+}
 
+bool SCA_ANDController::Evaluate() const
+{
   bool sensorresult = true;
 
   for (SCA_ISensor *sensor : m_linkedsensors) {
@@ -61,9 +65,12 @@ void SCA_ANDController::Trigger(SCA_LogicManager *logicmgr)
     }
   }
 
-  for (SCA_IActuator *actuator : m_linkedactuators) {
-    logicmgr->AddActiveActuator(actuator, sensorresult);
-  }
+  return sensorresult;
+}
+
+void SCA_ANDController::Trigger(SCA_LogicManager *logicmgr)
+{
+  TriggerActuators(logicmgr, Evaluate());
 }
 
 EXP_Value *SCA_ANDController::GetReplica()
@@ -43,4 +43,6 @@ class SCA_ANDController : public SCA_IController {
   virtual ~SCA_ANDController();
   virtual EXP_Value *GetReplica();
   virtual void Trigger(SCA_LogicManager *logicmgr);
+  virtual bool IsThreadSafe() const;
+  virtual bool Evaluate() const;
 };
@@ -272,7 +272,7 @@ bool SCA_ActionActuator::Play(KX_GameObject *obj, float start, float end, short
 {
   const short blendmode = (m_blendmode == ACT_ACTION_ADD) ? BL_Action::ACT_BLEND_ADD :
                                                             BL_Action::ACT_BLEND_BLEND;
-  return obj->PlayAction(m_action->id.name + 2,
+  return obj->PlayAction(m_action,
                          start,
                          end,
                          m_layer,
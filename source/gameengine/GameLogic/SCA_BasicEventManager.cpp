@@ -48,6 +48,11 @@ SCA_BasicEventManager::~SCA_BasicEventManager()
 
 void SCA_BasicEventManager::NextFrame()
 {
+  for (SCA_ISensor *sensor : m_sensors) {
+    sensor->AddRayCasts(m_rayCastBatch);
+  }
+  m_rayCastBatch.Execute();
+
   for (SCA_ISensor *sensor : m_sensors) {
     sensor->Activate(m_logicmgr);
   }
@@ -34,9 +34,14 @@
 
 #pragma once
 
+#include "KX_RayCastBatch.h"
 #include "SCA_EventManager.h"
 
 class SCA_BasicEventManager : public SCA_EventManager {
+ private:
+  /// Rays of the sensors, cast together before their activation.
+  KX_RayCastBatch m_rayCastBatch;
+
  public:
   SCA_BasicEventManager(class SCA_LogicManager *logicmgr);
   ~SCA_BasicEventManager();
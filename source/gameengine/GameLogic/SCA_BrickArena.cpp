@@ -0,0 +1,131 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+
+/** \file gameengine/GameLogic/SCA_BrickArena.cpp
+ *  \ingroup gamelogic
+ */
+
+#include "SCA_BrickArena.h"
+
+#include <atomic>
+#include <new>
+
+static const size_t allocationAlignment = alignof(std::max_align_t);
+
+static size_t align_size(size_t size)
+{
+  return (size + allocationAlignment - 1) & ~(allocationAlignment - 1);
+}
+
+struct SCA_BrickArena::Block {
+  /// The bricks of the block and its scope while it exists.
+  std::atomic<unsigned int> m_users;
+  size_t m_capacity;
+  size_t m_used;
+};
+
+/// Header placed before each brick.
+struct AllocationHeader {
+  /// The block containing the brick, nullptr for an individual allocation.
+  SCA_BrickArena::Block *m_block;
+  size_t m_size;
+};
+
+static const size_t headerSize = align_size(sizeof(AllocationHeader));
+static const size_t blockHeaderSize = align_size(sizeof(SCA_BrickArena::Block));
+
+/// The block receiving the allocations of the current thread.
+static thread_local SCA_BrickArena::Block *currentBlock = nullptr;
+
+SCA_BrickArena::Scope::Scope(size_t size) : m_block(nullptr), m_previousBlock(currentBlock)
+{
+  if (size > 0) {
+    void *memory = ::operator new(blockHeaderSize + size);
+    m_block = new (memory) Block{{1}, size, 0};
+  }
+  currentBlock = m_block;
+}
+
+SCA_BrickArena::Scope::~Scope()
+{
+  currentBlock = m_previousBlock;
+  if (m_block) {
+    ReleaseBlock(m_block);
+  }
+}
+
+void SCA_BrickArena::ReleaseBlock(Block *block)
+{
+  // The bricks can be deleted from an other thread than the one of their scope.
+  if (block->m_users.fetch_sub(1) == 1) {
+    block->~Block();
+    ::operator delete(block);
+  }
+}
+
+void *SCA_BrickArena::Allocate(size_t size)
+{
+  const size_t allocationSize = headerSize + align_size(size);
+
+  AllocationHeader *header;
+  Block *block = currentBlock;
+  if (block && block->m_used + allocationSize <= block->m_capacity) {
+    header = reinterpret_cast<AllocationHeader *>(reinterpret_cast<char *>(block) +
+                                                  blockHeaderSize + block->m_used);
+    block->m_used += allocationSize;
+    ++block->m_users;
+  }
+  else {
+    // No scope or not enough space left in its block.
+    header = static_cast<AllocationHeader *>(::operator new(allocationSize));
+    block = nullptr;
+  }
+
+  header->m_block = block;
+  header->m_size = size;
+
+  return reinterpret_cast<char *>(header) + headerSize;
+}
+
+void SCA_BrickArena::Free(void *ptr)
+{
+  if (!ptr) {
+    return;
+  }
+
+  AllocationHeader *header = reinterpret_cast<AllocationHeader *>(static_cast<char *>(ptr) -
+                                                                  headerSize);
+  if (header->m_block) {
+    ReleaseBlock(header->m_block);
+  }
+  else {
+    ::operator delete(header);
+  }
+}
+
+size_t SCA_BrickArena::GetAllocationSize(void *ptr)
+{
+  const AllocationHeader *header = reinterpret_cast<AllocationHeader *>(
+      static_cast<char *>(ptr) - headerSize);
+  return headerSize + align_size(header->m_size);
+}
@@ -0,0 +1,65 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+
+/** \file SCA_BrickArena.h
+ *  \ingroup gamelogic
+ */
+
+#pragma once
+
+#include <cstddef>
+
+/** Allocator of the logic bricks. The bricks allocated while a scope exists share one memory
+ * block, the block is freed at once when its last brick is deleted. Outside of a scope each
+ * brick has its own allocation.
+ */
+class SCA_BrickArena {
+ public:
+  /// Memory shared by the bricks allocated in a scope.
+  struct Block;
+
+ private:
+  static void ReleaseBlock(Block *block);
+
+ public:
+  /// Allocate the bricks of the current thread in a new block until the scope is destructed.
+  class Scope {
+   private:
+    Block *m_block;
+    Block *m_previousBlock;
+
+   public:
+    /** \param size The size of the block, the sum of the allocation sizes of the bricks,
+     * no block is used for a null size.
+     */
+    Scope(size_t size);
+    ~Scope();
+  };
+
+  static void *Allocate(size_t size);
+  static void Free(void *ptr);
+  /** Return the memory used by the allocation of ptr, used to size the block of a scope.
+   * \param ptr The address of the complete allocated object.
+   */
+  static size_t GetAllocationSize(void *ptr);
+};
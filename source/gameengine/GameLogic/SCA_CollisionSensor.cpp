@@ -37,7 +37,6 @@
 #include "KX_CollisionEventManager.h"
 #include "PHY_IPhysicsController.h"
 #include "PHY_IPhysicsEnvironment.h"
-#include "RAS_MeshObject.h"
 
 /* ------------------------------------------------------------------------- */
 /* Native functions                                                          */
@@ -52,6 +51,7 @@ void SCA_CollisionSensor::SynchronizeTransform()
 void SCA_CollisionSensor::EndFrame()
 {
   m_colliders->ReleaseAndRemoveAll();
+  m_colliderSet.clear();
   m_hitObject = nullptr;
   m_bTriggered = false;
   m_bColliderHash = 0;
@@ -61,6 +61,9 @@ void SCA_CollisionSensor::UnregisterToManager()
 {
   // before unregistering the sensor, make sure we release all references
   EndFrame();
+  // The sensor can be unregistered by a collision callback before its contacts are applied.
+  m_contacts.clear();
+  m_acceptedContacts.clear();
   SCA_ISensor::UnregisterToManager();
 }
 
@@ -141,6 +144,9 @@ void SCA_CollisionSensor::ProcessReplica()
 {
   SCA_ISensor::ProcessReplica();
   m_colliders = new EXP_ListValue<KX_GameObject>();
+  m_colliderSet.clear();
+  m_contacts.clear();
+  m_acceptedContacts.clear();
   Init();
 }
 
@@ -210,15 +216,7 @@ bool SCA_CollisionSensor::BroadPhaseSensorFilterCollision(void *obj1, void *obj2
   bool found = m_touchedpropname.empty();
   if (!found) {
     if (m_bFindMaterial) {
-      for (unsigned int i = 0; i < otherobj->GetMeshCount(); ++i) {
-        RAS_MeshObject *meshObj = otherobj->GetMesh(i);
-        for (unsigned int j = 0; j < meshObj->NumMaterials(); ++j) {
-          found = (m_touchedpropname == std::string(meshObj->GetMaterialName(j), 2));
-          if (found) {
-            break;
-          }
-        }
-      }
+      found = otherobj->HasMaterialName(m_touchedpropname);
     }
     else {
       found = (otherobj->GetProperty(m_touchedpropname) != nullptr);
@@ -230,54 +228,88 @@ bool SCA_CollisionSensor::BroadPhaseSensorFilterCollision(void *obj1, void *obj2
 bool SCA_CollisionSensor::NewHandleCollision(void *object1,
                                              void *object2,
                                              const PHY_CollData *colldata)
+{
+  // add the same check as in SCA_ISensor::Activate(),
+  // we don't want to record collision when the sensor is not active.
+  if (m_links && !m_suspended) {
+    PHY_IPhysicsController *ctrl = static_cast<PHY_IPhysicsController *>(
+        object1 == m_physCtrl ? object2 : object1);
+    KX_GameObject *gameobj = FilterCollision(ctrl);
+    if (gameobj) {
+      AddCollider(gameobj);
+    }
+  }
+  return false;
+}
+
+KX_GameObject *SCA_CollisionSensor::FilterCollision(PHY_IPhysicsController *ctrl)
 {
   KX_GameObject *parent = (KX_GameObject *)GetParent();
 
   // need the mapping from PHY_IPhysicsController to gameobjects now
-
   KX_ClientObjectInfo *client_info = static_cast<KX_ClientObjectInfo *>(
-      object1 == m_physCtrl ? ((PHY_IPhysicsController *)object2)->GetNewClientInfo() :
-                              ((PHY_IPhysicsController *)object1)->GetNewClientInfo());
+      ctrl->GetNewClientInfo());
 
   KX_GameObject *gameobj = (client_info ? client_info->m_gameobject : nullptr);
 
-  // add the same check as in SCA_ISensor::Activate(),
-  // we don't want to record collision when the sensor is not active.
-  if (m_links && !m_suspended && gameobj && (gameobj != parent) && client_info->isActor()) {
-
-    bool found = m_touchedpropname.empty();
-    std::string hitMaterial = "";
-    if (!found) {
-      if (m_bFindMaterial) {
-        for (unsigned int i = 0; i < gameobj->GetMeshCount(); ++i) {
-          RAS_MeshObject *meshObj = gameobj->GetMesh(i);
-          for (unsigned int j = 0; j < meshObj->NumMaterials(); ++j) {
-            found = (m_touchedpropname == std::string(meshObj->GetMaterialName(j), 2));
-            if (found) {
-              hitMaterial = m_touchedpropname;
-              break;
-            }
-          }
-        }
-      }
-      else {
-        found = (gameobj->GetProperty(m_touchedpropname) != nullptr);
-      }
+  if (!gameobj || (gameobj == parent) || !client_info->isActor()) {
+    return nullptr;
+  }
+
+  bool found = m_touchedpropname.empty();
+  if (!found) {
+    if (m_bFindMaterial) {
+      found = gameobj->HasMaterialName(m_touchedpropname);
     }
-    if (found) {
-      if (!m_colliders->SearchValue(gameobj)) {
-        m_colliders->Add(CM_AddRef(gameobj));
+    else {
+      found = (gameobj->GetProperty(m_touchedpropname) != nullptr);
+    }
+  }
 
-        if (m_bCollisionPulse) {
-          m_bColliderHash += (uint_ptr)(static_cast<void *>(&gameobj));
-        }
-      }
-      m_bTriggered = true;
-      m_hitObject = gameobj;
-      m_hitMaterial = hitMaterial;
+  return (found) ? gameobj : nullptr;
+}
+
+void SCA_CollisionSensor::AddCollider(KX_GameObject *gameobj)
+{
+  if (m_colliderSet.insert(gameobj).second) {
+    m_colliders->Add(CM_AddRef(gameobj));
+
+    if (m_bCollisionPulse) {
+      m_bColliderHash += (uint_ptr)(static_cast<void *>(&gameobj));
     }
   }
-  return false;
+  m_bTriggered = true;
+  m_hitObject = gameobj;
+  m_hitMaterial = (m_bFindMaterial) ? m_touchedpropname : "";
+}
+
+bool SCA_CollisionSensor::QueueContact(PHY_IPhysicsController *ctrl)
+{
+  if (!m_links || m_suspended) {
+    return false;
+  }
+
+  m_contacts.push_back(ctrl);
+  return (m_contacts.size() == 1);
+}
+
+void SCA_CollisionSensor::FilterContacts()
+{
+  for (PHY_IPhysicsController *ctrl : m_contacts) {
+    KX_GameObject *gameobj = FilterCollision(ctrl);
+    if (gameobj) {
+      m_acceptedContacts.push_back(gameobj);
+    }
+  }
+  m_contacts.clear();
+}
+
+void SCA_CollisionSensor::ApplyContacts()
+{
+  for (KX_GameObject *gameobj : m_acceptedContacts) {
+    AddCollider(gameobj);
+  }
+  m_acceptedContacts.clear();
 }
 
 #ifdef WITH_PYTHON
@@ -32,6 +32,9 @@
 
 #pragma once
 
+#include <unordered_set>
+#include <vector>
+
 #include "EXP_ListValue.h"
 #include "KX_ClientObjectInfo.h"
 #include "SCA_ISensor.h"
@@ -71,8 +74,18 @@ class SCA_CollisionSensor : public SCA_ISensor {
 
   SCA_IObject *m_hitObject;
   EXP_ListValue<KX_GameObject> *m_colliders;
+  /// The objects of m_colliders, to add them only once.
+  std::unordered_set<KX_GameObject *> m_colliderSet;
   std::string m_hitMaterial;
 
+  /// Controllers colliding the sensor controller in the last physics step, to filter.
+  std::vector<PHY_IPhysicsController *> m_contacts;
+  /// Objects of the contacts passing the filter, added to the colliders.
+  std::vector<KX_GameObject *> m_acceptedContacts;
+
+  /// Add an object to the colliders and trigger the sensor.
+  void AddCollider(KX_GameObject *gameobj);
+
  public:
   SCA_CollisionSensor(class SCA_EventManager *eventmgr,
                       class KX_GameObject *gameobj,
@@ -94,6 +107,20 @@ class SCA_CollisionSensor : public SCA_ISensor {
 
   virtual bool NewHandleCollision(void *obj1, void *obj2, const PHY_CollData *colldata);
 
+  /** Return the object of a controller colliding the sensor controller if the sensor detects
+   * it, nullptr otherwise. The objects are only read, the sensors can filter in parallel.
+   */
+  virtual KX_GameObject *FilterCollision(PHY_IPhysicsController *ctrl);
+  /** Queue a controller colliding the sensor controller, nothing is queued if the sensor is
+   * not active.
+   * \return True if this is the first queued contact since the last ApplyContacts.
+   */
+  bool QueueContact(PHY_IPhysicsController *ctrl);
+  /// Filter the queued contacts, can run in parallel with the other sensors.
+  void FilterContacts();
+  /// Add the filtered contacts to the colliders.
+  void ApplyContacts();
+
   // Allows to do pre-filtering and save computation time
   // obj1 = sensor physical controller, obj2 = physical controller of second object
   // return value = true if collision should be checked on pair of object
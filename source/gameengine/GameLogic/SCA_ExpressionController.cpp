@@ -35,6 +35,8 @@
 #include "SCA_ExpressionController.h"
 
 #include "CM_Message.h"
+#include "EXP_BoolValue.h"
+#include "EXP_FloatValue.h"
 #include "EXP_InputParser.h"
 #include "SCA_ISensor.h"
 #include "SCA_LogicManager.h"
@@ -45,7 +47,18 @@
 
 SCA_ExpressionController::SCA_ExpressionController(SCA_IObject *gameobj,
                                                    const std::string &exprtext)
-    : SCA_IController(gameobj), m_exprText(exprtext), m_exprCache(nullptr)
+    : SCA_IController(gameobj),
+      m_exprText(exprtext),
+      m_exprCache(nullptr),
+      m_programDirty(true),
+      m_programNumSensors(0)
+{
+}
+
+SCA_ExpressionController::Source::Source(SCA_ISensor *sensor,
+                                         unsigned int index,
+                                         const std::string &name)
+    : m_sensor(sensor), m_sensorIndex(index), m_property(name)
 {
 }
 
@@ -60,6 +73,10 @@ EXP_Value *SCA_ExpressionController::GetReplica()
   SCA_ExpressionController *replica = new SCA_ExpressionController(*this);
   replica->m_exprText = m_exprText;
   replica->m_exprCache = nullptr;
+  // The program reads the sensors of this controller.
+  replica->m_program.Clear();
+  replica->m_sources.clear();
+  replica->m_programDirty = true;
   // this will copy properties and so on...
   replica->ProcessReplica();
 
@@ -74,6 +91,8 @@ void SCA_ExpressionController::Delete()
     m_exprCache->Release();
     m_exprCache = nullptr;
   }
+  m_program.Clear();
+  m_sources.clear();
   Release();
 }
 
@@ -85,18 +104,45 @@ void SCA_ExpressionController::Trigger(SCA_LogicManager *logicmgr)
     EXP_Parser parser;
     parser.SetContext(this->AddRef());
     m_exprCache = parser.ProcessText(m_exprText);
+    m_programDirty = true;
   }
   if (m_exprCache) {
-    EXP_Value *value = m_exprCache->Calculate();
-    if (value) {
-      if (value->IsError()) {
-        CM_LogicBrickError(this, value->GetText());
+    if (m_programDirty || m_programNumSensors != m_linkedsensors.size()) {
+      m_sources.clear();
+      m_program.Compile(m_exprCache, this);
+      m_programDirty = false;
+      m_programNumSensors = m_linkedsensors.size();
+    }
+
+    EXP_ExpressionProgram::Status status = EXP_ExpressionProgram::STATUS_UNSUPPORTED;
+    EXP_ExpressionProgram::Value result;
+    if (m_program.IsValid()) {
+      status = m_program.Evaluate(result);
+    }
+
+    switch (status) {
+      case EXP_ExpressionProgram::STATUS_SUCCESS: {
+        expressionresult = !MT_fuzzyZero((float)result.GetNumber());
+        break;
+      }
+      case EXP_ExpressionProgram::STATUS_ERROR: {
+        CM_LogicBrickError(this, m_program.GetError());
+        break;
       }
-      else {
-        float num = (float)value->GetNumber();
-        expressionresult = !MT_fuzzyZero(num);
+      case EXP_ExpressionProgram::STATUS_UNSUPPORTED: {
+        EXP_Value *value = m_exprCache->Calculate();
+        if (value) {
+          if (value->IsError()) {
+            CM_LogicBrickError(this, value->GetText());
+          }
+          else {
+            float num = (float)value->GetNumber();
+            expressionresult = !MT_fuzzyZero(num);
+          }
+          value->Release();
+        }
+        break;
       }
-      value->Release();
     }
   }
 
@@ -135,3 +181,66 @@ EXP_Value *SCA_ExpressionController::FindIdentifier(const std::string &identifie
 
   return GetParent()->FindIdentifier(identifiername);
 }
+
+int SCA_ExpressionController::ResolveIdentifier(const std::string &name)
+{
+  // Same lookup order as FindIdentifier.
+  for (unsigned int i = 0, size = m_linkedsensors.size(); i < size; ++i) {
+    SCA_ISensor *sensor = m_linkedsensors[i];
+    if (sensor->GetName() == name) {
+      m_sources.emplace_back(sensor, i, name);
+      return m_sources.size() - 1;
+    }
+  }
+
+  // The sub-contexts of the dotted names are left to the tree.
+  if (name.find('.') != std::string::npos) {
+    return -1;
+  }
+
+  m_sources.emplace_back(nullptr, 0, name);
+  return m_sources.size() - 1;
+}
+
+bool SCA_ExpressionController::GetSource(unsigned int index, EXP_ExpressionProgram::Value &value)
+{
+  Source &source = m_sources[index];
+  if (source.m_sensor) {
+    // The sensors were relinked since the compilation.
+    if (source.m_sensorIndex >= m_linkedsensors.size() ||
+        m_linkedsensors[source.m_sensorIndex] != source.m_sensor) {
+      m_programDirty = true;
+      return false;
+    }
+
+    value.m_type = EXP_ExpressionProgram::TYPE_BOOL;
+    value.m_bool = source.m_sensor->GetState();
+    return true;
+  }
+
+  EXP_Value *prop = source.m_property.Get(GetParent());
+  if (!prop) {
+    return false;
+  }
+
+  switch (prop->GetValueType()) {
+    case VALUE_BOOL_TYPE: {
+      value.m_type = EXP_ExpressionProgram::TYPE_BOOL;
+      value.m_bool = static_cast<EXP_BoolValue *>(prop)->GetBool();
+      return true;
+    }
+    case VALUE_INT_TYPE: {
+      value.m_type = EXP_ExpressionProgram::TYPE_INT;
+      value.m_int = static_cast<EXP_IntValue *>(prop)->GetInt();
+      return true;
+    }
+    case VALUE_FLOAT_TYPE: {
+      value.m_type = EXP_ExpressionProgram::TYPE_FLOAT;
+      value.m_float = static_cast<EXP_FloatValue *>(prop)->GetFloat();
+      return true;
+    }
+    default: {
+      return false;
+    }
+  }
+}
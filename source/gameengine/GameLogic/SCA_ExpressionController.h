@@ -34,14 +34,37 @@
 
 #pragma once
 
+#include "EXP_ExpressionProgram.h"
+#include "EXP_PropertyHandle.h"
 #include "SCA_IController.h"
 
 class EXP_Expression;
 
-class SCA_ExpressionController : public SCA_IController {
+/** Controller activating its actuators when an expression of the sensors and the properties
+ * of its object is true. The parsed expression is compiled to a program reading the linked
+ * sensors and the properties directly, the expression tree is evaluated when the program
+ * doesn't support an identifier, a value type or an operation.
+ */
+class SCA_ExpressionController : public SCA_IController, public EXP_ExpressionProgram::Context {
   //	Py_Header
+  /// Identifier of the program, a linked sensor or a property of the object.
+  struct Source {
+    SCA_ISensor *m_sensor;
+    /// Index of the sensor in the linked sensors.
+    unsigned int m_sensorIndex;
+    EXP_PropertyHandle m_property;
+
+    Source(SCA_ISensor *sensor, unsigned int index, const std::string &name);
+  };
+
   std::string m_exprText;
   EXP_Expression *m_exprCache;
+  EXP_ExpressionProgram m_program;
+  std::vector<Source> m_sources;
+  /// The program must be compiled again, e.g. after the sensors were relinked.
+  bool m_programDirty;
+  /// Number of linked sensors when the program was compiled.
+  unsigned int m_programNumSensors;
 
  public:
   SCA_ExpressionController(SCA_IObject *gameobj, const std::string &exprtext);
@@ -50,6 +73,10 @@ class SCA_ExpressionController : public SCA_IController {
   virtual EXP_Value *GetReplica();
   virtual void Trigger(SCA_LogicManager *logicmgr);
   virtual EXP_Value *FindIdentifier(const std::string &identifiername);
+
+  // EXP_ExpressionProgram::Context
+  virtual int ResolveIdentifier(const std::string &name);
+  virtual bool GetSource(unsigned int index, EXP_ExpressionProgram::Value &value);
   /**
    *  used to release the expression cache
    *  so that self references are removed before the controller itself is released
@@ -36,9 +36,14 @@
 #include "EXP_ListWrapper.h"
 #include "SCA_IActuator.h"
 #include "SCA_ISensor.h"
+#include "SCA_LogicManager.h"
 
 SCA_IController::SCA_IController(SCA_IObject *gameobj)
-    : SCA_ILogicBrick(gameobj), m_statemask(0), m_justActivated(false)
+    : SCA_ILogicBrick(gameobj),
+      m_statemask(0),
+      m_justActivated(false),
+      m_evaluatedResult(false),
+      m_evaluationId(0)
 {
 }
 
@@ -46,6 +51,40 @@ SCA_IController::~SCA_IController()
 {
 }
 
+bool SCA_IController::IsThreadSafe() const
+{
+  return false;
+}
+
+bool SCA_IController::Evaluate() const
+{
+  return false;
+}
+
+void SCA_IController::TriggerActuators(SCA_LogicManager *logicmgr, bool result)
+{
+  for (SCA_IActuator *actuator : m_linkedactuators) {
+    logicmgr->AddActiveActuator(actuator, result);
+  }
+}
+
+void SCA_IController::SetEvaluatedResult(bool result, unsigned int evaluationId)
+{
+  m_evaluatedResult = result;
+  m_evaluationId = evaluationId;
+}
+
+bool SCA_IController::TriggerEvaluatedResult(SCA_LogicManager *logicmgr,
+                                             unsigned int evaluationId)
+{
+  if (m_evaluationId != evaluationId) {
+    return false;
+  }
+
+  TriggerActuators(logicmgr, m_evaluatedResult);
+  return true;
+}
+
 std::vector<SCA_ISensor *> &SCA_IController::GetLinkedSensors()
 {
   return m_linkedsensors;
@@ -127,6 +166,14 @@ void SCA_IController::UnlinkSensor(SCA_ISensor *sensor)
 void SCA_IController::SetState(unsigned int state)
 {
   m_statemask = state;
+  if (m_gameobj) {
+    m_gameobj->InvalidateStateControllers();
+  }
+}
+
+unsigned int SCA_IController::GetStateMask() const
+{
+  return m_statemask;
 }
 
 void SCA_IController::ApplyState(unsigned int state)
@@ -47,12 +47,29 @@ class SCA_IController : public SCA_ILogicBrick {
   unsigned int m_statemask;
   bool m_justActivated;
   bool m_bookmark;
+  /// Result computed ahead by the logic manager, see SCA_LogicManager::EvaluateControllers.
+  bool m_evaluatedResult;
+  unsigned int m_evaluationId;
 
  public:
   SCA_IController(SCA_IObject *gameobj);
   virtual ~SCA_IController();
 
   virtual void Trigger(SCA_LogicManager *logicmgr) = 0;
+  /** Return true if the result of the controller only depends on its linked sensors,
+   * Evaluate can then be called from any thread.
+   */
+  virtual bool IsThreadSafe() const;
+  /// Compute the event sent to the linked actuators, only for thread safe controllers.
+  virtual bool Evaluate() const;
+  /// Send an event to all the linked actuators.
+  void TriggerActuators(SCA_LogicManager *logicmgr, bool result);
+
+  void SetEvaluatedResult(bool result, unsigned int evaluationId);
+  /** Trigger the actuators with the result evaluated ahead for this evaluation if any.
+   * \return False if there was no evaluated result.
+   */
+  bool TriggerEvaluatedResult(SCA_LogicManager *logicmgr, unsigned int evaluationId);
 
   void LinkToSensor(SCA_ISensor *sensor);
   void LinkToActuator(SCA_IActuator *);
@@ -63,6 +80,7 @@ class SCA_IController : public SCA_ILogicBrick {
   void UnlinkActuator(SCA_IActuator *actua);
   void UnlinkSensor(SCA_ISensor *sensor);
   void SetState(unsigned int state);
+  unsigned int GetStateMask() const;
   void ApplyState(unsigned int state);
   void Deactivate();
   bool IsJustActivated();
@@ -111,7 +111,7 @@ static std::map<SCA_IInputDevice::SCA_EnumInputs, std::pair<char, char>> createK
 std::map<SCA_IInputDevice::SCA_EnumInputs, std::pair<char, char>> SCA_IInputDevice::m_keyToChar =
     createKeyToCharMap();
 
-SCA_IInputDevice::SCA_IInputDevice() : m_hookExitKey(false)
+SCA_IInputDevice::SCA_IInputDevice() : m_hookExitKey(false), m_eventTime(0.0)
 {
   for (int i = 0; i < SCA_IInputDevice::MAX_KEYS; ++i) {
     m_inputsTable[i] = SCA_InputEvent(i);
@@ -160,10 +160,16 @@ void SCA_IInputDevice::ReleaseMoveEvent()
       event.m_status.pop_back();
       event.m_status.push_back(SCA_InputEvent::NONE);
       event.m_queue.push_back(SCA_InputEvent::JUSTRELEASED);
+      event.m_times.push_back(m_eventTime);
     }
   }
 }
 
+void SCA_IInputDevice::ProcessEvents(double time)
+{
+  m_eventTime = time;
+}
+
 const std::wstring &SCA_IInputDevice::GetText() const
 {
   return m_text;
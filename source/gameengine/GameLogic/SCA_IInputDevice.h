@@ -213,6 +213,9 @@ class SCA_IInputDevice {
   /// True when a sensor handle the same key as the exit key.
   bool m_hookExitKey;
 
+  /// Time in seconds of the events being converted, stored in SCA_InputEvent::m_times.
+  double m_eventTime;
+
   /** Translation table used to get the character from a key number with shift or not.
    * Key -> (Character, Character shifted)
    */
@@ -236,6 +239,11 @@ class SCA_IInputDevice {
    */
   virtual void ReleaseMoveEvent();
 
+  /** Convert the events received since the last call, called just before the logic.
+   * \param time The current time in seconds, used for the events without time.
+   */
+  virtual void ProcessEvents(double time);
+
   /// Return typed unicode text during a frame.
   const std::wstring &GetText() const;
 
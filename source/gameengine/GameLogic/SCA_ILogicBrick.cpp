@@ -30,6 +30,7 @@
  */
 
 #include "SCA_ILogicBrick.h"
+#include "SCA_BrickArena.h"
 
 SCA_ILogicBrick::SCA_ILogicBrick(SCA_IObject *gameobj)
     : EXP_Value(),
@@ -47,6 +48,16 @@ SCA_ILogicBrick::~SCA_ILogicBrick()
   RemoveEvent();
 }
 
+void *SCA_ILogicBrick::operator new(size_t size)
+{
+  return SCA_BrickArena::Allocate(size);
+}
+
+void SCA_ILogicBrick::operator delete(void *ptr)
+{
+  SCA_BrickArena::Free(ptr);
+}
+
 void SCA_ILogicBrick::SetExecutePriority(int execute_Priority)
 {
   m_Execute_Priority = execute_Priority;
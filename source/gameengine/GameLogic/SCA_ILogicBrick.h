@@ -55,6 +55,10 @@ class SCA_ILogicBrick : public EXP_Value, public SG_QList {
   SCA_ILogicBrick(SCA_IObject *gameobj);
   virtual ~SCA_ILogicBrick();
 
+  /// The bricks are allocated by SCA_BrickArena.
+  static void *operator new(size_t size);
+  static void operator delete(void *ptr);
+
   void SetExecutePriority(int execute_Priority);
   void SetUeberExecutePriority(int execute_Priority);
 
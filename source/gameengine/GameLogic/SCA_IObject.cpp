@@ -31,6 +31,10 @@
 
 #include "SCA_IObject.h"
 
+#include <algorithm>
+#include <cstdint>
+
+#include "SCA_BrickArena.h"
 #include "SCA_IActuator.h"
 #include "SCA_ISensor.h"
 
@@ -39,10 +43,12 @@ SG_QList SCA_IObject::m_activeBookmarkedControllers;
 SCA_IObject::SCA_IObject()
     : KX_PythonProxy(),
       m_logicSuspended(false),
+      m_logicInterval(1),
       m_initState(0),
       m_state(0),
       m_backupState(0),
-      m_firstState(nullptr)
+      m_firstState(nullptr),
+      m_stateControllersValid(false)
 {
 }
 
@@ -112,6 +118,7 @@ void SCA_IObject::AddController(SCA_IController *act)
 {
   act->AddRef();
   m_controllers.push_back(act);
+  m_stateControllersValid = false;
 }
 
 void SCA_IObject::ReserveController(int num)
@@ -176,6 +183,19 @@ bool SCA_IObject::UnlinkObject(SCA_IObject *clientobj)
 
 void SCA_IObject::ReParentLogic()
 {
+  // Allocate the bricks of the replica in one block, as close as the object is iterated.
+  size_t bricksSize = 0;
+  for (SCA_IActuator *actuator : m_actuators) {
+    bricksSize += SCA_BrickArena::GetAllocationSize(dynamic_cast<void *>(actuator));
+  }
+  for (SCA_IController *controller : m_controllers) {
+    bricksSize += SCA_BrickArena::GetAllocationSize(dynamic_cast<void *>(controller));
+  }
+  for (SCA_ISensor *sensor : m_sensors) {
+    bricksSize += SCA_BrickArena::GetAllocationSize(dynamic_cast<void *>(sensor));
+  }
+  SCA_BrickArena::Scope arenaScope(bricksSize);
+
   SCA_ActuatorList &oldactuators = GetActuators();
   for (unsigned short i = 0, size = oldactuators.size(); i < size; ++i) {
     SCA_IActuator *newactuator = static_cast<SCA_IActuator *>(oldactuators[i]->GetReplica());
@@ -194,6 +214,8 @@ void SCA_IObject::ReParentLogic()
     newcontroller->SetActive(false);
     oldcontrollers[i] = newcontroller;
   }
+  // The index holds the controllers of the original object.
+  m_stateControllersValid = false;
   // Convert sensors last so that actuators are already available for Actuator sensor
   SCA_SensorList &oldsensors = GetSensors();
   for (unsigned short i = 0, size = oldsensors.size(); i < size; ++i) {
@@ -240,6 +262,27 @@ SCA_IActuator *SCA_IObject::FindActuator(const std::string &actuatorname)
   return nullptr;
 }
 
+void SCA_IObject::SetLogicInterval(unsigned short interval)
+{
+  m_logicInterval = std::max(interval, (unsigned short)1);
+}
+
+unsigned short SCA_IObject::GetLogicInterval() const
+{
+  return m_logicInterval;
+}
+
+bool SCA_IObject::IsLogicFrameSkipped(unsigned int frame) const
+{
+  if (m_logicInterval <= 1) {
+    return false;
+  }
+
+  // Offset the frames by the address to spread the objects with the same interval.
+  const uintptr_t phase = ((uintptr_t)this) >> 4;
+  return (((frame + phase) % m_logicInterval) != 0);
+}
+
 void SCA_IObject::SuspendLogic()
 {
   if (!m_logicSuspended) {
@@ -285,19 +328,72 @@ void SCA_IObject::SetState(unsigned int state)
    * that are switching state: no need to deactive and reactive the sensor
    */
 
+  /* A controller is active when its mask intersects the state, only the controllers of the
+   * changed bits can be (de)activated. */
   const unsigned int tmpstate = m_state | state;
   if (tmpstate != m_state) {
     // Update the status of the controllers.
-    for (SCA_IController *controller : m_controllers) {
-      controller->ApplyState(tmpstate);
-    }
+    ApplyStateControllers(tmpstate & ~m_state, tmpstate);
   }
+  const unsigned int clearedBits = tmpstate & ~state;
   m_state = state;
-  if (m_state != tmpstate) {
-    for (SCA_IController *controller : m_controllers) {
-      controller->ApplyState(m_state);
+  if (clearedBits) {
+    ApplyStateControllers(clearedBits, m_state);
+  }
+}
+
+void SCA_IObject::BuildStateControllers()
+{
+  unsigned int counts[32] = {0};
+  for (SCA_IController *controller : m_controllers) {
+    const unsigned int mask = controller->GetStateMask();
+    for (unsigned int bit = 0; bit < 32; ++bit) {
+      if (mask & (1u << bit)) {
+        ++counts[bit];
+      }
     }
   }
+
+  m_stateControllersOffsets[0] = 0;
+  for (unsigned int bit = 0; bit < 32; ++bit) {
+    m_stateControllersOffsets[bit + 1] = m_stateControllersOffsets[bit] + counts[bit];
+  }
+
+  // Fill each range in the order of the controllers, as the full walk did.
+  m_stateControllers.resize(m_stateControllersOffsets[32]);
+  unsigned int fill[32];
+  std::copy(m_stateControllersOffsets, m_stateControllersOffsets + 32, fill);
+  for (SCA_IController *controller : m_controllers) {
+    const unsigned int mask = controller->GetStateMask();
+    for (unsigned int bit = 0; bit < 32; ++bit) {
+      if (mask & (1u << bit)) {
+        m_stateControllers[fill[bit]++] = controller;
+      }
+    }
+  }
+
+  m_stateControllersValid = true;
+}
+
+void SCA_IObject::ApplyStateControllers(unsigned int bits, unsigned int state)
+{
+  if (!m_stateControllersValid) {
+    BuildStateControllers();
+  }
+
+  for (unsigned int bit = 0; bit < 32; ++bit) {
+    if (bits & (1u << bit)) {
+      const unsigned int end = m_stateControllersOffsets[bit + 1];
+      for (unsigned int i = m_stateControllersOffsets[bit]; i < end; ++i) {
+        m_stateControllers[i]->ApplyState(state);
+      }
+    }
+  }
+}
+
+void SCA_IObject::InvalidateStateControllers()
+{
+  m_stateControllersValid = false;
 }
 
 unsigned int SCA_IObject::GetState()
@@ -86,6 +86,9 @@ class SCA_IObject : public KX_PythonProxy {
   /// Ignore updates?
   bool m_logicSuspended;
 
+  /// The sensors and components run every this number of logic frames.
+  unsigned short m_logicInterval;
+
   /// Init state of object (used when object is created).
   unsigned int m_initState;
 
@@ -98,6 +101,18 @@ class SCA_IObject : public KX_PythonProxy {
   /// Pointer inside state actuator list for sorting.
   SG_QList *m_firstState;
 
+  /** Controllers indexed by state bit, a controller is in the range of each bit of its state
+   * mask. A state change only applies to the controllers of the changed bits.
+   */
+  std::vector<SCA_IController *> m_stateControllers;
+  /// Start of the range of each state bit in m_stateControllers, the last is the end.
+  unsigned int m_stateControllersOffsets[33];
+  bool m_stateControllersValid;
+
+  void BuildStateControllers();
+  /// Apply a state to the controllers of some state bits.
+  void ApplyStateControllers(unsigned int bits, unsigned int state);
+
  public:
   SCA_IObject();
   virtual ~SCA_IObject();
@@ -135,6 +150,13 @@ class SCA_IObject : public KX_PythonProxy {
 
   /// Suspend all progress.
   void SuspendLogic(void);
+  /** Run the sensors and components only every number of logic frames, 1 to run them every
+   * frame. The actuators still run every frame.
+   */
+  void SetLogicInterval(unsigned short interval);
+  unsigned short GetLogicInterval() const;
+  /// Return true if the sensors and components don't run in a logic frame.
+  bool IsLogicFrameSkipped(unsigned int frame) const;
 
   /// Resume progress.
   void ResumeLogic(void);
@@ -150,6 +172,8 @@ class SCA_IObject : public KX_PythonProxy {
 
   /// Get the object state.
   unsigned int GetState();
+  /// Index the controllers per state again at the next state change.
+  void InvalidateStateControllers();
 
   SG_QList **GetFirstState();
   void SetFirstState(SG_QList *firstState);
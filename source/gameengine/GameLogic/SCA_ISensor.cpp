@@ -58,7 +58,8 @@ SCA_ISensor::SCA_ISensor(SCA_IObject *gameobj, SCA_EventManager *eventmgr)
       m_suspended(false),
       m_links(0),
       m_state(false),
-      m_prev_state(false)
+      m_prev_state(false),
+      m_pulsePhasePending(false)
 {
 }
 
@@ -194,6 +195,7 @@ void SCA_ISensor::RegisterToManager()
   // sensor is just activated, initialize it
   Init();
   m_state = false;
+  m_pulsePhasePending = true;
   m_eventmgr->RegisterSensor(this);
 }
 
@@ -249,13 +251,53 @@ void SCA_ISensor::ActivateControllers(class SCA_LogicManager *logicmgr)
   }
 }
 
+bool SCA_ISensor::HasInputChanged()
+{
+  return true;
+}
+
+void SCA_ISensor::AddRayCasts(KX_RayCastBatch &UNUSED(batch))
+{
+}
+
 void SCA_ISensor::Activate(class SCA_LogicManager *logicmgr)
 {
   /* Calculate if a __triggering__ is wanted
    * don't evaluate a sensor that is not connected to any controller
    */
   if (m_links && !m_suspended) {
-    bool result = this->Evaluate();
+    // The object runs its logic at a lower rate, see KX_GameObject::UpdateActivity.
+    if (m_gameobj->IsLogicFrameSkipped(logicmgr->GetFrame())) {
+      return;
+    }
+
+    /* The sensors registered together, e.g. the replicas of an object, would all pulse on the
+     * same frames, offset their pulse counters. */
+    if (m_pulsePhasePending) {
+      if ((m_pos_pulsemode || m_neg_pulsemode) && m_skipped_ticks > 0 &&
+          logicmgr->GetStaggeredPulses()) {
+        m_pos_ticks = m_neg_ticks = logicmgr->NextPulsePhase(m_skipped_ticks);
+      }
+      m_pulsePhasePending = false;
+    }
+
+    /* Without pulse, tap and level modes a sensor with unchanged inputs and the same
+     * state than in the previous frame can't trigger, its evaluation is skipped. */
+    if (!m_pos_pulsemode && !m_neg_pulsemode && !m_tap && !m_level && m_prev_state == m_state &&
+        !HasInputChanged()) {
+      return;
+    }
+
+    SCA_ObjectProfiler &profiler = logicmgr->GetObjectProfiler();
+    bool result;
+    if (profiler.GetEnabled()) {
+      const double startTime = SCA_ObjectProfiler::GetTime();
+      result = this->Evaluate();
+      profiler.AddTime(GetParent(), SCA_ObjectProfiler::CATEGORY_SENSORS, startTime);
+    }
+    else {
+      result = this->Evaluate();
+    }
     // store the state for the rest of the logic system
     m_prev_state = m_state;
     m_state = this->IsPositiveTrigger();
@@ -35,6 +35,7 @@
 
 #include "SCA_IController.h"
 
+class KX_RayCastBatch;
 class SCA_EventManager;
 
 /**
@@ -87,6 +88,9 @@ class SCA_ISensor : public SCA_ILogicBrick {
   /// Previous state (for tap option).
   bool m_prev_state;
 
+  /// The pulse phase is chosen at the next activation, see SCA_LogicManager::NextPulsePhase.
+  bool m_pulsePhasePending;
+
   std::vector<SCA_IController *> m_linkedcontrollers;
 
  public:
@@ -95,6 +99,7 @@ class SCA_ISensor : public SCA_ILogicBrick {
     ST_TOUCH,
     ST_NEAR,
     ST_RADAR,
+    ST_MESSAGE,
     // to be updated as needed
   };
 
@@ -111,6 +116,15 @@ class SCA_ISensor : public SCA_ILogicBrick {
   virtual bool Evaluate() = 0;
   virtual bool IsPositiveTrigger();
   virtual void Init();
+  /** Return false if the data read by Evaluate didn't change since the last evaluation,
+   * Evaluate would then return false and keep the same trigger state.
+   */
+  virtual bool HasInputChanged();
+  /** Add the rays of the next evaluation to a batch, the event managers cast the batch before
+   * activating their sensors and Evaluate then uses the results instead of casting the rays.
+   * A sensor only adds its rays if it is linked and not suspended.
+   */
+  virtual void AddRayCasts(KX_RayCastBatch &batch);
 
   virtual EXP_Value *GetReplica() = 0;
 
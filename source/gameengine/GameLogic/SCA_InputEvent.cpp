@@ -58,6 +58,7 @@ void SCA_InputEvent::Clear()
   m_values.push_back(value);
 
   m_queue.clear();
+  m_times.clear();
 }
 
 bool SCA_InputEvent::Find(SCA_EnumInputs inputenum) const
@@ -130,6 +131,7 @@ PyMethodDef SCA_InputEvent::Methods[] = {
 PyAttributeDef SCA_InputEvent::Attributes[] = {
     EXP_PYATTRIBUTE_RO_FUNCTION("status", SCA_InputEvent, pyattr_get_status),
     EXP_PYATTRIBUTE_RO_FUNCTION("queue", SCA_InputEvent, pyattr_get_queue),
+    EXP_PYATTRIBUTE_RO_FUNCTION("times", SCA_InputEvent, pyattr_get_times),
     EXP_PYATTRIBUTE_RO_FUNCTION("values", SCA_InputEvent, pyattr_get_values),
     EXP_PYATTRIBUTE_RO_FUNCTION("inactive", SCA_InputEvent, pyattr_get_inactive),
     EXP_PYATTRIBUTE_RO_FUNCTION("active", SCA_InputEvent, pyattr_get_active),
@@ -187,6 +189,30 @@ PyObject *SCA_InputEvent::pyattr_get_queue(EXP_PyObjectPlus *self_v,
       ->NewProxy(true);
 }
 
+int SCA_InputEvent::get_times_size_cb(void *self_v)
+{
+  return ((SCA_InputEvent *)self_v)->m_times.size();
+}
+
+PyObject *SCA_InputEvent::get_times_item_cb(void *self_v, int index)
+{
+  return PyFloat_FromDouble(((SCA_InputEvent *)self_v)->m_times[index]);
+}
+
+PyObject *SCA_InputEvent::pyattr_get_times(EXP_PyObjectPlus *self_v,
+                                           const EXP_PYATTRIBUTE_DEF *attrdef)
+{
+  return (new EXP_ListWrapper(self_v,
+                              ((SCA_InputEvent *)self_v)->GetProxy(),
+                              nullptr,
+                              SCA_InputEvent::get_times_size_cb,
+                              SCA_InputEvent::get_times_item_cb,
+                              nullptr,
+                              nullptr,
+                              EXP_ListWrapper::FLAG_FIND_VALUE))
+      ->NewProxy(true);
+}
+
 int SCA_InputEvent::get_values_size_cb(void *self_v)
 {
   return ((SCA_InputEvent *)self_v)->m_values.size();
@@ -56,6 +56,8 @@ class SCA_InputEvent : public EXP_Value {
   std::vector<SCA_EnumInputs> m_status;
   /// All recorded event for this input during a frame, can contain none value.
   std::vector<SCA_EnumInputs> m_queue;
+  /// Time in seconds of each recorded event, see bge.logic.getRealTime().
+  std::vector<double> m_times;
   /// All recorded values of this input (used for mouse), always contains one value.
   std::vector<int> m_values;
   /// Keyboard unicode value.
@@ -68,11 +70,14 @@ class SCA_InputEvent : public EXP_Value {
   static PyObject *get_status_item_cb(void *self_v, int index);
   static int get_queue_size_cb(void *self_v);
   static PyObject *get_queue_item_cb(void *self_v, int index);
+  static int get_times_size_cb(void *self_v);
+  static PyObject *get_times_item_cb(void *self_v, int index);
   static int get_values_size_cb(void *self_v);
   static PyObject *get_values_item_cb(void *self_v, int index);
 
   static PyObject *pyattr_get_status(EXP_PyObjectPlus *self_v, const EXP_PYATTRIBUTE_DEF *attrdef);
   static PyObject *pyattr_get_queue(EXP_PyObjectPlus *self_v, const EXP_PYATTRIBUTE_DEF *attrdef);
+  static PyObject *pyattr_get_times(EXP_PyObjectPlus *self_v, const EXP_PYATTRIBUTE_DEF *attrdef);
   static PyObject *pyattr_get_values(EXP_PyObjectPlus *self_v, const EXP_PYATTRIBUTE_DEF *attrdef);
   static PyObject *pyattr_get_inactive(EXP_PyObjectPlus *self_v,
                                        const EXP_PYATTRIBUTE_DEF *attrdef);
@@ -32,10 +32,21 @@
 
 #include "SCA_LogicManager.h"
 
+#include "BLI_task.h"
+#include "BLI_utildefines.h"
+
 #include "SCA_ISensor.h"
 #include "SCA_PythonController.h"
 
+/// Minimum number of thread safe controllers to evaluate them in parallel.
+static const unsigned int parallelControllersThreshold = 256;
+
 SCA_LogicManager::SCA_LogicManager()
+    : m_parallelControllers(false),
+      m_staggeredPulses(false),
+      m_pulsePhase(0),
+      m_frame(0),
+      m_evaluationId(0)
 {
 }
 
@@ -54,10 +65,18 @@ void SCA_LogicManager::RegisterEventManager(SCA_EventManager *eventmgr)
   m_eventmanagers.push_back(eventmgr);
 }
 
+/// Return the value registered with a key, nullptr if the key isn't registered.
+template<class Map>
+static typename Map::mapped_type find_registered(const Map &map,
+                                                 const typename Map::key_type &key)
+{
+  const typename Map::const_iterator it = map.find(key);
+  return (it != map.end()) ? it->second : nullptr;
+}
+
 void SCA_LogicManager::RegisterGameObjectName(const std::string &gameobjname, EXP_Value *gameobj)
 {
-  std::string mn = gameobjname;
-  m_mapStringToGameObjects[mn] = gameobj;
+  m_mapStringToGameObjects[gameobjname] = gameobj;
 }
 
 void SCA_LogicManager::UnregisterGameObjectName(const std::string &gameobjname)
@@ -67,8 +86,7 @@ void SCA_LogicManager::UnregisterGameObjectName(const std::string &gameobjname)
 
 void SCA_LogicManager::RegisterGameMeshName(const std::string &gamemeshname, void *blendobj)
 {
-  std::string mn = gamemeshname;
-  m_map_gamemeshname_to_blendobj[mn] = blendobj;
+  m_map_gamemeshname_to_blendobj[gamemeshname] = blendobj;
 }
 
 void SCA_LogicManager::RegisterGameObj(void *blendobj, EXP_Value *gameobj)
@@ -78,7 +96,8 @@ void SCA_LogicManager::RegisterGameObj(void *blendobj, EXP_Value *gameobj)
 
 void SCA_LogicManager::UnregisterGameObj(void *blendobj, EXP_Value *gameobj)
 {
-  std::map<void *, EXP_Value *>::iterator it = m_map_blendobj_to_gameobj.find(blendobj);
+  std::unordered_map<void *, EXP_Value *>::iterator it = m_map_blendobj_to_gameobj.find(
+      blendobj);
   if (it != m_map_blendobj_to_gameobj.end() && it->second == gameobj) {
     m_map_blendobj_to_gameobj.erase(it);
   }
@@ -86,19 +105,17 @@ void SCA_LogicManager::UnregisterGameObj(void *blendobj, EXP_Value *gameobj)
 
 EXP_Value *SCA_LogicManager::GetGameObjectByName(const std::string &gameobjname)
 {
-  std::string mn = gameobjname;
-  return m_mapStringToGameObjects[mn];
+  return find_registered(m_mapStringToGameObjects, gameobjname);
 }
 
 EXP_Value *SCA_LogicManager::FindGameObjByBlendObj(void *blendobj)
 {
-  return m_map_blendobj_to_gameobj[blendobj];
+  return find_registered(m_map_blendobj_to_gameobj, blendobj);
 }
 
 void *SCA_LogicManager::FindBlendObjByGameMeshName(const std::string &gamemeshname)
 {
-  std::string mn = gamemeshname;
-  return m_map_gamemeshname_to_blendobj[mn];
+  return find_registered(m_map_gamemeshname_to_blendobj, gamemeshname);
 }
 
 void SCA_LogicManager::RemoveSensor(SCA_ISensor *sensor)
@@ -133,23 +150,119 @@ void SCA_LogicManager::RegisterToActuator(SCA_IController *controller, SCA_IActu
   controller->LinkToActuator(actua);
 }
 
+static void evaluate_controller_task(void *__restrict userdata,
+                                     const int i,
+                                     const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  SCA_LogicManager::ControllerTaskData *data = (SCA_LogicManager::ControllerTaskData *)userdata;
+  SCA_IController *contr = data->controllers[i];
+  contr->SetEvaluatedResult(contr->Evaluate(), data->evaluationId);
+}
+
+bool SCA_LogicManager::EvaluateControllers()
+{
+  m_threadSafeControllers.clear();
+
+  SG_DList::iterator<SG_QList> io(m_triggeredControllerSet);
+  for (io.begin(); !io.end(); ++io) {
+    SG_QList::iterator<SCA_IController> ic(**io);
+    for (ic.begin(); !ic.end(); ++ic) {
+      SCA_IController *contr = *ic;
+      if (contr->IsThreadSafe()) {
+        m_threadSafeControllers.push_back(contr);
+      }
+    }
+  }
+
+  if (m_threadSafeControllers.size() < parallelControllersThreshold) {
+    return false;
+  }
+
+  ControllerTaskData data = {m_threadSafeControllers.data(), ++m_evaluationId};
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 64;
+  BLI_task_parallel_range(
+      0, m_threadSafeControllers.size(), &data, evaluate_controller_task, &settings);
+
+  return true;
+}
+
 void SCA_LogicManager::BeginFrame(double curtime, double fixedtime)
 {
+  ++m_frame;
+
   for (std::vector<SCA_EventManager *>::const_iterator ie = m_eventmanagers.begin();
        !(ie == m_eventmanagers.end());
        ie++)
     (*ie)->NextFrame(curtime, fixedtime);
 
+  /* The results are computed ahead, the actuators are then activated in the same
+   * order than without parallel evaluation. A controller deactivated in between by a
+   * state change is removed from the triggered list and its result ignored. */
+  const bool evaluated = m_parallelControllers && EvaluateControllers();
+
   for (SG_QList *obj = (SG_QList *)m_triggeredControllerSet.Remove(); obj != nullptr;
        obj = (SG_QList *)m_triggeredControllerSet.Remove()) {
     for (SCA_IController *contr = (SCA_IController *)obj->QRemove(); contr != nullptr;
          contr = (SCA_IController *)obj->QRemove()) {
-      contr->Trigger(this);
+      const bool profileObject = m_objectProfiler.GetEnabled();
+      const double objectStartTime = profileObject ? SCA_ObjectProfiler::GetTime() : 0.0;
+      if (!evaluated || !contr->TriggerEvaluatedResult(this, m_evaluationId)) {
+        if (m_scriptProfiler.GetEnabled() && !contr->IsThreadSafe()) {
+          const double startTime = SCA_ScriptProfiler::GetTime();
+          contr->Trigger(this);
+          m_scriptProfiler.AddCall(contr->GetParent()->GetName() + "/" + contr->GetName(),
+                                   startTime);
+        }
+        else {
+          contr->Trigger(this);
+        }
+      }
+      if (profileObject) {
+        m_objectProfiler.AddTime(
+            contr->GetParent(), SCA_ObjectProfiler::CATEGORY_CONTROLLERS, objectStartTime);
+      }
       contr->ClrJustActivated();
     }
   }
 }
 
+void SCA_LogicManager::SetParallelControllers(bool parallel)
+{
+  m_parallelControllers = parallel;
+}
+
+void SCA_LogicManager::SetStaggeredPulses(bool staggered)
+{
+  m_staggeredPulses = staggered;
+}
+
+bool SCA_LogicManager::GetStaggeredPulses() const
+{
+  return m_staggeredPulses;
+}
+
+int SCA_LogicManager::NextPulsePhase(int skippedTicks)
+{
+  return (m_pulsePhase++ % (unsigned int)(skippedTicks + 1));
+}
+
+unsigned int SCA_LogicManager::GetFrame() const
+{
+  return m_frame;
+}
+
+SCA_ScriptProfiler &SCA_LogicManager::GetScriptProfiler()
+{
+  return m_scriptProfiler;
+}
+
+SCA_ObjectProfiler &SCA_LogicManager::GetObjectProfiler()
+{
+  return m_objectProfiler;
+}
+
 void SCA_LogicManager::UpdateFrame(double curtime)
 {
   for (std::vector<SCA_EventManager *>::const_iterator ie = m_eventmanagers.begin();
@@ -167,7 +280,17 @@ void SCA_LogicManager::UpdateFrame(double curtime)
       SCA_IActuator *actua = *ia;
       // increment first to allow removal of inactive actuators.
       ++ia;
-      if (!actua->Update(curtime)) {
+      bool active;
+      if (m_objectProfiler.GetEnabled()) {
+        const double startTime = SCA_ObjectProfiler::GetTime();
+        active = actua->Update(curtime);
+        m_objectProfiler.AddTime(
+            actua->GetParent(), SCA_ObjectProfiler::CATEGORY_ACTUATORS, startTime);
+      }
+      else {
+        active = actua->Update(curtime);
+      }
+      if (!active) {
         // this actuator is not active anymore, remove
         actua->QDelink();
         actua->SetActive(false);
@@ -192,37 +315,27 @@ void SCA_LogicManager::UpdateFrame(double curtime)
 
 void *SCA_LogicManager::GetActionByName(const std::string &actname)
 {
-  std::string an = actname;
-  std::map<std::string, void *>::iterator it;
-  it = m_mapStringToActions.find(an);
-  if (it != m_mapStringToActions.end()) {
-    return m_mapStringToActions[an];
-  }
-  return nullptr;
+  return find_registered(m_mapStringToActions, actname);
 }
 
 void *SCA_LogicManager::GetMeshByName(const std::string &meshname)
 {
-  std::string mn = meshname;
-  return m_mapStringToMeshes[mn];
+  return find_registered(m_mapStringToMeshes, meshname);
 }
 
 void SCA_LogicManager::RegisterMeshName(const std::string &meshname, void *mesh)
 {
-  std::string mn = meshname;
-  m_mapStringToMeshes[mn] = mesh;
+  m_mapStringToMeshes[meshname] = mesh;
 }
 
 void SCA_LogicManager::UnregisterMeshName(const std::string &meshname, void *mesh)
 {
-  std::string mn = meshname;
-  m_mapStringToMeshes.erase(mn);
+  m_mapStringToMeshes.erase(meshname);
 }
 
 void SCA_LogicManager::RegisterActionName(const std::string &actname, void *action)
 {
-  std::string an = actname;
-  m_mapStringToActions[an] = action;
+  m_mapStringToActions[actname] = action;
 }
 
 void SCA_LogicManager::EndFrame()
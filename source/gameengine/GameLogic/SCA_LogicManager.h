@@ -37,6 +37,7 @@
 #include <list>
 #include <map>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "EXP_Value.h"
@@ -61,8 +62,18 @@ typedef std::map<class SCA_ISensor *, controllerlist> sensormap_t;
 #include "SCA_EventManager.h"
 #include "SCA_IActuator.h"
 #include "SCA_ILogicBrick.h"
+#include "SCA_ObjectProfiler.h"
+#include "SCA_ScriptProfiler.h"
 
 class SCA_LogicManager {
+ public:
+  /// Data of the parallel evaluation of the controllers.
+  struct ControllerTaskData {
+    class SCA_IController **controllers;
+    unsigned int evaluationId;
+  };
+
+ private:
   std::vector<class SCA_EventManager *> m_eventmanagers;
 
   // SG_DList: Head of objects having activated actuators
@@ -72,14 +83,36 @@ class SCA_LogicManager {
   //           element: SCA_IObject::m_activeControllers
   SG_DList m_triggeredControllerSet;
 
+  /// Evaluate the thread safe triggered controllers in parallel.
+  bool m_parallelControllers;
+  /// Start the pulses of the sensors at spread phases.
+  bool m_staggeredPulses;
+  /// Counter giving the pulse phase of the next activated sensor.
+  unsigned int m_pulsePhase;
+  /// Number of logic frames begun.
+  unsigned int m_frame;
+  /// Identifier of the last parallel evaluation of the controllers.
+  unsigned int m_evaluationId;
+  /// Thread safe triggered controllers of the current frame.
+  std::vector<class SCA_IController *> m_threadSafeControllers;
+  /// Timings of the controllers not thread safe and of the object components.
+  SCA_ScriptProfiler m_scriptProfiler;
+  SCA_ObjectProfiler m_objectProfiler;
+
   // need to find better way for this
   // also known as FactoryManager...
-  std::map<std::string, EXP_Value *> m_mapStringToGameObjects;
-  std::map<std::string, void *> m_mapStringToMeshes;
-  std::map<std::string, void *> m_mapStringToActions;
+  std::unordered_map<std::string, EXP_Value *> m_mapStringToGameObjects;
+  std::unordered_map<std::string, void *> m_mapStringToMeshes;
+  std::unordered_map<std::string, void *> m_mapStringToActions;
 
-  std::map<std::string, void *> m_map_gamemeshname_to_blendobj;
-  std::map<void *, EXP_Value *> m_map_blendobj_to_gameobj;
+  std::unordered_map<std::string, void *> m_map_gamemeshname_to_blendobj;
+  std::unordered_map<void *, EXP_Value *> m_map_blendobj_to_gameobj;
+
+  /** Compute the result of the triggered controllers not using Python in parallel,
+   * their actuators are still triggered in order by BeginFrame.
+   * \return True if the controller results were evaluated.
+   */
+  bool EvaluateControllers();
 
  public:
   SCA_LogicManager();
@@ -91,6 +124,17 @@ class SCA_LogicManager {
   void RegisterToActuator(SCA_IController *controller, class SCA_IActuator *actuator);
 
   void BeginFrame(double curtime, double fixedtime);
+  void SetParallelControllers(bool parallel);
+  void SetStaggeredPulses(bool staggered);
+  bool GetStaggeredPulses() const;
+  /** Return the pulse phase of a sensor with a number of skipped ticks, the phases of the
+   * sensors activated in turn are spread over the pulse period.
+   */
+  int NextPulsePhase(int skippedTicks);
+  /// Return the number of the current logic frame.
+  unsigned int GetFrame() const;
+  SCA_ScriptProfiler &GetScriptProfiler();
+  SCA_ObjectProfiler &GetObjectProfiler();
   void UpdateFrame(double curtime);
   void EndFrame();
   void AddActiveActuator(SCA_IActuator *actua, bool event)
@@ -117,11 +161,11 @@ class SCA_LogicManager {
   // for the scripting... needs a FactoryManager later (if we would have time... ;)
   void RegisterMeshName(const std::string &meshname, void *mesh);
   void UnregisterMeshName(const std::string &meshname, void *mesh);
-  std::map<std::string, void *> &GetMeshMap()
+  std::unordered_map<std::string, void *> &GetMeshMap()
   {
     return m_mapStringToMeshes;
   }
-  std::map<std::string, void *> &GetActionMap()
+  std::unordered_map<std::string, void *> &GetActionMap()
   {
     return m_mapStringToActions;
   }
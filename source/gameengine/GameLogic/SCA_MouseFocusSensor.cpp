@@ -85,6 +85,8 @@ void SCA_MouseFocusSensor::Init()
   m_hitObject = 0;
   m_hitObject_Last = nullptr;
   m_reset = true;
+  m_rayCastPending = false;
+  m_rayCastCamera = nullptr;
 
   m_hitPosition.setValue(0, 0, 0);
   m_prevTargetPoint.setValue(0, 0, 0);
@@ -250,7 +252,7 @@ bool SCA_MouseFocusSensor::NeedRayCast(KX_ClientObjectInfo *client, void *UNUSED
   return true;
 }
 
-bool SCA_MouseFocusSensor::ParentObjectHasFocusCamera(KX_Camera *cam)
+bool SCA_MouseFocusSensor::ComputeRay(KX_Camera *cam)
 {
   /* All screen handling in the gameengine is done by GL,
    * specifically the model/view and projection parts. The viewport
@@ -359,6 +361,15 @@ bool SCA_MouseFocusSensor::ParentObjectHasFocusCamera(KX_Camera *cam)
   m_prevTargetPoint.setValue(
       topoint[0] / topoint[3], topoint[1] / topoint[3], topoint[2] / topoint[3]);
 
+  return true;
+}
+
+bool SCA_MouseFocusSensor::ParentObjectHasFocusCamera(KX_Camera *cam)
+{
+  if (!ComputeRay(cam)) {
+    return false;
+  }
+
   /* 2. Get the object from PhysicsEnvironment */
   /* Shoot! Beware that the first argument here is an
    * ignore-object. We don't ignore anything... */
@@ -377,16 +388,63 @@ bool SCA_MouseFocusSensor::ParentObjectHasFocusCamera(KX_Camera *cam)
   return false;
 }
 
-bool SCA_MouseFocusSensor::ParentObjectHasFocus()
+void SCA_MouseFocusSensor::AddRayCasts(KX_RayCastBatch &batch)
 {
+  m_rayCastPending = false;
+  if (!m_links || m_suspended || !m_focusmode) {
+    return;
+  }
+
+  // The camera made active during the evaluation, see Evaluate.
+  KX_Camera *cam = m_kxscene->GetActiveCamera();
+  KX_Camera *overlayCam = m_kxscene->GetOverlayCamera();
+  if (overlayCam) {
+    Camera *blCam = (Camera *)overlayCam->GetBlenderObject()->data;
+    if (blCam->flag & GAME_CAM_OVERLAY_MOUSE_CONTROL) {
+      cam = overlayCam;
+    }
+  }
+
+  if (!cam) {
+    return;
+  }
+
   m_hitObject = 0;
   m_hitPosition.setValue(0, 0, 0);
   m_hitNormal.setValue(1, 0, 0);
 
+  if (ComputeRay(cam)) {
+    batch.Add(m_kxscene->GetPhysicsEnvironment(),
+              m_prevSourcePoint,
+              m_prevTargetPoint,
+              this,
+              cam->GetPhysicsController(),
+              true);
+    m_rayCastPending = true;
+    m_rayCastCamera = cam;
+  }
+}
+
+bool SCA_MouseFocusSensor::ParentObjectHasFocus()
+{
   KX_Camera *activecam = m_kxscene->GetActiveCamera();
 
-  if (ParentObjectHasFocusCamera(activecam))
-    return true;
+  if (m_rayCastPending && m_rayCastCamera == activecam) {
+    // The hit was reset before casting the batch.
+    m_rayCastPending = false;
+    if (m_hitObject) {
+      return true;
+    }
+  }
+  else {
+    m_rayCastPending = false;
+    m_hitObject = 0;
+    m_hitPosition.setValue(0, 0, 0);
+    m_hitNormal.setValue(1, 0, 0);
+
+    if (ParentObjectHasFocusCamera(activecam))
+      return true;
+  }
 
   EXP_ListValue<KX_Camera> *cameras = m_kxscene->GetCameraList();
   for (KX_Camera *cam : cameras) {
@@ -34,6 +34,7 @@
 
 #include "BLI_utildefines.h"
 
+#include "KX_RayCastBatch.h"
 #include "KX_Scene.h"
 #include "SCA_MouseSensor.h"
 
@@ -50,7 +51,7 @@ struct KX_ClientObjectInfo;
  *
  * - extend the valid modes?
  * - */
-class SCA_MouseFocusSensor : public SCA_MouseSensor {
+class SCA_MouseFocusSensor : public SCA_MouseSensor, public KX_RayCastBatch::Receiver {
 
   Py_Header
 
@@ -75,7 +76,8 @@ class SCA_MouseFocusSensor : public SCA_MouseSensor {
   }
   virtual EXP_Value *GetReplica()
   {
-    EXP_Value *replica = new SCA_MouseFocusSensor(*this);
+    SCA_MouseFocusSensor *replica = new SCA_MouseFocusSensor(*this);
+    replica->m_rayCastPending = false;
     // this will copy properties and so on...
     replica->ProcessReplica();
     return replica;
@@ -91,6 +93,8 @@ class SCA_MouseFocusSensor : public SCA_MouseSensor {
    */
   virtual bool Evaluate();
   virtual void Init();
+  /// Add the ray of the camera the mouse is computed in.
+  virtual void AddRayCasts(KX_RayCastBatch &batch);
 
   virtual bool IsPositiveTrigger()
   {
@@ -101,9 +105,9 @@ class SCA_MouseFocusSensor : public SCA_MouseSensor {
   };
 
   /// \see KX_RayCast
-  bool RayHit(KX_ClientObjectInfo *client, KX_RayCast *result, void *UNUSED(data));
+  virtual bool RayHit(KX_ClientObjectInfo *client, KX_RayCast *result, void *UNUSED(data));
   /// \see KX_RayCast
-  bool NeedRayCast(KX_ClientObjectInfo *client, void *UNUSED(data));
+  virtual bool NeedRayCast(KX_ClientObjectInfo *client, void *UNUSED(data));
 
   const MT_Vector3 &RaySource() const;
   const MT_Vector3 &RayTarget() const;
@@ -176,6 +180,18 @@ class SCA_MouseFocusSensor : public SCA_MouseSensor {
    */
   bool m_positive_event;
 
+  /**
+   * The ray of this camera was cast in a batch, its result is used by the next evaluation.
+   */
+  bool m_rayCastPending;
+  KX_Camera *m_rayCastCamera;
+
+  /**
+   * Compute the ray under the mouse for this camera, return false if the mouse is out of its
+   * viewport.
+   */
+  bool ComputeRay(KX_Camera *cam);
+
   /**
    * Tests whether the object is in mouse focus for this camera
    */
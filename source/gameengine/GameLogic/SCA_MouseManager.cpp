@@ -60,21 +60,28 @@ SCA_IInputDevice *SCA_MouseManager::GetInputDevice()
 void SCA_MouseManager::NextFrame()
 {
   if (m_mousedevice) {
+    const SCA_InputEvent &event1 = m_mousedevice->GetInput(SCA_IInputDevice::MOUSEX);
+    const SCA_InputEvent &event2 = m_mousedevice->GetInput(SCA_IInputDevice::MOUSEY);
+
+    // (0,0) is the Upper Left corner in our local window
+    // coordinates
+    int mx = event1.m_values[event1.m_values.size() - 1];
+    int my = event2.m_values[event2.m_values.size() - 1];
+
     for (SCA_ISensor *sensor : m_sensors) {
       SCA_MouseSensor *mousesensor = static_cast<SCA_MouseSensor *>(sensor);
-      // (0,0) is the Upper Left corner in our local window
-      // coordinates
       if (!mousesensor->IsSuspended()) {
-        const SCA_InputEvent &event1 = m_mousedevice->GetInput(SCA_IInputDevice::MOUSEX);
-        const SCA_InputEvent &event2 = m_mousedevice->GetInput(SCA_IInputDevice::MOUSEY);
-
-        int mx = event1.m_values[event1.m_values.size() - 1];
-        int my = event2.m_values[event2.m_values.size() - 1];
-
         mousesensor->setX(mx);
         mousesensor->setY(my);
+        // The focus sensors need the mouse position to compute their rays.
+        mousesensor->AddRayCasts(m_rayCastBatch);
+      }
+    }
+    m_rayCastBatch.Execute();
 
-        mousesensor->Activate(m_logicmgr);
+    for (SCA_ISensor *sensor : m_sensors) {
+      if (!sensor->IsSuspended()) {
+        sensor->Activate(m_logicmgr);
       }
     }
   }
@@ -33,11 +33,14 @@
 
 #pragma once
 
+#include "KX_RayCastBatch.h"
 #include "SCA_EventManager.h"
 #include "SCA_IInputDevice.h"
 
 class SCA_MouseManager : public SCA_EventManager {
   class SCA_IInputDevice *m_mousedevice;
+  /// Rays of the mouse focus sensors, cast together before their activation.
+  KX_RayCastBatch m_rayCastBatch;
 
  public:
   SCA_MouseManager(class SCA_LogicManager *logicmgr, class SCA_IInputDevice *mousedev);
@@ -49,9 +49,13 @@ SCA_NANDController::~SCA_NANDController()
 {
 }
 
-void SCA_NANDController::Trigger(SCA_LogicManager *logicmgr)
+bool SCA_NANDController::IsThreadSafe() const
 {
+  return true;
+}
 
+bool SCA_NANDController::Evaluate() const
+{
   bool sensorresult = false;
 
   for (SCA_ISensor *sensor : m_linkedsensors) {
@@ -61,9 +65,12 @@ void SCA_NANDController::Trigger(SCA_LogicManager *logicmgr)
     }
   }
 
-  for (SCA_IActuator *actuator : m_linkedactuators) {
-    logicmgr->AddActiveActuator(actuator, sensorresult);
-  }
+  return sensorresult;
+}
+
+void SCA_NANDController::Trigger(SCA_LogicManager *logicmgr)
+{
+  TriggerActuators(logicmgr, Evaluate());
 }
 
 EXP_Value *SCA_NANDController::GetReplica()
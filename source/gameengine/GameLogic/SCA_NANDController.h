@@ -40,6 +40,8 @@ class SCA_NANDController : public SCA_IController {
   virtual ~SCA_NANDController();
   virtual EXP_Value *GetReplica();
   virtual void Trigger(SCA_LogicManager *logicmgr);
+  virtual bool IsThreadSafe() const;
+  virtual bool Evaluate() const;
 
   /* --------------------------------------------------------------------- */
   /* Python interface ---------------------------------------------------- */
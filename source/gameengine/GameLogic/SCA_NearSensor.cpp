@@ -47,7 +47,8 @@ SCA_NearSensor::SCA_NearSensor(SCA_EventManager *eventmgr,
                                PHY_IPhysicsController *ctrl)
     : SCA_CollisionSensor(eventmgr, gameobj, bFindMaterial, false, touchedpropname),
       m_Margin(margin),
-      m_ResetMargin(resetmargin)
+      m_ResetMargin(resetmargin),
+      m_transformDirty(true)
 
 {
 
@@ -64,17 +65,36 @@ SCA_NearSensor::SCA_NearSensor(SCA_EventManager *eventmgr,
   SynchronizeTransform();
 }
 
+void SCA_NearSensor::SetPhysCtrlTransform(const MT_Vector3 &position,
+                                          const MT_Matrix3x3 &orientation)
+{
+  if (!m_physCtrl) {
+    return;
+  }
+
+  if (!m_transformDirty && position == m_lastPosition && orientation[0] == m_lastOrientation[0] &&
+      orientation[1] == m_lastOrientation[1] && orientation[2] == m_lastOrientation[2]) {
+    m_physCtrl->SetActive(false);
+    return;
+  }
+
+  PHY_IMotionState *motionState = m_physCtrl->GetMotionState();
+  motionState->SetWorldPosition(position);
+  motionState->SetWorldOrientation(orientation);
+  m_physCtrl->WriteMotionStateToDynamics(true);
+  m_physCtrl->SetActive(true);
+
+  m_lastPosition = position;
+  m_lastOrientation = orientation;
+  m_transformDirty = false;
+}
+
 void SCA_NearSensor::SynchronizeTransform()
 {
   // The near and radar sensors are using a different physical object which is
   // not linked to the parent object, must synchronize it.
-  if (m_physCtrl) {
-    PHY_IMotionState *motionState = m_physCtrl->GetMotionState();
-    KX_GameObject *parent = ((KX_GameObject *)GetParent());
-    motionState->SetWorldPosition(parent->NodeGetWorldPosition());
-    motionState->SetWorldOrientation(parent->NodeGetWorldOrientation());
-    m_physCtrl->WriteMotionStateToDynamics(true);
-  }
+  KX_GameObject *parent = ((KX_GameObject *)GetParent());
+  SetPhysCtrlTransform(parent->NodeGetWorldPosition(), parent->NodeGetWorldOrientation());
 }
 
 EXP_Value *SCA_NearSensor::GetReplica()
@@ -90,6 +110,7 @@ void SCA_NearSensor::ProcessReplica()
 
   m_client_info = new KX_ClientObjectInfo(m_client_info->m_gameobject,
                                           KX_ClientObjectInfo::SENSOR);
+  m_transformDirty = true;
 
   if (m_physCtrl) {
     m_physCtrl = m_physCtrl->GetReplicaForSensors();
@@ -107,6 +128,7 @@ void SCA_NearSensor::ReParent(SCA_IObject *parent)
   m_client_info->m_gameobject = static_cast<KX_GameObject *>(parent);
   m_client_info->m_sensors.push_back(this);
   // Synchronize here with the actual parent.
+  m_transformDirty = true;
   SynchronizeTransform();
 }
 
@@ -126,6 +148,9 @@ SCA_NearSensor::~SCA_NearSensor()
 
 void SCA_NearSensor::SetPhysCtrlRadius()
 {
+  // The contacts must be computed again with the new radius.
+  m_transformDirty = true;
+
   if (m_bTriggered) {
     if (m_physCtrl) {
       m_physCtrl->SetRadius(m_ResetMargin);
@@ -180,39 +205,14 @@ bool SCA_NearSensor::BroadPhaseFilterCollision(void *obj1, void *obj2)
   return false;
 }
 
-bool SCA_NearSensor::NewHandleCollision(void *obj1, void *obj2, const PHY_CollData *coll_data)
+KX_GameObject *SCA_NearSensor::FilterCollision(PHY_IPhysicsController *ctrl)
 {
-  //	KX_CollisionEventManager* toucheventmgr = static_cast<KX_CollisionEventManager*>(m_eventmgr);
-  //	KX_GameObject* parent = static_cast<KX_GameObject*>(GetParent());
-
   // need the mapping from PHY_IPhysicsController to gameobjects now
-
   KX_ClientObjectInfo *client_info = static_cast<KX_ClientObjectInfo *>(
-      obj1 == m_physCtrl ? ((PHY_IPhysicsController *)obj2)->GetNewClientInfo() :
-                           ((PHY_IPhysicsController *)obj1)->GetNewClientInfo());
-
-  KX_GameObject *gameobj = (client_info ? client_info->m_gameobject : nullptr);
-
-  // Add the same check as in SCA_ISensor::Activate(),
-  // we don't want to record collision when the sensor is not active.
-  if (m_links && !m_suspended &&
-      gameobj /* done in BroadPhaseFilterCollision() && (gameobj != parent)*/) {
-    if (!m_colliders->SearchValue(gameobj))
-      m_colliders->Add(CM_AddRef(gameobj));
-    // only take valid colliders
-    // These checks are done already in BroadPhaseFilterCollision()
-    // if (client_info->m_type == KX_ClientObjectInfo::ACTOR)
-    //{
-    //	if ((m_touchedpropname.empty()) ||
-    //		(gameobj->GetProperty(m_touchedpropname)))
-    //	{
-    m_bTriggered = true;
-    m_hitObject = gameobj;
-    //	}
-    //}
-  }
+      ctrl->GetNewClientInfo());
 
-  return false;  // was DT_CONTINUE; but this was defined in Sumo as false
+  // The parent, the type and the property are checked in BroadPhaseFilterCollision().
+  return (client_info ? client_info->m_gameobject : nullptr);
 }
 
 #ifdef WITH_PYTHON
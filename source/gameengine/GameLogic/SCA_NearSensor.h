@@ -33,6 +33,8 @@
 #pragma once
 
 #include "KX_ClientObjectInfo.h"
+#include "MT_Matrix3x3.h"
+#include "MT_Vector3.h"
 #include "SCA_CollisionSensor.h"
 
 class KX_Scene;
@@ -44,6 +46,17 @@ class SCA_NearSensor : public SCA_CollisionSensor {
 
   KX_ClientObjectInfo *m_client_info;
 
+  /// Last transform written to the physics controller.
+  MT_Vector3 m_lastPosition;
+  MT_Matrix3x3 m_lastOrientation;
+  /// The physics controller must be synchronized even if the transform didn't change.
+  bool m_transformDirty;
+
+  /** Write the sensor transform to its physics controller, a sensor keeping the same
+   * transform sleeps and reuses the contacts of its sleeping colliders.
+   */
+  void SetPhysCtrlTransform(const MT_Vector3 &position, const MT_Matrix3x3 &orientation);
+
  public:
   SCA_NearSensor(class SCA_EventManager *eventmgr,
                  class KX_GameObject *gameobj,
@@ -70,7 +83,7 @@ public:
   virtual bool Evaluate();
 
   virtual void ReParent(SCA_IObject *parent);
-  virtual bool NewHandleCollision(void *obj1, void *obj2, const PHY_CollData *coll_data);
+  virtual KX_GameObject *FilterCollision(PHY_IPhysicsController *ctrl);
   virtual bool BroadPhaseFilterCollision(void *obj1, void *obj2);
   virtual bool BroadPhaseSensorFilterCollision(void *obj1, void *obj2)
   {
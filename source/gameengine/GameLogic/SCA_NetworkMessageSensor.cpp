@@ -48,10 +48,12 @@ SCA_NetworkMessageSensor::SCA_NetworkMessageSensor(
     : SCA_ISensor(gameobj, eventmgr),
       m_NetworkScene(NetworkScene),
       m_subject(subject),
+      m_filter(0),
       m_frame_message_count(0),
       m_BodyList(nullptr),
       m_SubjectList(nullptr)
 {
+  UpdateFilter();
   Init();
 }
 
@@ -78,6 +80,19 @@ EXP_Value *SCA_NetworkMessageSensor::GetReplica()
   return replica;
 }
 
+void SCA_NetworkMessageSensor::ReParent(SCA_IObject *parent)
+{
+  SCA_ISensor::ReParent(parent);
+  UpdateFilter();
+}
+
+void SCA_NetworkMessageSensor::UpdateFilter()
+{
+  if (m_NetworkScene) {
+    m_filter = m_NetworkScene->RegisterFilter(GetParent()->GetName(), m_subject);
+  }
+}
+
 /// Return true only for flank (UP and DOWN)
 bool SCA_NetworkMessageSensor::Evaluate()
 {
@@ -96,15 +111,11 @@ bool SCA_NetworkMessageSensor::Evaluate()
     m_SubjectList = nullptr;
   }
 
-  std::string toname = GetParent()->GetName();
-  std::string &subject = this->m_subject;
-
-  const std::vector<KX_NetworkMessageManager::Message> messages = m_NetworkScene->FindMessages(
-      toname, subject);
+  m_NetworkScene->FindMessages(m_filter, m_messages);
 
-  m_frame_message_count = messages.size();
+  m_frame_message_count = m_messages.size();
 
-  if (!messages.empty()) {
+  if (!m_messages.empty()) {
 #ifdef NAN_NET_DEBUG
     std::cout << "SCA_NetworkMessageSensor found one or more messages" << std::endl;
 #endif
@@ -113,16 +124,13 @@ bool SCA_NetworkMessageSensor::Evaluate()
     m_SubjectList = new EXP_ListValue<EXP_StringValue>();
   }
 
-  std::vector<KX_NetworkMessageManager::Message>::const_iterator mesit;
-  for (mesit = messages.begin(); mesit != messages.end(); mesit++) {
+  for (const KX_NetworkMessageManager::Message &message : m_messages) {
     // save the body
-    const std::string &body = (*mesit).body;
+    const std::string body(message.body);
     // save the subject
-    const std::string &messub = (*mesit).subject;
+    const std::string messub(message.subject);
 #ifdef NAN_NET_DEBUG
-    if (body) {
-      cout << "body [" << body << "]\n";
-    }
+    cout << "body [" << body << "]\n";
 #endif
     m_BodyList->Add(new EXP_StringValue(body, "body"));
     // Store Subject
@@ -199,7 +207,8 @@ PyMethodDef SCA_NetworkMessageSensor::Methods[] = {
 };
 
 PyAttributeDef SCA_NetworkMessageSensor::Attributes[] = {
-    EXP_PYATTRIBUTE_STRING_RW("subject", 0, 100, false, SCA_NetworkMessageSensor, m_subject),
+    EXP_PYATTRIBUTE_STRING_RW_CHECK(
+        "subject", 0, 100, false, SCA_NetworkMessageSensor, m_subject, CheckSubject),
     EXP_PYATTRIBUTE_INT_RO("frameMessageCount", SCA_NetworkMessageSensor, m_frame_message_count),
     EXP_PYATTRIBUTE_RO_FUNCTION("bodies", SCA_NetworkMessageSensor, pyattr_get_bodies),
     EXP_PYATTRIBUTE_RO_FUNCTION("subjects", SCA_NetworkMessageSensor, pyattr_get_subjects),
@@ -230,4 +239,11 @@ PyObject *SCA_NetworkMessageSensor::pyattr_get_subjects(EXP_PyObjectPlus *self_v
   }
 }
 
+int SCA_NetworkMessageSensor::CheckSubject(EXP_PyObjectPlus *self, const PyAttributeDef *)
+{
+  SCA_NetworkMessageSensor *sensor = reinterpret_cast<SCA_NetworkMessageSensor *>(self);
+  sensor->UpdateFilter();
+  return 0;
+}
+
 #endif  // WITH_PYTHON
@@ -31,6 +31,7 @@
  */
 #pragma once
 
+#include "KX_NetworkMessageManager.h"
 #include "SCA_ISensor.h"
 
 class KX_NetworkMessageScene;
@@ -44,9 +45,15 @@ class SCA_NetworkMessageSensor : public SCA_ISensor {
   // The subject we filter on.
   std::string m_subject;
 
+  // The registered receiver name and subject, updated when one of them changes.
+  KX_NetworkMessageManager::FilterId m_filter;
+
   // The number of messages caught since the last frame.
   int m_frame_message_count;
 
+  // The messages caught since the last frame, kept to avoid allocations.
+  std::vector<KX_NetworkMessageManager::Message> m_messages;
+
   bool m_IsUp;
 
   EXP_ListValue<EXP_StringValue> *m_BodyList;
@@ -60,14 +67,24 @@ class SCA_NetworkMessageSensor : public SCA_ISensor {
   virtual ~SCA_NetworkMessageSensor();
 
   virtual EXP_Value *GetReplica();
+  virtual void ReParent(SCA_IObject *parent);
   virtual bool Evaluate();
   virtual bool IsPositiveTrigger();
   virtual void Init();
   void EndFrame();
 
+  virtual sensortype GetSensorType()
+  {
+    return ST_MESSAGE;
+  }
+
+  /// Register the filter of the messages again after a change of the parent name.
+  void UpdateFilter();
+
   virtual void Replace_NetworkScene(KX_NetworkMessageScene *val)
   {
     m_NetworkScene = val;
+    UpdateFilter();
   };
 
 #ifdef WITH_PYTHON
@@ -81,5 +98,7 @@ class SCA_NetworkMessageSensor : public SCA_ISensor {
   static PyObject *pyattr_get_subjects(EXP_PyObjectPlus *self_v,
                                        const EXP_PYATTRIBUTE_DEF *attrdef);
 
+  static int CheckSubject(EXP_PyObjectPlus *self, const PyAttributeDef *);
+
 #endif /* WITH_PYTHON */
 };
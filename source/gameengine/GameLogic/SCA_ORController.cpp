@@ -58,9 +58,13 @@ EXP_Value *SCA_ORController::GetReplica()
   return replica;
 }
 
-void SCA_ORController::Trigger(SCA_LogicManager *logicmgr)
+bool SCA_ORController::IsThreadSafe() const
 {
+  return true;
+}
 
+bool SCA_ORController::Evaluate() const
+{
   bool sensorresult = false;
 
   for (SCA_ISensor *sensor : m_linkedsensors) {
@@ -69,9 +73,12 @@ void SCA_ORController::Trigger(SCA_LogicManager *logicmgr)
     }
   }
 
-  for (SCA_IActuator *actuator : m_linkedactuators) {
-    logicmgr->AddActiveActuator(actuator, sensorresult);
-  }
+  return sensorresult;
+}
+
+void SCA_ORController::Trigger(SCA_LogicManager *logicmgr)
+{
+  TriggerActuators(logicmgr, Evaluate());
 }
 
 #ifdef WITH_PYTHON
@@ -41,4 +41,6 @@ class SCA_ORController : public SCA_IController {
   virtual ~SCA_ORController();
   virtual EXP_Value *GetReplica();
   virtual void Trigger(SCA_LogicManager *logicmgr);
+  virtual bool IsThreadSafe() const;
+  virtual bool Evaluate() const;
 };
@@ -0,0 +1,79 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/GameLogic/SCA_ObjectProfiler.cpp
+ *  \ingroup gamelogic
+ */
+
+#include "SCA_ObjectProfiler.h"
+
+#include "PIL_time.h"
+#include "SCA_IObject.h"
+
+static const char *categoryNames[SCA_ObjectProfiler::CATEGORY_MAX] = {
+    "Sensors", "Controllers", "Actuators", "Components", "Physics", "Transform"};
+
+SCA_ObjectProfiler::SCA_ObjectProfiler() : m_enabled(false)
+{
+}
+
+SCA_ObjectProfiler::~SCA_ObjectProfiler()
+{
+}
+
+bool SCA_ObjectProfiler::GetEnabled() const
+{
+  return m_enabled;
+}
+
+void SCA_ObjectProfiler::SetEnabled(bool enabled)
+{
+  if (enabled && !m_enabled) {
+    m_entries.clear();
+  }
+  m_enabled = enabled;
+}
+
+double SCA_ObjectProfiler::GetTime()
+{
+  return PIL_check_seconds_timer();
+}
+
+const char *SCA_ObjectProfiler::GetCategoryName(Category category)
+{
+  return categoryNames[category];
+}
+
+void SCA_ObjectProfiler::AddTime(SCA_IObject *object, Category category, double startTime)
+{
+  const double time = PIL_check_seconds_timer() - startTime;
+
+  // Zero initialized on insertion.
+  Entry &entry = m_entries[object->GetName()];
+  entry.m_times[category] += time;
+  entry.m_totalTime += time;
+}
+
+const SCA_ObjectProfiler::EntryMap &SCA_ObjectProfiler::GetEntries() const
+{
+  return m_entries;
+}
@@ -0,0 +1,82 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file SCA_ObjectProfiler.h
+ *  \ingroup gamelogic
+ */
+
+#pragma once
+
+#include <map>
+#include <string>
+
+class SCA_IObject;
+
+/** Time spent by each object in the logic, physics and transform synchronization.
+ * The times are accumulated by object name since the profiler was enabled, the
+ * replicas of an object are then measured together.
+ */
+class SCA_ObjectProfiler {
+ public:
+  enum Category {
+    CATEGORY_SENSORS = 0,
+    CATEGORY_CONTROLLERS,
+    CATEGORY_ACTUATORS,
+    CATEGORY_COMPONENTS,
+    CATEGORY_PHYSICS,
+    CATEGORY_TRANSFORM,
+    CATEGORY_MAX
+  };
+
+  struct Entry {
+    /// Cumulative time of each category in seconds.
+    double m_times[CATEGORY_MAX];
+    double m_totalTime;
+  };
+
+  typedef std::map<std::string, Entry> EntryMap;
+
+ private:
+  EntryMap m_entries;
+  bool m_enabled;
+
+ public:
+  SCA_ObjectProfiler();
+  ~SCA_ObjectProfiler();
+
+  bool GetEnabled() const;
+  /// Enable or disable the profiler, the times are cleared when the profiler is enabled.
+  void SetEnabled(bool enabled);
+
+  /// Return the current time used to measure a task.
+  static double GetTime();
+  /// Return the name of a category used in the profile report.
+  static const char *GetCategoryName(Category category);
+  /** Register the time spent by an object.
+   * \param object The object the time is attributed to.
+   * \param category The kind of task measured.
+   * \param startTime The time returned by GetTime when the task started.
+   */
+  void AddTime(SCA_IObject *object, Category category, double startTime);
+
+  const EntryMap &GetEntries() const;
+};
@@ -34,9 +34,7 @@
 
 #include "SCA_PropertyActuator.h"
 
-#include "EXP_ConstExpr.h"
 #include "EXP_InputParser.h"
-#include "EXP_Operator2Expr.h"
 
 /* ------------------------------------------------------------------------- */
 /* Native functions                                                          */
@@ -50,7 +48,9 @@ SCA_PropertyActuator::SCA_PropertyActuator(SCA_IObject *gameobj,
     : SCA_IActuator(gameobj, KX_ACT_PROPERTY),
       m_type(acttype),
       m_propname(propname),
+      m_propHandle(propname),
       m_exprtxt(expr),
+      m_exprCache(nullptr),
       m_sourceObj(sourceObj)
 {
   // protect ourselves against someone else deleting the source object
@@ -63,6 +63,23 @@ SCA_PropertyActuator::~SCA_PropertyActuator()
 {
   if (m_sourceObj)
     m_sourceObj->UnregisterActuator(this);
+  if (m_exprCache)
+    m_exprCache->Release();
+}
+
+// Forced deletion of the parsed expression to break the reference loop.
+void SCA_PropertyActuator::Delete()
+{
+  if (m_exprCache) {
+    m_exprCache->Release();
+    m_exprCache = nullptr;
+  }
+  Release();
+}
+
+EXP_Value *SCA_PropertyActuator::FindIdentifier(const std::string &identifiername)
+{
+  return GetParent()->FindIdentifier(identifiername);
 }
 
 bool SCA_PropertyActuator::Update()
@@ -76,7 +93,7 @@ bool SCA_PropertyActuator::Update()
   if (bNegativeEvent) {
     if (m_type == KX_ACT_PROP_LEVEL) {
       EXP_Value *newval = new EXP_BoolValue(false);
-      EXP_Value *oldprop = propowner->GetProperty(m_propname);
+      EXP_Value *oldprop = m_propHandle.Get(propowner);
       if (oldprop) {
         oldprop->SetValue(newval);
       }
@@ -85,15 +102,19 @@ bool SCA_PropertyActuator::Update()
     return false;
   }
 
-  EXP_Parser parser;
-  parser.SetContext(propowner->AddRef());
+  // Parse the expression once instead of at each update.
+  if (!m_exprCache && m_type != KX_ACT_PROP_TOGGLE && m_type != KX_ACT_PROP_LEVEL) {
+    EXP_Parser parser;
+    parser.SetContext(this->AddRef());
+    m_exprCache = parser.ProcessText(m_exprtxt);
+  }
 
   EXP_Expression *userexpr = nullptr;
 
   if (m_type == KX_ACT_PROP_TOGGLE) {
     /* don't use */
     EXP_Value *newval;
-    EXP_Value *oldprop = propowner->GetProperty(m_propname);
+    EXP_Value *oldprop = m_propHandle.Get(propowner);
     if (oldprop) {
       newval = new EXP_BoolValue((oldprop->GetNumber() == 0.0) ? true : false);
       oldprop->SetValue(newval);
@@ -106,7 +127,7 @@ bool SCA_PropertyActuator::Update()
   }
   else if (m_type == KX_ACT_PROP_LEVEL) {
     EXP_Value *newval = new EXP_BoolValue(true);
-    EXP_Value *oldprop = propowner->GetProperty(m_propname);
+    EXP_Value *oldprop = m_propHandle.Get(propowner);
     if (oldprop) {
       oldprop->SetValue(newval);
     }
@@ -115,13 +136,13 @@ bool SCA_PropertyActuator::Update()
     }
     newval->Release();
   }
-  else if ((userexpr = parser.ProcessText(m_exprtxt))) {
+  else if ((userexpr = m_exprCache)) {
     switch (m_type) {
 
       case KX_ACT_PROP_ASSIGN: {
 
         EXP_Value *newval = userexpr->Calculate();
-        EXP_Value *oldprop = propowner->GetProperty(m_propname);
+        EXP_Value *oldprop = m_propHandle.Get(propowner);
         if (oldprop) {
           oldprop->SetValue(newval);
         }
@@ -132,16 +153,14 @@ bool SCA_PropertyActuator::Update()
         break;
       }
       case KX_ACT_PROP_ADD: {
-        EXP_Value *oldprop = propowner->GetProperty(m_propname);
+        EXP_Value *oldprop = m_propHandle.Get(propowner);
         if (oldprop) {
-          // int waarde = (int)oldprop->GetNumber();  /*unused*/
-          EXP_Expression *expr = new EXP_Operator2Expr(
-              VALUE_ADD_OPERATOR, new EXP_ConstExpr(oldprop->AddRef()), userexpr->AddRef());
-
-          EXP_Value *newprop = expr->Calculate();
+          // Same as calculating the sum expression of the property and the value.
+          EXP_Value *value = userexpr->Calculate();
+          EXP_Value *newprop = oldprop->Calc(VALUE_ADD_OPERATOR, value);
           oldprop->SetValue(newprop);
           newprop->Release();
-          expr->Release();
+          value->Release();
         }
 
         break;
@@ -161,8 +180,6 @@ bool SCA_PropertyActuator::Update()
       default: {
       }
     }
-
-    userexpr->Release();
   }
 
   return result;
@@ -176,6 +193,7 @@ SCA_PropertyActuator::
 {
 
   SCA_PropertyActuator *replica = new SCA_PropertyActuator(*this);
+  replica->m_exprCache = nullptr;
 
   replica->ProcessReplica();
   return replica;
@@ -261,10 +279,39 @@ PyMethodDef SCA_PropertyActuator::Methods[] = {
     {nullptr, nullptr}  // Sentinel
 };
 
+int SCA_PropertyActuator::pyattr_check_prop_name(EXP_PyObjectPlus *self,
+                                                 const PyAttributeDef *attrdef)
+{
+  SCA_PropertyActuator *act = static_cast<SCA_PropertyActuator *>(self);
+  const int result = CheckProperty(self, attrdef);
+  if (result == 0) {
+    act->m_propHandle.SetName(act->m_propname);
+  }
+  return result;
+}
+
+int SCA_PropertyActuator::pyattr_check_value(EXP_PyObjectPlus *self,
+                                             const PyAttributeDef *attrdef)
+{
+  SCA_PropertyActuator *act = static_cast<SCA_PropertyActuator *>(self);
+  // Parse the new expression at the next update.
+  if (act->m_exprCache) {
+    act->m_exprCache->Release();
+    act->m_exprCache = nullptr;
+  }
+  return 0;
+}
+
 PyAttributeDef SCA_PropertyActuator::Attributes[] = {
+    EXP_PYATTRIBUTE_STRING_RW_CHECK("propName",
+                                    0,
+                                    MAX_PROP_NAME,
+                                    false,
+                                    SCA_PropertyActuator,
+                                    m_propname,
+                                    pyattr_check_prop_name),
     EXP_PYATTRIBUTE_STRING_RW_CHECK(
-        "propName", 0, MAX_PROP_NAME, false, SCA_PropertyActuator, m_propname, CheckProperty),
-    EXP_PYATTRIBUTE_STRING_RW("value", 0, 100, false, SCA_PropertyActuator, m_exprtxt),
+        "value", 0, 100, false, SCA_PropertyActuator, m_exprtxt, pyattr_check_value),
     EXP_PYATTRIBUTE_INT_RW("mode",
                            KX_ACT_PROP_NODEF + 1,
                            KX_ACT_PROP_MAX - 1,
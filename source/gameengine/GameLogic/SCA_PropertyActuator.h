@@ -31,8 +31,11 @@
 
 #pragma once
 
+#include "EXP_PropertyHandle.h"
 #include "SCA_IActuator.h"
 
+class EXP_Expression;
+
 class SCA_PropertyActuator : public SCA_IActuator {
   Py_Header
 
@@ -48,7 +51,13 @@ class SCA_PropertyActuator : public SCA_IActuator {
 
   int m_type;
   std::string m_propname;
+  /// Property m_propname resolved on the parent.
+  EXP_PropertyHandle m_propHandle;
   std::string m_exprtxt;
+  /** Expression parsed from m_exprtxt at the first update, the actuator is its context to
+   * resolve the identifiers on the parent.
+   */
+  EXP_Expression *m_exprCache;
   SCA_IObject *m_sourceObj;  // for copy property actuator
 
  public:
@@ -63,6 +72,8 @@ class SCA_PropertyActuator : public SCA_IActuator {
   EXP_Value *GetReplica();
 
   virtual void ProcessReplica();
+  virtual void Delete();
+  virtual EXP_Value *FindIdentifier(const std::string &identifiername);
   virtual bool UnlinkObject(SCA_IObject *clientobj);
   virtual void Relink(std::map<SCA_IObject *, SCA_IObject *> &obj_map);
 
@@ -71,4 +82,9 @@ class SCA_PropertyActuator : public SCA_IActuator {
   /* --------------------------------------------------------------------- */
   /* Python interface ---------------------------------------------------- */
   /* --------------------------------------------------------------------- */
+
+#ifdef WITH_PYTHON
+  static int pyattr_check_prop_name(EXP_PyObjectPlus *self, const PyAttributeDef *attrdef);
+  static int pyattr_check_value(EXP_PyObjectPlus *self, const PyAttributeDef *attrdef);
+#endif
 };
@@ -49,7 +49,12 @@ SCA_PropertySensor::SCA_PropertySensor(SCA_EventManager *eventmgr,
       m_checktype(checktype),
       m_checkpropval(propval),
       m_checkpropmaxval(propmaxval),
-      m_checkpropname(propname)
+      m_checkpropname(propname),
+      m_evaluatedProp(nullptr),
+      m_evaluatedPropVersion(0),
+      m_evaluatedPropertiesVersion(0),
+      m_evaluatedInvert(false),
+      m_evaluatedValid(false)
 {
   // EXP_Parser pars;
   // pars.SetContext(this->AddRef());
@@ -69,6 +74,7 @@ void SCA_PropertySensor::Init()
   m_recentresult = false;
   m_lastresult = m_invert ? true : false;
   m_reset = true;
+  m_evaluatedValid = false;
 }
 
 EXP_Value *SCA_PropertySensor::GetReplica()
@@ -94,10 +100,60 @@ SCA_PropertySensor::~SCA_PropertySensor()
 {
 }
 
+void SCA_PropertySensor::SaveEvaluatedVersions()
+{
+  SCA_IObject *parent = GetParent();
+  m_evaluatedPropertiesVersion = parent->GetPropertiesVersion();
+  m_evaluatedInvert = m_invert;
+  m_evaluatedProp = nullptr;
+  m_evaluatedValid = false;
+
+  // Sub properties are owned by other values which are not tracked.
+  if (m_checkpropname.find('.') != std::string::npos) {
+    return;
+  }
+
+  EXP_Value *prop = parent->GetProperty(m_checkpropname);
+  if (prop) {
+    // Only the basic values notify their changes, a list can be modified in place.
+    switch (prop->GetValueType()) {
+      case VALUE_INT_TYPE:
+      case VALUE_FLOAT_TYPE:
+      case VALUE_BOOL_TYPE:
+      case VALUE_STRING_TYPE: {
+        break;
+      }
+      default: {
+        return;
+      }
+    }
+    m_evaluatedProp = prop;
+    m_evaluatedPropVersion = prop->GetValueVersion();
+  }
+
+  m_evaluatedValid = true;
+}
+
+bool SCA_PropertySensor::HasInputChanged()
+{
+  if (!m_evaluatedValid || m_evaluatedInvert != m_invert ||
+      m_evaluatedPropertiesVersion != GetParent()->GetPropertiesVersion()) {
+    return true;
+  }
+
+  if (m_evaluatedProp && m_evaluatedProp->GetValueVersion() != m_evaluatedPropVersion) {
+    return true;
+  }
+
+  // A changed condition is true only for the frame of the change, it must become false.
+  return (m_checktype == KX_PROPSENSOR_CHANGED && m_lastresult);
+}
+
 bool SCA_PropertySensor::Evaluate()
 {
   bool result = CheckPropertyCondition();
   bool reset = m_reset && m_level;
+  SaveEvaluatedVersions();
 
   m_reset = false;
   if (m_lastresult != result) {
@@ -242,9 +298,24 @@ int SCA_PropertySensor::validValueForProperty(EXP_PyObjectPlus *self, const PyAt
    * function directly */
 
   /*  There is no type checking at this moment, unfortunately...           */
+  // The condition changed, the property must be checked again.
+  static_cast<SCA_PropertySensor *>(self)->m_evaluatedValid = false;
   return 0;
 }
 
+int SCA_PropertySensor::pyattr_check_mode(EXP_PyObjectPlus *self, const PyAttributeDef *)
+{
+  static_cast<SCA_PropertySensor *>(self)->m_evaluatedValid = false;
+  return 0;
+}
+
+int SCA_PropertySensor::pyattr_check_prop_name(EXP_PyObjectPlus *self,
+                                               const PyAttributeDef *attrdef)
+{
+  static_cast<SCA_PropertySensor *>(self)->m_evaluatedValid = false;
+  return CheckProperty(self, attrdef);
+}
+
 /* Integration hooks ------------------------------------------------------- */
 PyTypeObject SCA_PropertySensor::Type = {PyVarObject_HEAD_INIT(nullptr, 0) "SCA_PropertySensor",
                                          sizeof(EXP_PyObjectPlus_Proxy),
@@ -289,14 +360,20 @@ PyMethodDef SCA_PropertySensor::Methods[] = {
 };
 
 PyAttributeDef SCA_PropertySensor::Attributes[] = {
-    EXP_PYATTRIBUTE_INT_RW("mode",
-                           KX_PROPSENSOR_NODEF,
-                           KX_PROPSENSOR_MAX - 1,
-                           false,
-                           SCA_PropertySensor,
-                           m_checktype),
-    EXP_PYATTRIBUTE_STRING_RW_CHECK(
-        "propName", 0, MAX_PROP_NAME, false, SCA_PropertySensor, m_checkpropname, CheckProperty),
+    EXP_PYATTRIBUTE_INT_RW_CHECK("mode",
+                                 KX_PROPSENSOR_NODEF,
+                                 KX_PROPSENSOR_MAX - 1,
+                                 false,
+                                 SCA_PropertySensor,
+                                 m_checktype,
+                                 pyattr_check_mode),
+    EXP_PYATTRIBUTE_STRING_RW_CHECK("propName",
+                                    0,
+                                    MAX_PROP_NAME,
+                                    false,
+                                    SCA_PropertySensor,
+                                    m_checkpropname,
+                                    pyattr_check_prop_name),
     EXP_PYATTRIBUTE_STRING_RW_CHECK(
         "value", 0, 100, false, SCA_PropertySensor, m_checkpropval, validValueForProperty),
     EXP_PYATTRIBUTE_STRING_RW_CHECK(
@@ -45,6 +45,19 @@ class SCA_PropertySensor : public SCA_ISensor {
   bool m_lastresult;
   bool m_recentresult;
 
+  /** Versions of the parent properties and of the checked property read by the last
+   * evaluation, see HasInputChanged. The property is owned by the parent while the
+   * parent properties version is unchanged.
+   */
+  EXP_Value *m_evaluatedProp;
+  unsigned int m_evaluatedPropVersion;
+  unsigned int m_evaluatedPropertiesVersion;
+  bool m_evaluatedInvert;
+  /// The versions were saved by the last evaluation and the sensor settings didn't change.
+  bool m_evaluatedValid;
+
+  void SaveEvaluatedVersions();
+
  protected:
  public:
   enum KX_PROPSENSOR_TYPE {
@@ -75,6 +88,7 @@ class SCA_PropertySensor : public SCA_ISensor {
 
   virtual bool Evaluate();
   virtual bool IsPositiveTrigger();
+  virtual bool HasInputChanged();
   virtual EXP_Value *FindIdentifier(const std::string &identifiername);
 
 #ifdef WITH_PYTHON
@@ -87,6 +101,8 @@ class SCA_PropertySensor : public SCA_ISensor {
    * Test whether this is a sensible value (type check)
    */
   static int validValueForProperty(EXP_PyObjectPlus *self, const PyAttributeDef *);
+  static int pyattr_check_mode(EXP_PyObjectPlus *self, const PyAttributeDef *);
+  static int pyattr_check_prop_name(EXP_PyObjectPlus *self, const PyAttributeDef *attrdef);
 
 #endif
 };
@@ -44,6 +44,9 @@
 
 // initialize static member variables
 SCA_PythonController *SCA_PythonController::m_sCurrentController = nullptr;
+#ifdef WITH_PYTHON
+std::unordered_map<std::string, PyObject *> SCA_PythonController::m_sCodeCache;
+#endif
 
 SCA_PythonController::SCA_PythonController(SCA_IObject *gameobj, int mode)
     : SCA_IController(gameobj),
@@ -252,10 +255,24 @@ bool SCA_PythonController::Compile()
     m_bytecode = nullptr;
   }
 
+  // Controllers running the same script, e.g. replicated objects, share the bytecode.
+  std::string key = m_scriptName;
+  key += '\0';
+  key += m_scriptText;
+
+  std::unordered_map<std::string, PyObject *>::iterator it = m_sCodeCache.find(key);
+  if (it != m_sCodeCache.end()) {
+    m_bytecode = it->second;
+    Py_INCREF(m_bytecode);
+    return true;
+  }
+
   // recompile the scripttext into bytecode
   m_bytecode = Py_CompileString(m_scriptText.c_str(), m_scriptName.c_str(), Py_file_input);
 
   if (m_bytecode) {
+    Py_INCREF(m_bytecode);
+    m_sCodeCache.emplace(key, m_bytecode);
     return true;
   }
   else {
@@ -264,6 +281,14 @@ bool SCA_PythonController::Compile()
   }
 }
 
+void SCA_PythonController::ClearCodeCache()
+{
+  for (const std::pair<const std::string, PyObject *> &pair : m_sCodeCache) {
+    Py_DECREF(pair.second);
+  }
+  m_sCodeCache.clear();
+}
+
 bool SCA_PythonController::Import()
 {
   m_bModified = false;
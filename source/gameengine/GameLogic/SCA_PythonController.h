@@ -32,6 +32,7 @@
 
 #pragma once
 
+#include <unordered_map>
 #include <vector>
 
 #include "EXP_BoolValue.h"
@@ -59,6 +60,11 @@ class SCA_PythonController : public SCA_IController {
 #endif
   std::vector<class SCA_ISensor *> m_triggeredSensors;
 
+#ifdef WITH_PYTHON
+  /// Compiled scripts shared by all the controllers, indexed by script name and text.
+  static std::unordered_map<std::string, PyObject *> m_sCodeCache;
+#endif
+
  public:
   enum SCA_PyExecMode { SCA_PYEXEC_SCRIPT = 0, SCA_PYEXEC_MODULE, SCA_PYEXEC_MAX };
 
@@ -91,6 +97,9 @@ class SCA_PythonController : public SCA_IController {
   void ErrorPrint(const char *error_msg);
 
 #ifdef WITH_PYTHON
+  /// Free the compiled scripts shared by the controllers, Python must still be initialized.
+  static void ClearCodeCache();
+
   static const char *sPyGetCurrentController__doc__;
   static PyObject *sPyGetCurrentController(PyObject *self);
   static const char *sPyAddActiveActuator__doc__;
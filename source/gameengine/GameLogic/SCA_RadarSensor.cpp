@@ -34,7 +34,6 @@
 #include "DNA_sensor_types.h"
 
 #include "KX_GameObject.h"
-#include "PHY_IMotionState.h"
 #include "PHY_IPhysicsController.h"
 
 /**
@@ -155,12 +154,7 @@ void SCA_RadarSensor::SynchronizeTransform()
   m_cone_target[1] = temp[1];
   m_cone_target[2] = temp[2];
 
-  if (m_physCtrl) {
-    PHY_IMotionState *motionState = m_physCtrl->GetMotionState();
-    motionState->SetWorldPosition(trans.getOrigin());
-    motionState->SetWorldOrientation(trans.getBasis());
-    m_physCtrl->WriteMotionStateToDynamics(true);
-  }
+  SetPhysCtrlTransform(trans.getOrigin(), trans.getBasis());
 }
 
 /* ------------------------------------------------------------------------- */
@@ -38,6 +38,8 @@
 
 #include "SCA_RandomNumberGenerator.h"
 
+#include <algorithm>
+
 /* Period parameters */
 #define N 624
 #define M 397
@@ -90,46 +92,91 @@ void SCA_RandomNumberGenerator::SetSeed(long newseed)
 /**
  * This is the important part: copied verbatim :)
  */
-unsigned long SCA_RandomNumberGenerator::Draw()
+void SCA_RandomNumberGenerator::GenerateVector(void)
 {
-  static unsigned long mag01[2] = {0x0, MATRIX_A};
+  static const uint32_t mag01[2] = {0x0, MATRIX_A};
   /* mag01[x] = x * MATRIX_A  for x=0,1 */
 
-  unsigned long y;
-
-  if (mti >= N) { /* generate N words at one time */
-    int kk;
-
-    /* I set this in the constructor, so it is always satisfied ! */
-    //          if (mti == N+1)   /* if sgenrand() has not been called, */
-    //              GEN_srand(4357); /* a default initial seed is used   */
-
-    for (kk = 0; kk < N - M; kk++) {
-      y = (mt[kk] & UPPER_MASK) | (mt[kk + 1] & LOWER_MASK);
-      mt[kk] = mt[kk + M] ^ (y >> 1) ^ mag01[y & 0x1];
-    }
-    for (; kk < N - 1; kk++) {
-      y = (mt[kk] & UPPER_MASK) | (mt[kk + 1] & LOWER_MASK);
-      mt[kk] = mt[kk + (M - N)] ^ (y >> 1) ^ mag01[y & 0x1];
-    }
-    y = (mt[N - 1] & UPPER_MASK) | (mt[0] & LOWER_MASK);
-    mt[N - 1] = mt[M - 1] ^ (y >> 1) ^ mag01[y & 0x1];
+  uint32_t y;
+  int kk;
 
-    mti = 0;
+  for (kk = 0; kk < N - M; kk++) {
+    y = (mt[kk] & UPPER_MASK) | (mt[kk + 1] & LOWER_MASK);
+    mt[kk] = mt[kk + M] ^ (y >> 1) ^ mag01[y & 0x1];
   }
+  for (; kk < N - 1; kk++) {
+    y = (mt[kk] & UPPER_MASK) | (mt[kk + 1] & LOWER_MASK);
+    mt[kk] = mt[kk + (M - N)] ^ (y >> 1) ^ mag01[y & 0x1];
+  }
+  y = (mt[N - 1] & UPPER_MASK) | (mt[0] & LOWER_MASK);
+  mt[N - 1] = mt[M - 1] ^ (y >> 1) ^ mag01[y & 0x1];
+
+  mti = 0;
+}
 
-  y = mt[mti++];
+static inline uint32_t temper(uint32_t y)
+{
   y ^= TEMPERING_SHIFT_U(y);
   y ^= TEMPERING_SHIFT_S(y) & TEMPERING_MASK_B;
   y ^= TEMPERING_SHIFT_T(y) & TEMPERING_MASK_C;
   y ^= TEMPERING_SHIFT_L(y);
-
   return y;
 }
 
+unsigned long SCA_RandomNumberGenerator::Draw()
+{
+  if (mti >= N) { /* generate N words at one time */
+    /* I set this in the constructor, so it is always satisfied ! */
+    //          if (mti == N+1)   /* if sgenrand() has not been called, */
+    //              GEN_srand(4357); /* a default initial seed is used   */
+    GenerateVector();
+  }
+
+  return temper(mt[mti++]);
+}
+
 float SCA_RandomNumberGenerator::DrawFloat()
 {
   return ((float)Draw() / (unsigned long)0xffffffff);
 }
 
+void SCA_RandomNumberGenerator::DrawArray(uint32_t *values, unsigned int count)
+{
+  while (count > 0) {
+    if (mti >= N) {
+      GenerateVector();
+    }
+
+    // Temper a run of the state vector, the loop has no dependency and is vectorized.
+    const unsigned int num = std::min(count, (unsigned int)(N - mti));
+    const uint32_t *state = mt + mti;
+    for (unsigned int i = 0; i < num; ++i) {
+      values[i] = temper(state[i]);
+    }
+
+    mti += num;
+    values += num;
+    count -= num;
+  }
+}
+
+void SCA_RandomNumberGenerator::DrawFloatArray(float *values, unsigned int count)
+{
+  while (count > 0) {
+    if (mti >= N) {
+      GenerateVector();
+    }
+
+    const unsigned int num = std::min(count, (unsigned int)(N - mti));
+    const uint32_t *state = mt + mti;
+    for (unsigned int i = 0; i < num; ++i) {
+      values[i] = ((float)temper(state[i]) / (unsigned long)0xffffffff);
+    }
+
+    mti += num;
+    values += num;
+    count -= num;
+  }
+}
+
 /* eof */
@@ -34,6 +34,8 @@
 
 #pragma once
 
+#include <cstdint>
+
 class SCA_RandomNumberGenerator {
 
   /* reference counted for memleak */
@@ -44,20 +46,26 @@ class SCA_RandomNumberGenerator {
 
   /* A bit silly.. The N parameter is a define in the .cpp file */
   /** the array for the state vector  */
-  /* unsigned long mt[N]; */
-  unsigned long mt[624];
+  /* uint32_t mt[N]; */
+  uint32_t mt[624];
 
   /** mti==N+1 means mt[KX_MT_VectorLength] is not initialized */
   int mti; /* initialized in the cpp file */
 
   /** Calculate a start vector */
   void SetStartVector(void);
+  /** Generate the next N words of the state vector */
+  void GenerateVector(void);
 
  public:
   SCA_RandomNumberGenerator(long seed);
   ~SCA_RandomNumberGenerator();
   unsigned long Draw();
   float DrawFloat();
+  /** Fill an array with the next values of Draw, without the per value overhead. */
+  void DrawArray(uint32_t *values, unsigned int count);
+  /** Fill an array with the next values of DrawFloat. */
+  void DrawFloatArray(float *values, unsigned int count);
   long GetSeed();
   void SetSeed(long newseed);
   SCA_RandomNumberGenerator *AddRef()
@@ -70,6 +70,7 @@ void SCA_RaySensor::Init()
   m_rayHit = false;
   m_hitObject = nullptr;
   m_reset = true;
+  m_rayCastPending = false;
 }
 
 SCA_RaySensor::~SCA_RaySensor()
@@ -182,10 +183,10 @@ bool SCA_RaySensor::NeedRayCast(KX_ClientObjectInfo *client, void *UNUSED(data))
   return true;
 }
 
-bool SCA_RaySensor::Evaluate()
+bool SCA_RaySensor::PrepareRay(MT_Vector3 &frompoint,
+                               MT_Vector3 &topoint,
+                               PHY_IPhysicsController *&ignoreController)
 {
-  bool result = false;
-  bool reset = m_reset && m_level;
   m_rayHit = false;
   m_hitObject = nullptr;
   m_hitPosition[0] = 0;
@@ -197,12 +198,11 @@ bool SCA_RaySensor::Evaluate()
   m_hitNormal[2] = 0;
 
   KX_GameObject *obj = (KX_GameObject *)GetParent();
-  MT_Vector3 frompoint = obj->NodeGetWorldPosition();
+  frompoint = obj->NodeGetWorldPosition();
   MT_Matrix3x3 matje = obj->NodeGetWorldOrientation();
   MT_Matrix3x3 invmat = matje.inverse();
 
   MT_Vector3 todir;
-  m_reset = false;
   switch (m_axis) {
     case SENS_RAY_X_AXIS:  // X
     {
@@ -252,23 +252,59 @@ bool SCA_RaySensor::Evaluate()
   m_rayDirection[1] = todir[1];
   m_rayDirection[2] = todir[2];
 
-  MT_Vector3 topoint = frompoint + (m_distance)*todir;
+  topoint = frompoint + (m_distance)*todir;
   PHY_IPhysicsEnvironment *pe = m_scene->GetPhysicsEnvironment();
 
   if (!pe) {
-    CM_LogicBrickWarning(this, "there is no physics environment! Check universe for malfunction.");
     return false;
   }
 
-  PHY_IPhysicsController *spc = obj->GetPhysicsController();
+  ignoreController = obj->GetPhysicsController();
   KX_GameObject *parent = obj->GetParent();
-  if (!spc && parent)
-    spc = parent->GetPhysicsController();
+  if (!ignoreController && parent)
+    ignoreController = parent->GetPhysicsController();
+
+  return true;
+}
+
+void SCA_RaySensor::AddRayCasts(KX_RayCastBatch &batch)
+{
+  m_rayCastPending = false;
+  if (!m_links || m_suspended) {
+    return;
+  }
 
-  PHY_IPhysicsEnvironment *physics_environment = this->m_scene->GetPhysicsEnvironment();
+  MT_Vector3 frompoint;
+  MT_Vector3 topoint;
+  PHY_IPhysicsController *spc = nullptr;
+  if (PrepareRay(frompoint, topoint, spc)) {
+    batch.Add(m_scene->GetPhysicsEnvironment(), frompoint, topoint, this, spc, false);
+    m_rayCastPending = true;
+  }
+}
 
-  KX_RayCast::Callback<SCA_RaySensor, void> callback(this, spc);
-  KX_RayCast::RayTest(physics_environment, frompoint, topoint, callback);
+bool SCA_RaySensor::Evaluate()
+{
+  bool result = false;
+  bool reset = m_reset && m_level;
+  m_reset = false;
+
+  if (m_rayCastPending) {
+    m_rayCastPending = false;
+  }
+  else {
+    MT_Vector3 frompoint;
+    MT_Vector3 topoint;
+    PHY_IPhysicsController *spc = nullptr;
+    if (!PrepareRay(frompoint, topoint, spc)) {
+      CM_LogicBrickWarning(this,
+                           "there is no physics environment! Check universe for malfunction.");
+      return false;
+    }
+
+    KX_RayCast::Callback<SCA_RaySensor, void> callback(this, spc);
+    KX_RayCast::RayTest(m_scene->GetPhysicsEnvironment(), frompoint, topoint, callback);
+  }
 
   /* now pass this result to some controller */
 
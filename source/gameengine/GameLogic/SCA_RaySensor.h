@@ -34,6 +34,7 @@
 
 #include "BLI_utildefines.h"
 
+#include "KX_RayCastBatch.h"
 #include "KX_Scene.h" /* only for scene replace */
 #include "MT_Vector3.h"
 #include "SCA_IScene.h" /* only for scene replace */
@@ -42,7 +43,7 @@
 struct KX_ClientObjectInfo;
 class KX_RayCast;
 
-class SCA_RaySensor : public SCA_ISensor {
+class SCA_RaySensor : public SCA_ISensor, public KX_RayCastBatch::Receiver {
   Py_Header std::string m_propertyname;
   bool m_bFindMaterial;
   bool m_bXRay;
@@ -57,6 +58,15 @@ class SCA_RaySensor : public SCA_ISensor {
   float m_hitNormal[3];
   float m_rayDirection[3];
   std::string m_hitMaterial;
+  /// The ray was cast in a batch, its result is used by the next evaluation.
+  bool m_rayCastPending;
+
+  /** Reset the hit and compute the ray.
+   * \return False if the scene has no physics environment.
+   */
+  bool PrepareRay(MT_Vector3 &frompoint,
+                  MT_Vector3 &topoint,
+                  PHY_IPhysicsController *&ignoreController);
 
  public:
   SCA_RaySensor(class SCA_EventManager *eventmgr,
@@ -74,11 +84,12 @@ class SCA_RaySensor : public SCA_ISensor {
   virtual bool Evaluate();
   virtual bool IsPositiveTrigger();
   virtual void Init();
+  virtual void AddRayCasts(KX_RayCastBatch &batch);
 
   /// \see KX_RayCast
-  bool RayHit(KX_ClientObjectInfo *client, KX_RayCast *result, void *UNUSED(data));
+  virtual bool RayHit(KX_ClientObjectInfo *client, KX_RayCast *result, void *UNUSED(data));
   /// \see KX_RayCast
-  bool NeedRayCast(KX_ClientObjectInfo *client, void *UNUSED(data));
+  virtual bool NeedRayCast(KX_ClientObjectInfo *client, void *UNUSED(data));
 
   virtual void Replace_IScene(SCA_IScene *val)
   {
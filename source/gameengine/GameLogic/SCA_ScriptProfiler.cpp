@@ -0,0 +1,73 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/GameLogic/SCA_ScriptProfiler.cpp
+ *  \ingroup gamelogic
+ */
+
+#include "SCA_ScriptProfiler.h"
+
+#include <algorithm>
+
+#include "PIL_time.h"
+
+SCA_ScriptProfiler::SCA_ScriptProfiler() : m_enabled(false)
+{
+}
+
+SCA_ScriptProfiler::~SCA_ScriptProfiler()
+{
+}
+
+bool SCA_ScriptProfiler::GetEnabled() const
+{
+  return m_enabled;
+}
+
+void SCA_ScriptProfiler::SetEnabled(bool enabled)
+{
+  if (enabled && !m_enabled) {
+    m_entries.clear();
+  }
+  m_enabled = enabled;
+}
+
+double SCA_ScriptProfiler::GetTime()
+{
+  return PIL_check_seconds_timer();
+}
+
+void SCA_ScriptProfiler::AddCall(const std::string &name, double startTime)
+{
+  const double time = PIL_check_seconds_timer() - startTime;
+
+  // Zero initialized on insertion.
+  Entry &entry = m_entries[name];
+  ++entry.m_calls;
+  entry.m_totalTime += time;
+  entry.m_maxTime = std::max(entry.m_maxTime, time);
+}
+
+const SCA_ScriptProfiler::EntryMap &SCA_ScriptProfiler::GetEntries() const
+{
+  return m_entries;
+}
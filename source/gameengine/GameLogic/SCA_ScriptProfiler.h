@@ -0,0 +1,67 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file SCA_ScriptProfiler.h
+ *  \ingroup gamelogic
+ */
+
+#pragma once
+
+#include <map>
+#include <string>
+
+/** Timings of the scripts run by the logic, the python controllers and the object components.
+ * The timings are accumulated since the profiler was enabled.
+ */
+class SCA_ScriptProfiler {
+ public:
+  struct Entry {
+    unsigned int m_calls;
+    /// Cumulative and maximum time of a call in seconds.
+    double m_totalTime;
+    double m_maxTime;
+  };
+
+  typedef std::map<std::string, Entry> EntryMap;
+
+ private:
+  EntryMap m_entries;
+  bool m_enabled;
+
+ public:
+  SCA_ScriptProfiler();
+  ~SCA_ScriptProfiler();
+
+  bool GetEnabled() const;
+  /// Enable or disable the profiler, the timings are cleared when the profiler is enabled.
+  void SetEnabled(bool enabled);
+
+  /// Return the current time used to measure a call.
+  static double GetTime();
+  /** Register a call of a script.
+   * \param name The name of the script, e.g "object/controller".
+   * \param startTime The time returned by GetTime when the call started.
+   */
+  void AddCall(const std::string &name, double startTime);
+
+  const EntryMap &GetEntries() const;
+};
@@ -35,6 +35,8 @@
 
 #include "SCA_SoundActuator.h"
 
+#include <climits>
+
 #ifdef WITH_AUDASPACE
 typedef float sample_t;
 #  include <AUD_Device.h>
@@ -44,8 +46,8 @@ typedef float sample_t;
 #  include <python/PyAPI.h>
 #endif
 
-#include "KX_Camera.h"
 #include "KX_Globals.h"
+#include "KX_KetsjiEngine.h"
 
 /* ------------------------------------------------------------------------- */
 /* Native functions                                                          */
@@ -63,23 +65,24 @@ SCA_SoundActuator::SCA_SoundActuator(SCA_IObject *gameobj,
 {
 #ifdef WITH_AUDASPACE
   m_sound = sound ? AUD_Sound_copy(sound) : nullptr;
-  m_handle = nullptr;
+  // The converted sound lives as long as the blender data, the replicas share its handles.
+  m_soundKey = sound;
 #endif  // WITH_AUDASPACE
+  m_voice = nullptr;
   m_volume = volume;
   m_pitch = pitch;
   m_is3d = is3d;
   m_3d = settings;
   m_type = type;
+  m_priority = 0;
   m_isplaying = false;
 }
 
 SCA_SoundActuator::~SCA_SoundActuator()
 {
-#ifdef WITH_AUDASPACE
-  if (m_handle) {
-    AUD_Handle_stop(m_handle);
-  }
+  stop();
 
+#ifdef WITH_AUDASPACE
   if (m_sound) {
     AUD_Sound_free(m_sound);
   }
@@ -88,64 +91,71 @@ SCA_SoundActuator::~SCA_SoundActuator()
 
 void SCA_SoundActuator::play()
 {
-#ifdef WITH_AUDASPACE
-  if (m_handle) {
-    AUD_Handle_stop(m_handle);
-    m_handle = nullptr;
-  }
+  stop();
 
+#ifdef WITH_AUDASPACE
   if (!m_sound)
     return;
 
-  // this is the sound that will be played and not deleted afterwards
-  AUD_Sound *sound = m_sound;
-
-  bool loop = false;
-
-  switch (m_type) {
-    case KX_SOUNDACT_LOOPBIDIRECTIONAL:
-    case KX_SOUNDACT_LOOPBIDIRECTIONAL_STOP:
-      sound = AUD_Sound_pingpong(sound);
-      ATTR_FALLTHROUGH;
-    case KX_SOUNDACT_LOOPEND:
-    case KX_SOUNDACT_LOOPSTOP:
-      loop = true;
-      break;
-    case KX_SOUNDACT_PLAYSTOP:
-    case KX_SOUNDACT_PLAYEND:
-    default:
-      break;
+  // The voice can be culled or virtual, the actuator is still playing.
+  m_voice = KX_GetActiveEngine()->GetSoundManager()->Play(this);
+  m_isplaying = true;
+#endif  // WITH_AUDASPACE
+}
+
+void SCA_SoundActuator::stop()
+{
+  if (m_voice) {
+    KX_GetActiveEngine()->GetSoundManager()->Stop(m_voice);
+    m_voice = nullptr;
   }
+}
 
-  AUD_Device *device = AUD_Device_getCurrent();
-  m_handle = AUD_Device_play(device, sound, false);
-  AUD_Device_free(device);
-
-  // in case of pingpong, we have to free the sound
-  if (sound != m_sound)
-    AUD_Sound_free(sound);
-
-  if (m_handle != nullptr) {
-    if (m_is3d) {
-      AUD_Handle_setRelative(m_handle, true);
-      AUD_Handle_setVolumeMaximum(m_handle, m_3d.max_gain);
-      AUD_Handle_setVolumeMinimum(m_handle, m_3d.min_gain);
-      AUD_Handle_setDistanceReference(m_handle, m_3d.reference_distance);
-      AUD_Handle_setDistanceMaximum(m_handle, m_3d.max_distance);
-      AUD_Handle_setAttenuation(m_handle, m_3d.rolloff_factor);
-      AUD_Handle_setConeAngleInner(m_handle, m_3d.cone_inner_angle);
-      AUD_Handle_setConeAngleOuter(m_handle, m_3d.cone_outer_angle);
-      AUD_Handle_setConeVolumeOuter(m_handle, m_3d.cone_outer_gain);
-    }
+#ifdef WITH_AUDASPACE
+AUD_Handle *SCA_SoundActuator::GetHandle() const
+{
+  return m_voice ? m_voice->m_handle : nullptr;
+}
 
-    if (loop)
-      AUD_Handle_setLoopCount(m_handle, -1);
-    AUD_Handle_setPitch(m_handle, m_pitch);
-    AUD_Handle_setVolume(m_handle, m_volume);
-  }
+AUD_Sound *SCA_SoundActuator::GetSound() const
+{
+  return m_sound;
+}
 
-  m_isplaying = true;
+void *SCA_SoundActuator::GetSoundKey() const
+{
+  return m_soundKey;
+}
 #endif  // WITH_AUDASPACE
+
+float SCA_SoundActuator::GetVolume() const
+{
+  return m_volume;
+}
+
+float SCA_SoundActuator::GetPitch() const
+{
+  return m_pitch;
+}
+
+bool SCA_SoundActuator::Is3D() const
+{
+  return m_is3d;
+}
+
+const KX_3DSoundSettings &SCA_SoundActuator::Get3DSettings() const
+{
+  return m_3d;
+}
+
+int SCA_SoundActuator::GetPriority() const
+{
+  return m_priority;
+}
+
+void SCA_SoundActuator::ReleaseVoice()
+{
+  m_voice = nullptr;
 }
 
 EXP_Value *SCA_SoundActuator::GetReplica()
@@ -158,8 +168,8 @@ EXP_Value *SCA_SoundActuator::GetReplica()
 void SCA_SoundActuator::ProcessReplica()
 {
   SCA_IActuator::ProcessReplica();
+  m_voice = nullptr;
 #ifdef WITH_AUDASPACE
-  m_handle = nullptr;
   m_sound = m_sound ? AUD_Sound_copy(m_sound) : nullptr;
 #endif  // WITH_AUDASPACE
 }
@@ -180,8 +190,10 @@ bool SCA_SoundActuator::Update(double curtime)
   if (!m_sound)
     return false;
 
-  // actual audio device playing state
-  bool isplaying = m_handle ? (AUD_Handle_getStatus(m_handle) == AUD_STATUS_PLAYING) : false;
+  KX_SoundManager *manager = KX_GetActiveEngine()->GetSoundManager();
+
+  // actual audio device playing state, a virtual looping voice is playing
+  bool isplaying = m_voice ? manager->IsPlaying(m_voice) : false;
 
   if (bNegativeEvent) {
     // here must be a check if it is still playing
@@ -191,10 +203,7 @@ bool SCA_SoundActuator::Update(double curtime)
         case KX_SOUNDACT_LOOPSTOP:
         case KX_SOUNDACT_LOOPBIDIRECTIONAL_STOP: {
           // stop immediately
-          if (m_handle) {
-            AUD_Handle_stop(m_handle);
-            m_handle = nullptr;
-          }
+          stop();
           break;
         }
         case KX_SOUNDACT_PLAYEND: {
@@ -204,8 +213,7 @@ bool SCA_SoundActuator::Update(double curtime)
         case KX_SOUNDACT_LOOPEND:
         case KX_SOUNDACT_LOOPBIDIRECTIONAL: {
           // stop the looping so that the sound stops when it finished
-          if (m_handle)
-            AUD_Handle_setLoopCount(m_handle, 0);
+          manager->StopLooping(m_voice);
           break;
         }
         default:
@@ -232,33 +240,16 @@ bool SCA_SoundActuator::Update(double curtime)
       play();
   }
   // verify that the sound is still playing
-  isplaying = m_handle ? (AUD_Handle_getStatus(m_handle) == AUD_STATUS_PLAYING) : false;
+  isplaying = m_voice ? manager->IsPlaying(m_voice) : false;
 
+  /* The 3D sources are updated once per frame by the sound manager
+   * for all the playing actuators. */
   if (isplaying) {
-    if (m_is3d) {
-      KX_Camera *cam = KX_GetActiveScene()->GetActiveCamera();
-      if (cam) {
-        KX_GameObject *obj = (KX_GameObject *)this->GetParent();
-        MT_Vector3 p;
-        MT_Matrix3x3 Mo;
-        float data[4];
-
-        Mo = cam->NodeGetWorldOrientation().inverse();
-        p = (obj->NodeGetWorldPosition() - cam->NodeGetWorldPosition());
-        p = Mo * p;
-        p.getValue(data);
-        AUD_Handle_setLocation(m_handle, data);
-        p = (obj->GetLinearVelocity() - cam->GetLinearVelocity());
-        p = Mo * p;
-        p.getValue(data);
-        AUD_Handle_setVelocity(m_handle, data);
-        (Mo * obj->NodeGetWorldOrientation()).getRotation().getValue(data);
-        AUD_Handle_setOrientation(m_handle, data);
-      }
-    }
     result = true;
   }
   else {
+    // Give the finished handle back to the pool.
+    stop();
     m_isplaying = false;
     result = false;
   }
@@ -343,6 +334,7 @@ PyAttributeDef SCA_SoundActuator::Attributes[] = {
         "time", SCA_SoundActuator, pyattr_get_audposition, pyattr_set_audposition),
     EXP_PYATTRIBUTE_RW_FUNCTION("volume", SCA_SoundActuator, pyattr_get_gain, pyattr_set_gain),
     EXP_PYATTRIBUTE_RW_FUNCTION("pitch", SCA_SoundActuator, pyattr_get_pitch, pyattr_set_pitch),
+    EXP_PYATTRIBUTE_INT_RW("priority", INT_MIN, INT_MAX, false, SCA_SoundActuator, m_priority),
     EXP_PYATTRIBUTE_ENUM_RW("mode",
                             SCA_SoundActuator::KX_SOUNDACT_NODEF + 1,
                             SCA_SoundActuator::KX_SOUNDACT_MAX - 1,
@@ -359,14 +351,12 @@ EXP_PYMETHODDEF_DOC_NOARGS(SCA_SoundActuator,
                            "\tStarts the sound.\n")
 {
 #  ifdef WITH_AUDASPACE
-  switch (m_handle ? AUD_Handle_getStatus(m_handle) : AUD_STATUS_INVALID) {
-    case AUD_STATUS_PLAYING:
-      break;
-    case AUD_STATUS_PAUSED:
-      AUD_Handle_resume(m_handle);
-      break;
-    default:
-      play();
+  KX_SoundManager *manager = KX_GetActiveEngine()->GetSoundManager();
+  if (!m_voice || !manager->IsPlaying(m_voice)) {
+    play();
+  }
+  else if (m_voice->m_paused) {
+    manager->Resume(m_voice);
   }
 #  endif  // WITH_AUDASPACE
 
@@ -379,8 +369,8 @@ EXP_PYMETHODDEF_DOC_NOARGS(SCA_SoundActuator,
                            "\tPauses the sound.\n")
 {
 #  ifdef WITH_AUDASPACE
-  if (m_handle)
-    AUD_Handle_pause(m_handle);
+  if (m_voice)
+    KX_GetActiveEngine()->GetSoundManager()->Pause(m_voice);
 #  endif  // WITH_AUDASPACE
 
   Py_RETURN_NONE;
@@ -392,10 +382,7 @@ EXP_PYMETHODDEF_DOC_NOARGS(SCA_SoundActuator,
                            "\tStops the sound.\n")
 {
 #  ifdef WITH_AUDASPACE
-  if (m_handle) {
-    AUD_Handle_stop(m_handle);
-    m_handle = nullptr;
-  }
+  stop();
 #  endif  // WITH_AUDASPACE
 
   Py_RETURN_NONE;
@@ -449,8 +436,8 @@ PyObject *SCA_SoundActuator::pyattr_get_audposition(EXP_PyObjectPlus *self,
 #  ifdef WITH_AUDASPACE
   SCA_SoundActuator *actuator = static_cast<SCA_SoundActuator *>(self);
 
-  if (actuator->m_handle)
-    position = AUD_Handle_getPosition(actuator->m_handle);
+  if (actuator->m_voice)
+    position = KX_GetActiveEngine()->GetSoundManager()->GetPosition(actuator->m_voice);
 #  endif  // WITH_AUDASPACE
 
   PyObject *result = PyFloat_FromDouble(position);
@@ -511,57 +498,57 @@ int SCA_SoundActuator::pyattr_set_3d_property(EXP_PyObjectPlus *self,
   if (prop == "volume_maximum") {
     actuator->m_3d.max_gain = prop_value;
 #  ifdef WITH_AUDASPACE
-    if (actuator->m_handle)
-      AUD_Handle_setVolumeMaximum(actuator->m_handle, prop_value);
+    if (AUD_Handle *handle = actuator->GetHandle())
+      AUD_Handle_setVolumeMaximum(handle, prop_value);
 #  endif  // WITH_AUDASPACE
   }
   else if (prop == "volume_minimum") {
     actuator->m_3d.min_gain = prop_value;
 #  ifdef WITH_AUDASPACE
-    if (actuator->m_handle)
-      AUD_Handle_setVolumeMinimum(actuator->m_handle, prop_value);
+    if (AUD_Handle *handle = actuator->GetHandle())
+      AUD_Handle_setVolumeMinimum(handle, prop_value);
 #  endif  // WITH_AUDASPACE
   }
   else if (prop == "distance_reference") {
     actuator->m_3d.reference_distance = prop_value;
 #  ifdef WITH_AUDASPACE
-    if (actuator->m_handle)
-      AUD_Handle_setDistanceReference(actuator->m_handle, prop_value);
+    if (AUD_Handle *handle = actuator->GetHandle())
+      AUD_Handle_setDistanceReference(handle, prop_value);
 #  endif  // WITH_AUDASPACE
   }
   else if (prop == "distance_maximum") {
     actuator->m_3d.max_distance = prop_value;
 #  ifdef WITH_AUDASPACE
-    if (actuator->m_handle)
-      AUD_Handle_setDistanceMaximum(actuator->m_handle, prop_value);
+    if (AUD_Handle *handle = actuator->GetHandle())
+      AUD_Handle_setDistanceMaximum(handle, prop_value);
 #  endif  // WITH_AUDASPACE
   }
   else if (prop == "attenuation") {
     actuator->m_3d.rolloff_factor = prop_value;
 #  ifdef WITH_AUDASPACE
-    if (actuator->m_handle)
-      AUD_Handle_setAttenuation(actuator->m_handle, prop_value);
+    if (AUD_Handle *handle = actuator->GetHandle())
+      AUD_Handle_setAttenuation(handle, prop_value);
 #  endif  // WITH_AUDASPACE
   }
   else if (prop == "cone_angle_inner") {
     actuator->m_3d.cone_inner_angle = prop_value;
 #  ifdef WITH_AUDASPACE
-    if (actuator->m_handle)
-      AUD_Handle_setConeAngleInner(actuator->m_handle, prop_value);
+    if (AUD_Handle *handle = actuator->GetHandle())
+      AUD_Handle_setConeAngleInner(handle, prop_value);
 #  endif  // WITH_AUDASPACE
   }
   else if (prop == "cone_angle_outer") {
     actuator->m_3d.cone_outer_angle = prop_value;
 #  ifdef WITH_AUDASPACE
-    if (actuator->m_handle)
-      AUD_Handle_setConeAngleOuter(actuator->m_handle, prop_value);
+    if (AUD_Handle *handle = actuator->GetHandle())
+      AUD_Handle_setConeAngleOuter(handle, prop_value);
 #  endif  // WITH_AUDASPACE
   }
   else if (prop == "cone_volume_outer") {
     actuator->m_3d.cone_outer_gain = prop_value;
 #  ifdef WITH_AUDASPACE
-    if (actuator->m_handle)
-      AUD_Handle_setConeVolumeOuter(actuator->m_handle, prop_value);
+    if (AUD_Handle *handle = actuator->GetHandle())
+      AUD_Handle_setConeVolumeOuter(handle, prop_value);
 #  endif  // WITH_AUDASPACE
   }
   else {
@@ -582,8 +569,8 @@ int SCA_SoundActuator::pyattr_set_audposition(EXP_PyObjectPlus *self,
 #  ifdef WITH_AUDASPACE
   SCA_SoundActuator *actuator = static_cast<SCA_SoundActuator *>(self);
 
-  if (actuator->m_handle)
-    AUD_Handle_setPosition(actuator->m_handle, position);
+  if (actuator->m_voice)
+    KX_GetActiveEngine()->GetSoundManager()->SetPosition(actuator->m_voice, position);
 #  endif  // WITH_AUDASPACE
 
   return PY_SET_ATTR_SUCCESS;
@@ -601,8 +588,8 @@ int SCA_SoundActuator::pyattr_set_gain(EXP_PyObjectPlus *self,
   actuator->m_volume = gain;
 
 #  ifdef WITH_AUDASPACE
-  if (actuator->m_handle)
-    AUD_Handle_setVolume(actuator->m_handle, gain);
+  if (AUD_Handle *handle = actuator->GetHandle())
+    AUD_Handle_setVolume(handle, gain);
 #  endif  // WITH_AUDASPACE
 
   return PY_SET_ATTR_SUCCESS;
@@ -620,8 +607,8 @@ int SCA_SoundActuator::pyattr_set_pitch(EXP_PyObjectPlus *self,
   actuator->m_pitch = pitch;
 
 #  ifdef WITH_AUDASPACE
-  if (actuator->m_handle)
-    AUD_Handle_setPitch(actuator->m_handle, pitch);
+  if (AUD_Handle *handle = actuator->GetHandle())
+    AUD_Handle_setPitch(handle, pitch);
 #  endif  // WITH_AUDASPACE
 
   return PY_SET_ATTR_SUCCESS;
@@ -646,6 +633,8 @@ int SCA_SoundActuator::pyattr_set_sound(EXP_PyObjectPlus *self,
 
   AUD_Sound_free(actuator->m_sound);
   actuator->m_sound = snd;
+  // The python sounds have no stable identity, their handles are not pooled.
+  actuator->m_soundKey = nullptr;
 #  endif  // WITH_AUDASPACE
 
   return PY_SET_ATTR_SUCCESS;
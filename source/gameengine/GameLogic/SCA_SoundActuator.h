@@ -33,6 +33,7 @@
 
 #include "BKE_sound.h"
 
+#include "KX_SoundManager.h"
 #include "SCA_IActuator.h"
 
 #ifdef WITH_AUDASPACE
@@ -55,14 +56,24 @@ class SCA_SoundActuator : public SCA_IActuator {
   Py_Header bool m_isplaying;
 #ifdef WITH_AUDASPACE
   AUD_Sound *m_sound;
-  AUD_Handle *m_handle;
+  /// Identity of the sound shared by the replicas for the handle pools, nullptr if not shared.
+  void *m_soundKey;
 #endif  // WITH_AUDASPACE
+  /// The voice playing the sound, nullptr if not playing.
+  KX_SoundManager::Voice *m_voice;
   float m_volume;
   float m_pitch;
   bool m_is3d;
   KX_3DSoundSettings m_3d;
+  /// Voices of higher priority take the device handles first.
+  int m_priority;
 
   void play();
+  void stop();
+#ifdef WITH_AUDASPACE
+  /// Return the device handle of the voice, nullptr if not playing or virtual.
+  AUD_Handle *GetHandle() const;
+#endif  // WITH_AUDASPACE
 
  public:
   enum KX_SOUNDACT_TYPE {
@@ -95,6 +106,18 @@ class SCA_SoundActuator : public SCA_IActuator {
   EXP_Value *GetReplica();
   void ProcessReplica();
 
+#ifdef WITH_AUDASPACE
+  AUD_Sound *GetSound() const;
+  void *GetSoundKey() const;
+#endif  // WITH_AUDASPACE
+  float GetVolume() const;
+  float GetPitch() const;
+  bool Is3D() const;
+  const KX_3DSoundSettings &Get3DSettings() const;
+  int GetPriority() const;
+  /// Forget the voice freed by the sound manager.
+  void ReleaseVoice();
+
 #ifdef WITH_PYTHON
 
   /* -------------------------------------------------------------------- */
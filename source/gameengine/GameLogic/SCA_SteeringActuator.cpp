@@ -75,7 +75,8 @@ SCA_SteeringActuator::SCA_SteeringActuator(SCA_IObject *gameobj,
       m_pathUpdatePeriod(pathUpdatePeriod),
       m_lockzvel(lockzvel),
       m_wayPointIdx(-1),
-      m_steerVec(MT_Vector3(0, 0, 0))
+      m_steerVec(MT_Vector3(0, 0, 0)),
+      m_steerDelta(0.0)
 {
   m_navmesh = static_cast<KX_NavMeshObject *>(navmesh);
   if (m_navmesh)
@@ -247,43 +248,27 @@ bool SCA_SteeringActuator::Update(double curtime)
   }
 
   if (apply_steerforce) {
-    bool isdyna = obj->IsDynamic();
-    if (isdyna)
+    if (obj->IsDynamic())
       m_steerVec.z() = 0;
     if (!m_steerVec.fuzzyZero())
       m_steerVec.normalize();
-    MT_Vector3 newvel = m_velocity * m_steerVec;
+    const MT_Vector3 newvel = m_velocity * m_steerVec;
+    m_steerDelta = delta;
 
-    // adjust velocity to avoid obstacles
+    /* Adjust velocity to avoid obstacles, the velocity is applied once the avoidance
+     * of all the agents of the scene is computed. */
     if (m_simulation && m_obstacle /*&& !newvel.fuzzyZero()*/) {
       if (m_enableVisualization)
         KX_RasterizerDrawDebugLine(mypos, mypos + newvel, MT_Vector4(1.0f, 0.0f, 0.0f, 1.0f));
-      m_simulation->AdjustObstacleVelocity(m_obstacle,
-                                           m_mode != KX_STEERING_PATHFOLLOWING ? m_navmesh :
-                                                                                 nullptr,
-                                           newvel,
-                                           m_acceleration * (float)delta,
-                                           m_turnspeed / (180.0f * (float)(M_PI * delta)));
-      if (m_enableVisualization)
-        KX_RasterizerDrawDebugLine(mypos, mypos + newvel, MT_Vector4(0.0f, 1.0f, 0.0f, 1.0f));
-    }
-
-    HandleActorFace(newvel);
-    if (isdyna) {
-      // temporary solution: set 2D steering velocity directly to obj
-      // correct way is to apply physical force
-      MT_Vector3 curvel = obj->GetLinearVelocity();
-
-      if (m_lockzvel)
-        newvel.z() = 0.0f;
-      else
-        newvel.z() = curvel.z();
-
-      obj->setLinearVelocity(newvel, false);
+      m_simulation->AddAgent(this,
+                             m_obstacle,
+                             m_mode != KX_STEERING_PATHFOLLOWING ? m_navmesh : nullptr,
+                             newvel,
+                             m_acceleration * (float)delta,
+                             m_turnspeed / (180.0f * (float)(M_PI * delta)));
     }
     else {
-      MT_Vector3 movement = delta * newvel;
-      obj->ApplyMovement(movement, false);
+      ApplyVelocity(newvel);
     }
   }
   else {
@@ -299,6 +284,35 @@ bool SCA_SteeringActuator::Update(double curtime)
   return true;
 }
 
+void SCA_SteeringActuator::ApplyVelocity(const MT_Vector3 &velocity)
+{
+  KX_GameObject *obj = (KX_GameObject *)GetParent();
+  MT_Vector3 newvel = velocity;
+
+  if (m_simulation && m_obstacle && m_enableVisualization) {
+    const MT_Vector3 &mypos = obj->NodeGetWorldPosition();
+    KX_RasterizerDrawDebugLine(mypos, mypos + newvel, MT_Vector4(0.0f, 1.0f, 0.0f, 1.0f));
+  }
+
+  HandleActorFace(newvel);
+  if (obj->IsDynamic()) {
+    // temporary solution: set 2D steering velocity directly to obj
+    // correct way is to apply physical force
+    MT_Vector3 curvel = obj->GetLinearVelocity();
+
+    if (m_lockzvel)
+      newvel.z() = 0.0f;
+    else
+      newvel.z() = curvel.z();
+
+    obj->setLinearVelocity(newvel, false);
+  }
+  else {
+    MT_Vector3 movement = m_steerDelta * newvel;
+    obj->ApplyMovement(movement, false);
+  }
+}
+
 const MT_Vector3 &SCA_SteeringActuator::GetSteeringVec()
 {
   static MT_Vector3 ZERO_VECTOR(0, 0, 0);
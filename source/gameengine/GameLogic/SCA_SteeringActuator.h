@@ -64,6 +64,8 @@ class SCA_SteeringActuator : public SCA_IActuator {
   int m_wayPointIdx;
   MT_Matrix3x3 m_parentlocalmat;
   MT_Vector3 m_steerVec;
+  /// Time step of the last update, used to apply the velocity adjusted by the simulation.
+  double m_steerDelta;
   void HandleActorFace(MT_Vector3 &velocity);
 
  public:
@@ -92,6 +94,8 @@ class SCA_SteeringActuator : public SCA_IActuator {
                        bool lockzvel);
   virtual ~SCA_SteeringActuator();
   virtual bool Update(double curtime);
+  /// Move the object with the steering velocity of the last update.
+  void ApplyVelocity(const MT_Vector3 &velocity);
 
   virtual EXP_Value *GetReplica();
   virtual void ProcessReplica();
@@ -70,16 +70,12 @@ void SCA_TimeEventManager::NextFrame(double curtime, double fixedtime)
     return;
   }
 
-  EXP_FloatValue *floatval = new EXP_FloatValue(curtime);
-
-  // update sensors, but ... need deltatime !
+  /* The timer properties count up without expiry, they are all incremented. They are always
+   * float values, see BL_ConvertProperties. */
   for (EXP_Value *prop : m_timevalues) {
-    float newtime = prop->GetNumber() + fixedtime;
-    floatval->SetFloat(newtime);
-    prop->SetValue(floatval);
+    EXP_FloatValue *floatval = static_cast<EXP_FloatValue *>(prop);
+    floatval->SetFloat(floatval->GetFloat() + fixedtime);
   }
-
-  floatval->Release();
 }
 
 void SCA_TimeEventManager::AddTimeProperty(EXP_Value *timeval)
@@ -49,9 +49,13 @@ SCA_XNORController::~SCA_XNORController()
 {
 }
 
-void SCA_XNORController::Trigger(SCA_LogicManager *logicmgr)
+bool SCA_XNORController::IsThreadSafe() const
 {
+  return true;
+}
 
+bool SCA_XNORController::Evaluate() const
+{
   bool sensorresult = true;
 
   for (SCA_ISensor *sensor : m_linkedsensors) {
@@ -64,9 +68,12 @@ void SCA_XNORController::Trigger(SCA_LogicManager *logicmgr)
     }
   }
 
-  for (SCA_IActuator *actuator : m_linkedactuators) {
-    logicmgr->AddActiveActuator(actuator, sensorresult);
-  }
+  return sensorresult;
+}
+
+void SCA_XNORController::Trigger(SCA_LogicManager *logicmgr)
+{
+  TriggerActuators(logicmgr, Evaluate());
 }
 
 EXP_Value *SCA_XNORController::GetReplica()
@@ -49,9 +49,13 @@ SCA_XORController::~SCA_XORController()
 {
 }
 
-void SCA_XORController::Trigger(SCA_LogicManager *logicmgr)
+bool SCA_XORController::IsThreadSafe() const
 {
+  return true;
+}
 
+bool SCA_XORController::Evaluate() const
+{
   bool sensorresult = false;
 
   for (SCA_ISensor *sensor : m_linkedsensors) {
@@ -64,9 +68,12 @@ void SCA_XORController::Trigger(SCA_LogicManager *logicmgr)
     }
   }
 
-  for (SCA_IActuator *actuator : m_linkedactuators) {
-    logicmgr->AddActiveActuator(actuator, sensorresult);
-  }
+  return sensorresult;
+}
+
+void SCA_XORController::Trigger(SCA_LogicManager *logicmgr)
+{
+  TriggerActuators(logicmgr, Evaluate());
 }
 
 EXP_Value *SCA_XORController::GetReplica()
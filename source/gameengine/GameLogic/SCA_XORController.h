@@ -40,4 +40,6 @@ class SCA_XORController : public SCA_IController {
   virtual ~SCA_XORController();
   virtual EXP_Value *GetReplica();
   virtual void Trigger(SCA_LogicManager *logicmgr);
+  virtual bool IsThreadSafe() const;
+  virtual bool Evaluate() const;
 };
@@ -118,6 +118,7 @@
 #include "wm_window.h"
 
 #include "CM_Message.h"
+#include "CM_StartupProfiler.h"
 #include "KX_Globals.h"
 #include "KX_PythonInit.h"
 #include "LA_PlayerLauncher.h"
@@ -518,6 +519,62 @@ static void usage(const std::string &program, bool isBlenderPlayer)
   CM_Message("       show_camera_frustum            0         Show debug camera frustum volume");
   CM_Message(
       "       show_shadow_frustum            0         Show debug light shadow frustum volume");
+  CM_Message("       parallel_scene_step            0         Step scenes physics in parallel");
+  CM_Message("       retained_draw                  0         Reuse the draw of static views");
+  CM_Message("       frame_pacing                   0         Sleep between fixed framerate frames");
+  CM_Message("       deferred_swap                  0         Swap buffers after the next logic frame");
+  CM_Message("       low_latency                    0         Limit the frames queued to the GPU");
+  CM_Message("       max_frames_in_flight           1         Frames queued to the GPU in low latency");
+  CM_Message("       instanced_collections          0         Draw static collection members as instances");
+  CM_Message("       static_batching                0         Merge the meshes of the static objects");
+  CM_Message("       headless                       0         Run without window nor GPU, only logic, physics and network");
+  CM_Message("       physics_interpolation          0         Render interpolated physics between fixed frames");
+  CM_Message("       parallel_logic                 0         Evaluate logic bricks in parallel");
+  CM_Message("       stagger_pulses                 0         Spread the sensor pulses over the frames");
+  CM_Message("       profile_scripts                0         Profile python controllers and components");
+  CM_Message("       profile_gpu                    0         Measure the GPU time of the render passes");
+  CM_Message("       profile_objects                0         Measure the logic and physics time of each object");
+  CM_Message("       profile_depsgraph              0         Measure the stages of the depsgraph update");
+  CM_Message("       profile_allocations            0         Count the allocations of each profiling category");
+  CM_Message("       profile_startup                0         Print the timeline of the startup until the first frame");
+  CM_Message("       startup_trace                            File to write the trace of the profiled startup");
+  CM_Message("       show_hud                       0         Show the graphs of the performance counters");
+  CM_Message("       shader_cache                   1         Cache the compiled shaders on disk");
+  CM_Message("       mesh_cache                     0         Cache the converted meshes on disk");
+  CM_Message("       lazy_meshes                    1         Convert the meshes of the inactive objects when added");
+  CM_Message("       texture_streaming              0         Load the textures at the resolution of their size on screen");
+  CM_Message("       texture_budget                 1024      Memory in MB of the streamed textures");
+  CM_Message("       compressed_textures            0         Load the textures from their KTX2 or DDS files");
+  CM_Message("       transcode_textures             0         Save the DDS files of the textures without one");
+  CM_Message("       light_budget                   0         Most lights drawn per camera, the smallest on screen culled, 0 for all");
+  CM_Message("       main_thread_node               -1        NUMA node of the main and render thread, -1 to not pin it");
+  CM_Message("       worker_node                    -1        NUMA node of the worker threads, -1 to not pin them");
+  CM_Message("       worker_threads                 0         Number of worker threads, 0 for the default or their node size");
+  CM_Message("       dynamic_resolution             0         Lower the render resolution when the GPU is slow");
+  CM_Message("       target_frametime               0.0       GPU time in ms to hold, 0 for the logic tic rate");
+  CM_Message("       min_resolution_scale           0.5       Lowest scale of the render resolution");
+  CM_Message("       shared_render_targets          1         Share the temporary render targets between the cameras");
+  CM_Message("       deferred_shaders               0         Compile the materials added in game between frames");
+  CM_Message("       static_shadows                 0         Cache the shadows of the objects not moved in game");
+  CM_Message("       deferred_geometry              0         Update the geometry of the culled objects once visible");
+  CM_Message("       multi_view                     1         Draw the stereo eyes and same size viewports from shared caches");
+  CM_Message("       overlay_workbench              0         Draw the overlay collections unlit with the workbench engine");
+  CM_Message("       debug_draw_capacity            65536     Lines and triangles of the debug shapes drawn per frame");
+  CM_Message("       hud_counters                   255       Mask of the counters shown in the graphs");
+  CM_Message("       network_port                   0         Local UDP port exchanging the messages with the peers");
+  CM_Message("       network_peers                            Comma separated host:port list receiving the messages");
+  CM_Message("       replication_rate               30        Sends per second of the replicated objects");
+  CM_Message("       replication_radius             0         Distance around the peers of the sent objects, 0 for all");
+  CM_Message("       sound_voices                   64        Maximum number of mixed sounds, 0 for unlimited");
+  CM_Message("       sound_stream_length            0.0       Seconds from which the actuator sounds are streamed, 0 to disable");
+  CM_Message("       input_record                             File to write the recorded inputs");
+  CM_Message("       input_replay                             File of the recorded inputs to replay");
+  CM_Message("       capture_file                             Video file recording the game from the start");
+  CM_Message("       capture_rate                   0         Frames per second of the video, 0 for the scene frame rate");
+  CM_Message("       capture_hardware               1         Prefer a hardware video encoder");
+  CM_Message("       frame_count                    0         Number of frames before the game ends");
+  CM_Message("       stats_output                             File to write the JSON timing report");
+  CM_Message("       benchmark_render               1         Render the frames of a benchmark");
   CM_Message("       ignore_deprecation_warnings    1         Ignore deprecation warnings"
              << std::endl);
   CM_Message("  -p: override python main loop script");
@@ -591,6 +648,8 @@ static BlendFileData *load_game_data(const char *progname,
   BlendFileReadReport breports;
   breports.reports = &reports;
 
+  CM_StartupScope readScope("Read File", progname);
+
   /* try to load ourself, will only work if we are a runtime */
   if (BLO_is_a_runtime(progname)) {
     bfd = BLO_read_runtime(progname, &breports);
@@ -1358,13 +1417,22 @@ int main(int argc,
     usage(argv[0], isBlenderPlayer);
     return 0;
   }
+  /* Dedicated server mode: no window nor GPU context, the engine only runs the logic, physics
+   * and network. */
+  const bool headless = (SYS_GetCommandLineInt(syshandle, "headless", 0) != 0);
+  if (headless) {
+    G.background = true;
+  }
+
   GHOST_ISystem *system = nullptr;
 #ifdef WIN32
   if (scr_saver_mode != SCREEN_SAVER_MODE_CONFIGURATION)
 #endif
   {
     // Create the system
-    if (GHOST_ISystem::createSystem() == GHOST_kSuccess) {
+    const GHOST_TSuccess systemSuccess = headless ? GHOST_ISystem::createSystemHeadless() :
+                                                    GHOST_ISystem::createSystem();
+    if (systemSuccess == GHOST_kSuccess) {
       system = GHOST_ISystem::getSystem();
       BLI_assert(system);
 
@@ -1404,6 +1472,9 @@ int main(int argc,
         bool useViewportRender = false;
 
         do {
+          // Record the startup timeline from the file read.
+          LA_Launcher::StartStartupProfiler();
+
           // Read the Blender file
 
           // if we got an exitcode 3 (KX_ExitRequest::START_OTHER_GAME) load a different file
@@ -1578,7 +1649,10 @@ int main(int argc,
             if (firstTimeRunning) {
               firstTimeRunning = false;
 
-              if (fullScreen) {
+              if (headless) {
+                // No window.
+              }
+              else if (fullScreen) {
 #ifdef WIN32
                 if (scr_saver_mode == SCREEN_SAVER_MODE_SAVER) {
                   window = startScreenSaverFullScreen(system,
@@ -1669,23 +1743,29 @@ int main(int argc,
             CTX_wm_manager_set(C, wm);
             CTX_wm_window_set(C, win);
             InitBlenderContextVariables(C, wm, bfd->curscene);
-            wm_window_ghostwindow_blenderplayer_ensure(wm, win, window, first_time_window);
+            if (headless) {
+              wm_window_blenderplayer_headless_ensure(
+                  wm, win, scene->gm.xplay, scene->gm.yplay, first_time_window);
+            }
+            else {
+              wm_window_ghostwindow_blenderplayer_ensure(wm, win, window, first_time_window);
 
-            /* The following is needed to run some bpy operators in blenderplayer */
-            ED_screen_refresh_blenderplayer(win);
+              /* The following is needed to run some bpy operators in blenderplayer */
+              ED_screen_refresh_blenderplayer(win);
 
-            if (first_time_window) {
-              /* We need to have first an ogl context bound and it's done
-               * in wm_window_ghostwindow_blenderplayer_ensure.
-               */
-              WM_init_opengl_blenderplayer(system);
+              if (first_time_window) {
+                /* We need to have first an ogl context bound and it's done
+                 * in wm_window_ghostwindow_blenderplayer_ensure.
+                 */
+                WM_init_opengl_blenderplayer(system);
 
-              UI_theme_init_default();
-              UI_init();
+                UI_theme_init_default();
+                UI_init();
 
-              /* Set Viewport render mode and shading type for the whole runtime */
-              useViewportRender = scene->gm.flag & GAME_USE_VIEWPORT_RENDER;
-              shadingTypeRuntime = GetShadingTypeRuntime(C);
+                /* Set Viewport render mode and shading type for the whole runtime */
+                useViewportRender = scene->gm.flag & GAME_USE_VIEWPORT_RENDER;
+                shadingTypeRuntime = GetShadingTypeRuntime(C);
+              }
             }
             first_time_window = false;
 
@@ -1833,11 +1913,13 @@ int main(int argc,
 
   BLF_exit();
 
-  DRW_opengl_context_enable_ex(false);
-  GPU_pass_cache_free();
-  GPU_exit();
-  DRW_opengl_context_disable_ex(false);
-  DRW_opengl_context_destroy();
+  if (!headless) {
+    DRW_opengl_context_enable_ex(false);
+    GPU_pass_cache_free();
+    GPU_exit();
+    DRW_opengl_context_disable_ex(false);
+    DRW_opengl_context_destroy();
+  }
 
   if (window) {
     system->disposeWindow(window);
@@ -1858,7 +1940,9 @@ int main(int argc,
 
   ED_file_exit(); /* for fsmenu */
 
-  UI_exit();
+  if (!headless) {
+    UI_exit();
+  }
   BKE_blender_userdef_data_free(&U, false);
 
   RNA_exit(); /* should be after BPY_python_end so struct python slots are cleared */
@@ -26,8 +26,11 @@
 
 #include "BL_Action.h"
 
+#include <cmath>
+
 #include "BKE_action.h"
 #include "BKE_context.h"
+#include "BKE_fcurve.h"
 #include "BKE_modifier.h"
 #include "BKE_node.h"
 #include "BLI_listbase.h"
@@ -41,6 +44,8 @@
 #include "BL_IpoConvert.h"
 #include "CM_Message.h"
 
+#define IS_TAGGED(_id) ((_id) && (((ID *)_id)->tag & LIB_TAG_DOIT))
+
 BL_Action::BL_Action(class KX_GameObject *gameobj)
     : m_action(nullptr),
       m_blendpose(nullptr),
@@ -59,8 +64,17 @@ BL_Action::BL_Action(class KX_GameObject *gameobj)
       m_ipo_flags(0),
       m_done(true),
       m_appliedToObject(true),
+      m_objectUpdatePending(false),
       m_calc_localtime(true),
-      m_prevUpdate(-1.0f)
+      m_prevUpdate(-1.0f),
+      m_bakedAction(nullptr),
+      m_bakedStart(0),
+      m_bakedEnd(0),
+      m_actionTarget(ACT_TARGET_OBJECT),
+      m_actionFallbackTarget(ACT_TARGET_OBJECT),
+      m_actionNodeTree(nullptr),
+      m_actionNodeTreeOwner(nullptr),
+      m_shapeKey(nullptr)
 {
   bContext *C = KX_GetActiveEngine()->GetContext();
   Depsgraph *depsgraph = CTX_data_depsgraph_on_load(C);
@@ -100,7 +114,7 @@ void BL_Action::ClearControllerList()
   m_sg_contr_list.clear();
 }
 
-bool BL_Action::Play(const std::string &name,
+bool BL_Action::Play(bAction *action,
                      float start,
                      float end,
                      short priority,
@@ -109,7 +123,8 @@ bool BL_Action::Play(const std::string &name,
                      float layer_weight,
                      short ipo_flags,
                      float playback_speed,
-                     short blend_mode)
+                     short blend_mode,
+                     bool bake)
 {
 
   // Only start playing a new action if we're done, or if
@@ -121,10 +136,8 @@ bool BL_Action::Play(const std::string &name,
 
   KX_Scene *kxscene = m_obj->GetScene();
 
-  // First try to load the action
-  m_action = (bAction *)kxscene->GetLogicManager()->GetActionByName(name);
+  m_action = action;
   if (!m_action) {
-    CM_Error("failed to load action: " << name);
     m_done = true;
     return false;
   }
@@ -198,14 +211,133 @@ bool BL_Action::Play(const std::string &name,
 
   m_prevUpdate = -1.0f;
 
+  // Find the data animated by the action once instead of matching the names every frame.
+  if (m_obj->GetGameObjectType() != SCA_IObject::OBJ_ARMATURE) {
+    m_actionNodeTree = nullptr;
+    m_actionNodeTreeOwner = nullptr;
+    m_nodeTreeValues.clear();
+    m_shapeKey = nullptr;
+    m_actionTarget = ClassifyAction(true);
+    m_actionFallbackTarget = (m_actionTarget == ACT_TARGET_CONSTRAINT) ? ClassifyAction(false) :
+                                                                         m_actionTarget;
+  }
+
+  /* Keep the samples of the same action already baked for the same frame range,
+   * a replayed clip doesn't need to be sampled again. */
+  const int bakeStart = (int)std::floor(std::min(m_startframe, m_endframe));
+  const int bakeEnd = (int)std::ceil(std::max(m_startframe, m_endframe));
+  if (!bake || m_obj->GetGameObjectType() != SCA_IObject::OBJ_ARMATURE) {
+    m_bakedAction = nullptr;
+  }
+  else if (m_bakedAction != m_action || m_bakedStart != bakeStart || m_bakedEnd != bakeEnd) {
+    m_bakedStart = bakeStart;
+    m_bakedEnd = bakeEnd;
+    if (!BakeAction()) {
+      CM_Warning("action " << m_action->id.name + 2
+                           << " can't be baked, it is evaluated every frame");
+    }
+  }
+
   return true;
 }
 
+bool BL_Action::BakeAction()
+{
+  m_bakedAction = nullptr;
+  m_bakedChannels.clear();
+  m_bakedSamples.clear();
+
+  Object *ob = ((BL_ArmatureObject *)m_obj)->GetArmatureObject();
+  PointerRNA ptrrna;
+  RNA_id_pointer_create(&ob->id, &ptrrna);
+
+  // Resolve the RNA path of the curves only once, as animsys_evaluate_action does each frame.
+  std::vector<FCurve *> fcurves;
+  LISTBASE_FOREACH (FCurve *, fcu, &m_action->curves) {
+    if ((fcu->flag & (FCURVE_MUTED | FCURVE_DISABLED)) ||
+        (fcu->grp && (fcu->grp->flag & AGRP_MUTED)) || BKE_fcurve_is_empty(fcu)) {
+      continue;
+    }
+
+    PathResolvedRNA anim_rna;
+    if (!BKE_animsys_rna_path_resolve(&ptrrna, fcu->rna_path, fcu->array_index, &anim_rna)) {
+      continue;
+    }
+
+    // Interpolating the samples is only valid for float properties.
+    if (fcu->driver || RNA_property_type(anim_rna.prop) != PROP_FLOAT) {
+      m_bakedChannels.clear();
+      return false;
+    }
+
+    m_bakedChannels.push_back(anim_rna);
+    fcurves.push_back(fcu);
+  }
+
+  const unsigned int numChannels = m_bakedChannels.size();
+  m_bakedSamples.resize((m_bakedEnd - m_bakedStart + 1) * numChannels);
+  for (int frame = m_bakedStart; frame <= m_bakedEnd; ++frame) {
+    float *samples = &m_bakedSamples[(frame - m_bakedStart) * numChannels];
+    for (unsigned int i = 0; i < numChannels; ++i) {
+      samples[i] = evaluate_fcurve(fcurves[i], (float)frame);
+    }
+  }
+
+  m_bakedAction = m_action;
+  return true;
+}
+
+void BL_Action::ApplyBakedAction(float frame)
+{
+  const unsigned int numChannels = m_bakedChannels.size();
+  const float localframe = std::min(std::max(frame, (float)m_bakedStart), (float)m_bakedEnd);
+  const int index = std::min((int)(localframe - m_bakedStart), m_bakedEnd - m_bakedStart - 1);
+
+  // A single frame action doesn't need interpolation.
+  if (index < 0) {
+    for (unsigned int i = 0; i < numChannels; ++i) {
+      BKE_animsys_write_to_rna_path(&m_bakedChannels[i], m_bakedSamples[i]);
+    }
+    return;
+  }
+
+  const float factor = localframe - (float)(m_bakedStart + index);
+  const float *prev = &m_bakedSamples[index * numChannels];
+  const float *next = prev + numChannels;
+  for (unsigned int i = 0; i < numChannels; ++i) {
+    BKE_animsys_write_to_rna_path(&m_bakedChannels[i], prev[i] + (next[i] - prev[i]) * factor);
+  }
+}
+
 bool BL_Action::IsDone()
 {
   return m_done;
 }
 
+bool BL_Action::IsFinished() const
+{
+  return m_done && m_appliedToObject;
+}
+
+void BL_Action::RemoveTaggedData()
+{
+  if (IS_TAGGED(m_actionNodeTreeOwner)) {
+    m_actionNodeTree = nullptr;
+    m_actionNodeTreeOwner = nullptr;
+    m_nodeTreeValues.clear();
+    if (m_actionTarget == ACT_TARGET_NODETREE) {
+      m_actionTarget = ACT_TARGET_OBJECT;
+    }
+    if (m_actionFallbackTarget == ACT_TARGET_NODETREE) {
+      m_actionFallbackTarget = ACT_TARGET_OBJECT;
+    }
+  }
+
+  if (IS_TAGGED(m_shapeKey)) {
+    m_shapeKey = nullptr;
+  }
+}
+
 void BL_Action::InitIPO()
 {
   // Initialize the IPOs
@@ -238,6 +370,46 @@ const std::string BL_Action::GetName()
   }
 }
 
+float BL_Action::GetStartFrame() const
+{
+  return m_startframe;
+}
+
+float BL_Action::GetEndFrame() const
+{
+  return m_endframe;
+}
+
+float BL_Action::GetSpeed() const
+{
+  return m_speed;
+}
+
+float BL_Action::GetLayerWeight() const
+{
+  return m_layer_weight;
+}
+
+short BL_Action::GetPriority() const
+{
+  return m_priority;
+}
+
+short BL_Action::GetPlayMode() const
+{
+  return m_playmode;
+}
+
+short BL_Action::GetBlendMode() const
+{
+  return m_blendmode;
+}
+
+short BL_Action::GetIpoFlags() const
+{
+  return m_ipo_flags;
+}
+
 void BL_Action::SetFrame(float frame)
 {
   // Clamp the frame to the start and end frame
@@ -344,14 +516,95 @@ static bool ActionMatchesName(bAction *action, char *name, eActionType type)
   return false;
 }
 
-void BL_Action::Update(float curtime, bool applyToObject)
+BL_Action::ActionTarget BL_Action::ClassifyAction(bool useConstraints)
+{
+  Object *ob = m_obj->GetBlenderObject();
+  if (!ob) {
+    return ACT_TARGET_OBJECT;
+  }
+
+  /* WARNING: The check to be sure the right action is played (to know if the action
+   * which is in the actuator will be the one which will be played)
+   * might be wrong (if (ob->adt && ob->adt->action == m_action) playaction;)
+   * because WE MIGHT NEED TO CHANGE OB->ADT->ACTION DURING RUNTIME
+   * then another check should be found to ensure to play the right action.
+   */
+  // TEST KEYFRAMED MODIFIERS (WRONG CODE BUT JUST FOR TESTING PURPOSE)
+  LISTBASE_FOREACH (ModifierData *, md, &ob->modifiers) {
+    if (ActionMatchesName(m_action, md->name, ACT_TYPE_MODIFIER) &&
+        !BKE_modifier_is_non_geometrical(md)) {
+      return ACT_TARGET_MODIFIER;
+    }
+    /* HERE we can add other modifier action types,
+     * if some actions require another notifier than ID_RECALC_GEOMETRY */
+  }
+
+  LISTBASE_FOREACH (GpencilModifierData *, gpmd, &ob->greasepencil_modifiers) {
+    if (ActionMatchesName(m_action, gpmd->name, ACT_TYPE_GPMODIFIER)) {
+      return ACT_TARGET_GPMODIFIER;
+    }
+  }
+
+  // TEST FollowPath action
+  if (useConstraints) {
+    LISTBASE_FOREACH (bConstraint *, con, &ob->constraints) {
+      if (ActionMatchesName(m_action, con->name, ACT_TYPE_CONSTRAINT)) {
+        return ACT_TARGET_CONSTRAINT;
+      }
+    }
+  }
+
+  // TEST IDPROP ACTIONS
+  if (ob->id.properties) {
+    LISTBASE_FOREACH (IDProperty *, prop, &ob->id.properties->data.group) {
+      if (prop->type != IDP_GROUP && ActionMatchesName(m_action, prop->name, ACT_TYPE_IDPROP)) {
+        return ACT_TARGET_IDPROP;
+      }
+    }
+  }
+
+  // Node Trees actions (Geometry one and Shader ones (material, world))
+  Main *bmain = KX_GetActiveEngine()->GetConverter()->GetMain();
+  FOREACH_NODETREE_BEGIN (bmain, nodetree, id) {
+    bool isRightAction = (nodetree->adt && nodetree->adt->action == m_action);
+    if (!isRightAction && nodetree->adt && nodetree->adt->nla_tracks.first) {
+      LISTBASE_FOREACH (NlaTrack *, track, &nodetree->adt->nla_tracks) {
+        LISTBASE_FOREACH (NlaStrip *, strip, &track->strips) {
+          if (strip->act == m_action) {
+            isRightAction = true;
+            break;
+          }
+        }
+      }
+    }
+    if (isRightAction) {
+      m_actionNodeTree = nodetree;
+      m_actionNodeTreeOwner = id;
+      return ACT_TARGET_NODETREE;
+    }
+  }
+  FOREACH_NODETREE_END;
+
+  // TEST Shapekeys action
+  Mesh *me = (Mesh *)ob->data;
+  if (ob->type == OB_MESH && me) {
+    const bool bHasShapeKey = me->key && me->key->type == KEY_RELATIVE;
+    if (bHasShapeKey && me->key->adt && me->key->adt->action == m_action) {
+      return ACT_TARGET_SHAPEKEY;
+    }
+  }
+
+  return ACT_TARGET_OBJECT;
+}
+
+bool BL_Action::Update(float curtime, bool applyToObject, bool deferObject)
 {
   /* Don't bother if we're done with the animation and if the animation was already applied to the
    * object. of if the animation made a double update for the same time and that it was applied to
    * the object.
    */
   if ((m_done || m_prevUpdate == curtime) && m_appliedToObject) {
-    return;
+    return false;
   }
   m_prevUpdate = curtime;
 
@@ -398,13 +651,12 @@ void BL_Action::Update(float curtime, bool applyToObject)
   m_appliedToObject = applyToObject;
   // In case of culled armatures (doesn't requesting to transform the object) we only manages time.
   if (!applyToObject) {
-    return;
+    return false;
   }
 
-  // Update controllers time. The controllers list is cleared when action is done
-  for (SG_Controller *cont : m_sg_contr_list) {
-    cont->SetSimulatedTime(m_localframe);  // update spatial controllers
-    cont->Update(m_localframe);
+  m_objectUpdatePending = true;
+  if (!deferObject) {
+    UpdateObject();
   }
 
   Object *ob = m_obj->GetBlenderObject();  // eevee
@@ -414,23 +666,38 @@ void BL_Action::Update(float curtime, bool applyToObject)
   AnimationEvalContext animEvalContext = BKE_animsys_eval_context_construct_at(&m_animEvalCtx,
                                                                                m_localframe);
 
+  /* The armature poses can be updated from several threads, they are then only tagged
+   * for the depsgraph by the caller, see KX_Scene::UpdateAnimations. */
+  bool poseUpdated = false;
   if (m_obj->GetGameObjectType() == SCA_IObject::OBJ_ARMATURE) {
-    if (ob->gameflag & OB_OVERLAY_COLLECTION) {
-      scene->AppendToExtraObjectsToUpdateInOverlayPass(ob, ID_RECALC_TRANSFORM);
-    }
-    else {
-      scene->AppendToExtraObjectsToUpdateInAllRenderPasses(ob, ID_RECALC_TRANSFORM);
-    }
-
     BL_ArmatureObject *obj = (BL_ArmatureObject *)m_obj;
 
     if (m_layer_weight >= 0)
       obj->GetPose(&m_blendpose);
 
-    // Extract the pose from the action
-    obj->SetPoseByAction(m_action, &animEvalContext);
+    /* Armatures sharing their armature data and playing the same action frame without
+     * blending get the same pose, only the first one evaluates it. */
+    Object *armaob = obj->GetArmatureObject();
+    const bool baked = (m_bakedAction == m_action);
+    const bool sharePose = (ID_REAL_USERS((ID *)armaob->data) > 1 && m_layer_weight < 0.0f &&
+                            !(m_blendin && m_blendframe < m_blendin));
+    BL_PoseCache &poseCache = scene->GetPoseCache();
+    bool poseOwner = false;
+    if (!sharePose ||
+        !poseCache.GetPose(
+            m_action, armaob->data, m_localframe, baked, obj->GetPose(), poseOwner)) {
+      // Extract the pose from the action
+      if (baked) {
+        ApplyBakedAction(m_localframe);
+      }
+      else {
+        obj->SetPoseByAction(m_action, &animEvalContext);
+      }
 
-    m_obj->ForceIgnoreParentTx();
+      if (poseOwner) {
+        poseCache.SetPose(m_action, armaob->data, baked, obj->GetPose());
+      }
+    }
 
     // Handle blending between armature actions
     if (m_blendin && m_blendframe < m_blendin) {
@@ -448,177 +715,164 @@ void BL_Action::Update(float curtime, bool applyToObject)
       obj->BlendInPose(m_blendpose, m_layer_weight, m_blendmode);
 
     obj->UpdateTimestep(curtime);
+    poseUpdated = true;
   }
   else {
-    /* To skip some code if not needed */
-    bool actionIsUpdated = false;
-
-    /* WARNING: The check to be sure the right action is played (to know if the action
-     * which is in the actuator will be the one which will be played)
-     * might be wrong (if (ob->adt && ob->adt->action == m_action) playaction;)
-     * because WE MIGHT NEED TO CHANGE OB->ADT->ACTION DURING RUNTIME
-     * then another check should be found to ensure to play the right action.
-     */
-    // TEST KEYFRAMED MODIFIERS (WRONG CODE BUT JUST FOR TESTING PURPOSE)
-    LISTBASE_FOREACH (ModifierData *, md, &ob->modifiers) {
-      bool isRightAction = ActionMatchesName(m_action, md->name, ACT_TYPE_MODIFIER);
-      // TODO: We need to find the good notifier per action
-      if (isRightAction && !BKE_modifier_is_non_geometrical(md)) {
+    /* The animated data was found when the action was played, see ClassifyAction.
+     * A constraint needs the object to be transformable in realtime, else the next
+     * matching data is used like if the constraint was not animated. */
+    ActionTarget target = m_actionTarget;
+    if (target == ACT_TARGET_CONSTRAINT && !scene->OrigObCanBeTransformedInRealtime(ob)) {
+      target = m_actionFallbackTarget;
+    }
+
+    switch (target) {
+      case ACT_TARGET_MODIFIER:
+      case ACT_TARGET_GPMODIFIER:
+      case ACT_TARGET_CONSTRAINT:
+      case ACT_TARGET_IDPROP: {
+        // TODO: We need to find the good notifier per action
+        const IDRecalcFlag flag = (target == ACT_TARGET_MODIFIER ||
+                                   target == ACT_TARGET_GPMODIFIER) ?
+                                      ID_RECALC_GEOMETRY :
+                                      ID_RECALC_TRANSFORM;
         if (ob->gameflag & OB_OVERLAY_COLLECTION) {
-          scene->AppendToExtraObjectsToUpdateInOverlayPass(ob, ID_RECALC_GEOMETRY);
+          scene->AppendToExtraObjectsToUpdateInOverlayPass(ob, flag);
         }
         else {
-          scene->AppendToExtraObjectsToUpdateInAllRenderPasses(ob, ID_RECALC_GEOMETRY);
+          scene->AppendToExtraObjectsToUpdateInAllRenderPasses(ob, flag, m_obj);
         }
         PointerRNA ptrrna;
         RNA_id_pointer_create(&ob->id, &ptrrna);
         animsys_evaluate_action(&ptrrna, m_action, &animEvalContext, false);
-        actionIsUpdated = true;
-        break;
-      }
-      /* HERE we can add other modifier action types,
-       * if some actions require another notifier than ID_RECALC_GEOMETRY */
-    }
-
-    if (!actionIsUpdated) {
-      LISTBASE_FOREACH (GpencilModifierData *, gpmd, &ob->greasepencil_modifiers) {
-        // TODO: We need to find the good notifier per action (maybe all ID_RECALC_GEOMETRY except
-        // the Color ones)
-        bool isRightAction = ActionMatchesName(m_action, gpmd->name, ACT_TYPE_GPMODIFIER);
-        if (isRightAction) {
-          if (ob->gameflag & OB_OVERLAY_COLLECTION) {
-            scene->AppendToExtraObjectsToUpdateInOverlayPass(ob, ID_RECALC_GEOMETRY);
-          }
-          else {
-            scene->AppendToExtraObjectsToUpdateInAllRenderPasses(ob, ID_RECALC_GEOMETRY);
-          }
-          PointerRNA ptrrna;
-          RNA_id_pointer_create(&ob->id, &ptrrna);
-          animsys_evaluate_action(&ptrrna, m_action, &animEvalContext, false);
-          actionIsUpdated = true;
-          break;
-        }
-      }
-    }
-
-    if (!actionIsUpdated) {
-      // TEST FollowPath action
-      LISTBASE_FOREACH (bConstraint *, con, &ob->constraints) {
-        if (ActionMatchesName(m_action, con->name, ACT_TYPE_CONSTRAINT)) {
-          if (!scene->OrigObCanBeTransformedInRealtime(ob)) {
-            break;
-          }
-          if (ob->gameflag & OB_OVERLAY_COLLECTION) {
-            scene->AppendToExtraObjectsToUpdateInOverlayPass(ob, ID_RECALC_TRANSFORM);
-          }
-          else {
-            scene->AppendToExtraObjectsToUpdateInAllRenderPasses(ob, ID_RECALC_TRANSFORM);
-          }
-          PointerRNA ptrrna;
-          RNA_id_pointer_create(&ob->id, &ptrrna);
-          animsys_evaluate_action(&ptrrna, m_action, &animEvalContext, false);
 
+        if (target == ACT_TARGET_CONSTRAINT) {
           m_obj->ForceIgnoreParentTx();
-          actionIsUpdated = true;
-          break;
-          /* HERE we can add other constraint action types,
-           * if some actions require another notifier than ID_RECALC_TRANSFORM */
         }
+        break;
       }
-    }
+      case ACT_TARGET_NODETREE: {
+        PointerRNA ptrrna;
+        RNA_id_pointer_create(&m_actionNodeTree->id, &ptrrna);
+        animsys_evaluate_action(&ptrrna, m_action, &animEvalContext, false);
 
-    // TEST IDPROP ACTIONS
-    if (!actionIsUpdated) {
-      if (ob->id.properties) {
-        LISTBASE_FOREACH (IDProperty *, prop, &ob->id.properties->data.group) {
-          if (prop->type == IDP_GROUP) {
-            continue;
-          }
-          if (ActionMatchesName(m_action, prop->name, ACT_TYPE_IDPROP)) {
-            if (ob->gameflag & OB_OVERLAY_COLLECTION) {
-              scene->AppendToExtraObjectsToUpdateInOverlayPass(ob, ID_RECALC_TRANSFORM);
-            }
-            else {
-              scene->AppendToExtraObjectsToUpdateInAllRenderPasses(ob, ID_RECALC_TRANSFORM);
-            }
-            PointerRNA ptrrna;
-            RNA_id_pointer_create(&ob->id, &ptrrna);
-            animsys_evaluate_action(&ptrrna, m_action, &animEvalContext, false);
-            actionIsUpdated = true;
-            break;
+        /* The node tree update evaluates its materials again, skip it when the curves give
+         * the same values as in the last update, e.g. on held or looping poses. */
+        const size_t numCurves = BLI_listbase_count(&m_action->curves);
+        bool valuesChanged = (m_nodeTreeValues.size() != numCurves);
+        m_nodeTreeValues.resize(numCurves);
+        unsigned int i = 0;
+        LISTBASE_FOREACH (FCurve *, fcu, &m_action->curves) {
+          const float value = evaluate_fcurve(fcu, m_localframe);
+          if (m_nodeTreeValues[i] != value) {
+            m_nodeTreeValues[i] = value;
+            valuesChanged = true;
           }
+          ++i;
         }
-      }
-    }
 
-    if (!actionIsUpdated) {
-      // Node Trees actions (Geometry one and Shader ones (material, world))
-      Main *bmain = KX_GetActiveEngine()->GetConverter()->GetMain();
-      FOREACH_NODETREE_BEGIN (bmain, nodetree, id) {
-        bool isRightAction = false;
-        isRightAction = (nodetree->adt && nodetree->adt->action == m_action);
-        if (!isRightAction && nodetree->adt && nodetree->adt->nla_tracks.first) {
-          LISTBASE_FOREACH (NlaTrack *, track, &nodetree->adt->nla_tracks) {
-            LISTBASE_FOREACH (NlaStrip *, strip, &track->strips) {
-              if (strip->act == m_action) {
-                isRightAction = true;
-                break;
-              }
-            }
-          }
+        if (valuesChanged) {
+          scene->AppendToNodeTreesToUpdateInAllRenderPasses(m_actionNodeTree);
         }
-        if (isRightAction) {
-          scene->AppendToNodeTreesToUpdateInAllRenderPasses(nodetree);
-          PointerRNA ptrrna;
-          RNA_id_pointer_create(&nodetree->id, &ptrrna);
-          animsys_evaluate_action(&ptrrna, m_action, &animEvalContext, false);
-          actionIsUpdated = true;
+        break;
+      }
+      case ACT_TARGET_SHAPEKEY: {
+        Mesh *me = (Mesh *)ob->data;
+        // The mesh could have been replaced since the action was played.
+        if (ob->type != OB_MESH || !me || !me->key || me->key->type != KEY_RELATIVE ||
+            !me->key->adt || me->key->adt->action != m_action) {
           break;
         }
-      }
-      FOREACH_NODETREE_END;
-    }
-
-    if (!actionIsUpdated) {
-      // TEST Shapekeys action
-      Mesh *me = (Mesh *)ob->data;
-      if (ob->type == OB_MESH && me) {
-        const bool bHasShapeKey = me->key && me->key->type == KEY_RELATIVE;
-        if (bHasShapeKey && me->key->adt && me->key->adt->action == m_action) {
-          scene->AppendToMeshesToUpdateInAllRenderPasses(me, ID_RECALC_GEOMETRY);
-          Key *key = me->key;
+        Key *key = me->key;
 
-          PointerRNA ptrrna;
-          RNA_id_pointer_create(&key->id, &ptrrna);
-          animsys_evaluate_action(&ptrrna, m_action, &animEvalContext, false);
+        PointerRNA ptrrna;
+        RNA_id_pointer_create(&key->id, &ptrrna);
+        animsys_evaluate_action(&ptrrna, m_action, &animEvalContext, false);
 
-          // Handle blending between shape actions
-          if (m_blendin && m_blendframe < m_blendin) {
-            IncrementBlending(curtime);
+        // Handle blending between shape actions
+        const bool blending = (m_blendin && m_blendframe < m_blendin);
+        if (blending) {
+          IncrementBlending(curtime);
 
-            // float weight = 1.f - (m_blendframe / m_blendin);
+          // float weight = 1.f - (m_blendframe / m_blendin);
 
-            // We go through and clear out the keyblocks so there isn't any interference
-            // from other shape actions
-            KeyBlock *kb;
-            for (kb = (KeyBlock *)key->block.first; kb; kb = (KeyBlock *)kb->next) {
-              kb->curval = 0.f;
-            }
+          // We go through and clear out the keyblocks so there isn't any interference
+          // from other shape actions
+          KeyBlock *kb;
+          for (kb = (KeyBlock *)key->block.first; kb; kb = (KeyBlock *)kb->next) {
+            kb->curval = 0.f;
+          }
 
-            // Now blend the shape
-            // BlendShape(key, weight, m_blendinshape);
+          // Now blend the shape
+          // BlendShape(key, weight, m_blendinshape);
+        }
+        //// Handle layer blending
+        // if (m_layer_weight >= 0) {
+        //  shape_deformer->GetShape(m_blendshape);
+        //  BlendShape(key, m_layer_weight, m_blendshape);
+        //}
+
+        // shape_deformer->SetLastFrame(curtime);
+
+        /* The key evaluation of the mesh blends all the key blocks, skip it when the
+         * weights are the same as in the last update, e.g. on held or looping poses. */
+        bool weightsChanged = (blending || key != m_shapeKey ||
+                               m_shapeWeights.size() != (size_t)key->totkey);
+        m_shapeWeights.resize(key->totkey);
+        unsigned int i = 0;
+        LISTBASE_FOREACH (KeyBlock *, kb, &key->block) {
+          if (i == m_shapeWeights.size()) {
+            break;
           }
-          //// Handle layer blending
-          // if (m_layer_weight >= 0) {
-          //  shape_deformer->GetShape(m_blendshape);
-          //  BlendShape(key, m_layer_weight, m_blendshape);
-          //}
+          if (m_shapeWeights[i] != kb->curval) {
+            m_shapeWeights[i] = kb->curval;
+            weightsChanged = true;
+          }
+          ++i;
+        }
+        m_shapeKey = key;
 
-          // shape_deformer->SetLastFrame(curtime);
+        if (weightsChanged) {
+          scene->AppendToMeshesToUpdateInAllRenderPasses(me, ID_RECALC_GEOMETRY);
         }
+        break;
+      }
+      case ACT_TARGET_OBJECT: {
+        // Only the object transform is animated, by the scene graph controllers.
+        break;
       }
     }
   }
+  return poseUpdated;
+}
+
+void BL_Action::UpdateObject()
+{
+  if (!m_objectUpdatePending) {
+    return;
+  }
+  m_objectUpdatePending = false;
+
+  /* Update controllers time. The controllers list is cleared when action is done.
+   * The transform controller, always the first, is evaluated with the other transform
+   * controllers of the scene unless it is freed at the end of this update. */
+  KX_IpoBatch &ipoBatch = m_obj->GetScene()->GetIpoBatch();
+  const bool batchTransform = (ipoBatch.IsOpen() && !m_done);
+  for (unsigned int i = 0, size = m_sg_contr_list.size(); i < size; ++i) {
+    SG_Controller *cont = m_sg_contr_list[i];
+    cont->SetSimulatedTime(m_localframe);  // update spatial controllers
+    if (i == 0 && batchTransform) {
+      ipoBatch.Add(static_cast<KX_IpoSGController *>(cont));
+    }
+    else {
+      cont->Update(m_localframe);
+    }
+  }
+
+  if (m_obj->GetGameObjectType() == SCA_IObject::OBJ_ARMATURE) {
+    m_obj->ForceIgnoreParentTx();
+  }
+
   // If the action is done we can remove its scene graph IPO controller.
   if (m_done) {
     ClearControllerList();
@@ -69,18 +69,67 @@ class BL_Action {
    * to the object.
    */
   bool m_appliedToObject;
+  /// Set to true when the object part of the last update is left to UpdateObject.
+  bool m_objectUpdatePending;
 
   bool m_calc_localtime;
 
   // The last update time to avoid double animation update.
   float m_prevUpdate;
 
+  /// Action sampled in m_bakedSamples, nullptr when the action is not baked.
+  struct bAction *m_bakedAction;
+  /// Armature properties animated by the baked action.
+  std::vector<struct PathResolvedRNA> m_bakedChannels;
+  /// Values of all the channels for each frame from m_bakedStart to m_bakedEnd.
+  std::vector<float> m_bakedSamples;
+  int m_bakedStart;
+  int m_bakedEnd;
+
+  /// Data animated by the action of a non armature object.
+  enum ActionTarget {
+    /// Only the object transform, applied by the scene graph controllers.
+    ACT_TARGET_OBJECT,
+    ACT_TARGET_MODIFIER,
+    ACT_TARGET_GPMODIFIER,
+    ACT_TARGET_CONSTRAINT,
+    ACT_TARGET_IDPROP,
+    ACT_TARGET_NODETREE,
+    ACT_TARGET_SHAPEKEY
+  };
+
+  ActionTarget m_actionTarget;
+  /// Target used when a constraint target can't be applied, skipping the constraints.
+  ActionTarget m_actionFallbackTarget;
+  /// Node tree animated by the action for ACT_TARGET_NODETREE.
+  struct bNodeTree *m_actionNodeTree;
+  /// ID owning the node tree, tagged when its library is freed.
+  struct ID *m_actionNodeTreeOwner;
+  /** Values of the F-Curves written to the node tree by the last update, its materials don't
+   * need to be evaluated again while they don't change. */
+  std::vector<float> m_nodeTreeValues;
+  /** Shape key and key block weights written by the last update, the mesh doesn't
+   * need to be evaluated again while they don't change. */
+  struct Key *m_shapeKey;
+  std::vector<float> m_shapeWeights;
+
   void ClearControllerList();
   void InitIPO();
   void SetLocalTime(float curtime);
   void ResetStartTime(float curtime);
   void IncrementBlending(float curtime);
   void BlendShape(struct Key *key, float srcweight, std::vector<float> &blendshape);
+  /** Sample the armature action for each frame between the start and end frame.
+   * \return False if the action can't be baked, e.g. it animates non float properties.
+   */
+  bool BakeAction();
+  /** Find the data animated by the action, matching the F-Curve paths with the object data
+   * names.
+   * \param useConstraints False to ignore the object constraints.
+   */
+  ActionTarget ClassifyAction(bool useConstraints);
+  /// Apply the baked channels interpolated at the given frame.
+  void ApplyBakedAction(float frame);
 
  public:
   BL_Action(class KX_GameObject *gameobj);
@@ -88,8 +137,10 @@ class BL_Action {
 
   /**
    * Play an action
+   * \param action The action resolved in the logic manager, nullptr stops the layer.
+   * \param bake Sample an armature action once to avoid evaluating its F-Curves each frame.
    */
-  bool Play(const std::string &name,
+  bool Play(struct bAction *action,
             float start,
             float end,
             short priority,
@@ -98,24 +149,45 @@ class BL_Action {
             float layer_weight,
             short ipo_flags,
             float playback_speed,
-            short blend_mode);
+            short blend_mode,
+            bool bake);
   /**
    * Whether or not the action is still playing
    */
   bool IsDone();
+  /// Return true when the action is done and its last frame was applied to the object.
+  bool IsFinished() const;
+  /// Forget the data animated by the action which belongs to a library being freed.
+  void RemoveTaggedData();
   /**
    * Update the action's frame, etc.
    * \param curtime The current time used to compute the action's' frame.
    * \param applyToObject Set to true when the action must be applied to the object,
    * else it only manages action's' time/end.
+   * \param deferObject Set to true when updating from an animation pool thread, the caller
+   * must then call UpdateObject from the main thread.
+   * \return True when an armature pose was changed, the caller must then tag the armature
+   * for the depsgraph.
+   */
+  bool Update(float curtime, bool applyToObject, bool deferObject = false);
+  /** Update the scene graph controllers and the object at the frame of the last update.
+   * They write the node, the object and the scene lists, which are not thread safe.
    */
-  void Update(float curtime, bool applyToObject);
+  void UpdateObject();
 
   // Accessors
   float GetFrame();
   const std::string GetName();
 
   struct bAction *GetAction();
+  float GetStartFrame() const;
+  float GetEndFrame() const;
+  float GetSpeed() const;
+  float GetLayerWeight() const;
+  short GetPriority() const;
+  short GetPlayMode() const;
+  short GetBlendMode() const;
+  short GetIpoFlags() const;
 
   // Mutators
   void SetFrame(float frame);
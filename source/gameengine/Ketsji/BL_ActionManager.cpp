@@ -52,6 +52,15 @@ BL_Action *BL_ActionManager::GetAction(short layer)
   return (it != m_layers.end()) ? it->second : 0;
 }
 
+std::vector<short> BL_ActionManager::GetLayers() const
+{
+  std::vector<short> layers;
+  for (const BL_ActionMap::value_type &pair : m_layers) {
+    layers.push_back(pair.first);
+  }
+  return layers;
+}
+
 float BL_ActionManager::GetActionFrame(short layer)
 {
   BL_Action *action = GetAction(layer);
@@ -88,7 +97,7 @@ void BL_ActionManager::SetPlayMode(short layer, short mode)
     action->SetPlayMode(mode);
 }
 
-bool BL_ActionManager::PlayAction(const std::string &name,
+bool BL_ActionManager::PlayAction(bAction *act,
                                   float start,
                                   float end,
                                   short layer,
@@ -98,7 +107,8 @@ bool BL_ActionManager::PlayAction(const std::string &name,
                                   float layer_weight,
                                   short ipo_flags,
                                   float playback_speed,
-                                  short blend_mode)
+                                  short blend_mode,
+                                  bool bake)
 {
   // Only this method will create layer if non-existent
   BL_Action *action = GetAction(layer);
@@ -111,7 +121,7 @@ bool BL_ActionManager::PlayAction(const std::string &name,
   if (layer == 0)
     layer_weight = -1.f;
 
-  return action->Play(name,
+  return action->Play(act,
                       start,
                       end,
                       priority,
@@ -120,7 +130,8 @@ bool BL_ActionManager::PlayAction(const std::string &name,
                       layer_weight,
                       ipo_flags,
                       playback_speed,
-                      blend_mode);
+                      blend_mode,
+                      bake);
 }
 
 void BL_ActionManager::StopAction(short layer)
@@ -140,8 +151,10 @@ void BL_ActionManager::RemoveTaggedActions()
       delete it->second;
       it = m_layers.erase(it);
     }
-    else
+    else {
+      it->second->RemoveTaggedData();
       ++it;
+    }
   }
 }
 
@@ -167,9 +180,30 @@ bool BL_ActionManager::IsSuspended() const
   return m_suspended;
 }
 
-void BL_ActionManager::Update(float curtime, bool applyToObject)
+bool BL_ActionManager::IsIdle() const
+{
+  for (const auto &pair : m_layers) {
+    if (!pair.second->IsFinished()) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool BL_ActionManager::Update(float curtime, bool applyToObject, bool deferObject)
+{
+  bool poseUpdated = false;
+  for (const auto &pair : m_layers) {
+    poseUpdated |= pair.second->Update(curtime, applyToObject, deferObject);
+  }
+
+  return poseUpdated;
+}
+
+void BL_ActionManager::UpdateObject()
 {
   for (const auto &pair : m_layers) {
-    pair.second->Update(curtime, applyToObject);
+    pair.second->UpdateObject();
   }
 }
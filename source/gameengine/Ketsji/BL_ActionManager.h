@@ -28,6 +28,7 @@
 
 #include <iostream>
 #include <map>
+#include <vector>
 
 // Currently, we use the max value of a short.
 // We should switch to unsigned short; doesn't make sense to support negative layers.
@@ -49,16 +50,19 @@ class BL_ActionManager {
   // Suspend action update?
   bool m_suspended;
 
+ public:
+  BL_ActionManager(class KX_GameObject *obj);
+  ~BL_ActionManager();
+
   /**
    * Check if an action exists
    */
   BL_Action *GetAction(short layer);
 
- public:
-  BL_ActionManager(class KX_GameObject *obj);
-  ~BL_ActionManager();
+  /// Return the layers playing an action.
+  std::vector<short> GetLayers() const;
 
-  bool PlayAction(const std::string &name,
+  bool PlayAction(struct bAction *action,
                   float start,
                   float end,
                   short layer = 0,
@@ -68,7 +72,8 @@ class BL_ActionManager {
                   float layer_weight = 0.f,
                   short ipo_flags = 0,
                   float playback_speed = 1.f,
-                  short blend_mode = 0);
+                  short blend_mode = 0,
+                  bool bake = false);
   /**
    * Gets the current frame of an action
    */
@@ -113,11 +118,19 @@ class BL_ActionManager {
   void Resume();
   bool IsSuspended() const;
 
+  /// Return true when no action needs to be updated anymore, until the next PlayAction.
+  bool IsIdle() const;
+
   /**
    * Update any running actions
    * \param curtime The current time used to compute the actions' frame.
    * \param applyToObject Set to true if the actions must transform the object, else it only
    * manages actions' frames.
+   * \param deferObject Set to true when updating from an animation pool thread, the caller
+   * must then call UpdateObject from the main thread.
+   * \return True when an armature pose was changed.
    */
-  void Update(float curtime, bool applyToObject);
+  bool Update(float curtime, bool applyToObject, bool deferObject = false);
+  /// Update the object part of the running actions deferred by the last update.
+  void UpdateObject();
 };
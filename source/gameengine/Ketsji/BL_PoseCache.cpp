@@ -0,0 +1,149 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file BL_PoseCache.cpp
+ *  \ingroup ketsji
+ */
+
+#include "BL_PoseCache.h"
+
+#include <algorithm>
+
+#include "BKE_action.h"
+
+#include "BLI_listbase.h"
+#include "BLI_string.h"
+
+#include "DNA_action_types.h"
+#include "DNA_anim_types.h"
+
+BL_PoseCache::BL_PoseCache() : m_updateId(0)
+{
+}
+
+BL_PoseCache::~BL_PoseCache()
+{
+  for (const auto &pair : m_entries) {
+    if (pair.second.pose) {
+      BKE_pose_free(pair.second.pose);
+    }
+  }
+}
+
+void BL_PoseCache::NewUpdate()
+{
+  // Free the poses not used during the last update, their action is not played anymore.
+  for (auto it = m_entries.begin(); it != m_entries.end();) {
+    if (it->second.updateId != m_updateId) {
+      if (it->second.pose) {
+        BKE_pose_free(it->second.pose);
+      }
+      it = m_entries.erase(it);
+    }
+    else {
+      ++it;
+    }
+  }
+
+  ++m_updateId;
+}
+
+void BL_PoseCache::CopyChannels(bPose *pose,
+                                const bPose *src,
+                                const std::vector<unsigned int> &channels)
+{
+  bPoseChannel *pchan = (bPoseChannel *)pose->chanbase.first;
+  const bPoseChannel *schan = (const bPoseChannel *)src->chanbase.first;
+  unsigned int index = 0;
+
+  for (const unsigned int channel : channels) {
+    for (; index < channel && pchan && schan; ++index) {
+      pchan = pchan->next;
+      schan = schan->next;
+    }
+    if (!pchan || !schan) {
+      break;
+    }
+    extract_pose_channel(pchan, schan);
+  }
+}
+
+bool BL_PoseCache::GetPose(
+    bAction *action, void *armature, float frame, bool baked, bPose *pose, bool &owner)
+{
+  m_mutex.Lock();
+
+  Entry &entry = m_entries
+                     .emplace(Key{action, armature, baked},
+                              Entry{nullptr, 0.0f, m_updateId - 1, false, {}})
+                     .first->second;
+
+  // The first armature of the update owns the entry and evaluates the pose.
+  if (entry.updateId != m_updateId) {
+    entry.updateId = m_updateId;
+    entry.frame = frame;
+    entry.ready = false;
+    owner = true;
+    m_mutex.Unlock();
+    return false;
+  }
+
+  owner = false;
+  const bool found = (entry.ready && entry.frame == frame);
+  if (found) {
+    // Leave untouched the channels the action doesn't animate, as the evaluation does.
+    CopyChannels(pose, entry.pose, entry.channels);
+  }
+
+  m_mutex.Unlock();
+  return found;
+}
+
+void BL_PoseCache::SetPose(bAction *action, void *armature, bool baked, const bPose *pose)
+{
+  m_mutex.Lock();
+
+  Entry &entry = m_entries[Key{action, armature, baked}];
+  if (entry.pose) {
+    CopyChannels(entry.pose, pose, entry.channels);
+  }
+  else {
+    BKE_pose_copy_data(&entry.pose, pose, false);
+
+    // Collect the channels animated by the action, the key ensures they don't change.
+    for (const FCurve *fcu = (const FCurve *)action->curves.first; fcu; fcu = fcu->next) {
+      char name[sizeof(((bPoseChannel *)nullptr)->name)];
+      if (!fcu->rna_path ||
+          !BLI_str_quoted_substr(fcu->rna_path, "pose.bones[", name, sizeof(name))) {
+        continue;
+      }
+      bPoseChannel *pchan = BKE_pose_channel_find_name(entry.pose, name);
+      if (pchan) {
+        entry.channels.push_back(BLI_findindex(&entry.pose->chanbase, pchan));
+      }
+    }
+    std::sort(entry.channels.begin(), entry.channels.end());
+    entry.channels.erase(std::unique(entry.channels.begin(), entry.channels.end()),
+                         entry.channels.end());
+  }
+  entry.ready = true;
+
+  m_mutex.Unlock();
+}
@@ -0,0 +1,97 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file BL_PoseCache.h
+ *  \ingroup ketsji
+ */
+
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+
+#include "CM_Thread.h"
+
+struct bAction;
+struct bPose;
+
+/** Poses computed from an action during the current animation update.
+ * Armatures sharing the same armature data and playing the same action at the same frame
+ * copy the pose of the first evaluated armature instead of evaluating the action again.
+ * The cache is accessed from the animation pool threads.
+ */
+class BL_PoseCache {
+ private:
+  struct Key {
+    bAction *action;
+    /// Armature data, the poses of objects using the same data are aligned.
+    void *armature;
+    bool baked;
+
+    bool operator==(const Key &other) const
+    {
+      return (action == other.action && armature == other.armature && baked == other.baked);
+    }
+  };
+
+  struct KeyHash {
+    size_t operator()(const Key &key) const
+    {
+      return std::hash<void *>()(key.action) ^ (std::hash<void *>()(key.armature) << 1) ^
+             (size_t)key.baked;
+    }
+  };
+
+  struct Entry {
+    bPose *pose;
+    float frame;
+    /// Animation update which computed the pose.
+    unsigned int updateId;
+    /// The pose was copied, false while the owner armature evaluates it.
+    bool ready;
+    /// Sorted indices of the pose channels animated by the action, the only ones copied back.
+    std::vector<unsigned int> channels;
+  };
+
+  std::unordered_map<Key, Entry, KeyHash> m_entries;
+  unsigned int m_updateId;
+  CM_ThreadMutex m_mutex;
+
+  /// Copy the given channels of a pose aligned with the source pose.
+  static void CopyChannels(bPose *pose,
+                           const bPose *src,
+                           const std::vector<unsigned int> &channels);
+
+ public:
+  BL_PoseCache();
+  ~BL_PoseCache();
+
+  /// Start a new animation update, the poses of the previous one are invalid.
+  void NewUpdate();
+
+  /** Copy the pose cached for an action frame.
+   * \param pose The pose to set.
+   * \return False if the pose must be evaluated, the caller is then responsible of calling
+   * SetPose once the pose is evaluated when owner is set to true.
+   */
+  bool GetPose(bAction *action, void *armature, float frame, bool baked, bPose *pose, bool &owner);
+  /// Store the pose evaluated by the owner of an action frame.
+  void SetPose(bAction *action, void *armature, bool baked, const bPose *pose);
+};
@@ -29,6 +29,7 @@
 #include "CM_Message.h"
 #include "KX_GameObject.h"
 #include "KX_PyMath.h"
+#include "RAS_UniformBlock.h"
 
 #ifdef WITH_PYTHON
 #  include "EXP_PythonCallBack.h"
@@ -130,6 +131,7 @@ PyMethodDef BL_Shader::Methods[] = {
     EXP_PYMETHODTABLE(BL_Shader, setSampler),
     EXP_PYMETHODTABLE(BL_Shader, setUniformMatrix4),
     EXP_PYMETHODTABLE(BL_Shader, setUniformMatrix3),
+    EXP_PYMETHODTABLE(BL_Shader, setUniformBlock),
     {nullptr, nullptr}  // Sentinel
 };
 
@@ -886,6 +888,44 @@ EXP_PYMETHODDEF_DOC(
   Py_RETURN_NONE;
 }
 
+EXP_PYMETHODDEF_DOC(BL_Shader, setUniformBlock, "setUniformBlock(block_name, data, offset=0)")
+{
+  if (!m_shader) {
+    Py_RETURN_NONE;
+  }
+
+  const char *name;
+  Py_buffer data;
+  int offset = 0;
+
+  if (!PyArg_ParseTuple(args, "sy*|i:setUniformBlock", &name, &data, &offset)) {
+    return nullptr;
+  }
+
+  RAS_UniformBlock *block = GetUniformBlock(name);
+  if (!block) {
+    PyBuffer_Release(&data);
+    PyErr_Format(PyExc_ValueError,
+                 "shader.setUniformBlock(...): BL_Shader, no uniform block named \"%s\"",
+                 name);
+    return nullptr;
+  }
+
+  const bool set = (offset >= 0 && block->SetData(offset, data.buf, data.len));
+  PyBuffer_Release(&data);
+
+  if (!set) {
+    PyErr_Format(PyExc_ValueError,
+                 "shader.setUniformBlock(...): BL_Shader, the data exceeds the %u bytes of the "
+                 "uniform block \"%s\"",
+                 block->GetSize(),
+                 name);
+    return nullptr;
+  }
+
+  Py_RETURN_NONE;
+}
+
 EXP_PYMETHODDEF_DOC(BL_Shader, setAttrib, "setAttrib(enum)")
 {
   if (!m_shader) {
@@ -79,6 +79,7 @@ class BL_Shader : public EXP_Value, public virtual RAS_Shader {
   EXP_PYMETHOD_DOC(BL_Shader, setUniformiv);
   EXP_PYMETHOD_DOC(BL_Shader, setUniformMatrix4);
   EXP_PYMETHOD_DOC(BL_Shader, setUniformMatrix3);
+  EXP_PYMETHOD_DOC(BL_Shader, setUniformBlock);
   EXP_PYMETHOD_DOC(BL_Shader, setUniformDef);
   EXP_PYMETHOD_DOC(BL_Shader, setAttrib);
   EXP_PYMETHOD_DOC(BL_Shader, setSampler);
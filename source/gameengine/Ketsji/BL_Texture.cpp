@@ -25,6 +25,8 @@
 #include "BKE_image.h"
 
 #include "BL_Texture.h"
+#include "KX_Globals.h"
+#include "KX_KetsjiEngine.h"
 
 #include "GPU_material.h"
 
@@ -39,6 +41,14 @@ BL_Texture::BL_Texture(GPUMaterialTexture *gpumattex, eGPUTextureTarget textarge
   m_isCubeMap = false; /*(m_gpuTex->type == GPU_TEXCUBE)*/
   m_name = m_gpuMatTex->ima->id.name;
 
+  KX_KetsjiEngine *engine = KX_GetActiveEngine();
+  /* Replace the image texture by its compressed file or its lowest level before referencing it,
+   * the compressed textures are uploaded with all their levels. */
+  if (engine &&
+      !engine->GetCompressedTextures().RegisterImage(m_gpuMatTex->ima, m_gpuMatTex->iuser)) {
+    engine->GetTextureStreamer().RegisterImage(m_gpuMatTex->ima, m_gpuMatTex->iuser);
+  }
+
   m_gpuTex = BKE_image_get_gpu_texture(m_gpuMatTex->ima, m_gpuMatTex->iuser, nullptr);
 
   if (m_gpuTex) {
@@ -46,10 +56,19 @@ BL_Texture::BL_Texture(GPUMaterialTexture *gpumattex, eGPUTextureTarget textarge
     m_savedData.bindcode = m_bindCode;
     GPU_texture_ref(m_gpuTex);
   }
+
+  if (engine) {
+    engine->GetTextureStreamer().AddTexture(this);
+  }
 }
 
 BL_Texture::~BL_Texture()
 {
+  KX_KetsjiEngine *engine = KX_GetActiveEngine();
+  if (engine) {
+    engine->GetTextureStreamer().RemoveTexture(this);
+  }
+
   if (m_gpuTex) {
     GPU_texture_set_opengl_bindcode(m_gpuTex, m_savedData.bindcode);
     GPU_texture_free(m_gpuTex);
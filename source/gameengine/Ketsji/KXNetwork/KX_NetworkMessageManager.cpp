@@ -32,58 +32,481 @@
 
 #include "KX_NetworkMessageManager.h"
 
-KX_NetworkMessageManager::KX_NetworkMessageManager() : m_currentList(0)
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+
+#include "KX_NetworkTransport.h"
+
+/** Packet layout: magic and version, the table of the names used by the packet and the
+ * messages referencing the names by their index in the table. All the integers are stored
+ * as variable length quantities of 7 bits per byte.
+ */
+static const char packetMagic[4] = {'B', 'G', 'E', 'M'};
+static const char packetVersion = 1;
+/// Size of the packets under which more messages are added, below the usual MTU.
+static const unsigned int maxPacketSize = 1200;
+/// Number of interned names from which the unused names are removed.
+static const unsigned int minNamePruneSize = 1024;
+
+static unsigned int varint_size(unsigned int value)
+{
+  unsigned int size = 1;
+  while (value >= 0x80) {
+    value >>= 7;
+    ++size;
+  }
+  return size;
+}
+
+static void write_varint(std::string &out, unsigned int value)
+{
+  while (value >= 0x80) {
+    out.push_back((char)((value & 0x7F) | 0x80));
+    value >>= 7;
+  }
+  out.push_back((char)value);
+}
+
+static bool read_varint(const char *&data, const char *end, unsigned int &value)
 {
+  value = 0;
+  for (unsigned int shift = 0; shift < 32 && data < end; shift += 7) {
+    const unsigned char byte = *data++;
+    value |= (unsigned int)(byte & 0x7F) << shift;
+    if (!(byte & 0x80)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+static bool read_string(const char *&data, const char *end, std::string_view &str)
+{
+  unsigned int size;
+  if (!read_varint(data, end, size) || size > (unsigned int)(end - data)) {
+    return false;
+  }
+  str = std::string_view(data, size);
+  data += size;
+  return true;
+}
+
+KX_NetworkMessageManager::KX_NetworkMessageManager()
+    : m_currentList(0), m_namePruneSize(minNamePruneSize), m_transport(nullptr)
+{
+  // The identifier 0 is always the empty name used for messages without receiver or subject.
+  InternName("");
 }
 
 KX_NetworkMessageManager::~KX_NetworkMessageManager()
 {
-  ClearMessages();
 }
 
-void KX_NetworkMessageManager::AddMessage(KX_NetworkMessageManager::Message message)
+KX_NetworkMessageManager::NameId KX_NetworkMessageManager::InternName(const std::string &name)
 {
-  // Put the new message in map for the given receiver and subject.
-  m_messages[m_currentList][message.to][message.subject].push_back(message);
+  const auto it = m_nameIds.find(name);
+  if (it != m_nameIds.end()) {
+    return it->second;
+  }
+
+  const NameId id = m_names.size();
+  m_names.push_back(name);
+  m_nameIds.emplace(name, id);
+  return id;
 }
 
-const std::vector<KX_NetworkMessageManager::Message> KX_NetworkMessageManager::GetMessages(
-    std::string to, std::string subject)
+void KX_NetworkMessageManager::AddMessage(const std::string &to,
+                                          SCA_IObject *from,
+                                          const std::string &subject,
+                                          const std::string &body)
 {
-  std::vector<KX_NetworkMessageManager::Message> messages;
+  m_lock.Lock();
+  PushMessage(InternName(to), from, InternName(subject), body, false);
+  m_lock.Unlock();
+}
 
-  // look at messages without receiver.
-  std::map<std::string, std::vector<Message>> &messagesNoReceiver =
-      m_messages[1 - m_currentList][""];
-  std::map<std::string, std::vector<Message>> &messagesReceiver =
-      m_messages[1 - m_currentList][to];
-  if (subject.empty()) {
-    // Add all message without receiver and subject.
-    for (const auto &pair : messagesNoReceiver) {
-      messages.insert(messages.end(), pair.second.begin(), pair.second.end());
-    }
-    // Add all message with the given receiver and no subject.
-    for (const auto &pair : messagesReceiver) {
-      messages.insert(messages.end(), pair.second.begin(), pair.second.end());
+void KX_NetworkMessageManager::PushMessage(
+    NameId to, SCA_IObject *from, NameId subject, std::string_view body, bool remote)
+{
+  MessageList &list = m_messages[m_currentList];
+
+  MessageData message;
+  message.to = to;
+  message.from = from;
+  message.subject = subject;
+  message.bodyOffset = list.bodies.size();
+  message.bodySize = body.size();
+  message.remote = remote;
+
+  const unsigned int index = list.messages.size();
+  list.messages.push_back(message);
+  list.bodies.append(body);
+
+  if (to != 0) {
+    const auto it = m_receiverFilters.find(to);
+    if (it != m_receiverFilters.end()) {
+      IndexMessage(it->second, subject, m_currentList, index);
     }
   }
   else {
-    std::vector<KX_NetworkMessageManager::Message> &messagesNoReceiverSubject =
-        messagesNoReceiver[subject];
-    messages.insert(
-        messages.end(), messagesNoReceiverSubject.begin(), messagesNoReceiverSubject.end());
-    std::vector<KX_NetworkMessageManager::Message> &messagesReceiverSubject =
-        messagesReceiver[subject];
-    messages.insert(
-        messages.end(), messagesReceiverSubject.begin(), messagesReceiverSubject.end());
+    // A message without receiver is read by all the filters of its subject.
+    const auto it = m_subjectFilters.find(subject);
+    if (it != m_subjectFilters.end()) {
+      IndexMessage(it->second, subject, m_currentList, index);
+    }
+    if (subject != 0) {
+      const auto allIt = m_subjectFilters.find(0);
+      if (allIt != m_subjectFilters.end()) {
+        IndexMessage(allIt->second, subject, m_currentList, index);
+      }
+    }
+  }
+}
+
+void KX_NetworkMessageManager::IndexMessage(const std::vector<FilterId> &filters,
+                                            NameId subject,
+                                            unsigned int list,
+                                            unsigned int index)
+{
+  for (const FilterId id : filters) {
+    Filter &filter = m_filters[id];
+    // An empty subject accepts all the messages.
+    if (filter.subject == 0 || filter.subject == subject) {
+      filter.messages[list].push_back(index);
+    }
+  }
+}
+
+KX_NetworkMessageManager::FilterId KX_NetworkMessageManager::RegisterFilter(
+    const std::string &to, const std::string &subject)
+{
+  m_lock.Lock();
+
+  const NameId toId = InternName(to);
+  const NameId subjectId = InternName(subject);
+  const uint64_t key = ((uint64_t)toId << 32) | subjectId;
+
+  const auto it = m_filterIds.find(key);
+  if (it != m_filterIds.end()) {
+    m_lock.Unlock();
+    return it->second;
+  }
+
+  const FilterId id = m_filters.size();
+  m_filters.emplace_back();
+  Filter &filter = m_filters.back();
+  filter.to = toId;
+  filter.subject = subjectId;
+
+  // Index the messages sent before the registration, from a newly added object.
+  for (unsigned short i = 0; i < 2; ++i) {
+    const std::vector<MessageData> &messages = m_messages[i].messages;
+    for (unsigned int index = 0, size = messages.size(); index < size; ++index) {
+      const MessageData &data = messages[index];
+      if ((data.to == 0 || data.to == toId) && (subjectId == 0 || data.subject == subjectId)) {
+        filter.messages[i].push_back(index);
+      }
+    }
   }
 
-  return messages;
+  m_filterIds.emplace(key, id);
+  if (toId != 0) {
+    m_receiverFilters[toId].push_back(id);
+  }
+  m_subjectFilters[subjectId].push_back(id);
+
+  m_lock.Unlock();
+
+  return id;
+}
+
+void KX_NetworkMessageManager::GetMessages(FilterId filter, std::vector<Message> &messages)
+{
+  messages.clear();
+
+  m_lock.Lock();
+
+  const MessageList &list = m_messages[1 - m_currentList];
+  const std::string_view bodies = list.bodies;
+  for (const unsigned int index : m_filters[filter].messages[1 - m_currentList]) {
+    const MessageData &data = list.messages[index];
+    messages.push_back({m_names[data.to],
+                        data.from,
+                        m_names[data.subject],
+                        bodies.substr(data.bodyOffset, data.bodySize)});
+  }
+
+  m_lock.Unlock();
+}
+
+void KX_NetworkMessageManager::SetTransport(KX_NetworkTransport *transport)
+{
+  m_transport = transport;
+}
+
+KX_NetworkTransport *KX_NetworkMessageManager::GetTransport() const
+{
+  return m_transport;
+}
+
+void KX_NetworkMessageManager::SendMessages(const MessageList &list)
+{
+  // Index of the names in the table of the packet being built.
+  std::unordered_map<NameId, unsigned int> packetNames;
+  std::vector<NameId> names;
+  unsigned int namesSize = 0;
+  std::string records;
+  unsigned int numRecords = 0;
+
+  const auto flush = [&]() {
+    if (numRecords == 0) {
+      return;
+    }
+
+    m_packet.clear();
+    m_packet.append(packetMagic, sizeof(packetMagic));
+    m_packet.push_back(packetVersion);
+    write_varint(m_packet, names.size());
+    for (const NameId id : names) {
+      const std::string &name = m_names[id];
+      write_varint(m_packet, name.size());
+      m_packet.append(name);
+    }
+    write_varint(m_packet, numRecords);
+    m_packet.append(records);
+    m_transport->Send(m_packet.data(), m_packet.size());
+
+    packetNames.clear();
+    names.clear();
+    namesSize = 0;
+    records.clear();
+    numRecords = 0;
+  };
+
+  const auto nameSize = [&](NameId id) {
+    if (packetNames.find(id) != packetNames.end()) {
+      return 0u;
+    }
+    const unsigned int size = m_names[id].size();
+    return varint_size(size) + size;
+  };
+
+  const auto nameIndex = [&](NameId id) {
+    const auto it = packetNames.find(id);
+    if (it != packetNames.end()) {
+      return it->second;
+    }
+    const unsigned int index = names.size();
+    packetNames.emplace(id, index);
+    names.push_back(id);
+    namesSize += varint_size(m_names[id].size()) + m_names[id].size();
+    return index;
+  };
+
+  for (const MessageData &message : list.messages) {
+    if (message.remote) {
+      continue;
+    }
+
+    // Start a new packet if the message doesn't fit in the current one.
+    const unsigned int messageSize = nameSize(message.to) + nameSize(message.subject) + 15 +
+                                     message.bodySize;
+    const unsigned int packetSize = sizeof(packetMagic) + 1 + namesSize + 10 + records.size();
+    if (packetSize + messageSize > maxPacketSize) {
+      flush();
+    }
+
+    write_varint(records, nameIndex(message.to));
+    write_varint(records, nameIndex(message.subject));
+    write_varint(records, message.bodySize);
+    records.append(list.bodies, message.bodyOffset, message.bodySize);
+    ++numRecords;
+  }
+
+  flush();
+}
+
+void KX_NetworkMessageManager::ReadPacket(const char *data, unsigned int size)
+{
+  const char *end = data + size;
+  if (size < sizeof(packetMagic) + 1 || memcmp(data, packetMagic, sizeof(packetMagic)) != 0 ||
+      data[sizeof(packetMagic)] != packetVersion) {
+    return;
+  }
+  data += sizeof(packetMagic) + 1;
+
+  // Malformed packets are dropped as a whole, before adding any message.
+  unsigned int numNames;
+  if (!read_varint(data, end, numNames) || numNames > size) {
+    return;
+  }
+  std::vector<std::string_view> names(numNames);
+  for (std::string_view &name : names) {
+    if (!read_string(data, end, name)) {
+      return;
+    }
+  }
+
+  unsigned int numRecords;
+  if (!read_varint(data, end, numRecords) || numRecords > size) {
+    return;
+  }
+  struct Record {
+    unsigned int to;
+    unsigned int subject;
+    std::string_view body;
+  };
+  std::vector<Record> records(numRecords);
+  for (Record &record : records) {
+    if (!read_varint(data, end, record.to) || !read_varint(data, end, record.subject) ||
+        record.to >= numNames || record.subject >= numNames ||
+        !read_string(data, end, record.body)) {
+      return;
+    }
+  }
+
+  /* The names are only looked up, a remote name is interned only for a message read by a
+   * filter, the senders can't grow the name table with messages nobody reads. */
+  std::vector<NameId> ids(numNames);
+  std::vector<bool> known(numNames);
+  for (unsigned int i = 0; i < numNames; ++i) {
+    const auto it = m_nameIds.find(std::string(names[i]));
+    known[i] = (it != m_nameIds.end());
+    ids[i] = known[i] ? it->second : 0;
+  }
+
+  for (const Record &record : records) {
+    // A receiver without name in the table has no filter.
+    if (!known[record.to]) {
+      continue;
+    }
+    const NameId to = ids[record.to];
+
+    if (!known[record.subject]) {
+      // An unknown subject is only read by the filters accepting all the subjects.
+      if (!AcceptsAllSubjects(to)) {
+        continue;
+      }
+      ids[record.subject] = InternName(std::string(names[record.subject]));
+      known[record.subject] = true;
+    }
+
+    PushMessage(to, nullptr, ids[record.subject], record.body, true);
+  }
+}
+
+bool KX_NetworkMessageManager::AcceptsAllSubjects(NameId to) const
+{
+  // The messages without receiver are read by the filters of their subject.
+  const auto &filters = (to != 0) ? m_receiverFilters : m_subjectFilters;
+  const auto it = filters.find(to);
+  if (it == filters.end()) {
+    return false;
+  }
+
+  for (const FilterId id : it->second) {
+    if (m_filters[id].subject == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void KX_NetworkMessageManager::UpdateTransport()
+{
+  if (!m_transport) {
+    return;
+  }
+
+  m_lock.Lock();
+
+  SendMessages(m_messages[m_currentList]);
+
+  /* The received messages are added after the sent ones, they are available to the sensors
+   * in the next frame as the local messages of this frame. */
+  for (unsigned int i = 0, numPackets = m_transport->GetNumPackets(); i < numPackets; ++i) {
+    unsigned int size;
+    int peer;
+    const char *data = m_transport->GetPacket(i, size, peer);
+    // The socket receives from any address, only the peers can send messages.
+    if (peer >= 0) {
+      ReadPacket(data, size);
+    }
+  }
+
+  m_lock.Unlock();
 }
 
 void KX_NetworkMessageManager::ClearMessages()
 {
-  // Clear previous list.
-  m_messages[1 - m_currentList].clear();
+  m_lock.Lock();
+
+  // Clear previous list, keep the memory allocated for the next frames.
+  MessageList &list = m_messages[1 - m_currentList];
+  list.messages.clear();
+  list.bodies.clear();
+  for (Filter &filter : m_filters) {
+    filter.messages[1 - m_currentList].clear();
+  }
   m_currentList = 1 - m_currentList;
+
+  if (m_names.size() >= m_namePruneSize) {
+    PruneNames();
+  }
+
+  m_lock.Unlock();
+}
+
+void KX_NetworkMessageManager::PruneNames()
+{
+  static const NameId unused = (NameId)-1;
+
+  // The used names are the empty name, the names of the filters and of the last frame messages.
+  std::vector<NameId> remap(m_names.size(), unused);
+  remap[0] = 0;
+  for (const Filter &filter : m_filters) {
+    remap[filter.to] = 0;
+    remap[filter.subject] = 0;
+  }
+  MessageList &list = m_messages[1 - m_currentList];
+  for (const MessageData &message : list.messages) {
+    remap[message.to] = 0;
+    remap[message.subject] = 0;
+  }
+
+  // Keep the order of the used names so that the empty name stays the identifier 0.
+  std::deque<std::string> names;
+  m_nameIds.clear();
+  for (NameId id = 0, size = m_names.size(); id < size; ++id) {
+    if (remap[id] != unused) {
+      remap[id] = names.size();
+      m_nameIds.emplace(m_names[id], remap[id]);
+      names.push_back(std::move(m_names[id]));
+    }
+  }
+  m_names.swap(names);
+
+  for (MessageData &message : list.messages) {
+    message.to = remap[message.to];
+    message.subject = remap[message.subject];
+  }
+
+  m_filterIds.clear();
+  m_receiverFilters.clear();
+  m_subjectFilters.clear();
+  for (FilterId id = 0, size = m_filters.size(); id < size; ++id) {
+    Filter &filter = m_filters[id];
+    filter.to = remap[filter.to];
+    filter.subject = remap[filter.subject];
+
+    m_filterIds.emplace(((uint64_t)filter.to << 32) | filter.subject, id);
+    if (filter.to != 0) {
+      m_receiverFilters[filter.to].push_back(id);
+    }
+    m_subjectFilters[filter.subject].push_back(id);
+  }
+
+  // Prune again once the names not used grew as much as the used names.
+  m_namePruneSize = std::max<unsigned int>(minNamePruneSize, m_names.size() * 2);
 }
@@ -34,50 +34,162 @@ conflicts with KX_NetworkMessageManager::SendMessage */
 #  undef SendMessage
 #endif
 
-#include <map>
+#include <cstdint>
+#include <deque>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
+#include "CM_Thread.h"
+
+class KX_NetworkTransport;
 class SCA_IObject;
 
 class KX_NetworkMessageManager {
  public:
+  /// Identifier of an interned receiver or subject name.
+  using NameId = unsigned int;
+  /// Identifier of a registered receiver and subject filter.
+  using FilterId = unsigned int;
+
+  /** View of a received message, the strings are valid until the next call to
+   * ClearMessages().
+   */
   struct Message {
     /// Receiver object(s) name.
-    std::string to;
+    std::string_view to;
     /// Sender game object.
     SCA_IObject *from;
     /// Message subject, used as filter.
-    std::string subject;
+    std::string_view subject;
     /// Message body.
-    std::string body;
+    std::string_view body;
   };
 
  private:
+  /// Stored message, all the strings are interned or pooled.
+  struct MessageData {
+    NameId to;
+    SCA_IObject *from;
+    NameId subject;
+    /// Range of the body in the body pool of the list.
+    unsigned int bodyOffset;
+    unsigned int bodySize;
+    /// True if the message was received from a peer, it is not sent back.
+    bool remote;
+  };
+
+  struct MessageList {
+    /// All messages in sending order.
+    std::vector<MessageData> messages;
+    /// Storage of all the bodies, kept allocated between frames.
+    std::string bodies;
+  };
+
+  /** Receiver and subject of the messages read by the sensors, the matching messages are
+   * indexed when they are added so that a filter without message costs nothing.
+   */
+  struct Filter {
+    NameId to;
+    /// The subject, 0 accepts all the messages.
+    NameId subject;
+    /// Indices of the matching messages in each message list, kept allocated.
+    std::vector<unsigned int> messages[2];
+  };
+
   /** List of all messages, filtered by receiver object(s) name and subject name.
    * We use two lists, one handle sended message in the current frame and the other
    * is used for handle message sended in the last frame for sensors.
    */
-  std::map<std::string, std::map<std::string, std::vector<Message>>> m_messages[2];
+  MessageList m_messages[2];
 
   /** Since we use two list for the current and last frame we have to switch of
    * current message list each frame. This value is only 0 or 1.
    */
   unsigned short m_currentList;
 
+  /// All interned names, a deque keeps the strings at the same address.
+  std::deque<std::string> m_names;
+  /// Interned name identifiers per name.
+  std::unordered_map<std::string, NameId> m_nameIds;
+  /// Number of names from which the names not used anymore are removed.
+  unsigned int m_namePruneSize;
+
+  /// All filters, never removed.
+  std::vector<Filter> m_filters;
+  /// Filter identifiers per receiver and subject pair.
+  std::unordered_map<uint64_t, FilterId> m_filterIds;
+  /// Filters per receiver name, for the messages sent to a receiver.
+  std::unordered_map<NameId, std::vector<FilterId>> m_receiverFilters;
+  /// Filters per subject name, for the messages sent without receiver.
+  std::unordered_map<NameId, std::vector<FilterId>> m_subjectFilters;
+
+  /// Lock used to allow sending messages from any thread.
+  CM_ThreadSpinLock m_lock;
+
+  /// Transport of the messages to the other engine instances, nullptr if disabled.
+  KX_NetworkTransport *m_transport;
+  /// Buffer of the packet being sent.
+  std::string m_packet;
+
+  /// Return the identifier of a name, creating it if needed, the lock must be owned.
+  NameId InternName(const std::string &name);
+  /** Remove the names used by no filter and no message of the last frame, the identifiers of
+   * the other names change. Called after clearing a list, the lock must be owned.
+   */
+  void PruneNames();
+  /// Add a message to the current list, the lock must be owned.
+  void PushMessage(
+      NameId to, SCA_IObject *from, NameId subject, std::string_view body, bool remote);
+  /// Add a message of a list to the filters of a subject matching it.
+  void IndexMessage(const std::vector<FilterId> &filters,
+                    NameId subject,
+                    unsigned int list,
+                    unsigned int index);
+  /// Send the local messages of a list in packets, the lock must be owned.
+  void SendMessages(const MessageList &list);
+  /** Add the messages of a received packet read by a filter, the lock must be owned.
+   * \param data The packet of a peer.
+   */
+  void ReadPacket(const char *data, unsigned int size);
+  /// Return true if a filter of a receiver reads the messages of any subject.
+  bool AcceptsAllSubjects(NameId to) const;
+
  public:
   KX_NetworkMessageManager();
   virtual ~KX_NetworkMessageManager();
 
-  /** Add a message in the next message list.
-   * \param message The given message to add.
+  /** Add a message in the next message list, this function can be called from any thread.
+   * \param to The receiver object(s) name.
+   * \param from The sender game object.
+   * \param subject The message subject.
+   * \param body The message body.
    */
-  void AddMessage(Message message);
-  /** Get all messages for a given receiver object name and message subject.
+  void AddMessage(const std::string &to,
+                  SCA_IObject *from,
+                  const std::string &subject,
+                  const std::string &body);
+  /** Register the messages of a receiver object name and subject to be read by a sensor,
+   * the same filter is returned for the same names.
    * \param to The object(s) name.
-   * \param subject The message subject/filter.
+   * \param subject The message subject/filter, empty for all the messages.
+   */
+  FilterId RegisterFilter(const std::string &to, const std::string &subject);
+  /** Get all messages of the last frame for a filter.
+   * \param messages The list filled with the messages, it is cleared first.
+   */
+  void GetMessages(FilterId filter, std::vector<Message> &messages);
+
+  /** Set the transport exchanging the messages with other engine instances, the sent messages
+   * are broadcast to its peers and the received messages have no sender object.
+   */
+  void SetTransport(KX_NetworkTransport *transport);
+  KX_NetworkTransport *GetTransport() const;
+  /** Send the messages of the frame to the peers and add the messages of the packets of the
+   * last poll of the transport, must be called before ClearMessages().
    */
-  const std::vector<Message> GetMessages(std::string to, std::string subject);
+  void UpdateTransport();
 
   /// Clear all messages
   void ClearMessages();
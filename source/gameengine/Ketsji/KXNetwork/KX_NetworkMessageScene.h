@@ -60,12 +60,21 @@ class KX_NetworkMessageScene {
    * \param subject The message subject, used as filter for receiver object(s).
    * \param message The body of the message.
    */
-  void SendMessage(std::string to, SCA_IObject *from, std::string subject, std::string body);
+  void SendMessage(const std::string &to,
+                   SCA_IObject *from,
+                   const std::string &subject,
+                   const std::string &body);
 
-  /** Get all messages for a given receiver object name and message subject.
+  /** Register the messages of a receiver object name and subject.
    * \param to The object(s) name.
    * \param subject The message subject/filter.
    */
-  const std::vector<KX_NetworkMessageManager::Message> FindMessages(std::string to,
-                                                                    std::string subject);
+  KX_NetworkMessageManager::FilterId RegisterFilter(const std::string &to,
+                                                    const std::string &subject);
+
+  /** Get all messages of a filter.
+   * \param messages The list filled with the messages.
+   */
+  void FindMessages(KX_NetworkMessageManager::FilterId filter,
+                    std::vector<KX_NetworkMessageManager::Message> &messages);
 };
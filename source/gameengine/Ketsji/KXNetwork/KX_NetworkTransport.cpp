@@ -0,0 +1,272 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Ketsji/KXNetwork/KX_NetworkTransport.cpp
+ *  \ingroup ketsjinet
+ */
+
+#include "KX_NetworkTransport.h"
+
+#ifdef WIN32
+#  include <winsock2.h>
+#  include <ws2tcpip.h>
+#else
+#  include <arpa/inet.h>
+#  include <fcntl.h>
+#  include <netdb.h>
+#  include <netinet/in.h>
+#  include <sys/socket.h>
+#  include <unistd.h>
+#endif
+
+#include <cstring>
+
+#include "CM_Message.h"
+
+/// Largest payload of an UDP datagram over IPv4.
+static const unsigned int maxDatagramSize = 65507;
+/// Packets read per poll at most, the others wait for the next poll.
+static const unsigned int maxPolledPackets = 1024;
+
+#ifdef WIN32
+using SocketType = SOCKET;
+#else
+using SocketType = int;
+#endif
+
+static void close_socket(SocketType sock)
+{
+#ifdef WIN32
+  closesocket(sock);
+#else
+  close(sock);
+#endif
+}
+
+KX_NetworkTransport::KX_NetworkTransport() : m_socket(-1)
+{
+}
+
+KX_NetworkTransport::~KX_NetworkTransport()
+{
+  Close();
+}
+
+bool KX_NetworkTransport::Open(int port)
+{
+  Close();
+
+#ifdef WIN32
+  WSADATA wsaData;
+  if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0) {
+    CM_Error("unable to initialize the network sockets");
+    return false;
+  }
+#endif
+
+  const SocketType sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+#ifdef WIN32
+  const bool invalid = (sock == INVALID_SOCKET);
+#else
+  const bool invalid = (sock < 0);
+#endif
+  if (invalid) {
+    CM_Error("unable to create the network socket");
+#ifdef WIN32
+    WSACleanup();
+#endif
+    return false;
+  }
+
+  sockaddr_in address;
+  memset(&address, 0, sizeof(address));
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_ANY);
+  address.sin_port = htons((uint16_t)port);
+
+  // The reads and writes are done from the frame loop, they must never wait.
+#ifdef WIN32
+  u_long nonBlocking = 1;
+  const bool configured = (ioctlsocket(sock, FIONBIO, &nonBlocking) == 0);
+#else
+  const bool configured = (fcntl(sock, F_SETFL, fcntl(sock, F_GETFL, 0) | O_NONBLOCK) == 0);
+#endif
+
+  if (!configured || bind(sock, (const sockaddr *)&address, sizeof(address)) != 0) {
+    CM_Error("unable to bind the network socket to the port " << port);
+    close_socket(sock);
+#ifdef WIN32
+    WSACleanup();
+#endif
+    return false;
+  }
+
+  m_socket = (intptr_t)sock;
+  m_datagram.resize(maxDatagramSize);
+  return true;
+}
+
+void KX_NetworkTransport::Close()
+{
+  if (!IsOpen()) {
+    return;
+  }
+
+  close_socket((SocketType)m_socket);
+  m_socket = -1;
+  m_buffer.clear();
+  m_packets.clear();
+#ifdef WIN32
+  WSACleanup();
+#endif
+}
+
+bool KX_NetworkTransport::IsOpen() const
+{
+  return (m_socket != -1);
+}
+
+bool KX_NetworkTransport::AddPeer(const std::string &address)
+{
+  const size_t separator = address.rfind(':');
+  if (separator == std::string::npos || separator == 0) {
+    CM_Error("invalid network peer \"" << address << "\", expected host:port");
+    return false;
+  }
+
+  const std::string host = address.substr(0, separator);
+  const std::string service = address.substr(separator + 1);
+
+  addrinfo hints;
+  memset(&hints, 0, sizeof(hints));
+  hints.ai_family = AF_INET;
+  hints.ai_socktype = SOCK_DGRAM;
+
+  addrinfo *result = nullptr;
+  if (getaddrinfo(host.c_str(), service.c_str(), &hints, &result) != 0 || !result) {
+    CM_Error("unable to resolve the network peer \"" << address << "\"");
+    return false;
+  }
+
+  const sockaddr_in *resolved = (const sockaddr_in *)result->ai_addr;
+  m_peers.push_back({resolved->sin_addr.s_addr, resolved->sin_port});
+  freeaddrinfo(result);
+
+  return true;
+}
+
+void KX_NetworkTransport::AddPeers(const std::string &addresses)
+{
+  size_t start = 0;
+  while (start < addresses.size()) {
+    size_t end = addresses.find(',', start);
+    if (end == std::string::npos) {
+      end = addresses.size();
+    }
+    if (end > start) {
+      AddPeer(addresses.substr(start, end - start));
+    }
+    start = end + 1;
+  }
+}
+
+unsigned int KX_NetworkTransport::GetNumPeers() const
+{
+  return m_peers.size();
+}
+
+void KX_NetworkTransport::Send(const char *data, unsigned int size)
+{
+  for (unsigned int i = 0, numPeers = m_peers.size(); i < numPeers; ++i) {
+    SendTo(i, data, size);
+  }
+}
+
+void KX_NetworkTransport::SendTo(unsigned int peer, const char *data, unsigned int size)
+{
+  if (!IsOpen() || size > maxDatagramSize) {
+    return;
+  }
+
+  sockaddr_in address;
+  memset(&address, 0, sizeof(address));
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = m_peers[peer].m_address;
+  address.sin_port = m_peers[peer].m_port;
+  sendto((SocketType)m_socket, data, size, 0, (const sockaddr *)&address, sizeof(address));
+}
+
+void KX_NetworkTransport::Poll()
+{
+  m_buffer.clear();
+  m_packets.clear();
+
+  if (!IsOpen()) {
+    return;
+  }
+
+  while (m_packets.size() < maxPolledPackets) {
+    sockaddr_in sender;
+    socklen_t senderSize = sizeof(sender);
+    /* Errors are ignored like an empty socket, on some systems a datagram refused by
+     * a peer is reported at the next read. */
+    const int received = recvfrom((SocketType)m_socket,
+                                  m_datagram.data(),
+                                  m_datagram.size(),
+                                  0,
+                                  (sockaddr *)&sender,
+                                  &senderSize);
+    if (received <= 0) {
+      break;
+    }
+
+    Packet packet;
+    packet.m_offset = m_buffer.size();
+    packet.m_size = received;
+    packet.m_peer = -1;
+    for (unsigned int i = 0, size = m_peers.size(); i < size; ++i) {
+      if (m_peers[i].m_address == sender.sin_addr.s_addr &&
+          m_peers[i].m_port == sender.sin_port) {
+        packet.m_peer = i;
+        break;
+      }
+    }
+
+    m_buffer.insert(m_buffer.end(), m_datagram.begin(), m_datagram.begin() + received);
+    m_packets.push_back(packet);
+  }
+}
+
+unsigned int KX_NetworkTransport::GetNumPackets() const
+{
+  return m_packets.size();
+}
+
+const char *KX_NetworkTransport::GetPacket(unsigned int index,
+                                           unsigned int &size,
+                                           int &peer) const
+{
+  const Packet &packet = m_packets[index];
+  size = packet.m_size;
+  peer = packet.m_peer;
+  return m_buffer.data() + packet.m_offset;
+}
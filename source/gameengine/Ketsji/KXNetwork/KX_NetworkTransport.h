@@ -0,0 +1,95 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file KX_NetworkTransport.h
+ *  \ingroup ketsjinet
+ *  \brief Ketsji Logic Extension: UDP transport of the network messages
+ */
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/** Non blocking UDP socket exchanging the packets of the network messages with a list of
+ * peers, a packet is sent to all the peers and received from any address.
+ */
+class KX_NetworkTransport {
+ private:
+  /// IPv4 address and port of a peer, in network byte order.
+  struct Peer {
+    uint32_t m_address;
+    uint16_t m_port;
+  };
+
+  /// Socket handle, -1 if closed, stored as an integer to keep the system headers out.
+  intptr_t m_socket;
+  std::vector<Peer> m_peers;
+
+  /// Packet received by the last poll.
+  struct Packet {
+    unsigned int m_offset;
+    unsigned int m_size;
+    /// Index of the sender in the peers, -1 if the sender isn't a peer.
+    int m_peer;
+  };
+
+  /// Storage of the packets received by the last poll.
+  std::vector<char> m_buffer;
+  std::vector<Packet> m_packets;
+  /// Buffer of the datagram being read.
+  std::vector<char> m_datagram;
+
+ public:
+  KX_NetworkTransport();
+  ~KX_NetworkTransport();
+
+  /** Open the socket bound to a local port of all interfaces.
+   * \return False if the socket can't be created or bound.
+   */
+  bool Open(int port);
+  void Close();
+  bool IsOpen() const;
+
+  /** Add a peer receiving the sent packets.
+   * \param address The peer as "host:port", the host is resolved once here.
+   * \return False if the address is invalid or can't be resolved.
+   */
+  bool AddPeer(const std::string &address);
+  /// Add the peers of a comma separated list of addresses.
+  void AddPeers(const std::string &addresses);
+  unsigned int GetNumPeers() const;
+
+  /// Send a packet to all the peers, never blocks, the packet is lost if the socket is full.
+  void Send(const char *data, unsigned int size);
+  /// Send a packet to one peer, never blocks.
+  void SendTo(unsigned int peer, const char *data, unsigned int size);
+
+  /// Read all the pending packets, never blocks, the packets of the previous poll are freed.
+  void Poll();
+  unsigned int GetNumPackets() const;
+  /** Return a packet of the last poll.
+   * \param size The size of the packet.
+   * \param peer The index of the sender in the peers, -1 if the sender isn't a peer.
+   */
+  const char *GetPacket(unsigned int index, unsigned int &size, int &peer) const;
+};
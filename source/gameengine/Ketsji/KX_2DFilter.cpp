@@ -132,6 +132,10 @@ PyMethodDef KX_2DFilter::Methods[] = {
 
 PyAttributeDef KX_2DFilter::Attributes[] = {
     EXP_PYATTRIBUTE_RW_FUNCTION("mipmap", KX_2DFilter, pyattr_get_mipmap, pyattr_set_mipmap),
+    EXP_PYATTRIBUTE_RW_FUNCTION("resolutionScale",
+                                KX_2DFilter,
+                                pyattr_get_resolutionScale,
+                                pyattr_set_resolutionScale),
     EXP_PYATTRIBUTE_RO_FUNCTION("frameBuffer", KX_2DFilter, pyattr_get_frameBuffer),
     EXP_PYATTRIBUTE_RO_FUNCTION(
         "offScreen",
@@ -163,6 +167,30 @@ int KX_2DFilter::pyattr_set_mipmap(EXP_PyObjectPlus *self_v,
   return PY_SET_ATTR_SUCCESS;
 }
 
+PyObject *KX_2DFilter::pyattr_get_resolutionScale(EXP_PyObjectPlus *self_v,
+                                                  const EXP_PYATTRIBUTE_DEF *attrdef)
+{
+  KX_2DFilter *self = static_cast<KX_2DFilter *>(self_v);
+  return PyFloat_FromDouble(self->GetResolutionScale());
+}
+
+int KX_2DFilter::pyattr_set_resolutionScale(EXP_PyObjectPlus *self_v,
+                                            const EXP_PYATTRIBUTE_DEF *attrdef,
+                                            PyObject *value)
+{
+  KX_2DFilter *self = static_cast<KX_2DFilter *>(self_v);
+  const float scale = PyFloat_AsDouble(value);
+  if (PyErr_Occurred() || scale < 0.01f || scale > 1.0f) {
+    PyErr_SetString(PyExc_AttributeError,
+                    "filter.resolutionScale = float: KX_2DFilter, expected a float between 0.01 "
+                    "and 1.0");
+    return PY_SET_ATTR_FAIL;
+  }
+
+  self->SetResolutionScale(scale);
+  return PY_SET_ATTR_SUCCESS;
+}
+
 PyObject *KX_2DFilter::pyattr_get_frameBuffer(EXP_PyObjectPlus *self_v,
                                               const EXP_PYATTRIBUTE_DEF *attrdef)
 {
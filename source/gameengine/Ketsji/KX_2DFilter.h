@@ -51,6 +51,11 @@ class KX_2DFilter : public RAS_2DFilter, public BL_Shader {
   static int pyattr_set_mipmap(EXP_PyObjectPlus *self_v,
                                const EXP_PYATTRIBUTE_DEF *attrdef,
                                PyObject *value);
+  static PyObject *pyattr_get_resolutionScale(EXP_PyObjectPlus *self_v,
+                                              const EXP_PYATTRIBUTE_DEF *attrdef);
+  static int pyattr_set_resolutionScale(EXP_PyObjectPlus *self_v,
+                                        const EXP_PYATTRIBUTE_DEF *attrdef,
+                                        PyObject *value);
   static PyObject *pyattr_get_frameBuffer(EXP_PyObjectPlus *self_v,
                                           const EXP_PYATTRIBUTE_DEF *attrdef);
 
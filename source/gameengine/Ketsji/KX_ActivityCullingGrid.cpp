@@ -0,0 +1,257 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Ketsji/KX_ActivityCullingGrid.cpp
+ *  \ingroup ketsji
+ */
+
+#include "KX_ActivityCullingGrid.h"
+
+#include <cfloat>
+#include <cmath>
+
+#include "EXP_ListValue.h"
+#include "KX_GameObject.h"
+
+/** Get the range of the squared culling radii of an object.
+ * \return False if the object doesn't use activity culling.
+ */
+static bool get_object_radius(KX_GameObject *gameobj, float &minRadius, float &maxRadius)
+{
+  const KX_GameObject::ActivityCullingInfo &info = gameobj->GetActivityCullingInfo();
+  minRadius = FLT_MAX;
+  maxRadius = -FLT_MAX;
+
+  if (info.m_flags & KX_GameObject::ActivityCullingInfo::ACTIVITY_PHYSICS) {
+    minRadius = std::min(minRadius, info.m_physicsRadius);
+    maxRadius = std::max(maxRadius, info.m_physicsRadius);
+  }
+  if (info.m_flags & KX_GameObject::ActivityCullingInfo::ACTIVITY_LOGIC) {
+    minRadius = std::min(minRadius, info.m_logicRadius);
+    maxRadius = std::max(maxRadius, info.m_logicRadius);
+  }
+  if (info.m_flags & KX_GameObject::ActivityCullingInfo::ACTIVITY_PHYSICS_LOD) {
+    minRadius = std::min(minRadius, info.m_physicsLodRadius);
+    maxRadius = std::max(maxRadius, info.m_physicsLodRadius);
+  }
+  if (info.m_flags & KX_GameObject::ActivityCullingInfo::ACTIVITY_LOGIC_LOD) {
+    minRadius = std::min(minRadius, info.m_logicLodRadius);
+    maxRadius = std::max(maxRadius, info.m_logicLodRadius);
+  }
+
+  return (info.m_flags != KX_GameObject::ActivityCullingInfo::ACTIVITY_NONE);
+}
+
+KX_ActivityCullingGrid::KX_ActivityCullingGrid() : m_cellSize(1.0f), m_valid(false)
+{
+}
+
+KX_ActivityCullingGrid::~KX_ActivityCullingGrid()
+{
+}
+
+KX_ActivityCullingGrid::CellKey KX_ActivityCullingGrid::GetCellKey(const MT_Vector3 &pos) const
+{
+  return {(int)std::floor(pos.x() / m_cellSize),
+          (int)std::floor(pos.y() / m_cellSize),
+          (int)std::floor(pos.z() / m_cellSize)};
+}
+
+void KX_ActivityCullingGrid::InsertObject(KX_GameObject *gameobj)
+{
+  const CellKey key = GetCellKey(gameobj->NodeGetWorldPosition());
+
+  std::pair<std::unordered_map<CellKey, Cell, CellKeyHash>::iterator, bool> result =
+      m_cells.emplace(key, Cell());
+  Cell &cell = result.first->second;
+  cell.m_dirty = true;
+
+  m_entries[gameobj] = {key, (unsigned int)cell.m_objects.size()};
+  cell.m_objects.push_back(gameobj);
+}
+
+void KX_ActivityCullingGrid::ExtractObject(const Entry &entry)
+{
+  Cell &cell = m_cells[entry.m_key];
+  cell.m_dirty = true;
+
+  // Swap with the last object of the cell to keep the list dense.
+  KX_GameObject *last = cell.m_objects.back();
+  cell.m_objects[entry.m_index] = last;
+  m_entries[last].m_index = entry.m_index;
+  cell.m_objects.pop_back();
+}
+
+void KX_ActivityCullingGrid::Rebuild(EXP_ListValue<KX_GameObject> *objects)
+{
+  m_cells.clear();
+  m_entries.clear();
+
+  /* Use cells of half the smallest culling radius, the cells are then small enough
+   * to be mostly inside or outside of the radius of their objects. */
+  float minRadius = FLT_MAX;
+  for (KX_GameObject *gameobj : objects) {
+    float objMinRadius, objMaxRadius;
+    if (get_object_radius(gameobj, objMinRadius, objMaxRadius)) {
+      minRadius = std::min(minRadius, objMinRadius);
+    }
+  }
+  m_cellSize = (minRadius == FLT_MAX) ? 1.0f : std::max(std::sqrt(minRadius) * 0.5f, 1.0f);
+
+  for (KX_GameObject *gameobj : objects) {
+    InsertObject(gameobj);
+  }
+
+  m_valid = true;
+}
+
+void KX_ActivityCullingGrid::UpdateCellRadius(Cell &cell) const
+{
+  cell.m_minRadius = FLT_MAX;
+  cell.m_maxRadius = -FLT_MAX;
+  for (KX_GameObject *gameobj : cell.m_objects) {
+    float objMinRadius, objMaxRadius;
+    if (get_object_radius(gameobj, objMinRadius, objMaxRadius)) {
+      cell.m_minRadius = std::min(cell.m_minRadius, objMinRadius);
+      cell.m_maxRadius = std::max(cell.m_maxRadius, objMaxRadius);
+    }
+  }
+}
+
+void KX_ActivityCullingGrid::Invalidate()
+{
+  m_valid = false;
+  m_movedObjects.clear();
+}
+
+void KX_ActivityCullingGrid::TagMovedObject(KX_GameObject *gameobj)
+{
+  if (m_valid) {
+    m_movedObjects.push_back(gameobj);
+  }
+}
+
+void KX_ActivityCullingGrid::RemoveObject(KX_GameObject *gameobj)
+{
+  std::unordered_map<KX_GameObject *, Entry>::iterator it = m_entries.find(gameobj);
+  if (it == m_entries.end()) {
+    return;
+  }
+
+  ExtractObject(it->second);
+  m_entries.erase(it);
+}
+
+void KX_ActivityCullingGrid::Update(EXP_ListValue<KX_GameObject> *objects,
+                                    const std::vector<MT_Vector3> &camPositions)
+{
+  /* Objects added or moved from an other list are not tracked, rebuild the grid
+   * when the object count doesn't match. */
+  if (!m_valid || (size_t)objects->GetCount() != m_entries.size()) {
+    Rebuild(objects);
+  }
+  else {
+    // Objects removed since they moved are not in the entries and never dereferenced.
+    for (KX_GameObject *gameobj : m_movedObjects) {
+      std::unordered_map<KX_GameObject *, Entry>::iterator it = m_entries.find(gameobj);
+      if (it == m_entries.end()) {
+        continue;
+      }
+
+      const CellKey key = GetCellKey(gameobj->NodeGetWorldPosition());
+      // Still in the same cell, the state of the cell is still valid for this object.
+      if (key == it->second.m_key) {
+        continue;
+      }
+
+      ExtractObject(it->second);
+      InsertObject(gameobj);
+    }
+  }
+  m_movedObjects.clear();
+
+  for (std::unordered_map<CellKey, Cell, CellKeyHash>::iterator it = m_cells.begin();
+       it != m_cells.end();) {
+    Cell &cell = it->second;
+    if (cell.m_objects.empty()) {
+      it = m_cells.erase(it);
+      continue;
+    }
+
+    if (cell.m_dirty) {
+      UpdateCellRadius(cell);
+    }
+
+    // Range of the minimum squared distance from an object of the cell to the cameras.
+    const CellKey &key = it->first;
+    const MT_Vector3 cellMin(key.x * m_cellSize, key.y * m_cellSize, key.z * m_cellSize);
+    const MT_Vector3 cellMax = cellMin + MT_Vector3(m_cellSize, m_cellSize, m_cellSize);
+    float minDist = FLT_MAX;
+    float maxDist = FLT_MAX;
+    for (const MT_Vector3 &campos : camPositions) {
+      float camMinDist = 0.0f;
+      float camMaxDist = 0.0f;
+      for (unsigned short i = 0; i < 3; ++i) {
+        const float lower = cellMin[i] - campos[i];
+        const float upper = campos[i] - cellMax[i];
+        const float gap = std::max(std::max(lower, upper), 0.0f);
+        const float extent = std::max(std::abs(lower), std::abs(upper));
+        camMinDist += gap * gap;
+        camMaxDist += extent * extent;
+      }
+      minDist = std::min(minDist, camMinDist);
+      maxDist = std::min(maxDist, camMaxDist);
+    }
+
+    CellState state = CELL_MIXED;
+    if (maxDist <= cell.m_minRadius) {
+      state = CELL_INSIDE;
+    }
+    else if (minDist > cell.m_maxRadius) {
+      state = CELL_OUTSIDE;
+    }
+
+    // The objects already have the activity matching the cell.
+    if (!cell.m_dirty && state == cell.m_state && state != CELL_MIXED) {
+      ++it;
+      continue;
+    }
+
+    for (KX_GameObject *gameobj : cell.m_objects) {
+      // If the object doesn't manage activity culling we don't compute distance.
+      if (gameobj->GetActivityCullingInfo().m_flags ==
+          KX_GameObject::ActivityCullingInfo::ACTIVITY_NONE) {
+        continue;
+      }
+
+      // For each camera compute the distance to objects and keep the minimum distance.
+      const MT_Vector3 &obpos = gameobj->NodeGetWorldPosition();
+      float dist = FLT_MAX;
+      for (const MT_Vector3 &campos : camPositions) {
+        dist = std::min((obpos - campos).length2(), dist);
+      }
+      gameobj->UpdateActivity(dist);
+    }
+
+    cell.m_state = state;
+    cell.m_dirty = false;
+    ++it;
+  }
+}
@@ -0,0 +1,119 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file KX_ActivityCullingGrid.h
+ *  \ingroup ketsji
+ */
+
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+
+#include "MT_Vector3.h"
+
+class KX_GameObject;
+template<class T> class EXP_ListValue;
+
+/** Uniform grid over the object positions used by the object activity culling.
+ * Each cell knows the range of the culling radii of its objects, a cell entirely
+ * inside or outside of these radii for all the cameras doesn't need to evaluate its
+ * objects again until one of them moves to another cell.
+ */
+class KX_ActivityCullingGrid {
+ private:
+  struct CellKey {
+    int x;
+    int y;
+    int z;
+
+    bool operator==(const CellKey &other) const
+    {
+      return (x == other.x && y == other.y && z == other.z);
+    }
+  };
+
+  struct CellKeyHash {
+    size_t operator()(const CellKey &key) const
+    {
+      return ((size_t)key.x * 73856093) ^ ((size_t)key.y * 19349663) ^
+             ((size_t)key.z * 83492791);
+    }
+  };
+
+  /// Activity state of all the objects of a cell.
+  enum CellState {
+    /// All the objects are inside their culling radii.
+    CELL_INSIDE,
+    /// All the objects are outside their culling radii.
+    CELL_OUTSIDE,
+    /// The objects must be evaluated one by one.
+    CELL_MIXED
+  };
+
+  struct Cell {
+    std::vector<KX_GameObject *> m_objects;
+    /// Minimum and maximum squared culling radius of the objects.
+    float m_minRadius;
+    float m_maxRadius;
+    CellState m_state;
+    /// The objects changed since the last evaluation.
+    bool m_dirty;
+  };
+
+  /// Location of an object in the grid.
+  struct Entry {
+    CellKey m_key;
+    unsigned int m_index;
+  };
+
+  std::unordered_map<CellKey, Cell, CellKeyHash> m_cells;
+  std::unordered_map<KX_GameObject *, Entry> m_entries;
+  /// Objects moved since the last update.
+  std::vector<KX_GameObject *> m_movedObjects;
+  float m_cellSize;
+  /// False when the grid must be rebuilt from all the objects.
+  bool m_valid;
+
+  CellKey GetCellKey(const MT_Vector3 &pos) const;
+  void InsertObject(KX_GameObject *gameobj);
+  void ExtractObject(const Entry &entry);
+  void Rebuild(EXP_ListValue<KX_GameObject> *objects);
+  void UpdateCellRadius(Cell &cell) const;
+
+ public:
+  KX_ActivityCullingGrid();
+  ~KX_ActivityCullingGrid();
+
+  /// Rebuild the grid from all the objects at the next update.
+  void Invalidate();
+  /** Register an object whose world position changed.
+   * The caller must ensure that no other thread is tagging an object at the same time.
+   */
+  void TagMovedObject(KX_GameObject *gameobj);
+  /// Remove an object being deleted from the grid.
+  void RemoveObject(KX_GameObject *gameobj);
+
+  /** Update the activity of the scene objects.
+   * \param objects All the objects of the scene.
+   * \param camPositions The positions of the cameras using activity culling.
+   */
+  void Update(EXP_ListValue<KX_GameObject> *objects, const std::vector<MT_Vector3> &camPositions);
+};
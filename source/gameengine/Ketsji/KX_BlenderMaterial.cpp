@@ -62,7 +62,9 @@ KX_BlenderMaterial::KX_BlenderMaterial(RAS_Rasterizer *rasty,
    * (m_textures list won't be available for these object)
    */
   if (m_material->use_nodes && m_material->nodetree && !converting_during_runtime) {
-    if (!KX_GetActiveEngine()->UseViewportRender()) {
+    // Without GPU context in headless mode there is no EEVEE cache.
+    if (!KX_GetActiveEngine()->UseViewportRender() &&
+        !KX_GetActiveEngine()->GetFlag(KX_KetsjiEngine::HEADLESS)) {
       EEVEE_Data *vedata = EEVEE_engine_data_get();
       EEVEE_EffectsInfo *effects = vedata->stl->effects;
       const bool use_ssrefract = ((m_material->blend_flag & MA_BL_SS_REFRACTION) != 0) &&
@@ -125,3 +125,8 @@ SG_ParentRelation *KX_BoneParentRelation::NewCopy()
   KX_BoneParentRelation *bone_parent = new KX_BoneParentRelation(m_bone);
   return bone_parent;
 }
+
+bool KX_BoneParentRelation::IsBoneRelation()
+{
+  return true;
+}
@@ -40,11 +40,17 @@
 #include "KX_Globals.h"
 #include "KX_PyMath.h"
 #include "KX_RayCast.h"
+#include "RAS_FrameBuffer.h"
+#include "RAS_HiZCulling.h"
 #include "RAS_ICanvas.h"
 
 KX_Camera::KX_Camera()
     : KX_GameObject(),
       m_gpuViewport(nullptr),  // eevee
+      m_viewportFrameBuffer(nullptr),
+      m_retainedUpdateCount(0),
+      m_retainedSamples(0),
+      m_hizCulling(nullptr),
       m_dirty(true),
       m_normalized(false),
       m_set_projection_matrix(false),
@@ -62,6 +68,9 @@ KX_Camera::KX_Camera()
 KX_Camera::~KX_Camera()
 {
   RemoveGPUViewport();
+  delete m_viewportFrameBuffer;
+  RemoveExtraViewFrameBuffers();
+  delete m_hizCulling;
   if (m_delete_node && m_pSGNode) {
     // for shadow camera, avoids memleak
     delete m_pSGNode;
@@ -106,12 +115,65 @@ GPUViewport *KX_Camera::GetGPUViewport()
   return m_gpuViewport;
 }
 
+bool KX_Camera::HasGPUViewport() const
+{
+  return (m_gpuViewport != nullptr);
+}
+
 void KX_Camera::RemoveGPUViewport()
 {
   if (m_gpuViewport && m_gpuViewport != GetScene()->GetCurrentGPUViewport()) {
     GPU_viewport_free(m_gpuViewport);
     m_gpuViewport = nullptr;
+    m_retainedSamples = 0;
+    delete m_viewportFrameBuffer;
+    m_viewportFrameBuffer = nullptr;
+    RemoveExtraViewFrameBuffers();
+
+    // The occlusion result was tested against the depth of the freed viewport.
+    delete m_hizCulling;
+    m_hizCulling = nullptr;
+    m_hizObjects.clear();
+  }
+}
+
+RAS_FrameBuffer *KX_Camera::GetViewportFrameBuffer()
+{
+  GPUViewport *viewport = GetGPUViewport();
+  if (!m_viewportFrameBuffer) {
+    // A filter type, the first filter renders to the other filter frame buffer.
+    m_viewportFrameBuffer = new RAS_FrameBuffer(RAS_Rasterizer::RAS_FRAMEBUFFER_FILTER1);
+  }
+  m_viewportFrameBuffer->AttachTextures(GPU_viewport_color_texture(viewport, 0),
+                                        GPU_viewport_depth_texture(viewport));
+  return m_viewportFrameBuffer;
+}
+
+RAS_FrameBuffer *KX_Camera::GetExtraViewFrameBuffer(unsigned int index,
+                                                    unsigned int width,
+                                                    unsigned int height)
+{
+  if (index >= m_extraViewFrameBuffers.size()) {
+    m_extraViewFrameBuffers.resize(index + 1, nullptr);
+  }
+
+  RAS_FrameBuffer *&frameBuffer = m_extraViewFrameBuffers[index];
+  if (frameBuffer && (frameBuffer->GetWidth() != width || frameBuffer->GetHeight() != height)) {
+    delete frameBuffer;
+    frameBuffer = nullptr;
+  }
+  if (!frameBuffer) {
+    frameBuffer = new RAS_FrameBuffer(width, height, RAS_Rasterizer::RAS_FRAMEBUFFER_FILTER1);
+  }
+  return frameBuffer;
+}
+
+void KX_Camera::RemoveExtraViewFrameBuffers()
+{
+  for (RAS_FrameBuffer *frameBuffer : m_extraViewFrameBuffers) {
+    delete frameBuffer;
   }
+  m_extraViewFrameBuffers.clear();
 }
 
 KX_PythonProxy *KX_Camera::NewInstance()
@@ -124,6 +186,11 @@ void KX_Camera::ProcessReplica()
   KX_GameObject::ProcessReplica();
   // replicated camera are always registered in the scene
   m_delete_node = false;
+  m_retainedSamples = 0;
+  m_viewportFrameBuffer = nullptr;
+  m_extraViewFrameBuffers.clear();
+  m_hizCulling = nullptr;
+  m_hizObjects.clear();
 }
 
 MT_Transform KX_Camera::GetWorldToCamera() const
@@ -36,6 +36,9 @@
 #include "RAS_CameraData.h"
 #include "SG_Frustum.h"
 
+class RAS_FrameBuffer;
+class RAS_HiZCulling;
+
 #ifdef WITH_PYTHON
 /* utility conversion function */
 bool ConvertPythonToCamera(KX_Scene *scene,
@@ -57,6 +60,25 @@ class KX_Camera : public KX_GameObject {
   RAS_CameraData m_camdata;
 
   struct GPUViewport *m_gpuViewport;
+  /// Frame buffer wrapping the color and depth textures of the GPU viewport.
+  RAS_FrameBuffer *m_viewportFrameBuffer;
+  /// Color and depth of the views drawn from the draw caches of the camera, e.g. the other eye.
+  std::vector<RAS_FrameBuffer *> m_extraViewFrameBuffers;
+
+  /** State of the last draw in the GPU viewport, used to retain the
+   * viewport result as long as nothing changed in the view. */
+  float m_retainedViewMat[4][4];
+  float m_retainedWinMat[4][4];
+  int m_retainedWindow[4];
+  /** Scene draw update count at the time of the last draw. */
+  unsigned int m_retainedUpdateCount;
+  /** Number of samples accumulated in the viewport for the same view, 0 if invalid. */
+  int m_retainedSamples;
+
+  /// GPU occlusion test of the objects drawn by the camera, created on the first use.
+  RAS_HiZCulling *m_hizCulling;
+  /// Original blender objects of the boxes sent to the last occlusion test.
+  std::vector<Object *> m_hizObjects;
 
   // Never used, I think...
 //	void MoveTo(const MT_Vector3& movevec)
@@ -129,7 +151,20 @@ class KX_Camera : public KX_GameObject {
   virtual ~KX_Camera();
 
   struct GPUViewport *GetGPUViewport();
+  /// Return true if the viewport was created by a render of the camera.
+  bool HasGPUViewport() const;
   void RemoveGPUViewport();
+  /** Return the frame buffer of the color and depth textures of the GPU viewport, built once and
+   * updated only when the viewport textures change.
+   */
+  RAS_FrameBuffer *GetViewportFrameBuffer();
+  /** Return the frame buffer receiving an extra view drawn with the render of the camera,
+   * created again when the size changes.
+   */
+  RAS_FrameBuffer *GetExtraViewFrameBuffer(unsigned int index,
+                                           unsigned int width,
+                                           unsigned int height);
+  void RemoveExtraViewFrameBuffers();
 
   virtual KX_PythonProxy *NewInstance();
   virtual void ProcessReplica();
@@ -31,6 +31,8 @@
 
 #include "KX_CollisionEventManager.h"
 
+#include "BLI_task.h"
+
 #include "KX_CollisionContactPoints.h"
 #include "PHY_IPhysicsController.h"
 #include "PHY_IPhysicsEnvironment.h"
@@ -54,9 +56,7 @@ KX_CollisionEventManager::~KX_CollisionEventManager()
 
 void KX_CollisionEventManager::RemoveNewCollisions()
 {
-  for (const NewCollision &collision : m_newCollisions) {
-    delete collision.colldata;
-  }
+  // The collision data are owned by the physics environment.
   m_newCollisions.clear();
 }
 
@@ -176,6 +176,43 @@ bool KX_CollisionEventManager::RemoveSensor(SCA_ISensor *sensor)
   return false;
 }
 
+void KX_CollisionEventManager::RemoveGameObject(KX_GameObject *gameobj)
+{
+  for (std::set<ContactPair>::iterator it = m_contacts.begin(); it != m_contacts.end();) {
+    if (it->first == gameobj || it->second == gameobj) {
+      it = m_contacts.erase(it);
+    }
+    else {
+      ++it;
+    }
+  }
+}
+
+void KX_CollisionEventManager::RunCollisionCallbacks(KX_GameObject *gameobj,
+                                                     KX_GameObject *collider,
+                                                     const PHY_CollData *colldata,
+                                                     bool first)
+{
+  if (!gameobj->FilterCollisionCallbacks(collider, colldata, first)) {
+    return;
+  }
+
+  if (gameobj->TrackCollisionContacts()) {
+    const ContactPair pair(gameobj, collider);
+    // The same pair can be reported by several manifolds.
+    if (!m_newContacts.insert(pair).second) {
+      return;
+    }
+    // Sustained contact.
+    if (!gameobj->GetCollisionCallbackPersistent() && m_contacts.find(pair) != m_contacts.end()) {
+      return;
+    }
+  }
+
+  KX_CollisionContactPointList contactPointList(colldata, first);
+  gameobj->RunCollisionCallbacks(collider, contactPointList);
+}
+
 void KX_CollisionEventManager::EndFrame()
 {
   for (SCA_ISensor *sensor : m_sensors) {
@@ -183,6 +220,17 @@ void KX_CollisionEventManager::EndFrame()
   }
 }
 
+/// Minimum number of sensors per thread filtering their contacts.
+static const unsigned int contactSensorsParallelThreshold = 8;
+
+static void filter_contacts_task(void *__restrict userdata,
+                                 const int i,
+                                 const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  SCA_CollisionSensor **sensors = (SCA_CollisionSensor **)userdata;
+  sensors[i]->FilterContacts();
+}
+
 void KX_CollisionEventManager::NextFrame()
 {
   for (SCA_ISensor *sensor : m_sensors) {
@@ -204,7 +252,10 @@ void KX_CollisionEventManager::NextFrame()
     // Invoke sensor response for each object
     if (client_info) {
       for (sit = client_info->m_sensors.begin(); sit != client_info->m_sensors.end(); ++sit) {
-        static_cast<SCA_CollisionSensor *>(*sit)->NewHandleCollision(ctrl1, ctrl2, nullptr);
+        SCA_CollisionSensor *sensor = static_cast<SCA_CollisionSensor *>(*sit);
+        if (sensor->QueueContact(ctrl2)) {
+          m_contactSensors.push_back(sensor);
+        }
       }
     }
 
@@ -214,16 +265,39 @@ void KX_CollisionEventManager::NextFrame()
     KX_GameObject *kxObj2 = KX_GameObject::GetClientObject(client_info);
     if (client_info) {
       for (sit = client_info->m_sensors.begin(); sit != client_info->m_sensors.end(); ++sit) {
-        static_cast<SCA_CollisionSensor *>(*sit)->NewHandleCollision(ctrl2, ctrl1, nullptr);
+        SCA_CollisionSensor *sensor = static_cast<SCA_CollisionSensor *>(*sit);
+        if (sensor->QueueContact(ctrl1)) {
+          m_contactSensors.push_back(sensor);
+        }
       }
     }
     // Run python callbacks
-    const PHY_CollData *colldata = collision.colldata;
-    KX_CollisionContactPointList contactPointList0 = KX_CollisionContactPointList(colldata, true);
-    KX_CollisionContactPointList contactPointList1 = KX_CollisionContactPointList(colldata, false);
-    kxObj1->RunCollisionCallbacks(kxObj2, contactPointList0);
-    kxObj2->RunCollisionCallbacks(kxObj1, contactPointList1);
+    RunCollisionCallbacks(kxObj1, kxObj2, collision.colldata, true);
+    RunCollisionCallbacks(kxObj2, kxObj1, collision.colldata, false);
+  }
+
+  // The contacts not reported by the last physics step ended.
+  for (const ContactPair &pair : m_contacts) {
+    if (m_newContacts.find(pair) == m_newContacts.end()) {
+      pair.first->RunCollisionEndCallbacks(pair.second);
+    }
+  }
+  m_contacts.swap(m_newContacts);
+  m_newContacts.clear();
+
+  /* The sensors filter their contacts by property or material in parallel, the colliders
+   * are then added in sequence as adding a reference to an object isn't thread safe. */
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (m_contactSensors.size() >= contactSensorsParallelThreshold);
+  settings.min_iter_per_thread = contactSensorsParallelThreshold;
+  BLI_task_parallel_range(
+      0, m_contactSensors.size(), m_contactSensors.data(), filter_contacts_task, &settings);
+
+  for (SCA_CollisionSensor *sensor : m_contactSensors) {
+    sensor->ApplyContacts();
   }
+  m_contactSensors.clear();
 
   for (SCA_ISensor *sensor : m_sensors) {
     sensor->Activate(m_logicmgr);
@@ -52,12 +52,8 @@ class KX_CollisionEventManager : public SCA_EventManager {
     const PHY_CollData *colldata;
 
     /**
-     * Creates a copy of the given PHY_CollData; freeing that copy should be done by the owner of
-     * the NewCollision object.
-     *
-     * This allows us to efficiently store NewCollision objects in a std::set without creating more
-     * copies of colldata, as the NewCollision copy constructor reuses the pointer and doesn't
-     * clone it again. */
+     * Stores a non-owning pointer to the given PHY_CollData, the data is owned by the physics
+     * environment and stays valid until its next physics step. */
     NewCollision(PHY_IPhysicsController *first,
                  PHY_IPhysicsController *second,
                  const PHY_CollData *colldata);
@@ -65,10 +61,21 @@ class KX_CollisionEventManager : public SCA_EventManager {
     bool operator<(const NewCollision &other) const;
   };
 
+  /// An object running collision callbacks and its collider.
+  using ContactPair = std::pair<KX_GameObject *, KX_GameObject *>;
+
   PHY_IPhysicsEnvironment *m_physEnv;
 
   std::set<NewCollision> m_newCollisions;
 
+  /// Contacts of the objects tracking their collisions begin and end, at the previous frame.
+  std::set<ContactPair> m_contacts;
+  /// Contacts of the current frame.
+  std::set<ContactPair> m_newContacts;
+
+  /// Sensors with queued contacts, filtered in parallel.
+  std::vector<SCA_CollisionSensor *> m_contactSensors;
+
   static bool newCollisionResponse(void *client_data,
                                    void *object1,
                                    void *object2,
@@ -83,6 +90,15 @@ class KX_CollisionEventManager : public SCA_EventManager {
 
   void RemoveNewCollisions();
 
+  /** Run the collision callbacks of an object if the collider passes its filters and for
+   * a contact tracking object if the contact begins or its callbacks are persistent.
+   * \param first True if the object is the first object of the collision data.
+   */
+  void RunCollisionCallbacks(KX_GameObject *gameobj,
+                             KX_GameObject *collider,
+                             const PHY_CollData *colldata,
+                             bool first);
+
  public:
   KX_CollisionEventManager(class SCA_LogicManager *logicmgr, PHY_IPhysicsEnvironment *physEnv);
   virtual ~KX_CollisionEventManager();
@@ -91,6 +107,9 @@ class KX_CollisionEventManager : public SCA_EventManager {
   virtual bool RegisterSensor(SCA_ISensor *sensor);
   virtual bool RemoveSensor(SCA_ISensor *sensor);
 
+  /// Forget the contacts of an object being removed, no end callbacks are run for them.
+  void RemoveGameObject(KX_GameObject *gameobj);
+
   SCA_LogicManager *GetLogicManager()
   {
     return m_logicmgr;
@@ -0,0 +1,988 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Ketsji/KX_CompressedTextures.cpp
+ *  \ingroup ketsji
+ */
+
+#include "KX_CompressedTextures.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <zlib.h>
+#include <zstd.h>
+
+#include "BKE_image.h"
+#include "BLI_fileops.h"
+#include "BLI_path_util.h"
+#include "BLI_string.h"
+#include "DNA_image_types.h"
+#include "GPU_capabilities.h"
+#include "GPU_glew.h"
+#include "IMB_colormanagement.h"
+#include "IMB_imbuf.h"
+#include "IMB_imbuf_types.h"
+
+#include "CM_Message.h"
+
+#define FOURCC(a, b, c, d) \
+  (uint32_t(a) | (uint32_t(b) << 8) | (uint32_t(c) << 16) | (uint32_t(d) << 24))
+
+/// Size of the DDS magic and header.
+static const size_t ddsHeaderSize = 128;
+/// Size of the DDS header of the DXGI formats.
+static const size_t ddsDx10HeaderSize = 20;
+/// Size of the KTX2 header and index before the level index.
+static const size_t ktx2HeaderSize = 80;
+static const unsigned char ktx2Identifier[12] = {
+    0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+
+static uint32_t read_u32(const unsigned char *data)
+{
+  return uint32_t(data[0]) | (uint32_t(data[1]) << 8) | (uint32_t(data[2]) << 16) |
+         (uint32_t(data[3]) << 24);
+}
+
+static uint64_t read_u64(const unsigned char *data)
+{
+  return uint64_t(read_u32(data)) | (uint64_t(read_u32(data + 4)) << 32);
+}
+
+static void write_u32(unsigned char *data, uint32_t value)
+{
+  for (unsigned short i = 0; i < 4; ++i) {
+    data[i] = (value >> (8 * i)) & 0xFF;
+  }
+}
+
+static bool read_file(const std::string &filepath, std::vector<unsigned char> &data)
+{
+  FILE *file = BLI_fopen(filepath.c_str(), "rb");
+  if (!file) {
+    return false;
+  }
+
+  data.resize(BLI_file_size(filepath.c_str()));
+  const bool read = (fread(data.data(), 1, data.size(), file) == data.size());
+  fclose(file);
+  return read;
+}
+
+static size_t block_size(eGPUTextureFormat format)
+{
+  switch (format) {
+    case GPU_SRGB8_A8_DXT1:
+    case GPU_RGBA8_DXT1:
+    case GPU_COMPRESSED_RED_RGTC1:
+      return 8;
+    default:
+      return 16;
+  }
+}
+
+static size_t level_size(eGPUTextureFormat format, int width, int height)
+{
+  return size_t((width + 3) / 4) * size_t((height + 3) / 4) * block_size(format);
+}
+
+static size_t levels_size(eGPUTextureFormat format, int width, int height, int numLevels)
+{
+  size_t size = 0;
+  for (int i = 0; i < numLevels; ++i) {
+    size += level_size(format, std::max(width >> i, 1), std::max(height >> i, 1));
+  }
+  return size;
+}
+
+/// Number of levels of a full mipmap chain, down to the 1x1 level.
+static int full_num_levels(int width, int height)
+{
+  int numLevels = 1;
+  while ((std::max(width, height) >> numLevels) > 0) {
+    ++numLevels;
+  }
+  return numLevels;
+}
+
+/// Check the dimensions read from a file header before computing the size of its levels.
+static bool valid_dimensions(const std::string &filepath, int width, int height)
+{
+  if (width <= 0 || height <= 0) {
+    return false;
+  }
+  if (std::max(width, height) > GPU_max_texture_size()) {
+    CM_Warning("compressed texture " << filepath << " is larger than the maximum texture size");
+    return false;
+  }
+  return true;
+}
+
+static bool format_supported(eGPUTextureFormat format)
+{
+  switch (format) {
+    case GPU_SRGB8_A8_BPTC:
+    case GPU_RGBA8_BPTC:
+      return GLEW_ARB_texture_compression_bptc;
+    case GPU_COMPRESSED_RED_RGTC1:
+    case GPU_COMPRESSED_RG_RGTC2:
+      // Core since OpenGL 3.0.
+      return true;
+    default:
+      return GLEW_EXT_texture_compression_s3tc;
+  }
+}
+
+/// Reverse the rows of 2 bits indices of a color block.
+static void flip_color_block(unsigned char *block, int rows)
+{
+  std::reverse(block + 4, block + 4 + rows);
+}
+
+/// Reverse the rows of 4 bits alpha values of an explicit alpha block.
+static void flip_explicit_alpha_block(unsigned char *block, int rows)
+{
+  for (int i = 0; i < rows / 2; ++i) {
+    std::swap(block[i * 2], block[(rows - 1 - i) * 2]);
+    std::swap(block[i * 2 + 1], block[(rows - 1 - i) * 2 + 1]);
+  }
+}
+
+/// Reverse the rows of 3 bits indices of an interpolated alpha block.
+static void flip_alpha_block(unsigned char *block, int rows)
+{
+  uint64_t bits = 0;
+  for (unsigned short i = 0; i < 6; ++i) {
+    bits |= uint64_t(block[2 + i]) << (8 * i);
+  }
+
+  uint64_t flipped = bits;
+  for (int r = 0; r < rows; ++r) {
+    const uint64_t row = (bits >> (12 * r)) & 0xFFF;
+    const int dest = rows - 1 - r;
+    flipped = (flipped & ~(uint64_t(0xFFF) << (12 * dest))) | (row << (12 * dest));
+  }
+
+  for (unsigned short i = 0; i < 6; ++i) {
+    block[2 + i] = (flipped >> (8 * i)) & 0xFF;
+  }
+}
+
+/** Convert the levels between the top to bottom order of the files and the bottom to top
+ * order of the textures.
+ * \return False if the blocks of the format can't be flipped.
+ */
+static bool flip_levels(eGPUTextureFormat format,
+                        int width,
+                        int height,
+                        int numLevels,
+                        unsigned char *data)
+{
+  if (ELEM(format, GPU_SRGB8_A8_BPTC, GPU_RGBA8_BPTC)) {
+    // The partitions of the BC7 blocks don't allow to reverse their rows.
+    return false;
+  }
+
+  const size_t blockSize = block_size(format);
+  for (int i = 0; i < numLevels; ++i) {
+    const int levelWidth = std::max(width >> i, 1);
+    const int levelHeight = std::max(height >> i, 1);
+    const size_t rowSize = size_t((levelWidth + 3) / 4) * blockSize;
+    const int numRows = (levelHeight + 3) / 4;
+
+    for (int row = 0; row < numRows / 2; ++row) {
+      std::swap_ranges(
+          data + row * rowSize, data + (row + 1) * rowSize, data + (numRows - 1 - row) * rowSize);
+    }
+
+    // The blocks of the levels under 4 pixels high only contain the first rows.
+    const int blockRows = std::min(levelHeight, 4);
+    for (unsigned char *block = data, *end = data + numRows * rowSize; block < end;
+         block += blockSize) {
+      switch (format) {
+        case GPU_SRGB8_A8_DXT1:
+        case GPU_RGBA8_DXT1:
+          flip_color_block(block, blockRows);
+          break;
+        case GPU_SRGB8_A8_DXT3:
+        case GPU_RGBA8_DXT3:
+          flip_explicit_alpha_block(block, blockRows);
+          flip_color_block(block + 8, blockRows);
+          break;
+        case GPU_SRGB8_A8_DXT5:
+        case GPU_RGBA8_DXT5:
+          flip_alpha_block(block, blockRows);
+          flip_color_block(block + 8, blockRows);
+          break;
+        case GPU_COMPRESSED_RED_RGTC1:
+          flip_alpha_block(block, blockRows);
+          break;
+        case GPU_COMPRESSED_RG_RGTC2:
+          flip_alpha_block(block, blockRows);
+          flip_alpha_block(block + 8, blockRows);
+          break;
+        default:
+          break;
+      }
+    }
+
+    data += numRows * rowSize;
+  }
+
+  return true;
+}
+
+static unsigned short pack_rgb565(const unsigned char color[3])
+{
+  return ((color[0] >> 3) << 11) | ((color[1] >> 2) << 5) | (color[2] >> 3);
+}
+
+static void unpack_rgb565(unsigned short value, int color[3])
+{
+  const int r = (value >> 11) & 0x1F;
+  const int g = (value >> 5) & 0x3F;
+  const int b = value & 0x1F;
+  color[0] = (r << 3) | (r >> 2);
+  color[1] = (g << 2) | (g >> 4);
+  color[2] = (b << 3) | (b >> 2);
+}
+
+/** Encode the colors of a block of 16 RGBA pixels in a BC1 color block with the bounding box
+ * of the colors, inset to reduce the error of the extreme colors.
+ */
+static void encode_color_block(const unsigned char pixels[16][4], unsigned char *block)
+{
+  unsigned char minColor[3] = {255, 255, 255};
+  unsigned char maxColor[3] = {0, 0, 0};
+  for (unsigned short i = 0; i < 16; ++i) {
+    for (unsigned short c = 0; c < 3; ++c) {
+      minColor[c] = std::min(minColor[c], pixels[i][c]);
+      maxColor[c] = std::max(maxColor[c], pixels[i][c]);
+    }
+  }
+
+  for (unsigned short c = 0; c < 3; ++c) {
+    const int inset = (maxColor[c] - minColor[c]) >> 4;
+    minColor[c] += inset;
+    maxColor[c] -= inset;
+  }
+
+  unsigned short color0 = pack_rgb565(maxColor);
+  unsigned short color1 = pack_rgb565(minColor);
+  // The four colors mode requires the first color to be the greatest.
+  if (color0 < color1) {
+    std::swap(color0, color1);
+  }
+
+  int palette[4][3];
+  unpack_rgb565(color0, palette[0]);
+  unpack_rgb565(color1, palette[1]);
+  for (unsigned short c = 0; c < 3; ++c) {
+    palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+    palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+  }
+
+  uint32_t indices = 0;
+  if (color0 != color1) {
+    for (unsigned short i = 0; i < 16; ++i) {
+      int bestDistance = INT32_MAX;
+      uint32_t bestIndex = 0;
+      for (uint32_t index = 0; index < 4; ++index) {
+        int distance = 0;
+        for (unsigned short c = 0; c < 3; ++c) {
+          const int delta = pixels[i][c] - palette[index][c];
+          distance += delta * delta;
+        }
+        if (distance < bestDistance) {
+          bestDistance = distance;
+          bestIndex = index;
+        }
+      }
+      indices |= bestIndex << (2 * i);
+    }
+  }
+
+  block[0] = color0 & 0xFF;
+  block[1] = color0 >> 8;
+  block[2] = color1 & 0xFF;
+  block[3] = color1 >> 8;
+  write_u32(block + 4, indices);
+}
+
+/// Encode the alpha of a block of 16 RGBA pixels in a BC3 alpha block.
+static void encode_alpha_block(const unsigned char pixels[16][4], unsigned char *block)
+{
+  int alpha0 = 0;
+  int alpha1 = 255;
+  for (unsigned short i = 0; i < 16; ++i) {
+    alpha0 = std::max<int>(alpha0, pixels[i][3]);
+    alpha1 = std::min<int>(alpha1, pixels[i][3]);
+  }
+
+  uint64_t indices = 0;
+  // The eight alpha values mode requires the first alpha to be the greatest.
+  if (alpha0 != alpha1) {
+    int palette[8] = {alpha0, alpha1};
+    for (int i = 1; i < 7; ++i) {
+      palette[i + 1] = ((7 - i) * alpha0 + i * alpha1) / 7;
+    }
+
+    for (unsigned short i = 0; i < 16; ++i) {
+      int bestDistance = INT32_MAX;
+      uint64_t bestIndex = 0;
+      for (uint64_t index = 0; index < 8; ++index) {
+        const int distance = std::abs(pixels[i][3] - palette[index]);
+        if (distance < bestDistance) {
+          bestDistance = distance;
+          bestIndex = index;
+        }
+      }
+      indices |= bestIndex << (3 * i);
+    }
+  }
+
+  block[0] = alpha0;
+  block[1] = alpha1;
+  for (unsigned short i = 0; i < 6; ++i) {
+    block[2 + i] = (indices >> (8 * i)) & 0xFF;
+  }
+}
+
+/// Encode a level of RGBA pixels in BC1 or BC3 blocks, in the order of the pixels.
+static void encode_level(
+    const unsigned char *pixels, int width, int height, bool alpha, unsigned char *data)
+{
+  for (int y = 0; y < height; y += 4) {
+    for (int x = 0; x < width; x += 4) {
+      unsigned char block[16][4];
+      // The pixels outside of the level repeat the last column and row.
+      for (int i = 0; i < 16; ++i) {
+        const int px = std::min(x + (i % 4), width - 1);
+        const int py = std::min(y + (i / 4), height - 1);
+        memcpy(block[i], pixels + (size_t(py) * width + px) * 4, 4);
+      }
+
+      if (alpha) {
+        encode_alpha_block(block, data);
+        data += 8;
+      }
+      encode_color_block(block, data);
+      data += 8;
+    }
+  }
+}
+
+/// Average the pixels of a level by 2x2 to the next level.
+static void downsample_level(const unsigned char *pixels,
+                             int width,
+                             int height,
+                             std::vector<unsigned char> &result)
+{
+  const int levelWidth = std::max(width >> 1, 1);
+  const int levelHeight = std::max(height >> 1, 1);
+  result.resize(size_t(levelWidth) * levelHeight * 4);
+
+  for (int y = 0; y < levelHeight; ++y) {
+    const int y0 = std::min(y * 2, height - 1);
+    const int y1 = std::min(y * 2 + 1, height - 1);
+    for (int x = 0; x < levelWidth; ++x) {
+      const int x0 = std::min(x * 2, width - 1);
+      const int x1 = std::min(x * 2 + 1, width - 1);
+      for (unsigned short c = 0; c < 4; ++c) {
+        const int sum = pixels[(size_t(y0) * width + x0) * 4 + c] +
+                        pixels[(size_t(y0) * width + x1) * 4 + c] +
+                        pixels[(size_t(y1) * width + x0) * 4 + c] +
+                        pixels[(size_t(y1) * width + x1) * 4 + c];
+        result[(size_t(y) * levelWidth + x) * 4 + c] = (sum + 2) / 4;
+      }
+    }
+  }
+}
+
+KX_CompressedTextures::KX_CompressedTextures() : m_enabled(false), m_transcode(false)
+{
+}
+
+KX_CompressedTextures::~KX_CompressedTextures()
+{
+  for (auto &pair : m_entries) {
+    Image *ima = pair.first;
+    const Entry &entry = pair.second;
+    if (!entry.m_texture) {
+      continue;
+    }
+
+    // Let the image create its own texture again.
+    GPUTexture **slot = &ima->gputexture[TEXTARGET_2D][0][IMA_TEXTURE_RESOLUTION_FULL];
+    if (*slot == entry.m_texture) {
+      GPU_texture_free(*slot);
+      *slot = nullptr;
+    }
+    ima->gpuflag = (ima->gpuflag & ~IMA_GPU_REUSE_MAX_RESOLUTION) |
+                   (entry.m_savedGpuFlag & IMA_GPU_REUSE_MAX_RESOLUTION);
+  }
+}
+
+void KX_CompressedTextures::SetEnabled(bool enabled)
+{
+  m_enabled = enabled;
+}
+
+bool KX_CompressedTextures::GetEnabled() const
+{
+  return m_enabled;
+}
+
+void KX_CompressedTextures::SetTranscode(bool transcode)
+{
+  m_transcode = transcode;
+  if (transcode) {
+    m_enabled = true;
+  }
+}
+
+bool KX_CompressedTextures::ReadDds(const std::string &filepath, bool srgb, Levels &levels)
+{
+  std::vector<unsigned char> data;
+  if (!read_file(filepath, data) || data.size() < ddsHeaderSize ||
+      read_u32(data.data()) != FOURCC('D', 'D', 'S', ' ')) {
+    return false;
+  }
+
+  const unsigned char *header = data.data() + 4;
+  const uint32_t flags = read_u32(header + 4);
+  const uint32_t caps2 = read_u32(header + 108);
+  const uint32_t fourcc = read_u32(header + 80);
+  levels.m_height = read_u32(header + 8);
+  levels.m_width = read_u32(header + 12);
+  // Only use the mipmap count when the flag is set.
+  const uint32_t numLevels = (flags & 0x20000) ? read_u32(header + 24) : 1;
+
+  // The cube maps and the volumes are not material images.
+  if (caps2 & (0x200 | 0x200000)) {
+    CM_Warning("compressed texture " << filepath << " is not a 2D texture");
+    return false;
+  }
+
+  size_t offset = ddsHeaderSize;
+  switch (fourcc) {
+    case FOURCC('D', 'X', 'T', '1'):
+      levels.m_format = srgb ? GPU_SRGB8_A8_DXT1 : GPU_RGBA8_DXT1;
+      break;
+    case FOURCC('D', 'X', 'T', '3'):
+      levels.m_format = srgb ? GPU_SRGB8_A8_DXT3 : GPU_RGBA8_DXT3;
+      break;
+    case FOURCC('D', 'X', 'T', '5'):
+      levels.m_format = srgb ? GPU_SRGB8_A8_DXT5 : GPU_RGBA8_DXT5;
+      break;
+    case FOURCC('A', 'T', 'I', '1'):
+    case FOURCC('B', 'C', '4', 'U'):
+      levels.m_format = GPU_COMPRESSED_RED_RGTC1;
+      break;
+    case FOURCC('A', 'T', 'I', '2'):
+    case FOURCC('B', 'C', '5', 'U'):
+      levels.m_format = GPU_COMPRESSED_RG_RGTC2;
+      break;
+    case FOURCC('D', 'X', '1', '0'): {
+      if (data.size() < ddsHeaderSize + ddsDx10HeaderSize) {
+        return false;
+      }
+      const unsigned char *dx10 = data.data() + ddsHeaderSize;
+      const uint32_t dxgiFormat = read_u32(dx10);
+      // Only the single 2D textures are supported.
+      if (read_u32(dx10 + 4) != 3 || (read_u32(dx10 + 8) & 0x4) || read_u32(dx10 + 12) > 1) {
+        CM_Warning("compressed texture " << filepath << " is not a 2D texture");
+        return false;
+      }
+      offset += ddsDx10HeaderSize;
+
+      switch (dxgiFormat) {
+        case 71:
+        case 72:
+          levels.m_format = (srgb || dxgiFormat == 72) ? GPU_SRGB8_A8_DXT1 : GPU_RGBA8_DXT1;
+          break;
+        case 74:
+        case 75:
+          levels.m_format = (srgb || dxgiFormat == 75) ? GPU_SRGB8_A8_DXT3 : GPU_RGBA8_DXT3;
+          break;
+        case 77:
+        case 78:
+          levels.m_format = (srgb || dxgiFormat == 78) ? GPU_SRGB8_A8_DXT5 : GPU_RGBA8_DXT5;
+          break;
+        case 80:
+          levels.m_format = GPU_COMPRESSED_RED_RGTC1;
+          break;
+        case 83:
+          levels.m_format = GPU_COMPRESSED_RG_RGTC2;
+          break;
+        case 98:
+        case 99:
+          levels.m_format = (srgb || dxgiFormat == 99) ? GPU_SRGB8_A8_BPTC : GPU_RGBA8_BPTC;
+          break;
+        default:
+          CM_Warning("compressed texture " << filepath << " has an unsupported DXGI format "
+                                           << dxgiFormat);
+          return false;
+      }
+      break;
+    }
+    default:
+      CM_Warning("compressed texture " << filepath << " has an unsupported format");
+      return false;
+  }
+
+  if (!valid_dimensions(filepath, levels.m_width, levels.m_height)) {
+    return false;
+  }
+  // The levels under 1x1 don't exist, a larger count would only come from a corrupt file.
+  levels.m_numLevels = std::clamp<uint32_t>(
+      numLevels, 1, full_num_levels(levels.m_width, levels.m_height));
+
+  const size_t size = levels_size(
+      levels.m_format, levels.m_width, levels.m_height, levels.m_numLevels);
+  if (data.size() < offset + size) {
+    CM_Warning("compressed texture " << filepath << " is truncated");
+    return false;
+  }
+
+  levels.m_data.assign(data.begin() + offset, data.begin() + offset + size);
+
+  // The DDS levels are stored from top to bottom.
+  if (!flip_levels(levels.m_format,
+                   levels.m_width,
+                   levels.m_height,
+                   levels.m_numLevels,
+                   levels.m_data.data())) {
+    CM_Warning("compressed texture " << filepath
+                                     << " can't be flipped, use a KTX2 file stored bottom to top");
+    return false;
+  }
+
+  return true;
+}
+
+bool KX_CompressedTextures::ReadKtx2(const std::string &filepath, bool srgb, Levels &levels)
+{
+  std::vector<unsigned char> data;
+  if (!read_file(filepath, data) || data.size() < ktx2HeaderSize ||
+      memcmp(data.data(), ktx2Identifier, sizeof(ktx2Identifier)) != 0) {
+    return false;
+  }
+
+  const unsigned char *header = data.data();
+  const uint32_t vkFormat = read_u32(header + 12);
+  levels.m_width = read_u32(header + 20);
+  levels.m_height = read_u32(header + 24);
+  const uint32_t depth = read_u32(header + 28);
+  const uint32_t layers = read_u32(header + 32);
+  const uint32_t faces = read_u32(header + 36);
+  // No levels means the mipmaps are generated at the loading.
+  const uint32_t numLevels = read_u32(header + 40);
+  const uint32_t supercompression = read_u32(header + 44);
+  const uint32_t kvdOffset = read_u32(header + 56);
+  const uint32_t kvdLength = read_u32(header + 60);
+
+  if (depth > 1 || layers > 1 || faces != 1) {
+    CM_Warning("compressed texture " << filepath << " is not a 2D texture");
+    return false;
+  }
+  if (!valid_dimensions(filepath, levels.m_width, levels.m_height)) {
+    return false;
+  }
+  // The levels under 1x1 don't exist, a larger count would only come from a corrupt file.
+  levels.m_numLevels = std::clamp<uint32_t>(
+      numLevels, 1, full_num_levels(levels.m_width, levels.m_height));
+
+  switch (vkFormat) {
+    case 131:
+    case 132:
+    case 133:
+    case 134:
+      levels.m_format = (srgb || ELEM(vkFormat, 132, 134)) ? GPU_SRGB8_A8_DXT1 : GPU_RGBA8_DXT1;
+      break;
+    case 135:
+    case 136:
+      levels.m_format = (srgb || vkFormat == 136) ? GPU_SRGB8_A8_DXT3 : GPU_RGBA8_DXT3;
+      break;
+    case 137:
+    case 138:
+      levels.m_format = (srgb || vkFormat == 138) ? GPU_SRGB8_A8_DXT5 : GPU_RGBA8_DXT5;
+      break;
+    case 139:
+      levels.m_format = GPU_COMPRESSED_RED_RGTC1;
+      break;
+    case 141:
+      levels.m_format = GPU_COMPRESSED_RG_RGTC2;
+      break;
+    case 145:
+    case 146:
+      levels.m_format = (srgb || vkFormat == 146) ? GPU_SRGB8_A8_BPTC : GPU_RGBA8_BPTC;
+      break;
+    default:
+      // The ASTC formats are not supported by the desktop drivers.
+      CM_Warning("compressed texture " << filepath << " has an unsupported Vulkan format "
+                                       << vkFormat);
+      return false;
+  }
+
+  if (!ELEM(supercompression, 0, 2, 3)) {
+    CM_Warning("compressed texture " << filepath << " has an unsupported supercompression, "
+                                     << "only zstd and zlib are supported");
+    return false;
+  }
+
+  if (data.size() < ktx2HeaderSize + size_t(levels.m_numLevels) * 24 ||
+      data.size() < size_t(kvdOffset) + kvdLength) {
+    return false;
+  }
+
+  // The textures are stored from top to bottom unless the orientation tells otherwise.
+  bool bottomUp = false;
+  for (size_t offset = kvdOffset; offset + 4 <= size_t(kvdOffset) + kvdLength;) {
+    const uint32_t length = read_u32(data.data() + offset);
+    const char *key = (const char *)data.data() + offset + 4;
+    if (offset + 4 + length > size_t(kvdOffset) + kvdLength) {
+      break;
+    }
+    if (length > 16 && STREQ(key, "KTXorientation")) {
+      bottomUp = (key[16] == 'u');
+    }
+    // The values are aligned on 4 bytes.
+    offset += 4 + ((length + 3) & ~3);
+  }
+
+  /* Check the level index against the file before allocating the levels, the size of a level
+   * is bounded by the length of its data in the file. */
+  for (int i = 0; i < levels.m_numLevels; ++i) {
+    const unsigned char *index = data.data() + ktx2HeaderSize + i * 24;
+    const uint64_t offset = read_u64(index);
+    const uint64_t length = read_u64(index + 8);
+    const size_t size = level_size(levels.m_format,
+                                   std::max(levels.m_width >> i, 1),
+                                   std::max(levels.m_height >> i, 1));
+    if (offset > data.size() || length > data.size() - offset) {
+      CM_Warning("compressed texture " << filepath << " is truncated");
+      return false;
+    }
+
+    bool valid;
+    switch (supercompression) {
+      case 2:
+        // The zstd frames written by the KTX tools store their content size.
+        valid = (ZSTD_getFrameContentSize(data.data() + offset, length) == size);
+        break;
+      case 3:
+        // Highest compression ratio of zlib.
+        valid = (size / 1032 <= length);
+        break;
+      default:
+        valid = (length == size);
+        break;
+    }
+
+    if (!valid) {
+      CM_Warning("compressed texture " << filepath << " has an invalid level " << i);
+      return false;
+    }
+  }
+
+  levels.m_data.resize(
+      levels_size(levels.m_format, levels.m_width, levels.m_height, levels.m_numLevels));
+  unsigned char *levelData = levels.m_data.data();
+  for (int i = 0; i < levels.m_numLevels; ++i) {
+    const unsigned char *index = data.data() + ktx2HeaderSize + i * 24;
+    const uint64_t offset = read_u64(index);
+    const uint64_t length = read_u64(index + 8);
+    const size_t size = level_size(levels.m_format,
+                                   std::max(levels.m_width >> i, 1),
+                                   std::max(levels.m_height >> i, 1));
+
+    bool valid;
+    switch (supercompression) {
+      case 2: {
+        const size_t result = ZSTD_decompress(levelData, size, data.data() + offset, length);
+        valid = (!ZSTD_isError(result) && result == size);
+        break;
+      }
+      case 3: {
+        uLongf result = size;
+        valid = (uncompress(levelData, &result, data.data() + offset, length) == Z_OK &&
+                 result == size);
+        break;
+      }
+      default:
+        memcpy(levelData, data.data() + offset, size);
+        valid = true;
+        break;
+    }
+
+    if (!valid) {
+      CM_Warning("compressed texture " << filepath << " has an invalid level " << i);
+      return false;
+    }
+    levelData += size;
+  }
+
+  if (!bottomUp && !flip_levels(levels.m_format,
+                                levels.m_width,
+                                levels.m_height,
+                                levels.m_numLevels,
+                                levels.m_data.data())) {
+    CM_Warning("compressed texture " << filepath
+                                     << " can't be flipped, store it with the orientation \"ru\"");
+    return false;
+  }
+
+  return true;
+}
+
+bool KX_CompressedTextures::Transcode(Image *ima,
+                                      ImageUser *iuser,
+                                      const std::string &filepath,
+                                      Levels &levels)
+{
+  ImBuf *ibuf = BKE_image_acquire_ibuf(ima, iuser, nullptr);
+  if (!ibuf) {
+    return false;
+  }
+
+  // The float images would lose their range.
+  if (!ibuf->rect || ibuf->rect_float) {
+    BKE_image_release_ibuf(ima, ibuf, nullptr);
+    return false;
+  }
+
+  // Same conversion as the uncompressed textures of the byte images.
+  const bool isData = IMB_colormanagement_space_is_data(ibuf->rect_colorspace);
+  const bool srgb = (!isData && !IMB_colormanagement_space_is_scene_linear(ibuf->rect_colorspace));
+  int width = ibuf->x;
+  int height = ibuf->y;
+  std::vector<unsigned char> pixels(size_t(width) * height * 4);
+  if (isData) {
+    memcpy(pixels.data(), ibuf->rect, pixels.size());
+  }
+  else {
+    IMB_colormanagement_imbuf_to_byte_texture(pixels.data(),
+                                              0,
+                                              0,
+                                              width,
+                                              height,
+                                              ibuf,
+                                              srgb,
+                                              BKE_image_has_gpu_texture_premultiplied_alpha(ima,
+                                                                                            ibuf));
+  }
+  BKE_image_release_ibuf(ima, ibuf, nullptr);
+
+  bool alpha = false;
+  for (size_t i = 3; i < pixels.size() && !alpha; i += 4) {
+    alpha = (pixels[i] != 255);
+  }
+
+  levels.m_format = alpha ? (srgb ? GPU_SRGB8_A8_DXT5 : GPU_RGBA8_DXT5) :
+                            (srgb ? GPU_SRGB8_A8_DXT1 : GPU_RGBA8_DXT1);
+  levels.m_width = width;
+  levels.m_height = height;
+  levels.m_numLevels = full_num_levels(width, height);
+
+  levels.m_data.resize(levels_size(levels.m_format, width, height, levels.m_numLevels));
+  unsigned char *levelData = levels.m_data.data();
+  std::vector<unsigned char> nextPixels;
+  for (int i = 0; i < levels.m_numLevels; ++i) {
+    encode_level(pixels.data(), width, height, alpha, levelData);
+    levelData += level_size(levels.m_format, width, height);
+
+    if (i < levels.m_numLevels - 1) {
+      downsample_level(pixels.data(), width, height, nextPixels);
+      pixels.swap(nextPixels);
+      width = std::max(width >> 1, 1);
+      height = std::max(height >> 1, 1);
+    }
+  }
+
+  // The file is stored from top to bottom like any DDS file.
+  std::vector<unsigned char> data(ddsHeaderSize);
+  data.insert(data.end(), levels.m_data.begin(), levels.m_data.end());
+  flip_levels(levels.m_format,
+              levels.m_width,
+              levels.m_height,
+              levels.m_numLevels,
+              data.data() + ddsHeaderSize);
+
+  unsigned char *header = data.data();
+  write_u32(header, FOURCC('D', 'D', 'S', ' '));
+  header += 4;
+  write_u32(header, 124);
+  // Caps, height, width, pixel format, mipmap count and linear size.
+  write_u32(header + 4, 0x1 | 0x2 | 0x4 | 0x1000 | 0x20000 | 0x80000);
+  write_u32(header + 8, levels.m_height);
+  write_u32(header + 12, levels.m_width);
+  write_u32(header + 16, level_size(levels.m_format, levels.m_width, levels.m_height));
+  write_u32(header + 24, levels.m_numLevels);
+  write_u32(header + 72, 32);
+  // Four character code pixel format.
+  write_u32(header + 76, 0x4);
+  write_u32(header + 80, alpha ? FOURCC('D', 'X', 'T', '5') : FOURCC('D', 'X', 'T', '1'));
+  // Texture, complex and mipmap caps.
+  write_u32(header + 104, 0x1000 | 0x8 | 0x400000);
+
+  // The previous file stays valid until the new one is fully written.
+  char tmp_filepath[FILE_MAX];
+  BLI_snprintf(tmp_filepath, sizeof(tmp_filepath), "%s.tmp", filepath.c_str());
+  FILE *file = BLI_fopen(tmp_filepath, "wb");
+  bool written = false;
+  if (file) {
+    written = (fwrite(data.data(), 1, data.size(), file) == data.size());
+    fclose(file);
+    written = written && (BLI_rename(tmp_filepath, filepath.c_str()) == 0);
+    if (!written) {
+      BLI_delete(tmp_filepath, false, false);
+    }
+  }
+
+  if (written) {
+    CM_Message("transcoded image " << ima->id.name + 2 << " to " << filepath);
+  }
+  else {
+    CM_Error("cannot write the compressed texture " << filepath);
+  }
+
+  // The encoded levels are used even if they couldn't be saved.
+  return true;
+}
+
+bool KX_CompressedTextures::Upload(Image *ima, ImageUser *iuser, const Levels &levels)
+{
+  if (!format_supported(levels.m_format)) {
+    return false;
+  }
+
+  // The levels over the texture size limit of the user preferences are skipped.
+  int first = 0;
+  size_t offset = 0;
+  int width = levels.m_width;
+  int height = levels.m_height;
+  while (GPU_texture_size_with_limit(width, true) != width ||
+         GPU_texture_size_with_limit(height, true) != height) {
+    if (++first == levels.m_numLevels) {
+      return false;
+    }
+    offset += level_size(levels.m_format, width, height);
+    width = std::max(width >> 1, 1);
+    height = std::max(height >> 1, 1);
+  }
+
+  const int numLevels = levels.m_numLevels - first;
+  GPUTexture *tex = GPU_texture_create_compressed_2d(
+      ima->id.name + 2, width, height, numLevels, levels.m_format, levels.m_data.data() + offset);
+  if (!tex) {
+    return false;
+  }
+
+  // Same settings as the textures created by the image, the mipmaps are the ones of the file.
+  GPU_texture_wrap_mode(tex, true, false);
+  if (GPU_mipmap_enabled() && numLevels > 1) {
+    ima->gpuflag |= IMA_GPU_MIPMAP_COMPLETE;
+    GPU_texture_mipmap_mode(tex, true, true);
+  }
+  else {
+    GPU_texture_mipmap_mode(tex, false, true);
+  }
+
+  Entry &entry = m_entries[ima];
+  entry.m_texture = tex;
+  entry.m_savedGpuFlag = ima->gpuflag;
+
+  /* The image returns the texture of its slot as long as its pass, layer and view are not
+   * changed, and the full resolution slot is used even with a texture size limit. */
+  ima->gpu_pass = iuser ? iuser->pass : 0;
+  ima->gpu_layer = iuser ? iuser->layer : 0;
+  ima->gpu_view = (iuser && iuser->multi_index >= 2) ? iuser->multi_index : 0;
+  ima->gpuflag &= ~(IMA_GPU_REFRESH | IMA_GPU_PARTIAL_REFRESH);
+  ima->gpuflag |= IMA_GPU_REUSE_MAX_RESOLUTION;
+
+  GPUTexture **slot = &ima->gputexture[TEXTARGET_2D][0][IMA_TEXTURE_RESOLUTION_FULL];
+  if (*slot) {
+    GPU_texture_free(*slot);
+  }
+  *slot = tex;
+
+  return true;
+}
+
+bool KX_CompressedTextures::RegisterImage(Image *ima, ImageUser *iuser)
+{
+  if (!m_enabled) {
+    return false;
+  }
+
+  const auto it = m_entries.find(ima);
+  if (it != m_entries.end()) {
+    return (it->second.m_texture != nullptr);
+  }
+
+  // The images without compressed texture are registered too, to not look for it again.
+  m_entries[ima] = {nullptr, ima->gpuflag};
+
+  if (ima->source != IMA_SRC_FILE || ima->type != IMA_TYPE_IMAGE ||
+      BKE_image_is_multiview(ima) || BKE_image_has_packedfile(ima)) {
+    return false;
+  }
+
+  char filepath[FILE_MAX];
+  BKE_image_user_file_path(iuser, ima, filepath);
+
+  // The compressed textures are in the colorspace of the image, sRGB or linear.
+  const char *colorspace = ima->colorspace_settings.name;
+  const bool srgb = (!IMB_colormanagement_space_name_is_data(colorspace) &&
+                     !IMB_colormanagement_space_name_is_scene_linear(colorspace));
+
+  Levels levels;
+  bool loaded = false;
+  if (BLI_path_extension_check(filepath, ".ktx2")) {
+    loaded = ReadKtx2(filepath, srgb, levels);
+  }
+  else if (BLI_path_extension_check(filepath, ".dds")) {
+    loaded = ReadDds(filepath, srgb, levels);
+  }
+  else {
+    char ktx2_filepath[FILE_MAX];
+    char dds_filepath[FILE_MAX];
+    BLI_strncpy(ktx2_filepath, filepath, sizeof(ktx2_filepath));
+    BLI_strncpy(dds_filepath, filepath, sizeof(dds_filepath));
+    BLI_path_extension_replace(ktx2_filepath, sizeof(ktx2_filepath), ".ktx2");
+    BLI_path_extension_replace(dds_filepath, sizeof(dds_filepath), ".dds");
+
+    if (BLI_exists(ktx2_filepath)) {
+      loaded = ReadKtx2(ktx2_filepath, srgb, levels);
+    }
+    // A transcoded file older than its image is transcoded again.
+    else if (BLI_exists(dds_filepath) &&
+             !(m_transcode && BLI_file_older(dds_filepath, filepath))) {
+      loaded = ReadDds(dds_filepath, srgb, levels);
+    }
+
+    if (!loaded && m_transcode) {
+      loaded = Transcode(ima, iuser, dds_filepath, levels);
+    }
+  }
+
+  return (loaded && Upload(ima, iuser, levels));
+}
@@ -0,0 +1,85 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file KX_CompressedTextures.h
+ *  \ingroup ketsji
+ */
+
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "GPU_texture.h"
+
+struct Image;
+struct ImageUser;
+
+/** Textures of the material images uploaded from block compressed files, without decoding the
+ * images. An image uses the KTX2 or DDS file next to its file with the same name, or its own file
+ * if it is a DDS file. The BC1 to BC5 and BC7 formats are supported, the KTX2 levels can be zlib
+ * or zstd supercompressed.
+ * When transcoding, the images without compressed file are encoded once in BC1 or BC3 with their
+ * mipmaps and saved in a DDS file next to them, to be shipped with the game.
+ */
+class KX_CompressedTextures {
+ private:
+  struct Entry {
+    GPUTexture *m_texture;
+    /// The image gpu flag changed at the upload.
+    short m_savedGpuFlag;
+  };
+
+  /// Compressed levels of a file, the first level is the largest one.
+  struct Levels {
+    eGPUTextureFormat m_format;
+    int m_width;
+    int m_height;
+    int m_numLevels;
+    /// The levels in the order of the textures, the first row of blocks is the bottom one.
+    std::vector<unsigned char> m_data;
+  };
+
+  bool m_enabled;
+  bool m_transcode;
+  std::map<Image *, Entry> m_entries;
+
+  static bool ReadDds(const std::string &filepath, bool srgb, Levels &levels);
+  static bool ReadKtx2(const std::string &filepath, bool srgb, Levels &levels);
+  static bool Transcode(Image *ima, ImageUser *iuser, const std::string &filepath, Levels &levels);
+  bool Upload(Image *ima, ImageUser *iuser, const Levels &levels);
+
+ public:
+  KX_CompressedTextures();
+  ~KX_CompressedTextures();
+
+  /// Enable the compressed files, must be set before the conversion of the materials.
+  void SetEnabled(bool enabled);
+  bool GetEnabled() const;
+  /// Encode and save the images without compressed file, enables the compressed files.
+  void SetTranscode(bool transcode);
+
+  /** Upload the texture of an image from its compressed file if it is not registered yet.
+   * Must be called before the first request of the image texture.
+   * \return True if the image texture is a compressed one.
+   */
+  bool RegisterImage(Image *ima, ImageUser *iuser);
+};
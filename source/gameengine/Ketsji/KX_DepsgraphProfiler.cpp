@@ -0,0 +1,116 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Ketsji/KX_DepsgraphProfiler.cpp
+ *  \ingroup ketsji
+ */
+
+#include "KX_DepsgraphProfiler.h"
+
+#include "PIL_time.h"
+
+static const char *stageNames[KX_DepsgraphProfiler::STAGE_MAX] = {"Collection Remap",
+                                                                  "Transform Tagging",
+                                                                  "Extra Tagging",
+                                                                  "Relations",
+                                                                  "Evaluation",
+                                                                  "Obmat Sync"};
+
+KX_DepsgraphProfiler::KX_DepsgraphProfiler()
+    : m_enabled(false), m_frame(), m_lastFrame(), m_stage(STAGE_MAX), m_stageStartTime(0.0)
+{
+}
+
+KX_DepsgraphProfiler::~KX_DepsgraphProfiler()
+{
+}
+
+bool KX_DepsgraphProfiler::GetEnabled() const
+{
+  return m_enabled;
+}
+
+void KX_DepsgraphProfiler::SetEnabled(bool enabled)
+{
+  if (!enabled) {
+    m_frame = Frame();
+    m_lastFrame = Frame();
+    m_stage = STAGE_MAX;
+  }
+  m_enabled = enabled;
+}
+
+void KX_DepsgraphProfiler::StartStage(Stage stage)
+{
+  if (!m_enabled) {
+    return;
+  }
+
+  const double time = PIL_check_seconds_timer();
+  if (m_stage != STAGE_MAX) {
+    m_frame.m_times[m_stage] += time - m_stageStartTime;
+  }
+
+  m_stage = stage;
+  m_stageStartTime = time;
+}
+
+void KX_DepsgraphProfiler::EndStage()
+{
+  if (!m_enabled || m_stage == STAGE_MAX) {
+    return;
+  }
+
+  m_frame.m_times[m_stage] += PIL_check_seconds_timer() - m_stageStartTime;
+  m_stage = STAGE_MAX;
+}
+
+void KX_DepsgraphProfiler::AddTaggedIds(unsigned int count)
+{
+  m_frame.m_taggedIds += count;
+}
+
+void KX_DepsgraphProfiler::AddEvaluatedIds(unsigned int count)
+{
+  m_frame.m_evaluatedIds += count;
+}
+
+void KX_DepsgraphProfiler::AddRelationsRebuild()
+{
+  ++m_frame.m_relationsRebuilds;
+}
+
+void KX_DepsgraphProfiler::NextFrame()
+{
+  m_lastFrame = m_frame;
+  m_frame = Frame();
+}
+
+const KX_DepsgraphProfiler::Frame &KX_DepsgraphProfiler::GetLastFrame() const
+{
+  return m_lastFrame;
+}
+
+const char *KX_DepsgraphProfiler::GetStageName(Stage stage)
+{
+  return stageNames[stage];
+}
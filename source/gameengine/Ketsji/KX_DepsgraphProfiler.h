@@ -0,0 +1,90 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file KX_DepsgraphProfiler.h
+ *  \ingroup ketsji
+ */
+
+#pragma once
+
+/** Breakdown of the depsgraph update time of the game frames, accumulated over
+ * all the scenes and render passes of a frame.
+ */
+class KX_DepsgraphProfiler {
+ public:
+  enum Stage {
+    /// Collection remap, view layer synchronization and relations tagging.
+    STAGE_COLLECTION_REMAP = 0,
+    /// Tagging of the moved objects.
+    STAGE_TRANSFORM_TAGGING,
+    /// Tagging of the other modified objects, meshes and node trees.
+    STAGE_EXTRA_TAGGING,
+    /// Rebuild of the graph relations.
+    STAGE_RELATIONS,
+    /// Evaluation of the tagged IDs.
+    STAGE_EVALUATION,
+    /// Synchronization of the evaluated objects matrices with the scene graph.
+    STAGE_OBMAT_SYNC,
+    STAGE_MAX
+  };
+
+  struct Frame {
+    /// Time of each stage in seconds.
+    double m_times[STAGE_MAX];
+    /// Number of IDs tagged by the game engine.
+    unsigned int m_taggedIds;
+    /// Number of IDs updated by the evaluation.
+    unsigned int m_evaluatedIds;
+    /// Number of rebuilds of the graph relations.
+    unsigned int m_relationsRebuilds;
+  };
+
+ private:
+  bool m_enabled;
+  Frame m_frame;
+  Frame m_lastFrame;
+  /// Current stage, STAGE_MAX when no stage is measured.
+  Stage m_stage;
+  double m_stageStartTime;
+
+ public:
+  KX_DepsgraphProfiler();
+  ~KX_DepsgraphProfiler();
+
+  bool GetEnabled() const;
+  void SetEnabled(bool enabled);
+
+  /// Start measuring a stage, ending the measure of the previous stage.
+  void StartStage(Stage stage);
+  /// End the measure of the current stage.
+  void EndStage();
+
+  void AddTaggedIds(unsigned int count);
+  void AddEvaluatedIds(unsigned int count);
+  void AddRelationsRebuild();
+
+  /// Finish the current frame, its measures are then returned by GetLastFrame.
+  void NextFrame();
+  const Frame &GetLastFrame() const;
+
+  static const char *GetStageName(Stage stage);
+};
@@ -31,10 +31,26 @@
 
 #include "KX_FontObject.h"
 
+#include <algorithm>
+#include <cmath>
+
+#include "BKE_main.h"
+#include "BKE_vfont.h"
+#include "BLF_api.h"
 #include "BLI_blenlib.h"
 #include "DNA_curve_types.h"
+#include "DNA_packedFile_types.h"
+#include "DNA_vfont_types.h"
 #include "MEM_guardedalloc.h"
 
+#include "KX_Globals.h"
+#include "KX_KetsjiEngine.h"
+
+/// Size in pixels of the glyphs of a text of unit size and scale.
+static const float fontResolution = 100.0f;
+/// Size in pixels of the glyphs at most, the glyph atlas is shared by all the texts of a size.
+static const int maxFontSize = 512;
+
 static std::vector<std::string> split_string(std::string str)
 {
   std::vector<std::string> text = std::vector<std::string>();
@@ -54,7 +70,31 @@ static std::vector<std::string> split_string(std::string str)
   return text;
 }
 
-KX_FontObject::KX_FontObject() : KX_GameObject(), m_object(nullptr), m_rasterizer(nullptr)
+/// Load the blenfont font of a curve font, fonts already loaded are reused by name.
+static int load_font(VFont *vfont)
+{
+  if (!vfont || BKE_vfont_is_builtin(vfont)) {
+    return BLF_default();
+  }
+
+  int fontid;
+  if (vfont->packedfile) {
+    fontid = BLF_load_mem(vfont->id.name + 2,
+                          (const unsigned char *)vfont->packedfile->data,
+                          vfont->packedfile->size);
+  }
+  else {
+    char filepath[FILE_MAX];
+    BLI_strncpy(filepath, vfont->filepath, sizeof(filepath));
+    BLI_path_abs(filepath, ID_BLEND_PATH_FROM_GLOBAL(&vfont->id));
+    fontid = BLF_load(filepath);
+  }
+
+  return (fontid == -1) ? BLF_default() : fontid;
+}
+
+KX_FontObject::KX_FontObject()
+    : KX_GameObject(), m_object(nullptr), m_fastText(false), m_fontId(-1), m_rasterizer(nullptr)
 {
 }
 
@@ -100,7 +140,7 @@ void KX_FontObject::UpdateCurveText(std::string newText)  // eevee
     GetScene()->AppendToExtraObjectsToUpdateInOverlayPass(ob, ID_RECALC_GEOMETRY);
   }
   else {
-    GetScene()->AppendToExtraObjectsToUpdateInAllRenderPasses(ob, ID_RECALC_GEOMETRY);
+    GetScene()->AppendToExtraObjectsToUpdateInAllRenderPasses(ob, ID_RECALC_GEOMETRY, this);
   }
 }
 
@@ -110,8 +150,78 @@ void KX_FontObject::UpdateTextFromProperty()
   EXP_Value *prop = GetProperty("Text");
   if (prop && prop->GetText() != m_text) {
     SetText(prop->GetText());
-    UpdateCurveText(m_text);  // eevee
+    if (m_fastText) {
+      // Only the text drawn over the render changes, the curve stays empty.
+      GetScene()->InvalidateRetainedDraws();
+    }
+    else {
+      UpdateCurveText(m_text);  // eevee
+    }
+  }
+}
+
+void KX_FontObject::SetFastText(bool fast)
+{
+  if (fast && KX_GetActiveEngine()->UseViewportRender()) {
+    return;
   }
+  if (fast == m_fastText) {
+    return;
+  }
+
+  m_fastText = fast;
+  // An empty curve has no geometry to evaluate and draw.
+  UpdateCurveText(m_fastText ? "" : m_text);
+}
+
+bool KX_FontObject::GetFastText() const
+{
+  return m_fastText;
+}
+
+void KX_FontObject::DrawFastText()
+{
+  Curve *cu = static_cast<Curve *>(GetBlenderObject()->data);
+  if (m_fontId == -1) {
+    m_fontId = load_font(cu->vfont);
+    if (m_fontId == -1) {
+      return;
+    }
+  }
+
+  /* The glyphs are rasterized at a size close to their size in the world, the aspect
+   * scales them back to the font size in object space. */
+  const float scale = std::fabs(NodeGetWorldScaling().x());
+  const int size = std::max(std::min(int(cu->fsize * scale * fontResolution), maxFontSize), 1);
+  const float aspect = cu->fsize / size;
+
+  float mat[16];
+  NodeGetWorldTransform().getValue(mat);
+
+  float color[4];
+  GetObjectColor().getValue(color);
+
+  BLF_enable(m_fontId, BLF_MATRIX | BLF_ASPECT);
+  BLF_matrix(m_fontId, mat);
+  BLF_aspect(m_fontId, aspect, aspect, aspect);
+  BLF_size(m_fontId, size, 72);
+  BLF_color4fv(m_fontId, color);
+
+  const float lineSpacing = cu->linedist * cu->fsize;
+  for (unsigned int i = 0, numLines = m_texts.size(); i < numLines; ++i) {
+    const std::string &line = m_texts[i];
+    float xco = cu->xof * cu->fsize;
+    if (ELEM(cu->spacemode, CU_ALIGN_X_MIDDLE, CU_ALIGN_X_RIGHT)) {
+      const float width = BLF_width(m_fontId, line.c_str(), line.size());
+      xco -= (cu->spacemode == CU_ALIGN_X_MIDDLE) ? width * 0.5f : width;
+    }
+    const float yco = cu->yof * cu->fsize - lineSpacing * i;
+
+    BLF_position(m_fontId, xco, yco, 0.0f);
+    BLF_draw(m_fontId, line.c_str(), line.size());
+  }
+
+  BLF_disable(m_fontId, BLF_MATRIX | BLF_ASPECT);
 }
 
 void KX_FontObject::SetRasterizer(RAS_Rasterizer *rasterizer)
@@ -193,7 +303,32 @@ PyMethodDef KX_FontObject::Methods[] = {
 };
 
 PyAttributeDef KX_FontObject::Attributes[] = {
+    EXP_PYATTRIBUTE_RW_FUNCTION(
+        "fastText", KX_FontObject, pyattr_get_fast_text, pyattr_set_fast_text),
     EXP_PYATTRIBUTE_NULL  // Sentinel
 };
 
+PyObject *KX_FontObject::pyattr_get_fast_text(EXP_PyObjectPlus *self_v,
+                                              const EXP_PYATTRIBUTE_DEF *attrdef)
+{
+  KX_FontObject *self = static_cast<KX_FontObject *>(self_v);
+  return PyBool_FromLong(self->m_fastText);
+}
+
+int KX_FontObject::pyattr_set_fast_text(EXP_PyObjectPlus *self_v,
+                                        const EXP_PYATTRIBUTE_DEF *attrdef,
+                                        PyObject *value)
+{
+  KX_FontObject *self = static_cast<KX_FontObject *>(self_v);
+  int param = PyObject_IsTrue(value);
+  if (param == -1) {
+    PyErr_SetString(PyExc_AttributeError,
+                    "font.fastText = bool: KX_FontObject, expected True/False or 0/1");
+    return PY_SET_ATTR_FAIL;
+  }
+
+  self->SetFastText(param);
+  return PY_SET_ATTR_SUCCESS;
+}
+
 #endif  // WITH_PYTHON
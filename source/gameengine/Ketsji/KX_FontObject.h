@@ -57,12 +57,29 @@ class KX_FontObject : public KX_GameObject {
 
   virtual void SetBlenderObject(Object *obj);
 
+  /** Draw the text with the glyph atlas of the font instead of the curve geometry.
+   * The text changes then don't need any depsgraph evaluation, only the transform is
+   * evaluated. Ignored when the game is rendered with the viewport render.
+   */
+  void SetFastText(bool fast);
+  bool GetFastText() const;
+  /** Draw the text lines in the current framebuffer with the current view and projection.
+   * Once per frame and camera for the fast text objects.
+   */
+  void DrawFastText();
+
 #ifdef WITH_PYTHON
   /**
    * \section Python interface functions.
    */
 
   static PyObject *game_object_new(PyTypeObject *type, PyObject *args, PyObject *kwds);
+
+  static PyObject *pyattr_get_fast_text(EXP_PyObjectPlus *self_v,
+                                        const EXP_PYATTRIBUTE_DEF *attrdef);
+  static int pyattr_set_fast_text(EXP_PyObjectPlus *self_v,
+                                  const EXP_PYATTRIBUTE_DEF *attrdef,
+                                  PyObject *value);
 #endif
 
  protected:
@@ -71,6 +88,10 @@ class KX_FontObject : public KX_GameObject {
   Object *m_object;
 
   std::string m_backupText;  // eevee
+
+  bool m_fastText;
+  /// The blenfont font of the curve font, loaded at the first draw.
+  int m_fontId;
   /// needed for drawing routine
   class RAS_Rasterizer *m_rasterizer;
 };
@@ -0,0 +1,146 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Ketsji/KX_FrameStatistics.cpp
+ *  \ingroup ketsji
+ */
+
+#include "KX_FrameStatistics.h"
+
+#include <algorithm>
+
+KX_FrameStatistics::KX_FrameStatistics(unsigned int numCategories)
+    : m_numCategories(numCategories),
+      m_samples((numCategories + 1) * WINDOW_SIZE, 0.0),
+      m_sampleIndex(0),
+      m_numSamples(0),
+      m_frame(0),
+      m_hitchThreshold(0.0),
+      m_droppedEvents(0)
+{
+}
+
+KX_FrameStatistics::~KX_FrameStatistics()
+{
+}
+
+void KX_FrameStatistics::SetHitchThreshold(double threshold)
+{
+  m_hitchThreshold = std::max(threshold, 0.0);
+
+  m_eventLock.Lock();
+  m_frameEvents.clear();
+  m_droppedEvents = 0;
+  m_eventLock.Unlock();
+}
+
+double KX_FrameStatistics::GetHitchThreshold() const
+{
+  return m_hitchThreshold;
+}
+
+void KX_FrameStatistics::AddEvent(const char *type, const std::string &name)
+{
+  m_eventLock.Lock();
+
+  if (!m_frameEvents.empty()) {
+    Event &last = m_frameEvents.back();
+    // Merge repeated events, e.g the spawn of many objects from the same actuator.
+    if (last.m_type == type && last.m_name == name) {
+      ++last.m_count;
+      m_eventLock.Unlock();
+      return;
+    }
+  }
+
+  if (m_frameEvents.size() < MAX_FRAME_EVENTS) {
+    m_frameEvents.push_back({type, name, 1});
+  }
+  else {
+    ++m_droppedEvents;
+  }
+
+  m_eventLock.Unlock();
+}
+
+void KX_FrameStatistics::AddFrame(const std::vector<double> &times, double time)
+{
+  double duration = 0.0;
+  for (unsigned int i = 0; i < m_numCategories; ++i) {
+    m_samples[i * WINDOW_SIZE + m_sampleIndex] = times[i];
+    duration += times[i];
+  }
+  m_samples[m_numCategories * WINDOW_SIZE + m_sampleIndex] = duration;
+
+  m_sampleIndex = (m_sampleIndex + 1) % WINDOW_SIZE;
+  m_numSamples = std::min(m_numSamples + 1, (unsigned int)WINDOW_SIZE);
+
+  m_eventLock.Lock();
+  if (m_hitchThreshold > 0.0 && duration >= m_hitchThreshold) {
+    if (m_hitches.size() == MAX_HITCHES) {
+      m_hitches.pop_front();
+    }
+    m_hitches.push_back({m_frame, time, duration, times, m_frameEvents, m_droppedEvents});
+  }
+
+  m_frameEvents.clear();
+  m_droppedEvents = 0;
+  m_eventLock.Unlock();
+
+  ++m_frame;
+}
+
+KX_FrameStatistics::Percentiles KX_FrameStatistics::GetPercentiles(unsigned int category) const
+{
+  if (m_numSamples == 0) {
+    return {0.0, 0.0, 0.0, 0.0};
+  }
+
+  const std::vector<double>::const_iterator begin = m_samples.begin() + category * WINDOW_SIZE;
+  std::vector<double> samples(begin, begin + m_numSamples);
+
+  // Nearest rank percentile.
+  const auto rank = [&samples](double percent) {
+    const unsigned int index = std::min((unsigned int)(percent * samples.size()),
+                                        (unsigned int)samples.size() - 1);
+    std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+    return samples[index];
+  };
+
+  Percentiles percentiles;
+  percentiles.m_p50 = rank(0.5);
+  percentiles.m_p95 = rank(0.95);
+  percentiles.m_p99 = rank(0.99);
+  percentiles.m_max = *std::max_element(samples.begin(), samples.end());
+
+  return percentiles;
+}
+
+const std::deque<KX_FrameStatistics::Hitch> &KX_FrameStatistics::GetHitches() const
+{
+  return m_hitches;
+}
+
+void KX_FrameStatistics::ClearHitches()
+{
+  m_hitches.clear();
+}
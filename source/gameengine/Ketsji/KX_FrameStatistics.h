@@ -0,0 +1,129 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file KX_FrameStatistics.h
+ *  \ingroup ketsji
+ */
+
+#pragma once
+
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "CM_Thread.h"
+
+/** Rolling statistics of the last frame times per profiling category and
+ * detector of the frames much longer than the threshold, named hitches.
+ * The events of the detected frames are kept with their category breakdown.
+ */
+class KX_FrameStatistics {
+ public:
+  /// An event that can explain a hitch, e.g a LibLoad or a spawn of objects.
+  struct Event {
+    /// Static string of the event type.
+    const char *m_type;
+    std::string m_name;
+    /// Number of consecutive events of same type and name.
+    unsigned int m_count;
+  };
+
+  struct Hitch {
+    /// Index of the frame since the engine start.
+    unsigned int m_frame;
+    /// Game time of the frame.
+    double m_time;
+    /// Sum of the category times in seconds.
+    double m_duration;
+    /// Time per category in seconds.
+    std::vector<double> m_categories;
+    std::vector<Event> m_events;
+    /// Number of events not stored above the limit per frame.
+    unsigned int m_droppedEvents;
+  };
+
+  struct Percentiles {
+    double m_p50;
+    double m_p95;
+    double m_p99;
+    double m_max;
+  };
+
+ private:
+  enum {
+    /// Number of frames used to compute the percentiles.
+    WINDOW_SIZE = 600,
+    /// Number of hitches kept.
+    MAX_HITCHES = 32,
+    /// Number of distinct events stored per frame.
+    MAX_FRAME_EVENTS = 64
+  };
+
+  unsigned int m_numCategories;
+  /// Ring of the last frame times, WINDOW_SIZE times per category followed by the total.
+  std::vector<double> m_samples;
+  unsigned int m_sampleIndex;
+  unsigned int m_numSamples;
+  unsigned int m_frame;
+
+  /// Minimum frame duration in seconds of a hitch, zero disables the detector.
+  double m_hitchThreshold;
+  /// Events of the current frame, filled only when the detector is enabled.
+  std::vector<Event> m_frameEvents;
+  unsigned int m_droppedEvents;
+  /// Events can be added from the logic tasks.
+  CM_ThreadSpinLock m_eventLock;
+  /// Last detected hitches, the oldest first.
+  std::deque<Hitch> m_hitches;
+
+ public:
+  KX_FrameStatistics(unsigned int numCategories);
+  ~KX_FrameStatistics();
+
+  void SetHitchThreshold(double threshold);
+  double GetHitchThreshold() const;
+
+  /// Return true if the events must be reported with AddEvent.
+  inline bool UseEvents() const
+  {
+    return m_hitchThreshold > 0.0;
+  }
+
+  /** Register an event of the current frame.
+   * \param type A static string of the event type.
+   */
+  void AddEvent(const char *type, const std::string &name);
+
+  /** Register the times of the last finished frame.
+   * \param times The time in seconds of each category.
+   * \param time The game time of the frame.
+   */
+  void AddFrame(const std::vector<double> &times, double time);
+
+  /** Return the percentiles of a category over the last frames.
+   * \param category The category index or the number of categories for the total frame time.
+   */
+  Percentiles GetPercentiles(unsigned int category) const;
+
+  const std::deque<Hitch> &GetHitches() const;
+  void ClearHitches();
+};
@@ -38,6 +38,9 @@
 
 #include "KX_GameObject.h"
 
+#include <cfloat>
+#include <climits>
+
 #include "BKE_lib_id.h"
 #include "BKE_mball.h"
 #include "BKE_modifier.h"
@@ -48,6 +51,7 @@
 
 #include "BL_Action.h"
 #include "BL_ActionManager.h"
+#include "BL_BlenderDataConversion.h"
 #include "BL_BlenderSceneConverter.h"
 #include "KX_ClientObjectInfo.h"
 #include "KX_CollisionContactPoints.h"
@@ -57,11 +61,17 @@
 #include "KX_MeshProxy.h"
 #include "KX_NetworkMessageScene.h"  //Needed for sendMessage()
 #include "KX_NodeRelationships.h"
+#include "KX_ParticleEmitter.h"
+#include "KX_ParticleManager.h"
 #include "KX_PolyProxy.h"
 #include "KX_PyMath.h"
 #include "KX_PythonComponent.h"
 #include "KX_RayCast.h"
+#include "KX_StaticBatchManager.h"
+#include "PHY_IGraphicController.h"
 #include "SCA_ISensor.h"
+#include "SCA_LogicManager.h"
+#include "SCA_NetworkMessageSensor.h"
 #include "SG_Controller.h"
 
 #ifdef WITH_PYTHON
@@ -76,26 +86,42 @@ static MT_Matrix3x3 dummy_orientation = MT_Matrix3x3(
     1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f);
 
 KX_GameObject::ActivityCullingInfo::ActivityCullingInfo()
-    : m_flags(ACTIVITY_NONE), m_physicsRadius(0.0f), m_logicRadius(0.0f)
+    : m_flags(ACTIVITY_NONE),
+      m_physicsRadius(0.0f),
+      m_logicRadius(0.0f),
+      m_physicsLodRadius(0.0f),
+      m_logicLodRadius(0.0f),
+      m_logicLodInterval(4)
 {
 }
 
 KX_GameObject::KX_GameObject()
     : SCA_IObject(),
-      m_isReplica(false),            // eevee
-      m_visibleAtGameStart(false),   // eevee
-      m_forceIgnoreParentTx(false),  // eevee
-      m_previousLodLevel(-1),        // eevee
+      m_isReplica(false),              // eevee
+      m_isInstance(false),
+      m_isBatched(false),
+      m_visibleAtGameStart(false),     // eevee
+      m_forceIgnoreParentTx(false),    // eevee
+      m_inTransformUpdateList(false),  // eevee
+      m_inAnimatedList(false),
+      m_previousLodLevel(-1),          // eevee
       m_layer(0),
       m_lodManager(nullptr),
       m_currentLodLevel(0),
+      m_lodMinDistance2(FLT_MAX),
+      m_lodMaxDistance2(0.0f),
       m_pBlenderObject(nullptr),
       m_pBlenderGroupObject(nullptr),
+      m_pReplicaPoolKey(nullptr),
       m_bIsNegativeScaling(false),
       m_objectColor(1.0f, 1.0f, 1.0f, 1.0f),
+      m_collisionCallbackMask(0xFFFF),
+      m_collisionCallbackImpulse(0.0f),
+      m_collisionCallbackPersistent(true),
       m_bVisible(true),
       m_bOccluder(false),
       m_pPhysicsController(nullptr),
+      m_pGraphicController(nullptr),
       m_pSGNode(nullptr),
       m_components(NULL),
       m_pInstanceObjects(nullptr),
@@ -105,7 +131,9 @@ KX_GameObject::KX_GameObject()
       ,
       m_attr_dict(nullptr),
       m_collisionCallbacks(nullptr),
-      m_removeCallbacks(nullptr)
+      m_collisionEndCallbacks(nullptr),
+      m_removeCallbacks(nullptr),
+      m_pyMathWrappers()
 #endif
 {
   m_pClient_info = new KX_ClientObjectInfo(this, KX_ClientObjectInfo::ACTOR);
@@ -121,6 +149,10 @@ KX_GameObject::~KX_GameObject()
   RunOnRemoveCallbacks();
   Py_CLEAR(m_removeCallbacks);
 
+  for (PyObject *&wrapper : m_pyMathWrappers) {
+    Py_CLEAR(wrapper);
+  }
+
   if (m_attr_dict) {
     PyDict_Clear(m_attr_dict); /* in case of circular refs or other weird cases */
     /* Py_CLEAR: Py_DECREF's and nullptr's */
@@ -132,6 +164,10 @@ KX_GameObject::~KX_GameObject()
     UnregisterCollisionCallbacks();
     Py_CLEAR(m_collisionCallbacks);
   }
+  if (m_collisionEndCallbacks) {
+    UnregisterCollisionCallbacks();
+    Py_CLEAR(m_collisionEndCallbacks);
+  }
 
   if (m_components) {
     m_components->Release();
@@ -142,7 +178,12 @@ KX_GameObject::~KX_GameObject()
 
   Object *ob = GetBlenderObject();
 
-  if (ob) {
+  if (m_isBatched) {
+    GetScene()->GetStaticBatchManager()->RemoveObject(this);
+  }
+  GetScene()->GetParticleManager()->RemoveObject(this);
+
+  if (ob && !m_isInstance) {
     if (ob->gameflag & OB_OVERLAY_COLLECTION) {
       ob->gameflag &= ~OB_OVERLAY_COLLECTION;
     }
@@ -198,6 +239,10 @@ KX_GameObject::~KX_GameObject()
     delete m_pPhysicsController;
   }
 
+  if (m_pGraphicController) {
+    delete m_pGraphicController;
+  }
+
   if (m_actionManager) {
     delete m_actionManager;
   }
@@ -248,6 +293,28 @@ void KX_GameObject::SyncTransformWithDepsgraph()
 void KX_GameObject::ForceIgnoreParentTx()
 {
   m_forceIgnoreParentTx = true;
+  // Make sure the children are processed in the next render pass.
+  GetScene()->AddTransformUpdateObject(this);
+}
+
+bool KX_GameObject::IsInTransformUpdateList() const
+{
+  return m_inTransformUpdateList;
+}
+
+void KX_GameObject::SetInTransformUpdateList(bool inList)
+{
+  m_inTransformUpdateList = inList;
+}
+
+bool KX_GameObject::IsInAnimatedList() const
+{
+  return m_inAnimatedList;
+}
+
+void KX_GameObject::SetInAnimatedList(bool inList)
+{
+  m_inAnimatedList = inList;
 }
 
 void KX_GameObject::TagForTransformUpdate(bool is_overlay_pass, bool is_last_render_pass)
@@ -275,6 +342,12 @@ void KX_GameObject::TagForTransformUpdate(bool is_overlay_pass, bool is_last_ren
     }
   }
 
+  // The instance matrices are gathered by the scene after the scene graph update.
+  if (m_isInstance) {
+    m_forceIgnoreParentTx = false;
+    return;
+  }
+
   bContext *C = KX_GetActiveEngine()->GetContext();
   Main *bmain = CTX_data_main(C);
   Depsgraph *depsgraph = CTX_data_depsgraph_on_load(C);
@@ -292,24 +365,28 @@ void KX_GameObject::TagForTransformUpdate(bool is_overlay_pass, bool is_last_ren
   if (ob_orig && !skip_transform) {
 
     bool applyTransformToOrig = GetScene()->OrigObCanBeTransformedInRealtime(ob_orig);
+    /* With several rendering cameras the logic doesn't run between the render passes,
+     * the matrix was then already applied and the children compensated by a previous pass.
+     * The depsgraph is still tagged as each pass draws in its own viewport. */
+    const bool obmatChanged = !applyTransformToOrig || !equals_m4m4(ob_orig->obmat, obmat);
+
+    /* The objects are render dirty after the conversion, only an object moved since its
+     * conversion stops using the cached static shadows. */
+    if (!staticObject && obmatChanged) {
+      GetScene()->AddDynamicObject(ob_orig);
+    }
 
-    if (applyTransformToOrig) {
+    if (applyTransformToOrig && obmatChanged) {
       copy_m4_m4(ob_orig->obmat, obmat);
       BKE_object_apply_mat4(
           ob_orig, ob_orig->obmat, false, ob_orig->parent && ob_orig->partype != PARVERT1);
     }
 
-    if (!staticObject || m_forceIgnoreParentTx) {
-      std::vector<KX_GameObject *> children = GetChildren();
-      if (children.size() > 0) {
-        std::vector<Object *> childrenObjects;
-        for (KX_GameObject *go : children) {
-          Object *child = go->GetBlenderObject();
-          if (child) {
-            childrenObjects.push_back(child);
-          }
-        }
-        GetScene()->IgnoreParentTxBGE(bmain, depsgraph, ob_orig, childrenObjects);
+    if ((!staticObject && obmatChanged) || m_forceIgnoreParentTx) {
+      // Walk the scene graph children directly to not allocate lists for every moving object.
+      const NodeList &children = GetSGNode()->GetSGChildren();
+      if (!children.empty()) {
+        GetScene()->IgnoreParentTxBGE(bmain, depsgraph, ob_orig, children);
       }
     }
 
@@ -334,36 +411,60 @@ void KX_GameObject::TagForTransformUpdate(bool is_overlay_pass, bool is_last_ren
   m_forceIgnoreParentTx = false;
 }
 
-void KX_GameObject::TagForTransformUpdateEvaluated()
+bool KX_GameObject::IsTransformOverridenByDepsgraph()
 {
-  float obmat[4][4];
-  NodeGetWorldTransform().getValue(&obmat[0][0]);
-
-  bContext *C = KX_GetActiveEngine()->GetContext();
-  Depsgraph *depsgraph = CTX_data_depsgraph_on_load(C);
-
   Object *ob_orig = GetBlenderObject();
+  return ob_orig && !m_isInstance && (ob_orig->transflag & OB_TRANSFLAG_OVERRIDE_GAME_PRIORITY);
+}
 
-  bool skip_transform = ob_orig->transflag & OB_TRANSFLAG_OVERRIDE_GAME_PRIORITY;
-
-  if (skip_transform) {
-    SyncTransformWithDepsgraph();
+Object *KX_GameObject::TagForTransformUpdateEvaluated(Depsgraph *depsgraph)
+{
+  /* Can be called from multiple threads, only the evaluated object of this game object
+   * must be modified. */
+  Object *ob_orig = GetBlenderObject();
+  if (!ob_orig || m_isInstance) {
+    return nullptr;
   }
 
-  if (ob_orig && !skip_transform) {
-    Object *ob_eval = DEG_get_evaluated_object(depsgraph, ob_orig);
-    copy_m4_m4(ob_eval->obmat, obmat);
-    BKE_object_apply_mat4(ob_eval, ob_eval->obmat, false, true);
-  }
+  Object *ob_eval = DEG_get_evaluated_object(depsgraph, ob_orig);
+  NodeGetWorldTransform().getValue(&ob_eval->obmat[0][0]);
+  return ob_eval;
 }
 
 void KX_GameObject::ReplicateBlenderObject()
 {
   Object *ob = GetBlenderObject();
+  m_pReplicaPoolKey = nullptr;
+  m_isInstance = false;
 
   if (ob) {
     bContext *C = KX_GetActiveEngine()->GetContext();
     Main *bmain = CTX_data_main(C);
+    const NodeList &children = GetSGNode()->GetSGChildren();
+
+    /* Only the copies of original mesh objects outside of any hierarchy are pooled,
+     * the other copies reference their replicated parent. */
+    if (!m_isReplica && ob->type == OB_MESH && !ob->parent && children.empty()) {
+      // Keep the original blender object and only register a transform to draw it.
+      if (GetScene()->IsInstancedReplication()) {
+        m_isInstance = true;
+        GetScene()->AddInstanceObject(this);
+        return;
+      }
+
+      m_pReplicaPoolKey = ob;
+
+      Object *pooledob = GetScene()->PopReplicaObject(ob);
+      if (pooledob) {
+        copy_m4_m4(pooledob->obmat, ob->obmat);
+        copy_v4_v4(pooledob->color, ob->color);
+
+        m_pBlenderObject = pooledob;
+        m_isReplica = true;
+        return;
+      }
+    }
+
     Object *newob;
     BKE_id_copy_ex(bmain, &ob->id, (ID **)&newob, 0);
     id_us_min(&newob->id);
@@ -393,12 +494,11 @@ void KX_GameObject::ReplicateBlenderObject()
     }
 
     // To check again
-    const NodeList &children = GetSGNode()->GetSGChildren();
     if (children.size() > 0) {
       GetScene()->SetLastReplicatedParentObject(newob);
     }
 
-    DEG_relations_tag_update(bmain);
+    GetScene()->TagForRelationsUpdate();
 
     m_pBlenderObject = newob;
     m_isReplica = true;
@@ -407,19 +507,30 @@ void KX_GameObject::ReplicateBlenderObject()
 void KX_GameObject::RemoveReplicaObject()
 {
   Object *ob = GetBlenderObject();
+  if (m_isInstance) {
+    // Already removed from its instance group by the scene.
+    SetBlenderObject(nullptr);
+    return;
+  }
+
   if (ob && m_isReplica) {
-    bContext *C = KX_GetActiveEngine()->GetContext();
-    Main *bmain = CTX_data_main(C);
-    BKE_id_delete(bmain, ob);
+    GetScene()->RemoveDynamicObject(ob);
+    // Keep the copy for the next replication instead of rebuilding the depsgraph relations.
+    if (m_pReplicaPoolKey && GetScene()->m_isRuntime &&
+        GetScene()->PushReplicaObject(m_pReplicaPoolKey, ob)) {
+      SetBlenderObject(nullptr);
+      return;
+    }
+
+    GetScene()->DeleteBlenderObject(ob);
     SetBlenderObject(nullptr);
-    DEG_relations_tag_update(bmain);
   }
 }
 
 void KX_GameObject::HideOriginalObject()
 {
   Object *ob = GetBlenderObject();
-  if (ob && !m_isReplica &&
+  if (ob && !m_isReplica && !m_isInstance &&
       (ob->base_flag & (BASE_VISIBLE_VIEWLAYER | BASE_VISIBLE_DEPSGRAPH)) != 0) {
     Scene *scene = GetScene()->GetBlenderScene();
     ViewLayer *view_layer = BKE_view_layer_default_view(scene);
@@ -427,8 +538,7 @@ void KX_GameObject::HideOriginalObject()
     if (base) {  // As for SetVisible, there are cases (when we use bpy...) where Objects have no
                  // base.
       base->flag |= BASE_HIDDEN;
-      BKE_layer_collection_sync(scene, view_layer);
-      DEG_id_tag_update(&scene->id, ID_RECALC_BASE_FLAGS);
+      GetScene()->TagForLayerCollectionSync();
       GetScene()->m_hiddenObjectsDuringRuntime.push_back(ob);
     }
   }
@@ -576,6 +686,8 @@ void KX_GameObject::SetActivityCullingInfo(const ActivityCullingInfo &cullingInf
 
 void KX_GameObject::SetActivityCulling(ActivityCullingInfo::Flag flag, bool enable)
 {
+  GetScene()->InvalidateActivityCulling();
+
   if (enable) {
     m_activityCullingInfo.m_flags = (ActivityCullingInfo::Flag)(m_activityCullingInfo.m_flags |
                                                                 flag);
@@ -591,6 +703,12 @@ void KX_GameObject::SetActivityCulling(ActivityCullingInfo::Flag flag, bool enab
     if (flag & ActivityCullingInfo::ACTIVITY_LOGIC) {
       RestoreLogicAndActions(false);
     }
+    if ((flag & ActivityCullingInfo::ACTIVITY_PHYSICS_LOD) && m_pPhysicsController) {
+      m_pPhysicsController->SetSimplifiedShape(false);
+    }
+    if (flag & ActivityCullingInfo::ACTIVITY_LOGIC_LOD) {
+      SetLogicInterval(1);
+    }
   }
 }
 
@@ -598,6 +716,7 @@ void KX_GameObject::AddDummyLodManager(RAS_MeshObject *meshObj, Object *ob)
 {
   m_lodManager = new KX_LodManager(meshObj, ob);
   m_lodManager->AddRef();
+  InvalidateLodDistanceRange();
   GetScene()->AddObjToLodObjList(this);
 }
 
@@ -606,6 +725,21 @@ bool KX_GameObject::IsReplica()
   return m_isReplica;
 }
 
+bool KX_GameObject::IsInstance() const
+{
+  return m_isInstance;
+}
+
+bool KX_GameObject::IsBatched() const
+{
+  return m_isBatched;
+}
+
+void KX_GameObject::SetBatched(bool batched)
+{
+  m_isBatched = batched;
+}
+
 void KX_GameObject::SetIsReplicaObject()
 {
   m_isReplica = true;
@@ -634,6 +768,13 @@ std::string KX_GameObject::GetName()
 void KX_GameObject::SetName(const std::string &name)
 {
   m_name = name;
+
+  // The message sensors read the messages sent to the new name.
+  for (SCA_ISensor *sensor : m_sensors) {
+    if (sensor->GetSensorType() == SCA_ISensor::ST_MESSAGE) {
+      static_cast<SCA_NetworkMessageSensor *>(sensor)->UpdateFilter();
+    }
+  }
 }
 
 PHY_IPhysicsController *KX_GameObject::GetPhysicsController()
@@ -833,7 +974,7 @@ BL_ActionManager *KX_GameObject::GetActionManagerNoCreate()
   return m_actionManager;
 }
 
-bool KX_GameObject::PlayAction(const std::string &name,
+bool KX_GameObject::PlayAction(bAction *action,
                                float start,
                                float end,
                                short layer,
@@ -843,19 +984,27 @@ bool KX_GameObject::PlayAction(const std::string &name,
                                float layer_weight,
                                short ipo_flags,
                                float playback_speed,
-                               short blend_mode)
-{
-  return GetActionManager()->PlayAction(name,
-                                        start,
-                                        end,
-                                        layer,
-                                        priority,
-                                        blendin,
-                                        play_mode,
-                                        layer_weight,
-                                        ipo_flags,
-                                        playback_speed,
-                                        blend_mode);
+                               short blend_mode,
+                               bool bake)
+{
+  if (!GetActionManager()->PlayAction(action,
+                                      start,
+                                      end,
+                                      layer,
+                                      priority,
+                                      blendin,
+                                      play_mode,
+                                      layer_weight,
+                                      ipo_flags,
+                                      playback_speed,
+                                      blend_mode,
+                                      bake)) {
+    return false;
+  }
+
+  // The object could have been removed from the animated objects once its actions finished.
+  GetScene()->AddAnimatedObject(this);
+  return true;
 }
 
 void KX_GameObject::StopAction(short layer)
@@ -878,9 +1027,19 @@ bool KX_GameObject::IsActionsSuspended()
   return GetActionManager()->IsSuspended();
 }
 
-void KX_GameObject::UpdateActionManager(float curtime, bool applyToObject)
+bool KX_GameObject::IsActionsIdle()
+{
+  return GetActionManager()->IsIdle();
+}
+
+bool KX_GameObject::UpdateActionManager(float curtime, bool applyToObject, bool deferObject)
 {
-  GetActionManager()->Update(curtime, applyToObject);
+  return GetActionManager()->Update(curtime, applyToObject, deferObject);
+}
+
+void KX_GameObject::UpdateActionObject()
+{
+  GetActionManager()->UpdateObject();
 }
 
 float KX_GameObject::GetActionFrame(short layer)
@@ -913,23 +1072,37 @@ void KX_GameObject::ProcessReplica()
   KX_PythonProxy::ProcessReplica();
 
   ReplicateBlenderObject();
-  GetScene()->GetBlenderSceneConverter()->RegisterGameObject(this, m_pBlenderObject);
+  // The blender object of an instance stays associated to its original game object.
+  if (!m_isInstance) {
+    GetScene()->GetBlenderSceneConverter()->RegisterGameObject(this, m_pBlenderObject);
+  }
 
   m_pPhysicsController = nullptr;
+  // The graphic controller is replicated in KX_Scene::AddNodeReplicaObject.
+  m_pGraphicController = nullptr;
   m_pSGNode = nullptr;
 
   /* Dupli group and instance list are set later in replication.
    * See KX_Scene::DupliGroupRecurse. */
   m_pDupliGroupObject = nullptr;
   m_pInstanceObjects = nullptr;
+  m_isBatched = false;
   m_pClient_info = new KX_ClientObjectInfo(*m_pClient_info);
   m_pClient_info->m_gameobject = this;
   m_actionManager = nullptr;
+  m_inTransformUpdateList = false;
+  m_inAnimatedList = false;
   m_state = 0;
 
   if (m_lodManager) {
-    m_lodManager->AddRef();
-    GetScene()->AddObjToLodObjList(this);
+    // The level of detail switches the mesh of the blender object shared by all the instances.
+    if (m_isInstance) {
+      m_lodManager = nullptr;
+    }
+    else {
+      m_lodManager->AddRef();
+      GetScene()->AddObjToLodObjList(this);
+    }
   }
 
 #ifdef WITH_PYTHON
@@ -937,6 +1110,14 @@ void KX_GameObject::ProcessReplica()
   if (m_attr_dict)
     m_attr_dict = PyDict_Copy(m_attr_dict);
 
+  // The replica has no physics controller registered for its end callbacks yet.
+  m_collisionEndCallbacks = nullptr;
+
+  // The wrappers are owned by the original object.
+  for (PyObject *&wrapper : m_pyMathWrappers) {
+    wrapper = nullptr;
+  }
+
   if (m_components) {
     m_components = (EXP_ListValue<KX_PythonComponent> *)m_components->GetReplica();
     for (KX_PythonComponent *component : m_components) {
@@ -1095,15 +1276,34 @@ void KX_GameObject::RemoveMeshes()
   m_meshes.clear();
 }
 
-bool KX_GameObject::UseCulling() const
+void KX_GameObject::ConvertMeshGeometry()
 {
+  for (RAS_MeshObject *meshobj : m_meshes) {
+    BL_ConvertMeshGeometry(meshobj);
+  }
+}
+
+bool KX_GameObject::HasMaterialName(const std::string &name) const
+{
+  for (RAS_MeshObject *meshObj : m_meshes) {
+    if (meshObj->HasMaterialName(name)) {
+      return true;
+    }
+  }
+
   return false;
 }
 
+bool KX_GameObject::UseCulling() const
+{
+  return (m_pGraphicController != nullptr);
+}
+
 void KX_GameObject::SetLodManager(KX_LodManager *lodManager)
 {
   // Reset lod level to avoid overflow index in KX_LodManager::GetLevel.
   m_currentLodLevel = 0;
+  InvalidateLodDistanceRange();
 
   // Restore object original mesh.
   if (!lodManager && m_lodManager && m_lodManager->GetLevelCount() > 0) {
@@ -1128,15 +1328,32 @@ KX_LodManager *KX_GameObject::GetLodManager() const
   return m_lodManager;
 }
 
-void KX_GameObject::UpdateLod(const MT_Vector3 &cam_pos, float lodfactor)
+void KX_GameObject::InvalidateLodDistanceRange()
+{
+  m_lodMinDistance2 = FLT_MAX;
+  m_lodMaxDistance2 = 0.0f;
+}
+
+KX_GameObject::LodUpdateResult KX_GameObject::UpdateLod(Depsgraph *depsgraph,
+                                                        const MT_Vector3 &cam_pos,
+                                                        float lodfactor,
+                                                        bool allowSwitch)
 {
   if (!m_lodManager) {
-    return;
+    return LOD_UNCHANGED;
   }
 
   KX_Scene *scene = GetScene();
   const float distance2 = NodeGetWorldPosition().distance2(cam_pos) * (lodfactor * lodfactor);
-  KX_LodLevel *lodLevel = m_lodManager->GetLevel(scene, m_currentLodLevel, distance2);
+
+  /* Search a new level only when the distance leaves the range of the current level,
+   * most of the objects are far from a level threshold. */
+  KX_LodLevel *lodLevel = nullptr;
+  if (distance2 < m_lodMinDistance2 || distance2 >= m_lodMaxDistance2) {
+    lodLevel = m_lodManager->GetLevel(scene, m_currentLodLevel, distance2);
+    const short level = lodLevel ? lodLevel->GetLevel() : m_currentLodLevel;
+    m_lodManager->GetLevelDistanceRange(scene, level, m_lodMinDistance2, m_lodMaxDistance2);
+  }
 
   bool updatePhysicsShape = false;
   if (GetBlenderObject()->gameflag & OB_LOD_UPDATE_PHYSICS) {
@@ -1152,20 +1369,29 @@ void KX_GameObject::UpdateLod(const MT_Vector3 &cam_pos, float lodfactor)
     }
   }
 
+  LodUpdateResult result = LOD_UNCHANGED;
   if (lodLevel) {
     RAS_MeshObject *mesh = lodLevel->GetMesh();
-    if (mesh != m_meshes[0]) {
-      scene->ReplaceMesh(this, mesh, true, false);
+    const bool meshChanged = (mesh != m_meshes[0]);
+    if (meshChanged || lodLevel->GetLevel() != m_currentLodLevel) {
+      if (allowSwitch) {
+        if (meshChanged) {
+          scene->ReplaceMesh(this, mesh, true, false);
+        }
+        m_currentLodLevel = lodLevel->GetLevel();
+        result = LOD_SWITCHED;
+      }
+      else {
+        // Keep the current level until the next update and search the level again.
+        InvalidateLodDistanceRange();
+        result = LOD_DEFERRED;
+      }
     }
-    m_currentLodLevel = lodLevel->GetLevel();
   }
 
   KX_LodLevel *currentLodLevel = m_lodManager->GetLevel(m_currentLodLevel);
 
   if (currentLodLevel) {
-    bContext *C = KX_GetActiveEngine()->GetContext();
-    Depsgraph *depsgraph = CTX_data_expect_evaluated_depsgraph(C);
-
     /* Here we want to change the object which will be rendered, then the evaluated object by the
      * depsgraph */
     Object *ob_eval = DEG_get_evaluated_object(depsgraph, GetBlenderObject());
@@ -1178,10 +1404,18 @@ void KX_GameObject::UpdateLod(const MT_Vector3 &cam_pos, float lodfactor)
   if (updatePhysicsShape) {
     GetPhysicsController()->ReinstancePhysicsShape(this, nullptr, false, true);
   }
+
+  return result;
 }
 
 void KX_GameObject::UpdateActivity(float distance)
 {
+  // Manage physics level of detail.
+  if ((m_activityCullingInfo.m_flags & ActivityCullingInfo::ACTIVITY_PHYSICS_LOD) &&
+      m_pPhysicsController) {
+    m_pPhysicsController->SetSimplifiedShape(distance > m_activityCullingInfo.m_physicsLodRadius);
+  }
+
   // Manage physics culling.
   if (m_activityCullingInfo.m_flags & ActivityCullingInfo::ACTIVITY_PHYSICS) {
     if (distance > m_activityCullingInfo.m_physicsRadius) {
@@ -1192,6 +1426,13 @@ void KX_GameObject::UpdateActivity(float distance)
     }
   }
 
+  // Manage logic level of detail, the logic culling suspends the logic beyond its radius.
+  if (m_activityCullingInfo.m_flags & ActivityCullingInfo::ACTIVITY_LOGIC_LOD) {
+    SetLogicInterval((distance > m_activityCullingInfo.m_logicLodRadius) ?
+                         m_activityCullingInfo.m_logicLodInterval :
+                         1);
+  }
+
   // Manage logic culling.
   if (m_activityCullingInfo.m_flags & ActivityCullingInfo::ACTIVITY_LOGIC) {
     if (distance > m_activityCullingInfo.m_logicRadius) {
@@ -1203,6 +1444,13 @@ void KX_GameObject::UpdateActivity(float distance)
   }
 }
 
+void KX_GameObject::ActivateGraphicController(bool active)
+{
+  if (m_pGraphicController) {
+    m_pGraphicController->Activate(active);
+  }
+}
+
 void KX_GameObject::UpdateTransform()
 {
   // HACK: saves function call for dynamic object, they are handled differently
@@ -1213,6 +1461,7 @@ void KX_GameObject::UpdateTransform()
 void KX_GameObject::UpdateTransformFunc(SG_Node *node, void *gameobj, void *scene)
 {
   ((KX_GameObject *)gameobj)->UpdateTransform();
+  ((KX_Scene *)scene)->ActivityCullingObjectMoved((KX_GameObject *)gameobj);
 }
 
 void KX_GameObject::SynchronizeTransform()
@@ -1270,7 +1519,18 @@ static void setVisible_recursive(SG_Node *node, bool v)
 void KX_GameObject::SetVisible(bool v, bool recursive)
 {
   Object *ob = GetBlenderObject();
-  if (ob) {
+  // The batch can't hide a single object, the object is drawn by itself again.
+  if (m_isBatched && v != m_bVisible) {
+    GetScene()->GetStaticBatchManager()->RemoveObject(this);
+  }
+
+  if (m_isInstance) {
+    // Hidden instances are skipped when the instance matrices are gathered.
+    if (v != m_bVisible) {
+      GetScene()->TagInstanceGroupUpdate(this);
+    }
+  }
+  else if (ob) {
     Scene *scene = GetScene()->GetBlenderScene();
     ViewLayer *view_layer = BKE_view_layer_default_view(scene);
     Base *base = BKE_view_layer_base_find(view_layer, ob);
@@ -1282,8 +1542,7 @@ void KX_GameObject::SetVisible(bool v, bool recursive)
         base->flag |= BASE_HIDDEN;
       }
 
-      BKE_layer_collection_sync(scene, view_layer);
-      DEG_id_tag_update(&scene->id, ID_RECALC_BASE_FLAGS);
+      GetScene()->TagForLayerCollectionSync();
     }
   }
 
@@ -1386,7 +1645,7 @@ void KX_GameObject::SetObjectColor(const MT_Vector4 &rgbavec)
 {
   m_objectColor = rgbavec;
   Object *ob_orig = GetBlenderObject();
-  if (ob_orig && GetScene()->OrigObCanBeTransformedInRealtime(ob_orig) &&
+  if (ob_orig && !m_isInstance && GetScene()->OrigObCanBeTransformedInRealtime(ob_orig) &&
       ELEM(ob_orig->type, OB_MESH, OB_CURVE, OB_SURF, OB_FONT, OB_MBALL)) {
     copy_v4_v4(ob_orig->color, m_objectColor.getValue());
     DEG_id_tag_update(&ob_orig->id, ID_RECALC_SHADING | ID_RECALC_TRANSFORM);
@@ -1788,6 +2047,65 @@ void KX_GameObject::RunCollisionCallbacks(KX_GameObject *collider,
 #endif
 }
 
+void KX_GameObject::RunCollisionEndCallbacks(KX_GameObject *collider)
+{
+#ifdef WITH_PYTHON
+  if (!m_collisionEndCallbacks || PyList_GET_SIZE(m_collisionEndCallbacks) == 0) {
+    return;
+  }
+
+  PyObject *args[] = {collider->GetProxy()};
+  EXP_RunPythonCallBackList(m_collisionEndCallbacks, args, 1, ARRAY_SIZE(args));
+
+  Py_DECREF(args[0]);
+#endif
+}
+
+bool KX_GameObject::FilterCollisionCallbacks(KX_GameObject *collider,
+                                             const PHY_CollData *colldata,
+                                             bool first) const
+{
+#ifdef WITH_PYTHON
+  if ((!m_collisionCallbacks || PyList_GET_SIZE(m_collisionCallbacks) == 0) &&
+      (!m_collisionEndCallbacks || PyList_GET_SIZE(m_collisionEndCallbacks) == 0)) {
+    return false;
+  }
+
+  if (!(collider->GetUserCollisionGroup() & m_collisionCallbackMask)) {
+    return false;
+  }
+
+  if (m_collisionCallbackImpulse > 0.0f) {
+    float impulse = 0.0f;
+    for (unsigned int i = 0, size = colldata->GetNumContacts(); i < size; ++i) {
+      impulse = std::max(impulse, colldata->GetAppliedImpulse(i, first));
+    }
+    if (impulse < m_collisionCallbackImpulse) {
+      return false;
+    }
+  }
+
+  return true;
+#else
+  return false;
+#endif
+}
+
+bool KX_GameObject::TrackCollisionContacts() const
+{
+#ifdef WITH_PYTHON
+  return (!m_collisionCallbackPersistent ||
+          (m_collisionEndCallbacks && PyList_GET_SIZE(m_collisionEndCallbacks) > 0));
+#else
+  return false;
+#endif
+}
+
+bool KX_GameObject::GetCollisionCallbackPersistent() const
+{
+  return m_collisionCallbackPersistent;
+}
+
 void KX_GameObject::RunOnRemoveCallbacks()
 {
 #ifdef WITH_PYTHON
@@ -1880,14 +2198,41 @@ void KX_GameObject::SetComponents(EXP_ListValue<KX_PythonComponent> *components)
 void KX_GameObject::Update()
 {
 #ifdef WITH_PYTHON
-  if (!m_logicSuspended) {
-    if (m_components) {
-      for (KX_PythonComponent *comp : m_components) {
-        comp->Update();
+  SCA_LogicManager *logicmgr = GetScene()->GetLogicManager();
+  if (!m_logicSuspended && !IsLogicFrameSkipped(logicmgr->GetFrame())) {
+    SCA_ObjectProfiler &objectProfiler = logicmgr->GetObjectProfiler();
+    const bool profileObject = objectProfiler.GetEnabled();
+    const double objectStartTime = profileObject ? SCA_ObjectProfiler::GetTime() : 0.0;
+
+    SCA_ScriptProfiler &profiler = logicmgr->GetScriptProfiler();
+    if (profiler.GetEnabled()) {
+      if (m_components) {
+        for (KX_PythonComponent *comp : m_components) {
+          const double startTime = SCA_ScriptProfiler::GetTime();
+          comp->Update();
+          profiler.AddCall(GetName() + "/" + comp->GetName(), startTime);
+        }
+      }
+
+      if (GetPrototype()) {
+        const double startTime = SCA_ScriptProfiler::GetTime();
+        KX_PythonProxy::Update();
+        profiler.AddCall(GetName() + "/" + KX_PythonProxy::GetName(), startTime);
       }
     }
+    else {
+      if (m_components) {
+        for (KX_PythonComponent *comp : m_components) {
+          comp->Update();
+        }
+      }
 
-    KX_PythonProxy::Update();
+      KX_PythonProxy::Update();
+    }
+
+    if (profileObject) {
+      objectProfiler.AddTime(this, SCA_ObjectProfiler::CATEGORY_COMPONENTS, objectStartTime);
+    }
   }
 #endif  // WITH_PYTHON
 }
@@ -2208,6 +2553,7 @@ PyMethodDef KX_GameObject::Methods[] = {
     EXP_PYMETHODTABLE_O(KX_GameObject, getVectTo),
     EXP_PYMETHODTABLE_KEYWORDS(KX_GameObject, sendMessage),
     EXP_PYMETHODTABLE(KX_GameObject, addDebugProperty),
+    EXP_PYMETHODTABLE_KEYWORDS(KX_GameObject, addParticleEmitter),
 
     EXP_PYMETHODTABLE_KEYWORDS(KX_GameObject, playAction),
     EXP_PYMETHODTABLE(KX_GameObject, stopAction),
@@ -2261,6 +2607,26 @@ PyAttributeDef KX_GameObject::Attributes[] = {
         "physicsCulling", KX_GameObject, pyattr_get_physicsCulling, pyattr_set_physicsCulling),
     EXP_PYATTRIBUTE_RW_FUNCTION(
         "logicCulling", KX_GameObject, pyattr_get_logicCulling, pyattr_set_logicCulling),
+    EXP_PYATTRIBUTE_RW_FUNCTION(
+        "physicsLod", KX_GameObject, pyattr_get_physicsLod, pyattr_set_physicsLod),
+    EXP_PYATTRIBUTE_RW_FUNCTION("physicsLodRadius",
+                                KX_GameObject,
+                                pyattr_get_physicsLodRadius,
+                                pyattr_set_physicsLodRadius),
+    EXP_PYATTRIBUTE_RW_FUNCTION(
+        "logicLod", KX_GameObject, pyattr_get_logicLod, pyattr_set_logicLod),
+    EXP_PYATTRIBUTE_RW_FUNCTION(
+        "logicLodRadius", KX_GameObject, pyattr_get_logicLodRadius, pyattr_set_logicLodRadius),
+    EXP_PYATTRIBUTE_RW_FUNCTION("logicLodInterval",
+                                KX_GameObject,
+                                pyattr_get_logicLodInterval,
+                                pyattr_set_logicLodInterval),
+    EXP_PYATTRIBUTE_RW_FUNCTION(
+        "replicationId", KX_GameObject, pyattr_get_replicationId, pyattr_set_replicationId),
+    EXP_PYATTRIBUTE_RW_FUNCTION("replicationOwner",
+                                KX_GameObject,
+                                pyattr_get_replicationOwner,
+                                pyattr_set_replicationOwner),
 
     EXP_PYATTRIBUTE_RW_FUNCTION(
         "position", KX_GameObject, pyattr_get_worldPosition, pyattr_set_localPosition),
@@ -2275,6 +2641,16 @@ PyAttributeDef KX_GameObject::Attributes[] = {
                                 KX_GameObject,
                                 pyattr_get_collisionCallbacks,
                                 pyattr_set_collisionCallbacks),
+    EXP_PYATTRIBUTE_RW_FUNCTION("collisionEndCallbacks",
+                                KX_GameObject,
+                                pyattr_get_collisionEndCallbacks,
+                                pyattr_set_collisionEndCallbacks),
+    EXP_PYATTRIBUTE_INT_RW(
+        "collisionCallbackMask", 0, 0xFFFF, false, KX_GameObject, m_collisionCallbackMask),
+    EXP_PYATTRIBUTE_FLOAT_RW(
+        "collisionCallbackImpulse", 0.0f, FLT_MAX, KX_GameObject, m_collisionCallbackImpulse),
+    EXP_PYATTRIBUTE_BOOL_RW(
+        "collisionCallbackPersistent", KX_GameObject, m_collisionCallbackPersistent),
     EXP_PYATTRIBUTE_RW_FUNCTION(
         "onRemove", KX_GameObject, pyattr_get_remove_callback, pyattr_set_remove_callback),
     EXP_PYATTRIBUTE_RW_FUNCTION(
@@ -2422,6 +2798,14 @@ PyObject *KX_GameObject::PyReinstancePhysicsMesh(PyObject *args, PyObject *kwds)
     return nullptr;
   }
 
+  // The new shape is built from the polygons of the mesh.
+  if (mesh) {
+    BL_ConvertMeshGeometry(mesh);
+  }
+  else {
+    (gameobj ? gameobj : this)->ConvertMeshGeometry();
+  }
+
   /* gameobj and mesh can be nullptr */
   if (GetPhysicsController() &&
       GetPhysicsController()->ReinstancePhysicsShape(gameobj, mesh, dupli, evaluated))
@@ -2716,6 +3100,7 @@ int KX_GameObject::pyattr_set_name(EXP_PyObjectPlus *self_v,
 
   // Change the name
   self->SetName(newname);
+  self->GetScene()->GetObjectList()->InvalidateNameIndex();
 
   return PY_SET_ATTR_SUCCESS;
 }
@@ -2788,6 +3173,52 @@ int KX_GameObject::pyattr_set_collisionCallbacks(EXP_PyObjectPlus *self_v,
   return PY_SET_ATTR_SUCCESS;
 }
 
+PyObject *KX_GameObject::pyattr_get_collisionEndCallbacks(EXP_PyObjectPlus *self_v,
+                                                          const EXP_PYATTRIBUTE_DEF *attrdef)
+{
+  KX_GameObject *self = static_cast<KX_GameObject *>(self_v);
+
+  // Only objects with a physics controller should have collision callbacks
+  PYTHON_CHECK_PHYSICS_CONTROLLER(self, "collisionEndCallbacks", nullptr);
+
+  // Return the existing callbacks
+  if (self->m_collisionEndCallbacks == nullptr) {
+    self->m_collisionEndCallbacks = PyList_New(0);
+    // Subscribe to collision update from KX_CollisionEventManager
+    self->RegisterCollisionCallbacks();
+  }
+  Py_INCREF(self->m_collisionEndCallbacks);
+  return self->m_collisionEndCallbacks;
+}
+
+int KX_GameObject::pyattr_set_collisionEndCallbacks(EXP_PyObjectPlus *self_v,
+                                                    const EXP_PYATTRIBUTE_DEF *attrdef,
+                                                    PyObject *value)
+{
+  KX_GameObject *self = static_cast<KX_GameObject *>(self_v);
+
+  // Only objects with a physics controller should have collision callbacks
+  PYTHON_CHECK_PHYSICS_CONTROLLER(self, "collisionEndCallbacks", PY_SET_ATTR_FAIL);
+
+  if (!PyList_CheckExact(value)) {
+    PyErr_SetString(PyExc_ValueError, "Expected a list");
+    return PY_SET_ATTR_FAIL;
+  }
+
+  if (self->m_collisionEndCallbacks == nullptr) {
+    self->RegisterCollisionCallbacks();
+  }
+  else {
+    Py_DECREF(self->m_collisionEndCallbacks);
+  }
+
+  Py_INCREF(value);
+
+  self->m_collisionEndCallbacks = value;
+
+  return PY_SET_ATTR_SUCCESS;
+}
+
 PyObject *KX_GameObject::pyattr_get_remove_callback(EXP_PyObjectPlus *self_v,
                                                     const EXP_PYATTRIBUTE_DEF *attrdef)
 {
@@ -2912,11 +3343,11 @@ PyObject *KX_GameObject::pyattr_get_life(EXP_PyObjectPlus *self_v,
 {
   KX_GameObject *self = static_cast<KX_GameObject *>(self_v);
 
-  EXP_Value *life = self->GetProperty("::timebomb");
-  if (life)
+  float life;
+  if (self->GetScene()->GetTimeBombLife(self, life))
     // this convert the timebomb seconds to frames, hard coded 50.0f (assuming 50fps)
     // value hardcoded in KX_Scene::AddReplicaObject()
-    return PyFloat_FromDouble(life->GetNumber() * 50.0);
+    return PyFloat_FromDouble(life * 50.0);
   else
     Py_RETURN_NONE;
 }
@@ -3230,6 +3661,192 @@ int KX_GameObject::pyattr_set_physicsCullingRadius(EXP_PyObjectPlus *self_v,
   }
 
   self->GetActivityCullingInfo().m_physicsRadius = val * val;
+  self->GetScene()->InvalidateActivityCulling();
+
+  return PY_SET_ATTR_SUCCESS;
+}
+
+PyObject *KX_GameObject::pyattr_get_physicsLod(EXP_PyObjectPlus *self_v,
+                                               const EXP_PYATTRIBUTE_DEF *attrdef)
+{
+  KX_GameObject *self = static_cast<KX_GameObject *>(self_v);
+  return PyBool_FromLong(self->GetActivityCullingInfo().m_flags &
+                         ActivityCullingInfo::ACTIVITY_PHYSICS_LOD);
+}
+
+int KX_GameObject::pyattr_set_physicsLod(EXP_PyObjectPlus *self_v,
+                                         const EXP_PYATTRIBUTE_DEF *attrdef,
+                                         PyObject *value)
+{
+  KX_GameObject *self = static_cast<KX_GameObject *>(self_v);
+  int param = PyObject_IsTrue(value);
+  if (param == -1) {
+    PyErr_SetString(PyExc_AttributeError,
+                    "gameOb.physicsLod = bool: KX_GameObject, expected True or False");
+    return PY_SET_ATTR_FAIL;
+  }
+
+  self->SetActivityCulling(ActivityCullingInfo::ACTIVITY_PHYSICS_LOD, param);
+  return PY_SET_ATTR_SUCCESS;
+}
+
+PyObject *KX_GameObject::pyattr_get_physicsLodRadius(EXP_PyObjectPlus *self_v,
+                                                     const EXP_PYATTRIBUTE_DEF *attrdef)
+{
+  KX_GameObject *self = static_cast<KX_GameObject *>(self_v);
+  return PyFloat_FromDouble(std::sqrt(self->GetActivityCullingInfo().m_physicsLodRadius));
+}
+
+int KX_GameObject::pyattr_set_physicsLodRadius(EXP_PyObjectPlus *self_v,
+                                               const EXP_PYATTRIBUTE_DEF *attrdef,
+                                               PyObject *value)
+{
+  KX_GameObject *self = static_cast<KX_GameObject *>(self_v);
+  const float val = PyFloat_AsDouble(value);
+  if (val < 0.0f) {  // Also accounts for non float.
+    PyErr_SetString(
+        PyExc_AttributeError,
+        "gameOb.physicsLodRadius = float: KX_GameObject, expected a float zero or above");
+    return PY_SET_ATTR_FAIL;
+  }
+
+  self->GetActivityCullingInfo().m_physicsLodRadius = val * val;
+  self->GetScene()->InvalidateActivityCulling();
+
+  return PY_SET_ATTR_SUCCESS;
+}
+
+PyObject *KX_GameObject::pyattr_get_logicLod(EXP_PyObjectPlus *self_v,
+                                             const EXP_PYATTRIBUTE_DEF *attrdef)
+{
+  KX_GameObject *self = static_cast<KX_GameObject *>(self_v);
+  return PyBool_FromLong(self->GetActivityCullingInfo().m_flags &
+                         ActivityCullingInfo::ACTIVITY_LOGIC_LOD);
+}
+
+int KX_GameObject::pyattr_set_logicLod(EXP_PyObjectPlus *self_v,
+                                       const EXP_PYATTRIBUTE_DEF *attrdef,
+                                       PyObject *value)
+{
+  KX_GameObject *self = static_cast<KX_GameObject *>(self_v);
+  int param = PyObject_IsTrue(value);
+  if (param == -1) {
+    PyErr_SetString(PyExc_AttributeError,
+                    "gameOb.logicLod = bool: KX_GameObject, expected True or False");
+    return PY_SET_ATTR_FAIL;
+  }
+
+  self->SetActivityCulling(ActivityCullingInfo::ACTIVITY_LOGIC_LOD, param);
+  return PY_SET_ATTR_SUCCESS;
+}
+
+PyObject *KX_GameObject::pyattr_get_logicLodRadius(EXP_PyObjectPlus *self_v,
+                                                   const EXP_PYATTRIBUTE_DEF *attrdef)
+{
+  KX_GameObject *self = static_cast<KX_GameObject *>(self_v);
+  return PyFloat_FromDouble(std::sqrt(self->GetActivityCullingInfo().m_logicLodRadius));
+}
+
+int KX_GameObject::pyattr_set_logicLodRadius(EXP_PyObjectPlus *self_v,
+                                             const EXP_PYATTRIBUTE_DEF *attrdef,
+                                             PyObject *value)
+{
+  KX_GameObject *self = static_cast<KX_GameObject *>(self_v);
+  const float val = PyFloat_AsDouble(value);
+  if (val < 0.0f) {  // Also accounts for non float.
+    PyErr_SetString(
+        PyExc_AttributeError,
+        "gameOb.logicLodRadius = float: KX_GameObject, expected a float zero or above");
+    return PY_SET_ATTR_FAIL;
+  }
+
+  self->GetActivityCullingInfo().m_logicLodRadius = val * val;
+  self->GetScene()->InvalidateActivityCulling();
+
+  return PY_SET_ATTR_SUCCESS;
+}
+
+PyObject *KX_GameObject::pyattr_get_logicLodInterval(EXP_PyObjectPlus *self_v,
+                                                     const EXP_PYATTRIBUTE_DEF *attrdef)
+{
+  KX_GameObject *self = static_cast<KX_GameObject *>(self_v);
+  return PyLong_FromLong(self->GetActivityCullingInfo().m_logicLodInterval);
+}
+
+int KX_GameObject::pyattr_set_logicLodInterval(EXP_PyObjectPlus *self_v,
+                                               const EXP_PYATTRIBUTE_DEF *attrdef,
+                                               PyObject *value)
+{
+  KX_GameObject *self = static_cast<KX_GameObject *>(self_v);
+  const long val = PyLong_AsLong(value);
+  if (val < 1 || val > 1000) {  // Also accounts for non integer.
+    PyErr_SetString(
+        PyExc_AttributeError,
+        "gameOb.logicLodInterval = int: KX_GameObject, expected an integer between 1 and 1000");
+    return PY_SET_ATTR_FAIL;
+  }
+
+  self->GetActivityCullingInfo().m_logicLodInterval = val;
+  self->GetScene()->InvalidateActivityCulling();
+
+  return PY_SET_ATTR_SUCCESS;
+}
+
+PyObject *KX_GameObject::pyattr_get_replicationId(EXP_PyObjectPlus *self_v,
+                                                  const EXP_PYATTRIBUTE_DEF *attrdef)
+{
+  KX_GameObject *self = static_cast<KX_GameObject *>(self_v);
+  return PyLong_FromLong(self->GetScene()->GetReplicationManager().GetId(self));
+}
+
+int KX_GameObject::pyattr_set_replicationId(EXP_PyObjectPlus *self_v,
+                                            const EXP_PYATTRIBUTE_DEF *attrdef,
+                                            PyObject *value)
+{
+  KX_GameObject *self = static_cast<KX_GameObject *>(self_v);
+  const long val = PyLong_AsLong(value);
+  if (val < 0 || val > INT_MAX) {  // Also accounts for non int.
+    PyErr_SetString(PyExc_AttributeError,
+                    "gameOb.replicationId = int: KX_GameObject, expected an int zero or above");
+    return PY_SET_ATTR_FAIL;
+  }
+
+  if (!self->GetScene()->GetReplicationManager().SetId(self, val)) {
+    PyErr_Format(PyExc_ValueError,
+                 "gameOb.replicationId = int: KX_GameObject, the identifier %ld is used by "
+                 "another object",
+                 val);
+    return PY_SET_ATTR_FAIL;
+  }
+
+  return PY_SET_ATTR_SUCCESS;
+}
+
+PyObject *KX_GameObject::pyattr_get_replicationOwner(EXP_PyObjectPlus *self_v,
+                                                     const EXP_PYATTRIBUTE_DEF *attrdef)
+{
+  KX_GameObject *self = static_cast<KX_GameObject *>(self_v);
+  return PyBool_FromLong(self->GetScene()->GetReplicationManager().GetOwner(self));
+}
+
+int KX_GameObject::pyattr_set_replicationOwner(EXP_PyObjectPlus *self_v,
+                                               const EXP_PYATTRIBUTE_DEF *attrdef,
+                                               PyObject *value)
+{
+  KX_GameObject *self = static_cast<KX_GameObject *>(self_v);
+  int param = PyObject_IsTrue(value);
+  if (param == -1) {
+    PyErr_SetString(PyExc_AttributeError,
+                    "gameOb.replicationOwner = bool: KX_GameObject, expected True or False");
+    return PY_SET_ATTR_FAIL;
+  }
+
+  if (!self->GetScene()->GetReplicationManager().SetOwner(self, param)) {
+    PyErr_SetString(PyExc_ValueError,
+                    "gameOb.replicationOwner = bool: KX_GameObject, the object has no "
+                    "replicationId");
+    return PY_SET_ATTR_FAIL;
+  }
 
   return PY_SET_ATTR_SUCCESS;
 }
@@ -3255,18 +3872,61 @@ int KX_GameObject::pyattr_set_logicCullingRadius(EXP_PyObjectPlus *self_v,
   }
 
   self->GetActivityCullingInfo().m_logicRadius = val * val;
+  self->GetScene()->InvalidateActivityCulling();
 
   return PY_SET_ATTR_SUCCESS;
 }
 
+#  ifdef USE_MATHUTILS
+PyObject *KX_GameObject::GetPyMathWrapper(PyMathWrapperType type)
+{
+  PyObject *proxy = EXP_PROXY_FROM_REF_BORROW(this);
+  PyObject *&wrapper = m_pyMathWrappers[type];
+
+  // The proxy is replaced when the object is mutated into a python subclass.
+  if (wrapper && ((BaseMathObject *)wrapper)->cb_user == proxy) {
+    Py_INCREF(wrapper);
+    return wrapper;
+  }
+
+  Py_XDECREF(wrapper);
+  switch (type) {
+    case PY_MATH_WRAPPER_POS_LOCAL: {
+      wrapper = Vector_CreatePyObject_cb(
+          proxy, 3, mathutils_kxgameob_vector_cb_index, MATHUTILS_VEC_CB_POS_LOCAL);
+      break;
+    }
+    case PY_MATH_WRAPPER_POS_GLOBAL: {
+      wrapper = Vector_CreatePyObject_cb(
+          proxy, 3, mathutils_kxgameob_vector_cb_index, MATHUTILS_VEC_CB_POS_GLOBAL);
+      break;
+    }
+    case PY_MATH_WRAPPER_ORI_LOCAL: {
+      wrapper = Matrix_CreatePyObject_cb(
+          proxy, 3, 3, mathutils_kxgameob_matrix_cb_index, MATHUTILS_MAT_CB_ORI_LOCAL);
+      break;
+    }
+    case PY_MATH_WRAPPER_ORI_GLOBAL: {
+      wrapper = Matrix_CreatePyObject_cb(
+          proxy, 3, 3, mathutils_kxgameob_matrix_cb_index, MATHUTILS_MAT_CB_ORI_GLOBAL);
+      break;
+    }
+    default: {
+      wrapper = nullptr;
+      break;
+    }
+  }
+
+  Py_XINCREF(wrapper);
+  return wrapper;
+}
+#  endif  // USE_MATHUTILS
+
 PyObject *KX_GameObject::pyattr_get_worldPosition(EXP_PyObjectPlus *self_v,
                                                   const EXP_PYATTRIBUTE_DEF *attrdef)
 {
 #  ifdef USE_MATHUTILS
-  return Vector_CreatePyObject_cb(EXP_PROXY_FROM_REF_BORROW(self_v),
-                                  3,
-                                  mathutils_kxgameob_vector_cb_index,
-                                  MATHUTILS_VEC_CB_POS_GLOBAL);
+  return static_cast<KX_GameObject *>(self_v)->GetPyMathWrapper(PY_MATH_WRAPPER_POS_GLOBAL);
 #  else
   KX_GameObject *self = static_cast<KX_GameObject *>(self_v);
   return PyObjectFrom(self->NodeGetWorldPosition());
@@ -3291,10 +3951,7 @@ PyObject *KX_GameObject::pyattr_get_localPosition(EXP_PyObjectPlus *self_v,
                                                   const EXP_PYATTRIBUTE_DEF *attrdef)
 {
 #  ifdef USE_MATHUTILS
-  return Vector_CreatePyObject_cb(EXP_PROXY_FROM_REF_BORROW(self_v),
-                                  3,
-                                  mathutils_kxgameob_vector_cb_index,
-                                  MATHUTILS_VEC_CB_POS_LOCAL);
+  return static_cast<KX_GameObject *>(self_v)->GetPyMathWrapper(PY_MATH_WRAPPER_POS_LOCAL);
 #  else
   KX_GameObject *self = static_cast<KX_GameObject *>(self_v);
   return PyObjectFrom(self->NodeGetLocalPosition());
@@ -3335,11 +3992,7 @@ PyObject *KX_GameObject::pyattr_get_worldOrientation(EXP_PyObjectPlus *self_v,
                                                      const EXP_PYATTRIBUTE_DEF *attrdef)
 {
 #  ifdef USE_MATHUTILS
-  return Matrix_CreatePyObject_cb(EXP_PROXY_FROM_REF_BORROW(self_v),
-                                  3,
-                                  3,
-                                  mathutils_kxgameob_matrix_cb_index,
-                                  MATHUTILS_MAT_CB_ORI_GLOBAL);
+  return static_cast<KX_GameObject *>(self_v)->GetPyMathWrapper(PY_MATH_WRAPPER_ORI_GLOBAL);
 #  else
   KX_GameObject *self = static_cast<KX_GameObject *>(self_v);
   return PyObjectFrom(self->NodeGetWorldOrientation());
@@ -3367,11 +4020,7 @@ PyObject *KX_GameObject::pyattr_get_localOrientation(EXP_PyObjectPlus *self_v,
                                                      const EXP_PYATTRIBUTE_DEF *attrdef)
 {
 #  ifdef USE_MATHUTILS
-  return Matrix_CreatePyObject_cb(EXP_PROXY_FROM_REF_BORROW(self_v),
-                                  3,
-                                  3,
-                                  mathutils_kxgameob_matrix_cb_index,
-                                  MATHUTILS_MAT_CB_ORI_LOCAL);
+  return static_cast<KX_GameObject *>(self_v)->GetPyMathWrapper(PY_MATH_WRAPPER_ORI_LOCAL);
 #  else
   KX_GameObject *self = static_cast<KX_GameObject *>(self_v);
   return PyObjectFrom(self->NodeGetLocalOrientation());
@@ -4416,7 +5065,8 @@ PyObject *KX_GameObject::pyattr_get_blender_object(EXP_PyObjectPlus *self_v,
 {
   KX_GameObject *self = static_cast<KX_GameObject *>(self_v);
   Object *ob = self->GetBlenderObject();
-  if (ob) {
+  // The blender object of an instance is shared with the original object.
+  if (ob && !self->IsInstance()) {
     PyObject *py_blender_object = pyrna_id_CreatePyObject(&ob->id);
     return py_blender_object;
   }
@@ -4852,7 +5502,8 @@ static void layer_check(short &layer, const char *method_name)
 EXP_PYMETHODDEF_DOC(KX_GameObject,
                     playAction,
                     "playAction(name, start_frame, end_frame, layer=0, priority=0 blendin=0, "
-                    "play_mode=ACT_MODE_PLAY, layer_weight=0.0, ipo_flags=0, speed=1.0)\n"
+                    "play_mode=ACT_MODE_PLAY, layer_weight=0.0, ipo_flags=0, speed=1.0, "
+                    "blend_mode=ACT_BLEND_BLEND, bake=False)\n"
                     "Plays an action\n")
 {
   const char *name;
@@ -4861,6 +5512,7 @@ EXP_PYMETHODDEF_DOC(KX_GameObject,
   short ipo_flags = 0;
   short play_mode = 0;
   short blend_mode = 0;
+  int bake = 0;
 
   static const char *kwlist[] = {"name",
                                  "start_frame",
@@ -4873,11 +5525,12 @@ EXP_PYMETHODDEF_DOC(KX_GameObject,
                                  "ipo_flags",
                                  "speed",
                                  "blend_mode",
+                                 "bake",
                                  nullptr};
 
   if (!PyArg_ParseTupleAndKeywords(args,
                                    kwds,
-                                   "sff|hhfhfhfh:playAction",
+                                   "sff|hhfhfhfhp:playAction",
                                    const_cast<char **>(kwlist),
                                    &name,
                                    &start,
@@ -4889,7 +5542,8 @@ EXP_PYMETHODDEF_DOC(KX_GameObject,
                                    &layer_weight,
                                    &ipo_flags,
                                    &speed,
-                                   &blend_mode)) {
+                                   &blend_mode,
+                                   &bake)) {
     return nullptr;
   }
 
@@ -4921,7 +5575,12 @@ EXP_PYMETHODDEF_DOC(KX_GameObject,
     layer_weight = 0.f;
   }
 
-  PlayAction(name,
+  bAction *action = (bAction *)GetScene()->GetLogicManager()->GetActionByName(name);
+  if (!action) {
+    CM_Error("failed to load action: " << name);
+  }
+
+  PlayAction(action,
              start,
              end,
              layer,
@@ -4931,7 +5590,8 @@ EXP_PYMETHODDEF_DOC(KX_GameObject,
              layer_weight,
              ipo_flags,
              speed,
-             blend_mode);
+             blend_mode,
+             bake);
 
   Py_RETURN_NONE;
 }
@@ -5045,6 +5705,36 @@ EXP_PYMETHODDEF_DOC(KX_GameObject,
   Py_RETURN_NONE;
 }
 
+EXP_PYMETHODDEF_DOC(KX_GameObject,
+                    addParticleEmitter,
+                    "addParticleEmitter(maxParticles=10000)\n"
+                    "Add an emitter of GPU particles to the object.\n")
+{
+  int maxParticles = 10000;
+
+  static const char *kwlist[] = {"maxParticles", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(
+          args, kwds, "|i:addParticleEmitter", const_cast<char **>(kwlist), &maxParticles)) {
+    return nullptr;
+  }
+
+  if (maxParticles < 1 || maxParticles > (1 << 24)) {
+    PyErr_SetString(PyExc_ValueError,
+                    "gameOb.addParticleEmitter(maxParticles): KX_GameObject, expected a "
+                    "particle count between 1 and 16777216");
+    return nullptr;
+  }
+
+  if (!RAS_ParticleSystem::Supported()) {
+    PyErr_SetString(PyExc_RuntimeError,
+                    "gameOb.addParticleEmitter(maxParticles): KX_GameObject, the GPU doesn't "
+                    "support the compute shaders");
+    return nullptr;
+  }
+
+  return GetScene()->GetParticleManager()->AddEmitter(this, maxParticles)->GetProxy();
+}
+
 /* dict style access */
 
 /* Matches python dict.get(key, [default]) */
@@ -50,6 +50,7 @@
 #include "MT_Transform.h"
 #include "SCA_IObject.h"
 #include "SCA_LogicManager.h" /* for ConvertPythonToGameObject to search object names */
+#include "SG_CullingNode.h"
 #include "SG_Node.h"
 
 // Forward declarations.
@@ -59,10 +60,13 @@ class KX_LodManager;
 class KX_PythonComponent;
 class RAS_MeshObject;
 class PHY_IPhysicsController;
+class PHY_IGraphicController;
+class PHY_CollData;
 class BL_ActionManager;
 struct Object;
 class KX_CollisionContactPointList;
 struct bAction;
+struct Depsgraph;
 
 struct Mesh;
 
@@ -94,21 +98,37 @@ class KX_GameObject : public SCA_IObject {
     enum Flag {
       ACTIVITY_NONE = 0,
       ACTIVITY_PHYSICS = (1 << 0),
-      ACTIVITY_LOGIC = (1 << 1)
+      ACTIVITY_LOGIC = (1 << 1),
+      ACTIVITY_PHYSICS_LOD = (1 << 2),
+      ACTIVITY_LOGIC_LOD = (1 << 3)
     } m_flags;
 
     /// Squared physics culling radius.
     float m_physicsRadius;
     /// Squared logic culling radius.
     float m_logicRadius;
+    /// Squared radius beyond which the physics shape is simplified.
+    float m_physicsLodRadius;
+    /// Squared radius beyond which the logic runs every m_logicLodInterval frames.
+    float m_logicLodRadius;
+    unsigned short m_logicLodInterval;
   };
 
  protected:
   /* EEVEE INTEGRATION */
   float m_prevObmat[4][4];
   bool m_isReplica;
+  /** The object has no blender object copy and is drawn as an instance of its original
+   * blender object, see KX_Scene::AddInstanceObject. */
+  bool m_isInstance;
+  /// The blender object is hidden and drawn merged in a batch, see KX_StaticBatchManager.
+  bool m_isBatched;
   bool m_visibleAtGameStart;
   bool m_forceIgnoreParentTx;
+  /// The object is registered in the scene list of objects to notify to the depsgraph.
+  bool m_inTransformUpdateList;
+  /// The object is registered in the scene list of objects with actions to update.
+  bool m_inAnimatedList;
   short m_previousLodLevel;
   /* END OF EEVEE INTEGRATION */
 
@@ -118,8 +138,13 @@ class KX_GameObject : public SCA_IObject {
   std::vector<RAS_MeshObject *> m_meshes;
   KX_LodManager *m_lodManager;
   short m_currentLodLevel;
+  /// Range of squared camera distances keeping the current lod level, empty when unknown.
+  float m_lodMinDistance2;
+  float m_lodMaxDistance2;
   struct Object *m_pBlenderObject;
   struct Object *m_pBlenderGroupObject;
+  /// Original object the replica blender object was copied from when it can be pooled.
+  struct Object *m_pReplicaPoolKey;
 
   bool m_bIsNegativeScaling;
   MT_Vector4 m_objectColor;
@@ -128,6 +153,13 @@ class KX_GameObject : public SCA_IObject {
   unsigned short m_userCollisionGroup;
   unsigned short m_userCollisionMask;
 
+  /// Collision groups of the colliders running the collision callbacks.
+  int m_collisionCallbackMask;
+  /// Minimum impulse of the strongest contact point to run the collision callbacks.
+  float m_collisionCallbackImpulse;
+  /// Run the collision callbacks every frame of a contact, else only when it begins.
+  bool m_collisionCallbackPersistent;
+
   // visible = user setting
   // culled = while rendering, depending on camera
   bool m_bVisible;
@@ -137,7 +169,10 @@ class KX_GameObject : public SCA_IObject {
   ActivityCullingInfo m_activityCullingInfo;
 
   PHY_IPhysicsController *m_pPhysicsController;
+  /// Bounding volume of the object in the culling tree of the physics environment.
+  PHY_IGraphicController *m_pGraphicController;
   SG_Node *m_pSGNode;
+  SG_CullingNode m_cullingNode;
 
 #ifdef WITH_PYTHON
   EXP_ListValue<KX_PythonComponent> *m_components;
@@ -157,7 +192,12 @@ class KX_GameObject : public SCA_IObject {
   /* EEVEE INTEGRATION */
 
   void TagForTransformUpdate(bool is_overlay_pass, bool is_last_render_pass);
-  void TagForTransformUpdateEvaluated();
+  /// Return true when the object transform is driven by the depsgraph and not the game engine.
+  bool IsTransformOverridenByDepsgraph();
+  /** Write the world transform in the evaluated object matrix and return the evaluated
+   * object, its loc/rot/size are not updated.
+   */
+  Object *TagForTransformUpdateEvaluated(Depsgraph *depsgraph);
   void ReplicateBlenderObject();
   void HideOriginalObject();
   void RemoveReplicaObject();
@@ -167,7 +207,14 @@ class KX_GameObject : public SCA_IObject {
   void RestoreLogicAndActions(bool childrenRecursive);
   void AddDummyLodManager(RAS_MeshObject *meshObj, Object *ob);
   bool IsReplica();
+  bool IsInstance() const;
+  bool IsBatched() const;
+  void SetBatched(bool batched);
   void ForceIgnoreParentTx();
+  bool IsInTransformUpdateList() const;
+  void SetInTransformUpdateList(bool inList);
+  bool IsInAnimatedList() const;
+  void SetInAnimatedList(bool inList);
   void SyncTransformWithDepsgraph();
   void SetIsReplicaObject();
   float *GetPrevObmat();
@@ -214,7 +261,25 @@ class KX_GameObject : public SCA_IObject {
   //
   PyObject *m_attr_dict;
   PyObject *m_collisionCallbacks;
+  PyObject *m_collisionEndCallbacks;
   PyObject *m_removeCallbacks;
+
+  /// Transform attributes returning a cached mathutils wrapper.
+  enum PyMathWrapperType {
+    PY_MATH_WRAPPER_POS_LOCAL = 0,
+    PY_MATH_WRAPPER_POS_GLOBAL,
+    PY_MATH_WRAPPER_ORI_LOCAL,
+    PY_MATH_WRAPPER_ORI_GLOBAL,
+    PY_MATH_WRAPPER_MAX
+  };
+
+  /** Mathutils callback wrappers of the transform attributes. They always read the current
+   * transform so a single wrapper is shared by all the accesses of an attribute.
+   */
+  PyObject *m_pyMathWrappers[PY_MATH_WRAPPER_MAX];
+
+  /// Return a new reference to the mathutils wrapper of a transform attribute.
+  PyObject *GetPyMathWrapper(PyMathWrapperType type);
 #endif
 
   virtual void /* This function should be virtual - derived classed override it */
@@ -277,8 +342,9 @@ class KX_GameObject : public SCA_IObject {
 
   /**
    * Adds an action to the object's action manager
+   * \param action The action resolved with SCA_LogicManager::GetActionByName.
    */
-  bool PlayAction(const std::string &name,
+  bool PlayAction(bAction *action,
                   float start,
                   float end,
                   short layer = 0,
@@ -288,7 +354,8 @@ class KX_GameObject : public SCA_IObject {
                   float layer_weight = 0.f,
                   short ipo_flags = 0,
                   float playback_speed = 1.f,
-                  short blend_mode = 0);
+                  short blend_mode = 0,
+                  bool bake = false);
 
   /**
    * Gets the current frame of an action
@@ -332,13 +399,22 @@ class KX_GameObject : public SCA_IObject {
 
   bool IsActionsSuspended();
 
+  /// Return true when all the actions are finished and applied to the object.
+  bool IsActionsIdle();
+
   /**
    * Kick the object's action manager
    * \param curtime The current time used to compute the actions frame.
    * \param applyObject Set to true if the actions must transform this object, else it only manages
    * actions' frames.
+   * \param deferObject Set to true when updating from an animation pool thread, the caller
+   * must then call UpdateActionObject from the main thread.
+   * \return True when the armature pose of this object was changed.
    */
-  void UpdateActionManager(float curtime, bool applyObject);
+  bool UpdateActionManager(float curtime, bool applyObject, bool deferObject = false);
+
+  /// Update the scene graph controllers and this object for the actions of the last update.
+  void UpdateActionObject();
 
   /*********************************
    * End Animation API
@@ -442,6 +518,28 @@ class KX_GameObject : public SCA_IObject {
   {
     m_pPhysicsController = physicscontroller;
   }
+
+  /**
+   * \return a pointer to the graphic controller owned by this class.
+   */
+  PHY_IGraphicController *GetGraphicController()
+  {
+    return m_pGraphicController;
+  }
+
+  void SetGraphicController(PHY_IGraphicController *graphiccontroller)
+  {
+    m_pGraphicController = graphiccontroller;
+  }
+
+  /// Add or remove the graphic controller from the culling tree.
+  void ActivateGraphicController(bool active);
+
+  /// Return the culling state of the object in the last culling pass.
+  SG_CullingNode &GetCullingNode()
+  {
+    return m_cullingNode;
+  }
   /// Return true when the game object is a .
   virtual bool IsDeformable() const
   {
@@ -654,6 +752,9 @@ class KX_GameObject : public SCA_IObject {
     m_meshes.push_back(mesh);
   }
 
+  /// Convert the geometry of the meshes deferred while the object was inactive.
+  void ConvertMeshGeometry();
+
   /** Set current lod manager, can be nullptr.
    * If nullptr the object's mesh backs to the mesh of the previous first lod level.
    */
@@ -661,10 +762,26 @@ class KX_GameObject : public SCA_IObject {
   /// Get current lod manager.
   KX_LodManager *GetLodManager() const;
 
+  /// Result of a lod update.
+  enum LodUpdateResult {
+    /// The lod level didn't change.
+    LOD_UNCHANGED,
+    /// The lod level changed and the mesh was replaced.
+    LOD_SWITCHED,
+    /// A mesh replacement is needed but was not allowed, the previous level stays visible.
+    LOD_DEFERRED
+  };
+
   /**
    * Updates the current lod level based on distance from camera.
+   * \param allowSwitch False to keep the current mesh when a new level needs another mesh.
    */
-  void UpdateLod(const MT_Vector3 &cam_pos, float lodfactor);
+  LodUpdateResult UpdateLod(Depsgraph *depsgraph,
+                            const MT_Vector3 &cam_pos,
+                            float lodfactor,
+                            bool allowSwitch);
+  /// Force the lod level to be computed again at the next update.
+  void InvalidateLodDistanceRange();
 
   /** Update the activity culling of the object.
    * \param distance Squared nearest distance to the cameras of this object.
@@ -688,6 +805,9 @@ class KX_GameObject : public SCA_IObject {
     return m_meshes.size();
   }
 
+  /// Return true if a material of a mesh has this name without its ID code prefix.
+  bool HasMaterialName(const std::string &name) const;
+
   /// Return true when the object can be culled.
   bool UseCulling() const;
 
@@ -747,6 +867,19 @@ class KX_GameObject : public SCA_IObject {
   void UnregisterCollisionCallbacks();
   void RunCollisionCallbacks(KX_GameObject *collider,
                              KX_CollisionContactPointList &contactPointList);
+  void RunCollisionEndCallbacks(KX_GameObject *collider);
+
+  /** Return true if the object has collision callbacks to run for this collider,
+   * the collider must be in the callback mask and the strongest contact point must
+   * reach the callback impulse.
+   * \param first True if the object is the first object of the collision data.
+   */
+  bool FilterCollisionCallbacks(KX_GameObject *collider,
+                                const PHY_CollData *colldata,
+                                bool first) const;
+  /// Return true if the begin and end of the object contacts must be tracked.
+  bool TrackCollisionContacts() const;
+  bool GetCollisionCallbackPersistent() const;
 
   /* Run the registered python callbacks when the KX_GameObject is removed. */
   void RunOnRemoveCallbacks();
@@ -842,6 +975,7 @@ class KX_GameObject : public SCA_IObject {
   EXP_PYMETHOD(KX_GameObject, ReinstancePhysicsMesh);
   EXP_PYMETHOD_O(KX_GameObject, ReplacePhysicsShape);
   EXP_PYMETHOD_DOC(KX_GameObject, addDebugProperty);
+  EXP_PYMETHOD_DOC(KX_GameObject, addParticleEmitter);
 
   EXP_PYMETHOD_DOC(KX_GameObject, playAction);
   EXP_PYMETHOD_DOC(KX_GameObject, stopAction);
@@ -923,6 +1057,41 @@ class KX_GameObject : public SCA_IObject {
   static int pyattr_set_physicsCullingRadius(EXP_PyObjectPlus *self_v,
                                              const EXP_PYATTRIBUTE_DEF *attrdef,
                                              PyObject *value);
+  static PyObject *pyattr_get_physicsLod(EXP_PyObjectPlus *self_v,
+                                         const EXP_PYATTRIBUTE_DEF *attrdef);
+  static int pyattr_set_physicsLod(EXP_PyObjectPlus *self_v,
+                                   const EXP_PYATTRIBUTE_DEF *attrdef,
+                                   PyObject *value);
+  static PyObject *pyattr_get_physicsLodRadius(EXP_PyObjectPlus *self_v,
+                                               const EXP_PYATTRIBUTE_DEF *attrdef);
+  static int pyattr_set_physicsLodRadius(EXP_PyObjectPlus *self_v,
+                                         const EXP_PYATTRIBUTE_DEF *attrdef,
+                                         PyObject *value);
+  static PyObject *pyattr_get_logicLod(EXP_PyObjectPlus *self_v,
+                                       const EXP_PYATTRIBUTE_DEF *attrdef);
+  static int pyattr_set_logicLod(EXP_PyObjectPlus *self_v,
+                                 const EXP_PYATTRIBUTE_DEF *attrdef,
+                                 PyObject *value);
+  static PyObject *pyattr_get_logicLodRadius(EXP_PyObjectPlus *self_v,
+                                             const EXP_PYATTRIBUTE_DEF *attrdef);
+  static int pyattr_set_logicLodRadius(EXP_PyObjectPlus *self_v,
+                                       const EXP_PYATTRIBUTE_DEF *attrdef,
+                                       PyObject *value);
+  static PyObject *pyattr_get_logicLodInterval(EXP_PyObjectPlus *self_v,
+                                               const EXP_PYATTRIBUTE_DEF *attrdef);
+  static int pyattr_set_logicLodInterval(EXP_PyObjectPlus *self_v,
+                                         const EXP_PYATTRIBUTE_DEF *attrdef,
+                                         PyObject *value);
+  static PyObject *pyattr_get_replicationId(EXP_PyObjectPlus *self_v,
+                                            const EXP_PYATTRIBUTE_DEF *attrdef);
+  static int pyattr_set_replicationId(EXP_PyObjectPlus *self_v,
+                                      const EXP_PYATTRIBUTE_DEF *attrdef,
+                                      PyObject *value);
+  static PyObject *pyattr_get_replicationOwner(EXP_PyObjectPlus *self_v,
+                                               const EXP_PYATTRIBUTE_DEF *attrdef);
+  static int pyattr_set_replicationOwner(EXP_PyObjectPlus *self_v,
+                                         const EXP_PYATTRIBUTE_DEF *attrdef,
+                                         PyObject *value);
   static PyObject *pyattr_get_logicCullingRadius(EXP_PyObjectPlus *self_v,
                                                  const EXP_PYATTRIBUTE_DEF *attrdef);
   static int pyattr_set_logicCullingRadius(EXP_PyObjectPlus *self_v,
@@ -1027,6 +1196,11 @@ class KX_GameObject : public SCA_IObject {
   static int pyattr_set_collisionCallbacks(EXP_PyObjectPlus *self_v,
                                            const EXP_PYATTRIBUTE_DEF *attrdef,
                                            PyObject *value);
+  static PyObject *pyattr_get_collisionEndCallbacks(EXP_PyObjectPlus *self_v,
+                                                    const EXP_PYATTRIBUTE_DEF *attrdef);
+  static int pyattr_set_collisionEndCallbacks(EXP_PyObjectPlus *self_v,
+                                              const EXP_PYATTRIBUTE_DEF *attrdef,
+                                              PyObject *value);
   static PyObject *pyattr_get_collisionGroup(EXP_PyObjectPlus *self_v,
                                              const EXP_PYATTRIBUTE_DEF *attrdef);
   static int pyattr_set_collisionGroup(EXP_PyObjectPlus *self_v,
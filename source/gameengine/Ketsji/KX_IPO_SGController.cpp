@@ -111,241 +111,246 @@ bool KX_IpoSGController::Update(double currentTime)
       (*i)->Execute(m_ipotime);  // currentTime);
     }
 
-    SG_Node *ob = (SG_Node *)m_node;
-
-    // initialization on the first frame of the IPO
-    if (!m_ipo_start_initialized) {
-      m_ipo_start_point = ob->GetLocalPosition();
-      m_ipo_start_orient = ob->GetLocalOrientation();
-      m_ipo_start_scale = ob->GetLocalScale();
-      m_ipo_start_initialized = true;
-      if (!m_ipo_euler_initialized) {
-        // do it only once to avoid angle discontinuities
-        m_ipo_start_orient.getEuler(
-            m_ipo_start_euler[0], m_ipo_start_euler[1], m_ipo_start_euler[2]);
-        m_ipo_euler_initialized = true;
+    ApplyTransform();
+  }
+  return false;
+}
+
+void KX_IpoSGController::ApplyTransform()
+{
+  SG_Node *ob = (SG_Node *)m_node;
+
+  // initialization on the first frame of the IPO
+  if (!m_ipo_start_initialized) {
+    m_ipo_start_point = ob->GetLocalPosition();
+    m_ipo_start_orient = ob->GetLocalOrientation();
+    m_ipo_start_scale = ob->GetLocalScale();
+    m_ipo_start_initialized = true;
+    if (!m_ipo_euler_initialized) {
+      // do it only once to avoid angle discontinuities
+      m_ipo_start_orient.getEuler(
+          m_ipo_start_euler[0], m_ipo_start_euler[1], m_ipo_start_euler[2]);
+      m_ipo_euler_initialized = true;
+    }
+  }
+
+  // modifies position?
+  if (m_ipo_channels_active[OB_LOC_X] || m_ipo_channels_active[OB_LOC_Y] ||
+      m_ipo_channels_active[OB_LOC_Z] || m_ipo_channels_active[OB_DLOC_X] ||
+      m_ipo_channels_active[OB_DLOC_Y] || m_ipo_channels_active[OB_DLOC_Z]) {
+    if (m_ipo_as_force == true) {
+      if (m_game_object && ob && m_game_object->GetPhysicsController()) {
+        MT_Vector3 vec = m_ipo_local ? ob->GetWorldOrientation() * m_ipo_xform.GetPosition() :
+                                       m_ipo_xform.GetPosition();
+        m_game_object->GetPhysicsController()->ApplyForce(vec, false);
       }
     }
+    else {
+      // Local ipo should be defined with the object position at (0,0,0)
+      // Local transform is applied to the object based on initial position
+      MT_Vector3 newPosition(0.0f, 0.0f, 0.0f);
 
-    // modifies position?
-    if (m_ipo_channels_active[OB_LOC_X] || m_ipo_channels_active[OB_LOC_Y] ||
-        m_ipo_channels_active[OB_LOC_Z] || m_ipo_channels_active[OB_DLOC_X] ||
-        m_ipo_channels_active[OB_DLOC_Y] || m_ipo_channels_active[OB_DLOC_Z]) {
-      if (m_ipo_as_force == true) {
-        if (m_game_object && ob && m_game_object->GetPhysicsController()) {
-          MT_Vector3 vec = m_ipo_local ? ob->GetWorldOrientation() * m_ipo_xform.GetPosition() :
-                                         m_ipo_xform.GetPosition();
-          m_game_object->GetPhysicsController()->ApplyForce(vec, false);
-        }
+      if (!m_ipo_add)
+        newPosition = ob->GetLocalPosition();
+      // apply separate IPO channels if there is any data in them
+      // Loc and dLoc act by themselves or are additive
+      // LocX and dLocX
+      if (m_ipo_channels_active[OB_LOC_X]) {
+        newPosition[0] = (m_ipo_channels_active[OB_DLOC_X] ?
+                              m_ipo_xform.GetPosition()[0] + m_ipo_xform.GetDeltaPosition()[0] :
+                              m_ipo_xform.GetPosition()[0]);
       }
-      else {
-        // Local ipo should be defined with the object position at (0,0,0)
-        // Local transform is applied to the object based on initial position
-        MT_Vector3 newPosition(0.0f, 0.0f, 0.0f);
-
-        if (!m_ipo_add)
-          newPosition = ob->GetLocalPosition();
-        // apply separate IPO channels if there is any data in them
-        // Loc and dLoc act by themselves or are additive
-        // LocX and dLocX
-        if (m_ipo_channels_active[OB_LOC_X]) {
-          newPosition[0] = (m_ipo_channels_active[OB_DLOC_X] ?
-                                m_ipo_xform.GetPosition()[0] + m_ipo_xform.GetDeltaPosition()[0] :
-                                m_ipo_xform.GetPosition()[0]);
-        }
-        else if (m_ipo_channels_active[OB_DLOC_X] && m_ipo_start_initialized) {
-          newPosition[0] = (((!m_ipo_add) ? m_ipo_start_point[0] : 0.0f) +
-                            m_ipo_xform.GetDeltaPosition()[0]);
-        }
-        // LocY and dLocY
-        if (m_ipo_channels_active[OB_LOC_Y]) {
-          newPosition[1] = (m_ipo_channels_active[OB_DLOC_Y] ?
-                                m_ipo_xform.GetPosition()[1] + m_ipo_xform.GetDeltaPosition()[1] :
-                                m_ipo_xform.GetPosition()[1]);
-        }
-        else if (m_ipo_channels_active[OB_DLOC_Y] && m_ipo_start_initialized) {
-          newPosition[1] = (((!m_ipo_add) ? m_ipo_start_point[1] : 0.0f) +
-                            m_ipo_xform.GetDeltaPosition()[1]);
-        }
-        // LocZ and dLocZ
-        if (m_ipo_channels_active[OB_LOC_Z]) {
-          newPosition[2] = (m_ipo_channels_active[OB_DLOC_Z] ?
-                                m_ipo_xform.GetPosition()[2] + m_ipo_xform.GetDeltaPosition()[2] :
-                                m_ipo_xform.GetPosition()[2]);
-        }
-        else if (m_ipo_channels_active[OB_DLOC_Z] && m_ipo_start_initialized) {
-          newPosition[2] = (((!m_ipo_add) ? m_ipo_start_point[2] : 0.0f) +
-                            m_ipo_xform.GetDeltaPosition()[2]);
-        }
-        if (m_ipo_add) {
-          if (m_ipo_local)
-            newPosition = m_ipo_start_point +
-                          m_ipo_start_scale * (m_ipo_start_orient * newPosition);
-          else
-            newPosition = m_ipo_start_point + newPosition;
-        }
-        if (m_game_object)
-          m_game_object->NodeSetLocalPosition(newPosition);
+      else if (m_ipo_channels_active[OB_DLOC_X] && m_ipo_start_initialized) {
+        newPosition[0] = (((!m_ipo_add) ? m_ipo_start_point[0] : 0.0f) +
+                          m_ipo_xform.GetDeltaPosition()[0]);
       }
-    }
-    // modifies orientation?
-    if (m_ipo_channels_active[OB_ROT_X] || m_ipo_channels_active[OB_ROT_Y] ||
-        m_ipo_channels_active[OB_ROT_Z] || m_ipo_channels_active[OB_DROT_X] ||
-        m_ipo_channels_active[OB_DROT_Y] || m_ipo_channels_active[OB_DROT_Z]) {
-      if (m_ipo_as_force) {
-        if (m_game_object && ob) {
-          m_game_object->ApplyTorque(m_ipo_local ?
-                                         ob->GetWorldOrientation() * m_ipo_xform.GetEulerAngles() :
-                                         m_ipo_xform.GetEulerAngles(),
-                                     false);
-        }
+      // LocY and dLocY
+      if (m_ipo_channels_active[OB_LOC_Y]) {
+        newPosition[1] = (m_ipo_channels_active[OB_DLOC_Y] ?
+                              m_ipo_xform.GetPosition()[1] + m_ipo_xform.GetDeltaPosition()[1] :
+                              m_ipo_xform.GetPosition()[1]);
       }
-      else if (m_ipo_add) {
-        if (m_ipo_start_initialized) {
-          double yaw = 0.0, pitch = 0.0, roll = 0.0;  // delta Euler angles
-
-          // RotX and dRotX
-          if (m_ipo_channels_active[OB_ROT_X])
-            yaw += m_ipo_xform.GetEulerAngles()[0];
-          if (m_ipo_channels_active[OB_DROT_X])
-            yaw += m_ipo_xform.GetDeltaEulerAngles()[0];
-
-          // RotY dRotY
-          if (m_ipo_channels_active[OB_ROT_Y])
-            pitch += m_ipo_xform.GetEulerAngles()[1];
-          if (m_ipo_channels_active[OB_DROT_Y])
-            pitch += m_ipo_xform.GetDeltaEulerAngles()[1];
-
-          // RotZ and dRotZ
-          if (m_ipo_channels_active[OB_ROT_Z])
-            roll += m_ipo_xform.GetEulerAngles()[2];
-          if (m_ipo_channels_active[OB_DROT_Z])
-            roll += m_ipo_xform.GetDeltaEulerAngles()[2];
-
-          MT_Matrix3x3 rotation(MT_Vector3(yaw, pitch, roll));
-          if (m_ipo_local)
-            rotation = m_ipo_start_orient * rotation;
-          else
-            rotation = rotation * m_ipo_start_orient;
-          if (m_game_object)
-            m_game_object->NodeSetLocalOrientation(rotation);
-        }
+      else if (m_ipo_channels_active[OB_DLOC_Y] && m_ipo_start_initialized) {
+        newPosition[1] = (((!m_ipo_add) ? m_ipo_start_point[1] : 0.0f) +
+                          m_ipo_xform.GetDeltaPosition()[1]);
       }
-      else if (m_ipo_channels_active[OB_ROT_X] || m_ipo_channels_active[OB_ROT_Y] ||
-               m_ipo_channels_active[OB_ROT_Z]) {
-        if (m_ipo_euler_initialized) {
-          // assume all channel absolute
-          // All 3 channels should be specified but if they are not, we will take
-          // the value at the start of the game to avoid angle sign reversal
-          double yaw = m_ipo_start_euler[0], pitch = m_ipo_start_euler[1],
-                 roll = m_ipo_start_euler[2];
-
-          // RotX and dRotX
-          if (m_ipo_channels_active[OB_ROT_X]) {
-            yaw = (m_ipo_channels_active[OB_DROT_X] ?
-                       (m_ipo_xform.GetEulerAngles()[0] + m_ipo_xform.GetDeltaEulerAngles()[0]) :
-                       m_ipo_xform.GetEulerAngles()[0]);
-          }
-          else if (m_ipo_channels_active[OB_DROT_X]) {
-            yaw += m_ipo_xform.GetDeltaEulerAngles()[0];
-          }
-
-          // RotY dRotY
-          if (m_ipo_channels_active[OB_ROT_Y]) {
-            pitch = (m_ipo_channels_active[OB_DROT_Y] ?
-                         (m_ipo_xform.GetEulerAngles()[1] + m_ipo_xform.GetDeltaEulerAngles()[1]) :
-                         m_ipo_xform.GetEulerAngles()[1]);
-          }
-          else if (m_ipo_channels_active[OB_DROT_Y]) {
-            pitch += m_ipo_xform.GetDeltaEulerAngles()[1];
-          }
-
-          // RotZ and dRotZ
-          if (m_ipo_channels_active[OB_ROT_Z]) {
-            roll = (m_ipo_channels_active[OB_DROT_Z] ?
-                        (m_ipo_xform.GetEulerAngles()[2] + m_ipo_xform.GetDeltaEulerAngles()[2]) :
-                        m_ipo_xform.GetEulerAngles()[2]);
-          }
-          else if (m_ipo_channels_active[OB_DROT_Z]) {
-            roll += m_ipo_xform.GetDeltaEulerAngles()[2];
-          }
-          if (m_game_object)
-            m_game_object->NodeSetLocalOrientation(MT_Matrix3x3(MT_Vector3(yaw, pitch, roll)));
-        }
+      // LocZ and dLocZ
+      if (m_ipo_channels_active[OB_LOC_Z]) {
+        newPosition[2] = (m_ipo_channels_active[OB_DLOC_Z] ?
+                              m_ipo_xform.GetPosition()[2] + m_ipo_xform.GetDeltaPosition()[2] :
+                              m_ipo_xform.GetPosition()[2]);
+      }
+      else if (m_ipo_channels_active[OB_DLOC_Z] && m_ipo_start_initialized) {
+        newPosition[2] = (((!m_ipo_add) ? m_ipo_start_point[2] : 0.0f) +
+                          m_ipo_xform.GetDeltaPosition()[2]);
       }
-      else if (m_ipo_start_initialized) {
-        // only DROT, treat as Add
+      if (m_ipo_add) {
+        if (m_ipo_local)
+          newPosition = m_ipo_start_point +
+                        m_ipo_start_scale * (m_ipo_start_orient * newPosition);
+        else
+          newPosition = m_ipo_start_point + newPosition;
+      }
+      if (m_game_object)
+        m_game_object->NodeSetLocalPosition(newPosition);
+    }
+  }
+  // modifies orientation?
+  if (m_ipo_channels_active[OB_ROT_X] || m_ipo_channels_active[OB_ROT_Y] ||
+      m_ipo_channels_active[OB_ROT_Z] || m_ipo_channels_active[OB_DROT_X] ||
+      m_ipo_channels_active[OB_DROT_Y] || m_ipo_channels_active[OB_DROT_Z]) {
+    if (m_ipo_as_force) {
+      if (m_game_object && ob) {
+        m_game_object->ApplyTorque(m_ipo_local ?
+                                       ob->GetWorldOrientation() * m_ipo_xform.GetEulerAngles() :
+                                       m_ipo_xform.GetEulerAngles(),
+                                   false);
+      }
+    }
+    else if (m_ipo_add) {
+      if (m_ipo_start_initialized) {
         double yaw = 0.0, pitch = 0.0, roll = 0.0;  // delta Euler angles
 
-        // dRotX
+        // RotX and dRotX
+        if (m_ipo_channels_active[OB_ROT_X])
+          yaw += m_ipo_xform.GetEulerAngles()[0];
         if (m_ipo_channels_active[OB_DROT_X])
-          yaw = m_ipo_xform.GetDeltaEulerAngles()[0];
+          yaw += m_ipo_xform.GetDeltaEulerAngles()[0];
 
-        // dRotY
+        // RotY dRotY
+        if (m_ipo_channels_active[OB_ROT_Y])
+          pitch += m_ipo_xform.GetEulerAngles()[1];
         if (m_ipo_channels_active[OB_DROT_Y])
-          pitch = m_ipo_xform.GetDeltaEulerAngles()[1];
+          pitch += m_ipo_xform.GetDeltaEulerAngles()[1];
 
-        // dRotZ
+        // RotZ and dRotZ
+        if (m_ipo_channels_active[OB_ROT_Z])
+          roll += m_ipo_xform.GetEulerAngles()[2];
         if (m_ipo_channels_active[OB_DROT_Z])
-          roll = m_ipo_xform.GetDeltaEulerAngles()[2];
+          roll += m_ipo_xform.GetDeltaEulerAngles()[2];
 
-        // dRot are always local
         MT_Matrix3x3 rotation(MT_Vector3(yaw, pitch, roll));
-        rotation = m_ipo_start_orient * rotation;
+        if (m_ipo_local)
+          rotation = m_ipo_start_orient * rotation;
+        else
+          rotation = rotation * m_ipo_start_orient;
         if (m_game_object)
           m_game_object->NodeSetLocalOrientation(rotation);
       }
     }
-    // modifies scale?
-    if (m_ipo_channels_active[OB_SIZE_X] || m_ipo_channels_active[OB_SIZE_Y] ||
-        m_ipo_channels_active[OB_SIZE_Z] || m_ipo_channels_active[OB_DSIZE_X] ||
-        m_ipo_channels_active[OB_DSIZE_Y] || m_ipo_channels_active[OB_DSIZE_Z]) {
-      // default is no scale change
-      MT_Vector3 newScale(1.0f, 1.0f, 1.0f);
-      if (!m_ipo_add)
-        newScale = ob->GetLocalScale();
+    else if (m_ipo_channels_active[OB_ROT_X] || m_ipo_channels_active[OB_ROT_Y] ||
+             m_ipo_channels_active[OB_ROT_Z]) {
+      if (m_ipo_euler_initialized) {
+        // assume all channel absolute
+        // All 3 channels should be specified but if they are not, we will take
+        // the value at the start of the game to avoid angle sign reversal
+        double yaw = m_ipo_start_euler[0], pitch = m_ipo_start_euler[1],
+               roll = m_ipo_start_euler[2];
+
+        // RotX and dRotX
+        if (m_ipo_channels_active[OB_ROT_X]) {
+          yaw = (m_ipo_channels_active[OB_DROT_X] ?
+                     (m_ipo_xform.GetEulerAngles()[0] + m_ipo_xform.GetDeltaEulerAngles()[0]) :
+                     m_ipo_xform.GetEulerAngles()[0]);
+        }
+        else if (m_ipo_channels_active[OB_DROT_X]) {
+          yaw += m_ipo_xform.GetDeltaEulerAngles()[0];
+        }
 
-      if (m_ipo_channels_active[OB_SIZE_X]) {
-        newScale[0] = (m_ipo_channels_active[OB_DSIZE_X] ?
-                           (m_ipo_xform.GetScaling()[0] + m_ipo_xform.GetDeltaScaling()[0]) :
-                           m_ipo_xform.GetScaling()[0]);
-      }
-      else if (m_ipo_channels_active[OB_DSIZE_X] && m_ipo_start_initialized) {
-        newScale[0] = (m_ipo_xform.GetDeltaScaling()[0] +
-                       ((!m_ipo_add) ? m_ipo_start_scale[0] : 0.0f));
-      }
+        // RotY dRotY
+        if (m_ipo_channels_active[OB_ROT_Y]) {
+          pitch = (m_ipo_channels_active[OB_DROT_Y] ?
+                       (m_ipo_xform.GetEulerAngles()[1] + m_ipo_xform.GetDeltaEulerAngles()[1]) :
+                       m_ipo_xform.GetEulerAngles()[1]);
+        }
+        else if (m_ipo_channels_active[OB_DROT_Y]) {
+          pitch += m_ipo_xform.GetDeltaEulerAngles()[1];
+        }
 
-      // RotY dRotY
-      if (m_ipo_channels_active[OB_SIZE_Y]) {
-        newScale[1] = (m_ipo_channels_active[OB_DSIZE_Y] ?
-                           (m_ipo_xform.GetScaling()[1] + m_ipo_xform.GetDeltaScaling()[1]) :
-                           m_ipo_xform.GetScaling()[1]);
-      }
-      else if (m_ipo_channels_active[OB_DSIZE_Y] && m_ipo_start_initialized) {
-        newScale[1] = (m_ipo_xform.GetDeltaScaling()[1] +
-                       ((!m_ipo_add) ? m_ipo_start_scale[1] : 0.0f));
+        // RotZ and dRotZ
+        if (m_ipo_channels_active[OB_ROT_Z]) {
+          roll = (m_ipo_channels_active[OB_DROT_Z] ?
+                      (m_ipo_xform.GetEulerAngles()[2] + m_ipo_xform.GetDeltaEulerAngles()[2]) :
+                      m_ipo_xform.GetEulerAngles()[2]);
+        }
+        else if (m_ipo_channels_active[OB_DROT_Z]) {
+          roll += m_ipo_xform.GetDeltaEulerAngles()[2];
+        }
+        if (m_game_object)
+          m_game_object->NodeSetLocalOrientation(MT_Matrix3x3(MT_Vector3(yaw, pitch, roll)));
       }
+    }
+    else if (m_ipo_start_initialized) {
+      // only DROT, treat as Add
+      double yaw = 0.0, pitch = 0.0, roll = 0.0;  // delta Euler angles
 
-      // RotZ and dRotZ
-      if (m_ipo_channels_active[OB_SIZE_Z]) {
-        newScale[2] = (m_ipo_channels_active[OB_DSIZE_Z] ?
-                           (m_ipo_xform.GetScaling()[2] + m_ipo_xform.GetDeltaScaling()[2]) :
-                           m_ipo_xform.GetScaling()[2]);
-      }
-      else if (m_ipo_channels_active[OB_DSIZE_Z] && m_ipo_start_initialized) {
-        newScale[2] = (m_ipo_xform.GetDeltaScaling()[2] +
-                       ((!m_ipo_add) ? m_ipo_start_scale[2] : 1.0f));
-      }
+      // dRotX
+      if (m_ipo_channels_active[OB_DROT_X])
+        yaw = m_ipo_xform.GetDeltaEulerAngles()[0];
 
-      if (m_ipo_add) {
-        newScale = m_ipo_start_scale * newScale;
-      }
+      // dRotY
+      if (m_ipo_channels_active[OB_DROT_Y])
+        pitch = m_ipo_xform.GetDeltaEulerAngles()[1];
+
+      // dRotZ
+      if (m_ipo_channels_active[OB_DROT_Z])
+        roll = m_ipo_xform.GetDeltaEulerAngles()[2];
+
+      // dRot are always local
+      MT_Matrix3x3 rotation(MT_Vector3(yaw, pitch, roll));
+      rotation = m_ipo_start_orient * rotation;
       if (m_game_object)
-        m_game_object->NodeSetLocalScale(newScale);
+        m_game_object->NodeSetLocalOrientation(rotation);
     }
-    m_modified = false;
   }
-  return false;
+  // modifies scale?
+  if (m_ipo_channels_active[OB_SIZE_X] || m_ipo_channels_active[OB_SIZE_Y] ||
+      m_ipo_channels_active[OB_SIZE_Z] || m_ipo_channels_active[OB_DSIZE_X] ||
+      m_ipo_channels_active[OB_DSIZE_Y] || m_ipo_channels_active[OB_DSIZE_Z]) {
+    // default is no scale change
+    MT_Vector3 newScale(1.0f, 1.0f, 1.0f);
+    if (!m_ipo_add)
+      newScale = ob->GetLocalScale();
+
+    if (m_ipo_channels_active[OB_SIZE_X]) {
+      newScale[0] = (m_ipo_channels_active[OB_DSIZE_X] ?
+                         (m_ipo_xform.GetScaling()[0] + m_ipo_xform.GetDeltaScaling()[0]) :
+                         m_ipo_xform.GetScaling()[0]);
+    }
+    else if (m_ipo_channels_active[OB_DSIZE_X] && m_ipo_start_initialized) {
+      newScale[0] = (m_ipo_xform.GetDeltaScaling()[0] +
+                     ((!m_ipo_add) ? m_ipo_start_scale[0] : 0.0f));
+    }
+
+    // RotY dRotY
+    if (m_ipo_channels_active[OB_SIZE_Y]) {
+      newScale[1] = (m_ipo_channels_active[OB_DSIZE_Y] ?
+                         (m_ipo_xform.GetScaling()[1] + m_ipo_xform.GetDeltaScaling()[1]) :
+                         m_ipo_xform.GetScaling()[1]);
+    }
+    else if (m_ipo_channels_active[OB_DSIZE_Y] && m_ipo_start_initialized) {
+      newScale[1] = (m_ipo_xform.GetDeltaScaling()[1] +
+                     ((!m_ipo_add) ? m_ipo_start_scale[1] : 0.0f));
+    }
+
+    // RotZ and dRotZ
+    if (m_ipo_channels_active[OB_SIZE_Z]) {
+      newScale[2] = (m_ipo_channels_active[OB_DSIZE_Z] ?
+                         (m_ipo_xform.GetScaling()[2] + m_ipo_xform.GetDeltaScaling()[2]) :
+                         m_ipo_xform.GetScaling()[2]);
+    }
+    else if (m_ipo_channels_active[OB_DSIZE_Z] && m_ipo_start_initialized) {
+      newScale[2] = (m_ipo_xform.GetDeltaScaling()[2] +
+                     ((!m_ipo_add) ? m_ipo_start_scale[2] : 1.0f));
+    }
+
+    if (m_ipo_add) {
+      newScale = m_ipo_start_scale * newScale;
+    }
+    if (m_game_object)
+      m_game_object->NodeSetLocalScale(newScale);
+  }
+  m_modified = false;
 }
 
 void KX_IpoSGController::AddInterpolator(KX_IInterpolator *interp)
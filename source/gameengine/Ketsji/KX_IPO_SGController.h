@@ -106,7 +106,26 @@ class KX_IpoSGController : public SG_Controller {
   }
 
   void AddInterpolator(KX_IInterpolator *interp);
+  const T_InterpolatorList &GetInterpolators() const
+  {
+    return m_interpolators;
+  }
+
+  bool IsModified() const
+  {
+    return m_modified;
+  }
+
+  double GetSimulatedTime() const
+  {
+    return m_ipotime;
+  }
+
   virtual bool Update(double time);
+  /** Apply the evaluated channels to the node, the interpolators must be executed before.
+   * Used by KX_IpoBatch which evaluates the interpolators of many controllers at once.
+   */
+  void ApplyTransform();
   virtual void SetSimulatedTime(double time)
   {
     m_ipotime = time;
@@ -0,0 +1,120 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file KX_IpoBatch.cpp
+ *  \ingroup ketsji
+ */
+
+#include "KX_IpoBatch.h"
+
+#include "BLI_task.h"
+#include "BLI_utildefines.h"
+
+#include "KX_IPO_SGController.h"
+#include "KX_IScalarInterpolator.h"
+#include "KX_ScalarInterpolator.h"
+
+/// Minimum number of channels to evaluate in parallel, the fcurves of a few objects are cheap.
+static const unsigned int parallelChannelsThreshold = 256;
+
+struct IpoBatchTaskData {
+  const KX_IScalarInterpolator *const *interpolators;
+  const float *times;
+  MT_Scalar *const *targets;
+};
+
+static void ipo_batch_evaluate_task(void *__restrict userdata,
+                                    const int i,
+                                    const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const IpoBatchTaskData *data = (IpoBatchTaskData *)userdata;
+  *data->targets[i] = data->interpolators[i]->GetValue(data->times[i]);
+}
+
+KX_IpoBatch::KX_IpoBatch() : m_open(false)
+{
+}
+
+KX_IpoBatch::~KX_IpoBatch()
+{
+}
+
+void KX_IpoBatch::Open()
+{
+  m_open = true;
+}
+
+bool KX_IpoBatch::IsOpen() const
+{
+  return m_open;
+}
+
+void KX_IpoBatch::Add(KX_IpoSGController *controller)
+{
+  if (!controller->IsModified()) {
+    return;
+  }
+
+  const float time = controller->GetSimulatedTime();
+  // The transform controllers only use scalar interpolators, see BL_CreateIPO.
+  for (KX_IInterpolator *interp : controller->GetInterpolators()) {
+    KX_ScalarInterpolator *scalarInterp = static_cast<KX_ScalarInterpolator *>(interp);
+    m_interpolators.push_back(scalarInterp->GetInterpolator());
+    m_times.push_back(time);
+    m_targets.push_back(scalarInterp->GetTarget());
+  }
+
+  m_controllers.push_back(controller);
+}
+
+void KX_IpoBatch::Flush()
+{
+  m_open = false;
+
+  if (m_controllers.empty()) {
+    return;
+  }
+
+  const unsigned int size = m_interpolators.size();
+  if (size >= parallelChannelsThreshold) {
+    /* Each channel writes its own target in the transform of its controller, the evaluation of
+     * the fcurves only reads the actions. */
+    IpoBatchTaskData data = {m_interpolators.data(), m_times.data(), m_targets.data()};
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.min_iter_per_thread = 64;
+    BLI_task_parallel_range(0, size, &data, ipo_batch_evaluate_task, &settings);
+  }
+  else {
+    for (unsigned int i = 0; i < size; ++i) {
+      *m_targets[i] = m_interpolators[i]->GetValue(m_times[i]);
+    }
+  }
+
+  // The nodes and physics controllers are modified serially.
+  for (KX_IpoSGController *controller : m_controllers) {
+    controller->ApplyTransform();
+  }
+
+  m_controllers.clear();
+  m_interpolators.clear();
+  m_times.clear();
+  m_targets.clear();
+}
@@ -0,0 +1,61 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file KX_IpoBatch.h
+ *  \ingroup ketsji
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "MT_Scalar.h"
+
+class KX_IpoSGController;
+class KX_IScalarInterpolator;
+
+/** Evaluation of the transform IPO controllers of the objects animated during an animation
+ * update. The channels of all the controllers are gathered in flat arrays and evaluated in one
+ * pass, in parallel when they are numerous, the transforms are then applied to the nodes in the
+ * order the controllers were added.
+ * Only the serial parts of the animation update add controllers, the batch is closed when the
+ * armatures are updated by the animation pool threads and open again for their controllers.
+ */
+class KX_IpoBatch {
+ private:
+  std::vector<KX_IpoSGController *> m_controllers;
+  std::vector<const KX_IScalarInterpolator *> m_interpolators;
+  std::vector<float> m_times;
+  std::vector<MT_Scalar *> m_targets;
+  bool m_open;
+
+ public:
+  KX_IpoBatch();
+  ~KX_IpoBatch();
+
+  /// Start gathering the controllers.
+  void Open();
+  /// Return true if the controllers can be added instead of being updated.
+  bool IsOpen() const;
+  /// Gather the channels of a controller, nothing is done if the controller isn't modified.
+  void Add(KX_IpoSGController *controller);
+  /// Evaluate the gathered channels, apply the transforms and close the batch.
+  void Flush();
+};
@@ -36,25 +36,43 @@
 
 #include "KX_KetsjiEngine.h"
 
+#include <algorithm>
 #include <boost/format.hpp>
 
 #include "DRW_render.h"
+#include "GPU_batch.h"
 #include "GPU_matrix.h"
+#include "MEM_guardedalloc.h"
 
 #include "BL_BlenderConverter.h"
 #include "BL_BlenderSceneConverter.h"
+#include "CM_Trace.h"
 #include "DEV_Joystick.h"  // for DEV_Joystick::HandleEvents
 #include "KX_Camera.h"
 #include "KX_Globals.h"
 #include "KX_NetworkMessageScene.h"
+#include "KX_NetworkTransport.h"
 #include "KX_PyConstraintBinding.h"
 #include "KX_PythonInit.h"  // for updatePythonJoysticks
+#include "KX_SoundManager.h"
+#include "KX_SoundStreamer.h"
+#include "KX_StateManager.h"
+#include "KX_VideoCapture.h"
+#include "KX_WorldStreamer.h"
 #include "PHY_IPhysicsEnvironment.h"
 #include "RAS_ICanvas.h"
 #include "SCA_IInputDevice.h"
+#include "SCA_LogicManager.h"
+
+#ifdef WITH_PYTHON
+#  include "ImageBase.h"
+#endif
 
 #define DEFAULT_LOGIC_TIC_RATE 60.0
 
+/// Number of frames the unused shared render targets are kept.
+static const int sharedTargetFrames = 60;
+
 #ifdef FREE_WINDOWS /* XXX mingw64 (gcc 4.7.0) defines a macro for DrawText that translates to \
                        DrawTextA. Not good */
 #  ifdef DrawText
@@ -64,11 +82,13 @@
 
 KX_KetsjiEngine::CameraRenderData::CameraRenderData(KX_Camera *rendercam,
                                                     KX_Camera *cullingcam,
+                                                    KX_Camera *sourcecam,
                                                     const RAS_Rect &area,
                                                     const RAS_Rect &viewport,
                                                     RAS_Rasterizer::StereoEye eye)
     : m_renderCamera(rendercam),
       m_cullingCamera(cullingcam),
+      m_sourceCamera(sourcecam),
       m_area(area),
       m_viewport(viewport),
       m_eye(eye)
@@ -80,8 +100,10 @@ KX_KetsjiEngine::CameraRenderData::CameraRenderData(const CameraRenderData &othe
 {
   m_renderCamera = CM_AddRef(other.m_renderCamera);
   m_cullingCamera = other.m_cullingCamera;
+  m_sourceCamera = other.m_sourceCamera;
   m_area = other.m_area;
   m_viewport = other.m_viewport;
+  m_eye = other.m_eye;
 }
 
 KX_KetsjiEngine::CameraRenderData::~CameraRenderData()
@@ -99,17 +121,18 @@ KX_KetsjiEngine::FrameRenderData::FrameRenderData(RAS_Rasterizer::FrameBufferTyp
 }
 
 const std::string KX_KetsjiEngine::m_profileLabels[tc_numCategories] = {
-    "Physics:",     // tc_physics
-    "Logic:",       // tc_logic
-    "Animations:",  // tc_animations
-    "Depsgraph:",   // tc_depsgraph
-    "Network:",     // tc_network
-    "Scenegraph:",  // tc_scenegraph
-    "Rasterizer:",  // tc_rasterizer
-    "Services:",    // tc_services
-    "Overhead:",    // tc_overhead
-    "Outside:",     // tc_outside
-    "GPU Latency:"  // tc_latency
+    "Physics:",      // tc_physics
+    "Soft Bodies:",  // tc_softbodies
+    "Logic:",        // tc_logic
+    "Animations:",   // tc_animations
+    "Depsgraph:",    // tc_depsgraph
+    "Network:",      // tc_network
+    "Scenegraph:",   // tc_scenegraph
+    "Rasterizer:",   // tc_rasterizer
+    "Services:",     // tc_services
+    "Overhead:",     // tc_overhead
+    "Outside:",      // tc_outside
+    "GPU Latency:"   // tc_latency
 };
 
 /**
@@ -137,8 +160,16 @@ KX_KetsjiEngine::KX_KetsjiEngine(KX_ISystem *system,
       m_maxLogicFrame(5),
       m_maxPhysicsFrame(5),
       m_ticrate(DEFAULT_LOGIC_TIC_RATE),
+      m_shaderCompileBudget(0.004),
+      m_lightBudget(0),
+      m_replicationRate(30.0f),
+      m_replicationRadius(0.0f),
       m_anim_framerate(25.0),
       m_doRender(true),
+      m_pendingSwap(false),
+      m_inputTime(0.0),
+      m_pendingSwapInputTime(0.0),
+      m_maxFramesInFlight(1),
       m_exitkey(130),
       m_exitcode(KX_ExitRequest::NO_REQUEST),
       m_exitstring(""),
@@ -146,13 +177,18 @@ KX_KetsjiEngine::KX_KetsjiEngine(KX_ISystem *system,
       m_overrideCamZoom(1.0f),
       m_logger(KX_TimeCategoryLogger(m_clock, 25)),
       m_average_framerate(0.0),
+      m_frameDriftLogger(25),
+      m_presentLatencyLogger(25),
+      m_frameStatistics(tc_numCategories),
+      m_hud(std::vector<std::string>(m_profileLabels, m_profileLabels + tc_numCategories)),
+      m_memoryReportTime(-1.0),
       m_showBoundingBox(KX_DebugOption::DISABLE),
       m_showArmature(KX_DebugOption::DISABLE),
       m_showCameraFrustum(KX_DebugOption::DISABLE),
       m_showShadowFrustum(KX_DebugOption::DISABLE)
 {
   for (int i = tc_first; i < tc_numCategories; i++) {
-    m_logger.AddCategory((KX_TimeCategory)i);
+    m_logger.AddCategory((KX_TimeCategory)i, m_profileLabels[i].c_str());
   }
 
 #ifdef WITH_PYTHON
@@ -160,7 +196,13 @@ KX_KetsjiEngine::KX_KetsjiEngine(KX_ISystem *system,
 #endif
 
   m_scenes = new EXP_ListValue<KX_Scene>();
+  m_preloadedScenes = new EXP_ListValue<KX_Scene>();
   m_renderingCameras = {};
+
+  m_soundManager = new KX_SoundManager();
+  m_soundStreamer = new KX_SoundStreamer();
+  m_stateManager = new KX_StateManager();
+  m_videoCapture = new KX_VideoCapture();
 }
 
 /**
@@ -173,6 +215,13 @@ KX_KetsjiEngine::~KX_KetsjiEngine()
 #endif
 
   m_scenes->Release();
+  m_preloadedScenes->Release();
+
+  delete m_soundManager;
+  // After the sound manager releasing the handles playing the streamed sounds.
+  delete m_soundStreamer;
+  delete m_stateManager;
+  delete m_videoCapture;
 }
 
 /* EEVEE integration */
@@ -240,8 +289,393 @@ PyObject *KX_KetsjiEngine::GetPyProfileDict()
   Py_INCREF(m_pyprofiledict);
   return m_pyprofiledict;
 }
+
+void KX_KetsjiEngine::UpdateScriptProfileDict()
+{
+  if (!(m_flags & PROFILE_SCRIPTS)) {
+    if (PyDict_GetItemString(m_pyprofiledict, "Scripts")) {
+      PyDict_DelItemString(m_pyprofiledict, "Scripts");
+    }
+    return;
+  }
+
+  PyObject *scripts = PyDict_New();
+  for (KX_Scene *scene : m_scenes) {
+    const std::string prefix = scene->GetName() + "/";
+    for (const auto &pair : scene->GetLogicManager()->GetScriptProfiler().GetEntries()) {
+      const SCA_ScriptProfiler::Entry &entry = pair.second;
+      PyObject *val = Py_BuildValue(
+          "(Idd)", entry.m_calls, entry.m_totalTime * 1000.0, entry.m_maxTime * 1000.0);
+      PyDict_SetItemString(scripts, (prefix + pair.first).c_str(), val);
+      Py_DECREF(val);
+    }
+  }
+
+  PyDict_SetItemString(m_pyprofiledict, "Scripts", scripts);
+  Py_DECREF(scripts);
+}
+
+PyObject *KX_KetsjiEngine::GetPyProfileStatistics()
+{
+  PyObject *dict = PyDict_New();
+  for (int i = tc_first; i <= tc_numCategories; ++i) {
+    const KX_FrameStatistics::Percentiles percentiles = m_frameStatistics.GetPercentiles(i);
+    PyObject *val = Py_BuildValue("(dddd)",
+                                  percentiles.m_p50 * 1000.0,
+                                  percentiles.m_p95 * 1000.0,
+                                  percentiles.m_p99 * 1000.0,
+                                  percentiles.m_max * 1000.0);
+    // The last entry is the total time of the frames.
+    PyDict_SetItemString(
+        dict, (i == tc_numCategories) ? "Frame:" : m_profileLabels[i].c_str(), val);
+    Py_DECREF(val);
+  }
+
+  return dict;
+}
+
+PyObject *KX_KetsjiEngine::GetPyObjectProfile(unsigned int count)
+{
+  const ObjectProfileList objects = GetCostlyObjects(count);
+  PyObject *list = PyList_New(objects.size());
+
+  for (unsigned int i = 0, size = objects.size(); i < size; ++i) {
+    const SCA_ObjectProfiler::Entry &entry = objects[i].second;
+
+    PyObject *categories = PyDict_New();
+    for (unsigned short j = 0; j < SCA_ObjectProfiler::CATEGORY_MAX; ++j) {
+      PyObject *val = PyFloat_FromDouble(entry.m_times[j] * 1000.0);
+      PyDict_SetItemString(
+          categories, SCA_ObjectProfiler::GetCategoryName((SCA_ObjectProfiler::Category)j), val);
+      Py_DECREF(val);
+    }
+
+    PyList_SET_ITEM(list,
+                    i,
+                    Py_BuildValue("(sdN)",
+                                  objects[i].first.c_str(),
+                                  entry.m_totalTime * 1000.0,
+                                  categories));
+  }
+
+  return list;
+}
+
+PyObject *KX_KetsjiEngine::GetPyHitches()
+{
+  const std::deque<KX_FrameStatistics::Hitch> &hitches = m_frameStatistics.GetHitches();
+  PyObject *list = PyList_New(hitches.size());
+
+  for (unsigned int i = 0, size = hitches.size(); i < size; ++i) {
+    const KX_FrameStatistics::Hitch &hitch = hitches[i];
+
+    PyObject *categories = PyDict_New();
+    for (int j = tc_first; j < tc_numCategories; ++j) {
+      PyObject *val = PyFloat_FromDouble(hitch.m_categories[j] * 1000.0);
+      PyDict_SetItemString(categories, m_profileLabels[j].c_str(), val);
+      Py_DECREF(val);
+    }
+
+    PyObject *events = PyList_New(hitch.m_events.size());
+    for (unsigned int j = 0, numEvents = hitch.m_events.size(); j < numEvents; ++j) {
+      const KX_FrameStatistics::Event &event = hitch.m_events[j];
+      PyList_SET_ITEM(
+          events, j, Py_BuildValue("(ssI)", event.m_type, event.m_name.c_str(), event.m_count));
+    }
+
+    PyObject *item = Py_BuildValue("{s:I,s:d,s:d,s:N,s:N,s:I}",
+                                   "frame",
+                                   hitch.m_frame,
+                                   "time",
+                                   hitch.m_time,
+                                   "duration",
+                                   hitch.m_duration * 1000.0,
+                                   "categories",
+                                   categories,
+                                   "events",
+                                   events,
+                                   "dropped_events",
+                                   hitch.m_droppedEvents);
+    PyList_SET_ITEM(list, i, item);
+  }
+
+  return list;
+}
 #endif
 
+KX_FrameStatistics &KX_KetsjiEngine::GetFrameStatistics()
+{
+  return m_frameStatistics;
+}
+
+KX_DepsgraphProfiler &KX_KetsjiEngine::GetDepsgraphProfiler()
+{
+  return m_depsgraphProfiler;
+}
+
+KX_PerformanceHud &KX_KetsjiEngine::GetPerformanceHud()
+{
+  return m_hud;
+}
+
+KX_TextureStreamer &KX_KetsjiEngine::GetTextureStreamer()
+{
+  return m_textureStreamer;
+}
+
+KX_CompressedTextures &KX_KetsjiEngine::GetCompressedTextures()
+{
+  return m_compressedTextures;
+}
+
+KX_ResolutionScaler &KX_KetsjiEngine::GetResolutionScaler()
+{
+  return m_resolutionScaler;
+}
+
+unsigned short KX_KetsjiEngine::GetNumProfileCategories()
+{
+  return tc_numCategories;
+}
+
+const std::string &KX_KetsjiEngine::GetProfileLabel(unsigned short category)
+{
+  return m_profileLabels[category];
+}
+
+double KX_KetsjiEngine::GetLastProfileTime(unsigned short category)
+{
+  return m_logger.GetLastMeasurement((KX_TimeCategory)category);
+}
+
+void KX_KetsjiEngine::UpdateFrameStatistics()
+{
+  std::vector<double> times(tc_numCategories);
+  for (int i = tc_first; i < tc_numCategories; ++i) {
+    times[i] = m_logger.GetLastMeasurement((KX_TimeCategory)i);
+  }
+
+  m_frameStatistics.AddFrame(times, m_frameTime);
+}
+
+void KX_KetsjiEngine::SetSharedRenderTargets(bool enable)
+{
+  DRW_game_shared_texture_pool_set(enable);
+}
+
+void KX_KetsjiEngine::UpdateDeferredShaders()
+{
+  // Changes of the setting are applied from the next frame, disabling compiles the queue.
+  const bool enable = (m_flags & DEFERRED_SHADERS);
+  if (enable != DRW_game_deferred_compilation_get()) {
+    DRW_game_deferred_compilation_set(enable);
+  }
+
+  if (enable) {
+    DRW_game_deferred_shaders_compile(m_shaderCompileBudget);
+  }
+}
+
+void KX_KetsjiEngine::CaptureVideoFrame()
+{
+  if (!m_videoCapture->IsCapturing()) {
+    return;
+  }
+
+  const RAS_Rect &area = m_canvas->GetViewportArea();
+  m_videoCapture->Capture(
+      area.GetLeft(), area.GetBottom(), area.GetWidth(), area.GetHeight(), m_frameTime);
+}
+
+void KX_KetsjiEngine::UpdateHud()
+{
+  // The counter includes the batches drawn since the last frame.
+  const unsigned int drawCalls = GPU_batch_draw_count_get();
+  GPU_batch_draw_count_reset();
+
+  if (!(m_flags & SHOW_HUD)) {
+    return;
+  }
+
+  KX_PerformanceHud::Frame frame = {0};
+  frame.m_drawCalls = drawCalls;
+
+  for (KX_Scene *scene : m_scenes) {
+    EXP_ListValue<KX_GameObject> *objects = scene->GetObjectList();
+    frame.m_objects += objects->GetCount();
+
+    if (m_hud.UseCounter(KX_PerformanceHud::COUNTER_LOGIC_BRICKS)) {
+      for (KX_GameObject *gameobj : *objects) {
+        frame.m_logicBricks += gameobj->GetSensors().size() + gameobj->GetControllers().size() +
+                               gameobj->GetActuators().size();
+      }
+    }
+
+    unsigned int numControllers;
+    unsigned int numContacts;
+    scene->GetPhysicsEnvironment()->GetStatistics(numControllers, numContacts);
+    frame.m_physicsBodies += numControllers;
+    frame.m_physicsContacts += numContacts;
+  }
+
+  frame.m_memory = MEM_get_memory_in_use();
+
+  std::vector<double> times(tc_numCategories);
+  for (int i = tc_first; i < tc_numCategories; ++i) {
+    times[i] = m_logger.GetLastMeasurement((KX_TimeCategory)i);
+  }
+
+  m_hud.AddFrame(times, frame);
+}
+
+KX_KetsjiEngine::ObjectProfileList KX_KetsjiEngine::GetCostlyObjects(unsigned int count)
+{
+  ObjectProfileList objects;
+  if (!(m_flags & PROFILE_OBJECTS)) {
+    return objects;
+  }
+
+  for (KX_Scene *scene : m_scenes) {
+    const std::string prefix = scene->GetName() + "/";
+    for (const auto &pair : scene->GetLogicManager()->GetObjectProfiler().GetEntries()) {
+      objects.emplace_back(prefix + pair.first, pair.second);
+    }
+  }
+
+  const unsigned int numObjects = std::min<size_t>(objects.size(), count);
+  std::partial_sort(objects.begin(),
+                    objects.begin() + numObjects,
+                    objects.end(),
+                    [](const std::pair<std::string, SCA_ObjectProfiler::Entry> &a,
+                       const std::pair<std::string, SCA_ObjectProfiler::Entry> &b) {
+                      return a.second.m_totalTime > b.second.m_totalTime;
+                    });
+  objects.resize(numObjects);
+
+  return objects;
+}
+
+void KX_KetsjiEngine::UpdateGpuTimers()
+{
+  m_rasterizer->ResolveGpuTimers();
+  m_resolutionScaler.Update(m_rasterizer->GetGpuTimes(), GetTicRate());
+  // Changes of the setting are applied from the next frame.
+  m_rasterizer->SetUseGpuTimers((m_flags & PROFILE_GPU) || m_resolutionScaler.GetEnabled());
+
+#ifdef WITH_PYTHON
+  if (!(m_flags & PROFILE_GPU)) {
+    if (PyDict_GetItemString(m_pyprofiledict, "GPU")) {
+      PyDict_DelItemString(m_pyprofiledict, "GPU");
+    }
+    return;
+  }
+
+  PyObject *gpu = PyDict_New();
+  for (const std::pair<std::string, double> &pair : m_rasterizer->GetGpuTimes()) {
+    PyObject *val = PyFloat_FromDouble(pair.second);
+    PyDict_SetItemString(gpu, pair.first.c_str(), val);
+    Py_DECREF(val);
+  }
+
+  PyDict_SetItemString(m_pyprofiledict, "GPU", gpu);
+  Py_DECREF(gpu);
+#endif
+}
+
+void KX_KetsjiEngine::UpdateDepsgraphProfile()
+{
+  m_depsgraphProfiler.NextFrame();
+  // Changes of the setting are applied from the next frame.
+  m_depsgraphProfiler.SetEnabled(m_flags & PROFILE_DEPSGRAPH);
+
+#ifdef WITH_PYTHON
+  if (!(m_flags & PROFILE_DEPSGRAPH)) {
+    if (PyDict_GetItemString(m_pyprofiledict, "Depsgraph")) {
+      PyDict_DelItemString(m_pyprofiledict, "Depsgraph");
+    }
+    return;
+  }
+
+  const KX_DepsgraphProfiler::Frame &frame = m_depsgraphProfiler.GetLastFrame();
+  PyObject *depsgraph = PyDict_New();
+  for (unsigned short i = 0; i < KX_DepsgraphProfiler::STAGE_MAX; ++i) {
+    PyObject *val = PyFloat_FromDouble(frame.m_times[i] * 1000.0);
+    PyDict_SetItemString(
+        depsgraph, KX_DepsgraphProfiler::GetStageName((KX_DepsgraphProfiler::Stage)i), val);
+    Py_DECREF(val);
+  }
+
+  const std::pair<const char *, unsigned int> counts[] = {
+      {"Tagged IDs", frame.m_taggedIds},
+      {"Evaluated IDs", frame.m_evaluatedIds},
+      {"Relations Rebuilds", frame.m_relationsRebuilds}};
+  for (const std::pair<const char *, unsigned int> &count : counts) {
+    PyObject *val = PyLong_FromUnsignedLong(count.second);
+    PyDict_SetItemString(depsgraph, count.first, val);
+    Py_DECREF(val);
+  }
+
+  PyDict_SetItemString(m_pyprofiledict, "Depsgraph", depsgraph);
+  Py_DECREF(depsgraph);
+#endif
+}
+
+void KX_KetsjiEngine::UpdateAllocationProfile()
+{
+  // Changes of the setting are applied from the next frame.
+  m_logger.SetCountAllocations(m_flags & PROFILE_ALLOCATIONS);
+
+#ifdef WITH_PYTHON
+  if (!(m_flags & PROFILE_ALLOCATIONS)) {
+    if (PyDict_GetItemString(m_pyprofiledict, "Allocations")) {
+      PyDict_DelItemString(m_pyprofiledict, "Allocations");
+    }
+    return;
+  }
+
+  PyObject *allocations = PyDict_New();
+  for (int i = tc_first; i < tc_numCategories; ++i) {
+    const KX_TimeCategoryLogger::AllocationCounters &counters = m_logger.GetLastAllocations(i);
+    PyObject *val = Py_BuildValue("(nnnn)",
+                                  (Py_ssize_t)counters.m_allocations,
+                                  (Py_ssize_t)counters.m_allocatedBytes,
+                                  (Py_ssize_t)counters.m_frees,
+                                  (Py_ssize_t)counters.m_freedBytes);
+    PyDict_SetItemString(allocations, m_profileLabels[i].c_str(), val);
+    Py_DECREF(val);
+  }
+
+  PyDict_SetItemString(m_pyprofiledict, "Allocations", allocations);
+  Py_DECREF(allocations);
+#endif
+}
+
+void KX_KetsjiEngine::PrintHitches()
+{
+  const std::deque<KX_FrameStatistics::Hitch> &hitches = m_frameStatistics.GetHitches();
+  if (hitches.empty()) {
+    return;
+  }
+
+  CM_Message("Last " << hitches.size() << " hitches above "
+                     << m_frameStatistics.GetHitchThreshold() * 1000.0 << " ms:");
+  for (const KX_FrameStatistics::Hitch &hitch : hitches) {
+    CM_Message("  frame " << hitch.m_frame << " at " << hitch.m_time << " s: "
+                          << hitch.m_duration * 1000.0 << " ms");
+    for (int i = tc_first; i < tc_numCategories; ++i) {
+      if (hitch.m_categories[i] > 0.0) {
+        CM_Message("    " << m_profileLabels[i] << " " << hitch.m_categories[i] * 1000.0 << " ms");
+      }
+    }
+    for (const KX_FrameStatistics::Event &event : hitch.m_events) {
+      CM_Message("    " << event.m_type << " '" << event.m_name << "' x" << event.m_count);
+    }
+    if (hitch.m_droppedEvents > 0) {
+      CM_Message("    " << hitch.m_droppedEvents << " more events");
+    }
+  }
+}
+
 void KX_KetsjiEngine::SetConverter(BL_BlenderConverter *converter)
 {
   BLI_assert(converter);
@@ -258,6 +692,8 @@ void KX_KetsjiEngine::StartEngine()
 
 void KX_KetsjiEngine::BeginFrame()
 {
+  SwapPendingBuffers();
+
   m_rasterizer->BeginFrame(m_frameTime);
 
   m_canvas->BeginDraw();
@@ -275,7 +711,8 @@ void KX_KetsjiEngine::EndFrame()
 
   // Show profiling info
   m_logger.StartLog(tc_overhead);
-  if (m_flags & (SHOW_PROFILE | SHOW_FRAMERATE | SHOW_DEBUG_PROPERTIES)) {
+  if (m_flags & (SHOW_PROFILE | SHOW_FRAMERATE | SHOW_DEBUG_PROPERTIES | SHOW_MEMORY |
+                 SHOW_HUD)) {
     RenderDebugProperties();
   }
 
@@ -295,32 +732,81 @@ void KX_KetsjiEngine::EndFrame()
     PyDict_SetItemString(m_pyprofiledict, m_profileLabels[i].c_str(), val);
     Py_DECREF(val);
   }
+
+  UpdateScriptProfileDict();
 #endif
 
   m_average_framerate = 1.0 / tottime;
 
   // Go to next profiling measurement, time spent after this call is shown in the next frame.
   m_logger.NextMeasurement();
+  UpdateFrameStatistics();
+  UpdateGpuTimers();
+  UpdateDepsgraphProfile();
+  UpdateAllocationProfile();
+  UpdateHud();
 
   m_logger.StartLog(tc_rasterizer);
   m_rasterizer->EndFrame();
 
   m_logger.StartLog(tc_logic);
   m_canvas->FlushScreenshots();
+  CaptureVideoFrame();
+
+  if (m_flags & DEFERRED_SWAP) {
+    /* Only submit the commands, the GPU executes them while the logic of the next
+     * frame is running and the buffers are swapped just before the next render. */
+    GPU_flush();
+    m_pendingSwap = true;
+    m_pendingSwapInputTime = m_inputTime;
+  }
+  else {
+    PresentFrame(m_inputTime);
+  }
+
+  m_canvas->EndDraw();
+}
+
+void KX_KetsjiEngine::SwapPendingBuffers()
+{
+  if (!m_pendingSwap) {
+    return;
+  }
+
+  m_pendingSwap = false;
+  PresentFrame(m_pendingSwapInputTime);
+}
 
+void KX_KetsjiEngine::PresentFrame(double inputTime)
+{
   // swap backbuffer (drawing into this buffer) <-> front/visible buffer
   m_logger.StartLog(tc_latency);
   m_canvas->SwapBuffers();
-  m_logger.StartLog(tc_rasterizer);
 
-  m_canvas->EndDraw();
+  if (m_flags & (LOW_LATENCY | SHOW_PROFILE)) {
+    m_canvas->AddFrameFence(inputTime);
+  }
+
+  /* Wait here rather than before the next swap, the events are then polled and the inputs of
+   * the next frame sampled once the GPU caught up. */
+  const unsigned short maxFrames = (m_flags & LOW_LATENCY) ? m_maxFramesInFlight : 0;
+  double finishedInputTime;
+  if (m_canvas->WaitFrameFences(maxFrames, finishedInputTime)) {
+    const double now = m_clock.GetTimeSecond();
+    m_presentLatencyLogger.NextMeasurement(now);
+    m_presentLatencyLogger.StartLog(finishedInputTime);
+    m_presentLatencyLogger.EndLog(now);
+  }
+
+  m_logger.StartLog(tc_rasterizer);
 }
 
 void KX_KetsjiEngine::EndFrameViewportRender()
 {
   // Show profiling info
   m_logger.StartLog(tc_overhead);
-  if (m_flags & (SHOW_PROFILE | SHOW_FRAMERATE | SHOW_DEBUG_PROPERTIES)) {
+  if (m_flags & (SHOW_PROFILE | SHOW_FRAMERATE | SHOW_DEBUG_PROPERTIES | SHOW_MEMORY |
+                 SHOW_HUD)) {
     RenderDebugProperties();
   }
 
@@ -340,18 +826,26 @@ void KX_KetsjiEngine::EndFrameViewportRender()
     PyDict_SetItemString(m_pyprofiledict, m_profileLabels[i].c_str(), val);
     Py_DECREF(val);
   }
+
+  UpdateScriptProfileDict();
 #endif
 
   m_average_framerate = 1.0 / tottime;
 
   // Go to next profiling measurement, time spent after this call is shown in the next frame.
   m_logger.NextMeasurement();
+  UpdateFrameStatistics();
+  UpdateGpuTimers();
+  UpdateDepsgraphProfile();
+  UpdateAllocationProfile();
+  UpdateHud();
 
   m_logger.StartLog(tc_rasterizer);
   // m_rasterizer->EndFrame();
 
   m_logger.StartLog(tc_logic);
   m_canvas->FlushScreenshots();
+  CaptureVideoFrame();
 
   // swap backbuffer (drawing into this buffer) <-> front/visible buffer
   m_logger.StartLog(tc_latency);
@@ -382,8 +876,19 @@ KX_KetsjiEngine::FrameTimes KX_KetsjiEngine::GetFrameTimes()
    *   - fixed_framerate
    */
 
+  /* The fixed frames are proceeded at the tic rate and all the frames in between render
+   * the physics interpolated. */
+  const bool interpolate = (m_flags & (FIXED_FRAMERATE | PHYSICS_INTERPOLATION)) ==
+                           (FIXED_FRAMERATE | PHYSICS_INTERPOLATION);
+
   // Update time if the user is not controlling it.
   if (!(m_flags & USE_EXTERNAL_CLOCK)) {
+    /* In case of fixed framerate, sleep until the next frame. The last 1ms
+     * (sleep resolution) is busy wait. */
+    if (!interpolate &&
+        (m_flags & (FIXED_FRAMERATE | FRAME_PACING)) == (FIXED_FRAMERATE | FRAME_PACING)) {
+      m_clock.WaitUntil(m_previousRealTime + 1.0 / m_ticrate, 1.0e-3);
+    }
     m_clockTime = m_clock.GetTimeSecond();
   }
 
@@ -413,29 +918,35 @@ KX_KetsjiEngine::FrameTimes KX_KetsjiEngine::GetFrameTimes()
   }
 
   // Fix timestep to not exceed max physics and logic frames.
+  bool skipFrames = false;
   if (frames > m_maxPhysicsFrame) {
     timestep = dt / m_maxPhysicsFrame;
     frames = m_maxPhysicsFrame;
+    skipFrames = true;
   }
   if (frames > m_maxLogicFrame) {
     timestep = dt / m_maxLogicFrame;
     frames = m_maxLogicFrame;
+    skipFrames = true;
   }
 
   // If the number of frame is non-zero, update previous time.
   if (frames > 0) {
-    m_previousRealTime = m_clockTime;
-  }
-  //// Else in case of fixed framerate, try to sleep until the next frame.
-  // else if (m_flags & FIXED_FRAMERATE) {
-  //  const double sleeptime = timestep - dt - 1.0e-3;
-  //  /* If the remaining time is greather than 1ms (sleep resolution) sleep this thread.
-  //   * The other 1ms will be busy wait.
-  //   */
-  //  if (sleeptime > 0.0) {
-  //    std::this_thread::sleep_for(std::chrono::nanoseconds((long)(sleeptime * 1.0e9)));
-  //  }
-  //}
+    // Log how late the frame started compared to its expected time.
+    if (m_flags & FIXED_FRAMERATE) {
+      m_frameDriftLogger.NextMeasurement(m_clockTime);
+      m_frameDriftLogger.StartLog(m_previousRealTime + 1.0 / m_ticrate);
+      m_frameDriftLogger.EndLog(m_clockTime);
+    }
+    /* Keep the time remaining after the last frame for the interpolation, unless
+     * frames were skipped. */
+    if (interpolate && !skipFrames) {
+      m_previousRealTime += frames / m_ticrate;
+    }
+    else {
+      m_previousRealTime = m_clockTime;
+    }
+  }
 
   // Frame time with time scale.
   const double framestep = timestep * m_timescale;
@@ -444,51 +955,78 @@ KX_KetsjiEngine::FrameTimes KX_KetsjiEngine::GetFrameTimes()
   times.frames = frames;
   times.timestep = timestep;
   times.framestep = framestep;
+  times.interpolation = interpolate ?
+                            std::min(std::max((m_clockTime - m_previousRealTime) * m_ticrate, 0.0),
+                                     1.0) :
+                            1.0;
 
   return times;
 }
 
 bool KX_KetsjiEngine::NextFrame()
 {
+  CM_TraceScope traceScope("Next Frame");
+
   m_logger.StartLog(tc_services);
 
   const FrameTimes times = GetFrameTimes();
+  const bool interpolate = (m_flags & (FIXED_FRAMERATE | PHYSICS_INTERPOLATION)) ==
+                           (FIXED_FRAMERATE | PHYSICS_INTERPOLATION);
 
-  // Exit if zero frame is sheduled.
-  if (times.frames == 0) {
+  // Exit if zero frame is sheduled, the interpolated physics are rendered at each call.
+  if (times.frames == 0 && !interpolate) {
     // Start logging time spent outside main loop
     m_logger.StartLog(tc_outside);
 
     return false;
   }
 
+  // Convert the inputs received until now, after the wait of the frame time.
+  m_inputTime = m_clock.GetTimeSecond();
+  m_inputDevice->ProcessEvents(m_inputTime);
+
+  // The logic uses the transforms of the last physics step.
+  if (interpolate && times.frames > 0) {
+    for (KX_Scene *scene : m_scenes) {
+      m_logger.StartLog(tc_physics);
+      scene->GetPhysicsEnvironment()->InterpolateMotionStates(1.0f);
+      m_logger.StartLog(tc_scenegraph);
+      scene->UpdateParents(m_frameTime);
+    }
+  }
+
   for (unsigned short i = 0; i < times.frames; ++i) {
     m_frameTime += times.framestep;
 
-    m_converter->MergeAsyncLoads();
+    // Start the loads of the world cells near the cameras before merging the finished ones.
+    for (KX_Scene *scene : m_scenes) {
+      scene->GetWorldStreamer()->Update();
+    }
+
+    m_converter->MergeAsyncLoads(true);
+    m_converter->ProcessAsyncConversions();
 
     m_inputDevice->ReleaseMoveEvent();
 
 #ifdef WITH_SDL
-    // Handle all SDL Joystick events here to share them for all scenes properly.
+    /* Take the Joystick states polled in the background here to share them for all scenes
+     * properly, the force feedback duration is processed by the polling thread. */
     short addrem[JOYINDEX_MAX] = {0};
     if (DEV_Joystick::HandleEvents(addrem)) {
 #  ifdef WITH_PYTHON
       updatePythonJoysticks(addrem);
 #  endif  // WITH_PYTHON
     }
-
-    // Process Joystick force feedback duration
-    for (unsigned short j = 0; j < JOYINDEX_MAX; ++j) {
-      DEV_Joystick *joy = DEV_Joystick::GetInstance(j);
-      if (joy && joy->Connected() && joy->GetRumbleSupport() && joy->GetRumbleStatus()) {
-        joy->ProcessRumbleStatus();
-      }
-    }
 #endif  // WITH_SDL
 
+    /* Step the physics of the scenes in parallel only when multiple scenes are running,
+     * the logic is always processed on this thread as it could call python. */
+    const bool parallelStep = (m_flags & PARALLEL_SCENE_STEP) && (m_scenes->GetCount() > 1);
+
     // for each scene, call the proceed functions
     for (KX_Scene *scene : m_scenes) {
+      CM_TraceScope sceneTraceScope("Scene Frame", scene->GetName());
+
       /* Suspension holds the physics and logic processing for an
        * entire scene. Objects can be suspended individually, and
        * the settings for that precede the logic and physics
@@ -527,26 +1065,76 @@ bool KX_KetsjiEngine::NextFrame()
       m_logger.StartLog(tc_scenegraph);
       scene->UpdateParents(m_frameTime);
 
+      // The physics of all scenes are proceeded together after the logic.
+      if (parallelStep) {
+        m_logger.StartLog(tc_services);
+        continue;
+      }
+
       m_logger.StartLog(tc_physics);
 
       // Perform physics calculations on the scene. This can involve
       // many iterations of the physics solver.
-      scene->GetPhysicsEnvironment()->ProceedDeltaTime(
-          m_frameTime, times.timestep, times.framestep);  // m_deltatimerealDeltaTime);
+      {
+        CM_TraceScope physicsTraceScope("Physics Step");
+        scene->GetPhysicsEnvironment()->ProceedDeltaTime(
+            m_frameTime, times.timestep, times.framestep);  // m_deltatimerealDeltaTime);
+      }
 
       /* No need to call sofbody update more than 1 time */
       if (i == times.frames - 1) {
+        m_logger.StartLog(tc_softbodies);
         scene->GetPhysicsEnvironment()->UpdateSoftBodies();
       }
 
       m_logger.StartLog(tc_scenegraph);
       scene->UpdateParents(m_frameTime);
 
+      // Python and physics are idle, run the tasks submitted by the logic.
+      m_logger.StartLog(tc_logic);
+      scene->RunTasks();
+
+      m_logger.StartLog(tc_services);
+    }
+
+    if (parallelStep) {
+      m_logger.StartLog(tc_physics);
+      ProceedScenesPhysicsParallel(times);
+
+      // Measured apart from the physics steps, the soft bodies update is parallel itself.
+      if (i == times.frames - 1) {
+        m_logger.StartLog(tc_softbodies);
+        for (KX_Scene *scene : m_scenes) {
+          scene->GetPhysicsEnvironment()->UpdateSoftBodies();
+        }
+      }
+
+      // The motion states modified the scene graph of each scene.
+      m_logger.StartLog(tc_scenegraph);
+      for (KX_Scene *scene : m_scenes) {
+        scene->UpdateParents(m_frameTime);
+      }
+
+      m_logger.StartLog(tc_logic);
+      for (KX_Scene *scene : m_scenes) {
+        scene->RunTasks();
+      }
+
       m_logger.StartLog(tc_services);
     }
 
     m_logger.StartLog(tc_network);
+    KX_NetworkTransport *transport = m_networkMessageManager->GetTransport();
+    if (transport) {
+      transport->Poll();
+    }
+    m_networkMessageManager->UpdateTransport();
     m_networkMessageManager->ClearMessages();
+    if (transport) {
+      for (KX_Scene *scene : m_scenes) {
+        scene->UpdateReplication(transport, m_frameTime, m_replicationRate, m_replicationRadius);
+      }
+    }
 
     // update system devices
     m_logger.StartLog(tc_logic);
@@ -556,12 +1144,46 @@ bool KX_KetsjiEngine::NextFrame()
     ProcessScheduledScenes();
   }
 
+  if (interpolate) {
+    for (KX_Scene *scene : m_scenes) {
+      m_logger.StartLog(tc_physics);
+      scene->GetPhysicsEnvironment()->InterpolateMotionStates(times.interpolation);
+      m_logger.StartLog(tc_scenegraph);
+      scene->UpdateParents(m_frameTime);
+    }
+  }
+
+  // Update the sound sources with the final transforms of the frame.
+  m_logger.StartLog(tc_services);
+  m_soundManager->Update();
+
+  // The previous frame must be shown even if this one is not rendered.
+  if (!m_doRender) {
+    SwapPendingBuffers();
+  }
+
   // Start logging time spent outside main loop
   m_logger.StartLog(tc_outside);
 
   return m_doRender;
 }
 
+void KX_KetsjiEngine::ProceedScenesPhysicsParallel(const FrameTimes &times)
+{
+  const double curTime = m_frameTime;
+  m_physicsJobs.Clear();
+  for (KX_Scene *scene : m_scenes) {
+    PHY_IPhysicsEnvironment *physEnv = scene->GetPhysicsEnvironment();
+    m_physicsJobs.AddJob([physEnv, curTime, times]() {
+      CM_TraceScope traceScope("Physics Step");
+      physEnv->ProceedDeltaTime(curTime, times.timestep, times.framestep);
+    });
+  }
+
+  // Join before any scene management or rendering.
+  m_physicsJobs.Run();
+}
+
 KX_KetsjiEngine::CameraRenderData KX_KetsjiEngine::GetCameraRenderData(
     KX_Scene *scene,
     KX_Camera *camera,
@@ -612,7 +1234,7 @@ KX_KetsjiEngine::CameraRenderData KX_KetsjiEngine::GetCameraRenderData(
   rendercam->SetModelviewMatrix(viewmat);
   rendercam->SetProjectionMatrix(projmat);
 
-  CameraRenderData cameraData(rendercam, cullingcam, area, viewport, eye);
+  CameraRenderData cameraData(rendercam, cullingcam, camera, area, viewport, eye);
 
   if (usestereo) {
     rendercam->Release();
@@ -745,10 +1367,14 @@ bool KX_KetsjiEngine::GetFrameRenderData(std::vector<FrameRenderData> &frameData
 
 void KX_KetsjiEngine::Render()
 {
+  CM_TraceScope traceScope("Render");
+
   m_logger.StartLog(tc_rasterizer);
 
   BeginFrame();
 
+  UpdateDeferredShaders();
+
   std::vector<FrameRenderData> frameDataList;
   GetFrameRenderData(frameDataList);
 
@@ -779,14 +1405,31 @@ void KX_KetsjiEngine::Render()
 
       m_rasterizer->SetAuxilaryClientInfo(scene);
 
-      // Draw the scene once for each camera with an enabled viewport or an active camera.
-      for (const CameraRenderData &cameraFrameData : sceneFrameData.m_cameraDataList) {
+      /* Draw the scene once for each camera with an enabled viewport or an active camera, the
+       * following views sharing the draw caches of a camera are drawn with it. */
+      const std::vector<CameraRenderData> &cameraDataList = sceneFrameData.m_cameraDataList;
+      std::vector<const CameraRenderData *> views;
+      for (unsigned short j = 0, size = cameraDataList.size(); j < size; ++j) {
+        views.push_back(&cameraDataList[j]);
+        if (j + 1 < size && UseSharedRender(scene, cameraDataList[j], cameraDataList[j + 1])) {
+          continue;
+        }
         // do the rendering
-        RenderCamera(scene, cameraFrameData, pass++);
+        RenderCamera(scene, views, pass++);
+        views.clear();
       }
     }
   }
 
+  /* Free the shared render targets unused for a while, the delay keeps the targets of the
+   * cameras rendered at a lower rate than the frames, e.g. the image renders. */
+  DRW_game_shared_texture_pool_free_unused(sharedTargetFrames);
+
+  // Change the texture levels requested by the cameras for the next frames.
+  if (m_textureStreamer.GetEnabled()) {
+    m_textureStreamer.Update();
+  }
+
   if (!UseViewportRender()) {
     int v[4];
     v[0] = m_canvas->GetViewportArea().GetLeft();
@@ -1009,15 +1652,41 @@ MT_Matrix4x4 KX_KetsjiEngine::GetCameraProjectionMatrix(KX_Scene *scene,
 }
 
 // update graphics
+bool KX_KetsjiEngine::UseSharedRender(KX_Scene *scene,
+                                      const CameraRenderData &previous,
+                                      const CameraRenderData &view) const
+{
+  if (!(m_flags & MULTI_VIEW) || m_useViewportRender) {
+    return false;
+  }
+
+  KX_Camera *overlaycam = scene->GetOverlayCamera();
+  if (previous.m_sourceCamera == overlaycam || view.m_sourceCamera == overlaycam) {
+    return false;
+  }
+
+  // The views are drawn into textures of the same size and blended the same way.
+  KX_Camera *activecam = scene->GetActiveCamera();
+  const bool previousBlend = (previous.m_sourceCamera != activecam &&
+                              previous.m_sourceCamera->GetViewport());
+  const bool viewBlend = (view.m_sourceCamera != activecam && view.m_sourceCamera->GetViewport());
+  return (previous.m_viewport.GetWidth() == view.m_viewport.GetWidth() &&
+          previous.m_viewport.GetHeight() == view.m_viewport.GetHeight() &&
+          previousBlend == viewBlend);
+}
+
 void KX_KetsjiEngine::RenderCamera(KX_Scene *scene,
-                                   const CameraRenderData &cameraFrameData,
+                                   const std::vector<const CameraRenderData *> &views,
                                    unsigned short pass)
 {
+  const CameraRenderData &cameraFrameData = *views.front();
   KX_Camera *rendercam = cameraFrameData.m_renderCamera;
   // KX_Camera *cullingcam = cameraFrameData.m_cullingCamera;
   // const RAS_Rect &area = cameraFrameData.m_area;
   const RAS_Rect &viewport = cameraFrameData.m_viewport;
 
+  CM_TraceScope traceScope("Render Camera", scene->GetName());
+
   KX_SetActiveScene(scene);
 
   /* Clear the depth after setting the scene viewport/scissor
@@ -1039,7 +1708,9 @@ void KX_KetsjiEngine::RenderCamera(KX_Scene *scene,
 #ifdef WITH_PYTHON
   PHY_SetActiveEnvironment(scene->GetPhysicsEnvironment());
   // Run any pre-drawing python callbacks
-  scene->RunDrawingCallbacks(KX_Scene::PRE_DRAW, rendercam);
+  for (const CameraRenderData *view : views) {
+    scene->RunDrawingCallbacks(KX_Scene::PRE_DRAW, view->m_renderCamera);
+  }
 #endif
 
   if (scene->GetInitMaterialsGPUViewport()) {
@@ -1052,9 +1723,24 @@ void KX_KetsjiEngine::RenderCamera(KX_Scene *scene,
     m_rasterizer->SetBlendFunc(RAS_Rasterizer::RAS_ONE, RAS_Rasterizer::RAS_ONE_MINUS_SRC_ALPHA);
   }
 
-  bool is_last_render_pass = rendercam == m_renderingCameras.back();
-
-  scene->RenderAfterCameraSetup(rendercam, viewport, is_overlay_pass, is_last_render_pass);
+  if (views.size() == 1) {
+    bool is_last_render_pass = rendercam == m_renderingCameras.back();
+    scene->RenderAfterCameraSetup(rendercam, viewport, is_overlay_pass, is_last_render_pass, {});
+  }
+  else {
+    /* The views are drawn from the GPU viewport of the first scene camera, a stereo camera
+     * doesn't need a viewport per eye. */
+    std::vector<KX_Scene::RenderView> sceneViews;
+    for (const CameraRenderData *view : views) {
+      sceneViews.push_back({view->m_renderCamera, view->m_viewport});
+    }
+    bool is_last_render_pass = views.back()->m_sourceCamera == m_renderingCameras.back();
+    scene->RenderAfterCameraSetup(cameraFrameData.m_sourceCamera,
+                                  viewport,
+                                  is_overlay_pass,
+                                  is_last_render_pass,
+                                  sceneViews);
+  }
 
   if (scene->GetPhysicsEnvironment()) {
     scene->GetPhysicsEnvironment()->DebugDrawWorld();
@@ -1098,8 +1784,18 @@ RAS_FrameBuffer *KX_KetsjiEngine::PostRenderScene(KX_Scene *scene,
 void KX_KetsjiEngine::StopEngine()
 {
   if (m_bInitialized) {
+    SwapPendingBuffers();
+
+    // The capture uses the settings of the scenes and the GPU context.
+    m_videoCapture->Stop();
+
+    PrintHitches();
+
     m_converter->FinalizeAsyncLoads();
 
+    // Don't leave materials queued for the viewport.
+    DRW_game_deferred_compilation_set(false);
+
     while (m_scenes->GetCount() > 0) {
       KX_Scene *scene = m_scenes->GetFront();
       m_converter->RemoveScene(scene);
@@ -1107,8 +1803,18 @@ void KX_KetsjiEngine::StopEngine()
       m_scenes->Remove(0);
     }
 
+    m_preloadingScenes.clear();
+    while (m_preloadedScenes->GetCount() > 0) {
+      RemovePreloadedScene(m_preloadedScenes->GetFront());
+    }
+
+    // All the viewports using the shared render targets were freed with the scenes.
+    DRW_game_shared_texture_pool_set(false);
+
     // cleanup all the stuff
-    m_rasterizer->Exit();
+    if (!(m_flags & HEADLESS)) {
+      m_rasterizer->Exit();
+    }
   }
 }
 
@@ -1216,10 +1922,26 @@ void KX_KetsjiEngine::RenderDebugProperties()
         debugtxt, MT_Vector2(xcoord + const_xindent + profile_indent, ycoord), white);
     // Increase the indent by default increase
     ycoord += const_ysize;
+
+    if (m_flags & FIXED_FRAMERATE) {
+      debugDraw.RenderText2D("Drift :", MT_Vector2(xcoord + const_xindent, ycoord), white);
+
+      debugtxt = (boost::format("%5.2fms") % (m_frameDriftLogger.GetAverage() * 1000.0)).str();
+      debugDraw.RenderText2D(
+          debugtxt, MT_Vector2(xcoord + const_xindent + profile_indent, ycoord), white);
+      ycoord += const_ysize;
+    }
   }
 
   // Profile display
   if (m_flags & SHOW_PROFILE) {
+    debugDraw.RenderText2D("Input Latency :", MT_Vector2(xcoord + const_xindent, ycoord), white);
+
+    debugtxt = (boost::format("%5.2fms") % (m_presentLatencyLogger.GetAverage() * 1000.0)).str();
+    debugDraw.RenderText2D(
+        debugtxt, MT_Vector2(xcoord + const_xindent + profile_indent, ycoord), white);
+    ycoord += const_ysize;
+
     for (int j = tc_first; j < tc_numCategories; j++) {
       debugDraw.RenderText2D(
           m_profileLabels[j], MT_Vector2(xcoord + const_xindent, ycoord), white);
@@ -1237,10 +1959,139 @@ void KX_KetsjiEngine::RenderDebugProperties()
           MT_Vector2(xcoord + (int)(2.2 * profile_indent), ycoord), boxSize, white);
       ycoord += const_ysize;
     }
+
+    // The scripts taking the most time since the profiling was enabled.
+    if (m_flags & PROFILE_SCRIPTS) {
+      std::vector<std::pair<std::string, SCA_ScriptProfiler::Entry>> scripts;
+      for (KX_Scene *scene : m_scenes) {
+        for (const auto &pair : scene->GetLogicManager()->GetScriptProfiler().GetEntries()) {
+          scripts.push_back(pair);
+        }
+      }
+
+      const unsigned short numScripts = std::min<size_t>(scripts.size(), 8);
+      std::partial_sort(scripts.begin(),
+                        scripts.begin() + numScripts,
+                        scripts.end(),
+                        [](const std::pair<std::string, SCA_ScriptProfiler::Entry> &a,
+                           const std::pair<std::string, SCA_ScriptProfiler::Entry> &b) {
+                          return a.second.m_totalTime > b.second.m_totalTime;
+                        });
+
+      for (unsigned short i = 0; i < numScripts; ++i) {
+        const SCA_ScriptProfiler::Entry &entry = scripts[i].second;
+        debugDraw.RenderText2D(scripts[i].first, MT_Vector2(xcoord + const_xindent, ycoord), white);
+
+        debugtxt = (boost::format("%5.2fms | max %5.2fms") %
+                    (entry.m_totalTime / entry.m_calls * 1000.0) % (entry.m_maxTime * 1000.0))
+                       .str();
+        debugDraw.RenderText2D(
+            debugtxt, MT_Vector2(xcoord + const_xindent + 2 * profile_indent, ycoord), white);
+        ycoord += const_ysize;
+      }
+    }
+
+    // The objects taking the most time since the profiling was enabled.
+    if (m_flags & PROFILE_OBJECTS) {
+      for (const auto &pair : GetCostlyObjects(8)) {
+        const SCA_ObjectProfiler::Entry &entry = pair.second;
+        debugDraw.RenderText2D(pair.first, MT_Vector2(xcoord + const_xindent, ycoord), white);
+
+        // Show the category taking the most time of the object.
+        const unsigned short maxCategory = std::max_element(entry.m_times,
+                                                            entry.m_times +
+                                                                SCA_ObjectProfiler::CATEGORY_MAX) -
+                                           entry.m_times;
+        debugtxt = (boost::format("%5.2fms | %s") % (entry.m_totalTime * 1000.0) %
+                    SCA_ObjectProfiler::GetCategoryName(
+                        (SCA_ObjectProfiler::Category)maxCategory))
+                       .str();
+        debugDraw.RenderText2D(
+            debugtxt, MT_Vector2(xcoord + const_xindent + 2 * profile_indent, ycoord), white);
+        ycoord += const_ysize;
+      }
+    }
+
+    // The stages of the depsgraph update of the last frame.
+    if (m_flags & PROFILE_DEPSGRAPH) {
+      const KX_DepsgraphProfiler::Frame &frame = m_depsgraphProfiler.GetLastFrame();
+      for (unsigned short i = 0; i < KX_DepsgraphProfiler::STAGE_MAX; ++i) {
+        debugDraw.RenderText2D(
+            KX_DepsgraphProfiler::GetStageName((KX_DepsgraphProfiler::Stage)i),
+            MT_Vector2(xcoord + const_xindent, ycoord),
+            white);
+
+        debugtxt = (boost::format("%5.2fms") % (frame.m_times[i] * 1000.0)).str();
+        debugDraw.RenderText2D(
+            debugtxt, MT_Vector2(xcoord + const_xindent + 2 * profile_indent, ycoord), white);
+        ycoord += const_ysize;
+      }
+
+      debugtxt = (boost::format("IDs: %d tagged | %d evaluated | %d rebuilds") %
+                  frame.m_taggedIds % frame.m_evaluatedIds % frame.m_relationsRebuilds)
+                     .str();
+      debugDraw.RenderText2D(debugtxt, MT_Vector2(xcoord + const_xindent, ycoord), white);
+      ycoord += const_ysize;
+    }
+
+    // The allocations of the last frame, only the categories allocating are shown.
+    if (m_flags & PROFILE_ALLOCATIONS) {
+      for (int j = tc_first; j < tc_numCategories; j++) {
+        const KX_TimeCategoryLogger::AllocationCounters &counters = m_logger.GetLastAllocations(j);
+        if (counters.m_allocations == 0 && counters.m_frees == 0) {
+          continue;
+        }
+
+        debugDraw.RenderText2D(
+            m_profileLabels[j], MT_Vector2(xcoord + const_xindent, ycoord), white);
+
+        debugtxt = (boost::format("%d allocs %.1fKB | %d frees") % counters.m_allocations %
+                    (counters.m_allocatedBytes / 1024.0) % counters.m_frees)
+                       .str();
+        debugDraw.RenderText2D(
+            debugtxt, MT_Vector2(xcoord + const_xindent + 2 * profile_indent, ycoord), white);
+        ycoord += const_ysize;
+      }
+    }
   }
   // Add the ymargin for titles below the other section of debug info
   ycoord += title_y_top_margin;
 
+  // Memory display
+  if (m_flags & SHOW_MEMORY) {
+    const double time = m_clock.GetTimeSecond();
+    if (time - m_memoryReportTime >= 1.0) {
+      m_memoryReport = KX_MemoryReport();
+      FillMemoryReport(m_memoryReport);
+      m_memoryReportTime = time;
+    }
+
+    debugDraw.RenderText2D(
+        "Memory", MT_Vector2(xcoord + const_xindent + title_xmargin, ycoord), white);
+    ycoord += const_ysize;
+    ycoord += title_y_bottom_margin;
+
+    for (int i = 0; i < KX_MemoryReport::MEM_NUM_CATEGORIES; ++i) {
+      const KX_MemoryReport::Entry &entry = m_memoryReport.GetEntry((KX_MemoryReport::Category)i);
+      debugDraw.RenderText2D(KX_MemoryReport::m_categoryLabels[i] + " :",
+                             MT_Vector2(xcoord + const_xindent, ycoord),
+                             white);
+
+      debugtxt = (boost::format("%7.2fMB | %d") % (entry.m_bytes / 1048576.0) % entry.m_count).str();
+      debugDraw.RenderText2D(
+          debugtxt, MT_Vector2(xcoord + const_xindent + 2 * profile_indent, ycoord), white);
+      ycoord += const_ysize;
+    }
+
+    debugDraw.RenderText2D("Total :", MT_Vector2(xcoord + const_xindent, ycoord), white);
+    debugtxt = (boost::format("%7.2fMB") % (m_memoryReport.GetTotalBytes() / 1048576.0)).str();
+    debugDraw.RenderText2D(
+        debugtxt, MT_Vector2(xcoord + const_xindent + 2 * profile_indent, ycoord), white);
+    ycoord += const_ysize;
+
+    ycoord += title_y_top_margin;
+  }
+
   /* Property display */
   if (m_flags & SHOW_DEBUG_PROPERTIES) {
     // Title for debugging("Debug properties")
@@ -1261,6 +2112,59 @@ void KX_KetsjiEngine::RenderDebugProperties()
           debugDraw, const_xindent, const_ysize, xcoord, ycoord, propsMax);
     }
   }
+
+  // Performance graphs, drawn in the top right corner to not overlap the texts above.
+  if (m_flags & SHOW_HUD) {
+    m_hud.Render(debugDraw, m_canvas->GetWidth(), m_clock.GetTimeSecond());
+  }
+}
+
+void KX_KetsjiEngine::FillMemoryReport(KX_MemoryReport &report)
+{
+  for (KX_Scene *scene : m_scenes) {
+    scene->FillMemoryReport(report);
+  }
+
+  if (m_converter) {
+    m_converter->FillMemoryReport(report);
+  }
+
+#ifdef WITH_PYTHON
+  size_t count, bytes;
+  ImageBase::getMemoryUsage(count, bytes);
+  report.Add(KX_MemoryReport::MEM_VIDEO_TEXTURES, count, bytes);
+
+  /* Python only counts its allocated blocks, the size of the blocks is known when
+   * tracemalloc is tracing. */
+  count = 0;
+  bytes = 0;
+  PyObject *getallocatedblocks = PySys_GetObject("getallocatedblocks");
+  PyObject *blocks = getallocatedblocks ? PyObject_CallObject(getallocatedblocks, nullptr) :
+                                          nullptr;
+  if (blocks) {
+    count = PyLong_AsSize_t(blocks);
+    Py_DECREF(blocks);
+  }
+
+  PyObject *modname = PyUnicode_FromString("tracemalloc");
+  PyObject *tracemalloc = PyImport_GetModule(modname);
+  Py_DECREF(modname);
+  if (tracemalloc) {
+    PyObject *traced = PyObject_CallMethod(tracemalloc, "get_traced_memory", nullptr);
+    if (traced && PyTuple_Check(traced) && PyTuple_GET_SIZE(traced) > 0) {
+      bytes = PyLong_AsSize_t(PyTuple_GET_ITEM(traced, 0));
+    }
+    Py_XDECREF(traced);
+    Py_DECREF(tracemalloc);
+  }
+
+  if (PyErr_Occurred()) {
+    PyErr_Clear();
+    count = (count == (size_t)-1) ? 0 : count;
+    bytes = (bytes == (size_t)-1) ? 0 : bytes;
+  }
+  report.Add(KX_MemoryReport::MEM_PYTHON, count, bytes);
+#endif
 }
 
 void KX_KetsjiEngine::DrawDebugCameraFrustum(KX_Scene *scene,
@@ -1395,7 +2299,17 @@ void KX_KetsjiEngine::ReplaceScheduledScenes()
         if (scene->GetName() == oldscenename) {
           // avoid crash if the new scene doesn't exist, just do nothing
           Scene *blScene = m_converter->GetBlenderSceneForName(newscenename);
-          if (blScene) {
+          KX_Scene *preloadedScene = m_preloadedScenes->FindValue(newscenename);
+          if (preloadedScene) {
+            m_converter->RemoveScene(scene);
+
+            // The scene is already converted, it only needs to be the scene of the context.
+            m_preloadedScenes->RemoveValue(preloadedScene);
+            m_scenes->SetValue(sce_idx, preloadedScene);
+            preloadedScene->ActivateBlenderContext();
+            PostProcessScene(preloadedScene);
+          }
+          else if (blScene) {
             m_converter->RemoveScene(scene);
 
             KX_Scene *tmpscene = CreateScene(blScene, false);
@@ -1413,6 +2327,58 @@ void KX_KetsjiEngine::ReplaceScheduledScenes()
   }
 }
 
+bool KX_KetsjiEngine::PreloadScene(const std::string &scenename)
+{
+  if (!m_converter->GetBlenderSceneForName(scenename) || FindScene(scenename) ||
+      m_preloadedScenes->FindValue(scenename) ||
+      std::find(m_preloadingScenes.begin(), m_preloadingScenes.end(), scenename) !=
+          m_preloadingScenes.end()) {
+    return false;
+  }
+
+  m_preloadingScenes.push_back(scenename);
+  return true;
+}
+
+EXP_ListValue<KX_Scene> *KX_KetsjiEngine::PreloadedScenes()
+{
+  return m_preloadedScenes;
+}
+
+void KX_KetsjiEngine::RemovePreloadedScene(KX_Scene *scene)
+{
+  m_preloadedScenes->RemoveValue(scene);
+  m_converter->RemoveScene(scene);
+  // The destruction of the scene changed the scene of the context.
+  if (m_scenes->GetCount() > 0) {
+    m_scenes->GetFront()->ActivateBlenderContext();
+  }
+}
+
+void KX_KetsjiEngine::PreloadScheduledScenes()
+{
+  const std::string scenename = m_preloadingScenes.front();
+  m_preloadingScenes.erase(m_preloadingScenes.begin());
+
+  Scene *blScene = m_converter->GetBlenderSceneForName(scenename);
+  // The scene could have been freed or started since the schedule.
+  if (!blScene || FindScene(scenename)) {
+    return;
+  }
+
+  /* The scene creation makes its blender scene the scene of the context and sets its viewport
+   * as the current game viewport, both are restored for the running scenes. */
+  GPUViewport *viewport = DRW_game_gpu_viewport_get();
+
+  KX_Scene *scene = CreateScene(blScene, false);
+  m_preloadedScenes->Add(scene);
+
+  DRW_game_gpu_viewport_set(viewport);
+  if (m_scenes->GetCount() > 0) {
+    m_scenes->GetFront()->ActivateBlenderContext();
+  }
+}
+
 double KX_KetsjiEngine::GetTicRate()
 {
   return m_ticrate;
@@ -1423,6 +2389,46 @@ void KX_KetsjiEngine::SetTicRate(double ticrate)
   m_ticrate = ticrate;
 }
 
+double KX_KetsjiEngine::GetShaderCompileBudget() const
+{
+  return m_shaderCompileBudget;
+}
+
+void KX_KetsjiEngine::SetShaderCompileBudget(double budget)
+{
+  m_shaderCompileBudget = std::max(budget, 0.0);
+}
+
+unsigned short KX_KetsjiEngine::GetLightBudget() const
+{
+  return m_lightBudget;
+}
+
+void KX_KetsjiEngine::SetLightBudget(unsigned short budget)
+{
+  m_lightBudget = budget;
+}
+
+unsigned short KX_KetsjiEngine::GetMaxFramesInFlight() const
+{
+  return m_maxFramesInFlight;
+}
+
+void KX_KetsjiEngine::SetMaxFramesInFlight(unsigned short frames)
+{
+  m_maxFramesInFlight = std::max<unsigned short>(frames, 1);
+}
+
+void KX_KetsjiEngine::SetReplicationRate(float rate)
+{
+  m_replicationRate = std::max(rate, 0.0f);
+}
+
+void KX_KetsjiEngine::SetReplicationRadius(float radius)
+{
+  m_replicationRadius = std::max(radius, 0.0f);
+}
+
 double KX_KetsjiEngine::GetTimeScale() const
 {
   return m_timescale;
@@ -1503,6 +2509,16 @@ double KX_KetsjiEngine::GetAverageFrameRate()
   return m_average_framerate;
 }
 
+double KX_KetsjiEngine::GetAverageFrameDrift() const
+{
+  return m_frameDriftLogger.GetAverage();
+}
+
+double KX_KetsjiEngine::GetAveragePresentLatency() const
+{
+  return m_presentLatencyLogger.GetAverage();
+}
+
 void KX_KetsjiEngine::SetExitKey(short key)
 {
   m_exitkey = key;
@@ -1515,7 +2531,7 @@ short KX_KetsjiEngine::GetExitKey()
 
 void KX_KetsjiEngine::SetRender(bool render)
 {
-  m_doRender = render;
+  m_doRender = render && !(m_flags & HEADLESS);
 }
 
 bool KX_KetsjiEngine::GetRender()
@@ -1532,6 +2548,10 @@ void KX_KetsjiEngine::ProcessScheduledScenes(void)
     ReplaceScheduledScenes();
     RemoveScheduledScenes();
   }
+
+  if (!m_preloadingScenes.empty()) {
+    PreloadScheduledScenes();
+  }
 }
 
 void KX_KetsjiEngine::SetShowBoundingBox(KX_DebugOption mode)
@@ -36,20 +36,34 @@
 #include <vector>
 
 #include "CM_Clock.h"
+#include "CM_JobGraph.h"
 #include "EXP_Python.h"
+#include "KX_CompressedTextures.h"
 #include "KX_ISystem.h"
+#include "KX_DepsgraphProfiler.h"
+#include "KX_FrameStatistics.h"
+#include "KX_MemoryReport.h"
+#include "KX_PerformanceHud.h"
+#include "KX_ResolutionScaler.h"
+#include "KX_TextureStreamer.h"
 #include "KX_Scene.h"
 #include "KX_TimeCategoryLogger.h"
 #include "MT_Matrix4x4.h"
 #include "RAS_CameraData.h"
 #include "RAS_Rasterizer.h"
+#include "SCA_ObjectProfiler.h"
 
 class KX_ISystem;
 class BL_BlenderConverter;
 class KX_NetworkMessageManager;
+class KX_SoundManager;
+class KX_SoundStreamer;
+class KX_StateManager;
+class KX_VideoCapture;
 class RAS_ICanvas;
 class RAS_FrameBuffer;
 class SCA_IInputDevice;
+class PHY_IPhysicsEnvironment;
 
 enum class KX_ExitRequest {
   NO_REQUEST = 0,
@@ -90,13 +104,62 @@ class KX_KetsjiEngine {
     /// Automatic add debug properties to the debug list.
     AUTO_ADD_DEBUG_PROPERTIES = (1 << 6),
     /// Use override camera?
-    CAMERA_OVERRIDE = (1 << 7)
+    CAMERA_OVERRIDE = (1 << 7),
+    /// Step the physics of each scene in its own task?
+    PARALLEL_SCENE_STEP = (1 << 8),
+    /// Reuse the last draw of a camera when its view and the scene didn't change?
+    RETAINED_DRAW = (1 << 9),
+    /// Sleep until the next frame in fixed framerate instead of looping?
+    FRAME_PACING = (1 << 10),
+    /// Swap the buffers of a frame after the logic of the next frame?
+    DEFERRED_SWAP = (1 << 11),
+    /// Evaluate the logic brick controllers not using Python in parallel?
+    PARALLEL_LOGIC = (1 << 12),
+    /// Measure the python controllers and components?
+    PROFILE_SCRIPTS = (1 << 13),
+    /// Show the memory used by each subsystem?
+    SHOW_MEMORY = (1 << 14),
+    /// Render every frame in fixed framerate with the physics interpolated between the steps?
+    PHYSICS_INTERPOLATION = (1 << 15),
+    /// Measure the GPU time of the render passes?
+    PROFILE_GPU = (1 << 16),
+    /// Measure the logic, physics and transform time of each object?
+    PROFILE_OBJECTS = (1 << 17),
+    /// Measure the stages of the depsgraph update?
+    PROFILE_DEPSGRAPH = (1 << 18),
+    /// Show the graphs of the performance counters?
+    SHOW_HUD = (1 << 19),
+    /// Compile the materials added while playing between the frames instead of when first drawn?
+    DEFERRED_SHADERS = (1 << 20),
+    /// Cache the shadows of the objects not moved by the game and only redraw the moved ones?
+    STATIC_SHADOWS = (1 << 21),
+    /// Draw the views of the same size, e.g. the stereo eyes, from caches populated once?
+    MULTI_VIEW = (1 << 22),
+    /// Draw the overlay collections unlit with the workbench engine instead of EEVEE?
+    OVERLAY_WORKBENCH = (1 << 23),
+    /// Spread the pulses of the sensors with the same skipped ticks over the frames?
+    STAGGER_PULSES = (1 << 24),
+    /// Limit the frames queued to the GPU and sample the inputs once the GPU caught up?
+    LOW_LATENCY = (1 << 25),
+    /// Draw the static members of the collection instances as instances of their object?
+    INSTANCED_COLLECTIONS = (1 << 26),
+    /// Merge the meshes of the static objects of the converted scenes into batches?
+    STATIC_BATCHING = (1 << 27),
+    /// Run without window nor GPU context, only the logic, physics and network are processed?
+    HEADLESS = (1 << 28),
+    /// Count the allocations and frees of each profiling category?
+    PROFILE_ALLOCATIONS = (1 << 29),
+    /// Hold back the geometry updates of the objects outside the views until they are visible?
+    DEFERRED_GEOMETRY = (1 << 30)
   };
 
+  typedef std::vector<std::pair<std::string, SCA_ObjectProfiler::Entry>> ObjectProfileList;
+
  private:
   struct CameraRenderData {
     CameraRenderData(KX_Camera *rendercam,
                      KX_Camera *cullingcam,
+                     KX_Camera *sourcecam,
                      const RAS_Rect &area,
                      const RAS_Rect &viewport,
                      RAS_Rasterizer::StereoEye eye);
@@ -106,6 +169,8 @@ class KX_KetsjiEngine {
     /// Rendered camera, could be a temporary camera in case of stereo.
     KX_Camera *m_renderCamera;
     KX_Camera *m_cullingCamera;
+    /// Camera of the scene the render camera is copied from.
+    KX_Camera *m_sourceCamera;
     RAS_Rect m_area;
     RAS_Rect m_viewport;
     RAS_Rasterizer::StereoEye m_eye;
@@ -140,6 +205,13 @@ class KX_KetsjiEngine {
   KX_ISystem *m_kxsystem;
   BL_BlenderConverter *m_converter;
   KX_NetworkMessageManager *m_networkMessageManager;
+  /// Voices of the sound actuators of all the scenes.
+  KX_SoundManager *m_soundManager;
+  KX_SoundStreamer *m_soundStreamer;
+  /// Save and load of the scene states, the files are written on a worker thread.
+  KX_StateManager *m_stateManager;
+  /// Recording of the rendered frames in a video file.
+  KX_VideoCapture *m_videoCapture;
 #ifdef WITH_PYTHON
   PyObject *m_pyprofiledict;
 #endif
@@ -152,14 +224,23 @@ class KX_KetsjiEngine {
     double timestep;
     // Scaled duration of a frame.
     double framestep;
+    // Position of the render between the last two frames, 1 for the last one.
+    double interpolation;
   };
 
   CM_Clock m_clock;
 
+  /// Jobs stepping the physics of the scenes in parallel, one per scene.
+  CM_JobGraph m_physicsJobs;
+
   /// Lists of scenes scheduled to be removed at the end of the frame.
   std::vector<std::string> m_removingScenes;
   /// Lists of scenes scheduled to be replaced at the end of the frame.
   std::vector<std::pair<std::string, std::string>> m_replace_scenes;
+  /// Lists of scenes scheduled to be converted ahead at the end of the frame.
+  std::vector<std::string> m_preloadingScenes;
+  /// Scenes converted ahead of a replace, they are not updated nor rendered.
+  EXP_ListValue<KX_Scene> *m_preloadedScenes;
 
   /// The current list of scenes.
   EXP_ListValue<KX_Scene> *m_scenes;
@@ -185,10 +266,26 @@ class KX_KetsjiEngine {
   /// maximum number of consecutive physics frame
   int m_maxPhysicsFrame;
   double m_ticrate;
+  /// Time in seconds spent per frame to compile the queued materials, see DEFERRED_SHADERS.
+  double m_shaderCompileBudget;
+  /// Most lights drawn per camera, 0 to not cull the lights.
+  unsigned short m_lightBudget;
+  /// Sends per second of the replicated object states.
+  float m_replicationRate;
+  /// Distance around the peers under which the object states are sent to them, 0 for all.
+  float m_replicationRadius;
   /// for animation playback only - ipo and action
   double m_anim_framerate;
 
   bool m_doRender; /* whether or not the scene should be rendered after the logic frame */
+  /// The last rendered frame is flushed and waits its buffer swap, see DEFERRED_SWAP.
+  bool m_pendingSwap;
+  /// Time the inputs were last sampled.
+  double m_inputTime;
+  /// Input time of the frame waiting its buffer swap.
+  double m_pendingSwapInputTime;
+  /// Maximum of frames queued to the GPU in low latency, see LOW_LATENCY.
+  unsigned short m_maxFramesInFlight;
 
   /// Key used to exit the BGE
   short m_exitkey;
@@ -209,6 +306,7 @@ class KX_KetsjiEngine {
   typedef enum {
     tc_first = 0,
     tc_physics = 0,
+    tc_softbodies,
     tc_logic,
     tc_animations,
     tc_depsgraph,
@@ -229,6 +327,26 @@ class KX_KetsjiEngine {
   static const std::string m_profileLabels[tc_numCategories];
   /// Last estimated framerate
   double m_average_framerate;
+  /// Logger of the delay between the expected and the real start of the frames in fixed framerate.
+  KX_TimeLogger m_frameDriftLogger;
+  /// Logger of the delay between the input sampling and the end of the GPU work of the frames.
+  KX_TimeLogger m_presentLatencyLogger;
+  /// Percentiles of the category times and hitch detector.
+  KX_FrameStatistics m_frameStatistics;
+  /// Breakdown of the depsgraph update time.
+  KX_DepsgraphProfiler m_depsgraphProfiler;
+  /// Graphs of the performance counters of the last frames.
+  KX_PerformanceHud m_hud;
+  /// Resolution of the material image textures by their size on screen.
+  KX_TextureStreamer m_textureStreamer;
+  /// Material image textures uploaded from their block compressed files.
+  KX_CompressedTextures m_compressedTextures;
+  /// Render resolution adapted to the GPU time of the cameras.
+  KX_ResolutionScaler m_resolutionScaler;
+  /// Memory report shown in the debug overlay, refreshed every second.
+  KX_MemoryReport m_memoryReport;
+  /// Real time of the last refresh of m_memoryReport.
+  double m_memoryReportTime;
 
   /// Enable debug draw of culling bounding boxes.
   KX_DebugOption m_showBoundingBox;
@@ -257,9 +375,37 @@ class KX_KetsjiEngine {
   /// Compute frame render data per eyes (in case of stereo), scenes and camera.
   bool GetFrameRenderData(std::vector<FrameRenderData> &frameDataList);
 
-  /// EEVEE scene rendering
-  void RenderCamera(KX_Scene *scene, const CameraRenderData &cameraFrameData, unsigned short pass);
+  /// Return true if a view can be drawn with the draw caches populated for the previous view.
+  bool UseSharedRender(KX_Scene *scene,
+                       const CameraRenderData &previous,
+                       const CameraRenderData &view) const;
+  /** EEVEE scene rendering
+   * \param views The views drawn together, several when they share the draw caches.
+   */
+  void RenderCamera(KX_Scene *scene,
+                    const std::vector<const CameraRenderData *> &views,
+                    unsigned short pass);
   void RenderDebugProperties();
+#ifdef WITH_PYTHON
+  /// Copy the script timings of all the scenes in the python profile dictionary.
+  void UpdateScriptProfileDict();
+#endif
+  /// Register the category times of the last frame in the frame statistics.
+  void UpdateFrameStatistics();
+  /// Read the GPU timers of a previous frame and copy them in the python profile dictionary.
+  void UpdateGpuTimers();
+  /// Finish the depsgraph measures of the frame and copy them in the python profile dictionary.
+  void UpdateDepsgraphProfile();
+  /// Copy the allocations of the last frame in the python profile dictionary.
+  void UpdateAllocationProfile();
+  /// Register the counters of the last frame in the performance HUD.
+  void UpdateHud();
+  /// Queue the readback of the drawn frame when a video is captured.
+  void CaptureVideoFrame();
+  /// Compile a part of the materials queued by the previous frames.
+  void UpdateDeferredShaders();
+  /// Print the detected hitches.
+  void PrintHitches();
   /// Debug draw cameras frustum of a scene.
   void DrawDebugCameraFrustum(KX_Scene *scene,
                               RAS_DebugDraw &debugDraw,
@@ -280,11 +426,19 @@ class KX_KetsjiEngine {
    */
   void RemoveScheduledScenes(void);
   void ReplaceScheduledScenes(void);
+  /// Convert the first scene scheduled to be preloaded, one scene per frame.
+  void PreloadScheduledScenes();
   void PostProcessScene(KX_Scene *scene);
 
   void BeginFrame();
   FrameTimes GetFrameTimes();
 
+  /** Proceed the physics of all the scenes at the same time, each scene
+   * physics environment is stepped in its own task and the function returns
+   * once all the tasks are done.
+   */
+  void ProceedScenesPhysicsParallel(const FrameTimes &times);
+
  public:
   KX_KetsjiEngine(KX_ISystem *system,
                   struct bContext *C,
@@ -304,6 +458,13 @@ class KX_KetsjiEngine {
   /***** End of EEVEE integration *****/
 
   void EndFrame();
+  /// Swap the buffers of the last rendered frame if it was deferred.
+  void SwapPendingBuffers();
+  /** Swap the buffers of a frame, then wait for the GPU to limit the frames in flight in low
+   * latency and measure the latency of the finished frames.
+   * \param inputTime The time the inputs of the frame were sampled.
+   */
+  void PresentFrame(double inputTime);
 
   RAS_FrameBuffer *PostRenderScene(KX_Scene *scene,
                                    RAS_FrameBuffer *inputfb,
@@ -316,7 +477,36 @@ class KX_KetsjiEngine {
   void SetNetworkMessageManager(KX_NetworkMessageManager *manager);
 #ifdef WITH_PYTHON
   PyObject *GetPyProfileDict();
+  /// Return a dictionary of the percentiles of each category.
+  PyObject *GetPyProfileStatistics();
+  /// Return a list of the detected hitches.
+  PyObject *GetPyHitches();
+  /// Return a list of the objects taking the most time.
+  PyObject *GetPyObjectProfile(unsigned int count);
 #endif
+  /** Return the objects of all the scenes taking the most time since the object
+   * profiling was enabled, sorted by decreasing time.
+   * \param count The maximum number of objects returned.
+   */
+  ObjectProfileList GetCostlyObjects(unsigned int count);
+  KX_FrameStatistics &GetFrameStatistics();
+  KX_DepsgraphProfiler &GetDepsgraphProfiler();
+  KX_PerformanceHud &GetPerformanceHud();
+  KX_TextureStreamer &GetTextureStreamer();
+  KX_CompressedTextures &GetCompressedTextures();
+  KX_ResolutionScaler &GetResolutionScaler();
+  /** Share the temporary render targets of the engines between the camera viewports rendered
+   * one after the other, must be set before creating the scenes.
+   */
+  void SetSharedRenderTargets(bool enable);
+  /// Return the number of profiling categories.
+  static unsigned short GetNumProfileCategories();
+  /// Return the label of a profiling category, e.g "Physics:".
+  static const std::string &GetProfileLabel(unsigned short category);
+  /// Return the time in seconds of a profiling category during the last finished frame.
+  double GetLastProfileTime(unsigned short category);
+  /// Fill a report of the memory used by each subsystem of the engine.
+  void FillMemoryReport(KX_MemoryReport &report);
   void SetConverter(BL_BlenderConverter *converter);
   BL_BlenderConverter *GetConverter()
   {
@@ -335,10 +525,31 @@ class KX_KetsjiEngine {
   {
     return m_inputDevice;
   }
+  /// Return the clock of the real time.
+  const CM_Clock &GetClock() const
+  {
+    return m_clock;
+  }
   KX_NetworkMessageManager *GetNetworkMessageManager() const
   {
     return m_networkMessageManager;
   }
+  KX_SoundManager *GetSoundManager() const
+  {
+    return m_soundManager;
+  }
+  KX_SoundStreamer *GetSoundStreamer() const
+  {
+    return m_soundStreamer;
+  }
+  KX_StateManager *GetStateManager() const
+  {
+    return m_stateManager;
+  }
+  KX_VideoCapture *GetVideoCapture() const
+  {
+    return m_videoCapture;
+  }
 
   /// returns true if an update happened to indicate -> Render
   bool NextFrame();
@@ -358,6 +569,14 @@ class KX_KetsjiEngine {
 
   void RemoveScene(const std::string &scenename);
   bool ReplaceScene(const std::string &oldscene, const std::string &newscene);
+  /** Schedule the conversion of a scene at the end of the frame, the scene is kept
+   * inactive until a replace activates it without converting it again.
+   * \return False if the scene doesn't exist, is running or is already preloaded.
+   */
+  bool PreloadScene(const std::string &scenename);
+  EXP_ListValue<KX_Scene> *PreloadedScenes();
+  /// Free a preloaded scene not yet activated.
+  void RemovePreloadedScene(KX_Scene *scene);
 
   void GetSceneViewport(KX_Scene *scene,
                         KX_Camera *cam,
@@ -413,6 +632,22 @@ class KX_KetsjiEngine {
    * Sets the number of logic updates per second.
    */
   void SetTicRate(double ticrate);
+  /// Gets the time in seconds spent per frame to compile the queued materials.
+  double GetShaderCompileBudget() const;
+  /// Sets the time in seconds spent per frame to compile the queued materials.
+  void SetShaderCompileBudget(double budget);
+  /// Gets the most lights drawn per camera, 0 if the lights are not culled.
+  unsigned short GetLightBudget() const;
+  /// Sets the most lights drawn per camera, 0 to not cull the lights.
+  void SetLightBudget(unsigned short budget);
+  /// Gets the maximum of frames queued to the GPU in low latency.
+  unsigned short GetMaxFramesInFlight() const;
+  /// Sets the maximum of frames queued to the GPU in low latency.
+  void SetMaxFramesInFlight(unsigned short frames);
+  /// Sets the sends per second of the replicated object states.
+  void SetReplicationRate(float rate);
+  /// Sets the distance around the peers under which the object states are sent, 0 for all.
+  void SetReplicationRadius(float radius);
   /**
    * Gets the maximum number of logic frame before render frame
    */
@@ -444,6 +679,18 @@ class KX_KetsjiEngine {
    */
   double GetAverageFrameRate();
 
+  /**
+   * Gets the average delay in seconds between the expected and the real start
+   * of the frames in fixed framerate.
+   */
+  double GetAverageFrameDrift() const;
+
+  /**
+   * Gets the average delay in seconds between the input sampling of the frames and the end of
+   * their GPU work, measured in low latency or when the profile is shown.
+   */
+  double GetAveragePresentLatency() const;
+
   /**
    * Gets the time scale multiplier
    */
@@ -459,7 +706,8 @@ class KX_KetsjiEngine {
   short GetExitKey();
 
   /**
-   * Activate or deactivates the render of the scene after the logic frame
+   * Activate or deactivates the render of the scene after the logic frame, the render stays
+   * disabled in headless mode.
    * \param render	true (render) or false (do not render)
    */
   void SetRender(bool render);
@@ -26,6 +26,8 @@
 
 #include "KX_LibLoadStatus.h"
 
+#include "KX_KetsjiEngine.h"
+#include "KX_PythonCoroutine.h"
 #include "PIL_time.h"
 
 KX_LibLoadStatus::KX_LibLoadStatus(class BL_BlenderConverter *kx_converter,
@@ -38,7 +40,9 @@ KX_LibLoadStatus::KX_LibLoadStatus(class BL_BlenderConverter *kx_converter,
       m_data(nullptr),
       m_libname(path),
       m_progress(0.0f),
-      m_finished(false)
+      m_mergeBudget(0.0f),
+      m_finished(false),
+      m_owners(0)
 #ifdef WITH_PYTHON
       ,
       m_finish_cb(nullptr),
@@ -54,6 +58,10 @@ void KX_LibLoadStatus::Finish()
   m_progress = 1.f;
   m_endtime = PIL_check_seconds_timer();
 
+  if (m_engine && m_engine->GetFrameStatistics().UseEvents()) {
+    m_engine->GetFrameStatistics().AddEvent("LibLoad", m_libname);
+  }
+
   RunFinishCallback();
   RunProgressCallback();
 }
@@ -76,22 +84,19 @@ void KX_LibLoadStatus::RunFinishCallback()
 
 void KX_LibLoadStatus::RunProgressCallback()
 {
-// Progess callbacks are causing threading problems with Python, so they're disabled for now
-#if 0
-#  ifdef WITH_PYTHON
-	if (m_progress_cb) {
-		//PyGILState_STATE gstate = PyGILState_Ensure();
-		PyObject* args = Py_BuildValue("(O)", GetProxy());
-
-		if (!PyObject_Call(m_progress_cb, args, nullptr)) {
-			PyErr_Print();
-			PyErr_Clear();
-		}
-
-		Py_DECREF(args);
-		//PyGILState_Release(gstate);
-	}
-#  endif
+  /* Must be called from the main thread only, progress added from a loading
+   * thread is reported at the next call from the main thread. */
+#ifdef WITH_PYTHON
+  if (m_progress_cb) {
+    PyObject *args = Py_BuildValue("(O)", GetProxy());
+
+    if (!PyObject_Call(m_progress_cb, args, nullptr)) {
+      PyErr_Print();
+      PyErr_Clear();
+    }
+
+    Py_DECREF(args);
+  }
 #endif
 }
 
@@ -134,7 +139,16 @@ float KX_LibLoadStatus::GetProgress()
 void KX_LibLoadStatus::AddProgress(float progress)
 {
   m_progress += progress;
-  RunProgressCallback();
+}
+
+void KX_LibLoadStatus::SetMergeBudget(float budget)
+{
+  m_mergeBudget = budget;
+}
+
+float KX_LibLoadStatus::GetMergeBudget() const
+{
+  return m_mergeBudget;
 }
 
 #ifdef WITH_PYTHON
@@ -146,9 +160,10 @@ PyMethodDef KX_LibLoadStatus::Methods[] = {
 PyAttributeDef KX_LibLoadStatus::Attributes[] = {
     EXP_PYATTRIBUTE_RW_FUNCTION(
         "onFinish", KX_LibLoadStatus, pyattr_get_onfinish, pyattr_set_onfinish),
-    // EXP_PYATTRIBUTE_RW_FUNCTION("onProgress", KX_LibLoadStatus, pyattr_get_onprogress,
-    // pyattr_set_onprogress),
+    EXP_PYATTRIBUTE_RW_FUNCTION(
+        "onProgress", KX_LibLoadStatus, pyattr_get_onprogress, pyattr_set_onprogress),
     EXP_PYATTRIBUTE_FLOAT_RO("progress", KX_LibLoadStatus, m_progress),
+    EXP_PYATTRIBUTE_FLOAT_RO("mergeBudget", KX_LibLoadStatus, m_mergeBudget),
     EXP_PYATTRIBUTE_STRING_RO("libraryName", KX_LibLoadStatus, m_libname),
     EXP_PYATTRIBUTE_RO_FUNCTION("timeTaken", KX_LibLoadStatus, pyattr_get_timetaken),
     EXP_PYATTRIBUTE_BOOL_RO("finished", KX_LibLoadStatus, m_finished),
@@ -162,7 +177,7 @@ PyTypeObject KX_LibLoadStatus::Type = {PyVarObject_HEAD_INIT(nullptr, 0) "KX_Lib
                                        0,
                                        0,
                                        0,
-                                       0,
+                                       &KX_CoroutineWait_LibLoadAsync,
                                        py_base_repr,
                                        0,
                                        0,
@@ -36,11 +36,15 @@ class KX_LibLoadStatus : public EXP_PyObjectPlus {
   std::string m_libname;
 
   float m_progress;
+  /// Time in milliseconds spent at most per frame to merge the loaded scenes, 0 for no limit.
+  float m_mergeBudget;
   double m_starttime;
   double m_endtime;
 
   // The current status of this libload, used by the scene converter.
   bool m_finished;
+  /// Number of owners preventing the converter to delete the status, see AddOwner().
+  unsigned int m_owners;
 
 #ifdef WITH_PYTHON
   PyObject *m_finish_cb;
@@ -69,10 +73,29 @@ class KX_LibLoadStatus : public EXP_PyObjectPlus {
     return m_finished;
   }
 
+  /** Keep the status alive until the matching call to RemoveOwner(), the converter deletes
+   * the finished statuses only once they are not owned nor referenced by a script.
+   */
+  inline void AddOwner()
+  {
+    ++m_owners;
+  }
+  inline void RemoveOwner()
+  {
+    --m_owners;
+  }
+  inline bool IsOwned() const
+  {
+    return m_owners > 0;
+  }
+
   void SetProgress(float progress);
   float GetProgress();
   void AddProgress(float progress);
 
+  void SetMergeBudget(float budget);
+  float GetMergeBudget() const;
+
 #ifdef WITH_PYTHON
   static PyObject *pyattr_get_onfinish(EXP_PyObjectPlus *self_v,
                                        const EXP_PYATTRIBUTE_DEF *attrdef);
@@ -35,12 +35,24 @@
 
 #include "KX_Light.h"
 
-KX_LightObject::KX_LightObject() : KX_GameObject(), m_obLight(nullptr)
+#include "BLI_math_base.h"
+#include "BLI_math_rotation.h"
+#include "BLI_math_vector.h"
+#include "DNA_light_types.h"
+#include "DNA_scene_types.h"
+#include "DRW_render.h"
+
+#include "KX_PyMath.h"
+#include "KX_Scene.h"
+
+KX_LightObject::KX_LightObject()
+    : KX_GameObject(), m_obLight(nullptr), m_light(nullptr), m_gameLight(nullptr)
 {
 }
 
 KX_LightObject::~KX_LightObject()
 {
+  delete m_gameLight;
 }
 
 void KX_LightObject::SetBlenderObject(Object *obj)
@@ -55,6 +67,109 @@ Light *KX_LightObject::GetLight()
   return m_light;
 }
 
+const DRWGameLight *KX_LightObject::GetGameLight() const
+{
+  return m_gameLight;
+}
+
+DRWGameLight *KX_LightObject::EnsureGameLight()
+{
+  if (!m_gameLight) {
+    m_gameLight = new DRWGameLight();
+    copy_v3_v3(m_gameLight->color, &m_light->r);
+    m_gameLight->energy = m_light->energy;
+    m_gameLight->distance = (m_light->mode & LA_CUSTOM_ATTENUATION) ? m_light->att_dist : 0.0f;
+    m_gameLight->spot_size = m_light->spotsize;
+    m_gameLight->spot_blend = m_light->spotblend;
+    m_gameLight->changes = 0;
+  }
+  return m_gameLight;
+}
+
+void KX_LightObject::TagGameLightChange()
+{
+  ++m_gameLight->changes;
+  GetScene()->InvalidateRetainedDraws();
+}
+
+float KX_LightObject::GetEnergy() const
+{
+  return m_gameLight ? m_gameLight->energy : m_light->energy;
+}
+
+MT_Vector3 KX_LightObject::GetColor() const
+{
+  return MT_Vector3(m_gameLight ? m_gameLight->color : &m_light->r);
+}
+
+float KX_LightObject::GetDistance() const
+{
+  if (m_gameLight) {
+    return m_gameLight->distance;
+  }
+  return (m_light->mode & LA_CUSTOM_ATTENUATION) ? m_light->att_dist : 0.0f;
+}
+
+float KX_LightObject::GetSpotSize() const
+{
+  return m_gameLight ? m_gameLight->spot_size : m_light->spotsize;
+}
+
+float KX_LightObject::GetSpotBlend() const
+{
+  return m_gameLight ? m_gameLight->spot_blend : m_light->spotblend;
+}
+
+float KX_LightObject::GetInfluenceRadius()
+{
+  const float distance = GetDistance();
+  if (distance > 0.0f) {
+    return distance;
+  }
+
+  // Same as the attenuation radius of EEVEE.
+  const MT_Vector3 color = GetColor();
+  const float power = max_fff(color[0], color[1], color[2]) * fabsf(GetEnergy() / 100.0f) *
+                      max_ff(m_light->diff_fac, m_light->spec_fac);
+  const float threshold = GetScene()->GetBlenderScene()->eevee.light_threshold;
+  return sqrtf(max_ff(1e-16f, power / max_ff(1e-16f, threshold)));
+}
+
+bool KX_LightObject::IsSun() const
+{
+  return (m_light->type == LA_SUN);
+}
+
+void KX_LightObject::SetEnergy(float energy)
+{
+  EnsureGameLight()->energy = energy;
+  TagGameLightChange();
+}
+
+void KX_LightObject::SetColor(const MT_Vector3 &color)
+{
+  color.getValue(EnsureGameLight()->color);
+  TagGameLightChange();
+}
+
+void KX_LightObject::SetDistance(float distance)
+{
+  EnsureGameLight()->distance = distance;
+  TagGameLightChange();
+}
+
+void KX_LightObject::SetSpotSize(float size)
+{
+  EnsureGameLight()->spot_size = size;
+  TagGameLightChange();
+}
+
+void KX_LightObject::SetSpotBlend(float blend)
+{
+  EnsureGameLight()->spot_blend = blend;
+  TagGameLightChange();
+}
+
 KX_PythonProxy *KX_LightObject::NewInstance()
 {
   return new KX_LightObject(*this);
@@ -66,6 +181,10 @@ void KX_LightObject::ProcessReplica()
 
   m_obLight = m_pBlenderObject;
   m_light = static_cast<Light *>(m_obLight->data);
+  // The replica keeps the parameters changed in game.
+  if (m_gameLight) {
+    m_gameLight = new DRWGameLight(*m_gameLight);
+  }
 }
 
 #ifdef WITH_PYTHON
@@ -129,8 +248,129 @@ PyMethodDef KX_LightObject::Methods[] = {
 };
 
 PyAttributeDef KX_LightObject::Attributes[] = {
-    // EXP_PYATTRIBUTE_RW_FUNCTION("energy", KX_LightObject, pyattr_get_energy, pyattr_set_energy),
+    EXP_PYATTRIBUTE_RW_FUNCTION("energy", KX_LightObject, pyattr_get_energy, pyattr_set_energy),
+    EXP_PYATTRIBUTE_RW_FUNCTION("color", KX_LightObject, pyattr_get_color, pyattr_set_color),
+    EXP_PYATTRIBUTE_RW_FUNCTION(
+        "distance", KX_LightObject, pyattr_get_distance, pyattr_set_distance),
+    EXP_PYATTRIBUTE_RW_FUNCTION(
+        "spotSize", KX_LightObject, pyattr_get_spot_size, pyattr_set_spot_size),
+    EXP_PYATTRIBUTE_RW_FUNCTION(
+        "spotBlend", KX_LightObject, pyattr_get_spot_blend, pyattr_set_spot_blend),
 
     EXP_PYATTRIBUTE_NULL  // Sentinel
 };
+
+PyObject *KX_LightObject::pyattr_get_energy(EXP_PyObjectPlus *self_v,
+                                            const EXP_PYATTRIBUTE_DEF *attrdef)
+{
+  KX_LightObject *self = static_cast<KX_LightObject *>(self_v);
+  return PyFloat_FromDouble(self->GetEnergy());
+}
+
+int KX_LightObject::pyattr_set_energy(EXP_PyObjectPlus *self_v,
+                                      const EXP_PYATTRIBUTE_DEF *attrdef,
+                                      PyObject *value)
+{
+  KX_LightObject *self = static_cast<KX_LightObject *>(self_v);
+  const float val = PyFloat_AsDouble(value);
+  if (val == -1.0f && PyErr_Occurred()) {
+    PyErr_SetString(PyExc_AttributeError,
+                    "light.energy = float: KX_LightObject, expected a float");
+    return PY_SET_ATTR_FAIL;
+  }
+
+  self->SetEnergy(val);
+  return PY_SET_ATTR_SUCCESS;
+}
+
+PyObject *KX_LightObject::pyattr_get_color(EXP_PyObjectPlus *self_v,
+                                           const EXP_PYATTRIBUTE_DEF *attrdef)
+{
+  KX_LightObject *self = static_cast<KX_LightObject *>(self_v);
+  return PyObjectFrom(self->GetColor());
+}
+
+int KX_LightObject::pyattr_set_color(EXP_PyObjectPlus *self_v,
+                                     const EXP_PYATTRIBUTE_DEF *attrdef,
+                                     PyObject *value)
+{
+  KX_LightObject *self = static_cast<KX_LightObject *>(self_v);
+  MT_Vector3 color;
+  if (!PyVecTo(value, color)) {
+    return PY_SET_ATTR_FAIL;
+  }
+
+  self->SetColor(color);
+  return PY_SET_ATTR_SUCCESS;
+}
+
+PyObject *KX_LightObject::pyattr_get_distance(EXP_PyObjectPlus *self_v,
+                                              const EXP_PYATTRIBUTE_DEF *attrdef)
+{
+  KX_LightObject *self = static_cast<KX_LightObject *>(self_v);
+  return PyFloat_FromDouble(self->GetDistance());
+}
+
+int KX_LightObject::pyattr_set_distance(EXP_PyObjectPlus *self_v,
+                                        const EXP_PYATTRIBUTE_DEF *attrdef,
+                                        PyObject *value)
+{
+  KX_LightObject *self = static_cast<KX_LightObject *>(self_v);
+  const float val = PyFloat_AsDouble(value);
+  if (val < 0.0f) { /* also accounts for non float */
+    PyErr_SetString(PyExc_AttributeError,
+                    "light.distance = float: KX_LightObject, expected a float zero or above");
+    return PY_SET_ATTR_FAIL;
+  }
+
+  self->SetDistance(val);
+  return PY_SET_ATTR_SUCCESS;
+}
+
+PyObject *KX_LightObject::pyattr_get_spot_size(EXP_PyObjectPlus *self_v,
+                                               const EXP_PYATTRIBUTE_DEF *attrdef)
+{
+  KX_LightObject *self = static_cast<KX_LightObject *>(self_v);
+  return PyFloat_FromDouble(self->GetSpotSize());
+}
+
+int KX_LightObject::pyattr_set_spot_size(EXP_PyObjectPlus *self_v,
+                                         const EXP_PYATTRIBUTE_DEF *attrdef,
+                                         PyObject *value)
+{
+  KX_LightObject *self = static_cast<KX_LightObject *>(self_v);
+  const float val = PyFloat_AsDouble(value);
+  if (val < DEG2RADF(1.0f) || val > M_PI) { /* also accounts for non float */
+    PyErr_SetString(PyExc_AttributeError,
+                    "light.spotSize = float: KX_LightObject, expected an angle between 1 degree "
+                    "and pi");
+    return PY_SET_ATTR_FAIL;
+  }
+
+  self->SetSpotSize(val);
+  return PY_SET_ATTR_SUCCESS;
+}
+
+PyObject *KX_LightObject::pyattr_get_spot_blend(EXP_PyObjectPlus *self_v,
+                                                const EXP_PYATTRIBUTE_DEF *attrdef)
+{
+  KX_LightObject *self = static_cast<KX_LightObject *>(self_v);
+  return PyFloat_FromDouble(self->GetSpotBlend());
+}
+
+int KX_LightObject::pyattr_set_spot_blend(EXP_PyObjectPlus *self_v,
+                                          const EXP_PYATTRIBUTE_DEF *attrdef,
+                                          PyObject *value)
+{
+  KX_LightObject *self = static_cast<KX_LightObject *>(self_v);
+  const float val = PyFloat_AsDouble(value);
+  if (val < 0.0f || val > 1.0f) { /* also accounts for non float */
+    PyErr_SetString(PyExc_AttributeError,
+                    "light.spotBlend = float: KX_LightObject, expected a float between 0 and 1");
+    return PY_SET_ATTR_FAIL;
+  }
+
+  self->SetSpotBlend(val);
+  return PY_SET_ATTR_SUCCESS;
+}
 #endif  // WITH_PYTHON
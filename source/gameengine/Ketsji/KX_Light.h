@@ -33,6 +33,7 @@
 
 #include "KX_GameObject.h"
 
+struct DRWGameLight;
 struct Light;
 struct Object;
 
@@ -43,6 +44,13 @@ class KX_LightObject : public KX_GameObject {
 
       Object *m_obLight;
   Light *m_light;
+  /// Parameters changed in game over the light data, nullptr until the first change.
+  DRWGameLight *m_gameLight;
+
+  /// Return the parameters changed in game, created from the light data.
+  DRWGameLight *EnsureGameLight();
+  /// Count a change of the parameters and redraw the scene.
+  void TagGameLightChange();
 
  public:
   KX_LightObject();
@@ -57,10 +65,56 @@ class KX_LightObject : public KX_GameObject {
   }
 
   Light *GetLight();
+  /// Return the parameters changed in game, nullptr if the light data is used.
+  const DRWGameLight *GetGameLight() const;
+
+  float GetEnergy() const;
+  MT_Vector3 GetColor() const;
+  /// Return the influence distance, 0 for the distance of the scene light threshold.
+  float GetDistance() const;
+  float GetSpotSize() const;
+  float GetSpotBlend() const;
+  /** Return the distance at which the light is under the scene light threshold, the distance
+   * used by EEVEE to cull the light.
+   */
+  float GetInfluenceRadius();
+  bool IsSun() const;
+
+  /* The parameters are changed without depsgraph update, the light data of the instances
+   * sharing it is unchanged. */
+  void SetEnergy(float energy);
+  void SetColor(const MT_Vector3 &color);
+  void SetDistance(float distance);
+  void SetSpotSize(float size);
+  void SetSpotBlend(float blend);
 
   virtual void SetBlenderObject(Object *obj);
 
 #ifdef WITH_PYTHON
   static PyObject *game_object_new(PyTypeObject *type, PyObject *args, PyObject *kwds);
+
+  static PyObject *pyattr_get_energy(EXP_PyObjectPlus *self_v, const EXP_PYATTRIBUTE_DEF *attrdef);
+  static int pyattr_set_energy(EXP_PyObjectPlus *self_v,
+                               const EXP_PYATTRIBUTE_DEF *attrdef,
+                               PyObject *value);
+  static PyObject *pyattr_get_color(EXP_PyObjectPlus *self_v, const EXP_PYATTRIBUTE_DEF *attrdef);
+  static int pyattr_set_color(EXP_PyObjectPlus *self_v,
+                              const EXP_PYATTRIBUTE_DEF *attrdef,
+                              PyObject *value);
+  static PyObject *pyattr_get_distance(EXP_PyObjectPlus *self_v,
+                                       const EXP_PYATTRIBUTE_DEF *attrdef);
+  static int pyattr_set_distance(EXP_PyObjectPlus *self_v,
+                                 const EXP_PYATTRIBUTE_DEF *attrdef,
+                                 PyObject *value);
+  static PyObject *pyattr_get_spot_size(EXP_PyObjectPlus *self_v,
+                                        const EXP_PYATTRIBUTE_DEF *attrdef);
+  static int pyattr_set_spot_size(EXP_PyObjectPlus *self_v,
+                                  const EXP_PYATTRIBUTE_DEF *attrdef,
+                                  PyObject *value);
+  static PyObject *pyattr_get_spot_blend(EXP_PyObjectPlus *self_v,
+                                         const EXP_PYATTRIBUTE_DEF *attrdef);
+  static int pyattr_set_spot_blend(EXP_PyObjectPlus *self_v,
+                                   const EXP_PYATTRIBUTE_DEF *attrdef,
+                                   PyObject *value);
 #endif
 };
@@ -0,0 +1,113 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Ketsji/KX_LightManager.cpp
+ *  \ingroup ketsji
+ */
+
+#include "KX_LightManager.h"
+
+#include <algorithm>
+#include <cfloat>
+
+#include "BLI_ghash.h"
+#include "DRW_render.h"
+
+#include "KX_Camera.h"
+#include "KX_Light.h"
+#include "KX_Scene.h"
+
+KX_LightManager::KX_LightManager(KX_Scene *scene)
+    : m_scene(scene), m_gameLights(BLI_ghash_ptr_new(__func__))
+{
+}
+
+KX_LightManager::~KX_LightManager()
+{
+  BLI_ghash_free(m_gameLights, nullptr, nullptr);
+}
+
+GHash *KX_LightManager::UpdateGameLights()
+{
+  BLI_ghash_clear(m_gameLights, nullptr, nullptr);
+  for (KX_LightObject *light : m_scene->GetLightList()) {
+    const DRWGameLight *gameLight = light->GetGameLight();
+    if (gameLight) {
+      BLI_ghash_insert(m_gameLights, light->GetBlenderObject(), (void *)gameLight);
+    }
+  }
+
+  return (BLI_ghash_len(m_gameLights) != 0) ? m_gameLights : nullptr;
+}
+
+void KX_LightManager::Cull(const std::vector<KX_Camera *> &cameras,
+                           unsigned int budget,
+                           GSet *culledObjects)
+{
+  struct Candidate {
+    float m_score;
+    Object *m_object;
+  };
+  std::vector<Candidate> candidates;
+  unsigned int numSuns = 0;
+
+  for (KX_LightObject *light : m_scene->GetLightList()) {
+    // EEVEE skips the lights without power, they don't use the budget.
+    if (!light->GetVisible() || light->GetEnergy() == 0.0f) {
+      continue;
+    }
+    if (light->IsSun()) {
+      ++numSuns;
+      continue;
+    }
+
+    const MT_Vector3 &position = light->NodeGetWorldPosition();
+    const float radius = light->GetInfluenceRadius();
+    // The size of the influence sphere on screen of the closest view, -1 outside of the views.
+    float score = -1.0f;
+    for (KX_Camera *cam : cameras) {
+      if (cam->GetFrustum().SphereInsideFrustum(position, radius) == SG_Frustum::OUTSIDE) {
+        continue;
+      }
+      const float distance = (position - cam->NodeGetWorldPosition()).length();
+      score = std::max(score, (distance > radius) ? radius / distance : FLT_MAX);
+    }
+
+    if (score < 0.0f) {
+      BLI_gset_add(culledObjects, light->GetBlenderObject());
+    }
+    else {
+      candidates.push_back({score, light->GetBlenderObject()});
+    }
+  }
+
+  const unsigned int maxLights = (budget > numSuns) ? budget - numSuns : 0;
+  if (candidates.size() <= maxLights) {
+    return;
+  }
+
+  std::nth_element(candidates.begin(),
+                   candidates.begin() + maxLights,
+                   candidates.end(),
+                   [](const Candidate &a, const Candidate &b) { return a.m_score > b.m_score; });
+  for (unsigned int i = maxLights, size = candidates.size(); i < size; ++i) {
+    BLI_gset_add(culledObjects, candidates[i].m_object);
+  }
+}
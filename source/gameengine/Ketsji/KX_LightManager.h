@@ -0,0 +1,57 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file KX_LightManager.h
+ *  \ingroup ketsji
+ */
+
+#pragma once
+
+#include <vector>
+
+class KX_Camera;
+class KX_Scene;
+struct GHash;
+struct GSet;
+
+/** Lights of a scene seen by the render loops. The parameters of the lights changed in game are
+ * passed to EEVEE which fills its light buffer with them at each render, without depsgraph
+ * update. Over a budget of lights, the lights outside of the views and then the smallest on
+ * screen are culled, from the EEVEE light limit all the lights after it are dropped otherwise.
+ */
+class KX_LightManager {
+ private:
+  KX_Scene *m_scene;
+  /// Original light objects changed in game mapped to their DRWGameLight.
+  GHash *m_gameLights;
+
+ public:
+  KX_LightManager(KX_Scene *scene);
+  ~KX_LightManager();
+
+  /** Gather the parameters of the lights changed in game for the next render.
+   * \return The lights for DRW_game_lights_set, nullptr if no light changed.
+   */
+  GHash *UpdateGameLights();
+  /** Add to the culled objects the lights of which the influence is outside of all the views,
+   * then the lights the smallest on screen until the budget is met. The suns are always drawn.
+   */
+  void Cull(const std::vector<KX_Camera *> &cameras, unsigned int budget, GSet *culledObjects);
+};
@@ -26,6 +26,8 @@
 
 #include "KX_LodManager.h"
 
+#include <cfloat>
+
 #include "BLI_listbase.h"
 #include "BLI_math.h"
 #include "DNA_object_types.h"
@@ -78,6 +80,21 @@ inline short KX_LodManager::LodLevelIterator::operator*() const
   return m_index;
 }
 
+inline float KX_LodManager::LodLevelIterator::GetMinDistance2() const
+{
+  return square_f(m_levels[m_index]->GetDistance() - GetHysteresis(m_index));
+}
+
+inline float KX_LodManager::LodLevelIterator::GetMaxDistance2() const
+{
+  // The last level doesn't have a next level, then the maximum distance is infinite.
+  if (m_index == (m_levels.size() - 1)) {
+    return FLT_MAX;
+  }
+
+  return square_f(m_levels[m_index + 1]->GetDistance() + GetHysteresis(m_index + 1));
+}
+
 inline bool KX_LodManager::LodLevelIterator::operator<=(float distance2) const
 {
   // The last level doesn't have a next level, then the maximum distance is infinite and should
@@ -86,12 +103,12 @@ inline bool KX_LodManager::LodLevelIterator::operator<=(float distance2) const
     return false;
   }
 
-  return square_f(m_levels[m_index + 1]->GetDistance() + GetHysteresis(m_index + 1)) <= distance2;
+  return GetMaxDistance2() <= distance2;
 }
 
 inline bool KX_LodManager::LodLevelIterator::operator>(float distance2) const
 {
-  return square_f(m_levels[m_index]->GetDistance() - GetHysteresis(m_index)) > distance2;
+  return GetMinDistance2() > distance2;
 }
 
 KX_LodManager::KX_LodManager(Object *ob,
@@ -194,6 +211,26 @@ KX_LodLevel *KX_LodManager::GetLevel(KX_Scene *scene, short previouslod, float d
   return (level == previouslod) ? nullptr : m_levels[level];
 }
 
+void KX_LodManager::GetLevelDistanceRange(KX_Scene *scene,
+                                          short level,
+                                          float &mindistance2,
+                                          float &maxdistance2)
+{
+  // A single level or a null factor always give the same level.
+  if (m_levels.size() == 1 || m_distanceFactor == 0.0f) {
+    mindistance2 = 0.0f;
+    maxdistance2 = FLT_MAX;
+    return;
+  }
+
+  const LodLevelIterator it(m_levels, level, scene);
+  const float factor2 = m_distanceFactor * m_distanceFactor;
+
+  mindistance2 = it.GetMinDistance2() / factor2;
+  const float maxlevel2 = it.GetMaxDistance2();
+  maxdistance2 = (maxlevel2 == FLT_MAX) ? FLT_MAX : maxlevel2 / factor2;
+}
+
 #ifdef WITH_PYTHON
 
 PyTypeObject KX_LodManager::Type = {PyVarObject_HEAD_INIT(nullptr, 0) "KX_LodManager",
@@ -59,6 +59,10 @@ class KX_LodManager : public EXP_Value {
     int operator++();
     int operator--();
     short operator*() const;
+    /// Return the squared current level distance less hysteresis.
+    float GetMinDistance2() const;
+    /// Return the squared next level distance more hysteresis, FLT_MAX for the last level.
+    float GetMaxDistance2() const;
     /// Compare next level distance more hysteresis with current distance.
     bool operator<=(float distance2) const;
     /// Compare the current lod level distance less hysteresis with current distance.
@@ -106,6 +110,19 @@ class KX_LodManager : public EXP_Value {
    */
   KX_LodLevel *GetLevel(KX_Scene *scene, short previouslod, float distance);
 
+  /** Get the range of squared distances keeping a lod level selected.
+   * While the distance stays in [mindistance2, maxdistance2[ the function
+   * GetLevel(scene, level, distance2) returns nullptr and doesn't need to be called.
+   * \param scene Scene used to get default hysteresis.
+   * \param level The current lod level.
+   * \param mindistance2 Returned minimum squared distance.
+   * \param maxdistance2 Returned maximum squared distance.
+   */
+  void GetLevelDistanceRange(KX_Scene *scene,
+                             short level,
+                             float &mindistance2,
+                             float &maxdistance2);
+
 #ifdef WITH_PYTHON
 
   static PyObject *pyattr_get_levels(EXP_PyObjectPlus *self_v, const EXP_PYATTRIBUTE_DEF *attrdef);
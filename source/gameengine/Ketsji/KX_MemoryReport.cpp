@@ -0,0 +1,71 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Ketsji/KX_MemoryReport.cpp
+ *  \ingroup ketsji
+ */
+
+#include "KX_MemoryReport.h"
+
+const std::string KX_MemoryReport::m_categoryLabels[MEM_NUM_CATEGORIES] = {
+    "Objects",         // MEM_OBJECTS
+    "Scene Graph",     // MEM_SCENE_GRAPH
+    "Logic Bricks",    // MEM_LOGIC_BRICKS
+    "Physics",         // MEM_PHYSICS_CONTROLLERS
+    "Physics Shapes",  // MEM_PHYSICS_SHAPES
+    "Meshes",          // MEM_MESHES
+    "Textures",        // MEM_TEXTURES
+    "Viewports",       // MEM_VIEWPORTS
+    "Video Textures",  // MEM_VIDEO_TEXTURES
+    "Python",          // MEM_PYTHON
+};
+
+KX_MemoryReport::KX_MemoryReport()
+{
+  for (Entry &entry : m_entries) {
+    entry = {0, 0};
+  }
+}
+
+KX_MemoryReport::~KX_MemoryReport()
+{
+}
+
+void KX_MemoryReport::Add(Category category, size_t count, size_t bytes)
+{
+  m_entries[category].m_count += count;
+  m_entries[category].m_bytes += bytes;
+}
+
+const KX_MemoryReport::Entry &KX_MemoryReport::GetEntry(Category category) const
+{
+  return m_entries[category];
+}
+
+size_t KX_MemoryReport::GetTotalBytes() const
+{
+  size_t bytes = 0;
+  for (const Entry &entry : m_entries) {
+    bytes += entry.m_bytes;
+  }
+  return bytes;
+}
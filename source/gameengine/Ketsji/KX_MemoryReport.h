@@ -0,0 +1,67 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file KX_MemoryReport.h
+ *  \ingroup ketsji
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+/// Count and size in bytes of the data allocated by each subsystem of the engine.
+class KX_MemoryReport {
+ public:
+  enum Category {
+    MEM_OBJECTS = 0,
+    MEM_SCENE_GRAPH,
+    MEM_LOGIC_BRICKS,
+    MEM_PHYSICS_CONTROLLERS,
+    MEM_PHYSICS_SHAPES,
+    MEM_MESHES,
+    MEM_TEXTURES,
+    MEM_VIEWPORTS,
+    MEM_VIDEO_TEXTURES,
+    MEM_PYTHON,
+    MEM_NUM_CATEGORIES
+  };
+
+  struct Entry {
+    size_t m_count;
+    size_t m_bytes;
+  };
+
+  static const std::string m_categoryLabels[MEM_NUM_CATEGORIES];
+
+ private:
+  Entry m_entries[MEM_NUM_CATEGORIES];
+
+ public:
+  KX_MemoryReport();
+  ~KX_MemoryReport();
+
+  void Add(Category category, size_t count, size_t bytes);
+  const Entry &GetEntry(Category category) const;
+  /// Return the sum of the sizes of all the categories.
+  size_t GetTotalBytes() const;
+};
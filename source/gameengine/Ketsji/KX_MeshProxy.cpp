@@ -33,6 +33,11 @@
 
 #  include "KX_MeshProxy.h"
 
+#  include "BLI_math_vector.h"
+#  include "DNA_mesh_types.h"
+#  include "DNA_meshdata_types.h"
+
+#  include "BL_BlenderDataConversion.h"
 #  include "EXP_ListWrapper.h"
 #  include "EXP_PyObjectPlus.h"
 #  include "KX_BlenderMaterial.h"
@@ -93,6 +98,8 @@ PyMethodDef KX_MeshProxy::Methods[] = {
     {"transform", (PyCFunction)KX_MeshProxy::sPyTransform, METH_VARARGS},
     {"transformUV", (PyCFunction)KX_MeshProxy::sPyTransformUV, METH_VARARGS},
     {"replaceMaterial", (PyCFunction)KX_MeshProxy::sPyReplaceMaterial, METH_VARARGS},
+    {"getVertexBuffer", (PyCFunction)KX_MeshProxy::sPyGetVertexBuffer, METH_VARARGS},
+    {"commitVertexBuffer", (PyCFunction)KX_MeshProxy::sPyCommitVertexBuffer, METH_VARARGS},
     {nullptr, nullptr}  // Sentinel
 };
 
@@ -107,6 +114,8 @@ PyAttributeDef KX_MeshProxy::Attributes[] = {
 
 KX_MeshProxy::KX_MeshProxy(RAS_MeshObject *mesh) : EXP_Value(), m_meshobj(mesh)
 {
+  // The proxy gives access to the vertices and the polygons.
+  BL_ConvertMeshGeometry(m_meshobj);
 }
 
 KX_MeshProxy::~KX_MeshProxy()
@@ -380,6 +389,191 @@ PyObject *KX_MeshProxy::PyReplaceMaterial(PyObject *args, PyObject *kwds)
   Py_RETURN_NONE;
 }
 
+/// A vertex layer of a display array, the vertices are stored interleaved.
+struct KX_VertexLayer {
+  RAS_IDisplayArray *array;
+  intptr_t offset;
+  unsigned short components;
+  Py_ssize_t itemsize;
+  const char *format;
+  unsigned short modifiedFlag;
+};
+
+static bool kx_mesh_vertex_layer(RAS_MeshObject *meshobj,
+                                 int matindex,
+                                 const char *layer,
+                                 int layerindex,
+                                 const char *errprefix,
+                                 KX_VertexLayer &r_layer)
+{
+  RAS_IDisplayArray *array = meshobj->GetDisplayArray(matindex);
+  if (!array) {
+    PyErr_Format(PyExc_ValueError, "%s: invalid material index %d", errprefix, matindex);
+    return false;
+  }
+
+  r_layer.array = array;
+  r_layer.itemsize = sizeof(float);
+  r_layer.format = "f";
+  if (STREQ(layer, "position")) {
+    r_layer.offset = array->GetVertexXYZOffset();
+    r_layer.components = 3;
+    r_layer.modifiedFlag = RAS_IDisplayArray::POSITION_MODIFIED;
+  }
+  else if (STREQ(layer, "normal")) {
+    r_layer.offset = array->GetVertexNormalOffset();
+    r_layer.components = 3;
+    r_layer.modifiedFlag = RAS_IDisplayArray::NORMAL_MODIFIED;
+  }
+  else if (STREQ(layer, "tangent")) {
+    r_layer.offset = array->GetVertexTangentOffset();
+    r_layer.components = 4;
+    r_layer.modifiedFlag = RAS_IDisplayArray::TANGENT_MODIFIED;
+  }
+  else if (STREQ(layer, "uv")) {
+    if (layerindex < 0 || layerindex >= array->GetVertexUvSize()) {
+      PyErr_Format(PyExc_ValueError, "%s: invalid uv layer index %d", errprefix, layerindex);
+      return false;
+    }
+    r_layer.offset = array->GetVertexUVOffset() + layerindex * sizeof(float[2]);
+    r_layer.components = 2;
+    r_layer.modifiedFlag = RAS_IDisplayArray::UVS_MODIFIED;
+  }
+  else if (STREQ(layer, "color")) {
+    if (layerindex < 0 || layerindex >= array->GetVertexColorSize()) {
+      PyErr_Format(PyExc_ValueError, "%s: invalid color layer index %d", errprefix, layerindex);
+      return false;
+    }
+    r_layer.offset = array->GetVertexColorOffset() + layerindex * sizeof(unsigned int);
+    r_layer.components = 4;
+    r_layer.itemsize = sizeof(unsigned char);
+    r_layer.format = "B";
+    r_layer.modifiedFlag = RAS_IDisplayArray::COLORS_MODIFIED;
+  }
+  else {
+    PyErr_Format(PyExc_ValueError,
+                 "%s: invalid layer \"%s\", expected \"position\", \"normal\", \"tangent\", "
+                 "\"uv\" or \"color\"",
+                 errprefix,
+                 layer);
+    return false;
+  }
+
+  return true;
+}
+
+PyObject *KX_MeshProxy::PyGetVertexBuffer(PyObject *args, PyObject *kwds)
+{
+  int matindex;
+  const char *layer;
+  int layerindex = 0;
+
+  if (!PyArg_ParseTuple(args, "is|i:getVertexBuffer", &matindex, &layer, &layerindex)) {
+    return nullptr;
+  }
+
+  KX_VertexLayer vlayer;
+  if (!kx_mesh_vertex_layer(
+          m_meshobj, matindex, layer, layerindex, "mesh.getVertexBuffer(...)", vlayer)) {
+    return nullptr;
+  }
+
+  /* The layer is copied contiguously, a view over the vertex array would outlive
+   * the mesh freed by a scene or a library. */
+  RAS_IDisplayArray *array = vlayer.array;
+  const unsigned int count = array->GetVertexCount();
+  const unsigned int vertexSize = array->GetVertexMemorySize();
+  const Py_ssize_t layerSize = vlayer.components * vlayer.itemsize;
+
+  PyObject *bytes = PyByteArray_FromStringAndSize(nullptr, count * layerSize);
+  if (!bytes) {
+    return nullptr;
+  }
+
+  char *dst = PyByteArray_AS_STRING(bytes);
+  const char *src = (const char *)array->GetVertexPointer() + vlayer.offset;
+  for (unsigned int i = 0; i < count; ++i) {
+    memcpy(dst + i * layerSize, src + i * vertexSize, layerSize);
+  }
+
+  PyObject *view = PyMemoryView_FromObject(bytes);
+  Py_DECREF(bytes);
+  if (!view) {
+    return nullptr;
+  }
+
+  PyObject *result = PyObject_CallMethod(
+      view, "cast", "s(II)", vlayer.format, count, (unsigned int)vlayer.components);
+  Py_DECREF(view);
+  return result;
+}
+
+PyObject *KX_MeshProxy::PyCommitVertexBuffer(PyObject *args, PyObject *kwds)
+{
+  int matindex;
+  const char *layer;
+  PyObject *pybuffer;
+  int layerindex = 0;
+
+  if (!PyArg_ParseTuple(
+          args, "isO|i:commitVertexBuffer", &matindex, &layer, &pybuffer, &layerindex)) {
+    return nullptr;
+  }
+
+  KX_VertexLayer vlayer;
+  if (!kx_mesh_vertex_layer(
+          m_meshobj, matindex, layer, layerindex, "mesh.commitVertexBuffer(...)", vlayer)) {
+    return nullptr;
+  }
+
+  Py_buffer buffer;
+  if (PyObject_GetBuffer(pybuffer, &buffer, PyBUF_C_CONTIGUOUS) == -1) {
+    return nullptr;
+  }
+
+  RAS_IDisplayArray *array = vlayer.array;
+  const unsigned int count = array->GetVertexCount();
+  const unsigned int vertexSize = array->GetVertexMemorySize();
+  const Py_ssize_t layerSize = vlayer.components * vlayer.itemsize;
+
+  if (buffer.len != count * layerSize) {
+    PyErr_Format(PyExc_ValueError,
+                 "mesh.commitVertexBuffer(...): expected a buffer of %zd bytes, got %zd bytes",
+                 count * layerSize,
+                 buffer.len);
+    PyBuffer_Release(&buffer);
+    return nullptr;
+  }
+
+  const char *src = (const char *)buffer.buf;
+  char *dst = (char *)array->GetVertexPointer() + vlayer.offset;
+  for (unsigned int i = 0; i < count; ++i) {
+    memcpy(dst + i * vertexSize, src + i * layerSize, layerSize);
+  }
+  PyBuffer_Release(&buffer);
+
+  array->AppendModifiedFlag(vlayer.modifiedFlag);
+
+  /* The rendered mesh is evaluated from the blender mesh, the positions are copied to its
+   * vertices and its geometry is updated at the next render, the normals are recomputed
+   * from them. The other layers are only used by the game engine. */
+  Mesh *me = m_meshobj->GetOrigMesh();
+  if (vlayer.modifiedFlag == RAS_IDisplayArray::POSITION_MODIFIED && me && me->mvert) {
+    for (unsigned int i = 0; i < count; ++i) {
+      const unsigned int origindex = array->GetVertexInfo(i).getOrigIndex();
+      if (origindex < (unsigned int)me->totvert) {
+        copy_v3_v3(me->mvert[origindex].co, array->GetVertex(i)->getXYZ());
+      }
+    }
+
+    RAS_MeshMaterial *meshmat = m_meshobj->GetMeshMaterial(matindex);
+    KX_Scene *scene = (KX_Scene *)meshmat->GetBucket()->GetPolyMaterial()->GetScene();
+    scene->AppendToMeshesToUpdateInAllRenderPasses(me, ID_RECALC_GEOMETRY);
+  }
+
+  Py_RETURN_NONE;
+}
+
 PyObject *KX_MeshProxy::pyattr_get_materials(EXP_PyObjectPlus *self_v,
                                              const EXP_PYATTRIBUTE_DEF *attrdef)
 {
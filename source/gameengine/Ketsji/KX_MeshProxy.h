@@ -76,6 +76,8 @@ class KX_MeshProxy : public EXP_Value {
   EXP_PYMETHOD(KX_MeshProxy, Transform);
   EXP_PYMETHOD(KX_MeshProxy, TransformUV);
   EXP_PYMETHOD(KX_MeshProxy, ReplaceMaterial);
+  EXP_PYMETHOD(KX_MeshProxy, GetVertexBuffer);
+  EXP_PYMETHOD(KX_MeshProxy, CommitVertexBuffer);
 
   static PyObject *pyattr_get_materials(EXP_PyObjectPlus *self_v,
                                         const EXP_PYATTRIBUTE_DEF *attrdef);
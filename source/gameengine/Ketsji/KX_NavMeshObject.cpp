@@ -27,6 +27,8 @@
 
 #include "KX_NavMeshObject.h"
 
+#include <algorithm>
+
 #include "BKE_cdderivedmesh.h"
 #include "BKE_context.h"
 #include "BLI_sort.h"
@@ -39,11 +41,15 @@
 #include "KX_Globals.h"
 #include "KX_ObstacleSimulation.h"
 #include "KX_PyMath.h"
+#include "KX_Scene.h"
+#include "KX_TaskFuture.h"
 #include "RAS_IVertex.h"
 #include "RAS_Polygon.h"
 #include "Recast.h"
 
 #define MAX_PATH_LEN 256
+/// Number of corridors kept by the path cache of a navigation mesh.
+#define PATH_CACHE_SIZE 64
 static const float polyPickExt[3] = {2, 4, 2};
 
 static void calcMeshBounds(const float *vert, int nverts, float *bmin, float *bmax)
@@ -572,7 +578,7 @@ static int polyFindVertex(const unsigned short *p,
   return res;
 }
 
-KX_NavMeshObject::KX_NavMeshObject() : KX_GameObject(), m_navMesh(nullptr)
+KX_NavMeshObject::KX_NavMeshObject() : KX_GameObject(), m_navMesh(nullptr), m_pathCacheTime(0)
 {
 }
 
@@ -780,53 +786,73 @@ bool KX_NavMeshObject::BuildVertIndArrays(float *&vertices,
   return true;
 }
 
-bool KX_NavMeshObject::BuildNavMesh()
+KX_NavMeshObject::BuildData::BuildData()
+    : vertices(nullptr),
+      nverts(0),
+      polys(nullptr),
+      npolys(0),
+      dmeshes(nullptr),
+      dvertices(nullptr),
+      ndvertsuniq(0),
+      dtris(nullptr),
+      ndtris(0),
+      vertsPerPoly(0)
 {
-  if (m_navMesh) {
-    delete m_navMesh;
-    m_navMesh = nullptr;
+}
+
+KX_NavMeshObject::BuildData::~BuildData()
+{
+  if (vertices) {
+    delete[] vertices;
+  }
+  if (dvertices) {
+    delete[] dvertices;
+  }
+  /* navmesh conversion is using C guarded alloc for memory allocaitons */
+  if (polys) {
+    MEM_freeN(polys);
+  }
+  if (dmeshes) {
+    MEM_freeN(dmeshes);
   }
+  if (dtris) {
+    MEM_freeN(dtris);
+  }
+}
 
+bool KX_NavMeshObject::ReadBuildData(BuildData &source)
+{
   if (GetMeshCount() == 0) {
     CM_Error("can't find mesh for navmesh object: " << m_name);
     return false;
   }
 
-  float *vertices = nullptr, *dvertices = nullptr;
-  unsigned short *polys = nullptr, *dtris = nullptr, *dmeshes = nullptr;
-  int nverts = 0, npolys = 0, ndvertsuniq = 0, ndtris = 0;
-  int vertsPerPoly = 0;
-  if (!BuildVertIndArrays(vertices,
-                          nverts,
-                          polys,
-                          npolys,
-                          dmeshes,
-                          dvertices,
-                          ndvertsuniq,
-                          dtris,
-                          ndtris,
-                          vertsPerPoly) ||
-      vertsPerPoly < 3) {
+  if (!BuildVertIndArrays(source.vertices,
+                          source.nverts,
+                          source.polys,
+                          source.npolys,
+                          source.dmeshes,
+                          source.dvertices,
+                          source.ndvertsuniq,
+                          source.dtris,
+                          source.ndtris,
+                          source.vertsPerPoly) ||
+      source.vertsPerPoly < 3) {
     CM_Error("can't build navigation mesh data for object: " << m_name);
-    if (vertices) {
-      delete[] vertices;
-    }
-    if (dvertices) {
-      delete[] dvertices;
-    }
-    if (polys) {
-      MEM_freeN(polys);
-    }
-    if (dmeshes) {
-      MEM_freeN(dmeshes);
-    }
-    if (dtris) {
-      MEM_freeN(dtris);
-    }
     return false;
   }
 
-  MT_Vector3 pos;
+  return true;
+}
+
+dtStatNavMesh *KX_NavMeshObject::CreateNavMesh(BuildData &source)
+{
+  float *vertices = source.vertices, *dvertices = source.dvertices;
+  unsigned short *polys = source.polys, *dtris = source.dtris, *dmeshes = source.dmeshes;
+  const int nverts = source.nverts, npolys = source.npolys;
+  const int ndvertsuniq = source.ndvertsuniq, ndtris = source.ndtris;
+  const int vertsPerPoly = source.vertsPerPoly;
+
   if (dmeshes == nullptr) {
     for (int i = 0; i < nverts; i++) {
       flipAxes(&vertices[i * 3]);
@@ -838,43 +864,13 @@ bool KX_NavMeshObject::BuildNavMesh()
 
   if (!buildMeshAdjacency(polys, npolys, nverts, vertsPerPoly)) {
     CM_FunctionError("unable to build mesh adjacency information.");
-    if (vertices) {
-      delete[] vertices;
-    }
-    if (dvertices) {
-      delete[] dvertices;
-    }
-    if (polys) {
-      MEM_freeN(polys);
-    }
-    if (dmeshes) {
-      MEM_freeN(dmeshes);
-    }
-    if (dtris) {
-      MEM_freeN(dtris);
-    }
-    return false;
+    return nullptr;
   }
 
   float cs = 0.2f;
 
   if (!nverts || !npolys) {
-    if (vertices) {
-      delete[] vertices;
-    }
-    if (dvertices) {
-      delete[] dvertices;
-    }
-    if (polys) {
-      MEM_freeN(polys);
-    }
-    if (dmeshes) {
-      MEM_freeN(dmeshes);
-    }
-    if (dtris) {
-      MEM_freeN(dtris);
-    }
-    return false;
+    return nullptr;
   }
 
   float bmin[3], bmax[3];
@@ -998,25 +994,46 @@ bool KX_NavMeshObject::BuildNavMesh()
     }
   }
 
-  m_navMesh = new dtStatNavMesh;
-  m_navMesh->init(data, dataSize, true);
+  dtStatNavMesh *navmesh = new dtStatNavMesh;
+  navmesh->init(data, dataSize, true);
 
-  delete[] vertices;
+  if (vertsi)
+    delete[] vertsi;
 
-  /* navmesh conversion is using C guarded alloc for memory allocaitons */
-  MEM_freeN(polys);
-  if (dmeshes)
-    MEM_freeN(dmeshes);
-  if (dtris)
-    MEM_freeN(dtris);
+  return navmesh;
+}
 
-  if (dvertices)
-    delete[] dvertices;
+bool KX_NavMeshObject::BuildNavMesh()
+{
+  BuildData source;
+  if (!ReadBuildData(source)) {
+    SetNavMesh(nullptr);
+    return false;
+  }
 
-  if (vertsi)
-    delete[] vertsi;
+  dtStatNavMesh *navmesh = CreateNavMesh(source);
+  SetNavMesh(navmesh);
+  return (navmesh != nullptr);
+}
 
-  return true;
+void KX_NavMeshObject::SetNavMesh(dtStatNavMesh *navmesh)
+{
+  m_pathCache.clear();
+  m_pathCacheIndices.clear();
+
+  if (m_navMesh) {
+    delete m_navMesh;
+  }
+  m_navMesh = navmesh;
+}
+
+void KX_NavMeshObject::UpdateObstacles()
+{
+  KX_ObstacleSimulation *obssimulation = GetScene()->GetObstacleSimulation();
+  if (obssimulation) {
+    obssimulation->DestroyObstacleForObj(this);
+    obssimulation->AddObstaclesForNavMesh(this);
+  }
 }
 
 dtStatNavMesh *KX_NavMeshObject::GetNavMesh()
@@ -1083,37 +1100,97 @@ void KX_NavMeshObject::DrawNavMesh(NavMeshRenderMode renderMode)
   }
 }
 
-MT_Vector3 KX_NavMeshObject::TransformToLocalCoords(const MT_Vector3 &wpos)
+MT_Transform KX_NavMeshObject::GetNavMeshTransform()
 {
   MT_Matrix3x3 orientation = NodeGetWorldOrientation();
   const MT_Vector3 &scaling = NodeGetWorldScaling();
   orientation.scale(scaling[0], scaling[1], scaling[2]);
-  MT_Transform worldtr(NodeGetWorldPosition(), orientation);
+  return MT_Transform(NodeGetWorldPosition(), orientation);
+}
+
+MT_Vector3 KX_NavMeshObject::TransformToLocalCoords(const MT_Vector3 &wpos)
+{
   MT_Transform invworldtr;
-  invworldtr.invert(worldtr);
+  invworldtr.invert(GetNavMeshTransform());
   MT_Vector3 lpos = invworldtr(wpos);
   return lpos;
 }
 
 MT_Vector3 KX_NavMeshObject::TransformToWorldCoords(const MT_Vector3 &lpos)
 {
-  MT_Matrix3x3 orientation = NodeGetWorldOrientation();
-  const MT_Vector3 &scaling = NodeGetWorldScaling();
-  orientation.scale(scaling[0], scaling[1], scaling[2]);
-  MT_Transform worldtr(NodeGetWorldPosition(), orientation);
-  MT_Vector3 wpos = worldtr(lpos);
+  MT_Vector3 wpos = GetNavMeshTransform()(lpos);
   return wpos;
 }
 
+int KX_NavMeshObject::FindPathPolys(dtStatPolyRef sPolyRef,
+                                    dtStatPolyRef ePolyRef,
+                                    const float *spos,
+                                    const float *epos,
+                                    dtStatPolyRef *polys,
+                                    int maxPathLen)
+{
+  const PathCacheKey key = {sPolyRef, ePolyRef};
+  ++m_pathCacheTime;
+
+  unsigned int index;
+  const auto it = m_pathCacheIndices.find(key);
+  if (it != m_pathCacheIndices.end()) {
+    index = it->second;
+    PathCacheEntry &entry = m_pathCache[index];
+    // A truncated corridor can't answer a longer search.
+    if ((int)entry.m_polys.size() < entry.m_maxPathLen || maxPathLen <= entry.m_maxPathLen) {
+      const int npolys = std::min((int)entry.m_polys.size(), maxPathLen);
+      std::copy_n(entry.m_polys.begin(), npolys, polys);
+      entry.m_lastUse = m_pathCacheTime;
+      return npolys;
+    }
+  }
+  else if (m_pathCache.size() < PATH_CACHE_SIZE) {
+    index = m_pathCache.size();
+    m_pathCache.emplace_back();
+  }
+  else {
+    index = 0;
+    for (unsigned int i = 1; i < m_pathCache.size(); ++i) {
+      if (m_pathCache[i].m_lastUse < m_pathCache[index].m_lastUse) {
+        index = i;
+      }
+    }
+    m_pathCacheIndices.erase(m_pathCache[index].m_key);
+  }
+
+  const int npolys = m_navMesh->findPath(sPolyRef, ePolyRef, spos, epos, polys, maxPathLen);
+
+  PathCacheEntry &entry = m_pathCache[index];
+  entry.m_key = key;
+  entry.m_polys.assign(polys, polys + npolys);
+  entry.m_maxPathLen = maxPathLen;
+  entry.m_lastUse = m_pathCacheTime;
+  m_pathCacheIndices[key] = index;
+
+  return npolys;
+}
+
 int KX_NavMeshObject::FindPath(const MT_Vector3 &from,
                                const MT_Vector3 &to,
                                float *path,
                                int maxPathLen)
+{
+  return FindPath(GetNavMeshTransform(), from, to, path, maxPathLen);
+}
+
+int KX_NavMeshObject::FindPath(const MT_Transform &worldtr,
+                               const MT_Vector3 &from,
+                               const MT_Vector3 &to,
+                               float *path,
+                               int maxPathLen)
 {
   if (!m_navMesh)
     return 0;
-  MT_Vector3 localfrom = TransformToLocalCoords(from);
-  MT_Vector3 localto = TransformToLocalCoords(to);
+  MT_Transform invworldtr;
+  invworldtr.invert(worldtr);
+  MT_Vector3 localfrom = invworldtr(from);
+  MT_Vector3 localto = invworldtr(to);
   float spos[3], epos[3];
   localfrom.getValue(spos);
   flipAxes(spos);
@@ -1126,13 +1203,13 @@ int KX_NavMeshObject::FindPath(const MT_Vector3 &from,
   if (sPolyRef && ePolyRef) {
     dtStatPolyRef *polys = new dtStatPolyRef[maxPathLen];
     int npolys;
-    npolys = m_navMesh->findPath(sPolyRef, ePolyRef, spos, epos, polys, maxPathLen);
+    npolys = FindPathPolys(sPolyRef, ePolyRef, spos, epos, polys, maxPathLen);
     if (npolys) {
       pathLen = m_navMesh->findStraightPath(spos, epos, polys, npolys, path, maxPathLen);
       for (int i = 0; i < pathLen; i++) {
         flipAxes(&path[i * 3]);
         MT_Vector3 waypoint(&path[i * 3]);
-        waypoint = TransformToWorldCoords(waypoint);
+        waypoint = worldtr(waypoint);
         waypoint.getValue(&path[i * 3]);
       }
     }
@@ -1232,9 +1309,11 @@ PyAttributeDef KX_NavMeshObject::Attributes[] = {
 // EXP_PYMETHODTABLE_NOARGS(KX_GameObject, getD),
 PyMethodDef KX_NavMeshObject::Methods[] = {
     EXP_PYMETHODTABLE(KX_NavMeshObject, findPath),
+    EXP_PYMETHODTABLE(KX_NavMeshObject, findPathAsync),
     EXP_PYMETHODTABLE(KX_NavMeshObject, raycast),
     EXP_PYMETHODTABLE(KX_NavMeshObject, draw),
     EXP_PYMETHODTABLE(KX_NavMeshObject, rebuild),
+    EXP_PYMETHODTABLE_NOARGS(KX_NavMeshObject, rebuildAsync),
     {nullptr, nullptr}  // Sentinel
 };
 
@@ -1261,6 +1340,77 @@ EXP_PYMETHODDEF_DOC(KX_NavMeshObject,
   return pathList;
 }
 
+/** Future of findPathAsync, the navigation mesh is used by only one task at a time
+ * as its queries modify its nodes.
+ */
+class KX_NavMeshPathFuture : public KX_TaskFuture {
+ private:
+  KX_NavMeshObject *m_navMeshObject;
+  /// Transform of the navigation mesh at submission.
+  MT_Transform m_transform;
+  MT_Vector3 m_from;
+  MT_Vector3 m_to;
+  float m_path[MAX_PATH_LEN * 3];
+  int m_pathLen;
+
+ public:
+  KX_NavMeshPathFuture(KX_NavMeshObject *navmesh, const MT_Vector3 &from, const MT_Vector3 &to)
+      : m_navMeshObject(navmesh),
+        m_transform(navmesh->GetNavMeshTransform()),
+        m_from(from),
+        m_to(to),
+        m_pathLen(0)
+  {
+    m_navMeshObject->AddRef();
+  }
+
+  virtual ~KX_NavMeshPathFuture()
+  {
+    m_navMeshObject->Release();
+  }
+
+  virtual void *GetExclusiveData() const
+  {
+    return m_navMeshObject;
+  }
+
+  virtual void Run()
+  {
+    m_pathLen = m_navMeshObject->FindPath(m_transform, m_from, m_to, m_path, MAX_PATH_LEN);
+  }
+
+  virtual PyObject *ConvertResult()
+  {
+    PyObject *pathList = PyList_New(m_pathLen);
+    for (int i = 0; i < m_pathLen; i++) {
+      MT_Vector3 point(&m_path[3 * i]);
+      PyList_SET_ITEM(pathList, i, PyObjectFrom(point));
+    }
+
+    return pathList;
+  }
+};
+
+EXP_PYMETHODDEF_DOC(KX_NavMeshObject,
+                    findPathAsync,
+                    "findPathAsync(start, goal): find path from start to goal points "
+                    "after the physics update\n"
+                    "Returns a future of the path as list of points\n")
+{
+  PyObject *ob_from, *ob_to;
+  if (!PyArg_ParseTuple(args, "OO:findPathAsync", &ob_from, &ob_to))
+    return nullptr;
+  MT_Vector3 from, to;
+  if (!PyVecTo(ob_from, from) || !PyVecTo(ob_to, to))
+    return nullptr;
+
+  KX_NavMeshPathFuture *future = new KX_NavMeshPathFuture(this, from, to);
+  GetScene()->AddTask(future);
+
+  // Python owns the initial reference of the future.
+  return future->NewProxy(true);
+}
+
 EXP_PYMETHODDEF_DOC(KX_NavMeshObject,
                     raycast,
                     "raycast(start, goal): raycast from start to goal points\n"
@@ -1292,7 +1442,67 @@ EXP_PYMETHODDEF_DOC(KX_NavMeshObject,
 EXP_PYMETHODDEF_DOC_NOARGS(KX_NavMeshObject, rebuild, "rebuild(): rebuild navigation mesh\n")
 {
   BuildNavMesh();
+  UpdateObstacles();
   Py_RETURN_NONE;
 }
 
+/** Future of rebuildAsync, the polygons are read at submission and the navigation mesh
+ * replaced once the task is done, the current navigation mesh stays usable in between.
+ */
+class KX_NavMeshRebuildFuture : public KX_TaskFuture {
+ private:
+  KX_NavMeshObject *m_navMeshObject;
+  KX_NavMeshObject::BuildData m_source;
+  bool m_valid;
+  dtStatNavMesh *m_navMesh;
+
+ public:
+  KX_NavMeshRebuildFuture(KX_NavMeshObject *navmesh)
+      : m_navMeshObject(navmesh), m_valid(navmesh->ReadBuildData(m_source)), m_navMesh(nullptr)
+  {
+    m_navMeshObject->AddRef();
+  }
+
+  virtual ~KX_NavMeshRebuildFuture()
+  {
+    if (m_navMesh) {
+      delete m_navMesh;
+    }
+    m_navMeshObject->Release();
+  }
+
+  virtual void Run()
+  {
+    if (m_valid) {
+      m_navMesh = KX_NavMeshObject::CreateNavMesh(m_source);
+    }
+  }
+
+  virtual PyObject *ConvertResult()
+  {
+    // The object could be removed from the scene since the submission.
+    if (!m_navMesh ||
+        !m_navMeshObject->GetScene()->GetObjectList()->SearchValue(m_navMeshObject)) {
+      Py_RETURN_FALSE;
+    }
+
+    m_navMeshObject->SetNavMesh(m_navMesh);
+    m_navMesh = nullptr;
+    m_navMeshObject->UpdateObstacles();
+    Py_RETURN_TRUE;
+  }
+};
+
+EXP_PYMETHODDEF_DOC_NOARGS(KX_NavMeshObject,
+                           rebuildAsync,
+                           "rebuildAsync(): rebuild navigation mesh after the physics update\n"
+                           "Returns a future of the success of the rebuild\n")
+{
+  KX_NavMeshRebuildFuture *future = new KX_NavMeshRebuildFuture(this);
+  GetScene()->AddTask(future);
+
+  // Python owns the initial reference of the future.
+  return future->NewProxy(true);
+}
+
 #endif  // WITH_PYTHON
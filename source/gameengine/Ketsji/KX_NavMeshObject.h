@@ -26,6 +26,7 @@
  */
 #pragma once
 
+#include <unordered_map>
 #include <vector>
 
 #include "DetourStatNavMesh.h"
@@ -36,7 +37,67 @@
 class KX_NavMeshObject : public KX_GameObject {
   Py_Header
 
-      protected : dtStatNavMesh *m_navMesh;
+  friend class KX_NavMeshRebuildFuture;
+
+ protected:
+  dtStatNavMesh *m_navMesh;
+
+  /// Polygons read from the mesh, owned until the navigation mesh is created.
+  struct BuildData {
+    float *vertices;
+    int nverts;
+    unsigned short *polys;
+    int npolys;
+    unsigned short *dmeshes;
+    float *dvertices;
+    int ndvertsuniq;
+    unsigned short *dtris;
+    int ndtris;
+    int vertsPerPoly;
+
+    BuildData();
+    ~BuildData();
+  };
+
+  struct PathCacheKey {
+    dtStatPolyRef m_start;
+    dtStatPolyRef m_end;
+
+    bool operator==(const PathCacheKey &other) const
+    {
+      return m_start == other.m_start && m_end == other.m_end;
+    }
+  };
+
+  struct PathCacheKeyHash {
+    size_t operator()(const PathCacheKey &key) const
+    {
+      return ((size_t)key.m_start * 73856093) ^ ((size_t)key.m_end * 19349663);
+    }
+  };
+
+  /// Polygons corridor found between two polygons.
+  struct PathCacheEntry {
+    PathCacheKey m_key;
+    std::vector<dtStatPolyRef> m_polys;
+    /// Maximum length of the search, the corridor can be truncated if reached.
+    int m_maxPathLen;
+    /// Time of the last use, the least recently used entry is replaced first.
+    unsigned int m_lastUse;
+  };
+
+  /// Recent corridors, cleared when the navigation mesh is rebuilt.
+  std::vector<PathCacheEntry> m_pathCache;
+  std::unordered_map<PathCacheKey, unsigned int, PathCacheKeyHash> m_pathCacheIndices;
+  unsigned int m_pathCacheTime;
+
+  /// Find the polygons corridor between two polygons, reusing a recent search if possible.
+  int FindPathPolys(dtStatPolyRef sPolyRef,
+                    dtStatPolyRef ePolyRef,
+                    const float *spos,
+                    const float *epos,
+                    dtStatPolyRef *polys,
+                    int maxPathLen);
 
   bool BuildVertIndArrays(float *&vertices,
                           int &nverts,
@@ -48,6 +109,16 @@ class KX_NavMeshObject : public KX_GameObject {
                           unsigned short *&dtris,
                           int &ndtris,
                           int &vertsPerPoly);
+  /// Read the polygons of the evaluated mesh, must be called from the main thread.
+  bool ReadBuildData(BuildData &source);
+  /** Create the detour navigation mesh from the polygons read, doesn't access the object
+   * and can be used from a worker thread. Return nullptr on failure.
+   */
+  static dtStatNavMesh *CreateNavMesh(BuildData &source);
+  /// Replace the navigation mesh and clear the path cache.
+  void SetNavMesh(dtStatNavMesh *navmesh);
+  /// Replace the wall obstacles of the navigation mesh in the obstacle simulation.
+  void UpdateObstacles();
 
  public:
   KX_NavMeshObject();
@@ -59,12 +130,22 @@ class KX_NavMeshObject : public KX_GameObject {
   bool BuildNavMesh();
   dtStatNavMesh *GetNavMesh();
   int FindPath(const MT_Vector3 &from, const MT_Vector3 &to, float *path, int maxPathLen);
+  /** Find a path using the given world transform of the navigation mesh.
+   * Doesn't access the scene graph, can be used from a worker thread.
+   */
+  int FindPath(const MT_Transform &worldtr,
+               const MT_Vector3 &from,
+               const MT_Vector3 &to,
+               float *path,
+               int maxPathLen);
   float Raycast(const MT_Vector3 &from, const MT_Vector3 &to);
 
   enum NavMeshRenderMode { RM_WALLS, RM_POLYS, RM_TRIS, RM_MAX };
   void DrawNavMesh(NavMeshRenderMode mode);
   void DrawPath(const float *path, int pathLen, const MT_Vector4 &color);
 
+  /// Return the world transform of the navigation mesh including the scaling.
+  MT_Transform GetNavMeshTransform();
   MT_Vector3 TransformToLocalCoords(const MT_Vector3 &wpos);
   MT_Vector3 TransformToWorldCoords(const MT_Vector3 &lpos);
 #ifdef WITH_PYTHON
@@ -75,8 +156,10 @@ class KX_NavMeshObject : public KX_GameObject {
   static PyObject *game_object_new(PyTypeObject *type, PyObject *args, PyObject *kwds);
 
   EXP_PYMETHOD_DOC(KX_NavMeshObject, findPath);
+  EXP_PYMETHOD_DOC(KX_NavMeshObject, findPathAsync);
   EXP_PYMETHOD_DOC(KX_NavMeshObject, raycast);
   EXP_PYMETHOD_DOC(KX_NavMeshObject, draw);
   EXP_PYMETHOD_DOC_NOARGS(KX_NavMeshObject, rebuild);
+  EXP_PYMETHOD_DOC_NOARGS(KX_NavMeshObject, rebuildAsync);
 #endif /* WITH_PYTHON */
 };
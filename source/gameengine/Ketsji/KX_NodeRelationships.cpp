@@ -31,8 +31,6 @@
 
 #include "KX_NodeRelationships.h"
 
-#include "MT_Matrix4x4.h"
-
 KX_NormalParentRelation::KX_NormalParentRelation()
 {
 }
@@ -60,17 +58,12 @@ bool KX_NormalParentRelation::UpdateChildCoordinates(SG_Node *child,
   }
   else {
     const MT_Transform trans(parent->GetWorldTransform() * child->GetLocalTransform());
-    MT_Matrix4x4 tmat(trans.toMatrix());
-    float sx =
-        MT_Vector3(tmat.getElement(0, 0), tmat.getElement(1, 0), tmat.getElement(2, 0)).length();
-    float sy =
-        MT_Vector3(tmat.getElement(0, 1), tmat.getElement(1, 1), tmat.getElement(2, 1)).length();
-    float sz =
-        MT_Vector3(tmat.getElement(0, 2), tmat.getElement(1, 2), tmat.getElement(2, 2)).length();
-    const MT_Vector3 scale(sx, sy, sz);
-    const MT_Vector3 invscale(1.0f / sx, 1.0f / sy, 1.0f / sz);
+    // Extract the scale from the basis columns, no need of a full 4x4 matrix.
+    const MT_Matrix3x3 &basis = trans.getBasis();
+    const MT_Vector3 scale(
+        basis.getColumn(0).length(), basis.getColumn(1).length(), basis.getColumn(2).length());
     const MT_Vector3 pos = trans.getOrigin();
-    const MT_Matrix3x3 rot = trans.getBasis().scaled(invscale.x(), invscale.y(), invscale.z());
+    const MT_Matrix3x3 rot = basis.scaled(1.0f / scale.x(), 1.0f / scale.y(), 1.0f / scale.z());
 
     child->SetWorldScale(scale);
     child->SetWorldPosition(pos);
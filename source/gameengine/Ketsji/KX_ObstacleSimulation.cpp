@@ -28,8 +28,13 @@
 
 #include "KX_ObstacleSimulation.h"
 
+#include <algorithm>
+
+#include "BLI_task.h"
+
 #include "KX_Globals.h"
 #include "KX_NavMeshObject.h"
+#include "SCA_SteeringActuator.h"
 
 namespace {
 inline float perp(const MT_Vector2 &a, const MT_Vector2 &b)
@@ -187,7 +192,13 @@ static float interpolateToi(float a, const float *dir, const float *toi, const i
 }
 
 KX_ObstacleSimulation::KX_ObstacleSimulation(MT_Scalar levelHeight, bool enableVisualization)
-    : m_levelHeight(levelHeight), m_enableVisualization(enableVisualization)
+    : m_cellSize(1.0f),
+      m_maxExtent(0.0f),
+      m_gridValid(false),
+      m_numAgents(0),
+      m_levelHeight(levelHeight),
+      m_enableVisualization(enableVisualization),
+      m_maxSpeed(0.0f)
 {
 }
 
@@ -213,6 +224,8 @@ KX_Obstacle *KX_ObstacleSimulation::CreateObstacle(KX_GameObject *gameobj)
   obstacle->hhead = 0;
 
   m_obstacles.push_back(obstacle);
+  m_obstacleSet.insert(obstacle);
+  m_gridValid = false;
   return obstacle;
 }
 
@@ -252,11 +265,24 @@ void KX_ObstacleSimulation::AddObstaclesForNavMesh(KX_NavMeshObject *navmeshobj)
 
 void KX_ObstacleSimulation::DestroyObstacleForObj(KX_GameObject *gameobj)
 {
+  // Drop the queued steering of the object, its actuator is freed with it.
+  for (unsigned int i = 0; i < m_numAgents;) {
+    if (m_agents[i].m_obstacle->m_gameObj == gameobj) {
+      std::rotate(m_agents.begin() + i, m_agents.begin() + i + 1, m_agents.begin() + m_numAgents);
+      --m_numAgents;
+    }
+    else {
+      ++i;
+    }
+  }
+
   for (size_t i = 0; i < m_obstacles.size();) {
     if (m_obstacles[i]->m_gameObj == gameobj) {
       KX_Obstacle *obstacle = m_obstacles[i];
       m_obstacles[i] = m_obstacles.back();
       m_obstacles.pop_back();
+      m_obstacleSet.erase(obstacle);
+      m_gridValid = false;
       delete obstacle;
     }
     else
@@ -266,6 +292,10 @@ void KX_ObstacleSimulation::DestroyObstacleForObj(KX_GameObject *gameobj)
 
 void KX_ObstacleSimulation::UpdateObstacles()
 {
+  // The grid is rebuilt at the first query of the frame.
+  m_gridValid = false;
+  m_maxSpeed = 0.0f;
+
   for (size_t i = 0; i < m_obstacles.size(); i++) {
     if (m_obstacles[i]->m_type == KX_OBSTACLE_NAV_MESH ||
         m_obstacles[i]->m_shape == KX_OBSTACLE_SEGMENT)
@@ -283,9 +313,54 @@ void KX_ObstacleSimulation::UpdateObstacles()
     for (int j = 0; j < VEL_HIST_SIZE; ++j)
       add_v2_v2v2(obs->pvel, obs->pvel, &obs->hvel[j * 2]);
     mul_v2_fl(obs->pvel, 1.0f / VEL_HIST_SIZE);
+
+    m_maxSpeed = std::max(m_maxSpeed, len_v2(obs->vel));
   }
 }
 
+void KX_ObstacleSimulation::BuildGrid()
+{
+  m_cells.clear();
+  m_maxExtent = 0.0f;
+
+  std::vector<CellEntry> entries;
+  entries.reserve(m_obstacles.size());
+  float maxRadius = 0.0f;
+  for (KX_Obstacle *obs : m_obstacles) {
+    CellEntry entry;
+    entry.m_obstacle = obs;
+    if (obs->m_shape == KX_OBSTACLE_SEGMENT) {
+      MT_Vector3 p1 = obs->m_pos;
+      MT_Vector3 p2 = obs->m_pos2;
+      if (obs->m_type == KX_OBSTACLE_NAV_MESH) {
+        KX_NavMeshObject *navmeshobj = static_cast<KX_NavMeshObject *>(obs->m_gameObj);
+        p1 = navmeshobj->TransformToWorldCoords(p1);
+        p2 = navmeshobj->TransformToWorldCoords(p2);
+      }
+      entry.m_center = ((p1 + p2) * 0.5f).to2d();
+      entry.m_extent = (p2.to2d() - p1.to2d()).length() * 0.5f + obs->m_rad;
+    }
+    else {
+      entry.m_center = obs->m_pos.to2d();
+      entry.m_extent = obs->m_rad;
+    }
+    maxRadius = std::max(maxRadius, (float)obs->m_rad);
+    m_maxExtent = std::max(m_maxExtent, entry.m_extent);
+    entries.push_back(entry);
+  }
+
+  // A cell covers a few agents and the distance moved in a second by the fastest one.
+  m_cellSize = std::max(1.0f, std::max(maxRadius * 4.0f, m_maxSpeed));
+  const float invCellSize = 1.0f / m_cellSize;
+  for (const CellEntry &entry : entries) {
+    const CellKey key = {(int)floorf(entry.m_center.x() * invCellSize),
+                         (int)floorf(entry.m_center.y() * invCellSize)};
+    m_cells[key].push_back(entry);
+  }
+
+  m_gridValid = true;
+}
+
 KX_Obstacle *KX_ObstacleSimulation::GetObstacle(KX_GameObject *gameobj)
 {
   for (size_t i = 0; i < m_obstacles.size(); i++) {
@@ -298,12 +373,92 @@ KX_Obstacle *KX_ObstacleSimulation::GetObstacle(KX_GameObject *gameobj)
 
 void KX_ObstacleSimulation::AdjustObstacleVelocity(KX_Obstacle *activeObst,
                                                    KX_NavMeshObject *activeNavMeshObj,
+                                                   KX_Obstacles &neighbors,
                                                    MT_Vector3 &velocity,
                                                    MT_Scalar maxDeltaSpeed,
                                                    MT_Scalar maxDeltaAngle)
 {
 }
 
+void KX_ObstacleSimulation::AddAgent(SCA_SteeringActuator *actuator,
+                                     KX_Obstacle *activeObst,
+                                     KX_NavMeshObject *activeNavMeshObj,
+                                     const MT_Vector3 &velocity,
+                                     MT_Scalar maxDeltaSpeed,
+                                     MT_Scalar maxDeltaAngle)
+{
+  if (m_obstacleSet.find(activeObst) == m_obstacleSet.end()) {
+    return;
+  }
+
+  if (m_numAgents == m_agents.size()) {
+    m_agents.emplace_back();
+  }
+
+  Agent &agent = m_agents[m_numAgents++];
+  agent.m_actuator = actuator;
+  agent.m_obstacle = activeObst;
+  agent.m_navmesh = activeNavMeshObj;
+  agent.m_velocity = velocity;
+  agent.m_maxDeltaSpeed = maxDeltaSpeed;
+  agent.m_maxDeltaAngle = maxDeltaAngle;
+}
+
+void KX_ObstacleSimulation::AdjustAgentVelocity(unsigned int index)
+{
+  Agent &agent = m_agents[index];
+  AdjustObstacleVelocity(agent.m_obstacle,
+                         agent.m_navmesh,
+                         agent.m_neighbors,
+                         agent.m_velocity,
+                         agent.m_maxDeltaSpeed,
+                         agent.m_maxDeltaAngle);
+}
+
+static void adjust_agent_velocity_task(void *__restrict userdata,
+                                       const int i,
+                                       const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  KX_ObstacleSimulation *simulation = (KX_ObstacleSimulation *)userdata;
+  simulation->AdjustAgentVelocity(i);
+}
+
+/// Minimum number of agents to adjust their velocities in parallel.
+static const unsigned int parallelAgentsThreshold = 16;
+
+void KX_ObstacleSimulation::UpdateAgents()
+{
+  if (m_numAgents == 0) {
+    return;
+  }
+
+  /* The desired velocities of all the agents are set first, every agent then samples
+   * the same obstacle states whatever the order of the evaluation. */
+  for (unsigned int i = 0; i < m_numAgents; ++i) {
+    const Agent &agent = m_agents[i];
+    vset(agent.m_obstacle->dvel, agent.m_velocity.x(), agent.m_velocity.y());
+  }
+
+  // The grid is shared by the tasks and must be built before.
+  if (!m_gridValid) {
+    BuildGrid();
+  }
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (m_numAgents >= parallelAgentsThreshold);
+  settings.min_iter_per_thread = 4;
+  BLI_task_parallel_range(0, m_numAgents, this, adjust_agent_velocity_task, &settings);
+
+  // The actuators apply the velocities in the order they were updated.
+  for (unsigned int i = 0; i < m_numAgents; ++i) {
+    Agent &agent = m_agents[i];
+    agent.m_actuator->ApplyVelocity(agent.m_velocity);
+  }
+
+  m_numAgents = 0;
+}
+
 void KX_ObstacleSimulation::DrawObstacles()
 {
   if (!m_enableVisualization)
@@ -371,6 +526,56 @@ static bool filterObstacle(KX_Obstacle *activeObst,
   return true;
 }
 
+void KX_ObstacleSimulation::GetNeighbors(KX_Obstacle *activeObst,
+                                         KX_NavMeshObject *activeNavMeshObj,
+                                         float range,
+                                         KX_Obstacles &neighbors)
+{
+  neighbors.clear();
+
+  const MT_Vector2 pos = activeObst->m_pos.to2d();
+  const float invCellSize = 1.0f / m_cellSize;
+  const float cellRange = range + m_maxExtent;
+  const int minx = (int)floorf((pos.x() - cellRange) * invCellSize);
+  const int maxx = (int)floorf((pos.x() + cellRange) * invCellSize);
+  const int miny = (int)floorf((pos.y() - cellRange) * invCellSize);
+  const int maxy = (int)floorf((pos.y() + cellRange) * invCellSize);
+
+  const auto testEntry = [&](const CellEntry &entry) {
+    const float dist = range + entry.m_extent;
+    if ((entry.m_center - pos).length2() <= dist * dist &&
+        filterObstacle(activeObst, activeNavMeshObj, entry.m_obstacle, m_levelHeight)) {
+      neighbors.push_back(entry.m_obstacle);
+    }
+  };
+
+  // Iterate over all the cells when there are more cells in range than cells filled.
+  if ((float)(maxx - minx + 1) * (float)(maxy - miny + 1) > (float)m_cells.size()) {
+    for (const auto &pair : m_cells) {
+      const CellKey &key = pair.first;
+      if (key.x < minx || key.x > maxx || key.y < miny || key.y > maxy) {
+        continue;
+      }
+      for (const CellEntry &entry : pair.second) {
+        testEntry(entry);
+      }
+    }
+  }
+  else {
+    for (int x = minx; x <= maxx; ++x) {
+      for (int y = miny; y <= maxy; ++y) {
+        const auto it = m_cells.find({x, y});
+        if (it == m_cells.end()) {
+          continue;
+        }
+        for (const CellEntry &entry : it->second) {
+          testEntry(entry);
+        }
+      }
+    }
+  }
+}
+
 ///////////*********TOI_rays**********/////////////////
 KX_ObstacleSimulationTOI::KX_ObstacleSimulationTOI(MT_Scalar levelHeight, bool enableVisualization)
     : KX_ObstacleSimulation(levelHeight, enableVisualization),
@@ -386,20 +591,21 @@ KX_ObstacleSimulationTOI::KX_ObstacleSimulationTOI(MT_Scalar levelHeight, bool e
 
 void KX_ObstacleSimulationTOI::AdjustObstacleVelocity(KX_Obstacle *activeObst,
                                                       KX_NavMeshObject *activeNavMeshObj,
+                                                      KX_Obstacles &neighbors,
                                                       MT_Vector3 &velocity,
                                                       MT_Scalar maxDeltaSpeed,
                                                       MT_Scalar maxDeltaAngle)
 {
-  int nobs = m_obstacles.size();
-  int obstidx = std::find(m_obstacles.begin(), m_obstacles.end(), activeObst) -
-                m_obstacles.begin();
-  if (obstidx == nobs)
-    return;
-
-  vset(activeObst->dvel, velocity.x(), velocity.y());
+  /* Only the obstacles the agent can reach before the max time of impact change the samples,
+   * the relative velocity of a sample is at most four times the desired speed plus the current
+   * speed and the speed of the fastest obstacle. */
+  const float vmax = len_v2(activeObst->dvel);
+  const float range = activeObst->m_rad +
+                      (4.0f * vmax + len_v2(activeObst->vel) + m_maxSpeed) * m_maxToi;
+  GetNeighbors(activeObst, activeNavMeshObj, range, neighbors);
 
   // apply RVO
-  sampleRVO(activeObst, activeNavMeshObj, maxDeltaAngle);
+  sampleRVO(activeObst, activeNavMeshObj, neighbors, maxDeltaAngle);
 
   // Fake dynamic constraint.
   float dv[2];
@@ -441,6 +647,7 @@ KX_ObstacleSimulationTOI_rays::KX_ObstacleSimulationTOI_rays(MT_Scalar levelHeig
 
 void KX_ObstacleSimulationTOI_rays::sampleRVO(KX_Obstacle *activeObst,
                                               KX_NavMeshObject *activeNavMeshObj,
+                                              const KX_Obstacles &neighbors,
                                               const float maxDeltaAngle)
 {
   MT_Vector2 vel(activeObst->dvel[0], activeObst->dvel[1]);
@@ -462,7 +669,6 @@ void KX_ObstacleSimulationTOI_rays::sampleRVO(KX_Obstacle *activeObst,
   const int iforw = m_maxSamples / 2;
   const float aoff = (float)iforw / (float)m_maxSamples;
 
-  size_t nobs = m_obstacles.size();
   for (int iter = 0; iter < m_maxSamples; ++iter) {
     // Calculate sample velocity
     const float ndir = ((float)iter / (float)m_maxSamples) - aoff;
@@ -474,12 +680,7 @@ void KX_ObstacleSimulationTOI_rays::sampleRVO(KX_Obstacle *activeObst,
     // Find min time of impact and exit amongst all obstacles.
     float tmin = m_maxToi;
     float tmine = 0.0f;
-    for (int i = 0; i < nobs; ++i) {
-      KX_Obstacle *ob = m_obstacles[i];
-      bool res = filterObstacle(activeObst, activeNavMeshObj, ob, m_levelHeight);
-      if (!res)
-        continue;
-
+    for (KX_Obstacle *ob : neighbors) {
       float htmin, htmax;
 
       if (ob->m_shape == KX_OBSTACLE_CIRCLE) {
@@ -588,9 +789,7 @@ void KX_ObstacleSimulationTOI_rays::sampleRVO(KX_Obstacle *activeObst,
 ///////////********* TOI_cells**********/////////////////
 
 static void processSamples(KX_Obstacle *activeObst,
-                           KX_NavMeshObject *activeNavMeshObj,
-                           KX_Obstacles &obstacles,
-                           float levelHeight,
+                           const KX_Obstacles &obstacles,
                            const float vmax,
                            const float *spos,
                            const float cs,
@@ -626,11 +825,7 @@ static void processSamples(KX_Obstacle *activeObst,
     float side = 0;
     int nside = 0;
 
-    for (int i = 0; i < obstacles.size(); ++i) {
-      KX_Obstacle *ob = obstacles[i];
-      bool found = filterObstacle(activeObst, activeNavMeshObj, ob, levelHeight);
-      if (!found)
-        continue;
+    for (KX_Obstacle *ob : obstacles) {
       float htmin, htmax;
 
       if (ob->m_shape == KX_OBSTACLE_CIRCLE) {
@@ -759,6 +954,7 @@ static void processSamples(KX_Obstacle *activeObst,
 
 void KX_ObstacleSimulationTOI_cells::sampleRVO(KX_Obstacle *activeObst,
                                                KX_NavMeshObject *activeNavMeshObj,
+                                               const KX_Obstacles &neighbors,
                                                const float maxDeltaAngle)
 {
   vset(activeObst->nvel, 0.f, 0.f);
@@ -787,9 +983,7 @@ void KX_ObstacleSimulationTOI_cells::sampleRVO(KX_Obstacle *activeObst,
       }
     }
     processSamples(activeObst,
-                   activeNavMeshObj,
-                   m_obstacles,
-                   m_levelHeight,
+                   neighbors,
                    vmax,
                    spos,
                    cs / 2,
@@ -828,9 +1022,7 @@ void KX_ObstacleSimulationTOI_cells::sampleRVO(KX_Obstacle *activeObst,
       }
 
       processSamples(activeObst,
-                     activeNavMeshObj,
-                     m_obstacles,
-                     m_levelHeight,
+                     neighbors,
                      vmax,
                      spos,
                      cs / 2,
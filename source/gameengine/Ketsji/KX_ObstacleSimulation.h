@@ -25,6 +25,8 @@
 
 #pragma once
 
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "MT_Vector2.h"
@@ -32,6 +34,7 @@
 
 class KX_GameObject;
 class KX_NavMeshObject;
+class SCA_SteeringActuator;
 
 enum KX_OBSTACLE_TYPE {
   KX_OBSTACLE_OBJ,
@@ -63,13 +66,84 @@ struct KX_Obstacle {
 typedef std::vector<KX_Obstacle *> KX_Obstacles;
 
 class KX_ObstacleSimulation {
+ private:
+  struct CellKey {
+    int x;
+    int y;
+
+    bool operator==(const CellKey &other) const
+    {
+      return x == other.x && y == other.y;
+    }
+  };
+
+  struct CellKeyHash {
+    size_t operator()(const CellKey &key) const
+    {
+      return ((size_t)key.x * 73856093) ^ ((size_t)key.y * 19349663);
+    }
+  };
+
+  /// Obstacle registered in the cell of its world center.
+  struct CellEntry {
+    KX_Obstacle *m_obstacle;
+    MT_Vector2 m_center;
+    /// Distance from the center to the farthest point of the obstacle.
+    float m_extent;
+  };
+
+  /// Uniform 2D grid of the obstacles to gather the neighbors of an agent.
+  std::unordered_map<CellKey, std::vector<CellEntry>, CellKeyHash> m_cells;
+  float m_cellSize;
+  float m_maxExtent;
+  /// False when the obstacles moved or changed since the grid was built.
+  bool m_gridValid;
+
+  /// Steering of an actuator queued for the crowd update of the frame.
+  struct Agent {
+    SCA_SteeringActuator *m_actuator;
+    KX_Obstacle *m_obstacle;
+    KX_NavMeshObject *m_navmesh;
+    MT_Vector3 m_velocity;
+    MT_Scalar m_maxDeltaSpeed;
+    MT_Scalar m_maxDeltaAngle;
+    KX_Obstacles m_neighbors;
+  };
+
+  /// Queued agents, the first m_numAgents are used and the others keep their allocations.
+  std::vector<Agent> m_agents;
+  unsigned int m_numAgents;
+
+  void BuildGrid();
+
  protected:
   KX_Obstacles m_obstacles;
+  /// Fast lookup of the obstacles still registered.
+  std::unordered_set<KX_Obstacle *> m_obstacleSet;
 
   MT_Scalar m_levelHeight;
   bool m_enableVisualization;
+  /// Largest speed of the moving obstacles of the frame.
+  float m_maxSpeed;
 
   KX_Obstacle *CreateObstacle(KX_GameObject *gameobj);
+  /** Gather the obstacles passing the filter of an agent and closer than a range
+   * of its position, the grid must be built.
+   */
+  void GetNeighbors(KX_Obstacle *activeObst,
+                    KX_NavMeshObject *activeNavMeshObj,
+                    float range,
+                    KX_Obstacles &neighbors);
+
+  /** Adjust the velocity of an agent whose desired velocity is set, called from several
+   * threads at once, only the agent obstacle and the neighbors list can be modified.
+   */
+  virtual void AdjustObstacleVelocity(KX_Obstacle *activeObst,
+                                      KX_NavMeshObject *activeNavMeshObj,
+                                      KX_Obstacles &neighbors,
+                                      MT_Vector3 &velocity,
+                                      MT_Scalar maxDeltaSpeed,
+                                      MT_Scalar maxDeltaAngle);
 
  public:
   KX_ObstacleSimulation(MT_Scalar levelHeight, bool enableVisualization);
@@ -83,11 +157,20 @@ class KX_ObstacleSimulation {
   void AddObstaclesForNavMesh(KX_NavMeshObject *navmesh);
   KX_Obstacle *GetObstacle(KX_GameObject *gameobj);
   void UpdateObstacles();
-  virtual void AdjustObstacleVelocity(KX_Obstacle *activeObst,
-                                      KX_NavMeshObject *activeNavMeshObj,
-                                      MT_Vector3 &velocity,
-                                      MT_Scalar maxDeltaSpeed,
-                                      MT_Scalar maxDeltaAngle);
+
+  /// Queue the avoidance of an agent, the velocity is adjusted and applied in UpdateAgents.
+  void AddAgent(SCA_SteeringActuator *actuator,
+                KX_Obstacle *activeObst,
+                KX_NavMeshObject *activeNavMeshObj,
+                const MT_Vector3 &velocity,
+                MT_Scalar maxDeltaSpeed,
+                MT_Scalar maxDeltaAngle);
+  /** Adjust the velocities of the queued agents from the obstacle states of the frame,
+   * in parallel for large crowds, and apply them to the actuators in the queue order.
+   */
+  void UpdateAgents();
+  /// Adjust the velocity of a queued agent, used by the parallel task of UpdateAgents.
+  void AdjustAgentVelocity(unsigned int index);
 };
 class KX_ObstacleSimulationTOI : public KX_ObstacleSimulation {
  protected:
@@ -101,21 +184,26 @@ class KX_ObstacleSimulationTOI : public KX_ObstacleSimulation {
 
   virtual void sampleRVO(KX_Obstacle *activeObst,
                          KX_NavMeshObject *activeNavMeshObj,
+                         const KX_Obstacles &neighbors,
                          const float maxDeltaAngle) = 0;
 
  public:
-  KX_ObstacleSimulationTOI(MT_Scalar levelHeight, bool enableVisualization);
   virtual void AdjustObstacleVelocity(KX_Obstacle *activeObst,
                                       KX_NavMeshObject *activeNavMeshObj,
+                                      KX_Obstacles &neighbors,
                                       MT_Vector3 &velocity,
                                       MT_Scalar maxDeltaSpeed,
                                       MT_Scalar maxDeltaAngle);
+
+ public:
+  KX_ObstacleSimulationTOI(MT_Scalar levelHeight, bool enableVisualization);
 };
 
 class KX_ObstacleSimulationTOI_rays : public KX_ObstacleSimulationTOI {
  protected:
   virtual void sampleRVO(KX_Obstacle *activeObst,
                          KX_NavMeshObject *activeNavMeshObj,
+                         const KX_Obstacles &neighbors,
                          const float maxDeltaAngle);
 
  public:
@@ -129,6 +217,7 @@ class KX_ObstacleSimulationTOI_cells : public KX_ObstacleSimulationTOI {
   int m_sampleRadius;
   virtual void sampleRVO(KX_Obstacle *activeObst,
                          KX_NavMeshObject *activeNavMeshObj,
+                         const KX_Obstacles &neighbors,
                          const float maxDeltaAngle);
 
  public:
@@ -0,0 +1,291 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Ketsji/KX_ParticleEmitter.cpp
+ *  \ingroup ketsji
+ */
+
+#include "KX_ParticleEmitter.h"
+
+#include <algorithm>
+#include <cfloat>
+
+#include "KX_GameObject.h"
+#include "KX_ParticleManager.h"
+#include "KX_Scene.h"
+
+KX_ParticleEmitter::KX_ParticleEmitter(KX_GameObject *object, unsigned int maxParticles)
+    : m_object(object),
+      m_system(nullptr),
+      m_maxParticles(maxParticles),
+      m_active(true),
+      m_rate(100.0f),
+      m_velocity{0.0f, 0.0f, 2.0f},
+      m_randomVelocity(0.5f),
+      m_radius(0.0f),
+      m_lifetime(2.0f),
+      m_lifetimeRandom(0.0f),
+      m_gravity{0.0f, 0.0f, -9.8f},
+      m_damping(0.0f),
+      m_sizeStart(0.1f),
+      m_sizeEnd(0.1f),
+      m_colorStart{1.0f, 1.0f, 1.0f, 1.0f},
+      m_colorEnd{1.0f, 1.0f, 1.0f, 0.0f},
+      m_additive(false),
+      m_depthCollision(false),
+      m_bounce(0.5f),
+      m_collisionThickness(0.5f),
+      m_emitRemainder(0.0f),
+      m_burst(0),
+      m_idleTime(FLT_MAX)
+{
+}
+
+KX_ParticleEmitter::~KX_ParticleEmitter()
+{
+  if (m_system) {
+    delete m_system;
+  }
+}
+
+std::string KX_ParticleEmitter::GetName()
+{
+  return "KX_ParticleEmitter";
+}
+
+KX_GameObject *KX_ParticleEmitter::GetObject() const
+{
+  return m_object;
+}
+
+unsigned int KX_ParticleEmitter::GetMaxParticles() const
+{
+  return m_maxParticles;
+}
+
+void KX_ParticleEmitter::Emit(unsigned int count)
+{
+  m_burst = std::min(m_burst + count, m_maxParticles);
+}
+
+bool KX_ParticleEmitter::HasParticles() const
+{
+  return (m_idleTime <= m_lifetime * (1.0f + m_lifetimeRandom));
+}
+
+void KX_ParticleEmitter::Simulate(float timeStep,
+                                  GPUTexture *depthBuffer,
+                                  const MT_Matrix4x4 &viewProjection,
+                                  const MT_Vector3 &cameraPosition,
+                                  const float depthUvScale[2])
+{
+  float rate = m_active ? m_rate : 0.0f;
+  if (rate > 0.0f && !m_rateProperty.empty()) {
+    EXP_Value *prop = m_object->GetProperty(m_rateProperty);
+    rate = prop ? rate * std::max((float)prop->GetNumber(), 0.0f) : 0.0f;
+  }
+
+  const float emission = rate * timeStep + m_emitRemainder;
+  const unsigned int count = std::min((unsigned int)emission + m_burst, m_maxParticles);
+  m_emitRemainder = (rate > 0.0f) ? emission - (float)(unsigned int)emission : 0.0f;
+  m_burst = 0;
+
+  if (count > 0) {
+    m_idleTime = 0.0f;
+  }
+  else if (HasParticles()) {
+    m_idleTime += timeStep;
+  }
+  else {
+    // All the particles are dead, nothing to step.
+    return;
+  }
+
+  if (!m_system) {
+    m_system = new RAS_ParticleSystem(m_maxParticles);
+  }
+
+  RAS_ParticleSystem::Settings settings;
+  FillSettings(settings);
+  m_system->Simulate(settings,
+                     timeStep,
+                     count,
+                     m_depthCollision ? depthBuffer : nullptr,
+                     viewProjection,
+                     cameraPosition,
+                     depthUvScale);
+}
+
+void KX_ParticleEmitter::Draw(const MT_Matrix4x4 &viewProjection,
+                              const MT_Vector3 &right,
+                              const MT_Vector3 &up)
+{
+  if (!m_system || !HasParticles()) {
+    return;
+  }
+
+  RAS_ParticleSystem::Settings settings;
+  FillSettings(settings);
+  m_system->Draw(settings, viewProjection, right, up);
+}
+
+void KX_ParticleEmitter::FillSettings(RAS_ParticleSystem::Settings &settings) const
+{
+  m_object->NodeGetWorldTransform().getValue(&settings.m_emitterMatrix[0][0]);
+  std::copy_n(m_velocity, 3, settings.m_velocity);
+  settings.m_randomVelocity = m_randomVelocity;
+  settings.m_radius = m_radius;
+  settings.m_lifetime = m_lifetime;
+  settings.m_lifetimeRandom = m_lifetimeRandom;
+  std::copy_n(m_gravity, 3, settings.m_gravity);
+  settings.m_damping = m_damping;
+  settings.m_sizeStart = m_sizeStart;
+  settings.m_sizeEnd = m_sizeEnd;
+  std::copy_n(m_colorStart, 4, settings.m_colorStart);
+  std::copy_n(m_colorEnd, 4, settings.m_colorEnd);
+  settings.m_additive = m_additive;
+  settings.m_depthCollision = m_depthCollision;
+  settings.m_bounce = m_bounce;
+  settings.m_collisionThickness = m_collisionThickness;
+}
+
+#ifdef WITH_PYTHON
+
+PyTypeObject KX_ParticleEmitter::Type = {PyVarObject_HEAD_INIT(nullptr, 0) "KX_ParticleEmitter",
+                                         sizeof(EXP_PyObjectPlus_Proxy),
+                                         0,
+                                         py_base_dealloc,
+                                         0,
+                                         0,
+                                         0,
+                                         0,
+                                         py_base_repr,
+                                         0,
+                                         0,
+                                         0,
+                                         0,
+                                         0,
+                                         0,
+                                         0,
+                                         0,
+                                         0,
+                                         Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE,
+                                         0,
+                                         0,
+                                         0,
+                                         0,
+                                         0,
+                                         0,
+                                         0,
+                                         Methods,
+                                         0,
+                                         0,
+                                         &EXP_Value::Type,
+                                         0,
+                                         0,
+                                         0,
+                                         0,
+                                         0,
+                                         0,
+                                         py_base_new};
+
+PyMethodDef KX_ParticleEmitter::Methods[] = {
+    EXP_PYMETHODTABLE(KX_ParticleEmitter, emit),
+    EXP_PYMETHODTABLE_NOARGS(KX_ParticleEmitter, remove),
+    {nullptr, nullptr}  // Sentinel
+};
+
+PyAttributeDef KX_ParticleEmitter::Attributes[] = {
+    EXP_PYATTRIBUTE_RO_FUNCTION("object", KX_ParticleEmitter, pyattr_get_object),
+    EXP_PYATTRIBUTE_RO_FUNCTION("maxParticles", KX_ParticleEmitter, pyattr_get_max_particles),
+    EXP_PYATTRIBUTE_BOOL_RW("active", KX_ParticleEmitter, m_active),
+    EXP_PYATTRIBUTE_FLOAT_RW("rate", 0.0f, FLT_MAX, KX_ParticleEmitter, m_rate),
+    EXP_PYATTRIBUTE_STRING_RW("rateProperty", 0, 64, false, KX_ParticleEmitter, m_rateProperty),
+    EXP_PYATTRIBUTE_FLOAT_VECTOR_RW(
+        "velocity", -FLT_MAX, FLT_MAX, KX_ParticleEmitter, m_velocity, 3),
+    EXP_PYATTRIBUTE_FLOAT_RW(
+        "randomVelocity", 0.0f, FLT_MAX, KX_ParticleEmitter, m_randomVelocity),
+    EXP_PYATTRIBUTE_FLOAT_RW("radius", 0.0f, FLT_MAX, KX_ParticleEmitter, m_radius),
+    EXP_PYATTRIBUTE_FLOAT_RW("lifetime", 0.0f, FLT_MAX, KX_ParticleEmitter, m_lifetime),
+    EXP_PYATTRIBUTE_FLOAT_RW(
+        "lifetimeRandom", 0.0f, 1.0f, KX_ParticleEmitter, m_lifetimeRandom),
+    EXP_PYATTRIBUTE_FLOAT_VECTOR_RW(
+        "gravity", -FLT_MAX, FLT_MAX, KX_ParticleEmitter, m_gravity, 3),
+    EXP_PYATTRIBUTE_FLOAT_RW("damping", 0.0f, FLT_MAX, KX_ParticleEmitter, m_damping),
+    EXP_PYATTRIBUTE_FLOAT_RW("sizeStart", 0.0f, FLT_MAX, KX_ParticleEmitter, m_sizeStart),
+    EXP_PYATTRIBUTE_FLOAT_RW("sizeEnd", 0.0f, FLT_MAX, KX_ParticleEmitter, m_sizeEnd),
+    EXP_PYATTRIBUTE_FLOAT_VECTOR_RW(
+        "colorStart", 0.0f, FLT_MAX, KX_ParticleEmitter, m_colorStart, 4),
+    EXP_PYATTRIBUTE_FLOAT_VECTOR_RW(
+        "colorEnd", 0.0f, FLT_MAX, KX_ParticleEmitter, m_colorEnd, 4),
+    EXP_PYATTRIBUTE_BOOL_RW("additive", KX_ParticleEmitter, m_additive),
+    EXP_PYATTRIBUTE_BOOL_RW("depthCollision", KX_ParticleEmitter, m_depthCollision),
+    EXP_PYATTRIBUTE_FLOAT_RW("bounce", 0.0f, 1.0f, KX_ParticleEmitter, m_bounce),
+    EXP_PYATTRIBUTE_FLOAT_RW(
+        "collisionThickness", 0.0f, FLT_MAX, KX_ParticleEmitter, m_collisionThickness),
+    EXP_PYATTRIBUTE_NULL  // Sentinel
+};
+
+EXP_PYMETHODDEF_DOC_VARARGS(KX_ParticleEmitter,
+                            emit,
+                            "emit(count)\n"
+                            "Emit particles at the next frame, even if the emitter is inactive.\n")
+{
+  int count;
+  if (!PyArg_ParseTuple(args, "i:emit", &count)) {
+    return nullptr;
+  }
+
+  if (count < 0) {
+    PyErr_SetString(PyExc_ValueError, "emitter.emit(count): count must be positive");
+    return nullptr;
+  }
+
+  Emit(count);
+
+  Py_RETURN_NONE;
+}
+
+EXP_PYMETHODDEF_DOC_NOARGS(KX_ParticleEmitter,
+                           remove,
+                           "remove()\n"
+                           "Remove the emitter and its particles.\n")
+{
+  // The emitter is deleted by the manager, the proxy is invalidated.
+  m_object->GetScene()->GetParticleManager()->RemoveEmitter(this);
+
+  Py_RETURN_NONE;
+}
+
+PyObject *KX_ParticleEmitter::pyattr_get_object(EXP_PyObjectPlus *self_v,
+                                                const EXP_PYATTRIBUTE_DEF *attrdef)
+{
+  KX_ParticleEmitter *self = static_cast<KX_ParticleEmitter *>(self_v);
+  return self->m_object->GetProxy();
+}
+
+PyObject *KX_ParticleEmitter::pyattr_get_max_particles(EXP_PyObjectPlus *self_v,
+                                                       const EXP_PYATTRIBUTE_DEF *attrdef)
+{
+  KX_ParticleEmitter *self = static_cast<KX_ParticleEmitter *>(self_v);
+  return PyLong_FromLong(self->m_maxParticles);
+}
+
+#endif  // WITH_PYTHON
@@ -0,0 +1,114 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file KX_ParticleEmitter.h
+ *  \ingroup ketsji
+ */
+
+#pragma once
+
+#include <string>
+
+#include "EXP_Value.h"
+#include "MT_Matrix4x4.h"
+#include "MT_Vector3.h"
+#include "RAS_ParticleSystem.h"
+
+class KX_GameObject;
+struct GPUTexture;
+
+/** GPU particles emitted from a game object. The emitter only holds the parameters, the
+ * particles are simulated and drawn by a particle system on the GPU, see RAS_ParticleSystem.
+ * The emission rate can be driven by a game property of the object for the logic bricks.
+ */
+class KX_ParticleEmitter : public EXP_Value {
+  Py_Header
+
+      private : KX_GameObject *m_object;
+  /// Created at the first simulation, in the GPU context.
+  RAS_ParticleSystem *m_system;
+  unsigned int m_maxParticles;
+
+  bool m_active;
+  /// Particles emitted per second.
+  float m_rate;
+  /// Name of the game property of the object multiplying the rate, empty for none.
+  std::string m_rateProperty;
+  float m_velocity[3];
+  float m_randomVelocity;
+  float m_radius;
+  float m_lifetime;
+  float m_lifetimeRandom;
+  float m_gravity[3];
+  float m_damping;
+  float m_sizeStart;
+  float m_sizeEnd;
+  float m_colorStart[4];
+  float m_colorEnd[4];
+  bool m_additive;
+  bool m_depthCollision;
+  float m_bounce;
+  float m_collisionThickness;
+
+  /// Fraction of particle left from the previous emissions.
+  float m_emitRemainder;
+  /// Particles emitted at once by the next step.
+  unsigned int m_burst;
+  /// Time since the last emission, once over the longest lifetime no particle is alive.
+  float m_idleTime;
+
+  void FillSettings(RAS_ParticleSystem::Settings &settings) const;
+
+ public:
+  KX_ParticleEmitter(KX_GameObject *object, unsigned int maxParticles);
+  virtual ~KX_ParticleEmitter();
+
+  virtual std::string GetName();
+
+  /// Return the emitting object, the emitter is removed with it.
+  KX_GameObject *GetObject() const;
+  unsigned int GetMaxParticles() const;
+
+  /// Emit particles at the next step, even if the emitter is inactive.
+  void Emit(unsigned int count);
+  /// Return true while particles can be alive.
+  bool HasParticles() const;
+
+  /** Step the particles and emit the new ones.
+   * \param depthBuffer The depth of the render for the collisions, nullptr if unavailable.
+   * \param viewProjection The matrix the depth was rendered with.
+   */
+  void Simulate(float timeStep,
+                GPUTexture *depthBuffer,
+                const MT_Matrix4x4 &viewProjection,
+                const MT_Vector3 &cameraPosition,
+                const float depthUvScale[2]);
+  /// Draw the particles in the bound frame buffer.
+  void Draw(const MT_Matrix4x4 &viewProjection, const MT_Vector3 &right, const MT_Vector3 &up);
+
+#ifdef WITH_PYTHON
+  EXP_PYMETHOD_DOC_VARARGS(KX_ParticleEmitter, emit);
+  EXP_PYMETHOD_DOC_NOARGS(KX_ParticleEmitter, remove);
+
+  static PyObject *pyattr_get_object(EXP_PyObjectPlus *self_v, const EXP_PYATTRIBUTE_DEF *attrdef);
+  static PyObject *pyattr_get_max_particles(EXP_PyObjectPlus *self_v,
+                                            const EXP_PYATTRIBUTE_DEF *attrdef);
+#endif  // WITH_PYTHON
+};
@@ -0,0 +1,141 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Ketsji/KX_ParticleManager.cpp
+ *  \ingroup ketsji
+ */
+
+#include "KX_ParticleManager.h"
+
+#include <algorithm>
+
+#include "BLI_rect.h"
+#include "DNA_object_types.h"
+#include "GPU_framebuffer.h"
+#include "GPU_state.h"
+#include "GPU_texture.h"
+
+#include "KX_Camera.h"
+#include "KX_Globals.h"
+#include "KX_KetsjiEngine.h"
+#include "KX_ParticleEmitter.h"
+#include "RAS_FrameBuffer.h"
+
+KX_ParticleManager::KX_ParticleManager(KX_Scene *scene) : m_scene(scene), m_lastTime(-1.0)
+{
+}
+
+KX_ParticleManager::~KX_ParticleManager()
+{
+  for (KX_ParticleEmitter *emitter : m_emitters) {
+    emitter->Release();
+  }
+}
+
+KX_ParticleEmitter *KX_ParticleManager::AddEmitter(KX_GameObject *gameobj,
+                                                   unsigned int maxParticles)
+{
+  KX_ParticleEmitter *emitter = new KX_ParticleEmitter(gameobj, maxParticles);
+  m_emitters.push_back(emitter);
+  return emitter;
+}
+
+void KX_ParticleManager::RemoveEmitter(KX_ParticleEmitter *emitter)
+{
+  std::vector<KX_ParticleEmitter *>::iterator it = std::find(
+      m_emitters.begin(), m_emitters.end(), emitter);
+  if (it != m_emitters.end()) {
+    m_emitters.erase(it);
+    emitter->Release();
+  }
+}
+
+void KX_ParticleManager::RemoveObject(KX_GameObject *gameobj)
+{
+  for (std::vector<KX_ParticleEmitter *>::iterator it = m_emitters.begin();
+       it != m_emitters.end();) {
+    KX_ParticleEmitter *emitter = *it;
+    if (emitter->GetObject() == gameobj) {
+      it = m_emitters.erase(it);
+      emitter->Release();
+    }
+    else {
+      ++it;
+    }
+  }
+}
+
+bool KX_ParticleManager::IsEmpty() const
+{
+  return m_emitters.empty();
+}
+
+void KX_ParticleManager::Render(KX_Camera *cam,
+                                RAS_FrameBuffer *target,
+                                const rcti *window,
+                                bool is_overlay_pass)
+{
+  if (m_emitters.empty()) {
+    return;
+  }
+
+  const MT_Matrix4x4 viewProjection = cam->GetProjectionMatrix() * cam->GetModelviewMatrix();
+
+  GPU_framebuffer_bind(target->GetFrameBuffer());
+  GPU_viewport(0, 0, BLI_rcti_size_x(window), BLI_rcti_size_y(window));
+
+  // Step once per frame, the additional views and the overlay pass only draw.
+  const double time = KX_GetActiveEngine()->GetFrameTime();
+  if (time != m_lastTime) {
+    const float timeStep = (m_lastTime < 0.0) ? 0.0f : std::min(float(time - m_lastTime), 0.1f);
+    m_lastTime = time;
+
+    GPUTexture *depth = target->GetDepthAttachment();
+    float depthUvScale[2] = {1.0f, 1.0f};
+    if (depth) {
+      depthUvScale[0] = float(BLI_rcti_size_x(window)) / GPU_texture_width(depth);
+      depthUvScale[1] = float(BLI_rcti_size_y(window)) / GPU_texture_height(depth);
+    }
+
+    const MT_Vector3 cameraPosition = cam->NodeGetWorldPosition();
+    for (KX_ParticleEmitter *emitter : m_emitters) {
+      emitter->Simulate(timeStep, depth, viewProjection, cameraPosition, depthUvScale);
+    }
+  }
+
+  const MT_Matrix3x3 orientation = cam->NodeGetWorldOrientation();
+  const MT_Vector3 right = orientation.getColumn(0);
+  const MT_Vector3 up = orientation.getColumn(1);
+
+  GPU_depth_test(GPU_DEPTH_LESS_EQUAL);
+  GPU_depth_mask(false);
+
+  for (KX_ParticleEmitter *emitter : m_emitters) {
+    const bool overlay = (emitter->GetObject()->GetBlenderObject()->gameflag &
+                          OB_OVERLAY_COLLECTION);
+    if (overlay == is_overlay_pass) {
+      emitter->Draw(viewProjection, right, up);
+    }
+  }
+
+  GPU_depth_mask(true);
+  GPU_depth_test(GPU_DEPTH_NONE);
+  GPU_blend(GPU_BLEND_NONE);
+}
@@ -0,0 +1,64 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file KX_ParticleManager.h
+ *  \ingroup ketsji
+ */
+
+#pragma once
+
+#include <vector>
+
+class KX_Camera;
+class KX_GameObject;
+class KX_ParticleEmitter;
+class KX_Scene;
+class RAS_FrameBuffer;
+struct rcti;
+
+/** Particle emitters of a scene. The emitters are stepped once per frame with the depth of
+ * the first view rendered and drawn in each view over the render result, like the fast texts.
+ */
+class KX_ParticleManager {
+ private:
+  KX_Scene *m_scene;
+  std::vector<KX_ParticleEmitter *> m_emitters;
+  /// Frame time of the last step.
+  double m_lastTime;
+
+ public:
+  KX_ParticleManager(KX_Scene *scene);
+  ~KX_ParticleManager();
+
+  /// Create an emitter on an object, the manager owns it.
+  KX_ParticleEmitter *AddEmitter(KX_GameObject *gameobj, unsigned int maxParticles);
+  /// Delete an emitter.
+  void RemoveEmitter(KX_ParticleEmitter *emitter);
+  /// Delete the emitters of an object being deleted.
+  void RemoveObject(KX_GameObject *gameobj);
+  bool IsEmpty() const;
+
+  /** Step the emitters at a new frame and draw them in a view.
+   * \param target The frame buffer of the render of the view, its depth is used for the
+   * collisions.
+   * \param window The area of the render in the target.
+   */
+  void Render(KX_Camera *cam, RAS_FrameBuffer *target, const rcti *window, bool is_overlay_pass);
+};
@@ -0,0 +1,194 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Ketsji/KX_PerformanceHud.cpp
+ *  \ingroup ketsji
+ */
+
+#include "KX_PerformanceHud.h"
+
+#include <algorithm>
+#include <boost/format.hpp>
+
+#include "RAS_DebugDraw.h"
+
+/// Refresh period of the labels in seconds.
+static const double labelPeriod = 0.25;
+
+KX_PerformanceHud::KX_PerformanceHud(const std::vector<std::string> &categories)
+    : m_numCategories(categories.size()),
+      m_sampleIndex(0),
+      m_numSamples(0),
+      m_counters((1 << COUNTER_MAX) - 1),
+      m_labelTime(-1.0)
+{
+  static const std::pair<Counter, const char *> counters[] = {
+      {COUNTER_DRAW_CALLS, "Draw Calls:"},
+      {COUNTER_OBJECTS, "Objects:"},
+      {COUNTER_LOGIC_BRICKS, "Logic Bricks:"},
+      {COUNTER_PHYSICS_BODIES, "Bodies:"},
+      {COUNTER_PHYSICS_CONTACTS, "Contacts:"},
+      {COUNTER_MEMORY, "Memory:"}};
+
+  // The frame time first, then the categories and the other counters.
+  m_series.resize(1 + m_numCategories + COUNTER_MAX - COUNTER_DRAW_CALLS);
+  m_series[0].m_name = "Frametime:";
+  m_series[0].m_counter = COUNTER_FRAME_TIME;
+  for (unsigned int i = 0; i < m_numCategories; ++i) {
+    m_series[i + 1].m_name = categories[i];
+    m_series[i + 1].m_counter = COUNTER_CATEGORIES;
+  }
+  for (unsigned int i = 0, size = COUNTER_MAX - COUNTER_DRAW_CALLS; i < size; ++i) {
+    m_series[i + 1 + m_numCategories].m_name = counters[i].second;
+    m_series[i + 1 + m_numCategories].m_counter = counters[i].first;
+  }
+
+  for (Series &series : m_series) {
+    std::fill(series.m_samples, series.m_samples + NUM_SAMPLES, 0.0f);
+  }
+}
+
+KX_PerformanceHud::~KX_PerformanceHud()
+{
+}
+
+int KX_PerformanceHud::GetCounters() const
+{
+  return m_counters;
+}
+
+void KX_PerformanceHud::SetCounters(int counters)
+{
+  m_counters = counters & ((1 << COUNTER_MAX) - 1);
+}
+
+void KX_PerformanceHud::AddSample(Series &series, float value)
+{
+  series.m_samples[m_sampleIndex] = value;
+}
+
+void KX_PerformanceHud::AddFrame(const std::vector<double> &times, const Frame &frame)
+{
+  double total = 0.0;
+  for (unsigned int i = 0; i < m_numCategories; ++i) {
+    total += times[i];
+    AddSample(m_series[i + 1], times[i] * 1000.0);
+  }
+  AddSample(m_series[0], total * 1000.0);
+
+  const float values[] = {float(frame.m_drawCalls),
+                          float(frame.m_objects),
+                          float(frame.m_logicBricks),
+                          float(frame.m_physicsBodies),
+                          float(frame.m_physicsContacts),
+                          float(frame.m_memory / 1048576.0)};
+  for (unsigned int i = 0, size = COUNTER_MAX - COUNTER_DRAW_CALLS; i < size; ++i) {
+    AddSample(m_series[i + 1 + m_numCategories], values[i]);
+  }
+
+  m_sampleIndex = (m_sampleIndex + 1) % NUM_SAMPLES;
+  m_numSamples = std::min<unsigned int>(m_numSamples + 1, NUM_SAMPLES);
+}
+
+void KX_PerformanceHud::UpdateLabels()
+{
+  const unsigned int last = (m_sampleIndex + NUM_SAMPLES - 1) % NUM_SAMPLES;
+  for (Series &series : m_series) {
+    const float value = series.m_samples[last];
+    switch (series.m_counter) {
+      case COUNTER_FRAME_TIME:
+      case COUNTER_CATEGORIES: {
+        series.m_label = (boost::format("%5.2fms") % value).str();
+        break;
+      }
+      case COUNTER_MEMORY: {
+        series.m_label = (boost::format("%.2fMB") % value).str();
+        break;
+      }
+      default: {
+        series.m_label = std::to_string((unsigned int)value);
+        break;
+      }
+    }
+  }
+}
+
+void KX_PerformanceHud::Render(RAS_DebugDraw &debugDraw, int width, double time)
+{
+  if (m_numSamples == 0) {
+    return;
+  }
+
+  if (time - m_labelTime >= labelPeriod) {
+    UpdateLabels();
+    m_labelTime = time;
+  }
+
+  static const MT_Vector4 white(1.0f, 1.0f, 1.0f, 1.0f);
+  static const MT_Vector4 grey(0.5f, 0.5f, 0.5f, 0.5f);
+  static const MT_Vector4 timeColor(0.3f, 1.0f, 0.3f, 1.0f);
+  static const MT_Vector4 countColor(0.3f, 0.7f, 1.0f, 1.0f);
+
+  const int valueIndent = 84;
+  const int graphIndent = 160;
+  const int graphHeight = 10;
+  const int ysize = 14;
+
+  const int xcoord = width - 12 - graphIndent - NUM_SAMPLES;
+  int ycoord = 17;
+
+  // Index of the oldest sample.
+  const unsigned int first = (m_sampleIndex + NUM_SAMPLES - m_numSamples) % NUM_SAMPLES;
+  // Right align the graphs, the newest sample is always at the end.
+  const int graphStart = xcoord + graphIndent + NUM_SAMPLES - m_numSamples;
+
+  for (const Series &series : m_series) {
+    if (!UseCounter(series.m_counter)) {
+      continue;
+    }
+
+    debugDraw.RenderText2D(series.m_name, MT_Vector2(xcoord, ycoord), white);
+    debugDraw.RenderText2D(series.m_label, MT_Vector2(xcoord + valueIndent, ycoord), white);
+
+    // Scale the graph to the maximum value of the ring.
+    float max = 0.0f;
+    for (unsigned int i = 0; i < m_numSamples; ++i) {
+      max = std::max(max, series.m_samples[(first + i) % NUM_SAMPLES]);
+    }
+    const float scale = (max > 0.0f) ? graphHeight / max : 0.0f;
+
+    debugDraw.RenderLine2D(MT_Vector2(xcoord + graphIndent, ycoord),
+                           MT_Vector2(xcoord + graphIndent + NUM_SAMPLES, ycoord),
+                           grey);
+
+    const MT_Vector4 &color = (series.m_counter <= COUNTER_CATEGORIES) ? timeColor : countColor;
+    MT_Vector2 prev(graphStart, ycoord - series.m_samples[first] * scale);
+    for (unsigned int i = 1; i < m_numSamples; ++i) {
+      const MT_Vector2 pos(graphStart + i,
+                           ycoord - series.m_samples[(first + i) % NUM_SAMPLES] * scale);
+      debugDraw.RenderLine2D(prev, pos, color);
+      prev = pos;
+    }
+
+    ycoord += ysize;
+  }
+}
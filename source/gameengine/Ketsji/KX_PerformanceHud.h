@@ -0,0 +1,123 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file KX_PerformanceHud.h
+ *  \ingroup ketsji
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+class RAS_DebugDraw;
+
+/** Graphs of the counters of the last frames drawn over the game.
+ * The samples are stored in a ring allocated once, adding a frame never allocates.
+ */
+class KX_PerformanceHud {
+ public:
+  enum Counter {
+    /// Sum of the category times.
+    COUNTER_FRAME_TIME = 0,
+    /// Time of each profiling category.
+    COUNTER_CATEGORIES,
+    /// Number of GPU batches drawn.
+    COUNTER_DRAW_CALLS,
+    /// Number of objects in the scenes.
+    COUNTER_OBJECTS,
+    /// Number of sensors, controllers and actuators in the scenes.
+    COUNTER_LOGIC_BRICKS,
+    /// Number of physics controllers in the scenes.
+    COUNTER_PHYSICS_BODIES,
+    /// Number of physics contact points in the scenes.
+    COUNTER_PHYSICS_CONTACTS,
+    /// Memory allocated by the guarded allocator.
+    COUNTER_MEMORY,
+    COUNTER_MAX
+  };
+
+  /// Counters of a frame other than the times.
+  struct Frame {
+    unsigned int m_drawCalls;
+    unsigned int m_objects;
+    unsigned int m_logicBricks;
+    unsigned int m_physicsBodies;
+    unsigned int m_physicsContacts;
+    size_t m_memory;
+  };
+
+ private:
+  enum {
+    /// Number of frames shown in the graphs.
+    NUM_SAMPLES = 128
+  };
+
+  /// A graph of the last values of a counter or a category.
+  struct Series {
+    std::string m_name;
+    Counter m_counter;
+    /// Ring of the last NUM_SAMPLES values.
+    float m_samples[NUM_SAMPLES];
+    /// Text of the last value, refreshed at a low rate to be readable.
+    std::string m_label;
+  };
+
+  std::vector<Series> m_series;
+  unsigned int m_numCategories;
+  unsigned int m_sampleIndex;
+  unsigned int m_numSamples;
+  /// Mask of the shown counters, a bit per counter.
+  int m_counters;
+  /// Real time of the last refresh of the labels.
+  double m_labelTime;
+
+  void AddSample(Series &series, float value);
+  void UpdateLabels();
+
+ public:
+  /** Construct the HUD.
+   * \param categories The labels of the profiling categories.
+   */
+  KX_PerformanceHud(const std::vector<std::string> &categories);
+  ~KX_PerformanceHud();
+
+  int GetCounters() const;
+  void SetCounters(int counters);
+
+  /// Return true if the counter must be measured.
+  inline bool UseCounter(Counter counter) const
+  {
+    return m_counters & (1 << counter);
+  }
+
+  /** Register the counters of the last finished frame.
+   * \param times The time in seconds of each category.
+   */
+  void AddFrame(const std::vector<double> &times, const Frame &frame);
+
+  /** Draw the graphs of the shown counters in the top right corner of the canvas.
+   * \param width The canvas width.
+   * \param time The real time used to refresh the labels.
+   */
+  void Render(RAS_DebugDraw &debugDraw, int width, double time);
+};
@@ -35,6 +35,7 @@
 #include "KX_ConstraintWrapper.h"
 #include "KX_GameObject.h"  // ConvertPythonToGameObject()
 #include "KX_Globals.h"
+#include "KX_PyMath.h"
 #include "KX_VehicleWrapper.h"
 #include "PHY_IConstraint.h"
 #include "PHY_IPhysicsEnvironment.h"
@@ -111,6 +112,10 @@ PyDoc_STRVAR(gPySetSolverType__doc__,
 PyDoc_STRVAR(gPyCreateConstraint__doc__,
              "createConstraint(ob1,ob2,float restLength,float restitution,float damping)\n"
              "");
+PyDoc_STRVAR(gPyCreateConstraints__doc__,
+             "createConstraints(physicsids, constraint_type, pivots, axes=None, limits=None, "
+             "flag=0)\n"
+             "Create a list of constraints in one call, used to build ragdolls and chains.");
 PyDoc_STRVAR(gPyCreateVehicle__doc__,
              "createVehicle(chassis)\n"
              "");
@@ -126,6 +131,12 @@ PyDoc_STRVAR(gPyRemoveConstraint__doc__,
 PyDoc_STRVAR(gPyGetAppliedImpulse__doc__,
              "getAppliedImpulse(int constraintId)\n"
              "");
+PyDoc_STRVAR(gPySaveState__doc__,
+             "saveState()\n"
+             "Return the state of the physics simulation as bytes.");
+PyDoc_STRVAR(gPyRestoreState__doc__,
+             "restoreState(bytes state)\n"
+             "Restore a state returned by saveState.");
 
 static PyObject *gPySetGravity(PyObject *self, PyObject *args, PyObject *kwds)
 {
@@ -424,6 +435,23 @@ static PyObject *gPyGetCharacter(PyObject *self, PyObject *args, PyObject *kwds)
   Py_RETURN_NONE;
 }
 
+/// Convert the euler angles in degrees of a constraint frame into its axes.
+static void ConstraintAxesFromAngles(const MT_Vector3 &angles,
+                                     MT_Vector3 &axis0,
+                                     MT_Vector3 &axis1,
+                                     MT_Vector3 &axis2)
+{
+  // convert from euler angle into axis
+  const float deg2rad = 0.017453292f;
+
+  // we need to pass a full constraint frame, not just axis
+  // localConstraintFrameBasis
+  MT_Matrix3x3 localCFrame(angles * deg2rad);
+  axis0 = localCFrame.getColumn(0);
+  axis1 = localCFrame.getColumn(1);
+  axis2 = localCFrame.getColumn(2);
+}
+
 static PyObject *gPyCreateConstraint(PyObject *self, PyObject *args, PyObject *kwds)
 {
   /* FIXME - physicsid is a long being cast to a pointer, should at least use PyCapsule */
@@ -474,15 +502,8 @@ static PyObject *gPyCreateConstraint(PyObject *self, PyObject *args, PyObject *k
 
         return wrap->NewProxy(true);
       }
-      // convert from euler angle into axis
-      const float deg2rad = 0.017453292f;
-
-      // we need to pass a full constraint frame, not just axis
-      // localConstraintFrameBasis
-      MT_Matrix3x3 localCFrame(MT_Vector3(deg2rad * axisX, deg2rad * axisY, deg2rad * axisZ));
-      MT_Vector3 axis0 = localCFrame.getColumn(0);
-      MT_Vector3 axis1 = localCFrame.getColumn(1);
-      MT_Vector3 axis2 = localCFrame.getColumn(2);
+      MT_Vector3 axis0, axis1, axis2;
+      ConstraintAxesFromAngles(MT_Vector3(axisX, axisY, axisZ), axis0, axis1, axis2);
 
       PHY_IConstraint *constraint = PHY_GetActiveEnvironment()->CreateConstraint(
           physctrl,
@@ -520,6 +541,183 @@ static PyObject *gPyCreateConstraint(PyObject *self, PyObject *args, PyObject *k
   Py_RETURN_NONE;
 }
 
+/// Return the item of a sequence of the same length as the physics ids, nullptr if none.
+static PyObject *GetConstraintsItem(PyObject *seq, Py_ssize_t index)
+{
+  if (!seq) {
+    return nullptr;
+  }
+  PyObject *item = PySequence_Fast_GET_ITEM(seq, index);
+  return (item == Py_None) ? nullptr : item;
+}
+
+static PyObject *gPyCreateConstraints(PyObject *self, PyObject *args, PyObject *kwds)
+{
+  PyObject *pyids;
+  PyObject *pytype;
+  PyObject *pypivots;
+  PyObject *pyaxes = Py_None;
+  PyObject *pylimits = Py_None;
+  int flag = 0;
+
+  static const char *kwlist[] = {
+      "physicsids", "constraint_type", "pivots", "axes", "limits", "flag", nullptr};
+
+  if (!PyArg_ParseTupleAndKeywords(args,
+                                   kwds,
+                                   "OOO|OOi:createConstraints",
+                                   (char **)kwlist,
+                                   &pyids,
+                                   &pytype,
+                                   &pypivots,
+                                   &pyaxes,
+                                   &pylimits,
+                                   &flag)) {
+    return nullptr;
+  }
+
+  PHY_IPhysicsEnvironment *env = PHY_GetActiveEnvironment();
+  if (!env) {
+    Py_RETURN_NONE;
+  }
+
+  const bool singleType = PyLong_Check(pytype);
+  const int type = singleType ? PyLong_AsLong(pytype) : 0;
+
+  PyObject *ids = PySequence_Fast(pyids, "createConstraints(...): physicsids must be a sequence");
+  if (!ids) {
+    return nullptr;
+  }
+  const Py_ssize_t size = PySequence_Fast_GET_SIZE(ids);
+
+  /* Sequences of the pivots, the axes, the limits and the types, all with one item per
+   * constraint. */
+  std::array<PyObject *, 4> seqs = {{nullptr, nullptr, nullptr, nullptr}};
+  const std::array<PyObject *, 4> pyseqs = {
+      {pypivots, pyaxes, pylimits, singleType ? Py_None : pytype}};
+  static const char *names[] = {"pivots", "axes", "limits", "constraint_type"};
+
+  bool error = false;
+  for (unsigned short i = 0; i < 4 && !error; ++i) {
+    if (pyseqs[i] == Py_None) {
+      continue;
+    }
+    seqs[i] = PySequence_Fast(pyseqs[i], "createConstraints(...): expected a sequence");
+    if (!seqs[i]) {
+      error = true;
+    }
+    else if (PySequence_Fast_GET_SIZE(seqs[i]) != size) {
+      PyErr_Format(PyExc_ValueError,
+                   "createConstraints(...): %s must have one item per physics ids pair",
+                   names[i]);
+      error = true;
+    }
+  }
+
+  std::vector<PHY_ConstraintInfo> infos(size);
+  for (Py_ssize_t i = 0; i < size && !error; ++i) {
+    PHY_ConstraintInfo &info = infos[i];
+
+    unsigned long long physicsid = 0, physicsid2 = 0;
+    if (!PyArg_ParseTuple(PySequence_Fast_GET_ITEM(ids, i),
+                          "KK:createConstraints",
+                          &physicsid,
+                          &physicsid2)) {
+      error = true;
+      break;
+    }
+    info.m_ctrl0 = (PHY_IPhysicsController *)physicsid;
+    info.m_ctrl1 = (PHY_IPhysicsController *)physicsid2;
+
+    info.m_type = (PHY_ConstraintType)(
+        singleType ? type : PyLong_AsLong(PySequence_Fast_GET_ITEM(seqs[3], i)));
+    if (PyErr_Occurred()) {
+      error = true;
+      break;
+    }
+    if (info.m_type == PHY_VEHICLE_CONSTRAINT) {
+      PyErr_SetString(PyExc_ValueError,
+                      "createConstraints(...): use bge.constraints.createVehicle(chassis)");
+      error = true;
+      break;
+    }
+
+    info.m_pivot = MT_Vector3(0.0f, 0.0f, 0.0f);
+    PyObject *pypivot = GetConstraintsItem(seqs[0], i);
+    if (pypivot && !PyVecTo(pypivot, info.m_pivot)) {
+      error = true;
+      break;
+    }
+
+    MT_Vector3 angles(0.0f, 0.0f, 0.0f);
+    PyObject *pyangles = GetConstraintsItem(seqs[1], i);
+    if (pyangles && !PyVecTo(pyangles, angles)) {
+      error = true;
+      break;
+    }
+    ConstraintAxesFromAngles(angles, info.m_axis0, info.m_axis1, info.m_axis2);
+
+    info.m_flag = flag;
+
+    PyObject *pyparams = GetConstraintsItem(seqs[2], i);
+    if (pyparams) {
+      PyObject *params = PySequence_Fast(pyparams,
+                                         "createConstraints(...): limits items must be sequences");
+      if (!params) {
+        error = true;
+        break;
+      }
+      const Py_ssize_t numParams = PySequence_Fast_GET_SIZE(params);
+      info.m_params.resize(numParams);
+      for (Py_ssize_t j = 0; j < numParams; ++j) {
+        PHY_ConstraintInfo::Param &param = info.m_params[j];
+        if (!PyArg_ParseTuple(PySequence_Fast_GET_ITEM(params, j),
+                              "iff:createConstraints",
+                              &param.m_param,
+                              &param.m_value0,
+                              &param.m_value1)) {
+          error = true;
+          break;
+        }
+      }
+      Py_DECREF(params);
+      if (error) {
+        break;
+      }
+    }
+  }
+
+  Py_DECREF(ids);
+  for (PyObject *seq : seqs) {
+    Py_XDECREF(seq);
+  }
+
+  if (error) {
+    return nullptr;
+  }
+
+  std::vector<PHY_IConstraint *> constraints;
+  env->CreateConstraints(infos, constraints);
+
+  PyObject *list = PyList_New(size);
+  for (Py_ssize_t i = 0; i < size; ++i) {
+    PHY_IConstraint *constraint = constraints[i];
+    PyObject *item;
+    if (constraint) {
+      KX_ConstraintWrapper *wrap = new KX_ConstraintWrapper(
+          constraint, constraint->GetType(), constraint->GetIdentifier());
+      item = wrap->NewProxy(true);
+    }
+    else {
+      item = Py_None;
+      Py_INCREF(item);
+    }
+    PyList_SET_ITEM(list, i, item);
+  }
+
+  return list;
+}
+
 static PyObject *gPyCreateVehicle(PyObject *self, PyObject *args)
 {
   /* FIXME - physicsid is a long being cast to a pointer, should at least use PyCapsule */
@@ -604,6 +802,34 @@ static PyObject *gPyExportBulletFile(PyObject *, PyObject *args)
   Py_RETURN_NONE;
 }
 
+static PyObject *gPySaveState(PyObject *, PyObject *)
+{
+  PHY_IPhysicsEnvironment *env = PHY_GetActiveEnvironment();
+  if (!env) {
+    Py_RETURN_NONE;
+  }
+
+  // Reuse the buffer capacity between the calls.
+  static std::vector<char> buffer;
+  env->SaveState(buffer);
+
+  return PyBytes_FromStringAndSize(buffer.data(), buffer.size());
+}
+
+static PyObject *gPyRestoreState(PyObject *, PyObject *args)
+{
+  Py_buffer state;
+  if (!PyArg_ParseTuple(args, "y*:restoreState", &state)) {
+    return nullptr;
+  }
+
+  PHY_IPhysicsEnvironment *env = PHY_GetActiveEnvironment();
+  const bool result = env && env->RestoreState((const char *)state.buf, state.len);
+  PyBuffer_Release(&state);
+
+  return PyBool_FromLong(result);
+}
+
 static struct PyMethodDef physicsconstraints_methods[] = {
     {"setGravity", (PyCFunction)gPySetGravity, METH_VARARGS, (const char *)gPySetGravity__doc__},
     {"setDebugMode",
@@ -673,6 +899,10 @@ static struct PyMethodDef physicsconstraints_methods[] = {
      (PyCFunction)gPyCreateConstraint,
      METH_VARARGS | METH_KEYWORDS,
      (const char *)gPyCreateConstraint__doc__},
+    {"createConstraints",
+     (PyCFunction)gPyCreateConstraints,
+     METH_VARARGS | METH_KEYWORDS,
+     (const char *)gPyCreateConstraints__doc__},
     {"createVehicle",
      (PyCFunction)gPyCreateVehicle,
      METH_VARARGS,
@@ -697,6 +927,11 @@ static struct PyMethodDef physicsconstraints_methods[] = {
      (const char *)gPyGetAppliedImpulse__doc__},
 
     {"exportBulletFile", (PyCFunction)gPyExportBulletFile, METH_VARARGS, "export a .bullet file"},
+    {"saveState", (PyCFunction)gPySaveState, METH_NOARGS, (const char *)gPySaveState__doc__},
+    {"restoreState",
+     (PyCFunction)gPyRestoreState,
+     METH_VARARGS,
+     (const char *)gPyRestoreState__doc__},
 
     // sentinel
     {nullptr, (PyCFunction) nullptr, 0, nullptr}};
@@ -0,0 +1,180 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Ketsji/KX_PythonCoroutine.cpp
+ *  \ingroup ketsji
+ */
+
+#ifdef WITH_PYTHON
+
+#  include "KX_PythonCoroutine.h"
+
+#  include "KX_GameObject.h"
+#  include "KX_LibLoadStatus.h"
+#  include "KX_TaskFuture.h"
+
+PyObject *KX_CoroutineWait_New(KX_CoroutineWait::WaitType type, PyObject *object)
+{
+  KX_CoroutineWait *wait = PyObject_New(KX_CoroutineWait, &KX_CoroutineWait_Type);
+  wait->m_type = type;
+  wait->m_frames = 0;
+  wait->m_time = 0.0;
+  wait->m_layer = 0;
+  wait->m_object = object;
+  wait->m_yielded = false;
+  Py_XINCREF(object);
+
+  return (PyObject *)wait;
+}
+
+bool KX_CoroutineWait_Check(PyObject *obj)
+{
+  return (Py_TYPE(obj) == &KX_CoroutineWait_Type);
+}
+
+bool KX_CoroutineWait_IsDone(PyObject *wait_v, double time)
+{
+  KX_CoroutineWait *wait = (KX_CoroutineWait *)wait_v;
+
+  // A freed object doesn't suspend the coroutine anymore.
+  EXP_PyObjectPlus *ref = wait->m_object ? EXP_PROXY_REF(wait->m_object) : nullptr;
+  if (wait->m_object && !ref) {
+    return true;
+  }
+
+  switch (wait->m_type) {
+    case KX_CoroutineWait::WAIT_FRAMES: {
+      return (--wait->m_frames <= 0);
+    }
+    case KX_CoroutineWait::WAIT_TIME: {
+      return (time >= wait->m_time);
+    }
+    case KX_CoroutineWait::WAIT_ACTION: {
+      return static_cast<KX_GameObject *>(ref)->IsActionDone(wait->m_layer);
+    }
+    case KX_CoroutineWait::WAIT_LIBLOAD: {
+      return static_cast<KX_LibLoadStatus *>(ref)->IsFinished();
+    }
+    case KX_CoroutineWait::WAIT_TASK: {
+      return static_cast<KX_TaskFuture *>(ref)->IsDone();
+    }
+  }
+
+  return true;
+}
+
+static void KX_CoroutineWait_dealloc(KX_CoroutineWait *self)
+{
+  Py_XDECREF(self->m_object);
+  Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static PyObject *KX_CoroutineWait_await(KX_CoroutineWait *self)
+{
+  Py_INCREF(self);
+  return (PyObject *)self;
+}
+
+/** The first step yields the wait to the component, the second ends the await with the lib load
+ * status or the task result.
+ */
+static PyObject *KX_CoroutineWait_iternext(KX_CoroutineWait *self)
+{
+  if (!self->m_yielded) {
+    self->m_yielded = true;
+    Py_INCREF(self);
+    return (PyObject *)self;
+  }
+
+  PyObject *value = nullptr;
+  if (self->m_object && EXP_PROXY_REF(self->m_object)) {
+    if (self->m_type == KX_CoroutineWait::WAIT_LIBLOAD) {
+      Py_INCREF(self->m_object);
+      value = self->m_object;
+    }
+    else if (self->m_type == KX_CoroutineWait::WAIT_TASK) {
+      value = PyObject_GetAttrString(self->m_object, "result");
+      if (!value) {
+        return nullptr;
+      }
+    }
+  }
+
+  if (value) {
+    // Wrap the value in the exception, a tuple would be used as the exception arguments.
+    PyObject *exc = PyObject_CallOneArg(PyExc_StopIteration, value);
+    PyErr_SetObject(PyExc_StopIteration, exc);
+    Py_DECREF(exc);
+    Py_DECREF(value);
+  }
+
+  // Without exception set the end of the iteration returns None.
+  return nullptr;
+}
+
+static PyAsyncMethods KX_CoroutineWait_async = {
+    (unaryfunc)KX_CoroutineWait_await, /* am_await */
+    nullptr,                           /* am_aiter */
+    nullptr,                           /* am_anext */
+};
+
+PyTypeObject KX_CoroutineWait_Type = {
+    PyVarObject_HEAD_INIT(nullptr, 0) "KX_CoroutineWait", /* tp_name */
+    sizeof(KX_CoroutineWait),                             /* tp_basicsize */
+    0,                                                    /* tp_itemsize */
+    (destructor)KX_CoroutineWait_dealloc,                 /* tp_dealloc */
+    0,                                                    /* tp_vectorcall_offset */
+    0,                                                    /* tp_getattr */
+    0,                                                    /* tp_setattr */
+    &KX_CoroutineWait_async,                              /* tp_as_async */
+    0,                                                    /* tp_repr */
+    0,                                                    /* tp_as_number */
+    0,                                                    /* tp_as_sequence */
+    0,                                                    /* tp_as_mapping */
+    0,                                                    /* tp_hash */
+    0,                                                    /* tp_call */
+    0,                                                    /* tp_str */
+    0,                                                    /* tp_getattro */
+    0,                                                    /* tp_setattro */
+    0,                                                    /* tp_as_buffer */
+    Py_TPFLAGS_DEFAULT,                                   /* tp_flags */
+    "Wait of a component update coroutine",               /* tp_doc */
+    0,                                                    /* tp_traverse */
+    0,                                                    /* tp_clear */
+    0,                                                    /* tp_richcompare */
+    0,                                                    /* tp_weaklistoffset */
+    PyObject_SelfIter,                                    /* tp_iter */
+    (iternextfunc)KX_CoroutineWait_iternext,              /* tp_iternext */
+};
+
+static PyObject *KX_CoroutineWait_await_libload(PyObject *self)
+{
+  return KX_CoroutineWait_New(KX_CoroutineWait::WAIT_LIBLOAD, self);
+}
+
+static PyObject *KX_CoroutineWait_await_task(PyObject *self)
+{
+  return KX_CoroutineWait_New(KX_CoroutineWait::WAIT_TASK, self);
+}
+
+PyAsyncMethods KX_CoroutineWait_LibLoadAsync = {KX_CoroutineWait_await_libload, nullptr, nullptr};
+PyAsyncMethods KX_CoroutineWait_TaskAsync = {KX_CoroutineWait_await_task, nullptr, nullptr};
+
+#endif  // WITH_PYTHON
@@ -0,0 +1,75 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file KX_PythonCoroutine.h
+ *  \ingroup ketsji
+ */
+
+#pragma once
+
+#ifdef WITH_PYTHON
+
+#  include "EXP_Python.h"
+
+/** Awaitable suspending the update coroutine of a python component until a condition is met.
+ * It is yielded to the component which checks the condition each frame without calling python
+ * and resumes the coroutine once met.
+ */
+struct KX_CoroutineWait {
+  PyObject_HEAD
+
+  enum WaitType {
+    WAIT_FRAMES = 0,
+    WAIT_TIME,
+    WAIT_ACTION,
+    WAIT_LIBLOAD,
+    WAIT_TASK,
+  };
+
+  WaitType m_type;
+  /// Frames before the resume.
+  int m_frames;
+  /// Frame time of the resume.
+  double m_time;
+  /// Layer of the waited action.
+  short m_layer;
+  /// Proxy of the game object, lib load status or task future waited, nullptr if none.
+  PyObject *m_object;
+  /// The wait was yielded to the component.
+  bool m_yielded;
+};
+
+extern PyTypeObject KX_CoroutineWait_Type;
+
+/** Create a wait.
+ * \param object The proxy of the waited object, a new reference is held.
+ */
+PyObject *KX_CoroutineWait_New(KX_CoroutineWait::WaitType type, PyObject *object);
+bool KX_CoroutineWait_Check(PyObject *obj);
+/** Return true when the coroutine suspended by the wait can be resumed, called once per frame.
+ * \param time The current frame time.
+ */
+bool KX_CoroutineWait_IsDone(PyObject *wait, double time);
+
+/// Await slots of the lib load status and the task futures.
+extern PyAsyncMethods KX_CoroutineWait_LibLoadAsync;
+extern PyAsyncMethods KX_CoroutineWait_TaskAsync;
+
+#endif  // WITH_PYTHON
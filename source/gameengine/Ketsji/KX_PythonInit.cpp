@@ -56,6 +56,7 @@
 #  include "BLI_utildefines.h"
 #  include "DNA_ID.h"
 #  include "DNA_scene_types.h"
+#  include "DRW_render.h"
 #  include "GPU_material.h"
 #  include "MEM_guardedalloc.h"
 #  include "bgl.h"
@@ -100,9 +101,11 @@
 
 // python physics binding
 #include "BL_Action.h"
+#include "BL_ActionManager.h"
 #include "BL_BlenderConverter.h"
 #include "BL_Shader.h"
 #include "CM_Message.h"
+#include "CM_Trace.h"
 #include "KX_Globals.h"
 #include "KX_LibLoadStatus.h"
 #include "KX_MeshProxy.h" /* for creating a new library of mesh objects */
@@ -110,7 +113,10 @@
 #include "KX_NetworkMessageScene.h"  //Needed for sendMessage()
 #include "KX_PyConstraintBinding.h"
 #include "KX_PyMath.h"
+#include "KX_PythonCoroutine.h"
 #include "KX_PythonInitTypes.h"
+#include "KX_VideoCapture.h"
+#include "KX_WorldStreamer.h"
 #include "PHY_IPhysicsEnvironment.h"
 #include "RAS_2DFilterManager.h"
 #include "RAS_ICanvas.h"
@@ -144,6 +150,8 @@
 static SCA_PythonKeyboard *gp_PythonKeyboard = nullptr;
 static SCA_PythonMouse *gp_PythonMouse = nullptr;
 static SCA_PythonJoystick *gp_PythonJoysticks[JOYINDEX_MAX] = {nullptr};
+/// Function registered in gc.callbacks to report the collections to the hitch detector.
+static PyObject *gp_GCCallback = nullptr;
 
 static struct {
   PyObject *path;
@@ -181,6 +189,28 @@ static PyObject *gPyGetRandomFloat(PyObject *)
   return PyFloat_FromDouble(MT_random());
 }
 
+PyDoc_STRVAR(gPyGetRandomFloats_doc,
+             "getRandomFloats(count)\n"
+             "returns a list of random floating point values in the range [0..1]");
+static PyObject *gPyGetRandomFloats(PyObject *, PyObject *args)
+{
+  int count;
+  if (!PyArg_ParseTuple(args, "i:getRandomFloats", &count)) {
+    return nullptr;
+  }
+  if (count < 0) {
+    PyErr_SetString(PyExc_ValueError, "getRandomFloats(count): count must be positive or zero");
+    return nullptr;
+  }
+
+  PyObject *list = PyList_New(count);
+  for (int i = 0; i < count; ++i) {
+    PyList_SET_ITEM(list, i, PyFloat_FromDouble(MT_random()));
+  }
+
+  return list;
+}
+
 static PyObject *gPySetGravity(PyObject *, PyObject *value)
 {
   MT_Vector3 vec;
@@ -282,6 +312,182 @@ static PyObject *gPyGetProfileInfo(PyObject *)
   return KX_GetActiveEngine()->GetPyProfileDict();
 }
 
+PyDoc_STRVAR(gPyStartTraceRecord_doc,
+             "startTraceRecord()\n"
+             "starts recording a timeline of the engine events");
+static PyObject *gPyStartTraceRecord(PyObject *)
+{
+  CM_Trace::Start();
+  Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(gPyStopTraceRecord_doc,
+             "stopTraceRecord(filepath)\n"
+             "stops recording the timeline and writes it as a Chrome trace JSON file");
+static PyObject *gPyStopTraceRecord(PyObject *, PyObject *args)
+{
+  char *filename;
+  if (!PyArg_ParseTuple(args, "s:stopTraceRecord", &filename)) {
+    return nullptr;
+  }
+
+  if (!CM_Trace::IsEnabled()) {
+    PyErr_SetString(PyExc_RuntimeError, "stopTraceRecord(filepath): no trace is recorded");
+    return nullptr;
+  }
+
+  char filepath[FILE_MAX];
+  BLI_strncpy(filepath, filename, FILE_MAX);
+  BLI_path_abs(filepath, KX_GetMainPath().c_str());
+
+  if (!CM_Trace::Stop(filepath)) {
+    PyErr_Format(PyExc_OSError, "stopTraceRecord(filepath): cannot write file '%s'", filepath);
+    return nullptr;
+  }
+
+  Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(gPyGetProfileStatistics_doc,
+             "getProfileStatistics()\n"
+             "returns a dictionary with the percentiles of the frame times of each category");
+static PyObject *gPyGetProfileStatistics(PyObject *)
+{
+  return KX_GetActiveEngine()->GetPyProfileStatistics();
+}
+
+static PyObject *gPyGCCallback(PyObject *, PyObject *args)
+{
+  const char *phase;
+  PyObject *info;
+  if (!PyArg_ParseTuple(args, "sO!:gcCallback", &phase, &PyDict_Type, &info)) {
+    return nullptr;
+  }
+
+  KX_KetsjiEngine *engine = KX_GetActiveEngine();
+  if (engine && engine->GetFrameStatistics().UseEvents() && STREQ(phase, "stop")) {
+    PyObject *generation = PyDict_GetItemString(info, "generation");
+    const long index = generation ? PyLong_AsLong(generation) : -1;
+    engine->GetFrameStatistics().AddEvent("GC", "generation " + std::to_string(index));
+  }
+
+  Py_RETURN_NONE;
+}
+
+static PyMethodDef gGCCallbackMethod = {
+    "gcCallback", (PyCFunction)gPyGCCallback, METH_VARARGS, nullptr};
+
+/// Add or remove the hitch detector function from gc.callbacks.
+static void setGCCallback(bool enable)
+{
+  if (enable == (gp_GCCallback != nullptr)) {
+    return;
+  }
+
+  PyObject *gc = PyImport_ImportModule("gc");
+  PyObject *callbacks = gc ? PyObject_GetAttrString(gc, "callbacks") : nullptr;
+  if (callbacks) {
+    if (enable) {
+      gp_GCCallback = PyCFunction_New(&gGCCallbackMethod, nullptr);
+      PyList_Append(callbacks, gp_GCCallback);
+    }
+    else {
+      const Py_ssize_t index = PySequence_Index(callbacks, gp_GCCallback);
+      if (index != -1) {
+        PySequence_DelItem(callbacks, index);
+      }
+      Py_CLEAR(gp_GCCallback);
+    }
+  }
+
+  if (PyErr_Occurred()) {
+    PyErr_Clear();
+  }
+  Py_XDECREF(callbacks);
+  Py_XDECREF(gc);
+}
+
+PyDoc_STRVAR(gPySetHitchThreshold_doc,
+             "setHitchThreshold(threshold)\n"
+             "sets the minimum duration in ms of the frames recorded as hitches, 0 disables "
+             "the detection");
+static PyObject *gPySetHitchThreshold(PyObject *, PyObject *args)
+{
+  float threshold;
+  if (!PyArg_ParseTuple(args, "f:setHitchThreshold", &threshold)) {
+    return nullptr;
+  }
+
+  if (threshold < 0.0f) {
+    PyErr_SetString(PyExc_ValueError,
+                    "setHitchThreshold(threshold): threshold must be positive or zero");
+    return nullptr;
+  }
+
+  KX_GetActiveEngine()->GetFrameStatistics().SetHitchThreshold(threshold / 1000.0);
+  setGCCallback(threshold > 0.0f);
+
+  Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(gPyGetHitchThreshold_doc,
+             "getHitchThreshold()\n"
+             "returns the minimum duration in ms of the frames recorded as hitches");
+static PyObject *gPyGetHitchThreshold(PyObject *)
+{
+  return PyFloat_FromDouble(KX_GetActiveEngine()->GetFrameStatistics().GetHitchThreshold() *
+                            1000.0);
+}
+
+PyDoc_STRVAR(gPyGetHitches_doc,
+             "getHitches()\n"
+             "returns a list of the last frames longer than the hitch threshold");
+static PyObject *gPyGetHitches(PyObject *)
+{
+  return KX_GetActiveEngine()->GetPyHitches();
+}
+
+PyDoc_STRVAR(gPyGetObjectProfile_doc,
+             "getObjectProfile(count=8)\n"
+             "returns a list of the objects taking the most time since the object profiling was "
+             "enabled");
+static PyObject *gPyGetObjectProfile(PyObject *, PyObject *args)
+{
+  int count = 8;
+  if (!PyArg_ParseTuple(args, "|i:getObjectProfile", &count)) {
+    return nullptr;
+  }
+
+  if (count < 0) {
+    PyErr_SetString(PyExc_ValueError, "getObjectProfile(count): count must be positive");
+    return nullptr;
+  }
+
+  return KX_GetActiveEngine()->GetPyObjectProfile(count);
+}
+
+PyDoc_STRVAR(gPyGetMemoryInfo_doc,
+             "getMemoryInfo()\n"
+             "returns a dictionary with the memory used by each subsystem");
+static PyObject *gPyGetMemoryInfo(PyObject *)
+{
+  KX_MemoryReport report;
+  KX_GetActiveEngine()->FillMemoryReport(report);
+
+  PyObject *dict = PyDict_New();
+  for (int i = 0; i < KX_MemoryReport::MEM_NUM_CATEGORIES; ++i) {
+    const KX_MemoryReport::Entry &entry = report.GetEntry((KX_MemoryReport::Category)i);
+    PyObject *val = PyTuple_New(2);
+    PyTuple_SET_ITEM(val, 0, PyLong_FromSize_t(entry.m_count));
+    PyTuple_SET_ITEM(val, 1, PyLong_FromSize_t(entry.m_bytes));
+
+    PyDict_SetItemString(dict, KX_MemoryReport::m_categoryLabels[i].c_str(), val);
+    Py_DECREF(val);
+  }
+
+  return dict;
+}
+
 PyDoc_STRVAR(gPySendMessage_doc,
              "sendMessage(subject, [body, to, from])\n"
              "sends a message in same manner as a message actuator"
@@ -430,6 +636,16 @@ static PyObject *gPyGetAverageFrameRate(PyObject *)
   return PyFloat_FromDouble(KX_GetActiveEngine()->GetAverageFrameRate());
 }
 
+static PyObject *gPyGetAverageFrameDrift(PyObject *)
+{
+  return PyFloat_FromDouble(KX_GetActiveEngine()->GetAverageFrameDrift());
+}
+
+static PyObject *gPyGetAveragePresentLatency(PyObject *)
+{
+  return PyFloat_FromDouble(KX_GetActiveEngine()->GetAveragePresentLatency());
+}
+
 static PyObject *gPyGetUseExternalClock(PyObject *)
 {
   return PyBool_FromLong(KX_GetActiveEngine()->GetFlag(KX_KetsjiEngine::USE_EXTERNAL_CLOCK));
@@ -442,7 +658,274 @@ static PyObject *gPySetUseExternalClock(PyObject *, PyObject *args)
   if (!PyArg_ParseTuple(args, "p:setUseExternalClock", &bUseExternalClock))
     return nullptr;
 
-  KX_GetActiveEngine()->SetFlag(KX_KetsjiEngine::USE_EXTERNAL_CLOCK, (bool)bUseExternalClock);
+  KX_GetActiveEngine()->SetFlag(KX_KetsjiEngine::USE_EXTERNAL_CLOCK, (bool)bUseExternalClock);
+  Py_RETURN_NONE;
+}
+
+static PyObject *gPyGetUseParallelSceneStep(PyObject *)
+{
+  return PyBool_FromLong(KX_GetActiveEngine()->GetFlag(KX_KetsjiEngine::PARALLEL_SCENE_STEP));
+}
+
+static PyObject *gPySetUseParallelSceneStep(PyObject *, PyObject *args)
+{
+  int useParallelSceneStep;
+
+  if (!PyArg_ParseTuple(args, "p:setUseParallelSceneStep", &useParallelSceneStep))
+    return nullptr;
+
+  KX_GetActiveEngine()->SetFlag(KX_KetsjiEngine::PARALLEL_SCENE_STEP,
+                                (bool)useParallelSceneStep);
+  Py_RETURN_NONE;
+}
+
+static PyObject *gPyGetUseRetainedDraw(PyObject *)
+{
+  return PyBool_FromLong(KX_GetActiveEngine()->GetFlag(KX_KetsjiEngine::RETAINED_DRAW));
+}
+
+static PyObject *gPySetUseRetainedDraw(PyObject *, PyObject *args)
+{
+  int useRetainedDraw;
+
+  if (!PyArg_ParseTuple(args, "p:setUseRetainedDraw", &useRetainedDraw))
+    return nullptr;
+
+  KX_GetActiveEngine()->SetFlag(KX_KetsjiEngine::RETAINED_DRAW, (bool)useRetainedDraw);
+  Py_RETURN_NONE;
+}
+
+static PyObject *gPyGetUseFramePacing(PyObject *)
+{
+  return PyBool_FromLong(KX_GetActiveEngine()->GetFlag(KX_KetsjiEngine::FRAME_PACING));
+}
+
+static PyObject *gPySetUseFramePacing(PyObject *, PyObject *args)
+{
+  int useFramePacing;
+
+  if (!PyArg_ParseTuple(args, "p:setUseFramePacing", &useFramePacing))
+    return nullptr;
+
+  KX_GetActiveEngine()->SetFlag(KX_KetsjiEngine::FRAME_PACING, (bool)useFramePacing);
+  Py_RETURN_NONE;
+}
+
+static PyObject *gPyGetUsePhysicsInterpolation(PyObject *)
+{
+  return PyBool_FromLong(KX_GetActiveEngine()->GetFlag(KX_KetsjiEngine::PHYSICS_INTERPOLATION));
+}
+
+static PyObject *gPySetUsePhysicsInterpolation(PyObject *, PyObject *args)
+{
+  int usePhysicsInterpolation;
+
+  if (!PyArg_ParseTuple(args, "p:setUsePhysicsInterpolation", &usePhysicsInterpolation))
+    return nullptr;
+
+  KX_GetActiveEngine()->SetFlag(KX_KetsjiEngine::PHYSICS_INTERPOLATION,
+                                (bool)usePhysicsInterpolation);
+  Py_RETURN_NONE;
+}
+
+static PyObject *gPyGetUseDeferredSwap(PyObject *)
+{
+  return PyBool_FromLong(KX_GetActiveEngine()->GetFlag(KX_KetsjiEngine::DEFERRED_SWAP));
+}
+
+static PyObject *gPySetUseDeferredSwap(PyObject *, PyObject *args)
+{
+  int useDeferredSwap;
+
+  if (!PyArg_ParseTuple(args, "p:setUseDeferredSwap", &useDeferredSwap))
+    return nullptr;
+
+  KX_GetActiveEngine()->SetFlag(KX_KetsjiEngine::DEFERRED_SWAP, (bool)useDeferredSwap);
+  Py_RETURN_NONE;
+}
+
+static PyObject *gPyGetUseLowLatency(PyObject *)
+{
+  return PyBool_FromLong(KX_GetActiveEngine()->GetFlag(KX_KetsjiEngine::LOW_LATENCY));
+}
+
+static PyObject *gPySetUseLowLatency(PyObject *, PyObject *args)
+{
+  int useLowLatency;
+
+  if (!PyArg_ParseTuple(args, "p:setUseLowLatency", &useLowLatency))
+    return nullptr;
+
+  KX_GetActiveEngine()->SetFlag(KX_KetsjiEngine::LOW_LATENCY, (bool)useLowLatency);
+  Py_RETURN_NONE;
+}
+
+static PyObject *gPyGetMaxFramesInFlight(PyObject *)
+{
+  return PyLong_FromLong(KX_GetActiveEngine()->GetMaxFramesInFlight());
+}
+
+static PyObject *gPySetMaxFramesInFlight(PyObject *, PyObject *args)
+{
+  int frames;
+
+  if (!PyArg_ParseTuple(args, "i:setMaxFramesInFlight", &frames))
+    return nullptr;
+
+  if (frames < 1 || frames > 8) {
+    PyErr_SetString(PyExc_ValueError,
+                    "bge.logic.setMaxFramesInFlight(frames): frames must be between 1 and 8");
+    return nullptr;
+  }
+
+  KX_GetActiveEngine()->SetMaxFramesInFlight(frames);
+  Py_RETURN_NONE;
+}
+
+static PyObject *gPyGetUseInstancedCollections(PyObject *)
+{
+  return PyBool_FromLong(
+      KX_GetActiveEngine()->GetFlag(KX_KetsjiEngine::INSTANCED_COLLECTIONS));
+}
+
+static PyObject *gPySetUseInstancedCollections(PyObject *, PyObject *args)
+{
+  int useInstancedCollections;
+
+  if (!PyArg_ParseTuple(args, "p:setUseInstancedCollections", &useInstancedCollections))
+    return nullptr;
+
+  KX_GetActiveEngine()->SetFlag(KX_KetsjiEngine::INSTANCED_COLLECTIONS,
+                                (bool)useInstancedCollections);
+  Py_RETURN_NONE;
+}
+
+static PyObject *gPyGetUseStaticBatching(PyObject *)
+{
+  return PyBool_FromLong(KX_GetActiveEngine()->GetFlag(KX_KetsjiEngine::STATIC_BATCHING));
+}
+
+static PyObject *gPySetUseStaticBatching(PyObject *, PyObject *args)
+{
+  int useStaticBatching;
+
+  if (!PyArg_ParseTuple(args, "p:setUseStaticBatching", &useStaticBatching))
+    return nullptr;
+
+  KX_GetActiveEngine()->SetFlag(KX_KetsjiEngine::STATIC_BATCHING, (bool)useStaticBatching);
+  Py_RETURN_NONE;
+}
+
+static PyObject *gPyGetUseParallelLogic(PyObject *)
+{
+  return PyBool_FromLong(KX_GetActiveEngine()->GetFlag(KX_KetsjiEngine::PARALLEL_LOGIC));
+}
+
+static PyObject *gPySetUseParallelLogic(PyObject *, PyObject *args)
+{
+  int useParallelLogic;
+
+  if (!PyArg_ParseTuple(args, "p:setUseParallelLogic", &useParallelLogic))
+    return nullptr;
+
+  KX_GetActiveEngine()->SetFlag(KX_KetsjiEngine::PARALLEL_LOGIC, (bool)useParallelLogic);
+  Py_RETURN_NONE;
+}
+
+static PyObject *gPyGetUseStaggeredPulses(PyObject *)
+{
+  return PyBool_FromLong(KX_GetActiveEngine()->GetFlag(KX_KetsjiEngine::STAGGER_PULSES));
+}
+
+static PyObject *gPySetUseStaggeredPulses(PyObject *, PyObject *args)
+{
+  int useStaggeredPulses;
+
+  if (!PyArg_ParseTuple(args, "p:setUseStaggeredPulses", &useStaggeredPulses))
+    return nullptr;
+
+  KX_GetActiveEngine()->SetFlag(KX_KetsjiEngine::STAGGER_PULSES, (bool)useStaggeredPulses);
+  Py_RETURN_NONE;
+}
+
+static PyObject *gPyGetUseScriptProfile(PyObject *)
+{
+  return PyBool_FromLong(KX_GetActiveEngine()->GetFlag(KX_KetsjiEngine::PROFILE_SCRIPTS));
+}
+
+static PyObject *gPySetUseScriptProfile(PyObject *, PyObject *args)
+{
+  int useScriptProfile;
+
+  if (!PyArg_ParseTuple(args, "p:setUseScriptProfile", &useScriptProfile))
+    return nullptr;
+
+  KX_GetActiveEngine()->SetFlag(KX_KetsjiEngine::PROFILE_SCRIPTS, (bool)useScriptProfile);
+  Py_RETURN_NONE;
+}
+
+static PyObject *gPyGetUseGpuProfile(PyObject *)
+{
+  return PyBool_FromLong(KX_GetActiveEngine()->GetFlag(KX_KetsjiEngine::PROFILE_GPU));
+}
+
+static PyObject *gPySetUseGpuProfile(PyObject *, PyObject *args)
+{
+  int useGpuProfile;
+
+  if (!PyArg_ParseTuple(args, "p:setUseGpuProfile", &useGpuProfile))
+    return nullptr;
+
+  KX_GetActiveEngine()->SetFlag(KX_KetsjiEngine::PROFILE_GPU, (bool)useGpuProfile);
+  Py_RETURN_NONE;
+}
+
+static PyObject *gPyGetUseObjectProfile(PyObject *)
+{
+  return PyBool_FromLong(KX_GetActiveEngine()->GetFlag(KX_KetsjiEngine::PROFILE_OBJECTS));
+}
+
+static PyObject *gPySetUseObjectProfile(PyObject *, PyObject *args)
+{
+  int useObjectProfile;
+
+  if (!PyArg_ParseTuple(args, "p:setUseObjectProfile", &useObjectProfile))
+    return nullptr;
+
+  KX_GetActiveEngine()->SetFlag(KX_KetsjiEngine::PROFILE_OBJECTS, (bool)useObjectProfile);
+  Py_RETURN_NONE;
+}
+
+static PyObject *gPyGetUseDepsgraphProfile(PyObject *)
+{
+  return PyBool_FromLong(KX_GetActiveEngine()->GetFlag(KX_KetsjiEngine::PROFILE_DEPSGRAPH));
+}
+
+static PyObject *gPySetUseDepsgraphProfile(PyObject *, PyObject *args)
+{
+  int useDepsgraphProfile;
+
+  if (!PyArg_ParseTuple(args, "p:setUseDepsgraphProfile", &useDepsgraphProfile))
+    return nullptr;
+
+  KX_GetActiveEngine()->SetFlag(KX_KetsjiEngine::PROFILE_DEPSGRAPH, (bool)useDepsgraphProfile);
+  Py_RETURN_NONE;
+}
+
+static PyObject *gPyGetUseAllocationProfile(PyObject *)
+{
+  return PyBool_FromLong(KX_GetActiveEngine()->GetFlag(KX_KetsjiEngine::PROFILE_ALLOCATIONS));
+}
+
+static PyObject *gPySetUseAllocationProfile(PyObject *, PyObject *args)
+{
+  int useAllocationProfile;
+
+  if (!PyArg_ParseTuple(args, "p:setUseAllocationProfile", &useAllocationProfile))
+    return nullptr;
+
+  KX_GetActiveEngine()->SetFlag(KX_KetsjiEngine::PROFILE_ALLOCATIONS,
+                                (bool)useAllocationProfile);
   Py_RETURN_NONE;
 }
 
@@ -557,6 +1040,21 @@ static PyObject *gPyGetInactiveSceneNames(PyObject *self)
   return list->NewProxy(true);
 }
 
+PyDoc_STRVAR(gPyPreloadScene_doc,
+             "preloadScene(name)\n"
+             "Convert an inactive scene at the end of the frame, a later replace by this scene "
+             "only activates it");
+static PyObject *gPyPreloadScene(PyObject *, PyObject *value)
+{
+  const char *name = _PyUnicode_AsString(value);
+  if (!name) {
+    PyErr_SetString(PyExc_TypeError, "bge.logic.preloadScene(name): expected a string");
+    return nullptr;
+  }
+
+  return PyBool_FromLong(KX_GetActiveEngine()->PreloadScene(name));
+}
+
 static PyObject *pyPrintStats(PyObject *, PyObject *, PyObject *)
 {
   KX_GetActiveEngine()->GetConverter()->PrintStats();
@@ -587,6 +1085,25 @@ static PyObject *pyPrintExt(PyObject *, PyObject *, PyObject *)
   Py_RETURN_NONE;
 }
 
+/// Append the strings of a python list of datablock names, return false if an item isn't a str.
+static bool libload_names_from_list(PyObject *list, std::vector<std::string> &r_names)
+{
+  if (!list) {
+    return true;
+  }
+
+  for (Py_ssize_t i = 0, size = PyList_GET_SIZE(list); i < size; ++i) {
+    PyObject *item = PyList_GET_ITEM(list, i);
+    if (!PyUnicode_Check(item)) {
+      PyErr_SetString(PyExc_TypeError, "LibLoad(...): expected a list of datablock names");
+      return false;
+    }
+    r_names.push_back(_PyUnicode_AsString(item));
+  }
+
+  return true;
+}
+
 static PyObject *gLibLoad(PyObject *, PyObject *args, PyObject *kwds)
 {
   KX_Scene *kx_scene = nullptr;
@@ -600,6 +1117,11 @@ static PyObject *gLibLoad(PyObject *, PyObject *args, PyObject *kwds)
 
   short options = 0;
   int load_actions = 0, verbose = 0, load_scripts = 1, asynchronous = 0;
+  float merge_budget = 0.0f;
+  PyObject *pyobjects = nullptr;
+  PyObject *pycollections = nullptr;
+  PyObject *pymeshes = nullptr;
+  int dependencies_only = 0;
 
   static const char *kwlist[] = {"path",
                                  "group",
@@ -609,11 +1131,16 @@ static PyObject *gLibLoad(PyObject *, PyObject *args, PyObject *kwds)
                                  "load_scripts",
                                  "asynchronous",
                                  "scene",
+                                 "merge_budget",
+                                 "objects",
+                                 "collections",
+                                 "meshes",
+                                 "dependencies_only",
                                  nullptr};
 
   if (!PyArg_ParseTupleAndKeywords(args,
                                    kwds,
-                                   "ss|y*iiIiO:LibLoad",
+                                   "ss|y*iiIiOfO!O!O!i:LibLoad",
                                    const_cast<char **>(kwlist),
                                    &path,
                                    &group,
@@ -622,8 +1149,27 @@ static PyObject *gLibLoad(PyObject *, PyObject *args, PyObject *kwds)
                                    &verbose,
                                    &load_scripts,
                                    &asynchronous,
-                                   &pyscene))
+                                   &pyscene,
+                                   &merge_budget,
+                                   &PyList_Type,
+                                   &pyobjects,
+                                   &PyList_Type,
+                                   &pycollections,
+                                   &PyList_Type,
+                                   &pymeshes,
+                                   &dependencies_only))
+    return nullptr;
+
+  BL_BlenderConverter::LibLoadFilter filter;
+  if (!libload_names_from_list(pyobjects, filter.m_objects) ||
+      !libload_names_from_list(pycollections, filter.m_collections) ||
+      !libload_names_from_list(pymeshes, filter.m_meshes)) {
+    if (py_buffer.buf) {
+      PyBuffer_Release(&py_buffer);
+    }
     return nullptr;
+  }
+  const bool use_filter = (pyobjects || pycollections || pymeshes);
 
   if (!ConvertPythonToScene(pyscene, &kx_scene, true, "invalid scene")) {
     return nullptr;
@@ -641,6 +1187,8 @@ static PyObject *gLibLoad(PyObject *, PyObject *args, PyObject *kwds)
     options |= BL_BlenderConverter::LIB_LOAD_LOAD_SCRIPTS;
   if (asynchronous != 0)
     options |= BL_BlenderConverter::LIB_LOAD_ASYNC;
+  if (dependencies_only != 0)
+    options |= BL_BlenderConverter::LIB_LOAD_DEPENDENCIES_ONLY;
 
   BL_BlenderConverter *converter = KX_GetActiveEngine()->GetConverter();
 
@@ -650,15 +1198,28 @@ static PyObject *gLibLoad(PyObject *, PyObject *args, PyObject *kwds)
     BLI_strncpy(abs_path, path, sizeof(abs_path));
     BLI_path_abs(abs_path, KX_GetMainPath().c_str());
 
-    if ((status = converter->LinkBlendFilePath(abs_path, group, kx_scene, &err_str, options))) {
+    if ((status = converter->LinkBlendFilePath(abs_path,
+                                               group,
+                                               kx_scene,
+                                               &err_str,
+                                               options,
+                                               use_filter ? &filter : nullptr))) {
+      status->SetMergeBudget(merge_budget);
       return status->GetProxy();
     }
   }
   else {
 
-    if ((status = converter->LinkBlendFileMemory(
-             py_buffer.buf, py_buffer.len, path, group, kx_scene, &err_str, options))) {
+    if ((status = converter->LinkBlendFileMemory(py_buffer.buf,
+                                                 py_buffer.len,
+                                                 path,
+                                                 group,
+                                                 kx_scene,
+                                                 &err_str,
+                                                 options,
+                                                 use_filter ? &filter : nullptr))) {
       PyBuffer_Release(&py_buffer);
+      status->SetMergeBudget(merge_budget);
       return status->GetProxy();
     }
 
@@ -775,10 +1336,73 @@ static PyObject *gPyNextFrame(PyObject *)
   }
 }
 
+PyDoc_STRVAR(gPyWaitFrames_doc,
+             "waitFrames(frames=1)\n"
+             "Return an awaitable suspending a component update coroutine for a number of frames");
+static PyObject *gPyWaitFrames(PyObject *, PyObject *args)
+{
+  int frames = 1;
+  if (!PyArg_ParseTuple(args, "|i:waitFrames", &frames)) {
+    return nullptr;
+  }
+
+  PyObject *wait = KX_CoroutineWait_New(KX_CoroutineWait::WAIT_FRAMES, nullptr);
+  ((KX_CoroutineWait *)wait)->m_frames = frames;
+  return wait;
+}
+
+PyDoc_STRVAR(gPyWaitSeconds_doc,
+             "waitSeconds(seconds)\n"
+             "Return an awaitable suspending a component update coroutine for a game time");
+static PyObject *gPyWaitSeconds(PyObject *, PyObject *args)
+{
+  double seconds;
+  if (!PyArg_ParseTuple(args, "d:waitSeconds", &seconds)) {
+    return nullptr;
+  }
+
+  PyObject *wait = KX_CoroutineWait_New(KX_CoroutineWait::WAIT_TIME, nullptr);
+  ((KX_CoroutineWait *)wait)->m_time = KX_GetActiveEngine()->GetFrameTime() + seconds;
+  return wait;
+}
+
+PyDoc_STRVAR(gPyWaitAction_doc,
+             "waitAction(object, layer=0)\n"
+             "Return an awaitable suspending a component update coroutine until the action "
+             "played by an object on a layer is done");
+static PyObject *gPyWaitAction(PyObject *, PyObject *args)
+{
+  PyObject *pyobj;
+  short layer = 0;
+  if (!PyArg_ParseTuple(args, "O|h:waitAction", &pyobj, &layer)) {
+    return nullptr;
+  }
+
+  if (!PyObject_TypeCheck(pyobj, &KX_GameObject::Type) || !EXP_PROXY_REF(pyobj)) {
+    PyErr_SetString(PyExc_TypeError,
+                    "bge.logic.waitAction(object, layer): expected a valid KX_GameObject");
+    return nullptr;
+  }
+
+  if (layer < 0 || layer >= MAX_ACTION_LAYERS) {
+    PyErr_Format(PyExc_ValueError,
+                 "bge.logic.waitAction(object, layer): layer must be between 0 and %d",
+                 MAX_ACTION_LAYERS - 1);
+    return nullptr;
+  }
+
+  PyObject *wait = KX_CoroutineWait_New(KX_CoroutineWait::WAIT_ACTION, pyobj);
+  ((KX_CoroutineWait *)wait)->m_layer = layer;
+  return wait;
+}
+
 static struct PyMethodDef game_methods[] = {
     {"expandPath", (PyCFunction)gPyExpandPath, METH_VARARGS, (const char *)gPyExpandPath_doc},
     {"startGame", (PyCFunction)gPyStartGame, METH_VARARGS, (const char *)gPyStartGame_doc},
     {"endGame", (PyCFunction)gPyEndGame, METH_NOARGS, (const char *)gPyEndGame_doc},
+    {"waitFrames", (PyCFunction)gPyWaitFrames, METH_VARARGS, (const char *)gPyWaitFrames_doc},
+    {"waitSeconds", (PyCFunction)gPyWaitSeconds, METH_VARARGS, (const char *)gPyWaitSeconds_doc},
+    {"waitAction", (PyCFunction)gPyWaitAction, METH_VARARGS, (const char *)gPyWaitAction_doc},
     {"restartGame", (PyCFunction)gPyRestartGame, METH_NOARGS, (const char *)gPyRestartGame_doc},
     {"saveGlobalDict",
      (PyCFunction)gPySaveGlobalDict,
@@ -799,10 +1423,15 @@ static struct PyMethodDef game_methods[] = {
      METH_NOARGS,
      (const char *)gPyGetInactiveSceneNames_doc},
     {"getSceneList", (PyCFunction)gPyGetSceneList, METH_NOARGS, (const char *)gPyGetSceneList_doc},
+    {"preloadScene", (PyCFunction)gPyPreloadScene, METH_O, (const char *)gPyPreloadScene_doc},
     {"getRandomFloat",
      (PyCFunction)gPyGetRandomFloat,
      METH_NOARGS,
      (const char *)gPyGetRandomFloat_doc},
+    {"getRandomFloats",
+     (PyCFunction)gPyGetRandomFloats,
+     METH_VARARGS,
+     (const char *)gPyGetRandomFloats_doc},
     {"setGravity", (PyCFunction)gPySetGravity, METH_O, (const char *)"set Gravitation"},
     {"getSpectrum", (PyCFunction)gPyGetSpectrum, METH_NOARGS, (const char *)"get audio spectrum"},
     {"getMaxLogicFrame",
@@ -861,6 +1490,134 @@ static struct PyMethodDef game_methods[] = {
      (PyCFunction)gPySetUseExternalClock,
      METH_VARARGS,
      (const char *)"Set if we use the time provided by an external clock"},
+    {"getUseParallelSceneStep",
+     (PyCFunction)gPyGetUseParallelSceneStep,
+     METH_NOARGS,
+     (const char *)"Get if the physics of the scenes are stepped in parallel"},
+    {"setUseParallelSceneStep",
+     (PyCFunction)gPySetUseParallelSceneStep,
+     METH_VARARGS,
+     (const char *)"Set if the physics of the scenes are stepped in parallel"},
+    {"getUseRetainedDraw",
+     (PyCFunction)gPyGetUseRetainedDraw,
+     METH_NOARGS,
+     (const char *)"Get if the draw of static camera views is reused"},
+    {"setUseRetainedDraw",
+     (PyCFunction)gPySetUseRetainedDraw,
+     METH_VARARGS,
+     (const char *)"Set if the draw of static camera views is reused"},
+    {"getUseFramePacing",
+     (PyCFunction)gPyGetUseFramePacing,
+     METH_NOARGS,
+     (const char *)"Get if the engine sleeps until the next frame in fixed framerate"},
+    {"setUseFramePacing",
+     (PyCFunction)gPySetUseFramePacing,
+     METH_VARARGS,
+     (const char *)"Set if the engine sleeps until the next frame in fixed framerate"},
+    {"getUsePhysicsInterpolation",
+     (PyCFunction)gPyGetUsePhysicsInterpolation,
+     METH_NOARGS,
+     (const char *)"Get if the physics are interpolated to render each frame in fixed framerate"},
+    {"setUsePhysicsInterpolation",
+     (PyCFunction)gPySetUsePhysicsInterpolation,
+     METH_VARARGS,
+     (const char *)"Set if the physics are interpolated to render each frame in fixed framerate"},
+    {"getUseDeferredSwap",
+     (PyCFunction)gPyGetUseDeferredSwap,
+     METH_NOARGS,
+     (const char *)"Get if the buffers of a frame are swapped after the logic of the next frame"},
+    {"setUseDeferredSwap",
+     (PyCFunction)gPySetUseDeferredSwap,
+     METH_VARARGS,
+     (const char *)"Set if the buffers of a frame are swapped after the logic of the next frame"},
+    {"getUseLowLatency",
+     (PyCFunction)gPyGetUseLowLatency,
+     METH_NOARGS,
+     (const char *)"Get if the frames queued to the GPU are limited to reduce the input latency"},
+    {"setUseLowLatency",
+     (PyCFunction)gPySetUseLowLatency,
+     METH_VARARGS,
+     (const char *)"Set if the frames queued to the GPU are limited to reduce the input latency"},
+    {"getMaxFramesInFlight",
+     (PyCFunction)gPyGetMaxFramesInFlight,
+     METH_NOARGS,
+     (const char *)"Get the maximum of frames queued to the GPU in low latency"},
+    {"setMaxFramesInFlight",
+     (PyCFunction)gPySetMaxFramesInFlight,
+     METH_VARARGS,
+     (const char *)"Set the maximum of frames queued to the GPU in low latency"},
+    {"getUseInstancedCollections",
+     (PyCFunction)gPyGetUseInstancedCollections,
+     METH_NOARGS,
+     (const char *)"Get if the static collection instance members are drawn as instances"},
+    {"setUseInstancedCollections",
+     (PyCFunction)gPySetUseInstancedCollections,
+     METH_VARARGS,
+     (const char *)"Set if the static collection instance members are drawn as instances"},
+    {"getUseStaticBatching",
+     (PyCFunction)gPyGetUseStaticBatching,
+     METH_NOARGS,
+     (const char *)"Get if the meshes of the static objects are merged into batches"},
+    {"setUseStaticBatching",
+     (PyCFunction)gPySetUseStaticBatching,
+     METH_VARARGS,
+     (const char *)"Set if the meshes of the static objects are merged into batches"},
+    {"getUseParallelLogic",
+     (PyCFunction)gPyGetUseParallelLogic,
+     METH_NOARGS,
+     (const char *)"Get if the logic brick controllers not using Python are evaluated in parallel"},
+    {"setUseParallelLogic",
+     (PyCFunction)gPySetUseParallelLogic,
+     METH_VARARGS,
+     (const char *)"Set if the logic brick controllers not using Python are evaluated in parallel"},
+    {"getUseStaggeredPulses",
+     (PyCFunction)gPyGetUseStaggeredPulses,
+     METH_NOARGS,
+     (const char *)"Get if the pulses of the sensors are spread over the frames"},
+    {"setUseStaggeredPulses",
+     (PyCFunction)gPySetUseStaggeredPulses,
+     METH_VARARGS,
+     (const char *)"Set if the pulses of the sensors are spread over the frames"},
+    {"getUseScriptProfile",
+     (PyCFunction)gPyGetUseScriptProfile,
+     METH_NOARGS,
+     (const char *)"Get if the python controllers and components are profiled"},
+    {"setUseScriptProfile",
+     (PyCFunction)gPySetUseScriptProfile,
+     METH_VARARGS,
+     (const char *)"Set if the python controllers and components are profiled"},
+    {"getUseGpuProfile",
+     (PyCFunction)gPyGetUseGpuProfile,
+     METH_NOARGS,
+     (const char *)"Get if the GPU time of the render passes is measured"},
+    {"setUseGpuProfile",
+     (PyCFunction)gPySetUseGpuProfile,
+     METH_VARARGS,
+     (const char *)"Set if the GPU time of the render passes is measured"},
+    {"getUseObjectProfile",
+     (PyCFunction)gPyGetUseObjectProfile,
+     METH_NOARGS,
+     (const char *)"Get if the logic, physics and transform time of each object is measured"},
+    {"setUseObjectProfile",
+     (PyCFunction)gPySetUseObjectProfile,
+     METH_VARARGS,
+     (const char *)"Set if the logic, physics and transform time of each object is measured"},
+    {"getUseDepsgraphProfile",
+     (PyCFunction)gPyGetUseDepsgraphProfile,
+     METH_NOARGS,
+     (const char *)"Get if the stages of the depsgraph update are measured"},
+    {"setUseDepsgraphProfile",
+     (PyCFunction)gPySetUseDepsgraphProfile,
+     METH_VARARGS,
+     (const char *)"Set if the stages of the depsgraph update are measured"},
+    {"getUseAllocationProfile",
+     (PyCFunction)gPyGetUseAllocationProfile,
+     METH_NOARGS,
+     (const char *)"Get if the allocations of each profiling category are counted"},
+    {"setUseAllocationProfile",
+     (PyCFunction)gPySetUseAllocationProfile,
+     METH_VARARGS,
+     (const char *)"Set if the allocations of each profiling category are counted"},
     {"getClockTime",
      (PyCFunction)gPyGetClockTime,
      METH_NOARGS,
@@ -888,6 +1645,14 @@ static struct PyMethodDef game_methods[] = {
      (PyCFunction)gPyGetAverageFrameRate,
      METH_NOARGS,
      (const char *)"Gets the estimated average frame rate"},
+    {"getAverageFrameDrift",
+     (PyCFunction)gPyGetAverageFrameDrift,
+     METH_NOARGS,
+     (const char *)"Gets the average delay of the frames start in fixed framerate"},
+    {"getAveragePresentLatency",
+     (PyCFunction)gPyGetAveragePresentLatency,
+     METH_NOARGS,
+     (const char *)"Gets the average delay between the input sampling and the GPU frame end"},
     {"getTimeScale",
      (PyCFunction)gPyGetTimeScale,
      METH_NOARGS,
@@ -917,6 +1682,29 @@ static struct PyMethodDef game_methods[] = {
      METH_NOARGS,
      (const char *)"Render next frame (if Python has control)"},
     {"getProfileInfo", (PyCFunction)gPyGetProfileInfo, METH_NOARGS, gPyGetProfileInfo_doc},
+    {"getMemoryInfo", (PyCFunction)gPyGetMemoryInfo, METH_NOARGS, gPyGetMemoryInfo_doc},
+    {"getProfileStatistics",
+     (PyCFunction)gPyGetProfileStatistics,
+     METH_NOARGS,
+     gPyGetProfileStatistics_doc},
+    {"setHitchThreshold",
+     (PyCFunction)gPySetHitchThreshold,
+     METH_VARARGS,
+     gPySetHitchThreshold_doc},
+    {"getHitchThreshold",
+     (PyCFunction)gPyGetHitchThreshold,
+     METH_NOARGS,
+     gPyGetHitchThreshold_doc},
+    {"getHitches", (PyCFunction)gPyGetHitches, METH_NOARGS, gPyGetHitches_doc},
+    {"getObjectProfile",
+     (PyCFunction)gPyGetObjectProfile,
+     METH_VARARGS,
+     gPyGetObjectProfile_doc},
+    {"startTraceRecord",
+     (PyCFunction)gPyStartTraceRecord,
+     METH_NOARGS,
+     gPyStartTraceRecord_doc},
+    {"stopTraceRecord", (PyCFunction)gPyStopTraceRecord, METH_VARARGS, gPyStopTraceRecord_doc},
     /* library functions */
     {"LibLoad", (PyCFunction)gLibLoad, METH_VARARGS | METH_KEYWORDS, (const char *)""},
     {"LibNew", (PyCFunction)gLibNew, METH_VARARGS, (const char *)""},
@@ -1069,6 +1857,52 @@ static PyObject *gPyMakeScreenshot(PyObject *, PyObject *args)
   Py_RETURN_NONE;
 }
 
+static PyObject *gPyStartCapture(PyObject *, PyObject *args, PyObject *kwds)
+{
+  char *filepath;
+  float rate = 0.0f;
+  int hardware = 1;
+
+  static const char *kwlist[] = {"filepath", "rate", "hardware", nullptr};
+
+  if (!PyArg_ParseTupleAndKeywords(args,
+                                   kwds,
+                                   "s|fi:startCapture",
+                                   const_cast<char **>(kwlist),
+                                   &filepath,
+                                   &rate,
+                                   &hardware)) {
+    return nullptr;
+  }
+
+  KX_KetsjiEngine *engine = KX_GetActiveEngine();
+  KX_Scene *scene = KX_GetActiveScene();
+  RAS_ICanvas *canvas = engine->GetCanvas();
+  if (!scene || !canvas) {
+    PyErr_SetString(PyExc_RuntimeError, "bge.render.startCapture(): no active scene or canvas");
+    return nullptr;
+  }
+
+  const bool started = engine->GetVideoCapture()->Start(scene->GetBlenderScene(),
+                                                        filepath,
+                                                        canvas->GetWidth(),
+                                                        canvas->GetHeight(),
+                                                        rate,
+                                                        hardware);
+  return PyBool_FromLong(started);
+}
+
+static PyObject *gPyStopCapture(PyObject *)
+{
+  KX_GetActiveEngine()->GetVideoCapture()->Stop();
+  Py_RETURN_NONE;
+}
+
+static PyObject *gPyIsCapturing(PyObject *)
+{
+  return PyBool_FromLong(KX_GetActiveEngine()->GetVideoCapture()->IsCapturing());
+}
+
 static PyObject *gPySetGLSLMaterialSetting(PyObject *, PyObject *args, PyObject *)
 {
   EXP_ShowDeprecationWarning("setGLSLMaterialSetting(settings, enable)", "nothing");
@@ -1228,9 +2062,9 @@ static PyObject *gPySetVsync(PyObject *, PyObject *args)
     return nullptr;
   }
 
-  if (interval == VSYNC_ADAPTIVE)
-    interval = -1;
-  KX_GetActiveEngine()->GetCanvas()->SetSwapInterval((interval == VSYNC_ON) ? 1 : 0);
+  // The adaptive vsync is a negative swap interval.
+  KX_GetActiveEngine()->GetCanvas()->SetSwapInterval(
+      (interval == VSYNC_ADAPTIVE) ? -1 : ((interval == VSYNC_ON) ? 1 : 0));
   Py_RETURN_NONE;
 }
 
@@ -1238,7 +2072,10 @@ static PyObject *gPyGetVsync(PyObject *)
 {
   int interval = 0;
   KX_GetActiveEngine()->GetCanvas()->GetSwapInterval(interval);
-  return PyLong_FromLong(interval);
+  if (interval < 0) {
+    return PyLong_FromLong(VSYNC_ADAPTIVE);
+  }
+  return PyLong_FromLong((interval > 0) ? VSYNC_ON : VSYNC_OFF);
 }
 
 static PyObject *gPyShowFramerate(PyObject *, PyObject *args)
@@ -1261,6 +2098,210 @@ static PyObject *gPyShowProfile(PyObject *, PyObject *args)
   Py_RETURN_NONE;
 }
 
+static PyObject *gPyShowMemory(PyObject *, PyObject *args)
+{
+  int visible;
+  if (!PyArg_ParseTuple(args, "i:showMemory", &visible))
+    return nullptr;
+
+  KX_GetActiveEngine()->SetFlag(KX_KetsjiEngine::SHOW_MEMORY, visible);
+  Py_RETURN_NONE;
+}
+
+static PyObject *gPyShowHud(PyObject *, PyObject *args)
+{
+  int visible;
+  if (!PyArg_ParseTuple(args, "i:showHud", &visible))
+    return nullptr;
+
+  KX_GetActiveEngine()->SetFlag(KX_KetsjiEngine::SHOW_HUD, visible);
+  Py_RETURN_NONE;
+}
+
+static PyObject *gPySetHudCounters(PyObject *, PyObject *args)
+{
+  int counters;
+  if (!PyArg_ParseTuple(args, "i:setHudCounters", &counters))
+    return nullptr;
+
+  KX_GetActiveEngine()->GetPerformanceHud().SetCounters(counters);
+  Py_RETURN_NONE;
+}
+
+static PyObject *gPyGetHudCounters(PyObject *)
+{
+  return PyLong_FromLong(KX_GetActiveEngine()->GetPerformanceHud().GetCounters());
+}
+
+static PyObject *gPySetDeferredShaders(PyObject *, PyObject *args)
+{
+  int enable;
+  if (!PyArg_ParseTuple(args, "i:setDeferredShaders", &enable))
+    return nullptr;
+
+  KX_GetActiveEngine()->SetFlag(KX_KetsjiEngine::DEFERRED_SHADERS, enable);
+  Py_RETURN_NONE;
+}
+
+static PyObject *gPyGetDeferredShaders(PyObject *)
+{
+  return PyBool_FromLong(KX_GetActiveEngine()->GetFlag(KX_KetsjiEngine::DEFERRED_SHADERS));
+}
+
+static PyObject *gPySetShaderCompileBudget(PyObject *, PyObject *args)
+{
+  float budget;
+  if (!PyArg_ParseTuple(args, "f:setShaderCompileBudget", &budget))
+    return nullptr;
+
+  if (budget < 0.0f) {
+    PyErr_SetString(PyExc_ValueError,
+                    "setShaderCompileBudget(budget): budget must be positive or zero");
+    return nullptr;
+  }
+
+  KX_GetActiveEngine()->SetShaderCompileBudget(budget / 1000.0);
+  Py_RETURN_NONE;
+}
+
+static PyObject *gPyGetShaderCompileBudget(PyObject *)
+{
+  return PyFloat_FromDouble(KX_GetActiveEngine()->GetShaderCompileBudget() * 1000.0);
+}
+
+static PyObject *gPyGetQueuedShaderCount(PyObject *)
+{
+  return PyLong_FromLong(DRW_game_deferred_shaders_count());
+}
+
+static PyObject *gPyCompileQueuedShaders(PyObject *, PyObject *args)
+{
+  float budget = -1.0f;
+  if (!PyArg_ParseTuple(args, "|f:compileQueuedShaders", &budget))
+    return nullptr;
+
+  const int count = DRW_game_deferred_shaders_compile((budget < 0.0f) ? -1.0 : budget / 1000.0);
+  return PyLong_FromLong(count);
+}
+
+static PyObject *gPySetTextureBudget(PyObject *, PyObject *args)
+{
+  float budget;
+  if (!PyArg_ParseTuple(args, "f:setTextureBudget", &budget))
+    return nullptr;
+
+  if (budget < 0.0f) {
+    PyErr_SetString(PyExc_ValueError, "setTextureBudget(budget): budget must be positive or zero");
+    return nullptr;
+  }
+
+  KX_GetActiveEngine()->GetTextureStreamer().SetBudget(size_t(budget * 1048576.0));
+  Py_RETURN_NONE;
+}
+
+static PyObject *gPyGetTextureBudget(PyObject *)
+{
+  return PyFloat_FromDouble(KX_GetActiveEngine()->GetTextureStreamer().GetBudget() / 1048576.0);
+}
+
+static PyObject *gPyGetTextureMemory(PyObject *)
+{
+  return PyFloat_FromDouble(KX_GetActiveEngine()->GetTextureStreamer().GetResidentMemory() /
+                            1048576.0);
+}
+
+static PyObject *gPySetLightBudget(PyObject *, PyObject *args)
+{
+  int budget;
+  if (!PyArg_ParseTuple(args, "i:setLightBudget", &budget))
+    return nullptr;
+
+  if (budget < 0 || budget > 65535) {
+    PyErr_SetString(PyExc_ValueError,
+                    "setLightBudget(budget): budget must be between 0 and 65535");
+    return nullptr;
+  }
+
+  KX_GetActiveEngine()->SetLightBudget(budget);
+  Py_RETURN_NONE;
+}
+
+static PyObject *gPyGetLightBudget(PyObject *)
+{
+  return PyLong_FromLong(KX_GetActiveEngine()->GetLightBudget());
+}
+
+static PyObject *gPySetDynamicResolution(PyObject *, PyObject *args)
+{
+  int enable;
+  if (!PyArg_ParseTuple(args, "i:setDynamicResolution", &enable))
+    return nullptr;
+
+  KX_GetActiveEngine()->GetResolutionScaler().SetEnabled(enable);
+  Py_RETURN_NONE;
+}
+
+static PyObject *gPyGetDynamicResolution(PyObject *)
+{
+  return PyBool_FromLong(KX_GetActiveEngine()->GetResolutionScaler().GetEnabled());
+}
+
+static PyObject *gPySetTargetFrameTime(PyObject *, PyObject *args)
+{
+  float time;
+  if (!PyArg_ParseTuple(args, "f:setTargetFrameTime", &time))
+    return nullptr;
+
+  if (time < 0.0f) {
+    PyErr_SetString(PyExc_ValueError, "setTargetFrameTime(time): time must be positive or zero");
+    return nullptr;
+  }
+
+  KX_GetActiveEngine()->GetResolutionScaler().SetTargetFrameTime(time / 1000.0);
+  Py_RETURN_NONE;
+}
+
+static PyObject *gPyGetTargetFrameTime(PyObject *)
+{
+  return PyFloat_FromDouble(KX_GetActiveEngine()->GetResolutionScaler().GetTargetFrameTime() *
+                            1000.0);
+}
+
+static PyObject *gPyGetResolutionScale(PyObject *)
+{
+  return PyFloat_FromDouble(KX_GetActiveEngine()->GetResolutionScaler().GetScale());
+}
+
+static PyObject *gPySetStaticShadows(PyObject *, PyObject *args)
+{
+  int enable;
+  if (!PyArg_ParseTuple(args, "i:setStaticShadows", &enable))
+    return nullptr;
+
+  KX_GetActiveEngine()->SetFlag(KX_KetsjiEngine::STATIC_SHADOWS, enable);
+  Py_RETURN_NONE;
+}
+
+static PyObject *gPyGetStaticShadows(PyObject *)
+{
+  return PyBool_FromLong(KX_GetActiveEngine()->GetFlag(KX_KetsjiEngine::STATIC_SHADOWS));
+}
+
+static PyObject *gPySetDeferredGeometry(PyObject *, PyObject *args)
+{
+  int enable;
+  if (!PyArg_ParseTuple(args, "i:setDeferredGeometry", &enable))
+    return nullptr;
+
+  KX_GetActiveEngine()->SetFlag(KX_KetsjiEngine::DEFERRED_GEOMETRY, enable);
+  Py_RETURN_NONE;
+}
+
+static PyObject *gPyGetDeferredGeometry(PyObject *)
+{
+  return PyBool_FromLong(KX_GetActiveEngine()->GetFlag(KX_KetsjiEngine::DEFERRED_GEOMETRY));
+}
+
 static PyObject *gPyShowProperties(PyObject *, PyObject *args)
 {
   int visible;
@@ -1310,6 +2351,12 @@ static struct PyMethodDef rasterizer_methods[] = {
     {"getWindowWidth", (PyCFunction)gPyGetWindowWidth, METH_VARARGS, "getWindowWidth doc"},
     {"getWindowHeight", (PyCFunction)gPyGetWindowHeight, METH_VARARGS, "getWindowHeight doc"},
     {"makeScreenshot", (PyCFunction)gPyMakeScreenshot, METH_VARARGS, "make Screenshot doc"},
+    {"startCapture",
+     (PyCFunction)gPyStartCapture,
+     METH_VARARGS | METH_KEYWORDS,
+     "startCapture(filepath, rate=0.0, hardware=True)"},
+    {"stopCapture", (PyCFunction)gPyStopCapture, METH_NOARGS, "stopCapture()"},
+    {"isCapturing", (PyCFunction)gPyIsCapturing, METH_NOARGS, "isCapturing()"},
     {"enableVisibility", (PyCFunction)gPyEnableVisibility, METH_VARARGS, "enableVisibility doc"},
     {"showMouse", (PyCFunction)gPyShowMouse, METH_VARARGS, "showMouse(bool visible)"},
     {"setMousePosition",
@@ -1375,6 +2422,99 @@ static struct PyMethodDef rasterizer_methods[] = {
     {"getVsync", (PyCFunction)gPyGetVsync, METH_NOARGS, ""},
     {"showFramerate", (PyCFunction)gPyShowFramerate, METH_VARARGS, "show or hide the framerate"},
     {"showProfile", (PyCFunction)gPyShowProfile, METH_VARARGS, "show or hide the profile"},
+    {"showMemory",
+     (PyCFunction)gPyShowMemory,
+     METH_VARARGS,
+     "show or hide the memory used by each subsystem"},
+    {"showHud", (PyCFunction)gPyShowHud, METH_VARARGS, "show or hide the performance graphs"},
+    {"setDeferredShaders",
+     (PyCFunction)gPySetDeferredShaders,
+     METH_VARARGS,
+     "compile the new materials between the frames instead of when first drawn"},
+    {"getDeferredShaders",
+     (PyCFunction)gPyGetDeferredShaders,
+     METH_NOARGS,
+     "return true if the new materials are compiled between the frames"},
+    {"setShaderCompileBudget",
+     (PyCFunction)gPySetShaderCompileBudget,
+     METH_VARARGS,
+     "set the time in ms spent per frame to compile the queued materials"},
+    {"getShaderCompileBudget",
+     (PyCFunction)gPyGetShaderCompileBudget,
+     METH_NOARGS,
+     "get the time in ms spent per frame to compile the queued materials"},
+    {"getQueuedShaderCount",
+     (PyCFunction)gPyGetQueuedShaderCount,
+     METH_NOARGS,
+     "get the number of materials waiting for their compilation"},
+    {"compileQueuedShaders",
+     (PyCFunction)gPyCompileQueuedShaders,
+     METH_VARARGS,
+     "compile the queued materials, optionally during a time in ms"},
+    {"setTextureBudget",
+     (PyCFunction)gPySetTextureBudget,
+     METH_VARARGS,
+     "set the memory in MB of the streamed textures"},
+    {"getTextureBudget",
+     (PyCFunction)gPyGetTextureBudget,
+     METH_NOARGS,
+     "get the memory in MB of the streamed textures"},
+    {"getTextureMemory",
+     (PyCFunction)gPyGetTextureMemory,
+     METH_NOARGS,
+     "get the memory in MB used by the streamed textures"},
+    {"setLightBudget",
+     (PyCFunction)gPySetLightBudget,
+     METH_VARARGS,
+     "set the most lights drawn per camera, 0 to draw all the lights"},
+    {"getLightBudget",
+     (PyCFunction)gPyGetLightBudget,
+     METH_NOARGS,
+     "get the most lights drawn per camera"},
+    {"setDynamicResolution",
+     (PyCFunction)gPySetDynamicResolution,
+     METH_VARARGS,
+     "enable or disable the render resolution adapted to the GPU time"},
+    {"getDynamicResolution",
+     (PyCFunction)gPyGetDynamicResolution,
+     METH_NOARGS,
+     "get if the render resolution is adapted to the GPU time"},
+    {"setTargetFrameTime",
+     (PyCFunction)gPySetTargetFrameTime,
+     METH_VARARGS,
+     "set the GPU time in ms held by the dynamic resolution"},
+    {"getTargetFrameTime",
+     (PyCFunction)gPyGetTargetFrameTime,
+     METH_NOARGS,
+     "get the GPU time in ms held by the dynamic resolution"},
+    {"getResolutionScale",
+     (PyCFunction)gPyGetResolutionScale,
+     METH_NOARGS,
+     "get the current scale of the render resolution"},
+    {"setStaticShadows",
+     (PyCFunction)gPySetStaticShadows,
+     METH_VARARGS,
+     "enable or disable the cached shadows of the objects not moved by the game"},
+    {"getStaticShadows",
+     (PyCFunction)gPyGetStaticShadows,
+     METH_NOARGS,
+     "get if the shadows of the objects not moved by the game are cached"},
+    {"setDeferredGeometry",
+     (PyCFunction)gPySetDeferredGeometry,
+     METH_VARARGS,
+     "enable or disable the deferred geometry updates of the objects outside the views"},
+    {"getDeferredGeometry",
+     (PyCFunction)gPyGetDeferredGeometry,
+     METH_NOARGS,
+     "get if the geometry updates of the objects outside the views are deferred"},
+    {"setHudCounters",
+     (PyCFunction)gPySetHudCounters,
+     METH_VARARGS,
+     "set the mask of the counters shown in the performance graphs"},
+    {"getHudCounters",
+     (PyCFunction)gPyGetHudCounters,
+     METH_NOARGS,
+     "get the mask of the counters shown in the performance graphs"},
     {"showProperties",
      (PyCFunction)gPyShowProperties,
      METH_VARARGS,
@@ -1822,6 +2962,12 @@ PyMODINIT_FUNC initGameLogicPythonBinding()
   KX_MACRO_addTypesToDict(
       d, KX_ACT_MOUSE_OBJECT_AXIS_Z, SCA_MouseActuator::KX_ACT_MOUSE_OBJECT_AXIS_Z);
 
+  /* KX_WorldStreamer cell states */
+  KX_MACRO_addTypesToDict(d, KX_STREAMING_CELL_UNLOADED, KX_WorldStreamer::CELL_UNLOADED);
+  KX_MACRO_addTypesToDict(d, KX_STREAMING_CELL_LOADING, KX_WorldStreamer::CELL_LOADING);
+  KX_MACRO_addTypesToDict(d, KX_STREAMING_CELL_LOADED, KX_WorldStreamer::CELL_LOADED);
+  KX_MACRO_addTypesToDict(d, KX_STREAMING_CELL_FAILED, KX_WorldStreamer::CELL_FAILED);
+
   // Check for errors
   if (PyErr_Occurred()) {
     Py_FatalError("can't initialize module bge.logic");
@@ -2286,8 +3432,10 @@ void exitGamePlayerPythonScripting()
   /* since python restarts we cant let the python backup of the sys.path hang around in a global
    * pointer */
   restorePySysObjects(); /* get back the original sys.path and clear the backup */
+  setGCCallback(false);
 
   // Py_Finalize();
+  SCA_PythonController::ClearCodeCache();
   bpy_import_main_set(nullptr);
   EXP_PyObjectPlus::ClearDeprecationWarning();
 }
@@ -2489,6 +3637,8 @@ void exitGamePythonScripting()
   }
 
   restorePySysObjects(); /* get back the original sys.path and clear the backup */
+  setGCCallback(false);
+  SCA_PythonController::ClearCodeCache();
   bpy_import_main_set(nullptr);
   EXP_PyObjectPlus::ClearDeprecationWarning();
 }
@@ -2620,6 +3770,17 @@ PyMODINIT_FUNC initRasterizerPythonBinding()
   KX_MACRO_addTypesToDict(d, LEFT_EYE, RAS_Rasterizer::RAS_STEREO_LEFTEYE);
   KX_MACRO_addTypesToDict(d, RIGHT_EYE, RAS_Rasterizer::RAS_STEREO_RIGHTEYE);
 
+  /* for get/setHudCounters */
+  KX_MACRO_addTypesToDict(d, HUD_FRAME_TIME, 1 << KX_PerformanceHud::COUNTER_FRAME_TIME);
+  KX_MACRO_addTypesToDict(d, HUD_CATEGORIES, 1 << KX_PerformanceHud::COUNTER_CATEGORIES);
+  KX_MACRO_addTypesToDict(d, HUD_DRAW_CALLS, 1 << KX_PerformanceHud::COUNTER_DRAW_CALLS);
+  KX_MACRO_addTypesToDict(d, HUD_OBJECTS, 1 << KX_PerformanceHud::COUNTER_OBJECTS);
+  KX_MACRO_addTypesToDict(d, HUD_LOGIC_BRICKS, 1 << KX_PerformanceHud::COUNTER_LOGIC_BRICKS);
+  KX_MACRO_addTypesToDict(d, HUD_PHYSICS_BODIES, 1 << KX_PerformanceHud::COUNTER_PHYSICS_BODIES);
+  KX_MACRO_addTypesToDict(
+      d, HUD_PHYSICS_CONTACTS, 1 << KX_PerformanceHud::COUNTER_PHYSICS_CONTACTS);
+  KX_MACRO_addTypesToDict(d, HUD_MEMORY, 1 << KX_PerformanceHud::COUNTER_MEMORY);
+
   // XXXX Add constants here
 
   // Check for errors
@@ -57,8 +57,11 @@
 #  include "KX_LodManager.h"
 #  include "KX_MeshProxy.h"
 #  include "KX_NavMeshObject.h"
+#  include "KX_ParticleEmitter.h"
 #  include "KX_PolyProxy.h"
 #  include "KX_PythonComponent.h"
+#  include "KX_PythonCoroutine.h"
+#  include "KX_TaskFuture.h"
 #  include "KX_VehicleWrapper.h"
 #  include "KX_VertexProxy.h"
 #  include "SCA_2DFilterActuator.h"
@@ -239,6 +242,7 @@ PyMODINIT_FUNC initGameTypesPythonBinding(void)
     PyType_Ready_Attr(dict, KX_LodManager, init_getset);
     PyType_Ready_Attr(dict, KX_FontObject, init_getset);
     PyType_Ready_Attr(dict, KX_MeshProxy, init_getset);
+    PyType_Ready_Attr(dict, KX_ParticleEmitter, init_getset);
     PyType_Ready_Attr(dict, SCA_MouseFocusSensor, init_getset);
     PyType_Ready_Attr(dict, SCA_MovementSensor, init_getset);
     PyType_Ready_Attr(dict, SCA_NearSensor, init_getset);
@@ -255,6 +259,7 @@ PyMODINIT_FUNC initGameTypesPythonBinding(void)
     PyType_Ready_Attr(dict, SCA_EndObjectActuator, init_getset);
     PyType_Ready_Attr(dict, SCA_ReplaceMeshActuator, init_getset);
     PyType_Ready_Attr(dict, KX_Scene, init_getset);
+    PyType_Ready_Attr(dict, KX_TaskFuture, init_getset);
     PyType_Ready_Attr(dict, KX_NavMeshObject, init_getset);
     PyType_Ready_Attr(dict, SCA_SceneActuator, init_getset);
     PyType_Ready_Attr(dict, SCA_SoundActuator, init_getset);
@@ -299,6 +304,11 @@ PyMODINIT_FUNC initGameTypesPythonBinding(void)
     PyType_Ready_Attr(dict, Texture, init_getset);
   }
 
+  // Plain python type without attributes, returned by the wait functions of bge.logic.
+  if (PyType_Ready(&KX_CoroutineWait_Type) == 0) {
+    PyDict_SetItemString(dict, "KX_CoroutineWait", (PyObject *)&KX_CoroutineWait_Type);
+  }
+
 #  ifdef USE_MATHUTILS
   /* Init mathutils callbacks */
   KX_GameObject_Mathutils_Callback_Init();
@@ -24,7 +24,11 @@
 
 #include "BKE_python_proxy.h"
 #include "CM_Message.h"
+#include "CM_StartupProfiler.h"
 #include "DNA_python_proxy_types.h"
+#include "KX_Globals.h"
+#include "KX_KetsjiEngine.h"
+#include "KX_PythonCoroutine.h"
 
 #include <boost/format.hpp>
 
@@ -33,6 +37,8 @@ KX_PythonProxy::KX_PythonProxy()
       m_init(false),
       m_pp(nullptr),
       m_update(nullptr),
+      m_coroutine(nullptr),
+      m_wait(nullptr),
       m_dispose(nullptr),
       m_logger(nullptr)
 {
@@ -67,6 +73,8 @@ void KX_PythonProxy::Start()
     m_init = true;
   }
 
+  CM_StartupScope startScope("Component Start", m_pp->name, true);
+
   PyObject *proxy = GetProxy();
   PyObject *arg_dict = (PyObject *)BKE_python_proxy_argument_dict_new(m_pp);
 
@@ -95,8 +103,24 @@ void KX_PythonProxy::Update()
   }
 
   if (m_init) {
-    if (m_update && !PyObject_CallNoArgs(m_update) && PyErr_Occurred()) {
-      LogError("Failed to invoke the update callback.");
+    if (m_coroutine) {
+      ResumeCoroutine();
+    }
+    else if (m_update) {
+      PyObject *ret = PyObject_CallNoArgs(m_update);
+      if (!ret) {
+        if (PyErr_Occurred()) {
+          LogError("Failed to invoke the update callback.");
+        }
+      }
+      // An async update runs until it returns, a new one is then started at the next update.
+      else if (PyCoro_CheckExact(ret)) {
+        m_coroutine = ret;
+        ResumeCoroutine();
+      }
+      else {
+        Py_DECREF(ret);
+      }
     }
   }
   else {
@@ -104,6 +128,43 @@ void KX_PythonProxy::Update()
   }
 }
 
+void KX_PythonProxy::ResumeCoroutine()
+{
+  if (m_wait) {
+    if (!KX_CoroutineWait_IsDone(m_wait, KX_GetActiveEngine()->GetFrameTime())) {
+      return;
+    }
+    Py_CLEAR(m_wait);
+  }
+
+  PyObject *ret = PyObject_CallMethod(m_coroutine, "send", "O", Py_None);
+  if (!ret) {
+    if (PyErr_ExceptionMatches(PyExc_StopIteration)) {
+      PyErr_Clear();
+    }
+    else {
+      LogError("Failed to resume the update coroutine.");
+    }
+    Py_CLEAR(m_coroutine);
+  }
+  else if (KX_CoroutineWait_Check(ret)) {
+    m_wait = ret;
+  }
+  else if (ret == Py_None) {
+    // A bare yield resumes at the next update.
+    Py_DECREF(ret);
+  }
+  else {
+    PyErr_Format(PyExc_TypeError,
+                 "update coroutine awaited %.200s, only the waits of bge.logic, "
+                 "KX_LibLoadStatus and KX_TaskFuture can be awaited",
+                 Py_TYPE(ret)->tp_name);
+    Py_DECREF(ret);
+    LogError("Failed to resume the update coroutine.");
+    Py_CLEAR(m_coroutine);
+  }
+}
+
 KX_PythonProxy *KX_PythonProxy::GetReplica()
 {
   KX_PythonProxy *replica = NewInstance();
@@ -129,6 +190,8 @@ void KX_PythonProxy::ProcessReplica()
   m_init = false;
 
   m_update = nullptr;
+  m_coroutine = nullptr;
+  m_wait = nullptr;
   m_dispose = nullptr;
   m_logger = nullptr;
 }
@@ -140,10 +203,14 @@ void KX_PythonProxy::Dispose()
   }
 
   Py_XDECREF(m_update);
+  Py_XDECREF(m_coroutine);
+  Py_XDECREF(m_wait);
   Py_XDECREF(m_dispose);
   Py_XDECREF(m_logger);
 
   m_update = nullptr;
+  m_coroutine = nullptr;
+  m_wait = nullptr;
   m_dispose = nullptr;
   m_logger = nullptr;
 }
@@ -35,10 +35,19 @@ class KX_PythonProxy : public EXP_Value {
 
   PyObject *m_update;
 
+  /// Update coroutine suspended, nullptr when update is not a coroutine or returned.
+  PyObject *m_coroutine;
+
+  /// Wait yielded by the suspended coroutine, nullptr to resume at the next update.
+  PyObject *m_wait;
+
   PyObject *m_dispose;
 
   PyObject *m_logger;
 
+  /// Resume the update coroutine once its wait is done.
+  void ResumeCoroutine();
+
  public:
   KX_PythonProxy();
 
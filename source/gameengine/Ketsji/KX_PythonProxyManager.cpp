@@ -22,6 +22,8 @@
 
 #include "KX_PythonProxyManager.h"
 
+#include <algorithm>
+
 #include "CM_List.h"
 #include "KX_GameObject.h"
 
@@ -41,30 +43,83 @@ KX_PythonProxyManager::~KX_PythonProxyManager()
 void KX_PythonProxyManager::Register(KX_GameObject *gameobj)
 {
   // Always register only once an object.
-  m_objects.push_back(gameobj);
-  m_objects_changed = true;
+  m_pendingObjects.push_back(gameobj);
 }
 
 void KX_PythonProxyManager::Unregister(KX_GameObject *gameobj)
 {
-  CM_ListRemoveIfFound(m_objects, gameobj);
-  m_objects_changed = true;
+  if (CM_ListRemoveIfFound(m_pendingObjects, gameobj)) {
+    return;
+  }
+
+  if (m_updating) {
+    // Keep the list unchanged while iterating on it.
+    std::vector<KX_GameObject *>::iterator it = std::find(
+        m_objects.begin(), m_objects.end(), gameobj);
+    if (it != m_objects.end()) {
+      *it = nullptr;
+      m_hasRemovedObjects = true;
+    }
+  }
+  else {
+    CM_ListRemoveIfFound(m_objects, gameobj);
+  }
+}
+
+void KX_PythonProxyManager::Unregister(const std::unordered_set<KX_GameObject *> &objects)
+{
+  const auto isRemoved = [&objects](KX_GameObject *gameobj) {
+    return (objects.find(gameobj) != objects.end());
+  };
+
+  m_pendingObjects.erase(
+      std::remove_if(m_pendingObjects.begin(), m_pendingObjects.end(), isRemoved),
+      m_pendingObjects.end());
+
+  if (m_updating) {
+    // Keep the list unchanged while iterating on it.
+    for (KX_GameObject *&gameobj : m_objects) {
+      if (gameobj && isRemoved(gameobj)) {
+        gameobj = nullptr;
+        m_hasRemovedObjects = true;
+      }
+    }
+  }
+  else {
+    m_objects.erase(std::remove_if(m_objects.begin(), m_objects.end(), isRemoved),
+                    m_objects.end());
+  }
 }
 
 void KX_PythonProxyManager::Update()
 {
-  if (m_objects_changed) {
-    std::sort(m_objects.begin(), m_objects.end(), compareObjectDepth);
+  // Merge the new objects by depth, the other objects are already sorted.
+  if (!m_pendingObjects.empty()) {
+    std::stable_sort(m_pendingObjects.begin(), m_pendingObjects.end(), compareObjectDepth);
 
-    m_objects_changed = false;
+    const size_t size = m_objects.size();
+    m_objects.insert(m_objects.end(), m_pendingObjects.begin(), m_pendingObjects.end());
+    std::inplace_merge(
+        m_objects.begin(), m_objects.begin() + size, m_objects.end(), compareObjectDepth);
+
+    m_pendingObjects.clear();
   }
 
-  /* Update object components, we copy the object pointer in a second list to make
-   * sure that we iterate on a list which will not be modified, indeed components
-   * can add objects in theirs update.
+  /* Update object components, components can add objects in theirs update,
+   * these objects are pending until the next update and the removed objects
+   * are cleared after the iteration.
    */
-  const std::vector<KX_GameObject *> objects = m_objects;
-  for (KX_GameObject *gameobj : objects) {
-    gameobj->Update();
+  m_updating = true;
+  for (unsigned int i = 0, size = m_objects.size(); i < size; ++i) {
+    KX_GameObject *gameobj = m_objects[i];
+    if (gameobj) {
+      gameobj->Update();
+    }
+  }
+  m_updating = false;
+
+  if (m_hasRemovedObjects) {
+    m_objects.erase(std::remove(m_objects.begin(), m_objects.end(), nullptr), m_objects.end());
+    m_hasRemovedObjects = false;
   }
 }
@@ -1,13 +1,20 @@
 #pragma once
 
+#include <unordered_set>
 #include <vector>
 
 class KX_GameObject;
 
 class KX_PythonProxyManager {
  private:
+  /// Objects sorted by decreasing depth, unregistered objects are nullptr during the update.
   std::vector<KX_GameObject *> m_objects;
-  bool m_objects_changed = false;
+  /// Objects registered since the last update, merged in m_objects at the next update.
+  std::vector<KX_GameObject *> m_pendingObjects;
+  /// The objects are being updated, m_objects must not be modified.
+  bool m_updating = false;
+  /// Objects were unregistered during the update.
+  bool m_hasRemovedObjects = false;
 
  public:
   KX_PythonProxyManager();
@@ -15,6 +22,8 @@ class KX_PythonProxyManager {
 
   void Register(KX_GameObject *gameobj);
   void Unregister(KX_GameObject *gameobj);
+  /// Unregister all the objects at once.
+  void Unregister(const std::unordered_set<KX_GameObject *> &objects);
 
   void Update();
 };
@@ -0,0 +1,76 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file KX_RayCastBatch.cpp
+ *  \ingroup ketsji
+ */
+
+#include "KX_RayCastBatch.h"
+
+#include "BLI_task.h"
+
+#include "KX_RayCast.h"
+
+/// Minimum number of rays per thread.
+static const unsigned int rayCastBatchParallelThreshold = 16;
+
+static void ray_cast_batch_task(void *__restrict userdata,
+                                const int i,
+                                const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const KX_RayCastBatch::Ray &ray = ((KX_RayCastBatch::Ray *)userdata)[i];
+
+  KX_RayCast::Callback<KX_RayCastBatch::Receiver, void> callback(
+      ray.m_receiver, ray.m_ignoreController, nullptr, false, ray.m_faceUV);
+  KX_RayCast::RayTest(ray.m_physicsEnvironment, ray.m_from, ray.m_to, callback);
+}
+
+KX_RayCastBatch::KX_RayCastBatch()
+{
+}
+
+KX_RayCastBatch::~KX_RayCastBatch()
+{
+}
+
+void KX_RayCastBatch::Add(PHY_IPhysicsEnvironment *physicsEnvironment,
+                          const MT_Vector3 &from,
+                          const MT_Vector3 &to,
+                          Receiver *receiver,
+                          PHY_IPhysicsController *ignoreController,
+                          bool faceUV)
+{
+  m_rays.push_back({physicsEnvironment, from, to, receiver, ignoreController, faceUV});
+}
+
+void KX_RayCastBatch::Execute()
+{
+  if (m_rays.empty()) {
+    return;
+  }
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (m_rays.size() >= rayCastBatchParallelThreshold);
+  settings.min_iter_per_thread = rayCastBatchParallelThreshold;
+  BLI_task_parallel_range(0, m_rays.size(), m_rays.data(), ray_cast_batch_task, &settings);
+
+  m_rays.clear();
+}
@@ -0,0 +1,75 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file KX_RayCastBatch.h
+ *  \ingroup ketsji
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "MT_Vector3.h"
+
+class KX_RayCast;
+class PHY_IPhysicsController;
+class PHY_IPhysicsEnvironment;
+struct KX_ClientObjectInfo;
+
+/** Rays of several logic bricks cast together, in parallel when there's enough of them.
+ * The rays are tested through KX_RayCast, the filter and hit functions of their receivers
+ * are called from the threads of the batch and must only modify the receiver.
+ */
+class KX_RayCastBatch {
+ public:
+  /// Owner of a ray, see KX_RayCast::Callback.
+  class Receiver {
+   public:
+    virtual ~Receiver() = default;
+
+    virtual bool RayHit(KX_ClientObjectInfo *client, KX_RayCast *result, void *data) = 0;
+    virtual bool NeedRayCast(KX_ClientObjectInfo *client, void *data) = 0;
+  };
+
+  struct Ray {
+    PHY_IPhysicsEnvironment *m_physicsEnvironment;
+    MT_Vector3 m_from;
+    MT_Vector3 m_to;
+    Receiver *m_receiver;
+    PHY_IPhysicsController *m_ignoreController;
+    bool m_faceUV;
+  };
+
+ private:
+  std::vector<Ray> m_rays;
+
+ public:
+  KX_RayCastBatch();
+  ~KX_RayCastBatch();
+
+  void Add(PHY_IPhysicsEnvironment *physicsEnvironment,
+           const MT_Vector3 &from,
+           const MT_Vector3 &to,
+           Receiver *receiver,
+           PHY_IPhysicsController *ignoreController,
+           bool faceUV);
+  /// Cast all the rays and clear the batch.
+  void Execute();
+};
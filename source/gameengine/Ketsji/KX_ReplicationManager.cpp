@@ -0,0 +1,553 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Ketsji/KX_ReplicationManager.cpp
+ *  \ingroup ketsji
+ */
+
+#include "KX_ReplicationManager.h"
+
+#include <cmath>
+#include <cstring>
+
+#include "KX_GameObject.h"
+#include "KX_NetworkTransport.h"
+#include "MT_Matrix3x3.h"
+#include "SG_Node.h"
+
+/** Packet layout: magic and version, the scene name, the position of interest of the sender
+ * and the records of the objects: identifier, mask of the fields and the fields. The
+ * integers are stored as variable length quantities of 7 bits per byte, the signed ones
+ * zigzag encoded, the orientation as four 16 bits little endian integers.
+ */
+static const char packetMagic[4] = {'B', 'G', 'E', 'R'};
+static const char packetVersion = 1;
+/// Size of the packets under which more records are added, below the usual MTU.
+static const unsigned int maxPacketSize = 1200;
+/// Seconds between two sends of all the fields of all the objects.
+static const double keyframeInterval = 1.0;
+/// Quantization steps per unit of the positions and velocities.
+static const float positionScale = 1024.0f;
+static const float velocityScale = 256.0f;
+static const float orientationScale = 32767.0f;
+
+static int32_t quantize(float value, float scale)
+{
+  const float scaled = std::round(value * scale);
+  return (int32_t)std::max(-2147483520.0f, std::min(scaled, 2147483520.0f));
+}
+
+static void write_varint(std::string &out, uint32_t value)
+{
+  while (value >= 0x80) {
+    out.push_back((char)((value & 0x7F) | 0x80));
+    value >>= 7;
+  }
+  out.push_back((char)value);
+}
+
+static void write_signed(std::string &out, int32_t value)
+{
+  write_varint(out, ((uint32_t)value << 1) ^ (uint32_t)(value >> 31));
+}
+
+static bool read_varint(const char *&data, const char *end, uint32_t &value)
+{
+  value = 0;
+  for (unsigned int shift = 0; shift < 32 && data < end; shift += 7) {
+    const unsigned char byte = *data++;
+    value |= (uint32_t)(byte & 0x7F) << shift;
+    if (!(byte & 0x80)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+static bool read_signed(const char *&data, const char *end, int32_t &value)
+{
+  uint32_t encoded;
+  if (!read_varint(data, end, encoded)) {
+    return false;
+  }
+  value = (int32_t)(encoded >> 1) ^ -(int32_t)(encoded & 1);
+  return true;
+}
+
+static void write_vector(std::string &out, const int32_t vec[3])
+{
+  for (unsigned short i = 0; i < 3; ++i) {
+    write_signed(out, vec[i]);
+  }
+}
+
+static bool read_vector(const char *&data, const char *end, int32_t vec[3])
+{
+  for (unsigned short i = 0; i < 3; ++i) {
+    if (!read_signed(data, end, vec[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static MT_Vector3 dequantize_vector(const int32_t vec[3], float scale)
+{
+  return MT_Vector3(vec[0] / scale, vec[1] / scale, vec[2] / scale);
+}
+
+KX_ReplicationManager::KX_ReplicationManager() : m_lastSendTime(0.0), m_lastKeyframeTime(0.0)
+{
+}
+
+KX_ReplicationManager::~KX_ReplicationManager()
+{
+}
+
+KX_ReplicationManager::CellKey KX_ReplicationManager::GetCellKey(const MT_Vector3 &pos,
+                                                                 float cellSize) const
+{
+  return {(int)std::floor(pos.x() / cellSize),
+          (int)std::floor(pos.y() / cellSize),
+          (int)std::floor(pos.z() / cellSize)};
+}
+
+bool KX_ReplicationManager::SetId(KX_GameObject *gameobj, int id)
+{
+  const std::unordered_map<int, unsigned int>::const_iterator idIt = m_ids.find(id);
+  if (idIt != m_ids.end()) {
+    return (m_entries[idIt->second].m_object == gameobj);
+  }
+
+  const std::unordered_map<KX_GameObject *, unsigned int>::iterator it = m_objects.find(gameobj);
+  if (it != m_objects.end()) {
+    Entry &entry = m_entries[it->second];
+    m_ids.erase(entry.m_id);
+    if (id == 0) {
+      RemoveObject(gameobj);
+      return true;
+    }
+    entry.m_id = id;
+    entry.m_sentValid = false;
+    m_ids[id] = it->second;
+    return true;
+  }
+
+  if (id == 0) {
+    return true;
+  }
+
+  Entry entry;
+  entry.m_object = gameobj;
+  entry.m_id = id;
+  entry.m_owner = true;
+  entry.m_sentValid = false;
+  entry.m_toPosition = gameobj->NodeGetLocalPosition();
+  entry.m_toOrientation = gameobj->NodeGetLocalOrientation().getRotation();
+  entry.m_receiveTime = 0.0;
+  entry.m_interpolating = false;
+
+  const unsigned int index = m_entries.size();
+  m_entries.push_back(entry);
+  m_ids[id] = index;
+  m_objects[gameobj] = index;
+
+  return true;
+}
+
+int KX_ReplicationManager::GetId(KX_GameObject *gameobj) const
+{
+  const std::unordered_map<KX_GameObject *, unsigned int>::const_iterator it = m_objects.find(
+      gameobj);
+  return (it == m_objects.end()) ? 0 : m_entries[it->second].m_id;
+}
+
+bool KX_ReplicationManager::SetOwner(KX_GameObject *gameobj, bool owner)
+{
+  const std::unordered_map<KX_GameObject *, unsigned int>::iterator it = m_objects.find(gameobj);
+  if (it == m_objects.end()) {
+    return false;
+  }
+
+  Entry &entry = m_entries[it->second];
+  if (entry.m_owner != owner) {
+    entry.m_owner = owner;
+    entry.m_sentValid = false;
+    entry.m_interpolating = false;
+    entry.m_toPosition = gameobj->NodeGetLocalPosition();
+    entry.m_toOrientation = gameobj->NodeGetLocalOrientation().getRotation();
+  }
+  return true;
+}
+
+bool KX_ReplicationManager::GetOwner(KX_GameObject *gameobj) const
+{
+  const std::unordered_map<KX_GameObject *, unsigned int>::const_iterator it = m_objects.find(
+      gameobj);
+  return (it == m_objects.end()) ? true : m_entries[it->second].m_owner;
+}
+
+void KX_ReplicationManager::RemoveObject(KX_GameObject *gameobj)
+{
+  const std::unordered_map<KX_GameObject *, unsigned int>::iterator it = m_objects.find(gameobj);
+  if (it == m_objects.end()) {
+    return;
+  }
+
+  const unsigned int index = it->second;
+  const std::unordered_map<int, unsigned int>::iterator idIt = m_ids.find(m_entries[index].m_id);
+  if (idIt != m_ids.end() && idIt->second == index) {
+    m_ids.erase(idIt);
+  }
+  m_objects.erase(it);
+
+  // Move the last entry in the removed one.
+  const unsigned int last = m_entries.size() - 1;
+  if (index != last) {
+    m_entries[index] = m_entries[last];
+    m_ids[m_entries[index].m_id] = index;
+    m_objects[m_entries[index].m_object] = index;
+  }
+  m_entries.pop_back();
+}
+
+void KX_ReplicationManager::ReadPacket(const char *data,
+                                       unsigned int size,
+                                       int peer,
+                                       const std::string &sceneName,
+                                       double time)
+{
+  // The socket receives from any address, only the peers can replicate their objects.
+  if (peer < 0) {
+    return;
+  }
+
+  const char *end = data + size;
+  if (size < sizeof(packetMagic) + 1 || memcmp(data, packetMagic, sizeof(packetMagic)) != 0 ||
+      data[sizeof(packetMagic)] != packetVersion) {
+    return;
+  }
+  data += sizeof(packetMagic) + 1;
+
+  uint32_t nameSize;
+  if (!read_varint(data, end, nameSize) || nameSize > (uint32_t)(end - data) ||
+      sceneName.compare(0, std::string::npos, data, nameSize) != 0) {
+    return;
+  }
+  data += nameSize;
+
+  if (data >= end) {
+    return;
+  }
+  const bool hasInterest = *data++;
+  if (hasInterest) {
+    int32_t interest[3];
+    if (!read_vector(data, end, interest)) {
+      return;
+    }
+    m_peers[peer] = {dequantize_vector(interest, positionScale), true};
+  }
+
+  while (data < end) {
+    uint32_t id;
+    if (!read_varint(data, end, id) || data >= end) {
+      return;
+    }
+    const unsigned char fields = *data++;
+
+    QuantizedState state;
+    if ((fields & FIELD_POSITION) && !read_vector(data, end, state.m_position)) {
+      return;
+    }
+    if (fields & FIELD_ORIENTATION) {
+      if ((end - data) < 8) {
+        return;
+      }
+      for (unsigned short i = 0; i < 4; ++i) {
+        state.m_orientation[i] = (int16_t)((unsigned char)data[0] | ((unsigned char)data[1] << 8));
+        data += 2;
+      }
+    }
+    if ((fields & FIELD_VELOCITY) && !read_vector(data, end, state.m_velocity)) {
+      return;
+    }
+
+    const std::unordered_map<int, unsigned int>::const_iterator it = m_ids.find((int)id);
+    if (it == m_ids.end()) {
+      continue;
+    }
+    Entry &entry = m_entries[it->second];
+    if (entry.m_owner) {
+      continue;
+    }
+
+    // Interpolate from the state displayed now to the received one.
+    KX_GameObject *gameobj = entry.m_object;
+    entry.m_fromPosition = gameobj->NodeGetLocalPosition();
+    entry.m_fromOrientation = gameobj->NodeGetLocalOrientation().getRotation();
+    if (fields & FIELD_POSITION) {
+      entry.m_toPosition = dequantize_vector(state.m_position, positionScale);
+    }
+    if (fields & FIELD_ORIENTATION) {
+      MT_Quaternion rot(state.m_orientation[0] / orientationScale,
+                        state.m_orientation[1] / orientationScale,
+                        state.m_orientation[2] / orientationScale,
+                        state.m_orientation[3] / orientationScale);
+      if (rot.length2() > 0.0f) {
+        rot.normalize();
+        entry.m_toOrientation = rot;
+      }
+    }
+    if ((fields & FIELD_VELOCITY) && gameobj->GetPhysicsController()) {
+      gameobj->setLinearVelocity(dequantize_vector(state.m_velocity, velocityScale), false);
+    }
+    entry.m_receiveTime = time;
+    entry.m_interpolating = true;
+  }
+}
+
+void KX_ReplicationManager::SendRecords(KX_NetworkTransport *transport,
+                                        int peer,
+                                        const std::string &sceneName,
+                                        const MT_Vector3 *interest,
+                                        const std::vector<unsigned int> &records)
+{
+  m_packet.assign(packetMagic, sizeof(packetMagic));
+  m_packet.push_back(packetVersion);
+  write_varint(m_packet, sceneName.size());
+  m_packet.append(sceneName);
+  m_packet.push_back(interest ? 1 : 0);
+  if (interest) {
+    const int32_t pos[3] = {quantize(interest->x(), positionScale),
+                            quantize(interest->y(), positionScale),
+                            quantize(interest->z(), positionScale)};
+    write_vector(m_packet, pos);
+  }
+  const unsigned int headerSize = m_packet.size();
+
+  for (unsigned int index : records) {
+    const Record &record = m_records[index];
+    const Entry &entry = m_entries[record.m_entry];
+    const unsigned int recordStart = m_packet.size();
+
+    write_varint(m_packet, entry.m_id);
+    m_packet.push_back((char)record.m_fields);
+    if (record.m_fields & FIELD_POSITION) {
+      write_vector(m_packet, entry.m_sent.m_position);
+    }
+    if (record.m_fields & FIELD_ORIENTATION) {
+      for (unsigned short i = 0; i < 4; ++i) {
+        const uint16_t value = entry.m_sent.m_orientation[i];
+        m_packet.push_back((char)(value & 0xFF));
+        m_packet.push_back((char)(value >> 8));
+      }
+    }
+    if (record.m_fields & FIELD_VELOCITY) {
+      write_vector(m_packet, entry.m_sent.m_velocity);
+    }
+
+    // Send the previous records and start a new packet with the same header.
+    if (m_packet.size() > maxPacketSize && recordStart > headerSize) {
+      const std::string recordData = m_packet.substr(recordStart);
+      transport->SendTo(peer, m_packet.data(), recordStart);
+      m_packet.resize(headerSize);
+      m_packet.append(recordData);
+    }
+  }
+
+  transport->SendTo(peer, m_packet.data(), m_packet.size());
+}
+
+void KX_ReplicationManager::Send(KX_NetworkTransport *transport,
+                                 const std::string &sceneName,
+                                 const MT_Vector3 *interest,
+                                 float radius,
+                                 bool keyframe)
+{
+  m_records.clear();
+
+  for (unsigned int i = 0, size = m_entries.size(); i < size; ++i) {
+    Entry &entry = m_entries[i];
+    if (!entry.m_owner) {
+      continue;
+    }
+
+    // The node is tagged at each update of its world transform.
+    KX_GameObject *gameobj = entry.m_object;
+    SG_Node *node = gameobj->GetSGNode();
+    if (!keyframe && entry.m_sentValid && !node->IsDirty(SG_Node::DIRTY_REPLICATION)) {
+      continue;
+    }
+    node->ClearDirty(SG_Node::DIRTY_REPLICATION);
+
+    const MT_Vector3 &pos = gameobj->NodeGetLocalPosition();
+    MT_Quaternion rot = gameobj->NodeGetLocalOrientation().getRotation();
+    // The opposite quaternion is the same rotation, use a single one to compare the states.
+    if (rot.w() < 0.0f) {
+      rot = MT_Quaternion(-rot);
+    }
+    const MT_Vector3 vel = gameobj->GetPhysicsController() ? gameobj->GetLinearVelocity(false) :
+                                                              MT_Vector3(0.0f, 0.0f, 0.0f);
+
+    QuantizedState state;
+    for (unsigned short j = 0; j < 3; ++j) {
+      state.m_position[j] = quantize(pos[j], positionScale);
+      state.m_velocity[j] = quantize(vel[j], velocityScale);
+    }
+    for (unsigned short j = 0; j < 4; ++j) {
+      state.m_orientation[j] = (int16_t)quantize(rot[j], orientationScale);
+    }
+
+    unsigned char fields = FIELD_ALL;
+    if (!keyframe && entry.m_sentValid) {
+      fields = 0;
+      if (memcmp(state.m_position, entry.m_sent.m_position, sizeof(state.m_position)) != 0) {
+        fields |= FIELD_POSITION;
+      }
+      if (memcmp(state.m_orientation, entry.m_sent.m_orientation, sizeof(state.m_orientation)) !=
+          0) {
+        fields |= FIELD_ORIENTATION;
+      }
+      if (memcmp(state.m_velocity, entry.m_sent.m_velocity, sizeof(state.m_velocity)) != 0) {
+        fields |= FIELD_VELOCITY;
+      }
+      if (fields == 0) {
+        continue;
+      }
+    }
+
+    entry.m_sent = state;
+    entry.m_sentValid = true;
+    m_records.push_back({i, fields, gameobj->NodeGetWorldPosition()});
+  }
+
+  // The keyframes are always sent to share the position of interest.
+  if (m_records.empty() && !keyframe) {
+    return;
+  }
+
+  const unsigned int numPeers = m_peers.size();
+  const bool limited = (radius > 0.0f);
+
+  m_selected.resize(m_records.size());
+  for (unsigned int i = 0, size = m_records.size(); i < size; ++i) {
+    m_selected[i] = i;
+  }
+
+  if (!limited) {
+    for (unsigned int peer = 0; peer < numPeers; ++peer) {
+      SendRecords(transport, peer, sceneName, interest, m_selected);
+    }
+    return;
+  }
+
+  // Index the records in cells of the radius size, a peer reads only its neighbor cells.
+  for (std::pair<const CellKey, std::vector<unsigned int>> &pair : m_cells) {
+    pair.second.clear();
+  }
+  for (unsigned int i = 0, size = m_records.size(); i < size; ++i) {
+    m_cells[GetCellKey(m_records[i].m_position, radius)].push_back(i);
+  }
+
+  const float radius2 = radius * radius;
+  std::vector<unsigned int> records;
+  for (unsigned int peer = 0; peer < numPeers; ++peer) {
+    const PeerInterest &peerInterest = m_peers[peer];
+    // Send everything until the peer position is known.
+    if (!peerInterest.m_valid) {
+      SendRecords(transport, peer, sceneName, interest, m_selected);
+      continue;
+    }
+
+    records.clear();
+    const CellKey center = GetCellKey(peerInterest.m_position, radius);
+    for (int x = center.x - 1; x <= center.x + 1; ++x) {
+      for (int y = center.y - 1; y <= center.y + 1; ++y) {
+        for (int z = center.z - 1; z <= center.z + 1; ++z) {
+          const std::unordered_map<CellKey, std::vector<unsigned int>, CellKeyHash>::
+              const_iterator it = m_cells.find({x, y, z});
+          if (it == m_cells.end()) {
+            continue;
+          }
+          for (unsigned int index : it->second) {
+            if ((m_records[index].m_position - peerInterest.m_position).length2() <= radius2) {
+              records.push_back(index);
+            }
+          }
+        }
+      }
+    }
+
+    SendRecords(transport, peer, sceneName, interest, records);
+  }
+}
+
+void KX_ReplicationManager::ApplyReceived(double time, float rate)
+{
+  for (Entry &entry : m_entries) {
+    if (entry.m_owner || !entry.m_interpolating) {
+      continue;
+    }
+
+    float factor = 1.0f;
+    if (rate > 0.0f) {
+      factor = std::min((float)((time - entry.m_receiveTime) * rate), 1.0f);
+    }
+    if (factor >= 1.0f) {
+      entry.m_interpolating = false;
+    }
+
+    KX_GameObject *gameobj = entry.m_object;
+    gameobj->NodeSetLocalPosition(entry.m_fromPosition.lerp(entry.m_toPosition, factor));
+    gameobj->NodeSetLocalOrientation(
+        MT_Matrix3x3(entry.m_fromOrientation.slerp(entry.m_toOrientation, factor)));
+    gameobj->NodeUpdateGS(0.0f);
+    // The applied state must not be sent back if the object becomes owned.
+    gameobj->GetSGNode()->ClearDirty(SG_Node::DIRTY_REPLICATION);
+  }
+}
+
+void KX_ReplicationManager::Update(KX_NetworkTransport *transport,
+                                   const std::string &sceneName,
+                                   const MT_Vector3 *interest,
+                                   double time,
+                                   float rate,
+                                   float radius)
+{
+  m_peers.resize(transport->GetNumPeers(), {MT_Vector3(0.0f, 0.0f, 0.0f), false});
+
+  for (unsigned int i = 0, numPackets = transport->GetNumPackets(); i < numPackets; ++i) {
+    unsigned int size;
+    int peer;
+    const char *data = transport->GetPacket(i, size, peer);
+    ReadPacket(data, size, peer, sceneName, time);
+  }
+
+  if (!m_entries.empty() && rate > 0.0f && (time - m_lastSendTime) >= (1.0 / rate)) {
+    const bool keyframe = ((time - m_lastKeyframeTime) >= keyframeInterval);
+    if (keyframe) {
+      m_lastKeyframeTime = time;
+    }
+    Send(transport, sceneName, interest, radius, keyframe);
+    m_lastSendTime = time;
+  }
+
+  ApplyReceived(time, rate);
+}
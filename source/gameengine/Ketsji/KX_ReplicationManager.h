@@ -0,0 +1,178 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file KX_ReplicationManager.h
+ *  \ingroup ketsji
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "MT_Quaternion.h"
+#include "MT_Vector3.h"
+
+class KX_GameObject;
+class KX_NetworkTransport;
+
+/** Replication of the transforms and velocities of the scene objects to the peers of the
+ * network transport. An object is identified by a replication identifier shared by all the
+ * engine instances, it is either owned and sent by this instance or received from a peer.
+ * Only the quantized fields changed since the last sent state are sent, all the fields are
+ * sent at a regular keyframe to recover from the lost packets. The received states are
+ * interpolated over a send interval.
+ */
+class KX_ReplicationManager {
+ public:
+  /// Fields of a replicated state.
+  enum Field {
+    FIELD_POSITION = (1 << 0),
+    FIELD_ORIENTATION = (1 << 1),
+    FIELD_VELOCITY = (1 << 2),
+    FIELD_ALL = FIELD_POSITION | FIELD_ORIENTATION | FIELD_VELOCITY
+  };
+
+ private:
+  /// State quantized as sent in the packets.
+  struct QuantizedState {
+    int32_t m_position[3];
+    int16_t m_orientation[4];
+    int32_t m_velocity[3];
+  };
+
+  struct Entry {
+    KX_GameObject *m_object;
+    int m_id;
+    /// The state is sent by this instance, else it is received.
+    bool m_owner;
+    /// Last sent state.
+    QuantizedState m_sent;
+    /// The last sent state is valid.
+    bool m_sentValid;
+
+    /// Received state interpolated from the state displayed at the reception.
+    MT_Vector3 m_fromPosition;
+    MT_Quaternion m_fromOrientation;
+    MT_Vector3 m_toPosition;
+    MT_Quaternion m_toOrientation;
+    double m_receiveTime;
+    /// A state was received and is not yet fully applied.
+    bool m_interpolating;
+  };
+
+  struct CellKey {
+    int x;
+    int y;
+    int z;
+
+    bool operator==(const CellKey &other) const
+    {
+      return (x == other.x && y == other.y && z == other.z);
+    }
+  };
+
+  struct CellKeyHash {
+    size_t operator()(const CellKey &key) const
+    {
+      return ((size_t)key.x * 73856093) ^ ((size_t)key.y * 19349663) ^
+             ((size_t)key.z * 83492791);
+    }
+  };
+
+  /// Changed state of an owned object to send.
+  struct Record {
+    unsigned int m_entry;
+    unsigned char m_fields;
+    MT_Vector3 m_position;
+  };
+
+  /// Position of interest of a peer, the objects out of its radius are not sent to it.
+  struct PeerInterest {
+    MT_Vector3 m_position;
+    bool m_valid;
+  };
+
+  std::vector<Entry> m_entries;
+  /// Index of the entries per replication identifier and per object.
+  std::unordered_map<int, unsigned int> m_ids;
+  std::unordered_map<KX_GameObject *, unsigned int> m_objects;
+
+  std::vector<PeerInterest> m_peers;
+  /// Records of the current send, indexed by cell when the radius is limited.
+  std::vector<Record> m_records;
+  std::unordered_map<CellKey, std::vector<unsigned int>, CellKeyHash> m_cells;
+  /// Records selected for a peer.
+  std::vector<unsigned int> m_selected;
+  std::string m_packet;
+
+  double m_lastSendTime;
+  double m_lastKeyframeTime;
+
+  CellKey GetCellKey(const MT_Vector3 &pos, float cellSize) const;
+  void ReadPacket(const char *data, unsigned int size, int peer, const std::string &sceneName,
+                  double time);
+  void Send(KX_NetworkTransport *transport,
+            const std::string &sceneName,
+            const MT_Vector3 *interest,
+            float radius,
+            bool keyframe);
+  void SendRecords(KX_NetworkTransport *transport,
+                   int peer,
+                   const std::string &sceneName,
+                   const MT_Vector3 *interest,
+                   const std::vector<unsigned int> &records);
+  void ApplyReceived(double time, float rate);
+
+ public:
+  KX_ReplicationManager();
+  ~KX_ReplicationManager();
+
+  /** Set the replication identifier of an object.
+   * \param id The identifier, 0 stops the replication of the object.
+   * \return False if the identifier is used by another object.
+   */
+  bool SetId(KX_GameObject *gameobj, int id);
+  /// Return the replication identifier of an object, 0 if not replicated.
+  int GetId(KX_GameObject *gameobj) const;
+  /** Set if a replicated object is sent by this instance or received.
+   * \return False if the object is not replicated.
+   */
+  bool SetOwner(KX_GameObject *gameobj, bool owner);
+  bool GetOwner(KX_GameObject *gameobj) const;
+  /// Remove an object being deleted.
+  void RemoveObject(KX_GameObject *gameobj);
+
+  /** Read the states of the last poll of the transport, send the changed states of the
+   * owned objects at the replication rate and interpolate the received states.
+   * \param interest The position of interest of this instance, nullptr if unknown.
+   * \param rate The sends per second.
+   * \param radius The distance around the position of interest of a peer under which the
+   * objects are sent to it, 0 for unlimited.
+   */
+  void Update(KX_NetworkTransport *transport,
+              const std::string &sceneName,
+              const MT_Vector3 *interest,
+              double time,
+              float rate,
+              float radius);
+};
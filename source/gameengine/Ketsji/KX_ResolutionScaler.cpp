@@ -0,0 +1,136 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Ketsji/KX_ResolutionScaler.cpp
+ *  \ingroup ketsji
+ */
+
+#include "KX_ResolutionScaler.h"
+
+#include <algorithm>
+#include <cmath>
+
+/// Number of frames the times are averaged over before changing the scale.
+static const unsigned int adaptFrames = 16;
+/// The scale is a multiple of this step.
+static const float scaleStep = 0.05f;
+/// Part of the target frame time left free when the scale is increased, avoids oscillations.
+static const double headroom = 0.85;
+
+KX_ResolutionScaler::KX_ResolutionScaler()
+    : m_enabled(false),
+      m_targetFrameTime(0.0),
+      m_minScale(0.5f),
+      m_scale(1.0f),
+      m_totalTime(0.0),
+      m_numFrames(0)
+{
+}
+
+KX_ResolutionScaler::~KX_ResolutionScaler()
+{
+}
+
+void KX_ResolutionScaler::SetEnabled(bool enabled)
+{
+  m_enabled = enabled;
+  m_scale = 1.0f;
+  m_totalTime = 0.0;
+  m_numFrames = 0;
+}
+
+bool KX_ResolutionScaler::GetEnabled() const
+{
+  return m_enabled;
+}
+
+void KX_ResolutionScaler::SetTargetFrameTime(double time)
+{
+  m_targetFrameTime = time;
+}
+
+double KX_ResolutionScaler::GetTargetFrameTime() const
+{
+  return m_targetFrameTime;
+}
+
+void KX_ResolutionScaler::SetMinScale(float scale)
+{
+  m_minScale = std::min(std::max(scale, scaleStep), 1.0f);
+  m_scale = std::max(m_scale, m_minScale);
+}
+
+float KX_ResolutionScaler::GetMinScale() const
+{
+  return m_minScale;
+}
+
+float KX_ResolutionScaler::GetScale() const
+{
+  return m_enabled ? m_scale : 1.0f;
+}
+
+void KX_ResolutionScaler::Update(const RAS_Rasterizer::GpuTimes &times, double ticRate)
+{
+  if (!m_enabled) {
+    return;
+  }
+
+  // Only the camera renders depend on the resolution, see KX_Scene::RenderAfterCameraSetup.
+  double time = 0.0;
+  bool measured = false;
+  for (const std::pair<std::string, double> &pair : times) {
+    if (pair.first.compare(0, 7, "Camera ") == 0 || pair.first.compare(0, 8, "Overlay ") == 0) {
+      time += pair.second * 1.0e-3;
+      measured = true;
+    }
+  }
+
+  // The timer results come a few frames late, none are available the first frames.
+  if (!measured) {
+    return;
+  }
+
+  m_totalTime += time;
+  if (++m_numFrames < adaptFrames) {
+    return;
+  }
+
+  const double average = m_totalTime / m_numFrames;
+  m_totalTime = 0.0;
+  m_numFrames = 0;
+
+  const double target = (m_targetFrameTime > 0.0) ? m_targetFrameTime : 1.0 / ticRate;
+  if (average <= 0.0 || (average <= target && average >= target * headroom)) {
+    return;
+  }
+
+  // The render time is proportional to the number of pixels, the square of the scale.
+  const float ideal = m_scale * std::sqrt(target * headroom / average);
+  float scale = std::floor(ideal / scaleStep) * scaleStep;
+  if (average < target * headroom) {
+    // Increase by one step at most, the time of the larger size is not known yet.
+    scale = std::max(std::min(scale, m_scale + scaleStep), m_scale);
+  }
+
+  m_scale = std::min(std::max(scale, m_minScale), 1.0f);
+}
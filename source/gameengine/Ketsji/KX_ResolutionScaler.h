@@ -0,0 +1,67 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file KX_ResolutionScaler.h
+ *  \ingroup ketsji
+ */
+
+#pragma once
+
+#include "RAS_Rasterizer.h"
+
+/** Scale of the resolution the scenes are rendered at, adapted to the GPU time of the camera
+ * renders to hold a target frame time. The scale changes by steps and at a low rate because
+ * each change resizes the render textures and restarts the temporal anti-aliasing.
+ */
+class KX_ResolutionScaler {
+ private:
+  bool m_enabled;
+  /// Frame time in seconds to hold, 0 for the engine tic rate.
+  double m_targetFrameTime;
+  float m_minScale;
+  float m_scale;
+  /// Sum of the GPU render times of the frames since the last change.
+  double m_totalTime;
+  unsigned int m_numFrames;
+
+ public:
+  KX_ResolutionScaler();
+  ~KX_ResolutionScaler();
+
+  void SetEnabled(bool enabled);
+  bool GetEnabled() const;
+
+  void SetTargetFrameTime(double time);
+  double GetTargetFrameTime() const;
+
+  void SetMinScale(float scale);
+  float GetMinScale() const;
+
+  /// Return the scale of the render width and height, 1 when disabled.
+  float GetScale() const;
+
+  /** Register the GPU times of a frame and adapt the scale.
+   * \param times The last GPU times of the rasterizer, the camera renders are scaled.
+   * \param ticRate The engine tic rate used when no target frame time is set.
+   */
+  void Update(const RAS_Rasterizer::GpuTimes &times, double ticRate);
+};
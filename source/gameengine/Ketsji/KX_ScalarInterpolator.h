@@ -55,6 +55,10 @@ class KX_ScalarInterpolator : public KX_IInterpolator {
   {
     return m_target;
   }
+  KX_IScalarInterpolator *GetInterpolator() const
+  {
+    return m_ipo;
+  }
 
  private:
   MT_Scalar *m_target;
@@ -36,12 +36,23 @@
 
 #include "KX_Scene.h"
 
+#include <algorithm>
+#include <array>
+#include <limits>
+
 #include "BKE_lib_id.h"
 #include "BKE_mball.h"
 #include "BKE_modifier.h"
 #include "BKE_object.h"
 #include "BKE_screen.h"
+#include "BLI_ghash.h"
+#include "BLI_listbase.h"
+#include "BLI_math_matrix.h"
+#include "BLI_path_util.h"
+#include "BLI_rect.h"
+#include "BLI_string.h"
 #include "BLI_task.h"
+#include "DEG_depsgraph_build.h"
 #include "DEG_depsgraph_query.h"
 #include "DNA_camera_types.h"
 #include "DNA_collection_types.h"
@@ -52,36 +63,57 @@
 #include "ED_object.h"
 #include "ED_screen.h"
 #include "ED_view3d.h"
+#include "GPU_framebuffer.h"
+#include "GPU_matrix.h"
+#include "GPU_state.h"
+#include "GPU_texture.h"
 #include "GPU_viewport.h"
 #include "WM_api.h"
 #include "wm_draw.h"
 #include "wm_event_system.h"
 
+#include "eevee_private.h"
+
 #include "BL_BlenderConverter.h"
 #include "BL_BlenderDataConversion.h"
 #include "BL_BlenderSceneConverter.h"
 #include "CM_List.h"
+#include "CM_StartupProfiler.h"
 #include "EXP_FloatValue.h"
 #include "KX_2DFilterManager.h"
 #include "KX_BlenderCanvas.h"
 #include "KX_Camera.h"
+#include "KX_ClientObjectInfo.h"
 #include "KX_CollisionEventManager.h"
 #include "KX_FontObject.h"
 #include "KX_Globals.h"
+#include "KX_LibLoadStatus.h"
 #include "KX_Light.h"
+#include "KX_LightManager.h"
 #include "KX_LodManager.h"
+#include "KX_MemoryReport.h"
 #include "KX_MotionState.h"
 #include "KX_NetworkMessageScene.h"
 #include "KX_NodeRelationships.h"
 #include "KX_ObstacleSimulation.h"
+#include "KX_ParticleManager.h"
 #include "KX_PyMath.h"
+#include "KX_RayCast.h"
+#include "KX_StateManager.h"
+#include "KX_StaticBatchManager.h"
+#include "KX_TaskFuture.h"
+#include "KX_WorldStreamer.h"
+#include "PHY_IGraphicController.h"
 #include "PHY_IPhysicsController.h"
 #include "PHY_IPhysicsEnvironment.h"
+#include "PIL_time.h"
 #include "RAS_BucketManager.h"
 #include "RAS_FrameBuffer.h"
+#include "RAS_HiZCulling.h"
 #include "SCA_2DFilterActuator.h"
 #include "SCA_ActuatorEventManager.h"
 #include "SCA_BasicEventManager.h"
+#include "SCA_BrickArena.h"
 #include "SCA_JoystickManager.h"
 #include "SCA_KeyboardManager.h"
 #include "SCA_MouseManager.h"
@@ -121,11 +153,17 @@ bool KX_Scene::KX_ScenegraphRescheduleFunc(SG_Node *node, void *gameobj, void *s
   return node->Reschedule(((KX_Scene *)scene)->m_sghead);
 }
 
+void KX_Scene::KX_ScenegraphDirtyRenderFunc(SG_Node *node, void *gameobj, void *scene)
+{
+  ((KX_Scene *)scene)->AddTransformUpdateObject((KX_GameObject *)gameobj);
+}
+
 SG_Callbacks KX_Scene::m_callbacks = SG_Callbacks(KX_SceneReplicationFunc,
                                                   KX_SceneDestructionFunc,
                                                   KX_GameObject::UpdateTransformFunc,
                                                   KX_Scene::KX_ScenegraphUpdateFunc,
-                                                  KX_Scene::KX_ScenegraphRescheduleFunc);
+                                                  KX_Scene::KX_ScenegraphRescheduleFunc,
+                                                  KX_Scene::KX_ScenegraphDirtyRenderFunc);
 
 KX_Scene::KX_Scene(SCA_IInputDevice *inputDevice,
                    const std::string &sceneName,
@@ -141,28 +179,54 @@ KX_Scene::KX_Scene(SCA_IInputDevice *inputDevice,
       m_sceneConverter(nullptr),              // eevee
       m_isPythonMainLoop(false),              // eevee
       m_collectionRemap(false),               // eevee (to uncheck viewport restrictflag)
+      m_layerCollectionSync(false),
+      m_relationsUpdate(false),
+      m_instancedReplication(false),
+      m_drawUpdateCount(0),                   // eevee (for retained draw)
+      m_timeBombs(0.02),
       m_keyboardmgr(nullptr),
       m_mousemgr(nullptr),
       m_physicsEnvironment(0),
+      m_collisionEventManager(nullptr),
       m_sceneName(sceneName),
       m_active_camera(nullptr),
       m_overrideCullingCamera(nullptr),
       m_ueberExecutionPriority(0),
       m_blenderScene(scene),
+      m_viewportFrameBuffer(nullptr),
       m_isActivedHysteresis(false),
       m_lodHysteresisValue(0),
+      m_lodSwitchBudget(0),
+      m_lodUpdateOffset(0),
       m_isRuntime(true)  // eevee
 {
 
   m_dbvt_culling = false;
   m_dbvt_occlusion_res = 0;
+  m_gpuOcclusionCulling = false;
+  m_culledObjects = BLI_gset_ptr_new(__func__);
+  m_dynamicObjects = BLI_gset_ptr_new(__func__);
+  m_mergeState.m_started = false;
+  m_mergeState.m_objectIndex = 0;
+  m_mergeState.m_inactiveIndex = 0;
   m_activityCulling = false;
+  m_batchedRemoval = false;
   m_objectlist = new EXP_ListValue<KX_GameObject>();
+  // Scripts look up the objects by name every frame.
+  m_objectlist->SetUseNameIndex(true);
   m_parentlist = new EXP_ListValue<KX_GameObject>();
   m_lightlist = new EXP_ListValue<KX_LightObject>();
   m_inactivelist = new EXP_ListValue<KX_GameObject>();
   m_cameralist = new EXP_ListValue<KX_Camera>();
   m_fontlist = new EXP_ListValue<KX_FontObject>();
+  /* The objects removed outside of a batch and the parented objects are searched by slot, the
+   * lists visible to python keep their order. */
+  m_objectlist->SetUseItemIndex(true, true);
+  m_parentlist->SetUseItemIndex(true, false);
+  m_lightlist->SetUseItemIndex(true, true);
+  m_inactivelist->SetUseItemIndex(true, true);
+  m_cameralist->SetUseItemIndex(true, true);
+  m_fontlist->SetUseItemIndex(true, true);
 
   m_filterManager = new KX_2DFilterManager();
   m_logicmgr = new SCA_LogicManager();
@@ -189,6 +253,11 @@ KX_Scene::KX_Scene(SCA_IInputDevice *inputDevice,
 
   m_bucketmanager = new RAS_BucketManager();
 
+  m_animationCulling = (scene->gm.flag & GAME_USE_ANIMATION_CULLING) != 0;
+  m_animationLodDistance = 0.0f;
+  m_animationLodInterval = 2;
+  m_animationFrame = 0;
+
   bool showObstacleSimulation = (scene->gm.flag & GAME_SHOW_OBSTACLE_SIMULATION) != 0;
   switch (scene->gm.obstacleSimulation) {
     case OBSTSIMULATION_TOI_rays:
@@ -203,6 +272,11 @@ KX_Scene::KX_Scene(SCA_IInputDevice *inputDevice,
       m_obstacleSimulation = nullptr;
   }
 
+  m_worldStreamer = new KX_WorldStreamer(this);
+  m_staticBatchManager = new KX_StaticBatchManager(this);
+  m_particleManager = new KX_ParticleManager(this);
+  m_lightManager = new KX_LightManager(this);
+
   m_animationPool = BLI_task_pool_create(&m_animationPoolData, TASK_PRIORITY_LOW);
 
 #ifdef WITH_PYTHON
@@ -261,10 +335,13 @@ KX_Scene::KX_Scene(SCA_IInputDevice *inputDevice,
 
   m_overlay_collections = {};
   m_imageRenderCameraList = {};
-  m_extraObjectsToUpdateInAllRenderPasses = {};
-  m_meshesToUpdateInAllRenderPasses = {};
-  m_nodeTreesToUpdateInAllRenderPasses = {};
-  m_extraObjectsToUpdateInOverlayPass = {};
+  m_extraObjectsToUpdateInAllRenderPasses.Clear();
+  m_meshesToUpdateInAllRenderPasses.Clear();
+  m_nodeTreesToUpdateInAllRenderPasses.Clear();
+  m_extraObjectsToUpdateInOverlayPass.Clear();
+
+  /* The world may have been edited since the last game. */
+  DRW_game_world_update_tag();
 
   /* To backup and restore obmat */
   m_backupObList = {};
@@ -275,6 +352,9 @@ KX_Scene::KX_Scene(SCA_IInputDevice *inputDevice,
   CTX_wm_view3d(C)->shading.type = KX_GetActiveEngine()->ShadingTypeRuntime();
   ConfigureOverlays();
 
+  /* Without GPU context the materials are not initialized, the scene is never drawn. */
+  const bool headless = KX_GetActiveEngine()->GetFlag(KX_KetsjiEngine::HEADLESS);
+
   if (!KX_GetActiveEngine()->UseViewportRender()) {
     /* We want to indicate that we are in bge runtime. The flag can be used in draw code but in
      * depsgraph code too later */
@@ -285,15 +365,20 @@ KX_Scene::KX_Scene(SCA_IInputDevice *inputDevice,
      * 2: We need to create an eevee's cache to initialize
      * KX_BlenderMaterials and BL_Textures.
      */
-    const RAS_Rect &viewport = KX_GetActiveEngine()->GetCanvas()->GetViewportArea();
-    RenderAfterCameraSetup(nullptr, viewport, false, true);
+    if (!headless) {
+      const RAS_Rect &viewport = KX_GetActiveEngine()->GetCanvas()->GetViewportArea();
+      CM_StartupScope warmupScope("Material Warm-up", scene->id.name + 2);
+      RenderAfterCameraSetup(nullptr, viewport, false, true, {});
+    }
   }
   else {
     scene->flag |= SCE_INTERACTIVE_VIEWPORT;
   }
 
   /* Fix black shading issue with addObject https://github.com/UPBGE/upbge/issues/1354 */
-  GPU_shader_force_unbind();
+  if (!headless) {
+    GPU_shader_force_unbind();
+  }
   /****************************************************/
 }
 
@@ -323,8 +408,17 @@ KX_Scene::~KX_Scene()
   }
   /*************************/
 
-  if (!KX_GetActiveEngine()->UseViewportRender()) {
-    if (!m_isPythonMainLoop) {
+  const bool headless = KX_GetActiveEngine()->GetFlag(KX_KetsjiEngine::HEADLESS);
+
+  if (headless) {
+    // Nothing was drawn.
+  }
+  else if (!KX_GetActiveEngine()->UseViewportRender()) {
+    if (m_initMaterialsGPUViewport && m_initMaterialsGPUViewport != DRW_game_gpu_viewport_get()) {
+      /* A preloaded scene never drawn, the current viewport belongs to another scene. */
+      GPU_viewport_free(m_initMaterialsGPUViewport);
+    }
+    else if (!m_isPythonMainLoop) {
       /* This will free m_gpuViewport and m_gpuOffScreen */
       DRW_game_render_loop_end();
     }
@@ -349,7 +443,9 @@ KX_Scene::~KX_Scene()
   }
 
   /* Fixes issue when switching .blend erm...*/
-  GPU_shader_force_unbind();
+  if (!headless) {
+    GPU_shader_force_unbind();
+  }
 
   for (Object *hiddenOb : m_hiddenObjectsDuringRuntime) {
     Base *base = BKE_view_layer_base_find(view_layer, hiddenOb);
@@ -369,18 +465,38 @@ KX_Scene::~KX_Scene()
   // reference might be hanging and causing late release of objects
   RemoveAllDebugProperties();
 
+#ifdef WITH_PYTHON
+  // The tasks never ran, their futures stay undone.
+  for (KX_TaskFuture *task : m_tasks) {
+    task->Release();
+  }
+  m_tasks.clear();
+#endif  // WITH_PYTHON
+
   while (GetRootParentList()->GetCount() > 0) {
     KX_GameObject *parentobj = GetRootParentList()->GetValue(0);
     this->RemoveObject(parentobj);
   }
 
+  FreeReplicaPool();
+  FreeEmptyInstanceGroups();
+
   if (m_obstacleSimulation)
     delete m_obstacleSimulation;
 
+  delete m_worldStreamer;
+  // After the objects removal, the batched objects are already restored.
+  delete m_staticBatchManager;
+  delete m_particleManager;
+  delete m_lightManager;
+
   if (m_animationPool) {
     BLI_task_pool_free(m_animationPool);
   }
 
+  BLI_gset_free(m_culledObjects, nullptr);
+  BLI_gset_free(m_dynamicObjects, nullptr);
+
   if (m_objectlist)
     m_objectlist->Release();
 
@@ -412,6 +528,8 @@ KX_Scene::~KX_Scene()
     delete m_filterManager;
   }
 
+  delete m_viewportFrameBuffer;
+
   if (m_logicmgr)
     delete m_logicmgr;
 
@@ -431,6 +549,9 @@ KX_Scene::~KX_Scene()
   RestoreRestrictFlags();
   m_obRestrictFlags.clear();
 
+  // The removed objects restored the visibility of the original objects.
+  FlushStructureUpdates(bmain);
+
   // Flush depsgraph updates a last time at ge exit
   BKE_scene_graph_update_tagged(depsgraph, bmain);
 
@@ -508,6 +629,15 @@ void KX_Scene::ReinitBlenderContextVariables()
   }
 }
 
+void KX_Scene::ActivateBlenderContext()
+{
+  ReinitBlenderContextVariables();
+
+  bContext *C = KX_GetActiveEngine()->GetContext();
+  ED_screen_scene_change(C, CTX_wm_window(C), m_blenderScene);
+  CTX_data_depsgraph_pointer(C);
+}
+
 void KX_Scene::ConfigureOverlays()
 {
   bContext *C = KX_GetActiveEngine()->GetContext();
@@ -563,6 +693,20 @@ void KX_Scene::AddOverlayCollection(KX_Camera *overlay_cam, Collection *collecti
   }
 }
 
+void KX_Scene::GetOverlayObjects(std::vector<Object *> &objects) const
+{
+  // An object can be in several overlay collections.
+  std::unordered_set<Object *> added;
+  for (Collection *collection : m_overlay_collections) {
+    FOREACH_COLLECTION_OBJECT_RECURSIVE_BEGIN (collection, collection_object) {
+      if (added.insert(collection_object).second) {
+        objects.push_back(collection_object);
+      }
+    }
+    FOREACH_COLLECTION_OBJECT_RECURSIVE_END;
+  }
+}
+
 void KX_Scene::RemoveOverlayCollection(Collection *collection)
 {
   /* Check for already removed collections */
@@ -709,13 +853,91 @@ bool KX_Scene::CameraIsInactive(KX_Camera *cam)
   return true;
 }
 
+struct EvaluatedTransformData {
+  KX_GameObject **objects;
+  Object **obEvals;
+  Depsgraph *depsgraph;
+};
+
+static void evaluated_transform_matrix_task(void *__restrict userdata,
+                                            const int i,
+                                            const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  EvaluatedTransformData *data = (EvaluatedTransformData *)userdata;
+  data->obEvals[i] = data->objects[i]->TagForTransformUpdateEvaluated(data->depsgraph);
+}
+
+static void evaluated_transform_decompose_task(void *__restrict userdata,
+                                               const int i,
+                                               const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  EvaluatedTransformData *data = (EvaluatedTransformData *)userdata;
+  Object *ob_eval = data->obEvals[i];
+  if (ob_eval) {
+    BKE_object_apply_mat4(ob_eval, ob_eval->obmat, false, true);
+  }
+}
+
+/// Return the number of IDs updated by the last evaluation of a depsgraph.
+static unsigned int count_updated_ids(Depsgraph *depsgraph)
+{
+  DEGIDIterData data = {depsgraph, true, 0, 0};
+  BLI_Iterator iter = {nullptr, nullptr, false, true};
+
+  unsigned int count = 0;
+  for (DEG_iterator_ids_begin(&iter, &data); iter.valid; DEG_iterator_ids_next(&iter)) {
+    ++count;
+  }
+  DEG_iterator_ids_end(&iter);
+
+  return count;
+}
+
+/* Compute the area of a camera render in the canvas and the window of the render, reduced by
+ * the resolution scale. */
+static void get_render_window(KX_Scene *scene,
+                              RAS_ICanvas *canvas,
+                              KX_Camera *cam,
+                              const RAS_Rect &viewport,
+                              float resolutionScale,
+                              int v[4],
+                              rcti &window)
+{
+  /* Custom BGE viewports*/
+  if (cam && cam->GetViewport() && cam != scene->GetOverlayCamera()) {
+    v[0] = canvas->GetViewportArea().GetLeft() + viewport.GetLeft();
+    v[1] = canvas->GetViewportArea().GetBottom() + viewport.GetBottom();
+    v[2] = viewport.GetWidth() + 1;
+    v[3] = viewport.GetHeight() + 1;
+
+    window = {0, viewport.GetWidth(), 0, viewport.GetHeight()};
+  }
+  /* Main cam (when it has no custom viewport), overlay cam */
+  else {
+    v[0] = canvas->GetViewportArea().GetLeft();
+    v[1] = canvas->GetViewportArea().GetBottom();
+    v[2] = canvas->GetWidth() + 1;
+    v[3] = canvas->GetHeight() + 1;
+
+    window = {0, canvas->GetWidth(), 0, canvas->GetHeight()};
+  }
+
+  /* Render at a lower resolution when the GPU is slow, the viewport textures are
+   * upscaled to the viewport at the transform to display or at the 2D filters. */
+  if (resolutionScale < 1.0f) {
+    window.xmax = max_ii(int(window.xmax * resolutionScale), 1);
+    window.ymax = max_ii(int(window.ymax * resolutionScale), 1);
+  }
+}
+
 static RAS_Rasterizer::FrameBufferType r = RAS_Rasterizer::RAS_FRAMEBUFFER_FILTER0;
 static RAS_Rasterizer::FrameBufferType s = RAS_Rasterizer::RAS_FRAMEBUFFER_EYE_LEFT0;
 
 void KX_Scene::RenderAfterCameraSetup(KX_Camera *cam,
                                       const RAS_Rect &viewport,
                                       bool is_overlay_pass,
-                                      bool is_last_render_pass)
+                                      bool is_last_render_pass,
+                                      const std::vector<RenderView> &views)
 {
   KX_KetsjiEngine *engine = KX_GetActiveEngine();
   RAS_Rasterizer *rasty = engine->GetRasterizer();
@@ -740,60 +962,172 @@ void KX_Scene::RenderAfterCameraSetup(KX_Camera *cam,
   }
 
   engine->CountDepsgraphTime();
+  KX_DepsgraphProfiler &depsgraphProfiler = engine->GetDepsgraphProfiler();
+  const bool profileDepsgraph = depsgraphProfiler.GetEnabled();
 
-  if (m_collectionRemap) {
-    BKE_main_collection_sync_remap(bmain);
-    m_collectionRemap = false;
+  // Apply the object additions, removals and visibility changes of the frame at once.
+  depsgraphProfiler.StartStage(KX_DepsgraphProfiler::STAGE_COLLECTION_REMAP);
+  if (m_staticBatchManager->Update()) {
+    m_drawUpdateCount++;
+  }
+  FlushStructureUpdates(bmain);
+
+  depsgraphProfiler.StartStage(KX_DepsgraphProfiler::STAGE_TRANSFORM_TAGGING);
+  if (profileDepsgraph) {
+    depsgraphProfiler.AddTaggedIds(m_transformUpdateObjects.size());
   }
 
   /* Notify the depsgraph if object transform changed in the scene
-   * for next drawing loop. */
-  for (KX_GameObject *gameobj : GetObjectList()) {
-    gameobj->TagForTransformUpdate(is_overlay_pass, is_last_render_pass);
+   * for next drawing loop. Only the objects moved since the last
+   * render are visited, static objects don't need any update. */
+  SCA_ObjectProfiler &objectProfiler = m_logicmgr->GetObjectProfiler();
+  if (objectProfiler.GetEnabled()) {
+    for (KX_GameObject *gameobj : m_transformUpdateObjects) {
+      const double startTime = SCA_ObjectProfiler::GetTime();
+      gameobj->TagForTransformUpdate(is_overlay_pass, is_last_render_pass);
+      objectProfiler.AddTime(gameobj, SCA_ObjectProfiler::CATEGORY_TRANSFORM, startTime);
+    }
+  }
+  else {
+    for (KX_GameObject *gameobj : m_transformUpdateObjects) {
+      gameobj->TagForTransformUpdate(is_overlay_pass, is_last_render_pass);
+    }
   }
 
   /* Notify depsgraph for other changes */
-  TagForExtraObjectsUpdate(bmain, cam);
+  depsgraphProfiler.StartStage(KX_DepsgraphProfiler::STAGE_EXTRA_TAGGING);
+  if (profileDepsgraph) {
+    depsgraphProfiler.AddTaggedIds(m_extraObjectsToUpdateInAllRenderPasses.GetSize() +
+                                   m_meshesToUpdateInAllRenderPasses.GetSize() +
+                                   m_nodeTreesToUpdateInAllRenderPasses.GetSize() +
+                                   ((cam && cam == GetOverlayCamera()) ?
+                                        m_extraObjectsToUpdateInOverlayPass.GetSize() :
+                                        0));
+  }
+  TagForExtraObjectsUpdate(bmain, cam, views);
 
   if (is_last_render_pass) {
-    m_extraObjectsToUpdateInAllRenderPasses.clear();
-    m_meshesToUpdateInAllRenderPasses.clear();
-    m_nodeTreesToUpdateInAllRenderPasses.clear();
+    m_extraObjectsToUpdateInAllRenderPasses.Clear();
+    m_meshesToUpdateInAllRenderPasses.Clear();
+    m_nodeTreesToUpdateInAllRenderPasses.Clear();
+  }
+
+  /* Any change to evaluate invalidates the retained camera viewports. */
+  if (!DEG_is_fully_evaluated(depsgraph)) {
+    m_drawUpdateCount++;
+  }
+
+  /* Rebuild the relations ahead of the evaluation to measure them apart, the
+   * evaluation then finds the relations up to date. */
+  if (profileDepsgraph) {
+    depsgraphProfiler.StartStage(KX_DepsgraphProfiler::STAGE_RELATIONS);
+    if (DEG_graph_relations_need_update(depsgraph)) {
+      depsgraphProfiler.AddRelationsRebuild();
+      DEG_graph_relations_update(depsgraph);
+    }
+  }
+
+  /* The draw manager skips the world update unless the world or a node tree was tagged, the
+   * tagged types are cleared by the evaluation. */
+  if (DEG_id_type_updated(depsgraph, ID_WO)) {
+    DRW_game_world_update_tag();
   }
 
   /* We need the changes to be flushed before each draw loop! */
+  depsgraphProfiler.StartStage(KX_DepsgraphProfiler::STAGE_EVALUATION);
   BKE_scene_graph_update_tagged(depsgraph, bmain);
 
-  UpdateParents(0.0);
-
-  /* Update evaluated object obmat according to SceneGraph. */
-  for (KX_GameObject *gameobj : GetObjectList()) {
-    gameobj->TagForTransformUpdateEvaluated();
+  if (profileDepsgraph) {
+    depsgraphProfiler.AddEvaluatedIds(count_updated_ids(depsgraph));
   }
 
-  engine->EndCountDepsgraphTime();
+  depsgraphProfiler.StartStage(KX_DepsgraphProfiler::STAGE_OBMAT_SYNC);
+  UpdateParents(0.0);
 
-  rcti window;
-  int v[4];
-  /* Custom BGE viewports*/
-  if (cam && cam->GetViewport() && cam != GetOverlayCamera()) {
-    v[0] = canvas->GetViewportArea().GetLeft() + viewport.GetLeft();
-    v[1] = canvas->GetViewportArea().GetBottom() + viewport.GetBottom();
-    v[2] = viewport.GetWidth() + 1;
-    v[3] = viewport.GetHeight() + 1;
+  /* Update evaluated object obmat according to SceneGraph.
+   * Use indices as UpdateParents could have registered new moved objects.
+   * Objects overriden by the depsgraph modify the scene graph and are synchronized
+   * serially, the others only write their evaluated object and are batched. */
+  for (unsigned int i = 0; i < m_transformUpdateObjects.size(); ++i) {
+    KX_GameObject *gameobj = m_transformUpdateObjects[i];
+    // A moved object leaves its batch, rebuilt at the next render.
+    if (gameobj->IsBatched()) {
+      m_staticBatchManager->UpdateObjectTransform(gameobj);
+    }
+    if (gameobj->IsTransformOverridenByDepsgraph()) {
+      gameobj->SyncTransformWithDepsgraph();
+    }
+    else if (gameobj->IsInstance()) {
+      TagInstanceGroupUpdate(gameobj);
+    }
+    else {
+      m_evaluatedTransformObjects.push_back(gameobj);
+    }
+  }
 
-    window = {0, viewport.GetWidth(), 0, viewport.GetHeight()};
+  m_evaluatedTransformObjectsEval.resize(m_evaluatedTransformObjects.size());
+  EvaluatedTransformData evaluatedData = {
+      m_evaluatedTransformObjects.data(), m_evaluatedTransformObjectsEval.data(), depsgraph};
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 16;
+  /* All the matrices are written before the decomposition which reads the matrix
+   * of the parent object. */
+  BLI_task_parallel_range(0,
+                          m_evaluatedTransformObjects.size(),
+                          &evaluatedData,
+                          evaluated_transform_matrix_task,
+                          &settings);
+  BLI_task_parallel_range(0,
+                          m_evaluatedTransformObjects.size(),
+                          &evaluatedData,
+                          evaluated_transform_decompose_task,
+                          &settings);
+  m_evaluatedTransformObjects.clear();
+
+  /* The instances are drawn from the matrices written here, the draw doesn't
+   * need any depsgraph evaluation. */
+  if (UpdateInstanceGroups()) {
+    m_drawUpdateCount++;
+  }
+
+  if (m_dbvt_culling) {
+    UpdateCullingBounds(depsgraph);
   }
-  /* Main cam (when it has no custom viewport), overlay cam */
-  else {
-    v[0] = canvas->GetViewportArea().GetLeft();
-    v[1] = canvas->GetViewportArea().GetBottom();
-    v[2] = canvas->GetWidth() + 1;
-    v[3] = canvas->GetHeight() + 1;
 
-    window = {0, canvas->GetWidth(), 0, canvas->GetHeight()};
+  if (is_last_render_pass) {
+    RemoveStaticTransformUpdateObjects();
   }
 
+  depsgraphProfiler.EndStage();
+  engine->EndCountDepsgraphTime();
+
+  const float resolutionScale = useViewportRender ? 1.0f :
+                                                    engine->GetResolutionScaler().GetScale();
+
+  /* With several views the camera only owns the GPU viewport, the first view is drawn in the
+   * viewport and the others into frame buffers of the camera. */
+  const bool multiView = !views.empty();
+  const unsigned int numViews = multiView ? views.size() : 1;
+  std::vector<KX_Camera *> viewCameras(numViews, cam);
+  std::vector<rcti> windows(numViews);
+  std::vector<std::array<int, 4>> areas(numViews);
+  for (unsigned int i = 0; i < numViews; ++i) {
+    if (multiView) {
+      viewCameras[i] = views[i].m_camera;
+    }
+    get_render_window(this,
+                      canvas,
+                      viewCameras[i],
+                      multiView ? views[i].m_viewport : viewport,
+                      resolutionScale,
+                      areas[i].data(),
+                      windows[i]);
+  }
+  KX_Camera *viewcam = viewCameras[0];
+  const rcti &window = windows[0];
+  const int *v = areas[0].data();
+
   /* Here we'll render directly the scene with viewport code. */
   if (useViewportRender) {
     /* Viewport render mode doesn't support several render passes then exit here
@@ -826,9 +1160,13 @@ void KX_Scene::RenderAfterCameraSetup(KX_Camera *cam,
 
       CTX_wm_view3d(C)->camera = cam->GetBlenderObject();
 
+      /* Only the game region is redrawn, the XR session still needs the full window manager
+       * update to draw its surface. */
+      bool useGameDraw = true;
 #ifdef WITH_XR_OPENXR
       wmWindowManager *wm = CTX_wm_manager(C);
       if (WM_xr_session_exists(&wm->xr)) {
+        useGameDraw = false;
         if (WM_xr_session_is_ready(&wm->xr)) {
           wm_event_do_handlers(C);   // TODO: Find more specific XR code
           wm_event_do_notifiers(C);  // TODO: Find more specific XR code
@@ -837,7 +1175,12 @@ void KX_Scene::RenderAfterCameraSetup(KX_Camera *cam,
 #endif
 
       ED_region_tag_redraw(CTX_wm_region(C));
-      wm_draw_update(C);
+      if (useGameDraw) {
+        wm_draw_game_update(C);
+      }
+      else {
+        wm_draw_update(C);
+      }
 
       /* We need to do that before and after wm_draw_update
        * because wm_draw_update unset context variables.
@@ -855,20 +1198,23 @@ void KX_Scene::RenderAfterCameraSetup(KX_Camera *cam,
 
   /* Custom bge render loop only from here */
   if (cam) {
+    float viewmat[4][4];
     float winmat[4][4];
-    cam->GetProjectionMatrix().getValue(&winmat[0][0]);
+    viewcam->GetModelviewMatrix().getValue(&viewmat[0][0]);
+    viewcam->GetProjectionMatrix().getValue(&winmat[0][0]);
     CTX_wm_view3d(C)->camera = cam->GetBlenderObject();
+    /* The views are drawn with their own view matrices, e.g. with the eye offset. */
     ED_view3d_draw_setup_view(CTX_wm_manager(C),
                               CTX_wm_window(C),
                               CTX_data_expect_evaluated_depsgraph(C),
                               CTX_data_scene(C),
                               CTX_wm_region(C),
                               CTX_wm_view3d(C),
-                              NULL,
+                              multiView ? viewmat : NULL,
                               winmat,
                               NULL);
 
-    UpdateObjectLods(cam);
+    UpdateObjectLods(cam, depsgraph);
   }
 
   OverlayPassDisableEffects(depsgraph, cam, is_overlay_pass);
@@ -876,49 +1222,146 @@ void KX_Scene::RenderAfterCameraSetup(KX_Camera *cam,
   short samples_per_frame = min_ii(scene->gm.samples_per_frame, scene->eevee.taa_samples);
   samples_per_frame = max_ii(samples_per_frame, 1);
 
-  for (short i = 0; i < samples_per_frame; i++) {
+  /* Reuse the previous result of the camera viewport when nothing changed, the particles move
+   * on the GPU without notifying the scene. */
+  const bool retainDraw = cam && !is_overlay_pass && !multiView &&
+                          engine->GetFlag(KX_KetsjiEngine::RETAINED_DRAW) &&
+                          m_particleManager->IsEmpty() &&
+                          UpdateRetainedDraw(cam, &window, samples_per_frame);
+
+  if (!retainDraw) {
+    const bool useCulling = cam && m_dbvt_culling;
+    const bool useHiZCulling = useCulling && !is_overlay_pass && !multiView &&
+                               m_gpuOcclusionCulling && RAS_HiZCulling::Supported();
+    if (useCulling) {
+      CullObjects(viewcam, v);
+      // The caches are populated once, only the objects outside of all the views are culled.
+      for (unsigned int i = 1; i < numViews; ++i) {
+        CullObjectsMerge(viewCameras[i], areas[i].data());
+      }
+    }
+    if (useHiZCulling) {
+      ApplyHiZCulling(cam);
+    }
+    // The lights over the budget are culled even without the objects culling.
+    const unsigned short lightBudget = engine->GetLightBudget();
+    const bool useLightCulling = cam && !is_overlay_pass && lightBudget > 0;
+    if (useLightCulling) {
+      if (!useCulling) {
+        BLI_gset_clear(m_culledObjects, nullptr);
+      }
+      m_lightManager->Cull(viewCameras, lightBudget, m_culledObjects);
+    }
+    if (cam && !is_overlay_pass && engine->GetTextureStreamer().GetEnabled()) {
+      engine->GetTextureStreamer().AddView(this, viewcam, v, useCulling);
+    }
+
+    std::vector<float> extraViewMats(16 * (numViews - 1));
+    std::vector<float> extraWinMats(16 * (numViews - 1));
+    std::vector<GPUFrameBuffer *> extraTargets(numViews - 1);
+    for (unsigned int i = 1; i < numViews; ++i) {
+      viewCameras[i]->GetModelviewMatrix().getValue(&extraViewMats[16 * (i - 1)]);
+      viewCameras[i]->GetProjectionMatrix().getValue(&extraWinMats[16 * (i - 1)]);
+      // Same size as the viewport textures.
+      extraTargets[i - 1] = cam->GetExtraViewFrameBuffer(i - 1,
+                                                         BLI_rcti_size_x(&window) + 1,
+                                                         BLI_rcti_size_y(&window) + 1)
+                                ->GetFrameBuffer();
+    }
+
+    /* The TAA samples are accumulated in the same render loop, the draw caches
+     * are populated only once. */
     GPU_clear_depth(1.0f);
-    DRW_game_render_loop(
-        C, m_currentGPUViewport, depsgraph, &window, is_overlay_pass, cam == nullptr);
+    DRW_game_culled_objects_set((useCulling || useLightCulling) ? m_culledObjects : nullptr);
+    DRW_game_lights_set(m_lightManager->UpdateGameLights());
+    DRW_game_dynamic_objects_set(
+        engine->GetFlag(KX_KetsjiEngine::STATIC_SHADOWS) ? m_dynamicObjects : nullptr);
+    DRW_game_extra_views_set((const float(*)[4][4])extraViewMats.data(),
+                             (const float(*)[4][4])extraWinMats.data(),
+                             extraTargets.data(),
+                             numViews - 1);
+    /* The overlay pass only visits the objects of the overlay collections. */
+    std::vector<Object *> overlayObjects;
+    if (is_overlay_pass) {
+      GetOverlayObjects(overlayObjects);
+      DRW_game_overlay_pass_set(overlayObjects.data(),
+                                overlayObjects.size(),
+                                engine->GetFlag(KX_KetsjiEngine::OVERLAY_WORKBENCH));
+    }
+    if (rasty->GetUseGpuTimers()) {
+      rasty->BeginGpuTimer(is_overlay_pass ? "Overlay " + cam->GetName() :
+                                             "Camera " + (cam ? cam->GetName() : GetName()));
+    }
+    DRW_game_render_loop(C,
+                         m_currentGPUViewport,
+                         depsgraph,
+                         &window,
+                         is_overlay_pass,
+                         cam == nullptr,
+                         samples_per_frame);
+    rasty->EndGpuTimer();
+    DRW_game_culled_objects_set(nullptr);
+    DRW_game_lights_set(nullptr);
+    DRW_game_dynamic_objects_set(nullptr);
+    DRW_game_extra_views_set(nullptr, nullptr, nullptr, 0);
+    DRW_game_overlay_pass_set(nullptr, 0, false);
+
+    if (useHiZCulling) {
+      TestHiZCulling(cam);
+    }
   }
 
-  RAS_FrameBuffer *input = rasty->GetFrameBuffer(rasty->NextFilterFrameBuffer(r));
+  /* The 2D filters read directly the color and depth textures of the viewport through a frame
+   * buffer built once, its attachments change only with the viewport textures. */
+  RAS_FrameBuffer *input;
+  if (cam && !useViewportRender) {
+    input = cam->GetViewportFrameBuffer();
+  }
+  else {
+    if (!m_viewportFrameBuffer) {
+      m_viewportFrameBuffer = new RAS_FrameBuffer(rasty->NextFilterFrameBuffer(r));
+    }
+    m_viewportFrameBuffer->AttachTextures(GPU_viewport_color_texture(m_currentGPUViewport, 0),
+                                          GPU_viewport_depth_texture(m_currentGPUViewport));
+    input = m_viewportFrameBuffer;
+  }
   RAS_FrameBuffer *output = rasty->GetFrameBuffer(rasty->NextRenderFrameBuffer(s));
 
-  /* Detach Defaults attachments from input framebuffer... */
-  GPU_framebuffer_texture_detach(input->GetFrameBuffer(), input->GetColorAttachment());
-  GPU_framebuffer_texture_detach(input->GetFrameBuffer(), input->GetDepthAttachment());
-  /* And replace it with color and depth textures from viewport */
-  GPU_framebuffer_texture_attach(
-      input->GetFrameBuffer(), GPU_viewport_color_texture(m_currentGPUViewport, 0), 0, 0);
-  GPU_framebuffer_texture_attach(
-      input->GetFrameBuffer(), GPU_viewport_depth_texture(m_currentGPUViewport), 0, 0);
+  for (unsigned int i = 0; i < numViews; ++i) {
+    if (i > 0) {
+      input = cam->GetExtraViewFrameBuffer(
+          i - 1, BLI_rcti_size_x(&window) + 1, BLI_rcti_size_y(&window) + 1);
+    }
+
+    /* The particles and the texts are drawn over the render result before the filters, tested
+     * against its depth. */
+    if (cam && !retainDraw) {
+      m_particleManager->Render(viewCameras[i], input, &windows[i], is_overlay_pass);
+      RenderFastTexts(viewCameras[i], input, &windows[i], is_overlay_pass);
+    }
 
-  RAS_FrameBuffer *f = is_overlay_pass ? input : Render2DFilters(rasty, canvas, input, output);
+    GPU_texture_filter_mode(input->GetColorAttachment(), resolutionScale < 1.0f);
 
-  GPU_framebuffer_restore();
+    RAS_FrameBuffer *f = is_overlay_pass ? input : Render2DFilters(rasty, canvas, input, output);
 
-  GPU_viewport(v[0], v[1], v[2], v[3]);
-  GPU_scissor_test(true);
-  GPU_scissor(v[0], v[1], v[2], v[3]);
+    GPU_framebuffer_restore();
 
-  GPU_apply_state();
+    const int *area = areas[i].data();
+    GPU_viewport(area[0], area[1], area[2], area[3]);
+    GPU_scissor_test(true);
+    GPU_scissor(area[0], area[1], area[2], area[3]);
 
-  DRW_transform_to_display(GPU_framebuffer_color_texture(f->GetFrameBuffer()),
-                           CTX_wm_view3d(C),
-                           CTX_data_scene(C),
-                           GetOverlayCamera() && !is_overlay_pass ? false : true);
+    GPU_apply_state();
 
-  /* Detach viewport textures from input framebuffer... */
-  GPU_framebuffer_texture_detach(input->GetFrameBuffer(),
-                                 GPU_viewport_color_texture(m_currentGPUViewport, 0));
-  GPU_framebuffer_texture_detach(input->GetFrameBuffer(),
-                                 GPU_viewport_depth_texture(m_currentGPUViewport));
-  /* And restore defaults attachments */
-  GPU_framebuffer_texture_attach(input->GetFrameBuffer(), input->GetColorAttachment(), 0, 0);
-  GPU_framebuffer_texture_attach(input->GetFrameBuffer(), input->GetDepthAttachment(), 0, 0);
+    rasty->BeginGpuTimer("Transform To Display");
+    DRW_transform_to_display(GPU_framebuffer_color_texture(f->GetFrameBuffer()),
+                             CTX_wm_view3d(C),
+                             CTX_data_scene(C),
+                             GetOverlayCamera() && !is_overlay_pass ? false : true);
+    rasty->EndGpuTimer();
 
-  GPU_framebuffer_restore();
+    GPU_framebuffer_restore();
+  }
 
   GPU_blend(GPU_BLEND_NONE);
 }
@@ -945,7 +1388,111 @@ void KX_Scene::RenderAfterCameraSetupImageRender(KX_Camera *cam, const rcti *win
                             winmat,
                             NULL);
 
-  DRW_game_render_loop(C, m_currentGPUViewport, depsgraph, window, false, false);
+  if (m_dbvt_culling) {
+    const int viewport[4] = {
+        window->xmin, window->ymin, window->xmax - window->xmin, window->ymax - window->ymin};
+    CullObjects(cam, viewport);
+    DRW_game_culled_objects_set(m_culledObjects);
+  }
+  const unsigned short lightBudget = KX_GetActiveEngine()->GetLightBudget();
+  if (lightBudget > 0) {
+    if (!m_dbvt_culling) {
+      BLI_gset_clear(m_culledObjects, nullptr);
+    }
+    m_lightManager->Cull({cam}, lightBudget, m_culledObjects);
+    DRW_game_culled_objects_set(m_culledObjects);
+  }
+
+  DRW_game_dynamic_objects_set(
+      KX_GetActiveEngine()->GetFlag(KX_KetsjiEngine::STATIC_SHADOWS) ? m_dynamicObjects : nullptr);
+  DRW_game_lights_set(m_lightManager->UpdateGameLights());
+  DRW_game_render_loop(C, m_currentGPUViewport, depsgraph, window, false, false, 1);
+  DRW_game_culled_objects_set(nullptr);
+  DRW_game_lights_set(nullptr);
+  DRW_game_dynamic_objects_set(nullptr);
+
+  /* The camera viewport is now used by an image render. */
+  cam->m_retainedSamples = 0;
+}
+
+bool KX_Scene::UpdateRetainedDraw(KX_Camera *cam, const rcti *window, int samples)
+{
+  bContext *C = KX_GetActiveEngine()->GetContext();
+  RegionView3D *rv3d = CTX_wm_region_view3d(C);
+  Scene *scene = GetBlenderScene();
+
+  const int viewportWindow[4] = {window->xmin, window->xmax, window->ymin, window->ymax};
+  const bool sameWindow = (memcmp(cam->m_retainedWindow, viewportWindow, sizeof(viewportWindow)) ==
+                           0);
+  const bool unchanged = (cam->m_retainedSamples > 0) &&
+                         (cam->m_retainedUpdateCount == m_drawUpdateCount) && sameWindow &&
+                         equals_m4m4(cam->m_retainedViewMat, rv3d->viewmat) &&
+                         equals_m4m4(cam->m_retainedWinMat, rv3d->winmat);
+
+  if (!unchanged) {
+    copy_m4_m4(cam->m_retainedViewMat, rv3d->viewmat);
+    copy_m4_m4(cam->m_retainedWinMat, rv3d->winmat);
+    memcpy(cam->m_retainedWindow, viewportWindow, sizeof(viewportWindow));
+    cam->m_retainedUpdateCount = m_drawUpdateCount;
+    cam->m_retainedSamples = 0;
+  }
+  /* Wait for the end of the temporal anti-aliasing accumulation of the static view. */
+  else if (cam->m_retainedSamples >= max_ii(scene->eevee.taa_samples, 1)) {
+    return true;
+  }
+
+  cam->m_retainedSamples += samples;
+  return false;
+}
+
+void KX_Scene::RenderFastTexts(KX_Camera *cam,
+                               RAS_FrameBuffer *target,
+                               const rcti *window,
+                               bool is_overlay_pass)
+{
+  std::vector<KX_FontObject *> fonts;
+  for (KX_FontObject *font : m_fontlist) {
+    const bool overlay = (font->GetBlenderObject()->gameflag & OB_OVERLAY_COLLECTION);
+    if (font->GetFastText() && font->GetVisible() && overlay == is_overlay_pass) {
+      fonts.push_back(font);
+    }
+  }
+
+  if (fonts.empty()) {
+    return;
+  }
+
+  GPU_framebuffer_bind(target->GetFrameBuffer());
+  GPU_viewport(0, 0, BLI_rcti_size_x(window), BLI_rcti_size_y(window));
+
+  float viewmat[4][4];
+  float winmat[4][4];
+  cam->GetModelviewMatrix().getValue(&viewmat[0][0]);
+  cam->GetProjectionMatrix().getValue(&winmat[0][0]);
+  GPU_matrix_push_projection();
+  GPU_matrix_projection_set(winmat);
+  GPU_matrix_push();
+  GPU_matrix_set(viewmat);
+
+  GPU_blend(GPU_BLEND_ALPHA);
+  GPU_depth_test(GPU_DEPTH_LESS_EQUAL);
+  GPU_depth_mask(false);
+
+  for (KX_FontObject *font : fonts) {
+    font->DrawFastText();
+  }
+
+  GPU_depth_mask(true);
+  GPU_depth_test(GPU_DEPTH_NONE);
+  GPU_blend(GPU_BLEND_NONE);
+
+  GPU_matrix_pop();
+  GPU_matrix_pop_projection();
+}
+
+void KX_Scene::InvalidateRetainedDraws()
+{
+  m_drawUpdateCount++;
 }
 
 void KX_Scene::SetBlenderSceneConverter(BL_BlenderSceneConverter *sc_converter)
@@ -1005,81 +1552,18 @@ void KX_Scene::convert_blender_objects_list_synchronous(std::vector<Object *> ob
   }
 }
 
-// Task data for convertBlenderCollection in a different thread.
-struct ConvertBlenderObjectsListTaskData {
-  std::vector<Object *> objectslist;
-  KX_KetsjiEngine *engine;
-  e_PhysicsEngine physics_engine;
-  KX_Scene *kxscene;
-  BL_BlenderSceneConverter *converter;
-  RAS_Rasterizer *rasty;
-  RAS_ICanvas *canvas;
-  Depsgraph *depsgraph;
-  Main *bmain;
-};
-
-static void convert_blender_objects_list_thread_func(TaskPool *__restrict UNUSED(pool),
-                                                     void *taskdata)
-{
-  ConvertBlenderObjectsListTaskData *task = static_cast<ConvertBlenderObjectsListTaskData *>(
-      taskdata);
-
-  for (Object *obj : task->objectslist) {
-    BL_ConvertBlenderObjects(task->bmain,
-                             task->depsgraph,
-                             task->kxscene,
-                             task->engine,
-                             task->physics_engine,
-                             task->rasty,
-                             task->canvas,
-                             task->converter,
-                             obj,
-                             false,
-                             false);
-  }
-}
-
-void KX_Scene::ConvertBlenderObjectsList(std::vector<Object *> objectslist, bool asynchronous)
+KX_LibLoadStatus *KX_Scene::ConvertBlenderObjectsList(std::vector<Object *> objectslist,
+                                                      bool asynchronous)
 {
   if (asynchronous) {
-    /* Convert the Blender Objects list in a different thread, so that the
+    /* Convert the Blender Objects list over the next frames, so that the
      * game engine can keep running at full speed. */
-    ConvertBlenderObjectsListTaskData task;
-    task.engine = KX_GetActiveEngine();
-    task.physics_engine = UseBullet;
-    task.kxscene = this;
-    task.converter = m_sceneConverter;
-    task.rasty = task.engine->GetRasterizer();
-    task.canvas = task.engine->GetCanvas();
-    bContext *C = task.engine->GetContext();
-    task.depsgraph = CTX_data_expect_evaluated_depsgraph(C);
-    task.bmain = CTX_data_main(C);
-    task.objectslist = objectslist;
-
-    TaskPool *taskpool = BLI_task_pool_create(&task, TASK_PRIORITY_LOW);
-
-    BLI_task_pool_push(
-        taskpool,
-        convert_blender_objects_list_thread_func,
-        &task,
-        false,  // We will clean the objectslist std::vector of pointers ourself later
-        NULL);
-    BLI_task_pool_work_and_wait(taskpool);
-
-    /* delete the objectslist ourself as it gives error if the work
-     * has to do it the BLI_task_pool_work_and_wait function */
-    while (!task.objectslist.size() != 0) {
-      Object *temp = task.objectslist.back();
-      task.objectslist.pop_back();
-      delete temp;
-    }
-
-    BLI_task_pool_free(taskpool);
-    taskpool = nullptr;
-  }
-  else {
-    convert_blender_objects_list_synchronous(objectslist);
+    return KX_GetActiveEngine()->GetConverter()->ConvertBlenderObjectsAsync(
+        this, objectslist, GetName());
   }
+
+  convert_blender_objects_list_synchronous(objectslist);
+  return nullptr;
 }
 
 void KX_Scene::convert_blender_collection_synchronous(Collection *co)
@@ -1108,70 +1592,23 @@ void KX_Scene::convert_blender_collection_synchronous(Collection *co)
   FOREACH_COLLECTION_OBJECT_RECURSIVE_END;
 }
 
-// Task data for convertBlenderCollection in a different thread.
-struct ConvertBlenderCollectionTaskData {
-  Collection *co;
-  KX_KetsjiEngine *engine;
-  e_PhysicsEngine physics_engine;
-  KX_Scene *kxscene;
-  BL_BlenderSceneConverter *converter;
-  RAS_Rasterizer *rasty;
-  RAS_ICanvas *canvas;
-  Depsgraph *depsgraph;
-  Main *bmain;
-};
-
-static void convert_blender_collection_thread_func(TaskPool *__restrict UNUSED(pool),
-                                                   void *taskdata)
-{
-  ConvertBlenderCollectionTaskData *task = static_cast<ConvertBlenderCollectionTaskData *>(
-      taskdata);
-
-  FOREACH_COLLECTION_OBJECT_RECURSIVE_BEGIN (task->co, obj) {
-    BL_ConvertBlenderObjects(task->bmain,
-                             task->depsgraph,
-                             task->kxscene,
-                             task->engine,
-                             task->physics_engine,
-                             task->rasty,
-                             task->canvas,
-                             task->converter,
-                             obj,
-                             false,
-                             false);
-  }
-  FOREACH_COLLECTION_OBJECT_RECURSIVE_END;
-}
-
-void KX_Scene::ConvertBlenderCollection(Collection *co, bool asynchronous)
+KX_LibLoadStatus *KX_Scene::ConvertBlenderCollection(Collection *co, bool asynchronous)
 {
   if (asynchronous) {
-
-    /* Convert the Blender collection in a different thread, so that the
+    /* Convert the Blender collection over the next frames, so that the
      * game engine can keep running at full speed. */
-    ConvertBlenderCollectionTaskData task;
-
-    task.engine = KX_GetActiveEngine();
-    task.physics_engine = UseBullet;
-    task.co = co;
-    task.kxscene = this;
-    task.converter = m_sceneConverter;
-    task.rasty = task.engine->GetRasterizer();
-    task.canvas = task.engine->GetCanvas();
-    bContext *C = task.engine->GetContext();
-    task.depsgraph = CTX_data_ensure_evaluated_depsgraph(C);
-    task.bmain = CTX_data_main(C);
-
-    TaskPool *taskpool = BLI_task_pool_create(&task, TASK_PRIORITY_LOW);
-
-    BLI_task_pool_push(taskpool, convert_blender_collection_thread_func, &task, false, NULL);
-    BLI_task_pool_work_and_wait(taskpool);
-    BLI_task_pool_free(taskpool);
-    taskpool = nullptr;
-  }
-  else {
-    convert_blender_collection_synchronous(co);
+    std::vector<Object *> objectslist;
+    FOREACH_COLLECTION_OBJECT_RECURSIVE_BEGIN (co, obj) {
+      objectslist.push_back(obj);
+    }
+    FOREACH_COLLECTION_OBJECT_RECURSIVE_END;
+
+    return KX_GetActiveEngine()->GetConverter()->ConvertBlenderObjectsAsync(
+        this, objectslist, co->id.name + 2);
   }
+
+  convert_blender_collection_synchronous(co);
+  return nullptr;
 }
 
 void KX_Scene::ConvertBlenderAction(bAction *action)
@@ -1200,6 +1637,11 @@ void KX_Scene::AddObjToLodObjList(KX_GameObject *gameobj)
 
 void KX_Scene::RemoveObjFromLodObjList(KX_GameObject *gameobj)
 {
+  // The list was already compacted at the end of the removal batch.
+  if (m_batchedRemoval && m_batchRemovedObjects.count(gameobj)) {
+    return;
+  }
+
   std::vector<KX_GameObject *>::iterator it = std::find(
       m_kxobWithLod.begin(), m_kxobWithLod.end(), gameobj);
   if (it != m_kxobWithLod.end()) {
@@ -1227,52 +1669,251 @@ void KX_Scene::TagForCollectionRemap()
   m_collectionRemap = true;
 }
 
-KX_GameObject *KX_Scene::GetGameObjectFromObject(Object *ob)
+void KX_Scene::TagForLayerCollectionSync()
 {
-  return m_sceneConverter->FindGameObject(ob);
+  m_layerCollectionSync = true;
 }
 
-void KX_Scene::BackupObjectsObmat(BackupObj *backup)
+void KX_Scene::TagForRelationsUpdate()
 {
-  m_backupObList.push_back(backup);
+  m_relationsUpdate = true;
 }
 
-void KX_Scene::RestoreObjectsObmat()
+void KX_Scene::FlushStructureUpdates(Main *bmain)
 {
-  for (BackupObj *backup : m_backupObList) {
-    BKE_object_tfm_restore(backup->ob, backup->obtfm);
+  if (m_collectionRemap) {
+    // Synchronize all the view layers and remap the collections.
+    BKE_main_collection_sync_remap(bmain);
+    m_collectionRemap = false;
+    m_layerCollectionSync = false;
   }
-}
 
-bool KX_Scene::OrigObCanBeTransformedInRealtime(Object *ob)
-{
-  FluidModifierData *fluidModifierData = (FluidModifierData *)BKE_modifiers_findby_type(
-      ob, eModifierType_Fluid);
-  if (fluidModifierData) {
-    return false;
+  if (m_layerCollectionSync) {
+    Scene *scene = GetBlenderScene();
+    BKE_layer_collection_sync(scene, BKE_view_layer_default_view(scene));
+    DEG_id_tag_update(&scene->id, ID_RECALC_BASE_FLAGS);
+    m_layerCollectionSync = false;
+  }
+
+  if (m_relationsUpdate) {
+    DEG_relations_tag_update(bmain);
+    m_relationsUpdate = false;
   }
-  return true;
 }
 
-/* Look at object_transform for original function */
-void KX_Scene::IgnoreParentTxBGE(Main *bmain,
-                                 Depsgraph *depsgraph,
-                                 Object *ob,
-                                 std::vector<Object *> children)
+Object *KX_Scene::PopReplicaObject(Object *ob)
 {
-  Object workob;
-  Object *ob_child;
+  std::map<Object *, std::vector<Object *>>::iterator it = m_replicaPool.find(ob);
+  if (it == m_replicaPool.end() || it->second.empty()) {
+    return nullptr;
+  }
 
-  Scene *scene_eval = DEG_get_evaluated_scene(depsgraph);
+  Object *replica = it->second.back();
+  it->second.pop_back();
 
-  /* a change was made, adjust the children to compensate */
-  for (Object *child : children) {
-    if (child->parent == ob) {
-      ob_child = child;
-      Object *ob_child_eval = DEG_get_evaluated_object(depsgraph, ob_child);
-      BKE_object_apply_mat4(ob_child_eval, ob_child_eval->obmat, true, false);
-      BKE_object_workob_calc_parent(depsgraph, GetBlenderScene(), ob_child_eval, &workob);
-      invert_m4_m4(ob_child->parentinv, workob.obmat);
+  Scene *scene = GetBlenderScene();
+  ViewLayer *view_layer = BKE_view_layer_default_view(scene);
+  Base *base = BKE_view_layer_base_find(view_layer, replica);
+  if (base) {
+    base->flag &= ~BASE_HIDDEN;
+    TagForLayerCollectionSync();
+  }
+  DEG_id_tag_update(&replica->id, ID_RECALC_TRANSFORM);
+
+  return replica;
+}
+
+bool KX_Scene::PushReplicaObject(Object *ob, Object *replica)
+{
+  Scene *scene = GetBlenderScene();
+  ViewLayer *view_layer = BKE_view_layer_default_view(scene);
+  Base *base = BKE_view_layer_base_find(view_layer, replica);
+  // The collections were not synchronized since the replication.
+  if (!base) {
+    return false;
+  }
+
+  base->flag |= BASE_HIDDEN;
+  TagForLayerCollectionSync();
+
+  m_replicaPool[ob].push_back(replica);
+
+  return true;
+}
+
+void KX_Scene::FreeReplicaPool()
+{
+  if (m_replicaPool.empty()) {
+    return;
+  }
+
+  Main *bmain = CTX_data_main(KX_GetActiveEngine()->GetContext());
+  for (const std::pair<Object *const, std::vector<Object *>> &pair : m_replicaPool) {
+    for (Object *replica : pair.second) {
+      BKE_id_delete(bmain, replica);
+    }
+  }
+  m_replicaPool.clear();
+
+  TagForRelationsUpdate();
+}
+
+bool KX_Scene::IsInstancedReplication() const
+{
+  return m_instancedReplication;
+}
+
+void KX_Scene::AddInstanceObject(KX_GameObject *gameobj)
+{
+  Object *ob = gameobj->GetBlenderObject();
+  InstanceGroup &group = m_instanceGroups[ob];
+
+  if (!group.m_instancer) {
+    Main *bmain = CTX_data_main(KX_GetActiveEngine()->GetContext());
+    Object *instancer = BKE_object_add_only_object(bmain, OB_EMPTY, ob->id.name + 2);
+    id_us_min(&instancer->id);
+    Scene *scene = GetBlenderScene();
+    ViewLayer *view_layer = BKE_view_layer_default_view(scene);
+    BKE_collection_object_add_from(bmain,
+                                   scene,
+                                   BKE_view_layer_camera_find(view_layer),
+                                   instancer);  // add instancer where is the active camera
+    instancer->base_flag |= (BASE_VISIBLE_VIEWLAYER | BASE_VISIBLE_DEPSGRAPH);
+    instancer->visibility_flag &= ~OB_HIDE_VIEWPORT;
+    instancer->transflag |= OB_DUPLIGAME;
+    instancer->runtime.game_instance_object = ob;
+
+    group.m_instancer = instancer;
+    TagForCollectionRemap();
+    TagForRelationsUpdate();
+  }
+
+  group.m_objects.push_back(gameobj);
+  group.m_dirty = true;
+}
+
+void KX_Scene::RemoveInstanceObject(KX_GameObject *gameobj)
+{
+  std::map<Object *, InstanceGroup>::iterator it = m_instanceGroups.find(
+      gameobj->GetBlenderObject());
+  if (it == m_instanceGroups.end()) {
+    return;
+  }
+
+  // The instancer is kept for the next instances, an empty group doesn't change the relations.
+  InstanceGroup &group = it->second;
+  CM_ListRemoveIfFound(group.m_objects, gameobj);
+  group.m_dirty = true;
+}
+
+void KX_Scene::TagInstanceGroupUpdate(KX_GameObject *gameobj)
+{
+  std::map<Object *, InstanceGroup>::iterator it = m_instanceGroups.find(
+      gameobj->GetBlenderObject());
+  if (it != m_instanceGroups.end()) {
+    it->second.m_dirty = true;
+  }
+}
+
+bool KX_Scene::UpdateInstanceGroups()
+{
+  bool updated = false;
+  for (std::pair<Object *const, InstanceGroup> &pair : m_instanceGroups) {
+    InstanceGroup &group = pair.second;
+    if (!group.m_dirty) {
+      continue;
+    }
+
+    group.m_matrices.clear();
+    for (KX_GameObject *gameobj : group.m_objects) {
+      if (gameobj->GetVisible()) {
+        float obmat[16];
+        gameobj->NodeGetWorldTransform().getValue(obmat);
+        group.m_matrices.insert(group.m_matrices.end(), obmat, obmat + 16);
+      }
+    }
+
+    // The duplis are generated from these matrices at each draw.
+    Object *instancer = group.m_instancer;
+    instancer->runtime.game_instance_matrices = group.m_matrices.data();
+    instancer->runtime.game_instance_count = group.m_matrices.size() / 16;
+
+    group.m_dirty = false;
+    updated = true;
+  }
+
+  return updated;
+}
+
+void KX_Scene::FreeEmptyInstanceGroups()
+{
+  Main *bmain = CTX_data_main(KX_GetActiveEngine()->GetContext());
+  for (std::map<Object *, InstanceGroup>::iterator it = m_instanceGroups.begin();
+       it != m_instanceGroups.end();) {
+    if (!it->second.m_objects.empty()) {
+      ++it;
+      continue;
+    }
+
+    BKE_id_delete(bmain, it->second.m_instancer);
+    it = m_instanceGroups.erase(it);
+    TagForRelationsUpdate();
+  }
+}
+
+KX_GameObject *KX_Scene::GetGameObjectFromObject(Object *ob)
+{
+  return m_sceneConverter->FindGameObject(ob);
+}
+
+void KX_Scene::BackupObjectsObmat(BackupObj *backup)
+{
+  m_backupObList.push_back(backup);
+}
+
+void KX_Scene::RestoreObjectsObmat()
+{
+  for (BackupObj *backup : m_backupObList) {
+    BKE_object_tfm_restore(backup->ob, backup->obtfm);
+  }
+}
+
+bool KX_Scene::OrigObCanBeTransformedInRealtime(Object *ob)
+{
+  FluidModifierData *fluidModifierData = (FluidModifierData *)BKE_modifiers_findby_type(
+      ob, eModifierType_Fluid);
+  if (fluidModifierData) {
+    return false;
+  }
+  return true;
+}
+
+/* Look at object_transform for original function */
+void KX_Scene::IgnoreParentTxBGE(Main *bmain,
+                                 Depsgraph *depsgraph,
+                                 Object *ob,
+                                 const NodeList &children)
+{
+  Object workob;
+
+  Scene *scene_eval = DEG_get_evaluated_scene(depsgraph);
+
+  /* a change was made, adjust the children to compensate */
+  for (SG_Node *childnode : children) {
+    KX_GameObject *childobj = static_cast<KX_GameObject *>(childnode->GetSGClientObject());
+    /* if the childobj is nullptr then this may be an inverse parent link
+     * so look down this node as KX_GameObject::GetChildren does. */
+    if (!childobj) {
+      IgnoreParentTxBGE(bmain, depsgraph, ob, childnode->GetSGChildren());
+      continue;
+    }
+
+    Object *ob_child = childobj->GetBlenderObject();
+    if (ob_child && ob_child->parent == ob) {
+      Object *ob_child_eval = DEG_get_evaluated_object(depsgraph, ob_child);
+      BKE_object_apply_mat4(ob_child_eval, ob_child_eval->obmat, true, false);
+      BKE_object_workob_calc_parent(depsgraph, GetBlenderScene(), ob_child_eval, &workob);
+      invert_m4_m4(ob_child->parentinv, workob.obmat);
       /* Copy result of BKE_object_apply_mat4(). */
       BKE_object_transform_copy(ob_child, ob_child_eval);
       /* Make sure evaluated object is in a consistent state with the original one.
@@ -1286,10 +1927,21 @@ void KX_Scene::IgnoreParentTxBGE(Main *bmain,
         continue;
       }
       DEG_id_tag_update(&ob_child->id, ID_RECALC_TRANSFORM);
+      AddDynamicObject(ob_child);
     }
   }
 }
 
+void KX_Scene::AddDynamicObject(Object *ob)
+{
+  BLI_gset_add(m_dynamicObjects, ob);
+}
+
+void KX_Scene::RemoveDynamicObject(Object *ob)
+{
+  BLI_gset_remove(m_dynamicObjects, ob, nullptr);
+}
+
 void KX_Scene::TagForObmatRestore()
 {
   for (BackupObj *backup : m_backupObList) {
@@ -1340,73 +1992,114 @@ bool KX_Scene::SomethingIsMoving()
   return false;
 }
 
-void KX_Scene::AppendToExtraObjectsToUpdateInAllRenderPasses(Object *ob, IDRecalcFlag flag)
+void KX_Scene::AppendToExtraObjectsToUpdateInAllRenderPasses(Object *ob,
+                                                              IDRecalcFlag flag,
+                                                              KX_GameObject *gameobj)
 {
-  std::pair<Object *, IDRecalcFlag> it = {ob, flag};
-  if (std::find(m_extraObjectsToUpdateInAllRenderPasses.begin(),
-                m_extraObjectsToUpdateInAllRenderPasses.end(),
-                it) == m_extraObjectsToUpdateInAllRenderPasses.end()) {
-    m_extraObjectsToUpdateInAllRenderPasses.push_back(it);
+  // The objects updated in all the render passes are changed by the game.
+  AddDynamicObject(ob);
+
+  m_extraObjectsToUpdateInAllRenderPasses.Add(ob, flag);
+
+  if (gameobj && (flag & ID_RECALC_GEOMETRY)) {
+    m_deferrableGeometryObjects.emplace(ob, std::make_pair(gameobj, false));
   }
 }
 
 void KX_Scene::AppendToMeshesToUpdateInAllRenderPasses(Mesh *me, IDRecalcFlag flag)
 {
-  std::pair<Mesh *, IDRecalcFlag> it = {me, flag};
-  if (std::find(m_meshesToUpdateInAllRenderPasses.begin(),
-                m_meshesToUpdateInAllRenderPasses.end(),
-                it) == m_meshesToUpdateInAllRenderPasses.end()) {
-    m_meshesToUpdateInAllRenderPasses.push_back(it);
-  }
+  m_meshesToUpdateInAllRenderPasses.Add(me, flag);
 }
 
 void KX_Scene::AppendToNodeTreesToUpdateInAllRenderPasses(bNodeTree *ntree)
 {
-  if (std::find(m_nodeTreesToUpdateInAllRenderPasses.begin(),
-                m_nodeTreesToUpdateInAllRenderPasses.end(),
-                ntree) == m_nodeTreesToUpdateInAllRenderPasses.end()) {
-    m_nodeTreesToUpdateInAllRenderPasses.push_back(ntree);
-  }
+  m_nodeTreesToUpdateInAllRenderPasses.Add(ntree, (IDRecalcFlag)0);
 }
 
 void KX_Scene::AppendToExtraObjectsToUpdateInOverlayPass(Object *ob, IDRecalcFlag flag)
 {
-  std::pair<Object *, IDRecalcFlag> it = {ob, flag};
-  if (std::find(m_extraObjectsToUpdateInOverlayPass.begin(),
-                m_extraObjectsToUpdateInOverlayPass.end(),
-                it) == m_extraObjectsToUpdateInOverlayPass.end()) {
-    m_extraObjectsToUpdateInOverlayPass.push_back(it);
+  m_extraObjectsToUpdateInOverlayPass.Add(ob, flag);
+}
+
+/// Test if an object is drawn by one of the cameras, from its bounds of the last culling.
+static bool object_inside_views(KX_GameObject *gameobj, const std::vector<KX_Camera *> &cameras)
+{
+  if (!gameobj->GetVisible()) {
+    return false;
   }
+
+  const SG_BBox &aabb = gameobj->GetCullingNode().GetAabb();
+  const MT_Matrix4x4 mat(gameobj->NodeGetWorldTransform());
+  for (KX_Camera *cam : cameras) {
+    if (cam->GetFrustum().AabbInsideFrustum(aabb.GetMin(), aabb.GetMax(), mat) !=
+        SG_Frustum::OUTSIDE) {
+      return true;
+    }
+  }
+  return false;
 }
 
-void KX_Scene::TagForExtraObjectsUpdate(Main *bmain, KX_Camera *cam)
+void KX_Scene::TagForExtraObjectsUpdate(Main *bmain,
+                                        KX_Camera *cam,
+                                        const std::vector<RenderView> &views)
 {
-  for (std::vector<std::pair<Object *, IDRecalcFlag>>::iterator it =
-           m_extraObjectsToUpdateInAllRenderPasses.begin();
-       it != m_extraObjectsToUpdateInAllRenderPasses.end();
-       it++) {
-    DEG_id_tag_update(&it->first->id, it->second);
+  /* The geometry updates of the objects outside the views are held back, the culled objects are
+   * not drawn, nor their shadows. The overlay pass doesn't draw the objects updated here. */
+  const bool deferGeometry = cam && m_dbvt_culling && !m_deferrableGeometryObjects.empty() &&
+                             KX_GetActiveEngine()->GetFlag(KX_KetsjiEngine::DEFERRED_GEOMETRY);
+  const bool overlayPass = cam && cam == GetOverlayCamera();
+  std::vector<KX_Camera *> cameras;
+  if (deferGeometry && !overlayPass) {
+    if (views.empty()) {
+      cameras.push_back(cam);
+    }
+    for (const RenderView &view : views) {
+      cameras.push_back(view.m_camera);
+    }
   }
 
-  for (std::vector<std::pair<Mesh *, IDRecalcFlag>>::iterator it =
-           m_meshesToUpdateInAllRenderPasses.begin();
-       it != m_meshesToUpdateInAllRenderPasses.end();
-       it++) {
-    DEG_id_tag_update(&it->first->id, it->second);
+  for (const std::pair<Object *, IDRecalcFlag> &pair : m_extraObjectsToUpdateInAllRenderPasses) {
+    int flag = pair.second;
+    if (deferGeometry && (flag & ID_RECALC_GEOMETRY)) {
+      const auto it = m_deferrableGeometryObjects.find(pair.first);
+      if (it != m_deferrableGeometryObjects.end() && it->second.first->UseCulling() &&
+          (overlayPass || !object_inside_views(it->second.first, cameras))) {
+        it->second.second = true;
+        flag &= ~ID_RECALC_GEOMETRY;
+        if (flag == 0) {
+          continue;
+        }
+      }
+    }
+    DEG_id_tag_update(&pair.first->id, flag);
+  }
+
+  // Flush the held back updates of the objects now visible, or of all without deferring.
+  if (!overlayPass) {
+    for (std::pair<Object *const, std::pair<KX_GameObject *, bool>> &pair :
+         m_deferrableGeometryObjects) {
+      if (pair.second.second &&
+          (!deferGeometry || !pair.second.first->UseCulling() ||
+           object_inside_views(pair.second.first, cameras))) {
+        DEG_id_tag_update(&pair.first->id, ID_RECALC_GEOMETRY);
+        pair.second.second = false;
+      }
+    }
+  }
+
+  for (const std::pair<Mesh *, IDRecalcFlag> &pair : m_meshesToUpdateInAllRenderPasses) {
+    DEG_id_tag_update(&pair.first->id, pair.second);
   }
 
-  for (bNodeTree *ntree : m_nodeTreesToUpdateInAllRenderPasses) {
-    ED_node_tag_update_nodetree(bmain, ntree, nullptr);
+  for (const std::pair<bNodeTree *, IDRecalcFlag> &pair : m_nodeTreesToUpdateInAllRenderPasses) {
+    ED_node_tag_update_nodetree(bmain, pair.first, nullptr);
   }
 
   if (cam && cam == GetOverlayCamera()) {
-    for (std::vector<std::pair<Object *, IDRecalcFlag>>::iterator it =
-             m_extraObjectsToUpdateInOverlayPass.begin();
-         it != m_extraObjectsToUpdateInOverlayPass.end();
-         it++) {
-      DEG_id_tag_update(&it->first->id, it->second);
+    for (const std::pair<Object *, IDRecalcFlag> &pair : m_extraObjectsToUpdateInOverlayPass) {
+      DEG_id_tag_update(&pair.first->id, pair.second);
     }
-    m_extraObjectsToUpdateInOverlayPass.clear();
+    m_extraObjectsToUpdateInOverlayPass.Clear();
   }
 }
 
@@ -1442,14 +2135,10 @@ KX_GameObject *KX_Scene::AddDuplicaObject(KX_GameObject *gameobj,
       // add a timebomb to this object
       // lifespan of zero means 'this object lives forever'
       if (lifespan > 0.0f) {
-        // for now, convert between so called frames and realtime
-        m_tempObjectList.push_back(replica);
         // this convert the life from frames to sort-of seconds, hard coded 0.02 that assumes we
         // have 50 frames per second if you change this value, make sure you change it in
         // KX_GameObject::pyattr_get_life property too
-        EXP_Value *fval = new EXP_FloatValue(lifespan * 0.02f);
-        replica->SetProperty("::timebomb", fval);
-        fval->Release();
+        AddTimeBomb(replica, lifespan * 0.02f);
       }
 
       if (reference) {
@@ -1534,6 +2223,14 @@ KX_PythonProxyManager &KX_Scene::GetPythonProxyManager()
   return m_proxyManager;
 }
 
+void KX_Scene::AddTask(KX_TaskFuture *task)
+{
+#ifdef WITH_PYTHON
+  task->AddRef();
+  m_tasks.push_back(task);
+#endif  // WITH_PYTHON
+}
+
 EXP_ListValue<KX_Camera> *KX_Scene::GetCameraList() const
 {
   return m_cameralist;
@@ -1568,6 +2265,20 @@ const RAS_FrameSettings &KX_Scene::GetFramingType() const
 void KX_Scene::SetActivityCulling(bool b)
 {
   m_activityCulling = b;
+  m_activityCullingGrid.Invalidate();
+}
+
+void KX_Scene::InvalidateActivityCulling()
+{
+  m_activityCullingGrid.Invalidate();
+}
+
+void KX_Scene::ActivityCullingObjectMoved(KX_GameObject *gameobj)
+{
+  if (m_activityCulling && gameobj->GetActivityCullingInfo().m_flags !=
+                               KX_GameObject::ActivityCullingInfo::ACTIVITY_NONE) {
+    m_activityCullingGrid.TagMovedObject(gameobj);
+  }
 }
 
 void KX_Scene::AddObjectDebugProperties(class KX_GameObject *gameobj)
@@ -1591,6 +2302,15 @@ void KX_Scene::AddObjectDebugProperties(class KX_GameObject *gameobj)
 
 void KX_Scene::RemoveNodeDestructObject(SG_Node *node, KX_GameObject *gameobj)
 {
+  if (m_batchedRemoval) {
+    // The object is still referenced by the lists until the end of the batch.
+    NewRemoveObject(gameobj);
+    if (node) {
+      m_batchRemovedNodes.push_back(node);
+    }
+    return;
+  }
+
   if (NewRemoveObject(gameobj)) {
     // object is not yet deleted because a reference is hanging somewhere.
     // This should not happen anymore since we use proxy object for Python.
@@ -1678,6 +2398,7 @@ KX_GameObject *KX_Scene::AddNodeReplicaObject(SG_Node *node, KX_GameObject *game
 
   // logic cannot be replicated, until the whole hierarchy is replicated.
   m_logicHierarchicalGameObjects.push_back(newobj);
+  m_logicHierarchicalOriginals.push_back(gameobj);
   // replicate controllers of this node
   SGControllerList scenegraphcontrollers = gameobj->GetSGNode()->GetSGControllerList();
   replicanode->RemoveAllControllers();
@@ -1710,9 +2431,43 @@ KX_GameObject *KX_Scene::AddNodeReplicaObject(SG_Node *node, KX_GameObject *game
       newctrl->SuspendDynamics();
   }
 
+  // replicate graphic controller, the instances are drawn from their original object
+  if (gameobj->GetGraphicController() && !newobj->IsInstance()) {
+    PHY_IMotionState *motionstate = new KX_MotionState(newobj->GetSGNode());
+    PHY_IGraphicController *newctrl = gameobj->GetGraphicController()->GetReplica(motionstate);
+    newctrl->SetNewClientInfo(newobj->getClientInfo());
+    newobj->SetGraphicController(newctrl);
+    // The bounds are set at the next render, once the replica is positioned.
+    newobj->ActivateGraphicController(true);
+  }
+
   return newobj;
 }
 
+/** Return the position of a linked brick in the brick list of its owner. The position stored
+ * in the template for this link is used if it still designates the brick, else it is searched
+ * and stored for the next replications.
+ */
+template<class Brick>
+static unsigned int get_linked_brick_position(std::vector<unsigned int> &positions,
+                                              unsigned int link,
+                                              Brick *brick,
+                                              const std::vector<Brick *> &bricks)
+{
+  if (link < positions.size() && positions[link] < bricks.size() &&
+      bricks[positions[link]] == brick) {
+    return positions[link];
+  }
+
+  const unsigned int position = std::find(bricks.begin(), bricks.end(), brick) - bricks.begin();
+  if (link >= positions.size()) {
+    positions.resize(link + 1);
+  }
+  positions[link] = position;
+
+  return position;
+}
+
 // before calling this method KX_Scene::ReplicateLogic(), make sure to
 // have called 'GameObject::ReParentLogic' for each object this
 // hierarchy that's because first ALL bricks must exist in the new
@@ -1723,7 +2478,7 @@ KX_GameObject *KX_Scene::AddNodeReplicaObject(SG_Node *node, KX_GameObject *game
 // This method is more robust then using the bricks name in case of complex
 // group replication. The replication of logic bricks is done in
 // SCA_IObject::ReParentLogic(), make sure it preserves the order of the bricks.
-void KX_Scene::ReplicateLogic(KX_GameObject *newobj)
+void KX_Scene::ReplicateLogic(KX_GameObject *newobj, KX_GameObject *orgobj)
 {
   /* add properties to debug list, for added objects and DupliGroups */
   if (KX_GetActiveEngine()->GetFlag(KX_KetsjiEngine::AUTO_ADD_DEBUG_PROPERTIES)) {
@@ -1734,7 +2489,15 @@ void KX_Scene::ReplicateLogic(KX_GameObject *newobj)
   // SCA_SensorList&     sensors     = newobj->GetSensors();
   // SCA_ActuatorList&   actuators   = newobj->GetActuators();
 
-  for (SCA_IController *cont : controllers) {
+  // The controllers of the replica are in the same order as the ones of the original object.
+  LogicLinkTemplate &linkTemplate = m_logicLinkTemplates[orgobj];
+  if (linkTemplate.m_sensors.size() < controllers.size()) {
+    linkTemplate.m_sensors.resize(controllers.size());
+    linkTemplate.m_actuators.resize(controllers.size());
+  }
+
+  for (unsigned int i = 0, size = controllers.size(); i < size; ++i) {
+    SCA_IController *cont = controllers[i];
     cont->SetUeberExecutePriority(m_ueberExecutionPriority);
     const SCA_SensorList linkedsensors = cont->GetLinkedSensors();
     const SCA_ActuatorList linkedactuators = cont->GetLinkedActuators();
@@ -1745,7 +2508,8 @@ void KX_Scene::ReplicateLogic(KX_GameObject *newobj)
     cont->GetLinkedActuators().clear();
 
     // now relink each sensor
-    for (SCA_ISensor *oldsensor : linkedsensors) {
+    for (unsigned int j = 0, numsensors = linkedsensors.size(); j < numsensors; ++j) {
+      SCA_ISensor *oldsensor = linkedsensors[j];
       SCA_IObject *oldsensorobj = oldsensor->GetParent();
       // the original owner of the sensor has been replicated?
       SCA_IObject *newsensorobj = m_map_gameobject_to_replica[oldsensorobj];
@@ -1758,25 +2522,17 @@ void KX_Scene::ReplicateLogic(KX_GameObject *newobj)
       }
       else {
         // yes, then the new sensor has the same position
-        SCA_SensorList &sensorlist = oldsensorobj->GetSensors();
-        SCA_SensorList::iterator sit;
-        SCA_ISensor *newsensor = nullptr;
-        int sensorpos;
-
-        for (sensorpos = 0, sit = sensorlist.begin(); sit != sensorlist.end();
-             sit++, sensorpos++) {
-          if ((*sit) == oldsensor) {
-            newsensor = newsensorobj->GetSensors().at(sensorpos);
-            break;
-          }
-        }
+        const unsigned int sensorpos = get_linked_brick_position(
+            linkTemplate.m_sensors[i], j, oldsensor, oldsensorobj->GetSensors());
+        SCA_ISensor *newsensor = newsensorobj->GetSensors().at(sensorpos);
         BLI_assert(newsensor != nullptr);
         m_logicmgr->RegisterToSensor(cont, newsensor);
       }
     }
 
     // now relink each actuator
-    for (SCA_IActuator *oldactuator : linkedactuators) {
+    for (unsigned int j = 0, numactuators = linkedactuators.size(); j < numactuators; ++j) {
+      SCA_IActuator *oldactuator = linkedactuators[j];
       SCA_IObject *oldactuatorobj = oldactuator->GetParent();
       SCA_IObject *newactuatorobj = m_map_gameobject_to_replica[oldactuatorobj];
 
@@ -1788,18 +2544,9 @@ void KX_Scene::ReplicateLogic(KX_GameObject *newobj)
       }
       else {
         // yes, then the new sensor has the same position
-        SCA_ActuatorList &actuatorlist = oldactuatorobj->GetActuators();
-        SCA_ActuatorList::iterator ait;
-        SCA_IActuator *newactuator = nullptr;
-        int actuatorpos;
-
-        for (actuatorpos = 0, ait = actuatorlist.begin(); ait != actuatorlist.end();
-             ait++, actuatorpos++) {
-          if ((*ait) == oldactuator) {
-            newactuator = newactuatorobj->GetActuators().at(actuatorpos);
-            break;
-          }
-        }
+        const unsigned int actuatorpos = get_linked_brick_position(
+            linkTemplate.m_actuators[i], j, oldactuator, oldactuatorobj->GetActuators());
+        SCA_IActuator *newactuator = newactuatorobj->GetActuators().at(actuatorpos);
         BLI_assert(newactuator != nullptr);
         m_logicmgr->RegisterToActuator(cont, newactuator);
         newactuator->SetUeberExecutePriority(m_ueberExecutionPriority);
@@ -1810,6 +2557,20 @@ void KX_Scene::ReplicateLogic(KX_GameObject *newobj)
   newobj->ResetState();
 }
 
+/** Return true if a collection member is never moved or changed by itself, its replicas can
+ * then be drawn as instances of its blender object, see KX_KetsjiEngine::INSTANCED_COLLECTIONS.
+ */
+static bool IsStaticGroupMember(KX_GameObject *gameobj)
+{
+  if (!gameobj->GetSensors().empty() || !gameobj->GetControllers().empty() ||
+      !gameobj->GetActuators().empty() || gameobj->GetComponents()) {
+    return false;
+  }
+
+  Object *ob = gameobj->GetBlenderObject();
+  return (!gameobj->IsDynamic() && !(ob && ob->adt));
+}
+
 void KX_Scene::DupliGroupRecurse(KX_GameObject *groupobj, int level)
 {
   Object *blgroupobj = groupobj->GetBlenderObject();
@@ -1818,8 +2579,15 @@ void KX_Scene::DupliGroupRecurse(KX_GameObject *groupobj, int level)
   if (!groupobj->GetSGNode() || !groupobj->IsDupliGroup() || level > MAX_DUPLI_RECUR)
     return;
 
+  /* The members of a collection added with an instanced replication are all instances,
+   * else only the static members are instances when the collections are instanced. */
+  const bool instancedReplication = m_instancedReplication;
+  const bool instancedCollections = KX_GetActiveEngine()->GetFlag(
+      KX_KetsjiEngine::INSTANCED_COLLECTIONS);
+
   // we will add one group at a time
   m_logicHierarchicalGameObjects.clear();
+  m_logicHierarchicalOriginals.clear();
   m_map_gameobject_to_replica.clear();
   m_ueberExecutionPriority++;
   // for groups will do something special:
@@ -1872,7 +2640,10 @@ void KX_Scene::DupliGroupRecurse(KX_GameObject *groupobj, int level)
       // is inconsistent, skip it anyway
       continue;
     }
+    m_instancedReplication = instancedReplication ||
+                             (instancedCollections && IsStaticGroupMember(gameobj));
     KX_GameObject *replica = (KX_GameObject *)AddNodeReplicaObject(nullptr, gameobj);
+    m_instancedReplication = instancedReplication;
     // add to 'rootparent' list (this is the list of top hierarchy objects, updated each frame)
     m_parentlist->Add(CM_AddRef(replica));
 
@@ -1915,6 +2686,7 @@ void KX_Scene::DupliGroupRecurse(KX_GameObject *groupobj, int level)
   // the new logic bricks before relinking
   for (KX_GameObject *gameobj : m_logicHierarchicalGameObjects) {
     gameobj->ReParentLogic();
+    gameobj->ConvertMeshGeometry();
   }
 
   //	relink any pointers as necessary, sort of a temporary solution
@@ -1926,8 +2698,8 @@ void KX_Scene::DupliGroupRecurse(KX_GameObject *groupobj, int level)
   }
 
   // replicate crosslinks etc. between logic bricks
-  for (KX_GameObject *gameobj : m_logicHierarchicalGameObjects) {
-    ReplicateLogic(gameobj);
+  for (unsigned int i = 0, size = m_logicHierarchicalGameObjects.size(); i < size; ++i) {
+    ReplicateLogic(m_logicHierarchicalGameObjects[i], m_logicHierarchicalOriginals[i]);
   }
 
   // now look if object in the hierarchy have dupli group and recurse
@@ -1970,6 +2742,7 @@ KX_GameObject *KX_Scene::AddReplicaObject(KX_GameObject *originalobject,
                                           float lifespan)
 {
   m_logicHierarchicalGameObjects.clear();
+  m_logicHierarchicalOriginals.clear();
   m_map_gameobject_to_replica.clear();
   m_groupGameObjects.clear();
 
@@ -1981,17 +2754,18 @@ KX_GameObject *KX_Scene::AddReplicaObject(KX_GameObject *originalobject,
   // lets create a replica
   KX_GameObject *replica = (KX_GameObject *)AddNodeReplicaObject(nullptr, originalobj);
 
+  // The replicas share the meshes of the inactive objects, convert their deferred geometry.
+  for (KX_GameObject *gameobj : m_logicHierarchicalGameObjects) {
+    gameobj->ConvertMeshGeometry();
+  }
+
   // add a timebomb to this object
   // lifespan of zero means 'this object lives forever'
   if (lifespan > 0.0f) {
-    // for now, convert between so called frames and realtime
-    m_tempObjectList.push_back(replica);
     // this convert the life from frames to sort-of seconds, hard coded 0.02 that assumes we have
     // 50 frames per second if you change this value, make sure you change it in
     // KX_GameObject::pyattr_get_life property too
-    EXP_Value *fval = new EXP_FloatValue(lifespan * 0.02f);
-    replica->SetProperty("::timebomb", fval);
-    fval->Release();
+    AddTimeBomb(replica, lifespan * 0.02f);
   }
 
   // add to 'rootparent' list (this is the list of top hierarchy objects, updated each frame)
@@ -2045,8 +2819,8 @@ KX_GameObject *KX_Scene::AddReplicaObject(KX_GameObject *originalobject,
   }
 
   // replicate crosslinks etc. between logic bricks
-  for (KX_GameObject *gameobj : m_logicHierarchicalGameObjects) {
-    ReplicateLogic(gameobj);
+  for (unsigned int i = 0, size = m_logicHierarchicalGameObjects.size(); i < size; ++i) {
+    ReplicateLogic(m_logicHierarchicalGameObjects[i], m_logicHierarchicalOriginals[i]);
   }
 
   // check if there are objects with dupligroup in the hierarchy
@@ -2061,10 +2835,26 @@ KX_GameObject *KX_Scene::AddReplicaObject(KX_GameObject *originalobject,
     DupliGroupRecurse(gameobj, 0);
   }
 
+  KX_FrameStatistics &frameStatistics = KX_GetActiveEngine()->GetFrameStatistics();
+  if (frameStatistics.UseEvents()) {
+    frameStatistics.AddEvent("Spawn", originalobject->GetName());
+  }
+
   //	don't release replica here because we are returning it, not done with it...
   return replica;
 }
 
+KX_GameObject *KX_Scene::AddInstancedReplicaObject(KX_GameObject *gameobj,
+                                                   KX_GameObject *reference,
+                                                   float lifespan)
+{
+  m_instancedReplication = true;
+  KX_GameObject *replica = AddReplicaObject(gameobj, reference, lifespan);
+  m_instancedReplication = false;
+
+  return replica;
+}
+
 void KX_Scene::RemoveObject(KX_GameObject *gameobj)
 {
   // disconnect child from parent
@@ -2094,10 +2884,50 @@ void KX_Scene::DelayedRemoveObject(KX_GameObject *gameobj)
   CM_ListAddIfNotFound(m_euthanasyobjects, gameobj);
 }
 
+void KX_Scene::AddTimeBomb(KX_GameObject *gameobj, float lifespan)
+{
+  RemoveTimeBomb(gameobj);
+  m_timeBombTimers[gameobj] = m_timeBombs.Add(gameobj, lifespan);
+}
+
+void KX_Scene::RemoveTimeBomb(KX_GameObject *gameobj)
+{
+  const auto it = m_timeBombTimers.find(gameobj);
+  if (it != m_timeBombTimers.end()) {
+    m_timeBombs.Remove(it->second);
+    m_timeBombTimers.erase(it);
+  }
+}
+
+bool KX_Scene::GetTimeBombLife(KX_GameObject *gameobj, float &life) const
+{
+  const auto it = m_timeBombTimers.find(gameobj);
+  if (it == m_timeBombTimers.end()) {
+    return false;
+  }
+
+  life = m_timeBombs.GetRemaining(it->second);
+  return true;
+}
+
 bool KX_Scene::NewRemoveObject(KX_GameObject *gameobj)
 {
   gameobj->Dispose();
 
+  m_activityCullingGrid.RemoveObject(gameobj);
+  m_replicationManager.RemoveObject(gameobj);
+  m_logicLinkTemplates.erase(gameobj);
+  m_deferrableGeometryObjects.erase(gameobj->GetBlenderObject());
+  if (m_collisionEventManager) {
+    m_collisionEventManager->RemoveGameObject(gameobj);
+  }
+  // The object can outlive its removal through python references.
+  gameobj->ActivateGraphicController(false);
+
+  if (gameobj->IsInstance()) {
+    RemoveInstanceObject(gameobj);
+  }
+
   /* remove property from debug list */
   RemoveObjectDebugProperties(gameobj);
 
@@ -2163,10 +2993,25 @@ bool KX_Scene::NewRemoveObject(KX_GameObject *gameobj)
     m_obstacleSimulation->DestroyObstacleForObj(gameobj);
   }
 
-  m_proxyManager.Unregister(gameobj);
-
   gameobj->RemoveMeshes();
 
+  if (m_batchedRemoval) {
+    m_batchRemovedObjects.insert(gameobj);
+    RemoveTimeBomb(gameobj);
+
+    if (gameobj == m_active_camera) {
+      m_active_camera = nullptr;
+    }
+    if (gameobj == m_overrideCullingCamera) {
+      m_overrideCullingCamera = nullptr;
+    }
+
+    // The object is released by EndBatchedRemoval.
+    return false;
+  }
+
+  m_proxyManager.Unregister(gameobj);
+
   bool ret = true;
   if (m_lightlist->RemoveValue(gameobj)) {
     ret = (gameobj->Release() != nullptr);
@@ -2189,8 +3034,9 @@ bool KX_Scene::NewRemoveObject(KX_GameObject *gameobj)
 
   // WARNING: 'gameobj' maybe be freed now, only compare, don't access.
   CM_ListRemoveIfFound(m_animatedlist, gameobj);
+  CM_ListRemoveIfFound(m_transformUpdateObjects, gameobj);
   CM_ListRemoveIfFound(m_euthanasyobjects, gameobj);
-  CM_ListRemoveIfFound(m_tempObjectList, gameobj);
+  RemoveTimeBomb(gameobj);
 
   if (gameobj == m_active_camera) {
     // no AddRef done on m_active_camera so no Release
@@ -2207,6 +3053,78 @@ bool KX_Scene::NewRemoveObject(KX_GameObject *gameobj)
   return ret;
 }
 
+void KX_Scene::BeginBatchedRemoval()
+{
+  m_batchedRemoval = true;
+}
+
+void KX_Scene::EndBatchedRemoval()
+{
+  if (!m_batchRemovedObjects.empty()) {
+    const std::unordered_set<KX_GameObject *> &removedSet = m_batchRemovedObjects;
+    const auto isRemoved = [&removedSet](EXP_Value *val) {
+      return (removedSet.find(static_cast<KX_GameObject *>(val)) != removedSet.end());
+    };
+    const auto isRemovedObject = [&removedSet](KX_GameObject *gameobj) {
+      return (removedSet.find(gameobj) != removedSet.end());
+    };
+
+    m_proxyManager.Unregister(removedSet);
+
+    // Compact each list once, the references of the lists are released after.
+    std::vector<EXP_Value *> released;
+    m_lightlist->RemoveIf(isRemoved, released);
+    m_objectlist->RemoveIf(isRemoved, released);
+    m_parentlist->RemoveIf(isRemoved, released);
+    m_inactivelist->RemoveIf(isRemoved, released);
+    m_fontlist->RemoveIf(isRemoved, released);
+    m_cameralist->RemoveIf(isRemoved, released);
+
+    for (std::vector<KX_GameObject *> *list :
+         {&m_animatedlist, &m_transformUpdateObjects, &m_euthanasyobjects, &m_kxobWithLod}) {
+      list->erase(std::remove_if(list->begin(), list->end(), isRemovedObject), list->end());
+    }
+
+    for (EXP_Value *val : released) {
+      val->Release();
+    }
+
+    // The destructor of the objects still accesses their node.
+    for (SG_Node *node : m_batchRemovedNodes) {
+      delete node;
+    }
+
+    m_batchRemovedObjects.clear();
+    m_batchRemovedNodes.clear();
+  }
+
+  m_batchedRemoval = false;
+
+  if (!m_batchDeletedBlenderObjects.empty()) {
+    Main *bmain = CTX_data_main(KX_GetActiveEngine()->GetContext());
+    BKE_main_id_tag_all(bmain, LIB_TAG_DOIT, false);
+    for (Object *blenderobj : m_batchDeletedBlenderObjects) {
+      blenderobj->id.tag |= LIB_TAG_DOIT;
+    }
+    BKE_id_multi_tagged_delete(bmain);
+    m_batchDeletedBlenderObjects.clear();
+
+    TagForRelationsUpdate();
+  }
+}
+
+void KX_Scene::DeleteBlenderObject(Object *blenderobj)
+{
+  if (m_batchedRemoval) {
+    m_batchDeletedBlenderObjects.push_back(blenderobj);
+    return;
+  }
+
+  Main *bmain = CTX_data_main(KX_GetActiveEngine()->GetContext());
+  BKE_id_delete(bmain, blenderobj);
+  TagForRelationsUpdate();
+}
+
 void KX_Scene::ReplaceMesh(KX_GameObject *gameobj,
                            RAS_MeshObject *mesh,
                            bool use_gfx,
@@ -2221,7 +3139,20 @@ void KX_Scene::ReplaceMesh(KX_GameObject *gameobj,
     return;
   }
 
-  if (use_gfx) {
+  BL_ConvertMeshGeometry(mesh);
+
+  // The mesh is shared by all the instances of the blender object.
+  if (use_gfx && gameobj->IsInstance()) {
+    CM_FunctionWarning("the mesh of an instanced object can't be replaced, doing nothing");
+    use_gfx = false;
+  }
+
+  if (use_gfx) {
+    // The merged mesh of a batch keeps the previous geometry, the object is drawn on its own.
+    if (gameobj->IsBatched()) {
+      m_staticBatchManager->RemoveObject(gameobj);
+    }
+
     gameobj->RemoveMeshes();
     gameobj->AddMesh(mesh);
 
@@ -2242,8 +3173,18 @@ void KX_Scene::ReplaceMesh(KX_GameObject *gameobj,
       gameobj->GetPhysicsController()->ReinstancePhysicsShape(nullptr, mesh);
   }
 
-  if (use_gfx || use_phys) {
-    DEG_id_tag_update(&gameobj->GetBlenderObject()->id, ID_RECALC_GEOMETRY);
+  /* The rendered mesh is switched in UpdateLod to the evaluated mesh of the object the new
+   * mesh was converted from, which keeps its GPU batches. The object is only evaluated again
+   * when it has modifiers, the physics never need it. */
+  if (use_gfx) {
+    Object *ob = gameobj->GetBlenderObject();
+    if (BLI_listbase_is_empty(&ob->modifiers)) {
+      // The retained camera viewports are not invalidated by an evaluation.
+      m_drawUpdateCount++;
+    }
+    else {
+      DEG_id_tag_update(&ob->id, ID_RECALC_GEOMETRY);
+    }
   }
 }
 
@@ -2282,6 +3223,148 @@ void KX_Scene::PhysicsCullingCallback(KX_ClientObjectInfo *objectInfo, void *cul
     // ideally, invisible objects should be removed from the culling tree temporarily
     return;
   }
+
+  gameobj->GetCullingNode().SetCulled(false);
+}
+
+void KX_Scene::UpdateCullingBounds(Depsgraph *depsgraph)
+{
+  for (KX_GameObject *gameobj : m_transformUpdateObjects) {
+    PHY_IGraphicController *ctrl = gameobj->GetGraphicController();
+    if (!ctrl) {
+      continue;
+    }
+
+    // The evaluated bounds follow the mesh replacements and the modifiers.
+    Object *ob_eval = DEG_get_evaluated_object(depsgraph, gameobj->GetBlenderObject());
+    BoundBox *bb = BKE_object_boundbox_get(ob_eval);
+    if (bb) {
+      const MT_Vector3 min(bb->vec[0]);
+      const MT_Vector3 max(bb->vec[6]);
+      gameobj->GetCullingNode().GetAabb().Set(min, max);
+      // Also update the world bounds from the object transform.
+      ctrl->SetLocalAabb(min, max);
+    }
+    else {
+      ctrl->SetGraphicTransform();
+    }
+  }
+}
+
+void KX_Scene::CullObjects(KX_Camera *cam, const int *viewport)
+{
+  BLI_gset_clear(m_culledObjects, nullptr);
+
+  // The culling test only reports the objects inside the view.
+  for (KX_GameObject *gameobj : GetObjectList()) {
+    gameobj->GetCullingNode().SetCulled(gameobj->UseCulling());
+  }
+
+  const SG_Frustum &frustum = cam->GetFrustum();
+  if (!m_physicsEnvironment->CullingTest(PhysicsCullingCallback,
+                                         nullptr,
+                                         frustum.GetPlanes(),
+                                         m_dbvt_occlusion_res,
+                                         viewport,
+                                         frustum.GetMatrix())) {
+    return;
+  }
+
+  for (KX_GameObject *gameobj : GetObjectList()) {
+    if (gameobj->GetCullingNode().GetCulled()) {
+      BLI_gset_add(m_culledObjects, gameobj->GetBlenderObject());
+    }
+  }
+}
+
+void KX_Scene::CullObjectsMerge(KX_Camera *cam, const int *viewport)
+{
+  for (KX_GameObject *gameobj : GetObjectList()) {
+    gameobj->GetCullingNode().SetCulled(gameobj->UseCulling());
+  }
+
+  const SG_Frustum &frustum = cam->GetFrustum();
+  if (!m_physicsEnvironment->CullingTest(PhysicsCullingCallback,
+                                         nullptr,
+                                         frustum.GetPlanes(),
+                                         m_dbvt_occlusion_res,
+                                         viewport,
+                                         frustum.GetMatrix())) {
+    BLI_gset_clear(m_culledObjects, nullptr);
+    return;
+  }
+
+  // The culling state of the objects is then the one of all the views.
+  for (KX_GameObject *gameobj : GetObjectList()) {
+    SG_CullingNode &node = gameobj->GetCullingNode();
+    if (!node.GetCulled()) {
+      BLI_gset_remove(m_culledObjects, gameobj->GetBlenderObject(), nullptr);
+    }
+    else {
+      node.SetCulled(BLI_gset_haskey(m_culledObjects, gameobj->GetBlenderObject()));
+    }
+  }
+}
+
+void KX_Scene::ApplyHiZCulling(KX_Camera *cam)
+{
+  std::vector<bool> visibility;
+  if (!cam->m_hizCulling || !cam->m_hizCulling->ReadVisibility(visibility)) {
+    return;
+  }
+
+  /* The objects tested at the previous render are not referenced, a removed object only
+   * leaves an unused entry in the culled objects. */
+  for (unsigned int i = 0, size = visibility.size(); i < size; ++i) {
+    if (!visibility[i]) {
+      BLI_gset_add(m_culledObjects, cam->m_hizObjects[i]);
+    }
+  }
+}
+
+void KX_Scene::TestHiZCulling(KX_Camera *cam)
+{
+  // The max depth pyramid built by EEVEE after the depth prepass of the render.
+  EEVEE_Data *vedata = EEVEE_engine_data_get();
+  GPUTexture *maxzBuffer = vedata->txl->maxzbuffer;
+  if (!maxzBuffer) {
+    return;
+  }
+
+  cam->m_hizObjects.clear();
+  std::vector<float> bounds;
+
+  /* Test the objects inside the view, including the ones occluded at this render,
+   * they are drawn again at the next render if they are no longer occluded. */
+  for (KX_GameObject *gameobj : GetObjectList()) {
+    if (!gameobj->UseCulling() || gameobj->GetCullingNode().GetCulled() ||
+        !gameobj->GetVisible()) {
+      continue;
+    }
+
+    const SG_BBox &aabb = gameobj->GetCullingNode().GetAabb();
+    const MT_Transform trans = gameobj->NodeGetWorldTransform();
+    const MT_Vector3 center = trans(aabb.GetCenter());
+    const MT_Vector3 extent = trans.getBasis().absolute() * ((aabb.GetMax() - aabb.GetMin()) *
+                                                             0.5f);
+    const MT_Vector3 min = center - extent;
+    const MT_Vector3 max = center + extent;
+
+    bounds.insert(bounds.end(), {min.x(), min.y(), min.z(), 1.0f, max.x(), max.y(), max.z(), 1.0f});
+    cam->m_hizObjects.push_back(gameobj->GetBlenderObject());
+  }
+
+  if (!cam->m_hizCulling) {
+    cam->m_hizCulling = new RAS_HiZCulling();
+  }
+
+  GPUTexture *depth = GPU_viewport_depth_texture(m_currentGPUViewport);
+  cam->m_hizCulling->Test(bounds,
+                          cam->GetProjectionMatrix() * cam->GetModelviewMatrix(),
+                          maxzBuffer,
+                          GPU_texture_width(depth),
+                          GPU_texture_height(depth),
+                          MAX_SCREEN_BUFFERS_LOD_LEVEL);
 }
 
 void KX_Scene::RenderDebugProperties(RAS_DebugDraw &debugDraw,
@@ -2335,99 +3418,343 @@ void KX_Scene::RenderDebugProperties(RAS_DebugDraw &debugDraw,
   }
 }
 
-// logic stuff
-void KX_Scene::LogicBeginFrame(double curtime, double framestep)
+void KX_Scene::FillMemoryReport(KX_MemoryReport &report)
 {
-  // have a look at temp objects ...
-  for (KX_GameObject *gameobj : m_tempObjectList) {
-    EXP_FloatValue *propval = (EXP_FloatValue *)gameobj->GetProperty("::timebomb");
-
-    if (propval) {
-      const float timeleft = propval->GetNumber() - framestep;
-
-      if (timeleft > 0) {
-        propval->SetFloat(timeleft);
+  for (EXP_ListValue<KX_GameObject> *list : {m_objectlist, m_inactivelist}) {
+    for (KX_GameObject *gameobj : list) {
+      size_t objectSize;
+      switch (gameobj->GetGameObjectType()) {
+        case SCA_IObject::OBJ_CAMERA: {
+          objectSize = sizeof(KX_Camera);
+          break;
+        }
+        case SCA_IObject::OBJ_LIGHT: {
+          objectSize = sizeof(KX_LightObject);
+          break;
+        }
+        case SCA_IObject::OBJ_TEXT: {
+          objectSize = sizeof(KX_FontObject);
+          break;
+        }
+        default: {
+          objectSize = sizeof(KX_GameObject);
+          break;
+        }
       }
-      else {
-        // remove obj, remove the object from tempObjectList in NewRemoveObject only.
-        DelayedRemoveObject(gameobj);
+      report.Add(KX_MemoryReport::MEM_OBJECTS, 1, objectSize);
+
+      SG_Node *node = gameobj->GetSGNode();
+      if (node) {
+        report.Add(KX_MemoryReport::MEM_SCENE_GRAPH,
+                   1,
+                   sizeof(SG_Node) + node->GetSGChildren().capacity() * sizeof(SG_Node *));
       }
+
+      // The bricks are allocated as their complete type, one allocation per brick.
+      size_t numBricks = 0;
+      size_t brickBytes = 0;
+      const auto addBricks = [&numBricks, &brickBytes](const auto &bricks) {
+        for (SCA_ILogicBrick *brick : bricks) {
+          ++numBricks;
+          brickBytes += SCA_BrickArena::GetAllocationSize(dynamic_cast<void *>(brick));
+        }
+      };
+      addBricks(gameobj->GetSensors());
+      addBricks(gameobj->GetControllers());
+      addBricks(gameobj->GetActuators());
+      report.Add(KX_MemoryReport::MEM_LOGIC_BRICKS, numBricks, brickBytes);
     }
-    else {
-      // all object is the tempObjectList should have a clock
-      BLI_assert(false);
+  }
+
+  for (KX_Camera *cam : m_cameralist) {
+    if (cam->HasGPUViewport()) {
+      report.Add(
+          KX_MemoryReport::MEM_VIEWPORTS, 1, GPU_viewport_memory_size(cam->GetGPUViewport()));
     }
   }
+  if (m_initMaterialsGPUViewport) {
+    report.Add(
+        KX_MemoryReport::MEM_VIEWPORTS, 1, GPU_viewport_memory_size(m_initMaterialsGPUViewport));
+  }
+
+  if (m_physicsEnvironment) {
+    size_t numControllers, controllerBytes, numShapes, shapeBytes;
+    m_physicsEnvironment->GetMemoryUsage(numControllers, controllerBytes, numShapes, shapeBytes);
+    report.Add(KX_MemoryReport::MEM_PHYSICS_CONTROLLERS, numControllers, controllerBytes);
+    report.Add(KX_MemoryReport::MEM_PHYSICS_SHAPES, numShapes, shapeBytes);
+  }
+}
+
+// logic stuff
+void KX_Scene::LogicBeginFrame(double curtime, double framestep)
+{
+  // Remove the temp objects at the end of their life.
+  m_timeBombs.Advance(framestep, m_expiredTimeBombs);
+  for (KX_GameObject *gameobj : m_expiredTimeBombs) {
+    m_timeBombTimers.erase(gameobj);
+    DelayedRemoveObject(gameobj);
+  }
+  m_expiredTimeBombs.clear();
+  m_logicmgr->SetParallelControllers(
+      KX_GetActiveEngine()->GetFlag(KX_KetsjiEngine::PARALLEL_LOGIC));
+  m_logicmgr->SetStaggeredPulses(
+      KX_GetActiveEngine()->GetFlag(KX_KetsjiEngine::STAGGER_PULSES));
+  m_logicmgr->GetScriptProfiler().SetEnabled(
+      KX_GetActiveEngine()->GetFlag(KX_KetsjiEngine::PROFILE_SCRIPTS));
+  m_logicmgr->GetObjectProfiler().SetEnabled(
+      KX_GetActiveEngine()->GetFlag(KX_KetsjiEngine::PROFILE_OBJECTS));
   m_logicmgr->BeginFrame(curtime, framestep);
 }
 
 void KX_Scene::AddAnimatedObject(KX_GameObject *gameobj)
 {
-  CM_ListAddIfNotFound(m_animatedlist, gameobj);
+  if (!gameobj->IsInAnimatedList()) {
+    gameobj->SetInAnimatedList(true);
+    m_animatedlist.push_back(gameobj);
+  }
 }
 
-// static void update_anim_thread_func(TaskPool *pool, void *taskdata, int UNUSED(threadid))
-//{
-//  KX_GameObject *gameobj, *parent;
-//  bool needs_update;
-//  KX_Scene::AnimationPoolData *data = (KX_Scene::AnimationPoolData
-//  *)BLI_task_pool_user_data(pool); double curtime = data->curtime;
+void KX_Scene::AddTransformUpdateObject(KX_GameObject *gameobj)
+{
+  if (!gameobj->IsInTransformUpdateList()) {
+    gameobj->SetInTransformUpdateList(true);
+    m_transformUpdateObjects.push_back(gameobj);
+  }
+}
 
-//  gameobj = (KX_GameObject *)taskdata;
+void KX_Scene::RemoveStaticTransformUpdateObjects()
+{
+  std::vector<KX_GameObject *>::iterator it = std::remove_if(
+      m_transformUpdateObjects.begin(),
+      m_transformUpdateObjects.end(),
+      [this](KX_GameObject *gameobj) {
+        /* Evaluated matrices of objects with an original object not transformed in realtime
+         * have to be set at each render pass. */
+        Object *ob = gameobj->GetBlenderObject();
+        if (gameobj->GetSGNode()->IsDirty(SG_Node::DIRTY_RENDER) ||
+            (ob && !gameobj->IsInstance() && !OrigObCanBeTransformedInRealtime(ob))) {
+          return false;
+        }
+        gameobj->SetInTransformUpdateList(false);
+        return true;
+      });
+  m_transformUpdateObjects.erase(it, m_transformUpdateObjects.end());
+}
 
-//  // Non-armature updates are fast enough, so just update them
-//  needs_update = gameobj->GetGameObjectType() != SCA_IObject::OBJ_ARMATURE;
+/// Minimum number of armatures to update them in the animation pool.
+static const unsigned int animationPoolThreshold = 4;
 
-//  if (!needs_update) {
-//    // If we got here, we're looking to update an armature, so check its children meshes
-//    // to see if we need to bother with a more expensive pose update
-//    const std::vector<KX_GameObject *> children = gameobj->GetChildren();
+static void update_anim_thread_func(TaskPool *__restrict pool, void *taskdata)
+{
+  KX_Scene::AnimationPoolData *data = (KX_Scene::AnimationPoolData *)BLI_task_pool_user_data(
+      pool);
+  KX_Scene::AnimationTaskData *task = (KX_Scene::AnimationTaskData *)taskdata;
 
-//    bool has_mesh = false, has_non_mesh = false;
+  task->poseUpdated = task->gameobj->UpdateActionManager(data->curtime, true, true);
+}
 
-//    // Check for meshes that haven't been culled
-//    for (KX_GameObject *child : children) {
-//      // if (!child->GetCulled()) { // eevee disable armature animation culling
-//      needs_update = true;
-//      break;
-//      //}
+/** Add the world bounds of the mesh children of an armature.
+ * \return False if the armature is always visible, without mesh children or with a child
+ * without bounds.
+ */
+static bool add_armature_bounds(KX_GameObject *armature,
+                                Depsgraph *depsgraph,
+                                SG_BBoxList &bounds)
+{
+  bool hasMesh = false;
+  for (SG_Node *childnode : armature->GetSGNode()->GetSGChildren()) {
+    KX_GameObject *child = (KX_GameObject *)childnode->GetSGClientObject();
+    if (!child || child->GetMeshCount() == 0 || !child->GetBlenderObject()) {
+      continue;
+    }
+    hasMesh = true;
 
-//      if (child->GetMeshCount() == 0)
-//        has_non_mesh = true;
-//      else
-//        has_mesh = true;
-//    }
+    Object *ob_eval = DEG_get_evaluated_object(depsgraph, child->GetBlenderObject());
+    BoundBox *bb = BKE_object_boundbox_get(ob_eval);
+    if (!bb) {
+      return false;
+    }
 
-//    // If we didn't find a non-culled mesh, check to see
-//    // if we even have any meshes, and update if this
-//    // armature has only non-mesh children.
-//    if (!needs_update && !has_mesh && has_non_mesh)
-//      needs_update = true;
-//  }
+    bounds.Add(MT_Vector3(bb->vec[0]), MT_Vector3(bb->vec[6]), child->NodeGetWorldTransform());
+  }
 
-//  // If the object is a culled armature, then we manage only the animation time and end of its
-//  // animations.
-//  gameobj->UpdateActionManager(curtime, needs_update);
+  return hasMesh;
+}
 
-//  if (needs_update) {
-//    const std::vector<KX_GameObject *> children = gameobj->GetChildren();
-//    parent = gameobj->GetParent();
-//  }
-//}
+void KX_Scene::CullArmatures(const std::vector<const SG_Frustum *> &frustums,
+                             Depsgraph *depsgraph)
+{
+  m_armatureBounds.Clear();
+  m_armatureBoundsRanges.clear();
+  for (KX_GameObject *gameobj : m_animatedlist) {
+    if (gameobj->IsActionsSuspended() ||
+        gameobj->GetGameObjectType() != SCA_IObject::OBJ_ARMATURE) {
+      continue;
+    }
+
+    const unsigned int start = m_armatureBounds.GetSize();
+    if (add_armature_bounds(gameobj, depsgraph, m_armatureBounds)) {
+      m_armatureBoundsRanges.emplace_back(start, m_armatureBounds.GetSize());
+    }
+    else {
+      m_armatureBoundsRanges.emplace_back(start, start);
+    }
+  }
+
+  // All the bounds are tested together against each frustum.
+  m_armatureBoundsVisible.clear();
+  for (const SG_Frustum *frustum : frustums) {
+    frustum->BoxesInsideFrustum(m_armatureBounds, m_armatureBoundsVisible);
+  }
+
+  m_armaturesVisible.resize(m_armatureBoundsRanges.size());
+  for (unsigned int i = 0, size = m_armatureBoundsRanges.size(); i < size; ++i) {
+    const std::pair<unsigned int, unsigned int> &range = m_armatureBoundsRanges[i];
+    bool visible = (range.first == range.second);
+    for (unsigned int j = range.first; j < range.second && !visible; ++j) {
+      visible = (m_armatureBoundsVisible[j / 32] >> (j % 32)) & 1;
+    }
+    m_armaturesVisible[i] = visible;
+  }
+}
 
 void KX_Scene::UpdateAnimations(double curtime)
 {
-  // m_animationPoolData.curtime = curtime;
+  m_animationTasks.clear();
+  m_poseCache.NewUpdate();
+
+  /* Use the frustums of the cameras from their last render, a camera never rendered
+   * can't cull. */
+  std::vector<const SG_Frustum *> frustums;
+  bool useCulling = m_animationCulling;
+  if (useCulling) {
+    for (KX_Camera *cam : m_cameralist) {
+      if (cam->hasValidProjectionMatrix()) {
+        frustums.push_back(&cam->GetFrustum());
+      }
+    }
+    useCulling = !frustums.empty();
+  }
+  Depsgraph *depsgraph = useCulling ?
+                             CTX_data_depsgraph_pointer(KX_GetActiveEngine()->GetContext()) :
+                             nullptr;
 
+  std::vector<MT_Vector3> camPositions;
+  const float lodDistance2 = m_animationLodDistance * m_animationLodDistance;
+  bool useLod = (m_animationLodDistance > 0.0f && m_animationLodInterval > 1);
+  if (useLod) {
+    for (KX_Camera *cam : m_cameralist) {
+      if (cam->hasValidProjectionMatrix()) {
+        camPositions.push_back(cam->NodeGetWorldPosition());
+      }
+    }
+    useLod = !camPositions.empty();
+  }
+  if (useCulling) {
+    CullArmatures(frustums, depsgraph);
+  }
+
+  ++m_animationFrame;
+  unsigned int armatureIndex = 0;
+  m_ipoBatch.Open();
+
+  /* Armature poses are the expensive part and are independent per object, they are
+   * updated in parallel. The other actions can evaluate shared data (node trees, meshes)
+   * and are updated here. */
   for (KX_GameObject *gameobj : m_animatedlist) {
-    // BLI_task_pool_push(m_animationPool, update_anim_thread_func, gameobj, false,
-    // TASK_PRIORITY_LOW);
-    if (!gameobj->IsActionsSuspended()) {
+    if (gameobj->IsActionsSuspended()) {
+      continue;
+    }
+
+    if (gameobj->GetGameObjectType() == SCA_IObject::OBJ_ARMATURE) {
+      /* A culled armature only manages the time and end of its actions, its pose is
+       * evaluated again when it enters a camera view. */
+      const unsigned int index = armatureIndex++;
+      if (useCulling && !m_armaturesVisible[index]) {
+        gameobj->UpdateActionManager(curtime, false);
+        continue;
+      }
+
+      /* A distant armature skips its pose, and so the deformation of its meshes, on most
+       * of the frames. The armatures are shifted by their index to not all update on the
+       * same frame. */
+      if (useLod && (m_animationFrame + index) % m_animationLodInterval != 0) {
+        const MT_Vector3 &pos = gameobj->NodeGetWorldPosition();
+        float dist2 = FLT_MAX;
+        for (const MT_Vector3 &campos : camPositions) {
+          dist2 = std::min(dist2, (float)(pos - campos).length2());
+        }
+        if (dist2 > lodDistance2) {
+          gameobj->UpdateActionManager(curtime, false);
+          continue;
+        }
+      }
+      m_animationTasks.push_back({gameobj, false});
+    }
+    else {
       gameobj->UpdateActionManager(curtime, true);
     }
   }
 
-  // BLI_task_pool_work_and_wait(m_animationPool);
+  // The armature actions can be updated by several threads, the batch is closed for them.
+  m_ipoBatch.Flush();
+
+  if (m_animationTasks.size() >= animationPoolThreshold) {
+    m_animationPoolData.curtime = curtime;
+    for (AnimationTaskData &task : m_animationTasks) {
+      BLI_task_pool_push(m_animationPool, update_anim_thread_func, &task, false, nullptr);
+    }
+    BLI_task_pool_work_and_wait(m_animationPool);
+
+    // The controllers write the nodes and the objects, they are updated from this thread.
+    m_ipoBatch.Open();
+    for (AnimationTaskData &task : m_animationTasks) {
+      task.gameobj->UpdateActionObject();
+    }
+    m_ipoBatch.Flush();
+  }
+  else {
+    for (AnimationTaskData &task : m_animationTasks) {
+      task.poseUpdated = task.gameobj->UpdateActionManager(curtime, true);
+    }
+  }
+
+  // Tag the updated armatures serially as the render pass lists are not thread safe.
+  for (const AnimationTaskData &task : m_animationTasks) {
+    if (!task.poseUpdated) {
+      continue;
+    }
+
+    Object *ob = task.gameobj->GetBlenderObject();
+    if (ob->gameflag & OB_OVERLAY_COLLECTION) {
+      AppendToExtraObjectsToUpdateInOverlayPass(ob, ID_RECALC_TRANSFORM);
+    }
+    else {
+      AppendToExtraObjectsToUpdateInAllRenderPasses(ob, ID_RECALC_TRANSFORM);
+    }
+  }
+
+  /* Objects whose actions are all finished and applied don't need any update,
+   * they are added again by their next PlayAction. */
+  std::vector<KX_GameObject *>::iterator it = std::remove_if(
+      m_animatedlist.begin(), m_animatedlist.end(), [](KX_GameObject *gameobj) {
+        if (!gameobj->IsActionsIdle()) {
+          return false;
+        }
+        gameobj->SetInAnimatedList(false);
+        return true;
+      });
+  m_animatedlist.erase(it, m_animatedlist.end());
+}
+
+BL_PoseCache &KX_Scene::GetPoseCache()
+{
+  return m_poseCache;
+}
+
+KX_IpoBatch &KX_Scene::GetIpoBatch()
+{
+  return m_ipoBatch;
 }
 
 void KX_Scene::LogicUpdateFrame(double curtime)
@@ -2435,21 +3762,31 @@ void KX_Scene::LogicUpdateFrame(double curtime)
   m_proxyManager.Update();
 
   m_logicmgr->UpdateFrame(curtime);
+
+  // Apply the steering of the actuators updated in the frame.
+  if (m_obstacleSimulation) {
+    m_obstacleSimulation->UpdateAgents();
+  }
 }
 
 void KX_Scene::LogicEndFrame()
 {
   m_logicmgr->EndFrame();
 
-  /* Don't remove the objects from the euthanasy list here as the child objects of a deleted
-   * parent object are destructed directly from the sgnode in the same time the parent
-   * object is destructed. These child objects must be removed automatically from the
-   * euthanasy list to avoid double deletion in case the user ask to delete the child object
-   * explicitly. NewRemoveObject is the place to do it.
+  /* The child objects of a deleted parent object are destructed directly from the sgnode
+   * in the same time the parent object is destructed. These child objects can be in the
+   * euthanasy list too, they are skipped to avoid double deletion in case the user ask to
+   * delete the child object explicitly. The removed objects stay allocated and the list is
+   * compacted at the end of the batch.
    */
-  while (!m_euthanasyobjects.empty()) {
-    RemoveObject(m_euthanasyobjects.front());
+  BeginBatchedRemoval();
+  for (unsigned int i = 0; i < m_euthanasyobjects.size(); ++i) {
+    KX_GameObject *gameobj = m_euthanasyobjects[i];
+    if (m_batchRemovedObjects.find(gameobj) == m_batchRemovedObjects.end()) {
+      RemoveObject(gameobj);
+    }
   }
+  EndBatchedRemoval();
 
   // prepare obstacle simulation for new frame
   if (m_obstacleSimulation)
@@ -2460,44 +3797,198 @@ void KX_Scene::LogicEndFrame()
   }
 }
 
+/// Minimum number of independent scheduled subtrees to update them in parallel.
+static const unsigned int updateParentsParallelThreshold = 8;
+
+struct UpdateParentsData {
+  SG_Node **nodes;
+  double curtime;
+};
+
+static void update_parents_task(void *__restrict userdata,
+                                const int i,
+                                const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  UpdateParentsData *data = (UpdateParentsData *)userdata;
+  // The familly lock serializes the subtrees sharing the same root.
+  data->nodes[i]->UpdateWorldDataThread(data->curtime);
+}
+
 /**
  * UpdateParents: SceneGraph transformation update.
  */
 void KX_Scene::UpdateParents(double curtime)
 {
-  // we use the SG dynamic list
-  SG_Node *node;
+  // Nodes can be scheduled again while updating, process the list until it's empty.
+  while (!m_sghead.Empty()) {
+    /* Split the scheduled nodes into subtrees independent enough to be updated in parallel
+     * and nodes depending on a slow, vertex or bone parent which are updated serially.
+     * A node with a scheduled ancestor is skipped as the ancestor update its children. */
+    SG_DList::iterator<SG_Node> it(m_sghead);
+    for (it.begin(); !it.end(); ++it) {
+      SG_Node *node = *it;
+      if (node->HasScheduledAncestor()) {
+        continue;
+      }
+
+      if (node->IsSlowParent() || node->IsVertexParent() || node->IsBoneParent()) {
+        m_serialUpdateNodes.push_back(node);
+      }
+      else {
+        m_parallelUpdateNodes.push_back(node);
+      }
+    }
 
-  while ((node = SG_Node::GetNextScheduled(m_sghead)) != nullptr) {
-    node->UpdateWorldData(curtime);
+    // Unschedule all the nodes, including the skipped ones.
+    while (SG_Node::GetNextScheduled(m_sghead)) {
+    }
+
+    if (m_parallelUpdateNodes.size() >= updateParentsParallelThreshold) {
+      UpdateParentsData data = {m_parallelUpdateNodes.data(), curtime};
+
+      TaskParallelSettings settings;
+      BLI_parallel_range_settings_defaults(&settings);
+      settings.min_iter_per_thread = 1;
+      BLI_task_parallel_range(0, m_parallelUpdateNodes.size(), &data, update_parents_task, &settings);
+    }
+    else {
+      for (SG_Node *node : m_parallelUpdateNodes) {
+        node->UpdateWorldData(curtime);
+      }
+    }
+
+    for (SG_Node *node : m_serialUpdateNodes) {
+      node->UpdateWorldData(curtime);
+    }
+
+    m_parallelUpdateNodes.clear();
+    m_serialUpdateNodes.clear();
   }
 
-  // the list must be empty here
-  BLI_assert(m_sghead.Empty());
   // some nodes may be ready for reschedule, move them to schedule list for next time
+  SG_Node *node;
   while ((node = SG_Node::GetNextRescheduled(m_sghead)) != nullptr) {
     node->Schedule(m_sghead);
   }
 }
 
+#ifdef WITH_PYTHON
+struct RunTasksData {
+  KX_TaskFuture **tasks;
+  /// Range of the tasks of each group in the tasks array, a group is run serially.
+  std::pair<unsigned int, unsigned int> *groups;
+};
+
+static void run_tasks_task(void *__restrict userdata,
+                           const int i,
+                           const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  RunTasksData *data = (RunTasksData *)userdata;
+  const std::pair<unsigned int, unsigned int> &group = data->groups[i];
+  for (unsigned int j = group.first; j < group.second; ++j) {
+    data->tasks[j]->Run();
+  }
+}
+#endif  // WITH_PYTHON
+
+void KX_Scene::RunTasks()
+{
+#ifdef WITH_PYTHON
+  if (m_tasks.empty()) {
+    return;
+  }
+
+  // Group the tasks sharing the same exclusive data, keeping the submission order in a group.
+  std::stable_sort(m_tasks.begin(), m_tasks.end(), [](KX_TaskFuture *a, KX_TaskFuture *b) {
+    return a->GetExclusiveData() < b->GetExclusiveData();
+  });
+
+  std::vector<std::pair<unsigned int, unsigned int>> groups;
+  for (unsigned int i = 0, size = m_tasks.size(); i < size;) {
+    void *data = m_tasks[i]->GetExclusiveData();
+    unsigned int end = i + 1;
+    if (data) {
+      while (end < size && m_tasks[end]->GetExclusiveData() == data) {
+        ++end;
+      }
+    }
+    groups.emplace_back(i, end);
+    i = end;
+  }
+
+  RunTasksData data = {m_tasks.data(), groups.data()};
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (groups.size() > 1);
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(0, groups.size(), &data, run_tasks_task, &settings);
+
+  // The results reference game objects, convert them before any object can be removed.
+  for (KX_TaskFuture *task : m_tasks) {
+    task->Finish();
+    task->Release();
+  }
+  m_tasks.clear();
+#endif  // WITH_PYTHON
+}
+
 RAS_MaterialBucket *KX_Scene::FindBucket(class RAS_IPolyMaterial *polymat, bool &bucketCreated)
 {
   return m_bucketmanager->FindBucket(polymat, bucketCreated);
 }
 
-void KX_Scene::UpdateObjectLods(KX_Camera *cam)
+void KX_Scene::UpdateObjectLods(KX_Camera *cam, Depsgraph *depsgraph)
 {
   const MT_Vector3 &cam_pos = cam->NodeGetWorldPosition();
   const float lodfactor = cam->GetLodDistanceFactor();
+  const unsigned int count = m_kxobWithLod.size();
 
-  for (KX_GameObject *gameobj : m_kxobWithLod) {
-    gameobj->UpdateLod(cam_pos, lodfactor);
+  if (m_lodUpdateOffset >= count) {
+    m_lodUpdateOffset = 0;
+  }
+
+  /* Start from the first switch deferred at the previous update so that
+   * the objects waiting for a switch are served first. */
+  int switches = 0;
+  int firstDeferred = -1;
+  for (unsigned int i = 0; i < count; ++i) {
+    const unsigned int index = (m_lodUpdateOffset + i) % count;
+    const bool allowSwitch = (m_lodSwitchBudget == 0 || switches < m_lodSwitchBudget);
+
+    switch (m_kxobWithLod[index]->UpdateLod(depsgraph, cam_pos, lodfactor, allowSwitch)) {
+      case KX_GameObject::LOD_SWITCHED: {
+        ++switches;
+        break;
+      }
+      case KX_GameObject::LOD_DEFERRED: {
+        if (firstDeferred == -1) {
+          firstDeferred = index;
+        }
+        break;
+      }
+      case KX_GameObject::LOD_UNCHANGED: {
+        break;
+      }
+    }
+  }
+
+  if (firstDeferred != -1) {
+    m_lodUpdateOffset = firstDeferred;
   }
 }
 
 void KX_Scene::SetLodHysteresis(bool active)
 {
   m_isActivedHysteresis = active;
+  InvalidateLodDistanceRanges();
+}
+
+void KX_Scene::InvalidateLodDistanceRanges()
+{
+  for (KX_GameObject *gameobj : m_kxobWithLod) {
+    gameobj->InvalidateLodDistanceRange();
+  }
 }
 
 bool KX_Scene::IsActivedLodHysteresis(void)
@@ -2508,6 +3999,7 @@ bool KX_Scene::IsActivedLodHysteresis(void)
 void KX_Scene::SetLodHysteresisValue(int hysteresisvalue)
 {
   m_lodHysteresisValue = hysteresisvalue;
+  InvalidateLodDistanceRanges();
 }
 
 int KX_Scene::GetLodHysteresisValue(void)
@@ -2515,6 +4007,16 @@ int KX_Scene::GetLodHysteresisValue(void)
   return m_lodHysteresisValue;
 }
 
+void KX_Scene::SetLodSwitchBudget(int budget)
+{
+  m_lodSwitchBudget = budget;
+}
+
+int KX_Scene::GetLodSwitchBudget() const
+{
+  return m_lodSwitchBudget;
+}
+
 void KX_Scene::UpdateObjectActivity(void)
 {
   if (!m_activityCulling) {
@@ -2531,25 +4033,12 @@ void KX_Scene::UpdateObjectActivity(void)
 
   // None cameras are using object activity culling?
   if (camPositions.size() == 0) {
+    // Moved objects are not tracked until a camera uses activity culling.
+    m_activityCullingGrid.Invalidate();
     return;
   }
 
-  for (KX_GameObject *gameobj : m_objectlist) {
-    // If the object doesn't manage activity culling we don't compute distance.
-    if (gameobj->GetActivityCullingInfo().m_flags ==
-        KX_GameObject::ActivityCullingInfo::ACTIVITY_NONE) {
-      continue;
-    }
-
-    // For each camera compute the distance to objects and keep the minimum distance.
-    const MT_Vector3 &obpos = gameobj->NodeGetWorldPosition();
-    float dist = FLT_MAX;
-    for (const MT_Vector3 &campos : camPositions) {
-      // Keep the minimum distance.
-      dist = min_ff((obpos - campos).length2(), dist);
-    }
-    gameobj->UpdateActivity(dist);
-  }
+  m_activityCullingGrid.Update(m_objectlist, camPositions);
 }
 
 KX_NetworkMessageScene *KX_Scene::GetNetworkMessageScene()
@@ -2557,6 +4046,25 @@ KX_NetworkMessageScene *KX_Scene::GetNetworkMessageScene()
   return m_networkScene;
 }
 
+KX_ReplicationManager &KX_Scene::GetReplicationManager()
+{
+  return m_replicationManager;
+}
+
+void KX_Scene::UpdateReplication(KX_NetworkTransport *transport,
+                                 double time,
+                                 float rate,
+                                 float radius)
+{
+  MT_Vector3 interest;
+  if (m_active_camera) {
+    interest = m_active_camera->NodeGetWorldPosition();
+  }
+
+  m_replicationManager.Update(
+      transport, GetName(), m_active_camera ? &interest : nullptr, time, rate, radius);
+}
+
 void KX_Scene::SetNetworkMessageScene(KX_NetworkMessageScene *newScene)
 {
   m_networkScene = newScene;
@@ -2580,8 +4088,9 @@ void KX_Scene::SetPhysicsEnvironment(class PHY_IPhysicsEnvironment *physEnv)
 {
   m_physicsEnvironment = physEnv;
   if (m_physicsEnvironment) {
-    KX_CollisionEventManager *collisionmgr = new KX_CollisionEventManager(m_logicmgr, physEnv);
-    m_logicmgr->RegisterEventManager(collisionmgr);
+    m_physicsEnvironment->SetObjectProfiler(&m_logicmgr->GetObjectProfiler());
+    m_collisionEventManager = new KX_CollisionEventManager(m_logicmgr, physEnv);
+    m_logicmgr->RegisterEventManager(m_collisionEventManager);
   }
 }
 
@@ -2630,11 +4139,21 @@ static void MergeScene_GameObject(KX_GameObject *gameobj, KX_Scene *to, KX_Scene
   }
 
   /* graphics controller */
-  PHY_IController *ctrl = gameobj->GetPhysicsController();
+  PHY_IController *ctrl = gameobj->GetGraphicController();
   if (ctrl) {
     ctrl->SetPhysicsEnvironment(to->GetPhysicsEnvironment());
   }
 
+  ctrl = gameobj->GetPhysicsController();
+  if (ctrl) {
+    ctrl->SetPhysicsEnvironment(to->GetPhysicsEnvironment());
+  }
+
+  if (gameobj->IsInstance()) {
+    from->RemoveInstanceObject(gameobj);
+    to->AddInstanceObject(gameobj);
+  }
+
   /* SG_Node can hold a scene reference */
   SG_Node *sg = gameobj->GetSGNode();
   if (sg) {
@@ -2649,9 +4168,12 @@ static void MergeScene_GameObject(KX_GameObject *gameobj, KX_Scene *to, KX_Scene
     }
   }
 
-  // All armatures should be in the animated object list to be umpdated.
-  if (gameobj->GetGameObjectType() == SCA_IObject::OBJ_ARMATURE)
+  // All armatures and objects with actions should be in the animated object list to be updated.
+  gameobj->SetInAnimatedList(false);
+  if (gameobj->GetGameObjectType() == SCA_IObject::OBJ_ARMATURE ||
+      gameobj->GetActionManagerNoCreate()) {
     to->AddAnimatedObject(gameobj);
+  }
 
   /* Add the object to the scene's logic manager */
   to->GetLogicManager()->RegisterGameObjectName(gameobj->GetName(), gameobj);
@@ -2665,72 +4187,130 @@ static void MergeScene_GameObject(KX_GameObject *gameobj, KX_Scene *to, KX_Scene
   }
 }
 
+static void MergeScene_ObjectLists(KX_GameObject *gameobj, KX_Scene *to, KX_Scene *from)
+{
+  if (gameobj->GetSGNode()->GetSGParent() == nullptr) {
+    to->GetRootParentList()->Add(CM_AddRef(gameobj));
+  }
+
+  switch (gameobj->GetGameObjectType()) {
+    case SCA_IObject::OBJ_LIGHT: {
+      KX_LightObject *light = static_cast<KX_LightObject *>(gameobj);
+      if (from->GetLightList()->SearchValue(light)) {
+        to->GetLightList()->Add(CM_AddRef(light));
+      }
+      break;
+    }
+    case SCA_IObject::OBJ_CAMERA: {
+      KX_Camera *camera = static_cast<KX_Camera *>(gameobj);
+      if (from->GetCameraList()->SearchValue(camera)) {
+        to->GetCameraList()->Add(CM_AddRef(camera));
+      }
+      break;
+    }
+    case SCA_IObject::OBJ_TEXT: {
+      KX_FontObject *font = static_cast<KX_FontObject *>(gameobj);
+      if (from->GetFontList()->SearchValue(font)) {
+        to->GetFontList()->Add(CM_AddRef(font));
+      }
+      break;
+    }
+  }
+}
+
 bool KX_Scene::MergeScene(KX_Scene *other)
+{
+  bool finished;
+  return MergeScenePart(other, std::numeric_limits<double>::max(), finished);
+}
+
+bool KX_Scene::MergeScenePart(KX_Scene *other, double endtime, bool &finished)
 {
   PHY_IPhysicsEnvironment *env = this->GetPhysicsEnvironment();
   PHY_IPhysicsEnvironment *env_other = other->GetPhysicsEnvironment();
+  MergeState &state = other->m_mergeState;
+
+  finished = false;
+
+  if (!state.m_started) {
+    if ((env == nullptr) !=
+        (env_other == nullptr)) /* TODO - even when both scenes have NONE physics, the other is
+                                   loaded with bullet enabled, ??? */
+    {
+      CM_FunctionError("physics scenes type differ, aborting\n\tsource "
+                       << (int)(env != nullptr) << ", target " << (int)(env_other != nullptr));
+      finished = true;
+      return false;
+    }
 
-  if ((env == nullptr) !=
-      (env_other == nullptr)) /* TODO - even when both scenes have NONE physics, the other is
-                                 loaded with bullet enabled, ??? */
-  {
-    CM_FunctionError("physics scenes type differ, aborting\n\tsource "
-                     << (int)(env != nullptr) << ", target " << (int)(env_other != nullptr));
-    return false;
+    GetBucketManager()->MergeBucketManager(other->GetBucketManager());
+    state.m_started = true;
   }
 
-  GetBucketManager()->MergeBucketManager(other->GetBucketManager());
+  /* Merged objects are added to the lists of this scene, the references
+   * of the other scene lists are released once everything is merged. */
+  bool outoftime = false;
 
   /* active + inactive == all ??? - lets hope so */
-  for (KX_GameObject *gameobj : *other->GetObjectList()) {
+  EXP_ListValue<KX_GameObject> *otherObjects = other->GetObjectList();
+  while (state.m_objectIndex < otherObjects->GetCount() && !outoftime) {
+    KX_GameObject *gameobj = otherObjects->GetValue(state.m_objectIndex++);
     MergeScene_GameObject(gameobj, this, other);
 
     /* add properties to debug list for LibLoad objects */
     if (KX_GetActiveEngine()->GetFlag(KX_KetsjiEngine::AUTO_ADD_DEBUG_PROPERTIES)) {
       AddObjectDebugProperties(gameobj);
     }
+
+    if (gameobj->GetPhysicsController()) {
+      state.m_physicsObjects.push_back(gameobj);
+    }
+
+    // The merged objects have to be notified to the depsgraph at least once.
+    gameobj->SetInTransformUpdateList(false);
+    AddTransformUpdateObject(gameobj);
+
+    GetObjectList()->Add(CM_AddRef(gameobj));
+    MergeScene_ObjectLists(gameobj, this, other);
+
+    outoftime = (PIL_check_seconds_timer() >= endtime);
   }
 
-  for (KX_GameObject *gameobj : *other->GetInactiveList()) {
+  EXP_ListValue<KX_GameObject> *otherInactiveObjects = other->GetInactiveList();
+  while (state.m_inactiveIndex < otherInactiveObjects->GetCount() && !outoftime) {
+    KX_GameObject *gameobj = otherInactiveObjects->GetValue(state.m_inactiveIndex++);
     MergeScene_GameObject(gameobj, this, other);
+
+    GetInactiveList()->Add(CM_AddRef(gameobj));
+    MergeScene_ObjectLists(gameobj, this, other);
+
+    outoftime = (PIL_check_seconds_timer() >= endtime);
+  }
+
+  if (state.m_objectIndex < otherObjects->GetCount() ||
+      state.m_inactiveIndex < otherInactiveObjects->GetCount()) {
+    return true;
   }
 
+  /* The physics and the constraints are not merged per part: the targets of a constraint can
+   * be merged by any part and MergeEnvironment moves all the controllers at once. Until then
+   * the merged objects keep their controllers in the environment of the other scene, which is
+   * not simulated. */
   if (env) {
     env->MergeEnvironment(env_other);
-    EXP_ListValue<KX_GameObject> *otherObjects = other->GetObjectList();
-
-    // List of all physics objects to merge (needed by ReplicateConstraints).
-    std::vector<KX_GameObject *> physicsObjects;
-    for (KX_GameObject *gameobj : *otherObjects) {
-      if (gameobj->GetPhysicsController()) {
-        physicsObjects.push_back(gameobj);
-      }
-    }
 
-    for (unsigned int i = 0; i < physicsObjects.size(); ++i) {
-      KX_GameObject *gameobj = physicsObjects[i];
+    for (KX_GameObject *gameobj : state.m_physicsObjects) {
       // Replicate all constraints in the right physics environment.
-      gameobj->GetPhysicsController()->ReplicateConstraints(gameobj, physicsObjects);
+      gameobj->GetPhysicsController()->ReplicateConstraints(gameobj, state.m_physicsObjects);
       gameobj->ClearConstraints();
     }
   }
 
-  GetObjectList()->MergeList(other->GetObjectList());
   other->GetObjectList()->ReleaseAndRemoveAll();
-
-  GetInactiveList()->MergeList(other->GetInactiveList());
   other->GetInactiveList()->ReleaseAndRemoveAll();
-
-  GetRootParentList()->MergeList(other->GetRootParentList());
   other->GetRootParentList()->ReleaseAndRemoveAll();
-
-  GetLightList()->MergeList(other->GetLightList());
   other->GetLightList()->ReleaseAndRemoveAll();
-
-  GetCameraList()->MergeList(other->GetCameraList());
   other->GetCameraList()->ReleaseAndRemoveAll();
-
-  GetFontList()->MergeList(other->GetFontList());
   other->GetFontList()->ReleaseAndRemoveAll();
 
   /* move materials across, assume they both use the same scene-converters
@@ -2768,9 +4348,21 @@ bool KX_Scene::MergeScene(KX_Scene *other)
       timemgr->AddTimeProperty(times[i]);
     }
   }
+
+  state.m_physicsObjects.clear();
+  finished = true;
   return true;
 }
 
+float KX_Scene::GetMergeProgress()
+{
+  const unsigned int total = m_objectlist->GetCount() + m_inactivelist->GetCount();
+  if (!m_mergeState.m_started || total == 0) {
+    return 0.0f;
+  }
+  return (float)(m_mergeState.m_objectIndex + m_mergeState.m_inactiveIndex) / (float)total;
+}
+
 RAS_2DFilterManager *KX_Scene::Get2DFilterManager() const
 {
   return m_filterManager;
@@ -2873,6 +4465,16 @@ PyMethodDef KX_Scene::Methods[] = {
     EXP_PYMETHODTABLE(KX_Scene, addOverlayCollection),
     EXP_PYMETHODTABLE(KX_Scene, removeOverlayCollection),
     EXP_PYMETHODTABLE(KX_Scene, getGameObjectFromObject),
+    EXP_PYMETHODTABLE(KX_Scene, getTransforms),
+    EXP_PYMETHODTABLE(KX_Scene, setTransforms),
+    EXP_PYMETHODTABLE(KX_Scene, rayCastBatch),
+    EXP_PYMETHODTABLE(KX_Scene, rayCastBatchAsync),
+    EXP_PYMETHODTABLE(KX_Scene, addStreamingCell),
+    EXP_PYMETHODTABLE(KX_Scene, removeStreamingCell),
+    EXP_PYMETHODTABLE(KX_Scene, getStreamingCellState),
+    EXP_PYMETHODTABLE(KX_Scene, prewarmMeshes),
+    EXP_PYMETHODTABLE(KX_Scene, saveState),
+    EXP_PYMETHODTABLE(KX_Scene, loadState),
 
     /* dict style access */
     EXP_PYMETHODTABLE(KX_Scene, get),
@@ -3169,25 +4771,93 @@ int KX_Scene::pyattr_set_remove_callback(EXP_PyObjectPlus *self_v,
   return PY_SET_ATTR_SUCCESS;
 }
 
-PyObject *KX_Scene::pyattr_get_gravity(EXP_PyObjectPlus *self_v,
-                                       const EXP_PYATTRIBUTE_DEF *attrdef)
+PyObject *KX_Scene::pyattr_get_gravity(EXP_PyObjectPlus *self_v,
+                                       const EXP_PYATTRIBUTE_DEF *attrdef)
+{
+  KX_Scene *self = static_cast<KX_Scene *>(self_v);
+
+  return PyObjectFrom(self->GetGravity());
+}
+
+int KX_Scene::pyattr_set_gravity(EXP_PyObjectPlus *self_v,
+                                 const EXP_PYATTRIBUTE_DEF *attrdef,
+                                 PyObject *value)
+{
+  KX_Scene *self = static_cast<KX_Scene *>(self_v);
+
+  MT_Vector3 vec;
+  if (!PyVecTo(value, vec))
+    return PY_SET_ATTR_FAIL;
+
+  self->SetGravity(vec);
+  return PY_SET_ATTR_SUCCESS;
+}
+
+PyObject *KX_Scene::pyattr_get_streaming_cells(EXP_PyObjectPlus *self_v,
+                                               const EXP_PYATTRIBUTE_DEF *attrdef)
+{
+  KX_Scene *self = static_cast<KX_Scene *>(self_v);
+
+  const std::vector<std::string> names = self->m_worldStreamer->GetCellNames();
+  PyObject *list = PyList_New(names.size());
+  for (unsigned int i = 0, size = names.size(); i < size; ++i) {
+    PyList_SET_ITEM(list, i, PyUnicode_FromStdString(names[i]));
+  }
+
+  return list;
+}
+
+PyObject *KX_Scene::pyattr_get_streaming_max_loads(EXP_PyObjectPlus *self_v,
+                                                   const EXP_PYATTRIBUTE_DEF *attrdef)
+{
+  KX_Scene *self = static_cast<KX_Scene *>(self_v);
+
+  return PyLong_FromLong(self->m_worldStreamer->GetMaxLoads());
+}
+
+int KX_Scene::pyattr_set_streaming_max_loads(EXP_PyObjectPlus *self_v,
+                                             const EXP_PYATTRIBUTE_DEF *attrdef,
+                                             PyObject *value)
+{
+  KX_Scene *self = static_cast<KX_Scene *>(self_v);
+
+  const int maxLoads = PyLong_AsLong(value);
+  if (maxLoads < 1) {
+    if (!PyErr_Occurred()) {
+      PyErr_SetString(PyExc_ValueError,
+                      "scene.streamingMaxLoads = int: KX_Scene, expected a positive int");
+    }
+    return PY_SET_ATTR_FAIL;
+  }
+
+  self->m_worldStreamer->SetMaxLoads(maxLoads);
+  return PY_SET_ATTR_SUCCESS;
+}
+
+PyObject *KX_Scene::pyattr_get_streaming_merge_budget(EXP_PyObjectPlus *self_v,
+                                                      const EXP_PYATTRIBUTE_DEF *attrdef)
 {
   KX_Scene *self = static_cast<KX_Scene *>(self_v);
 
-  return PyObjectFrom(self->GetGravity());
+  return PyFloat_FromDouble(self->m_worldStreamer->GetMergeBudget());
 }
 
-int KX_Scene::pyattr_set_gravity(EXP_PyObjectPlus *self_v,
-                                 const EXP_PYATTRIBUTE_DEF *attrdef,
-                                 PyObject *value)
+int KX_Scene::pyattr_set_streaming_merge_budget(EXP_PyObjectPlus *self_v,
+                                                const EXP_PYATTRIBUTE_DEF *attrdef,
+                                                PyObject *value)
 {
   KX_Scene *self = static_cast<KX_Scene *>(self_v);
 
-  MT_Vector3 vec;
-  if (!PyVecTo(value, vec))
+  const float budget = PyFloat_AsDouble(value);
+  if (budget < 0.0f || PyErr_Occurred()) {
+    if (!PyErr_Occurred()) {
+      PyErr_SetString(PyExc_ValueError,
+                      "scene.streamingMergeBudget = float: KX_Scene, expected a positive float");
+    }
     return PY_SET_ATTR_FAIL;
+  }
 
-  self->SetGravity(vec);
+  self->m_worldStreamer->SetMergeBudget(budget);
   return PY_SET_ATTR_SUCCESS;
 }
 
@@ -3214,7 +4884,22 @@ PyAttributeDef KX_Scene::Attributes[] = {
     EXP_PYATTRIBUTE_RW_FUNCTION(
         "pre_draw_setup", KX_Scene, pyattr_get_drawing_callback, pyattr_set_drawing_callback),
     EXP_PYATTRIBUTE_RW_FUNCTION("gravity", KX_Scene, pyattr_get_gravity, pyattr_set_gravity),
+    EXP_PYATTRIBUTE_RO_FUNCTION("streamingCells", KX_Scene, pyattr_get_streaming_cells),
+    EXP_PYATTRIBUTE_RW_FUNCTION("streamingMaxLoads",
+                                KX_Scene,
+                                pyattr_get_streaming_max_loads,
+                                pyattr_set_streaming_max_loads),
+    EXP_PYATTRIBUTE_RW_FUNCTION("streamingMergeBudget",
+                                KX_Scene,
+                                pyattr_get_streaming_merge_budget,
+                                pyattr_set_streaming_merge_budget),
     EXP_PYATTRIBUTE_BOOL_RO("activityCulling", KX_Scene, m_activityCulling),
+    EXP_PYATTRIBUTE_BOOL_RW("animationCulling", KX_Scene, m_animationCulling),
+    EXP_PYATTRIBUTE_FLOAT_RW(
+        "animationLodDistance", 0.0f, FLT_MAX, KX_Scene, m_animationLodDistance),
+    EXP_PYATTRIBUTE_INT_RW(
+        "animationLodInterval", 1, INT_MAX, true, KX_Scene, m_animationLodInterval),
+    EXP_PYATTRIBUTE_INT_RW("lodSwitchBudget", 0, INT_MAX, true, KX_Scene, m_lodSwitchBudget),
     EXP_PYATTRIBUTE_BOOL_RO("dbvt_culling", KX_Scene, m_dbvt_culling),
     EXP_PYATTRIBUTE_RO_FUNCTION("logger", KX_Scene, KX_PythonProxy::pyattr_get_logger),
     EXP_PYATTRIBUTE_RO_FUNCTION("loggerName", KX_Scene, KX_PythonProxy::pyattr_get_logger_name),
@@ -3223,7 +4908,7 @@ PyAttributeDef KX_Scene::Attributes[] = {
 
 EXP_PYMETHODDEF_DOC(KX_Scene,
                     addObject,
-                    "addObject(object, other, time=0, dupli=0)\n"
+                    "addObject(object, other, time=0, dupli=0, instanced=0)\n"
                     "Returns the added object.\n")
 {
   PyObject *pyob, *pyreference = Py_None;
@@ -3233,8 +4918,11 @@ EXP_PYMETHODDEF_DOC(KX_Scene,
 
   // Full duplication of ob->data
   int duplicate = 0;
+  // Draw as instances of the original blender object
+  int instanced = 0;
 
-  if (!PyArg_ParseTuple(args, "O|Ofi:addObject", &pyob, &pyreference, &time, &duplicate))
+  if (!PyArg_ParseTuple(
+          args, "O|Ofii:addObject", &pyob, &pyreference, &time, &duplicate, &instanced))
     return nullptr;
 
   if (!ConvertPythonToGameObject(
@@ -3259,8 +4947,16 @@ EXP_PYMETHODDEF_DOC(KX_Scene,
     return nullptr;
   }
   bool dupli = duplicate == 1;
-  KX_GameObject *replica = !dupli ? AddReplicaObject(ob, reference, time) :
-                                    AddDuplicaObject(ob, reference, time);
+  KX_GameObject *replica;
+  if (dupli) {
+    replica = AddDuplicaObject(ob, reference, time);
+  }
+  else if (instanced) {
+    replica = AddInstancedReplicaObject(ob, reference, time);
+  }
+  else {
+    replica = AddReplicaObject(ob, reference, time);
+  }
 
   // release here because AddReplicaObject AddRef's
   // the object is added to the scene so we don't want python to own a reference
@@ -3390,7 +5086,10 @@ EXP_PYMETHODDEF_DOC(KX_Scene,
     objectslist.push_back(ob);
   }
 
-  ConvertBlenderObjectsList(objectslist, asynchronous);
+  KX_LibLoadStatus *status = ConvertBlenderObjectsList(objectslist, asynchronous);
+  if (status) {
+    return status->GetProxy();
+  }
   Py_RETURN_NONE;
 }
 
@@ -3414,7 +5113,10 @@ EXP_PYMETHODDEF_DOC(KX_Scene,
   }
 
   Collection *co = (Collection *)id;
-  ConvertBlenderCollection(co, asynchronous);
+  KX_LibLoadStatus *status = ConvertBlenderCollection(co, asynchronous);
+  if (status) {
+    return status->GetProxy();
+  }
   Py_RETURN_NONE;
 }
 
@@ -3461,12 +5163,7 @@ EXP_PYMETHODDEF_DOC(KX_Scene,
 
   bAction *act = (bAction *)id;
   // Now unregister actions.
-  std::map<std::string, void *>::iterator it = GetLogicManager()->GetActionMap().find(
-      act->id.name + 2);
-  std::map<std::string, void *> &mapStringToActions = GetLogicManager()->GetActionMap();
-  if (it != mapStringToActions.end()) {
-    mapStringToActions.erase(it);
-  }
+  GetLogicManager()->GetActionMap().erase(act->id.name + 2);
   Py_RETURN_NONE;
 }
 
@@ -3554,6 +5251,605 @@ EXP_PYMETHODDEF_DOC(KX_Scene,
   Py_RETURN_NONE;
 }
 
+/// Number of floats of an object transform in the buffers of getTransforms and setTransforms.
+static const unsigned short transformBufferStride = 12;
+
+/// Convert a sequence of game objects or object names.
+static bool convert_python_to_game_objects(SCA_LogicManager *logicmgr,
+                                           PyObject *value,
+                                           std::vector<KX_GameObject *> &objects,
+                                           const char *error_prefix)
+{
+  PyObject *seq = PySequence_Fast(value, error_prefix);
+  if (!seq) {
+    return false;
+  }
+
+  const Py_ssize_t size = PySequence_Fast_GET_SIZE(seq);
+  PyObject **items = PySequence_Fast_ITEMS(seq);
+  objects.resize(size);
+  for (Py_ssize_t i = 0; i < size; ++i) {
+    if (!ConvertPythonToGameObject(logicmgr, items[i], &objects[i], false, error_prefix)) {
+      Py_DECREF(seq);
+      return false;
+    }
+  }
+
+  Py_DECREF(seq);
+  return true;
+}
+
+/** Get a C contiguous buffer of floats or raw bytes big enough for a number of floats.
+ * \return False and set the python error if the buffer is invalid.
+ */
+static bool get_float_buffer(
+    PyObject *value, Py_buffer &view, bool writable, size_t count, const char *error_prefix)
+{
+  if (PyObject_GetBuffer(value,
+                         &view,
+                         PyBUF_C_CONTIGUOUS | PyBUF_FORMAT | (writable ? PyBUF_WRITABLE : 0)) ==
+      -1) {
+    return false;
+  }
+
+  const char *format = view.format ? view.format : "B";
+  // Allow the native byte order prefixes of a float format.
+  if (ELEM(format[0], '@', '=')) {
+    ++format;
+  }
+
+  if (!((STREQ(format, "f") && view.itemsize == sizeof(float)) ||
+        (ELEM(format[0], 'B', 'b', 'c') && format[1] == '\0'))) {
+    PyErr_Format(PyExc_TypeError,
+                 "%s, expected a buffer of float32 or bytes, not format \"%s\"",
+                 error_prefix,
+                 format);
+    PyBuffer_Release(&view);
+    return false;
+  }
+
+  if ((size_t)view.len < count * sizeof(float)) {
+    PyErr_Format(
+        PyExc_ValueError, "%s, buffer is too small, %zu floats expected", error_prefix, count);
+    PyBuffer_Release(&view);
+    return false;
+  }
+
+  return true;
+}
+
+EXP_PYMETHODDEF_DOC(KX_Scene,
+                    getTransforms,
+                    "getTransforms(objects, buffer=None)\n"
+                    "Write the world position and orientation of the objects in a float32 "
+                    "buffer.\n")
+{
+  PyObject *pyobjects;
+  PyObject *pybuffer = Py_None;
+
+  if (!PyArg_ParseTuple(args, "O|O:getTransforms", &pyobjects, &pybuffer)) {
+    return nullptr;
+  }
+
+  std::vector<KX_GameObject *> objects;
+  if (!convert_python_to_game_objects(
+          m_logicmgr, pyobjects, objects, "scene.getTransforms(objects, buffer): KX_Scene")) {
+    return nullptr;
+  }
+
+  const size_t size = objects.size() * transformBufferStride * sizeof(float);
+  if (pybuffer == Py_None) {
+    pybuffer = PyByteArray_FromStringAndSize(nullptr, size);
+    if (!pybuffer) {
+      return nullptr;
+    }
+  }
+  else {
+    Py_INCREF(pybuffer);
+  }
+
+  Py_buffer view;
+  if (!get_float_buffer(pybuffer,
+                        view,
+                        true,
+                        objects.size() * transformBufferStride,
+                        "scene.getTransforms(objects, buffer): KX_Scene")) {
+    Py_DECREF(pybuffer);
+    return nullptr;
+  }
+
+  float *data = (float *)view.buf;
+  for (KX_GameObject *gameobj : objects) {
+    const MT_Vector3 &pos = gameobj->NodeGetWorldPosition();
+    const MT_Matrix3x3 &ori = gameobj->NodeGetWorldOrientation();
+    for (unsigned short i = 0; i < 3; ++i) {
+      data[i] = pos[i];
+    }
+    for (unsigned short i = 0; i < 3; ++i) {
+      for (unsigned short j = 0; j < 3; ++j) {
+        data[3 + i * 3 + j] = ori[i][j];
+      }
+    }
+    data += transformBufferStride;
+  }
+
+  PyBuffer_Release(&view);
+
+  return pybuffer;
+}
+
+EXP_PYMETHODDEF_DOC(KX_Scene,
+                    setTransforms,
+                    "setTransforms(objects, buffer)\n"
+                    "Set the world position and orientation of the objects from a float32 "
+                    "buffer.\n")
+{
+  PyObject *pyobjects;
+  PyObject *pybuffer;
+
+  if (!PyArg_ParseTuple(args, "OO:setTransforms", &pyobjects, &pybuffer)) {
+    return nullptr;
+  }
+
+  std::vector<KX_GameObject *> objects;
+  if (!convert_python_to_game_objects(
+          m_logicmgr, pyobjects, objects, "scene.setTransforms(objects, buffer): KX_Scene")) {
+    return nullptr;
+  }
+
+  Py_buffer view;
+  if (!get_float_buffer(pybuffer,
+                        view,
+                        false,
+                        objects.size() * transformBufferStride,
+                        "scene.setTransforms(objects, buffer): KX_Scene")) {
+    return nullptr;
+  }
+
+  const float *data = (const float *)view.buf;
+  for (KX_GameObject *gameobj : objects) {
+    const MT_Vector3 pos(data[0], data[1], data[2]);
+    const MT_Matrix3x3 ori(data[3],
+                           data[4],
+                           data[5],
+                           data[6],
+                           data[7],
+                           data[8],
+                           data[9],
+                           data[10],
+                           data[11]);
+    gameobj->NodeSetWorldPosition(pos);
+    gameobj->NodeSetGlobalOrientation(ori);
+    gameobj->NodeUpdateGS(0.0f);
+    data += transformBufferStride;
+  }
+
+  PyBuffer_Release(&view);
+
+  Py_RETURN_NONE;
+}
+
+/// Number of floats of a ray result in the buffer returned by rayCastBatch.
+static const unsigned short rayCastBatchStride = 7;
+/// Minimum number of rays per thread in rayCastBatch.
+static const unsigned int rayCastBatchParallelThreshold = 64;
+
+/// Ray cast callback of rayCastBatch, the objects not matching the collision mask are skipped.
+class KX_BatchRayCast : public KX_RayCast {
+ public:
+  unsigned int m_mask;
+  KX_GameObject *m_hitObject;
+
+  KX_BatchRayCast(unsigned int mask)
+      : KX_RayCast(nullptr, false, false), m_mask(mask), m_hitObject(nullptr)
+  {
+    m_hitFound = false;
+  }
+
+  virtual bool RayHit(KX_ClientObjectInfo *client)
+  {
+    m_hitObject = client->m_gameobject;
+    return true;
+  }
+
+  virtual bool needBroadphaseRayCast(PHY_IPhysicsController *controller)
+  {
+    KX_ClientObjectInfo *info = static_cast<KX_ClientObjectInfo *>(controller->GetNewClientInfo());
+    return (info && info->m_gameobject && (info->m_gameobject->GetUserCollisionGroup() & m_mask));
+  }
+};
+
+struct RayCastBatchData {
+  PHY_IPhysicsEnvironment *physEnv;
+  const float *origins;
+  const float *targets;
+  unsigned int mask;
+  float *hits;
+  KX_GameObject **objects;
+};
+
+static void ray_cast_batch_task(void *__restrict userdata,
+                                const int i,
+                                const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  RayCastBatchData *data = (RayCastBatchData *)userdata;
+  const MT_Vector3 from(&data->origins[i * 3]);
+  const MT_Vector3 to(&data->targets[i * 3]);
+  float *hit = &data->hits[i * rayCastBatchStride];
+
+  KX_BatchRayCast callback(data->mask);
+  if (!MT_fuzzyZero(to - from) && KX_RayCast::RayTest(data->physEnv, from, to, callback) &&
+      callback.m_hitObject) {
+    callback.m_hitPoint.getValue(&hit[0]);
+    callback.m_hitNormal.getValue(&hit[3]);
+    hit[6] = (callback.m_hitPoint - from).length() / (to - from).length();
+    data->objects[i] = callback.m_hitObject;
+  }
+  else {
+    to.getValue(&hit[0]);
+    zero_v3(&hit[3]);
+    hit[6] = 1.0f;
+    data->objects[i] = nullptr;
+  }
+}
+
+/** Parse the arguments of rayCastBatch and rayCastBatchAsync.
+ * \return False if the arguments are invalid, the buffers are released in this case.
+ */
+static bool parse_ray_cast_batch(PyObject *args,
+                                 const char *name,
+                                 Py_buffer &originsView,
+                                 Py_buffer &targetsView,
+                                 size_t &count,
+                                 unsigned int &mask)
+{
+  PyObject *pyorigins;
+  PyObject *pytargets;
+  int pymask = (1 << OB_MAX_COL_MASKS) - 1;
+
+  const std::string format = std::string("OO|i:") + name;
+  if (!PyArg_ParseTuple(args, format.c_str(), &pyorigins, &pytargets, &pymask)) {
+    return false;
+  }
+
+  const std::string prefix = std::string("scene.") + name + "(origins, targets, mask): KX_Scene";
+  if (pymask == 0 || pymask & ~((1 << OB_MAX_COL_MASKS) - 1)) {
+    PyErr_Format(PyExc_TypeError,
+                 "%s, mask argument must be a int bitfield, 0 < mask < %i",
+                 prefix.c_str(),
+                 (1 << OB_MAX_COL_MASKS));
+    return false;
+  }
+  mask = pymask;
+
+  // The number of rays is deduced from the size of the origins buffer.
+  if (!get_float_buffer(pyorigins, originsView, false, 0, (prefix + ", origins").c_str())) {
+    return false;
+  }
+  count = originsView.len / (sizeof(float) * 3);
+
+  if (!get_float_buffer(
+          pytargets, targetsView, false, count * 3, (prefix + ", targets").c_str())) {
+    PyBuffer_Release(&originsView);
+    return false;
+  }
+
+  return true;
+}
+
+/// Cast all the rays of data, in parallel if there's enough of them.
+static void ray_cast_batch(RayCastBatchData &data, size_t count)
+{
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (count >= rayCastBatchParallelThreshold);
+  settings.min_iter_per_thread = rayCastBatchParallelThreshold;
+  BLI_task_parallel_range(0, count, &data, ray_cast_batch_task, &settings);
+}
+
+/// Return the python list of the hit objects of a batch, None for the missed rays.
+static PyObject *ray_cast_batch_objects(const std::vector<KX_GameObject *> &objects)
+{
+  PyObject *pyobjects = PyList_New(objects.size());
+  for (size_t i = 0, size = objects.size(); i < size; ++i) {
+    if (objects[i]) {
+      PyList_SET_ITEM(pyobjects, i, objects[i]->GetProxy());
+    }
+    else {
+      Py_INCREF(Py_None);
+      PyList_SET_ITEM(pyobjects, i, Py_None);
+    }
+  }
+
+  return pyobjects;
+}
+
+/// Future of rayCastBatchAsync, the rays are copied at submission.
+class KX_RayCastBatchFuture : public KX_TaskFuture {
+ private:
+  PHY_IPhysicsEnvironment *m_physicsEnvironment;
+  std::vector<float> m_origins;
+  std::vector<float> m_targets;
+  unsigned int m_mask;
+  std::vector<float> m_hits;
+  std::vector<KX_GameObject *> m_objects;
+
+ public:
+  KX_RayCastBatchFuture(PHY_IPhysicsEnvironment *physEnv,
+                        const float *origins,
+                        const float *targets,
+                        size_t count,
+                        unsigned int mask)
+      : m_physicsEnvironment(physEnv),
+        m_origins(origins, origins + count * 3),
+        m_targets(targets, targets + count * 3),
+        m_mask(mask)
+  {
+  }
+
+  virtual void Run()
+  {
+    const size_t count = m_origins.size() / 3;
+    m_hits.resize(count * rayCastBatchStride);
+    m_objects.resize(count);
+
+    RayCastBatchData data = {m_physicsEnvironment,
+                             m_origins.data(),
+                             m_targets.data(),
+                             m_mask,
+                             m_hits.data(),
+                             m_objects.data()};
+    ray_cast_batch(data, count);
+  }
+
+  virtual PyObject *ConvertResult()
+  {
+    PyObject *pyhits = PyByteArray_FromStringAndSize((const char *)m_hits.data(),
+                                                     m_hits.size() * sizeof(float));
+    if (!pyhits) {
+      PyErr_Clear();
+      return nullptr;
+    }
+
+    PyObject *result = Py_BuildValue("NN", pyhits, ray_cast_batch_objects(m_objects));
+
+    // The game objects can be freed from now.
+    m_objects.clear();
+    m_hits.clear();
+
+    return result;
+  }
+};
+
+EXP_PYMETHODDEF_DOC(KX_Scene,
+                    rayCastBatch,
+                    "rayCastBatch(origins, targets, mask=0xFFFF)\n"
+                    "Cast many rays at once and return the float32 buffer of the hit positions, "
+                    "normals and fractions and the list of hit objects.\n")
+{
+  Py_buffer originsView;
+  Py_buffer targetsView;
+  size_t count;
+  unsigned int mask;
+  if (!parse_ray_cast_batch(args, "rayCastBatch", originsView, targetsView, count, mask)) {
+    return nullptr;
+  }
+
+  PyObject *pyhits = PyByteArray_FromStringAndSize(nullptr,
+                                                   count * rayCastBatchStride * sizeof(float));
+  if (!pyhits) {
+    PyBuffer_Release(&originsView);
+    PyBuffer_Release(&targetsView);
+    return nullptr;
+  }
+
+  std::vector<KX_GameObject *> objects(count);
+  RayCastBatchData data = {m_physicsEnvironment,
+                           (const float *)originsView.buf,
+                           (const float *)targetsView.buf,
+                           mask,
+                           (float *)PyByteArray_AS_STRING(pyhits),
+                           objects.data()};
+
+  /* The bullet ray tests only read the collision world, python and the physics
+   * simulation are not running during the casts. */
+  ray_cast_batch(data, count);
+
+  PyBuffer_Release(&originsView);
+  PyBuffer_Release(&targetsView);
+
+  return Py_BuildValue("NN", pyhits, ray_cast_batch_objects(objects));
+}
+
+EXP_PYMETHODDEF_DOC(KX_Scene,
+                    rayCastBatchAsync,
+                    "rayCastBatchAsync(origins, targets, mask=0xFFFF)\n"
+                    "Submit many rays to cast after the physics update and return a future "
+                    "of the result of rayCastBatch.\n")
+{
+  Py_buffer originsView;
+  Py_buffer targetsView;
+  size_t count;
+  unsigned int mask;
+  if (!parse_ray_cast_batch(args, "rayCastBatchAsync", originsView, targetsView, count, mask)) {
+    return nullptr;
+  }
+
+  KX_RayCastBatchFuture *future = new KX_RayCastBatchFuture(m_physicsEnvironment,
+                                                            (const float *)originsView.buf,
+                                                            (const float *)targetsView.buf,
+                                                            count,
+                                                            mask);
+
+  PyBuffer_Release(&originsView);
+  PyBuffer_Release(&targetsView);
+
+  AddTask(future);
+
+  // Python owns the initial reference of the future.
+  return future->NewProxy(true);
+}
+
+EXP_PYMETHODDEF_DOC(KX_Scene,
+                    addStreamingCell,
+                    "addStreamingCell(data, position, loadDistance, unloadDistance=0.0, "
+                    "priority=0)\n"
+                    "Add a library path or a collection loaded when a camera is near the "
+                    "position.\n")
+{
+  PyObject *pydata;
+  PyObject *pypos;
+  float loadDistance;
+  float unloadDistance = 0.0f;
+  int priority = 0;
+
+  if (!PyArg_ParseTuple(args,
+                        "OOf|fi:addStreamingCell",
+                        &pydata,
+                        &pypos,
+                        &loadDistance,
+                        &unloadDistance,
+                        &priority)) {
+    return nullptr;
+  }
+
+  MT_Vector3 center;
+  if (!PyVecTo(pypos, center)) {
+    return nullptr;
+  }
+
+  bool added;
+  if (PyUnicode_Check(pydata)) {
+    added = m_worldStreamer->AddLibraryCell(
+        _PyUnicode_AsString(pydata), center, loadDistance, unloadDistance, priority);
+  }
+  else {
+    ID *id;
+    if (!pyrna_id_FromPyObject(pydata, &id) || GS(id->name) != ID_GR) {
+      PyErr_SetString(PyExc_TypeError,
+                      "scene.addStreamingCell(data, ...): KX_Scene, expected a library path or "
+                      "a bpy.types.Collection");
+      return nullptr;
+    }
+    added = m_worldStreamer->AddCollectionCell(
+        (Collection *)id, center, loadDistance, unloadDistance, priority);
+  }
+
+  if (!added) {
+    PyErr_SetString(PyExc_ValueError,
+                    "scene.addStreamingCell(data, ...): KX_Scene, the cell already exists");
+    return nullptr;
+  }
+
+  Py_RETURN_NONE;
+}
+
+EXP_PYMETHODDEF_DOC(KX_Scene,
+                    removeStreamingCell,
+                    "removeStreamingCell(name)\n"
+                    "Remove a streaming cell and free its data.\n")
+{
+  const char *name;
+  if (!PyArg_ParseTuple(args, "s:removeStreamingCell", &name)) {
+    return nullptr;
+  }
+
+  if (!m_worldStreamer->RemoveCell(name)) {
+    PyErr_Format(PyExc_ValueError,
+                 "scene.removeStreamingCell(name): KX_Scene, cell \"%s\" not found or loading",
+                 name);
+    return nullptr;
+  }
+
+  Py_RETURN_NONE;
+}
+
+EXP_PYMETHODDEF_DOC(KX_Scene,
+                    getStreamingCellState,
+                    "getStreamingCellState(name)\n"
+                    "Return the loading state of a streaming cell.\n")
+{
+  const char *name;
+  if (!PyArg_ParseTuple(args, "s:getStreamingCellState", &name)) {
+    return nullptr;
+  }
+
+  KX_WorldStreamer::CellState state;
+  if (!m_worldStreamer->GetCellState(name, state)) {
+    PyErr_Format(PyExc_ValueError,
+                 "scene.getStreamingCellState(name): KX_Scene, cell \"%s\" not found",
+                 name);
+    return nullptr;
+  }
+
+  return PyLong_FromLong(state);
+}
+
+EXP_PYMETHODDEF_DOC(KX_Scene,
+                    prewarmMeshes,
+                    "prewarmMeshes(objects=None)\n"
+                    "Convert the deferred geometry of the meshes of the objects,\n"
+                    "all the inactive objects if None.\n")
+{
+  PyObject *pyobjects = Py_None;
+  if (!PyArg_ParseTuple(args, "|O:prewarmMeshes", &pyobjects)) {
+    return nullptr;
+  }
+
+  std::vector<KX_GameObject *> objects;
+  if (pyobjects == Py_None) {
+    for (KX_GameObject *gameobj : m_inactivelist) {
+      objects.push_back(gameobj);
+    }
+  }
+  else if (!convert_python_to_game_objects(
+               m_logicmgr, pyobjects, objects, "scene.prewarmMeshes(objects): KX_Scene")) {
+    return nullptr;
+  }
+
+  for (KX_GameObject *gameobj : objects) {
+    gameobj->ConvertMeshGeometry();
+  }
+
+  Py_RETURN_NONE;
+}
+
+EXP_PYMETHODDEF_DOC(KX_Scene,
+                    saveState,
+                    "saveState(filepath)\n"
+                    "Save the state of the objects in a binary file written in the background.\n")
+{
+  const char *path;
+  if (!PyArg_ParseTuple(args, "s:saveState", &path)) {
+    return nullptr;
+  }
+
+  char filepath[FILE_MAX];
+  BLI_strncpy(filepath, path, sizeof(filepath));
+  BLI_path_abs(filepath, KX_GetMainPath().c_str());
+
+  KX_GetActiveEngine()->GetStateManager()->Save(this, filepath);
+
+  Py_RETURN_NONE;
+}
+
+EXP_PYMETHODDEF_DOC(KX_Scene,
+                    loadState,
+                    "loadState(filepath)\n"
+                    "Load the state of the objects from a file written by saveState.\n")
+{
+  const char *path;
+  if (!PyArg_ParseTuple(args, "s:loadState", &path)) {
+    return nullptr;
+  }
+
+  char filepath[FILE_MAX];
+  BLI_strncpy(filepath, path, sizeof(filepath));
+  BLI_path_abs(filepath, KX_GetMainPath().c_str());
+
+  return PyBool_FromLong(KX_GetActiveEngine()->GetStateManager()->Load(this, filepath));
+}
+
 bool ConvertPythonToScene(PyObject *value,
                           KX_Scene **scene,
                           bool py_none_ok,
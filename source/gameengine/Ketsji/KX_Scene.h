@@ -32,20 +32,29 @@
 #pragma once
 
 #include <list>
+#include <map>
 #include <set>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
+#include "CM_TimerWheel.h"
 #include "DNA_ID.h"  // For IDRecalcFlag
 
 #include "EXP_PyObjectPlus.h"
 #include "EXP_Value.h"
+#include "BL_PoseCache.h"
+#include "KX_ActivityCullingGrid.h"
+#include "KX_IpoBatch.h"
 #include "KX_PhysicsEngineEnums.h"
 #include "KX_PythonProxy.h"
 #include "KX_PythonProxyManager.h"
+#include "KX_ReplicationManager.h"
 #include "MT_Transform.h"
 #include "RAS_FramingManager.h"
 #include "RAS_Rect.h"
 #include "SCA_IScene.h"
+#include "SG_BBoxList.h"
 #include "SG_Frustum.h"
 #include "SG_Node.h"
 
@@ -65,12 +74,16 @@ class SCA_ISystem;
 class SCA_IInputDevice;
 class KX_NetworkMessageScene;
 class KX_NetworkMessageManager;
+class KX_NetworkTransport;
 class SG_Node;
 class SG_Node;
 class KX_Camera;
+class KX_CollisionEventManager;
 class KX_FontObject;
 class KX_GameObject;
 class KX_LightObject;
+class KX_LibLoadStatus;
+class KX_MemoryReport;
 class RAS_MeshObject;
 class RAS_BucketManager;
 class RAS_MaterialBucket;
@@ -82,11 +95,18 @@ class RAS_2DFilterManager;
 class KX_2DFilterManager;
 class BL_BlenderSceneConverter;
 struct KX_ClientObjectInfo;
+class KX_LightManager;
 class KX_ObstacleSimulation;
+class KX_ParticleManager;
+class KX_StaticBatchManager;
+class KX_WorldStreamer;
+class KX_TaskFuture;
 struct TaskPool;
 
 /*********EEVEE INTEGRATION************/
 struct bNodeTree;
+struct GSet;
+struct Main;
 struct Mesh;
 struct Object;
 /**************************************/
@@ -111,6 +131,19 @@ class KX_Scene : public KX_PythonProxy, public SCA_IScene {
     double curtime;
   };
 
+  /// Armature updated by the animation pool.
+  struct AnimationTaskData {
+    KX_GameObject *gameobj;
+    /// The armature pose was changed and must be tagged for the depsgraph.
+    bool poseUpdated;
+  };
+
+  /// A view drawn from the draw caches populated for an other camera.
+  struct RenderView {
+    KX_Camera *m_camera;
+    RAS_Rect m_viewport;
+  };
+
  private:
   Py_Header
 
@@ -138,10 +171,77 @@ class KX_Scene : public KX_PythonProxy, public SCA_IScene {
   std::vector<KX_GameObject *> m_kxobWithLod;
   std::map<Object *, char> m_obRestrictFlags;
   bool m_collectionRemap;
+  /// The base flags changed and the view layer must be synchronized before the next render.
+  bool m_layerCollectionSync;
+  /// Objects were added or deleted and the depsgraph relations must be rebuilt.
+  bool m_relationsUpdate;
+  /// Game objects drawn as instances of the same original blender object.
+  struct InstanceGroup {
+    /// Empty object generating the instances in the depsgraph, see OB_DUPLIGAME.
+    Object *m_instancer;
+    std::vector<KX_GameObject *> m_objects;
+    /// World matrices of the visible objects, 16 floats per instance.
+    std::vector<float> m_matrices;
+    /// The objects were added, removed, moved or hidden since the last gathering.
+    bool m_dirty;
+  };
+  std::map<Object *, InstanceGroup> m_instanceGroups;
+  /// The replications create instances instead of blender object copies.
+  bool m_instancedReplication;
+  /** Incremented each time the depsgraph has something to evaluate before a
+   * render pass, used to know if a camera viewport can be retained. */
+  unsigned int m_drawUpdateCount;
   std::vector<BackupObj *> m_backupObList;
   int m_backupOverlayFlag;
   int m_backupOverlayGameFlag;
 
+  /** IDs to tag for update, an ID is added once per frame with the union of its recalc
+   * flags. The index of the IDs makes the additions constant time.
+   */
+  template<class IDType> class IdUpdateList {
+   public:
+    using Entry = std::pair<IDType *, IDRecalcFlag>;
+
+   private:
+    std::vector<Entry> m_entries;
+    std::unordered_map<IDType *, unsigned int> m_indices;
+
+   public:
+    void Add(IDType *id, IDRecalcFlag flag)
+    {
+      const std::pair<typename std::unordered_map<IDType *, unsigned int>::iterator, bool> it =
+          m_indices.emplace(id, m_entries.size());
+      if (it.second) {
+        m_entries.emplace_back(id, flag);
+      }
+      else {
+        IDRecalcFlag &entryFlag = m_entries[it.first->second].second;
+        entryFlag = (IDRecalcFlag)(entryFlag | flag);
+      }
+    }
+
+    void Clear()
+    {
+      m_entries.clear();
+      m_indices.clear();
+    }
+
+    unsigned int GetSize() const
+    {
+      return m_entries.size();
+    }
+
+    typename std::vector<Entry>::const_iterator begin() const
+    {
+      return m_entries.begin();
+    }
+
+    typename std::vector<Entry>::const_iterator end() const
+    {
+      return m_entries.end();
+    }
+  };
+
   /* Objects to update at each render pass */
   /* Note: We could try to get the right render pass where
    * we need to update these objects but it would make
@@ -149,15 +249,25 @@ class KX_Scene : public KX_PythonProxy, public SCA_IScene {
    * because the other render pass can contain the same objects
    * which need to be notified + flushed again.
    */
-  std::vector<std::pair<Object *, IDRecalcFlag>> m_extraObjectsToUpdateInAllRenderPasses;
-  std::vector<std::pair<Mesh *, IDRecalcFlag>> m_meshesToUpdateInAllRenderPasses;
-  std::vector<std::pair<Object *, IDRecalcFlag>> m_extraObjectsToUpdateInOverlayPass;
-  std::vector<bNodeTree *> m_nodeTreesToUpdateInAllRenderPasses;
+  IdUpdateList<Object> m_extraObjectsToUpdateInAllRenderPasses;
+  IdUpdateList<Mesh> m_meshesToUpdateInAllRenderPasses;
+  IdUpdateList<Object> m_extraObjectsToUpdateInOverlayPass;
+  IdUpdateList<bNodeTree> m_nodeTreesToUpdateInAllRenderPasses;
+  /** Objects whose geometry updates can be held back while they are outside the views, with
+   * whether an update is held back.
+   */
+  std::unordered_map<Object *, std::pair<KX_GameObject *, bool>> m_deferrableGeometryObjects;
   /*************************************************/
 
   RAS_BucketManager *m_bucketmanager;
 
-  std::vector<KX_GameObject *> m_tempObjectList;
+  /** Expiry of the objects added with a limited life span, only the objects expiring in a
+   * frame are touched.
+   */
+  CM_TimerWheel<KX_GameObject *> m_timeBombs;
+  /// Timer of each object with a limited life span.
+  std::unordered_map<KX_GameObject *, unsigned int> m_timeBombTimers;
+  std::vector<KX_GameObject *> m_expiredTimeBombs;
 
   /**
    * The list of objects which have been removed during the
@@ -166,12 +276,32 @@ class KX_Scene : public KX_PythonProxy, public SCA_IScene {
    */
   std::vector<KX_GameObject *> m_euthanasyobjects;
 
+  /** The removals are batched between BeginBatchedRemoval and EndBatchedRemoval,
+   * NewRemoveObject then defers the list removals, the releases and the deletion of
+   * the nodes and blender objects to compact each list only once.
+   */
+  bool m_batchedRemoval;
+  /// Objects removed in the batch, alive until the end of the batch.
+  std::unordered_set<KX_GameObject *> m_batchRemovedObjects;
+  /// Scene graph nodes of the removed objects, deleted after the objects.
+  std::vector<SG_Node *> m_batchRemovedNodes;
+  /// Replica blender objects deleted together at the end of the batch.
+  std::vector<Object *> m_batchDeletedBlenderObjects;
+
   EXP_ListValue<KX_GameObject> *m_objectlist;
   EXP_ListValue<KX_GameObject> *m_parentlist;  // all 'root' parents
   EXP_ListValue<KX_LightObject> *m_lightlist;
   EXP_ListValue<KX_GameObject> *m_inactivelist;  // all objects that are not in the active layer
   /// All animated objects, no need of EXP_ListValue because the list isn't exposed in python.
   std::vector<KX_GameObject *> m_animatedlist;
+  /** Objects with a transform to notify to the depsgraph in the next render passes,
+   * filled when the scene graph node of an object becomes dirty for render.
+   */
+  std::vector<KX_GameObject *> m_transformUpdateObjects;
+  /// Objects of m_transformUpdateObjects whose evaluated objects are synchronized in parallel.
+  std::vector<KX_GameObject *> m_evaluatedTransformObjects;
+  /// The evaluated objects of m_evaluatedTransformObjects, nullptr for objects without one.
+  std::vector<Object *> m_evaluatedTransformObjectsEval;
 
   /// The set of cameras for this scene
   EXP_ListValue<KX_Camera> *m_cameralist;
@@ -182,6 +312,20 @@ class KX_Scene : public KX_PythonProxy, public SCA_IScene {
                       // the Dlist is not object that must be updated
                       // the Qlist is for objects that needs to be rescheduled
                       // for updates after udpate is over (slow parent, bone parent)
+  /** Scheduled nodes updated in parallel and serially by UpdateParents,
+   * kept as member to avoid allocation every update.
+   */
+  std::vector<SG_Node *> m_parallelUpdateNodes;
+  std::vector<SG_Node *> m_serialUpdateNodes;
+
+  /// State of the merge of this scene into another scene, see MergeScenePart.
+  struct MergeState {
+    bool m_started;
+    unsigned int m_objectIndex;
+    unsigned int m_inactiveIndex;
+    /// All merged physics objects (needed by ReplicateConstraints).
+    std::vector<KX_GameObject *> m_physicsObjects;
+  } m_mergeState;
 
   /**
    * Various SCA managers used by the scene
@@ -193,11 +337,16 @@ class KX_Scene : public KX_PythonProxy, public SCA_IScene {
 
   KX_PythonProxyManager m_proxyManager;
 
+  /// Tasks submitted from python and run after the logic and physics of the frame.
+  std::vector<KX_TaskFuture *> m_tasks;
+
   /**
    * physics engine abstraction
    */
   // e_PhysicsEngine m_physicsEngine; //who needs this ?
   class PHY_IPhysicsEnvironment *m_physicsEnvironment;
+  /// Collision event manager of the physics environment, owned by the logic manager.
+  KX_CollisionEventManager *m_collisionEventManager;
 
   /**
    * The name of the scene
@@ -241,6 +390,17 @@ class KX_Scene : public KX_PythonProxy, public SCA_IScene {
    * have been updated. This stores a list of the new objects.
    */
   std::vector<KX_GameObject *> m_logicHierarchicalGameObjects;
+  /// The original objects of m_logicHierarchicalGameObjects, in the same order.
+  std::vector<KX_GameObject *> m_logicHierarchicalOriginals;
+
+  /** Position of the bricks linked to each controller of an original object in the brick
+   * list of their owner, filled by the first replication and checked by the next ones.
+   */
+  struct LogicLinkTemplate {
+    std::vector<std::vector<unsigned int>> m_sensors;
+    std::vector<std::vector<unsigned int>> m_actuators;
+  };
+  std::map<SCA_IObject *, LogicLinkTemplate> m_logicLinkTemplates;
 
   /**
    * This temporary variable will contain the list of
@@ -269,6 +429,20 @@ class KX_Scene : public KX_PythonProxy, public SCA_IScene {
    * Toggle to enable or disable activity culling.
    */
   bool m_activityCulling;
+  /// Grid of the objects used to skip the objects far from the activity culling radii.
+  KX_ActivityCullingGrid m_activityCullingGrid;
+
+  /// Replication of the object transforms with the other engine instances.
+  KX_ReplicationManager m_replicationManager;
+
+  /// Toggle to skip the pose evaluation of the armatures outside of the camera views.
+  bool m_animationCulling;
+  /** Distance from the cameras beyond which the armatures evaluate their pose only once
+   * every m_animationLodInterval frames, 0 to always evaluate it. */
+  float m_animationLodDistance;
+  int m_animationLodInterval;
+  /// Number of animation updates, used to spread the distant armatures over the frames.
+  unsigned int m_animationFrame;
 
   /**
    * Toggle to enable or disable culling via DBVT broadphase of Bullet.
@@ -280,6 +454,14 @@ class KX_Scene : public KX_PythonProxy, public SCA_IScene {
    */
   int m_dbvt_occlusion_res;
 
+  /// Also cull the objects hidden in the depth of the previous render of a camera.
+  bool m_gpuOcclusionCulling;
+
+  /// Original blender objects culled in the current render pass, skipped by the draw loop.
+  struct GSet *m_culledObjects;
+  /// Original blender objects moved by the game, the shadows of the others can be cached.
+  struct GSet *m_dynamicObjects;
+
   /**
    * The framing settings used by this scene
    */
@@ -300,17 +482,47 @@ class KX_Scene : public KX_PythonProxy, public SCA_IScene {
   struct Scene *m_blenderScene;
 
   KX_2DFilterManager *m_filterManager;
+  /** Frame buffer of the viewports not owned by a camera, the viewport of the constructor
+   * render or of the viewport render. */
+  RAS_FrameBuffer *m_viewportFrameBuffer;
 
   KX_ObstacleSimulation *m_obstacleSimulation;
 
+  /// Loader of the world cells near the cameras.
+  KX_WorldStreamer *m_worldStreamer;
+  /// Merged meshes of the objects never moved.
+  KX_StaticBatchManager *m_staticBatchManager;
+  /// GPU particles emitted by the objects.
+  KX_ParticleManager *m_particleManager;
+  /// Lights changed in game and culled over the light budget.
+  KX_LightManager *m_lightManager;
+
   AnimationPoolData m_animationPoolData;
   TaskPool *m_animationPool;
+  /// Armatures updated in the animation pool, kept to avoid allocations every frame.
+  std::vector<AnimationTaskData> m_animationTasks;
+  /// World bounds of the mesh children of the animated armatures, tested together.
+  SG_BBoxList m_armatureBounds;
+  /// Bitset of the bounds inside one of the frustums.
+  std::vector<uint32_t> m_armatureBoundsVisible;
+  /// Range of bounds of each armature, an empty range for an armature always visible.
+  std::vector<std::pair<unsigned int, unsigned int>> m_armatureBoundsRanges;
+  /// Visibility of the animated armatures, in the order of the animated objects.
+  std::vector<bool> m_armaturesVisible;
+  /// Poses shared between the armatures playing the same action frame.
+  BL_PoseCache m_poseCache;
+  /// Transform IPO controllers of the objects with non armature actions, evaluated together.
+  KX_IpoBatch m_ipoBatch;
 
   /**
    * LOD Hysteresis settings
    */
   bool m_isActivedHysteresis;
   int m_lodHysteresisValue;
+  /// Maximum number of lod mesh switches per camera render, 0 for no limit.
+  int m_lodSwitchBudget;
+  /// Index of the object in m_kxobWithLod to update first, the first deferred switch.
+  unsigned int m_lodUpdateOffset;
 
   // Convert objects list & collection helpers
   void convert_blender_objects_list_synchronous(std::vector<Object *> objectslist);
@@ -327,17 +539,26 @@ class KX_Scene : public KX_PythonProxy, public SCA_IScene {
 
   /******************EEVEE INTEGRATION************************/
   void ConvertBlenderObject(struct Object *ob);
-  void ConvertBlenderObjectsList(std::vector<Object *> objectslist, bool asynchronous);
-  void ConvertBlenderCollection(struct Collection *co, bool asynchronous);
+  /// Return the status of the conversion when asynchronous, else nullptr.
+  KX_LibLoadStatus *ConvertBlenderObjectsList(std::vector<Object *> objectslist,
+                                              bool asynchronous);
+  KX_LibLoadStatus *ConvertBlenderCollection(struct Collection *co, bool asynchronous);
   void ConvertBlenderAction(struct bAction *act);
 
   bool m_isRuntime;  // Too lazy to put that in protected
   std::vector<Object *> m_hiddenObjectsDuringRuntime;
+  /// Hidden blender object copies of each original object, reused by the next replications.
+  std::map<Object *, std::vector<Object *>> m_replicaPool;
 
+  /** Render the scene for a camera.
+   * \param views The views drawn with the draw caches populated once, the camera then only owns
+   * the GPU viewport and the views give the matrices and the areas. Empty to draw the camera.
+   */
   void RenderAfterCameraSetup(KX_Camera *cam,
                               const RAS_Rect &viewport,
                               bool is_overlay_pass,
-                              bool is_last_render_pass);
+                              bool is_last_render_pass,
+                              const std::vector<RenderView> &views);
   void RenderAfterCameraSetupImageRender(KX_Camera *cam, const struct rcti *window);
 
   void SetLastReplicatedParentObject(Object *ob);
@@ -345,9 +566,15 @@ class KX_Scene : public KX_PythonProxy, public SCA_IScene {
   void ResetLastReplicatedParentObject();
   Object *GetGameDefaultCamera();
   void ReinitBlenderContextVariables();
+  /** Make the blender scene the scene of the context and of the window, used when a scene
+   * converted ahead is activated or after the conversion of another scene.
+   */
+  void ActivateBlenderContext();
   void ConfigureOverlays();
   void AddOverlayCollection(KX_Camera *overlay_cam, struct Collection *collection);
   void RemoveOverlayCollection(struct Collection *collection);
+  /// Append the objects of the overlay collections, each object once.
+  void GetOverlayObjects(std::vector<struct Object *> &objects) const;
   void SetCurrentGPUViewport(struct GPUViewport *viewport);
   struct GPUViewport *GetCurrentGPUViewport();
   void SetInitMaterialsGPUViewport(struct GPUViewport *viewport);
@@ -363,27 +590,83 @@ class KX_Scene : public KX_PythonProxy, public SCA_IScene {
   void BackupRestrictFlag(Object *ob, char restrictFlag);
   void RestoreRestrictFlags();
   void TagForCollectionRemap();
+  void TagForLayerCollectionSync();
+  void TagForRelationsUpdate();
+  /// Apply the tagged collection and depsgraph relation updates at once.
+  void FlushStructureUpdates(Main *bmain);
+  /// Return a hidden copy of ob made visible again or nullptr if none is pooled.
+  Object *PopReplicaObject(Object *ob);
+  /** Hide a copy of ob and keep it for the next replication of ob.
+   * \return False if the copy can't be hidden and must be deleted.
+   */
+  bool PushReplicaObject(Object *ob, Object *replica);
+  /// Delete all the pooled copies.
+  void FreeReplicaPool();
+  bool IsInstancedReplication() const;
+  /// Register a replica without blender object copy in the instance group of its blender object.
+  void AddInstanceObject(KX_GameObject *gameobj);
+  void RemoveInstanceObject(KX_GameObject *gameobj);
+  /// Gather again the matrices of the instance group of gameobj before the next render.
+  void TagInstanceGroupUpdate(KX_GameObject *gameobj);
+  /** Write the matrices of the modified instance groups to their instancer.
+   * \return True if any instance group changed.
+   */
+  bool UpdateInstanceGroups();
+  /// Delete the instancers of the instance groups without objects.
+  void FreeEmptyInstanceGroups();
   KX_GameObject *GetGameObjectFromObject(Object *ob);
   void BackupObjectsObmat(BackupObj *back);
   void RestoreObjectsObmat();
   void TagForObmatRestore();
   bool OrigObCanBeTransformedInRealtime(Object *ob);
+  /** Compensate the parent inverse matrix of the children of ob, children are
+   * the scene graph children of the game object using ob.
+   */
   void IgnoreParentTxBGE(struct Main *bmain,
                          struct Depsgraph *depsgraph,
                          Object *ob,
-                         std::vector<Object *> children);
+                         const NodeList &children);
   bool SomethingIsMoving();
-  void AppendToExtraObjectsToUpdateInAllRenderPasses(Object *ob, IDRecalcFlag flag);
+  /// Register an object moved by the game, its shadow is not cached anymore.
+  void AddDynamicObject(Object *ob);
+  void RemoveDynamicObject(Object *ob);
+  /** \param gameobj The game object of ob when its geometry update can be held back while it is
+   * outside the views, see KX_KetsjiEngine::DEFERRED_GEOMETRY.
+   */
+  void AppendToExtraObjectsToUpdateInAllRenderPasses(Object *ob,
+                                                     IDRecalcFlag flag,
+                                                     KX_GameObject *gameobj = nullptr);
   void AppendToMeshesToUpdateInAllRenderPasses(Mesh *me, IDRecalcFlag flag);
   void AppendToNodeTreesToUpdateInAllRenderPasses(bNodeTree *ntree);
   void AppendToExtraObjectsToUpdateInOverlayPass(Object *ob, IDRecalcFlag flag);
-  void TagForExtraObjectsUpdate(Main *bmain, KX_Camera *cam);
+  /** \param views The views drawn by cam, the geometry updates held back are flushed for the
+   * objects inside one of the views.
+   */
+  void TagForExtraObjectsUpdate(Main *bmain,
+                                KX_Camera *cam,
+                                const std::vector<RenderView> &views = {});
   KX_GameObject *AddDuplicaObject(KX_GameObject *gameobj,
                                   KX_GameObject *reference,
                                   float lifespan);
+  /** Same as AddReplicaObject but the mesh objects without hierarchy are drawn
+   * as instances of their original blender object instead of being copied.
+   */
+  KX_GameObject *AddInstancedReplicaObject(KX_GameObject *gameobj,
+                                           KX_GameObject *reference,
+                                           float lifespan);
   void OverlayPassDisableEffects(struct Depsgraph *depsgraph,
                                  KX_Camera *kxcam,
                                  bool isOverlayPass);
+  /** Return true if the last draw of the camera viewport can be reused
+   * because nothing changed since, else register the samples drawn. */
+  bool UpdateRetainedDraw(KX_Camera *cam, const struct rcti *window, int samples);
+  /// Draw the fast text objects of the pass over the render of the camera.
+  void RenderFastTexts(KX_Camera *cam,
+                       RAS_FrameBuffer *target,
+                       const struct rcti *window,
+                       bool is_overlay_pass);
+  /// Redraw the retained camera viewports at the next render.
+  void InvalidateRetainedDraws();
   /***************End of EEVEE INTEGRATION**********************/
 
   RAS_BucketManager *GetBucketManager() const;
@@ -394,6 +677,7 @@ class KX_Scene : public KX_PythonProxy, public SCA_IScene {
    */
   static bool KX_ScenegraphUpdateFunc(SG_Node *node, void *gameobj, void *scene);
   static bool KX_ScenegraphRescheduleFunc(SG_Node *node, void *gameobj, void *scene);
+  static void KX_ScenegraphDirtyRenderFunc(SG_Node *node, void *gameobj, void *scene);
   void UpdateParents(double curtime);
   void DupliGroupRecurse(KX_GameObject *groupobj, int level);
   bool IsObjectInGroup(KX_GameObject *gameobj)
@@ -410,12 +694,31 @@ class KX_Scene : public KX_PythonProxy, public SCA_IScene {
   void RemoveObject(KX_GameObject *gameobj);
   void RemoveDupliGroup(KX_GameObject *gameobj);
   void DelayedRemoveObject(KX_GameObject *gameobj);
+  /// Remove an object after a life span in seconds.
+  void AddTimeBomb(KX_GameObject *gameobj, float lifespan);
+  void RemoveTimeBomb(KX_GameObject *gameobj);
+  /** Get the life left to an object added with a limited life span.
+   * 
+eturn False if the object lives forever.
+   */
+  bool GetTimeBombLife(KX_GameObject *gameobj, float &life) const;
 
   bool NewRemoveObject(KX_GameObject *gameobj);
+  /// Batch the object removals until EndBatchedRemoval.
+  void BeginBatchedRemoval();
+  /// Remove the objects from all the lists at once and free them.
+  void EndBatchedRemoval();
+  /// Delete the blender object of a removed replica, at the end of the removal batch if any.
+  void DeleteBlenderObject(Object *blenderobj);
   void ReplaceMesh(KX_GameObject *gameobj, RAS_MeshObject *mesh, bool use_gfx, bool use_phys);
 
   void AddAnimatedObject(KX_GameObject *gameobj);
 
+  /// Register an object to notify its transform to the depsgraph in the next render passes.
+  void AddTransformUpdateObject(KX_GameObject *gameobj);
+  /// Unregister the objects which aren't moving anymore, called after the last render pass.
+  void RemoveStaticTransformUpdateObjects();
+
   /**
    * \section Logic stuff
    * Initiate an update of the logic system.
@@ -423,6 +726,8 @@ class KX_Scene : public KX_PythonProxy, public SCA_IScene {
   void LogicBeginFrame(double curtime, double framestep);
   void LogicUpdateFrame(double curtime);
   void UpdateAnimations(double curtime);
+  BL_PoseCache &GetPoseCache();
+  KX_IpoBatch &GetIpoBatch();
 
   void LogicEndFrame();
 
@@ -437,6 +742,13 @@ class KX_Scene : public KX_PythonProxy, public SCA_IScene {
 
   KX_PythonProxyManager &GetPythonProxyManager();
 
+  /// Register a task to run at the end of the frame, the scene holds a reference on it.
+  void AddTask(KX_TaskFuture *task);
+  /** Run all the pending tasks in parallel and convert their results.
+   * Must be called when neither python nor the physics are accessing the scene.
+   */
+  void RunTasks();
+
   EXP_ListValue<KX_Camera> *GetCameraList() const;
   void SetCameraList(EXP_ListValue<KX_Camera> *camList);
   EXP_ListValue<KX_FontObject> *GetFontList() const;
@@ -481,6 +793,12 @@ class KX_Scene : public KX_PythonProxy, public SCA_IScene {
   void SetNetworkMessageScene(KX_NetworkMessageScene *newScene);
   KX_NetworkMessageScene *GetNetworkMessageScene();
 
+  KX_ReplicationManager &GetReplicationManager();
+  /** Exchange the replicated object states with the peers of a transport, the position of
+   * interest of the scene is its active camera.
+   */
+  void UpdateReplication(KX_NetworkTransport *transport, double time, float rate, float radius);
+
   /// \section Debug draw.
   void RenderDebugProperties(RAS_DebugDraw &debugDraw,
                              int xindent,
@@ -489,27 +807,60 @@ class KX_Scene : public KX_PythonProxy, public SCA_IScene {
                              int &ycoord,
                              unsigned short propsMax);
 
+  /// Add the memory used by the objects, the logic, the physics and the viewports of the scene.
+  void FillMemoryReport(KX_MemoryReport &report);
+
   /**
    * Replicate the logic bricks associated to this object.
+   * \param orgobj The object newobj is a replica of.
    */
 
-  void ReplicateLogic(class KX_GameObject *newobj);
+  void ReplicateLogic(class KX_GameObject *newobj, class KX_GameObject *orgobj);
   static SG_Callbacks m_callbacks;
 
   /// Update the mesh for objects based on level of detail settings
-  void UpdateObjectLods(KX_Camera *cam);
+  void UpdateObjectLods(KX_Camera *cam, struct Depsgraph *depsgraph);
+  /// Update the bounds in the culling tree of the objects moved since the last render.
+  void UpdateCullingBounds(struct Depsgraph *depsgraph);
+  /** Cull the objects outside of the camera view, or hidden by occluders, for the next
+   * draw loop.
+   * \param viewport The render area as x, y, width and height, used by the occlusion buffer.
+   */
+  void CullObjects(KX_Camera *cam, const int *viewport);
+  /// Keep culled only the objects also outside of the view of an other camera.
+  void CullObjectsMerge(KX_Camera *cam, const int *viewport);
+  /// Add the objects occluded at the last GPU occlusion test of the camera to the culled objects.
+  void ApplyHiZCulling(KX_Camera *cam);
+  /** Test the objects inside the camera view against the depth of the render just done, the
+   * result is used by the next render of the camera.
+   */
+  void TestHiZCulling(KX_Camera *cam);
+  /** Test the bounds of the mesh children of the animated armatures against the camera
+   * frustums, the visibility of the armatures is stored in m_armaturesVisible.
+   */
+  void CullArmatures(const std::vector<const SG_Frustum *> &frustums,
+                     struct Depsgraph *depsgraph);
+  /// Force all the objects to compute their lod level again, e.g. when hysteresis changed.
+  void InvalidateLodDistanceRanges();
 
   // LoD Hysteresis functions
   void SetLodHysteresis(bool active);
   bool IsActivedLodHysteresis();
   void SetLodHysteresisValue(int hysteresisvalue);
   int GetLodHysteresisValue();
+  /// Set the maximum number of lod mesh switches per camera render, 0 for no limit.
+  void SetLodSwitchBudget(int budget);
+  int GetLodSwitchBudget() const;
 
   // Update the activity box settings for objects in this scene, if needed.
   void UpdateObjectActivity(void);
 
   // Enable/disable activity culling.
   void SetActivityCulling(bool b);
+  /// Notify that the activity culling settings of an object changed.
+  void InvalidateActivityCulling();
+  /// Notify that an object using activity culling moved, called from the scene graph update.
+  void ActivityCullingObjectMoved(KX_GameObject *gameobj);
 
   // use of DBVT tree for camera culling
   void SetDbvtCulling(bool b)
@@ -528,6 +879,14 @@ class KX_Scene : public KX_PythonProxy, public SCA_IScene {
   {
     return m_dbvt_occlusion_res;
   }
+  void SetGpuOcclusionCulling(bool b)
+  {
+    m_gpuOcclusionCulling = b;
+  }
+  bool GetGpuOcclusionCulling() const
+  {
+    return m_gpuOcclusionCulling;
+  }
 
   void SetBlenderSceneConverter(class BL_BlenderSceneConverter *sceneConverter);
   class BL_BlenderSceneConverter *GetBlenderSceneConverter();
@@ -558,6 +917,26 @@ class KX_Scene : public KX_PythonProxy, public SCA_IScene {
     return m_obstacleSimulation;
   }
 
+  KX_WorldStreamer *GetWorldStreamer() const
+  {
+    return m_worldStreamer;
+  }
+
+  KX_StaticBatchManager *GetStaticBatchManager() const
+  {
+    return m_staticBatchManager;
+  }
+
+  KX_ParticleManager *GetParticleManager() const
+  {
+    return m_particleManager;
+  }
+
+  KX_LightManager *GetLightManager() const
+  {
+    return m_lightManager;
+  }
+
   /**  Inherited from EXP_Value -- returns the name of this object. */
   virtual std::string GetName();
 
@@ -585,6 +964,16 @@ class KX_Scene : public KX_PythonProxy, public SCA_IScene {
   EXP_PYMETHOD_DOC(KX_Scene, addOverlayCollection);
   EXP_PYMETHOD_DOC(KX_Scene, removeOverlayCollection);
   EXP_PYMETHOD_DOC(KX_Scene, getGameObjectFromObject);
+  EXP_PYMETHOD_DOC(KX_Scene, getTransforms);
+  EXP_PYMETHOD_DOC(KX_Scene, setTransforms);
+  EXP_PYMETHOD_DOC(KX_Scene, rayCastBatch);
+  EXP_PYMETHOD_DOC(KX_Scene, rayCastBatchAsync);
+  EXP_PYMETHOD_DOC(KX_Scene, addStreamingCell);
+  EXP_PYMETHOD_DOC(KX_Scene, removeStreamingCell);
+  EXP_PYMETHOD_DOC(KX_Scene, getStreamingCellState);
+  EXP_PYMETHOD_DOC(KX_Scene, prewarmMeshes);
+  EXP_PYMETHOD_DOC(KX_Scene, saveState);
+  EXP_PYMETHOD_DOC(KX_Scene, loadState);
 
   /* attributes */
   static PyObject *pyattr_get_name(EXP_PyObjectPlus *self_v, const EXP_PYATTRIBUTE_DEF *attrdef);
@@ -623,6 +1012,18 @@ class KX_Scene : public KX_PythonProxy, public SCA_IScene {
   static int pyattr_set_gravity(EXP_PyObjectPlus *self_v,
                                 const EXP_PYATTRIBUTE_DEF *attrdef,
                                 PyObject *value);
+  static PyObject *pyattr_get_streaming_cells(EXP_PyObjectPlus *self_v,
+                                              const EXP_PYATTRIBUTE_DEF *attrdef);
+  static PyObject *pyattr_get_streaming_max_loads(EXP_PyObjectPlus *self_v,
+                                                  const EXP_PYATTRIBUTE_DEF *attrdef);
+  static int pyattr_set_streaming_max_loads(EXP_PyObjectPlus *self_v,
+                                            const EXP_PYATTRIBUTE_DEF *attrdef,
+                                            PyObject *value);
+  static PyObject *pyattr_get_streaming_merge_budget(EXP_PyObjectPlus *self_v,
+                                                     const EXP_PYATTRIBUTE_DEF *attrdef);
+  static int pyattr_set_streaming_merge_budget(EXP_PyObjectPlus *self_v,
+                                               const EXP_PYATTRIBUTE_DEF *attrdef,
+                                               PyObject *value);
 
   /* getitem/setitem */
   static PyMappingMethods Mapping;
@@ -643,7 +1044,16 @@ class KX_Scene : public KX_PythonProxy, public SCA_IScene {
     return m_blenderScene;
   }
 
+  /// Merge all the objects of another scene, return false if the scenes can't be merged.
   bool MergeScene(KX_Scene *other);
+  /** Merge the objects of another scene until the time endtime is reached, at least
+   * one object is merged per call. The merge is spread over several calls until
+   * finished is set to true, the other scene must not be used meanwhile.
+   * \return false if the scenes can't be merged.
+   */
+  bool MergeScenePart(KX_Scene *other, double endtime, bool &finished);
+  /// Return the normalized progress of the merge of this scene into another scene.
+  float GetMergeProgress();
 
   // void PrintStats(int verbose_level) {
   //	m_bucketmanager->PrintStats(verbose_level)
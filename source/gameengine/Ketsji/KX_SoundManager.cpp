@@ -0,0 +1,484 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Ketsji/KX_SoundManager.cpp
+ *  \ingroup ketsji
+ */
+
+#include "KX_SoundManager.h"
+
+#include <algorithm>
+
+#include "KX_Camera.h"
+#include "KX_Scene.h"
+#include "SCA_SoundActuator.h"
+
+/// Gain under which a voice is inaudible, -60 dB.
+static const float minAudibleGain = 0.001f;
+/// Paused handles kept per sound at most, the others are freed.
+static const unsigned int maxPooledHandles = 16;
+
+/// Return true if a voice is less important than another.
+static bool voice_less(const KX_SoundManager::Voice *voice, const KX_SoundManager::Voice *other)
+{
+  const int priority = voice->m_actuator->GetPriority();
+  const int otherPriority = other->m_actuator->GetPriority();
+  if (priority != otherPriority) {
+    return priority < otherPriority;
+  }
+  return voice->m_audibility < other->m_audibility;
+}
+
+KX_SoundManager::KX_SoundManager() : m_numRealVoices(0), m_maxVoices(0)
+{
+  m_listener.m_scene = nullptr;
+  m_listener.m_camera = nullptr;
+}
+
+KX_SoundManager::~KX_SoundManager()
+{
+  for (Voice *voice : m_voices) {
+    voice->m_actuator->ReleaseVoice();
+#ifdef WITH_AUDASPACE
+    if (voice->m_handle) {
+      AUD_Handle_stop(voice->m_handle);
+    }
+#endif
+    delete voice;
+  }
+
+#ifdef WITH_AUDASPACE
+  for (auto &pair : m_pools) {
+    for (AUD_Handle *handle : pair.second) {
+      AUD_Handle_stop(handle);
+    }
+  }
+#endif
+}
+
+void KX_SoundManager::SetMaxVoices(unsigned int maxVoices)
+{
+  m_maxVoices = maxVoices;
+}
+
+unsigned int KX_SoundManager::GetMaxVoices() const
+{
+  return m_maxVoices;
+}
+
+unsigned int KX_SoundManager::GetNumVoices() const
+{
+  return m_voices.size();
+}
+
+unsigned int KX_SoundManager::GetNumRealVoices() const
+{
+  return m_numRealVoices;
+}
+
+const KX_SoundManager::Listener *KX_SoundManager::GetListener(KX_GameObject *object)
+{
+  KX_Scene *scene = object->GetScene();
+  if (scene != m_listener.m_scene) {
+    m_listener.m_scene = scene;
+    m_listener.m_camera = scene ? scene->GetActiveCamera() : nullptr;
+    if (m_listener.m_camera) {
+      m_listener.m_orientation = m_listener.m_camera->NodeGetWorldOrientation().inverse();
+      m_listener.m_position = m_listener.m_camera->NodeGetWorldPosition();
+      m_listener.m_velocity = m_listener.m_camera->GetLinearVelocity();
+    }
+  }
+
+  return m_listener.m_camera ? &m_listener : nullptr;
+}
+
+float KX_SoundManager::ComputeAudibility(SCA_SoundActuator *actuator)
+{
+  const float gain = actuator->GetVolume();
+  if (!actuator->Is3D()) {
+    return gain;
+  }
+
+  KX_GameObject *object = static_cast<KX_GameObject *>(actuator->GetParent());
+  const Listener *listener = GetListener(object);
+  if (!listener) {
+    return gain;
+  }
+
+  const KX_3DSoundSettings &settings = actuator->Get3DSettings();
+  float distance = (object->NodeGetWorldPosition() - listener->m_position).length();
+  if (settings.max_distance > 0.0f) {
+    distance = std::min(distance, settings.max_distance);
+  }
+
+  float attenuation = 1.0f;
+  const float reference = settings.reference_distance;
+  if (distance > reference && reference > 0.0f) {
+    attenuation = reference / (reference + settings.rolloff_factor * (distance - reference));
+  }
+  attenuation = std::max(settings.min_gain, std::min(attenuation, settings.max_gain));
+
+  return gain * attenuation;
+}
+
+KX_SoundManager::Voice *KX_SoundManager::FindLowestRealVoice() const
+{
+  Voice *lowest = nullptr;
+  for (Voice *voice : m_voices) {
+#ifdef WITH_AUDASPACE
+    if (voice->m_handle && (!lowest || voice_less(voice, lowest))) {
+      lowest = voice;
+    }
+#endif
+  }
+  return lowest;
+}
+
+bool KX_SoundManager::Realize(Voice *voice)
+{
+#ifdef WITH_AUDASPACE
+  SCA_SoundActuator *actuator = voice->m_actuator;
+  AUD_Sound *sound = actuator->GetSound();
+  if (!sound) {
+    return false;
+  }
+
+  const bool pingpong = (actuator->m_type == SCA_SoundActuator::KX_SOUNDACT_LOOPBIDIRECTIONAL ||
+                         actuator->m_type ==
+                             SCA_SoundActuator::KX_SOUNDACT_LOOPBIDIRECTIONAL_STOP);
+  // The ping pong sounds are created per play and can't be shared.
+  void *key = pingpong ? nullptr : actuator->GetSoundKey();
+
+  AUD_Handle *handle = nullptr;
+  bool pooled = false;
+  if (key) {
+    const auto it = m_pools.find({key, actuator->Is3D()});
+    if (it != m_pools.end() && !it->second.empty()) {
+      handle = it->second.back();
+      it->second.pop_back();
+      AUD_Handle_setPosition(handle, voice->m_position);
+      pooled = true;
+    }
+  }
+
+  if (!handle) {
+    // this is the sound that will be played and not deleted afterwards
+    AUD_Sound *played = pingpong ? AUD_Sound_pingpong(sound) : sound;
+
+    AUD_Device *device = AUD_Device_getCurrent();
+    // The pooled handles are kept at their end to be replayed.
+    handle = AUD_Device_play(device, played, key != nullptr);
+    AUD_Device_free(device);
+
+    // in case of pingpong, we have to free the sound
+    if (played != sound) {
+      AUD_Sound_free(played);
+    }
+
+    if (!handle) {
+      return false;
+    }
+
+    if (voice->m_position > 0.0) {
+      AUD_Handle_setPosition(handle, voice->m_position);
+    }
+  }
+
+  if (actuator->Is3D()) {
+    const KX_3DSoundSettings &settings = actuator->Get3DSettings();
+    AUD_Handle_setRelative(handle, true);
+    AUD_Handle_setVolumeMaximum(handle, settings.max_gain);
+    AUD_Handle_setVolumeMinimum(handle, settings.min_gain);
+    AUD_Handle_setDistanceReference(handle, settings.reference_distance);
+    AUD_Handle_setDistanceMaximum(handle, settings.max_distance);
+    AUD_Handle_setAttenuation(handle, settings.rolloff_factor);
+    AUD_Handle_setConeAngleInner(handle, settings.cone_inner_angle);
+    AUD_Handle_setConeAngleOuter(handle, settings.cone_outer_angle);
+    AUD_Handle_setConeVolumeOuter(handle, settings.cone_outer_gain);
+  }
+
+  AUD_Handle_setLoopCount(handle, voice->m_looping ? -1 : 0);
+  AUD_Handle_setPitch(handle, actuator->GetPitch());
+  AUD_Handle_setVolume(handle, actuator->GetVolume());
+
+  voice->m_handle = handle;
+  voice->m_key = key;
+  ++m_numRealVoices;
+
+  UpdateSource(voice);
+
+  if (voice->m_paused) {
+    AUD_Handle_pause(handle);
+  }
+  else if (pooled) {
+    AUD_Handle_resume(handle);
+  }
+
+  return true;
+#else
+  return false;
+#endif  // WITH_AUDASPACE
+}
+
+void KX_SoundManager::Virtualize(Voice *voice)
+{
+#ifdef WITH_AUDASPACE
+  if (!voice->m_handle) {
+    return;
+  }
+
+  // The voices not looping are stopped, they would be finished when resumed.
+  voice->m_position = voice->m_looping ? AUD_Handle_getPosition(voice->m_handle) : 0.0;
+  ReleaseHandle(voice);
+#endif  // WITH_AUDASPACE
+}
+
+#ifdef WITH_AUDASPACE
+void KX_SoundManager::ReleaseHandle(Voice *voice)
+{
+  AUD_Handle *handle = voice->m_handle;
+  if (!handle) {
+    return;
+  }
+
+  if (voice->m_key && AUD_Handle_getStatus(handle) != AUD_STATUS_INVALID) {
+    std::vector<AUD_Handle *> &pool = m_pools[{voice->m_key, voice->m_actuator->Is3D()}];
+    if (pool.size() < maxPooledHandles) {
+      AUD_Handle_pause(handle);
+      pool.push_back(handle);
+      handle = nullptr;
+    }
+  }
+
+  if (handle) {
+    AUD_Handle_stop(handle);
+  }
+
+  voice->m_handle = nullptr;
+  --m_numRealVoices;
+}
+
+void KX_SoundManager::UpdateSource(Voice *voice)
+{
+  SCA_SoundActuator *actuator = voice->m_actuator;
+  if (!actuator->Is3D()) {
+    return;
+  }
+
+  KX_GameObject *object = static_cast<KX_GameObject *>(actuator->GetParent());
+  const Listener *listener = GetListener(object);
+  if (!listener) {
+    return;
+  }
+
+  const MT_Matrix3x3 &orientation = listener->m_orientation;
+  float data[4];
+
+  (orientation * (object->NodeGetWorldPosition() - listener->m_position)).getValue(data);
+  AUD_Handle_setLocation(voice->m_handle, data);
+  (orientation * (object->GetLinearVelocity() - listener->m_velocity)).getValue(data);
+  AUD_Handle_setVelocity(voice->m_handle, data);
+  (orientation * object->NodeGetWorldOrientation()).getRotation().getValue(data);
+  AUD_Handle_setOrientation(voice->m_handle, data);
+}
+#endif  // WITH_AUDASPACE
+
+KX_SoundManager::Voice *KX_SoundManager::Play(SCA_SoundActuator *actuator)
+{
+#ifdef WITH_AUDASPACE
+  m_listener.m_scene = nullptr;
+
+  const float audibility = ComputeAudibility(actuator);
+  const bool looping = (actuator->m_type == SCA_SoundActuator::KX_SOUNDACT_LOOPSTOP ||
+                        actuator->m_type == SCA_SoundActuator::KX_SOUNDACT_LOOPEND ||
+                        actuator->m_type == SCA_SoundActuator::KX_SOUNDACT_LOOPBIDIRECTIONAL ||
+                        actuator->m_type ==
+                            SCA_SoundActuator::KX_SOUNDACT_LOOPBIDIRECTIONAL_STOP);
+
+  // Cull the inaudible sounds before creating a handle, the looping ones could get audible.
+  if (audibility < minAudibleGain && !looping) {
+    return nullptr;
+  }
+
+  Voice *voice = new Voice();
+  voice->m_actuator = actuator;
+  voice->m_index = m_voices.size();
+  voice->m_handle = nullptr;
+  voice->m_key = nullptr;
+  voice->m_position = 0.0;
+  voice->m_audibility = audibility;
+  voice->m_looping = looping;
+  voice->m_paused = false;
+  m_voices.push_back(voice);
+
+  if (audibility >= minAudibleGain) {
+    if (m_maxVoices > 0 && m_numRealVoices >= m_maxVoices) {
+      // Steal the slot of the least important voice.
+      Voice *lowest = FindLowestRealVoice();
+      if (lowest && voice_less(lowest, voice)) {
+        Virtualize(lowest);
+      }
+    }
+
+    if (m_maxVoices == 0 || m_numRealVoices < m_maxVoices) {
+      Realize(voice);
+    }
+  }
+
+  if (!voice->m_handle && !looping) {
+    Stop(voice);
+    return nullptr;
+  }
+
+  return voice;
+#else
+  return nullptr;
+#endif  // WITH_AUDASPACE
+}
+
+void KX_SoundManager::Stop(Voice *voice)
+{
+#ifdef WITH_AUDASPACE
+  ReleaseHandle(voice);
+#endif
+
+  Voice *last = m_voices.back();
+  m_voices[voice->m_index] = last;
+  last->m_index = voice->m_index;
+  m_voices.pop_back();
+
+  delete voice;
+}
+
+void KX_SoundManager::Pause(Voice *voice)
+{
+  voice->m_paused = true;
+#ifdef WITH_AUDASPACE
+  if (voice->m_handle) {
+    AUD_Handle_pause(voice->m_handle);
+  }
+#endif
+}
+
+void KX_SoundManager::Resume(Voice *voice)
+{
+  voice->m_paused = false;
+#ifdef WITH_AUDASPACE
+  if (voice->m_handle) {
+    AUD_Handle_resume(voice->m_handle);
+  }
+#endif
+}
+
+bool KX_SoundManager::IsPlaying(Voice *voice) const
+{
+#ifdef WITH_AUDASPACE
+  if (voice->m_handle) {
+    switch (AUD_Handle_getStatus(voice->m_handle)) {
+      case AUD_STATUS_PLAYING:
+        return true;
+      case AUD_STATUS_PAUSED:
+        // A kept handle is paused at its end.
+        return voice->m_paused;
+      default:
+        return false;
+    }
+  }
+#endif
+  return voice->m_looping;
+}
+
+void KX_SoundManager::StopLooping(Voice *voice)
+{
+  voice->m_looping = false;
+#ifdef WITH_AUDASPACE
+  if (voice->m_handle) {
+    AUD_Handle_setLoopCount(voice->m_handle, 0);
+  }
+#endif
+}
+
+double KX_SoundManager::GetPosition(Voice *voice) const
+{
+#ifdef WITH_AUDASPACE
+  if (voice->m_handle) {
+    return AUD_Handle_getPosition(voice->m_handle);
+  }
+#endif
+  return voice->m_position;
+}
+
+void KX_SoundManager::SetPosition(Voice *voice, double position)
+{
+#ifdef WITH_AUDASPACE
+  if (voice->m_handle) {
+    AUD_Handle_setPosition(voice->m_handle, position);
+    return;
+  }
+#endif
+  voice->m_position = position;
+}
+
+void KX_SoundManager::Update()
+{
+#ifdef WITH_AUDASPACE
+  if (m_voices.empty()) {
+    return;
+  }
+
+  m_listener.m_scene = nullptr;
+
+  AUD_Device *device = AUD_Device_getCurrent();
+  // Lock once for all the handle updates instead of once per call.
+  AUD_Device_lock(device);
+
+  for (Voice *voice : m_voices) {
+    voice->m_audibility = ComputeAudibility(voice->m_actuator);
+  }
+
+  m_order = m_voices;
+  std::sort(m_order.begin(), m_order.end(), [](const Voice *a, const Voice *b) {
+    return voice_less(b, a);
+  });
+
+  const unsigned int slots = (m_maxVoices > 0) ? m_maxVoices : m_order.size();
+
+  // Free the slots of the voices losing them before giving them to the others.
+  for (unsigned int i = 0, size = m_order.size(); i < size; ++i) {
+    Voice *voice = m_order[i];
+    if (voice->m_handle && (i >= slots || voice->m_audibility < minAudibleGain)) {
+      Virtualize(voice);
+    }
+  }
+
+  for (unsigned int i = 0, size = m_order.size(); i < size; ++i) {
+    Voice *voice = m_order[i];
+    if (voice->m_handle) {
+      UpdateSource(voice);
+    }
+    else if (i < slots && voice->m_looping && voice->m_audibility >= minAudibleGain) {
+      Realize(voice);
+    }
+  }
+
+  AUD_Device_unlock(device);
+  AUD_Device_free(device);
+#endif  // WITH_AUDASPACE
+}
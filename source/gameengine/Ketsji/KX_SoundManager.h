@@ -0,0 +1,159 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file KX_SoundManager.h
+ *  \ingroup ketsji
+ */
+
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+
+#include "MT_Matrix3x3.h"
+#include "MT_Vector3.h"
+
+#ifdef WITH_AUDASPACE
+#  include <AUD_Device.h>
+#  include <AUD_Handle.h>
+#  include <AUD_Sound.h>
+#endif
+
+class KX_Camera;
+class KX_GameObject;
+class KX_Scene;
+class SCA_SoundActuator;
+
+/** Voices of the sound actuators played on the audio device. The number of voices mixed by
+ * the device is limited, the voices of lower priority and audibility are virtual: they hold
+ * no device handle, the looping ones are resumed when they get a slot back and the others are
+ * stopped. The inaudible sounds are culled before creating their handle. The finished handles
+ * are paused and kept per sound to be replayed without creating a new reader.
+ * The 3D sources of all the voices are updated once per frame under a single device lock.
+ */
+class KX_SoundManager {
+ public:
+  struct Voice {
+    SCA_SoundActuator *m_actuator;
+    /// Index in the voices, for constant time removal.
+    unsigned int m_index;
+#ifdef WITH_AUDASPACE
+    /// The device handle, nullptr for a virtual voice.
+    AUD_Handle *m_handle;
+#endif
+    /// Key of the handle pool, nullptr if the handle isn't pooled.
+    void *m_key;
+    /// Playback position kept while the voice is virtual.
+    double m_position;
+    float m_audibility;
+    bool m_looping;
+    /// Paused by the user.
+    bool m_paused;
+  };
+
+ private:
+  /// Active camera of a scene, the 3D sources are relative to it.
+  struct Listener {
+    KX_Scene *m_scene;
+    KX_Camera *m_camera;
+    /// Inverse of the camera world orientation.
+    MT_Matrix3x3 m_orientation;
+    MT_Vector3 m_position;
+    MT_Vector3 m_velocity;
+  };
+
+  struct PoolKey {
+    void *m_sound;
+    bool m_is3d;
+
+    bool operator==(const PoolKey &other) const
+    {
+      return (m_sound == other.m_sound && m_is3d == other.m_is3d);
+    }
+  };
+
+  struct PoolKeyHash {
+    size_t operator()(const PoolKey &key) const
+    {
+      return std::hash<void *>()(key.m_sound) ^ (size_t)key.m_is3d;
+    }
+  };
+
+  std::vector<Voice *> m_voices;
+  /// Voices sorted by importance, rebuilt at each update.
+  std::vector<Voice *> m_order;
+  unsigned int m_numRealVoices;
+  /// Maximum number of voices with a device handle, 0 for unlimited.
+  unsigned int m_maxVoices;
+
+#ifdef WITH_AUDASPACE
+  /// Paused handles of finished voices per sound.
+  std::unordered_map<PoolKey, std::vector<AUD_Handle *>, PoolKeyHash> m_pools;
+#endif
+  /// Listener of the last scene, cached during an update.
+  Listener m_listener;
+
+  /// Return the listener of the scene of an object, nullptr if the scene has no camera.
+  const Listener *GetListener(KX_GameObject *object);
+  /** Estimate the gain of the sound of an actuator at the listener with the inverse clamped
+   * distance model, the sound is inaudible under a minimum gain.
+   */
+  float ComputeAudibility(SCA_SoundActuator *actuator);
+  /// Return the lowest voice with a device handle.
+  Voice *FindLowestRealVoice() const;
+  /// Create or reuse a device handle for a voice and start it.
+  bool Realize(Voice *voice);
+  /// Release the handle of a voice, keep the position if the voice loops.
+  void Virtualize(Voice *voice);
+#ifdef WITH_AUDASPACE
+  void ReleaseHandle(Voice *voice);
+  void UpdateSource(Voice *voice);
+#endif
+
+ public:
+  KX_SoundManager();
+  ~KX_SoundManager();
+
+  void SetMaxVoices(unsigned int maxVoices);
+  unsigned int GetMaxVoices() const;
+  unsigned int GetNumVoices() const;
+  unsigned int GetNumRealVoices() const;
+
+  /** Start a voice playing the sound of an actuator.
+   * \return nullptr if the sound is culled because it is inaudible or there is no free slot
+   * for it and it doesn't loop.
+   */
+  Voice *Play(SCA_SoundActuator *actuator);
+  /// Stop a voice and free it.
+  void Stop(Voice *voice);
+  void Pause(Voice *voice);
+  void Resume(Voice *voice);
+  /// Return true if a voice is playing or paused by the user, virtual looping voices play.
+  bool IsPlaying(Voice *voice) const;
+  /// Stop the looping, the voice ends at the end of the sound.
+  void StopLooping(Voice *voice);
+  double GetPosition(Voice *voice) const;
+  void SetPosition(Voice *voice, double position);
+
+  /** Update the 3D sources relative to the active camera of their scene, then give the
+   * device handles to the most important voices.
+   */
+  void Update();
+};
@@ -0,0 +1,482 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Ketsji/KX_SoundStreamer.cpp
+ *  \ingroup ketsji
+ */
+
+#include "KX_SoundStreamer.h"
+
+#ifdef WITH_AUDASPACE
+#  include <algorithm>
+#  include <atomic>
+#  include <chrono>
+#  include <condition_variable>
+#  include <cstring>
+#  include <exception>
+#  include <thread>
+#  include <vector>
+
+#  include "IReader.h"
+#  include "ISound.h"
+#  include "util/RingBuffer.h"
+
+#  include "BKE_sound.h"
+#  include "DNA_sound_types.h"
+
+#  include "CM_Message.h"
+#endif  // WITH_AUDASPACE
+
+#ifdef WITH_AUDASPACE
+
+/// Length in seconds of the first chunk decoded at the conversion.
+static const int STREAM_PREFETCH_LENGTH = 2;
+/// Length in seconds of the ring buffer of a playback.
+static const int STREAM_BUFFER_LENGTH = 2;
+/// Samples per channel decoded at once by the worker.
+static const int STREAM_CHUNK_SIZE = 4096;
+
+/// Decoding state of a playback, shared by its reader and the worker.
+struct KX_StreamState {
+  /// The sound decoded and its reader, only used by the worker once registered.
+  std::shared_ptr<aud::ISound> m_source;
+  std::shared_ptr<aud::IReader> m_reader;
+
+  std::mutex m_mutex;
+  /// Samples decoded from the ring start, protected by m_mutex.
+  aud::RingBuffer m_ring;
+  /// Position in the sound of the first sample of the ring, protected by m_mutex.
+  int m_ringStart;
+  /// The ring is filled up to the end of the sound, protected by m_mutex.
+  bool m_eos;
+  /// The worker must seek its reader to the ring start, protected by m_mutex.
+  bool m_seek;
+  /// Incremented at each seek to discard the samples decoded before it, protected by m_mutex.
+  unsigned int m_generation;
+  /// The reader of the playback was freed, the worker forgets the playback.
+  std::atomic<bool> m_closed;
+
+  KX_StreamState(const std::shared_ptr<aud::ISound> &source,
+                 const std::shared_ptr<aud::IReader> &reader,
+                 int bufferSize,
+                 int ringStart)
+      : m_source(source),
+        m_reader(reader),
+        m_ring(bufferSize),
+        m_ringStart(ringStart),
+        m_eos(false),
+        m_seek(false),
+        m_generation(0),
+        m_closed(false)
+  {
+  }
+};
+
+struct KX_SoundStreamer::Worker {
+  std::thread m_thread;
+  std::mutex m_mutex;
+  std::condition_variable m_condition;
+  /// Playbacks to fill, protected by m_mutex.
+  std::vector<std::shared_ptr<KX_StreamState>> m_streams;
+  /// Protected by m_mutex.
+  bool m_wake;
+  bool m_stopping;
+
+  Worker() : m_wake(false), m_stopping(false)
+  {
+    m_thread = std::thread(&Worker::Run, this);
+  }
+
+  ~Worker()
+  {
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_stopping = true;
+    }
+    m_condition.notify_one();
+    m_thread.join();
+  }
+
+  void Add(const std::shared_ptr<KX_StreamState> &stream)
+  {
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_streams.push_back(stream);
+      m_wake = true;
+    }
+    m_condition.notify_one();
+  }
+
+  void Wake()
+  {
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_wake = true;
+    }
+    m_condition.notify_one();
+  }
+
+  /// Decode the samples of a playback until its ring is full.
+  static void Fill(KX_StreamState &stream, std::vector<aud::sample_t> &samples)
+  {
+    bool seek;
+    int position;
+    unsigned int generation;
+    {
+      std::unique_lock<std::mutex> lock(stream.m_mutex);
+      if (stream.m_eos && !stream.m_seek) {
+        return;
+      }
+      seek = stream.m_seek;
+      stream.m_seek = false;
+      position = stream.m_ringStart;
+      generation = stream.m_generation;
+    }
+
+    try {
+      // The file is opened here for the playbacks not using the reader of the prefetch.
+      if (!stream.m_reader) {
+        stream.m_reader = stream.m_source->createReader();
+        seek = true;
+      }
+      if (seek) {
+        stream.m_reader->seek(position);
+      }
+
+      const aud::Specs specs = stream.m_reader->getSpecs();
+      const int sampleSize = AUD_SAMPLE_SIZE(specs);
+      while (!stream.m_closed) {
+        int length;
+        {
+          std::unique_lock<std::mutex> lock(stream.m_mutex);
+          length = std::min((int)stream.m_ring.getWriteSize() / sampleSize, STREAM_CHUNK_SIZE);
+        }
+        if (length == 0) {
+          return;
+        }
+
+        samples.resize(length * specs.channels);
+        bool eos = false;
+        stream.m_reader->read(length, eos, samples.data());
+
+        std::unique_lock<std::mutex> lock(stream.m_mutex);
+        // A seek during the decoding, the next fill decodes from the new position.
+        if (generation != stream.m_generation) {
+          return;
+        }
+        stream.m_ring.write((aud::data_t *)samples.data(), length * sampleSize);
+        if (eos) {
+          stream.m_eos = true;
+          return;
+        }
+      }
+    }
+    catch (std::exception &exception) {
+      CM_Error("failed to stream sound: " << exception.what());
+      std::unique_lock<std::mutex> lock(stream.m_mutex);
+      stream.m_eos = true;
+    }
+  }
+
+  void Run()
+  {
+    std::vector<std::shared_ptr<KX_StreamState>> streams;
+    std::vector<aud::sample_t> samples;
+    while (true) {
+      {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        // The playbacks wake the worker when their ring is half empty, the time out catches up.
+        m_condition.wait_for(lock, std::chrono::milliseconds(50), [this]() {
+          return (m_wake || m_stopping);
+        });
+        if (m_stopping) {
+          break;
+        }
+        m_wake = false;
+
+        m_streams.erase(std::remove_if(m_streams.begin(),
+                                       m_streams.end(),
+                                       [](const std::shared_ptr<KX_StreamState> &stream) {
+                                         return stream->m_closed.load();
+                                       }),
+                        m_streams.end());
+        streams = m_streams;
+      }
+
+      for (const std::shared_ptr<KX_StreamState> &stream : streams) {
+        Fill(*stream, samples);
+      }
+      streams.clear();
+    }
+  }
+};
+
+/// First samples of a streamed sound, shared by its playbacks.
+struct KX_StreamPrefetch {
+  std::vector<aud::sample_t> m_samples;
+  /// Length in samples per channel.
+  int m_length;
+  /// The prefetch holds the whole sound.
+  bool m_eos;
+  aud::Specs m_specs;
+  /// Length of the sound, negative if unknown.
+  int m_soundLength;
+  bool m_seekable;
+};
+
+/// Playback of a streamed sound, reads the prefetch then the ring filled by the worker.
+class KX_StreamReader : public aud::IReader {
+ private:
+  std::shared_ptr<KX_SoundStreamer::Worker> m_worker;
+  std::shared_ptr<KX_StreamState> m_stream;
+  std::shared_ptr<const KX_StreamPrefetch> m_prefetch;
+  int m_position;
+
+ public:
+  KX_StreamReader(const std::shared_ptr<KX_SoundStreamer::Worker> &worker,
+                  const std::shared_ptr<KX_StreamState> &stream,
+                  const std::shared_ptr<const KX_StreamPrefetch> &prefetch)
+      : m_worker(worker), m_stream(stream), m_prefetch(prefetch), m_position(0)
+  {
+  }
+
+  virtual ~KX_StreamReader()
+  {
+    m_stream->m_closed = true;
+  }
+
+  virtual bool isSeekable() const
+  {
+    return m_prefetch->m_seekable;
+  }
+
+  virtual void seek(int position)
+  {
+    m_position = std::max(position, 0);
+    if (m_prefetch->m_eos) {
+      return;
+    }
+
+    // The ring always continues the prefetch, a seek into the prefetch reads it again.
+    const int start = std::max(m_position, m_prefetch->m_length);
+    {
+      std::unique_lock<std::mutex> lock(m_stream->m_mutex);
+      if (start == m_stream->m_ringStart) {
+        return;
+      }
+      m_stream->m_ring.reset();
+      m_stream->m_ringStart = start;
+      m_stream->m_eos = false;
+      m_stream->m_seek = true;
+      ++m_stream->m_generation;
+    }
+    m_worker->Wake();
+  }
+
+  virtual int getLength() const
+  {
+    return m_prefetch->m_soundLength;
+  }
+
+  virtual int getPosition() const
+  {
+    return m_position;
+  }
+
+  virtual aud::Specs getSpecs() const
+  {
+    return m_prefetch->m_specs;
+  }
+
+  virtual void read(int &length, bool &eos, aud::sample_t *buffer)
+  {
+    const int channels = m_prefetch->m_specs.channels;
+    int done = 0;
+    if (m_position < m_prefetch->m_length) {
+      done = std::min(length, m_prefetch->m_length - m_position);
+      std::memcpy(buffer,
+                  m_prefetch->m_samples.data() + m_position * channels,
+                  done * channels * sizeof(aud::sample_t));
+      m_position += done;
+    }
+
+    eos = false;
+    bool wake = false;
+    if (done < length) {
+      if (m_prefetch->m_eos) {
+        eos = true;
+      }
+      else {
+        std::unique_lock<std::mutex> lock(m_stream->m_mutex);
+        aud::RingBuffer &ring = m_stream->m_ring;
+        const int sampleSize = AUD_SAMPLE_SIZE(m_prefetch->m_specs);
+        const int count = std::min(length - done, (int)ring.getReadSize() / sampleSize);
+        ring.read((aud::data_t *)(buffer + done * channels), count * sampleSize);
+        m_stream->m_ringStart += count;
+        m_position += count;
+        done += count;
+
+        eos = (m_stream->m_eos && ring.getReadSize() == 0);
+        wake = (!m_stream->m_eos && (int)ring.getReadSize() < ring.getSize() / 2);
+      }
+    }
+
+    if (eos) {
+      length = done;
+    }
+    else if (done < length) {
+      // The worker is late, play silence without moving in the sound.
+      std::memset(buffer + done * channels, 0, (length - done) * channels * sizeof(aud::sample_t));
+    }
+
+    if (wake) {
+      m_worker->Wake();
+    }
+  }
+};
+
+class KX_StreamedSound : public aud::ISound {
+ private:
+  std::shared_ptr<KX_SoundStreamer::Worker> m_worker;
+  std::shared_ptr<aud::ISound> m_source;
+  std::shared_ptr<KX_StreamPrefetch> m_prefetch;
+  /// Reader of the prefetch placed after it, given to the first playback.
+  std::shared_ptr<aud::IReader> m_spareReader;
+
+ public:
+  /// Decode the prefetch from a reader of the source.
+  KX_StreamedSound(const std::shared_ptr<KX_SoundStreamer::Worker> &worker,
+                   const std::shared_ptr<aud::ISound> &source,
+                   const std::shared_ptr<aud::IReader> &reader)
+      : m_worker(worker),
+        m_source(source),
+        m_prefetch(std::make_shared<KX_StreamPrefetch>()),
+        m_spareReader(reader)
+  {
+    KX_StreamPrefetch &prefetch = *m_prefetch;
+    prefetch.m_specs = reader->getSpecs();
+    prefetch.m_soundLength = reader->getLength();
+    prefetch.m_seekable = reader->isSeekable();
+
+    int length = prefetch.m_specs.rate * STREAM_PREFETCH_LENGTH;
+    prefetch.m_samples.resize(length * prefetch.m_specs.channels);
+    prefetch.m_eos = false;
+    reader->read(length, prefetch.m_eos, prefetch.m_samples.data());
+    prefetch.m_length = length;
+    prefetch.m_samples.resize(length * prefetch.m_specs.channels);
+    prefetch.m_samples.shrink_to_fit();
+
+    if (prefetch.m_eos) {
+      m_spareReader.reset();
+    }
+  }
+
+  virtual std::shared_ptr<aud::IReader> createReader()
+  {
+    const int bufferSize = m_prefetch->m_specs.rate * STREAM_BUFFER_LENGTH *
+                           AUD_SAMPLE_SIZE(m_prefetch->m_specs);
+    std::shared_ptr<KX_StreamState> stream = std::make_shared<KX_StreamState>(
+        m_source, m_spareReader, m_prefetch->m_eos ? 0 : bufferSize, m_prefetch->m_length);
+    m_spareReader.reset();
+
+    if (!m_prefetch->m_eos) {
+      m_worker->Add(stream);
+    }
+
+    return std::make_shared<KX_StreamReader>(m_worker, stream, m_prefetch);
+  }
+};
+
+#else
+
+struct KX_SoundStreamer::Worker {
+};
+
+#endif  // WITH_AUDASPACE
+
+KX_SoundStreamer::KX_SoundStreamer() : m_streamLength(0.0f)
+{
+}
+
+KX_SoundStreamer::~KX_SoundStreamer()
+{
+#ifdef WITH_AUDASPACE
+  for (const std::pair<bSound *const, AUD_Sound *> &pair : m_sounds) {
+    if (pair.second) {
+      AUD_Sound_free(pair.second);
+    }
+  }
+#endif  // WITH_AUDASPACE
+}
+
+void KX_SoundStreamer::SetStreamLength(float length)
+{
+  m_streamLength = length;
+}
+
+float KX_SoundStreamer::GetStreamLength() const
+{
+  return m_streamLength;
+}
+
+#ifdef WITH_AUDASPACE
+AUD_Sound *KX_SoundStreamer::GetSound(bSound *sound)
+{
+  if (m_streamLength <= 0.0f || !sound->handle) {
+    return sound->playback_handle;
+  }
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+
+  AUD_Sound *streamed = nullptr;
+  const std::unordered_map<bSound *, AUD_Sound *>::iterator it = m_sounds.find(sound);
+  if (it != m_sounds.end()) {
+    streamed = it->second;
+  }
+  else {
+    try {
+      // The C API sounds are shared pointers to the audaspace sounds.
+      const std::shared_ptr<aud::ISound> &source = *(std::shared_ptr<aud::ISound> *)sound->handle;
+      std::shared_ptr<aud::IReader> reader = source->createReader();
+      const int length = reader->getLength();
+      // The sounds of unknown length are streamed.
+      if (length < 0 || length >= reader->getSpecs().rate * m_streamLength) {
+        if (!m_worker) {
+          m_worker = std::make_shared<Worker>();
+        }
+        streamed = (AUD_Sound *)new std::shared_ptr<aud::ISound>(
+            new KX_StreamedSound(m_worker, source, reader));
+      }
+    }
+    catch (std::exception &exception) {
+      CM_Error("failed to stream sound \"" << sound->id.name + 2 << "\": " << exception.what());
+    }
+    m_sounds[sound] = streamed;
+  }
+
+  if (!streamed) {
+    return sound->playback_handle;
+  }
+
+  // The full decoding of a cached sound is not played, the sound is loaded again per actuator.
+  BKE_sound_delete_cache(sound);
+  return streamed;
+}
+#endif  // WITH_AUDASPACE
@@ -0,0 +1,72 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file KX_SoundStreamer.h
+ *  \ingroup ketsji
+ */
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#ifdef WITH_AUDASPACE
+#  include <AUD_Sound.h>
+#endif
+
+struct bSound;
+
+/** Streaming of the long sounds of the sound actuators. A streamed sound decodes its first
+ * chunk at the conversion, a playback of the sound starts from this chunk while a worker thread
+ * opens the file and decodes the rest into a ring buffer per playback.
+ * The short sounds are played from their blender sound, fully buffered if it is cached.
+ */
+class KX_SoundStreamer {
+ public:
+  /// Thread decoding the streamed playbacks, shared with the playbacks it fills.
+  struct Worker;
+
+ private:
+  std::shared_ptr<Worker> m_worker;
+  /// Minimum length in seconds of a streamed sound, 0 to disable the streaming.
+  float m_streamLength;
+#ifdef WITH_AUDASPACE
+  /// Streamed sound of each blender sound, nullptr for the short sounds.
+  std::unordered_map<bSound *, AUD_Sound *> m_sounds;
+#endif
+  /// Protects the sounds, the conversion can run in several threads.
+  std::mutex m_mutex;
+
+ public:
+  KX_SoundStreamer();
+  ~KX_SoundStreamer();
+
+  /// Set the minimum length of the streamed sounds, must be set before the conversion.
+  void SetStreamLength(float length);
+  float GetStreamLength() const;
+
+#ifdef WITH_AUDASPACE
+  /** Return the sound to play for a loaded blender sound, a streamed sound owned by the
+   * streamer for the sounds longer than the stream length, else the sound playback handle.
+   */
+  AUD_Sound *GetSound(bSound *sound);
+#endif
+};
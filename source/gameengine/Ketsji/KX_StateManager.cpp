@@ -0,0 +1,615 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Ketsji/KX_StateManager.cpp
+ *  \ingroup ketsji
+ */
+
+#include "KX_StateManager.h"
+
+#include <cstring>
+#include <unordered_map>
+
+#include "BLI_fileops.h"
+#include "BLI_path_util.h"
+#include "BLI_string.h"
+#include "BLI_task.h"
+#include "BLI_utildefines.h"
+
+#include "BL_Action.h"
+#include "BL_ActionManager.h"
+#include "CM_Message.h"
+#include "EXP_BoolValue.h"
+#include "EXP_FloatValue.h"
+#include "EXP_IntValue.h"
+#include "EXP_StringValue.h"
+#include "KX_GameObject.h"
+#include "KX_Scene.h"
+#include "PHY_IPhysicsController.h"
+#include "SCA_LogicManager.h"
+
+/// Increase when the layout changes, the files of the previous layouts are then refused.
+static const unsigned int stateFileVersion = 1;
+static const char stateFileMagic[8] = "BGESTAT";
+
+enum {
+  STATE_OBJECT_REPLICA = 1,
+  STATE_OBJECT_DYNAMIC = 2,
+};
+
+enum {
+  STATE_PROP_INT = 0,
+  STATE_PROP_FLOAT,
+  STATE_PROP_BOOL,
+  STATE_PROP_STRING,
+};
+
+struct StateProperty {
+  std::string m_name;
+  unsigned char m_type;
+  long long m_int;
+  float m_float;
+  std::string m_string;
+};
+
+struct StateAction {
+  short m_layer;
+  std::string m_name;
+  float m_frame;
+  float m_start;
+  float m_end;
+  float m_speed;
+  float m_layerWeight;
+  short m_priority;
+  short m_playMode;
+  short m_blendMode;
+  short m_ipoFlags;
+};
+
+struct StateObject {
+  std::string m_name;
+  unsigned char m_flags;
+  /// Remaining life of a replica in seconds, 0 for unlimited.
+  float m_life;
+  float m_position[3];
+  float m_orientation[4];
+  float m_scale[3];
+  float m_linearVelocity[3];
+  float m_angularVelocity[3];
+  unsigned int m_state;
+  std::vector<StateProperty> m_properties;
+  std::vector<StateAction> m_actions;
+};
+
+class StateWriter {
+ private:
+  std::vector<char> &m_data;
+
+ public:
+  StateWriter(std::vector<char> &data) : m_data(data)
+  {
+  }
+
+  template<class Item> void Write(const Item &item)
+  {
+    const char *begin = (const char *)&item;
+    m_data.insert(m_data.end(), begin, begin + sizeof(Item));
+  }
+
+  void WriteFloats(const float *values, unsigned int count)
+  {
+    const char *begin = (const char *)values;
+    m_data.insert(m_data.end(), begin, begin + sizeof(float) * count);
+  }
+
+  void WriteString(const std::string &str)
+  {
+    Write((unsigned int)str.size());
+    m_data.insert(m_data.end(), str.begin(), str.end());
+  }
+};
+
+/// Bounds checked read of the file, the items are copied as they are not aligned.
+class StateReader {
+ private:
+  const char *m_data;
+  size_t m_size;
+  size_t m_offset;
+
+ public:
+  StateReader(const std::vector<char> &data)
+      : m_data(data.data()), m_size(data.size()), m_offset(0)
+  {
+  }
+
+  template<class Item> bool Read(Item &item)
+  {
+    if (m_size - m_offset < sizeof(Item)) {
+      return false;
+    }
+
+    memcpy(&item, m_data + m_offset, sizeof(Item));
+    m_offset += sizeof(Item);
+    return true;
+  }
+
+  bool ReadFloats(float *values, unsigned int count)
+  {
+    const size_t length = sizeof(float) * count;
+    if (m_size - m_offset < length) {
+      return false;
+    }
+
+    memcpy(values, m_data + m_offset, length);
+    m_offset += length;
+    return true;
+  }
+
+  bool ReadString(std::string &str)
+  {
+    unsigned int length;
+    if (!Read(length) || m_size - m_offset < length) {
+      return false;
+    }
+
+    str.assign(m_data + m_offset, length);
+    m_offset += length;
+    return true;
+  }
+
+  bool End() const
+  {
+    return m_offset == m_size;
+  }
+};
+
+static void state_write_object(StateWriter &writer, KX_Scene *scene, KX_GameObject *gameobj)
+{
+  PHY_IPhysicsController *ctrl = gameobj->GetPhysicsController();
+  const bool replica = gameobj->IsReplica();
+  const bool dynamic = (ctrl && ctrl->IsDynamic() && !ctrl->IsDynamicsSuspended());
+
+  writer.WriteString(gameobj->GetName());
+  writer.Write((unsigned char)((replica ? STATE_OBJECT_REPLICA : 0) |
+                               (dynamic ? STATE_OBJECT_DYNAMIC : 0)));
+
+  if (replica) {
+    float life = 0.0f;
+    scene->GetTimeBombLife(gameobj, life);
+    writer.Write(life);
+  }
+
+  float values[4];
+  gameobj->NodeGetLocalPosition().getValue(values);
+  writer.WriteFloats(values, 3);
+  const MT_Quaternion orientation = gameobj->NodeGetLocalOrientation().getRotation();
+  orientation.getValue(values);
+  writer.WriteFloats(values, 4);
+  gameobj->NodeGetLocalScaling().getValue(values);
+  writer.WriteFloats(values, 3);
+
+  if (dynamic) {
+    gameobj->GetLinearVelocity(false).getValue(values);
+    writer.WriteFloats(values, 3);
+    gameobj->GetAngularVelocity(false).getValue(values);
+    writer.WriteFloats(values, 3);
+  }
+
+  writer.Write(gameobj->GetState());
+
+  // Only the game properties are saved, not the python values of the object dictionary.
+  std::vector<std::pair<std::string, EXP_Value *>> properties;
+  for (const std::string &name : gameobj->GetPropertyNames()) {
+    EXP_Value *prop = gameobj->GetProperty(name);
+    switch (prop->GetValueType()) {
+      case VALUE_INT_TYPE:
+      case VALUE_FLOAT_TYPE:
+      case VALUE_BOOL_TYPE:
+      case VALUE_STRING_TYPE: {
+        properties.emplace_back(name, prop);
+        break;
+      }
+      default: {
+        break;
+      }
+    }
+  }
+
+  writer.Write((unsigned int)properties.size());
+  for (const std::pair<std::string, EXP_Value *> &pair : properties) {
+    EXP_Value *prop = pair.second;
+    writer.WriteString(pair.first);
+    switch (prop->GetValueType()) {
+      case VALUE_INT_TYPE: {
+        writer.Write((unsigned char)STATE_PROP_INT);
+        writer.Write((long long)static_cast<EXP_IntValue *>(prop)->GetInt());
+        break;
+      }
+      case VALUE_FLOAT_TYPE: {
+        writer.Write((unsigned char)STATE_PROP_FLOAT);
+        writer.Write(static_cast<EXP_FloatValue *>(prop)->GetFloat());
+        break;
+      }
+      case VALUE_BOOL_TYPE: {
+        writer.Write((unsigned char)STATE_PROP_BOOL);
+        writer.Write((unsigned char)static_cast<EXP_BoolValue *>(prop)->GetBool());
+        break;
+      }
+      case VALUE_STRING_TYPE: {
+        writer.Write((unsigned char)STATE_PROP_STRING);
+        writer.WriteString(prop->GetText());
+        break;
+      }
+    }
+  }
+
+  BL_ActionManager *actionManager = gameobj->GetActionManagerNoCreate();
+  std::vector<BL_Action *> actions;
+  std::vector<short> layers;
+  if (actionManager) {
+    for (short layer : actionManager->GetLayers()) {
+      BL_Action *action = actionManager->GetAction(layer);
+      if (action->GetAction() && !action->IsDone()) {
+        actions.push_back(action);
+        layers.push_back(layer);
+      }
+    }
+  }
+
+  writer.Write((unsigned int)actions.size());
+  for (unsigned int i = 0, size = actions.size(); i < size; ++i) {
+    BL_Action *action = actions[i];
+    writer.Write(layers[i]);
+    writer.WriteString(action->GetName());
+    writer.Write(action->GetFrame());
+    writer.Write(action->GetStartFrame());
+    writer.Write(action->GetEndFrame());
+    writer.Write(action->GetSpeed());
+    writer.Write(action->GetLayerWeight());
+    writer.Write(action->GetPriority());
+    writer.Write(action->GetPlayMode());
+    writer.Write(action->GetBlendMode());
+    writer.Write(action->GetIpoFlags());
+  }
+}
+
+static bool state_read_object(StateReader &reader, StateObject &object)
+{
+  if (!reader.ReadString(object.m_name) || !reader.Read(object.m_flags)) {
+    return false;
+  }
+
+  object.m_life = 0.0f;
+  if ((object.m_flags & STATE_OBJECT_REPLICA) && !reader.Read(object.m_life)) {
+    return false;
+  }
+
+  if (!reader.ReadFloats(object.m_position, 3) || !reader.ReadFloats(object.m_orientation, 4) ||
+      !reader.ReadFloats(object.m_scale, 3)) {
+    return false;
+  }
+
+  if ((object.m_flags & STATE_OBJECT_DYNAMIC) &&
+      (!reader.ReadFloats(object.m_linearVelocity, 3) ||
+       !reader.ReadFloats(object.m_angularVelocity, 3))) {
+    return false;
+  }
+
+  unsigned int numProperties;
+  if (!reader.Read(object.m_state) || !reader.Read(numProperties)) {
+    return false;
+  }
+
+  for (unsigned int i = 0; i < numProperties; ++i) {
+    StateProperty prop;
+    if (!reader.ReadString(prop.m_name) || !reader.Read(prop.m_type)) {
+      return false;
+    }
+
+    bool valid;
+    switch (prop.m_type) {
+      case STATE_PROP_INT: {
+        valid = reader.Read(prop.m_int);
+        break;
+      }
+      case STATE_PROP_FLOAT: {
+        valid = reader.Read(prop.m_float);
+        break;
+      }
+      case STATE_PROP_BOOL: {
+        unsigned char value;
+        valid = reader.Read(value);
+        prop.m_int = value;
+        break;
+      }
+      case STATE_PROP_STRING: {
+        valid = reader.ReadString(prop.m_string);
+        break;
+      }
+      default: {
+        valid = false;
+        break;
+      }
+    }
+
+    if (!valid) {
+      return false;
+    }
+    object.m_properties.push_back(prop);
+  }
+
+  unsigned int numActions;
+  if (!reader.Read(numActions)) {
+    return false;
+  }
+
+  for (unsigned int i = 0; i < numActions; ++i) {
+    StateAction action;
+    if (!reader.Read(action.m_layer) || !reader.ReadString(action.m_name) ||
+        !reader.Read(action.m_frame) || !reader.Read(action.m_start) ||
+        !reader.Read(action.m_end) || !reader.Read(action.m_speed) ||
+        !reader.Read(action.m_layerWeight) || !reader.Read(action.m_priority) ||
+        !reader.Read(action.m_playMode) || !reader.Read(action.m_blendMode) ||
+        !reader.Read(action.m_ipoFlags)) {
+      return false;
+    }
+    object.m_actions.push_back(action);
+  }
+
+  return true;
+}
+
+static void state_apply_object(KX_Scene *scene, KX_GameObject *gameobj, const StateObject &object)
+{
+  gameobj->NodeSetLocalPosition(MT_Vector3(object.m_position));
+  gameobj->NodeSetLocalOrientation(MT_Matrix3x3(MT_Quaternion(object.m_orientation)));
+  gameobj->NodeSetLocalScale(MT_Vector3(object.m_scale));
+  gameobj->NodeUpdateGS(0.0f);
+
+  if (object.m_flags & STATE_OBJECT_DYNAMIC) {
+    gameobj->setLinearVelocity(MT_Vector3(object.m_linearVelocity), false);
+    gameobj->setAngularVelocity(MT_Vector3(object.m_angularVelocity), false);
+  }
+
+  gameobj->SetState(object.m_state);
+
+  for (const StateProperty &prop : object.m_properties) {
+    EXP_Value *value;
+    int type;
+    switch (prop.m_type) {
+      case STATE_PROP_INT: {
+        value = new EXP_IntValue(prop.m_int);
+        type = VALUE_INT_TYPE;
+        break;
+      }
+      case STATE_PROP_FLOAT: {
+        value = new EXP_FloatValue(prop.m_float);
+        type = VALUE_FLOAT_TYPE;
+        break;
+      }
+      case STATE_PROP_BOOL: {
+        value = new EXP_BoolValue(prop.m_int != 0);
+        type = VALUE_BOOL_TYPE;
+        break;
+      }
+      default: {
+        value = new EXP_StringValue(prop.m_string, "");
+        type = VALUE_STRING_TYPE;
+        break;
+      }
+    }
+
+    // Keep the existing property, it can be referenced as a timer by the logic.
+    EXP_Value *oldprop = gameobj->GetProperty(prop.m_name);
+    if (oldprop && oldprop->GetValueType() == type) {
+      oldprop->SetValue(value);
+    }
+    else {
+      gameobj->SetProperty(prop.m_name, value);
+    }
+    value->Release();
+  }
+
+  SCA_LogicManager *logicmgr = scene->GetLogicManager();
+  for (const StateAction &action : object.m_actions) {
+    bAction *act = (bAction *)logicmgr->GetActionByName(action.m_name);
+    if (!act) {
+      CM_Warning("action \"" << action.m_name << "\" of object \"" << object.m_name
+                             << "\" not found, not restored");
+      continue;
+    }
+
+    gameobj->PlayAction(act,
+                        action.m_start,
+                        action.m_end,
+                        action.m_layer,
+                        action.m_priority,
+                        0.0f,
+                        action.m_playMode,
+                        action.m_layerWeight,
+                        action.m_ipoFlags,
+                        action.m_speed,
+                        action.m_blendMode);
+    gameobj->SetActionFrame(action.m_layer, action.m_frame);
+  }
+}
+
+struct StateWriteTaskData {
+  std::vector<char> m_data;
+  std::string m_filepath;
+};
+
+static void state_write_task(TaskPool *__restrict UNUSED(pool), void *taskdata)
+{
+  StateWriteTaskData *task = (StateWriteTaskData *)taskdata;
+
+  /* Write in a temporary file first to keep the previous save valid if the game stops during
+   * the write, the name is unique per task as several saves of a file can be written at once. */
+  char tmp_filepath[FILE_MAX];
+  BLI_snprintf(tmp_filepath, sizeof(tmp_filepath), "%s.%p.tmp", task->m_filepath.c_str(), task);
+  FILE *file = BLI_fopen(tmp_filepath, "wb");
+  if (file) {
+    const bool written = (fwrite(task->m_data.data(), 1, task->m_data.size(), file) ==
+                          task->m_data.size());
+    fclose(file);
+
+    if (!written || BLI_rename(tmp_filepath, task->m_filepath.c_str()) != 0) {
+      BLI_delete(tmp_filepath, false, false);
+      CM_Error("failed to write the state file \"" << task->m_filepath << "\"");
+    }
+  }
+  else {
+    CM_Error("failed to open the state file \"" << task->m_filepath << "\"");
+  }
+}
+
+static void state_write_task_free(TaskPool *__restrict UNUSED(pool), void *taskdata)
+{
+  delete (StateWriteTaskData *)taskdata;
+}
+
+KX_StateManager::KX_StateManager()
+{
+  m_pool = BLI_task_pool_create(nullptr, TASK_PRIORITY_LOW);
+}
+
+KX_StateManager::~KX_StateManager()
+{
+  BLI_task_pool_work_and_wait(m_pool);
+  BLI_task_pool_free(m_pool);
+}
+
+void KX_StateManager::Save(KX_Scene *scene, const std::string &filepath)
+{
+  std::vector<KX_GameObject *> objects;
+  for (KX_GameObject *gameobj : scene->GetObjectList()) {
+    /* The children of a replica are added with it, only the root replicas are saved.
+     * The objects without blender object (e.g the default camera) can't be found at load. */
+    if (!gameobj->GetBlenderObject() || (gameobj->IsReplica() && gameobj->GetParent())) {
+      continue;
+    }
+    objects.push_back(gameobj);
+  }
+
+  StateWriteTaskData *task = new StateWriteTaskData();
+  task->m_filepath = filepath;
+
+  StateWriter writer(task->m_data);
+  writer.Write(stateFileMagic);
+  writer.Write(stateFileVersion);
+  writer.Write((unsigned int)objects.size());
+  for (KX_GameObject *gameobj : objects) {
+    state_write_object(writer, scene, gameobj);
+  }
+
+  BLI_task_pool_push(m_pool, state_write_task, task, true, state_write_task_free);
+}
+
+bool KX_StateManager::Load(KX_Scene *scene, const std::string &filepath)
+{
+  // The last save of the file must be written before the read.
+  WaitSaves();
+
+  FILE *file = BLI_fopen(filepath.c_str(), "rb");
+  if (!file) {
+    return false;
+  }
+
+  std::vector<char> data(BLI_file_size(filepath.c_str()));
+  const bool read = (fread(data.data(), 1, data.size(), file) == data.size());
+  fclose(file);
+  if (!read) {
+    return false;
+  }
+
+  StateReader reader(data);
+  char magic[8];
+  unsigned int version;
+  unsigned int numObjects;
+  if (!reader.Read(magic) || memcmp(magic, stateFileMagic, sizeof(magic)) != 0 ||
+      !reader.Read(version) || version != stateFileVersion || !reader.Read(numObjects)) {
+    CM_Error("\"" << filepath << "\" is not a state file of this version");
+    return false;
+  }
+
+  // The whole file is validated before any modification of the scene.
+  std::vector<StateObject> objects;
+  for (unsigned int i = 0; i < numObjects; ++i) {
+    StateObject object;
+    if (!state_read_object(reader, object)) {
+      CM_Error("the state file \"" << filepath << "\" is corrupted");
+      return false;
+    }
+    objects.push_back(object);
+  }
+
+  if (!reader.End()) {
+    CM_Error("the state file \"" << filepath << "\" is corrupted");
+    return false;
+  }
+
+  std::unordered_map<std::string, KX_GameObject *> originals;
+  std::vector<KX_GameObject *> replicas;
+  for (KX_GameObject *gameobj : scene->GetObjectList()) {
+    if (!gameobj->IsReplica()) {
+      originals[gameobj->GetName()] = gameobj;
+    }
+    else if (!gameobj->GetParent()) {
+      replicas.push_back(gameobj);
+    }
+  }
+
+  // The saved replicas replace the current ones.
+  for (KX_GameObject *gameobj : replicas) {
+    scene->DelayedRemoveObject(gameobj);
+  }
+
+  EXP_ListValue<KX_GameObject> *inactiveList = scene->GetInactiveList();
+  for (const StateObject &object : objects) {
+    KX_GameObject *gameobj = nullptr;
+    if (object.m_flags & STATE_OBJECT_REPLICA) {
+      KX_GameObject *original = inactiveList->FindValue(object.m_name);
+      if (original) {
+        // The life is converted back to the frames of AddReplicaObject.
+        gameobj = scene->AddReplicaObject(original, nullptr, object.m_life / 0.02f);
+      }
+    }
+    else {
+      const auto it = originals.find(object.m_name);
+      if (it != originals.end()) {
+        gameobj = it->second;
+      }
+    }
+
+    if (!gameobj) {
+      CM_Warning("object \"" << object.m_name << "\" not found, its state is not restored");
+      continue;
+    }
+
+    state_apply_object(scene, gameobj, object);
+  }
+
+  return true;
+}
+
+void KX_StateManager::WaitSaves()
+{
+  BLI_task_pool_work_and_wait(m_pool);
+}
@@ -0,0 +1,58 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file KX_StateManager.h
+ *  \ingroup ketsji
+ */
+
+#pragma once
+
+#include <string>
+
+class KX_Scene;
+struct TaskPool;
+
+/** Save and load of the state of the objects of a scene in a versioned binary file: the
+ * transforms, the velocities of the dynamic objects, the game properties, the logic states, the
+ * playing actions and the spawned replicas. The objects are identified by name, the replicas are
+ * added again from their inactive original.
+ * The state is serialized on the main thread and written on a worker thread.
+ */
+class KX_StateManager {
+ private:
+  TaskPool *m_pool;
+
+ public:
+  KX_StateManager();
+  ~KX_StateManager();
+
+  /** Serialize the state of a scene and queue the writing of the file.
+   * The file is replaced once fully written, a previous file stays valid until then.
+   */
+  void Save(KX_Scene *scene, const std::string &filepath);
+  /** Wait the pending writes, read a file and apply it to a scene. The current replicas are
+   * removed at the end of the frame.
+   * \return False if the file is missing or invalid, the scene is then unmodified.
+   */
+  bool Load(KX_Scene *scene, const std::string &filepath);
+
+  /// Wait the end of the pending writes.
+  void WaitSaves();
+};
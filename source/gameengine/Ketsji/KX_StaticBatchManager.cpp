@@ -0,0 +1,368 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Ketsji/KX_StaticBatchManager.cpp
+ *  \ingroup ketsji
+ */
+
+#include "KX_StaticBatchManager.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <tuple>
+
+#include "BKE_collection.h"
+#include "BKE_context.h"
+#include "BKE_layer.h"
+#include "BKE_lib_id.h"
+#include "BKE_material.h"
+#include "BKE_mesh.h"
+#include "BKE_modifier.h"
+#include "BKE_object.h"
+#include "BLI_listbase.h"
+#include "BLI_math_matrix.h"
+#include "DEG_depsgraph_query.h"
+#include "DNA_layer_types.h"
+#include "DNA_mesh_types.h"
+#include "DNA_object_types.h"
+#include "bmesh.h"
+
+#include "KX_GameObject.h"
+#include "KX_Globals.h"
+#include "KX_KetsjiEngine.h"
+#include "KX_Scene.h"
+
+/// Size of the areas of the world grouped in a batch, to keep the batches cullable.
+static const float batchCellSize = 64.0f;
+/// Vertices of a batch at most, the objects beyond are merged in a new batch.
+static const unsigned int maxBatchVertices = (1 << 20);
+
+namespace {
+
+/// Settings shared by all the objects of a batch.
+struct BatchKey {
+  std::vector<Material *> m_materials;
+  short m_visibilityFlag;
+  /// Auto smooth angle of the meshes, negative without auto smooth.
+  float m_smoothAngle;
+  int m_cell[3];
+
+  bool operator<(const BatchKey &other) const
+  {
+    return std::tie(
+               m_materials, m_visibilityFlag, m_smoothAngle, m_cell[0], m_cell[1], m_cell[2]) <
+           std::tie(other.m_materials,
+                    other.m_visibilityFlag,
+                    other.m_smoothAngle,
+                    other.m_cell[0],
+                    other.m_cell[1],
+                    other.m_cell[2]);
+  }
+};
+
+}  // namespace
+
+static Mesh *get_evaluated_mesh(Object *ob)
+{
+  Depsgraph *depsgraph = CTX_data_depsgraph_on_load(KX_GetActiveEngine()->GetContext());
+  Object *ob_eval = DEG_get_evaluated_object(depsgraph, ob);
+  return BKE_object_get_evaluated_mesh(ob_eval);
+}
+
+KX_StaticBatchManager::KX_StaticBatchManager(KX_Scene *scene) : m_scene(scene)
+{
+}
+
+KX_StaticBatchManager::~KX_StaticBatchManager()
+{
+  // The objects restored their own visibility when removed.
+  for (Batch *batch : m_batches) {
+    FreeBatchObject(batch);
+    delete batch;
+  }
+}
+
+bool KX_StaticBatchManager::IsBatchable(KX_GameObject *gameobj)
+{
+  Object *ob = gameobj->GetBlenderObject();
+  if (!ob || ob->type != OB_MESH || gameobj->IsInstance() || !gameobj->GetVisible()) {
+    return false;
+  }
+
+  // Objects with logic, motion or a hierarchy are expected to move.
+  if (!gameobj->GetSensors().empty() || !gameobj->GetControllers().empty() ||
+      !gameobj->GetActuators().empty() || gameobj->GetComponents() || gameobj->IsDynamic() ||
+      (ob->gameflag & OB_DYNAMIC) || gameobj->GetParent() ||
+      !gameobj->GetSGNode()->GetSGChildren().empty()) {
+    return false;
+  }
+
+  // Objects animated, deformed or switching their mesh are drawn by themselves.
+  if (ob->adt || gameobj->GetLodManager() || gameobj->IsTransformOverridenByDepsgraph() ||
+      !BLI_listbase_is_empty(&ob->constraints) ||
+      BKE_modifiers_findby_type(ob, eModifierType_Armature) || ((Mesh *)ob->data)->key ||
+      (ob->gameflag & OB_OVERLAY_COLLECTION)) {
+    return false;
+  }
+
+  // A negative scale would flip the faces once merged.
+  return !is_negative_m4(ob->obmat);
+}
+
+void KX_StaticBatchManager::SetObjectHidden(KX_GameObject *gameobj, bool hidden)
+{
+  Scene *scene = m_scene->GetBlenderScene();
+  ViewLayer *view_layer = BKE_view_layer_default_view(scene);
+  Base *base = BKE_view_layer_base_find(view_layer, gameobj->GetBlenderObject());
+  if (!base) {
+    return;
+  }
+
+  if (hidden) {
+    base->flag |= BASE_HIDDEN;
+  }
+  else {
+    base->flag &= ~BASE_HIDDEN;
+  }
+  m_scene->TagForLayerCollectionSync();
+}
+
+void KX_StaticBatchManager::AddObjects(const std::vector<KX_GameObject *> &objects)
+{
+  std::map<BatchKey, Batch *> openBatches;
+
+  for (KX_GameObject *gameobj : objects) {
+    if (!IsBatchable(gameobj)) {
+      continue;
+    }
+
+    Object *ob = gameobj->GetBlenderObject();
+    Mesh *me = get_evaluated_mesh(ob);
+    if (!me || me->totpoly == 0) {
+      continue;
+    }
+
+    BatchKey key;
+    const short totcol = *BKE_object_material_len_p(ob);
+    for (short i = 1; i <= totcol; ++i) {
+      key.m_materials.push_back(BKE_object_material_get(ob, i));
+    }
+    key.m_visibilityFlag = ob->visibility_flag;
+    key.m_smoothAngle = (me->flag & ME_AUTOSMOOTH) ? me->smoothresh : -1.0f;
+
+    float obmat[16];
+    gameobj->NodeGetWorldTransform().getValue(obmat);
+    for (unsigned short i = 0; i < 3; ++i) {
+      key.m_cell[i] = (int)std::floor(obmat[12 + i] / batchCellSize);
+    }
+
+    Batch *&batch = openBatches[key];
+    if (!batch || batch->m_numVertices + me->totvert > maxBatchVertices) {
+      batch = new Batch();
+      batch->m_materials = key.m_materials;
+      batch->m_numVertices = 0;
+      batch->m_object = nullptr;
+      batch->m_mesh = nullptr;
+      batch->m_dirty = true;
+      m_batches.push_back(batch);
+    }
+
+    batch->m_objects.push_back(gameobj);
+    batch->m_numVertices += me->totvert;
+
+    Entry &entry = m_entries[gameobj];
+    entry.m_batch = batch;
+    memcpy(entry.m_obmat, obmat, sizeof(obmat));
+  }
+
+  // A batch of a single object only adds a copy of it.
+  for (std::vector<Batch *>::iterator it = m_batches.begin(); it != m_batches.end();) {
+    Batch *batch = *it;
+    if (batch->m_objects.size() > 1) {
+      for (KX_GameObject *gameobj : batch->m_objects) {
+        gameobj->SetBatched(true);
+        SetObjectHidden(gameobj, true);
+      }
+      ++it;
+      continue;
+    }
+
+    for (KX_GameObject *gameobj : batch->m_objects) {
+      m_entries.erase(gameobj);
+    }
+    delete batch;
+    it = m_batches.erase(it);
+  }
+}
+
+void KX_StaticBatchManager::RemoveObject(KX_GameObject *gameobj)
+{
+  std::unordered_map<KX_GameObject *, Entry>::iterator it = m_entries.find(gameobj);
+  if (it == m_entries.end()) {
+    return;
+  }
+
+  Batch *batch = it->second.m_batch;
+  std::vector<KX_GameObject *> &batchObjects = batch->m_objects;
+  batchObjects.erase(std::find(batchObjects.begin(), batchObjects.end(), gameobj));
+  batch->m_dirty = true;
+  m_entries.erase(it);
+
+  gameobj->SetBatched(false);
+  if (gameobj->GetVisible()) {
+    SetObjectHidden(gameobj, false);
+  }
+}
+
+void KX_StaticBatchManager::UpdateObjectTransform(KX_GameObject *gameobj)
+{
+  std::unordered_map<KX_GameObject *, Entry>::iterator it = m_entries.find(gameobj);
+  if (it == m_entries.end()) {
+    return;
+  }
+
+  float obmat[16];
+  gameobj->NodeGetWorldTransform().getValue(obmat);
+  if (memcmp(obmat, it->second.m_obmat, sizeof(obmat)) != 0) {
+    RemoveObject(gameobj);
+  }
+}
+
+void KX_StaticBatchManager::BuildBatch(Batch *batch)
+{
+  Main *bmain = CTX_data_main(KX_GetActiveEngine()->GetContext());
+
+  BMeshCreateParams createParams = {};
+  createParams.use_toolflags = false;
+  BMesh *bm = BM_mesh_create(&bm_mesh_allocsize_default, &createParams);
+
+  BMeshFromMeshParams fromParams = {};
+  fromParams.calc_face_normal = true;
+
+  // Vertex ranges of the objects, transformed once all the meshes are appended.
+  std::vector<std::pair<int, int>> ranges;
+  Mesh *firstMesh = nullptr;
+  for (KX_GameObject *gameobj : batch->m_objects) {
+    Mesh *me = get_evaluated_mesh(gameobj->GetBlenderObject());
+    if (!me) {
+      ranges.emplace_back(bm->totvert, bm->totvert);
+      continue;
+    }
+
+    if (!firstMesh) {
+      firstMesh = me;
+    }
+    const int start = bm->totvert;
+    BM_mesh_bm_from_me(bm, me, &fromParams);
+    ranges.emplace_back(start, bm->totvert);
+  }
+
+  BM_mesh_elem_table_ensure(bm, BM_VERT);
+  for (unsigned int i = 0, size = batch->m_objects.size(); i < size; ++i) {
+    Entry &entry = m_entries[batch->m_objects[i]];
+    float(*obmat)[4] = (float(*)[4])entry.m_obmat;
+    for (int v = ranges[i].first; v < ranges[i].second; ++v) {
+      mul_m4_v3(obmat, bm->vtable[v]->co);
+    }
+  }
+
+  Mesh *mesh = BKE_mesh_add(bmain, "GE_StaticBatch");
+  BMeshToMeshParams toParams = {};
+  toParams.calc_object_remap = false;
+  BM_mesh_bm_to_me(bmain, bm, mesh, &toParams);
+  BM_mesh_free(bm);
+
+  if (firstMesh && (firstMesh->flag & ME_AUTOSMOOTH)) {
+    mesh->flag |= ME_AUTOSMOOTH;
+    mesh->smoothresh = firstMesh->smoothresh;
+  }
+
+  Object *ob = BKE_object_add_only_object(bmain, OB_MESH, "GE_StaticBatch");
+  id_us_min(&ob->id);
+  ob->data = mesh;
+  Material **matar = batch->m_materials.data();
+  BKE_object_material_array_assign(bmain, ob, &matar, batch->m_materials.size(), false);
+
+  // Draw the batch in the collections of its objects with their visibility settings.
+  Object *first = batch->m_objects.front()->GetBlenderObject();
+  BKE_collection_object_add_from(bmain, m_scene->GetBlenderScene(), first, ob);
+  ob->visibility_flag = first->visibility_flag;
+  ob->base_flag |= (BASE_VISIBLE_VIEWLAYER | BASE_VISIBLE_DEPSGRAPH);
+
+  batch->m_object = ob;
+  batch->m_mesh = mesh;
+}
+
+void KX_StaticBatchManager::FreeBatchObject(Batch *batch)
+{
+  if (!batch->m_object) {
+    return;
+  }
+
+  Main *bmain = CTX_data_main(KX_GetActiveEngine()->GetContext());
+  BKE_id_delete(bmain, batch->m_object);
+  BKE_id_delete(bmain, batch->m_mesh);
+  batch->m_object = nullptr;
+  batch->m_mesh = nullptr;
+}
+
+bool KX_StaticBatchManager::Update()
+{
+  bool updated = false;
+  for (std::vector<Batch *>::iterator it = m_batches.begin(); it != m_batches.end();) {
+    Batch *batch = *it;
+    if (!batch->m_dirty) {
+      ++it;
+      continue;
+    }
+
+    FreeBatchObject(batch);
+    updated = true;
+
+    if (batch->m_objects.empty()) {
+      delete batch;
+      it = m_batches.erase(it);
+      continue;
+    }
+
+    BuildBatch(batch);
+    batch->m_dirty = false;
+    ++it;
+  }
+
+  if (updated) {
+    m_scene->TagForCollectionRemap();
+    m_scene->TagForRelationsUpdate();
+  }
+
+  return updated;
+}
+
+unsigned int KX_StaticBatchManager::GetNumBatches() const
+{
+  return m_batches.size();
+}
+
+unsigned int KX_StaticBatchManager::GetNumBatchedObjects() const
+{
+  return m_entries.size();
+}
@@ -0,0 +1,90 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file KX_StaticBatchManager.h
+ *  \ingroup ketsji
+ */
+
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+
+class KX_GameObject;
+class KX_Scene;
+struct Material;
+struct Mesh;
+struct Object;
+
+/** Merge the meshes of the objects never moved by the game into a few combined blender
+ * objects drawn instead of the originals. The objects are grouped by materials, visibility
+ * settings and area of the world so that a batch draws only once per material and can still
+ * be culled. The original objects are hidden but keep their game object and collision shape.
+ * An object moved, hidden or removed leaves its batch, which is rebuilt before the next render.
+ */
+class KX_StaticBatchManager {
+ private:
+  struct Batch {
+    std::vector<Material *> m_materials;
+    std::vector<KX_GameObject *> m_objects;
+    /// Number of vertices of the merged meshes.
+    unsigned int m_numVertices;
+    /// Combined object and its mesh, nullptr until built.
+    Object *m_object;
+    Mesh *m_mesh;
+    /// The objects changed since the last build.
+    bool m_dirty;
+  };
+
+  struct Entry {
+    Batch *m_batch;
+    /// World matrix of the object when batched, a moved object leaves its batch.
+    float m_obmat[16];
+  };
+
+  KX_Scene *m_scene;
+  std::vector<Batch *> m_batches;
+  std::unordered_map<KX_GameObject *, Entry> m_entries;
+
+  /// Return true if the object is static and its mesh can be merged.
+  static bool IsBatchable(KX_GameObject *gameobj);
+  void SetObjectHidden(KX_GameObject *gameobj, bool hidden);
+  void BuildBatch(Batch *batch);
+  void FreeBatchObject(Batch *batch);
+
+ public:
+  KX_StaticBatchManager(KX_Scene *scene);
+  ~KX_StaticBatchManager();
+
+  /// Merge the static objects of a list into batches, built before the next render.
+  void AddObjects(const std::vector<KX_GameObject *> &objects);
+  /// Restore the drawing of an object by its blender object and rebuild its batch without it.
+  void RemoveObject(KX_GameObject *gameobj);
+  /// Remove an object from its batch if its world transform changed since it was batched.
+  void UpdateObjectTransform(KX_GameObject *gameobj);
+
+  /** Rebuild the combined objects of the changed batches.
+   * \return True if any batch changed.
+   */
+  bool Update();
+
+  unsigned int GetNumBatches() const;
+  unsigned int GetNumBatchedObjects() const;
+};
@@ -0,0 +1,123 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Ketsji/KX_TaskFuture.cpp
+ *  \ingroup ketsji
+ */
+
+#ifdef WITH_PYTHON
+
+#  include "KX_TaskFuture.h"
+
+#  include "KX_PythonCoroutine.h"
+
+KX_TaskFuture::KX_TaskFuture() : m_result(nullptr), m_done(false)
+{
+}
+
+KX_TaskFuture::~KX_TaskFuture()
+{
+  Py_XDECREF(m_result);
+}
+
+std::string KX_TaskFuture::GetName()
+{
+  return "KX_TaskFuture";
+}
+
+void *KX_TaskFuture::GetExclusiveData() const
+{
+  return nullptr;
+}
+
+void KX_TaskFuture::Finish()
+{
+  m_result = ConvertResult();
+  m_done = true;
+}
+
+bool KX_TaskFuture::IsDone() const
+{
+  return m_done;
+}
+
+PyTypeObject KX_TaskFuture::Type = {PyVarObject_HEAD_INIT(nullptr, 0) "KX_TaskFuture",
+                                    sizeof(EXP_PyObjectPlus_Proxy),
+                                    0,
+                                    py_base_dealloc,
+                                    0,
+                                    0,
+                                    0,
+                                    &KX_CoroutineWait_TaskAsync,
+                                    py_base_repr,
+                                    0,
+                                    0,
+                                    0,
+                                    0,
+                                    0,
+                                    0,
+                                    0,
+                                    0,
+                                    0,
+                                    Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE,
+                                    0,
+                                    0,
+                                    0,
+                                    0,
+                                    0,
+                                    0,
+                                    0,
+                                    Methods,
+                                    0,
+                                    0,
+                                    &EXP_Value::Type,
+                                    0,
+                                    0,
+                                    0,
+                                    0,
+                                    0,
+                                    0,
+                                    py_base_new};
+
+PyMethodDef KX_TaskFuture::Methods[] = {
+    {nullptr, nullptr}  // Sentinel
+};
+
+PyAttributeDef KX_TaskFuture::Attributes[] = {
+    EXP_PYATTRIBUTE_BOOL_RO("done", KX_TaskFuture, m_done),
+    EXP_PYATTRIBUTE_RO_FUNCTION("result", KX_TaskFuture, pyattr_get_result),
+    EXP_PYATTRIBUTE_NULL  // Sentinel
+};
+
+PyObject *KX_TaskFuture::pyattr_get_result(EXP_PyObjectPlus *self_v,
+                                           const EXP_PYATTRIBUTE_DEF *attrdef)
+{
+  KX_TaskFuture *self = static_cast<KX_TaskFuture *>(self_v);
+  if (!self->m_result) {
+    Py_RETURN_NONE;
+  }
+
+  Py_INCREF(self->m_result);
+  return self->m_result;
+}
+
+#endif  // WITH_PYTHON
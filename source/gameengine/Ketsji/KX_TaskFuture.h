@@ -0,0 +1,66 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file KX_TaskFuture.h
+ *  \ingroup ketsji
+ */
+
+#pragma once
+
+#ifdef WITH_PYTHON
+
+#  include "EXP_Value.h"
+
+/** Result of a query submitted from python and computed without python in a worker thread.
+ * The pending tasks of a scene are run in parallel once the logic and the physics of the scene
+ * are done, their result is available from the next frame.
+ */
+class KX_TaskFuture : public EXP_Value {
+  Py_Header
+
+ protected:
+  PyObject *m_result;
+  bool m_done;
+
+ public:
+  KX_TaskFuture();
+  virtual ~KX_TaskFuture();
+
+  virtual std::string GetName();
+
+  /** Return the data that the task modifies, the tasks sharing the same data run one after
+   * the other, nullptr if the task can run in parallel of any other task.
+   */
+  virtual void *GetExclusiveData() const;
+  /// Compute the task from a worker thread, python must not be used here.
+  virtual void Run() = 0;
+  /// Convert the result of the task once it ran, called from the main thread.
+  virtual PyObject *ConvertResult() = 0;
+
+  /// Convert the result and set the task done.
+  void Finish();
+  bool IsDone() const;
+
+  static PyObject *pyattr_get_result(EXP_PyObjectPlus *self_v, const EXP_PYATTRIBUTE_DEF *attrdef);
+};
+
+#endif  // WITH_PYTHON
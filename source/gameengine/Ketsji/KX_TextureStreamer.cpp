@@ -0,0 +1,468 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Ketsji/KX_TextureStreamer.cpp
+ *  \ingroup ketsji
+ */
+
+#include "KX_TextureStreamer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <queue>
+
+#include "BKE_image.h"
+#include "GPU_capabilities.h"
+#include "GPU_state.h"
+#include "GPU_texture.h"
+#include "IMB_imbuf.h"
+#include "IMB_imbuf_types.h"
+
+#include "BL_Texture.h"
+#include "KX_Camera.h"
+#include "KX_GameObject.h"
+#include "KX_Scene.h"
+#include "RAS_IPolygonMaterial.h"
+#include "RAS_MaterialBucket.h"
+#include "RAS_MeshObject.h"
+
+/// The lowest level is the first one with a size under this size in pixels.
+static const int minLevelSize = 64;
+/// Number of textures uploaded per frame at most, each upload rescales the image.
+static const unsigned int maxUploads = 2;
+/// Number of frames a texture keeps its level after the objects using it are no longer seen.
+static const unsigned int holdFrames = 120;
+
+KX_TextureStreamer::KX_TextureStreamer()
+    : m_enabled(false), m_budget(1024 * 1048576), m_residentMemory(0), m_frame(0)
+{
+}
+
+KX_TextureStreamer::~KX_TextureStreamer()
+{
+  for (auto &pair : m_entries) {
+    Restore(pair.second);
+  }
+}
+
+void KX_TextureStreamer::SetEnabled(bool enabled)
+{
+  m_enabled = enabled;
+}
+
+bool KX_TextureStreamer::GetEnabled() const
+{
+  return m_enabled;
+}
+
+void KX_TextureStreamer::SetBudget(size_t budget)
+{
+  m_budget = budget;
+}
+
+size_t KX_TextureStreamer::GetBudget() const
+{
+  return m_budget;
+}
+
+size_t KX_TextureStreamer::GetResidentMemory() const
+{
+  return m_residentMemory;
+}
+
+size_t KX_TextureStreamer::GetLevelMemory(const Entry &entry, short level) const
+{
+  if (level < 0) {
+    return 0;
+  }
+
+  const size_t width = std::max(entry.m_width >> level, 1);
+  const size_t height = std::max(entry.m_height >> level, 1);
+  // The mipmaps add a third of the first level.
+  return width * height * entry.m_pixelSize * 4 / 3;
+}
+
+GPUTexture **KX_TextureStreamer::GetImageSlot(const Entry &entry) const
+{
+  return &entry.m_image->gputexture[TEXTARGET_2D][0][IMA_TEXTURE_RESOLUTION_FULL];
+}
+
+void KX_TextureStreamer::RegisterImage(Image *ima, ImageUser *iuser)
+{
+  if (!m_enabled) {
+    return;
+  }
+
+  Entry &entry = m_entries[ima];
+  if (entry.m_image) {
+    return;
+  }
+
+  entry.m_image = ima;
+  entry.m_useImageUser = (iuser != nullptr);
+  if (iuser) {
+    entry.m_imageUser = *iuser;
+  }
+  entry.m_streamed = false;
+  entry.m_level = -1;
+  entry.m_targetLevel = -1;
+  entry.m_pixels = 0.0f;
+  entry.m_requestFrame = 0;
+  entry.m_texture = nullptr;
+  entry.m_savedGpuFlag = ima->gpuflag;
+
+  // The sequences, movies, tiles, generated and multiview images keep their own textures.
+  if (ima->source != IMA_SRC_FILE || ima->type != IMA_TYPE_IMAGE ||
+      BKE_image_is_multiview(ima)) {
+    return;
+  }
+
+  ImageUser *user = entry.m_useImageUser ? &entry.m_imageUser : nullptr;
+  ImBuf *ibuf = BKE_image_acquire_ibuf(ima, user, nullptr);
+  if (!ibuf) {
+    return;
+  }
+
+  // The compressed textures are uploaded with their own mipmaps.
+  bool compressed = false;
+#ifdef WITH_DDS
+  compressed = (ibuf->ftype == IMB_FTYPE_DDS);
+#endif
+  if (!compressed) {
+    // The level 0 respects the texture size limit of the user preferences.
+    entry.m_width = GPU_texture_size_with_limit(ibuf->x, true);
+    entry.m_height = GPU_texture_size_with_limit(ibuf->y, true);
+    if (ibuf->rect_float) {
+      entry.m_pixelSize = ((ima->flag & IMA_HIGH_BITDEPTH) && !(ibuf->flags & IB_halffloat)) ?
+                              16 :
+                              8;
+    }
+    else {
+      entry.m_pixelSize = 4;
+    }
+
+    entry.m_numLevels = 0;
+    while ((std::max(entry.m_width, entry.m_height) >> entry.m_numLevels) > minLevelSize) {
+      ++entry.m_numLevels;
+    }
+    entry.m_wantedLevel = entry.m_numLevels;
+    entry.m_streamed = true;
+  }
+
+  BKE_image_release_ibuf(ima, ibuf, nullptr);
+
+  if (entry.m_streamed) {
+    // Upload the lowest level first, the next levels are promoted when the image is seen.
+    SetLevel(entry, entry.m_numLevels);
+  }
+}
+
+void KX_TextureStreamer::AddTexture(BL_Texture *texture)
+{
+  const auto it = m_entries.find(texture->GetImage());
+  if (it == m_entries.end()) {
+    return;
+  }
+
+  it->second.m_textures.push_back(texture);
+  m_materialEntries.clear();
+}
+
+void KX_TextureStreamer::RemoveTexture(BL_Texture *texture)
+{
+  const auto it = m_entries.find(texture->GetImage());
+  if (it == m_entries.end()) {
+    return;
+  }
+
+  Entry &entry = it->second;
+  entry.m_textures.erase(std::remove(entry.m_textures.begin(), entry.m_textures.end(), texture),
+                         entry.m_textures.end());
+  m_materialEntries.clear();
+
+  if (entry.m_textures.empty()) {
+    Restore(entry);
+    m_entries.erase(it);
+  }
+}
+
+const std::vector<KX_TextureStreamer::Entry *> &KX_TextureStreamer::GetMaterialEntries(
+    RAS_IPolyMaterial *polymat)
+{
+  const auto it = m_materialEntries.find(polymat);
+  if (it != m_materialEntries.end()) {
+    return it->second;
+  }
+
+  std::vector<Entry *> &entries = m_materialEntries[polymat];
+  for (unsigned short i = 0; i < RAS_Texture::MaxUnits; ++i) {
+    RAS_Texture *texture = polymat->GetTexture(i);
+    if (!texture) {
+      continue;
+    }
+
+    const auto entryIt = m_entries.find(texture->GetImage());
+    if (entryIt != m_entries.end() && entryIt->second.m_streamed) {
+      entries.push_back(&entryIt->second);
+    }
+  }
+
+  return entries;
+}
+
+void KX_TextureStreamer::Request(Entry &entry, float pixels)
+{
+  /* A texture mapped once on the object needs as many texels as the pixels covered,
+   * each level finer than the object size on screen is useless. */
+  const float size = std::max(entry.m_width, entry.m_height);
+  const short level = (pixels > 1.0f) ? std::max(short(std::log2(size / pixels)), short(0)) :
+                                        entry.m_numLevels;
+
+  if (entry.m_requestFrame != m_frame) {
+    entry.m_requestFrame = m_frame;
+    entry.m_wantedLevel = std::min(level, entry.m_numLevels);
+    entry.m_pixels = pixels;
+  }
+  else {
+    entry.m_wantedLevel = std::min(entry.m_wantedLevel, level);
+    entry.m_pixels = std::max(entry.m_pixels, pixels);
+  }
+}
+
+void KX_TextureStreamer::AddView(KX_Scene *scene,
+                                 KX_Camera *cam,
+                                 const int viewport[4],
+                                 bool culled)
+{
+  if (m_entries.empty()) {
+    return;
+  }
+
+  const RAS_CameraData *camdata = cam->GetCameraData();
+  const MT_Vector3 campos = cam->NodeGetWorldPosition();
+  // Size in pixels of a unit at a unit distance or of a unit in orthographic.
+  const float pixelScale = viewport[3] * cam->GetProjectionMatrix()[1][1] * 0.5f;
+
+  for (KX_GameObject *gameobj : *scene->GetObjectList()) {
+    if (!gameobj->GetVisible() || gameobj->GetMeshCount() == 0) {
+      continue;
+    }
+    if (culled && gameobj->UseCulling() && gameobj->GetCullingNode().GetCulled()) {
+      continue;
+    }
+
+    const SG_BBox &aabb = gameobj->GetCullingNode().GetAabb();
+    const MT_Transform trans = gameobj->NodeGetWorldTransform();
+    const MT_Vector3 extent = trans.getBasis().absolute() * ((aabb.GetMax() - aabb.GetMin()) *
+                                                             0.5f);
+    const float diameter = extent.length() * 2.0f;
+
+    float pixels = diameter * pixelScale;
+    if (camdata->m_perspective) {
+      const float distance = (trans(aabb.GetCenter()) - campos).length() - diameter * 0.5f;
+      pixels /= std::max(distance, camdata->m_clipstart);
+    }
+
+    for (unsigned short i = 0, numMeshes = gameobj->GetMeshCount(); i < numMeshes; ++i) {
+      RAS_MeshObject *meshobj = gameobj->GetMesh(i);
+      for (unsigned short j = 0, numMats = meshobj->NumMaterials(); j < numMats; ++j) {
+        RAS_IPolyMaterial *polymat = meshobj->GetMeshMaterial(j)->GetBucket()->GetPolyMaterial();
+        for (Entry *entry : GetMaterialEntries(polymat)) {
+          Request(*entry, pixels);
+        }
+      }
+    }
+  }
+}
+
+bool KX_TextureStreamer::SetLevel(Entry &entry, short level)
+{
+  ImageUser *user = entry.m_useImageUser ? &entry.m_imageUser : nullptr;
+  ImBuf *ibuf = BKE_image_acquire_ibuf(entry.m_image, user, nullptr);
+  if (!ibuf) {
+    return false;
+  }
+
+  Image *ima = entry.m_image;
+  GPUTexture *tex = IMB_create_gpu_texture_scaled(
+      ima->id.name + 2,
+      ibuf,
+      std::max(entry.m_width >> level, 1),
+      std::max(entry.m_height >> level, 1),
+      (ima->flag & IMA_HIGH_BITDEPTH),
+      BKE_image_has_gpu_texture_premultiplied_alpha(ima, ibuf));
+  BKE_image_release_ibuf(ima, ibuf, nullptr);
+
+  if (!tex) {
+    return false;
+  }
+
+  // Same settings as the textures created by the image.
+  GPU_texture_wrap_mode(tex, true, false);
+  if (GPU_mipmap_enabled()) {
+    GPU_texture_generate_mipmap(tex);
+    ima->gpuflag |= IMA_GPU_MIPMAP_COMPLETE;
+    GPU_texture_mipmap_mode(tex, true, true);
+  }
+  else {
+    GPU_texture_mipmap_mode(tex, false, true);
+  }
+
+  /* The image returns the texture of its slot as long as its pass, layer and view are not
+   * changed, and the full resolution slot is used even with a texture size limit. */
+  ima->gpu_pass = user ? user->pass : 0;
+  ima->gpu_layer = user ? user->layer : 0;
+  ima->gpu_view = (user && user->multi_index >= 2) ? user->multi_index : 0;
+  ima->gpuflag &= ~(IMA_GPU_REFRESH | IMA_GPU_PARTIAL_REFRESH);
+  ima->gpuflag |= IMA_GPU_REUSE_MAX_RESOLUTION;
+
+  GPUTexture **slot = GetImageSlot(entry);
+  if (*slot) {
+    // The material textures keep a reference until they are updated.
+    GPU_texture_free(*slot);
+  }
+  *slot = tex;
+
+  // An unknown level was already removed from the resident memory.
+  m_residentMemory += GetLevelMemory(entry, level) - GetLevelMemory(entry, entry.m_level);
+  entry.m_texture = tex;
+  entry.m_level = level;
+
+  for (BL_Texture *texture : entry.m_textures) {
+    texture->CheckValidTexture();
+  }
+
+  return true;
+}
+
+void KX_TextureStreamer::Restore(Entry &entry)
+{
+  if (!entry.m_streamed) {
+    return;
+  }
+
+  // Let the image create its own texture again, at the resolution of the user preferences.
+  GPUTexture **slot = GetImageSlot(entry);
+  if (*slot && *slot == entry.m_texture) {
+    GPU_texture_free(*slot);
+    *slot = nullptr;
+  }
+  m_residentMemory -= GetLevelMemory(entry, entry.m_level);
+
+  Image *ima = entry.m_image;
+  ima->gpuflag = (ima->gpuflag & ~IMA_GPU_REUSE_MAX_RESOLUTION) |
+                 (entry.m_savedGpuFlag & IMA_GPU_REUSE_MAX_RESOLUTION);
+
+  for (BL_Texture *texture : entry.m_textures) {
+    texture->CheckValidTexture();
+  }
+}
+
+void KX_TextureStreamer::Update()
+{
+  size_t targetMemory = 0;
+  std::vector<Entry *> entries;
+  for (auto &pair : m_entries) {
+    Entry &entry = pair.second;
+    if (!entry.m_streamed) {
+      continue;
+    }
+
+    // The image was reloaded or its texture freed, the resident level is unknown.
+    if (*GetImageSlot(entry) != entry.m_texture) {
+      m_residentMemory -= GetLevelMemory(entry, entry.m_level);
+      entry.m_texture = nullptr;
+      entry.m_level = -1;
+    }
+
+    const bool seen = (entry.m_requestFrame + holdFrames >= m_frame);
+    entry.m_targetLevel = seen ? entry.m_wantedLevel : entry.m_numLevels;
+    if (!seen) {
+      entry.m_pixels = 0.0f;
+    }
+    targetMemory += GetLevelMemory(entry, entry.m_targetLevel);
+    entries.push_back(&entry);
+  }
+
+  // Demote the textures the smallest on screen until the levels fit in the budget.
+  const auto smaller = [](const Entry *a, const Entry *b) { return a->m_pixels > b->m_pixels; };
+  std::priority_queue<Entry *, std::vector<Entry *>, decltype(smaller)> queue(smaller);
+  for (Entry *entry : entries) {
+    if (entry->m_targetLevel < entry->m_numLevels) {
+      queue.push(entry);
+    }
+  }
+  while (targetMemory > m_budget && !queue.empty()) {
+    Entry *entry = queue.top();
+    queue.pop();
+    targetMemory -= GetLevelMemory(*entry, entry->m_targetLevel);
+    ++entry->m_targetLevel;
+    targetMemory += GetLevelMemory(*entry, entry->m_targetLevel);
+    if (entry->m_targetLevel < entry->m_numLevels) {
+      queue.push(entry);
+    }
+  }
+
+  /* Apply the unknown levels and the demotions first to free the memory, the largest first,
+   * then the promotions of the textures the largest on screen. */
+  std::vector<Entry *> changes;
+  for (Entry *entry : entries) {
+    if (entry->m_targetLevel != entry->m_level) {
+      changes.push_back(entry);
+    }
+  }
+  std::sort(changes.begin(), changes.end(), [this](const Entry *a, const Entry *b) {
+    const bool demoteA = (a->m_level == -1 || a->m_targetLevel > a->m_level);
+    const bool demoteB = (b->m_level == -1 || b->m_targetLevel > b->m_level);
+    if (demoteA != demoteB) {
+      return demoteA;
+    }
+    if (demoteA) {
+      return GetLevelMemory(*a, a->m_level) > GetLevelMemory(*b, b->m_level);
+    }
+    return a->m_pixels > b->m_pixels;
+  });
+
+  unsigned int uploads = 0;
+  for (Entry *entry : changes) {
+    if (uploads == maxUploads) {
+      break;
+    }
+
+    const bool promote = (entry->m_level != -1 && entry->m_targetLevel < entry->m_level);
+    if (promote && (m_residentMemory + GetLevelMemory(*entry, entry->m_targetLevel) -
+                    GetLevelMemory(*entry, entry->m_level)) > m_budget) {
+      // Wait for the demotions of the next frames.
+      break;
+    }
+
+    if (!SetLevel(*entry, entry->m_targetLevel)) {
+      // Leave the image to the default texture creation.
+      Restore(*entry);
+      entry->m_streamed = false;
+      m_materialEntries.clear();
+    }
+    ++uploads;
+  }
+
+  ++m_frame;
+}
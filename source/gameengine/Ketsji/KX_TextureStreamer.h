@@ -0,0 +1,124 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file KX_TextureStreamer.h
+ *  \ingroup ketsji
+ */
+
+#pragma once
+
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+#include "DNA_image_types.h"
+
+class BL_Texture;
+class KX_Camera;
+class KX_Scene;
+class RAS_IPolyMaterial;
+struct GPUTexture;
+
+/** Resolution of the image textures of the materials according to their size on screen.
+ * The textures are uploaded at their lowest level first, a level halves the resolution of
+ * the previous one. The levels requested by the visible objects of the rendered views are
+ * promoted and the textures not seen for a while are demoted, the total memory is kept under
+ * a budget by demoting first the textures the smallest on screen.
+ */
+class KX_TextureStreamer {
+ private:
+  struct Entry {
+    Image *m_image;
+    ImageUser m_imageUser;
+    bool m_useImageUser;
+    /// False if the image can't be streamed, its texture is left to the image.
+    bool m_streamed;
+    /// Size of the level 0.
+    int m_width;
+    int m_height;
+    /// Bytes per pixel of the texture format.
+    unsigned short m_pixelSize;
+    /// Index of the lowest level.
+    short m_numLevels;
+    /// Resident level, -1 if the texture of the image was replaced outside the streamer.
+    short m_level;
+    /// Level requested by the views of the last frame it was seen.
+    short m_wantedLevel;
+    /// Level to reach after checking the budget.
+    short m_targetLevel;
+    /// Size in pixels of the largest object using the texture in the last frame it was seen.
+    float m_pixels;
+    unsigned int m_requestFrame;
+    /// Texture owned by the image slot, used to detect a reload of the image.
+    GPUTexture *m_texture;
+    /// The image gpu flag changed by the streamer.
+    short m_savedGpuFlag;
+    std::vector<BL_Texture *> m_textures;
+  };
+
+  bool m_enabled;
+  /// Memory in bytes of all the streamed textures at most.
+  size_t m_budget;
+  size_t m_residentMemory;
+  unsigned int m_frame;
+  std::map<Image *, Entry> m_entries;
+  /// Entries of the textures of each drawn material.
+  std::unordered_map<RAS_IPolyMaterial *, std::vector<Entry *>> m_materialEntries;
+
+  size_t GetLevelMemory(const Entry &entry, short level) const;
+  GPUTexture **GetImageSlot(const Entry &entry) const;
+  const std::vector<Entry *> &GetMaterialEntries(RAS_IPolyMaterial *polymat);
+  void Request(Entry &entry, float pixels);
+  bool SetLevel(Entry &entry, short level);
+  void Restore(Entry &entry);
+
+ public:
+  KX_TextureStreamer();
+  ~KX_TextureStreamer();
+
+  /// Enable the streaming, must be set before the conversion of the materials.
+  void SetEnabled(bool enabled);
+  bool GetEnabled() const;
+
+  void SetBudget(size_t budget);
+  size_t GetBudget() const;
+  /// Return the memory in bytes of the streamed textures.
+  size_t GetResidentMemory() const;
+
+  /** Upload the lowest level of an image texture if it is not registered yet.
+   * Must be called before the first request of the image texture.
+   */
+  void RegisterImage(Image *ima, ImageUser *iuser);
+  /// Register a material texture to update when the image texture changes.
+  void AddTexture(BL_Texture *texture);
+  /// Unregister a material texture, the image texture is restored once unused.
+  void RemoveTexture(BL_Texture *texture);
+
+  /** Request the levels of the textures of the visible objects of a view.
+   * \param viewport The camera viewport, its height gives the size of the objects on screen.
+   * \param culled True if the objects were culled for this view.
+   */
+  void AddView(KX_Scene *scene, KX_Camera *cam, const int viewport[4], bool culled);
+
+  /// Change the resident levels to the requested ones under the budget.
+  void Update();
+};
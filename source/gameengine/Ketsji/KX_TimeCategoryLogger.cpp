@@ -31,21 +31,36 @@
 
 #include "KX_TimeCategoryLogger.h"
 
+#include <cstdint>
+
+#include "MEM_guardedalloc.h"
+
+#include "CM_Trace.h"
+
 KX_TimeCategoryLogger::KX_TimeCategoryLogger(const CM_Clock &clock,
                                              unsigned int maxNumMeasurements)
 
-    : m_clock(clock), m_maxNumMeasurements(maxNumMeasurements), m_lastCategory(-1)
+    : m_clock(clock), m_maxNumMeasurements(maxNumMeasurements), m_lastCategory(-1),
+      m_traceOpen(false),
+      m_countAllocations(false),
+      m_allocCount(0),
+      m_allocBytes(0),
+      m_blocksInUse(0),
+      m_memoryInUse(0)
 {
 }
 
 KX_TimeCategoryLogger::~KX_TimeCategoryLogger()
 {
+  if (m_countAllocations) {
+    MEM_set_allocation_counting(false);
+  }
 }
 
 void KX_TimeCategoryLogger::SetMaxNumMeasurements(unsigned int maxNumMeasurements)
 {
-  for (TimeLoggerMap::value_type &pair : m_loggers) {
-    pair.second.SetMaxNumMeasurements(maxNumMeasurements);
+  for (KX_TimeLogger &logger : m_loggers) {
+    logger.SetMaxNumMeasurements(maxNumMeasurements);
   }
   m_maxNumMeasurements = maxNumMeasurements;
 }
@@ -55,42 +70,130 @@ unsigned int KX_TimeCategoryLogger::GetMaxNumMeasurements() const
   return m_maxNumMeasurements;
 }
 
-void KX_TimeCategoryLogger::AddCategory(TimeCategory tc)
+void KX_TimeCategoryLogger::AddCategory(TimeCategory tc, const char *traceName)
 {
   // Only add if not already present
-  if (m_loggers.find(tc) == m_loggers.end()) {
-    m_loggers.emplace(TimeLoggerMap::value_type(tc, KX_TimeLogger(m_maxNumMeasurements)));
+  if (tc >= (TimeCategory)m_loggers.size()) {
+    m_loggers.resize(tc + 1, KX_TimeLogger(m_maxNumMeasurements));
+    m_traceNames.resize(tc + 1, nullptr);
+    m_allocations.resize(tc + 1, AllocationCounters{0, 0, 0, 0});
+    m_lastAllocations.resize(tc + 1, AllocationCounters{0, 0, 0, 0});
+  }
+  if (traceName) {
+    m_traceNames[tc] = traceName;
+  }
+}
+
+void KX_TimeCategoryLogger::TraceCategory(TimeCategory tc)
+{
+  if (m_traceOpen) {
+    CM_Trace::End(CM_Trace::TRACK_TIME_CATEGORIES);
+    m_traceOpen = false;
+  }
+
+  if (tc != -1 && m_traceNames[tc] && CM_Trace::IsEnabled()) {
+    CM_Trace::Begin(m_traceNames[tc], "", CM_Trace::TRACK_TIME_CATEGORIES);
+    m_traceOpen = true;
+  }
+}
+
+void KX_TimeCategoryLogger::CountAllocations()
+{
+  size_t count;
+  size_t bytes;
+  MEM_get_allocation_counters(&count, &bytes);
+  const unsigned int blocksInUse = MEM_get_memory_blocks_in_use();
+  const size_t memoryInUse = MEM_get_memory_in_use();
+
+  if (m_lastCategory != -1) {
+    AllocationCounters &counters = m_allocations[m_lastCategory];
+    const size_t allocations = count - m_allocCount;
+    const size_t allocatedBytes = bytes - m_allocBytes;
+    /* The frees are the allocations not added to the memory in use. The counters of the
+     * allocator are not updated at once by the other threads, the deduced frees are clamped. */
+    const int64_t frees = (int64_t)allocations - ((int64_t)blocksInUse - (int64_t)m_blocksInUse);
+    const int64_t freedBytes = (int64_t)allocatedBytes -
+                               ((int64_t)memoryInUse - (int64_t)m_memoryInUse);
+    counters.m_allocations += allocations;
+    counters.m_allocatedBytes += allocatedBytes;
+    counters.m_frees += (frees > 0) ? frees : 0;
+    counters.m_freedBytes += (freedBytes > 0) ? freedBytes : 0;
   }
+
+  m_allocCount = count;
+  m_allocBytes = bytes;
+  m_blocksInUse = blocksInUse;
+  m_memoryInUse = memoryInUse;
 }
 
 void KX_TimeCategoryLogger::StartLog(TimeCategory tc)
 {
+  if (m_countAllocations) {
+    CountAllocations();
+  }
+
   const double now = m_clock.GetTimeSecond();
   if (m_lastCategory != -1) {
     m_loggers[m_lastCategory].EndLog(now);
   }
   m_loggers[tc].StartLog(now);
   m_lastCategory = tc;
+
+  if (m_traceOpen || CM_Trace::IsEnabled()) {
+    TraceCategory(tc);
+  }
 }
 
 void KX_TimeCategoryLogger::EndLog(TimeCategory tc)
 {
+  if (m_countAllocations && tc == m_lastCategory) {
+    CountAllocations();
+  }
+
   const double now = m_clock.GetTimeSecond();
   m_loggers[tc].EndLog(now);
+
+  if (m_traceOpen && tc == m_lastCategory) {
+    TraceCategory(-1);
+  }
 }
 
 void KX_TimeCategoryLogger::EndLog()
 {
+  if (m_lastCategory == -1) {
+    return;
+  }
+
+  if (m_countAllocations) {
+    CountAllocations();
+  }
+
   const double now = m_clock.GetTimeSecond();
   m_loggers[m_lastCategory].EndLog(now);
   m_lastCategory = -1;
+
+  if (m_traceOpen) {
+    TraceCategory(-1);
+  }
 }
 
 void KX_TimeCategoryLogger::NextMeasurement()
 {
   const double now = m_clock.GetTimeSecond();
-  for (TimeLoggerMap::value_type &pair : m_loggers) {
-    pair.second.NextMeasurement(now);
+  for (KX_TimeLogger &logger : m_loggers) {
+    logger.NextMeasurement(now);
+  }
+
+  if (m_countAllocations) {
+    CountAllocations();
+  }
+  m_lastAllocations.swap(m_allocations);
+  for (AllocationCounters &counters : m_allocations) {
+    counters = AllocationCounters{0, 0, 0, 0};
+  }
+
+  if (CM_Trace::IsEnabled()) {
+    CM_Trace::Instant("Frame", CM_Trace::TRACK_TIME_CATEGORIES);
   }
 }
 
@@ -103,9 +206,49 @@ double KX_TimeCategoryLogger::GetAverage()
 {
   double time = 0.0;
 
-  for (TimeLoggerMap::value_type &pair : m_loggers) {
-    time += pair.second.GetAverage();
+  for (const KX_TimeLogger &logger : m_loggers) {
+    time += logger.GetAverage();
   }
 
   return time;
 }
+
+double KX_TimeCategoryLogger::GetLastMeasurement(TimeCategory tc)
+{
+  return m_loggers[tc].GetLastMeasurement();
+}
+
+void KX_TimeCategoryLogger::SetCountAllocations(bool count)
+{
+  if (count == m_countAllocations) {
+    return;
+  }
+
+  MEM_set_allocation_counting(count);
+  m_countAllocations = count;
+
+  for (AllocationCounters &counters : m_allocations) {
+    counters = AllocationCounters{0, 0, 0, 0};
+  }
+  for (AllocationCounters &counters : m_lastAllocations) {
+    counters = AllocationCounters{0, 0, 0, 0};
+  }
+
+  if (count) {
+    // Only the allocations from now are counted.
+    MEM_get_allocation_counters(&m_allocCount, &m_allocBytes);
+    m_blocksInUse = MEM_get_memory_blocks_in_use();
+    m_memoryInUse = MEM_get_memory_in_use();
+  }
+}
+
+bool KX_TimeCategoryLogger::GetCountAllocations() const
+{
+  return m_countAllocations;
+}
+
+const KX_TimeCategoryLogger::AllocationCounters &KX_TimeCategoryLogger::GetLastAllocations(
+    TimeCategory tc) const
+{
+  return m_lastAllocations[tc];
+}
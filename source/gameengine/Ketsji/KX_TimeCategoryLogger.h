@@ -35,21 +35,31 @@
 #  pragma warning(disable : 4786) /* suppress stl-MSVC debug info warning */
 #endif
 
-#include <map>
+#include <vector>
 
 #include "CM_Clock.h"
 #include "KX_TimeLogger.h"
 
 /**
  * Stores and manages time measurements by category.
- * Categories can be added dynamically.
+ * Categories can be added dynamically, they are indexed in a fixed array
+ * so logging doesn't do any lookup. A category must be added before logging in it.
  * Average measurements can be established for each separate category
  * or for all categories together.
+ * The allocations of the guarded allocator can also be counted by category, the allocations
+ * of all the threads are assigned to the category logged on the main thread.
  */
 class KX_TimeCategoryLogger {
  public:
   typedef int TimeCategory;
-  typedef std::map<TimeCategory, KX_TimeLogger> TimeLoggerMap;
+  typedef std::vector<KX_TimeLogger> TimeLoggerList;
+
+  struct AllocationCounters {
+    size_t m_allocations;
+    size_t m_allocatedBytes;
+    size_t m_frees;
+    size_t m_freedBytes;
+  };
 
   /**
    * Constructor.
@@ -75,8 +85,10 @@ class KX_TimeCategoryLogger {
   /**
    * Adds a category.
    * \param category	The new category.
+   * \param traceName	Optional name of the category in the recorded traces, see CM_Trace.
+   * It must stay valid for the program lifetime.
    */
-  void AddCategory(TimeCategory tc);
+  void AddCategory(TimeCategory tc, const char *traceName = nullptr);
 
   /**
    * Starts logging in current measurement for the given category.
@@ -113,12 +125,48 @@ class KX_TimeCategoryLogger {
    */
   double GetAverage();
 
+  /**
+   * Returns the last finished measurement of the given category.
+   */
+  double GetLastMeasurement(TimeCategory tc);
+
+  /**
+   * Enable the counting of the allocations of each category.
+   * The guarded allocator counts the allocations only while it is enabled.
+   */
+  void SetCountAllocations(bool count);
+  bool GetCountAllocations() const;
+
+  /**
+   * Returns the allocations of the last finished measurement of the given category.
+   */
+  const AllocationCounters &GetLastAllocations(TimeCategory tc) const;
+
  protected:
   const CM_Clock &m_clock;
-  /// Storage for the loggers.
-  TimeLoggerMap m_loggers;
+  /// Storage for the loggers, indexed by category.
+  TimeLoggerList m_loggers;
   /// Maximum number of measurements.
   unsigned int m_maxNumMeasurements;
 
   TimeCategory m_lastCategory;
+
+  /// Names of the categories in the recorded traces, indexed by category.
+  std::vector<const char *> m_traceNames;
+  /// A category scope is open in the trace being recorded.
+  bool m_traceOpen;
+
+  bool m_countAllocations;
+  /// Allocations of the current and of the last finished measurement, indexed by category.
+  std::vector<AllocationCounters> m_allocations;
+  std::vector<AllocationCounters> m_lastAllocations;
+  /// State of the allocator at the last change of category.
+  size_t m_allocCount;
+  size_t m_allocBytes;
+  unsigned int m_blocksInUse;
+  size_t m_memoryInUse;
+
+  void TraceCategory(TimeCategory tc);
+  /// Assign the allocations since the last change of category to the current category.
+  void CountAllocations();
 };
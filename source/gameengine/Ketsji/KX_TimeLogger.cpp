@@ -31,8 +31,15 @@
 
 #include "KX_TimeLogger.h"
 
+#include <algorithm>
+
 KX_TimeLogger::KX_TimeLogger(unsigned int maxNumMeasurements)
-    : m_maxNumMeasurements(maxNumMeasurements), m_logStart(0), m_logging(false)
+    : m_measurements(std::max(maxNumMeasurements, 1u), 0.0),
+      m_current(0),
+      m_numMeasurements(0),
+      m_maxNumMeasurements(std::max(maxNumMeasurements, 1u)),
+      m_logStart(0),
+      m_logging(false)
 {
 }
 
@@ -43,7 +50,15 @@ KX_TimeLogger::~KX_TimeLogger()
 void KX_TimeLogger::SetMaxNumMeasurements(unsigned int maxNumMeasurements)
 {
   if ((m_maxNumMeasurements != maxNumMeasurements) && maxNumMeasurements) {
-    // Actual removing is done in NextMeasurement()
+    // Keep the most recent measurements, the current one at the front of the new ring.
+    std::vector<double> measurements(maxNumMeasurements, 0.0);
+    m_numMeasurements = std::min(m_numMeasurements, maxNumMeasurements);
+    for (unsigned int i = 0; i < m_numMeasurements; ++i) {
+      measurements[i] = m_measurements[(m_current + i) % m_maxNumMeasurements];
+    }
+
+    m_measurements = measurements;
+    m_current = 0;
     m_maxNumMeasurements = maxNumMeasurements;
   }
 }
@@ -66,8 +81,8 @@ void KX_TimeLogger::EndLog(double now)
   if (m_logging) {
     m_logging = false;
     double time = now - m_logStart;
-    if (!m_measurements.empty()) {
-      m_measurements[0] += time;
+    if (m_numMeasurements > 0) {
+      m_measurements[m_current] += time;
     }
   }
 }
@@ -77,29 +92,27 @@ void KX_TimeLogger::NextMeasurement(double now)
   // End logging to current measurement
   EndLog(now);
 
-  // Add a new measurement at the front
-  double m = 0.0;
-  m_measurements.push_front(m);
-
-  // Remove measurement if we grow beyond the maximum size
-  if ((m_measurements.size()) > m_maxNumMeasurements) {
-    while (m_measurements.size() > m_maxNumMeasurements) {
-      m_measurements.pop_back();
-    }
-  }
+  // Add a new measurement at the front, replacing the oldest one if the ring is full.
+  m_current = (m_current + m_maxNumMeasurements - 1) % m_maxNumMeasurements;
+  m_measurements[m_current] = 0.0;
+  m_numMeasurements = std::min(m_numMeasurements + 1, m_maxNumMeasurements);
 }
 
 double KX_TimeLogger::GetAverage() const
 {
   double avg = 0.0;
 
-  const unsigned int numMeasurements = m_measurements.size();
-  if (numMeasurements > 1) {
-    for (unsigned int i = 1; i < numMeasurements; i++) {
-      avg += m_measurements[i];
+  if (m_numMeasurements > 1) {
+    for (unsigned int i = 1; i < m_numMeasurements; i++) {
+      avg += m_measurements[(m_current + i) % m_maxNumMeasurements];
     }
-    avg /= (double)numMeasurements - 1.0;
+    avg /= (double)m_numMeasurements - 1.0;
   }
 
   return avg;
 }
+
+double KX_TimeLogger::GetLastMeasurement() const
+{
+  return (m_numMeasurements > 1) ? m_measurements[(m_current + 1) % m_maxNumMeasurements] : 0.0;
+}
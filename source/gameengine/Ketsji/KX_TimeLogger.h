@@ -35,10 +35,11 @@
 #  pragma warning(disable : 4786) /* suppress stl-MSVC debug info warning */
 #endif
 
-#include <deque>
+#include <vector>
 
 /**
  * Stores and manages time measurements.
+ * The measurements are stored in a ring of fixed size to not allocate at each frame.
  */
 class KX_TimeLogger {
  public:
@@ -87,9 +88,17 @@ class KX_TimeLogger {
    */
   double GetAverage() const;
 
+  /**
+   * Returns the last finished measurement.
+   */
+  double GetLastMeasurement() const;
+
  protected:
-  /// Storage for the measurements.
-  std::deque<double> m_measurements;
+  /// Ring of the measurements, m_current is the index of the current measurement.
+  std::vector<double> m_measurements;
+  unsigned int m_current;
+  /// Number of measurements stored in the ring.
+  unsigned int m_numMeasurements;
 
   /// Maximum number of measurements.
   unsigned int m_maxNumMeasurements;
@@ -0,0 +1,313 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Ketsji/KX_VideoCapture.cpp
+ *  \ingroup ketsji
+ */
+
+#include "KX_VideoCapture.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "BLI_path_util.h"
+#include "BLI_string.h"
+#include "GPU_glew.h"
+
+#ifdef WITH_FFMPEG
+#  include "BKE_writeffmpeg.h"
+#endif
+
+#include "CM_Message.h"
+#include "KX_Globals.h"
+
+/// Readbacks in flight before waiting for the oldest.
+static const unsigned int maxReadbacks = 3;
+/// Frames waiting for the encoder before dropping the new ones.
+static const unsigned int maxQueuedFrames = 8;
+
+KX_VideoCapture::KX_VideoCapture()
+    : m_context(nullptr),
+      m_width(0),
+      m_height(0),
+      m_rate(0.0),
+      m_startTime(0.0),
+      m_lastFrame(-1),
+      m_droppedFrames(0),
+      m_stopping(false),
+      m_failedFrames(0)
+{
+}
+
+KX_VideoCapture::~KX_VideoCapture()
+{
+  Stop();
+}
+
+bool KX_VideoCapture::Start(
+    Scene *scene, const std::string &filepath, int width, int height, float rate, bool hardware)
+{
+  Stop();
+
+#ifdef WITH_FFMPEG
+  // The YUV 4:2:0 formats of most codecs need an even size.
+  width &= ~1;
+  height &= ~1;
+  if (width <= 0 || height <= 0) {
+    CM_Error("cannot capture an empty area");
+    return false;
+  }
+
+  m_renderData = scene->r;
+  RenderData &rd = m_renderData;
+  if (rd.im_format.imtype != R_IMF_IMTYPE_FFMPEG) {
+    BKE_ffmpeg_preset_set(&rd, FFMPEG_PRESET_H264);
+    rd.ffcodecdata.type = FFMPEG_MKV;
+    rd.ffcodecdata.constant_rate_factor = FFM_CRF_MEDIUM;
+    rd.ffcodecdata.ffmpeg_preset = FFM_PRESET_REALTIME;
+  }
+  // The game sounds don't play in the scene, AV_CODEC_ID_NONE disables the audio mixdown.
+  rd.ffcodecdata.audio_codec = 0;
+  // Use the file path as is without frame range or extension.
+  rd.scemode &= ~R_EXTENSION;
+  BLI_strncpy(rd.pic, filepath.c_str(), sizeof(rd.pic));
+  BLI_path_abs(rd.pic, KX_GetMainPath().c_str());
+
+  if (rate > 0.0f) {
+    rd.frs_sec = std::max(1, int(std::round(rate)));
+    rd.frs_sec_base = float(rd.frs_sec) / rate;
+  }
+
+  m_context = BKE_ffmpeg_context_create();
+  BKE_ffmpeg_context_hardware_encoder_set(m_context, hardware);
+  if (!BKE_ffmpeg_start(m_context, scene, &rd, width, height, nullptr, false, "")) {
+    CM_Error("cannot start the video capture of " << rd.pic);
+    BKE_ffmpeg_context_free(m_context);
+    m_context = nullptr;
+    return false;
+  }
+
+  const char *encoder = BKE_ffmpeg_video_encoder_name(m_context);
+  CM_Message("capturing video to " << rd.pic << " with the " << (encoder ? encoder : "unknown")
+                                   << " encoder");
+
+  m_width = width;
+  m_height = height;
+  m_rate = double(rd.frs_sec) / double(rd.frs_sec_base);
+  m_lastFrame = -1;
+  m_droppedFrames = 0;
+  m_failedFrames = 0;
+  m_stopping = false;
+  m_thread = std::thread(&KX_VideoCapture::EncodeFrames, this);
+
+  return true;
+#else
+  (void)scene;
+  (void)filepath;
+  (void)width;
+  (void)height;
+  (void)rate;
+  (void)hardware;
+  CM_Error("video capture is not available, built without FFmpeg");
+  return false;
+#endif
+}
+
+void KX_VideoCapture::Stop()
+{
+  if (!m_context) {
+    return;
+  }
+
+  while (!m_readbacks.empty()) {
+    ReadOldest(true);
+  }
+
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_stopping = true;
+  }
+  m_condition.notify_one();
+  m_thread.join();
+
+#ifdef WITH_FFMPEG
+  BKE_ffmpeg_end(m_context);
+  BKE_ffmpeg_context_free(m_context);
+#endif
+  m_context = nullptr;
+
+  if (!m_freeBuffers.empty()) {
+    glDeleteBuffers(m_freeBuffers.size(), m_freeBuffers.data());
+    m_freeBuffers.clear();
+  }
+  m_freePixels.clear();
+
+  if (m_droppedFrames > 0) {
+    CM_Warning("video capture dropped " << m_droppedFrames << " frames, the encoding is too slow");
+  }
+  if (m_failedFrames > 0) {
+    CM_Error("video capture failed to encode " << m_failedFrames << " frames");
+  }
+}
+
+bool KX_VideoCapture::IsCapturing() const
+{
+  return (m_context != nullptr);
+}
+
+void KX_VideoCapture::Capture(int x, int y, int width, int height, double time)
+{
+  if (!m_context) {
+    return;
+  }
+
+  // Queue the readbacks already finished by the GPU.
+  while (!m_readbacks.empty() && ReadOldest(false)) {
+  }
+
+  if ((width & ~1) != m_width || (height & ~1) != m_height) {
+    return;
+  }
+
+  if (m_lastFrame == -1) {
+    m_startTime = time;
+  }
+  const int frame = int(std::floor((time - m_startTime) * m_rate + 0.5));
+  // Several renders in the same video frame.
+  if (frame <= m_lastFrame) {
+    return;
+  }
+
+  if (m_readbacks.size() >= maxReadbacks) {
+    ReadOldest(true);
+  }
+
+  const GLsizeiptr size = GLsizeiptr(m_width) * m_height * 4;
+  GLuint buffer;
+  if (m_freeBuffers.empty()) {
+    glGenBuffers(1, &buffer);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, buffer);
+    glBufferData(GL_PIXEL_PACK_BUFFER, size, nullptr, GL_STREAM_READ);
+  }
+  else {
+    buffer = m_freeBuffers.back();
+    m_freeBuffers.pop_back();
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, buffer);
+  }
+
+  // With a bound pixel buffer the read returns without waiting for the GPU.
+  glReadPixels(x, y, m_width, m_height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+  m_readbacks.push_back({buffer, glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0), frame});
+  m_lastFrame = frame;
+}
+
+bool KX_VideoCapture::ReadOldest(bool wait)
+{
+  const Readback readback = m_readbacks.front();
+  GLsync sync = (GLsync)readback.m_sync;
+  const GLenum status = glClientWaitSync(
+      sync, GL_SYNC_FLUSH_COMMANDS_BIT, wait ? GL_TIMEOUT_IGNORED : 0);
+  if (status == GL_TIMEOUT_EXPIRED) {
+    return false;
+  }
+
+  glDeleteSync(sync);
+  m_readbacks.pop_front();
+
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.m_buffer);
+  const void *pixels = glMapBufferRange(
+      GL_PIXEL_PACK_BUFFER, 0, GLsizeiptr(m_width) * m_height * 4, GL_MAP_READ_BIT);
+  if (pixels) {
+    QueueFrame(readback.m_frame, pixels);
+    glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+  }
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+  m_freeBuffers.push_back(readback.m_buffer);
+
+  return true;
+}
+
+void KX_VideoCapture::QueueFrame(int frame, const void *pixels)
+{
+  Frame entry;
+  entry.m_frame = frame;
+
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_frames.size() >= maxQueuedFrames) {
+      ++m_droppedFrames;
+      return;
+    }
+
+    if (!m_freePixels.empty()) {
+      entry.m_pixels = std::move(m_freePixels.back());
+      m_freePixels.pop_back();
+    }
+  }
+
+  entry.m_pixels.resize(size_t(m_width) * m_height);
+  memcpy(entry.m_pixels.data(), pixels, entry.m_pixels.size() * sizeof(unsigned int));
+
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_frames.push_back(std::move(entry));
+  }
+  m_condition.notify_one();
+}
+
+void KX_VideoCapture::EncodeFrames()
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (true) {
+    m_condition.wait(lock, [this]() { return (!m_frames.empty() || m_stopping); });
+    // All the frames are encoded at the stop.
+    if (m_frames.empty()) {
+      break;
+    }
+
+    Frame entry = std::move(m_frames.front());
+    m_frames.pop_front();
+    lock.unlock();
+
+#ifdef WITH_FFMPEG
+    const bool success = BKE_ffmpeg_append(m_context,
+                                           &m_renderData,
+                                           0,
+                                           entry.m_frame,
+                                           (int *)entry.m_pixels.data(),
+                                           m_width,
+                                           m_height,
+                                           "",
+                                           nullptr);
+#else
+    const bool success = false;
+#endif
+
+    lock.lock();
+    if (!success) {
+      ++m_failedFrames;
+    }
+    m_freePixels.push_back(std::move(entry.m_pixels));
+  }
+}
@@ -0,0 +1,126 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file KX_VideoCapture.h
+ *  \ingroup ketsji
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "DNA_scene_types.h"
+
+/** Recording of the rendered frames in a video file with the FFmpeg writer.
+ * The frames are read back asynchronously in pixel buffers at the frame end and copied once the
+ * GPU finished them, the encoding runs on a worker thread. The frames are placed in the video
+ * at their frame time, the frames rendered in the same video frame are skipped and the frames
+ * are dropped when the encoder is late.
+ */
+class KX_VideoCapture {
+ private:
+  struct Readback {
+    unsigned int m_buffer;
+    /// The GLsync object signaled when the copy in the buffer is done.
+    void *m_sync;
+    int m_frame;
+  };
+
+  struct Frame {
+    int m_frame;
+    std::vector<unsigned int> m_pixels;
+  };
+
+  /// Copy of the output settings of the scene, used by the worker thread.
+  RenderData m_renderData;
+  /// The FFmpeg writer context, nullptr when not capturing.
+  void *m_context;
+  int m_width;
+  int m_height;
+  /// Frames per second of the video.
+  double m_rate;
+  double m_startTime;
+  /// Last video frame read back, -1 before the first.
+  int m_lastFrame;
+  unsigned int m_droppedFrames;
+
+  /// Readbacks not yet copied, the oldest first.
+  std::deque<Readback> m_readbacks;
+  std::vector<unsigned int> m_freeBuffers;
+
+  std::thread m_thread;
+  std::mutex m_mutex;
+  std::condition_variable m_condition;
+  /// Frames waiting for the encoder, protected by m_mutex.
+  std::deque<Frame> m_frames;
+  /// Pixel arrays of the encoded frames to reuse, protected by m_mutex.
+  std::vector<std::vector<unsigned int>> m_freePixels;
+  bool m_stopping;
+  unsigned int m_failedFrames;
+
+  /** Copy the oldest readback in the frame queue.
+   * \param wait Wait for the GPU to finish the readback.
+   * \return False if the readback isn't finished.
+   */
+  bool ReadOldest(bool wait);
+  void QueueFrame(int frame, const void *pixels);
+  /// Loop of the worker thread encoding the queued frames until the stop.
+  void EncodeFrames();
+
+ public:
+  KX_VideoCapture();
+  ~KX_VideoCapture();
+
+  /** Start the recording of a video file, a previous recording is stopped.
+   * The FFmpeg output settings of the scene are used, or H.264 in Matroska when the scene
+   * doesn't output a video, the audio isn't recorded.
+   * \param filepath The video file path, relative to the main blend file.
+   * \param width The width of the captured area, rounded down to an even size.
+   * \param height The height of the captured area, rounded down to an even size.
+   * \param rate The frames per second of the video, 0 for the frame rate of the scene.
+   * \param hardware Prefer a hardware encoder (NVENC, QSV, AMF, VideoToolbox) of the H.264
+   * and HEVC codecs, the software encoder is used when none is available.
+   * \return False if the encoder failed to start.
+   */
+  bool Start(Scene *scene,
+             const std::string &filepath,
+             int width,
+             int height,
+             float rate,
+             bool hardware);
+  /// Encode the pending frames and close the file.
+  void Stop();
+  bool IsCapturing() const;
+
+  /** Queue the readback of the current framebuffer, must be called once the frame is drawn.
+   * The areas of a different size than at the start are skipped.
+   * \param x The left of the captured area.
+   * \param y The bottom of the captured area.
+   * \param width The width of the captured area.
+   * \param height The height of the captured area.
+   * \param time The frame time.
+   */
+  void Capture(int x, int y, int width, int height, double time);
+};
@@ -0,0 +1,317 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Ketsji/KX_WorldStreamer.cpp
+ *  \ingroup ketsji
+ */
+
+#include "KX_WorldStreamer.h"
+
+#include <algorithm>
+#include <cfloat>
+
+#include "BKE_collection.h"
+#include "BLI_path_util.h"
+#include "BLI_string.h"
+#include "DNA_collection_types.h"
+#include "DNA_layer_types.h"
+
+#include "BL_BlenderConverter.h"
+#include "BL_BlenderSceneConverter.h"
+#include "CM_Message.h"
+#include "KX_Camera.h"
+#include "KX_Globals.h"
+#include "KX_KetsjiEngine.h"
+#include "KX_LibLoadStatus.h"
+#include "KX_Scene.h"
+
+KX_WorldStreamer::KX_WorldStreamer(KX_Scene *scene)
+    : m_scene(scene), m_maxLoads(2), m_mergeBudget(2.0f)
+{
+}
+
+KX_WorldStreamer::~KX_WorldStreamer()
+{
+  for (Cell &cell : m_cells) {
+    if (cell.m_state == CELL_LOADING) {
+      cell.m_status->RemoveOwner();
+    }
+  }
+}
+
+KX_WorldStreamer::Cell *KX_WorldStreamer::FindCell(const std::string &name)
+{
+  for (Cell &cell : m_cells) {
+    if (cell.m_name == name) {
+      return &cell;
+    }
+  }
+  return nullptr;
+}
+
+bool KX_WorldStreamer::AddCell(const Cell &cell)
+{
+  if (FindCell(cell.m_name)) {
+    return false;
+  }
+
+  m_cells.push_back(cell);
+  return true;
+}
+
+bool KX_WorldStreamer::AddLibraryCell(const std::string &path,
+                                      const MT_Vector3 &center,
+                                      float loadDistance,
+                                      float unloadDistance,
+                                      int priority)
+{
+  // Make the path absolute as LibLoad does, it identifies the library to free.
+  char abs_path[FILE_MAX];
+  BLI_strncpy(abs_path, path.c_str(), sizeof(abs_path));
+  BLI_path_abs(abs_path, KX_GetMainPath().c_str());
+
+  const Cell cell = {abs_path,
+                     nullptr,
+                     center,
+                     loadDistance,
+                     std::max(loadDistance, unloadDistance),
+                     priority,
+                     CELL_UNLOADED,
+                     nullptr};
+  return AddCell(cell);
+}
+
+bool KX_WorldStreamer::AddCollectionCell(Collection *collection,
+                                         const MT_Vector3 &center,
+                                         float loadDistance,
+                                         float unloadDistance,
+                                         int priority)
+{
+  const Cell cell = {collection->id.name + 2,
+                     collection,
+                     center,
+                     loadDistance,
+                     std::max(loadDistance, unloadDistance),
+                     priority,
+                     CELL_UNLOADED,
+                     nullptr};
+  return AddCell(cell);
+}
+
+bool KX_WorldStreamer::RemoveCell(const std::string &name)
+{
+  for (std::vector<Cell>::iterator it = m_cells.begin(), end = m_cells.end(); it != end; ++it) {
+    Cell &cell = *it;
+    if (cell.m_name != name) {
+      continue;
+    }
+
+    // As the libraries, a loading cell can't be freed until the end of its loading.
+    if (cell.m_state == CELL_LOADING) {
+      return false;
+    }
+    if (cell.m_state == CELL_LOADED) {
+      FreeCell(cell);
+    }
+
+    m_cells.erase(it);
+    return true;
+  }
+
+  return false;
+}
+
+bool KX_WorldStreamer::GetCellState(const std::string &name, CellState &r_state)
+{
+  Cell *cell = FindCell(name);
+  if (!cell) {
+    return false;
+  }
+
+  r_state = cell->m_state;
+  return true;
+}
+
+std::vector<std::string> KX_WorldStreamer::GetCellNames() const
+{
+  std::vector<std::string> names;
+  for (const Cell &cell : m_cells) {
+    names.push_back(cell.m_name);
+  }
+  return names;
+}
+
+unsigned int KX_WorldStreamer::GetMaxLoads() const
+{
+  return m_maxLoads;
+}
+
+void KX_WorldStreamer::SetMaxLoads(unsigned int maxLoads)
+{
+  m_maxLoads = maxLoads;
+}
+
+float KX_WorldStreamer::GetMergeBudget() const
+{
+  return m_mergeBudget;
+}
+
+void KX_WorldStreamer::SetMergeBudget(float budget)
+{
+  m_mergeBudget = budget;
+}
+
+void KX_WorldStreamer::LoadCell(Cell &cell)
+{
+  if (cell.m_collection) {
+    cell.m_status = m_scene->ConvertBlenderCollection(cell.m_collection, true);
+    cell.m_status->AddOwner();
+    cell.m_state = CELL_LOADING;
+    return;
+  }
+
+  BL_BlenderConverter *converter = KX_GetActiveEngine()->GetConverter();
+  // The library was loaded by an other mean, e.g. by a script.
+  if (converter->GetMainDynamicPath(cell.m_name)) {
+    cell.m_state = CELL_LOADED;
+    return;
+  }
+
+  char group[] = "Scene";
+  char *err_str = nullptr;
+  cell.m_status = converter->LinkBlendFilePath(
+      cell.m_name.c_str(),
+      group,
+      m_scene,
+      &err_str,
+      BL_BlenderConverter::LIB_LOAD_LOAD_SCRIPTS | BL_BlenderConverter::LIB_LOAD_ASYNC);
+
+  if (!cell.m_status) {
+    CM_Error("streaming cell \"" << cell.m_name << "\" failed to load: " << err_str);
+    // Never try again a missing or invalid library.
+    cell.m_state = CELL_FAILED;
+    return;
+  }
+
+  cell.m_status->AddOwner();
+  cell.m_status->SetMergeBudget(m_mergeBudget);
+  cell.m_state = CELL_LOADING;
+}
+
+void KX_WorldStreamer::FreeCell(Cell &cell)
+{
+  cell.m_state = CELL_UNLOADED;
+
+  if (!cell.m_collection) {
+    KX_GetActiveEngine()->GetConverter()->FreeBlendFile(cell.m_name);
+    return;
+  }
+
+  // End the objects converted from the collection.
+  BL_BlenderSceneConverter *sceneConverter = m_scene->GetBlenderSceneConverter();
+  EXP_ListValue<KX_GameObject> *objects = m_scene->GetObjectList();
+  FOREACH_COLLECTION_OBJECT_RECURSIVE_BEGIN (cell.m_collection, blenderobj) {
+    KX_GameObject *gameobj = sceneConverter->FindGameObject(blenderobj);
+    if (gameobj && objects->SearchValue(gameobj)) {
+      m_scene->DelayedRemoveObject(gameobj);
+    }
+  }
+  FOREACH_COLLECTION_OBJECT_RECURSIVE_END;
+}
+
+void KX_WorldStreamer::Update()
+{
+  if (m_cells.empty()) {
+    return;
+  }
+
+  // The active camera and the cameras rendering a viewport.
+  std::vector<MT_Vector3> positions;
+  KX_Camera *activecam = m_scene->GetActiveCamera();
+  for (KX_Camera *cam : *m_scene->GetCameraList()) {
+    if (cam == activecam || cam->GetViewport()) {
+      positions.push_back(cam->NodeGetWorldPosition());
+    }
+  }
+
+  if (positions.empty()) {
+    return;
+  }
+
+  unsigned int numLoads = 0;
+  std::vector<std::pair<float, Cell *>> candidates;
+  for (Cell &cell : m_cells) {
+    float distance = FLT_MAX;
+    for (const MT_Vector3 &pos : positions) {
+      distance = std::min(distance, (float)(pos - cell.m_center).length());
+    }
+
+    if (cell.m_state == CELL_LOADING && cell.m_status->IsFinished()) {
+      cell.m_status->RemoveOwner();
+      cell.m_status = nullptr;
+      cell.m_state = CELL_LOADED;
+    }
+
+    switch (cell.m_state) {
+      case CELL_LOADING: {
+        ++numLoads;
+        break;
+      }
+      case CELL_LOADED: {
+        if (distance > cell.m_unloadDistance) {
+          FreeCell(cell);
+        }
+        break;
+      }
+      case CELL_UNLOADED: {
+        if (distance <= cell.m_loadDistance) {
+          candidates.emplace_back(distance, &cell);
+        }
+        break;
+      }
+      case CELL_FAILED: {
+        break;
+      }
+    }
+  }
+
+  // Load the cells of highest priority first, then the nearest.
+  std::sort(candidates.begin(),
+            candidates.end(),
+            [](const std::pair<float, Cell *> &a, const std::pair<float, Cell *> &b) {
+              if (a.second->m_priority != b.second->m_priority) {
+                return a.second->m_priority > b.second->m_priority;
+              }
+              return a.first < b.first;
+            });
+
+  for (const std::pair<float, Cell *> &candidate : candidates) {
+    if (numLoads >= m_maxLoads) {
+      break;
+    }
+
+    LoadCell(*candidate.second);
+    if (candidate.second->m_state == CELL_LOADING) {
+      ++numLoads;
+    }
+  }
+}
@@ -0,0 +1,109 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file KX_WorldStreamer.h
+ *  \ingroup ketsji
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "MT_Vector3.h"
+
+class KX_LibLoadStatus;
+class KX_Scene;
+struct Collection;
+
+/** Load and free the parts of a world according to their distance to the active cameras.
+ * A cell is a library file merged into the scene or a collection converted into the scene.
+ * The cells are loaded asynchronously by priority, the merge is spread over the frames.
+ */
+class KX_WorldStreamer {
+ public:
+  enum CellState { CELL_UNLOADED = 0, CELL_LOADING, CELL_LOADED, CELL_FAILED };
+
+ private:
+  struct Cell {
+    /// Absolute library path or collection name.
+    std::string m_name;
+    /// Collection converted by the cell, nullptr for a library.
+    Collection *m_collection;
+    MT_Vector3 m_center;
+    float m_loadDistance;
+    float m_unloadDistance;
+    int m_priority;
+    CellState m_state;
+    /// Status of the loading owned by the cell, only valid in CELL_LOADING state.
+    KX_LibLoadStatus *m_status;
+  };
+
+  KX_Scene *m_scene;
+  std::vector<Cell> m_cells;
+  /// Number of cells loaded at the same time.
+  unsigned int m_maxLoads;
+  /// Time in milliseconds spent at most per frame to merge a library.
+  float m_mergeBudget;
+
+  Cell *FindCell(const std::string &name);
+  bool AddCell(const Cell &cell);
+  void LoadCell(Cell &cell);
+  void FreeCell(Cell &cell);
+
+ public:
+  KX_WorldStreamer(KX_Scene *scene);
+  ~KX_WorldStreamer();
+
+  /** Add a cell loading a library.
+   * \param path The library path, relative to the main file.
+   * \param unloadDistance The distance to free the cell, at least the load distance.
+   * \return False if a cell of the same library exists.
+   */
+  bool AddLibraryCell(const std::string &path,
+                      const MT_Vector3 &center,
+                      float loadDistance,
+                      float unloadDistance,
+                      int priority);
+  /// Add a cell converting the objects of a collection.
+  bool AddCollectionCell(Collection *collection,
+                         const MT_Vector3 &center,
+                         float loadDistance,
+                         float unloadDistance,
+                         int priority);
+  /// Remove a cell and free its data, return false if the cell doesn't exist.
+  bool RemoveCell(const std::string &name);
+
+  /** Return the state of a cell.
+   * \param r_state The state of the cell if it exists.
+   */
+  bool GetCellState(const std::string &name, CellState &r_state);
+  std::vector<std::string> GetCellNames() const;
+
+  unsigned int GetMaxLoads() const;
+  void SetMaxLoads(unsigned int maxLoads);
+  float GetMergeBudget() const;
+  void SetMergeBudget(float budget);
+
+  /// Start the loads of the near cells and free the distant ones, called once per frame.
+  void Update();
+};
@@ -0,0 +1,216 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Launcher/LA_Benchmark.cpp
+ *  \ingroup launcher
+ */
+
+#include "LA_Benchmark.h"
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <numeric>
+
+#include "CM_Message.h"
+#include "DEV_InputDevice.h"
+#include "KX_KetsjiEngine.h"
+#include "LA_SystemCommandLine.h"
+
+LA_Benchmark::LA_Benchmark()
+    : m_frameCount(0),
+      m_render(true),
+      m_inputDevice(nullptr),
+      m_frame(0),
+      m_timeStep(0.0),
+      m_frameStartTime(0.0)
+{
+}
+
+LA_Benchmark::~LA_Benchmark()
+{
+}
+
+void LA_Benchmark::ReadOptions()
+{
+  SYS_SystemHandle syshandle = SYS_GetSystem();
+
+  m_recordPath = SYS_GetCommandLineString(syshandle, "input_record", "");
+  m_replayPath = SYS_GetCommandLineString(syshandle, "input_replay", "");
+  m_statsPath = SYS_GetCommandLineString(syshandle, "stats_output", "");
+  m_frameCount = std::max(SYS_GetCommandLineInt(syshandle, "frame_count", 0), 0);
+  m_render = (SYS_GetCommandLineInt(syshandle, "benchmark_render", 1) != 0);
+
+  if (!m_recordPath.empty() && !m_replayPath.empty()) {
+    CM_Warning("input_record and input_replay can't be used together, inputs are not recorded");
+    m_recordPath.clear();
+  }
+}
+
+bool LA_Benchmark::UseFixedStep() const
+{
+  return (!m_recordPath.empty() || !m_replayPath.empty() || !m_statsPath.empty() ||
+          m_frameCount > 0 || !m_render);
+}
+
+bool LA_Benchmark::UseReplay() const
+{
+  return !m_replayPath.empty();
+}
+
+bool LA_Benchmark::GetRender() const
+{
+  return m_render;
+}
+
+bool LA_Benchmark::Start(DEV_InputDevice *inputDevice, double ticrate)
+{
+  m_inputDevice = inputDevice;
+  m_frame = 0;
+  m_timeStep = 1.0 / ticrate;
+  m_frameTimes.clear();
+  m_categoryTimes.assign(KX_KetsjiEngine::GetNumProfileCategories(), 0.0);
+  m_record = DEV_InputRecord();
+
+  if (!m_replayPath.empty()) {
+    if (!m_record.Load(m_replayPath)) {
+      CM_Error("cannot read the input record '" << m_replayPath << "'");
+      return false;
+    }
+    m_inputDevice->SetReplay(&m_record);
+  }
+  else if (!m_recordPath.empty()) {
+    m_inputDevice->SetRecord(&m_record);
+  }
+
+  m_clock.Reset();
+  m_frameStartTime = m_clock.GetTimeSecond();
+
+  return true;
+}
+
+void LA_Benchmark::Stop()
+{
+  if (!m_inputDevice) {
+    return;
+  }
+
+  if (!m_replayPath.empty()) {
+    m_inputDevice->SetReplay(nullptr);
+  }
+  if (!m_recordPath.empty()) {
+    m_inputDevice->SetRecord(nullptr);
+    if (m_record.Save(m_recordPath)) {
+      CM_Message("Inputs of " << m_frame << " frames recorded to '" << m_recordPath << "'");
+    }
+    else {
+      CM_Error("cannot write the input record '" << m_recordPath << "'");
+    }
+  }
+
+  if (!m_statsPath.empty()) {
+    if (!WriteStats()) {
+      CM_Error("cannot write the timing report '" << m_statsPath << "'");
+    }
+  }
+
+  m_inputDevice = nullptr;
+}
+
+void LA_Benchmark::BeginFrame(KX_KetsjiEngine *engine)
+{
+  /* Recorded inputs are given at the speed of the player, wait for the real time
+   * of the frame to keep the game speed. */
+  if (!m_recordPath.empty()) {
+    m_clock.WaitUntil(m_frame * m_timeStep, 1.0e-3);
+  }
+
+  // Computed from the frame index to not accumulate rounding errors.
+  engine->SetClockTime((m_frame + 1) * m_timeStep);
+}
+
+bool LA_Benchmark::EndFrame(KX_KetsjiEngine *engine)
+{
+  const double time = m_clock.GetTimeSecond();
+  m_frameTimes.push_back(time - m_frameStartTime);
+  m_frameStartTime = time;
+
+  for (unsigned short i = 0, size = m_categoryTimes.size(); i < size; ++i) {
+    m_categoryTimes[i] += engine->GetLastProfileTime(i);
+  }
+
+  ++m_frame;
+
+  return (m_frameCount == 0 || m_frame < m_frameCount);
+}
+
+bool LA_Benchmark::WriteStats() const
+{
+  std::ofstream file(m_statsPath);
+  if (!file) {
+    return false;
+  }
+
+  std::vector<double> sortedTimes = m_frameTimes;
+  std::sort(sortedTimes.begin(), sortedTimes.end());
+
+  const unsigned int numFrames = sortedTimes.size();
+  const double totalTime = std::accumulate(sortedTimes.begin(), sortedTimes.end(), 0.0);
+  const auto percentile = [&sortedTimes, numFrames](double factor) {
+    return (numFrames == 0) ? 0.0 : sortedTimes[(unsigned int)((numFrames - 1) * factor)];
+  };
+
+  // Frame times are written in ms.
+  file << "{\n";
+  file << "  \"frames\": " << numFrames << ",\n";
+  file << "  \"time_step\": " << m_timeStep << ",\n";
+  file << "  \"total_time\": " << totalTime << ",\n";
+  file << "  \"frame_time\": {\n";
+  file << "    \"mean\": " << ((numFrames == 0) ? 0.0 : totalTime / numFrames * 1000.0) << ",\n";
+  file << "    \"min\": " << percentile(0.0) * 1000.0 << ",\n";
+  file << "    \"p50\": " << percentile(0.5) * 1000.0 << ",\n";
+  file << "    \"p95\": " << percentile(0.95) * 1000.0 << ",\n";
+  file << "    \"p99\": " << percentile(0.99) * 1000.0 << ",\n";
+  file << "    \"max\": " << percentile(1.0) * 1000.0 << "\n";
+  file << "  },\n";
+
+  // Mean time of each category, with the label as lower case identifier.
+  file << "  \"categories\": {";
+  for (unsigned short i = 0, size = m_categoryTimes.size(); i < size; ++i) {
+    std::string name;
+    for (const char c : KX_KetsjiEngine::GetProfileLabel(i)) {
+      if (c == ' ') {
+        name += '_';
+      }
+      else if (c != ':') {
+        name += std::tolower(c);
+      }
+    }
+
+    file << ((i == 0) ? "\n" : ",\n") << "    \"" << name
+         << "\": " << ((numFrames == 0) ? 0.0 : m_categoryTimes[i] / numFrames * 1000.0);
+  }
+  file << "\n  }\n";
+  file << "}\n";
+
+  return file.good();
+}
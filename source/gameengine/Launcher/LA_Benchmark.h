@@ -0,0 +1,101 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file LA_Benchmark.h
+ *  \ingroup launcher
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "CM_Clock.h"
+#include "DEV_InputRecord.h"
+
+class KX_KetsjiEngine;
+class DEV_InputDevice;
+
+/** Deterministic run of the engine used for benchmarks. The engine is stepped at
+ * a fixed time step of the external clock, the inputs can be recorded and replayed
+ * and the frame times are written in a JSON report at the end.
+ *
+ * The options are read from the command line:
+ * - input_record: file to write the recorded inputs.
+ * - input_replay: file of the recorded inputs to replay, the real inputs are ignored.
+ * - frame_count: number of frames before the game ends.
+ * - stats_output: file to write the JSON timing report.
+ * - benchmark_render: render the frames, enabled by default.
+ */
+class LA_Benchmark {
+ private:
+  std::string m_recordPath;
+  std::string m_replayPath;
+  std::string m_statsPath;
+  unsigned int m_frameCount;
+  bool m_render;
+
+  DEV_InputRecord m_record;
+  DEV_InputDevice *m_inputDevice;
+
+  /// Index of the current frame.
+  unsigned int m_frame;
+  /// Game time between two frames.
+  double m_timeStep;
+
+  CM_Clock m_clock;
+  double m_frameStartTime;
+  /// Real time of each frame in seconds.
+  std::vector<double> m_frameTimes;
+  /// Cumulative time of each profiling category in seconds.
+  std::vector<double> m_categoryTimes;
+
+  bool WriteStats() const;
+
+ public:
+  LA_Benchmark();
+  ~LA_Benchmark();
+
+  /// Read the benchmark options from the command line.
+  void ReadOptions();
+
+  /// Return true if any option is used, the engine is then stepped by the external clock.
+  bool UseFixedStep() const;
+  /// Return true if the real inputs are ignored.
+  bool UseReplay() const;
+  bool GetRender() const;
+
+  /** Start recording or replaying the inputs of a device.
+   * \param ticrate The number of frames per game second.
+   * \return False if the replayed inputs can't be loaded.
+   */
+  bool Start(DEV_InputDevice *inputDevice, double ticrate);
+  /// Write the recorded inputs and the timing report.
+  void Stop();
+
+  /// Advance the external clock of the engine before a frame.
+  void BeginFrame(KX_KetsjiEngine *engine);
+  /** Measure the frame and replay the inputs of the next frame.
+   * \return False when the requested number of frames is reached.
+   */
+  bool EndFrame(KX_KetsjiEngine *engine);
+};
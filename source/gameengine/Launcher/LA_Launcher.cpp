@@ -30,14 +30,21 @@
 
 #include "LA_Launcher.h"
 
+#include "BKE_appdir.h"
 #include "BKE_main.h"
 #include "BKE_sound.h"
+#include "BLI_fileops.h"
+#include "BLI_path_util.h"
+#include "BLI_task.h"
+#include "BLI_utildefines.h"
+#include "GPU_shader.h"
 #include "DNA_scene_types.h"
 #include "wm_event_types.h"
 
 #include "BL_BlenderConverter.h"
 #include "BL_BlenderDataConversion.h"
 #include "CM_Message.h"
+#include "CM_StartupProfiler.h"
 #include "DEV_EventConsumer.h"
 #include "DEV_InputDevice.h"
 #include "DEV_Joystick.h"
@@ -46,11 +53,16 @@
 #include "GPG_Canvas.h"
 #include "KX_Globals.h"
 #include "KX_NetworkMessageManager.h"
+#include "KX_NetworkTransport.h"
 #include "KX_PyConstraintBinding.h"
 #include "KX_PythonInit.h"
 #include "KX_PythonMain.h"
+#include "KX_SoundManager.h"
+#include "KX_SoundStreamer.h"
+#include "KX_VideoCapture.h"
 #include "LA_System.h"
 #include "LA_SystemCommandLine.h"
+#include "numaapi.h"
 
 #ifdef WITH_PYTHON
 #  include "Texture.h"  // For FreeAllTextures.
@@ -84,6 +96,7 @@ LA_Launcher::LA_Launcher(GHOST_ISystem *system,
       m_canvas(nullptr),
       m_rasterizer(nullptr),
       m_converter(nullptr),
+      m_networkTransport(nullptr),
 #ifdef WITH_PYTHON
       m_globalDict(nullptr),
       m_gameLogic(nullptr),
@@ -123,12 +136,88 @@ const std::string &LA_Launcher::GetExitString()
   return m_exitString;
 }
 
+static void la_worker_thread_init(void *userdata)
+{
+  numaAPI_RunThreadOnNode(POINTER_AS_INT(userdata));
+}
+
+/** Place the threads on the NUMA nodes, meant for several instances of a game running on a
+ * multi socket computer. The memory allocated by a pinned thread is local to its node, the
+ * scenes converted on these threads keep their data close to them.
+ */
+static void la_init_threads(SYS_SystemHandle syshandle)
+{
+  const int mainThreadNode = SYS_GetCommandLineInt(syshandle, "main_thread_node", -1);
+  const int workerNode = SYS_GetCommandLineInt(syshandle, "worker_node", -1);
+  int numWorkerThreads = SYS_GetCommandLineInt(syshandle, "worker_threads", 0);
+
+  if (mainThreadNode >= 0 || workerNode >= 0) {
+    if (numaAPI_Initialize() != NUMAAPI_SUCCESS) {
+      CM_Warning("NUMA is not available, the threads are not pinned");
+    }
+    else {
+      // The main thread also renders.
+      if (mainThreadNode >= 0) {
+        if (numaAPI_IsNodeAvailable(mainThreadNode)) {
+          numaAPI_RunThreadOnNode(mainThreadNode);
+        }
+        else {
+          CM_Warning("NUMA node " << mainThreadNode << " is not available");
+        }
+      }
+
+      if (workerNode >= 0) {
+        if (numaAPI_IsNodeAvailable(workerNode)) {
+          BLI_task_scheduler_worker_init_set(la_worker_thread_init, POINTER_FROM_INT(workerNode));
+          // By default one thread per processor of the node.
+          if (numWorkerThreads == 0) {
+            numWorkerThreads = numaAPI_GetNumNodeProcessors(workerNode);
+          }
+        }
+        else {
+          CM_Warning("NUMA node " << workerNode << " is not available");
+        }
+      }
+    }
+  }
+
+  // The scheduler is shared with Blender, its default size is restored at the exit.
+  if (numWorkerThreads > 0) {
+    BLI_task_scheduler_num_threads_set(numWorkerThreads);
+  }
+}
+
+void LA_Launcher::StartStartupProfiler()
+{
+  SYS_SystemHandle syshandle = SYS_GetSystem();
+  if (SYS_GetCommandLineInt(syshandle, "profile_startup", 0)) {
+    CM_StartupProfiler::Start(SYS_GetCommandLineString(syshandle, "startup_trace", ""));
+  }
+}
+
 void LA_Launcher::InitEngine()
 {
+  // Started before the file read by the player, the timeline ends with the first frame.
+  StartStartupProfiler();
+  CM_StartupScope initScope("Engine Init");
+
   // Get and set the preferences.
   SYS_SystemHandle syshandle = SYS_GetSystem();
 
   const GameData &gm = m_startScene->gm;
+  m_benchmark.ReadOptions();
+
+  la_init_threads(syshandle);
+
+  /* Load the linked shaders of the previous launches instead of compiling them, the scene
+   * conversion compiles all the materials. */
+  char cacheDir[FILE_MAX];
+  if (SYS_GetCommandLineInt(syshandle, "shader_cache", 1) &&
+      BKE_appdir_folder_caches(cacheDir, sizeof(cacheDir))) {
+    BLI_path_append(cacheDir, sizeof(cacheDir), "bge_shaders");
+    GPU_shader_cache_dir_set(cacheDir);
+  }
+
   bool properties = (SYS_GetCommandLineInt(syshandle, "show_properties", 0) != 0);
   bool profile = (SYS_GetCommandLineInt(syshandle, "show_profile", 0) != 0);
 
@@ -138,9 +227,46 @@ void LA_Launcher::InitEngine()
   // WARNING: Fixed time is the opposite of fixed framerate.
   bool fixed_framerate = (SYS_GetCommandLineInt(
                               syshandle, "fixedtime", (gm.flag & GAME_ENABLE_ALL_FRAMES)) == 0);
+  /* The benchmarks proceed one frame of the tic rate duration per render, the
+   * clock is advanced by the launcher. */
+  const bool fixedStep = m_benchmark.UseFixedStep();
+  if (fixedStep) {
+    fixed_framerate = false;
+  }
   bool frameRate = (SYS_GetCommandLineInt(syshandle, "show_framerate", 0) != 0);
   bool nodepwarnings = (SYS_GetCommandLineInt(syshandle, "ignore_deprecation_warnings", 1) != 0);
   bool restrictAnimFPS = (gm.flag & GAME_RESTRICT_ANIM_UPDATES) != 0;
+  bool parallelSceneStep = (SYS_GetCommandLineInt(syshandle, "parallel_scene_step", 0) != 0);
+  bool retainedDraw = (SYS_GetCommandLineInt(syshandle, "retained_draw", 0) != 0);
+  bool framePacing = (SYS_GetCommandLineInt(syshandle, "frame_pacing", 0) != 0);
+  bool deferredSwap = (SYS_GetCommandLineInt(syshandle, "deferred_swap", 0) != 0);
+  bool lowLatency = (SYS_GetCommandLineInt(syshandle, "low_latency", 0) != 0);
+  bool instancedCollections = (SYS_GetCommandLineInt(syshandle, "instanced_collections", 0) !=
+                               0);
+  bool staticBatching = (SYS_GetCommandLineInt(syshandle, "static_batching", 0) != 0);
+  bool parallelLogic = (SYS_GetCommandLineInt(syshandle, "parallel_logic", 0) != 0);
+  bool staggerPulses = (SYS_GetCommandLineInt(syshandle, "stagger_pulses", 0) != 0);
+  bool profileScripts = (SYS_GetCommandLineInt(syshandle, "profile_scripts", 0) != 0);
+  bool profileGpu = (SYS_GetCommandLineInt(syshandle, "profile_gpu", 0) != 0);
+  bool profileObjects = (SYS_GetCommandLineInt(syshandle, "profile_objects", 0) != 0);
+  bool profileDepsgraph = (SYS_GetCommandLineInt(syshandle, "profile_depsgraph", 0) != 0);
+  bool profileAllocations = (SYS_GetCommandLineInt(syshandle, "profile_allocations", 0) != 0);
+  bool showMemory = (SYS_GetCommandLineInt(syshandle, "show_memory", 0) != 0);
+  bool showHud = (SYS_GetCommandLineInt(syshandle, "show_hud", 0) != 0);
+  bool deferredShaders = (SYS_GetCommandLineInt(syshandle, "deferred_shaders", 0) != 0);
+  bool staticShadows = (SYS_GetCommandLineInt(syshandle, "static_shadows", 0) != 0);
+  bool deferredGeometry = (SYS_GetCommandLineInt(syshandle, "deferred_geometry", 0) != 0);
+  bool multiView = (SYS_GetCommandLineInt(syshandle, "multi_view", 1) != 0);
+  bool overlayWorkbench = (SYS_GetCommandLineInt(syshandle, "overlay_workbench", 0) != 0);
+  bool physicsInterpolation = (SYS_GetCommandLineInt(syshandle, "physics_interpolation", 0) !=
+                               0);
+  const bool headless = (SYS_GetCommandLineInt(syshandle, "headless", 0) != 0);
+  if (headless) {
+    /* Without vsync nor swap to throttle the loop, the tics are paced by sleeping until the
+     * next one. */
+    fixed_framerate = !fixedStep;
+    framePacing = true;
+  }
 
   // Setup python console keys used as shortcut.
   for (unsigned short i = 0; i < 4; ++i) {
@@ -155,10 +281,41 @@ void LA_Launcher::InitEngine()
                                   (frameRate ? KX_KetsjiEngine::SHOW_FRAMERATE : 0) |
                                   (restrictAnimFPS ? KX_KetsjiEngine::RESTRICT_ANIMATION : 0) |
                                   (properties ? KX_KetsjiEngine::SHOW_DEBUG_PROPERTIES : 0) |
-                                  (profile ? KX_KetsjiEngine::SHOW_PROFILE : 0));
+                                  (profile ? KX_KetsjiEngine::SHOW_PROFILE : 0) |
+                                  (parallelSceneStep ? KX_KetsjiEngine::PARALLEL_SCENE_STEP : 0) |
+                                  (retainedDraw ? KX_KetsjiEngine::RETAINED_DRAW : 0) |
+                                  (framePacing ? KX_KetsjiEngine::FRAME_PACING : 0) |
+                                  (deferredSwap ? KX_KetsjiEngine::DEFERRED_SWAP : 0) |
+                                  (lowLatency ? KX_KetsjiEngine::LOW_LATENCY : 0) |
+                                  (instancedCollections ? KX_KetsjiEngine::INSTANCED_COLLECTIONS :
+                                                          0) |
+                                  (staticBatching ? KX_KetsjiEngine::STATIC_BATCHING : 0) |
+                                  (parallelLogic ? KX_KetsjiEngine::PARALLEL_LOGIC : 0) |
+                                  (staggerPulses ? KX_KetsjiEngine::STAGGER_PULSES : 0) |
+                                  (profileScripts ? KX_KetsjiEngine::PROFILE_SCRIPTS : 0) |
+                                  (profileGpu ? KX_KetsjiEngine::PROFILE_GPU : 0) |
+                                  (profileObjects ? KX_KetsjiEngine::PROFILE_OBJECTS : 0) |
+                                  (profileDepsgraph ? KX_KetsjiEngine::PROFILE_DEPSGRAPH : 0) |
+                                  (profileAllocations ? KX_KetsjiEngine::PROFILE_ALLOCATIONS :
+                                                        0) |
+                                  (showMemory ? KX_KetsjiEngine::SHOW_MEMORY : 0) |
+                                  (showHud ? KX_KetsjiEngine::SHOW_HUD : 0) |
+                                  (deferredShaders ? KX_KetsjiEngine::DEFERRED_SHADERS : 0) |
+                                  (staticShadows ? KX_KetsjiEngine::STATIC_SHADOWS : 0) |
+                                  (deferredGeometry ? KX_KetsjiEngine::DEFERRED_GEOMETRY : 0) |
+                                  (multiView ? KX_KetsjiEngine::MULTI_VIEW : 0) |
+                                  (overlayWorkbench ? KX_KetsjiEngine::OVERLAY_WORKBENCH : 0) |
+                                  (physicsInterpolation ? KX_KetsjiEngine::PHYSICS_INTERPOLATION :
+                                                          0) |
+                                  (fixedStep ? KX_KetsjiEngine::USE_EXTERNAL_CLOCK : 0) |
+                                  (headless ? KX_KetsjiEngine::HEADLESS : 0));
 
   m_rasterizer = new RAS_Rasterizer();
 
+  // Lines and triangles of the debug shapes drawn per frame at most.
+  m_rasterizer->GetDebugDraw().SetCapacity(
+      SYS_GetCommandLineInt(syshandle, "debug_draw_capacity", 65536));
+
   // Stereo parameters - Eye Separation from the UI - stereomode from the command-line/UI
   m_rasterizer->SetStereoMode(m_stereoMode);
   m_rasterizer->SetEyeSeparation(m_startScene->gm.eyeseparation);
@@ -195,13 +352,30 @@ void LA_Launcher::InitEngine()
   // Create the inputdevices.
   m_inputDevice = new DEV_InputDevice();
   m_eventConsumer = new DEV_EventConsumer(m_system, m_inputDevice, m_canvas);
-  m_system->addEventConsumer(m_eventConsumer);
+  // The replayed inputs replace the real inputs.
+  if (!m_benchmark.UseReplay()) {
+    m_system->addEventConsumer(m_eventConsumer);
+  }
 
   // Create a ketsjisystem (only needed for timing and stuff).
   m_kxsystem = new LA_System();
 
   m_networkMessageManager = new KX_NetworkMessageManager();
 
+  // The messages are broadcast to the peers when a local port is given.
+  const int networkPort = SYS_GetCommandLineInt(syshandle, "network_port", 0);
+  if (networkPort > 0) {
+    m_networkTransport = new KX_NetworkTransport();
+    if (m_networkTransport->Open(networkPort)) {
+      m_networkTransport->AddPeers(SYS_GetCommandLineString(syshandle, "network_peers", ""));
+      m_networkMessageManager->SetTransport(m_networkTransport);
+    }
+    else {
+      delete m_networkTransport;
+      m_networkTransport = nullptr;
+    }
+  }
+
   // Create the ketsjiengine.
   m_ketsjiEngine = new KX_KetsjiEngine(
       m_kxsystem, m_context, m_useViewportRender, m_shadingTypeRuntime);
@@ -209,9 +383,25 @@ void LA_Launcher::InitEngine()
 
   // Set the devices.
   m_ketsjiEngine->SetInputDevice(m_inputDevice);
+  // The events received during the frame wait are read again just before the logic.
+  m_inputDevice->SetClock(&m_ketsjiEngine->GetClock());
+  m_inputDevice->SetEventPump([this]() {
+    m_system->processEvents(false);
+    m_system->dispatchEvents();
+  });
   m_ketsjiEngine->SetCanvas(m_canvas);
   m_ketsjiEngine->SetRasterizer(m_rasterizer);
   m_ketsjiEngine->SetNetworkMessageManager(m_networkMessageManager);
+  m_ketsjiEngine->SetReplicationRate(
+      SYS_GetCommandLineFloat(syshandle, "replication_rate", 30.0f));
+  m_ketsjiEngine->SetReplicationRadius(
+      SYS_GetCommandLineFloat(syshandle, "replication_radius", 0.0f));
+  m_ketsjiEngine->SetMaxFramesInFlight(
+      SYS_GetCommandLineInt(syshandle, "max_frames_in_flight", 1));
+  const int soundVoices = SYS_GetCommandLineInt(syshandle, "sound_voices", 64);
+  m_ketsjiEngine->GetSoundManager()->SetMaxVoices((soundVoices > 0) ? soundVoices : 0);
+  m_ketsjiEngine->GetSoundStreamer()->SetStreamLength(
+      SYS_GetCommandLineFloat(syshandle, "sound_stream_length", 0.0f));
 
   DEV_Joystick::Init();
 
@@ -223,7 +413,9 @@ void LA_Launcher::InitEngine()
 #endif
 
   m_ketsjiEngine->SetFlag(flags, true);
-  m_ketsjiEngine->SetRender(true);
+  m_ketsjiEngine->GetPerformanceHud().SetCounters(SYS_GetCommandLineInt(
+      syshandle, "hud_counters", m_ketsjiEngine->GetPerformanceHud().GetCounters()));
+  m_ketsjiEngine->SetRender(m_benchmark.GetRender());
 
   m_ketsjiEngine->SetTicRate(gm.ticrate);
   m_ketsjiEngine->SetMaxLogicFrame(gm.maxlogicstep);
@@ -233,27 +425,79 @@ void LA_Launcher::InitEngine()
   // Set the global settings (carried over if restart/load new files).
   m_ketsjiEngine->SetGlobalSettings(m_globalSettings);
 
-  m_rasterizer->Init(m_canvas);
+  if (!headless) {
+    m_rasterizer->Init(m_canvas);
+  }
   InitCamera();
 
 #ifdef WITH_PYTHON
-  KX_SetMainPath(std::string(m_maggie->name));
-  setupGamePython(m_ketsjiEngine,
-                  m_maggie,
-                  m_globalDict,
-                  &m_gameLogic,
-                  m_argc,
-                  m_argv,
-                  m_context,
-                  &m_audioDeviceIsInitialized);
+  {
+    CM_StartupScope pythonScope("Python Init");
+    KX_SetMainPath(std::string(m_maggie->name));
+    setupGamePython(m_ketsjiEngine,
+                    m_maggie,
+                    m_globalDict,
+                    &m_gameLogic,
+                    m_argc,
+                    m_argv,
+                    m_context,
+                    &m_audioDeviceIsInitialized);
+  }
 #endif  // WITH_PYTHON
 
   // Create a scene converter, create and convert the stratingscene.
   m_converter = new BL_BlenderConverter(m_maggie, m_ketsjiEngine);
   m_ketsjiEngine->SetConverter(m_converter);
 
-  m_kxStartScene = new KX_Scene(
-      m_inputDevice, m_startSceneName, m_startScene, m_canvas, m_networkMessageManager);
+  /* Reuse the meshes converted by the previous launches, meant for the shipped games
+   * launched from a file which doesn't change. */
+  if (SYS_GetCommandLineInt(syshandle, "mesh_cache", 0) &&
+      BKE_appdir_folder_caches(cacheDir, sizeof(cacheDir))) {
+    BLI_path_append(cacheDir, sizeof(cacheDir), "bge_meshes");
+    if (BLI_dir_create_recursive(cacheDir)) {
+      m_converter->SetMeshCacheDirectory(cacheDir);
+    }
+    else {
+      CM_Warning("could not create the mesh cache directory " << cacheDir);
+    }
+  }
+
+  // Convert the geometry of the meshes of the inactive objects when they are first added.
+  m_converter->SetLazyMeshConversion(SYS_GetCommandLineInt(syshandle, "lazy_meshes", 1));
+
+  // Upload the material image textures at the resolution of their size on screen.
+  KX_TextureStreamer &textureStreamer = m_ketsjiEngine->GetTextureStreamer();
+  textureStreamer.SetEnabled(SYS_GetCommandLineInt(syshandle, "texture_streaming", 0));
+  textureStreamer.SetBudget(size_t(SYS_GetCommandLineInt(syshandle, "texture_budget", 1024)) *
+                            1048576);
+
+  /* Upload the material image textures from their compressed files, the transcoding saves the
+   * compressed files of the images as a build step of the shipped games. */
+  KX_CompressedTextures &compressedTextures = m_ketsjiEngine->GetCompressedTextures();
+  compressedTextures.SetEnabled(SYS_GetCommandLineInt(syshandle, "compressed_textures", 0));
+  compressedTextures.SetTranscode(SYS_GetCommandLineInt(syshandle, "transcode_textures", 0));
+
+  // Cull the lights the smallest on screen over a light budget per camera.
+  m_ketsjiEngine->SetLightBudget(
+      CLAMPIS(SYS_GetCommandLineInt(syshandle, "light_budget", 0), 0, 65535));
+
+  // Adapt the render resolution to the GPU time of the cameras.
+  KX_ResolutionScaler &resolutionScaler = m_ketsjiEngine->GetResolutionScaler();
+  resolutionScaler.SetEnabled(SYS_GetCommandLineInt(syshandle, "dynamic_resolution", 0));
+  resolutionScaler.SetTargetFrameTime(
+      SYS_GetCommandLineFloat(syshandle, "target_frametime", 0.0f) / 1000.0);
+  resolutionScaler.SetMinScale(SYS_GetCommandLineFloat(syshandle, "min_resolution_scale", 0.5f));
+
+  /* Share the temporary render targets between the camera viewports, must be set before the
+   * creation of the viewports. */
+  m_ketsjiEngine->SetSharedRenderTargets(
+      SYS_GetCommandLineInt(syshandle, "shared_render_targets", 1) && !m_useViewportRender);
+
+  {
+    CM_StartupScope sceneScope("Scene Creation", m_startSceneName.c_str());
+    m_kxStartScene = new KX_Scene(
+        m_inputDevice, m_startSceneName, m_startScene, m_canvas, m_networkMessageManager);
+  }
 
   KX_SetActiveScene(m_kxStartScene);
 
@@ -273,7 +517,26 @@ void LA_Launcher::InitEngine()
   m_ketsjiEngine->AddScene(m_kxStartScene);
   m_kxStartScene->Release();
 
-  m_ketsjiEngine->StartEngine();
+  {
+    CM_StartupScope startScope("Engine Start");
+    m_ketsjiEngine->StartEngine();
+  }
+
+  if (fixedStep && !m_benchmark.Start(m_inputDevice, gm.ticrate)) {
+    m_ketsjiEngine->RequestExit(KX_ExitRequest::OUTSIDE);
+  }
+
+  // Record the game in a video from the first frame.
+  const std::string capturePath = SYS_GetCommandLineString(syshandle, "capture_file", "");
+  if (!capturePath.empty()) {
+    m_ketsjiEngine->GetVideoCapture()->Start(
+        m_startScene,
+        capturePath,
+        m_canvas->GetWidth(),
+        m_canvas->GetHeight(),
+        SYS_GetCommandLineFloat(syshandle, "capture_rate", 0.0f),
+        (SYS_GetCommandLineInt(syshandle, "capture_hardware", 1) != 0));
+  }
 
   /* Set the animation playback rate for ipo's and actions the
    * framerate below should patch with FPS macro defined in blendef.h
@@ -290,6 +553,7 @@ void LA_Launcher::ExitEngine()
 #endif  // WITH_PYTHON
 
   DEV_Joystick::Close();
+  m_benchmark.Stop();
   m_ketsjiEngine->StopEngine();
 
 #ifdef WITH_PYTHON
@@ -354,6 +618,10 @@ void LA_Launcher::ExitEngine()
     delete m_networkMessageManager;
     m_networkMessageManager = nullptr;
   }
+  if (m_networkTransport) {
+    delete m_networkTransport;
+    m_networkTransport = nullptr;
+  }
 
   // Call this after we're sure nothing needs Python anymore (e.g., destructors).
   ExitPython();
@@ -365,6 +633,13 @@ void LA_Launcher::ExitEngine()
   }
 #endif  // WITH_AUDASPACE
 
+  GPU_shader_cache_dir_set(nullptr);
+
+  /* The pinned worker threads stay on their node, only the number of threads and the pinning
+   * of the new threads are restored. */
+  BLI_task_scheduler_worker_init_set(nullptr, nullptr);
+  BLI_task_scheduler_num_threads_set(0);
+
   m_exitRequested = KX_ExitRequest::NO_REQUEST;
 }
 
@@ -468,6 +743,17 @@ bool LA_Launcher::EngineNextFrame()
   // Check if we can create a python console debugging.
   HandlePythonConsole();
 #endif
+  const bool fixedStep = m_benchmark.UseFixedStep();
+  if (fixedStep) {
+    m_benchmark.BeginFrame(m_ketsjiEngine);
+  }
+
+  // The startup timeline ends with the first rendered frame.
+  const bool firstFrame = CM_StartupProfiler::IsEnabled();
+  if (firstFrame) {
+    CM_StartupProfiler::Begin("First Frame");
+  }
+
   // Kick the engine.
   bool renderFrame = m_ketsjiEngine->NextFrame();
 
@@ -481,8 +767,20 @@ bool LA_Launcher::EngineNextFrame()
     }
   }
 
+  if (firstFrame) {
+    CM_StartupProfiler::End();
+    CM_StartupProfiler::Stop();
+  }
+
   m_system->processEvents(false);
   m_system->dispatchEvents();
+  // Convert the events now for the exit checks, the next frame reads the events again.
+  m_inputDevice->FlushEvents();
+
+  if (fixedStep && !m_benchmark.EndFrame(m_ketsjiEngine) &&
+      m_exitRequested == KX_ExitRequest::NO_REQUEST) {
+    m_exitRequested = KX_ExitRequest::QUIT_GAME;
+  }
 
   if (m_inputDevice->GetInput((SCA_IInputDevice::SCA_EnumInputs)m_ketsjiEngine->GetExitKey())
           .Find(SCA_InputEvent::ACTIVE) &&
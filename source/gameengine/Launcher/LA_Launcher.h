@@ -30,6 +30,7 @@
 
 #include "KX_ISystem.h"
 #include "KX_KetsjiEngine.h"
+#include "LA_Benchmark.h"
 #include "RAS_Rasterizer.h"
 #include "SCA_IInputDevice.h"
 
@@ -37,6 +38,7 @@ class KX_Scene;
 class KX_ISystem;
 class BL_BlenderConverter;
 class KX_NetworkMessageManager;
+class KX_NetworkTransport;
 class RAS_ICanvas;
 class DEV_EventConsumer;
 class DEV_InputDevice;
@@ -78,6 +80,8 @@ class LA_Launcher {
   BL_BlenderConverter *m_converter;
   /// Manage messages.
   KX_NetworkMessageManager *m_networkMessageManager;
+  /// Exchange the messages with other engine instances, nullptr if disabled.
+  KX_NetworkTransport *m_networkTransport;
 
 #ifdef WITH_PYTHON
   PyObject *m_globalDict;
@@ -104,6 +108,9 @@ class LA_Launcher {
     int anisotropic;
   } m_savedData;
 
+  /// Fixed step run with the input record and replay and timing report.
+  LA_Benchmark m_benchmark;
+
   struct PythonConsole {
     bool use;
     std::vector<SCA_IInputDevice::SCA_EnumInputs> keys;
@@ -160,6 +167,11 @@ class LA_Launcher {
     return m_kxStartScene;
   }
 
+  /** Start the startup timeline if requested by the options, the player starts it before the
+   * file read. The timeline is printed after the first frame.
+   */
+  static void StartStartupProfiler();
+
   /// Initializes the game engine.
   virtual void InitEngine();
   /// Shuts the game engine down.
@@ -0,0 +1,369 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Physics/Bullet/CcdConvexDecomposition.cpp
+ *  \ingroup physbullet
+ */
+
+#include "CcdConvexDecomposition.h"
+
+#include <mutex>
+#include <numeric>
+#include <unordered_map>
+
+#include "BLI_hash_mm2a.h"
+
+#include "LinearMath/btConvexHullComputer.h"
+#include "LinearMath/btVector3.h"
+
+/// Maximum number of hulls of a decomposition.
+static const unsigned int maxHulls = 64;
+/// Distance of a vertex over the plane of a triangle of its part, relative to the mesh size.
+static const btScalar concavityTolerance = 0.02f;
+/// Maximum number of vertex and triangle plane tests to check the convexity of a part.
+static const size_t maxConvexityTests = 1 << 22;
+
+/// Decompositions by hash of their geometry.
+static std::unordered_multimap<uint32_t, CcdConvexDecomposition *> decompositions;
+/// The shapes can be created by the asynchronous libload.
+static std::mutex decompositionMutex;
+
+/// Split the triangles of a mesh in convex parts.
+class CcdConvexDecomposer {
+ private:
+  /// Triangles of a part, each triangle is 3 consecutive points.
+  struct Part {
+    btAlignedObjectArray<btVector3> m_points;
+    /// The part is convex or too small to be split.
+    bool m_final;
+  };
+
+  btScalar m_tolerance;
+  std::vector<Part> m_parts;
+  std::vector<std::vector<btScalar>> &m_hulls;
+
+  /// Return true if all the points of a part are under the planes of its triangles.
+  bool IsConvex(const Part &part) const
+  {
+    const btAlignedObjectArray<btVector3> &points = part.m_points;
+    const size_t numPoints = points.size();
+    if (numPoints * numPoints / 3 > maxConvexityTests) {
+      return false;
+    }
+
+    for (int i = 0; i < points.size(); i += 3) {
+      btVector3 normal = (points[i + 1] - points[i]).cross(points[i + 2] - points[i]);
+      const btScalar length = normal.length();
+      // Degenerated triangles don't make any concavity.
+      if (length < SIMD_EPSILON) {
+        continue;
+      }
+      normal /= length;
+
+      const btScalar dist = normal.dot(points[i]) + m_tolerance;
+      for (int j = 0; j < points.size(); ++j) {
+        if (normal.dot(points[j]) > dist) {
+          return false;
+        }
+      }
+    }
+
+    return true;
+  }
+
+  /// Add a polygon to a part as a triangle fan.
+  static void AddPolygon(Part &part, const btVector3 *polygon, unsigned short size)
+  {
+    for (unsigned short i = 2; i < size; ++i) {
+      part.m_points.push_back(polygon[0]);
+      part.m_points.push_back(polygon[i - 1]);
+      part.m_points.push_back(polygon[i]);
+    }
+  }
+
+  /** Cut a part in two by a plane normal to the longest axis of its bounds, the triangles
+   * crossing the plane are clipped so that the hulls of both halves keep their volume.
+   * \return False if the part is too small to be split.
+   */
+  bool Split(Part &part, Part &r_other)
+  {
+    btAlignedObjectArray<btVector3> &points = part.m_points;
+    btVector3 min(BT_LARGE_FLOAT, BT_LARGE_FLOAT, BT_LARGE_FLOAT);
+    btVector3 max(-BT_LARGE_FLOAT, -BT_LARGE_FLOAT, -BT_LARGE_FLOAT);
+    for (int i = 0; i < points.size(); ++i) {
+      min.setMin(points[i]);
+      max.setMax(points[i]);
+    }
+
+    const int axis = (max - min).maxAxis();
+    if ((max[axis] - min[axis]) < m_tolerance) {
+      return false;
+    }
+    const btScalar center = (min[axis] + max[axis]) * 0.5f;
+
+    Part below = {btAlignedObjectArray<btVector3>(), false};
+    r_other = {btAlignedObjectArray<btVector3>(), false};
+    for (int i = 0; i < points.size(); i += 3) {
+      // Clip the triangle polygon on both sides, a side gets at most 4 points.
+      btVector3 polygons[2][4];
+      unsigned short sizes[2] = {0, 0};
+      for (unsigned short j = 0; j < 3; ++j) {
+        const btVector3 &point = points[i + j];
+        const btVector3 &next = points[i + (j + 1) % 3];
+        const btScalar dist = point[axis] - center;
+        const btScalar nextDist = next[axis] - center;
+        const unsigned short side = (dist < 0.0f) ? 0 : 1;
+        polygons[side][sizes[side]++] = point;
+        if ((dist < 0.0f) != (nextDist < 0.0f)) {
+          const btVector3 cut = point.lerp(next, dist / (dist - nextDist));
+          polygons[0][sizes[0]++] = cut;
+          polygons[1][sizes[1]++] = cut;
+        }
+      }
+      AddPolygon(below, polygons[0], sizes[0]);
+      AddPolygon(r_other, polygons[1], sizes[1]);
+    }
+
+    if (below.m_points.size() == 0 || r_other.m_points.size() == 0) {
+      return false;
+    }
+
+    part = below;
+    return true;
+  }
+
+  /// Add the hull of the points of a part, only the points on the hull are kept.
+  void AddHull(const Part &part)
+  {
+    const btAlignedObjectArray<btVector3> &points = part.m_points;
+    std::vector<btScalar> coords(points.size() * 3);
+    for (int i = 0; i < points.size(); ++i) {
+      coords[i * 3] = points[i].x();
+      coords[i * 3 + 1] = points[i].y();
+      coords[i * 3 + 2] = points[i].z();
+    }
+
+    btConvexHullComputer computer;
+    computer.compute(coords.data(), 3 * sizeof(btScalar), points.size(), 0.0f, 0.0f);
+
+    const int numPoints = computer.vertices.size();
+    // Keep all the points of a flat part the computer can't make a hull of.
+    if (numPoints >= 3) {
+      coords.resize(numPoints * 3);
+      for (int i = 0; i < numPoints; ++i) {
+        const btVector3 &point = computer.vertices[i];
+        coords[i * 3] = point.x();
+        coords[i * 3 + 1] = point.y();
+        coords[i * 3 + 2] = point.z();
+      }
+    }
+
+    m_hulls.push_back(std::move(coords));
+  }
+
+  /// Find the root of a vertex in the loose parts union.
+  static int FindRoot(std::vector<int> &parents, int index)
+  {
+    while (parents[index] != index) {
+      parents[index] = parents[parents[index]];
+      index = parents[index];
+    }
+    return index;
+  }
+
+ public:
+  CcdConvexDecomposer(std::vector<std::vector<btScalar>> &hulls) : m_hulls(hulls)
+  {
+  }
+
+  void Decompose(const btScalar *vertices,
+                 unsigned int numVertices,
+                 const int *indices,
+                 unsigned int numTriangles)
+  {
+    btVector3 min(BT_LARGE_FLOAT, BT_LARGE_FLOAT, BT_LARGE_FLOAT);
+    btVector3 max(-BT_LARGE_FLOAT, -BT_LARGE_FLOAT, -BT_LARGE_FLOAT);
+    for (unsigned int i = 0; i < numVertices; ++i) {
+      const btVector3 co(vertices[i * 3], vertices[i * 3 + 1], vertices[i * 3 + 2]);
+      min.setMin(co);
+      max.setMax(co);
+    }
+    m_tolerance = (max - min).length() * concavityTolerance;
+
+    // Group the triangles by loose part.
+    std::vector<int> parents(numVertices);
+    std::iota(parents.begin(), parents.end(), 0);
+    for (unsigned int i = 0; i < numTriangles; ++i) {
+      const int *tri = &indices[i * 3];
+      const int root = FindRoot(parents, tri[0]);
+      parents[FindRoot(parents, tri[1])] = root;
+      parents[FindRoot(parents, tri[2])] = root;
+    }
+
+    std::unordered_map<int, unsigned int> rootParts;
+    for (unsigned int i = 0; i < numTriangles; ++i) {
+      const int *tri = &indices[i * 3];
+      const auto it = rootParts.emplace(FindRoot(parents, tri[0]), m_parts.size());
+      if (it.second) {
+        m_parts.push_back({btAlignedObjectArray<btVector3>(), false});
+      }
+      Part &part = m_parts[it.first->second];
+      for (unsigned short j = 0; j < 3; ++j) {
+        const btScalar *co = &vertices[tri[j] * 3];
+        part.m_points.push_back(btVector3(co[0], co[1], co[2]));
+      }
+    }
+
+    // Too many loose parts are split spatially as a whole.
+    if (m_parts.size() > maxHulls) {
+      for (unsigned int i = 1, size = m_parts.size(); i < size; ++i) {
+        const btAlignedObjectArray<btVector3> &points = m_parts[i].m_points;
+        for (int j = 0; j < points.size(); ++j) {
+          m_parts[0].m_points.push_back(points[j]);
+        }
+      }
+      m_parts.resize(1);
+    }
+
+    /* Split the largest part not known as convex until all the parts are convex or the
+     * maximum number of hulls is reached. */
+    while (m_parts.size() < maxHulls) {
+      Part *largest = nullptr;
+      for (Part &part : m_parts) {
+        if (!part.m_final &&
+            (!largest || part.m_points.size() > largest->m_points.size())) {
+          largest = &part;
+        }
+      }
+      if (!largest) {
+        break;
+      }
+
+      Part other;
+      if (IsConvex(*largest) || !Split(*largest, other)) {
+        largest->m_final = true;
+        continue;
+      }
+      m_parts.push_back(other);
+    }
+
+    for (const Part &part : m_parts) {
+      AddHull(part);
+    }
+  }
+};
+
+void CcdConvexDecomposition::Build(const btScalar *vertices,
+                                   unsigned int numVertices,
+                                   const int *indices)
+{
+  CcdConvexDecomposer decomposer(m_hulls);
+  decomposer.Decompose(vertices, numVertices, indices, m_numTriangles);
+}
+
+/** Find a decomposition of identical geometry.
+ * The decomposition mutex must be locked.
+ */
+CcdConvexDecomposition *CcdConvexDecomposition::Find(uint32_t hash,
+                                                     uint32_t hash2,
+                                                     unsigned int numVertices,
+                                                     unsigned int numTriangles)
+{
+  const auto range = decompositions.equal_range(hash);
+  for (auto it = range.first; it != range.second; ++it) {
+    CcdConvexDecomposition *decomposition = it->second;
+    if (decomposition->m_hash2 == hash2 && decomposition->m_numVertices == numVertices &&
+        decomposition->m_numTriangles == numTriangles) {
+      return decomposition;
+    }
+  }
+
+  return nullptr;
+}
+
+CcdConvexDecomposition *CcdConvexDecomposition::Acquire(
+    const btAlignedObjectArray<btScalar> &vertexArray,
+    const std::vector<int> &triFaceArray,
+    int numTriangles)
+{
+  if (vertexArray.size() == 0 || numTriangles == 0 ||
+      triFaceArray.size() < (size_t)numTriangles * 3) {
+    return nullptr;
+  }
+
+  const unsigned int numVertices = vertexArray.size() / 3;
+  const size_t vertexBytes = vertexArray.size() * sizeof(btScalar);
+  const size_t indexBytes = numTriangles * 3 * sizeof(int);
+  const uint32_t hash = BLI_hash_mm2(
+      (const unsigned char *)&vertexArray[0], vertexBytes, numTriangles);
+  const uint32_t hash2 = BLI_hash_mm2(
+      (const unsigned char *)triFaceArray.data(), indexBytes, ~(uint32_t)numTriangles);
+
+  {
+    std::lock_guard<std::mutex> lock(decompositionMutex);
+    CcdConvexDecomposition *decomposition = Find(hash, hash2, numVertices, numTriangles);
+    if (decomposition) {
+      ++decomposition->m_users;
+      return decomposition;
+    }
+  }
+
+  // Build outside of the lock, the decompositions of different geometries are built at once.
+  CcdConvexDecomposition *decomposition = new CcdConvexDecomposition();
+  decomposition->m_hash = hash;
+  decomposition->m_hash2 = hash2;
+  decomposition->m_numVertices = numVertices;
+  decomposition->m_numTriangles = numTriangles;
+  decomposition->m_users = 1;
+  decomposition->Build(&vertexArray[0], numVertices, triFaceArray.data());
+
+  std::lock_guard<std::mutex> lock(decompositionMutex);
+
+  // Another thread built the same geometry meanwhile, use its decomposition.
+  CcdConvexDecomposition *concurrent = Find(hash, hash2, numVertices, numTriangles);
+  if (concurrent) {
+    delete decomposition;
+    ++concurrent->m_users;
+    return concurrent;
+  }
+
+  decompositions.emplace(hash, decomposition);
+
+  return decomposition;
+}
+
+void CcdConvexDecomposition::Release(CcdConvexDecomposition *decomposition)
+{
+  std::lock_guard<std::mutex> lock(decompositionMutex);
+
+  if (--decomposition->m_users > 0) {
+    return;
+  }
+
+  const auto range = decompositions.equal_range(decomposition->m_hash);
+  for (auto it = range.first; it != range.second; ++it) {
+    if (it->second == decomposition) {
+      decompositions.erase(it);
+      break;
+    }
+  }
+
+  delete decomposition;
+}
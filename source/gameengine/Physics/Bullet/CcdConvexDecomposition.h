@@ -0,0 +1,67 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file CcdConvexDecomposition.h
+ *  \ingroup physbullet
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "LinearMath/btAlignedObjectArray.h"
+#include "LinearMath/btScalar.h"
+
+/** Approximation of a concave triangle mesh by convex hulls, used by the dynamic objects as a
+ * compound of convex shapes which collides much faster than a GImpact shape.
+ * The largest loose part of the mesh is cut in two by a plane until all the parts are convex
+ * within a tolerance relative to the mesh size, each part then makes a hull.
+ * The decompositions are shared by the meshes of identical geometry.
+ */
+class CcdConvexDecomposition {
+ public:
+  /// Points of each convex hull, each point is 3 consecutive values.
+  std::vector<std::vector<btScalar>> m_hulls;
+
+  /** Return the decomposition of a geometry, built on the first use. The decomposition must be
+   * released with Release, it can be acquired from any thread.
+   * \param numTriangles The number of triangles of triFaceArray.
+   * \return nullptr if the geometry is empty.
+   */
+  static CcdConvexDecomposition *Acquire(const btAlignedObjectArray<btScalar> &vertexArray,
+                                         const std::vector<int> &triFaceArray,
+                                         int numTriangles);
+  static void Release(CcdConvexDecomposition *decomposition);
+
+ private:
+  /// Hashes of the vertices and the indices, used to find the identical geometries.
+  uint32_t m_hash;
+  uint32_t m_hash2;
+  unsigned int m_numVertices;
+  unsigned int m_numTriangles;
+  unsigned int m_users;
+
+  static CcdConvexDecomposition *Find(uint32_t hash,
+                                      uint32_t hash2,
+                                      unsigned int numVertices,
+                                      unsigned int numTriangles);
+  void Build(const btScalar *vertices, unsigned int numVertices, const int *indices);
+};
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstring>
+
 #include "LinearMath/btMatrix3x3.h"
 #include "LinearMath/btQuaternion.h"
 #include "LinearMath/btVector3.h"
@@ -9,18 +11,45 @@
 #include "MT_Vector3.h"
 #include "MT_Vector4.h"
 
+/* With the vector instructions of moto the vectors and matrices share the memory layout of the
+ * single precision Bullet ones, they are converted by copying their memory. */
+#if defined(MT_SIMD) && !defined(BT_USE_DOUBLE_PRECISION)
+#  define CCD_SHARED_MATH_LAYOUT
+#endif
+
+#ifdef CCD_SHARED_MATH_LAYOUT
+template<class To, class From> inline To CcdReinterpretMath(const From &from)
+{
+  static_assert(sizeof(To) == sizeof(From), "The math types must have the same layout");
+  To to;
+  std::memcpy((void *)&to, (const void *)&from, sizeof(To));
+  return to;
+}
+#endif
+
 inline MT_Vector3 ToMoto(const btVector3 &vec)
 {
+#ifdef CCD_SHARED_MATH_LAYOUT
+  return CcdReinterpretMath<MT_Vector3>(vec);
+#else
   return MT_Vector3(vec.x(), vec.y(), vec.z());
+#endif
 }
 
 inline MT_Vector4 ToMoto(const btVector4 &vec)
 {
+#ifdef CCD_SHARED_MATH_LAYOUT
+  return CcdReinterpretMath<MT_Vector4>(vec);
+#else
   return MT_Vector4(vec.x(), vec.y(), vec.z(), vec.w());
+#endif
 }
 
 inline MT_Matrix3x3 ToMoto(const btMatrix3x3 &mat)
 {
+#ifdef CCD_SHARED_MATH_LAYOUT
+  return CcdReinterpretMath<MT_Matrix3x3>(mat);
+#else
   return MT_Matrix3x3(mat[0][0],
                       mat[0][1],
                       mat[0][2],
@@ -30,25 +59,41 @@ inline MT_Matrix3x3 ToMoto(const btMatrix3x3 &mat)
                       mat[2][0],
                       mat[2][1],
                       mat[2][2]);
+#endif
 }
 
 inline MT_Quaternion ToMoto(const btQuaternion &quat)
 {
+#ifdef CCD_SHARED_MATH_LAYOUT
+  return CcdReinterpretMath<MT_Quaternion>(quat);
+#else
   return MT_Quaternion(quat.x(), quat.y(), quat.z(), quat.w());
+#endif
 }
 
 inline btVector3 ToBullet(const MT_Vector3 &vec)
 {
+#ifdef CCD_SHARED_MATH_LAYOUT
+  return CcdReinterpretMath<btVector3>(vec);
+#else
   return btVector3(vec.x(), vec.y(), vec.z());
+#endif
 }
 
 inline btVector4 ToBullet(const MT_Vector4 &vec)
 {
+#ifdef CCD_SHARED_MATH_LAYOUT
+  return CcdReinterpretMath<btVector4>(vec);
+#else
   return btVector4(vec.x(), vec.y(), vec.z(), vec.w());
+#endif
 }
 
 inline btMatrix3x3 ToBullet(const MT_Matrix3x3 &mat)
 {
+#ifdef CCD_SHARED_MATH_LAYOUT
+  return CcdReinterpretMath<btMatrix3x3>(mat);
+#else
   return btMatrix3x3(mat[0][0],
                      mat[0][1],
                      mat[0][2],
@@ -58,9 +103,14 @@ inline btMatrix3x3 ToBullet(const MT_Matrix3x3 &mat)
                      mat[2][0],
                      mat[2][1],
                      mat[2][2]);
+#endif
 }
 
 inline btQuaternion ToBullet(const MT_Quaternion &quat)
 {
+#ifdef CCD_SHARED_MATH_LAYOUT
+  return CcdReinterpretMath<btQuaternion>(quat);
+#else
   return btQuaternion(quat.x(), quat.y(), quat.z(), quat.w());
+#endif
 }
@@ -25,8 +25,18 @@
 
 #include "CcdPhysicsController.h"
 
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+
+#include "BKE_appdir.h"
 #include "BKE_cdderivedmesh.h"
 #include "BKE_context.h"
+#include "BLI_fileops.h"
+#include "BLI_hash_mm2a.h"
+#include "BLI_path_util.h"
+#include "BLI_string.h"
 #include "DEG_depsgraph_query.h"
 #include "DNA_mesh_types.h"
 
@@ -36,6 +46,7 @@
 #include "BulletSoftBody/btSoftRigidDynamicsWorld.h"
 #include "LinearMath/btConvexHull.h"
 
+#include "CcdConvexDecomposition.h"
 #include "CcdPhysicsEnvironment.h"
 #include "KX_GameObject.h"
 #include "RAS_DisplayArray.h"
@@ -193,6 +204,9 @@ CcdPhysicsController::CcdPhysicsController(const CcdConstructionInfo &ci) : m_cc
   m_registerCount = 0;
   m_softBodyTransformInitialized = false;
   m_parentRoot = nullptr;
+  m_environmentIndex = -1;
+  m_fhIndex = -1;
+  m_softBodyIndex = -1;
   // copy pointers locally to allow smart release
   m_MotionState = ci.m_MotionState;
   m_collisionShape = ci.m_collisionShape;
@@ -216,6 +230,9 @@ CcdPhysicsController::CcdPhysicsController(const CcdConstructionInfo &ci) : m_cc
   m_savedFriction = 0.0f;
   m_savedDyna = false;
   m_suspended = false;
+  m_fullShape = nullptr;
+  m_savedCcdMotionThreshold = 0.0f;
+  m_motionStateSynced = false;
 
   CreateRigidbody();
 }
@@ -609,7 +626,8 @@ void CcdPhysicsController::CreateRigidbody()
   if (m_cci.m_bSensor) {
     // reset the flags that have been set so far
     GetCollisionObject()->setCollisionFlags(0);
-    // sensor must never go to sleep: they need to detect continously
+    /* sensor must never go to sleep: they need to detect continously,
+     * except the near and radar sensors sleeping while they are not moving. */
     GetCollisionObject()->setActivationState(DISABLE_DEACTIVATION);
   }
   GetCollisionObject()->setCollisionFlags(m_object->getCollisionFlags() | m_cci.m_collisionFlags);
@@ -627,11 +645,41 @@ void CcdPhysicsController::CreateRigidbody()
     //		body->setContactProcessingThreshold(m_cci.m_contactProcessingThreshold);
     body->setSleepingThresholds(gLinearSleepingTreshold, gAngularSleepingTreshold);
   }
+  UpdateCcd();
   if (m_object && m_cci.m_do_anisotropic) {
     m_object->setAnisotropicFriction(m_cci.m_anisotropicFriction);
   }
 }
 
+void CcdPhysicsController::UpdateCcd()
+{
+  btRigidBody *body = GetRigidBody();
+  if (!body || !m_cci.m_ccd) {
+    return;
+  }
+
+  if (!m_cci.m_ccd_auto_threshold) {
+    body->setCcdMotionThreshold(m_cci.m_ccd_motion_threshold);
+    body->setCcdSweptSphereRadius(m_cci.m_ccd_swept_sphere_radius);
+    return;
+  }
+
+  /* The body can tunnel when it moves more than its thinnest half extent in one step, the swept
+   * sphere must stay inside the shape to not report early contacts. */
+  btTransform identity;
+  identity.setIdentity();
+  btVector3 aabbMin, aabbMax;
+  m_collisionShape->getAabb(identity, aabbMin, aabbMax);
+  const btVector3 halfExtents = (aabbMax - aabbMin) * btScalar(0.5f);
+  const btScalar halfExtent = halfExtents[halfExtents.minAxis()];
+  if (halfExtent <= SIMD_EPSILON) {
+    return;
+  }
+
+  body->setCcdMotionThreshold(halfExtent);
+  body->setCcdSweptSphereRadius(halfExtent * btScalar(0.9f));
+}
+
 MT_Vector3 CcdPhysicsController::GetGravity()
 {
   MT_Vector3 gravity(0.0f, 0.0f, 0.0f);
@@ -650,14 +698,317 @@ void CcdPhysicsController::SetGravity(const MT_Vector3 &gravity)
   }
 }
 
+/** Triangle mesh shape and its BVH shared by all the mesh shapes of identical geometry.
+ * It owns a copy of the geometry as the shape infos it was built for can be freed or updated.
+ */
+struct CcdSharedMeshShape {
+  btAlignedObjectArray<btScalar> m_vertexArray;
+  std::vector<int> m_triFaceArray;
+  btScalar m_margin;
+  bool m_useBvh;
+  btTriangleIndexVertexArray *m_indexVertexArray;
+  btBvhTriangleMeshShape *m_shape;
+  /// Buffer of the BVH loaded in place from the disk cache, nullptr if the shape built it.
+  void *m_bvhBuffer;
+  unsigned int m_users;
+};
+
+/// Minimum number of triangles of the meshes whose BVH is saved in the disk cache.
+static const int bvhCacheMinTriangles = 1024;
+
+/// Header of a BVH cache file, followed by the BVH serialized in place.
+struct CcdBvhCacheHeader {
+  char m_id[8];
+  uint32_t m_scalarSize;
+  uint32_t m_numVertices;
+  uint32_t m_numTriangles;
+  /// Second hash of the geometry, the first one is in the file name.
+  uint32_t m_hash;
+  uint32_t m_bvhSize;
+};
+
+static const char bvhCacheId[8] = "BGEBVH1";
+
+static bool bvh_cache_header_match(const CcdBvhCacheHeader &a, const CcdBvhCacheHeader &b)
+{
+  return (memcmp(a.m_id, b.m_id, sizeof(a.m_id)) == 0 && a.m_scalarSize == b.m_scalarSize &&
+          a.m_numVertices == b.m_numVertices && a.m_numTriangles == b.m_numTriangles &&
+          a.m_hash == b.m_hash);
+}
+
+/// Get the file of the BVH cache of a geometry in the user cache directory.
+static bool get_bvh_cache_path(uint32_t hash, uint32_t hash2, char *r_path, size_t path_len)
+{
+  char dir[FILE_MAX];
+  if (!BKE_appdir_folder_caches(dir, sizeof(dir))) {
+    return false;
+  }
+
+  char name[32];
+  BLI_snprintf(name, sizeof(name), "%08x%08x.bvh", hash, hash2);
+  BLI_path_join(r_path, path_len, dir, "bge_bvh", name, NULL);
+  return true;
+}
+
+/** Load a BVH from the disk cache.
+ * \param r_buffer The buffer containing the BVH, to free with btAlignedFree after the shape.
+ * \return The BVH or nullptr if the cache file doesn't exist or doesn't match.
+ */
+static btOptimizedBvh *load_cached_bvh(const char *path,
+                                       const CcdBvhCacheHeader &header,
+                                       void **r_buffer)
+{
+  FILE *file = BLI_fopen(path, "rb");
+  if (!file) {
+    return nullptr;
+  }
+
+  btOptimizedBvh *bvh = nullptr;
+  CcdBvhCacheHeader fileHeader;
+  if (fread(&fileHeader, sizeof(fileHeader), 1, file) == 1 &&
+      bvh_cache_header_match(fileHeader, header) && fileHeader.m_bvhSize > 0) {
+    // The BVH is deserialized in place and requires an aligned buffer.
+    void *buffer = btAlignedAlloc(fileHeader.m_bvhSize, 16);
+    if (fread(buffer, fileHeader.m_bvhSize, 1, file) == 1) {
+      bvh = btOptimizedBvh::deSerializeInPlace(buffer, fileHeader.m_bvhSize, false);
+    }
+
+    if (bvh) {
+      *r_buffer = buffer;
+    }
+    else {
+      btAlignedFree(buffer);
+    }
+  }
+  fclose(file);
+
+  return bvh;
+}
+
+/// Save a BVH in the disk cache, the file is written aside and renamed for concurrent players.
+static void save_cached_bvh(const char *path, const CcdBvhCacheHeader &header, btOptimizedBvh *bvh)
+{
+  if (!BLI_make_existing_file(path)) {
+    return;
+  }
+
+  CcdBvhCacheHeader fileHeader = header;
+  fileHeader.m_bvhSize = bvh->calculateSerializeBufferSize();
+  void *buffer = btAlignedAlloc(fileHeader.m_bvhSize, 16);
+  if (!bvh->serializeInPlace(buffer, fileHeader.m_bvhSize, false)) {
+    btAlignedFree(buffer);
+    return;
+  }
+
+  char tmpPath[FILE_MAX];
+  // The BVH address makes the name unique between the threads saving the same geometry.
+  BLI_snprintf(tmpPath, sizeof(tmpPath), "%s.%p.tmp", path, (void *)bvh);
+
+  FILE *file = BLI_fopen(tmpPath, "wb");
+  if (file) {
+    const bool written = (fwrite(&fileHeader, sizeof(fileHeader), 1, file) == 1 &&
+                          fwrite(buffer, fileHeader.m_bvhSize, 1, file) == 1);
+    fclose(file);
+
+    if (!written || BLI_rename(tmpPath, path) != 0) {
+      BLI_delete(tmpPath, false, false);
+    }
+  }
+
+  btAlignedFree(buffer);
+}
+
+/// Shared mesh shapes by hash of their geometry.
+static std::unordered_multimap<uint32_t, CcdSharedMeshShape *> sharedMeshShapes;
+/// Shared mesh shapes by bullet shape, used to release them.
+static std::unordered_map<btTriangleMeshShape *, CcdSharedMeshShape *> sharedMeshShapeOwners;
+/// The shapes can be created by the asynchronous libload.
+static std::mutex sharedMeshShapeMutex;
+
+/** Find a shared shape of identical geometry, margin and BVH usage.
+ * The shared shape mutex must be locked.
+ */
+static CcdSharedMeshShape *find_shared_mesh_shape(uint32_t hash,
+                                                  const btAlignedObjectArray<btScalar> &vertexArray,
+                                                  const std::vector<int> &triFaceArray,
+                                                  int numTriangles,
+                                                  btScalar margin,
+                                                  bool useBvh)
+{
+  const size_t vertexBytes = vertexArray.size() * sizeof(btScalar);
+  const size_t indexBytes = numTriangles * 3 * sizeof(int);
+
+  const auto range = sharedMeshShapes.equal_range(hash);
+  for (auto it = range.first; it != range.second; ++it) {
+    CcdSharedMeshShape *shared = it->second;
+    // Compare the whole geometry, equal hashes don't ensure equal geometries.
+    if (shared->m_margin == margin && shared->m_useBvh == useBvh &&
+        shared->m_vertexArray.size() == vertexArray.size() &&
+        shared->m_triFaceArray.size() == (size_t)numTriangles * 3 &&
+        memcmp(&shared->m_vertexArray[0], &vertexArray[0], vertexBytes) == 0 &&
+        memcmp(shared->m_triFaceArray.data(), triFaceArray.data(), indexBytes) == 0) {
+      return shared;
+    }
+  }
+
+  return nullptr;
+}
+
+static void free_shared_mesh_shape(CcdSharedMeshShape *shared)
+{
+  delete shared->m_shape;
+  if (shared->m_bvhBuffer) {
+    btAlignedFree(shared->m_bvhBuffer);
+  }
+  delete shared->m_indexVertexArray;
+  delete shared;
+}
+
+/** Return a triangle mesh shape of the geometry, shared with the other shapes of identical
+ * geometry, margin and BVH usage. The shape must be released with release_shared_mesh_shape.
+ * The BVH is built outside of the lock, several threads can build the shapes of different
+ * geometries at the same time.
+ * \param numTriangles The number of triangles of triFaceArray.
+ * \param useBvhCache Load the BVH of a large mesh from the disk cache, or save it once built.
+ */
+static btBvhTriangleMeshShape *acquire_shared_mesh_shape(
+    const btAlignedObjectArray<btScalar> &vertexArray,
+    const std::vector<int> &triFaceArray,
+    int numTriangles,
+    btScalar margin,
+    bool useBvh,
+    bool useBvhCache)
+{
+  if (vertexArray.size() == 0 || numTriangles == 0 ||
+      triFaceArray.size() < (size_t)numTriangles * 3) {
+    return nullptr;
+  }
+
+  const size_t vertexBytes = vertexArray.size() * sizeof(btScalar);
+  const size_t indexBytes = numTriangles * 3 * sizeof(int);
+  uint32_t hash = BLI_hash_mm2((const unsigned char *)&vertexArray[0], vertexBytes, numTriangles);
+  hash = BLI_hash_mm2((const unsigned char *)triFaceArray.data(), indexBytes, hash);
+
+  {
+    std::lock_guard<std::mutex> lock(sharedMeshShapeMutex);
+    CcdSharedMeshShape *shared = find_shared_mesh_shape(
+        hash, vertexArray, triFaceArray, numTriangles, margin, useBvh);
+    if (shared) {
+      ++shared->m_users;
+      return shared->m_shape;
+    }
+  }
+
+  CcdSharedMeshShape *shared = new CcdSharedMeshShape();
+  shared->m_vertexArray = vertexArray;
+  shared->m_triFaceArray.assign(triFaceArray.begin(), triFaceArray.begin() + numTriangles * 3);
+  shared->m_margin = margin;
+  shared->m_useBvh = useBvh;
+  shared->m_indexVertexArray = new btTriangleIndexVertexArray(numTriangles,
+                                                              shared->m_triFaceArray.data(),
+                                                              3 * sizeof(int),
+                                                              shared->m_vertexArray.size() / 3,
+                                                              &shared->m_vertexArray[0],
+                                                              3 * sizeof(btScalar));
+  shared->m_bvhBuffer = nullptr;
+
+  char cachePath[FILE_MAX];
+  CcdBvhCacheHeader cacheHeader;
+  btOptimizedBvh *cachedBvh = nullptr;
+  useBvhCache = useBvhCache && useBvh && numTriangles >= bvhCacheMinTriangles &&
+                get_bvh_cache_path(hash,
+                                   BLI_hash_mm2((const unsigned char *)&vertexArray[0],
+                                                vertexBytes,
+                                                ~(uint32_t)numTriangles),
+                                   cachePath,
+                                   sizeof(cachePath));
+  if (useBvhCache) {
+    memcpy(cacheHeader.m_id, bvhCacheId, sizeof(cacheHeader.m_id));
+    cacheHeader.m_scalarSize = sizeof(btScalar);
+    cacheHeader.m_numVertices = vertexArray.size() / 3;
+    cacheHeader.m_numTriangles = numTriangles;
+    cacheHeader.m_hash = BLI_hash_mm2(
+        (const unsigned char *)triFaceArray.data(), indexBytes, ~(uint32_t)numTriangles);
+    cacheHeader.m_bvhSize = 0;
+    cachedBvh = load_cached_bvh(cachePath, cacheHeader, &shared->m_bvhBuffer);
+  }
+
+  if (cachedBvh) {
+    // Build the shape without BVH and use the one of the cache.
+    shared->m_shape = new btBvhTriangleMeshShape(shared->m_indexVertexArray, true, false);
+    shared->m_shape->setOptimizedBvh(cachedBvh);
+  }
+  else {
+    shared->m_shape = new btBvhTriangleMeshShape(shared->m_indexVertexArray, true, useBvh);
+    if (useBvhCache) {
+      save_cached_bvh(cachePath, cacheHeader, shared->m_shape->getOptimizedBvh());
+    }
+  }
+  shared->m_shape->setMargin(margin);
+  shared->m_users = 1;
+
+  std::lock_guard<std::mutex> lock(sharedMeshShapeMutex);
+
+  // Another thread built the same geometry meanwhile, use its shape.
+  CcdSharedMeshShape *concurrentShared = find_shared_mesh_shape(
+      hash, vertexArray, triFaceArray, numTriangles, margin, useBvh);
+  if (concurrentShared) {
+    free_shared_mesh_shape(shared);
+    ++concurrentShared->m_users;
+    return concurrentShared->m_shape;
+  }
+
+  sharedMeshShapes.emplace(hash, shared);
+  sharedMeshShapeOwners.emplace(shared->m_shape, shared);
+
+  return shared->m_shape;
+}
+
+/** Release a triangle mesh shape returned by acquire_shared_mesh_shape.
+ * \return False if the shape is not shared.
+ */
+static bool release_shared_mesh_shape(btTriangleMeshShape *shape)
+{
+  std::lock_guard<std::mutex> lock(sharedMeshShapeMutex);
+
+  const auto ownerIt = sharedMeshShapeOwners.find(shape);
+  if (ownerIt == sharedMeshShapeOwners.end()) {
+    return false;
+  }
+
+  CcdSharedMeshShape *shared = ownerIt->second;
+  if (--shared->m_users > 0) {
+    return true;
+  }
+
+  sharedMeshShapeOwners.erase(ownerIt);
+  for (auto it = sharedMeshShapes.begin(); it != sharedMeshShapes.end(); ++it) {
+    if (it->second == shared) {
+      sharedMeshShapes.erase(it);
+      break;
+    }
+  }
+
+  free_shared_mesh_shape(shared);
+
+  return true;
+}
+
 static void DeleteBulletShape(btCollisionShape *shape, bool free)
 {
-  if (shape->getShapeType() == SCALED_TRIANGLE_MESH_SHAPE_PROXYTYPE) {
+  if (shape->isCompound()) {
+    // bullet does not delete the child shape, must do it here
+    btCompoundShape *compoundShape = (btCompoundShape *)shape;
+    for (int i = compoundShape->getNumChildShapes() - 1; i >= 0; i--) {
+      DeleteBulletShape(compoundShape->getChildShape(i), true);
+    }
+  }
+  else if (shape->getShapeType() == SCALED_TRIANGLE_MESH_SHAPE_PROXYTYPE) {
     /* If we use Bullet scaled shape (btScaledBvhTriangleMeshShape) we have to
      * free the child of the unscaled shape (btTriangleMeshShape) here.
      */
     btTriangleMeshShape *meshShape = ((btScaledBvhTriangleMeshShape *)shape)->getChildShape();
-    if (meshShape)
+    if (meshShape && !release_shared_mesh_shape(meshShape))
       delete meshShape;
   }
   if (free) {
@@ -668,16 +1019,8 @@ static void DeleteBulletShape(btCollisionShape *shape, bool free)
 bool CcdPhysicsController::DeleteControllerShape()
 {
   if (m_collisionShape) {
-    // collision shape is always unique to the controller, can delete it here
-    if (m_collisionShape->isCompound()) {
-      // bullet does not delete the child shape, must do it here
-      btCompoundShape *compoundShape = (btCompoundShape *)m_collisionShape;
-      int numChild = compoundShape->getNumChildShapes();
-      for (int i = numChild - 1; i >= 0; i--) {
-        btCollisionShape *childShape = compoundShape->getChildShape(i);
-        DeleteBulletShape(childShape, true);
-      }
-    }
+    /* collision shape is always unique to the controller, can delete it here, with the
+     * children of the compound shapes */
     DeleteBulletShape(m_collisionShape, true);
 
     return true;
@@ -688,6 +1031,9 @@ bool CcdPhysicsController::DeleteControllerShape()
 
 bool CcdPhysicsController::ReplaceControllerShape(btCollisionShape *newShape)
 {
+  // The kept full shape is outdated by the new shape.
+  SetSimplifiedShape(false);
+
   if (m_collisionShape)
     DeleteControllerShape();
 
@@ -727,6 +1073,10 @@ bool CcdPhysicsController::ReplaceControllerShape(btCollisionShape *newShape)
     m_characterController->ReplaceShape(static_cast<btConvexShape *>(newShape));
   }
 
+  if (m_cci.m_ccd_auto_threshold) {
+    UpdateCcd();
+  }
+
   return true;
 }
 
@@ -745,6 +1095,10 @@ CcdPhysicsController::~CcdPhysicsController()
   delete m_object;
 
   DeleteControllerShape();
+  if (m_fullShape) {
+    m_collisionShape = m_fullShape;
+    DeleteControllerShape();
+  }
 
   if (m_shapeInfo) {
     m_shapeInfo->Release();
@@ -822,111 +1176,146 @@ bool CcdPhysicsController::SynchronizeMotionStates(float time)
 
   if (body && !body->isStaticObject()) {
     const btTransform &xform = body->getCenterOfMassTransform();
-    const btMatrix3x3 &worldOri = xform.getBasis();
-    const btVector3 &worldPos = xform.getOrigin();
-    m_MotionState->SetWorldOrientation(ToMoto(worldOri));
-    m_MotionState->SetWorldPosition(ToMoto(worldPos));
-    m_MotionState->CalculateWorldTransformations();
+    /* A body at rest doesn't tag its node as modified, the node is tagged by the
+     * game object when it moves the body. */
+    if (!m_motionStateSynced || !(xform == m_syncedTransform)) {
+      const btMatrix3x3 &worldOri = xform.getBasis();
+      const btVector3 &worldPos = xform.getOrigin();
+      m_MotionState->SetWorldOrientation(ToMoto(worldOri));
+      m_MotionState->SetWorldPosition(ToMoto(worldPos));
+      m_MotionState->CalculateWorldTransformations();
+      m_syncedTransform = xform;
+      m_motionStateSynced = true;
+    }
   }
 
-  const MT_Vector3 &scale = m_MotionState->GetWorldScaling();
-  GetCollisionShape()->setLocalScaling(ToBullet(scale));
+  // Rescaling a compound shape updates the bounding box of all its children.
+  const btVector3 scale = ToBullet(m_MotionState->GetWorldScaling());
+  btCollisionShape *shape = GetCollisionShape();
+  if (shape->getLocalScaling() != scale) {
+    shape->setLocalScaling(scale);
+    if (m_cci.m_ccd_auto_threshold) {
+      UpdateCcd();
+    }
+  }
 
   return true;
 }
 
-void CcdPhysicsController::UpdateSoftBody()
+bool CcdPhysicsController::NeedSynchronizeMotionStates() const
+{
+  if (btSoftBody::upcast(m_object)) {
+    return true;
+  }
+
+  const btRigidBody *body = GetRigidBody();
+  return (body && !body->isStaticObject() && (body->isActive() || body->isKinematicObject()));
+}
+
+Mesh *CcdPhysicsController::GetSoftBodyMesh()
 {
   btSoftBody *sb = GetSoftBody();
-  if (sb) {
-    if (sb->m_pose.m_bframe || sb->m_pose.m_bvolume) {
+  if (!sb || !(sb->m_pose.m_bframe || sb->m_pose.m_bvolume)) {
+    return nullptr;
+  }
+
+  RAS_MeshObject *rasMesh = GetShapeInfo()->GetMesh();
+  return rasMesh ? rasMesh->GetOrigMesh() : nullptr;
+}
 
-      RAS_MeshObject *rasMesh = GetShapeInfo()->GetMesh();
+void CcdPhysicsController::WriteSoftBodyMesh()
+{
+  Mesh *me = GetSoftBodyMesh();
+  if (!me) {
+    return;
+  }
 
-      if (rasMesh) {
-        // Get other mesh data
-        Mesh *me = rasMesh->GetOrigMesh();
-        // I don't see how we could do without DerivedMesh...
-        DerivedMesh *dm = CDDM_from_mesh(me);
+  btSoftBody *sb = GetSoftBody();
+  RAS_MeshObject *rasMesh = GetShapeInfo()->GetMesh();
 
-        // Some meshes with modifiers returns 0 polys, call DM_ensure_tessface avoid this.
-        DM_ensure_tessface(dm);
+  // I don't see how we could do without DerivedMesh...
+  DerivedMesh *dm = CDDM_from_mesh(me);
 
-        const int *index_mf_to_mpoly = (const int *)dm->getTessFaceDataArray(dm, CD_ORIGINDEX);
-        const int *index_mp_to_orig = (const int *)dm->getPolyDataArray(dm, CD_ORIGINDEX);
-        if (!index_mf_to_mpoly) {
-          index_mp_to_orig = nullptr;
-        }
+  // Some meshes with modifiers returns 0 polys, call DM_ensure_tessface avoid this.
+  DM_ensure_tessface(dm);
 
-        MVert *mverts = dm->getVertArray(dm);
-        MFace *mface = dm->getTessFaceArray(dm);
-        int numpolys = dm->getNumTessFaces(dm);
+  const int *index_mf_to_mpoly = (const int *)dm->getTessFaceDataArray(dm, CD_ORIGINDEX);
+  const int *index_mp_to_orig = (const int *)dm->getPolyDataArray(dm, CD_ORIGINDEX);
+  if (!index_mf_to_mpoly) {
+    index_mp_to_orig = nullptr;
+  }
 
-        btSoftBody::tNodeArray &nodes(sb->m_nodes);
-        bContext *C = KX_GetActiveEngine()->GetContext();
-        Depsgraph *depsgraph = CTX_data_depsgraph_on_load(C);
-        KX_GameObject *gameobj = KX_GameObject::GetClientObject(
-            (KX_ClientObjectInfo *)GetNewClientInfo());
-        Object *ob = DEG_get_evaluated_object(depsgraph, gameobj->GetBlenderObject());
+  MVert *mverts = dm->getVertArray(dm);
+  MFace *mface = dm->getTessFaceArray(dm);
+  int numpolys = dm->getNumTessFaces(dm);
 
-        for (int p2 = 0; p2 < numpolys; p2++) {
-          MFace *mf = &mface[p2];
-          const int origi = index_mf_to_mpoly ?
-                                DM_origindex_mface_mpoly(index_mf_to_mpoly, index_mp_to_orig, p2) :
-                                p2;
-          RAS_Polygon *poly = (origi != ORIGINDEX_NONE) ? rasMesh->GetPolygon(origi) : nullptr;
+  btSoftBody::tNodeArray &nodes(sb->m_nodes);
+  KX_GameObject *gameobj = KX_GameObject::GetClientObject(
+      (KX_ClientObjectInfo *)GetNewClientInfo());
 
-          // only add polygons that have the collisionflag set
-          if (poly) {
-            MVert *v1 = &mverts[mf->v1];
-            MVert *v2 = &mverts[mf->v2];
-            MVert *v3 = &mverts[mf->v3];
+  for (int p2 = 0; p2 < numpolys; p2++) {
+    MFace *mf = &mface[p2];
+    const int origi = index_mf_to_mpoly ?
+                          DM_origindex_mface_mpoly(index_mf_to_mpoly, index_mp_to_orig, p2) :
+                          p2;
+    RAS_Polygon *poly = (origi != ORIGINDEX_NONE) ? rasMesh->GetPolygon(origi) : nullptr;
 
-            int i1 = poly->GetVertexInfo(0).getSoftBodyIndex();
-            int i2 = poly->GetVertexInfo(1).getSoftBodyIndex();
-            int i3 = poly->GetVertexInfo(2).getSoftBodyIndex();
+    // only add polygons that have the collisionflag set
+    if (poly) {
+      MVert *v1 = &mverts[mf->v1];
+      MVert *v2 = &mverts[mf->v2];
+      MVert *v3 = &mverts[mf->v3];
 
-            MT_Vector3 p1 = ToMoto(nodes.at(i1).m_x - sb->m_pose.m_com);
-            MT_Vector3 p2 = ToMoto(nodes.at(i2).m_x - sb->m_pose.m_com);
-            MT_Vector3 p3 = ToMoto(nodes.at(i3).m_x - sb->m_pose.m_com);
+      int i1 = poly->GetVertexInfo(0).getSoftBodyIndex();
+      int i2 = poly->GetVertexInfo(1).getSoftBodyIndex();
+      int i3 = poly->GetVertexInfo(2).getSoftBodyIndex();
 
-            MT_Vector3 n1 = ToMoto(nodes.at(i1).m_n);
-            MT_Vector3 n2 = ToMoto(nodes.at(i2).m_n);
-            MT_Vector3 n3 = ToMoto(nodes.at(i3).m_n);
+      MT_Vector3 p1 = ToMoto(nodes.at(i1).m_x - sb->m_pose.m_com);
+      MT_Vector3 p2 = ToMoto(nodes.at(i2).m_x - sb->m_pose.m_com);
+      MT_Vector3 p3 = ToMoto(nodes.at(i3).m_x - sb->m_pose.m_com);
 
-            // Do we need obmat? maybe
-            copy_v3_v3(v1->co, p1.getValue());
-            copy_v3_v3(v2->co, p2.getValue());
-            copy_v3_v3(v3->co, p3.getValue());
+      MT_Vector3 n1 = ToMoto(nodes.at(i1).m_n);
+      MT_Vector3 n2 = ToMoto(nodes.at(i2).m_n);
+      MT_Vector3 n3 = ToMoto(nodes.at(i3).m_n);
 
-            normal_float_to_short_v3(v1->no, n1.getValue());
-            normal_float_to_short_v3(v2->no, n2.getValue());
-            normal_float_to_short_v3(v3->no, n3.getValue());
+      // Do we need obmat? maybe
+      copy_v3_v3(v1->co, p1.getValue());
+      copy_v3_v3(v2->co, p2.getValue());
+      copy_v3_v3(v3->co, p3.getValue());
 
-            if (mf->v4) {
-              MVert *v4 = &mverts[mf->v4];
+      normal_float_to_short_v3(v1->no, n1.getValue());
+      normal_float_to_short_v3(v2->no, n2.getValue());
+      normal_float_to_short_v3(v3->no, n3.getValue());
 
-              int i4 = poly->GetVertexInfo(3).getSoftBodyIndex();
+      if (mf->v4) {
+        MVert *v4 = &mverts[mf->v4];
 
-              MT_Vector3 p4 = ToMoto(nodes.at(i4).m_x - sb->m_pose.m_com);
+        int i4 = poly->GetVertexInfo(3).getSoftBodyIndex();
 
-              MT_Vector3 n4 = ToMoto(nodes.at(i4).m_n);
+        MT_Vector3 p4 = ToMoto(nodes.at(i4).m_x - sb->m_pose.m_com);
 
-              copy_v3_v3(v4->co, p4.getValue());
+        MT_Vector3 n4 = ToMoto(nodes.at(i4).m_n);
 
-              normal_float_to_short_v3(v4->no, n4.getValue());
-            }
-          }
-        }
-        DM_to_mesh(dm,
-                   me,
-                   gameobj->GetBlenderObject(),
-                   &CD_MASK_MESH,
-                   true);  // if take_ownership is true, dm is freed
-        DEG_id_tag_update(&me->id, ID_RECALC_GEOMETRY);
+        copy_v3_v3(v4->co, p4.getValue());
+
+        normal_float_to_short_v3(v4->no, n4.getValue());
       }
     }
   }
+  DM_to_mesh(dm,
+             me,
+             gameobj->GetBlenderObject(),
+             &CD_MASK_MESH,
+             true);  // if take_ownership is true, dm is freed
+}
+
+void CcdPhysicsController::UpdateSoftBody()
+{
+  Mesh *me = GetSoftBodyMesh();
+  if (me) {
+    WriteSoftBodyMesh();
+    DEG_id_tag_update(&me->id, ID_RECALC_GEOMETRY);
+  }
 }
 
 void CcdPhysicsController::SetSoftBodyTransform(const MT_Vector3 &pos, const MT_Matrix3x3 &ori)
@@ -957,8 +1346,13 @@ void CcdPhysicsController::PostProcessReplica(class PHY_IMotionState *motionstat
   SetParentRoot((CcdPhysicsController *)parentctrl);
   m_softBodyTransformInitialized = false;
   m_MotionState = motionstate;
+  m_motionStateSynced = false;
   m_registerCount = 0;
+  m_environmentIndex = -1;
+  m_fhIndex = -1;
+  m_softBodyIndex = -1;
   m_collisionShape = nullptr;
+  m_fullShape = nullptr;
 
   // Clear all old constraints.
   m_ccdConstraintRefs.clear();
@@ -1508,6 +1902,10 @@ void CcdPhysicsController::Jump()
 
 void CcdPhysicsController::SetActive(bool active)
 {
+  // The activation of the near and radar sensors is managed by their logic brick.
+  if (m_cci.m_bSensor && m_object) {
+    m_object->forceActivationState(active ? ACTIVE_TAG : ISLAND_SLEEPING);
+  }
 }
 
 float CcdPhysicsController::GetLinearDamping() const
@@ -1552,6 +1950,11 @@ void CcdPhysicsController::SetCcdMotionThreshold(float ccd_motion_threshold)
     return;
 
   body->setCcdMotionThreshold(ccd_motion_threshold);
+  // Keep the thresholds set by the user for the replicas.
+  m_cci.m_ccd = true;
+  m_cci.m_ccd_auto_threshold = false;
+  m_cci.m_ccd_motion_threshold = ccd_motion_threshold;
+  m_cci.m_ccd_swept_sphere_radius = body->getCcdSweptSphereRadius();
 }
 
 void CcdPhysicsController::SetCcdSweptSphereRadius(float ccd_swept_sphere_radius)
@@ -1561,6 +1964,10 @@ void CcdPhysicsController::SetCcdSweptSphereRadius(float ccd_swept_sphere_radius
     return;
 
   body->setCcdSweptSphereRadius(ccd_swept_sphere_radius);
+  m_cci.m_ccd = true;
+  m_cci.m_ccd_auto_threshold = false;
+  m_cci.m_ccd_motion_threshold = body->getCcdMotionThreshold();
+  m_cci.m_ccd_swept_sphere_radius = ccd_swept_sphere_radius;
 }
 
 // reading out information from physics
@@ -1877,7 +2284,8 @@ bool CcdPhysicsController::ReplacePhysicsShape(PHY_IPhysicsController *phyctrl)
                                     PHY_SHAPE_COMPOUND,
                                     PHY_SHAPE_PROXY,
                                     PHY_SHAPE_EMPTY,
-                                    PHY_SHAPE_MESH)) {
+                                    PHY_SHAPE_MESH,
+                                    PHY_SHAPE_CONVEX_DECOMPOSITION)) {
     return false;
   }
 
@@ -1893,6 +2301,71 @@ bool CcdPhysicsController::ReplacePhysicsShape(PHY_IPhysicsController *phyctrl)
   return true;
 }
 
+void CcdPhysicsController::SetSimplifiedShape(bool simplified)
+{
+  if (simplified == (m_fullShape != nullptr)) {
+    return;
+  }
+
+  btRigidBody *body = GetRigidBody();
+  if (!body) {
+    return;
+  }
+
+  // Keep the scaling applied to the current shape.
+  const btVector3 scaling = m_collisionShape->getLocalScaling();
+
+  if (simplified) {
+    if (m_characterController || !IsDynamic() || !m_shapeInfo ||
+        !ELEM(m_shapeInfo->m_shapeType,
+              PHY_SHAPE_MESH,
+              PHY_SHAPE_POLYTOPE,
+              PHY_SHAPE_CONVEX_DECOMPOSITION) ||
+        btFuzzyZero(scaling.x()) || btFuzzyZero(scaling.y()) || btFuzzyZero(scaling.z())) {
+      return;
+    }
+
+    // Bound the full shape in its unscaled space, the box is then scaled as the full shape.
+    btVector3 aabbMin;
+    btVector3 aabbMax;
+    m_collisionShape->getAabb(btTransform::getIdentity(), aabbMin, aabbMax);
+    const btVector3 halfExtents = (aabbMax - aabbMin) * 0.5f / scaling;
+    const btVector3 center = (aabbMax + aabbMin) * 0.5f / scaling;
+
+    btCollisionShape *boxShape = new btBoxShape(halfExtents);
+    boxShape->setMargin(m_cci.m_margin);
+    btCollisionShape *newShape = boxShape;
+    // Mesh bounds are not always centered on the object origin.
+    if (!center.fuzzyZero()) {
+      btCompoundShape *compoundShape = new btCompoundShape();
+      compoundShape->addChildShape(btTransform(btMatrix3x3::getIdentity(), center), boxShape);
+      newShape = compoundShape;
+    }
+    newShape->setLocalScaling(scaling);
+
+    m_fullShape = m_collisionShape;
+    m_savedCcdMotionThreshold = body->getCcdMotionThreshold();
+    body->setCcdMotionThreshold(0.0f);
+
+    m_collisionShape = newShape;
+  }
+  else {
+    DeleteControllerShape();
+
+    m_fullShape->setLocalScaling(scaling);
+    body->setCcdMotionThreshold(m_savedCcdMotionThreshold);
+
+    m_collisionShape = m_fullShape;
+    m_fullShape = nullptr;
+  }
+
+  m_object->setCollisionShape(m_collisionShape);
+  m_cci.m_collisionShape = m_collisionShape;
+
+  // refresh to remove collision pair
+  GetPhysicsEnvironment()->RefreshCcdPhysicsController(this);
+}
+
 void CcdPhysicsController::ReplicateConstraints(KX_GameObject *replica,
                                                 std::vector<KX_GameObject *> constobj)
 {
@@ -1969,6 +2442,8 @@ void DefaultMotionState::CalculateWorldTransformations()
 
 // Shape constructor
 std::map<RAS_MeshObject *, CcdShapeConstructionInfo *> CcdShapeConstructionInfo::m_meshShapeMap;
+/// The scenes converted by the asynchronous libload register and release their shapes too.
+static std::mutex meshShapeMapMutex;
 
 CcdShapeConstructionInfo *CcdShapeConstructionInfo::FindMesh(RAS_MeshObject *mesh,
                                                              struct DerivedMesh *dm,
@@ -1978,10 +2453,12 @@ CcdShapeConstructionInfo *CcdShapeConstructionInfo::FindMesh(RAS_MeshObject *mes
     // not yet supported
     return nullptr;
 
+  std::lock_guard<std::mutex> lock(meshShapeMapMutex);
   std::map<RAS_MeshObject *, CcdShapeConstructionInfo *>::const_iterator mit = m_meshShapeMap.find(
       mesh);
   if (mit != m_meshShapeMap.end())
-    return mit->second;
+    // A shape info released by another thread is not shared anymore.
+    return mit->second->TryAddRef();
   return nullptr;
 }
 
@@ -1992,12 +2469,27 @@ CcdShapeConstructionInfo *CcdShapeConstructionInfo::GetReplica()
   return replica;
 }
 
+size_t CcdShapeConstructionInfo::GetMemorySize() const
+{
+  size_t size = sizeof(CcdShapeConstructionInfo) + m_vertexArray.capacity() * sizeof(btScalar) +
+                m_polygonIndexArray.capacity() * sizeof(int) +
+                m_triFaceArray.capacity() * sizeof(int) +
+                m_triFaceUVcoArray.capacity() * sizeof(UVco) +
+                m_shapeArray.capacity() * sizeof(CcdShapeConstructionInfo *);
+  if (m_triangleIndexVertexArray) {
+    size += sizeof(btTriangleIndexVertexArray);
+  }
+  return size;
+}
+
 void CcdShapeConstructionInfo::ProcessReplica()
 {
   m_userData = nullptr;
   m_meshObject = nullptr;
   m_triangleIndexVertexArray = nullptr;
   m_forceReInstance = false;
+  m_preparedShape = nullptr;
+  m_convexDecomposition = nullptr;
   m_shapeProxy = nullptr;
   m_vertexArray.clear();
   m_polygonIndexArray.clear();
@@ -2009,7 +2501,8 @@ void CcdShapeConstructionInfo::ProcessReplica()
 bool CcdShapeConstructionInfo::SetMesh(class KX_Scene *kxscene,
                                        RAS_MeshObject *meshobj,
                                        DerivedMesh *dm,
-                                       bool polytope)
+                                       bool polytope,
+                                       bool registerMesh)
 {
   int numpolys, numverts;
 
@@ -2312,9 +2805,8 @@ bool CcdShapeConstructionInfo::SetMesh(class KX_Scene *kxscene,
   }
 
   // sharing only on static mesh at present, if you change that, you must also change in FindMesh
-  if (!polytope && !dm) {
-    // triangle shape can be shared, store the mesh object in the map
-    m_meshShapeMap.insert(std::pair<RAS_MeshObject *, CcdShapeConstructionInfo *>(meshobj, this));
+  if (!polytope && !dm && registerMesh) {
+    RegisterMesh();
   }
   return true;
 
@@ -2331,6 +2823,14 @@ cleanup_empty_mesh:
   return false;
 }
 
+void CcdShapeConstructionInfo::RegisterMesh()
+{
+  // triangle shape can be shared, store the mesh object in the map
+  std::lock_guard<std::mutex> lock(meshShapeMapMutex);
+  m_meshShapeMap.insert(
+      std::pair<RAS_MeshObject *, CcdShapeConstructionInfo *>(m_meshObject, this));
+}
+
 /* Updates the arrays used by CreateBulletShape(),
  * take care that recalcLocalAabb() runs after CreateBulletShape is called.
  * */
@@ -2655,14 +3155,23 @@ bool CcdShapeConstructionInfo::UpdateMesh(class KX_GameObject *from_gameobj,
     m_forceReInstance = true;
   }
 
+  // The hulls are built again from the new geometry.
+  if (m_convexDecomposition) {
+    CcdConvexDecomposition::Release(m_convexDecomposition);
+    m_convexDecomposition = nullptr;
+  }
+
   // Make sure to also replace the mesh in the shape map! Otherwise we leave dangling references
   // when we free. Note, this whole business could cause issues with shared meshes. If we update
   // one mesh, do we replace them all?
-  std::map<RAS_MeshObject *, CcdShapeConstructionInfo *>::iterator mit = m_meshShapeMap.find(
-      m_meshObject);
-  if (mit != m_meshShapeMap.end()) {
-    m_meshShapeMap.erase(mit);
-    m_meshShapeMap[meshobj] = this;
+  {
+    std::lock_guard<std::mutex> lock(meshShapeMapMutex);
+    std::map<RAS_MeshObject *, CcdShapeConstructionInfo *>::iterator mit = m_meshShapeMap.find(
+        m_meshObject);
+    if (mit != m_meshShapeMap.end()) {
+      m_meshShapeMap.erase(mit);
+      m_meshShapeMap[meshobj] = this;
+    }
   }
 
   m_meshObject = meshobj;
@@ -2791,9 +3300,21 @@ btCollisionShape *CcdShapeConstructionInfo::CreateBulletShape(btScalar margin,
           m_forceReInstance = false;
         }
 
-        btBvhTriangleMeshShape *unscaledShape = new btBvhTriangleMeshShape(
-            m_triangleIndexVertexArray, true, useBvh);
-        unscaledShape->setMargin(margin);
+        /* The BVH of identical geometries is shared, the welded meshes are using different
+         * vertices and keep their own shape. */
+        btBvhTriangleMeshShape *unscaledShape = nullptr;
+        if (0.0f == m_weldingThreshold1) {
+          unscaledShape = acquire_shared_mesh_shape(m_vertexArray,
+                                                    m_triFaceArray,
+                                                    m_polygonIndexArray.size(),
+                                                    margin,
+                                                    useBvh,
+                                                    m_useBvhCache);
+        }
+        if (!unscaledShape) {
+          unscaledShape = new btBvhTriangleMeshShape(m_triangleIndexVertexArray, true, useBvh);
+          unscaledShape->setMargin(margin);
+        }
         collisionShape = new btScaledBvhTriangleMeshShape(unscaledShape,
                                                           btVector3(1.0f, 1.0f, 1.0f));
         collisionShape->setMargin(margin);
@@ -2817,6 +3338,24 @@ btCollisionShape *CcdShapeConstructionInfo::CreateBulletShape(btScalar margin,
       }
       collisionShape = compoundShape;
       break;
+    case PHY_SHAPE_CONVEX_DECOMPOSITION:
+      if (!m_convexDecomposition) {
+        m_convexDecomposition = CcdConvexDecomposition::Acquire(
+            m_vertexArray, m_triFaceArray, m_polygonIndexArray.size());
+      }
+      if (!m_convexDecomposition || m_convexDecomposition->m_hulls.empty()) {
+        break;
+      }
+
+      compoundShape = new btCompoundShape();
+      for (const std::vector<btScalar> &points : m_convexDecomposition->m_hulls) {
+        collisionShape = new btConvexHullShape(
+            points.data(), points.size() / 3, 3 * sizeof(btScalar));
+        collisionShape->setMargin(margin);
+        compoundShape->addChildShape(btTransform::getIdentity(), collisionShape);
+      }
+      collisionShape = compoundShape;
+      break;
     case PHY_SHAPE_EMPTY:
       collisionShape = new btEmptyShape();
       collisionShape->setMargin(margin);
@@ -2831,6 +3370,25 @@ void CcdShapeConstructionInfo::AddShape(CcdShapeConstructionInfo *shapeInfo)
   shapeInfo->AddRef();
 }
 
+void CcdShapeConstructionInfo::PrepareMeshShape(btScalar margin)
+{
+  // Welded meshes don't use the shared shapes.
+  if (m_shapeType != PHY_SHAPE_MESH || m_preparedShape || 0.0f != m_weldingThreshold1) {
+    return;
+  }
+
+  m_preparedShape = acquire_shared_mesh_shape(
+      m_vertexArray, m_triFaceArray, m_polygonIndexArray.size(), margin, true, m_useBvhCache);
+}
+
+void CcdShapeConstructionInfo::ReleasePreparedShape()
+{
+  if (m_preparedShape) {
+    release_shared_mesh_shape(m_preparedShape);
+    m_preparedShape = nullptr;
+  }
+}
+
 CcdShapeConstructionInfo::~CcdShapeConstructionInfo()
 {
   for (CcdShapeConstructionInfo *shapeInfo : m_shapeArray) {
@@ -2838,10 +3396,17 @@ CcdShapeConstructionInfo::~CcdShapeConstructionInfo()
   }
   m_shapeArray.clear();
 
+  ReleasePreparedShape();
+
+  if (m_convexDecomposition) {
+    CcdConvexDecomposition::Release(m_convexDecomposition);
+  }
+
   if (m_triangleIndexVertexArray)
     delete m_triangleIndexVertexArray;
   m_vertexArray.clear();
   if (m_shapeType == PHY_SHAPE_MESH && m_meshObject != nullptr) {
+    std::lock_guard<std::mutex> lock(meshShapeMapMutex);
     std::map<RAS_MeshObject *, CcdShapeConstructionInfo *>::iterator mit = m_meshShapeMap.find(
         m_meshObject);
     if (mit != m_meshShapeMap.end() && mit->second == this) {
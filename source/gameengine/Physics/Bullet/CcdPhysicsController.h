@@ -67,6 +67,9 @@ class CcdShapeConstructionInfo : public CM_RefCount<CcdShapeConstructionInfo> {
     float uv[2];
   };
 
+  /** Return the shape info shared by the objects of a triangle mesh, with a reference added
+   * for the caller. Can be called from any thread.
+   */
   static CcdShapeConstructionInfo *FindMesh(class RAS_MeshObject *mesh,
                                             struct DerivedMesh *dm,
                                             bool polytope);
@@ -82,6 +85,9 @@ class CcdShapeConstructionInfo : public CM_RefCount<CcdShapeConstructionInfo> {
         m_triangleIndexVertexArray(nullptr),
         m_forceReInstance(false),
         m_weldingThreshold1(0.0f),
+        m_useBvhCache(false),
+        m_preparedShape(nullptr),
+        m_convexDecomposition(nullptr),
         m_shapeProxy(nullptr)
   {
     m_childTrans.setIdentity();
@@ -134,10 +140,17 @@ class CcdShapeConstructionInfo : public CM_RefCount<CcdShapeConstructionInfo> {
     return true;
   }
 
+  /** Fill the shape arrays from a mesh.
+   * \param registerMesh Register a triangle mesh shape info to be shared with FindMesh,
+   * if false RegisterMesh must be called from the main thread once the shape is ready.
+   */
   bool SetMesh(class KX_Scene *kxscene,
                class RAS_MeshObject *mesh,
                struct DerivedMesh *dm,
-               bool polytope);
+               bool polytope,
+               bool registerMesh = true);
+  /// Share this triangle mesh shape info with the other objects using its mesh.
+  void RegisterMesh();
 
   RAS_MeshObject *GetMesh(void)
   {
@@ -150,6 +163,9 @@ class CcdShapeConstructionInfo : public CM_RefCount<CcdShapeConstructionInfo> {
 
   CcdShapeConstructionInfo *GetReplica();
 
+  /// Return the size in bytes of the shape info and of its arrays, the child shapes excluded.
+  size_t GetMemorySize() const;
+
   void ProcessReplica();
 
   bool SetProxy(CcdShapeConstructionInfo *shapeInfo);
@@ -162,6 +178,12 @@ class CcdShapeConstructionInfo : public CM_RefCount<CcdShapeConstructionInfo> {
                                       bool useGimpact = false,
                                       bool useBvh = true);
 
+  /** Build the shared triangle mesh shape and its BVH ahead of CreateBulletShape, to be
+   * called from any thread. The shape is kept alive until ReleasePreparedShape.
+   */
+  void PrepareMeshShape(btScalar margin);
+  void ReleasePreparedShape();
+
   // member variables
   PHY_ShapeType m_shapeType;
   btScalar m_radius;
@@ -190,6 +212,14 @@ class CcdShapeConstructionInfo : public CM_RefCount<CcdShapeConstructionInfo> {
     m_weldingThreshold1 = threshold * threshold;
   }
 
+  /** Load the BVH of the triangle mesh shapes from the disk cache instead of building it,
+   * a new BVH is saved in the cache.
+   */
+  void SetUseBvhCache(bool use)
+  {
+    m_useBvhCache = use;
+  }
+
  protected:
   static std::map<RAS_MeshObject *, CcdShapeConstructionInfo *> m_meshShapeMap;
   /// Keep a pointer to the original mesh
@@ -202,6 +232,12 @@ class CcdShapeConstructionInfo : public CM_RefCount<CcdShapeConstructionInfo> {
   bool m_forceReInstance;
   /// welding closeby vertices together can improve softbody stability etc.
   float m_weldingThreshold1;
+  /// Use the disk cache of BVH for the triangle mesh shapes?
+  bool m_useBvhCache;
+  /// Shared triangle mesh shape built by PrepareMeshShape.
+  btBvhTriangleMeshShape *m_preparedShape;
+  /// Shared convex hulls of a PHY_SHAPE_CONVEX_DECOMPOSITION shape, built on the first shape.
+  class CcdConvexDecomposition *m_convexDecomposition;
   /// only used for PHY_SHAPE_PROXY, pointer to actual shape info
   CcdShapeConstructionInfo *m_shapeProxy;
 };
@@ -290,7 +326,9 @@ struct CcdConstructionInfo {
         m_fh_distance(1.0f),
         m_fh_normal(false),
         m_ccd_motion_threshold(1.0f),
-        m_ccd_swept_sphere_radius(0.9f)
+        m_ccd_swept_sphere_radius(0.9f),
+        m_ccd(false),
+        m_ccd_auto_threshold(false)
   // m_contactProcessingThreshold(1e10f)
   {
   }
@@ -432,6 +470,12 @@ struct CcdConstructionInfo {
   /// Ccd
   btScalar m_ccd_motion_threshold;
   btScalar m_ccd_swept_sphere_radius;
+  /// Enable the continuous collision detection of the rigid body.
+  bool m_ccd;
+  /** Derive the ccd thresholds from the bounds of the scaled collision shape instead of using
+   * m_ccd_motion_threshold and m_ccd_swept_sphere_radius.
+   */
+  bool m_ccd_auto_threshold;
 
   /** m_contactProcessingThreshold allows to process contact points with positive distance
    * normally only contacts with negative distance (penetration) are solved
@@ -589,11 +633,28 @@ class CcdPhysicsController : public PHY_IPhysicsController {
   MT_Scalar m_savedFriction;
   bool m_savedDyna;
   bool m_suspended;
+  /// Full collision shape kept while the controller uses its simplified shape, else nullptr.
+  btCollisionShape *m_fullShape;
+  btScalar m_savedCcdMotionThreshold;
+  /// Body transform last written to the motion state, valid when m_motionStateSynced is true.
+  btTransform m_syncedTransform;
+  bool m_motionStateSynced;
+
+  /// Index of the controller in the controller list of its physics environment, -1 if none.
+  int m_environmentIndex;
+  /// Index of the controller in the Fh spring list of its physics environment, -1 if none.
+  int m_fhIndex;
+  /// Index of the controller in the soft body list of its physics environment, -1 if none.
+  int m_softBodyIndex;
 
   void GetWorldOrientation(btMatrix3x3 &mat);
 
   void CreateRigidbody();
   bool CreateSoftbody();
+  /** Apply the ccd settings of the construction info to the rigid body, the automatic
+   * thresholds are computed from the current collision shape and scaling.
+   */
+  void UpdateCcd();
   bool CreateCharacterController();
 
   bool Register()
@@ -668,7 +729,18 @@ class CcdPhysicsController : public PHY_IPhysicsController {
    */
   virtual bool SynchronizeMotionStates(float time);
 
+  /** Return true when SynchronizeMotionStates() can change the motion state, a static body or
+   * a body of a sleeping island keeps the same transform.
+   */
+  bool NeedSynchronizeMotionStates() const;
+
   virtual void UpdateSoftBody();
+  /// Return the mesh receiving the soft body nodes, nullptr if the soft body doesn't write one.
+  struct Mesh *GetSoftBodyMesh();
+  /** Copy the soft body nodes to its mesh without tagging the mesh for update, the
+   * controllers writing different meshes can be updated from different threads.
+   */
+  void WriteSoftBodyMesh();
   virtual void SetSoftBodyTransform(const MT_Vector3 &pos, const MT_Matrix3x3 &ori);
 
   /**
@@ -880,6 +952,7 @@ class CcdPhysicsController : public PHY_IPhysicsController {
                                       bool evaluatedMesh = false);
 
   virtual bool ReplacePhysicsShape(PHY_IPhysicsController *phyctrl);
+  virtual void SetSimplifiedShape(bool simplified);
 
   /* Method to replicate rigid body joint contraints for group instances. */
   virtual void ReplicateConstraints(KX_GameObject *gameobj, std::vector<KX_GameObject *> constobj);
@@ -21,16 +21,27 @@
 
 #include "CcdPhysicsEnvironment.h"
 
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+
 #include "BKE_object.h"
+#include "BLI_task.h"
+#include "BLI_threads.h"
+#include "DEG_depsgraph.h"
+#include "DNA_mesh_types.h"
 #include "DNA_object_force_types.h"
 #include "DNA_scene_types.h"
 
+#include "BulletCollision/CollisionDispatch/btCollisionDispatcherMt.h"
 #include "BulletCollision/CollisionDispatch/btGhostObject.h"
 #include "BulletCollision/Gimpact/btGImpactCollisionAlgorithm.h"
 #include "BulletCollision/NarrowPhaseCollision/btRaycastCallback.h"
 #include "BulletDynamics/ConstraintSolver/btNNCGConstraintSolver.h"
+#include "BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolverMt.h"
 #include "BulletSoftBody/btSoftBodyRigidBodyCollisionConfiguration.h"
 #include "BulletSoftBody/btSoftRigidDynamicsWorld.h"
+#include "LinearMath/btThreads.h"
 
 #include "BL_BlenderSceneConverter.h"
 #include "CM_List.h"
@@ -42,6 +53,7 @@
 #include "RAS_IVertex.h"
 #include "RAS_MeshObject.h"
 #include "RAS_Polygon.h"
+#include "SCA_ObjectProfiler.h"
 
 #define CCD_CONSTRAINT_DISABLE_LINKED_COLLISION 0x80
 
@@ -102,42 +114,73 @@ class VehicleClosestRayResultCallback : public btCollisionWorld::ClosestRayResul
 
 class BlenderVehicleRaycaster : public btDefaultVehicleRaycaster {
  private:
+  /// Result of a ray cast before the vehicle update.
+  struct CachedRay {
+    btVector3 m_from;
+    btVector3 m_to;
+    btVehicleRaycasterResult m_result;
+    void *m_object;
+  };
+
   btDynamicsWorld *m_dynamicsWorld;
   unsigned short m_mask;
+  std::vector<CachedRay> m_cachedRays;
+  /// Number of cached rays already returned.
+  unsigned int m_numUsedRays;
+  /// The rays cast are stored in the cache.
+  bool m_recording;
+
+  void *CastRayWorld(const btVector3 &from,
+                     const btVector3 &to,
+                     btVehicleRaycasterResult &result);
 
  public:
   BlenderVehicleRaycaster(btDynamicsWorld *world)
       : btDefaultVehicleRaycaster(world),
         m_dynamicsWorld(world),
-        m_mask((1 << OB_MAX_COL_MASKS) - 1)
+        m_mask((1 << OB_MAX_COL_MASKS) - 1),
+        m_numUsedRays(0),
+        m_recording(false)
   {
   }
 
+  /** Store the results of the next rays, they are returned in the same order
+   * by the following casts using the same ray.
+   */
+  void BeginCache()
+  {
+    m_cachedRays.clear();
+    m_numUsedRays = 0;
+    m_recording = true;
+  }
+
+  void EndCache()
+  {
+    m_recording = false;
+  }
+
   virtual void *castRay(const btVector3 &from,
                         const btVector3 &to,
                         btVehicleRaycasterResult &result)
   {
-    //	RayResultCallback& resultCallback;
-
-    VehicleClosestRayResultCallback rayCallback(from, to, m_mask);
-
-    // We override btDefaultVehicleRaycaster so we can set this flag, otherwise our
-    // vehicles go crazy (http://bulletphysics.org/Bullet/phpBB3/viewtopic.php?t=9662)
-    rayCallback.m_flags |= btTriangleRaycastCallback::kF_UseSubSimplexConvexCastRaytest;
-
-    m_dynamicsWorld->rayTest(from, to, rayCallback);
+    if (m_recording) {
+      void *object = CastRayWorld(from, to, result);
+      m_cachedRays.push_back({from, to, result, object});
+      return object;
+    }
 
-    if (rayCallback.hasHit()) {
-      const btRigidBody *body = btRigidBody::upcast(rayCallback.m_collisionObject);
-      if (body && body->hasContactResponse()) {
-        result.m_hitPointInWorld = rayCallback.m_hitPointWorld;
-        result.m_hitNormalInWorld = rayCallback.m_hitNormalWorld;
-        result.m_hitNormalInWorld.normalize();
-        result.m_distFraction = rayCallback.m_closestHitFraction;
-        return (void *)body;
+    if (m_numUsedRays < m_cachedRays.size()) {
+      const CachedRay &ray = m_cachedRays[m_numUsedRays++];
+      if (ray.m_from == from && ray.m_to == to) {
+        result = ray.m_result;
+        return ray.m_object;
       }
+      // The vehicle changed since the cache was filled.
+      m_cachedRays.clear();
+      m_numUsedRays = 0;
     }
-    return nullptr;
+
+    return CastRayWorld(from, to, result);
   }
 
   short GetRayCastMask() const
@@ -151,6 +194,31 @@ class BlenderVehicleRaycaster : public btDefaultVehicleRaycaster {
   }
 };
 
+void *BlenderVehicleRaycaster::CastRayWorld(const btVector3 &from,
+                                            const btVector3 &to,
+                                            btVehicleRaycasterResult &result)
+{
+  VehicleClosestRayResultCallback rayCallback(from, to, m_mask);
+
+  // We override btDefaultVehicleRaycaster so we can set this flag, otherwise our
+  // vehicles go crazy (http://bulletphysics.org/Bullet/phpBB3/viewtopic.php?t=9662)
+  rayCallback.m_flags |= btTriangleRaycastCallback::kF_UseSubSimplexConvexCastRaytest;
+
+  m_dynamicsWorld->rayTest(from, to, rayCallback);
+
+  if (rayCallback.hasHit()) {
+    const btRigidBody *body = btRigidBody::upcast(rayCallback.m_collisionObject);
+    if (body && body->hasContactResponse()) {
+      result.m_hitPointInWorld = rayCallback.m_hitPointWorld;
+      result.m_hitNormalInWorld = rayCallback.m_hitNormalWorld;
+      result.m_hitNormalInWorld.normalize();
+      result.m_distFraction = rayCallback.m_closestHitFraction;
+      return (void *)body;
+    }
+  }
+  return nullptr;
+}
+
 class WrapperVehicle : public PHY_IVehicle {
   btRaycastVehicle *m_vehicle;
   BlenderVehicleRaycaster *m_raycaster;
@@ -204,6 +272,22 @@ class WrapperVehicle : public PHY_IVehicle {
     info.m_clientInfo = motionState;
   }
 
+  /** Cast the rays of the wheels in advance, the vehicle update then uses the cached results.
+   * Only the world and the vehicle are read, the vehicles can cast their rays in parallel.
+   */
+  void CastWheelRays()
+  {
+    m_raycaster->BeginCache();
+    for (unsigned short i = 0, numWheels = GetNumWheels(); i < numWheels; ++i) {
+      btWheelInfo &info = m_vehicle->getWheelInfo(i);
+      // The vehicle update expects the contact of the previous step.
+      const btWheelInfo::RaycastInfo raycastInfo = info.m_raycastInfo;
+      m_vehicle->rayCast(info);
+      info.m_raycastInfo = raycastInfo;
+    }
+    m_raycaster->EndCache();
+  }
+
   void SyncWheels()
   {
     int numWheels = GetNumWheels();
@@ -344,6 +428,43 @@ class WrapperVehicle : public PHY_IVehicle {
   }
 };
 
+static void vehicle_wheel_rays_task(void *__restrict userdata,
+                                    const int iter,
+                                    const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const std::vector<WrapperVehicle *> *vehicles = static_cast<std::vector<WrapperVehicle *> *>(
+      userdata);
+  (*vehicles)[iter]->CastWheelRays();
+}
+
+/** Action updated before all the vehicles of the world, casting the wheel rays of
+ * all the vehicles in parallel. The vehicle actions then only solve their suspension
+ * and friction, which modify the bodies and are kept serial.
+ */
+class CcdVehicleRaysAction : public btActionInterface {
+ private:
+  std::vector<WrapperVehicle *> &m_vehicles;
+
+ public:
+  CcdVehicleRaysAction(std::vector<WrapperVehicle *> &vehicles) : m_vehicles(vehicles)
+  {
+  }
+
+  virtual void updateAction(btCollisionWorld *UNUSED(collisionWorld), btScalar UNUSED(step))
+  {
+    /* The bodies were integrated before the actions, the chassis transforms and the
+     * world used by the rays don't change until all the vehicles are updated. */
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.min_iter_per_thread = 8;
+    BLI_task_parallel_range(0, m_vehicles.size(), &m_vehicles, vehicle_wheel_rays_task, &settings);
+  }
+
+  virtual void debugDraw(btIDebugDraw *UNUSED(debugDrawer))
+  {
+  }
+};
+
 class CcdOverlapFilterCallBack : public btOverlapFilterCallback {
  private:
   class CcdPhysicsEnvironment *m_physEnv;
@@ -366,20 +487,231 @@ void CcdPhysicsEnvironment::SetDebugDrawer(btIDebugDraw *debugDrawer)
   m_debugDrawer = debugDrawer;
 }
 
-CcdPhysicsEnvironment::CcdPhysicsEnvironment(PHY_SolverType solverType, bool useDbvtCulling)
+/** Multithreaded dispatcher which can fallback to a sequential narrow phase, the
+ * soft body collision algorithms are not thread safe.
+ */
+class CcdCollisionDispatcherMt : public btCollisionDispatcherMt {
+ private:
+  bool m_parallel;
+
+ public:
+  CcdCollisionDispatcherMt(btCollisionConfiguration *config)
+      : btCollisionDispatcherMt(config), m_parallel(true)
+  {
+  }
+
+  void DisableParallel()
+  {
+    m_parallel = false;
+  }
+
+  virtual void dispatchAllCollisionPairs(btOverlappingPairCache *pairCache,
+                                         const btDispatcherInfo &info,
+                                         btDispatcher *dispatcher)
+  {
+    if (m_parallel) {
+      btCollisionDispatcherMt::dispatchAllCollisionPairs(pairCache, info, dispatcher);
+    }
+    else {
+      btCollisionDispatcher::dispatchAllCollisionPairs(pairCache, info, dispatcher);
+    }
+  }
+};
+
+/** Narrow phase of a collision pair. The pairs without contact response, as the pairs of the
+ * near and radar sensors, keep their contact points while both objects are sleeping instead of
+ * computing them again each step.
+ */
+static void ccd_near_callback(btBroadphasePair &collisionPair,
+                              btCollisionDispatcher &dispatcher,
+                              const btDispatcherInfo &dispatchInfo)
+{
+  btCollisionObject *colObj0 = (btCollisionObject *)collisionPair.m_pProxy0->m_clientObject;
+  btCollisionObject *colObj1 = (btCollisionObject *)collisionPair.m_pProxy1->m_clientObject;
+
+  if (dispatcher.needsResponse(colObj0, colObj1) ||
+      dispatchInfo.m_dispatchFunc != btDispatcherInfo::DISPATCH_DISCRETE) {
+    btCollisionDispatcher::defaultNearCallback(collisionPair, dispatcher, dispatchInfo);
+    return;
+  }
+
+  // A new pair is always processed once, even between sleeping objects.
+  if (collisionPair.m_algorithm && !colObj0->isActive() && !colObj1->isActive()) {
+    return;
+  }
+  if (!colObj0->checkCollideWith(colObj1) || !colObj1->checkCollideWith(colObj0)) {
+    return;
+  }
+
+  btCollisionObjectWrapper obj0Wrap(
+      nullptr, colObj0->getCollisionShape(), colObj0, colObj0->getWorldTransform(), -1, -1);
+  btCollisionObjectWrapper obj1Wrap(
+      nullptr, colObj1->getCollisionShape(), colObj1, colObj1->getWorldTransform(), -1, -1);
+
+  if (!collisionPair.m_algorithm) {
+    collisionPair.m_algorithm = dispatcher.findAlgorithm(
+        &obj0Wrap, &obj1Wrap, nullptr, BT_CONTACT_POINT_ALGORITHMS);
+  }
+  else {
+    /* Refreshing the contact points fails sometimes when there is penetration
+     * (usually the case with ghost and sensor objects), compute them again. */
+    btManifoldArray manifolds;
+    collisionPair.m_algorithm->getAllContactManifolds(manifolds);
+    for (int i = 0; i < manifolds.size(); ++i) {
+      manifolds[i]->clearManifold();
+    }
+  }
+
+  if (collisionPair.m_algorithm) {
+    btManifoldResult contactPointResult(&obj0Wrap, &obj1Wrap);
+    collisionPair.m_algorithm->processCollision(
+        &obj0Wrap, &obj1Wrap, dispatchInfo, &contactPointResult);
+  }
+}
+
+/** Bullet task scheduler running the parallel loops of the multithreaded
+ * dispatcher and solver in the blender task scheduler.
+ */
+class CcdTaskScheduler : public btITaskScheduler {
+ private:
+  struct LoopData {
+    const btIParallelForBody *forBody;
+    const btIParallelSumBody *sumBody;
+    int begin;
+    int end;
+    int grainSize;
+  };
+
+  static void ForTask(void *__restrict userdata,
+                      const int iter,
+                      const TaskParallelTLS *__restrict UNUSED(tls))
+  {
+    const LoopData *data = static_cast<LoopData *>(userdata);
+    const int begin = data->begin + iter * data->grainSize;
+    data->forBody->forLoop(begin, std::min(begin + data->grainSize, data->end));
+  }
+
+  static void SumTask(void *__restrict userdata,
+                      const int iter,
+                      const TaskParallelTLS *__restrict tls)
+  {
+    const LoopData *data = static_cast<LoopData *>(userdata);
+    const int begin = data->begin + iter * data->grainSize;
+    *static_cast<btScalar *>(tls->userdata_chunk) += data->sumBody->sumLoop(
+        begin, std::min(begin + data->grainSize, data->end));
+  }
+
+  static void SumReduce(const void *__restrict UNUSED(userdata),
+                        void *__restrict chunk_join,
+                        void *__restrict chunk)
+  {
+    *static_cast<btScalar *>(chunk_join) += *static_cast<btScalar *>(chunk);
+  }
+
+  /// Number of grains of a loop range.
+  static int GetNumChunks(int iBegin, int iEnd, int grainSize)
+  {
+    return (iEnd - iBegin + grainSize - 1) / grainSize;
+  }
+
+ public:
+  CcdTaskScheduler() : btITaskScheduler("Blender")
+  {
+  }
+
+  /** The Bullet thread indices are given on first use to any thread running a loop,
+   * the blender worker threads are not known in advance so all the indices are allowed.
+   */
+  virtual int getMaxNumThreads() const
+  {
+    return BT_MAX_THREAD_COUNT;
+  }
+  virtual int getNumThreads() const
+  {
+    return BT_MAX_THREAD_COUNT;
+  }
+  virtual void setNumThreads(int UNUSED(numThreads))
+  {
+  }
+
+  virtual void parallelFor(int iBegin, int iEnd, int grainSize, const btIParallelForBody &body)
+  {
+    grainSize = std::max(grainSize, 1);
+    const int numChunks = GetNumChunks(iBegin, iEnd, grainSize);
+    if (numChunks <= 1) {
+      body.forLoop(iBegin, iEnd);
+      return;
+    }
+
+    LoopData data = {&body, nullptr, iBegin, iEnd, grainSize};
+
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.min_iter_per_thread = 1;
+    BLI_task_parallel_range(0, numChunks, &data, ForTask, &settings);
+  }
+
+  virtual btScalar parallelSum(int iBegin, int iEnd, int grainSize, const btIParallelSumBody &body)
+  {
+    grainSize = std::max(grainSize, 1);
+    const int numChunks = GetNumChunks(iBegin, iEnd, grainSize);
+    if (numChunks <= 1) {
+      return body.sumLoop(iBegin, iEnd);
+    }
+
+    LoopData data = {nullptr, &body, iBegin, iEnd, grainSize};
+    btScalar sum = 0.0f;
+
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.min_iter_per_thread = 1;
+    settings.userdata_chunk = &sum;
+    settings.userdata_chunk_size = sizeof(btScalar);
+    settings.func_reduce = SumReduce;
+    BLI_task_parallel_range(0, numChunks, &data, SumTask, &settings);
+
+    return sum;
+  }
+
+  /** Register the scheduler to Bullet, Bullet requires this call to be done from the
+   * main thread, return false if the scheduler was not and can't be registered.
+   */
+  static bool Register()
+  {
+    static CcdTaskScheduler scheduler;
+    static bool registered = false;
+
+    if (!registered && BLI_thread_is_main()) {
+      btSetTaskScheduler(&scheduler);
+      registered = true;
+    }
+
+    return registered;
+  }
+};
+
+CcdPhysicsEnvironment::CcdPhysicsEnvironment(PHY_SolverType solverType,
+                                             bool useDbvtCulling,
+                                             bool useMultithreading)
     : m_cullingCache(nullptr),
       m_cullingTree(nullptr),
       m_numIterations(10),
       m_numTimeSubSteps(1),
+      m_lastStepTime(0.0f),
       m_solverType(PHY_SOLVER_NONE),
+      m_useMultithreading(useMultithreading),
+      m_useBvhCache(false),
       m_deactivationTime(2.0f),
       m_linearDeactivationThreshold(0.8f),
       m_angularDeactivationThreshold(1.0f),
       m_contactBreakingThreshold(0.02f),
+      m_objectProfiler(nullptr),
+      m_numCollData(0),
       m_solver(nullptr),
       m_ownPairCache(nullptr),
       m_filterCallback(nullptr),
       m_ghostPairCallback(nullptr),
+      m_vehicleRaysAction(nullptr),
       m_ownDispatcher(nullptr)
 {
   for (int i = 0; i < PHY_NUM_RESPONSE; i++) {
@@ -388,8 +720,13 @@ CcdPhysicsEnvironment::CcdPhysicsEnvironment(PHY_SolverType solverType, bool use
 
   m_collisionConfiguration = new btSoftBodyRigidBodyCollisionConfiguration();
 
-  btCollisionDispatcher *dispatcher = new btCollisionDispatcher(m_collisionConfiguration);
+  /* The multithreaded dispatcher processes the narrow phase of the collision pairs
+   * in parallel, it behaves like the default dispatcher otherwise. */
+  btCollisionDispatcher *dispatcher = (m_useMultithreading) ?
+                                          new CcdCollisionDispatcherMt(m_collisionConfiguration) :
+                                          new btCollisionDispatcher(m_collisionConfiguration);
   btGImpactCollisionAlgorithm::registerAlgorithm(dispatcher);
+  dispatcher->setNearCallback(ccd_near_callback);
   m_ownDispatcher = dispatcher;
 
   m_broadphase = new btDbvtBroadphase();
@@ -411,6 +748,9 @@ CcdPhysicsEnvironment::CcdPhysicsEnvironment(PHY_SolverType solverType, bool use
       dispatcher, m_broadphase, m_solver, m_collisionConfiguration);
   m_dynamicsWorld->setInternalTickCallback(&CcdPhysicsEnvironment::StaticSimulationSubtickCallback,
                                            this);
+  // Added first to be updated before all the vehicles.
+  m_vehicleRaysAction = new CcdVehicleRaysAction(m_wrapperVehicles);
+  m_dynamicsWorld->addAction(m_vehicleRaysAction);
   // m_dynamicsWorld->getSolverInfo().m_linearSlop = 0.01f;
   // m_dynamicsWorld->getSolverInfo().m_solverMode=	SOLVER_USE_WARMSTARTING +
   // SOLVER_USE_2_FRICTION_DIRECTIONS +	SOLVER_RANDMIZE_ORDER +	SOLVER_USE_FRICTION_WARMSTARTING;
@@ -419,13 +759,33 @@ CcdPhysicsEnvironment::CcdPhysicsEnvironment(PHY_SolverType solverType, bool use
   SetGravity(0.0f, 0.0f, -9.81f);
 }
 
+void CcdPhysicsEnvironment::DisableParallelCollisions()
+{
+  if (m_useMultithreading) {
+    static_cast<CcdCollisionDispatcherMt *>(m_ownDispatcher)->DisableParallel();
+  }
+}
+
 void CcdPhysicsEnvironment::AddCcdPhysicsController(CcdPhysicsController *ctrl)
 {
   // the controller is already added we do nothing
-  if (!m_controllers.insert(ctrl).second) {
+  if (IsActiveCcdPhysicsController(ctrl)) {
     return;
   }
 
+  ctrl->m_environmentIndex = m_controllers.size();
+  m_controllers.push_back(ctrl);
+
+  const CcdConstructionInfo &ci = ctrl->GetConstructionInfo();
+  if (ci.m_do_fh || ci.m_do_rot_fh) {
+    ctrl->m_fhIndex = m_fhControllers.size();
+    m_fhControllers.push_back(ctrl);
+  }
+  if (ctrl->GetSoftBody()) {
+    ctrl->m_softBodyIndex = m_softBodyControllers.size();
+    m_softBodyControllers.push_back(ctrl);
+  }
+
   btRigidBody *body = ctrl->GetRigidBody();
   btCollisionObject *obj = ctrl->GetCollisionObject();
 
@@ -455,6 +815,7 @@ void CcdPhysicsEnvironment::AddCcdPhysicsController(CcdPhysicsController *ctrl)
   else {
     if (ctrl->GetSoftBody()) {
       btSoftBody *softBody = ctrl->GetSoftBody();
+      DisableParallelCollisions();
       m_dynamicsWorld->addSoftBody(softBody);
     }
     else {
@@ -562,10 +923,32 @@ bool CcdPhysicsEnvironment::RemoveCcdPhysicsController(CcdPhysicsController *ctr
                                                        bool freeConstraints)
 {
   // if the physics controller is already removed we do nothing
-  if (!m_controllers.erase(ctrl)) {
+  if (!IsActiveCcdPhysicsController(ctrl)) {
     return false;
   }
 
+  // Move the last controller at the place of the removed one.
+  CcdPhysicsController *lastCtrl = m_controllers.back();
+  lastCtrl->m_environmentIndex = ctrl->m_environmentIndex;
+  m_controllers[ctrl->m_environmentIndex] = lastCtrl;
+  m_controllers.pop_back();
+  ctrl->m_environmentIndex = -1;
+
+  if (ctrl->m_fhIndex != -1) {
+    CcdPhysicsController *lastFhCtrl = m_fhControllers.back();
+    lastFhCtrl->m_fhIndex = ctrl->m_fhIndex;
+    m_fhControllers[ctrl->m_fhIndex] = lastFhCtrl;
+    m_fhControllers.pop_back();
+    ctrl->m_fhIndex = -1;
+  }
+  if (ctrl->m_softBodyIndex != -1) {
+    CcdPhysicsController *lastSoftBodyCtrl = m_softBodyControllers.back();
+    lastSoftBodyCtrl->m_softBodyIndex = ctrl->m_softBodyIndex;
+    m_softBodyControllers[ctrl->m_softBodyIndex] = lastSoftBodyCtrl;
+    m_softBodyControllers.pop_back();
+    ctrl->m_softBodyIndex = -1;
+  }
+
   // also remove constraint
   btRigidBody *body = ctrl->GetRigidBody();
   if (body) {
@@ -654,7 +1037,8 @@ void CcdPhysicsEnvironment::RefreshCcdPhysicsController(CcdPhysicsController *ct
 
 bool CcdPhysicsEnvironment::IsActiveCcdPhysicsController(CcdPhysicsController *ctrl)
 {
-  return (m_controllers.find(ctrl) != m_controllers.end());
+  const int index = ctrl->m_environmentIndex;
+  return (index != -1 && index < (int)m_controllers.size() && m_controllers[index] == ctrl);
 }
 
 void CcdPhysicsEnvironment::AddCcdGraphicController(CcdGraphicController *ctrl)
@@ -716,25 +1100,50 @@ void CcdPhysicsEnvironment::StaticSimulationSubtickCallback(btDynamicsWorld *wor
 
 void CcdPhysicsEnvironment::SimulationSubtickCallback(btScalar timeStep)
 {
-  std::set<CcdPhysicsController *>::iterator it;
+  for (CcdPhysicsController *ctrl : m_controllers) {
+    ctrl->SimulationTick(timeStep);
+  }
+}
+
+void CcdPhysicsEnvironment::SynchronizeMotionStates(float timeStep)
+{
+  if (m_objectProfiler && m_objectProfiler->GetEnabled()) {
+    for (CcdPhysicsController *ctrl : m_controllers) {
+      if (ctrl->NeedSynchronizeMotionStates()) {
+        const double startTime = SCA_ObjectProfiler::GetTime();
+        ctrl->SynchronizeMotionStates(timeStep);
+        KX_GameObject *gameobj = KX_GameObject::GetClientObject(
+            (KX_ClientObjectInfo *)ctrl->GetNewClientInfo());
+        if (gameobj) {
+          m_objectProfiler->AddTime(gameobj, SCA_ObjectProfiler::CATEGORY_PHYSICS, startTime);
+        }
+      }
+    }
+    return;
+  }
 
-  for (it = m_controllers.begin(); it != m_controllers.end(); it++) {
-    (*it)->SimulationTick(timeStep);
+  for (CcdPhysicsController *ctrl : m_controllers) {
+    // Sleeping and static bodies don't move.
+    if (ctrl->NeedSynchronizeMotionStates()) {
+      ctrl->SynchronizeMotionStates(timeStep);
+    }
   }
 }
 
+void CcdPhysicsEnvironment::SetObjectProfiler(SCA_ObjectProfiler *profiler)
+{
+  m_objectProfiler = profiler;
+}
+
 bool CcdPhysicsEnvironment::ProceedDeltaTime(double curTime, float timeStep, float interval)
 {
-  std::set<CcdPhysicsController *>::iterator it;
   int i;
 
   // Update Bullet global variables.
   gDeactivationTime = m_deactivationTime;
   gContactBreakingThreshold = m_contactBreakingThreshold;
 
-  for (it = m_controllers.begin(); it != m_controllers.end(); it++) {
-    (*it)->SynchronizeMotionStates(timeStep);
-  }
+  SynchronizeMotionStates(timeStep);
 
   float subStep = timeStep / float(m_numTimeSubSteps);
   i = m_dynamicsWorld->stepSimulation(
@@ -742,11 +1151,11 @@ bool CcdPhysicsEnvironment::ProceedDeltaTime(double curTime, float timeStep, flo
   // uncomment next line to see where Bullet spend its time (printf in console)
   // CProfileManager::dumpAll();
 
+  m_lastStepTime = i * subStep;
+
   ProcessFhSprings(curTime, i * subStep);
 
-  for (it = m_controllers.begin(); it != m_controllers.end(); it++) {
-    (*it)->SynchronizeMotionStates(timeStep);
-  }
+  SynchronizeMotionStates(timeStep);
 
   // for (it=m_controllers.begin(); it!=m_controllers.end(); it++)
   //{
@@ -763,12 +1172,76 @@ bool CcdPhysicsEnvironment::ProceedDeltaTime(double curTime, float timeStep, flo
   return true;
 }
 
+void CcdPhysicsEnvironment::InterpolateMotionStates(float factor)
+{
+  // Going back from the last step using the body velocities, as Bullet interpolates.
+  const btScalar backTime = (factor - 1.0f) * m_lastStepTime;
+
+  for (CcdPhysicsController *ctrl : m_controllers) {
+    btRigidBody *body = ctrl->GetRigidBody();
+    if (!body || body->isStaticOrKinematicObject() || !body->isActive()) {
+      continue;
+    }
+
+    btTransform trans;
+    if (factor < 1.0f) {
+      btTransformUtil::integrateTransform(body->getInterpolationWorldTransform(),
+                                          body->getInterpolationLinearVelocity(),
+                                          body->getInterpolationAngularVelocity(),
+                                          backTime,
+                                          trans);
+    }
+    else {
+      // Restore the exact transform of the last step.
+      trans = body->getCenterOfMassTransform();
+    }
+
+    PHY_IMotionState *motionState = ctrl->GetMotionState();
+    motionState->SetWorldOrientation(ToMoto(trans.getBasis()));
+    motionState->SetWorldPosition(ToMoto(trans.getOrigin()));
+    motionState->CalculateWorldTransformations();
+  }
+}
+
+static void write_soft_body_task(void *__restrict userdata,
+                                 const int iter,
+                                 const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const std::vector<CcdPhysicsController *> *controllers =
+      static_cast<std::vector<CcdPhysicsController *> *>(userdata);
+  (*controllers)[iter]->WriteSoftBodyMesh();
+}
+
 void CcdPhysicsEnvironment::UpdateSoftBodies()
 {
-  std::set<CcdPhysicsController *>::iterator it;
+  if (m_softBodyControllers.empty()) {
+    return;
+  }
+
+  /* A mesh shared by several soft bodies receives the nodes of the last one as in
+   * a serial update, the other writes are skipped to not write a mesh twice at once. */
+  std::unordered_map<Mesh *, CcdPhysicsController *> meshWriters;
+  for (CcdPhysicsController *ctrl : m_softBodyControllers) {
+    Mesh *me = ctrl->GetSoftBodyMesh();
+    if (me) {
+      meshWriters[me] = ctrl;
+    }
+  }
 
-  for (it = m_controllers.begin(); it != m_controllers.end(); it++) {
-    (*it)->UpdateSoftBody();
+  std::vector<CcdPhysicsController *> writers;
+  writers.reserve(meshWriters.size());
+  for (const std::pair<Mesh *const, CcdPhysicsController *> &pair : meshWriters) {
+    writers.push_back(pair.second);
+  }
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(0, writers.size(), &writers, write_soft_body_task, &settings);
+
+  // The depsgraph tagging is not thread safe.
+  for (const std::pair<Mesh *const, CcdPhysicsController *> &pair : meshWriters) {
+    DEG_id_tag_update(&pair.first->id, ID_RECALC_GEOMETRY);
   }
 }
 
@@ -800,130 +1273,170 @@ class ClosestRayResultCallbackNotMe : public btCollisionWorld::ClosestRayResultC
   }
 };
 
+/// Result of the ray cast below a body using a Fh spring.
+struct FhSpringHit {
+  /// The hit controller, nullptr if nothing was hit.
+  CcdPhysicsController *m_controller;
+  btScalar m_hitFraction;
+  btVector3 m_hitNormal;
+};
+
+struct FhSpringTaskData {
+  const btDynamicsWorld *world;
+  const std::vector<CcdPhysicsController *> *controllers;
+  /// The ray direction in world space, the ray always points down the z axis.
+  btVector3 rayDir;
+  std::vector<FhSpringHit> *hits;
+};
+
+static void fh_spring_ray_task(void *__restrict userdata,
+                               const int iter,
+                               const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const FhSpringTaskData *data = static_cast<FhSpringTaskData *>(userdata);
+  CcdPhysicsController *ctrl = (*data->controllers)[iter];
+  FhSpringHit &hit = (*data->hits)[iter];
+  hit.m_controller = nullptr;
+
+  btRigidBody *body = ctrl->GetRigidBody();
+  if (!body || body->isStaticOrKinematicObject()) {
+    return;
+  }
+
+  CcdPhysicsController *parentCtrl = ctrl->GetParentRoot();
+  btRigidBody *parentBody = parentCtrl ? parentCtrl->GetRigidBody() : nullptr;
+
+  const btVector3 rayFromWorld = body->getCenterOfMassPosition();
+  const btVector3 rayToWorld = rayFromWorld + data->rayDir;
+
+  // The world is only read, the broadphase uses a local stack with BT_THREADSAFE.
+  ClosestRayResultCallbackNotMe resultCallback(rayFromWorld, rayToWorld, body, parentBody);
+  data->world->rayTest(rayFromWorld, rayToWorld, resultCallback);
+  if (resultCallback.hasHit()) {
+    hit.m_controller = static_cast<CcdPhysicsController *>(
+        resultCallback.m_collisionObject->getUserPointer());
+    hit.m_hitFraction = resultCallback.m_closestHitFraction;
+    hit.m_hitNormal = resultCallback.m_hitNormalWorld;
+  }
+}
+
 void CcdPhysicsEnvironment::ProcessFhSprings(double curTime, float interval)
 {
-  std::set<CcdPhysicsController *>::iterator it;
+  if (m_fhControllers.empty()) {
+    return;
+  }
 
   const float step = interval * KX_GetActiveEngine()->GetTicRate();
 
-  for (it = m_controllers.begin(); it != m_controllers.end(); it++) {
-    CcdPhysicsController *ctrl = (*it);
-    btRigidBody *body = ctrl->GetRigidBody();
+  // re-implement SM_FhObject.cpp using btCollisionWorld::rayTest and info from
+  // ctrl->getConstructionInfo() send a ray from {0.0, 0.0, 0.0} towards {0.0, 0.0, -10.0}, in
+  // local coordinates
+  const btVector3 rayDirLocal(0.0f, 0.0f, -10.0f);
+
+  /* Cast the rays of all the bodies first, the forces only change the velocities
+   * and so don't modify the result of the next rays. */
+  std::vector<FhSpringHit> hits(m_fhControllers.size());
+  FhSpringTaskData data = {m_dynamicsWorld, &m_fhControllers, rayDirLocal, &hits};
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 16;
+  BLI_task_parallel_range(0, m_fhControllers.size(), &data, fh_spring_ray_task, &settings);
+
+  for (unsigned int i = 0, size = m_fhControllers.size(); i < size; ++i) {
+    const FhSpringHit &hit = hits[i];
+    CcdPhysicsController *controller = hit.m_controller;
+    if (!controller) {
+      continue;
+    }
 
-    if (body && (ctrl->GetConstructionInfo().m_do_fh || ctrl->GetConstructionInfo().m_do_rot_fh)) {
-      // re-implement SM_FhObject.cpp using btCollisionWorld::rayTest and info from
-      // ctrl->getConstructionInfo() send a ray from {0.0, 0.0, 0.0} towards {0.0, 0.0, -10.0}, in
-      // local coordinates
-      CcdPhysicsController *parentCtrl = ctrl->GetParentRoot();
-      btRigidBody *parentBody = parentCtrl ? parentCtrl->GetRigidBody() : nullptr;
-      btRigidBody *cl_object = parentBody ? parentBody : body;
+    CcdPhysicsController *ctrl = m_fhControllers[i];
+    CcdPhysicsController *parentCtrl = ctrl->GetParentRoot();
+    btRigidBody *parentBody = parentCtrl ? parentCtrl->GetRigidBody() : nullptr;
+    btRigidBody *cl_object = parentBody ? parentBody : ctrl->GetRigidBody();
 
-      if (body->isStaticOrKinematicObject())
-        continue;
+    if (controller->GetConstructionInfo().m_fh_distance < SIMD_EPSILON)
+      continue;
 
-      btVector3 rayDirLocal(0.0f, 0.0f, -10.0f);
-
-      // m_dynamicsWorld
-      // ctrl->GetRigidBody();
-      btVector3 rayFromWorld = body->getCenterOfMassPosition();
-      // btVector3	rayToWorld = rayFromWorld + body->getCenterOfMassTransform().getBasis() *
-      // rayDirLocal; ray always points down the z axis in world space...
-      btVector3 rayToWorld = rayFromWorld + rayDirLocal;
-
-      ClosestRayResultCallbackNotMe resultCallback(rayFromWorld, rayToWorld, body, parentBody);
-
-      m_dynamicsWorld->rayTest(rayFromWorld, rayToWorld, resultCallback);
-      if (resultCallback.hasHit()) {
-        // we hit this one: resultCallback.m_collisionObject;
-        CcdPhysicsController *controller = static_cast<CcdPhysicsController *>(
-            resultCallback.m_collisionObject->getUserPointer());
-
-        if (controller) {
-          if (controller->GetConstructionInfo().m_fh_distance < SIMD_EPSILON)
-            continue;
-
-          btRigidBody *hit_object = controller->GetRigidBody();
-          if (!hit_object)
-            continue;
-
-          CcdConstructionInfo &hitObjShapeProps = controller->GetConstructionInfo();
-
-          float distance = resultCallback.m_closestHitFraction * rayDirLocal.length() -
-                           ctrl->GetConstructionInfo().m_radius;
-          if (distance >= hitObjShapeProps.m_fh_distance)
-            continue;
-
-          // btVector3 ray_dir = cl_object->getCenterOfMassTransform().getBasis()*
-          // rayDirLocal.normalized();
-          btVector3 ray_dir = rayDirLocal.normalized();
-          btVector3 normal = resultCallback.m_hitNormalWorld;
-          normal.normalize();
-
-          if (ctrl->GetConstructionInfo().m_do_fh) {
-            btVector3 lspot = cl_object->getCenterOfMassPosition() +
-                              rayDirLocal * resultCallback.m_closestHitFraction;
-
-            lspot -= hit_object->getCenterOfMassPosition();
-            btVector3 rel_vel = cl_object->getLinearVelocity() -
-                                hit_object->getVelocityInLocalPoint(lspot);
-            btScalar rel_vel_ray = ray_dir.dot(rel_vel);
-            btScalar spring_extent = 1.0f - distance / hitObjShapeProps.m_fh_distance;
-
-            btScalar i_spring = spring_extent * hitObjShapeProps.m_fh_spring;
-            btScalar i_damp = rel_vel_ray * hitObjShapeProps.m_fh_damping;
-
-            cl_object->setLinearVelocity(cl_object->getLinearVelocity() +
-                                         (-(i_spring + i_damp) * ray_dir) * step);
-            if (hitObjShapeProps.m_fh_normal) {
-              cl_object->setLinearVelocity(cl_object->getLinearVelocity() +
-                                           (i_spring + i_damp) *
-                                               (normal - normal.dot(ray_dir) * ray_dir) * step);
-            }
+    btRigidBody *hit_object = controller->GetRigidBody();
+    if (!hit_object)
+      continue;
 
-            btVector3 lateral = rel_vel - rel_vel_ray * ray_dir;
+    CcdConstructionInfo &hitObjShapeProps = controller->GetConstructionInfo();
 
-            if (ctrl->GetConstructionInfo().m_do_anisotropic) {
-              // Bullet basis contains no scaling/shear etc.
-              const btMatrix3x3 &lcs = cl_object->getCenterOfMassTransform().getBasis();
-              btVector3 loc_lateral = lateral * lcs;
-              const btVector3 &friction_scaling = cl_object->getAnisotropicFriction();
-              loc_lateral *= friction_scaling;
-              lateral = lcs * loc_lateral;
-            }
+    float distance = hit.m_hitFraction * rayDirLocal.length() -
+                     ctrl->GetConstructionInfo().m_radius;
+    if (distance >= hitObjShapeProps.m_fh_distance)
+      continue;
 
-            btScalar rel_vel_lateral = lateral.length();
+    // btVector3 ray_dir = cl_object->getCenterOfMassTransform().getBasis()*
+    // rayDirLocal.normalized();
+    btVector3 ray_dir = rayDirLocal.normalized();
+    btVector3 normal = hit.m_hitNormal;
+    normal.normalize();
+
+    if (ctrl->GetConstructionInfo().m_do_fh) {
+      btVector3 lspot = cl_object->getCenterOfMassPosition() +
+                        rayDirLocal * hit.m_hitFraction;
+
+      lspot -= hit_object->getCenterOfMassPosition();
+      btVector3 rel_vel = cl_object->getLinearVelocity() -
+                          hit_object->getVelocityInLocalPoint(lspot);
+      btScalar rel_vel_ray = ray_dir.dot(rel_vel);
+      btScalar spring_extent = 1.0f - distance / hitObjShapeProps.m_fh_distance;
+
+      btScalar i_spring = spring_extent * hitObjShapeProps.m_fh_spring;
+      btScalar i_damp = rel_vel_ray * hitObjShapeProps.m_fh_damping;
+
+      cl_object->setLinearVelocity(cl_object->getLinearVelocity() +
+                                   (-(i_spring + i_damp) * ray_dir) * step);
+      if (hitObjShapeProps.m_fh_normal) {
+        cl_object->setLinearVelocity(cl_object->getLinearVelocity() +
+                                     (i_spring + i_damp) *
+                                         (normal - normal.dot(ray_dir) * ray_dir) * step);
+      }
 
-            if (rel_vel_lateral > SIMD_EPSILON) {
-              btScalar friction_factor = hit_object->getFriction();  // cl_object->getFriction();
+      btVector3 lateral = rel_vel - rel_vel_ray * ray_dir;
 
-              btScalar max_friction = friction_factor * btMax(btScalar(0.0), i_spring);
+      if (ctrl->GetConstructionInfo().m_do_anisotropic) {
+        // Bullet basis contains no scaling/shear etc.
+        const btMatrix3x3 &lcs = cl_object->getCenterOfMassTransform().getBasis();
+        btVector3 loc_lateral = lateral * lcs;
+        const btVector3 &friction_scaling = cl_object->getAnisotropicFriction();
+        loc_lateral *= friction_scaling;
+        lateral = lcs * loc_lateral;
+      }
 
-              btScalar rel_mom_lateral = rel_vel_lateral / cl_object->getInvMass();
+      btScalar rel_vel_lateral = lateral.length();
 
-              btVector3 friction = (rel_mom_lateral > max_friction) ?
-                                       -lateral * (max_friction / rel_vel_lateral) :
-                                       -lateral;
+      if (rel_vel_lateral > SIMD_EPSILON) {
+        btScalar friction_factor = hit_object->getFriction();  // cl_object->getFriction();
 
-              cl_object->applyCentralImpulse(friction * step);
-            }
-          }
+        btScalar max_friction = friction_factor * btMax(btScalar(0.0), i_spring);
 
-          if (ctrl->GetConstructionInfo().m_do_rot_fh) {
-            btVector3 up2 = cl_object->getWorldTransform().getBasis().getColumn(2);
+        btScalar rel_mom_lateral = rel_vel_lateral / cl_object->getInvMass();
 
-            btVector3 t_spring = up2.cross(normal) * hitObjShapeProps.m_fh_spring;
-            btVector3 ang_vel = cl_object->getAngularVelocity();
+        btVector3 friction = (rel_mom_lateral > max_friction) ?
+                                 -lateral * (max_friction / rel_vel_lateral) :
+                                 -lateral;
 
-            // only rotations that tilt relative to the normal are damped
-            ang_vel -= ang_vel.dot(normal) * normal;
+        cl_object->applyCentralImpulse(friction * step);
+      }
+    }
 
-            btVector3 t_damp = ang_vel * hitObjShapeProps.m_fh_damping;
+    if (ctrl->GetConstructionInfo().m_do_rot_fh) {
+      btVector3 up2 = cl_object->getWorldTransform().getBasis().getColumn(2);
 
-            cl_object->setAngularVelocity(cl_object->getAngularVelocity() +
-                                          (t_spring - t_damp) * step);
-          }
-        }
-      }
+      btVector3 t_spring = up2.cross(normal) * hitObjShapeProps.m_fh_spring;
+      btVector3 ang_vel = cl_object->getAngularVelocity();
+
+      // only rotations that tilt relative to the normal are damped
+      ang_vel -= ang_vel.dot(normal) * normal;
+
+      btVector3 t_damp = ang_vel * hitObjShapeProps.m_fh_damping;
+
+      cl_object->setAngularVelocity(cl_object->getAngularVelocity() +
+                                    (t_spring - t_damp) * step);
     }
   }
 }
@@ -968,12 +1481,11 @@ void CcdPhysicsEnvironment::SetDeactivationAngularTreshold(float angTresh)
   m_angularDeactivationThreshold = angTresh;
 
   // Update from all controllers.
-  for (std::set<CcdPhysicsController *>::iterator it = m_controllers.begin();
-       it != m_controllers.end();
-       it++) {
-    if ((*it)->GetRigidBody())
-      (*it)->GetRigidBody()->setSleepingThresholds(m_linearDeactivationThreshold,
-                                                   m_angularDeactivationThreshold);
+  for (CcdPhysicsController *ctrl : m_controllers) {
+    if (ctrl->GetRigidBody()) {
+      ctrl->GetRigidBody()->setSleepingThresholds(m_linearDeactivationThreshold,
+                                                  m_angularDeactivationThreshold);
+    }
   }
 }
 
@@ -1019,7 +1531,13 @@ void CcdPhysicsEnvironment::SetSolverType(PHY_SolverType solverType)
 
   switch (solverType) {
     case PHY_SOLVER_SEQUENTIAL: {
-      m_solver = new btSequentialImpulseConstraintSolver();
+      if (m_useMultithreading) {
+        // Solve the constraints of large islands in parallel.
+        m_solver = new btSequentialImpulseConstraintSolverMt();
+      }
+      else {
+        m_solver = new btSequentialImpulseConstraintSolver();
+      }
       break;
     }
 
@@ -1980,11 +2498,8 @@ void CcdPhysicsEnvironment::MergeEnvironment(PHY_IPhysicsEnvironment *other_env)
     return;
   }
 
-  std::set<CcdPhysicsController *>::iterator it;
-
-  while (other->m_controllers.begin() != other->m_controllers.end()) {
-    it = other->m_controllers.begin();
-    CcdPhysicsController *ctrl = (*it);
+  while (!other->m_controllers.empty()) {
+    CcdPhysicsController *ctrl = other->m_controllers.back();
 
     other->RemoveCcdPhysicsController(ctrl, true);
     this->AddCcdPhysicsController(ctrl);
@@ -2020,6 +2535,9 @@ CcdPhysicsEnvironment::~CcdPhysicsEnvironment()
   if (nullptr != m_ghostPairCallback)
     delete m_ghostPairCallback;
 
+  if (nullptr != m_vehicleRaysAction)
+    delete m_vehicleRaysAction;
+
   if (nullptr != m_collisionConfiguration)
     delete m_collisionConfiguration;
 
@@ -2088,6 +2606,9 @@ void CcdPhysicsEnvironment::CallbackTriggers()
   if (!m_triggerCallbacks[PHY_OBJECT_RESPONSE] && !draw_contact_points)
     return;
 
+  // The collision data of the previous step were consumed by the callbacks users.
+  m_numCollData = 0;
+
   // walk over all overlapping pairs, and if one of the involved bodies is registered for trigger
   // callback, perform callback
   btDispatcher *dispatcher = m_dynamicsWorld->getDispatcher();
@@ -2126,22 +2647,20 @@ void CcdPhysicsEnvironment::CallbackTriggers()
     }
 
     if (usecallback) {
-      const CcdCollData *coll_data = new CcdCollData(manifold);
+      // Reuse a collision data of the pool, the deque keeps the addresses on growth.
+      if (m_numCollData == m_collDataPool.size()) {
+        m_collDataPool.emplace_back(manifold);
+      }
+      else {
+        m_collDataPool[m_numCollData].SetManifold(manifold);
+      }
+      const CcdCollData *coll_data = &m_collDataPool[m_numCollData++];
 
       m_triggerCallbacks[PHY_OBJECT_RESPONSE](m_triggerCallbacksUserPtrs[PHY_OBJECT_RESPONSE],
                                               colliding_ctrl0 ? ctrl0 : ctrl1,
                                               colliding_ctrl0 ? ctrl1 : ctrl0,
                                               coll_data);
     }
-    // Bullet does not refresh the manifold contact point for object without contact response
-    // may need to remove this when a newer Bullet version is integrated
-    if (!dispatcher->needsResponse(col0, col1)) {
-      // Refresh algorithm fails sometimes when there is penetration
-      // (usuall the case with ghost and sensor objects)
-      // Let's just clear the manifold, in any case, it is recomputed on each frame.
-      manifold
-          ->clearManifold();  // refreshContactPoints(rb0->getCenterOfMassTransform(),rb1->getCenterOfMassTransform());
-    }
   }
 }
 
@@ -2608,6 +3127,44 @@ PHY_IConstraint *CcdPhysicsEnvironment::CreateConstraint(class PHY_IPhysicsContr
   return constraintData;
 }
 
+void CcdPhysicsEnvironment::CreateConstraints(const std::vector<PHY_ConstraintInfo> &infos,
+                                              std::vector<PHY_IConstraint *> &constraints)
+{
+  constraints.resize(infos.size());
+
+  for (unsigned int i = 0, size = infos.size(); i < size; ++i) {
+    const PHY_ConstraintInfo &info = infos[i];
+    if (!info.m_ctrl0) {
+      constraints[i] = nullptr;
+      continue;
+    }
+
+    PHY_IConstraint *constraint = CreateConstraint(info.m_ctrl0,
+                                                   info.m_ctrl1,
+                                                   info.m_type,
+                                                   info.m_pivot.x(),
+                                                   info.m_pivot.y(),
+                                                   info.m_pivot.z(),
+                                                   info.m_axis0.x(),
+                                                   info.m_axis0.y(),
+                                                   info.m_axis0.z(),
+                                                   info.m_axis1.x(),
+                                                   info.m_axis1.y(),
+                                                   info.m_axis1.z(),
+                                                   info.m_axis2.x(),
+                                                   info.m_axis2.y(),
+                                                   info.m_axis2.z(),
+                                                   info.m_flag,
+                                                   false);
+    if (constraint) {
+      for (const PHY_ConstraintInfo::Param &param : info.m_params) {
+        constraint->SetParam(param.m_param, param.m_value0, param.m_value1);
+      }
+    }
+    constraints[i] = constraint;
+  }
+}
+
 PHY_IVehicle *CcdPhysicsEnvironment::CreateVehicle(PHY_IPhysicsController *ctrl)
 {
   const btRaycastVehicle::btVehicleTuning tuning = btRaycastVehicle::btVehicleTuning();
@@ -2699,6 +3256,622 @@ void CcdPhysicsEnvironment::ExportFile(const std::string &filename)
   }
 }
 
+/// Header of a physics state buffer, followed by the state of each element.
+struct CcdStateHeader {
+  unsigned int m_numObjects;
+  unsigned int m_numConstraints;
+  unsigned int m_numVehicles;
+  unsigned int m_numWheels;
+  unsigned int m_numManifolds;
+  float m_lastStepTime;
+};
+
+/* The states are trivially copyable to be copied from and to the buffer, the bullet types
+ * are stored with their serialization data. */
+struct CcdObjectState {
+  /// The object the state belongs to, only used to check that the world didn't change.
+  const btCollisionObject *m_object;
+  btTransformData m_transform;
+  btTransformData m_interpolationTransform;
+  btVector3Data m_interpolationLinearVelocity;
+  btVector3Data m_interpolationAngularVelocity;
+  btVector3Data m_linearVelocity;
+  btVector3Data m_angularVelocity;
+  btScalar m_deactivationTime;
+  int m_activationState;
+};
+
+struct CcdConstraintState {
+  const btTypedConstraint *m_constraint;
+  btScalar m_appliedImpulse;
+  bool m_enabled;
+};
+
+/// State of a vehicle wheel, all the btWheelInfo members except the client info.
+struct CcdWheelState {
+  btVector3Data m_contactNormalWS;
+  btVector3Data m_contactPointWS;
+  btVector3Data m_hardPointWS;
+  btVector3Data m_wheelDirectionWS;
+  btVector3Data m_wheelAxleWS;
+  btScalar m_suspensionLength;
+  bool m_isInContact;
+  void *m_groundObject;
+
+  btTransformData m_worldTransform;
+  btVector3Data m_chassisConnectionPointCS;
+  btVector3Data m_wheelDirectionCS;
+  btVector3Data m_wheelAxleCS;
+  btScalar m_suspensionRestLength1;
+  btScalar m_maxSuspensionTravelCm;
+  btScalar m_wheelsRadius;
+  btScalar m_suspensionStiffness;
+  btScalar m_wheelsDampingCompression;
+  btScalar m_wheelsDampingRelaxation;
+  btScalar m_frictionSlip;
+  btScalar m_steering;
+  btScalar m_rotation;
+  btScalar m_deltaRotation;
+  btScalar m_rollInfluence;
+  btScalar m_maxSuspensionForce;
+  btScalar m_engineForce;
+  btScalar m_brake;
+  bool m_bIsFrontWheel;
+  btScalar m_clippedInvContactDotSuspension;
+  btScalar m_suspensionRelativeVelocity;
+  btScalar m_wheelsSuspensionForce;
+  btScalar m_skidInfo;
+};
+
+/// State of a contact manifold, followed by its contact points.
+struct CcdManifoldState {
+  const btCollisionObject *m_body0;
+  const btCollisionObject *m_body1;
+  int m_numContacts;
+};
+
+/// State of a contact point, all the btManifoldPoint members except the user persistent data.
+struct CcdContactState {
+  btVector3Data m_localPointA;
+  btVector3Data m_localPointB;
+  btVector3Data m_positionWorldOnB;
+  btVector3Data m_positionWorldOnA;
+  btVector3Data m_normalWorldOnB;
+  btVector3Data m_lateralFrictionDir1;
+  btVector3Data m_lateralFrictionDir2;
+  btScalar m_distance1;
+  btScalar m_combinedFriction;
+  btScalar m_combinedRollingFriction;
+  btScalar m_combinedSpinningFriction;
+  btScalar m_combinedRestitution;
+  int m_partId0;
+  int m_partId1;
+  int m_index0;
+  int m_index1;
+  int m_contactPointFlags;
+  btScalar m_appliedImpulse;
+  btScalar m_prevRHS;
+  btScalar m_appliedImpulseLateral1;
+  btScalar m_appliedImpulseLateral2;
+  btScalar m_contactMotion1;
+  btScalar m_contactMotion2;
+  btScalar m_contactCFM;
+  btScalar m_contactERP;
+  btScalar m_frictionCFM;
+  int m_lifeTime;
+};
+
+static CcdWheelState get_wheel_state(const btWheelInfo &wheel)
+{
+  const btWheelInfo::RaycastInfo &raycast = wheel.m_raycastInfo;
+
+  CcdWheelState state;
+  raycast.m_contactNormalWS.serialize(state.m_contactNormalWS);
+  raycast.m_contactPointWS.serialize(state.m_contactPointWS);
+  raycast.m_hardPointWS.serialize(state.m_hardPointWS);
+  raycast.m_wheelDirectionWS.serialize(state.m_wheelDirectionWS);
+  raycast.m_wheelAxleWS.serialize(state.m_wheelAxleWS);
+  state.m_suspensionLength = raycast.m_suspensionLength;
+  state.m_isInContact = raycast.m_isInContact;
+  state.m_groundObject = raycast.m_groundObject;
+
+  wheel.m_worldTransform.serialize(state.m_worldTransform);
+  wheel.m_chassisConnectionPointCS.serialize(state.m_chassisConnectionPointCS);
+  wheel.m_wheelDirectionCS.serialize(state.m_wheelDirectionCS);
+  wheel.m_wheelAxleCS.serialize(state.m_wheelAxleCS);
+  state.m_suspensionRestLength1 = wheel.m_suspensionRestLength1;
+  state.m_maxSuspensionTravelCm = wheel.m_maxSuspensionTravelCm;
+  state.m_wheelsRadius = wheel.m_wheelsRadius;
+  state.m_suspensionStiffness = wheel.m_suspensionStiffness;
+  state.m_wheelsDampingCompression = wheel.m_wheelsDampingCompression;
+  state.m_wheelsDampingRelaxation = wheel.m_wheelsDampingRelaxation;
+  state.m_frictionSlip = wheel.m_frictionSlip;
+  state.m_steering = wheel.m_steering;
+  state.m_rotation = wheel.m_rotation;
+  state.m_deltaRotation = wheel.m_deltaRotation;
+  state.m_rollInfluence = wheel.m_rollInfluence;
+  state.m_maxSuspensionForce = wheel.m_maxSuspensionForce;
+  state.m_engineForce = wheel.m_engineForce;
+  state.m_brake = wheel.m_brake;
+  state.m_bIsFrontWheel = wheel.m_bIsFrontWheel;
+  state.m_clippedInvContactDotSuspension = wheel.m_clippedInvContactDotSuspension;
+  state.m_suspensionRelativeVelocity = wheel.m_suspensionRelativeVelocity;
+  state.m_wheelsSuspensionForce = wheel.m_wheelsSuspensionForce;
+  state.m_skidInfo = wheel.m_skidInfo;
+
+  return state;
+}
+
+static void set_wheel_state(const CcdWheelState &state, btWheelInfo &wheel)
+{
+  btWheelInfo::RaycastInfo &raycast = wheel.m_raycastInfo;
+
+  raycast.m_contactNormalWS.deSerialize(state.m_contactNormalWS);
+  raycast.m_contactPointWS.deSerialize(state.m_contactPointWS);
+  raycast.m_hardPointWS.deSerialize(state.m_hardPointWS);
+  raycast.m_wheelDirectionWS.deSerialize(state.m_wheelDirectionWS);
+  raycast.m_wheelAxleWS.deSerialize(state.m_wheelAxleWS);
+  raycast.m_suspensionLength = state.m_suspensionLength;
+  raycast.m_isInContact = state.m_isInContact;
+  raycast.m_groundObject = state.m_groundObject;
+
+  wheel.m_worldTransform.deSerialize(state.m_worldTransform);
+  wheel.m_chassisConnectionPointCS.deSerialize(state.m_chassisConnectionPointCS);
+  wheel.m_wheelDirectionCS.deSerialize(state.m_wheelDirectionCS);
+  wheel.m_wheelAxleCS.deSerialize(state.m_wheelAxleCS);
+  wheel.m_suspensionRestLength1 = state.m_suspensionRestLength1;
+  wheel.m_maxSuspensionTravelCm = state.m_maxSuspensionTravelCm;
+  wheel.m_wheelsRadius = state.m_wheelsRadius;
+  wheel.m_suspensionStiffness = state.m_suspensionStiffness;
+  wheel.m_wheelsDampingCompression = state.m_wheelsDampingCompression;
+  wheel.m_wheelsDampingRelaxation = state.m_wheelsDampingRelaxation;
+  wheel.m_frictionSlip = state.m_frictionSlip;
+  wheel.m_steering = state.m_steering;
+  wheel.m_rotation = state.m_rotation;
+  wheel.m_deltaRotation = state.m_deltaRotation;
+  wheel.m_rollInfluence = state.m_rollInfluence;
+  wheel.m_maxSuspensionForce = state.m_maxSuspensionForce;
+  wheel.m_engineForce = state.m_engineForce;
+  wheel.m_brake = state.m_brake;
+  wheel.m_bIsFrontWheel = state.m_bIsFrontWheel;
+  wheel.m_clippedInvContactDotSuspension = state.m_clippedInvContactDotSuspension;
+  wheel.m_suspensionRelativeVelocity = state.m_suspensionRelativeVelocity;
+  wheel.m_wheelsSuspensionForce = state.m_wheelsSuspensionForce;
+  wheel.m_skidInfo = state.m_skidInfo;
+}
+
+static CcdContactState get_contact_state(const btManifoldPoint &point)
+{
+  CcdContactState state;
+  point.m_localPointA.serialize(state.m_localPointA);
+  point.m_localPointB.serialize(state.m_localPointB);
+  point.m_positionWorldOnB.serialize(state.m_positionWorldOnB);
+  point.m_positionWorldOnA.serialize(state.m_positionWorldOnA);
+  point.m_normalWorldOnB.serialize(state.m_normalWorldOnB);
+  point.m_lateralFrictionDir1.serialize(state.m_lateralFrictionDir1);
+  point.m_lateralFrictionDir2.serialize(state.m_lateralFrictionDir2);
+  state.m_distance1 = point.m_distance1;
+  state.m_combinedFriction = point.m_combinedFriction;
+  state.m_combinedRollingFriction = point.m_combinedRollingFriction;
+  state.m_combinedSpinningFriction = point.m_combinedSpinningFriction;
+  state.m_combinedRestitution = point.m_combinedRestitution;
+  state.m_partId0 = point.m_partId0;
+  state.m_partId1 = point.m_partId1;
+  state.m_index0 = point.m_index0;
+  state.m_index1 = point.m_index1;
+  state.m_contactPointFlags = point.m_contactPointFlags;
+  state.m_appliedImpulse = point.m_appliedImpulse;
+  state.m_prevRHS = point.m_prevRHS;
+  state.m_appliedImpulseLateral1 = point.m_appliedImpulseLateral1;
+  state.m_appliedImpulseLateral2 = point.m_appliedImpulseLateral2;
+  state.m_contactMotion1 = point.m_contactMotion1;
+  state.m_contactMotion2 = point.m_contactMotion2;
+  state.m_contactCFM = point.m_contactCFM;
+  state.m_contactERP = point.m_contactERP;
+  state.m_frictionCFM = point.m_frictionCFM;
+  state.m_lifeTime = point.m_lifeTime;
+
+  return state;
+}
+
+/// The restored point has no user persistent data, the one of the saved point may be freed.
+static btManifoldPoint get_contact_point(const CcdContactState &state)
+{
+  btManifoldPoint point;
+  point.m_localPointA.deSerialize(state.m_localPointA);
+  point.m_localPointB.deSerialize(state.m_localPointB);
+  point.m_positionWorldOnB.deSerialize(state.m_positionWorldOnB);
+  point.m_positionWorldOnA.deSerialize(state.m_positionWorldOnA);
+  point.m_normalWorldOnB.deSerialize(state.m_normalWorldOnB);
+  point.m_lateralFrictionDir1.deSerialize(state.m_lateralFrictionDir1);
+  point.m_lateralFrictionDir2.deSerialize(state.m_lateralFrictionDir2);
+  point.m_distance1 = state.m_distance1;
+  point.m_combinedFriction = state.m_combinedFriction;
+  point.m_combinedRollingFriction = state.m_combinedRollingFriction;
+  point.m_combinedSpinningFriction = state.m_combinedSpinningFriction;
+  point.m_combinedRestitution = state.m_combinedRestitution;
+  point.m_partId0 = state.m_partId0;
+  point.m_partId1 = state.m_partId1;
+  point.m_index0 = state.m_index0;
+  point.m_index1 = state.m_index1;
+  point.m_contactPointFlags = state.m_contactPointFlags;
+  point.m_appliedImpulse = state.m_appliedImpulse;
+  point.m_prevRHS = state.m_prevRHS;
+  point.m_appliedImpulseLateral1 = state.m_appliedImpulseLateral1;
+  point.m_appliedImpulseLateral2 = state.m_appliedImpulseLateral2;
+  point.m_contactMotion1 = state.m_contactMotion1;
+  point.m_contactMotion2 = state.m_contactMotion2;
+  point.m_contactCFM = state.m_contactCFM;
+  point.m_contactERP = state.m_contactERP;
+  point.m_frictionCFM = state.m_frictionCFM;
+  point.m_lifeTime = state.m_lifeTime;
+
+  return point;
+}
+
+template<class T> static void write_state(std::vector<char> &buffer, const T &state)
+{
+  static_assert(std::is_trivially_copyable<T>::value, "state must be trivially copyable");
+  const char *data = reinterpret_cast<const char *>(&state);
+  buffer.insert(buffer.end(), data, data + sizeof(T));
+}
+
+/// Copy the next state of the buffer, the buffer data may not be aligned for the state type.
+template<class T> static bool read_state(const char *data, size_t size, size_t &offset, T &state)
+{
+  static_assert(std::is_trivially_copyable<T>::value, "state must be trivially copyable");
+  if (offset + sizeof(T) > size) {
+    return false;
+  }
+  memcpy(&state, data + offset, sizeof(T));
+  offset += sizeof(T);
+  return true;
+}
+
+void CcdPhysicsEnvironment::SaveState(std::vector<char> &buffer)
+{
+  btDispatcher *dispatcher = m_dynamicsWorld->getDispatcher();
+  const btCollisionObjectArray &objects = m_dynamicsWorld->getCollisionObjectArray();
+
+  CcdStateHeader header;
+  header.m_numObjects = objects.size();
+  header.m_numConstraints = m_dynamicsWorld->getNumConstraints();
+  header.m_numVehicles = m_wrapperVehicles.size();
+  header.m_numWheels = 0;
+  for (WrapperVehicle *vehicle : m_wrapperVehicles) {
+    header.m_numWheels += vehicle->GetNumWheels();
+  }
+  header.m_numManifolds = dispatcher->getNumManifolds();
+  header.m_lastStepTime = m_lastStepTime;
+
+  buffer.clear();
+  buffer.reserve(sizeof(CcdStateHeader) + header.m_numObjects * sizeof(CcdObjectState) +
+                 header.m_numConstraints * sizeof(CcdConstraintState) +
+                 header.m_numVehicles * sizeof(unsigned int) +
+                 header.m_numWheels * sizeof(CcdWheelState) +
+                 header.m_numManifolds * sizeof(CcdManifoldState));
+
+  write_state(buffer, header);
+
+  for (unsigned int i = 0; i < header.m_numObjects; ++i) {
+    const btCollisionObject *object = objects[i];
+    const btRigidBody *body = btRigidBody::upcast(object);
+
+    CcdObjectState state;
+    state.m_object = object;
+    object->getWorldTransform().serialize(state.m_transform);
+    object->getInterpolationWorldTransform().serialize(state.m_interpolationTransform);
+    object->getInterpolationLinearVelocity().serialize(state.m_interpolationLinearVelocity);
+    object->getInterpolationAngularVelocity().serialize(state.m_interpolationAngularVelocity);
+    (body ? body->getLinearVelocity() : btVector3(0.0f, 0.0f, 0.0f))
+        .serialize(state.m_linearVelocity);
+    (body ? body->getAngularVelocity() : btVector3(0.0f, 0.0f, 0.0f))
+        .serialize(state.m_angularVelocity);
+    state.m_deactivationTime = object->getDeactivationTime();
+    state.m_activationState = object->getActivationState();
+    write_state(buffer, state);
+  }
+
+  for (unsigned int i = 0; i < header.m_numConstraints; ++i) {
+    btTypedConstraint *constraint = m_dynamicsWorld->getConstraint(i);
+    write_state(buffer,
+                CcdConstraintState{constraint,
+                                   constraint->internalGetAppliedImpulse(),
+                                   constraint->isEnabled()});
+  }
+
+  for (WrapperVehicle *vehicle : m_wrapperVehicles) {
+    const unsigned int numWheels = vehicle->GetNumWheels();
+    write_state(buffer, numWheels);
+    for (unsigned int i = 0; i < numWheels; ++i) {
+      write_state(buffer, get_wheel_state(vehicle->GetVehicle()->getWheelInfo(i)));
+    }
+  }
+
+  // The contact points are kept for the warm starting of the contact constraints.
+  for (unsigned int i = 0; i < header.m_numManifolds; ++i) {
+    const btPersistentManifold *manifold = dispatcher->getManifoldByIndexInternal(i);
+
+    const int numContacts = manifold->getNumContacts();
+    write_state(buffer,
+                CcdManifoldState{manifold->getBody0(), manifold->getBody1(), numContacts});
+    for (int j = 0; j < numContacts; ++j) {
+      write_state(buffer, get_contact_state(manifold->getContactPoint(j)));
+    }
+  }
+}
+
+bool CcdPhysicsEnvironment::RestoreState(const char *data, size_t size)
+{
+  btDispatcher *dispatcher = m_dynamicsWorld->getDispatcher();
+  const btCollisionObjectArray &objects = m_dynamicsWorld->getCollisionObjectArray();
+
+  size_t offset = 0;
+  CcdStateHeader header;
+  if (!read_state(data, size, offset, header) ||
+      header.m_numObjects != (unsigned int)objects.size() ||
+      header.m_numConstraints != (unsigned int)m_dynamicsWorld->getNumConstraints() ||
+      header.m_numVehicles != m_wrapperVehicles.size()) {
+    return false;
+  }
+
+  // Check that the state was saved from the same objects before modifying anything.
+  const size_t objectsOffset = offset;
+  for (unsigned int i = 0; i < header.m_numObjects; ++i) {
+    CcdObjectState state;
+    if (!read_state(data, size, offset, state) || state.m_object != objects[i]) {
+      return false;
+    }
+  }
+  for (unsigned int i = 0; i < header.m_numConstraints; ++i) {
+    CcdConstraintState state;
+    if (!read_state(data, size, offset, state) ||
+        state.m_constraint != m_dynamicsWorld->getConstraint(i)) {
+      return false;
+    }
+  }
+  for (WrapperVehicle *vehicle : m_wrapperVehicles) {
+    unsigned int numWheels;
+    if (!read_state(data, size, offset, numWheels) ||
+        numWheels != (unsigned int)vehicle->GetNumWheels()) {
+      return false;
+    }
+    offset += numWheels * sizeof(CcdWheelState);
+  }
+  for (unsigned int i = 0; i < header.m_numManifolds; ++i) {
+    CcdManifoldState state;
+    if (!read_state(data, size, offset, state) || state.m_numContacts < 0 ||
+        state.m_numContacts > MANIFOLD_CACHE_SIZE) {
+      return false;
+    }
+    offset += state.m_numContacts * sizeof(CcdContactState);
+  }
+  if (offset != size) {
+    return false;
+  }
+
+  offset = objectsOffset;
+  for (unsigned int i = 0; i < header.m_numObjects; ++i) {
+    CcdObjectState state;
+    read_state(data, size, offset, state);
+
+    btTransform transform;
+    btTransform interpolationTransform;
+    btVector3 interpolationLinearVelocity;
+    btVector3 interpolationAngularVelocity;
+    transform.deSerialize(state.m_transform);
+    interpolationTransform.deSerialize(state.m_interpolationTransform);
+    interpolationLinearVelocity.deSerialize(state.m_interpolationLinearVelocity);
+    interpolationAngularVelocity.deSerialize(state.m_interpolationAngularVelocity);
+
+    btCollisionObject *object = objects[i];
+    object->setWorldTransform(transform);
+    object->setInterpolationWorldTransform(interpolationTransform);
+    object->setInterpolationLinearVelocity(interpolationLinearVelocity);
+    object->setInterpolationAngularVelocity(interpolationAngularVelocity);
+    object->forceActivationState(state.m_activationState);
+    object->setDeactivationTime(state.m_deactivationTime);
+
+    btRigidBody *body = btRigidBody::upcast(object);
+    if (body) {
+      btVector3 linearVelocity;
+      btVector3 angularVelocity;
+      linearVelocity.deSerialize(state.m_linearVelocity);
+      angularVelocity.deSerialize(state.m_angularVelocity);
+      body->setLinearVelocity(linearVelocity);
+      body->setAngularVelocity(angularVelocity);
+      // The dynamic bodies drive their object, the others are driven by their object.
+      if (!body->isStaticOrKinematicObject() && body->getMotionState()) {
+        body->getMotionState()->setWorldTransform(transform);
+      }
+    }
+  }
+
+  for (unsigned int i = 0; i < header.m_numConstraints; ++i) {
+    CcdConstraintState state;
+    read_state(data, size, offset, state);
+
+    btTypedConstraint *constraint = m_dynamicsWorld->getConstraint(i);
+    constraint->internalSetAppliedImpulse(state.m_appliedImpulse);
+    constraint->setEnabled(state.m_enabled);
+  }
+
+  for (WrapperVehicle *vehicle : m_wrapperVehicles) {
+    unsigned int numWheels;
+    read_state(data, size, offset, numWheels);
+    for (unsigned int i = 0; i < numWheels; ++i) {
+      CcdWheelState state;
+      read_state(data, size, offset, state);
+      set_wheel_state(state, vehicle->GetVehicle()->getWheelInfo(i));
+    }
+  }
+
+  /* Restore the contact points into the manifolds of the same pairs, usually at the same
+   * index. The pairs which didn't exist when the state was saved lose their points. */
+  const int numManifolds = dispatcher->getNumManifolds();
+  for (int i = 0; i < numManifolds; ++i) {
+    dispatcher->getManifoldByIndexInternal(i)->clearManifold();
+  }
+
+  std::unordered_map<const btCollisionObject *, std::vector<btPersistentManifold *>> manifoldMap;
+  for (unsigned int i = 0; i < header.m_numManifolds; ++i) {
+    CcdManifoldState state;
+    read_state(data, size, offset, state);
+
+    btPersistentManifold *manifold = (i < (unsigned int)numManifolds) ?
+                                         dispatcher->getManifoldByIndexInternal(i) :
+                                         nullptr;
+    if (!manifold || manifold->getBody0() != state.m_body0 ||
+        manifold->getBody1() != state.m_body1) {
+      if (manifoldMap.empty()) {
+        for (int j = 0; j < numManifolds; ++j) {
+          btPersistentManifold *other = dispatcher->getManifoldByIndexInternal(j);
+          manifoldMap[other->getBody0()].push_back(other);
+        }
+      }
+
+      manifold = nullptr;
+      for (btPersistentManifold *other : manifoldMap[state.m_body0]) {
+        if (other->getBody1() == state.m_body1) {
+          manifold = other;
+          break;
+        }
+      }
+      if (!manifold) {
+        offset += state.m_numContacts * sizeof(CcdContactState);
+        continue;
+      }
+    }
+
+    for (int j = 0; j < state.m_numContacts; ++j) {
+      CcdContactState point;
+      read_state(data, size, offset, point);
+      manifold->addManifoldPoint(get_contact_point(point));
+    }
+  }
+
+  m_lastStepTime = header.m_lastStepTime;
+  // Move the broadphase proxies to the restored transforms.
+  m_dynamicsWorld->updateAabbs();
+
+  return true;
+}
+
+/// Add the size of a shape info and of its child shapes not yet counted.
+static void add_shape_info_memory(CcdShapeConstructionInfo *shapeInfo,
+                                  std::unordered_set<CcdShapeConstructionInfo *> &shapeInfos,
+                                  size_t &bytes)
+{
+  if (!shapeInfo || !shapeInfos.insert(shapeInfo).second) {
+    return;
+  }
+
+  bytes += shapeInfo->GetMemorySize();
+  for (int i = 0; CcdShapeConstructionInfo *childInfo = shapeInfo->GetChildShape(i); ++i) {
+    add_shape_info_memory(childInfo, shapeInfos, bytes);
+  }
+  add_shape_info_memory(shapeInfo->GetProxy(), shapeInfos, bytes);
+}
+
+/// Add the size of a bullet shape and of its child shapes not yet counted.
+static void add_collision_shape_memory(btCollisionShape *shape,
+                                       std::unordered_set<btCollisionShape *> &shapes,
+                                       size_t &bytes)
+{
+  if (!shape || !shapes.insert(shape).second) {
+    return;
+  }
+
+  switch (shape->getShapeType()) {
+    case TRIANGLE_MESH_SHAPE_PROXYTYPE: {
+      btBvhTriangleMeshShape *meshShape = static_cast<btBvhTriangleMeshShape *>(shape);
+      bytes += sizeof(btBvhTriangleMeshShape);
+      if (meshShape->getOptimizedBvh()) {
+        bytes += sizeof(btOptimizedBvh) +
+                 meshShape->getOptimizedBvh()->calculateSerializeBufferSize();
+      }
+      break;
+    }
+    case SCALED_TRIANGLE_MESH_SHAPE_PROXYTYPE: {
+      btScaledBvhTriangleMeshShape *scaledShape = static_cast<btScaledBvhTriangleMeshShape *>(
+          shape);
+      bytes += sizeof(btScaledBvhTriangleMeshShape);
+      add_collision_shape_memory(scaledShape->getChildShape(), shapes, bytes);
+      break;
+    }
+    case CONVEX_HULL_SHAPE_PROXYTYPE: {
+      btConvexHullShape *hullShape = static_cast<btConvexHullShape *>(shape);
+      bytes += sizeof(btConvexHullShape) + hullShape->getNumPoints() * sizeof(btVector3);
+      break;
+    }
+    case COMPOUND_SHAPE_PROXYTYPE: {
+      btCompoundShape *compoundShape = static_cast<btCompoundShape *>(shape);
+      bytes += sizeof(btCompoundShape) +
+               compoundShape->getNumChildShapes() * sizeof(btCompoundShapeChild);
+      for (int i = 0, size = compoundShape->getNumChildShapes(); i < size; ++i) {
+        add_collision_shape_memory(compoundShape->getChildShape(i), shapes, bytes);
+      }
+      break;
+    }
+    case GIMPACT_SHAPE_PROXYTYPE: {
+      bytes += sizeof(btGImpactMeshShape);
+      break;
+    }
+    default: {
+      // Primitive shapes, only the common data is counted.
+      bytes += sizeof(btConvexInternalShape);
+      break;
+    }
+  }
+}
+
+void CcdPhysicsEnvironment::GetMemoryUsage(size_t &numControllers,
+                                           size_t &controllerBytes,
+                                           size_t &numShapes,
+                                           size_t &shapeBytes)
+{
+  std::unordered_set<CcdShapeConstructionInfo *> shapeInfos;
+  std::unordered_set<btCollisionShape *> shapes;
+
+  numControllers = m_controllers.size();
+  controllerBytes = 0;
+  shapeBytes = 0;
+
+  for (CcdPhysicsController *ctrl : m_controllers) {
+    controllerBytes += sizeof(CcdPhysicsController);
+
+    btSoftBody *softBody = ctrl->GetSoftBody();
+    if (softBody) {
+      controllerBytes += sizeof(btSoftBody) + softBody->m_nodes.size() * sizeof(btSoftBody::Node) +
+                         softBody->m_links.size() * sizeof(btSoftBody::Link) +
+                         softBody->m_faces.size() * sizeof(btSoftBody::Face);
+    }
+    else if (ctrl->GetRigidBody()) {
+      controllerBytes += sizeof(btRigidBody);
+    }
+    else if (ctrl->GetCollisionObject()) {
+      controllerBytes += sizeof(btCollisionObject);
+    }
+
+    add_shape_info_memory(ctrl->GetShapeInfo(), shapeInfos, shapeBytes);
+    add_collision_shape_memory(ctrl->GetCollisionShape(), shapes, shapeBytes);
+  }
+
+  numShapes = shapes.size();
+}
+
+void CcdPhysicsEnvironment::GetStatistics(unsigned int &numControllers, unsigned int &numContacts)
+{
+  numControllers = m_controllers.size();
+  numContacts = 0;
+
+  btDispatcher *dispatcher = m_dynamicsWorld->getDispatcher();
+  const int numManifolds = dispatcher->getNumManifolds();
+  for (int i = 0; i < numManifolds; ++i) {
+    numContacts += dispatcher->getManifoldByIndexInternal(i)->getNumContacts();
+  }
+}
+
 struct BlenderDebugDraw : public btIDebugDraw {
   BlenderDebugDraw() : m_debugMode(0)
   {
@@ -2749,8 +3922,13 @@ CcdPhysicsEnvironment *CcdPhysicsEnvironment::Create(Scene *blenderscene, bool v
       PHY_SOLVER_SEQUENTIAL,  // GAME_SOLVER_SEQUENTIAL
       PHY_SOLVER_NNCG,        // GAME_SOLVER_NNGC
   };
+  // The task scheduler can be registered only from the main thread.
+  const bool useMultithreading = (blenderscene->gm.flag & GAME_USE_MULTITHREADED_PHYSICS) &&
+                                 CcdTaskScheduler::Register();
   CcdPhysicsEnvironment *ccdPhysEnv = new CcdPhysicsEnvironment(
-      solverTypeTable[blenderscene->gm.solverType], false);
+      solverTypeTable[blenderscene->gm.solverType],
+      (blenderscene->gm.flag & GAME_USE_DBVT_CULLING) != 0,
+      useMultithreading);
   ccdPhysEnv->SetDebugDrawer(new BlenderDebugDraw());
   ccdPhysEnv->SetDeactivationLinearTreshold(blenderscene->gm.lineardeactthreshold);
   ccdPhysEnv->SetDeactivationAngularTreshold(blenderscene->gm.angulardeactthreshold);
@@ -2758,6 +3936,7 @@ CcdPhysicsEnvironment *CcdPhysicsEnvironment::Create(Scene *blenderscene, bool v
   ccdPhysEnv->SetERPNonContact(blenderscene->gm.erp);
   ccdPhysEnv->SetERPContact(blenderscene->gm.erp2);
   ccdPhysEnv->SetCFM(blenderscene->gm.cfm);
+  ccdPhysEnv->SetUseBvhCache(blenderscene->gm.flag & GAME_USE_PHYSICS_BVH_CACHE);
 
   if (visualizePhysics)
     ccdPhysEnv->SetDebugMode(btIDebugDraw::DBG_DrawWireframe | btIDebugDraw::DBG_DrawAabb |
@@ -2768,6 +3947,108 @@ CcdPhysicsEnvironment *CcdPhysicsEnvironment::Create(Scene *blenderscene, bool v
   return ccdPhysEnv;
 }
 
+/** Return true if the object uses a static triangle mesh shape in ConvertObject, the
+ * shape of these objects can be shared through the mesh and built before the conversion.
+ */
+static bool use_static_mesh_shape(Object *blenderobject)
+{
+  if (!(blenderobject->gameflag & OB_COLLISION) || blenderobject->type != OB_MESH ||
+      (blenderobject->gameflag & (OB_DYNAMIC | OB_SENSOR | OB_CHARACTER | OB_SOFT_BODY))) {
+    return false;
+  }
+
+  return (!(blenderobject->gameflag & OB_BOUNDS) ||
+          blenderobject->collision_boundtype == OB_BOUND_TRIANGLE_MESH);
+}
+
+struct PrepareShapeTaskData {
+  KX_Scene *kxscene;
+  const std::vector<RAS_MeshObject *> *meshes;
+  const std::vector<float> *margins;
+  std::vector<CcdShapeConstructionInfo *> *shapeInfos;
+};
+
+static void prepare_shape_task(void *__restrict userdata,
+                               const int iter,
+                               const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const PrepareShapeTaskData *data = static_cast<PrepareShapeTaskData *>(userdata);
+  CcdShapeConstructionInfo *shapeInfo = (*data->shapeInfos)[iter];
+
+  // The mesh is registered later from the main thread.
+  if (shapeInfo->SetMesh(data->kxscene, (*data->meshes)[iter], nullptr, false, false)) {
+    shapeInfo->PrepareMeshShape((*data->margins)[iter]);
+  }
+}
+
+void CcdPhysicsEnvironment::PrepareObjectShapes(const std::vector<KX_GameObject *> &objects,
+                                                KX_Scene *kxscene)
+{
+  std::vector<RAS_MeshObject *> meshes;
+  std::vector<float> margins;
+  std::unordered_set<RAS_MeshObject *> usedMeshes;
+  for (KX_GameObject *gameobj : objects) {
+    Object *blenderobject = gameobj->GetBlenderObject();
+    if (!use_static_mesh_shape(blenderobject) || gameobj->GetMeshCount() == 0) {
+      continue;
+    }
+
+    RAS_MeshObject *meshobj = gameobj->GetMesh(0);
+    // The objects sharing a mesh use the shape info of the first one.
+    if (!usedMeshes.insert(meshobj).second) {
+      continue;
+    }
+    CcdShapeConstructionInfo *sharedShapeInfo = CcdShapeConstructionInfo::FindMesh(
+        meshobj, nullptr, false);
+    if (sharedShapeInfo) {
+      sharedShapeInfo->Release();
+      continue;
+    }
+
+    meshes.push_back(meshobj);
+    margins.push_back(blenderobject->margin);
+  }
+
+  if (meshes.empty()) {
+    return;
+  }
+
+  std::vector<CcdShapeConstructionInfo *> shapeInfos(meshes.size());
+  for (CcdShapeConstructionInfo *&shapeInfo : shapeInfos) {
+    shapeInfo = new CcdShapeConstructionInfo();
+    shapeInfo->SetUseBvhCache(m_useBvhCache);
+  }
+
+  PrepareShapeTaskData data = {kxscene, &meshes, &margins, &shapeInfos};
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(0, meshes.size(), &data, prepare_shape_task, &settings);
+
+  // Share the shape infos through their mesh with the objects converted next.
+  for (CcdShapeConstructionInfo *shapeInfo : shapeInfos) {
+    if (shapeInfo->m_shapeType == PHY_SHAPE_MESH) {
+      shapeInfo->RegisterMesh();
+      m_preparedShapeInfos.push_back(shapeInfo);
+    }
+    else {
+      shapeInfo->Release();
+    }
+  }
+}
+
+void CcdPhysicsEnvironment::ReleasePreparedShapes()
+{
+  for (CcdShapeConstructionInfo *shapeInfo : m_preparedShapeInfos) {
+    /* The converted objects own their shapes now, releasing the prepared shape and shape info
+     * frees only the ones no object used. */
+    shapeInfo->ReleasePreparedShape();
+    shapeInfo->Release();
+  }
+  m_preparedShapeInfos.clear();
+}
+
 void CcdPhysicsEnvironment::ConvertObject(BL_BlenderSceneConverter *converter,
                                           KX_GameObject *gameobj,
                                           RAS_MeshObject *meshobj,
@@ -2858,6 +4139,9 @@ void CcdPhysicsEnvironment::ConvertObject(BL_BlenderSceneConverter *converter,
   ci.m_ccd_swept_sphere_radius = (isbulletdyna || isbulletrigidbody) ?
                                      blenderobject->ccd_swept_sphere_radius :
                                      0.0;
+  ci.m_ccd = (isbulletdyna || isbulletrigidbody) &&
+             (blenderobject->gameflag2 & OB_CCD_RIGID_BODY);
+  ci.m_ccd_auto_threshold = ci.m_ccd && (blenderobject->gameflag2 & OB_CCD_AUTO_THRESHOLD);
 
   // mmm, for now, take this for the size of the dynamicobject
   // Blender uses inertia for radius of dynamic object
@@ -2972,9 +4256,13 @@ void CcdPhysicsEnvironment::ConvertObject(BL_BlenderSceneConverter *converter,
       bounds = OB_BOUND_SPHERE;
   }
   else {
-    if (ELEM(blenderobject->collision_boundtype, OB_BOUND_CONVEX_HULL, OB_BOUND_TRIANGLE_MESH) &&
+    if (ELEM(blenderobject->collision_boundtype,
+             OB_BOUND_CONVEX_HULL,
+             OB_BOUND_TRIANGLE_MESH,
+             OB_BOUND_CONVEX_DECOMPOSITION) &&
         blenderobject->type != OB_MESH) {
-      // Can't use triangle mesh or convex hull on a non-mesh object, fall-back to sphere
+      /* Can't use triangle mesh, convex hull or convex decomposition on a non-mesh object,
+       * fall-back to sphere */
       bounds = OB_BOUND_SPHERE;
     }
     else
@@ -3034,6 +4322,14 @@ void CcdPhysicsEnvironment::ConvertObject(BL_BlenderSceneConverter *converter,
       bm = shapeInfo->CreateBulletShape(ci.m_margin);
       break;
     }
+    case OB_BOUND_CONVEX_DECOMPOSITION: {
+      // The shape info isn't registered, FindMesh only shares the triangle mesh shapes.
+      if (shapeInfo->SetMesh(kxscene, meshobj, dm, false, false)) {
+        shapeInfo->m_shapeType = PHY_SHAPE_CONVEX_DECOMPOSITION;
+      }
+      bm = shapeInfo->CreateBulletShape(ci.m_margin);
+      break;
+    }
     case OB_BOUND_CAPSULE: {
       shapeInfo->m_radius = MT_max(bounds_extends[0], bounds_extends[1]);
       shapeInfo->m_height = 2.0f * (bounds_extends[2] - shapeInfo->m_radius);
@@ -3048,9 +4344,9 @@ void CcdPhysicsEnvironment::ConvertObject(BL_BlenderSceneConverter *converter,
       class CcdShapeConstructionInfo *sharedShapeInfo = CcdShapeConstructionInfo::FindMesh(
           meshobj, dm, false);
       if (sharedShapeInfo != nullptr) {
+        // The found shape info is already referenced for this object.
         shapeInfo->Release();
         shapeInfo = sharedShapeInfo;
-        shapeInfo->AddRef();
       }
       else {
         shapeInfo->SetMesh(kxscene, meshobj, dm, false);
@@ -3065,6 +4361,7 @@ void CcdPhysicsEnvironment::ConvertObject(BL_BlenderSceneConverter *converter,
         shapeInfo->setVertexWeldingThreshold1(0.0f);  // todo: expose this to the UI
       }
 
+      shapeInfo->SetUseBvhCache(m_useBvhCache);
       bm = shapeInfo->CreateBulletShape(ci.m_margin, useGimpact, !isbulletsoftbody);
       // should we compute inertia for dynamic shape?
       // bm->calculateLocalInertia(ci.m_mass,ci.m_localInertiaTensor);
@@ -3245,11 +4542,6 @@ void CcdPhysicsEnvironment::ConvertObject(BL_BlenderSceneConverter *converter,
       if (rbody && (blenderobject->gameflag & OB_COLLISION_RESPONSE) != 0) {
         rbody->setActivationState(DISABLE_DEACTIVATION);
       }
-
-      if (blenderobject->gameflag2 & OB_CCD_RIGID_BODY) {
-        rbody->setCcdMotionThreshold(ci.m_ccd_motion_threshold);
-        rbody->setCcdSweptSphereRadius(ci.m_ccd_swept_sphere_radius);
-      }
     }
   }
 
@@ -3362,6 +4654,11 @@ CcdCollData::~CcdCollData()
 {
 }
 
+void CcdCollData::SetManifold(const btPersistentManifold *manifoldPoint)
+{
+  m_manifoldPoint = manifoldPoint;
+}
+
 unsigned int CcdCollData::GetNumContacts() const
 {
   return m_manifoldPoint->getNumContacts();
@@ -23,6 +23,7 @@
 
 #pragma once
 
+#include <deque>
 #include <map>
 #include <set>
 #include <vector>
@@ -50,6 +51,26 @@ class CcdGraphicController;
 class CcdOverlapFilterCallBack;
 class CcdShapeConstructionInfo;
 
+class CcdCollData : public PHY_CollData {
+  const btPersistentManifold *m_manifoldPoint;
+
+ public:
+  CcdCollData(const btPersistentManifold *manifoldPoint);
+  virtual ~CcdCollData();
+
+  void SetManifold(const btPersistentManifold *manifoldPoint);
+
+  virtual unsigned int GetNumContacts() const;
+  virtual MT_Vector3 GetLocalPointA(unsigned int index, bool first) const;
+  virtual MT_Vector3 GetLocalPointB(unsigned int index, bool first) const;
+  virtual MT_Vector3 GetWorldPoint(unsigned int index, bool first) const;
+  virtual MT_Vector3 GetNormal(unsigned int index, bool first) const;
+  virtual float GetCombinedFriction(unsigned int index, bool first) const;
+  virtual float GetCombinedRollingFriction(unsigned int index, bool first) const;
+  virtual float GetCombinedRestitution(unsigned int index, bool first) const;
+  virtual float GetAppliedImpulse(unsigned int index, bool first) const;
+};
+
 /** CcdPhysicsEnvironment is an experimental mainloop for physics simulation using optional
  * continuous collision detection. Physics Environment takes care of stepping the simulation and is
  * a container for physics entities. It stores rigidbodies,constraints, materials etc. A derived
@@ -85,17 +106,37 @@ class CcdPhysicsEnvironment : public PHY_IPhysicsEnvironment {
   /// timestep subdivisions
   int m_numTimeSubSteps;
 
+  /// Simulated time of the last ProceedDeltaTime, used to interpolate the motion states.
+  float m_lastStepTime;
+
   PHY_SolverType m_solverType;
 
+  /// Use the multithreaded collision dispatcher and constraint solver?
+  bool m_useMultithreading;
+
+  /// Load and save the BVH of the static triangle mesh shapes from the disk cache?
+  bool m_useBvhCache;
+
+  /// Shape infos built by PrepareObjectShapes.
+  std::vector<CcdShapeConstructionInfo *> m_preparedShapeInfos;
+
   float m_deactivationTime;
   float m_linearDeactivationThreshold;
   float m_angularDeactivationThreshold;
   float m_contactBreakingThreshold;
 
+  /// Profiler of the scene logic, used to measure the motion state synchronization.
+  SCA_ObjectProfiler *m_objectProfiler;
+
   void ProcessFhSprings(double curTime, float timeStep);
+  /// Update the motion states of the moving controllers from the physics.
+  void SynchronizeMotionStates(float timeStep);
+
+  /// Process the narrow phase sequentially, used once soft bodies are added.
+  void DisableParallelCollisions();
 
  public:
-  CcdPhysicsEnvironment(PHY_SolverType solverType, bool useDbvtCulling);
+  CcdPhysicsEnvironment(PHY_SolverType solverType, bool useDbvtCulling, bool useMultithreading);
 
   virtual ~CcdPhysicsEnvironment();
 
@@ -118,6 +159,11 @@ class CcdPhysicsEnvironment : public PHY_IPhysicsEnvironment {
   virtual void SetERPNonContact(float erp);
   virtual void SetERPContact(float erp2);
   virtual void SetCFM(float cfm);
+
+  void SetUseBvhCache(bool use)
+  {
+    m_useBvhCache = use;
+  }
   virtual void SetContactBreakingTreshold(float contactBreakingTreshold);
   virtual void SetSolverType(PHY_SolverType solverType);
   virtual void SetSolverSorConstant(float sor);
@@ -133,6 +179,8 @@ class CcdPhysicsEnvironment : public PHY_IPhysicsEnvironment {
   virtual bool ProceedDeltaTime(double curTime, float timeStep, float interval);
 
   virtual void UpdateSoftBodies();
+  virtual void InterpolateMotionStates(float factor);
+  virtual void SetObjectProfiler(SCA_ObjectProfiler *profiler);
 
   /**
    * Called by Bullet for every physical simulation (sub)tick.
@@ -178,6 +226,8 @@ class CcdPhysicsEnvironment : public PHY_IPhysicsEnvironment {
                                             float axis2Z = 0,
                                             int flag = 0,
                                             bool replicate_dupli = false);
+  virtual void CreateConstraints(const std::vector<PHY_ConstraintInfo> &infos,
+                                 std::vector<PHY_IConstraint *> &constraints);
   virtual PHY_IVehicle *CreateVehicle(PHY_IPhysicsController *ctrl);
 
   virtual void RemoveConstraintById(int constraintid, bool free);
@@ -282,6 +332,9 @@ class CcdPhysicsEnvironment : public PHY_IPhysicsEnvironment {
 
   static CcdPhysicsEnvironment *Create(struct Scene *blenderscene, bool visualizePhysics);
 
+  virtual void PrepareObjectShapes(const std::vector<KX_GameObject *> &objects, KX_Scene *kxscene);
+  virtual void ReleasePreparedShapes();
+
   virtual void ConvertObject(BL_BlenderSceneConverter *converter,
                              KX_GameObject *gameobj,
                              RAS_MeshObject *meshobj,
@@ -300,13 +353,25 @@ class CcdPhysicsEnvironment : public PHY_IPhysicsEnvironment {
                                       bool replicate_dupli);
 
  protected:
-  std::set<CcdPhysicsController *> m_controllers;
+  /// All the controllers, a controller stores its index to be removed in constant time.
+  std::vector<CcdPhysicsController *> m_controllers;
+  /// The controllers using a Fh spring or a rotation Fh spring, stored the same way.
+  std::vector<CcdPhysicsController *> m_fhControllers;
+  /// The soft body controllers, stored the same way.
+  std::vector<CcdPhysicsController *> m_softBodyControllers;
 
   PHY_ResponseCallback m_triggerCallbacks[PHY_NUM_RESPONSE];
   void *m_triggerCallbacksUserPtrs[PHY_NUM_RESPONSE];
 
   std::vector<WrapperVehicle *> m_wrapperVehicles;
 
+  /** Collision data given to the response callbacks, the elements are reused each step
+   * and stay valid until the next call to CallbackTriggers().
+   */
+  std::deque<CcdCollData> m_collDataPool;
+  /// Number of used elements in m_collDataPool.
+  unsigned int m_numCollData;
+
   /** use explicit btSoftRigidDynamicsWorld/btDiscreteDynamicsWorld* so that we have access to
    * btDiscreteDynamicsWorld::addRigidBody(body,filter,group)
    * so that we can set the body collision filter/group at the time of creation
@@ -324,25 +389,19 @@ class CcdPhysicsEnvironment : public PHY_IPhysicsEnvironment {
 
   class btGhostPairCallback *m_ghostPairCallback;
 
+  /// Action casting the wheel rays of all the vehicles in parallel.
+  class btActionInterface *m_vehicleRaysAction;
+
   class btDispatcher *m_ownDispatcher;
 
   virtual void ExportFile(const std::string &filename);
-};
-
-class CcdCollData : public PHY_CollData {
-  const btPersistentManifold *m_manifoldPoint;
 
- public:
-  CcdCollData(const btPersistentManifold *manifoldPoint);
-  virtual ~CcdCollData();
+  virtual void SaveState(std::vector<char> &buffer);
+  virtual bool RestoreState(const char *data, size_t size);
 
-  virtual unsigned int GetNumContacts() const;
-  virtual MT_Vector3 GetLocalPointA(unsigned int index, bool first) const;
-  virtual MT_Vector3 GetLocalPointB(unsigned int index, bool first) const;
-  virtual MT_Vector3 GetWorldPoint(unsigned int index, bool first) const;
-  virtual MT_Vector3 GetNormal(unsigned int index, bool first) const;
-  virtual float GetCombinedFriction(unsigned int index, bool first) const;
-  virtual float GetCombinedRollingFriction(unsigned int index, bool first) const;
-  virtual float GetCombinedRestitution(unsigned int index, bool first) const;
-  virtual float GetAppliedImpulse(unsigned int index, bool first) const;
+  virtual void GetMemoryUsage(size_t &numControllers,
+                              size_t &controllerBytes,
+                              size_t &numShapes,
+                              size_t &shapeBytes);
+  virtual void GetStatistics(unsigned int &numControllers, unsigned int &numContacts);
 };
@@ -100,7 +100,9 @@ typedef enum PHY_ShapeType {
   PHY_SHAPE_POLYTOPE,
   PHY_SHAPE_COMPOUND,
   PHY_SHAPE_EMPTY,
-  PHY_SHAPE_PROXY
+  PHY_SHAPE_PROXY,
+  /// Compound of the convex hulls approximating a concave triangle mesh.
+  PHY_SHAPE_CONVEX_DECOMPOSITION
 } PHY_ShapeType;
 
 typedef enum PHY_SolverType {
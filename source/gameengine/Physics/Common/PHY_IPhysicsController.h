@@ -160,6 +160,10 @@ class PHY_IPhysicsController : public PHY_IController {
                                       bool evaluatedMesh = false) = 0;
 
   virtual bool ReplacePhysicsShape(PHY_IPhysicsController *phyctrl) = 0;
+  /** Replace the collision shape by its bounding box and disable the continuous collision
+   * detection, or restore them. Only dynamic bodies using a mesh or convex hull are simplified.
+   */
+  virtual void SetSimplifiedShape(bool simplified) = 0;
 
   /* Method to replicate rigid body joint contraints for group instances. */
   virtual void ReplicateConstraints(KX_GameObject *gameobj,
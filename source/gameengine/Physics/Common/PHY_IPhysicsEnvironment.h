@@ -38,6 +38,7 @@
 #include "PHY_DynamicTypes.h"
 
 #include <array>
+#include <vector>
 
 class PHY_IConstraint;
 class PHY_IVehicle;
@@ -50,6 +51,7 @@ struct DerivedMesh;
 class KX_GameObject;
 class KX_Scene;
 class BL_BlenderSceneConverter;
+class SCA_ObjectProfiler;
 
 class PHY_IMotionState;
 struct bRigidBodyJointConstraint;
@@ -67,6 +69,28 @@ struct PHY_RayCastResult {
   MT_Vector2 m_hitUV;  // UV coordinates of hit point
 };
 
+/// Description of a constraint built by PHY_IPhysicsEnvironment::CreateConstraints.
+struct PHY_ConstraintInfo {
+  /// Parameter set with PHY_IConstraint::SetParam once the constraint is created.
+  struct Param {
+    int m_param;
+    float m_value0;
+    float m_value1;
+  };
+
+  PHY_IPhysicsController *m_ctrl0;
+  PHY_IPhysicsController *m_ctrl1;
+  PHY_ConstraintType m_type;
+  /// Pivot and axes of the constraint frame in the space of the first controller.
+  MT_Vector3 m_pivot;
+  MT_Vector3 m_axis0;
+  MT_Vector3 m_axis1;
+  MT_Vector3 m_axis2;
+  int m_flag;
+  /// Limits and motors of the constraint.
+  std::vector<Param> m_params;
+};
+
 /**
  * This class replaces the ignoreController parameter of rayTest function.
  * It allows more sophisticated filtering on the physics controller before computing the ray
@@ -112,6 +136,15 @@ class PHY_IPhysicsEnvironment {
   virtual bool ProceedDeltaTime(double curTime, float timeStep, float interval) = 0;
 
   virtual void UpdateSoftBodies() = 0;
+  /** Set the motion states of the moving bodies between the last two physics steps, used to
+   * render at a higher rate than the physics.
+   * \param factor The interpolation factor, 0 for the previous step and 1 for the last step.
+   */
+  virtual void InterpolateMotionStates(float factor) = 0;
+  /// Set the profiler measuring the synchronization of the motion states of each object.
+  virtual void SetObjectProfiler(SCA_ObjectProfiler *profiler)
+  {
+  }
 
   /// draw debug lines (make sure to call this during the render phase, otherwise lines are not
   /// drawn properly)
@@ -210,6 +243,15 @@ class PHY_IPhysicsEnvironment {
                                             float axis2Z = 0,
                                             int flag = 0,
                                             bool replicate_dupli = false) = 0;
+  /** Create the constraints of a ragdoll or a chain in one pass and set their parameters.
+   * \param constraints Receive the created constraints in the order of the infos, nullptr for
+   * the infos not making a constraint like the soft body anchors.
+   */
+  virtual void CreateConstraints(const std::vector<PHY_ConstraintInfo> &infos,
+                                 std::vector<PHY_IConstraint *> &constraints)
+  {
+    constraints.assign(infos.size(), nullptr);
+  }
   virtual PHY_IVehicle *CreateVehicle(PHY_IPhysicsController *ctrl) = 0;
   virtual void RemoveConstraintById(int constraintid, bool free) = 0;
   virtual float GetAppliedImpulse(int constraintid)
@@ -257,8 +299,52 @@ class PHY_IPhysicsEnvironment {
 
   virtual void ExportFile(const std::string &filename){};
 
+  /** Save the state of the simulation: the transforms, the velocities and the activation of
+   * the objects, the constraint impulses and the contact points. The buffer is meant to be
+   * restored by RestoreState in the same environment, it is reused when the capacity allows.
+   */
+  virtual void SaveState(std::vector<char> &buffer)
+  {
+    buffer.clear();
+  }
+  /** Restore a state saved by SaveState.
+   * \return False if the objects or constraints changed since the state was saved.
+   */
+  virtual bool RestoreState(const char *data, size_t size)
+  {
+    return false;
+  }
+
+  /** Get the count and the size in bytes of the physics controllers and of their shapes,
+   * the shapes shared by several controllers are counted once.
+   */
+  virtual void GetMemoryUsage(size_t &numControllers,
+                              size_t &controllerBytes,
+                              size_t &numShapes,
+                              size_t &shapeBytes)
+  {
+    numControllers = controllerBytes = numShapes = shapeBytes = 0;
+  }
+
+  /// Get the number of physics controllers and the number of contact points of the last step.
+  virtual void GetStatistics(unsigned int &numControllers, unsigned int &numContacts)
+  {
+    numControllers = numContacts = 0;
+  }
+
   virtual void MergeEnvironment(PHY_IPhysicsEnvironment *other_env) = 0;
 
+  /** Build in parallel the shapes of the meshes used by objects about to be converted with
+   * ConvertObject. The prepared shapes are kept until ReleasePreparedShapes.
+   */
+  virtual void PrepareObjectShapes(const std::vector<KX_GameObject *> &objects, KX_Scene *kxscene)
+  {
+  }
+  /// Release the shapes of PrepareObjectShapes not used by the converted objects.
+  virtual void ReleasePreparedShapes()
+  {
+  }
+
   virtual void ConvertObject(BL_BlenderSceneConverter *converter,
                              KX_GameObject *gameobj,
                              RAS_MeshObject *meshobj,
@@ -56,6 +56,10 @@ void DummyPhysicsEnvironment::UpdateSoftBodies()
 {
 }
 
+void DummyPhysicsEnvironment::InterpolateMotionStates(float factor)
+{
+}
+
 void DummyPhysicsEnvironment::SetFixedTimeStep(bool useFixedTimeStep, float fixedTimeStep)
 {
 }
@@ -22,6 +22,8 @@
 
 #include "RAS_2DFilter.h"
 
+#include <algorithm>
+
 #include "DRW_render.h"
 
 #include "GPU_immediate.h"
@@ -48,7 +50,8 @@ RAS_2DFilter::RAS_2DFilter(RAS_2DFilterData &data)
     : m_properties(data.propertyNames),
       m_gameObject(data.gameObject),
       m_uniformInitialized(false),
-      m_mipmap(data.mipmap)
+      m_mipmap(data.mipmap),
+      m_resolutionScale(1.0f)
 {
   for (unsigned int i = 0; i < TEXTURE_OFFSETS_SIZE; i++) {
     m_textureOffsets[i] = 0;
@@ -78,6 +81,34 @@ void RAS_2DFilter::SetMipmap(bool mipmap)
   m_mipmap = mipmap;
 }
 
+float RAS_2DFilter::GetResolutionScale() const
+{
+  return m_resolutionScale;
+}
+
+void RAS_2DFilter::SetResolutionScale(float scale)
+{
+  m_resolutionScale = scale;
+}
+
+bool RAS_2DFilter::UseScaledTarget() const
+{
+  // A custom off screen defines its own size.
+  return (m_resolutionScale < 1.0f && !m_frameBuffer);
+}
+
+void RAS_2DFilter::GetRenderSize(RAS_ICanvas *canvas,
+                                 unsigned int &width,
+                                 unsigned int &height) const
+{
+  width = canvas->GetWidth() + 1;
+  height = canvas->GetHeight() + 1;
+  if (UseScaledTarget()) {
+    width = std::max((unsigned int)(width * m_resolutionScale), 1u);
+    height = std::max((unsigned int)(height * m_resolutionScale), 1u);
+  }
+}
+
 RAS_2DFilterFrameBuffer *RAS_2DFilter::GetFrameBuffer() const
 {
   return m_frameBuffer.get();
@@ -88,6 +119,22 @@ void RAS_2DFilter::SetOffScreen(RAS_2DFilterFrameBuffer *frameBuffer)
   m_frameBuffer.reset(frameBuffer);
 }
 
+void RAS_2DFilter::SetPixelFunction(const std::string &function)
+{
+  m_pixelFunction = function;
+  m_pixelFunctionProgram = m_progs[FRAGMENT_PROGRAM];
+}
+
+const std::string &RAS_2DFilter::GetPixelFunction() const
+{
+  static const std::string empty;
+  if (!Ok() || m_frameBuffer || !m_textures.empty() || m_resolutionScale != 1.0f ||
+      m_progs[FRAGMENT_PROGRAM] != m_pixelFunctionProgram) {
+    return empty;
+  }
+  return m_pixelFunction;
+}
+
 void RAS_2DFilter::Initialize(RAS_ICanvas *canvas)
 {
   /* The shader must be initialized at the first frame when the canvas is accesible.
@@ -129,6 +176,8 @@ RAS_FrameBuffer *RAS_2DFilter::Start(RAS_Rasterizer *rasty,
   }
 
   Initialize(canvas);
+  // The offsets depend on the render size which changes with the resolution scale.
+  ComputeTextureOffsets(canvas);
 
   GPUVertFormat *vert_format = immVertexFormat();
   uint pos = GPU_vertformat_attr_add(vert_format, "pos", GPU_COMP_F32, 2, GPU_FETCH_FLOAT);
@@ -206,8 +255,10 @@ void RAS_2DFilter::ParseShaderProgram()
 of nearby fragments. Or vertices or whatever.*/
 void RAS_2DFilter::ComputeTextureOffsets(RAS_ICanvas *canvas)
 {
-  const GLfloat texturewidth = (GLfloat)canvas->GetWidth() + 1;
-  const GLfloat textureheight = (GLfloat)canvas->GetHeight() + 1;
+  unsigned int width, height;
+  GetRenderSize(canvas, width, height);
+  const GLfloat texturewidth = (GLfloat)width;
+  const GLfloat textureheight = (GLfloat)height;
   const GLfloat xInc = 1.0f / texturewidth;
   const GLfloat yInc = 1.0f / textureheight;
 
@@ -270,14 +321,14 @@ void RAS_2DFilter::BindUniforms(RAS_ICanvas *canvas)
   if (m_predefinedUniforms[DEPTH_TEXTURE_UNIFORM] != -1) {
     SetUniform(m_predefinedUniforms[DEPTH_TEXTURE_UNIFORM], 9);
   }
+  unsigned int texturewidth, textureheight;
+  GetRenderSize(canvas, texturewidth, textureheight);
   if (m_predefinedUniforms[RENDERED_TEXTURE_WIDTH_UNIFORM] != -1) {
     // Bind rendered texture width.
-    const unsigned int texturewidth = canvas->GetWidth() + 1;
     SetUniform(m_predefinedUniforms[RENDERED_TEXTURE_WIDTH_UNIFORM], (float)texturewidth);
   }
   if (m_predefinedUniforms[RENDERED_TEXTURE_HEIGHT_UNIFORM] != -1) {
     // Bind rendered texture height.
-    const unsigned int textureheight = canvas->GetHeight() + 1;
     SetUniform(m_predefinedUniforms[RENDERED_TEXTURE_HEIGHT_UNIFORM], (float)textureheight);
   }
   if (m_predefinedUniforms[TEXTURE_COORDINATE_OFFSETS_UNIFORM] != -1) {
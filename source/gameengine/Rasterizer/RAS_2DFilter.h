@@ -55,6 +55,8 @@ class RAS_2DFilter : public virtual RAS_Shader {
   bool m_uniformInitialized;
   /// True if generate mipmap of input color texture.
   bool m_mipmap;
+  /// Scale of the filter render size relative to the canvas size.
+  float m_resolutionScale;
 
   /** A set of vec2 coordinates that the shaders use to sample nearby pixels from incoming
   textures. The computation should be left to the glsl shader, I keep it for backward
@@ -67,6 +69,13 @@ class RAS_2DFilter : public virtual RAS_Shader {
   /// Custom off screen for special datas.
   std::unique_ptr<RAS_2DFilterFrameBuffer> m_frameBuffer;
 
+  /** Body of a function computing the filter color from only the color of the same pixel,
+   * named texcolor, empty if the filter samples other pixels or textures.
+   */
+  std::string m_pixelFunction;
+  /// Fragment program the pixel function was extracted from.
+  std::string m_pixelFunctionProgram;
+
   virtual bool LinkProgram();
   void ParseShaderProgram();
   void BindUniforms(RAS_ICanvas *canvas);
@@ -81,9 +90,27 @@ class RAS_2DFilter : public virtual RAS_Shader {
   bool GetMipmap() const;
   void SetMipmap(bool mipmap);
 
+  float GetResolutionScale() const;
+  void SetResolutionScale(float scale);
+  /** Return true if the filter renders at a lower resolution than the canvas to a target
+   * provided by the filter manager.
+   */
+  bool UseScaledTarget() const;
+  /// Return the size of the filter render, the canvas size scaled by the resolution scale.
+  void GetRenderSize(RAS_ICanvas *canvas, unsigned int &width, unsigned int &height) const;
+
   RAS_2DFilterFrameBuffer *GetFrameBuffer() const;
   void SetOffScreen(RAS_2DFilterFrameBuffer *frameBuffer);
 
+  /** Set the pixel function equivalent to the current fragment program, used to merge
+   * the filter with its neighbours in a single pass.
+   */
+  void SetPixelFunction(const std::string &function);
+  /** Return the pixel function if the filter can be merged with its neighbours, the filter
+   * must be enabled and still use its original program without custom textures or off screen.
+   */
+  const std::string &GetPixelFunction() const;
+
   /// Called by the filter manager when it has informations like the display size, a gl context...
   void Initialize(RAS_ICanvas *canvas);
 
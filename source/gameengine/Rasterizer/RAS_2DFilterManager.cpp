@@ -26,11 +26,14 @@
 
 #include "RAS_2DFilterManager.h"
 
+#include <algorithm>
+
 #include "DRW_render.h"
 
 #include "CM_Message.h"
 #include "RAS_2DFilter.h"
 #include "RAS_FrameBuffer.h"
+#include "RAS_ICanvas.h"
 
 extern "C" {
 extern char datatoc_RAS_Blur2DFilter_glsl[];
@@ -49,12 +52,23 @@ RAS_2DFilterManager::RAS_2DFilterManager()
 {
 }
 
+static const std::string grayScalePixelFunction =
+    "float gray = dot(texcolor.rgb, vec3(0.299, 0.587, 0.114));\n"
+    "return vec4(gray, gray, gray, texcolor.a);\n";
+static const std::string sepiaPixelFunction =
+    "float gray = dot(texcolor.rgb, vec3(0.299, 0.587, 0.114));\n"
+    "return vec4(gray * vec3(1.2, 1.0, 0.8), texcolor.a);\n";
+static const std::string invertPixelFunction = "return vec4(1.0 - texcolor.rgb, texcolor.a);\n";
+
 RAS_2DFilterManager::~RAS_2DFilterManager()
 {
   for (const RAS_PassTo2DFilter::value_type &pair : m_filters) {
     RAS_2DFilter *filter = pair.second;
     delete filter;
   }
+  for (const auto &pair : m_fusedFilters) {
+    delete pair.second;
+  }
 }
 
 RAS_2DFilter *RAS_2DFilterManager::AddFilter(RAS_2DFilterData &filterData)
@@ -119,21 +133,33 @@ RAS_FrameBuffer *RAS_2DFilterManager::RenderFilters(RAS_Rasterizer *rasty,
   // The filter depth input off scree, unchanged for each filters.
   RAS_FrameBuffer *depthfb = previousfb;
 
-  // Used to know if a filter is the last of the container.
-  RAS_PassTo2DFilter::const_iterator pend = std::prev(m_filters.end());
+  const std::vector<RAS_2DFilter *> passes = GetFilterPasses();
+  const bool useGpuTimers = rasty->GetUseGpuTimers();
 
-  for (RAS_PassTo2DFilter::iterator begin = m_filters.begin(), it = begin, end = m_filters.end();
+  for (std::vector<RAS_2DFilter *>::const_iterator it = passes.begin(), end = passes.end();
        it != end;
        ++it) {
-    RAS_2DFilter *filter = it->second;
+    RAS_2DFilter *filter = *it;
+
+    if (useGpuTimers) {
+      rasty->BeginGpuTimer("2D Filter " + std::to_string(it - passes.begin()));
+    }
 
     /* Assign the previous off screen to the input off screen. At the first render it's the
      * input off screen sent to RenderFilters. */
     colorfb = previousfb;
 
     RAS_FrameBuffer *ftargetfb;
+    const bool scaled = filter->UseScaledTarget();
+    unsigned int width, height;
+    filter->GetRenderSize(canvas, width, height);
     // Computing the filter targeted off screen.
-    if (it == pend) {
+    if (scaled) {
+      /* Render to an off screen of the filter size, the next filter or the final copy to the
+       * targeted off screen upscale it. */
+      ftargetfb = GetPooledFrameBuffer(width, height, colorfb);
+    }
+    else if (std::next(it) == end) {
       // Render to the targeted off screen for the last filter.
       ftargetfb = targetfb;
     }
@@ -145,10 +171,26 @@ RAS_FrameBuffer *RAS_2DFilterManager::RenderFilters(RAS_Rasterizer *rasty,
     /* Get the output off screen of the filter, could be the same as the input off screen
      * if no modifications were made or the targeted off screen.
      * This output off screen is used for the next filter as input off screen */
+    if (scaled) {
+      rasty->SetViewport(0, 0, width, height);
+      rasty->SetScissor(0, 0, width, height);
+    }
+
     previousfb = filter->Start(rasty, canvas, depthfb, colorfb, ftargetfb);
     filter->End();
+
+    rasty->EndGpuTimer();
+
+    if (scaled) {
+      const int canvasWidth = canvas->GetWidth() + 1;
+      const int canvasHeight = canvas->GetHeight() + 1;
+      rasty->SetViewport(0, 0, canvasWidth, canvasHeight);
+      rasty->SetScissor(0, 0, canvasWidth, canvasHeight);
+    }
   }
 
+  ReleaseUnusedFrameBuffers();
+
   // The last filter doesn't use its own off screen and didn't render to the targeted off screen ?
   if (previousfb != targetfb) {
     // Render manually to the targeted off screen as the last filter didn't do it for us.
@@ -166,6 +208,123 @@ RAS_FrameBuffer *RAS_2DFilterManager::RenderFilters(RAS_Rasterizer *rasty,
   return targetfb;
 }
 
+std::vector<RAS_2DFilter *> RAS_2DFilterManager::GetFilterPasses()
+{
+  std::vector<RAS_2DFilter *> passes;
+  std::vector<std::string> functions;
+  RAS_2DFilter *firstPixelFilter = nullptr;
+
+  const auto flushPixelFilters = [&]() {
+    if (functions.size() == 1) {
+      passes.push_back(firstPixelFilter);
+    }
+    else if (functions.size() > 1) {
+      RAS_2DFilter *fused = GetFusedFilter(functions);
+      if (fused) {
+        passes.push_back(fused);
+      }
+    }
+    functions.clear();
+  };
+
+  for (const RAS_PassTo2DFilter::value_type &pair : m_filters) {
+    RAS_2DFilter *filter = pair.second;
+    // A disabled filter renders nothing, it doesn't stop a sequence of pixel filters.
+    if (!filter->Ok()) {
+      continue;
+    }
+
+    const std::string &function = filter->GetPixelFunction();
+    if (function.empty()) {
+      flushPixelFilters();
+      passes.push_back(filter);
+    }
+    else {
+      if (functions.empty()) {
+        firstPixelFilter = filter;
+      }
+      functions.push_back(function);
+    }
+  }
+  flushPixelFilters();
+
+  return passes;
+}
+
+RAS_2DFilter *RAS_2DFilterManager::GetFusedFilter(const std::vector<std::string> &functions)
+{
+  std::map<std::vector<std::string>, RAS_2DFilter *>::iterator it = m_fusedFilters.find(
+      functions);
+  if (it != m_fusedFilters.end()) {
+    return it->second;
+  }
+
+  std::string source =
+      "uniform sampler2D bgl_RenderedTexture;\n"
+      "in vec4 bgl_TexCoord;\n"
+      "out vec4 fragColor;\n";
+  std::string calls;
+  for (unsigned int i = 0, size = functions.size(); i < size; ++i) {
+    const std::string name = "bgl_PixelFilter" + std::to_string(i);
+    source += "vec4 " + name + "(vec4 texcolor)\n{\n" + functions[i] + "}\n";
+    calls += "  color = " + name + "(color);\n";
+  }
+  source += "void main(void)\n{\n  vec4 color = texture(bgl_RenderedTexture, bgl_TexCoord.xy);\n" +
+            calls + "  fragColor = color;\n}\n";
+
+  RAS_2DFilterData filterData;
+  filterData.filterMode = FILTER_CUSTOMFILTER;
+  filterData.shaderText = source;
+
+  RAS_2DFilter *filter = NewFilter(filterData);
+  if (filter) {
+    filter->SetEnabled(true);
+    if (!filter->Ok()) {
+      CM_Error("failed to merge 2D filters in a single pass.");
+      delete filter;
+      filter = nullptr;
+    }
+  }
+  m_fusedFilters[functions] = filter;
+
+  return filter;
+}
+
+RAS_FrameBuffer *RAS_2DFilterManager::GetPooledFrameBuffer(unsigned int width,
+                                                           unsigned int height,
+                                                           RAS_FrameBuffer *exclude)
+{
+  for (PooledFrameBuffer &pooled : m_frameBufferPool) {
+    RAS_FrameBuffer *frameBuffer = pooled.m_frameBuffer.get();
+    if (frameBuffer != exclude && frameBuffer->GetWidth() == width &&
+        frameBuffer->GetHeight() == height) {
+      pooled.m_used = true;
+      return frameBuffer;
+    }
+  }
+
+  RAS_FrameBuffer *frameBuffer = new RAS_FrameBuffer(
+      width, height, RAS_Rasterizer::RAS_FRAMEBUFFER_CUSTOM);
+  // The next filter samples the off screen at a different resolution.
+  GPU_texture_filter_mode(frameBuffer->GetColorAttachment(), true);
+  m_frameBufferPool.push_back({std::unique_ptr<RAS_FrameBuffer>(frameBuffer), true});
+
+  return frameBuffer;
+}
+
+void RAS_2DFilterManager::ReleaseUnusedFrameBuffers()
+{
+  m_frameBufferPool.erase(std::remove_if(m_frameBufferPool.begin(),
+                                         m_frameBufferPool.end(),
+                                         [](const PooledFrameBuffer &pooled) {
+                                           return !pooled.m_used;
+                                         }),
+                          m_frameBufferPool.end());
+  for (PooledFrameBuffer &pooled : m_frameBufferPool) {
+    pooled.m_used = false;
+  }
+}
+
 RAS_2DFilter *RAS_2DFilterManager::CreateFilter(RAS_2DFilterData &filterData)
 {
   RAS_2DFilter *result = nullptr;
@@ -215,6 +374,18 @@ RAS_2DFilter *RAS_2DFilterManager::CreateFilter(RAS_2DFilterData &filterData)
   else {
     filterData.shaderText = shaderSource;
     result = NewFilter(filterData);
+
+    switch (filterData.filterMode) {
+      case RAS_2DFilterManager::FILTER_GRAYSCALE:
+        result->SetPixelFunction(grayScalePixelFunction);
+        break;
+      case RAS_2DFilterManager::FILTER_SEPIA:
+        result->SetPixelFunction(sepiaPixelFunction);
+        break;
+      case RAS_2DFilterManager::FILTER_INVERT:
+        result->SetPixelFunction(invertPixelFunction);
+        break;
+    }
   }
   return result;
 }
@@ -27,6 +27,9 @@
 #pragma once
 
 #include <map>
+#include <memory>
+#include <string>
+#include <vector>
 
 #include "RAS_2DFilterData.h"
 
@@ -90,6 +93,33 @@ class RAS_2DFilterManager {
 
  private:
   RAS_PassTo2DFilter m_filters;
+  /// Filters made of consecutive pixel filters, indexed by their pixel functions.
+  std::map<std::vector<std::string>, RAS_2DFilter *> m_fusedFilters;
+
+  /** Return the list of filters to render, consecutive filters only reading the color
+   * of their pixel are replaced by a single filter computing all of them.
+   */
+  std::vector<RAS_2DFilter *> GetFilterPasses();
+  /// Return the filter computing all the pixel functions in sequence.
+  RAS_2DFilter *GetFusedFilter(const std::vector<std::string> &functions);
+
+  struct PooledFrameBuffer {
+    std::unique_ptr<RAS_FrameBuffer> m_frameBuffer;
+    /// True if the off screen was used by the last rendering of the filters.
+    bool m_used;
+  };
+
+  /// Off screens of the filters rendering at a lower resolution, shared by all the filters.
+  std::vector<PooledFrameBuffer> m_frameBufferPool;
+
+  /** Return an off screen of the pool with the given size, different from the filter input.
+   * \param exclude The off screen used as input of the filter.
+   */
+  RAS_FrameBuffer *GetPooledFrameBuffer(unsigned int width,
+                                        unsigned int height,
+                                        RAS_FrameBuffer *exclude);
+  /// Delete the off screens of the pool unused by the last rendering.
+  void ReleaseUnusedFrameBuffers();
 
   /** Creates a filter matching the given filter data. Returns nullptr if no
    * filter can be created with such information.
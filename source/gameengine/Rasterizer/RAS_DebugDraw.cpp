@@ -29,7 +29,7 @@
 #include "MT_Frustum.h"
 #include "RAS_OpenGLDebugDraw.h"
 
-RAS_DebugDraw::RAS_DebugDraw()
+RAS_DebugDraw::RAS_DebugDraw() : m_capacity(65536)
 {
   m_impl = new RAS_OpenGLDebugDraw();
 }
@@ -38,6 +38,16 @@ RAS_DebugDraw::~RAS_DebugDraw()
   delete m_impl;
 }
 
+void RAS_DebugDraw::SetCapacity(unsigned int capacity)
+{
+  m_capacity = capacity;
+}
+
+unsigned int RAS_DebugDraw::GetCapacity() const
+{
+  return m_capacity;
+}
+
 RAS_DebugDraw::Shape::Shape(const MT_Vector4 &color) : m_color(color)
 {
 }
@@ -90,6 +100,13 @@ RAS_DebugDraw::Box2D::Box2D(const MT_Vector2 &pos, const MT_Vector2 &size, const
 {
 }
 
+RAS_DebugDraw::Line2D::Line2D(const MT_Vector2 &from,
+                              const MT_Vector2 &to,
+                              const MT_Vector4 &color)
+    : Shape(color), m_from(from), m_to(to)
+{
+}
+
 void RAS_DebugDraw::DrawLine(const MT_Vector3 &from, const MT_Vector3 &to, const MT_Vector4 &color)
 {
   m_lines.emplace_back(from, to, color);
@@ -151,6 +168,13 @@ void RAS_DebugDraw::RenderText2D(const std::string &text,
   m_texts2D.emplace_back(text, size, color);
 }
 
+void RAS_DebugDraw::RenderLine2D(const MT_Vector2 &from,
+                                 const MT_Vector2 &to,
+                                 const MT_Vector4 &color)
+{
+  m_lines2D.emplace_back(from, to, color);
+}
+
 void RAS_DebugDraw::Flush(RAS_Rasterizer *rasty, RAS_ICanvas *canvas)
 {
   /*if ((m_lines.size() + m_circles.size() + m_aabbs.size() + m_boxes.size() + m_solidBoxes.size()
@@ -166,4 +190,5 @@ void RAS_DebugDraw::Flush(RAS_Rasterizer *rasty, RAS_ICanvas *canvas)
   m_solidBoxes.clear();
   m_texts2D.clear();
   m_boxes2D.clear();
+  m_lines2D.clear();
 }
@@ -105,6 +105,12 @@ class RAS_DebugDraw {
     MT_Vector2 m_size;
   };
 
+  struct Line2D : Shape {
+    Line2D(const MT_Vector2 &from, const MT_Vector2 &to, const MT_Vector4 &color);
+    MT_Vector2 m_from;
+    MT_Vector2 m_to;
+  };
+
   std::vector<Line> m_lines;
   std::vector<Circle> m_circles;
   std::vector<Aabb> m_aabbs;
@@ -112,6 +118,10 @@ class RAS_DebugDraw {
   std::vector<SolidBox> m_solidBoxes;
   std::vector<Text2D> m_texts2D;
   std::vector<Box2D> m_boxes2D;
+  std::vector<Line2D> m_lines2D;
+
+  /// Maximum number of lines and of triangles drawn per frame.
+  unsigned int m_capacity;
 
   RAS_OpenGLDebugDraw *m_impl;
 
@@ -119,6 +129,12 @@ class RAS_DebugDraw {
   RAS_DebugDraw();
   ~RAS_DebugDraw();
 
+  /** Set the maximum number of lines and of triangles of the debug shapes drawn per frame,
+   * the shapes over the capacity are dropped.
+   */
+  void SetCapacity(unsigned int capacity);
+  unsigned int GetCapacity() const;
+
   void DrawLine(const MT_Vector3 &from, const MT_Vector3 &to, const MT_Vector4 &color);
   void DrawCircle(const MT_Vector3 &center,
                   const MT_Scalar radius,
@@ -151,5 +167,8 @@ class RAS_DebugDraw {
 
   void RenderText2D(const std::string &text, const MT_Vector2 &pos, const MT_Vector4 &color);
 
+  /// Draw a 2D line in screen space, all the 2D lines are drawn in a single batch.
+  void RenderLine2D(const MT_Vector2 &from, const MT_Vector2 &to, const MT_Vector4 &color);
+
   void Flush(RAS_Rasterizer *rasty, RAS_ICanvas *canvas);
 };
@@ -26,12 +26,14 @@
 
 #include "RAS_FrameBuffer.h"
 
+#include "BLI_utildefines.h"
+
 #include "GPU_framebuffer.h"
 
 RAS_FrameBuffer::RAS_FrameBuffer(unsigned int width,
                                  unsigned int height,
                                  RAS_Rasterizer::FrameBufferType fbtype)
-    : m_frameBuffer(nullptr), m_frameBufferType(fbtype)
+    : m_frameBuffer(nullptr), m_frameBufferType(fbtype), m_ownAttachments(true)
 {
   m_colorAttachment = GPU_texture_create_2d("color_tex", width, height, 1, GPU_RGBA16F, nullptr);
   m_depthAttachment = GPU_texture_create_2d(
@@ -41,11 +43,23 @@ RAS_FrameBuffer::RAS_FrameBuffer(unsigned int width,
   GPU_framebuffer_texture_attach(m_frameBuffer, m_depthAttachment, 0, 0);
 }
 
+RAS_FrameBuffer::RAS_FrameBuffer(RAS_Rasterizer::FrameBufferType fbtype)
+    : m_frameBuffer(nullptr),
+      m_frameBufferType(fbtype),
+      m_colorAttachment(nullptr),
+      m_depthAttachment(nullptr),
+      m_ownAttachments(false)
+{
+  m_frameBuffer = GPU_framebuffer_create("game_wrap_fb");
+}
+
 RAS_FrameBuffer::~RAS_FrameBuffer()
 {
   GPU_framebuffer_free(m_frameBuffer);  // it detaches attachments
-  GPU_texture_free(m_colorAttachment);
-  GPU_texture_free(m_depthAttachment);
+  if (m_ownAttachments) {
+    GPU_texture_free(m_colorAttachment);
+    GPU_texture_free(m_depthAttachment);
+  }
 }
 
 GPUFrameBuffer *RAS_FrameBuffer::GetFrameBuffer()
@@ -73,6 +87,20 @@ GPUTexture *RAS_FrameBuffer::GetDepthAttachment()
   return m_depthAttachment;
 }
 
+void RAS_FrameBuffer::AttachTextures(GPUTexture *color, GPUTexture *depth)
+{
+  BLI_assert(!m_ownAttachments);
+
+  /* Attaching the textures already attached is a no-op and doesn't revalidate the frame buffer,
+   * a freed texture was detached and is always replaced, even by a texture at the same address.
+   */
+  GPU_framebuffer_texture_attach(m_frameBuffer, color, 0, 0);
+  GPU_framebuffer_texture_attach(m_frameBuffer, depth, 0, 0);
+
+  m_colorAttachment = color;
+  m_depthAttachment = depth;
+}
+
 RAS_Rasterizer::FrameBufferType RAS_FrameBuffer::GetType() const
 {
   return m_frameBufferType;
@@ -40,11 +40,17 @@ class RAS_FrameBuffer {
 
   GPUTexture *m_colorAttachment;
   GPUTexture *m_depthAttachment;
+  /// False if the attachments are textures of an other owner, e.g a GPUViewport.
+  bool m_ownAttachments;
 
  public:
   RAS_FrameBuffer(unsigned int width,
                   unsigned height,
                   RAS_Rasterizer::FrameBufferType framebufferType);
+  /** Construct a frame buffer without attachments, wrapping the textures given
+   * to AttachTextures without owning them.
+   */
+  RAS_FrameBuffer(RAS_Rasterizer::FrameBufferType framebufferType);
   ~RAS_FrameBuffer();
 
   GPUFrameBuffer *GetFrameBuffer();
@@ -57,5 +63,10 @@ class RAS_FrameBuffer {
   GPUTexture *GetColorAttachment();
   GPUTexture *GetDepthAttachment();
 
+  /** Attach the textures of an other owner, the frame buffer is reconfigured only if
+   * they differ from the current attachments.
+   */
+  void AttachTextures(GPUTexture *color, GPUTexture *depth);
+
   RAS_Rasterizer::FrameBufferType GetType() const;
 };
@@ -0,0 +1,166 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Rasterizer/RAS_HiZCulling.cpp
+ *  \ingroup bgerast
+ */
+
+#include "RAS_HiZCulling.h"
+
+#include "GPU_capabilities.h"
+#include "GPU_compute.h"
+#include "GPU_shader.h"
+#include "GPU_state.h"
+#include "GPU_texture.h"
+#include "GPU_vertex_buffer.h"
+#include "MEM_guardedalloc.h"
+
+extern "C" {
+extern char datatoc_RAS_HiZCulling_glsl[];
+}
+
+/// Number of visibility texels per row.
+static const int visibilityWidth = 256;
+/// Number of boxes tested by a compute work group.
+static const int groupSize = 64;
+
+/// The shader is shared by all the tests and freed with the last one.
+static GPUShader *hizCullingShader = nullptr;
+static unsigned int hizCullingUsers = 0;
+
+RAS_HiZCulling::RAS_HiZCulling()
+    : m_boundsBuffer(nullptr), m_visibilityTexture(nullptr), m_count(0), m_pending(false)
+{
+  ++hizCullingUsers;
+}
+
+RAS_HiZCulling::~RAS_HiZCulling()
+{
+  GPU_VERTBUF_DISCARD_SAFE(m_boundsBuffer);
+  if (m_visibilityTexture) {
+    GPU_texture_free(m_visibilityTexture);
+  }
+
+  if (--hizCullingUsers == 0 && hizCullingShader) {
+    GPU_shader_free(hizCullingShader);
+    hizCullingShader = nullptr;
+  }
+}
+
+bool RAS_HiZCulling::Supported()
+{
+  return GPU_compute_shader_support() && GPU_shader_image_load_store_support();
+}
+
+void RAS_HiZCulling::Test(const std::vector<float> &bounds,
+                          const MT_Matrix4x4 &viewProjection,
+                          GPUTexture *maxzBuffer,
+                          int viewportWidth,
+                          int viewportHeight,
+                          int maxLevel)
+{
+  m_count = bounds.size() / 8;
+  m_pending = false;
+  if (m_count == 0) {
+    return;
+  }
+
+  if (!hizCullingShader) {
+    hizCullingShader = GPU_shader_create_compute(
+        datatoc_RAS_HiZCulling_glsl, nullptr, nullptr, "RAS_HiZCulling");
+    if (!hizCullingShader) {
+      return;
+    }
+  }
+
+  // Two vertices of a vec4 per box.
+  const unsigned int vertCount = m_count * 2;
+  if (!m_boundsBuffer || GPU_vertbuf_get_vertex_alloc(m_boundsBuffer) != vertCount) {
+    static GPUVertFormat format = {0};
+    if (format.attr_len == 0) {
+      GPU_vertformat_attr_add(&format, "bounds", GPU_COMP_F32, 4, GPU_FETCH_FLOAT);
+    }
+    GPU_VERTBUF_DISCARD_SAFE(m_boundsBuffer);
+    m_boundsBuffer = GPU_vertbuf_create_with_format_ex(&format, GPU_USAGE_DYNAMIC);
+    GPU_vertbuf_data_alloc(m_boundsBuffer, vertCount);
+  }
+  GPU_vertbuf_attr_fill(m_boundsBuffer, 0, bounds.data());
+
+  const int height = (m_count + visibilityWidth - 1) / visibilityWidth;
+  if (!m_visibilityTexture || GPU_texture_height(m_visibilityTexture) < height) {
+    if (m_visibilityTexture) {
+      GPU_texture_free(m_visibilityTexture);
+    }
+    m_visibilityTexture = GPU_texture_create_2d(
+        "RAS_HiZCulling", visibilityWidth, height, 1, GPU_R32UI, nullptr);
+  }
+
+  float mat[4][4];
+  viewProjection.getValue(&mat[0][0]);
+
+  GPU_shader_bind(hizCullingShader);
+  GPU_shader_uniform_mat4(hizCullingShader, "ViewProjectionMatrix", mat);
+  GPU_shader_uniform_2f(hizCullingShader, "viewportSize", viewportWidth, viewportHeight);
+  GPU_shader_uniform_2f(hizCullingShader,
+                        "hizUvScale",
+                        (float)viewportWidth / GPU_texture_width(maxzBuffer),
+                        (float)viewportHeight / GPU_texture_height(maxzBuffer));
+  GPU_shader_uniform_1i(hizCullingShader, "boundsCount", m_count);
+  GPU_shader_uniform_1i(hizCullingShader, "maxLevel", maxLevel);
+
+  GPU_texture_bind(maxzBuffer, GPU_shader_get_texture_binding(hizCullingShader, "maxzBuffer"));
+  GPU_texture_image_bind(m_visibilityTexture,
+                         GPU_shader_get_texture_binding(hizCullingShader, "visibilityImage"));
+  GPU_vertbuf_bind_as_ssbo(m_boundsBuffer,
+                           GPU_shader_get_ssbo(hizCullingShader, "boundsBuffer"));
+
+  GPU_compute_dispatch(hizCullingShader, (m_count + groupSize - 1) / groupSize, 1, 1);
+  GPU_memory_barrier(GPU_BARRIER_SHADER_IMAGE_ACCESS | GPU_BARRIER_TEXTURE_FETCH);
+
+  GPU_texture_image_unbind(m_visibilityTexture);
+  GPU_texture_unbind(maxzBuffer);
+  GPU_shader_unbind();
+
+  m_pending = true;
+}
+
+bool RAS_HiZCulling::ReadVisibility(std::vector<bool> &visibility)
+{
+  if (!m_pending) {
+    return false;
+  }
+  m_pending = false;
+
+  // The test was dispatched at the previous render, the GPU is usually done with it.
+  unsigned int *data = (unsigned int *)GPU_texture_read(m_visibilityTexture, GPU_DATA_UINT, 0);
+  if (!data) {
+    return false;
+  }
+
+  visibility.resize(m_count);
+  for (unsigned int i = 0; i < m_count; ++i) {
+    visibility[i] = (data[i] != 0);
+  }
+  MEM_freeN(data);
+
+  return true;
+}
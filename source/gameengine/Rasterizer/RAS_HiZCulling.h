@@ -0,0 +1,78 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file RAS_HiZCulling.h
+ *  \ingroup bgerast
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "MT_Matrix4x4.h"
+
+struct GPUTexture;
+struct GPUVertBuf;
+
+/** GPU occlusion test of bounding boxes against the max depth pyramid of a render.
+ * The test is run by a compute shader after the render of a view and its result is read
+ * at the next render of the same view, the GPU doesn't stall the frame waiting for it.
+ */
+class RAS_HiZCulling {
+ private:
+  /// Minimum and maximum corners of the tested boxes.
+  GPUVertBuf *m_boundsBuffer;
+  /// Visibility of each tested box, one texel per box.
+  GPUTexture *m_visibilityTexture;
+  /// Number of boxes of the last test.
+  unsigned int m_count;
+  /// A test was dispatched since the last read of the visibility.
+  bool m_pending;
+
+ public:
+  RAS_HiZCulling();
+  ~RAS_HiZCulling();
+
+  /// Return true when the GPU supports the compute shaders used by the test.
+  static bool Supported();
+
+  /** Dispatch the test of boxes against a max depth pyramid.
+   * \param bounds The minimum and maximum world corners of each box, 8 floats per box.
+   * \param viewProjection The matrix the depth was rendered with.
+   * \param maxzBuffer The max depth pyramid, its first level matches the depth pixels.
+   * \param viewportWidth, viewportHeight The size of the rendered depth, the pyramid can be
+   * larger.
+   * \param maxLevel The last level built in the pyramid.
+   */
+  void Test(const std::vector<float> &bounds,
+            const MT_Matrix4x4 &viewProjection,
+            GPUTexture *maxzBuffer,
+            int viewportWidth,
+            int viewportHeight,
+            int maxLevel);
+
+  /** Read the result of the last test.
+   * \param visibility Filled with the visibility of each box of the last test.
+   * \return False if no test was dispatched since the last read.
+   */
+  bool ReadVisibility(std::vector<bool> &visibility);
+};
@@ -29,6 +29,7 @@
 #include "BLI_string.h"
 #include "BLI_task.h"
 #include "DNA_scene_types.h"
+#include "GPU_glew.h"
 #include "IMB_imbuf.h"
 #include "IMB_imbuf_types.h"
 #include "MEM_guardedalloc.h"
@@ -60,6 +61,10 @@ RAS_ICanvas::RAS_ICanvas(RAS_Rasterizer *rasty) : m_rasterizer(rasty), m_samples
 
 RAS_ICanvas::~RAS_ICanvas()
 {
+  for (const FrameFence &fence : m_frameFences) {
+    glDeleteSync((GLsync)fence.m_sync);
+  }
+
   if (m_taskpool) {
     BLI_task_pool_work_and_wait(m_taskpool);
     BLI_task_pool_free(m_taskpool);
@@ -67,6 +72,34 @@ RAS_ICanvas::~RAS_ICanvas()
   }
 }
 
+void RAS_ICanvas::AddFrameFence(double inputTime)
+{
+  m_frameFences.push_back({glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0), inputTime});
+}
+
+bool RAS_ICanvas::WaitFrameFences(unsigned short maxFrames, double &r_inputTime)
+{
+  bool finished = false;
+  while (!m_frameFences.empty()) {
+    const FrameFence &fence = m_frameFences.front();
+    GLsync sync = (GLsync)fence.m_sync;
+    // Wait only while the next swap would exceed the frames in flight.
+    const bool wait = (maxFrames > 0 && m_frameFences.size() >= maxFrames);
+    const GLenum status = glClientWaitSync(
+        sync, GL_SYNC_FLUSH_COMMANDS_BIT, wait ? GL_TIMEOUT_IGNORED : 0);
+    if (status == GL_TIMEOUT_EXPIRED) {
+      break;
+    }
+
+    r_inputTime = fence.m_inputTime;
+    finished = true;
+    glDeleteSync(sync);
+    m_frameFences.pop_front();
+  }
+
+  return finished;
+}
+
 void RAS_ICanvas::SetSamples(int samples)
 {
   m_samples = samples;
@@ -31,6 +31,8 @@
 
 #pragma once
 
+#include <deque>
+
 #include "RAS_Rasterizer.h"
 
 class RAS_Rect;
@@ -72,9 +74,25 @@ class RAS_ICanvas {
 
   /// probably needs some arguments for PS2 in future
   virtual void SwapBuffers() = 0;
+  /** Set the swap interval, 0 disables the vsync and -1 uses the adaptive vsync tearing the late
+   * frames, it falls back to the vsync where the adaptive vsync is not supported.
+   */
   virtual void SetSwapInterval(int interval) = 0;
   virtual bool GetSwapInterval(int &intervalOut) = 0;
 
+  /** Insert a fence signaled when the GPU finished the frame just swapped.
+   * \param inputTime The time the inputs of the frame were sampled.
+   */
+  void AddFrameFence(double inputTime);
+  /** Remove the fences of the frames finished by the GPU and wait for the oldest ones until
+   * less than a maximum of frames are in flight.
+   * \param maxFrames The maximum of frames in flight after the next swap, 0 to only remove the
+   * finished frames without waiting.
+   * \param r_inputTime The input time of the last finished frame.
+   * \return True if a frame was finished.
+   */
+  bool WaitFrameFences(unsigned short maxFrames, double &r_inputTime);
+
   void SetSamples(int samples);
   int GetSamples() const;
 
@@ -147,6 +165,15 @@ class RAS_ICanvas {
   RAS_Rect m_windowArea;
   RAS_Rect m_viewportArea;
 
+  struct FrameFence {
+    /// The GLsync object.
+    void *m_sync;
+    double m_inputTime;
+  };
+
+  /// Fences of the swapped frames not yet finished, the oldest first.
+  std::deque<FrameFence> m_frameFences;
+
   /** Delay the screenshot to the frame end to use a valid buffer and avoid copy from an invalid
    * buffer at the frame begin after the buffer swap. The screenshot are proceeded in \see
    * FlushScreenshots.
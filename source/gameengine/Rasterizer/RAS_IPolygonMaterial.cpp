@@ -122,6 +122,11 @@ std::string RAS_IPolyMaterial::GetName()
   return m_name;
 }
 
+bool RAS_IPolyMaterial::HasName(const std::string &name) const
+{
+  return (m_name.size() >= 2 && m_name.compare(2, std::string::npos, name) == 0);
+}
+
 unsigned int RAS_IPolyMaterial::GetFlag() const
 {
   return m_flag;
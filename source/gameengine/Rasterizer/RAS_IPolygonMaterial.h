@@ -100,6 +100,8 @@ class RAS_IPolyMaterial {
   int GetAlphaBlend() const;
   float GetZOffset() const;
   virtual std::string GetName();
+  /// Return true if the name without its ID code prefix is name, checked without copies.
+  bool HasName(const std::string &name) const;
   unsigned int GetFlag() const;
   bool IsAlphaShadow() const;
   bool CastsShadows() const;
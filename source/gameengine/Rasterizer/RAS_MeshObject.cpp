@@ -44,6 +44,7 @@ RAS_MeshObject::RAS_MeshObject(Mesh *mesh,
                                const LayersInfo &layersInfo)
     : m_name(mesh->id.name + 2),
       m_layersInfo(layersInfo),
+      m_geometryPending(false),
       m_mesh(mesh),
       m_conversionTotverts(conversionTotverts),
       m_originalOb(originalOb)
@@ -76,6 +77,17 @@ const std::string RAS_MeshObject::GetMaterialName(unsigned int matid)
   return "";
 }
 
+bool RAS_MeshObject::HasMaterialName(const std::string &name) const
+{
+  for (RAS_MeshMaterial *meshmat : m_materials) {
+    if (meshmat->GetBucket()->GetPolyMaterial()->HasName(name)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
 RAS_MeshMaterial *RAS_MeshObject::GetMeshMaterial(unsigned int matid) const
 {
   if (m_materials.size() > matid) {
@@ -151,20 +163,11 @@ RAS_Polygon *RAS_MeshObject::AddPolygon(RAS_MeshMaterial *meshmat,
                                         bool collider,
                                         bool twoside)
 {
+  RAS_Polygon *poly = AddConvertedPolygon(meshmat, numverts, indices, visible, collider, twoside);
+
   // add it to the bucket, this also adds new display arrays
   RAS_MaterialBucket *bucket = meshmat->GetBucket();
-
-  // create a new polygon
   RAS_IDisplayArray *darray = meshmat->GetDisplayArray();
-  RAS_Polygon poly(bucket, darray, numverts);
-
-  poly.SetVisible(visible);
-  poly.SetCollider(collider);
-  poly.SetTwoside(twoside);
-
-  for (unsigned short i = 0; i < numverts; ++i) {
-    poly.SetVertexOffset(i, indices[i]);
-  }
 
   if (visible && !bucket->IsWire()) {
     // Add the first triangle.
@@ -180,6 +183,30 @@ RAS_Polygon *RAS_MeshObject::AddPolygon(RAS_MeshMaterial *meshmat,
     }
   }
 
+  return poly;
+}
+
+RAS_Polygon *RAS_MeshObject::AddConvertedPolygon(RAS_MeshMaterial *meshmat,
+                                                 int numverts,
+                                                 const unsigned int indices[4],
+                                                 bool visible,
+                                                 bool collider,
+                                                 bool twoside)
+{
+  RAS_MaterialBucket *bucket = meshmat->GetBucket();
+
+  // create a new polygon
+  RAS_IDisplayArray *darray = meshmat->GetDisplayArray();
+  RAS_Polygon poly(bucket, darray, numverts);
+
+  poly.SetVisible(visible);
+  poly.SetCollider(collider);
+  poly.SetTwoside(twoside);
+
+  for (unsigned short i = 0; i < numverts; ++i) {
+    poly.SetVertexOffset(i, indices[i]);
+  }
+
   m_polygons.push_back(poly);
   return &m_polygons.back();
 }
@@ -293,6 +320,16 @@ void RAS_MeshObject::EndConversion()
   }
 }
 
+bool RAS_MeshObject::IsGeometryPending() const
+{
+  return m_geometryPending;
+}
+
+void RAS_MeshObject::SetGeometryPending(bool pending)
+{
+  m_geometryPending = pending;
+}
+
 const RAS_MeshObject::LayersInfo &RAS_MeshObject::GetLayersInfo() const
 {
   return m_layersInfo;
@@ -89,6 +89,9 @@ class RAS_MeshObject {
 
   std::vector<RAS_Polygon> m_polygons;
 
+  /// The vertices and the polygons are not converted yet, only the materials are.
+  bool m_geometryPending;
+
  protected:
   RAS_MeshMaterialList m_materials;
   Mesh *m_mesh;
@@ -109,6 +112,8 @@ class RAS_MeshObject {
   // materials
   int NumMaterials();
   const std::string GetMaterialName(unsigned int matid);
+  /// Return true if a material has this name without its ID code prefix.
+  bool HasMaterialName(const std::string &name) const;
   const std::string GetTextureName(unsigned int matid);
 
   RAS_MeshMaterial *GetMeshMaterial(unsigned int matid) const;
@@ -134,6 +139,13 @@ class RAS_MeshObject {
                                   bool visible,
                                   bool collider,
                                   bool twoside);
+  /// Add a polygon without adding its triangles to the display array, they are already added.
+  RAS_Polygon *AddConvertedPolygon(RAS_MeshMaterial *meshmat,
+                                   int numverts,
+                                   const unsigned int indices[4],
+                                   bool visible,
+                                   bool collider,
+                                   bool twoside);
   virtual unsigned int AddVertex(RAS_MeshMaterial *meshmat,
                                  const MT_Vector3 &xyz,
                                  const MT_Vector2 *const uvs,
@@ -153,6 +165,10 @@ class RAS_MeshObject {
 
   void EndConversion();
 
+  /// Return true if the conversion of the vertices and the polygons is deferred.
+  bool IsGeometryPending() const;
+  void SetGeometryPending(bool pending);
+
   /// Return the list of blender's layers.
   const LayersInfo &GetLayersInfo() const;
 
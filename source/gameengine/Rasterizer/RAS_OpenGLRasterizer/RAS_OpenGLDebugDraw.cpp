@@ -26,122 +26,274 @@
 
 #include "RAS_DebugDraw.h"
 
+#include <cmath>
+
 #include "BLF_api.h"
 #include "DRW_render.h"
+#include "GPU_batch.h"
 #include "GPU_immediate.h"
 #include "GPU_matrix.h"
 
+#include "CM_Message.h"
 #include "KX_Globals.h"
 #include "KX_KetsjiEngine.h"
 #include "RAS_ICanvas.h"
 #include "RAS_OpenGLDebugDraw.h"
 
+/// Corners of a box in the order of MT_FrustumBox, 1 for the maximum.
+static const unsigned short boxCorners[8][3] = {
+    {0, 0, 0}, {0, 1, 0}, {1, 1, 0}, {1, 0, 0}, {0, 0, 1}, {0, 1, 1}, {1, 1, 1}, {1, 0, 1}};
+
+static const unsigned short boxEdges[12][2] = {{0, 1},
+                                               {1, 2},
+                                               {2, 3},
+                                               {3, 0},
+                                               {4, 5},
+                                               {5, 6},
+                                               {6, 7},
+                                               {7, 4},
+                                               {0, 4},
+                                               {1, 5},
+                                               {2, 6},
+                                               {3, 7}};
+
+/// Triangles of the faces of a box, counter-clockwise seen from outside.
+static const unsigned short boxTriangles[12][3] = {{0, 1, 2},
+                                                   {2, 3, 0},
+                                                   {4, 7, 6},
+                                                   {6, 5, 4},
+                                                   {0, 4, 5},
+                                                   {5, 1, 0},
+                                                   {1, 5, 6},
+                                                   {6, 2, 1},
+                                                   {2, 6, 7},
+                                                   {7, 3, 2},
+                                                   {3, 7, 4},
+                                                   {4, 0, 3}};
+
+static struct {
+  GPUVertFormat format;
+  unsigned int pos;
+  unsigned int color;
+} debugFormat = {{0}};
+
+RAS_OpenGLDebugDraw::Batch::Batch(unsigned short primVerts)
+    : m_primVerts(primVerts), m_batch(nullptr)
+{
+}
+
+unsigned int RAS_OpenGLDebugDraw::Batch::GetNumVertices() const
+{
+  return m_positions.size() / 3;
+}
+
+void RAS_OpenGLDebugDraw::Batch::AddVertex(float x, float y, float z, const MT_Vector4 &color)
+{
+  m_positions.insert(m_positions.end(), {x, y, z});
+  m_colors.insert(m_colors.end(), color.getValue(), color.getValue() + 4);
+}
+
+void RAS_OpenGLDebugDraw::Batch::AddVertex(const MT_Vector3 &pos, const MT_Vector4 &color)
+{
+  AddVertex(pos.x(), pos.y(), pos.z(), color);
+}
+
+void RAS_OpenGLDebugDraw::Batch::Clear()
+{
+  m_positions.clear();
+  m_colors.clear();
+}
+
+bool RAS_OpenGLDebugDraw::Batch::Clamp(unsigned int capacity)
+{
+  const unsigned int maxVertices = capacity * m_primVerts;
+  if (GetNumVertices() <= maxVertices) {
+    return true;
+  }
+
+  m_positions.resize(maxVertices * 3);
+  m_colors.resize(maxVertices * 4);
+  return false;
+}
+
 RAS_OpenGLDebugDraw::RAS_OpenGLDebugDraw()
+    : m_lines(2), m_triangles(3), m_lines2D(2), m_triangles2D(3), m_capacityWarning(false)
 {
 }
 
 RAS_OpenGLDebugDraw::~RAS_OpenGLDebugDraw()
 {
+  for (Batch *batch : {&m_lines, &m_triangles, &m_lines2D, &m_triangles2D}) {
+    GPU_BATCH_DISCARD_SAFE(batch->m_batch);
+  }
 }
 
-void RAS_OpenGLDebugDraw::BindVBO(float *mvp, float color[4], float *vertexes, unsigned int ibo)
+void RAS_OpenGLDebugDraw::AddBox(const MT_Vector3 vertices[8], const MT_Vector4 &color)
 {
+  for (const unsigned short(&edge)[2] : boxEdges) {
+    m_lines.AddVertex(vertices[edge[0]], color);
+    m_lines.AddVertex(vertices[edge[1]], color);
+  }
 }
 
-void RAS_OpenGLDebugDraw::UnbindVBO()
+void RAS_OpenGLDebugDraw::AddSolidBox(const MT_Vector3 vertices[8],
+                                      const MT_Vector4 &insideColor,
+                                      const MT_Vector4 &outsideColor)
 {
+  /* The frustum boxes come from a projection which can mirror the box, the winding of the
+   * faces is then reversed to keep the outside faces counter-clockwise. */
+  const bool mirrored = MT_triple(vertices[3] - vertices[0],
+                                  vertices[1] - vertices[0],
+                                  vertices[4] - vertices[0]) < 0.0f;
+
+  /* The inside faces are the outside ones with the opposite winding, with the back faces
+   * culled a single batch shows the outside or the inside color of each face. */
+  for (const unsigned short(&tri)[3] : boxTriangles) {
+    for (unsigned short i = 0; i < 3; ++i) {
+      m_triangles.AddVertex(vertices[tri[mirrored ? 2 - i : i]], outsideColor);
+    }
+    for (unsigned short i = 0; i < 3; ++i) {
+      m_triangles.AddVertex(vertices[tri[mirrored ? i : 2 - i]], insideColor);
+    }
+  }
+}
+
+void RAS_OpenGLDebugDraw::FillBatches(RAS_DebugDraw *debugDraw,
+                                      RAS_ICanvas *canvas,
+                                      bool viewportRender)
+{
+  for (const RAS_DebugDraw::Line &line : debugDraw->m_lines) {
+    m_lines.AddVertex(line.m_from, line.m_color);
+    m_lines.AddVertex(line.m_to, line.m_color);
+  }
+
+  for (const RAS_DebugDraw::Circle &circle : debugDraw->m_circles) {
+    const MT_Vector3 normal = circle.m_normal.safe_normalized();
+    // Any axis not aligned with the normal gives the plane of the circle.
+    const MT_Vector3 axis = (std::fabs(normal.z()) < 0.9f) ? MT_Vector3(0.0f, 0.0f, 1.0f) :
+                                                              MT_Vector3(1.0f, 0.0f, 0.0f);
+    const MT_Vector3 xaxis = normal.cross(axis).safe_normalized() * circle.m_radius;
+    const MT_Vector3 yaxis = normal.cross(xaxis);
+
+    MT_Vector3 prev = circle.m_center + xaxis;
+    for (int i = 1; i <= circle.m_sector; ++i) {
+      const float angle = MT_2_PI * i / circle.m_sector;
+      const MT_Vector3 pos = circle.m_center + xaxis * cosf(angle) + yaxis * sinf(angle);
+      m_lines.AddVertex(prev, circle.m_color);
+      m_lines.AddVertex(pos, circle.m_color);
+      prev = pos;
+    }
+  }
+
+  for (const RAS_DebugDraw::Aabb &aabb : debugDraw->m_aabbs) {
+    MT_Vector3 vertices[8];
+    for (unsigned short i = 0; i < 8; ++i) {
+      const MT_Vector3 corner(boxCorners[i][0] ? aabb.m_max.x() : aabb.m_min.x(),
+                              boxCorners[i][1] ? aabb.m_max.y() : aabb.m_min.y(),
+                              boxCorners[i][2] ? aabb.m_max.z() : aabb.m_min.z());
+      vertices[i] = aabb.m_pos + aabb.m_rot * corner;
+    }
+    AddBox(vertices, aabb.m_color);
+  }
+
+  for (const RAS_DebugDraw::Box &box : debugDraw->m_boxes) {
+    AddBox(box.m_vertices.data(), box.m_color);
+  }
+
+  for (const RAS_DebugDraw::SolidBox &box : debugDraw->m_solidBoxes) {
+    AddSolidBox(box.m_vertices.data(), box.m_insideColor, box.m_outsideColor);
+    AddBox(box.m_vertices.data(), box.m_color);
+  }
+
+  // The viewport render draws the 2D shapes with the draw manager.
+  if (!viewportRender) {
+    const unsigned int height = canvas->GetHeight();
+
+    for (const RAS_DebugDraw::Line2D &line2d : debugDraw->m_lines2D) {
+      m_lines2D.AddVertex(line2d.m_from.x(), height - line2d.m_from.y(), 0.0f, line2d.m_color);
+      m_lines2D.AddVertex(line2d.m_to.x(), height - line2d.m_to.y(), 0.0f, line2d.m_color);
+    }
+
+    for (const RAS_DebugDraw::Box2D &box2d : debugDraw->m_boxes2D) {
+      const float xmin = box2d.m_pos.x();
+      const float ymin = height - box2d.m_pos.y();
+      const float xmax = xmin + 1 + box2d.m_size.x();
+      const float ymax = ymin + box2d.m_size.y();
+      const MT_Vector4 &color = box2d.m_color;
+
+      m_triangles2D.AddVertex(xmax, ymax, 0.0f, color);
+      m_triangles2D.AddVertex(xmin, ymax, 0.0f, color);
+      m_triangles2D.AddVertex(xmin, ymin, 0.0f, color);
+      m_triangles2D.AddVertex(xmax, ymax, 0.0f, color);
+      m_triangles2D.AddVertex(xmin, ymin, 0.0f, color);
+      m_triangles2D.AddVertex(xmax, ymin, 0.0f, color);
+    }
+  }
+
+  const unsigned int capacity = debugDraw->m_capacity;
+  bool fit = true;
+  for (Batch *batch : {&m_lines, &m_triangles, &m_lines2D, &m_triangles2D}) {
+    fit &= batch->Clamp(capacity);
+  }
+  if (!fit && !m_capacityWarning) {
+    CM_Warning("the debug shapes exceed the capacity of " << capacity << " primitives");
+    m_capacityWarning = true;
+  }
+}
+
+void RAS_OpenGLDebugDraw::DrawBatch(Batch &batch)
+{
+  const unsigned int numVerts = batch.GetNumVertices();
+  if (numVerts == 0) {
+    return;
+  }
+
+  if (debugFormat.format.attr_len == 0) {
+    debugFormat.pos = GPU_vertformat_attr_add(
+        &debugFormat.format, "pos", GPU_COMP_F32, 3, GPU_FETCH_FLOAT);
+    debugFormat.color = GPU_vertformat_attr_add(
+        &debugFormat.format, "color", GPU_COMP_F32, 4, GPU_FETCH_FLOAT);
+  }
+
+  GPUVertBuf *vbo;
+  if (!batch.m_batch) {
+    vbo = GPU_vertbuf_create_with_format_ex(&debugFormat.format, GPU_USAGE_STREAM);
+    GPU_vertbuf_data_alloc(vbo, numVerts);
+    batch.m_batch = GPU_batch_create_ex((batch.m_primVerts == 2) ? GPU_PRIM_LINES : GPU_PRIM_TRIS,
+                                        vbo,
+                                        nullptr,
+                                        GPU_BATCH_OWNS_VBO);
+    GPU_batch_program_set_builtin(batch.m_batch, GPU_SHADER_3D_FLAT_COLOR);
+  }
+  else {
+    vbo = batch.m_batch->verts[0];
+    // Grow by half to not reallocate at each frame for a growing number of shapes.
+    if (GPU_vertbuf_get_vertex_alloc(vbo) < numVerts) {
+      GPU_vertbuf_data_resize(vbo, numVerts + numVerts / 2);
+    }
+  }
+
+  // Only the vertices used by this frame are uploaded.
+  GPU_vertbuf_data_len_set(vbo, numVerts);
+  GPU_vertbuf_attr_fill(vbo, debugFormat.pos, batch.m_positions.data());
+  GPU_vertbuf_attr_fill(vbo, debugFormat.color, batch.m_colors.data());
+
+  GPU_batch_draw(batch.m_batch);
 }
 
 void RAS_OpenGLDebugDraw::Flush(RAS_Rasterizer *rasty,
                                 RAS_ICanvas *canvas,
                                 RAS_DebugDraw *debugDraw)
 {
-  //// Draw aabbs USE imm API
-  // for (const RAS_DebugDraw::Aabb &aabb : debugDraw->m_aabbs) {
-
-  //  const MT_Matrix3x3 &rot = aabb.m_rot;
-  //  const MT_Vector3 &pos = aabb.m_pos;
-  //  float mat[16] = {rot[0][0],
-  //                   rot[1][0],
-  //                   rot[2][0],
-  //                   0.0,
-  //                   rot[0][1],
-  //                   rot[1][1],
-  //                   rot[2][1],
-  //                   0.0,
-  //                   rot[0][2],
-  //                   rot[1][2],
-  //                   rot[2][2],
-  //                   0.0,
-  //                   pos[0],
-  //                   pos[1],
-  //                   pos[2],
-  //                   1.0};
-
-  //  const MT_Vector3 &min = aabb.m_min;
-  //  const MT_Vector3 &max = aabb.m_max;
-
-  //  GLfloat vertexes[24] = {
-  //      (float)min[0], (float)min[1], (float)min[2], (float)max[0], (float)min[1], (float)min[2],
-  //      (float)max[0], (float)max[1], (float)min[2], (float)min[0], (float)max[1], (float)min[2],
-  //      (float)min[0], (float)min[1], (float)max[2], (float)max[0], (float)min[1], (float)max[2],
-  //      (float)max[0], (float)max[1], (float)max[2], (float)min[0], (float)max[1],
-  //      (float)max[2]};
-
-  //  // rasty->PushMatrix();
-  //  // rasty->MultMatrix(mat);
-
-  //  float c[4];
-  //  aabb.m_color.getValue(c);
-
-  //  float mvp[16];
-  //  MT_Matrix4x4 obmat(mat);
-  //  MT_Matrix4x4 m(m_cameraMatrix * obmat);
-  //  m.getValue(mvp);
-
-  //  /*BindVBO(mvp, c, vertexes, m_wireibo);
-  //  glDrawElements(GL_LINES, 24, GL_UNSIGNED_BYTE, 0);
-  //  UnbindVBO();*/
-  //}
-
-  //// Draw boxes. USE imm API
-  // for (const RAS_DebugDraw::SolidBox &box : debugDraw->m_solidBoxes) {
-  //  GLfloat vertexes[24];
-  //  int k = 0;
-  //  for (int i = 0; i < 8; i++) {
-  //    for (int j = 0; j < 3; j++) {
-  //      vertexes[k] = box.m_vertices[i][j];
-  //      k++;
-  //    }
-  //  }
-  //  float c[4];
-  //  box.m_color.getValue(c);
-  //  /*BindVBO(mvp, c, vertexes, m_wireibo);
-  //  glDrawElements(GL_LINES, 24, GL_UNSIGNED_BYTE, 0);
-  //  UnbindVBO();*/
-
-  //  //rasty->SetFrontFace(false);
-  //  //GPU_front_facing(bool invert)
-  //  box.m_insideColor.getValue(c);
-  //  /*BindVBO(mvp, c, vertexes, m_solidibo);
-  //  glDrawElements(GL_TRIANGLES, 36, GL_UNSIGNED_BYTE, 0);
-  //  UnbindVBO();*/
-
-  //  //rasty->SetFrontFace(true);
-  //  //GPU_front_facing(bool invert);
-  //  box.m_outsideColor.getValue(c);
-  //  /*BindVBO(mvp, c, vertexes, m_solidibo);
-  //  glDrawElements(GL_TRIANGLES, 36, GL_UNSIGNED_BYTE, 0);
-  //  UnbindVBO();*/
-  //}
-
-  if (KX_GetActiveEngine()->UseViewportRender()) {
-    /* Draw Debug lines */
-    if (!debugDraw->m_lines.empty()) {
-      for (int i = 0; i < debugDraw->m_lines.size(); i++) {
-        RAS_DebugDraw::Line l = debugDraw->m_lines[i];
-        DRW_debug_line_bge(l.m_from.getValue(), l.m_to.getValue(), l.m_color.getValue());
-      }
+  const bool viewportRender = KX_GetActiveEngine()->UseViewportRender();
+  FillBatches(debugDraw, canvas, viewportRender);
+
+  if (viewportRender) {
+    /* Draw Debug lines, the draw manager has no debug triangles for the solid boxes. */
+    if (m_lines.GetNumVertices() > 0) {
+      DRW_debug_lines_bge((const float(*)[3])m_lines.m_positions.data(),
+                          (const float(*)[4])m_lines.m_colors.data(),
+                          m_lines.GetNumVertices());
     }
     /* The Performances profiler */
     const unsigned int left = canvas->GetViewportArea().GetLeft();
@@ -152,6 +304,25 @@ void RAS_OpenGLDebugDraw::Flush(RAS_Rasterizer *rasty,
         DRW_debug_box_2D_bge(left + b.m_pos[0], top - b.m_pos[1], b.m_size[0], b.m_size[1]);
       }
     }
+    if (!debugDraw->m_lines2D.empty()) {
+      const unsigned int numVerts = debugDraw->m_lines2D.size() * 2;
+      std::vector<float> positions(numVerts * 2);
+      std::vector<float> colors(numVerts * 4);
+      float *pos = positions.data();
+      float *col = colors.data();
+      for (const RAS_DebugDraw::Line2D &l : debugDraw->m_lines2D) {
+        *pos++ = left + l.m_from[0];
+        *pos++ = top - l.m_from[1];
+        *pos++ = left + l.m_to[0];
+        *pos++ = top - l.m_to[1];
+        for (unsigned short i = 0; i < 2; ++i) {
+          l.m_color.getValue(col);
+          col += 4;
+        }
+      }
+      DRW_debug_lines_2D_bge(
+          (const float(*)[2])positions.data(), (const float(*)[4])colors.data(), numVerts);
+    }
     if (!debugDraw->m_texts2D.empty()) {
       for (const RAS_DebugDraw::Text2D &t : debugDraw->m_texts2D) {
         DRW_debug_text_2D_bge(left + t.m_pos[0], top - t.m_pos[1], t.m_text.c_str());
@@ -159,12 +330,7 @@ void RAS_OpenGLDebugDraw::Flush(RAS_Rasterizer *rasty,
     }
   }
   else {  // Non viewport render pipeline
-    if (!debugDraw->m_lines.empty()) {
-      GPUVertFormat *format = immVertexFormat();
-      uint pos = GPU_vertformat_attr_add(format, "pos", GPU_COMP_F32, 3, GPU_FETCH_FLOAT);
-      uint col = GPU_vertformat_attr_add(format, "color", GPU_COMP_F32, 4, GPU_FETCH_FLOAT);
-      immBindBuiltinProgram(GPU_SHADER_3D_FLAT_COLOR);
-
+    if (m_lines.GetNumVertices() > 0 || m_triangles.GetNumVertices() > 0) {
       bContext *C = KX_GetActiveEngine()->GetContext();
       RegionView3D *rv3d = CTX_wm_region_view3d(C);
       GPU_matrix_push();
@@ -173,18 +339,18 @@ void RAS_OpenGLDebugDraw::Flush(RAS_Rasterizer *rasty,
       GPU_matrix_set(rv3d->viewmat);
 
       GPU_depth_test(GPU_DEPTH_ALWAYS);
+
+      if (m_triangles.GetNumVertices() > 0) {
+        GPU_blend(GPU_BLEND_ALPHA);
+        GPU_face_culling(GPU_CULL_BACK);
+        DrawBatch(m_triangles);
+        GPU_face_culling(GPU_CULL_NONE);
+        GPU_blend(GPU_BLEND_NONE);
+      }
+
       GPU_line_smooth(true);
       GPU_line_width(1.0f);
-      immBegin(GPU_PRIM_LINES, 2 * debugDraw->m_lines.size());
-      for (int i = 0; i < debugDraw->m_lines.size(); i++) {
-        RAS_DebugDraw::Line line = debugDraw->m_lines[i];
-        const MT_Vector3 &min = line.m_from;
-        const MT_Vector3 &max = line.m_to;
-        immAttr4fv(col, line.m_color.getValue());
-        immVertex3fv(pos, min.getValue());
-        immVertex3fv(pos, max.getValue());
-      }
-      immEnd();
+      DrawBatch(m_lines);
 
       /* Reset defaults */
       GPU_line_smooth(false);
@@ -192,8 +358,6 @@ void RAS_OpenGLDebugDraw::Flush(RAS_Rasterizer *rasty,
       GPU_matrix_pop_projection();
       GPU_depth_test(GPU_DEPTH_ALWAYS);
       GPU_face_culling(GPU_CULL_NONE);
-
-      immUnbindProgram();
     }
 
 #ifdef WITH_PYTHON
@@ -206,27 +370,8 @@ void RAS_OpenGLDebugDraw::Flush(RAS_Rasterizer *rasty,
     /* The Performances profiler */
     const unsigned int height = canvas->GetHeight();
 
-    if (!debugDraw->m_boxes2D.empty()) {
-      GPU_face_culling(GPU_CULL_BACK);
-
-      GPUVertFormat *format = immVertexFormat();
-      uint pos = GPU_vertformat_attr_add(format, "pos", GPU_COMP_F32, 2, GPU_FETCH_FLOAT);
-
-      immBindBuiltinProgram(GPU_SHADER_2D_UNIFORM_COLOR);
-      for (const RAS_DebugDraw::Box2D &box2d : debugDraw->m_boxes2D) {
-        const float xco = box2d.m_pos.x();
-        const float yco = height - box2d.m_pos.y();
-        const float xsize = box2d.m_size.x();
-        const float ysize = box2d.m_size.y();
-
-        immUniformColor4fv(box2d.m_color.getValue());
-        immRectf(pos, xco + 1 + xsize, yco + ysize, xco, yco);
-      }
-      immUnbindProgram();
-
-      DRW_state_reset();
-      GPU_depth_test(GPU_DEPTH_ALWAYS);
-    }
+    DrawBatch(m_triangles2D);
+    DrawBatch(m_lines2D);
 
     if (!debugDraw->m_texts2D.empty()) {
 
@@ -254,4 +399,8 @@ void RAS_OpenGLDebugDraw::Flush(RAS_Rasterizer *rasty,
       GPU_face_culling(GPU_CULL_NONE);
     }
   }
+
+  for (Batch *batch : {&m_lines, &m_triangles, &m_lines2D, &m_triangles2D}) {
+    batch->Clear();
+  }
 }
@@ -26,23 +26,58 @@
 
 #pragma once
 
+#include <vector>
+
 #include "MT_Matrix4x4.h"
+#include "MT_Vector3.h"
+#include "MT_Vector4.h"
 
 class RAS_Rasterizer;
 class RAS_ICanvas;
 class RAS_DebugDraw;
+struct GPUBatch;
 
 class RAS_OpenGLDebugDraw {
 
  private:
-  MT_Matrix4x4 m_cameraMatrix;
+  /** Vertices of a primitive type gathered from the debug shapes of the frame and the
+   * persistent batch they are uploaded to, its vertex buffer only grows.
+   */
+  struct Batch {
+    Batch(unsigned short primVerts);
+
+    /// Number of vertices per primitive.
+    unsigned short m_primVerts;
+    std::vector<float> m_positions;
+    std::vector<float> m_colors;
+    GPUBatch *m_batch;
+
+    unsigned int GetNumVertices() const;
+    void AddVertex(float x, float y, float z, const MT_Vector4 &color);
+    void AddVertex(const MT_Vector3 &pos, const MT_Vector4 &color);
+    void Clear();
+    /// Drop the primitives over the capacity, return false if any was dropped.
+    bool Clamp(unsigned int capacity);
+  };
+
+  Batch m_lines;
+  Batch m_triangles;
+  Batch m_lines2D;
+  Batch m_triangles2D;
+
+  /// True once the shapes over the capacity were reported.
+  bool m_capacityWarning;
+
+  void AddBox(const MT_Vector3 vertices[8], const MT_Vector4 &color);
+  void AddSolidBox(const MT_Vector3 vertices[8],
+                   const MT_Vector4 &insideColor,
+                   const MT_Vector4 &outsideColor);
+  void FillBatches(RAS_DebugDraw *debugDraw, RAS_ICanvas *canvas, bool viewportRender);
+  void DrawBatch(Batch &batch);
 
  public:
   RAS_OpenGLDebugDraw();
   ~RAS_OpenGLDebugDraw();
 
-  void BindVBO(float *mvp, float color[4], float *vertexes, unsigned int ibo);
-  void UnbindVBO();
-
   void Flush(RAS_Rasterizer *rasty, RAS_ICanvas *canvas, RAS_DebugDraw *debugDraw);
 };
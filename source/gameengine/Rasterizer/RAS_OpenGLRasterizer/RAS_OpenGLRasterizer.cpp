@@ -31,6 +31,8 @@
 
 #include "RAS_OpenGLRasterizer.h"
 
+#include <algorithm>
+
 #include "GPU_glew.h"
 #include "GPU_state.h"
 
@@ -152,12 +154,14 @@ inline void RAS_OpenGLRasterizer::ScreenPlane::Render()
   glBindVertexArray(0);
 }
 
-RAS_OpenGLRasterizer::RAS_OpenGLRasterizer(RAS_Rasterizer *rasterizer) : m_rasterizer(rasterizer)
+RAS_OpenGLRasterizer::RAS_OpenGLRasterizer(RAS_Rasterizer *rasterizer)
+    : m_gpuTimerFrame(0), m_rasterizer(rasterizer)
 {
 }
 
 RAS_OpenGLRasterizer::~RAS_OpenGLRasterizer()
 {
+  FreeGpuTimers();
 }
 
 unsigned short RAS_OpenGLRasterizer::GetNumLights() const
@@ -392,3 +396,89 @@ void RAS_OpenGLRasterizer::PrintHardwareInfo()
 
   CM_Message(" GL_ARB_draw_instanced supported?  " << (GLEW_ARB_draw_instanced ? "yes." : "no."));
 }
+
+void RAS_OpenGLRasterizer::BeginGpuTimer(const std::string &name)
+{
+  GpuTimerFrame &frame = m_gpuTimerFrames[m_gpuTimerFrame];
+  const unsigned int index = frame.m_numTimers++;
+  if (frame.m_queries.size() < frame.m_numTimers * 2) {
+    frame.m_queries.resize(frame.m_numTimers * 2);
+    frame.m_names.resize(frame.m_numTimers);
+    glGenQueries(2, &frame.m_queries[index * 2]);
+  }
+
+  frame.m_names[index] = name;
+  glQueryCounter(frame.m_queries[index * 2], GL_TIMESTAMP);
+  m_gpuTimerStack.push_back(index);
+}
+
+void RAS_OpenGLRasterizer::EndGpuTimer()
+{
+  if (m_gpuTimerStack.empty()) {
+    return;
+  }
+
+  GpuTimerFrame &frame = m_gpuTimerFrames[m_gpuTimerFrame];
+  glQueryCounter(frame.m_queries[m_gpuTimerStack.back() * 2 + 1], GL_TIMESTAMP);
+  m_gpuTimerStack.pop_back();
+}
+
+void RAS_OpenGLRasterizer::ResolveGpuTimers()
+{
+  // Close the timers left open to keep all the queries of the frame valid.
+  while (!m_gpuTimerStack.empty()) {
+    EndGpuTimer();
+  }
+
+  m_gpuTimerFrame = (m_gpuTimerFrame + 1) % GPU_TIMER_FRAMES;
+
+  /* The oldest frame is reused for the next frame, its results are read now.
+   * After several frames the queries are most likely available and reading them doesn't stall. */
+  GpuTimerFrame &frame = m_gpuTimerFrames[m_gpuTimerFrame];
+  if (frame.m_numTimers == 0) {
+    return;
+  }
+
+  m_gpuTimes.clear();
+  for (unsigned int i = 0; i < frame.m_numTimers; ++i) {
+    GLuint64 start, end;
+    glGetQueryObjectui64v(frame.m_queries[i * 2], GL_QUERY_RESULT, &start);
+    glGetQueryObjectui64v(frame.m_queries[i * 2 + 1], GL_QUERY_RESULT, &end);
+    const double time = (end - start) * 1.0e-6;
+
+    // Sum the timers of same name, e.g a filter pass rendered for several cameras.
+    const std::string &name = frame.m_names[i];
+    RAS_Rasterizer::GpuTimes::iterator it = std::find_if(
+        m_gpuTimes.begin(), m_gpuTimes.end(), [&name](const std::pair<std::string, double> &pair) {
+          return pair.first == name;
+        });
+    if (it == m_gpuTimes.end()) {
+      m_gpuTimes.emplace_back(name, time);
+    }
+    else {
+      it->second += time;
+    }
+  }
+
+  frame.m_numTimers = 0;
+}
+
+void RAS_OpenGLRasterizer::FreeGpuTimers()
+{
+  for (GpuTimerFrame &frame : m_gpuTimerFrames) {
+    if (!frame.m_queries.empty()) {
+      glDeleteQueries(frame.m_queries.size(), frame.m_queries.data());
+    }
+    frame.m_queries.clear();
+    frame.m_names.clear();
+    frame.m_numTimers = 0;
+  }
+
+  m_gpuTimerStack.clear();
+  m_gpuTimes.clear();
+}
+
+const RAS_Rasterizer::GpuTimes &RAS_OpenGLRasterizer::GetGpuTimes() const
+{
+  return m_gpuTimes;
+}
@@ -58,6 +58,26 @@ class RAS_OpenGLRasterizer {
   /// Class used to render a screen plane.
   ScreenPlane m_screenPlane;
 
+  enum {
+    /// Number of frames of timer queries in flight, the results are read this many frames later.
+    GPU_TIMER_FRAMES = 4
+  };
+
+  /// Timestamp queries of all the timers of a frame.
+  struct GpuTimerFrame {
+    /// Pairs of start and end queries.
+    std::vector<unsigned int> m_queries;
+    std::vector<std::string> m_names;
+    unsigned int m_numTimers = 0;
+  };
+
+  GpuTimerFrame m_gpuTimerFrames[GPU_TIMER_FRAMES];
+  unsigned int m_gpuTimerFrame;
+  /// Indices of the started timers of the current frame.
+  std::vector<unsigned int> m_gpuTimerStack;
+  /// Last read times in ms.
+  RAS_Rasterizer::GpuTimes m_gpuTimes;
+
   RAS_Rasterizer *m_rasterizer;
 
  public:
@@ -112,4 +132,10 @@ class RAS_OpenGLRasterizer {
   void PrintHardwareInfo();
 
   const unsigned char *GetGraphicsCardVendor();
+
+  void BeginGpuTimer(const std::string &name);
+  void EndGpuTimer();
+  void ResolveGpuTimers();
+  void FreeGpuTimers();
+  const RAS_Rasterizer::GpuTimes &GetGpuTimes() const;
 };
@@ -0,0 +1,72 @@
+/* Test the world bounding boxes against the max depth pyramid of the last render, a box is
+ * occluded when its nearest depth is behind the farthest depth of all the texels it covers. */
+
+layout(local_size_x = 64) in;
+
+layout(std430, binding = 0) readonly buffer boundsBuffer
+{
+  /* Minimum and maximum corners of each box. */
+  vec4 bounds[];
+};
+
+layout(r32ui, binding = 0) writeonly uniform uimage2D visibilityImage;
+
+uniform sampler2D maxzBuffer;
+uniform mat4 ViewProjectionMatrix;
+uniform vec2 viewportSize;
+uniform vec2 hizUvScale;
+uniform int boundsCount;
+uniform int maxLevel;
+
+void main(void)
+{
+  int index = int(gl_GlobalInvocationID.x);
+  if (index >= boundsCount) {
+    return;
+  }
+
+  ivec2 texel = ivec2(index % imageSize(visibilityImage).x, index / imageSize(visibilityImage).x);
+
+  vec3 bmin = bounds[index * 2].xyz;
+  vec3 bmax = bounds[index * 2 + 1].xyz;
+
+  vec3 ndcMin = vec3(1e30);
+  vec3 ndcMax = vec3(-1e30);
+  for (int i = 0; i < 8; i++) {
+    vec3 corner = vec3(((i & 1) != 0) ? bmax.x : bmin.x,
+                       ((i & 2) != 0) ? bmax.y : bmin.y,
+                       ((i & 4) != 0) ? bmax.z : bmin.z);
+    vec4 clip = ViewProjectionMatrix * vec4(corner, 1.0);
+    /* The box crosses the camera plane. */
+    if (clip.w <= 0.0) {
+      imageStore(visibilityImage, texel, uvec4(1u));
+      return;
+    }
+    vec3 ndc = clip.xyz / clip.w;
+    ndcMin = min(ndcMin, ndc);
+    ndcMax = max(ndcMax, ndc);
+  }
+
+  float depth = ndcMin.z * 0.5 + 0.5;
+  vec2 uvMin = clamp(ndcMin.xy * 0.5 + 0.5, 0.0, 1.0);
+  vec2 uvMax = clamp(ndcMax.xy * 0.5 + 0.5, 0.0, 1.0);
+
+  /* At this level the box rectangle covers at most 2x2 texels. */
+  vec2 size = (uvMax - uvMin) * viewportSize;
+  int level = int(ceil(log2(max(max(size.x, size.y), 1.0))));
+  if (depth <= 0.0 || level > maxLevel) {
+    imageStore(visibilityImage, texel, uvec4(1u));
+    return;
+  }
+
+  ivec2 levelSize = textureSize(maxzBuffer, level);
+  ivec2 texMin = min(ivec2(uvMin * hizUvScale * vec2(levelSize)), levelSize - 1);
+  ivec2 texMax = min(ivec2(uvMax * hizUvScale * vec2(levelSize)), levelSize - 1);
+
+  float maxDepth = max(max(texelFetch(maxzBuffer, texMin, level).r,
+                           texelFetch(maxzBuffer, ivec2(texMax.x, texMin.y), level).r),
+                       max(texelFetch(maxzBuffer, ivec2(texMin.x, texMax.y), level).r,
+                           texelFetch(maxzBuffer, texMax, level).r));
+
+  imageStore(visibilityImage, texel, uvec4((depth <= maxDepth) ? 1u : 0u));
+}
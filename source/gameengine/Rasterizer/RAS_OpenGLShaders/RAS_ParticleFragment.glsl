@@ -0,0 +1,16 @@
+/* Round soft particle. */
+
+in vec4 finalColor;
+in vec2 uv;
+
+out vec4 fragColor;
+
+void main(void)
+{
+  float dist = dot(uv, uv);
+  if (dist >= 1.0) {
+    discard;
+  }
+
+  fragColor = vec4(finalColor.rgb, finalColor.a * (1.0 - dist));
+}
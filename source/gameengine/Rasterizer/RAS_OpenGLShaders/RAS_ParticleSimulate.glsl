@@ -0,0 +1,149 @@
+/* Step the particles of an emitter, the slots of the emission ring are respawned at the
+ * emitter. The particles behind the depth of the last render bounce on its surface. */
+
+layout(local_size_x = 64) in;
+
+struct Particle {
+  /* World position and age in seconds. */
+  vec4 positionAge;
+  /* World velocity and lifetime in seconds, the particle is dead once its age exceeds it. */
+  vec4 velocityLife;
+};
+
+layout(std430, binding = 0) buffer particleBuffer
+{
+  Particle particles[];
+};
+
+uniform mat4 emitterMatrix;
+uniform vec3 emitVelocity;
+uniform float emitRandomVelocity;
+uniform float emitRadius;
+uniform float lifetime;
+uniform float lifetimeRandom;
+uniform vec3 gravity;
+uniform float damping;
+uniform float timeStep;
+uniform int particleCount;
+uniform int emitStart;
+uniform int emitCount;
+uniform int seed;
+
+uniform int useCollision;
+uniform sampler2D depthBuffer;
+uniform mat4 ViewProjectionMatrix;
+uniform mat4 ViewProjectionMatrixInverse;
+uniform vec2 depthUvScale;
+uniform vec3 cameraPosition;
+uniform float bounce;
+uniform float collisionThickness;
+
+float random(inout uint state)
+{
+  state ^= state >> 16;
+  state *= 0x7feb352du;
+  state ^= state >> 15;
+  state *= 0x846ca68bu;
+  state ^= state >> 16;
+  return float(state) / 4294967295.0;
+}
+
+vec3 random_in_sphere(inout uint state)
+{
+  float z = random(state) * 2.0 - 1.0;
+  float phi = random(state) * 6.2831853;
+  float r = sqrt(max(1.0 - z * z, 0.0));
+  return vec3(r * cos(phi), r * sin(phi), z) * pow(random(state), 1.0 / 3.0);
+}
+
+vec3 unproject(vec2 uv, float depth)
+{
+  vec4 world = ViewProjectionMatrixInverse * vec4(vec3(uv, depth) * 2.0 - 1.0, 1.0);
+  return world.xyz / world.w;
+}
+
+float scene_depth(vec2 uv)
+{
+  return texture(depthBuffer, uv * depthUvScale).r;
+}
+
+void collide(inout vec3 pos, inout vec3 vel)
+{
+  vec4 clip = ViewProjectionMatrix * vec4(pos, 1.0);
+  if (clip.w <= 0.0) {
+    return;
+  }
+
+  vec3 ndc = clip.xyz / clip.w;
+  if (any(greaterThan(abs(ndc.xy), vec2(1.0)))) {
+    return;
+  }
+
+  vec2 uv = ndc.xy * 0.5 + 0.5;
+  float depth = scene_depth(uv);
+  /* In front of the surface or behind the far plane. */
+  if (ndc.z * 0.5 + 0.5 <= depth || depth >= 1.0) {
+    return;
+  }
+
+  vec3 surface = unproject(uv, depth);
+  if (distance(pos, surface) > collisionThickness) {
+    return;
+  }
+
+  /* The surface normal is rebuilt from the neighbor depths. */
+  vec2 texel = 1.0 / vec2(textureSize(depthBuffer, 0));
+  vec2 uvx = uv + vec2(texel.x, 0.0);
+  vec2 uvy = uv + vec2(0.0, texel.y);
+  vec3 normal = cross(unproject(uvx, scene_depth(uvx)) - surface,
+                      unproject(uvy, scene_depth(uvy)) - surface);
+  if (dot(normal, normal) < 1e-12) {
+    return;
+  }
+  normal = normalize(normal);
+  if (dot(normal, cameraPosition - surface) < 0.0) {
+    normal = -normal;
+  }
+
+  pos = surface + normal * 1e-3;
+  if (dot(vel, normal) < 0.0) {
+    vel = reflect(vel, normal) * bounce;
+  }
+}
+
+void main(void)
+{
+  int index = int(gl_GlobalInvocationID.x);
+  if (index >= particleCount) {
+    return;
+  }
+
+  Particle p = particles[index];
+
+  int slot = (index - emitStart + particleCount) % particleCount;
+  if (slot < emitCount) {
+    uint state = uint(index) * 747796405u + uint(seed) * 2891336453u;
+    vec3 local = random_in_sphere(state) * emitRadius;
+    vec3 vel = mat3(emitterMatrix) * emitVelocity + random_in_sphere(state) * emitRandomVelocity;
+    float life = lifetime * (1.0 + lifetimeRandom * (random(state) * 2.0 - 1.0));
+    /* Spread the births over the step to avoid emitting in bursts. */
+    float age = random(state) * timeStep;
+    p.positionAge = vec4((emitterMatrix * vec4(local, 1.0)).xyz + vel * age, age);
+    p.velocityLife = vec4(vel, max(life, 1e-3));
+  }
+  else if (p.positionAge.w >= p.velocityLife.w) {
+    return;
+  }
+  else {
+    vec3 vel = p.velocityLife.xyz + gravity * timeStep;
+    vel *= max(1.0 - damping * timeStep, 0.0);
+    vec3 pos = p.positionAge.xyz + vel * timeStep;
+    if (useCollision != 0) {
+      collide(pos, vel);
+    }
+    p.positionAge = vec4(pos, p.positionAge.w + timeStep);
+    p.velocityLife.xyz = vel;
+  }
+
+  particles[index] = p;
+}
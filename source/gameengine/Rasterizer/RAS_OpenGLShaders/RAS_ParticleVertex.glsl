@@ -0,0 +1,36 @@
+/* Draw a particle as a billboard facing the camera, its size and color are interpolated
+ * over its life. */
+
+in vec2 corner;
+/* Instance attributes read from the simulated particles. */
+in vec4 positionAge;
+in vec4 velocityLife;
+
+uniform mat4 ViewProjectionMatrix;
+uniform vec3 cameraRight;
+uniform vec3 cameraUp;
+uniform float sizeStart;
+uniform float sizeEnd;
+uniform vec4 colorStart;
+uniform vec4 colorEnd;
+
+out vec4 finalColor;
+out vec2 uv;
+
+void main(void)
+{
+  if (positionAge.w >= velocityLife.w) {
+    /* Dead particle, outside of the clip volume. */
+    gl_Position = vec4(0.0, 0.0, -2.0, 1.0);
+    finalColor = vec4(0.0);
+    uv = vec2(0.0);
+    return;
+  }
+
+  float t = positionAge.w / velocityLife.w;
+  float size = mix(sizeStart, sizeEnd, t) * 0.5;
+  vec3 pos = positionAge.xyz + (cameraRight * corner.x + cameraUp * corner.y) * size;
+  gl_Position = ViewProjectionMatrix * vec4(pos, 1.0);
+  finalColor = mix(colorStart, colorEnd, t);
+  uv = corner;
+}
@@ -0,0 +1,229 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Rasterizer/RAS_ParticleSystem.cpp
+ *  \ingroup bgerast
+ */
+
+#include "RAS_ParticleSystem.h"
+
+#include <vector>
+
+#include "GPU_batch.h"
+#include "GPU_capabilities.h"
+#include "GPU_compute.h"
+#include "GPU_shader.h"
+#include "GPU_state.h"
+#include "GPU_texture.h"
+#include "GPU_vertex_buffer.h"
+
+extern "C" {
+extern char datatoc_RAS_ParticleSimulate_glsl[];
+extern char datatoc_RAS_ParticleVertex_glsl[];
+extern char datatoc_RAS_ParticleFragment_glsl[];
+}
+
+/// Number of particles stepped by a compute work group.
+static const int groupSize = 64;
+
+/// The shaders are shared by all the particle systems and freed with the last one.
+static GPUShader *simulateShader = nullptr;
+static GPUShader *drawShader = nullptr;
+static unsigned int particleSystemUsers = 0;
+
+RAS_ParticleSystem::RAS_ParticleSystem(unsigned int maxParticles)
+    : m_maxParticles(maxParticles),
+      m_particleBuffer(nullptr),
+      m_batch(nullptr),
+      m_emitCursor(0),
+      m_seed(0)
+{
+  ++particleSystemUsers;
+}
+
+RAS_ParticleSystem::~RAS_ParticleSystem()
+{
+  GPU_BATCH_DISCARD_SAFE(m_batch);
+  GPU_VERTBUF_DISCARD_SAFE(m_particleBuffer);
+
+  if (--particleSystemUsers == 0) {
+    if (simulateShader) {
+      GPU_shader_free(simulateShader);
+      simulateShader = nullptr;
+    }
+    if (drawShader) {
+      GPU_shader_free(drawShader);
+      drawShader = nullptr;
+    }
+  }
+}
+
+bool RAS_ParticleSystem::Supported()
+{
+  return GPU_compute_shader_support() && GPU_shader_storage_buffer_objects_support();
+}
+
+unsigned int RAS_ParticleSystem::GetMaxParticles() const
+{
+  return m_maxParticles;
+}
+
+bool RAS_ParticleSystem::Init()
+{
+  if (!simulateShader) {
+    simulateShader = GPU_shader_create_compute(
+        datatoc_RAS_ParticleSimulate_glsl, nullptr, nullptr, "RAS_ParticleSimulate");
+  }
+  if (!drawShader) {
+    drawShader = GPU_shader_create(datatoc_RAS_ParticleVertex_glsl,
+                                   datatoc_RAS_ParticleFragment_glsl,
+                                   nullptr,
+                                   nullptr,
+                                   nullptr,
+                                   "RAS_ParticleDraw");
+  }
+  if (!simulateShader || !drawShader) {
+    return false;
+  }
+
+  if (m_particleBuffer) {
+    return true;
+  }
+
+  // The particle layout matches the storage buffer structure of the simulation shader.
+  static GPUVertFormat particleFormat = {0};
+  if (particleFormat.attr_len == 0) {
+    GPU_vertformat_attr_add(&particleFormat, "positionAge", GPU_COMP_F32, 4, GPU_FETCH_FLOAT);
+    GPU_vertformat_attr_add(&particleFormat, "velocityLife", GPU_COMP_F32, 4, GPU_FETCH_FLOAT);
+  }
+  m_particleBuffer = GPU_vertbuf_create_with_format(&particleFormat);
+  GPU_vertbuf_data_alloc(m_particleBuffer, m_maxParticles);
+
+  // All the particles start dead, their age is over their null lifetime.
+  const std::vector<float> dead(m_maxParticles * 4, 1.0f);
+  const std::vector<float> null(m_maxParticles * 4, 0.0f);
+  GPU_vertbuf_attr_fill(m_particleBuffer, 0, dead.data());
+  GPU_vertbuf_attr_fill(m_particleBuffer, 1, null.data());
+
+  static GPUVertFormat cornerFormat = {0};
+  if (cornerFormat.attr_len == 0) {
+    GPU_vertformat_attr_add(&cornerFormat, "corner", GPU_COMP_F32, 2, GPU_FETCH_FLOAT);
+  }
+  GPUVertBuf *corners = GPU_vertbuf_create_with_format(&cornerFormat);
+  GPU_vertbuf_data_alloc(corners, 4);
+  const float cornerData[4][2] = {{-1.0f, -1.0f}, {1.0f, -1.0f}, {-1.0f, 1.0f}, {1.0f, 1.0f}};
+  GPU_vertbuf_attr_fill(corners, 0, cornerData);
+
+  m_batch = GPU_batch_create_ex(GPU_PRIM_TRI_STRIP, corners, nullptr, GPU_BATCH_OWNS_VBO);
+  GPU_batch_instbuf_set(m_batch, m_particleBuffer, false);
+
+  return true;
+}
+
+void RAS_ParticleSystem::Simulate(const Settings &settings,
+                                  float timeStep,
+                                  unsigned int emitCount,
+                                  GPUTexture *depthBuffer,
+                                  const MT_Matrix4x4 &viewProjection,
+                                  const MT_Vector3 &cameraPosition,
+                                  const float depthUvScale[2])
+{
+  if (!Init()) {
+    return;
+  }
+
+  if (emitCount > m_maxParticles) {
+    emitCount = m_maxParticles;
+  }
+
+  GPUShader *sh = simulateShader;
+  GPU_shader_bind(sh);
+  GPU_shader_uniform_mat4(sh, "emitterMatrix", settings.m_emitterMatrix);
+  GPU_shader_uniform_3fv(sh, "emitVelocity", settings.m_velocity);
+  GPU_shader_uniform_1f(sh, "emitRandomVelocity", settings.m_randomVelocity);
+  GPU_shader_uniform_1f(sh, "emitRadius", settings.m_radius);
+  GPU_shader_uniform_1f(sh, "lifetime", settings.m_lifetime);
+  GPU_shader_uniform_1f(sh, "lifetimeRandom", settings.m_lifetimeRandom);
+  GPU_shader_uniform_3fv(sh, "gravity", settings.m_gravity);
+  GPU_shader_uniform_1f(sh, "damping", settings.m_damping);
+  GPU_shader_uniform_1f(sh, "timeStep", timeStep);
+  GPU_shader_uniform_1i(sh, "particleCount", m_maxParticles);
+  GPU_shader_uniform_1i(sh, "emitStart", m_emitCursor);
+  GPU_shader_uniform_1i(sh, "emitCount", emitCount);
+  GPU_shader_uniform_1i(sh, "seed", m_seed++);
+
+  const bool collision = (settings.m_depthCollision && depthBuffer);
+  GPU_shader_uniform_1i(sh, "useCollision", collision);
+  if (collision) {
+    float mat[4][4];
+    float imat[4][4];
+    float campos[3];
+    viewProjection.getValue(&mat[0][0]);
+    viewProjection.inverse().getValue(&imat[0][0]);
+    cameraPosition.getValue(campos);
+    GPU_shader_uniform_mat4(sh, "ViewProjectionMatrix", mat);
+    GPU_shader_uniform_mat4(sh, "ViewProjectionMatrixInverse", imat);
+    GPU_shader_uniform_2f(sh, "depthUvScale", depthUvScale[0], depthUvScale[1]);
+    GPU_shader_uniform_3fv(sh, "cameraPosition", campos);
+    GPU_shader_uniform_1f(sh, "bounce", settings.m_bounce);
+    GPU_shader_uniform_1f(sh, "collisionThickness", settings.m_collisionThickness);
+    GPU_texture_bind(depthBuffer, GPU_shader_get_texture_binding(sh, "depthBuffer"));
+  }
+
+  GPU_vertbuf_bind_as_ssbo(m_particleBuffer, GPU_shader_get_ssbo(sh, "particleBuffer"));
+  GPU_compute_dispatch(sh, (m_maxParticles + groupSize - 1) / groupSize, 1, 1);
+  GPU_memory_barrier(GPU_BARRIER_SHADER_STORAGE | GPU_BARRIER_VERTEX_ATTRIB_ARRAY);
+
+  if (collision) {
+    GPU_texture_unbind(depthBuffer);
+  }
+  GPU_shader_unbind();
+
+  m_emitCursor = (m_emitCursor + emitCount) % m_maxParticles;
+}
+
+void RAS_ParticleSystem::Draw(const Settings &settings,
+                              const MT_Matrix4x4 &viewProjection,
+                              const MT_Vector3 &right,
+                              const MT_Vector3 &up)
+{
+  if (!m_batch) {
+    return;
+  }
+
+  float mat[4][4];
+  float camright[3];
+  float camup[3];
+  viewProjection.getValue(&mat[0][0]);
+  right.getValue(camright);
+  up.getValue(camup);
+
+  GPU_batch_set_shader(m_batch, drawShader);
+  GPU_shader_uniform_mat4(drawShader, "ViewProjectionMatrix", mat);
+  GPU_shader_uniform_3fv(drawShader, "cameraRight", camright);
+  GPU_shader_uniform_3fv(drawShader, "cameraUp", camup);
+  GPU_shader_uniform_1f(drawShader, "sizeStart", settings.m_sizeStart);
+  GPU_shader_uniform_1f(drawShader, "sizeEnd", settings.m_sizeEnd);
+  GPU_shader_uniform_4fv(drawShader, "colorStart", settings.m_colorStart);
+  GPU_shader_uniform_4fv(drawShader, "colorEnd", settings.m_colorEnd);
+
+  GPU_blend(settings.m_additive ? GPU_BLEND_ADDITIVE : GPU_BLEND_ALPHA);
+  GPU_batch_draw(m_batch);
+}
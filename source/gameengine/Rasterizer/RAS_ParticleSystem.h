@@ -0,0 +1,114 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file RAS_ParticleSystem.h
+ *  \ingroup bgerast
+ */
+
+#pragma once
+
+#include "MT_Matrix4x4.h"
+#include "MT_Vector3.h"
+
+struct GPUBatch;
+struct GPUTexture;
+struct GPUVertBuf;
+
+/** Particles simulated by a compute shader and drawn as instanced billboards, the particles
+ * never leave the GPU. The particles are stored in a ring, each step respawns the slots
+ * following the last emitted ones at the emitter.
+ */
+class RAS_ParticleSystem {
+ public:
+  /// Parameters of the emission and the simulation, in world space unless noted.
+  struct Settings {
+    /// World matrix of the emitter.
+    float m_emitterMatrix[4][4];
+    /// Initial velocity in the emitter space.
+    float m_velocity[3];
+    /// Magnitude of the random velocity added in all directions.
+    float m_randomVelocity;
+    /// Radius of the emission sphere in the emitter space.
+    float m_radius;
+    float m_lifetime;
+    /// Variation of the lifetime, factor of the lifetime.
+    float m_lifetimeRandom;
+    float m_gravity[3];
+    /// Fraction of the velocity lost per second.
+    float m_damping;
+    float m_sizeStart;
+    float m_sizeEnd;
+    float m_colorStart[4];
+    float m_colorEnd[4];
+    bool m_additive;
+    /// Bounce on the depth of the render, see Simulate.
+    bool m_depthCollision;
+    /// Fraction of the velocity kept by a bounce.
+    float m_bounce;
+    /// Depth behind a surface under which a particle collides with it.
+    float m_collisionThickness;
+  };
+
+ private:
+  unsigned int m_maxParticles;
+  /// Position, age, velocity and lifetime of each particle, used as storage and instances.
+  GPUVertBuf *m_particleBuffer;
+  /// Corners of the billboard quad instanced per particle.
+  GPUBatch *m_batch;
+  /// Slot of the next emitted particle.
+  unsigned int m_emitCursor;
+  unsigned int m_seed;
+
+  bool Init();
+
+ public:
+  RAS_ParticleSystem(unsigned int maxParticles);
+  ~RAS_ParticleSystem();
+
+  /// Return true when the GPU supports the compute shaders and storage buffers used.
+  static bool Supported();
+
+  unsigned int GetMaxParticles() const;
+
+  /** Step the particles and emit new ones.
+   * \param timeStep The time elapsed since the last step in seconds.
+   * \param emitCount The number of particles emitted in this step.
+   * \param depthBuffer The depth of the last render for the collisions, nullptr to disable
+   * them.
+   * \param viewProjection The matrix the depth was rendered with.
+   * \param depthUvScale The part of the depth texture covered by the render.
+   */
+  void Simulate(const Settings &settings,
+                float timeStep,
+                unsigned int emitCount,
+                GPUTexture *depthBuffer,
+                const MT_Matrix4x4 &viewProjection,
+                const MT_Vector3 &cameraPosition,
+                const float depthUvScale[2]);
+
+  /** Draw the particles in the bound frame buffer, tested against its depth.
+   * \param viewProjection The view projection matrix of the camera.
+   * \param right, up The world axes of the camera.
+   */
+  void Draw(const Settings &settings,
+            const MT_Matrix4x4 &viewProjection,
+            const MT_Vector3 &right,
+            const MT_Vector3 &up);
+};
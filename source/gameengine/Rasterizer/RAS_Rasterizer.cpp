@@ -163,7 +163,8 @@ RAS_Rasterizer::RAS_Rasterizer()
       m_auxilaryClientInfo(nullptr),
       m_shadowMode(RAS_SHADOW_NONE),
       m_invertFrontFace(false),
-      m_last_frontface(true)
+      m_last_frontface(true),
+      m_useGpuTimers(false)
 {
   m_impl.reset(new RAS_OpenGLRasterizer(this));
 
@@ -1094,3 +1095,43 @@ const unsigned char *RAS_Rasterizer::GetGraphicsCardVendor()
 {
   return m_impl->GetGraphicsCardVendor();
 }
+
+void RAS_Rasterizer::SetUseGpuTimers(bool use)
+{
+  m_useGpuTimers = use;
+}
+
+bool RAS_Rasterizer::GetUseGpuTimers() const
+{
+  return m_useGpuTimers;
+}
+
+void RAS_Rasterizer::BeginGpuTimer(const std::string &name)
+{
+  if (m_useGpuTimers) {
+    m_impl->BeginGpuTimer(name);
+  }
+}
+
+void RAS_Rasterizer::EndGpuTimer()
+{
+  if (m_useGpuTimers) {
+    m_impl->EndGpuTimer();
+  }
+}
+
+void RAS_Rasterizer::ResolveGpuTimers()
+{
+  if (m_useGpuTimers) {
+    m_impl->ResolveGpuTimers();
+  }
+  else {
+    // Release the queries once the timers are disabled.
+    m_impl->FreeGpuTimers();
+  }
+}
+
+const RAS_Rasterizer::GpuTimes &RAS_Rasterizer::GetGpuTimes() const
+{
+  return m_impl->GetGpuTimes();
+}
@@ -67,6 +67,9 @@ typedef struct ViewPortMatrices {
  */
 class RAS_Rasterizer {
  public:
+  /// GPU time in ms of each named timer of a frame.
+  typedef std::vector<std::pair<std::string, double>> GpuTimes;
+
   enum FrameBufferType {
     RAS_FRAMEBUFFER_FILTER0 = 0,
     RAS_FRAMEBUFFER_FILTER1,
@@ -274,6 +277,9 @@ class RAS_Rasterizer {
   bool m_invertFrontFace;
   bool m_last_frontface;
 
+  /// Measure the GPU timers?
+  bool m_useGpuTimers;
+
   std::unique_ptr<RAS_OpenGLRasterizer> m_impl;
 
   void InitScreenShaders();
@@ -564,4 +570,19 @@ class RAS_Rasterizer {
   void PrintHardwareInfo();
 
   const unsigned char *GetGraphicsCardVendor();
+
+  void SetUseGpuTimers(bool use);
+  bool GetUseGpuTimers() const;
+  /** Start measuring the GPU time of the next commands, timers can be nested.
+   * Does nothing when the GPU timers are not used.
+   */
+  void BeginGpuTimer(const std::string &name);
+  /// End the last started GPU timer.
+  void EndGpuTimer();
+  /** Finish the timers of the current frame and read the results of the timers
+   * of a previous frame, the results are reported a few frames late to not wait for the GPU.
+   */
+  void ResolveGpuTimers();
+  /// Return the last read GPU times.
+  const GpuTimes &GetGpuTimes() const;
 };
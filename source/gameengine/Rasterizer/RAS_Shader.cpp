@@ -23,8 +23,12 @@
  */
 
 #include "RAS_Shader.h"
+#include "RAS_UniformBlock.h"
+
+#include <algorithm>
 
 #include "BLI_alloca.h"
+#include "GPU_glew.h"
 #include "GPU_immediate.h"
 #include "MEM_guardedalloc.h"
 
@@ -134,6 +138,16 @@ void *RAS_Shader::RAS_Uniform::GetData()
   return m_data;
 }
 
+int RAS_Shader::RAS_Uniform::GetDataSize() const
+{
+  return m_dataLen;
+}
+
+bool RAS_Shader::RAS_Uniform::IsDirty() const
+{
+  return m_dirty;
+}
+
 bool RAS_Shader::Ok() const
 {
   return (m_shader && m_use);
@@ -159,77 +173,101 @@ void RAS_Shader::ClearUniforms()
     delete uni;
   }
   m_uniforms.clear();
+  m_uniformTable.clear();
+  m_dirtyUniforms.clear();
 
   for (RAS_DefUniform *uni : m_preDef) {
     delete uni;
   }
   m_preDef.clear();
+
+  for (RAS_UniformBlock *block : m_uniformBlocks) {
+    delete block;
+  }
+  m_uniformBlocks.clear();
 }
 
 RAS_Shader::RAS_Uniform *RAS_Shader::FindUniform(const int location)
 {
 #ifdef SORT_UNIFORMS
-  for (RAS_Uniform *uni : m_uniforms) {
-    if (uni->GetLocation() == location) {
-      return uni;
-    }
+  if (location >= 0 && location < m_uniformTable.size()) {
+    return m_uniformTable[location];
   }
 #endif
   return nullptr;
 }
 
-void RAS_Shader::SetUniformfv(
-    int location, int type, float *param, int size, unsigned int count, bool transpose)
+void RAS_Shader::StoreUniform(
+    int location, int type, const void *param, int size, unsigned int count)
 {
 #ifdef SORT_UNIFORMS
+  BLI_assert(location >= 0);
+
   RAS_Uniform *uni = FindUniform(location);
 
-  if (uni) {
-    memcpy(uni->GetData(), param, size);
-    uni->SetData(location, type, count, transpose);
+  if (uni && uni->GetDataSize() != size) {
+    // The type of the uniform changed, its storage is reallocated.
+    m_uniforms.erase(std::find(m_uniforms.begin(), m_uniforms.end(), uni));
+    m_dirtyUniforms.erase(std::remove(m_dirtyUniforms.begin(), m_dirtyUniforms.end(), uni),
+                          m_dirtyUniforms.end());
+    delete uni;
+    uni = nullptr;
   }
-  else {
+
+  if (!uni) {
     uni = new RAS_Uniform(size);
-    memcpy(uni->GetData(), param, size);
-    uni->SetData(location, type, count, transpose);
     m_uniforms.push_back(uni);
+    m_dirtyUniforms.push_back(uni);
+    if (location >= m_uniformTable.size()) {
+      m_uniformTable.resize(location + 1, nullptr);
+    }
+    m_uniformTable[location] = uni;
   }
+  // A uniform is in the dirty list until applied.
+  else if (!uni->IsDirty()) {
+    // Skip the unchanged values, the program keeps the last applied ones.
+    if (memcmp(uni->GetData(), param, size) == 0) {
+      return;
+    }
+    m_dirtyUniforms.push_back(uni);
+  }
+
+  memcpy(uni->GetData(), param, size);
+  uni->SetData(location, type, count);
 
   m_dirty = true;
 #endif
 }
 
+void RAS_Shader::SetUniformfv(
+    int location, int type, float *param, int size, unsigned int count, bool transpose)
+{
+  StoreUniform(location, type, param, size, count);
+}
+
 void RAS_Shader::SetUniformiv(
     int location, int type, int *param, int size, unsigned int count, bool transpose)
 {
-#ifdef SORT_UNIFORMS
-  RAS_Uniform *uni = FindUniform(location);
-
-  if (uni) {
-    memcpy(uni->GetData(), param, size);
-    uni->SetData(location, type, count, transpose);
-  }
-  else {
-    uni = new RAS_Uniform(size);
-    memcpy(uni->GetData(), param, size);
-    uni->SetData(location, type, count, transpose);
-    m_uniforms.push_back(uni);
-  }
-
-  m_dirty = true;
-#endif
+  StoreUniform(location, type, param, size, count);
 }
 
 void RAS_Shader::ApplyShader()
 {
+  // The binding points are shared by all the shaders, the blocks are bound at each apply.
+  for (RAS_UniformBlock *block : m_uniformBlocks) {
+    block->Bind();
+  }
+
 #ifdef SORT_UNIFORMS
   if (!m_dirty) {
     return;
   }
 
-  for (unsigned int i = 0; i < m_uniforms.size(); i++) {
-    m_uniforms[i]->Apply(this);
+  // Only the uniforms changed since the last apply are sent.
+  for (RAS_Uniform *uni : m_dirtyUniforms) {
+    uni->Apply(this);
   }
+  m_dirtyUniforms.clear();
 
   m_dirty = false;
 #endif
@@ -242,6 +280,8 @@ void RAS_Shader::UnloadShader()
 
 void RAS_Shader::DeleteShader()
 {
+  m_uniformLocations.clear();
+
   if (m_shader) {
     GPU_shader_free(m_shader);
     m_shader = nullptr;
@@ -461,7 +501,17 @@ void RAS_Shader::BindAttributes(const std::unordered_map<int, std::string> &attr
 int RAS_Shader::GetUniformLocation(const std::string &name, bool debug)
 {
   BLI_assert(m_shader != nullptr);
-  int location = GPU_shader_get_uniform_location_old(m_shader, name.c_str());
+
+  // The location is queried to the program only once per name.
+  std::unordered_map<std::string, int>::iterator it = m_uniformLocations.find(name);
+  int location;
+  if (it != m_uniformLocations.end()) {
+    location = it->second;
+  }
+  else {
+    location = GPU_shader_get_uniform_location_old(m_shader, name.c_str());
+    m_uniformLocations.emplace(name, location);
+  }
 
   if (location == -1 && debug) {
     CM_Error("invalid uniform value: " << name << ".");
@@ -470,6 +520,39 @@ int RAS_Shader::GetUniformLocation(const std::string &name, bool debug)
   return location;
 }
 
+RAS_UniformBlock *RAS_Shader::GetUniformBlock(const std::string &name)
+{
+  BLI_assert(m_shader != nullptr);
+
+  for (RAS_UniformBlock *block : m_uniformBlocks) {
+    if (block->GetName() == name) {
+      return block;
+    }
+  }
+
+  const int binding = GPU_shader_get_uniform_block_binding(m_shader, name.c_str());
+  if (binding == -1) {
+    return nullptr;
+  }
+
+  // The block size includes the padding of its layout.
+  const GLuint program = GPU_shader_get_program(m_shader);
+  const GLuint index = glGetUniformBlockIndex(program, name.c_str());
+  if (index == GL_INVALID_INDEX) {
+    return nullptr;
+  }
+
+  GLint size = 0;
+  glGetActiveUniformBlockiv(program, index, GL_UNIFORM_BLOCK_DATA_SIZE, &size);
+  if (size <= 0) {
+    return nullptr;
+  }
+
+  RAS_UniformBlock *block = new RAS_UniformBlock(name, binding, size);
+  m_uniformBlocks.push_back(block);
+  return block;
+}
+
 void RAS_Shader::SetUniform(int uniform, const MT_Vector2 &vec)
 {
   float value[2];
@@ -6,6 +6,7 @@
 #pragma once
 
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "MT_Matrix4x4.h"
@@ -15,6 +16,7 @@
 #define SORT_UNIFORMS 1
 
 class RAS_Rasterizer;
+class RAS_UniformBlock;
 struct GPUShader;
 
 /**
@@ -59,6 +61,8 @@ class RAS_Shader {
     void SetData(int location, int type, unsigned int count, bool transpose = false);
     int GetLocation();
     void *GetData();
+    int GetDataSize() const;
+    bool IsDirty() const;
   };
 
   /**
@@ -108,7 +112,14 @@ class RAS_Shader {
 
   // Stored uniform variables
   RAS_UniformVec m_uniforms;
+  /// Stored uniforms indexed by location, nullptr for the locations without uniform.
+  RAS_UniformVec m_uniformTable;
+  /// Stored uniforms changed since the last apply.
+  RAS_UniformVec m_dirtyUniforms;
   RAS_UniformVecDef m_preDef;
+  /// Locations of the uniform names already queried.
+  std::unordered_map<std::string, int> m_uniformLocations;
+  std::vector<RAS_UniformBlock *> m_uniformBlocks;
 
   /** Parse shader program to prevent redundant macro directives.
    * \param type The program type to parse.
@@ -122,6 +133,8 @@ class RAS_Shader {
 
   // search by location
   RAS_Uniform *FindUniform(const int location);
+  /// Store the value of a uniform, applied with the other changed uniforms in ApplyShader.
+  void StoreUniform(int location, int type, const void *param, int size, unsigned int count);
 
   // clears uniform data
   void ClearUniforms();
@@ -163,6 +176,11 @@ class RAS_Shader {
    */
   int GetUniformLocation(const std::string &name, bool debug = true);
 
+  /** Return the uniform block of a name, created at the first call.
+   * \return nullptr if the shader has no block of this name.
+   */
+  RAS_UniformBlock *GetUniformBlock(const std::string &name);
+
   void SetUniform(int uniform, const MT_Vector2 &vec);
   void SetUniform(int uniform, const MT_Vector3 &vec);
   void SetUniform(int uniform, const MT_Vector4 &vec);
@@ -0,0 +1,87 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Rasterizer/RAS_UniformBlock.cpp
+ *  \ingroup bgerast
+ */
+
+#include "RAS_UniformBlock.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "GPU_uniform_buffer.h"
+
+RAS_UniformBlock::RAS_UniformBlock(const std::string &name, int binding, unsigned int size)
+    : m_name(name), m_binding(binding), m_data(size, 0), m_dirtyBegin(0), m_dirtyEnd(size)
+{
+  m_ubo = GPU_uniformbuf_create_ex(size, nullptr, "RAS_UniformBlock");
+}
+
+RAS_UniformBlock::~RAS_UniformBlock()
+{
+  GPU_uniformbuf_free(m_ubo);
+}
+
+const std::string &RAS_UniformBlock::GetName() const
+{
+  return m_name;
+}
+
+unsigned int RAS_UniformBlock::GetSize() const
+{
+  return m_data.size();
+}
+
+bool RAS_UniformBlock::SetData(unsigned int offset, const void *data, unsigned int size)
+{
+  if (offset + size > m_data.size() || offset + size < offset) {
+    return false;
+  }
+
+  unsigned char *dst = m_data.data() + offset;
+  if (memcmp(dst, data, size) == 0) {
+    return true;
+  }
+
+  memcpy(dst, data, size);
+
+  if (m_dirtyBegin >= m_dirtyEnd) {
+    m_dirtyBegin = offset;
+    m_dirtyEnd = offset + size;
+  }
+  else {
+    m_dirtyBegin = std::min(m_dirtyBegin, offset);
+    m_dirtyEnd = std::max(m_dirtyEnd, offset + size);
+  }
+
+  return true;
+}
+
+void RAS_UniformBlock::Bind()
+{
+  if (m_dirtyBegin < m_dirtyEnd) {
+    GPU_uniformbuf_update_range(
+        m_ubo, m_data.data() + m_dirtyBegin, m_dirtyBegin, m_dirtyEnd - m_dirtyBegin);
+    m_dirtyBegin = m_dirtyEnd = 0;
+  }
+
+  GPU_uniformbuf_bind(m_ubo, m_binding);
+}
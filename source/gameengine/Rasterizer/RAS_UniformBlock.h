@@ -0,0 +1,63 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file RAS_UniformBlock.h
+ *  \ingroup bgerast
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+struct GPUUniformBuf;
+
+/** Uniform block of a custom shader backed by a uniform buffer. The values are written in a
+ * local copy and only the bytes changed since the last bind are uploaded, in one call.
+ */
+class RAS_UniformBlock {
+ private:
+  std::string m_name;
+  /// Binding point of the block in the shader.
+  int m_binding;
+  std::vector<unsigned char> m_data;
+  GPUUniformBuf *m_ubo;
+  /// Range of the bytes changed since the last upload, empty if begin >= end.
+  unsigned int m_dirtyBegin;
+  unsigned int m_dirtyEnd;
+
+ public:
+  RAS_UniformBlock(const std::string &name, int binding, unsigned int size);
+  ~RAS_UniformBlock();
+
+  RAS_UniformBlock(const RAS_UniformBlock &other) = delete;
+  RAS_UniformBlock &operator=(const RAS_UniformBlock &other) = delete;
+
+  const std::string &GetName() const;
+  unsigned int GetSize() const;
+
+  /** Write bytes of the block, the unchanged bytes are not uploaded.
+   * \return False if the range is out of the block.
+   */
+  bool SetData(unsigned int offset, const void *data, unsigned int size);
+
+  /// Upload the changed range and bind the buffer to the binding point of the block.
+  void Bind();
+};
@@ -0,0 +1,63 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file SG_BBoxList.cpp
+ *  \ingroup bgesg
+ */
+
+#include "SG_BBoxList.h"
+
+void SG_BBoxList::Clear()
+{
+  for (unsigned short axis = 0; axis < 3; ++axis) {
+    m_min[axis].clear();
+    m_max[axis].clear();
+  }
+}
+
+unsigned int SG_BBoxList::GetSize() const
+{
+  return m_min[0].size();
+}
+
+void SG_BBoxList::Add(const MT_Vector3 &min, const MT_Vector3 &max)
+{
+  for (unsigned short axis = 0; axis < 3; ++axis) {
+    m_min[axis].push_back(min[axis]);
+    m_max[axis].push_back(max[axis]);
+  }
+}
+
+void SG_BBoxList::Add(const MT_Vector3 &min, const MT_Vector3 &max, const MT_Transform &trans)
+{
+  const MT_Vector3 center = trans((min + max) * 0.5f);
+  const MT_Vector3 extent = trans.getBasis().absolute() * ((max - min) * 0.5f);
+  Add(center - extent, center + extent);
+}
+
+const float *SG_BBoxList::GetMin(unsigned short axis) const
+{
+  return m_min[axis].data();
+}
+
+const float *SG_BBoxList::GetMax(unsigned short axis) const
+{
+  return m_max[axis].data();
+}
@@ -15,61 +15,38 @@
  * along with this program; if not, write to the Free Software Foundation,
  * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
  *
- * Contributor(s): Tristan Porteries.
- *
  * ***** END GPL LICENSE BLOCK *****
  */
 
-/** \file gameengine/Common/CM_Thread.cpp
- *  \ingroup common
+/** \file SG_BBoxList.h
+ *  \ingroup bgesg
  */
 
-#include "CM_Thread.h"
-
-CM_ThreadLock::CM_ThreadLock()
-{
-}
-
-CM_ThreadLock::~CM_ThreadLock()
-{
-}
+#pragma once
 
-CM_ThreadSpinLock::CM_ThreadSpinLock()
-{
-  BLI_spin_init(&m_spinlock);
-}
+#include <vector>
 
-CM_ThreadSpinLock::~CM_ThreadSpinLock()
-{
-  BLI_spin_end(&m_spinlock);
-}
+#include "MT_Transform.h"
 
-void CM_ThreadSpinLock::Lock()
-{
-  BLI_spin_lock(&m_spinlock);
-}
-
-void CM_ThreadSpinLock::Unlock()
-{
-  BLI_spin_unlock(&m_spinlock);
-}
+/** World space axis aligned boxes stored per component, to be tested together against the
+ * frustum planes.
+ */
+class SG_BBoxList {
+ private:
+  std::vector<float> m_min[3];
+  std::vector<float> m_max[3];
 
-CM_ThreadMutex::CM_ThreadMutex()
-{
-  BLI_mutex_init(&m_mutex);
-}
+ public:
+  SG_BBoxList() = default;
+  ~SG_BBoxList() = default;
 
-CM_ThreadMutex::~CM_ThreadMutex()
-{
-  BLI_mutex_end(&m_mutex);
-}
+  void Clear();
+  unsigned int GetSize() const;
 
-void CM_ThreadMutex::Lock()
-{
-  BLI_mutex_lock(&m_mutex);
-}
+  void Add(const MT_Vector3 &min, const MT_Vector3 &max);
+  /// Add the world box enclosing a local box transformed by an object transform.
+  void Add(const MT_Vector3 &min, const MT_Vector3 &max, const MT_Transform &trans);
 
-void CM_ThreadMutex::Unlock()
-{
-  BLI_mutex_unlock(&m_mutex);
-}
+  const float *GetMin(unsigned short axis) const;
+  const float *GetMax(unsigned short axis) const;
+};
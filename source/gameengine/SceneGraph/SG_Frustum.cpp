@@ -1,6 +1,9 @@
 #include "SG_Frustum.h"
 
+#include <algorithm>
+
 #include "MT_Frustum.h"
+#include "SG_BBoxList.h"
 
 SG_Frustum::SG_Frustum(const MT_Matrix4x4 &matrix) : m_matrix(matrix)
 {
@@ -272,3 +275,52 @@ SG_Frustum::TestType SG_Frustum::FrustumInsideFrustum(const SG_Frustum &frustum)
 
   return INSIDE;
 }
+
+void SG_Frustum::BoxesInsideFrustum(const SG_BBoxList &boxes,
+                                    std::vector<uint32_t> &visible) const
+{
+  const unsigned int size = boxes.GetSize();
+  visible.resize((size + 31) / 32, 0);
+
+  /* A box is outside a plane when its corner the farthest along the plane normal is outside,
+   * this corner takes the minimum or maximum of each axis from the signs of the normal. */
+  const float *corners[6][3];
+  for (unsigned short i = 0; i < 6; ++i) {
+    for (unsigned short axis = 0; axis < 3; ++axis) {
+      corners[i][axis] = (m_planes[i][axis] < 0.0f) ? boxes.GetMin(axis) : boxes.GetMax(axis);
+    }
+  }
+
+  /* The distances of a block of boxes are computed without branches to be vectorized, the
+   * full blocks have a constant size. */
+  for (unsigned int start = 0; start < size; start += 32) {
+    const unsigned int count = std::min(size - start, 32u);
+    int outside[32] = {0};
+
+    for (unsigned short i = 0; i < 6; ++i) {
+      const float a = m_planes[i][0];
+      const float b = m_planes[i][1];
+      const float c = m_planes[i][2];
+      const float d = m_planes[i][3];
+      const float *__restrict x = corners[i][0] + start;
+      const float *__restrict y = corners[i][1] + start;
+      const float *__restrict z = corners[i][2] + start;
+      if (count == 32) {
+        for (unsigned int j = 0; j < 32; ++j) {
+          outside[j] |= (a * x[j] + b * y[j] + c * z[j] + d < 0.0f);
+        }
+      }
+      else {
+        for (unsigned int j = 0; j < count; ++j) {
+          outside[j] |= (a * x[j] + b * y[j] + c * z[j] + d < 0.0f);
+        }
+      }
+    }
+
+    uint32_t word = 0;
+    for (unsigned int j = 0; j < count; ++j) {
+      word |= (uint32_t)(outside[j] ^ 1) << j;
+    }
+    visible[start / 32] |= word;
+  }
+}
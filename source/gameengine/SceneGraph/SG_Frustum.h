@@ -1,9 +1,13 @@
 #pragma once
 
 #include <array>
+#include <cstdint>
+#include <vector>
 
 #include "MT_Matrix4x4.h"
 
+class SG_BBoxList;
+
 /// \brief Camera frustum data.
 class SG_Frustum {
  private:
@@ -29,4 +33,10 @@ class SG_Frustum {
                              const MT_Vector3 &max,
                              const MT_Matrix4x4 &mat) const;
   TestType FrustumInsideFrustum(const SG_Frustum &frustum) const;
+  /** Test boxes in world space 32 at a time, a box is visible when it is not fully outside
+   * one of the planes.
+   * \param visible Bitset of the boxes, 32 per word, the bits of the visible boxes are set and
+   * the others are kept to combine the tests of several frustums.
+   */
+  void BoxesInsideFrustum(const SG_BBoxList &boxes, std::vector<uint32_t> &visible) const;
 };
@@ -36,6 +36,7 @@
 
 static CM_ThreadMutex scheduleMutex;
 static CM_ThreadMutex transformMutex;
+static CM_ThreadMutex dirtyRenderMutex;
 
 SG_Node::SG_Node(void *clientobj, void *clientinfo, SG_Callbacks &callbacks)
     : SG_QList(),
@@ -216,6 +217,24 @@ bool SG_Node::IsSlowParent()
   return false;
 }
 
+bool SG_Node::IsBoneParent()
+{
+  if (m_parent_relation) {
+    return m_parent_relation->IsBoneRelation();
+  }
+  return false;
+}
+
+bool SG_Node::HasScheduledAncestor()
+{
+  for (SG_Node *parent = m_SGparent; parent; parent = parent->m_SGparent) {
+    if (!parent->Empty()) {
+      return true;
+    }
+  }
+  return false;
+}
+
 void SG_Node::AddChild(SG_Node *child)
 {
   m_children.push_back(child);
@@ -394,8 +413,15 @@ void SG_Node::SetControllerTime(double time)
 
 void SG_Node::ClearModified()
 {
+  const bool renderDirty = (m_dirty & DIRTY_RENDER);
+
   m_modified = false;
   m_dirty = DIRTY_ALL;
+
+  // Notify only once until the render dirty flag is cleared.
+  if (!renderDirty) {
+    ActivateDirtyRenderCallback();
+  }
 }
 
 void SG_Node::SetModified()
@@ -664,3 +690,13 @@ void SG_Node::ActivateRecheduleUpdateCallback()
     m_callbacks.m_reschedulefunc(this, m_SGclientObject, m_SGclientInfo);
   }
 }
+
+void SG_Node::ActivateDirtyRenderCallback()
+{
+  if (m_callbacks.m_dirtyrenderfunc) {
+    // Call client provided dirty render func.
+    dirtyRenderMutex.Lock();
+    m_callbacks.m_dirtyrenderfunc(this, m_SGclientObject, m_SGclientInfo);
+    dirtyRenderMutex.Unlock();
+  }
+}
@@ -50,6 +50,7 @@ typedef void *(*SG_DestructionNewCallback)(SG_Node *sgnode, void *clientobj, voi
 typedef void (*SG_UpdateTransformCallback)(SG_Node *sgnode, void *clientobj, void *clientinfo);
 typedef bool (*SG_ScheduleUpdateCallback)(SG_Node *sgnode, void *clientobj, void *clientinfo);
 typedef bool (*SG_RescheduleUpdateCallback)(SG_Node *sgnode, void *clientobj, void *clientinfo);
+typedef void (*SG_DirtyRenderCallback)(SG_Node *sgnode, void *clientobj, void *clientinfo);
 
 /**
  * SG_Callbacks hold 2 call backs to the outside world.
@@ -58,6 +59,8 @@ typedef bool (*SG_RescheduleUpdateCallback)(SG_Node *sgnode, void *clientobj, vo
  * with replicated nodes and their children.
  * The second is called when a node is destroyed and again
  * is their for synchronization purposes
+ * The dirty render callback is called when the node becomes dirty for
+ * render, it lets the outside world track the moved nodes.
  * These callbacks may both be nullptr.
  * The efficacy of this approach has not been proved some
  * alternatives might be to perform all replication and destruction
@@ -72,7 +75,8 @@ struct SG_Callbacks {
         m_destructionfunc(nullptr),
         m_updatefunc(nullptr),
         m_schedulefunc(nullptr),
-        m_reschedulefunc(nullptr)
+        m_reschedulefunc(nullptr),
+        m_dirtyrenderfunc(nullptr)
   {
   }
 
@@ -80,12 +84,14 @@ struct SG_Callbacks {
                SG_DestructionNewCallback destructfunc,
                SG_UpdateTransformCallback updatefunc,
                SG_ScheduleUpdateCallback schedulefunc,
-               SG_RescheduleUpdateCallback reschedulefunc)
+               SG_RescheduleUpdateCallback reschedulefunc,
+               SG_DirtyRenderCallback dirtyrenderfunc)
       : m_replicafunc(repfunc),
         m_destructionfunc(destructfunc),
         m_updatefunc(updatefunc),
         m_schedulefunc(schedulefunc),
-        m_reschedulefunc(reschedulefunc)
+        m_reschedulefunc(reschedulefunc),
+        m_dirtyrenderfunc(dirtyrenderfunc)
   {
   }
 
@@ -94,6 +100,7 @@ struct SG_Callbacks {
   SG_UpdateTransformCallback m_updatefunc;
   SG_ScheduleUpdateCallback m_schedulefunc;
   SG_RescheduleUpdateCallback m_reschedulefunc;
+  SG_DirtyRenderCallback m_dirtyrenderfunc;
 };
 
 typedef std::vector<SG_Node *> NodeList;
@@ -107,7 +114,8 @@ class SG_Node : public SG_QList {
     DIRTY_NONE = 0,
     DIRTY_ALL = 0xFF,
     DIRTY_RENDER = (1 << 0),
-    DIRTY_CULLING = (1 << 1)
+    DIRTY_CULLING = (1 << 1),
+    DIRTY_REPLICATION = (1 << 2)
   };
 
   SG_Node(void *clientobj, void *clientinfo, SG_Callbacks &callbacks);
@@ -182,6 +190,17 @@ class SG_Node : public SG_QList {
    */
   bool IsSlowParent();
 
+  /**
+   * Return bone parent status.
+   */
+  bool IsBoneParent();
+
+  /**
+   * Return true if one of the ancestors of this node is scheduled for update,
+   * in this case the node is updated by the recursion of its ancestor.
+   */
+  bool HasScheduledAncestor();
+
   /**
    * Update the spatial data of this node. Iterate through
    * the children of this node and update their world data.
@@ -359,6 +378,7 @@ class SG_Node : public SG_QList {
   void ActivateUpdateTransformCallback();
   bool ActivateScheduleUpdateCallback();
   void ActivateRecheduleUpdateCallback();
+  void ActivateDirtyRenderCallback();
 
   /**
    * Update the world coordinates of this spatial node. This also informs
@@ -96,6 +96,14 @@ class SG_ParentRelation {
     return false;
   }
 
+  /**
+   * Bone Parent Relation read the armature pose, they can't be updated in parallel
+   */
+  virtual bool IsBoneRelation()
+  {
+    return false;
+  }
+
  protected:
   /**
    * Protected constructors
@@ -77,6 +77,15 @@ class FilterBase {
     return filter(src, x, y, size, pixSize, convertPrevious(src, x, y, size, pixSize));
   }
 
+  /** convert a row of contiguous pixels at once
+   * \return false if the pixels must be converted one by one
+   */
+  template<class SRC> bool convertRow(SRC src, unsigned int *dst, int count)
+  {
+    // the row filters don't chain, only a single filter can be used
+    return (m_previous == nullptr && filterRow(src, dst, count));
+  }
+
   /// get previous filter
   PyFilter *getPrevious(void)
   {
@@ -121,6 +130,22 @@ class FilterBase {
     return val;
   }
 
+  /// filter row of pixels, source byte buffer, return false if not supported
+  virtual bool filterRow(unsigned char *src, unsigned int *dst, int count)
+  {
+    return false;
+  }
+  /// filter row of pixels, source int buffer, return false if not supported
+  virtual bool filterRow(unsigned int *src, unsigned int *dst, int count)
+  {
+    return false;
+  }
+  /// filter row of pixels, source float buffer, return false if not supported
+  virtual bool filterRow(float *src, unsigned int *dst, int count)
+  {
+    return false;
+  }
+
   /// get source pixel size
   virtual unsigned int getPixelSize(void)
   {
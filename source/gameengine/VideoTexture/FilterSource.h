@@ -30,6 +30,8 @@
 
 #pragma once
 
+#include "BLI_simd.h"
+
 #include "Common.h"
 #include "FilterBase.h"
 
@@ -59,6 +61,14 @@ class FilterRGB24 : public FilterBase {
     VT_RGBA(val, src[0], src[1], src[2], 0xFF);
     return val;
   }
+
+  /// filter row of pixels, source byte buffer
+  virtual bool filterRow(unsigned char *src, unsigned int *dst, int count)
+  {
+    for (int i = 0; i < count; ++i, src += 3, ++dst)
+      VT_RGBA(*dst, src[0], src[1], src[2], 0xFF);
+    return true;
+  }
 };
 
 /// class for RGBA32 conversion
@@ -91,6 +101,13 @@ class FilterRGBA32 : public FilterBase {
       return val;
     }
   }
+
+  /// filter row of pixels, source byte buffer
+  virtual bool filterRow(unsigned char *src, unsigned int *dst, int count)
+  {
+    memcpy(dst, src, count * sizeof(unsigned int));
+    return true;
+  }
 };
 
 /// class for BGRA32 conversion
@@ -119,6 +136,28 @@ class FilterBGRA32 : public FilterBase {
     VT_RGBA(val, src[2], src[1], src[0], src[3]);
     return val;
   }
+
+  /// filter row of pixels, source byte buffer
+  virtual bool filterRow(unsigned char *src, unsigned int *dst, int count)
+  {
+    int i = 0;
+#ifdef BLI_HAVE_SSE2
+    // swap the red and blue bytes of 4 pixels at once
+    const __m128i maskGA = _mm_set1_epi32((int)0xFF00FF00);
+    const __m128i maskB = _mm_set1_epi32(0xFF);
+    for (; i + 4 <= count; i += 4, src += 16, dst += 4) {
+      const __m128i pixels = _mm_loadu_si128((const __m128i *)src);
+      const __m128i swapped = _mm_or_si128(
+          _mm_and_si128(pixels, maskGA),
+          _mm_or_si128(_mm_slli_epi32(_mm_and_si128(pixels, maskB), 16),
+                       _mm_and_si128(_mm_srli_epi32(pixels, 16), maskB)));
+      _mm_storeu_si128((__m128i *)dst, swapped);
+    }
+#endif
+    for (; i < count; ++i, src += 4, ++dst)
+      VT_RGBA(*dst, src[2], src[1], src[0], src[3]);
+    return true;
+  }
 };
 
 /// class for BGR24 conversion
@@ -147,6 +186,14 @@ class FilterBGR24 : public FilterBase {
     VT_RGBA(val, src[2], src[1], src[0], 0xFF);
     return val;
   }
+
+  /// filter row of pixels, source byte buffer
+  virtual bool filterRow(unsigned char *src, unsigned int *dst, int count)
+  {
+    for (int i = 0; i < count; ++i, src += 3, ++dst)
+      VT_RGBA(*dst, src[2], src[1], src[0], 0xFF);
+    return true;
+  }
 };
 
 /// class for Z_buffer conversion
@@ -183,6 +230,16 @@ class FilterZZZA : public FilterBase {
 
     return val;
   }
+
+  /// filter row of pixels, source float buffer
+  virtual bool filterRow(float *src, unsigned int *dst, int count)
+  {
+    for (int i = 0; i < count; ++i, ++src, ++dst) {
+      const unsigned int depth = int(src[0] * 255);
+      VT_RGBA(*dst, depth, depth, depth, 0xFF);
+    }
+    return true;
+  }
 };
 
 /// class for Z_buffer conversion
@@ -214,6 +271,13 @@ class FilterDEPTH : public FilterBase {
     memcpy(&val, src, sizeof(unsigned int));
     return val;
   }
+
+  /// filter row of pixels, source float buffer
+  virtual bool filterRow(float *src, unsigned int *dst, int count)
+  {
+    memcpy(dst, src, count * sizeof(unsigned int));
+    return true;
+  }
 };
 
 /// class for YV12 conversion
@@ -53,6 +53,9 @@ ExpDesc InvalidColorChannelDesc(
 ExpDesc InvalidImageModeDesc(InvalidImageMode,
                              "Invalid image mode, only RGBA and BGRA are supported");
 
+size_t ImageBase::m_buffCount = 0;
+size_t ImageBase::m_buffBytes = 0;
+
 // constructor
 ImageBase::ImageBase(bool staticSrc)
     : m_image(nullptr),
@@ -77,6 +80,10 @@ ImageBase::~ImageBase(void)
   // release image
   if (m_image)
     MEM_freeN(m_image);
+  if (m_imgSize > 0) {
+    --m_buffCount;
+    m_buffBytes -= m_imgSize * sizeof(unsigned int);
+  }
 }
 
 // release python objects
@@ -215,6 +222,13 @@ void ImageBase::swapImageBR()
   }
 }
 
+// get memory usage of the image buffers
+void ImageBase::getMemoryUsage(size_t &count, size_t &bytes)
+{
+  count = m_buffCount;
+  bytes = m_buffBytes;
+}
+
 // initialize image data
 void ImageBase::init(short width, short height)
 {
@@ -233,6 +247,10 @@ void ImageBase::init(short width, short height)
     unsigned int newSize = width * height;
     // if new buffer is larger than previous
     if (newSize > m_imgSize) {
+      // update memory usage
+      if (m_imgSize == 0)
+        ++m_buffCount;
+      m_buffBytes += (newSize - m_imgSize) * sizeof(unsigned int);
       // set new buffer size
       m_imgSize = newSize;
       // release previous and create new buffer
@@ -32,6 +32,8 @@
 
 #include <vector>
 
+#include "BLI_task.h"
+
 #include "Common.h"
 #include "EXP_PyObjectPlus.h"
 #include "FilterBase.h"
@@ -44,6 +46,44 @@ class ImageSource;
 /// type for list of image sources
 typedef std::vector<ImageSource *> ImageSourceList;
 
+/// data shared by the row conversions of an image
+template<class FLT, class SRC> struct ConvImageData {
+  FLT *filter;
+  SRC srcBuff;
+  short *srcSize;
+  unsigned int pixSize;
+  unsigned int *dstBuff;
+  /// source row of each converted row
+  const int *srcRows;
+  /// source column of each converted column
+  const int *srcColumns;
+  int numColumns;
+  /// the converted columns are all the source columns
+  bool contiguous;
+};
+
+/// convert one row of an image
+template<class FLT, class SRC>
+static void convImageRow(void *__restrict userdata,
+                         const int row,
+                         const TaskParallelTLS *__restrict /*tls*/)
+{
+  const ConvImageData<FLT, SRC> *data = static_cast<ConvImageData<FLT, SRC> *>(userdata);
+  const short y = data->srcRows[row];
+  SRC srcRow = data->srcBuff + y * data->srcSize[0] * data->pixSize;
+  unsigned int *dstBuff = data->dstBuff + row * data->numColumns;
+  // convert the whole row if the filter allows it
+  if (data->contiguous && data->filter->convertRow(srcRow, dstBuff, data->numColumns)) {
+    return;
+  }
+  for (int i = 0; i < data->numColumns; ++i, ++dstBuff) {
+    const short x = data->srcColumns[i];
+    // convert pixel
+    *dstBuff = data->filter->convert(
+        srcRow + x * data->pixSize, x, y, data->srcSize, data->pixSize);
+  }
+}
+
 /// base class for image filters
 class ImageBase {
  public:
@@ -146,6 +186,9 @@ class ImageBase {
   /// swap the B and R channel in-place in the image buffer
   void swapImageBR();
 
+  /// get number and total size in bytes of the image buffers of all the images
+  static void getMemoryUsage(size_t &count, size_t &bytes);
+
   /// number of buffer pointing to m_image, public because not handled by this class
   int m_exports;
 
@@ -180,6 +223,11 @@ class ImageBase {
   /// pixel filter
   PyFilter *m_pyfilter;
 
+  /// number of allocated image buffers
+  static size_t m_buffCount;
+  /// total size in bytes of the allocated image buffers
+  static size_t m_buffBytes;
+
   /// initialize image data
   void init(short width, short height);
 
@@ -206,75 +254,57 @@ class ImageBase {
   /// template for image conversion
   template<class FLT, class SRC> void convImage(FLT &filter, SRC srcBuff, short *srcSize)
   {
-    // destination buffer
-    unsigned int *dstBuff = m_image;
-    // pixel size from filter
-    unsigned int pixSize = filter.firstPixelSize();
+    // source row of each converted row and source column of each converted column
+    std::vector<int> srcRows;
+    std::vector<int> srcColumns;
+    srcRows.reserve(m_size[1]);
+    srcColumns.reserve(m_size[0]);
     // if no scaling is needed
-    if (srcSize[0] == m_size[0] && srcSize[1] == m_size[1])
-      // if flipping isn't required
-      if (!m_flip)
-        // copy bitmap
-        for (short y = 0; y < m_size[1]; ++y)
-          for (short x = 0; x < m_size[0]; ++x, ++dstBuff, srcBuff += pixSize)
-            // copy pixel
-            *dstBuff = filter.convert(srcBuff, x, y, srcSize, pixSize);
-      // otherwise flip image top to bottom
-      else {
-        // go to last row of image
-        srcBuff += srcSize[0] * (srcSize[1] - 1) * pixSize;
-        // copy bitmap
-        for (short y = m_size[1] - 1; y >= 0; --y, srcBuff -= 2 * srcSize[0] * pixSize)
-          for (short x = 0; x < m_size[0]; ++x, ++dstBuff, srcBuff += pixSize)
-            // copy pixel
-            *dstBuff = filter.convert(srcBuff, x, y, srcSize, pixSize);
-      }
+    if (srcSize[0] == m_size[0] && srcSize[1] == m_size[1]) {
+      for (int y = 0; y < m_size[1]; ++y)
+        // flip image top to bottom if required
+        srcRows.push_back(m_flip ? srcSize[1] - y - 1 : y);
+      for (int x = 0; x < m_size[0]; ++x)
+        srcColumns.push_back(x);
+    }
     // else scale picture (nearest neighbor)
     else {
-      // interpolation accumulator
+      // interpolation accumulators
       int accHeight = srcSize[1] >> 1;
-      // if flipping is required
-      if (m_flip)
-        // go to last row of image
-        srcBuff += srcSize[0] * (srcSize[1] - 1) * pixSize;
-      // process image rows
       for (int y = 0; y < srcSize[1]; ++y) {
-        // increase height accum
         accHeight += m_size[1];
         // if pixel row has to be drawn
         if (accHeight >= srcSize[1]) {
-          // decrease accum
           accHeight -= srcSize[1];
-          // width accum
-          int accWidth = srcSize[0] >> 1;
-          // process row
-          for (int x = 0; x < srcSize[0]; ++x) {
-            // increase width accum
-            accWidth += m_size[0];
-            // if pixel has to be drawn
-            if (accWidth >= srcSize[0]) {
-              // decrease accum
-              accWidth -= srcSize[0];
-              // convert pixel
-              *dstBuff = filter.convert(
-                  srcBuff, x, m_flip ? srcSize[1] - y - 1 : y, srcSize, pixSize);
-              // next pixel
-              ++dstBuff;
-            }
-            // shift source pointer
-            srcBuff += pixSize;
-          }
+          srcRows.push_back(m_flip ? srcSize[1] - y - 1 : y);
+        }
+      }
+      int accWidth = srcSize[0] >> 1;
+      for (int x = 0; x < srcSize[0]; ++x) {
+        accWidth += m_size[0];
+        // if pixel has to be drawn
+        if (accWidth >= srcSize[0]) {
+          accWidth -= srcSize[0];
+          srcColumns.push_back(x);
         }
-        // if pixel row will not be drawn
-        else
-          // move source pointer to next row
-          srcBuff += pixSize * srcSize[0];
-        // if y flipping is required
-        if (m_flip)
-          // go to previous row of image
-          srcBuff -= 2 * pixSize * srcSize[0];
       }
     }
+
+    // the filters only read the source, the rows are converted in parallel
+    ConvImageData<FLT, SRC> data = {&filter,
+                                    srcBuff,
+                                    srcSize,
+                                    filter.firstPixelSize(),
+                                    m_image,
+                                    srcRows.data(),
+                                    srcColumns.data(),
+                                    (int)srcColumns.size(),
+                                    (srcColumns.size() == (size_t)srcSize[0])};
+
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.min_iter_per_thread = 16;
+    BLI_task_parallel_range(0, srcRows.size(), &data, convImageRow<FLT, SRC>, &settings);
   }
 
   // template for specific filter preprocessing
@@ -30,6 +30,8 @@
 
 #pragma once
 
+#include "BLI_simd.h"
+
 #include "Common.h"
 #include "FilterBase.h"
 #include "ImageBase.h"
@@ -140,4 +142,52 @@ class FilterImageMix : public FilterBase {
     return ((color[0] >> 8) & 0xFF) | (color[1] & 0xFF00) | ((color[2] << 8) & 0xFF0000) |
            ((color[3] << 16) & 0xFF000000);
   }
+
+#ifdef BLI_HAVE_SSE2
+  /// filter row of pixels, source int buffer
+  virtual bool filterRow(unsigned int *src, unsigned int *dst, int count)
+  {
+    const size_t numSources = m_sources.size();
+    const __m128i zero = _mm_setzero_si128();
+    int i = 0;
+    // mix 4 pixels at once, the channels are accumulated in 32 bits as the scalar filter
+    for (; i + 4 <= count; i += 4, src += 4, dst += 4) {
+      __m128i color[4] = {zero, zero, zero, zero};
+      // process the sources by pairs, interleaving their channels to multiply and add them
+      for (size_t j = 0; j < numSources; j += 2) {
+        ImageSourceMix *mixSrc0 = static_cast<ImageSourceMix *>(m_sources[j]);
+        const __m128i pixels0 = _mm_loadu_si128((const __m128i *)(src + mixSrc0->getOffset()));
+        __m128i pixels1 = zero;
+        short weight1 = 0;
+        if (j + 1 < numSources) {
+          ImageSourceMix *mixSrc1 = static_cast<ImageSourceMix *>(m_sources[j + 1]);
+          pixels1 = _mm_loadu_si128((const __m128i *)(src + mixSrc1->getOffset()));
+          weight1 = mixSrc1->getWeight();
+        }
+        const __m128i weights = _mm_set1_epi32((int)((unsigned short)mixSrc0->getWeight() |
+                                                     ((unsigned int)(unsigned short)weight1 << 16)));
+        // channels of the pixels 0 and 1, then 2 and 3, as 16 bits pairs of the two sources
+        const __m128i low = _mm_unpacklo_epi8(pixels0, pixels1);
+        const __m128i high = _mm_unpackhi_epi8(pixels0, pixels1);
+        color[0] = _mm_add_epi32(color[0], _mm_madd_epi16(_mm_unpacklo_epi8(low, zero), weights));
+        color[1] = _mm_add_epi32(color[1], _mm_madd_epi16(_mm_unpackhi_epi8(low, zero), weights));
+        color[2] = _mm_add_epi32(color[2], _mm_madd_epi16(_mm_unpacklo_epi8(high, zero), weights));
+        color[3] = _mm_add_epi32(color[3], _mm_madd_epi16(_mm_unpackhi_epi8(high, zero), weights));
+      }
+      // keep the 8 bits of each channel after the weight scale
+      const __m128i mask = _mm_set1_epi32(0xFF);
+      for (unsigned short k = 0; k < 4; ++k) {
+        color[k] = _mm_and_si128(_mm_srai_epi32(color[k], 8), mask);
+      }
+      const __m128i result = _mm_packus_epi16(_mm_packs_epi32(color[0], color[1]),
+                                              _mm_packs_epi32(color[2], color[3]));
+      _mm_storeu_si128((__m128i *)dst, result);
+    }
+    // remaining pixels
+    for (; i < count; ++i, ++src, ++dst) {
+      *dst = filter(src, 0, 0, nullptr, 1);
+    }
+    return true;
+  }
+#endif
 };
@@ -32,6 +32,8 @@
 
 #include "ImageRender.h"
 
+#include <map>
+
 #include "eevee_private.h"
 
 #include "EXP_PythonCallBack.h"
@@ -54,6 +56,18 @@ ExpDesc MirrorNormalInvalidDesc(MirrorNormalInvalid, "Cannot determine mirror pl
 ExpDesc MirrorHorizontalDesc(MirrorHorizontal, "Mirror is horizontal in local space");
 ExpDesc MirrorTooSmallDesc(MirrorTooSmall, "Mirror is too small");
 
+// last render of each camera used by an ImageRender
+struct SharedRender {
+  const ImageRender *m_owner;
+  double m_clockTime;
+  GLint m_area[4];
+  unsigned short m_samples;
+  // the draw callbacks of the owner could have changed the scene for its render only
+  bool m_callbacks;
+};
+
+static std::map<KX_Camera *, SharedRender> sharedRenders;
+
 // constructor
 ImageRender::ImageRender(KX_Scene *scene,
                          KX_Camera *camera,
@@ -70,6 +84,11 @@ ImageRender::ImageRender(KX_Scene *scene,
       m_scene(scene),
       m_camera(camera),
       m_samples(samples),
+      m_updateRate(1),
+      m_updateCount(0),
+      m_maxDistance(0.f),
+      m_visibilityCulling(false),
+      m_resolutionScale(1.f),
       m_owncamera(false),
       m_observer(nullptr),
       m_mirror(nullptr),
@@ -101,6 +120,11 @@ ImageRender::~ImageRender(void)
 #endif
   m_scene->RemoveImageRenderCamera(m_camera);
 
+  std::map<KX_Camera *, SharedRender>::iterator it = sharedRenders.find(m_camera);
+  if (it != sharedRenders.end() && it->second.m_owner == this) {
+    sharedRenders.erase(it);
+  }
+
   if (m_owncamera) {
     m_camera->Release();
   }
@@ -117,6 +141,50 @@ int ImageRender::GetColorBindCode() const
   return -1;
 }
 
+int ImageRender::GetDepthBindCode() const
+{
+  if (m_camera->GetGPUViewport()) {
+    return GPU_texture_opengl_bindcode(GPU_viewport_depth_texture(m_camera->GetGPUViewport()));
+  }
+  return -1;
+}
+
+bool ImageRender::hasDrawCallbacks() const
+{
+#ifdef WITH_PYTHON
+  return ((m_preDrawCallbacks && PyList_GET_SIZE(m_preDrawCallbacks) > 0) ||
+          (m_postDrawCallbacks && PyList_GET_SIZE(m_postDrawCallbacks) > 0));
+#else
+  return false;
+#endif
+}
+
+bool ImageRender::useSharedRender()
+{
+  const double clockTime = m_engine->GetClockTime();
+  const GLint area[4] = {m_position[0], m_position[1], m_capSize[0], m_capSize[1]};
+  // the draw callbacks are only run by a render of their own
+  const bool callbacks = hasDrawCallbacks();
+
+  std::map<KX_Camera *, SharedRender>::iterator it = sharedRenders.find(m_camera);
+  if (!callbacks && it != sharedRenders.end()) {
+    const SharedRender &render = it->second;
+    if (render.m_owner != this && !render.m_callbacks && render.m_clockTime == clockTime &&
+        render.m_samples == m_samples && memcmp(render.m_area, area, sizeof(area)) == 0) {
+      return true;
+    }
+  }
+
+  // this render becomes the one shared with the other ImageRender of the camera
+  SharedRender &render = sharedRenders[m_camera];
+  render.m_owner = this;
+  render.m_clockTime = clockTime;
+  memcpy(render.m_area, area, sizeof(area));
+  render.m_samples = m_samples;
+  render.m_callbacks = callbacks;
+  return false;
+}
+
 // capture image from viewport
 void ImageRender::calcViewport(unsigned int texId, double ts, unsigned int format)
 {
@@ -153,6 +221,62 @@ void ImageRender::calcViewport(unsigned int texId, double ts, unsigned int forma
   GPU_framebuffer_restore();
 }
 
+void ImageRender::setResolutionScale(float scale)
+{
+  m_resolutionScale = scale;
+  // render a centered area of the viewport, the image size follows the scale
+  short size[2];
+  GLint pos[2];
+  for (int idx = 0; idx < 2; ++idx) {
+    size[idx] = short(getViewportSize()[idx] * scale);
+  }
+  setCaptureSize(size);
+  for (int idx = 0; idx < 2; ++idx) {
+    pos[idx] = (getViewportSize()[idx] - m_capSize[idx]) >> 1;
+  }
+  setPosition(pos);
+}
+
+bool ImageRender::needRender()
+{
+  // the texture keeps the last rendered image when a render is skipped
+  if (m_updateRate > 1) {
+    const unsigned short count = m_updateCount;
+    m_updateCount = (m_updateCount + 1) % m_updateRate;
+    if (count != 0) {
+      return false;
+    }
+  }
+
+  KX_Camera *activecam = m_scene->GetActiveCamera();
+  if (!activecam) {
+    return true;
+  }
+
+  if (m_maxDistance > 0.f) {
+    const MT_Vector3 &pos = m_mirror ? m_mirror->NodeGetWorldPosition() :
+                                       m_camera->NodeGetWorldPosition();
+    if ((pos - activecam->NodeGetWorldPosition()).length2() > m_maxDistance * m_maxDistance) {
+      return false;
+    }
+  }
+
+  if (m_mirror && m_visibilityCulling) {
+    if (!m_mirror->GetVisible()) {
+      return false;
+    }
+    // the mirror bounds from the culling node are in object space
+    const SG_BBox &aabb = m_mirror->GetCullingNode().GetAabb();
+    const MT_Matrix4x4 mat(m_mirror->NodeGetWorldTransform());
+    if (activecam->GetFrustum().AabbInsideFrustum(aabb.GetMin(), aabb.GetMax(), mat) ==
+        SG_Frustum::OUTSIDE) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
 bool ImageRender::Render()
 {
   RAS_FrameFrustum frustum;
@@ -163,6 +287,17 @@ bool ImageRender::Render()
     return false;
   }
 
+  if (!needRender()) {
+    return false;
+  }
+
+  // the color and depth textures of the camera viewport already contain this frame
+  if (!m_mirror && useSharedRender()) {
+    m_done = true;
+    m_avail = false;
+    return true;
+  }
+
   /* Viewport render mode doesn't support ImageRender then exit here
    * if we are trying to use not supported features. */
   if (KX_GetActiveEngine()->UseViewportRender()) {
@@ -375,6 +510,10 @@ bool ImageRender::Render()
   int num_passes = max_ii(1, m_samples);
   num_passes = min_ii(num_passes, m_scene->GetBlenderScene()->eevee.taa_samples);
 
+  if (m_rasterizer->GetUseGpuTimers()) {
+    m_rasterizer->BeginGpuTimer("ImageRender " + m_camera->GetName());
+  }
+
   for (int i = 0; i < num_passes; i++) {
     GPU_clear_depth(1.0f);
     /* viewport and window share the same values here */
@@ -382,6 +521,8 @@ bool ImageRender::Render()
     m_scene->RenderAfterCameraSetupImageRender(m_camera, &window);
   }
 
+  m_rasterizer->EndGpuTimer();
+
 #ifdef WITH_PYTHON
   RunPostDrawCallbacks();
   // These may be nullptr but the macro checks.
@@ -550,6 +691,11 @@ static PyObject *getColorBindCode(PyImage *self, void *closure)
   return PyLong_FromLong(getImageRender(self)->GetColorBindCode());
 }
 
+static PyObject *getDepthBindCode(PyImage *self, void *closure)
+{
+  return PyLong_FromLong(getImageRender(self)->GetDepthBindCode());
+}
+
 static PyObject *getPreDrawCallbacks(PyImage *self, void *closure)
 {
   ImageRender *imageRender = getImageRender(self);
@@ -620,8 +766,79 @@ static PyMethodDef imageRenderMethods[] = {  // methods from ImageBase class
      METH_NOARGS,
      "Render scene - run before refresh() to performs asynchronous render"},
     {nullptr}};
+// get update rate
+static PyObject *getUpdateRate(PyImage *self, void *closure)
+{
+  return PyLong_FromLong(getImageRender(self)->getUpdateRate());
+}
+
+// set update rate
+static int setUpdateRate(PyImage *self, PyObject *value, void *closure)
+{
+  long rate;
+  if (value == nullptr || !PyLong_Check(value) || (rate = PyLong_AsLong(value)) < 1 ||
+      rate > 1000) {
+    PyErr_SetString(PyExc_TypeError, "The value must be an integer between 1 and 1000");
+    return -1;
+  }
+  getImageRender(self)->setUpdateRate((unsigned short)rate);
+  return 0;
+}
+
+// get max distance
+static PyObject *getMaxDistance(PyImage *self, void *closure)
+{
+  return PyFloat_FromDouble(getImageRender(self)->getMaxDistance());
+}
+
+// set max distance
+static int setMaxDistance(PyImage *self, PyObject *value, void *closure)
+{
+  double distance;
+  if (value == nullptr || !PyFloat_Check(value) || (distance = PyFloat_AsDouble(value)) < 0.0) {
+    PyErr_SetString(PyExc_TypeError, "The value must be a positive float");
+    return -1;
+  }
+  getImageRender(self)->setMaxDistance(float(distance));
+  return 0;
+}
+
+// get resolution scale
+static PyObject *getResolutionScale(PyImage *self, void *closure)
+{
+  return PyFloat_FromDouble(getImageRender(self)->getResolutionScale());
+}
+
+// set resolution scale
+static int setResolutionScale(PyImage *self, PyObject *value, void *closure)
+{
+  double scale;
+  if (value == nullptr || !PyFloat_Check(value) || (scale = PyFloat_AsDouble(value)) < 0.1 ||
+      scale > 1.0) {
+    PyErr_SetString(PyExc_TypeError, "The value must be a float between 0.1 and 1.0");
+    return -1;
+  }
+  getImageRender(self)->setResolutionScale(float(scale));
+  return 0;
+}
+
 // attributes structure
 static PyGetSetDef imageRenderGetSets[] = {
+    {(char *)"updateRate",
+     (getter)getUpdateRate,
+     (setter)setUpdateRate,
+     (char *)"number of refreshes between two renders",
+     nullptr},
+    {(char *)"maxDistance",
+     (getter)getMaxDistance,
+     (setter)setMaxDistance,
+     (char *)"distance to the active camera beyond which the render is skipped",
+     nullptr},
+    {(char *)"resolutionScale",
+     (getter)getResolutionScale,
+     (setter)setResolutionScale,
+     (char *)"scale of the render area relative to the viewport",
+     nullptr},
     // attribute from ImageViewport
     {(char *)"capsize",
      (getter)ImageViewport_getCaptureSize,
@@ -633,6 +850,11 @@ static PyGetSetDef imageRenderGetSets[] = {
      (setter)ImageViewport_setAlpha,
      (char *)"use alpha in texture",
      nullptr},
+    {(char *)"asyncFrames",
+     (getter)ImageViewport_getAsyncFrames,
+     (setter)ImageViewport_setAsyncFrames,
+     (char *)"number of frames of delay of the asynchronous capture",
+     nullptr},
     {(char *)"whole",
      (getter)ImageViewport_getWhole,
      (setter)ImageViewport_setWhole,
@@ -676,6 +898,11 @@ static PyGetSetDef imageRenderGetSets[] = {
      nullptr,
      (char *)"Off-screen color texture bind code",
      nullptr},
+    {(char *)"depthBindCode",
+     (getter)getDepthBindCode,
+     nullptr,
+     (char *)"Off-screen depth texture bind code",
+     nullptr},
     {(char *)"pre_draw",
      (getter)getPreDrawCallbacks,
      (setter)setPreDrawCallbacks,
@@ -838,9 +1065,49 @@ static int setClip(PyImage *self, PyObject *value, void *closure)
   return 0;
 }
 
+// get visibility culling
+static PyObject *getVisibilityCulling(PyImage *self, void *closure)
+{
+  if (getImageRender(self)->getVisibilityCulling())
+    Py_RETURN_TRUE;
+  else
+    Py_RETURN_FALSE;
+}
+
+// set visibility culling
+static int setVisibilityCulling(PyImage *self, PyObject *value, void *closure)
+{
+  if (value == nullptr || !PyBool_Check(value)) {
+    PyErr_SetString(PyExc_TypeError, "The value must be a bool");
+    return -1;
+  }
+  getImageRender(self)->setVisibilityCulling(value == Py_True);
+  return 0;
+}
+
 // attributes structure
 static PyGetSetDef imageMirrorGetSets[] = {
     {(char *)"clip", (getter)getClip, (setter)setClip, (char *)"clipping distance", nullptr},
+    {(char *)"updateRate",
+     (getter)getUpdateRate,
+     (setter)setUpdateRate,
+     (char *)"number of refreshes between two renders",
+     nullptr},
+    {(char *)"maxDistance",
+     (getter)getMaxDistance,
+     (setter)setMaxDistance,
+     (char *)"distance to the active camera beyond which the render is skipped",
+     nullptr},
+    {(char *)"resolutionScale",
+     (getter)getResolutionScale,
+     (setter)setResolutionScale,
+     (char *)"scale of the render area relative to the viewport",
+     nullptr},
+    {(char *)"visibilityCulling",
+     (getter)getVisibilityCulling,
+     (setter)setVisibilityCulling,
+     (char *)"skip the render when the mirror is outside of the active camera view",
+     nullptr},
     // attribute from ImageViewport
     {(char *)"capsize",
      (getter)ImageViewport_getCaptureSize,
@@ -852,6 +1119,11 @@ static PyGetSetDef imageMirrorGetSets[] = {
      (setter)ImageViewport_setAlpha,
      (char *)"use alpha in texture",
      nullptr},
+    {(char *)"asyncFrames",
+     (getter)ImageViewport_getAsyncFrames,
+     (setter)ImageViewport_setAsyncFrames,
+     (char *)"number of frames of delay of the asynchronous capture",
+     nullptr},
     {(char *)"whole",
      (getter)ImageViewport_getWhole,
      (setter)ImageViewport_setWhole,
@@ -905,6 +1177,11 @@ ImageRender::ImageRender(KX_Scene *scene,
       m_done(false),
       m_scene(scene),
       m_samples(samples),
+      m_updateRate(1),
+      m_updateCount(0),
+      m_maxDistance(0.f),
+      m_visibilityCulling(false),
+      m_resolutionScale(1.f),
       m_observer(observer),
       m_mirror(mirror),
       m_clip(100.f)
@@ -939,6 +1216,7 @@ ImageRender::ImageRender(KX_Scene *scene,
   // don't add the camera to the scene object list, it doesn't need to be accessible
   m_owncamera = true;
   // locate the vertex assigned to mat and do following calculation in mesh coordinates
+  mirror->ConvertMeshGeometry();
   for (int meshIndex = 0; meshIndex < mirror->GetMeshCount(); meshIndex++) {
     RAS_MeshObject *mesh = mirror->GetMesh(meshIndex);
     int numPolygons = mesh->NumPolygons();
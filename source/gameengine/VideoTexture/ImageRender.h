@@ -63,6 +63,8 @@ class ImageRender : public ImageViewport {
 
   /// Get color off screen bind code.
   int GetColorBindCode() const;
+  /// Get depth off screen bind code.
+  int GetDepthBindCode() const;
 
   /// clipping distance
   float getClip(void)
@@ -74,6 +76,44 @@ class ImageRender : public ImageViewport {
   {
     m_clip = clip;
   }
+  /// number of refreshes between two renders
+  unsigned short getUpdateRate(void)
+  {
+    return m_updateRate;
+  }
+  /// set number of refreshes between two renders
+  void setUpdateRate(unsigned short rate)
+  {
+    m_updateRate = rate;
+    m_updateCount = 0;
+  }
+  /// distance to the active camera beyond which the render is skipped, 0 if never skipped
+  float getMaxDistance(void)
+  {
+    return m_maxDistance;
+  }
+  /// set distance to the active camera beyond which the render is skipped
+  void setMaxDistance(float distance)
+  {
+    m_maxDistance = distance;
+  }
+  /// skip the render when the mirror is not visible by the active camera
+  bool getVisibilityCulling(void)
+  {
+    return m_visibilityCulling;
+  }
+  /// set mirror visibility culling
+  void setVisibilityCulling(bool culling)
+  {
+    m_visibilityCulling = culling;
+  }
+  /// scale of the render area relative to the viewport size
+  float getResolutionScale(void)
+  {
+    return m_resolutionScale;
+  }
+  /// set scale of the render area relative to the viewport size
+  void setResolutionScale(float scale);
   /// render status
   bool isDone()
   {
@@ -103,6 +143,16 @@ class ImageRender : public ImageViewport {
   KX_Camera *m_camera;
   /// number of render passes
   unsigned short m_samples;
+  /// render once every m_updateRate refreshes
+  unsigned short m_updateRate;
+  /// refreshes since the last render
+  unsigned short m_updateCount;
+  /// skip the render beyond this distance to the active camera, 0 to disable
+  float m_maxDistance;
+  /// skip the render of a mirror outside of the active camera view
+  bool m_visibilityCulling;
+  /// scale of the render area relative to the viewport size
+  float m_resolutionScale;
   /// do we own the camera?
   bool m_owncamera;
 
@@ -125,6 +175,16 @@ class ImageRender : public ImageViewport {
   /// engine
   KX_KetsjiEngine *m_engine;
 
+  /// return false if the render can be skipped this frame
+  bool needRender();
+  /// return true if pre_draw or post_draw callbacks are set
+  bool hasDrawCallbacks() const;
+  /** return true if another ImageRender of the same camera already rendered the same
+   * area this frame, its result in the camera viewport is then used by this one,
+   * renders with draw callbacks are never shared
+   */
+  bool useSharedRender();
+
   /// render 3d scene to image
   virtual void calcImage(unsigned int texId, double ts, unsigned int format)
   {
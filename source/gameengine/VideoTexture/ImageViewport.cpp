@@ -38,7 +38,8 @@
 #include "RAS_ICanvas.h"
 #include "Texture.h"
 
-ImageViewport::ImageViewport() : m_alpha(false), m_texInit(false)
+ImageViewport::ImageViewport()
+    : m_alpha(false), m_texInit(false), m_asyncFrames(0), m_asyncIndex(0)
 {
   /* Because this constructor is called from python direclty without any arguments
    * the viewport should be the one of the final screen with gaps.
@@ -67,7 +68,12 @@ ImageViewport::ImageViewport() : m_alpha(false), m_texInit(false)
 
 // constructor
 ImageViewport::ImageViewport(unsigned int width, unsigned int height)
-    : m_width(width), m_height(height), m_alpha(false), m_texInit(false)
+    : m_width(width),
+      m_height(height),
+      m_alpha(false),
+      m_texInit(false),
+      m_asyncFrames(0),
+      m_asyncIndex(0)
 {
   m_viewport[0] = 0;
   m_viewport[1] = 0;
@@ -86,6 +92,7 @@ ImageViewport::ImageViewport(unsigned int width, unsigned int height)
 // destructor
 ImageViewport::~ImageViewport(void)
 {
+  freeAsyncReads();
   delete[] m_viewportImage;
 }
 
@@ -144,6 +151,95 @@ void ImageViewport::setPosition(GLint pos[2])
     m_upLeft[idx] = m_position[idx] + m_viewport[idx];
 }
 
+void ImageViewport::setAsyncFrames(unsigned short frames)
+{
+  if (frames != m_asyncFrames) {
+    freeAsyncReads();
+    m_asyncFrames = frames;
+  }
+}
+
+void ImageViewport::freeAsyncReads(void)
+{
+  for (AsyncRead &read : m_asyncReads) {
+    if (read.m_fence) {
+      glDeleteSync(read.m_fence);
+    }
+    glDeleteBuffers(1, &read.m_pbo);
+  }
+  m_asyncReads.clear();
+  m_asyncIndex = 0;
+}
+
+bool ImageViewport::readPixels(GLenum format, GLenum type, void *buffer)
+{
+  if (m_asyncFrames == 0) {
+    glReadPixels(m_upLeft[0],
+                 m_upLeft[1],
+                 (GLsizei)m_capSize[0],
+                 (GLsizei)m_capSize[1],
+                 format,
+                 type,
+                 buffer);
+    return true;
+  }
+
+  if (m_asyncReads.empty()) {
+    m_asyncReads.resize(m_asyncFrames);
+    for (AsyncRead &read : m_asyncReads) {
+      glGenBuffers(1, &read.m_pbo);
+      read.m_fence = nullptr;
+      read.m_bufferSize = 0;
+    }
+  }
+
+  const GLint rect[4] = {m_upLeft[0], m_upLeft[1], m_capSize[0], m_capSize[1]};
+  // reads of depth and RGBA use 4 bytes per pixel, RGB uses 3
+  const unsigned int size = rect[2] * rect[3] * ((format == GL_RGB) ? 3 : 4);
+
+  AsyncRead &read = m_asyncReads[m_asyncIndex];
+  bool loaded = false;
+  if (read.m_fence) {
+    // the oldest read is still running, don't wait for it and try again at the next capture
+    if (glClientWaitSync(read.m_fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0) == GL_TIMEOUT_EXPIRED) {
+      return false;
+    }
+    glDeleteSync(read.m_fence);
+    read.m_fence = nullptr;
+
+    // the pixels are only usable if the capture settings didn't change
+    if (read.m_format == format && read.m_type == type && read.m_bufferSize == size &&
+        memcmp(read.m_rect, rect, sizeof(rect)) == 0) {
+      glBindBuffer(GL_PIXEL_PACK_BUFFER, read.m_pbo);
+      const void *data = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, size, GL_MAP_READ_BIT);
+      if (data) {
+        memcpy(buffer, data, size);
+        loaded = true;
+      }
+      glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+      glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    }
+  }
+
+  // start the read of the current pixels in the buffer object
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, read.m_pbo);
+  if (read.m_bufferSize != size) {
+    glBufferData(GL_PIXEL_PACK_BUFFER, size, nullptr, GL_STREAM_READ);
+    read.m_bufferSize = size;
+  }
+  glReadPixels(rect[0], rect[1], (GLsizei)rect[2], (GLsizei)rect[3], format, type, nullptr);
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+  read.m_fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  read.m_format = format;
+  read.m_type = type;
+  memcpy(read.m_rect, rect, sizeof(rect));
+
+  m_asyncIndex = (m_asyncIndex + 1) % m_asyncFrames;
+
+  return loaded;
+}
+
 // capture image from viewport
 void ImageViewport::calcViewport(unsigned int texId, double ts, unsigned int format)
 {
@@ -181,32 +277,22 @@ void ImageViewport::calcViewport(unsigned int texId, double ts, unsigned int for
       // *** misusing m_viewportImage here, but since it has the correct size
       //     (4 bytes per pixel = size of float) and we just need it to apply
       //     the filter, it's ok
-      glReadPixels(m_upLeft[0],
-                   m_upLeft[1],
-                   (GLsizei)m_capSize[0],
-                   (GLsizei)m_capSize[1],
-                   GL_DEPTH_COMPONENT,
-                   GL_FLOAT,
-                   m_viewportImage);
-      // filter loaded data
-      FilterZZZA filt;
-      filterImage(filt, (float *)m_viewportImage, m_capSize);
+      if (readPixels(GL_DEPTH_COMPONENT, GL_FLOAT, m_viewportImage)) {
+        // filter loaded data
+        FilterZZZA filt;
+        filterImage(filt, (float *)m_viewportImage, m_capSize);
+      }
     }
     else {
 
       if (m_depth) {
         // Use read pixels with the depth buffer
         // See warning above about m_viewportImage.
-        glReadPixels(m_upLeft[0],
-                     m_upLeft[1],
-                     (GLsizei)m_capSize[0],
-                     (GLsizei)m_capSize[1],
-                     GL_DEPTH_COMPONENT,
-                     GL_FLOAT,
-                     m_viewportImage);
-        // filter loaded data
-        FilterDEPTH filt;
-        filterImage(filt, (float *)m_viewportImage, m_capSize);
+        if (readPixels(GL_DEPTH_COMPONENT, GL_FLOAT, m_viewportImage)) {
+          // filter loaded data
+          FilterDEPTH filt;
+          filterImage(filt, (float *)m_viewportImage, m_capSize);
+        }
       }
       else {
 
@@ -215,35 +301,29 @@ void ImageViewport::calcViewport(unsigned int texId, double ts, unsigned int for
           // as we are reading the pixel in the native format, we can read directly in the image
           // buffer if we are sure that no processing is needed on the image
           if (m_size[0] == m_capSize[0] && m_size[1] == m_capSize[1] && !m_flip && !m_pyfilter) {
-            glReadPixels(m_upLeft[0],
-                         m_upLeft[1],
-                         (GLsizei)m_capSize[0],
-                         (GLsizei)m_capSize[1],
-                         format,
-                         GL_UNSIGNED_BYTE,
-                         m_image);
-            m_avail = true;
+            m_avail = readPixels(format, GL_UNSIGNED_BYTE, m_image);
           }
           else if (!m_pyfilter) {
-            glReadPixels(m_upLeft[0],
-                         m_upLeft[1],
-                         (GLsizei)m_capSize[0],
-                         (GLsizei)m_capSize[1],
-                         format,
-                         GL_UNSIGNED_BYTE,
-                         m_viewportImage);
-            FilterRGBA32 filt;
-            filterImage(filt, m_viewportImage, m_capSize);
+            if (readPixels(format, GL_UNSIGNED_BYTE, m_viewportImage)) {
+              FilterRGBA32 filt;
+              filterImage(filt, m_viewportImage, m_capSize);
+            }
           }
           else {
-            glReadPixels(m_upLeft[0],
-                         m_upLeft[1],
-                         (GLsizei)m_capSize[0],
-                         (GLsizei)m_capSize[1],
-                         GL_RGBA,
-                         GL_UNSIGNED_BYTE,
-                         m_viewportImage);
-            FilterRGBA32 filt;
+            if (readPixels(GL_RGBA, GL_UNSIGNED_BYTE, m_viewportImage)) {
+              FilterRGBA32 filt;
+              filterImage(filt, m_viewportImage, m_capSize);
+              if (format == GL_BGRA) {
+                // in place byte swapping
+                swapImageBR();
+              }
+            }
+          }
+        }
+        else {
+          if (readPixels(GL_RGB, GL_UNSIGNED_BYTE, m_viewportImage)) {
+            // filter loaded data
+            FilterRGB24 filt;
             filterImage(filt, m_viewportImage, m_capSize);
             if (format == GL_BGRA) {
               // in place byte swapping
@@ -251,22 +331,6 @@ void ImageViewport::calcViewport(unsigned int texId, double ts, unsigned int for
             }
           }
         }
-        else {
-          glReadPixels(m_upLeft[0],
-                       m_upLeft[1],
-                       (GLsizei)m_capSize[0],
-                       (GLsizei)m_capSize[1],
-                       GL_RGB,
-                       GL_UNSIGNED_BYTE,
-                       m_viewportImage);
-          // filter loaded data
-          FilterRGB24 filt;
-          filterImage(filt, m_viewportImage, m_capSize);
-          if (format == GL_BGRA) {
-            // in place byte swapping
-            swapImageBR();
-          }
-        }
       }
     }
   }
@@ -314,6 +378,28 @@ inline ImageViewport *getImageViewport(PyImage *self)
 
 // python methods
 
+// get async frames
+PyObject *ImageViewport_getAsyncFrames(PyImage *self, void *closure)
+{
+  return PyLong_FromLong(getImageViewport(self)->getAsyncFrames());
+}
+
+// set async frames
+int ImageViewport_setAsyncFrames(PyImage *self, PyObject *value, void *closure)
+{
+  long frames;
+  // check parameter, report failure
+  if (value == nullptr || !PyLong_Check(value) || (frames = PyLong_AsLong(value)) < 0 ||
+      frames > 16) {
+    PyErr_SetString(PyExc_TypeError, "The value must be an integer between 0 and 16");
+    return -1;
+  }
+  // set async frames
+  getImageViewport(self)->setAsyncFrames((unsigned short)frames);
+  // success
+  return 0;
+}
+
 // get whole
 PyObject *ImageViewport_getWhole(PyImage *self, void *closure)
 {
@@ -460,6 +546,11 @@ static PyGetSetDef imageViewportGetSets[] = {
      (setter)ImageViewport_setAlpha,
      (char *)"use alpha in texture",
      nullptr},
+    {(char *)"asyncFrames",
+     (getter)ImageViewport_getAsyncFrames,
+     (setter)ImageViewport_setAsyncFrames,
+     (char *)"number of frames of delay of the asynchronous capture",
+     nullptr},
     // attributes from ImageBase class
     {(char *)"valid",
      (getter)Image_valid,
@@ -30,6 +30,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "GPU_glew.h"
 
 #include "Common.h"
@@ -81,6 +83,14 @@ class ImageViewport : public ImageBase {
   /// set position in viewport
   void setPosition(GLint pos[2] = nullptr);
 
+  /// get number of frames of delay of the asynchronous capture
+  unsigned short getAsyncFrames(void)
+  {
+    return m_asyncFrames;
+  }
+  /// set number of frames of delay of the asynchronous capture, 0 to capture synchronously
+  void setAsyncFrames(unsigned short frames);
+
   /// capture image from viewport to user buffer
   virtual bool loadImage(unsigned int *buffer, unsigned int size, unsigned int format, double ts);
 
@@ -107,6 +117,33 @@ class ImageViewport : public ImageBase {
   /// texture is initialized
   bool m_texInit;
 
+  /// pixel read in progress in a pixel buffer object
+  struct AsyncRead {
+    GLuint m_pbo;
+    /// fence signaled when the read is complete, nullptr if no read is pending
+    GLsync m_fence;
+    unsigned int m_bufferSize;
+    GLenum m_format;
+    GLenum m_type;
+    /// captured area
+    GLint m_rect[4];
+  };
+
+  /// number of frames of delay of the asynchronous capture
+  unsigned short m_asyncFrames;
+  /// ring of pixel reads, one per frame of delay
+  std::vector<AsyncRead> m_asyncReads;
+  /// next read of the ring to use
+  unsigned short m_asyncIndex;
+
+  /** read pixels of the capture area to buffer, in asynchronous mode the pixels are
+   * the ones read m_asyncFrames captures before
+   * \return false if no pixels were available
+   */
+  bool readPixels(GLenum format, GLenum type, void *buffer);
+  /// delete the pixel buffer objects of the asynchronous capture
+  void freeAsyncReads(void);
+
   /// capture image from viewport
   virtual void calcImage(unsigned int texId, double ts)
   {
@@ -129,3 +166,5 @@ PyObject *ImageViewport_getWhole(PyImage *self, void *closure);
 int ImageViewport_setWhole(PyImage *self, PyObject *value, void *closure);
 PyObject *ImageViewport_getAlpha(PyImage *self, void *closure);
 int ImageViewport_setAlpha(PyImage *self, PyObject *value, void *closure);
+PyObject *ImageViewport_getAsyncFrames(PyImage *self, void *closure);
+int ImageViewport_setAsyncFrames(PyImage *self, PyObject *value, void *closure);
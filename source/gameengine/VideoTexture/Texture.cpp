@@ -78,8 +78,10 @@ Texture::Texture()
       m_mipmap(false),
       m_scaledImBuf(nullptr),
       m_lastClock(0.0),
-      m_source(nullptr)
+      m_source(nullptr),
+      m_streamIndex(0)
 {
+  m_streamSize[0] = m_streamSize[1] = 0;
   textures.push_back(this);
 }
 
@@ -89,6 +91,7 @@ Texture::~Texture()
   Py_XDECREF(m_source);
   // close texture
   Close();
+  FreeStreamBuffers();
   // release scaled image buffer
   IMB_freeImBuf(m_scaledImBuf);
 }
@@ -146,6 +149,7 @@ void Texture::Close()
       glDeleteTextures(1, (GLuint *)&m_actTex);
       m_actTex = 0;
     }
+    m_streamSize[0] = m_streamSize[1] = 0;
   }
 }
 
@@ -157,6 +161,124 @@ void Texture::SetSource(PyImage *source)
   m_source = source;
 }
 
+// number of buffers of the streaming ring, enough to not wait for the uploads in flight
+#define STREAM_BUFFER_COUNT 3
+
+void Texture::FreeStreamBuffers()
+{
+  for (StreamBuffer &buffer : m_streamBuffers) {
+    if (buffer.m_fence) {
+      glDeleteSync(buffer.m_fence);
+    }
+    if (buffer.m_data) {
+      glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer.m_pbo);
+      glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+    }
+    glDeleteBuffers(1, &buffer.m_pbo);
+  }
+  glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+  m_streamBuffers.clear();
+  m_streamIndex = 0;
+}
+
+void Texture::StreamTexture(unsigned int *texture, short *size, unsigned int internalFormat)
+{
+  if (m_streamBuffers.empty()) {
+    m_streamBuffers.resize(STREAM_BUFFER_COUNT);
+    for (StreamBuffer &buffer : m_streamBuffers) {
+      glGenBuffers(1, &buffer.m_pbo);
+      buffer.m_fence = nullptr;
+      buffer.m_data = nullptr;
+      buffer.m_bufferSize = 0;
+    }
+  }
+
+  const unsigned int imageSize = size[0] * size[1] * sizeof(unsigned int);
+  StreamBuffer &buffer = m_streamBuffers[m_streamIndex];
+  m_streamIndex = (m_streamIndex + 1) % STREAM_BUFFER_COUNT;
+
+  // the buffer can be written only once the previous upload from it is done
+  if (buffer.m_fence) {
+    glClientWaitSync(buffer.m_fence, GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
+    glDeleteSync(buffer.m_fence);
+    buffer.m_fence = nullptr;
+  }
+
+  glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer.m_pbo);
+  void *data = nullptr;
+  if (GLEW_ARB_buffer_storage) {
+    // buffer storage is immutable, a new buffer is needed when the image size changes
+    if (buffer.m_bufferSize != imageSize) {
+      if (buffer.m_bufferSize != 0) {
+        if (buffer.m_data) {
+          glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+        }
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        glDeleteBuffers(1, &buffer.m_pbo);
+        glGenBuffers(1, &buffer.m_pbo);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer.m_pbo);
+      }
+      const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+      glBufferStorage(GL_PIXEL_UNPACK_BUFFER, imageSize, nullptr, flags);
+      buffer.m_data = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, imageSize, flags);
+      buffer.m_bufferSize = imageSize;
+    }
+    data = buffer.m_data;
+  }
+  else {
+    if (buffer.m_bufferSize != imageSize) {
+      glBufferData(GL_PIXEL_UNPACK_BUFFER, imageSize, nullptr, GL_STREAM_DRAW);
+      buffer.m_bufferSize = imageSize;
+    }
+    data = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER,
+                            0,
+                            imageSize,
+                            GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT |
+                                GL_MAP_UNSYNCHRONIZED_BIT);
+  }
+
+  if (data == nullptr) {
+    // mapping failed, fallback to the client memory upload
+    if (!GLEW_ARB_buffer_storage) {
+      glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+    }
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    m_streamSize[0] = m_streamSize[1] = 0;
+    loadTexture(m_actTex, texture, size, m_mipmap, internalFormat);
+    return;
+  }
+
+  memcpy(data, texture, imageSize);
+  if (!GLEW_ARB_buffer_storage) {
+    glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+  }
+
+  glBindTexture(GL_TEXTURE_2D, m_actTex);
+  // allocate the texture storage only when the size changes, then update it in place
+  if (m_streamSize[0] != size[0] || m_streamSize[1] != size[1]) {
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexImage2D(GL_TEXTURE_2D,
+                 0,
+                 internalFormat,
+                 size[0],
+                 size[1],
+                 0,
+                 GL_RGBA,
+                 GL_UNSIGNED_BYTE,
+                 nullptr);
+    m_streamSize[0] = size[0];
+    m_streamSize[1] = size[1];
+  }
+  // the source of the upload is the offset in the bound unpack buffer
+  glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, size[0], size[1], GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+  // the mipmaps are computed on GPU instead of IMB_makemipmap as in loadTexture
+  glGenerateMipmap(GL_TEXTURE_2D);
+  glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+  buffer.m_fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
 // load texture
 void loadTexture(unsigned int texId,
                  unsigned int *texture,
@@ -454,7 +576,7 @@ EXP_PYMETHODDEF_DOC(Texture, refresh, "Refresh texture from source")
             texture = m_scaledImBuf->rect;
           }
           // load texture for rendering
-          loadTexture(m_actTex, texture, size, m_mipmap, m_source->m_image->GetInternalFormat());
+          StreamTexture(texture, size, m_source->m_image->GetInternalFormat());
         }
         // refresh texture source, if required
         if (refreshSource) {
@@ -30,7 +30,10 @@
 
 #pragma once
 
+#include <vector>
+
 #include "DNA_image_types.h"
+#include "GPU_glew.h"
 
 #include "EXP_Value.h"
 #include "Exception.h"
@@ -80,6 +83,23 @@ class Texture : public EXP_Value {
   // image source
   PyImage *m_source;
 
+  // pixel buffer object used to stream the images to the texture
+  struct StreamBuffer {
+    GLuint m_pbo;
+    // fence signaled when the upload from the buffer is complete, nullptr if none is pending
+    GLsync m_fence;
+    // persistent mapping of the buffer, nullptr if the buffer is mapped at each upload
+    void *m_data;
+    unsigned int m_bufferSize;
+  };
+
+  // ring of streaming buffers, the upload of a frame overlaps the rendering of the previous ones
+  std::vector<StreamBuffer> m_streamBuffers;
+  // next buffer of the ring to use
+  unsigned short m_streamIndex;
+  // size of the texture storage allocated by the streaming upload
+  short m_streamSize[2];
+
   Texture();
   virtual ~Texture();
 
@@ -88,6 +108,11 @@ class Texture : public EXP_Value {
   void Close();
   void SetSource(PyImage *source);
 
+  // upload the image to the texture through the streaming buffers
+  void StreamTexture(unsigned int *texture, short *size, unsigned int internalFormat);
+  // delete the streaming buffers
+  void FreeStreamBuffers();
+
   static void FreeAllTextures(KX_Scene *scene);
 
   EXP_PYMETHOD_DOC(Texture, close);
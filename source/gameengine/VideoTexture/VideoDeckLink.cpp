@@ -724,23 +724,19 @@ VideoDeckLink::VideoDeckLink(HRESULT *hRslt)
 {
   mDisplayMode = (BMDDisplayMode)0;
   mPixelFormat = (BMDPixelFormat)0;
-  pthread_mutex_init(&mCacheMutex, nullptr);
 }
 
 // destructor
 VideoDeckLink::~VideoDeckLink()
 {
-  LockCache();
   mClosing = true;
-  if (mpCacheFrame) {
-    mpCacheFrame->Release();
-    mpCacheFrame = nullptr;
-  }
-  UnlockCache();
+  ReleaseCacheFrame();
   if (mDLInput != nullptr) {
     // Cleanup for Capture
     mDLInput->StopStreams();
     mDLInput->SetCallback(nullptr);
+    // a callback running while closing may have stored a last frame
+    ReleaseCacheFrame();
     mDLInput->DisableVideoInput();
     mDLInput->DisableAudioInput();
     mDLInput->FlushStreams();
@@ -1059,11 +1055,7 @@ void VideoDeckLink::setFrameRate(float rate)
 // send cache frame directly to GPU
 void VideoDeckLink::calcImage(unsigned int texId, double ts)
 {
-  IDeckLinkVideoInputFrame *pFrame;
-  LockCache();
-  pFrame = mpCacheFrame;
-  mpCacheFrame = nullptr;
-  UnlockCache();
+  IDeckLinkVideoInputFrame *pFrame = mpCacheFrame.exchange(nullptr);
   if (pFrame) {
     // BUG: the dvpBindToGLCtx function fails the first time it is used, don't know why.
     // This causes an exception to be thrown.
@@ -1124,19 +1116,23 @@ void VideoDeckLink::calcImage(unsigned int texId, double ts)
 // Called from an internal thread, just pass the frame to the main thread
 void VideoDeckLink::VideoFrameArrived(IDeckLinkVideoInputFrame *inputFrame)
 {
-  IDeckLinkVideoInputFrame *pOldFrame = nullptr;
-  LockCache();
-  if (!mClosing) {
-    pOldFrame = mpCacheFrame;
-    mpCacheFrame = inputFrame;
-    inputFrame->AddRef();
+  if (mClosing) {
+    return;
   }
-  UnlockCache();
+  inputFrame->AddRef();
+  IDeckLinkVideoInputFrame *pOldFrame = mpCacheFrame.exchange(inputFrame);
   // old frame no longer needed, just release it
   if (pOldFrame)
     pOldFrame->Release();
 }
 
+void VideoDeckLink::ReleaseCacheFrame()
+{
+  IDeckLinkVideoInputFrame *pFrame = mpCacheFrame.exchange(nullptr);
+  if (pFrame)
+    pFrame->Release();
+}
+
 // python methods
 
 // object initialization
@@ -37,6 +37,7 @@
 #  if defined(__FreeBSD__)
 #    include <inttypes.h>
 #  endif
+#  include <atomic>
 #  include <map>
 #  include <set>
 
@@ -114,14 +115,8 @@ class VideoDeckLink : public VideoBase {
 
  private:
   void VideoFrameArrived(IDeckLinkVideoInputFrame *inputFrame);
-  void LockCache()
-  {
-    pthread_mutex_lock(&mCacheMutex);
-  }
-  void UnlockCache()
-  {
-    pthread_mutex_unlock(&mCacheMutex);
-  }
+  /// release the frame left in cache
+  void ReleaseCacheFrame();
 
   IDeckLinkInput *mDLInput;
   BMDDisplayMode mDisplayMode;
@@ -134,10 +129,10 @@ class VideoDeckLink : public VideoBase {
   CaptureDelegate *mpCaptureDelegate;
 
   // cache frame in transit between the callback thread and the main BGE thread
-  // keep only one frame in cache because we just want to keep up with real time
-  pthread_mutex_t mCacheMutex;
-  IDeckLinkVideoInputFrame *mpCacheFrame;
-  bool mClosing;
+  // keep only one frame in cache because we just want to keep up with real time,
+  // both threads exchange it atomically without locking
+  std::atomic<IDeckLinkVideoInputFrame *> mpCacheFrame;
+  std::atomic<bool> mClosing;
 };
 
 inline VideoDeckLink *getDeckLink(PyImage *self)
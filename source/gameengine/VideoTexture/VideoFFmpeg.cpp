@@ -75,6 +75,10 @@ VideoFFmpeg::VideoFFmpeg(HRESULT *hRslt)
       m_frameDeinterlaced(nullptr),
       m_frameRGB(nullptr),
       m_imgConvertCtx(nullptr),
+      m_hwDecode(false),
+      m_hwDeviceCtx(nullptr),
+      m_hwPixFmt(AV_PIX_FMT_NONE),
+      m_frameSw(nullptr),
       m_deinterlace(false),
       m_preseek(0),
       m_videoStream(-1),
@@ -91,7 +95,11 @@ VideoFFmpeg::VideoFFmpeg(HRESULT *hRslt)
       m_isThreaded(false),
       m_isStreaming(false),
       m_stopThread(false),
-      m_cacheStarted(false)
+      m_cacheStarted(false),
+      m_frameCacheHead(0),
+      m_frameCacheTail(0),
+      m_packetCacheHead(0),
+      m_packetCacheTail(0)
 {
   // set video format
   m_format = RGB24;
@@ -100,11 +108,6 @@ VideoFFmpeg::VideoFFmpeg(HRESULT *hRslt)
   // construction is OK
   *hRslt = S_OK;
   BLI_listbase_clear(&m_thread);
-  pthread_mutex_init(&m_cacheMutex, nullptr);
-  BLI_listbase_clear(&m_frameCacheFree);
-  BLI_listbase_clear(&m_frameCacheBase);
-  BLI_listbase_clear(&m_packetCacheFree);
-  BLI_listbase_clear(&m_packetCacheBase);
 }
 
 // destructor
@@ -151,6 +154,13 @@ bool VideoFFmpeg::release()
     sws_freeContext(m_imgConvertCtx);
     m_imgConvertCtx = nullptr;
   }
+  if (m_frameSw) {
+    av_frame_free(&m_frameSw);
+  }
+  if (m_hwDeviceCtx) {
+    av_buffer_unref(&m_hwDeviceCtx);
+  }
+  m_hwPixFmt = AV_PIX_FMT_NONE;
   m_codec = nullptr;
   m_status = SourceStopped;
   m_lastFrame = -1;
@@ -188,6 +198,98 @@ AVFrame *VideoFFmpeg::allocFrameRGB()
   return frame;
 }
 
+#  ifdef FFMPEG_HAVE_HW_DECODE
+static AVPixelFormat get_hw_format(AVCodecContext *codecCtx, const AVPixelFormat *formats)
+{
+  const AVPixelFormat hwPixFmt = *static_cast<AVPixelFormat *>(codecCtx->opaque);
+  for (const AVPixelFormat *format = formats; *format != AV_PIX_FMT_NONE; ++format) {
+    if (*format == hwPixFmt) {
+      return hwPixFmt;
+    }
+  }
+  // the hardware doesn't support this stream, fall back to a software format
+  return avcodec_default_get_format(codecCtx, formats);
+}
+#  endif
+
+void VideoFFmpeg::initHwDecode(AVCodecContext *codecCtx, AVCodec *codec)
+{
+#  ifdef FFMPEG_HAVE_HW_DECODE
+  // use the first device supported by the codec that can be created on this system
+  for (int i = 0;; ++i) {
+    const AVCodecHWConfig *config = avcodec_get_hw_config(codec, i);
+    if (!config) {
+      break;
+    }
+    if (!(config->methods & AV_CODEC_HW_CONFIG_METHOD_HW_DEVICE_CTX)) {
+      continue;
+    }
+    if (av_hwdevice_ctx_create(&m_hwDeviceCtx, config->device_type, nullptr, nullptr, 0) < 0) {
+      continue;
+    }
+
+    m_hwPixFmt = config->pix_fmt;
+    codecCtx->hw_device_ctx = av_buffer_ref(m_hwDeviceCtx);
+    codecCtx->opaque = &m_hwPixFmt;
+    codecCtx->get_format = get_hw_format;
+    return;
+  }
+#  endif
+  // Reported once, the same fallback happens for every video opened.
+  static bool reported = false;
+  if (!reported) {
+    std::cout << "Video: no hardware decoder available, decoding in software" << std::endl;
+    reported = true;
+  }
+}
+
+AVFrame *VideoFFmpeg::prepareFrame(AVFrame *frame)
+{
+  AVFrame *input = frame;
+  if (m_hwPixFmt != AV_PIX_FMT_NONE && frame->format == m_hwPixFmt) {
+    // the frame is in the video memory, copy it in its native format (usually NV12)
+    av_frame_unref(m_frameSw);
+    if (av_hwframe_transfer_data(m_frameSw, frame, 0) < 0) {
+      return nullptr;
+    }
+    input = m_frameSw;
+  }
+  else if (m_deinterlace) {
+    // the deinterlace buffer uses the codec format, never the one of the hardware frames
+    if (av_image_deinterlace((AVFrame *)m_frameDeinterlaced,
+                             (const AVFrame *)frame,
+                             m_codecCtx->pix_fmt,
+                             m_codecCtx->width,
+                             m_codecCtx->height) >= 0) {
+      input = m_frameDeinterlaced;
+    }
+  }
+
+  /* The transferred frames don't use the pixel format known at the opening, and the decoder
+   * can fall back to software for some frames. */
+  if (m_hwPixFmt != AV_PIX_FMT_NONE) {
+    const AVPixelFormat format = (input == m_frameSw) ? (AVPixelFormat)input->format :
+                                                        m_codecCtx->pix_fmt;
+    m_imgConvertCtx = sws_getCachedContext(m_imgConvertCtx,
+                                           m_codecCtx->width,
+                                           m_codecCtx->height,
+                                           format,
+                                           m_codecCtx->width,
+                                           m_codecCtx->height,
+                                           (m_format == RGBA32) ? AV_PIX_FMT_RGBA :
+                                                                  AV_PIX_FMT_RGB24,
+                                           SWS_FAST_BILINEAR,
+                                           nullptr,
+                                           nullptr,
+                                           nullptr);
+    if (!m_imgConvertCtx) {
+      return nullptr;
+    }
+  }
+
+  return input;
+}
+
 // set initial parameters
 void VideoFFmpeg::initParams(short width, short height, float rate, bool image)
 {
@@ -245,7 +347,20 @@ int VideoFFmpeg::openStream(const char *filename,
     return -1;
   }
   codecCtx->workaround_bugs = 1;
+  /* Let FFmpeg decode with its threads. The frame threading is not used: its output lags
+   * the packets by one frame per thread, while the frame positions are computed from the
+   * decoded packet and the decoder is not drained at the end of the file. */
+  codecCtx->thread_count = 0;
+  codecCtx->thread_type = FF_THREAD_SLICE;
+  if (m_hwDecode && !m_isImage) {
+    initHwDecode(codecCtx, codec);
+  }
   if (avcodec_open2(codecCtx, codec, nullptr) < 0) {
+    if (m_hwDeviceCtx) {
+      av_buffer_unref(&codecCtx->hw_device_ctx);
+      av_buffer_unref(&m_hwDeviceCtx);
+      m_hwPixFmt = AV_PIX_FMT_NONE;
+    }
     avformat_close_input(&formatCtx);
     return -1;
   }
@@ -266,6 +381,9 @@ int VideoFFmpeg::openStream(const char *filename,
   m_videoStream = videoStream;
   m_frame = av_frame_alloc();
   m_frameDeinterlaced = av_frame_alloc();
+  if (m_hwPixFmt != AV_PIX_FMT_NONE) {
+    m_frameSw = av_frame_alloc();
+  }
 
   // allocate buffer if deinterlacing is required
   av_image_fill_arrays(
@@ -348,7 +466,7 @@ void *VideoFFmpeg::cacheThread(void *data)
   VideoFFmpeg *video = (VideoFFmpeg *)data;
   // holds the frame that is being decoded
   CacheFrame *currentFrame = nullptr;
-  CachePacket *cachePacket;
+  AVPacket *cachePacket;
   bool endOfFile = false;
   int frameFinished = 0;
   double timeBase = av_q2d(video->m_formatCtx->streams[video->m_videoStream]->time_base);
@@ -363,21 +481,21 @@ void *VideoFFmpeg::cacheThread(void *data)
     // allow a bit of cycling to get rid quickly of those frames
     frameFinished = 0;
     while (!endOfFile &&
-           (cachePacket = (CachePacket *)video->m_packetCacheFree.first) != nullptr &&
+           video->m_packetCacheTail - video->m_packetCacheHead < CACHE_PACKET_SIZE &&
            frameFinished < 25) {
       // free packet => packet cache is not full yet, just read more
-      if (av_read_frame(video->m_formatCtx, &cachePacket->packet) >= 0) {
-        if (cachePacket->packet.stream_index == video->m_videoStream) {
+      cachePacket = &video->m_packetCache[video->m_packetCacheTail % CACHE_PACKET_SIZE];
+      if (av_read_frame(video->m_formatCtx, cachePacket) >= 0) {
+        if (cachePacket->stream_index == video->m_videoStream) {
           // make sure fresh memory is allocated for the packet and move it to queue
-          av_dup_packet(&cachePacket->packet);
-          BLI_remlink(&video->m_packetCacheFree, cachePacket);
-          BLI_addtail(&video->m_packetCacheBase, cachePacket);
+          av_dup_packet(cachePacket);
+          ++video->m_packetCacheTail;
           break;
         }
         else {
-          // this is not a good packet for us, just leave it on free queue
+          // this is not a good packet for us, just leave it out of the queue
           // Note: here we could handle sound packet
-          av_free_packet(&cachePacket->packet);
+          av_free_packet(cachePacket);
           frameFinished++;
         }
       }
@@ -389,39 +507,28 @@ void *VideoFFmpeg::cacheThread(void *data)
         break;
       }
     }
-    // frame cache is also used by main thread, lock
-    if (currentFrame == nullptr) {
-      // no current frame being decoded, take free one
-      pthread_mutex_lock(&video->m_cacheMutex);
-      if ((currentFrame = (CacheFrame *)video->m_frameCacheFree.first) != nullptr)
-        BLI_remlink(&video->m_frameCacheFree, currentFrame);
-      pthread_mutex_unlock(&video->m_cacheMutex);
+    // frame cache is also used by main thread, the acquire makes sure it is done with the frame
+    const unsigned int frameTail = video->m_frameCacheTail.load(std::memory_order_relaxed);
+    if (currentFrame == nullptr &&
+        frameTail - video->m_frameCacheHead.load(std::memory_order_acquire) < CACHE_FRAME_SIZE) {
+      // no current frame being decoded, take the free one after the ready frames
+      currentFrame = &video->m_frameCache[frameTail % CACHE_FRAME_SIZE];
     }
     if (currentFrame != nullptr) {
-      // this frame is out of free and busy queue, we can manipulate it without locking
+      // this frame is not visible to the main thread until the tail moves past it
       frameFinished = 0;
-      while (!frameFinished &&
-             (cachePacket = (CachePacket *)video->m_packetCacheBase.first) != nullptr) {
-        BLI_remlink(&video->m_packetCacheBase, cachePacket);
+      while (!frameFinished && video->m_packetCacheHead != video->m_packetCacheTail) {
+        cachePacket = &video->m_packetCache[video->m_packetCacheHead++ % CACHE_PACKET_SIZE];
         // use m_frame because when caching, it is not used in main thread
         // we can't use currentFrame directly because we need to convert to RGB first
-        avcodec_decode_video2(
-            video->m_codecCtx, video->m_frame, &frameFinished, &cachePacket->packet);
+        avcodec_decode_video2(video->m_codecCtx, video->m_frame, &frameFinished, cachePacket);
         if (frameFinished) {
           AVFrame *input = video->m_frame;
 
           /* This means the data wasnt read properly, this check stops crashing */
-          if (input->data[0] != 0 || input->data[1] != 0 || input->data[2] != 0 ||
-              input->data[3] != 0) {
-            if (video->m_deinterlace) {
-              if (av_image_deinterlace((AVFrame *)video->m_frameDeinterlaced,
-                                       (const AVFrame *)video->m_frame,
-                                       video->m_codecCtx->pix_fmt,
-                                       video->m_codecCtx->width,
-                                       video->m_codecCtx->height) >= 0) {
-                input = video->m_frameDeinterlaced;
-              }
-            }
+          if ((input->data[0] != 0 || input->data[1] != 0 || input->data[2] != 0 ||
+               input->data[3] != 0) &&
+              (input = video->prepareFrame(input)) != nullptr) {
             // convert to RGB24
             sws_scale(video->m_imgConvertCtx,
                       input->data,
@@ -431,25 +538,20 @@ void *VideoFFmpeg::cacheThread(void *data)
                       currentFrame->frame->data,
                       currentFrame->frame->linesize);
             // move frame to queue, this frame is necessarily the next one
-            video->m_curPosition = (long)((cachePacket->packet.dts - startTs) *
+            video->m_curPosition = (long)((cachePacket->dts - startTs) *
                                               (video->m_baseFrameRate * timeBase) +
                                           0.5);
             currentFrame->framePosition = video->m_curPosition;
-            pthread_mutex_lock(&video->m_cacheMutex);
-            BLI_addtail(&video->m_frameCacheBase, currentFrame);
-            pthread_mutex_unlock(&video->m_cacheMutex);
+            video->m_frameCacheTail.store(frameTail + 1, std::memory_order_release);
             currentFrame = nullptr;
           }
         }
-        av_free_packet(&cachePacket->packet);
-        BLI_addtail(&video->m_packetCacheFree, cachePacket);
+        av_free_packet(cachePacket);
       }
       if (currentFrame && endOfFile) {
         // no more packet and end of file => put a special frame that indicates that
         currentFrame->framePosition = -1;
-        pthread_mutex_lock(&video->m_cacheMutex);
-        BLI_addtail(&video->m_frameCacheBase, currentFrame);
-        pthread_mutex_unlock(&video->m_cacheMutex);
+        video->m_frameCacheTail.store(frameTail + 1, std::memory_order_release);
         currentFrame = nullptr;
         // no need to stay any longer in this thread
         break;
@@ -458,12 +560,7 @@ void *VideoFFmpeg::cacheThread(void *data)
     // small sleep to avoid unnecessary looping
     PIL_sleep_ms(10);
   }
-  // before quitting, put back the current frame to queue to allow freeing
-  if (currentFrame) {
-    pthread_mutex_lock(&video->m_cacheMutex);
-    BLI_addtail(&video->m_frameCacheFree, currentFrame);
-    pthread_mutex_unlock(&video->m_cacheMutex);
-  }
+  // the frame being decoded was never made ready, it stays free in the ring
   return 0;
 }
 
@@ -474,15 +571,13 @@ bool VideoFFmpeg::startCache()
 {
   if (!m_cacheStarted && m_isThreaded) {
     m_stopThread = false;
-    for (int i = 0; i < CACHE_FRAME_SIZE; i++) {
-      CacheFrame *frame = new CacheFrame();
-      frame->frame = allocFrameRGB();
-      BLI_addtail(&m_frameCacheFree, frame);
-    }
-    for (int i = 0; i < CACHE_PACKET_SIZE; i++) {
-      CachePacket *packet = new CachePacket();
-      BLI_addtail(&m_packetCacheFree, packet);
+    for (CacheFrame &frame : m_frameCache) {
+      frame.frame = allocFrameRGB();
     }
+    m_frameCacheHead = 0;
+    m_frameCacheTail = 0;
+    m_packetCacheHead = 0;
+    m_packetCacheTail = 0;
     BLI_threadpool_init(&m_thread, cacheThread, 1);
     BLI_threadpool_insert(&m_thread, this);
     m_cacheStarted = true;
@@ -496,28 +591,13 @@ void VideoFFmpeg::stopCache()
     m_stopThread = true;
     BLI_threadpool_end(&m_thread);
     // now delete the cache
-    CacheFrame *frame;
-    CachePacket *packet;
-    while ((frame = (CacheFrame *)m_frameCacheBase.first) != nullptr) {
-      BLI_remlink(&m_frameCacheBase, frame);
-      MEM_freeN(frame->frame->data[0]);
-      av_free(frame->frame);
-      delete frame;
+    for (CacheFrame &frame : m_frameCache) {
+      MEM_freeN(frame.frame->data[0]);
+      av_free(frame.frame);
+      frame.frame = nullptr;
     }
-    while ((frame = (CacheFrame *)m_frameCacheFree.first) != nullptr) {
-      BLI_remlink(&m_frameCacheFree, frame);
-      MEM_freeN(frame->frame->data[0]);
-      av_free(frame->frame);
-      delete frame;
-    }
-    while ((packet = (CachePacket *)m_packetCacheBase.first) != nullptr) {
-      BLI_remlink(&m_packetCacheBase, packet);
-      av_free_packet(&packet->packet);
-      delete packet;
-    }
-    while ((packet = (CachePacket *)m_packetCacheFree.first) != nullptr) {
-      BLI_remlink(&m_packetCacheFree, packet);
-      delete packet;
+    while (m_packetCacheHead != m_packetCacheTail) {
+      av_free_packet(&m_packetCache[m_packetCacheHead++ % CACHE_PACKET_SIZE]);
     }
     m_cacheStarted = false;
   }
@@ -530,12 +610,27 @@ void VideoFFmpeg::releaseFrame(AVFrame *frame)
     return;
   }
   // this frame MUST be the first one of the queue
-  pthread_mutex_lock(&m_cacheMutex);
-  CacheFrame *cacheFrame = (CacheFrame *)m_frameCacheBase.first;
+  CacheFrame *cacheFrame = getCacheFrame();
   assert(cacheFrame != nullptr && cacheFrame->frame == frame);
-  BLI_remlink(&m_frameCacheBase, cacheFrame);
-  BLI_addtail(&m_frameCacheFree, cacheFrame);
-  pthread_mutex_unlock(&m_cacheMutex);
+  (void)cacheFrame;
+  popCacheFrame();
+}
+
+VideoFFmpeg::CacheFrame *VideoFFmpeg::getCacheFrame()
+{
+  const unsigned int head = m_frameCacheHead.load(std::memory_order_relaxed);
+  // the acquire makes the frame written by the cache thread visible
+  if (head == m_frameCacheTail.load(std::memory_order_acquire)) {
+    return nullptr;
+  }
+  return &m_frameCache[head % CACHE_FRAME_SIZE];
+}
+
+void VideoFFmpeg::popCacheFrame()
+{
+  // the release makes sure the frame is not read anymore when the cache thread reuses it
+  m_frameCacheHead.store(m_frameCacheHead.load(std::memory_order_relaxed) + 1,
+                         std::memory_order_release);
 }
 
 // open video file
@@ -862,9 +957,7 @@ AVFrame *VideoFFmpeg::grabFrame(long position)
   if (m_cacheStarted) {
     // when cache is active, we must not read the file directly
     do {
-      pthread_mutex_lock(&m_cacheMutex);
-      frame = (CacheFrame *)m_frameCacheBase.first;
-      pthread_mutex_unlock(&m_cacheMutex);
+      frame = getCacheFrame();
       // no need to remove the frame from the queue: the cache thread does not touch the head, only
       // the tail
       if (frame == nullptr) {
@@ -895,10 +988,7 @@ AVFrame *VideoFFmpeg::grabFrame(long position)
         return nullptr;
       }
       // this frame is not useful, release it
-      pthread_mutex_lock(&m_cacheMutex);
-      BLI_remlink(&m_frameCacheBase, frame);
-      BLI_addtail(&m_frameCacheFree, frame);
-      pthread_mutex_unlock(&m_cacheMutex);
+      popCacheFrame();
     } while (true);
   }
   double timeBase = av_q2d(m_formatCtx->streams[m_videoStream]->time_base);
@@ -1011,14 +1101,10 @@ AVFrame *VideoFFmpeg::grabFrame(long position)
           break;
         }
 
-        if (m_deinterlace) {
-          if (av_image_deinterlace((AVFrame *)m_frameDeinterlaced,
-                                   (const AVFrame *)m_frame,
-                                   m_codecCtx->pix_fmt,
-                                   m_codecCtx->width,
-                                   m_codecCtx->height) >= 0) {
-            input = m_frameDeinterlaced;
-          }
+        input = prepareFrame(input);
+        if (!input) {
+          av_free_packet(&packet);
+          break;
         }
         // convert to RGB24
         sws_scale(m_imgConvertCtx,
@@ -1074,11 +1160,23 @@ static int VideoFFmpeg_init(PyObject *pySelf, PyObject *args, PyObject *kwds)
   // capture rate, only if capt is >= 0
   float rate = 25.f;
 
-  static const char *kwlist[] = {"file", "capture", "rate", "width", "height", nullptr};
+  // use the hardware decoding
+  int hwDecode = 0;
+
+  static const char *kwlist[] = {
+      "file", "capture", "rate", "width", "height", "hwDecode", nullptr};
 
   // get parameters
-  if (!PyArg_ParseTupleAndKeywords(
-          args, kwds, "s|hfhh", const_cast<char **>(kwlist), &file, &capt, &rate, &width, &height))
+  if (!PyArg_ParseTupleAndKeywords(args,
+                                   kwds,
+                                   "s|hfhhp",
+                                   const_cast<char **>(kwlist),
+                                   &file,
+                                   &capt,
+                                   &rate,
+                                   &width,
+                                   &height,
+                                   &hwDecode))
     return -1;
 
   try {
@@ -1087,6 +1185,7 @@ static int VideoFFmpeg_init(PyObject *pySelf, PyObject *args, PyObject *kwds)
 
     // set thread usage
     getVideoFFmpeg(self)->initParams(width, height, rate);
+    getVideoFFmpeg(self)->setHwDecode(hwDecode);
 
     // open video source
     Video_open(getVideo(self), file, capt);
@@ -1118,6 +1217,15 @@ static int VideoFFmpeg_setPreseek(PyImage *self, PyObject *value, void *closure)
   return 0;
 }
 
+// get hardware decoding
+static PyObject *VideoFFmpeg_getHwDecode(PyImage *self, void *closure)
+{
+  if (getFFmpeg(self)->getHwDecode())
+    Py_RETURN_TRUE;
+  else
+    Py_RETURN_FALSE;
+}
+
 // get deinterlace
 static PyObject *VideoFFmpeg_getDeinterlace(PyImage *self, void *closure)
 {
@@ -1199,6 +1307,11 @@ static PyGetSetDef videoGetSets[] = {  // methods from VideoBase class
      (setter)VideoFFmpeg_setDeinterlace,
      (char *)"deinterlace image",
      nullptr},
+    {(char *)"hwDecode",
+     (getter)VideoFFmpeg_getHwDecode,
+     nullptr,
+     (char *)"video decoded by the hardware",
+     nullptr},
     {nullptr}};
 
 // python type declaration
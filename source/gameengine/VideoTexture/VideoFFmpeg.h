@@ -35,6 +35,8 @@
 #  if defined(__FreeBSD__)
 #    include <inttypes.h>
 #  endif
+#  include <atomic>
+
 extern "C" {
 #  include "BLI_blenlib.h"
 #  include "BLI_threads.h"
@@ -43,6 +45,13 @@ extern "C" {
 #  include <pthread.h>
 }
 
+#  if LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(58, 18, 100)
+#    define FFMPEG_HAVE_HW_DECODE 1
+extern "C" {
+#    include <libavutil/hwcontext.h>
+}
+#  endif
+
 #  if LIBAVFORMAT_VERSION_INT < (49 << 16)
 #    define FFMPEG_OLD_FRAME_RATE 1
 #  else
@@ -113,6 +122,16 @@ class VideoFFmpeg : public VideoBase {
   {
     m_deinterlace = deinterlace;
   }
+  /// use the hardware decoding when available, must be set before opening the video
+  void setHwDecode(bool hwDecode)
+  {
+    m_hwDecode = hwDecode;
+  }
+  /// is the video decoded by the hardware?
+  bool getHwDecode(void)
+  {
+    return (m_hwPixFmt != AV_PIX_FMT_NONE);
+  }
   char *getImageName(void)
   {
     return (m_isImage) ? (char *)m_imageName.c_str() : nullptr;
@@ -131,6 +150,14 @@ class VideoFFmpeg : public VideoBase {
   AVFrame *m_frameRGB;
   // conversion from raw to RGB is done with sws_scale
   struct SwsContext *m_imgConvertCtx;
+  // request the hardware decoding
+  bool m_hwDecode;
+  // hardware device used by the decoder
+  AVBufferRef *m_hwDeviceCtx;
+  // pixel format of the frames decoded by the hardware, AV_PIX_FMT_NONE for software decoding
+  AVPixelFormat m_hwPixFmt;
+  // frame transferred from the hardware to the memory
+  AVFrame *m_frameSw;
   // should the codec be deinterlaced?
   bool m_deinterlace;
   // number of frame of preseek
@@ -199,29 +226,41 @@ class VideoFFmpeg : public VideoBase {
   /// in case of caching, put the frame back in free queue
   void releaseFrame(AVFrame *frame);
 
+  /// setup the hardware decoding of the codec before its opening
+  void initHwDecode(AVCodecContext *codecCtx, AVCodec *codec);
+  /** get the decoded frame in memory and deinterlaced if needed, and update the conversion
+   * context to its format, return nullptr if the frame is not usable
+   */
+  AVFrame *prepareFrame(AVFrame *frame);
+
   /// start thread to load the video file/capture/stream
   bool startCache();
   void stopCache();
 
  private:
   typedef struct {
-    Link link;
     long framePosition;
     AVFrame *frame;
   } CacheFrame;
-  typedef struct {
-    Link link;
-    AVPacket packet;
-  } CachePacket;
 
   bool m_stopThread;
   bool m_cacheStarted;
   ListBase m_thread;
-  ListBase m_frameCacheBase;   // list of frames that are ready
-  ListBase m_frameCacheFree;   // list of frames that are unused
-  ListBase m_packetCacheBase;  // list of packets that are ready for decoding
-  ListBase m_packetCacheFree;  // list of packets that are unused
-  pthread_mutex_t m_cacheMutex;
+  /* Ring of preallocated frames, filled by the cache thread and read by the main thread.
+   * The head is only written by the main thread and the tail by the cache thread, the
+   * frames between them are ready. */
+  CacheFrame m_frameCache[CACHE_FRAME_SIZE];
+  std::atomic<unsigned int> m_frameCacheHead;
+  std::atomic<unsigned int> m_frameCacheTail;
+  // ring of packets ready for decoding, used solely by the cache thread
+  AVPacket m_packetCache[CACHE_PACKET_SIZE];
+  unsigned int m_packetCacheHead;
+  unsigned int m_packetCacheTail;
+
+  /// first ready frame of the cache, nullptr if the cache is empty
+  CacheFrame *getCacheFrame();
+  /// give back the first ready frame of the cache to the cache thread
+  void popCacheFrame();
 
   AVFrame *allocFrameRGB();
   static void *cacheThread(void *);
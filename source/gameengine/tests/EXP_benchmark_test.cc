@@ -0,0 +1,182 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include <string>
+#include <vector>
+
+#include "EXP_IntValue.h"
+#include "EXP_ListValue.h"
+
+#include "ge_benchmark_test_utils.hh"
+
+namespace ge::tests {
+
+/// List of named integers, like the object list of a scene.
+static EXP_ListValue<EXP_IntValue> *create_list(int count, bool useNameIndex)
+{
+  EXP_ListValue<EXP_IntValue> *list = new EXP_ListValue<EXP_IntValue>();
+  list->SetReleaseOnDestruct(true);
+  list->SetUseNameIndex(useNameIndex);
+  for (int i = 0; i < count; ++i) {
+    list->Add(new EXP_IntValue(i, "Object" + std::to_string(i)));
+  }
+  return list;
+}
+
+static void benchmark_find_value(const std::string &name, bool useNameIndex)
+{
+  EXP_ListValue<EXP_IntValue> *list = create_list(1000, useNameIndex);
+
+  std::vector<std::string> names;
+  for (int i = 0; i < 1000; i += 10) {
+    names.push_back("Object" + std::to_string(i));
+  }
+
+  const long long sum = run_benchmark(name, 1000, [&]() {
+    long long total = 0;
+    for (const std::string &itemName : names) {
+      total += list->FindValue(itemName)->GetInt();
+    }
+    return total;
+  });
+  EXPECT_EQ(sum, 49500LL * 1000 * 5);
+
+  list->Release();
+}
+
+TEST(exp_list_value, DISABLED_BenchmarkFindValue)
+{
+  benchmark_find_value("EXP_ListValue find 100 names in 1000 items", false);
+}
+
+TEST(exp_list_value, DISABLED_BenchmarkFindValueNameIndex)
+{
+  benchmark_find_value("EXP_ListValue find 100 names in 1000 indexed items", true);
+}
+
+TEST(exp_list_value, DISABLED_BenchmarkAddRemove)
+{
+  EXP_ListValue<EXP_IntValue> *list = create_list(1000, true);
+  std::vector<EXP_IntValue *> values;
+  for (int i = 0; i < 100; ++i) {
+    values.push_back(new EXP_IntValue(i, "Added" + std::to_string(i)));
+  }
+
+  // Add and remove items as objects spawned and ended each frame.
+  const long long sum = run_benchmark("EXP_ListValue add and remove 100 items", 1000, [&]() {
+    for (EXP_IntValue *value : values) {
+      list->Add(CM_AddRef(value));
+    }
+    long long total = 0;
+    for (EXP_IntValue *value : values) {
+      total += list->RemoveValue(value);
+      value->Release();
+    }
+    return total;
+  });
+  EXPECT_EQ(sum, 100LL * 1000 * 5);
+  EXPECT_EQ(list->GetCount(), 1000);
+
+  for (EXP_IntValue *value : values) {
+    value->Release();
+  }
+  list->Release();
+}
+
+static void benchmark_remove_value(const std::string &name, bool useItemIndex, bool stableOrder)
+{
+  EXP_ListValue<EXP_IntValue> *list = create_list(10000, false);
+  list->SetUseItemIndex(useItemIndex, stableOrder);
+  std::vector<EXP_IntValue *> values;
+  for (int i = 0; i < 1000; ++i) {
+    values.push_back(new EXP_IntValue(i, "Added" + std::to_string(i)));
+  }
+
+  // Remove the objects one by one in their order of addition, as outside of a batched removal.
+  const long long sum = run_benchmark(name, 10, [&]() {
+    for (EXP_IntValue *value : values) {
+      list->Add(CM_AddRef(value));
+    }
+    long long total = 0;
+    for (EXP_IntValue *value : values) {
+      total += list->RemoveValue(value);
+      value->Release();
+    }
+    return total;
+  });
+  EXPECT_EQ(sum, 1000LL * 10 * 5);
+  EXPECT_EQ(list->GetCount(), 10000);
+  if (stableOrder) {
+    for (int i = 0; i < 10000; ++i) {
+      EXPECT_EQ(list->GetValue(i)->GetInt(), i);
+    }
+  }
+
+  for (EXP_IntValue *value : values) {
+    value->Release();
+  }
+  list->Release();
+}
+
+TEST(exp_list_value, DISABLED_BenchmarkRemoveValue)
+{
+  benchmark_remove_value("EXP_ListValue remove 1000 items from 11000", false, true);
+}
+
+TEST(exp_list_value, DISABLED_BenchmarkRemoveValueStableIndex)
+{
+  benchmark_remove_value(
+      "EXP_ListValue remove 1000 items from 11000 indexed in stable order", true, true);
+}
+
+TEST(exp_list_value, DISABLED_BenchmarkRemoveValueSwapIndex)
+{
+  benchmark_remove_value("EXP_ListValue remove 1000 items from 11000 indexed", true, false);
+}
+
+TEST(exp_value, DISABLED_BenchmarkGetProperty)
+{
+  // Properties of a game object, read by the property sensors and python scripts.
+  EXP_IntValue *owner = new EXP_IntValue(0, "Owner");
+  std::vector<std::string> names;
+  for (int i = 0; i < 20; ++i) {
+    names.push_back("prop" + std::to_string(i));
+    EXP_IntValue *prop = new EXP_IntValue(i);
+    owner->SetProperty(names.back(), prop);
+    prop->Release();
+  }
+
+  const long long sum = run_benchmark("EXP_Value get 20 properties", 100000, [&]() {
+    long long total = 0;
+    for (const std::string &name : names) {
+      total += static_cast<EXP_IntValue *>(owner->GetProperty(name))->GetInt();
+    }
+    return total;
+  });
+  EXPECT_EQ(sum, 190LL * 100000 * 5);
+
+  owner->Release();
+}
+
+TEST(exp_value, DISABLED_BenchmarkSetProperty)
+{
+  EXP_IntValue *owner = new EXP_IntValue(0, "Owner");
+  EXP_IntValue *prop = new EXP_IntValue(0);
+  owner->SetProperty("prop", prop);
+  prop->Release();
+
+  // Modify the value in place as the property actuator does.
+  EXP_IntValue *newValue = new EXP_IntValue(0);
+  const long long sum = run_benchmark("EXP_Value set a property value", 1000000, [&]() {
+    EXP_Value *value = owner->GetProperty("prop");
+    value->SetValue(newValue);
+    return 1;
+  });
+  EXPECT_EQ(sum, 1000000LL * 5);
+
+  newValue->Release();
+  owner->Release();
+}
+
+}  // namespace ge::tests
@@ -0,0 +1,59 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include <string>
+#include <vector>
+
+#include "KX_NetworkMessageManager.h"
+
+#include "ge_benchmark_test_utils.hh"
+
+namespace ge::tests {
+
+static void benchmark_messages(const std::string &name, int numMessages, int numReceivers)
+{
+  KX_NetworkMessageManager manager;
+
+  std::vector<std::string> receivers;
+  for (int i = 0; i < numReceivers; ++i) {
+    receivers.push_back("Receiver" + std::to_string(i));
+  }
+  const std::string subject = "hit";
+  const std::string body = "damage=10";
+
+  // The filters are registered once, as by the message sensors.
+  std::vector<KX_NetworkMessageManager::FilterId> filters;
+  for (const std::string &receiver : receivers) {
+    filters.push_back(manager.RegisterFilter(receiver, subject));
+  }
+
+  // Send the messages of a frame and read them in the next one, as the message sensors.
+  std::vector<KX_NetworkMessageManager::Message> messages;
+  const long long sum = run_benchmark(name, 100, [&]() {
+    for (int i = 0; i < numMessages; ++i) {
+      manager.AddMessage(receivers[i % numReceivers], nullptr, subject, body);
+    }
+    manager.ClearMessages();
+
+    long long total = 0;
+    for (KX_NetworkMessageManager::FilterId filter : filters) {
+      manager.GetMessages(filter, messages);
+      total += messages.size();
+    }
+    return total;
+  });
+  EXPECT_EQ(sum, (long long)numMessages * 100 * 5);
+}
+
+TEST(kx_network_message_manager, DISABLED_BenchmarkMessages)
+{
+  benchmark_messages("Send and receive 1000 messages to 50 receivers", 1000, 50);
+}
+
+TEST(kx_network_message_manager, DISABLED_BenchmarkMessagesManyReceivers)
+{
+  benchmark_messages("Send and receive 1000 messages to 1000 receivers", 1000, 1000);
+}
+
+}  // namespace ge::tests
@@ -0,0 +1,161 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include <string>
+#include <vector>
+
+#include "SCA_ANDController.h"
+#include "SCA_AlwaysSensor.h"
+#include "SCA_BasicEventManager.h"
+#include "SCA_IActuator.h"
+#include "SCA_IObject.h"
+#include "SCA_LogicManager.h"
+
+#include "ge_benchmark_test_utils.hh"
+
+namespace ge::tests {
+
+class BenchmarkObject : public SCA_IObject {
+ private:
+  std::string m_name;
+
+ public:
+  BenchmarkObject(const std::string &name) : m_name(name)
+  {
+  }
+
+  virtual std::string GetName()
+  {
+    return m_name;
+  }
+
+  virtual KX_PythonProxy *NewInstance()
+  {
+    return new BenchmarkObject(m_name);
+  }
+};
+
+/// Actuator doing nothing and stopping after its update, like a one shot actuator.
+class BenchmarkActuator : public SCA_IActuator {
+ public:
+  int m_updates;
+
+  BenchmarkActuator(SCA_IObject *gameobj) : SCA_IActuator(gameobj, KX_ACT_PROPERTY), m_updates(0)
+  {
+  }
+
+  virtual EXP_Value *GetReplica()
+  {
+    return nullptr;
+  }
+
+  virtual bool Update()
+  {
+    RemoveAllEvents();
+    ++m_updates;
+    return false;
+  }
+};
+
+/// Objects each having an always sensor in pulse mode linked to an actuator by a controller.
+struct LogicScene {
+  SCA_LogicManager logicmgr;
+  SCA_EventManager *eventmgr;
+  std::vector<BenchmarkObject *> objects;
+  std::vector<BenchmarkActuator *> actuators;
+
+  LogicScene(int count, int bricksPerObject)
+  {
+    eventmgr = new SCA_BasicEventManager(&logicmgr);
+    logicmgr.RegisterEventManager(eventmgr);
+
+    for (int i = 0; i < count; ++i) {
+      BenchmarkObject *gameobj = new BenchmarkObject("Object" + std::to_string(i));
+      for (int j = 0; j < bricksPerObject; ++j) {
+        SCA_ISensor *sensor = new SCA_AlwaysSensor(eventmgr, gameobj);
+        sensor->SetPulseMode(true, false, 0);
+        sensor->SetLogicManager(&logicmgr);
+        gameobj->AddSensor(sensor);
+
+        SCA_IController *controller = new SCA_ANDController(gameobj);
+        controller->SetState(1);
+        controller->SetLogicManager(&logicmgr);
+        gameobj->AddController(controller);
+
+        BenchmarkActuator *actuator = new BenchmarkActuator(gameobj);
+        actuator->SetLogicManager(&logicmgr);
+        gameobj->AddActuator(actuator);
+        actuators.push_back(actuator);
+
+        logicmgr.RegisterToSensor(controller, sensor);
+        logicmgr.RegisterToActuator(controller, actuator);
+      }
+
+      // Activate the controllers and register the sensors to the event manager.
+      gameobj->SetState(1);
+      objects.push_back(gameobj);
+    }
+  }
+
+  ~LogicScene()
+  {
+    // Same cleanup than KX_Scene::NewRemoveObject.
+    for (BenchmarkObject *gameobj : objects) {
+      for (SCA_ISensor *sensor : gameobj->GetSensors()) {
+        logicmgr.RemoveSensor(sensor);
+      }
+      for (SCA_IController *controller : gameobj->GetControllers()) {
+        logicmgr.RemoveController(controller);
+        controller->ReParent(nullptr);
+      }
+      for (SCA_IActuator *actuator : gameobj->GetActuators()) {
+        logicmgr.RemoveActuator(actuator);
+      }
+      gameobj->Release();
+    }
+  }
+
+  int NextFrame(double time)
+  {
+    logicmgr.BeginFrame(time, 0.0);
+    logicmgr.UpdateFrame(time);
+    logicmgr.EndFrame();
+    return 1;
+  }
+
+  long long GetUpdates() const
+  {
+    long long total = 0;
+    for (BenchmarkActuator *actuator : actuators) {
+      total += actuator->m_updates;
+    }
+    return total;
+  }
+};
+
+static void benchmark_logic_frame(const std::string &name, int count, int bricksPerObject)
+{
+  LogicScene scene(count, bricksPerObject);
+
+  double time = 0.0;
+  run_benchmark(name, 100, [&]() {
+    time += 1.0 / 60.0;
+    return scene.NextFrame(time);
+  });
+
+  // Every actuator is triggered at each frame.
+  EXPECT_EQ(scene.GetUpdates(), (long long)count * bricksPerObject * 100 * 5);
+}
+
+TEST(sca_logic_manager, DISABLED_BenchmarkTrigger)
+{
+  benchmark_logic_frame("Logic frame of 1000 objects with 1 brick chain", 1000, 1);
+}
+
+TEST(sca_logic_manager, DISABLED_BenchmarkTriggerManyBricks)
+{
+  benchmark_logic_frame("Logic frame of 100 objects with 10 brick chains", 100, 10);
+}
+
+}  // namespace ge::tests
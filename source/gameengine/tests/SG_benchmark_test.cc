@@ -0,0 +1,214 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include <memory>
+#include <vector>
+
+#include "BLI_utildefines.h"
+
+#include "SG_DList.h"
+#include "SG_Node.h"
+#include "SG_ParentRelation.h"
+#include "SG_QList.h"
+
+#include "ge_benchmark_test_utils.hh"
+
+namespace ge::tests {
+
+/** Parent relation computing the world transform from the parent one like
+ * KX_NormalParentRelation, without depending on Ketsji.
+ */
+class BenchmarkParentRelation : public SG_ParentRelation {
+ public:
+  virtual bool UpdateChildCoordinates(SG_Node *child, const SG_Node *parent, bool &parentUpdated)
+  {
+    if (!parentUpdated && !child->IsModified()) {
+      return false;
+    }
+
+    parentUpdated = true;
+
+    if (!parent) {
+      child->SetWorldFromLocalTransform();
+    }
+    else {
+      const MT_Transform trans(parent->GetWorldTransform() * child->GetLocalTransform());
+      child->SetWorldPosition(trans.getOrigin());
+      child->SetWorldOrientation(trans.getBasis());
+      child->SetWorldScale(child->GetLocalScale() * parent->GetWorldScaling());
+    }
+    child->ClearModified();
+
+    return true;
+  }
+
+  virtual SG_ParentRelation *NewCopy()
+  {
+    return new BenchmarkParentRelation();
+  }
+};
+
+/// Schedule the modified nodes in the list given as client info, like KX_Scene.
+static bool schedule_update_func(SG_Node *node, void *UNUSED(clientobj), void *clientinfo)
+{
+  return node->Schedule(*(SG_QList *)clientinfo);
+}
+
+static SG_Callbacks benchmark_callbacks(
+    nullptr, nullptr, nullptr, schedule_update_func, nullptr, nullptr);
+
+/// Hierarchy of root nodes each having a chain of children.
+struct NodeHierarchy {
+  SG_QList head;
+  std::vector<std::unique_ptr<SG_Node>> nodes;
+  std::vector<SG_Node *> roots;
+
+  NodeHierarchy(int numRoots, int depth)
+  {
+    for (int i = 0; i < numRoots; ++i) {
+      SG_Node *parent = nullptr;
+      for (int j = 0; j < depth; ++j) {
+        SG_Node *node = new SG_Node(nullptr, &head, benchmark_callbacks);
+        node->SetParentRelation(new BenchmarkParentRelation());
+        node->SetLocalPosition(MT_Vector3(i, j, 0.0f));
+        if (parent) {
+          parent->AddChild(node);
+        }
+        else {
+          roots.push_back(node);
+        }
+        nodes.emplace_back(node);
+        parent = node;
+      }
+    }
+  }
+
+  /// Update the scheduled nodes as KX_Scene::UpdateParents does serially.
+  int UpdateParents()
+  {
+    std::vector<SG_Node *> updateNodes;
+    SG_DList::iterator<SG_Node> it(head);
+    for (it.begin(); !it.end(); ++it) {
+      SG_Node *node = *it;
+      if (!node->HasScheduledAncestor()) {
+        updateNodes.push_back(node);
+      }
+    }
+
+    while (SG_Node::GetNextScheduled(head)) {
+    }
+
+    for (SG_Node *node : updateNodes) {
+      node->UpdateWorldData(0.0);
+    }
+    return updateNodes.size();
+  }
+};
+
+TEST(sg_node, DISABLED_BenchmarkUpdateRoots)
+{
+  NodeHierarchy hierarchy(1000, 4);
+  hierarchy.UpdateParents();
+
+  const long long sum = run_benchmark("Update moved roots of 1000x4 nodes", 100, [&]() {
+    for (SG_Node *root : hierarchy.roots) {
+      root->RelativeTranslate(MT_Vector3(0.0f, 0.0f, 0.1f), nullptr, false);
+    }
+    return hierarchy.UpdateParents();
+  });
+  EXPECT_EQ(sum, 1000 * 100 * 5);
+
+  EXPECT_NEAR(hierarchy.nodes.back()->GetWorldPosition().z(), 50.0f, 1e-2f);
+}
+
+TEST(sg_node, DISABLED_BenchmarkUpdateLeaves)
+{
+  NodeHierarchy hierarchy(1000, 4);
+  hierarchy.UpdateParents();
+
+  std::vector<SG_Node *> leaves;
+  for (SG_Node *root : hierarchy.roots) {
+    SG_Node *node = root;
+    while (!node->GetSGChildren().empty()) {
+      node = node->GetSGChildren().front();
+    }
+    leaves.push_back(node);
+  }
+
+  const long long sum = run_benchmark("Update moved leaves of 1000x4 nodes", 100, [&]() {
+    for (SG_Node *leaf : leaves) {
+      leaf->RelativeTranslate(MT_Vector3(0.0f, 0.0f, 0.1f), nullptr, false);
+    }
+    return hierarchy.UpdateParents();
+  });
+  EXPECT_EQ(sum, 1000 * 100 * 5);
+}
+
+/// List item also usable as a queue item, like the game objects and logic bricks.
+class BenchmarkItem : public SG_QList {
+ public:
+  int m_value;
+
+  BenchmarkItem(int value) : m_value(value)
+  {
+  }
+};
+
+TEST(sg_list, DISABLED_BenchmarkDList)
+{
+  std::vector<BenchmarkItem> items;
+  items.reserve(10000);
+  for (int i = 0; i < 10000; ++i) {
+    items.emplace_back(i);
+  }
+
+  SG_DList head;
+  const long long sum = run_benchmark("SG_DList add, iterate and remove 10000 items", 100, [&]() {
+    for (BenchmarkItem &item : items) {
+      head.AddBack(&item);
+    }
+
+    long long total = 0;
+    SG_DList::iterator<BenchmarkItem> it(head);
+    for (it.begin(); !it.end(); ++it) {
+      total += (*it)->m_value;
+    }
+
+    while (head.Remove()) {
+    }
+    return total;
+  });
+  EXPECT_EQ(sum, 49995000LL * 100 * 5);
+}
+
+TEST(sg_list, DISABLED_BenchmarkQList)
+{
+  std::vector<BenchmarkItem> items;
+  items.reserve(10000);
+  for (int i = 0; i < 10000; ++i) {
+    items.emplace_back(i);
+  }
+
+  SG_QList head;
+  const long long sum = run_benchmark("SG_QList add, iterate and delink 10000 items", 100, [&]() {
+    for (BenchmarkItem &item : items) {
+      head.QAddBack(&item);
+    }
+
+    long long total = 0;
+    SG_QList::iterator<BenchmarkItem> it(head);
+    for (it.begin(); !it.end(); ++it) {
+      total += (*it)->m_value;
+    }
+
+    // Delink in the list order, as actuators removed while updating.
+    for (BenchmarkItem &item : items) {
+      item.QDelink();
+    }
+    return total;
+  });
+  EXPECT_EQ(sum, 49995000LL * 100 * 5);
+}
+
+}  // namespace ge::tests
@@ -0,0 +1,39 @@
+/* Apache License, Version 2.0 */
+
+#pragma once
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+
+#include "BLI_timeit.hh"
+
+namespace ge::tests {
+
+/**
+ * Run a function for a number of iterations and print the time taken by one iteration.
+ * The best of a few repetitions is kept, the first ones also warm up the caches.
+ * \return The sum of the values returned by the function, callers should check it
+ * to avoid the compiler optimizing the benchmarked code away.
+ */
+template<typename Func>
+long long run_benchmark(const std::string &name, int iterations, const Func &func)
+{
+  using namespace blender::timeit;
+
+  long long sum = 0;
+  Nanoseconds best = Nanoseconds::max();
+  for (int repeat = 0; repeat < 5; ++repeat) {
+    const TimePoint start = Clock::now();
+    for (int i = 0; i < iterations; ++i) {
+      sum += func();
+    }
+    best = std::min(best, Nanoseconds(Clock::now() - start));
+  }
+
+  std::cout << "Benchmark '" << name << "': " << (double)best.count() / iterations
+            << " ns per iteration\n";
+  return sum;
+}
+
+}  // namespace ge::tests
@@ -0,0 +1,119 @@
+# Apache License, Version 2.0
+
+import api
+import pathlib
+import platform
+
+# Scenes are expected in lib/benchmarks/bge, for example static props,
+# rigid bodies, skinned characters, logic bricks, python components and
+# LibLoad streaming scenes. The game of each file must be able to run until
+# ended by the benchmark.
+
+
+def _run(args):
+    import bge
+    import time
+
+    warmup_frames = args['warmup_frames']
+    min_time = args['min_time']
+
+    # Let the scene settle, first frames include loading and shader compilation.
+    for i in range(warmup_frames):
+        if bge.logic.NextFrame():
+            return None
+
+    categories = {}
+    num_frames = 0
+    start_time = time.perf_counter()
+    elapsed_time = 0.0
+
+    while elapsed_time < min_time:
+        if bge.logic.NextFrame():
+            break
+
+        # Profile info is the average of the last frames in milliseconds.
+        for label, (ms, percent) in bge.logic.getProfileInfo().items():
+            if label == 'Scripts':
+                continue
+            name = label.rstrip(':').lower().replace(' ', '_')
+            categories[name] = categories.get(name, 0.0) + ms / 1000.0
+
+        num_frames += 1
+        elapsed_time = time.perf_counter() - start_time
+
+    if num_frames == 0:
+        return None
+
+    result = {'time': elapsed_time / num_frames}
+    for name, total in categories.items():
+        result[name] = total / num_frames
+    return result
+
+
+def _player_main(package_path, output_prefix):
+    # Python main loop script given to blenderplayer, arguments are passed
+    # after the " - " separator as blenderplayer has no python expression option.
+    return (f'import sys, pickle, base64\n'
+            f'sys.path.append("{package_path}")\n'
+            f'import bge\n'
+            f'from tests import bge as bge_test\n'
+            f'args = pickle.loads(base64.b64decode(sys.argv[-1]))\n'
+            f'result = bge_test._run(args)\n'
+            f'result = base64.b64encode(pickle.dumps(result))\n'
+            f'print("{output_prefix}" + result.decode())\n'
+            f'sys.stdout.flush()\n'
+            f'bge.logic.endGame()\n')
+
+
+class BgeTest(api.Test):
+    def __init__(self, filepath):
+        self.filepath = filepath
+
+    def name(self):
+        return self.filepath.stem
+
+    def category(self):
+        return "bge"
+
+    def _player_executable(self, env):
+        # blenderplayer is built next to the blender executable.
+        name = 'blenderplayer.exe' if platform.system() == "Windows" else 'blenderplayer'
+        return pathlib.Path(env.blender_executable).parent / name
+
+    def run(self, env, device_id):
+        import base64
+        import pickle
+
+        package_path = pathlib.Path(__file__).parent.parent
+        output_prefix = 'TEST_OUTPUT: '
+
+        script_filepath = env.log_file.parent / (env.log_file.stem + '_main.py')
+        script_filepath.parent.mkdir(parents=True, exist_ok=True)
+        script_filepath.write_text(_player_main(package_path, output_prefix))
+
+        args = {'warmup_frames': 60, 'min_time': 10.0}
+        args = base64.b64encode(pickle.dumps(args)).decode()
+
+        # Fixed time renders every frame whatever the frame rate, so the
+        # measure doesn't depend on the logic frames skipped by the engine.
+        player_args = [self._player_executable(env),
+                       '-w', '1024', '768', '0', '0',
+                       '-g', 'fixedtime', '=', '1',
+                       '-p', str(script_filepath),
+                       str(self.filepath),
+                       '-', args]
+
+        lines = env.call(player_args, cwd=env.base_dir,
+                         environment=env.blender_executable_environment)
+
+        for line in lines:
+            if line.startswith(output_prefix):
+                output = line[len(output_prefix):].strip()
+                return pickle.loads(base64.b64decode(output))
+
+        return None
+
+
+def generate(env):
+    filepaths = env.find_blend_files('bge/*')
+    return [BgeTest(filepath) for filepath in filepaths]